@@ -40,6 +40,9 @@
 
 
 #include "3dface.h"
+#include "arena.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -53,7 +56,7 @@
 Dxf3dface *
 dxf_3dface_new ()
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         Dxf3dface *face = NULL;
@@ -62,7 +65,7 @@ dxf_3dface_new ()
         size = sizeof (Dxf3dface);
         /* avoid malloc of 0 bytes */
         if (size == 0) size = 1;
-        if ((face = malloc (size)) == NULL)
+        if ((face = dxf_malloc (size)) == NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () could not allocate memory.\n")),
@@ -73,7 +76,7 @@ dxf_3dface_new ()
         {
                 memset (face, 0, size);
         }
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_END
 #endif
         return (face);
@@ -94,7 +97,7 @@ dxf_3dface_init
                 /*!< a pointer to a DXF \c 3DFACE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -113,8 +116,7 @@ dxf_3dface_init
                 return (NULL);
         }
         dxf_3dface_set_id_code (face, 0);
-        dxf_3dface_set_linetype (face, strdup (DXF_DEFAULT_LINETYPE));
-        dxf_3dface_set_layer (face, strdup (DXF_DEFAULT_LAYER));
+        face->properties = dxf_graphic_properties_default ();
         dxf_3dface_set_p0 (face, dxf_point_new ());
         dxf_point_init ((DxfPoint *) dxf_3dface_get_p0 (face));
         dxf_3dface_set_x0 (face, 0.0);
@@ -135,27 +137,14 @@ dxf_3dface_init
         dxf_3dface_set_x3 (face, 0.0);
         dxf_3dface_set_y3 (face, 0.0);
         dxf_3dface_set_z3 (face, 0.0);
-        dxf_3dface_set_elevation (face, 0.0);
-        dxf_3dface_set_thickness (face, 0.0);
-        dxf_3dface_set_linetype_scale (face, DXF_DEFAULT_LINETYPE_SCALE);
-        dxf_3dface_set_visibility (face, DXF_DEFAULT_VISIBILITY);
-        dxf_3dface_set_color (face, DXF_COLOR_BYLAYER);
-        dxf_3dface_set_paperspace (face, DXF_MODELSPACE);
         dxf_3dface_set_flag (face, 0);
         dxf_3dface_set_graphics_data_size (face, 0);
-        dxf_3dface_set_shadow_mode (face, 0);
         dxf_3dface_set_binary_graphics_data (face, (DxfBinaryGraphicsData *) dxf_binary_graphics_data_new ());
         dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) dxf_3dface_get_binary_graphics_data (face));
-        dxf_3dface_set_dictionary_owner_soft (face, strdup (""));
-        dxf_3dface_set_material (face, strdup (""));
-        dxf_3dface_set_dictionary_owner_hard (face, strdup (""));
-        dxf_3dface_set_lineweight (face, 0);
-        dxf_3dface_set_plot_style_name (face, strdup (""));
-        dxf_3dface_set_color_value (face, 0);
-        dxf_3dface_set_color_name (face, strdup (""));
-        dxf_3dface_set_transparency (face, 0);
+        dxf_3dface_set_dictionary_owner_soft (face, "");
+        dxf_3dface_set_dictionary_owner_hard (face, "");
         dxf_3dface_set_next (face, NULL);
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_END
 #endif
         return (face);
@@ -182,10 +171,13 @@ dxf_3dface_read
                 /*!< a pointer to a DXF \c 3DFACE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfGraphicProperties properties;
+        DxfPair pair;
+        DxfBinaryGraphicsData *binary_graphics_data = NULL;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -193,8 +185,6 @@ dxf_3dface_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (face == NULL)
@@ -205,297 +195,235 @@ dxf_3dface_read
                 face = dxf_3dface_new ();
                 face = dxf_3dface_init (face);
         }
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        binary_graphics_data = (DxfBinaryGraphicsData *) face->binary_graphics_data;
+        dxf_graphic_properties_start (&properties, face->properties);
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        /* Clean up. */
-                        free (temp_string);
-                        fclose (fp->fp);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &face->id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", face->linetype);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", face->layer);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the first point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &face->p0->x0);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the first point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &face->p0->y0);
-                }
-                else if (strcmp (temp_string, "30") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of first the point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &face->p0->z0);
-                }
-                else if (strcmp (temp_string, "11") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the second point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &face->p1->x0);
-                }
-                else if (strcmp (temp_string, "21") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the second point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &face->p1->y0);
-                }
-                else if (strcmp (temp_string, "31") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the second point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &face->p1->z0);
-                }
-                else if (strcmp (temp_string, "12") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the third point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &face->p2->x0);
-                }
-                else if (strcmp (temp_string, "22") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the third point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &face->p2->y0);
-                }
-                else if (strcmp (temp_string, "32") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the third point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &face->p2->z0);
-                }
-                else if (strcmp (temp_string, "13") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the fourth point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &face->p3->x0);
-                }
-                else if (strcmp (temp_string, "23") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the fourth point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &face->p3->y0);
-                }
-                else if (strcmp (temp_string, "33") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the fourth point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &face->p3->z0);
-                }
-                else if ((strcmp (temp_string, "38") == 0))
-                {
-                        /* Now follows a string containing the
-                         * elevation. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &face->elevation);
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &face->thickness);
-                }
-                else if (strcmp (temp_string, "48") == 0)
-                {
-                        /* Now follows a string containing the linetype
-                         * scale. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &face->linetype_scale);
-                }
-                else if (strcmp (temp_string, "60") == 0)
-                {
-                        /* Now follows a string containing the
-                         * visibility value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &face->visibility);
-                }
-                else if (strcmp (temp_string, "62") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &face->color);
-                }
-                else if (strcmp (temp_string, "67") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &face->paperspace);
-                }
-                else if (strcmp (temp_string, "70") == 0)
-                {
-                        /* Now follows a string containing the
-                         * value of edge visibility flag. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &face->flag);
-                }
-                else if (strcmp (temp_string, "92") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing the
-                         * graphics data size value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &face->graphics_data_size);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else if (strcmp (temp_string, "100") == 0)
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if ((strcmp (temp_string, "AcDbEntity") != 0)
-                        && (strcmp (temp_string, "AcDbFace") != 0))
-                        {
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                face->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 6:
+                                /* Now follows a string containing a linetype
+                                 * name. */
+                                dxf_lexer_free_string (fp, properties.linetype);
+                                properties.linetype = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 8:
+                                /* Now follows a string containing a layer name. */
+                                dxf_lexer_free_string (fp, properties.layer);
+                                properties.layer = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 10:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the first point. */
+                                face->p0->x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 20:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the first point. */
+                                face->p0->y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 30:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of first the point. */
+                                face->p0->z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 11:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the second point. */
+                                face->p1->x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 21:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the second point. */
+                                face->p1->y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 31:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the second point. */
+                                face->p1->z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 12:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the third point. */
+                                face->p2->x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 22:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the third point. */
+                                face->p2->y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 32:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the third point. */
+                                face->p2->z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 13:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the fourth point. */
+                                face->p3->x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 23:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the fourth point. */
+                                face->p3->y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 33:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the fourth point. */
+                                face->p3->z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 38:
+                                /* Now follows a string containing the
+                                 * elevation. */
+                                properties.elevation = dxf_pair_get_double (&pair);
+                                break;
+                        case 39:
+                                /* Now follows a string containing the
+                                 * thickness. */
+                                properties.thickness = dxf_pair_get_double (&pair);
+                                break;
+                        case 48:
+                                /* Now follows a string containing the linetype
+                                 * scale. */
+                                properties.linetype_scale = dxf_pair_get_double (&pair);
+                                break;
+                        case 60:
+                                /* Now follows a string containing the
+                                 * visibility value. */
+                                properties.visibility = dxf_pair_get_int (&pair);
+                                break;
+                        case 62:
+                                /* Now follows a string containing the
+                                 * color value. */
+                                properties.color = dxf_pair_get_int (&pair);
+                                break;
+                        case 67:
+                                /* Now follows a string containing the
+                                 * paperspace value. */
+                                properties.paperspace = dxf_pair_get_int (&pair);
+                                break;
+                        case 70:
+                                /* Now follows a string containing the
+                                 * value of edge visibility flag. */
+                                face->flag = dxf_pair_get_int (&pair);
+                                break;
+                        case 92:
+                                /* Now follows a string containing the
+                                 * graphics data size value. */
+                                face->graphics_data_size = dxf_pair_get_int (&pair);
+                                break;
+                        case 100:
+                                /* Now follows a string containing the
+                                 * subclass marker value. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                if ((strcmp (temp_string, "AcDbEntity") != 0)
+                                && (strcmp (temp_string, "AcDbFace") != 0))
+                                {
+                                        fprintf (stderr,
+                                          (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                }
+                                break;
+                        case 160:
+                                /* Now follows a string containing the
+                                 * graphics data size value. */
+                                face->graphics_data_size = dxf_pair_get_int (&pair);
+                                break;
+                        case 284:
+                                /* Now follows a string containing the shadow
+                                 * mode value. */
+                                properties.shadow_mode = dxf_pair_get_int (&pair);
+                                break;
+                        case 310:
+                                /* Now follows a string containing binary
+                                 * graphics data. */
+                                binary_graphics_data = dxf_binary_graphics_data_append_line
+                                  (binary_graphics_data,
+                                  dxf_pair_get_string (&pair));
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, face->dictionary_owner_soft);
+                                face->dictionary_owner_soft = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 347:
+                                /* Now follows a string containing a
+                                 * hard-pointer ID/handle to material object. */
+                                dxf_lexer_free_string (fp, properties.material);
+                                properties.material = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, face->dictionary_owner_hard);
+                                face->dictionary_owner_hard = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 370:
+                                /* Now follows a string containing the lineweight
+                                 * value. */
+                                properties.lineweight = dxf_pair_get_int (&pair);
+                                break;
+                        case 390:
+                                /* Now follows a string containing a plot style
+                                 * name value. */
+                                dxf_lexer_free_string (fp, properties.plot_style_name);
+                                properties.plot_style_name = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 420:
+                                /* Now follows a string containing a color value. */
+                                properties.color_value = dxf_pair_get_long (&pair);
+                                break;
+                        case 430:
+                                /* Now follows a string containing a color
+                                 * name value. */
+                                dxf_lexer_free_string (fp, properties.color_name);
+                                properties.color_name = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 440:
+                                /* Now follows a string containing a transparency
+                                 * value. */
+                                properties.transparency = dxf_pair_get_long (&pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, (_("DXF comment: %s\n")), temp_string);
+                                break;
+                        default:
                                 fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
                                   __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "160") == 0)
-                {
-                        /* Now follows a string containing the
-                         * graphics data size value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &face->graphics_data_size);
-                }
-                else if (strcmp (temp_string, "284") == 0)
-                {
-                        /* Now follows a string containing the shadow
-                         * mode value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &face->shadow_mode);
-                }
-                else if (strcmp (temp_string, "310") == 0)
-                {
-                        /* Now follows a string containing binary
-                         * graphics data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", face->binary_graphics_data->data_line);
-                        dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) face->binary_graphics_data->next);
-                        face->binary_graphics_data = (DxfBinaryGraphicsData *) face->binary_graphics_data->next;
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", face->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "347") == 0)
-                {
-                        /* Now follows a string containing a
-                         * hard-pointer ID/handle to material object. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", face->material);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", face->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "370") == 0)
-                {
-                        /* Now follows a string containing the lineweight
-                         * value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &face->lineweight);
-                }
-                else if (strcmp (temp_string, "390") == 0)
-                {
-                        /* Now follows a string containing a plot style
-                         * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", face->plot_style_name);
-                }
-                else if (strcmp (temp_string, "420") == 0)
-                {
-                        /* Now follows a string containing a color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%ld\n", &face->color_value);
-                }
-                else if (strcmp (temp_string, "430") == 0)
-                {
-                        /* Now follows a string containing a color
-                         * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", face->color_name);
-                }
-                else if (strcmp (temp_string, "440") == 0)
-                {
-                        /* Now follows a string containing a transparency
-                         * value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%ld\n", &face->transparency);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, (_("DXF comment: %s\n")), temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
         /* Handle omitted members and/or illegal values. */
-        if (strcmp (face->linetype, "") == 0)
+        if ((properties.linetype != NULL)
+          && (strcmp (properties.linetype, "") == 0))
         {
-                face->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_lexer_free_string (fp, properties.linetype);
+                properties.linetype = dxf_strdup (DXF_DEFAULT_LINETYPE);
         }
-        if (strcmp (face->layer, "") == 0)
+        if ((properties.layer != NULL)
+          && (strcmp (properties.layer, "") == 0))
         {
-                face->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_lexer_free_string (fp, properties.layer);
+                properties.layer = dxf_strdup (DXF_DEFAULT_LAYER);
         }
-        /* Clean up. */
-        free (temp_string);
+        /* Entities with equal properties share a record. */
+        dxf_graphic_properties_finish (fp, &face->properties, &properties);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -518,10 +446,10 @@ dxf_3dface_write
                 /*!< a pointer to a DXF \c 3DFACE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *dxf_entity_name = strdup ("3DFACE");
+        char *dxf_entity_name = dxf_strdup ("3DFACE");
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -530,7 +458,7 @@ dxf_3dface_write
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (face == NULL)
@@ -539,35 +467,35 @@ dxf_3dface_write
                   (_("Error in %s () a NULL pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if ((strcmp (dxf_3dface_get_layer (face), "") == 0)
           || (dxf_3dface_get_layer (face) == NULL))
         {
                 fprintf (stderr,
-                  (_("Warning in %s () invalid layer string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () invalid layer string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_3dface_get_id_code (face));
                 fprintf (stderr,
                   (_("\t%s entity is relocated to layer 0")),
                   dxf_entity_name);
-                dxf_3dface_set_layer (face, strdup (DXF_DEFAULT_LAYER));
+                dxf_3dface_set_layer (face, DXF_DEFAULT_LAYER);
         }
         if (dxf_3dface_get_linetype (face) == NULL)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () invalid linetype string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () invalid linetype string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_3dface_get_id_code (face));
                 fprintf (stderr,
                   (_("\t%s linetype is set to %s\n")),
                   dxf_entity_name, DXF_DEFAULT_LINETYPE);
-                dxf_3dface_set_linetype (face, strdup (DXF_DEFAULT_LINETYPE));
+                dxf_3dface_set_linetype (face, DXF_DEFAULT_LINETYPE);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
-        if (dxf_3dface_get_id_code (face) != -1)
+        dxf_write_string (fp, 0, dxf_entity_name);
+        if (face->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", dxf_3dface_get_id_code (face));
+                dxf_write_hex (fp, 5, dxf_3dface_get_id_code (face));
         }
         /*!
          * \todo for version R14.\n
@@ -582,69 +510,69 @@ dxf_3dface_write
         if ((strcmp (dxf_3dface_get_dictionary_owner_soft (face), "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", dxf_3dface_get_dictionary_owner_soft (face));
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, dxf_3dface_get_dictionary_owner_soft (face));
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (dxf_3dface_get_dictionary_owner_hard (face), "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", dxf_3dface_get_dictionary_owner_hard (face));
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, dxf_3dface_get_dictionary_owner_hard (face));
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbEntity\n");
+                dxf_write_string (fp, 100, "AcDbEntity");
         }
         if (dxf_3dface_get_paperspace (face) == DXF_PAPERSPACE)
         {
-                fprintf (fp->fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_int (fp, 67, DXF_PAPERSPACE);
         }
-        fprintf (fp->fp, "  8\n%s\n", dxf_3dface_get_layer (face));
+        dxf_write_string (fp, 8, dxf_3dface_get_layer (face));
         if (strcmp (dxf_3dface_get_linetype (face), DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp->fp, "  6\n%s\n", dxf_3dface_get_linetype (face));
+                dxf_write_string (fp, 6, dxf_3dface_get_linetype (face));
         }
         if ((fp->acad_version_number >= AutoCAD_2008)
           && (strcmp (dxf_3dface_get_material (face), "") != 0))
         {
-                fprintf (fp->fp, "347\n%s\n", dxf_3dface_get_material (face));
+                dxf_write_string (fp, 347, dxf_3dface_get_material (face));
         }
         if (dxf_3dface_get_color (face) != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp->fp, " 62\n%d\n", dxf_3dface_get_color (face));
+                dxf_write_int (fp, 62, dxf_3dface_get_color (face));
         }
         if (fp->acad_version_number >= AutoCAD_2002)
         {
-                fprintf (fp->fp, "370\n%d\n", dxf_3dface_get_lineweight (face));
+                dxf_write_int (fp, 370, dxf_3dface_get_lineweight (face));
         }
         if ((fp->acad_version_number <= AutoCAD_11)
           && DXF_FLATLAND
           && (dxf_3dface_get_elevation (face) != 0.0))
         {
-                fprintf (fp->fp, " 38\n%f\n", dxf_3dface_get_elevation (face));
+                dxf_write_double (fp, 38, dxf_3dface_get_elevation (face));
         }
         if ((fp->acad_version_number <= AutoCAD_13)
           && (dxf_3dface_get_thickness (face) != 0.0))
         {
-                fprintf (fp->fp, " 39\n%f\n", dxf_3dface_get_thickness (face));
+                dxf_write_double (fp, 39, dxf_3dface_get_thickness (face));
         }
         if (dxf_3dface_get_linetype_scale (face) != 1.0)
         {
-                fprintf (fp->fp, " 48\n%f\n", dxf_3dface_get_linetype_scale (face));
+                dxf_write_double (fp, 48, dxf_3dface_get_linetype_scale (face));
         }
         if (dxf_3dface_get_visibility (face) != 0)
         {
-                fprintf (fp->fp, " 60\n%d\n", dxf_3dface_get_visibility (face));
+                dxf_write_int (fp, 60, dxf_3dface_get_visibility (face));
         }
         if ((fp->acad_version_number >= AutoCAD_2000)
           && (dxf_3dface_get_graphics_data_size (face) > 0))
         {
 #ifdef BUILD_64
-                fprintf (fp->fp, "160\n%d\n", dxf_3dface_get_graphics_data_size (face));
+                dxf_write_int (fp, 160, dxf_3dface_get_graphics_data_size (face));
 #else
-                fprintf (fp->fp, " 92\n%d\n", dxf_3dface_get_graphics_data_size (face));
+                dxf_write_int (fp, 92, dxf_3dface_get_graphics_data_size (face));
 #endif
                 if (dxf_3dface_get_binary_graphics_data (face) != NULL)
                 {
@@ -652,42 +580,42 @@ dxf_3dface_write
                         iter = dxf_3dface_get_binary_graphics_data (face);
                         while (iter != NULL)
                         {
-                                fprintf (fp->fp, "310\n%s\n", dxf_binary_graphics_data_get_data_line (iter));
+                                dxf_write_string (fp, 310, dxf_binary_graphics_data_get_data_line (iter));
                                 iter = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_get_next (iter);
                         }
                 }
         }
         if (fp->acad_version_number >= AutoCAD_2004)
         {
-                fprintf (fp->fp, "420\n%ld\n", dxf_3dface_get_color_value (face));
-                fprintf (fp->fp, "430\n%s\n", dxf_3dface_get_color_name (face));
-                fprintf (fp->fp, "440\n%ld\n", dxf_3dface_get_transparency (face));
+                dxf_write_long (fp, 420, dxf_3dface_get_color_value (face));
+                dxf_write_string (fp, 430, dxf_3dface_get_color_name (face));
+                dxf_write_long (fp, 440, dxf_3dface_get_transparency (face));
         }
         if (fp->acad_version_number >= AutoCAD_2009)
         {
-                fprintf (fp->fp, "390\n%s\n", dxf_3dface_get_plot_style_name (face));
-                fprintf (fp->fp, "284\n%d\n", dxf_3dface_get_shadow_mode (face));
+                dxf_write_string (fp, 390, dxf_3dface_get_plot_style_name (face));
+                dxf_write_int (fp, 284, dxf_3dface_get_shadow_mode (face));
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbFace\n");
-        }
-        fprintf (fp->fp, " 10\n%f\n", dxf_3dface_get_x0 (face));
-        fprintf (fp->fp, " 20\n%f\n", dxf_3dface_get_y0 (face));
-        fprintf (fp->fp, " 30\n%f\n", dxf_3dface_get_z0 (face));
-        fprintf (fp->fp, " 11\n%f\n", dxf_3dface_get_x1 (face));
-        fprintf (fp->fp, " 21\n%f\n", dxf_3dface_get_y1 (face));
-        fprintf (fp->fp, " 31\n%f\n", dxf_3dface_get_z1 (face));
-        fprintf (fp->fp, " 12\n%f\n", dxf_3dface_get_x2 (face));
-        fprintf (fp->fp, " 22\n%f\n", dxf_3dface_get_y2 (face));
-        fprintf (fp->fp, " 32\n%f\n", dxf_3dface_get_z2 (face));
-        fprintf (fp->fp, " 13\n%f\n", dxf_3dface_get_x3 (face));
-        fprintf (fp->fp, " 23\n%f\n", dxf_3dface_get_y3 (face));
-        fprintf (fp->fp, " 33\n%f\n", dxf_3dface_get_z3 (face));
-        fprintf (fp->fp, " 70\n%d\n", dxf_3dface_get_flag (face));
+                dxf_write_string (fp, 100, "AcDbFace");
+        }
+        dxf_write_double (fp, 10, dxf_3dface_get_x0 (face));
+        dxf_write_double (fp, 20, dxf_3dface_get_y0 (face));
+        dxf_write_double (fp, 30, dxf_3dface_get_z0 (face));
+        dxf_write_double (fp, 11, dxf_3dface_get_x1 (face));
+        dxf_write_double (fp, 21, dxf_3dface_get_y1 (face));
+        dxf_write_double (fp, 31, dxf_3dface_get_z1 (face));
+        dxf_write_double (fp, 12, dxf_3dface_get_x2 (face));
+        dxf_write_double (fp, 22, dxf_3dface_get_y2 (face));
+        dxf_write_double (fp, 32, dxf_3dface_get_z2 (face));
+        dxf_write_double (fp, 13, dxf_3dface_get_x3 (face));
+        dxf_write_double (fp, 23, dxf_3dface_get_y3 (face));
+        dxf_write_double (fp, 33, dxf_3dface_get_z3 (face));
+        dxf_write_int (fp, 70, dxf_3dface_get_flag (face));
         /* Clean up. */
-        free (dxf_entity_name);
-#ifdef DEBUG
+        dxf_free (dxf_entity_name);
+#if DEBUG
         DXF_DEBUG_END
 #endif
         return (EXIT_SUCCESS);
@@ -709,7 +637,7 @@ dxf_3dface_free
                  * \c 3DFACE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (face == NULL)
@@ -726,21 +654,17 @@ dxf_3dface_free
                 __FUNCTION__);
               return (face);
         }
-        free (dxf_3dface_get_linetype (face));
-        free (dxf_3dface_get_layer (face));
+        dxf_graphic_properties_free (face->properties);
         dxf_binary_graphics_data_free_chain (dxf_3dface_get_binary_graphics_data (face));
-        free (dxf_3dface_get_dictionary_owner_soft (face));
-        free (dxf_3dface_get_material (face));
-        free (dxf_3dface_get_dictionary_owner_hard (face));
-        free (dxf_3dface_get_plot_style_name (face));
-        free (dxf_3dface_get_color_name (face));
+        dxf_free (face->dictionary_owner_soft);
+        dxf_free (face->dictionary_owner_hard);
         dxf_point_free (dxf_3dface_get_p0 (face));
         dxf_point_free (dxf_3dface_get_p1 (face));
         dxf_point_free (dxf_3dface_get_p2 (face));
         dxf_point_free (dxf_3dface_get_p3 (face));
-        free (face);
+        dxf_free (face);
         face = NULL;
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_END
 #endif
         return (face);
@@ -758,7 +682,7 @@ dxf_3dface_free_chain
                 /*!< a pointer to the chain of DXF \c 3DFACE entities. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (faces == NULL)
@@ -784,7 +708,7 @@ dxf_3dface_free_chain
  *
  * \return \c id_code.
  */
-int
+long
 dxf_3dface_get_id_code
 (
         Dxf3dface *face
@@ -826,7 +750,7 @@ dxf_3dface_set_id_code
 (
         Dxf3dface *face,
                 /*!< a pointer to a DXF \c 3DFACE entity. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -881,7 +805,7 @@ dxf_3dface_get_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        if (face->linetype ==  NULL)
+        if (face->properties->linetype ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found.\n")),
@@ -891,7 +815,7 @@ dxf_3dface_get_linetype
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (face->linetype));
+        return (dxf_strdup (face->properties->linetype));
 }
 
 
@@ -931,7 +855,12 @@ dxf_3dface_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        face->linetype = strdup (linetype);
+        if (dxf_graphic_properties_unshare (&face->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (face->properties->linetype);
+        face->properties->linetype = dxf_strdup (linetype);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -963,7 +892,7 @@ dxf_3dface_get_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        if (face->layer ==  NULL)
+        if (face->properties->layer ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found.\n")),
@@ -973,7 +902,7 @@ dxf_3dface_get_layer
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (face->layer));
+        return (dxf_strdup (face->properties->layer));
 }
 
 
@@ -1012,7 +941,12 @@ dxf_3dface_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        face->layer = strdup (layer);
+        if (dxf_graphic_properties_unshare (&face->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (face->properties->layer);
+        face->properties->layer = dxf_strdup (layer);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1046,7 +980,7 @@ dxf_3dface_get_elevation
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (face->elevation);
+        return (face->properties->elevation);
 }
 
 
@@ -1076,7 +1010,11 @@ dxf_3dface_set_elevation
                   __FUNCTION__);
                 return (NULL);
         }
-        face->elevation = elevation;
+        if (dxf_graphic_properties_unshare (&face->properties) == NULL)
+        {
+                return (NULL);
+        }
+        face->properties->elevation = elevation;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1107,7 +1045,7 @@ dxf_3dface_get_thickness
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (face->thickness < 0.0)
+        if (face->properties->thickness < 0.0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found.\n")),
@@ -1116,7 +1054,7 @@ dxf_3dface_get_thickness
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (face->thickness);
+        return (face->properties->thickness);
 }
 
 
@@ -1152,7 +1090,11 @@ dxf_3dface_set_thickness
                   (_("Warning in %s () a negative value was passed.\n")),
                   __FUNCTION__);
         }
-        face->thickness = thickness;
+        if (dxf_graphic_properties_unshare (&face->properties) == NULL)
+        {
+                return (NULL);
+        }
+        face->properties->thickness = thickness;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1183,7 +1125,7 @@ dxf_3dface_get_linetype_scale
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (face->linetype_scale < 0.0)
+        if (face->properties->linetype_scale < 0.0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found.\n")),
@@ -1192,7 +1134,7 @@ dxf_3dface_get_linetype_scale
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (face->linetype_scale);
+        return (face->properties->linetype_scale);
 }
 
 
@@ -1228,7 +1170,11 @@ dxf_3dface_set_linetype_scale
                   (_("Warning in %s () a negative value was passed.\n")),
                   __FUNCTION__);
         }
-        face->linetype_scale = linetype_scale;
+        if (dxf_graphic_properties_unshare (&face->properties) == NULL)
+        {
+                return (NULL);
+        }
+        face->properties->linetype_scale = linetype_scale;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1259,14 +1205,14 @@ dxf_3dface_get_visibility
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (face->visibility < 0)
+        if (face->properties->visibility < 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (face->visibility > 1)
+        if (face->properties->visibility > 1)
         {
                 fprintf (stderr,
                   (_("Error in %s () an out of range value was found.\n")),
@@ -1276,7 +1222,7 @@ dxf_3dface_get_visibility
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (face->visibility);
+        return (face->properties->visibility);
 }
 
 
@@ -1320,7 +1266,11 @@ dxf_3dface_set_visibility
                   __FUNCTION__);
                 return (NULL);
         }
-        face->visibility = visibility;
+        if (dxf_graphic_properties_unshare (&face->properties) == NULL)
+        {
+                return (NULL);
+        }
+        face->properties->visibility = visibility;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1351,7 +1301,7 @@ dxf_3dface_get_color
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (face->color < 0)
+        if (face->properties->color < 0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found.\n")),
@@ -1360,7 +1310,7 @@ dxf_3dface_get_color
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (face->color);
+        return (face->properties->color);
 }
 
 
@@ -1396,7 +1346,11 @@ dxf_3dface_set_color
                   (_("Warning in %s () a negative value was passed.\n")),
                   __FUNCTION__);
         }
-        face->color = color;
+        if (dxf_graphic_properties_unshare (&face->properties) == NULL)
+        {
+                return (NULL);
+        }
+        face->properties->color = color;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1427,13 +1381,13 @@ dxf_3dface_get_paperspace
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (face->paperspace < 0)
+        if (face->properties->paperspace < 0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found.\n")),
                   __FUNCTION__);
         }
-        if (face->paperspace > 1)
+        if (face->properties->paperspace > 1)
         {
                 fprintf (stderr,
                   (_("Warning in %s () an out of range value was found.\n")),
@@ -1442,7 +1396,7 @@ dxf_3dface_get_paperspace
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (face->paperspace);
+        return (face->properties->paperspace);
 }
 
 
@@ -1486,7 +1440,11 @@ dxf_3dface_set_paperspace
                   __FUNCTION__);
                 return (NULL);
         }
-        face->paperspace = paperspace;
+        if (dxf_graphic_properties_unshare (&face->properties) == NULL)
+        {
+                return (NULL);
+        }
+        face->properties->paperspace = paperspace;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1610,14 +1568,14 @@ dxf_3dface_get_shadow_mode
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (face->shadow_mode < 0)
+        if (face->properties->shadow_mode < 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (face->shadow_mode > 3)
+        if (face->properties->shadow_mode > 3)
         {
                 fprintf (stderr,
                   (_("Error in %s () an out of range value was found.\n")),
@@ -1627,7 +1585,7 @@ dxf_3dface_get_shadow_mode
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (face->shadow_mode);
+        return (face->properties->shadow_mode);
 }
 
 
@@ -1671,7 +1629,11 @@ dxf_3dface_set_shadow_mode
                   __FUNCTION__);
                 return (NULL);
         }
-        face->shadow_mode = shadow_mode;
+        if (dxf_graphic_properties_unshare (&face->properties) == NULL)
+        {
+                return (NULL);
+        }
+        face->properties->shadow_mode = shadow_mode;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1795,7 +1757,7 @@ dxf_3dface_get_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (face->dictionary_owner_soft));
+        return (dxf_strdup (face->dictionary_owner_soft));
 }
 
 
@@ -1831,7 +1793,7 @@ dxf_3dface_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        face->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        face->dictionary_owner_soft = dxf_strdup (dictionary_owner_soft);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1865,7 +1827,7 @@ dxf_3dface_get_material
                   __FUNCTION__);
                 return (NULL);
         }
-        if (face->material ==  NULL)
+        if (face->properties->material ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found.\n")),
@@ -1875,7 +1837,7 @@ dxf_3dface_get_material
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (face->material));
+        return (dxf_strdup (face->properties->material));
 }
 
 
@@ -1913,7 +1875,12 @@ dxf_3dface_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        face->material = strdup (material);
+        if (dxf_graphic_properties_unshare (&face->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (face->properties->material);
+        face->properties->material = dxf_strdup (material);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1957,7 +1924,7 @@ dxf_3dface_get_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (face->dictionary_owner_hard));
+        return (dxf_strdup (face->dictionary_owner_hard));
 }
 
 
@@ -1996,7 +1963,7 @@ dxf_3dface_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        face->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        face->dictionary_owner_hard = dxf_strdup (dictionary_owner_hard);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2031,7 +1998,7 @@ dxf_3dface_get_lineweight
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (face->lineweight);
+        return (face->properties->lineweight);
 }
 
 
@@ -2061,7 +2028,11 @@ dxf_3dface_set_lineweight
                   __FUNCTION__);
                 return (NULL);
         }
-        face->lineweight = lineweight;
+        if (dxf_graphic_properties_unshare (&face->properties) == NULL)
+        {
+                return (NULL);
+        }
+        face->properties->lineweight = lineweight;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2093,7 +2064,7 @@ dxf_3dface_get_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        if (face->plot_style_name ==  NULL)
+        if (face->properties->plot_style_name ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found.\n")),
@@ -2103,7 +2074,7 @@ dxf_3dface_get_plot_style_name
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (face->plot_style_name));
+        return (dxf_strdup (face->properties->plot_style_name));
 }
 
 
@@ -2141,7 +2112,12 @@ dxf_3dface_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        face->plot_style_name = strdup (plot_style_name);
+        if (dxf_graphic_properties_unshare (&face->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (face->properties->plot_style_name);
+        face->properties->plot_style_name = dxf_strdup (plot_style_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2176,7 +2152,7 @@ dxf_3dface_get_color_value
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (face->color_value);
+        return (face->properties->color_value);
 }
 
 
@@ -2206,7 +2182,11 @@ dxf_3dface_set_color_value
                   __FUNCTION__);
                 return (NULL);
         }
-        face->color_value = color_value;
+        if (dxf_graphic_properties_unshare (&face->properties) == NULL)
+        {
+                return (NULL);
+        }
+        face->properties->color_value = color_value;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2238,7 +2218,7 @@ dxf_3dface_get_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        if (face->color_name ==  NULL)
+        if (face->properties->color_name ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found.\n")),
@@ -2248,7 +2228,7 @@ dxf_3dface_get_color_name
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (face->color_name));
+        return (dxf_strdup (face->properties->color_name));
 }
 
 
@@ -2286,7 +2266,12 @@ dxf_3dface_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        face->color_name = strdup (color_name);
+        if (dxf_graphic_properties_unshare (&face->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (face->properties->color_name);
+        face->properties->color_name = dxf_strdup (color_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2321,7 +2306,7 @@ dxf_3dface_get_transparency
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (face->transparency);
+        return (face->properties->transparency);
 }
 
 
@@ -2351,7 +2336,11 @@ dxf_3dface_set_transparency
                   __FUNCTION__);
                 return (NULL);
         }
-        face->transparency = transparency;
+        if (dxf_graphic_properties_unshare (&face->properties) == NULL)
+        {
+                return (NULL);
+        }
+        face->properties->transparency = transparency;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2371,7 +2360,7 @@ dxf_3dface_get_p0
                 /*!< a pointer to a DXF \c 3DFACE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2411,7 +2400,7 @@ dxf_3dface_set_p0
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2450,7 +2439,7 @@ dxf_3dface_get_x0
                 /*!< a pointer to a DXF \c 3DFACE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2493,7 +2482,7 @@ dxf_3dface_set_x0
                  * \c 3DFACE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2532,7 +2521,7 @@ dxf_3dface_get_y0
                 /*!< a pointer to a DXF \c 3DFACE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2575,7 +2564,7 @@ dxf_3dface_set_y0
                  * \c 3DFACE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2614,7 +2603,7 @@ dxf_3dface_get_z0
                 /*!< a pointer to a DXF \c 3DFACE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2657,7 +2646,7 @@ dxf_3dface_set_z0
                  * \c 3DFACE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2695,7 +2684,7 @@ dxf_3dface_get_p1
                 /*!< a pointer to a DXF \c 3DFACE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2735,7 +2724,7 @@ dxf_3dface_set_p1
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2774,7 +2763,7 @@ dxf_3dface_get_x1
                 /*!< a pointer to a DXF \c 3DFACE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2817,7 +2806,7 @@ dxf_3dface_set_x1
                  * DXF \c 3DFACE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2856,7 +2845,7 @@ dxf_3dface_get_y1
                 /*!< a pointer to a DXF \c 3DFACE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2899,7 +2888,7 @@ dxf_3dface_set_y1
                  * DXF \c 3DFACE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2938,7 +2927,7 @@ dxf_3dface_get_z1
                 /*!< a pointer to a DXF \c 3DFACE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2981,7 +2970,7 @@ dxf_3dface_set_z1
                  * DXF \c 3DFACE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3019,7 +3008,7 @@ dxf_3dface_get_p2
                 /*!< a pointer to a DXF \c 3DFACE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3059,7 +3048,7 @@ dxf_3dface_set_p2
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3098,7 +3087,7 @@ dxf_3dface_get_x2
                 /*!< a pointer to a DXF \c 3DFACE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3141,7 +3130,7 @@ dxf_3dface_set_x2
                  * a DXF \c 3DFACE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3180,7 +3169,7 @@ dxf_3dface_get_y2
                 /*!< a pointer to a DXF \c 3DFACE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3223,7 +3212,7 @@ dxf_3dface_set_y2
                  * a DXF \c 3DFACE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3262,7 +3251,7 @@ dxf_3dface_get_z2
                 /*!< a pointer to a DXF \c 3DFACE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3305,7 +3294,7 @@ dxf_3dface_set_z2
                  * a DXF \c 3DFACE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3343,7 +3332,7 @@ dxf_3dface_get_p3
                 /*!< a pointer to a DXF \c 3DFACE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3383,7 +3372,7 @@ dxf_3dface_set_p3
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3422,7 +3411,7 @@ dxf_3dface_get_x3
                 /*!< a pointer to a DXF \c 3DFACE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3465,7 +3454,7 @@ dxf_3dface_set_x3
                  * DXF \c 3DFACE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3504,7 +3493,7 @@ dxf_3dface_get_y3
                 /*!< a pointer to a DXF \c 3DFACE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3547,7 +3536,7 @@ dxf_3dface_set_y3
                  * DXF \c 3DFACE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3586,7 +3575,7 @@ dxf_3dface_get_z3
                 /*!< a pointer to a DXF \c 3DFACE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3629,7 +3618,7 @@ dxf_3dface_set_z3
                  * DXF \c 3DFACE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3882,7 +3871,7 @@ dxf_3dface_create_from_points
                 /*!< a pointer to a DXF \c POINT entity. */
         DxfPoint *p3,
                 /*!< a pointer to a DXF \c POINT entity. */
-        int id_code,
+        long id_code,
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -3899,7 +3888,7 @@ dxf_3dface_create_from_points
                  */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         Dxf3dface *face = NULL;
@@ -3940,6 +3929,16 @@ dxf_3dface_create_from_points
                 __FUNCTION__);
               return (NULL);
         }
+        /* The inherited properties are set in a record of its own. */
+        if ((inheritance != 0)
+          && (dxf_graphic_properties_unshare (&face->properties) == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                dxf_3dface_free (face);
+                return (NULL);
+        }
         if (p1 != NULL)
         {
                 face->p0 = (DxfPoint *) p0;
@@ -3966,26 +3965,26 @@ dxf_3dface_create_from_points
                         {
                                 break;
                         }
-                        if (p0->linetype != NULL)
+                        if (p0->properties->linetype != NULL)
                         {
-                                face->linetype = strdup (p0->linetype);
+                                dxf_3dface_set_linetype (face, p0->properties->linetype);
                         }
-                        if (p0->layer != NULL)
+                        if (p0->properties->layer != NULL)
                         {
-                                face->layer = strdup (p0->layer);
+                                dxf_3dface_set_layer (face, p0->properties->layer);
                         }
-                        face->thickness = p0->thickness;
-                        face->linetype_scale = p0->linetype_scale;
-                        face->visibility = p0->visibility;
-                        face->color = p0->color;
-                        face->paperspace = p0->paperspace;
+                        face->properties->thickness = p0->properties->thickness;
+                        face->properties->linetype_scale = p0->properties->linetype_scale;
+                        face->properties->visibility = p0->properties->visibility;
+                        face->properties->color = p0->properties->color;
+                        face->properties->paperspace = p0->properties->paperspace;
                         if (p0->dictionary_owner_soft != NULL)
                         {
-                                face->dictionary_owner_soft = strdup (p0->dictionary_owner_soft);
+                                face->dictionary_owner_soft = dxf_strdup (p0->dictionary_owner_soft);
                         }
                         if (p0->dictionary_owner_hard != NULL)
                         {
-                                face->dictionary_owner_hard = strdup (p0->dictionary_owner_hard);
+                                face->dictionary_owner_hard = dxf_strdup (p0->dictionary_owner_hard);
                         }
                         break;
                 case 2:
@@ -3993,26 +3992,26 @@ dxf_3dface_create_from_points
                         {
                                 break;
                         }
-                        if (p1->linetype != NULL)
+                        if (p1->properties->linetype != NULL)
                         {
-                                face->linetype = strdup (p1->linetype);
+                                dxf_3dface_set_linetype (face, p1->properties->linetype);
                         }
-                        if (p1->layer != NULL)
+                        if (p1->properties->layer != NULL)
                         {
-                                face->layer = strdup (p1->layer);
+                                dxf_3dface_set_layer (face, p1->properties->layer);
                         }
-                        face->thickness = p1->thickness;
-                        face->linetype_scale = p1->linetype_scale;
-                        face->visibility = p1->visibility;
-                        face->color = p1->color;
-                        face->paperspace = p1->paperspace;
+                        face->properties->thickness = p1->properties->thickness;
+                        face->properties->linetype_scale = p1->properties->linetype_scale;
+                        face->properties->visibility = p1->properties->visibility;
+                        face->properties->color = p1->properties->color;
+                        face->properties->paperspace = p1->properties->paperspace;
                         if (p1->dictionary_owner_soft != NULL)
                         {
-                                face->dictionary_owner_soft = strdup (p1->dictionary_owner_soft);
+                                face->dictionary_owner_soft = dxf_strdup (p1->dictionary_owner_soft);
                         }
                         if (p1->dictionary_owner_hard != NULL)
                         {
-                                face->dictionary_owner_hard = strdup (p1->dictionary_owner_hard);
+                                face->dictionary_owner_hard = dxf_strdup (p1->dictionary_owner_hard);
                         }
                         break;
                 case 3:
@@ -4020,26 +4019,26 @@ dxf_3dface_create_from_points
                         {
                                 break;
                         }
-                        if (p2->linetype != NULL)
+                        if (p2->properties->linetype != NULL)
                         {
-                                face->linetype = strdup (p2->linetype);
+                                dxf_3dface_set_linetype (face, p2->properties->linetype);
                         }
-                        if (p2->layer != NULL)
+                        if (p2->properties->layer != NULL)
                         {
-                                face->layer = strdup (p2->layer);
+                                dxf_3dface_set_layer (face, p2->properties->layer);
                         }
-                        face->thickness = p2->thickness;
-                        face->linetype_scale = p2->linetype_scale;
-                        face->visibility = p2->visibility;
-                        face->color = p2->color;
-                        face->paperspace = p2->paperspace;
+                        face->properties->thickness = p2->properties->thickness;
+                        face->properties->linetype_scale = p2->properties->linetype_scale;
+                        face->properties->visibility = p2->properties->visibility;
+                        face->properties->color = p2->properties->color;
+                        face->properties->paperspace = p2->properties->paperspace;
                         if (p2->dictionary_owner_soft != NULL)
                         {
-                                face->dictionary_owner_soft = strdup (p2->dictionary_owner_soft);
+                                face->dictionary_owner_soft = dxf_strdup (p2->dictionary_owner_soft);
                         }
                         if (p2->dictionary_owner_hard != NULL)
                         {
-                                face->dictionary_owner_hard = strdup (p2->dictionary_owner_hard);
+                                face->dictionary_owner_hard = dxf_strdup (p2->dictionary_owner_hard);
                         }
                         break;
                 case 4:
@@ -4047,26 +4046,26 @@ dxf_3dface_create_from_points
                         {
                                 break;
                         }
-                        if (p3->linetype != NULL)
+                        if (p3->properties->linetype != NULL)
                         {
-                                face->linetype = strdup (p3->linetype);
+                                dxf_3dface_set_linetype (face, p3->properties->linetype);
                         }
-                        if (p3->layer != NULL)
+                        if (p3->properties->layer != NULL)
                         {
-                                face->layer = strdup (p3->layer);
+                                dxf_3dface_set_layer (face, p3->properties->layer);
                         }
-                        face->thickness = p3->thickness;
-                        face->linetype_scale = p3->linetype_scale;
-                        face->visibility = p3->visibility;
-                        face->color = p3->color;
-                        face->paperspace = p3->paperspace;
+                        face->properties->thickness = p3->properties->thickness;
+                        face->properties->linetype_scale = p3->properties->linetype_scale;
+                        face->properties->visibility = p3->properties->visibility;
+                        face->properties->color = p3->properties->color;
+                        face->properties->paperspace = p3->properties->paperspace;
                         if (p3->dictionary_owner_soft != NULL)
                         {
-                                face->dictionary_owner_soft = strdup (p3->dictionary_owner_soft);
+                                face->dictionary_owner_soft = dxf_strdup (p3->dictionary_owner_soft);
                         }
                         if (p3->dictionary_owner_hard != NULL)
                         {
-                                face->dictionary_owner_hard = strdup (p3->dictionary_owner_hard);
+                                face->dictionary_owner_hard = dxf_strdup (p3->dictionary_owner_hard);
                         }
                         break;
                 default:
@@ -42,6 +42,9 @@
 
 
 #include "3dline.h"
+#include "arena.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -64,7 +67,7 @@ dxf_3dline_new ()
         size = sizeof (Dxf3dline);
         /* avoid malloc of 0 bytes */
         if (size == 0) size = 1;
-        if ((line = malloc (size)) == NULL)
+        if ((line = dxf_malloc (size)) == NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () could not allocate memory.\n")),
@@ -115,8 +118,7 @@ dxf_3dline_init
               return (NULL);
         }
         dxf_3dline_set_id_code (line, 0);
-        dxf_3dline_set_linetype (line, strdup (DXF_DEFAULT_LINETYPE));
-        dxf_3dline_set_layer (line, strdup (DXF_DEFAULT_LAYER));
+        line->properties = dxf_graphic_properties_default ();
         dxf_3dline_set_p0 (line, dxf_point_new ());
         dxf_point_init ((DxfPoint *) dxf_3dline_get_p0 (line));
         dxf_3dline_set_x0 (line, 0.0);
@@ -130,24 +132,11 @@ dxf_3dline_init
         dxf_3dline_set_extr_x0 (line, 0.0);
         dxf_3dline_set_extr_y0 (line, 0.0);
         dxf_3dline_set_extr_z0 (line, 1.0);
-        dxf_3dline_set_elevation (line, 0.0);
-        dxf_3dline_set_thickness (line, 0.0);
-        dxf_3dline_set_linetype_scale (line, DXF_DEFAULT_LINETYPE_SCALE);
-        dxf_3dline_set_visibility (line, DXF_DEFAULT_VISIBILITY);
-        dxf_3dline_set_color (line, DXF_COLOR_BYLAYER);
-        dxf_3dline_set_paperspace (line, DXF_MODELSPACE);
         dxf_3dline_set_graphics_data_size (line, 0);
-        dxf_3dline_set_shadow_mode (line, 0);
         dxf_3dline_set_binary_graphics_data (line, (DxfBinaryGraphicsData *) dxf_binary_graphics_data_new ());
         dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) dxf_3dline_get_binary_graphics_data (line));
-        dxf_3dline_set_dictionary_owner_soft (line, strdup (""));
-        dxf_3dline_set_material (line, strdup (""));
-        dxf_3dline_set_dictionary_owner_hard (line, strdup (""));
-        dxf_3dline_set_lineweight (line, 0);
-        dxf_3dline_set_plot_style_name (line, strdup (""));
-        dxf_3dline_set_color_value (line, 0);
-        dxf_3dline_set_color_name (line, strdup (""));
-        dxf_3dline_set_transparency (line, 0);
+        dxf_3dline_set_dictionary_owner_soft (line, "");
+        dxf_3dline_set_dictionary_owner_hard (line, "");
         dxf_3dline_set_next (line, NULL);
 #if DEBUG
         DXF_DEBUG_END
@@ -179,7 +168,10 @@ dxf_3dline_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfGraphicProperties properties;
+        DxfPair pair;
+        DxfBinaryGraphicsData *binary_graphics_data = NULL;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -187,8 +179,6 @@ dxf_3dline_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (line == NULL)
@@ -199,269 +189,215 @@ dxf_3dline_read
                 line = dxf_3dline_new ();
                 line = dxf_3dline_init (line);
         }
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        binary_graphics_data = (DxfBinaryGraphicsData *) line->binary_graphics_data;
+        dxf_graphic_properties_start (&properties, line->properties);
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        fclose (fp->fp);
-                        /* Clean up. */
-                        free (temp_string);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &line->id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", line->linetype);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", line->layer);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the center point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &line->p0->x0);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the center point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &line->p0->y0);
-                }
-                else if (strcmp (temp_string, "30") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the center point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &line->p0->z0);
-                }
-                else if (strcmp (temp_string, "11") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the center point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &line->p1->x0);
-                }
-                else if (strcmp (temp_string, "21") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the center point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &line->p1->y0);
-                }
-                else if (strcmp (temp_string, "31") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the center point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &line->p1->z0);
-                }
-                else if (strcmp (temp_string, "38") == 0)
-                {
-                        /* Now follows a string containing the
-                         * elevation. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &line->elevation);
-                }
-                else if (strcmp (temp_string, "39") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &line->thickness);
-                }
-                else if (strcmp (temp_string, "48") == 0)
-                {
-                        /* Now follows a string containing the linetype
-                         * scale. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &line->linetype_scale);
-                }
-                else if (strcmp (temp_string, "60") == 0)
-                {
-                        /* Now follows a string containing the
-                         * visibility value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &line->visibility);
-                }
-                else if (strcmp (temp_string, "62") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &line->color);
-                }
-                else if (strcmp (temp_string, "67") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &line->paperspace);
-                }
-                else if (strcmp (temp_string, "92") == 0)
-                {
-                        /* Now follows a string containing the
-                         * graphics data size value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &line->graphics_data_size);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else if (strcmp (temp_string, "100") == 0)
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if ((strcmp (temp_string, "AcDbEntity") != 0)
-                        && ((strcmp (temp_string, "AcDbLine") != 0)))
-                        {
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                line->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 6:
+                                /* Now follows a string containing a linetype
+                                 * name. */
+                                dxf_lexer_free_string (fp, properties.linetype);
+                                properties.linetype = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 8:
+                                /* Now follows a string containing a layer name. */
+                                dxf_lexer_free_string (fp, properties.layer);
+                                properties.layer = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 10:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the center point. */
+                                line->p0->x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 20:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the center point. */
+                                line->p0->y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 30:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the center point. */
+                                line->p0->z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 11:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the center point. */
+                                line->p1->x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 21:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the center point. */
+                                line->p1->y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 31:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the center point. */
+                                line->p1->z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 38:
+                                /* Now follows a string containing the
+                                 * elevation. */
+                                properties.elevation = dxf_pair_get_double (&pair);
+                                break;
+                        case 39:
+                                /* Now follows a string containing the
+                                 * thickness. */
+                                properties.thickness = dxf_pair_get_double (&pair);
+                                break;
+                        case 48:
+                                /* Now follows a string containing the linetype
+                                 * scale. */
+                                properties.linetype_scale = dxf_pair_get_double (&pair);
+                                break;
+                        case 60:
+                                /* Now follows a string containing the
+                                 * visibility value. */
+                                properties.visibility = dxf_pair_get_int (&pair);
+                                break;
+                        case 62:
+                                /* Now follows a string containing the
+                                 * color value. */
+                                properties.color = dxf_pair_get_int (&pair);
+                                break;
+                        case 67:
+                                /* Now follows a string containing the
+                                 * paperspace value. */
+                                properties.paperspace = dxf_pair_get_int (&pair);
+                                break;
+                        case 92:
+                                /* Now follows a string containing the
+                                 * graphics data size value. */
+                                line->graphics_data_size = dxf_pair_get_int (&pair);
+                                break;
+                        case 100:
+                                /* Now follows a string containing the
+                                 * subclass marker value. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                if ((strcmp (temp_string, "AcDbEntity") != 0)
+                                && ((strcmp (temp_string, "AcDbLine") != 0)))
+                                {
+                                        fprintf (stderr,
+                                          (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                }
+                                break;
+                        case 160:
+                                /* Now follows a string containing the
+                                 * graphics data size value. */
+                                line->graphics_data_size = dxf_pair_get_int (&pair);
+                                break;
+                        case 210:
+                                /* Now follows a string containing the
+                                 * X-value of the extrusion vector. */
+                                line->extr_x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 220:
+                                /* Now follows a string containing the
+                                 * Y-value of the extrusion vector. */
+                                line->extr_y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 230:
+                                /* Now follows a string containing the
+                                 * Z-value of the extrusion vector. */
+                                line->extr_z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 284:
+                                /* Now follows a string containing the shadow
+                                 * mode value. */
+                                properties.shadow_mode = dxf_pair_get_int (&pair);
+                                break;
+                        case 310:
+                                /* Now follows a string containing binary
+                                 * graphics data. */
+                                binary_graphics_data = dxf_binary_graphics_data_append_line
+                                  (binary_graphics_data,
+                                  dxf_pair_get_string (&pair));
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, line->dictionary_owner_soft);
+                                line->dictionary_owner_soft = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 347:
+                                /* Now follows a string containing a
+                                 * hard-pointer ID/handle to material object. */
+                                dxf_lexer_free_string (fp, properties.material);
+                                properties.material = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, line->dictionary_owner_hard);
+                                line->dictionary_owner_hard = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 370:
+                                /* Now follows a string containing the lineweight
+                                 * value. */
+                                properties.lineweight = dxf_pair_get_int (&pair);
+                                break;
+                        case 390:
+                                /* Now follows a string containing a plot style
+                                 * name value. */
+                                dxf_lexer_free_string (fp, properties.plot_style_name);
+                                properties.plot_style_name = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 420:
+                                /* Now follows a string containing a color value. */
+                                properties.color_value = dxf_pair_get_long (&pair);
+                                break;
+                        case 430:
+                                /* Now follows a string containing a color
+                                 * name value. */
+                                dxf_lexer_free_string (fp, properties.color_name);
+                                properties.color_name = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 440:
+                                /* Now follows a string containing a transparency
+                                 * value. */
+                                properties.transparency = dxf_pair_get_long (&pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, "DXF comment: %s\n", temp_string);
+                                break;
+                        default:
                                 fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
                                   __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "160") == 0)
-                {
-                        /* Now follows a string containing the
-                         * graphics data size value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &line->graphics_data_size);
-                }
-                else if (strcmp (temp_string, "210") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &line->extr_x0);
-                }
-                else if (strcmp (temp_string, "220") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &line->extr_y0);
-                }
-                else if (strcmp (temp_string, "230") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &line->extr_z0);
-                }
-                else if (strcmp (temp_string, "284") == 0)
-                {
-                        /* Now follows a string containing the shadow
-                         * mode value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &line->shadow_mode);
-                }
-                else if (strcmp (temp_string, "310") == 0)
-                {
-                        /* Now follows a string containing binary
-                         * graphics data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", line->binary_graphics_data->data_line);
-                        dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) line->binary_graphics_data->next);
-                        line->binary_graphics_data = (DxfBinaryGraphicsData *) line->binary_graphics_data->next;
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", line->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "347") == 0)
-                {
-                        /* Now follows a string containing a
-                         * hard-pointer ID/handle to material object. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", line->material);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", line->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "370") == 0)
-                {
-                        /* Now follows a string containing the lineweight
-                         * value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &line->lineweight);
-                }
-                else if (strcmp (temp_string, "390") == 0)
-                {
-                        /* Now follows a string containing a plot style
-                         * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", line->plot_style_name);
-                }
-                else if (strcmp (temp_string, "420") == 0)
-                {
-                        /* Now follows a string containing a color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%ld\n", &line->color_value);
-                }
-                else if (strcmp (temp_string, "430") == 0)
-                {
-                        /* Now follows a string containing a color
-                         * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", line->color_name);
-                }
-                else if (strcmp (temp_string, "440") == 0)
-                {
-                        /* Now follows a string containing a transparency
-                         * value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%ld\n", &line->transparency);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
         /* Handle omitted members and/or illegal values. */
-        if (strcmp (line->linetype, "") == 0)
+        if ((properties.linetype != NULL)
+          && (strcmp (properties.linetype, "") == 0))
         {
-                line->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_lexer_free_string (fp, properties.linetype);
+                properties.linetype = dxf_strdup (DXF_DEFAULT_LINETYPE);
         }
-        if (strcmp (line->layer, "") == 0)
+        if ((properties.layer != NULL)
+          && (strcmp (properties.layer, "") == 0))
         {
-                line->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_lexer_free_string (fp, properties.layer);
+                properties.layer = dxf_strdup (DXF_DEFAULT_LAYER);
         }
-        /* Clean up. */
-        free (temp_string);
+        /* Entities with equal properties share a record. */
+        dxf_graphic_properties_finish (fp, &line->properties, &properties);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -491,7 +427,7 @@ dxf_3dline_write
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *dxf_entity_name = strdup ("3DLINE");
+        char *dxf_entity_name = dxf_strdup ("3DLINE");
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -500,7 +436,7 @@ dxf_3dline_write
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (line == NULL)
@@ -509,7 +445,7 @@ dxf_3dline_write
                   (_("Error in %s () a NULL pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if ((dxf_3dline_get_x0 (line) == dxf_3dline_get_x1 (line))
@@ -517,18 +453,18 @@ dxf_3dline_write
                 && (dxf_3dline_get_z0 (line) == dxf_3dline_get_z1 (line)))
         {
                 fprintf (stderr,
-                  (_("Error in %s () start point and end point are identical for the %s entity with id-code: %x\n")),
+                  (_("Error in %s () start point and end point are identical for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_3dline_get_id_code (line));
                 dxf_entity_skip (dxf_entity_name);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if ((strcmp (dxf_3dline_get_layer (line), "") == 0)
           || (dxf_3dline_get_layer (line) == NULL))
         {
                 fprintf (stderr,
-                  (_("Warning in %s () invalid layer string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () invalid layer string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_3dline_get_id_code (line));
                 fprintf (stderr,
                   (_("    %s entity is relocated to layer 0\n")),
@@ -538,7 +474,7 @@ dxf_3dline_write
         if (dxf_3dline_get_linetype (line) == NULL)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () invalid linetype string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () invalid linetype string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_3dline_get_id_code (line));
                 fprintf (stderr,
                   (_("\t%s linetype is set to %s\n")),
@@ -547,13 +483,13 @@ dxf_3dline_write
         }
         if (fp->acad_version_number > AutoCAD_11)
         {
-                dxf_entity_name = strdup ("LINE");
+                dxf_entity_name = dxf_strdup ("LINE");
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
-        if (dxf_3dline_get_id_code (line) != -1)
+        dxf_write_string (fp, 0, dxf_entity_name);
+        if (line->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", dxf_3dline_get_id_code (line));
+                dxf_write_hex (fp, 5, dxf_3dline_get_id_code (line));
         }
         /*!
          * \todo for version R14.\n
@@ -568,66 +504,66 @@ dxf_3dline_write
         if ((strcmp (dxf_3dline_get_dictionary_owner_soft (line), "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", dxf_3dline_get_dictionary_owner_soft (line));
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, dxf_3dline_get_dictionary_owner_soft (line));
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (dxf_3dline_get_dictionary_owner_hard (line), "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", dxf_3dline_get_dictionary_owner_hard (line));
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, dxf_3dline_get_dictionary_owner_hard (line));
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbEntity\n");
+                dxf_write_string (fp, 100, "AcDbEntity");
         }
         if ((dxf_3dline_get_paperspace (line) == DXF_PAPERSPACE)
           && (fp->acad_version_number >= AutoCAD_13))
         {
-                fprintf (fp->fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_int (fp, 67, DXF_PAPERSPACE);
         }
-        fprintf (fp->fp, "  8\n%s\n", dxf_3dline_get_layer (line));
+        dxf_write_string (fp, 8, dxf_3dline_get_layer (line));
         if (strcmp (dxf_3dline_get_linetype (line), DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp->fp, "  6\n%s\n", dxf_3dline_get_linetype (line));
+                dxf_write_string (fp, 6, dxf_3dline_get_linetype (line));
         }
         if ((fp->acad_version_number <= AutoCAD_11)
           && DXF_FLATLAND
           && (dxf_3dline_get_elevation (line) != 0.0))
         {
-                fprintf (fp->fp, " 38\n%f\n", dxf_3dline_get_elevation (line));
+                dxf_write_double (fp, 38, dxf_3dline_get_elevation (line));
         }
         if ((fp->acad_version_number >= AutoCAD_2008)
           && (strcmp (dxf_3dline_get_material (line), "") != 0))
         {
-                fprintf (fp->fp, "347\n%s\n", dxf_3dline_get_material (line));
+                dxf_write_string (fp, 347, dxf_3dline_get_material (line));
         }
         if (dxf_3dline_get_color (line) != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp->fp, " 62\n%d\n", dxf_3dline_get_color (line));
+                dxf_write_int (fp, 62, dxf_3dline_get_color (line));
         }
         if (fp->acad_version_number >= AutoCAD_2002)
         {
-                fprintf (fp->fp, "370\n%d\n", dxf_3dline_get_lineweight (line));
+                dxf_write_int (fp, 370, dxf_3dline_get_lineweight (line));
         }
         if ((dxf_3dline_get_linetype_scale (line) != 1.0)
           && (fp->acad_version_number >= AutoCAD_13))
         {
-                fprintf (fp->fp, " 48\n%f\n", dxf_3dline_get_linetype_scale (line));
+                dxf_write_double (fp, 48, dxf_3dline_get_linetype_scale (line));
         }
         if ((dxf_3dline_get_visibility (line) != 0)
           && (fp->acad_version_number >= AutoCAD_13))
         {
-                fprintf (fp->fp, " 60\n%d\n", dxf_3dline_get_visibility (line));
+                dxf_write_int (fp, 60, dxf_3dline_get_visibility (line));
         }
         if (fp->acad_version_number >= AutoCAD_2000)
         {
 #ifdef BUILD_64
-                fprintf (fp->fp, "160\n%d\n", dxf_3dline_get_graphics_data_size (line));
+                dxf_write_int (fp, 160, dxf_3dline_get_graphics_data_size (line));
 #else
-                fprintf (fp->fp, " 92\n%d\n", dxf_3dline_get_graphics_data_size (line));
+                dxf_write_int (fp, 92, dxf_3dline_get_graphics_data_size (line));
 #endif
                 if (dxf_3dline_get_binary_graphics_data (line) != NULL)
                 {
@@ -635,47 +571,47 @@ dxf_3dline_write
                         iter = dxf_3dline_get_binary_graphics_data (line);
                         while (iter != NULL)
                         {
-                                fprintf (fp->fp, "310\n%s\n", dxf_binary_graphics_data_get_data_line (iter));
+                                dxf_write_string (fp, 310, dxf_binary_graphics_data_get_data_line (iter));
                                 iter = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_get_next (iter);
                         }
                 }
         }
         if (fp->acad_version_number >= AutoCAD_2004)
         {
-                fprintf (fp->fp, "420\n%ld\n", dxf_3dline_get_color_value (line));
-                fprintf (fp->fp, "430\n%s\n", dxf_3dline_get_color_name (line));
-                fprintf (fp->fp, "440\n%ld\n", dxf_3dline_get_transparency (line));
+                dxf_write_long (fp, 420, dxf_3dline_get_color_value (line));
+                dxf_write_string (fp, 430, dxf_3dline_get_color_name (line));
+                dxf_write_long (fp, 440, dxf_3dline_get_transparency (line));
         }
         if (fp->acad_version_number >= AutoCAD_2009)
         {
-                fprintf (fp->fp, "390\n%s\n", dxf_3dline_get_plot_style_name (line));
-                fprintf (fp->fp, "284\n%d\n", dxf_3dline_get_shadow_mode (line));
+                dxf_write_string (fp, 390, dxf_3dline_get_plot_style_name (line));
+                dxf_write_int (fp, 284, dxf_3dline_get_shadow_mode (line));
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbLine\n");
+                dxf_write_string (fp, 100, "AcDbLine");
         }
         if (dxf_3dline_get_thickness (line) != 0.0)
         {
-                fprintf (fp->fp, " 39\n%f\n", dxf_3dline_get_thickness (line));
+                dxf_write_double (fp, 39, dxf_3dline_get_thickness (line));
         }
-        fprintf (fp->fp, " 10\n%f\n", dxf_3dline_get_x0 (line));
-        fprintf (fp->fp, " 20\n%f\n", dxf_3dline_get_y0 (line));
-        fprintf (fp->fp, " 30\n%f\n", dxf_3dline_get_z0 (line));
-        fprintf (fp->fp, " 11\n%f\n", dxf_3dline_get_x1 (line));
-        fprintf (fp->fp, " 21\n%f\n", dxf_3dline_get_y1 (line));
-        fprintf (fp->fp, " 31\n%f\n", dxf_3dline_get_z1 (line));
+        dxf_write_double (fp, 10, dxf_3dline_get_x0 (line));
+        dxf_write_double (fp, 20, dxf_3dline_get_y0 (line));
+        dxf_write_double (fp, 30, dxf_3dline_get_z0 (line));
+        dxf_write_double (fp, 11, dxf_3dline_get_x1 (line));
+        dxf_write_double (fp, 21, dxf_3dline_get_y1 (line));
+        dxf_write_double (fp, 31, dxf_3dline_get_z1 (line));
         if ((fp->acad_version_number >= AutoCAD_12)
                 && (dxf_3dline_get_extr_x0 (line) != 0.0)
                 && (dxf_3dline_get_extr_y0 (line) != 0.0)
                 && (dxf_3dline_get_extr_z0 (line) != 1.0))
         {
-                fprintf (fp->fp, "210\n%f\n", dxf_3dline_get_extr_x0 (line));
-                fprintf (fp->fp, "220\n%f\n", dxf_3dline_get_extr_y0 (line));
-                fprintf (fp->fp, "230\n%f\n", dxf_3dline_get_extr_z0 (line));
+                dxf_write_double (fp, 210, dxf_3dline_get_extr_x0 (line));
+                dxf_write_double (fp, 220, dxf_3dline_get_extr_y0 (line));
+                dxf_write_double (fp, 230, dxf_3dline_get_extr_z0 (line));
         }
         /* Clean up. */
-        free (dxf_entity_name);
+        dxf_free (dxf_entity_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -701,6 +637,9 @@ dxf_3dline_free
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        DxfPoint *p0;
+        DxfPoint *p1;
+
         if (line->next != NULL)
         {
               fprintf (stderr,
@@ -708,17 +647,17 @@ dxf_3dline_free
                 __FUNCTION__);
               return (EXIT_FAILURE);
         }
-        free (dxf_3dline_get_linetype (line));
-        free (dxf_3dline_get_layer (line));
+        dxf_graphic_properties_free (line->properties);
         dxf_binary_graphics_data_free_chain (dxf_3dline_get_binary_graphics_data (line));
-        free (dxf_3dline_get_dictionary_owner_soft (line));
-        free (dxf_3dline_get_material (line));
-        free (dxf_3dline_get_dictionary_owner_hard (line));
-        free (dxf_3dline_get_plot_style_name (line));
-        free (dxf_3dline_get_color_name (line));
-        dxf_point_free (dxf_3dline_get_p0 (line));
-        dxf_point_free (dxf_3dline_get_p1 (line));
-        free (line);
+        dxf_free (line->dictionary_owner_soft);
+        dxf_free (line->dictionary_owner_hard);
+        /* Take both points before freeing either, the getters
+         * compare them. */
+        p0 = line->p0;
+        p1 = line->p1;
+        dxf_point_free (p0);
+        dxf_point_free (p1);
+        dxf_free (line);
         line = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -738,7 +677,7 @@ dxf_3dline_free_chain
                 /*!< a pointer to the chain of DXF 3DLINE entities. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (lines == NULL)
@@ -764,7 +703,7 @@ dxf_3dline_free_chain
  *
  * \return ID code.
  */
-int
+long
 dxf_3dline_get_id_code
 (
         Dxf3dline *line
@@ -804,7 +743,7 @@ dxf_3dline_set_id_code
 (
         Dxf3dline *line,
                 /*!< a pointer to a DXF \c 3DLINE entity. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -859,7 +798,7 @@ dxf_3dline_get_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        if (line->linetype ==  NULL)
+        if (line->properties->linetype ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found.\n")),
@@ -869,7 +808,7 @@ dxf_3dline_get_linetype
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (line->linetype));
+        return (dxf_strdup (line->properties->linetype));
 }
 
 
@@ -903,7 +842,12 @@ dxf_3dline_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        line->linetype = strdup (linetype);
+        if (dxf_graphic_properties_unshare (&line->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (line->properties->linetype);
+        line->properties->linetype = dxf_strdup (linetype);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -934,7 +878,7 @@ dxf_3dline_get_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        if (line->layer ==  NULL)
+        if (line->properties->layer ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found.\n")),
@@ -944,7 +888,7 @@ dxf_3dline_get_layer
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (line->layer));
+        return (dxf_strdup (line->properties->layer));
 }
 
 
@@ -978,7 +922,12 @@ dxf_3dline_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        line->layer = strdup (layer);
+        if (dxf_graphic_properties_unshare (&line->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (line->properties->layer);
+        line->properties->layer = dxf_strdup (layer);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1012,7 +961,7 @@ dxf_3dline_get_elevation
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (line->elevation);
+        return (line->properties->elevation);
 }
 
 
@@ -1039,7 +988,11 @@ dxf_3dline_set_elevation
                   __FUNCTION__);
                 return (NULL);
         }
-        line->elevation = elevation;
+        if (dxf_graphic_properties_unshare (&line->properties) == NULL)
+        {
+                return (NULL);
+        }
+        line->properties->elevation = elevation;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1070,7 +1023,7 @@ dxf_3dline_get_thickness
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (line->thickness < 0.0)
+        if (line->properties->thickness < 0.0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found.\n")),
@@ -1080,7 +1033,7 @@ dxf_3dline_get_thickness
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (line->thickness);
+        return (line->properties->thickness);
 }
 
 
@@ -1114,7 +1067,11 @@ dxf_3dline_set_thickness
                   __FUNCTION__);
                 return (NULL);
         }
-        line->thickness = thickness;
+        if (dxf_graphic_properties_unshare (&line->properties) == NULL)
+        {
+                return (NULL);
+        }
+        line->properties->thickness = thickness;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1148,7 +1105,7 @@ dxf_3dline_get_linetype_scale
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (line->linetype_scale < 0.0)
+        if (line->properties->linetype_scale < 0.0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found.\n")),
@@ -1158,7 +1115,7 @@ dxf_3dline_get_linetype_scale
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (line->linetype_scale);
+        return (line->properties->linetype_scale);
 }
 
 
@@ -1195,7 +1152,11 @@ dxf_3dline_set_linetype_scale
                   __FUNCTION__);
                 return (NULL);
         }
-        line->linetype_scale = linetype_scale;
+        if (dxf_graphic_properties_unshare (&line->properties) == NULL)
+        {
+                return (NULL);
+        }
+        line->properties->linetype_scale = linetype_scale;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1229,14 +1190,14 @@ dxf_3dline_get_visibility
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (line->visibility < 0)
+        if (line->properties->visibility < 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (line->visibility > 1)
+        if (line->properties->visibility > 1)
         {
                 fprintf (stderr,
                   (_("Error in %s () an out of range value was found.\n")),
@@ -1246,7 +1207,7 @@ dxf_3dline_get_visibility
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (line->visibility);
+        return (line->properties->visibility);
 }
 
 
@@ -1290,7 +1251,11 @@ dxf_3dline_set_visibility
                   __FUNCTION__);
                 return (NULL);
         }
-        line->visibility = visibility;
+        if (dxf_graphic_properties_unshare (&line->properties) == NULL)
+        {
+                return (NULL);
+        }
+        line->properties->visibility = visibility;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1321,7 +1286,7 @@ dxf_3dline_get_color
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (line->color < 0)
+        if (line->properties->color < 0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found.\n")),
@@ -1330,7 +1295,7 @@ dxf_3dline_get_color
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (line->color);
+        return (line->properties->color);
 }
 
 
@@ -1363,7 +1328,11 @@ dxf_3dline_set_color
                   (_("Warning in %s () a negative value was passed.\n")),
                   __FUNCTION__);
         }
-        line->color = color;
+        if (dxf_graphic_properties_unshare (&line->properties) == NULL)
+        {
+                return (NULL);
+        }
+        line->properties->color = color;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1394,13 +1363,13 @@ dxf_3dline_get_paperspace
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (line->paperspace < 0)
+        if (line->properties->paperspace < 0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found.\n")),
                   __FUNCTION__);
         }
-        if (line->paperspace > 1)
+        if (line->properties->paperspace > 1)
         {
                 fprintf (stderr,
                   (_("Warning in %s () an out of range value was found.\n")),
@@ -1409,7 +1378,7 @@ dxf_3dline_get_paperspace
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (line->paperspace);
+        return (line->properties->paperspace);
 }
 
 
@@ -1453,7 +1422,11 @@ dxf_3dline_set_paperspace
                   __FUNCTION__);
                 return (NULL);
         }
-        line->paperspace = paperspace;
+        if (dxf_graphic_properties_unshare (&line->properties) == NULL)
+        {
+                return (NULL);
+        }
+        line->properties->paperspace = paperspace;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1579,14 +1552,14 @@ dxf_3dline_get_shadow_mode
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (line->shadow_mode < 0)
+        if (line->properties->shadow_mode < 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (line->shadow_mode > 3)
+        if (line->properties->shadow_mode > 3)
         {
                 fprintf (stderr,
                   (_("Error in %s () an out of range value was found.\n")),
@@ -1596,7 +1569,7 @@ dxf_3dline_get_shadow_mode
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (line->shadow_mode);
+        return (line->properties->shadow_mode);
 }
 
 
@@ -1640,7 +1613,11 @@ dxf_3dline_set_shadow_mode
                   __FUNCTION__);
                 return (NULL);
         }
-        line->shadow_mode = shadow_mode;
+        if (dxf_graphic_properties_unshare (&line->properties) == NULL)
+        {
+                return (NULL);
+        }
+        line->properties->shadow_mode = shadow_mode;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1767,7 +1744,7 @@ dxf_3dline_get_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (line->dictionary_owner_soft));
+        return (dxf_strdup (line->dictionary_owner_soft));
 }
 
 
@@ -1803,7 +1780,7 @@ dxf_3dline_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        line->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        line->dictionary_owner_soft = dxf_strdup (dictionary_owner_soft);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1837,7 +1814,7 @@ dxf_3dline_get_material
                   __FUNCTION__);
                 return (NULL);
         }
-        if (line->material ==  NULL)
+        if (line->properties->material ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found.\n")),
@@ -1847,7 +1824,7 @@ dxf_3dline_get_material
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (line->material));
+        return (dxf_strdup (line->properties->material));
 }
 
 
@@ -1885,7 +1862,12 @@ dxf_3dline_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        line->material = strdup (material);
+        if (dxf_graphic_properties_unshare (&line->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (line->properties->material);
+        line->properties->material = dxf_strdup (material);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1929,7 +1911,7 @@ dxf_3dline_get_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (line->dictionary_owner_hard));
+        return (dxf_strdup (line->dictionary_owner_hard));
 }
 
 
@@ -1965,7 +1947,7 @@ dxf_3dline_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        line->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        line->dictionary_owner_hard = dxf_strdup (dictionary_owner_hard);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2000,7 +1982,7 @@ dxf_3dline_get_lineweight
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (line->lineweight);
+        return (line->properties->lineweight);
 }
 
 
@@ -2030,7 +2012,11 @@ dxf_3dline_set_lineweight
                   __FUNCTION__);
                 return (NULL);
         }
-        line->lineweight = lineweight;
+        if (dxf_graphic_properties_unshare (&line->properties) == NULL)
+        {
+                return (NULL);
+        }
+        line->properties->lineweight = lineweight;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2062,7 +2048,7 @@ dxf_3dline_get_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        if (line->plot_style_name ==  NULL)
+        if (line->properties->plot_style_name ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found.\n")),
@@ -2072,7 +2058,7 @@ dxf_3dline_get_plot_style_name
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (line->plot_style_name));
+        return (dxf_strdup (line->properties->plot_style_name));
 }
 
 
@@ -2110,7 +2096,12 @@ dxf_3dline_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        line->plot_style_name = strdup (plot_style_name);
+        if (dxf_graphic_properties_unshare (&line->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (line->properties->plot_style_name);
+        line->properties->plot_style_name = dxf_strdup (plot_style_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2145,7 +2136,7 @@ dxf_3dline_get_color_value
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (line->color_value);
+        return (line->properties->color_value);
 }
 
 
@@ -2175,7 +2166,11 @@ dxf_3dline_set_color_value
                   __FUNCTION__);
                 return (NULL);
         }
-        line->color_value = color_value;
+        if (dxf_graphic_properties_unshare (&line->properties) == NULL)
+        {
+                return (NULL);
+        }
+        line->properties->color_value = color_value;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2207,7 +2202,7 @@ dxf_3dline_get_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        if (line->color_name ==  NULL)
+        if (line->properties->color_name ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found.\n")),
@@ -2217,7 +2212,7 @@ dxf_3dline_get_color_name
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (line->color_name));
+        return (dxf_strdup (line->properties->color_name));
 }
 
 
@@ -2255,7 +2250,12 @@ dxf_3dline_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        line->color_name = strdup (color_name);
+        if (dxf_graphic_properties_unshare (&line->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (line->properties->color_name);
+        line->properties->color_name = dxf_strdup (color_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2290,7 +2290,7 @@ dxf_3dline_get_transparency
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (line->transparency);
+        return (line->properties->transparency);
 }
 
 
@@ -2320,7 +2320,11 @@ dxf_3dline_set_transparency
                   __FUNCTION__);
                 return (NULL);
         }
-        line->transparency = transparency;
+        if (dxf_graphic_properties_unshare (&line->properties) == NULL)
+        {
+                return (NULL);
+        }
+        line->properties->transparency = transparency;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2340,7 +2344,7 @@ dxf_3dline_get_p0
                 /*!< a pointer to a DXF \c 3DLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2379,7 +2383,7 @@ dxf_3dline_set_p0
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2417,7 +2421,7 @@ dxf_3dline_get_x0
                 /*!< a pointer to a DXF \c 3DLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2458,7 +2462,7 @@ dxf_3dline_set_x0
                  * entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2496,7 +2500,7 @@ dxf_3dline_get_y0
                 /*!< a pointer to a DXF \c 3DLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2537,7 +2541,7 @@ dxf_3dline_set_y0
                  * entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2575,7 +2579,7 @@ dxf_3dline_get_z0
                 /*!< a pointer to a DXF \c 3DLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2616,7 +2620,7 @@ dxf_3dline_set_z0
                  * entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2654,7 +2658,7 @@ dxf_3dline_get_p1
                 /*!< a pointer to a DXF \c 3DLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2701,7 +2705,7 @@ dxf_3dline_set_p1
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2739,7 +2743,7 @@ dxf_3dline_get_x1
                 /*!< a pointer to a DXF \c 3DLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2780,7 +2784,7 @@ dxf_3dline_set_x1
                  * entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2818,7 +2822,7 @@ dxf_3dline_get_y1
                 /*!< a pointer to a DXF \c 3DLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2859,7 +2863,7 @@ dxf_3dline_set_y1
                  * entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2897,7 +2901,7 @@ dxf_3dline_get_z1
                 /*!< a pointer to a DXF \c 3DLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2938,7 +2942,7 @@ dxf_3dline_set_z1
                  * entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2977,7 +2981,7 @@ dxf_3dline_get_extr_x0
                 /*!< a pointer to a DXF \c 3DLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3013,7 +3017,7 @@ dxf_3dline_set_extr_x0
                  * \c 3DLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3045,7 +3049,7 @@ dxf_3dline_get_extr_y0
                 /*!< a pointer to a DXF \c 3DLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3081,7 +3085,7 @@ dxf_3dline_set_extr_y0
                  * \c 3DLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3113,7 +3117,7 @@ dxf_3dline_get_extr_z0
                 /*!< a pointer to a DXF \c 3DLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3149,7 +3153,7 @@ dxf_3dline_set_extr_z0
                  * \c 3DLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3183,7 +3187,7 @@ dxf_3dline_get_extrusion_vector_as_point
                 /*!< a pointer to a DXF \c 3DLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         DxfPoint *point = NULL;
@@ -3311,7 +3315,7 @@ dxf_3dline_get_mid_point
 (
         Dxf3dline *line,
                 /*!< a pointer to a DXF \c 3DLINE entity. */
-        int id_code,
+        long id_code,
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -3325,7 +3329,7 @@ dxf_3dline_get_mid_point
                  */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         DxfPoint *point = NULL;
@@ -3371,26 +3375,26 @@ dxf_3dline_get_mid_point
                         /* Do nothing. */
                         break;
                 case 1:
-                        if (line->linetype != NULL)
+                        if (line->properties->linetype != NULL)
                         {
-                                point->linetype = strdup (line->linetype);
+                                dxf_point_set_linetype (point, line->properties->linetype);
                         }
-                        if (line->layer != NULL)
+                        if (line->properties->layer != NULL)
                         {
-                                point->layer = strdup (line->layer);
+                                dxf_point_set_layer (point, line->properties->layer);
                         }
-                        point->thickness = line->thickness;
-                        point->linetype_scale = line->linetype_scale;
-                        point->visibility = line->visibility;
-                        point->color = line->color;
-                        point->paperspace = line->paperspace;
+                        dxf_point_set_thickness (point, line->properties->thickness);
+                        dxf_point_set_linetype_scale (point, line->properties->linetype_scale);
+                        dxf_point_set_visibility (point, line->properties->visibility);
+                        dxf_point_set_color (point, line->properties->color);
+                        dxf_point_set_paperspace (point, line->properties->paperspace);
                         if (line->dictionary_owner_soft != NULL)
                         {
-                                point->dictionary_owner_soft = strdup (line->dictionary_owner_soft);
+                                point->dictionary_owner_soft = dxf_strdup (line->dictionary_owner_soft);
                         }
                         if (line->dictionary_owner_hard != NULL)
                         {
-                                point->dictionary_owner_hard = strdup (line->dictionary_owner_hard);
+                                point->dictionary_owner_hard = dxf_strdup (line->dictionary_owner_hard);
                         }
                         break;
                 default:
@@ -3421,7 +3425,7 @@ dxf_3dline_get_length
                 /*!< a pointer to a DXF \c 3DLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3468,7 +3472,7 @@ dxf_3dline_create_from_points
                 /*!< a pointer to a DXF \c POINT entity. */
         DxfPoint *p1,
                 /*!< a pointer to a DXF \c POINT entity. */
-        int id_code,
+        long id_code,
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -3518,6 +3522,16 @@ dxf_3dline_create_from_points
                 __FUNCTION__);
               return (NULL);
         }
+        /* The inherited properties are set in a record of its own. */
+        if ((inheritance != 0)
+          && (dxf_graphic_properties_unshare (&line->properties) == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                dxf_3dline_free (line);
+                return (NULL);
+        }
         if (id_code < 0)
         {
               fprintf (stderr,
@@ -3537,49 +3551,53 @@ dxf_3dline_create_from_points
                         /* Do nothing. */
                         break;
                 case 1:
-                        if (p0->linetype != NULL)
+                        if (p0->properties->linetype != NULL)
                         {
-                                line->linetype = p0->linetype;
+                                dxf_free (line->properties->linetype);
+                                dxf_3dline_set_linetype (line, p0->properties->linetype);
                         }
-                        if (p0->layer != NULL)
+                        if (p0->properties->layer != NULL)
                         {
-                                line->layer = p0->layer;
+                                dxf_free (line->properties->layer);
+                                dxf_3dline_set_layer (line, p0->properties->layer);
                         }
-                        line->thickness = p0->thickness;
-                        line->linetype_scale = p0->linetype_scale;
-                        line->visibility = p0->visibility;
-                        line->color = p0->color;
-                        line->paperspace = p0->paperspace;
+                        line->properties->thickness = p0->properties->thickness;
+                        line->properties->linetype_scale = p0->properties->linetype_scale;
+                        line->properties->visibility = p0->properties->visibility;
+                        line->properties->color = p0->properties->color;
+                        line->properties->paperspace = p0->properties->paperspace;
                         if (p0->dictionary_owner_soft != NULL)
                         {
-                                line->dictionary_owner_soft = strdup (p0->dictionary_owner_soft);
+                                line->dictionary_owner_soft = dxf_strdup (p0->dictionary_owner_soft);
                         }
                         if (p0->dictionary_owner_hard != NULL)
                         {
-                                line->dictionary_owner_hard = strdup (p0->dictionary_owner_hard);
+                                line->dictionary_owner_hard = dxf_strdup (p0->dictionary_owner_hard);
                         }
                         break;
                 case 2:
-                        if (p1->linetype != NULL)
+                        if (p1->properties->linetype != NULL)
                         {
-                                line->linetype = p1->linetype;
+                                dxf_free (line->properties->linetype);
+                                dxf_3dline_set_linetype (line, p1->properties->linetype);
                         }
-                        if (p1->layer != NULL)
+                        if (p1->properties->layer != NULL)
                         {
-                                line->layer = p1->layer;
+                                dxf_free (line->properties->layer);
+                                dxf_3dline_set_layer (line, p1->properties->layer);
                         }
-                        line->thickness = p1->thickness;
-                        line->linetype_scale = p1->linetype_scale;
-                        line->visibility = p1->visibility;
-                        line->color = p1->color;
-                        line->paperspace = p1->paperspace;
+                        line->properties->thickness = p1->properties->thickness;
+                        line->properties->linetype_scale = p1->properties->linetype_scale;
+                        line->properties->visibility = p1->properties->visibility;
+                        line->properties->color = p1->properties->color;
+                        line->properties->paperspace = p1->properties->paperspace;
                         if (p1->dictionary_owner_soft != NULL)
                         {
-                                line->dictionary_owner_soft = strdup (p1->dictionary_owner_soft);
+                                line->dictionary_owner_soft = dxf_strdup (p1->dictionary_owner_soft);
                         }
                         if (p1->dictionary_owner_hard != NULL)
                         {
-                                line->dictionary_owner_hard = strdup (p1->dictionary_owner_hard);
+                                line->dictionary_owner_hard = dxf_strdup (p1->dictionary_owner_hard);
                         }
                         break;
                 default:
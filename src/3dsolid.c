@@ -49,6 +49,9 @@
 
 
 #include "3dsolid.h"
+#include "arena.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -68,7 +71,7 @@ dxf_3dsolid_new ()
         size = sizeof (Dxf3dsolid);
         /* avoid malloc of 0 bytes */
         if (size == 0) size = 1;
-        if ((solid = malloc (size)) == NULL)
+        if ((solid = dxf_malloc (size)) == NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () could not allocate memory.\n")),
@@ -119,30 +122,16 @@ dxf_3dsolid_init
                 return (NULL);
         }
         dxf_3dsolid_set_id_code (solid, 0);
-        dxf_3dsolid_set_linetype (solid, strdup (DXF_DEFAULT_LINETYPE));
-        dxf_3dsolid_set_layer (solid, strdup (DXF_DEFAULT_LAYER));
-        dxf_3dsolid_set_elevation (solid, 0.0);
-        dxf_3dsolid_set_thickness (solid, 0.0);
-        dxf_3dsolid_set_linetype_scale (solid, DXF_DEFAULT_LINETYPE_SCALE);
-        dxf_3dsolid_set_visibility (solid, DXF_DEFAULT_VISIBILITY);
-        dxf_3dsolid_set_color (solid, DXF_COLOR_BYLAYER);
-        dxf_3dsolid_set_paperspace (solid, DXF_MODELSPACE);
+        solid->properties = dxf_graphic_properties_default ();
         dxf_3dsolid_set_graphics_data_size (solid, 0);
-        dxf_3dsolid_set_shadow_mode (solid, 0);
         dxf_3dsolid_set_binary_graphics_data (solid, (DxfBinaryGraphicsData *) dxf_binary_graphics_data_new ());
         dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) dxf_3dsolid_get_binary_graphics_data (solid));
-        dxf_3dsolid_set_dictionary_owner_soft (solid, strdup (""));
-        dxf_3dsolid_set_material (solid, strdup (""));
-        dxf_3dsolid_set_dictionary_owner_hard (solid, strdup (""));
-        dxf_3dsolid_set_lineweight (solid, 0);
-        dxf_3dsolid_set_plot_style_name (solid, strdup (""));
-        dxf_3dsolid_set_color_value (solid, 0);
-        dxf_3dsolid_set_color_name (solid, strdup (""));
-        dxf_3dsolid_set_transparency (solid, 0);
+        dxf_3dsolid_set_dictionary_owner_soft (solid, "");
+        dxf_3dsolid_set_dictionary_owner_hard (solid, "");
         dxf_3dsolid_set_proprietary_data (solid, (DxfProprietaryData *) dxf_proprietary_data_init (solid->proprietary_data));
         dxf_3dsolid_set_additional_proprietary_data (solid, (DxfProprietaryData *) dxf_proprietary_data_init (solid->additional_proprietary_data));
         dxf_3dsolid_set_modeler_format_version_number (solid, 1);
-        dxf_3dsolid_set_history (solid, strdup (""));
+        dxf_3dsolid_set_history (solid, "");
         dxf_3dsolid_set_next (solid, NULL);
 #if DEBUG
         DXF_DEBUG_END
@@ -174,8 +163,11 @@ dxf_3dsolid_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfGraphicProperties properties;
+        DxfPair pair;
         int i;
+        DxfBinaryGraphicsData *binary_graphics_data = NULL;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -183,8 +175,6 @@ dxf_3dsolid_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (fp->acad_version_number < AutoCAD_13)
@@ -201,257 +191,201 @@ dxf_3dsolid_read
                 solid = dxf_3dsolid_new ();
                 solid = dxf_3dsolid_init (solid);
         }
+        binary_graphics_data = (DxfBinaryGraphicsData *) solid->binary_graphics_data;
         i = 1;
         solid->proprietary_data->order = 0;
         solid->additional_proprietary_data->order = 0;
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        dxf_graphic_properties_start (&properties, solid->properties);
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        /* Clean up. */
-                        free (temp_string);
-                        fclose (fp->fp);
-                        return (NULL);
-                }
-                else if (strcmp (temp_string, "  1") == 0)
-                {
-                        /* Now follows a string containing proprietary
-                         * data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", solid->proprietary_data->line);
-                        solid->proprietary_data->order = i;
-                        i++;
-                        dxf_proprietary_data_init ((DxfProprietaryData *) solid->proprietary_data->next);
-                        solid->proprietary_data = (DxfProprietaryData *) solid->proprietary_data->next;
-                }
-                else if (strcmp (temp_string, "  3") == 0)
-                {
-                        /* Now follows a string containing additional
-                         * proprietary data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", solid->additional_proprietary_data->line);
-                        solid->additional_proprietary_data->order = i;
-                        i++;
-                        dxf_proprietary_data_init ((DxfProprietaryData *) solid->additional_proprietary_data->next);
-                        solid->additional_proprietary_data = (DxfProprietaryData *) solid->additional_proprietary_data->next;
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &solid->id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", solid->linetype);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", solid->layer);
-                }
-                else if (strcmp (temp_string, "38") == 0)
-                {
-                        /* Now follows a string containing the
-                         * elevation. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &solid->elevation);
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &solid->thickness);
-                }
-                else if (strcmp (temp_string, "48") == 0)
-                {
-                        /* Now follows a string containing the linetype
-                         * scale. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &solid->linetype_scale);
-                }
-                else if (strcmp (temp_string, "60") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing the
-                         * visibility value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &solid->visibility);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else if (strcmp (temp_string, "62") == 0)
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &solid->color);
-                }
-                else if (strcmp (temp_string, "67") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &solid->paperspace);
-                }
-                else if (strcmp (temp_string, "70") == 0)
-                {
-                        /* Now follows a string containing the modeler
-                         * format version number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &solid->modeler_format_version_number);
-                }
-                else if (strcmp (temp_string, "92") == 0)
-                {
-                        /* Now follows a string containing the
-                         * graphics data size value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &solid->graphics_data_size);
-                }
-                else if (strcmp (temp_string, "100") == 0)
-                {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "AcDbModelerGeometry") != 0)
-                        {
+                        case 1:
+                                /* Now follows a string containing proprietary
+                                 * data. */
+                                solid->proprietary_data->line = dxf_pair_get_string (&pair);
+                                solid->proprietary_data->order = i;
+                                i++;
+                                dxf_proprietary_data_init ((DxfProprietaryData *) solid->proprietary_data->next);
+                                solid->proprietary_data = (DxfProprietaryData *) solid->proprietary_data->next;
+                                break;
+                        case 3:
+                                /* Now follows a string containing additional
+                                 * proprietary data. */
+                                solid->additional_proprietary_data->line = dxf_pair_get_string (&pair);
+                                solid->additional_proprietary_data->order = i;
+                                i++;
+                                dxf_proprietary_data_init ((DxfProprietaryData *) solid->additional_proprietary_data->next);
+                                solid->additional_proprietary_data = (DxfProprietaryData *) solid->additional_proprietary_data->next;
+                                break;
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                solid->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 6:
+                                /* Now follows a string containing a linetype
+                                 * name. */
+                                dxf_lexer_free_string (fp, properties.linetype);
+                                properties.linetype = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 8:
+                                /* Now follows a string containing a layer name. */
+                                dxf_lexer_free_string (fp, properties.layer);
+                                properties.layer = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 38:
+                                /* Now follows a string containing the
+                                 * elevation. */
+                                properties.elevation = dxf_pair_get_double (&pair);
+                                break;
+                        case 39:
+                                /* Now follows a string containing the
+                                 * thickness. */
+                                properties.thickness = dxf_pair_get_double (&pair);
+                                break;
+                        case 48:
+                                /* Now follows a string containing the linetype
+                                 * scale. */
+                                properties.linetype_scale = dxf_pair_get_double (&pair);
+                                break;
+                        case 60:
+                                /* Now follows a string containing the
+                                 * visibility value. */
+                                properties.visibility = dxf_pair_get_int (&pair);
+                                break;
+                        case 62:
+                                /* Now follows a string containing the
+                                 * color value. */
+                                properties.color = dxf_pair_get_int (&pair);
+                                break;
+                        case 67:
+                                /* Now follows a string containing the
+                                 * paperspace value. */
+                                properties.paperspace = dxf_pair_get_int (&pair);
+                                break;
+                        case 70:
+                                /* Now follows a string containing the modeler
+                                 * format version number. */
+                                solid->modeler_format_version_number = dxf_pair_get_int (&pair);
+                                break;
+                        case 92:
+                                /* Now follows a string containing the
+                                 * graphics data size value. */
+                                solid->graphics_data_size = dxf_pair_get_int (&pair);
+                                break;
+                        case 100:
+                                /* Now follows a string containing the
+                                 * subclass marker value. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                if (strcmp (temp_string, "AcDbModelerGeometry") != 0)
+                                {
+                                        fprintf (stderr,
+                                          (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                }
+                                break;
+                        case 160:
+                                /* Now follows a string containing the
+                                 * graphics data size value. */
+                                solid->graphics_data_size = dxf_pair_get_int (&pair);
+                                break;
+                        case 284:
+                                /* Now follows a string containing the shadow
+                                 * mode value. */
+                                properties.shadow_mode = dxf_pair_get_int (&pair);
+                                break;
+                        case 310:
+                                /* Now follows a string containing binary
+                                 * graphics data. */
+                                binary_graphics_data = dxf_binary_graphics_data_append_line
+                                  (binary_graphics_data,
+                                  dxf_pair_get_string (&pair));
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, solid->dictionary_owner_soft);
+                                solid->dictionary_owner_soft = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 347:
+                                /* Now follows a string containing a
+                                 * hard-pointer ID/handle to material object. */
+                                dxf_lexer_free_string (fp, properties.material);
+                                properties.material = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 350:
+                                /* Now follows a string containing a handle to a
+                                 * history object. */
+                                dxf_free (solid->history);
+                                solid->history = dxf_pair_get_string (&pair);
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, solid->dictionary_owner_hard);
+                                solid->dictionary_owner_hard = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 370:
+                                /* Now follows a string containing the lineweight
+                                 * value. */
+                                properties.lineweight = dxf_pair_get_int (&pair);
+                                break;
+                        case 390:
+                                /* Now follows a string containing a plot style
+                                 * name value. */
+                                dxf_lexer_free_string (fp, properties.plot_style_name);
+                                properties.plot_style_name = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 420:
+                                /* Now follows a string containing a color value. */
+                                properties.color_value = dxf_pair_get_long (&pair);
+                                break;
+                        case 430:
+                                /* Now follows a string containing a color
+                                 * name value. */
+                                dxf_lexer_free_string (fp, properties.color_name);
+                                properties.color_name = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 440:
+                                /* Now follows a string containing a transparency
+                                 * value. */
+                                properties.transparency = dxf_pair_get_long (&pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, (_("DXF comment: %s\n")), temp_string);
+                                break;
+                        default:
                                 fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
                                   __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "100") == 0)
-                {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "AcDb3dSolid") != 0)
-                        {
-                                fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "160") == 0)
-                {
-                        /* Now follows a string containing the
-                         * graphics data size value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &solid->graphics_data_size);
-                }
-                else if (strcmp (temp_string, "284") == 0)
-                {
-                        /* Now follows a string containing the shadow
-                         * mode value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &solid->shadow_mode);
-                }
-                else if (strcmp (temp_string, "310") == 0)
-                {
-                        /* Now follows a string containing binary
-                         * graphics data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", solid->binary_graphics_data->data_line);
-                        dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) solid->binary_graphics_data->next);
-                        solid->binary_graphics_data = (DxfBinaryGraphicsData *) solid->binary_graphics_data->next;
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", solid->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "347") == 0)
-                {
-                        /* Now follows a string containing a
-                         * hard-pointer ID/handle to material object. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", solid->material);
-                }
-                else if (strcmp (temp_string, "350") == 0)
-                {
-                        /* Now follows a string containing a handle to a
-                         * history object. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", solid->history);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", solid->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "370") == 0)
-                {
-                        /* Now follows a string containing the lineweight
-                         * value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &solid->lineweight);
-                }
-                else if (strcmp (temp_string, "390") == 0)
-                {
-                        /* Now follows a string containing a plot style
-                         * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", solid->plot_style_name);
-                }
-                else if (strcmp (temp_string, "420") == 0)
-                {
-                        /* Now follows a string containing a color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%ld\n", &solid->color_value);
-                }
-                else if (strcmp (temp_string, "430") == 0)
-                {
-                        /* Now follows a string containing a color
-                         * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", solid->color_name);
-                }
-                else if (strcmp (temp_string, "440") == 0)
-                {
-                        /* Now follows a string containing a transparency
-                         * value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%ld\n", &solid->transparency);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, (_("DXF comment: %s\n")), temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
         /* Handle omitted members and/or illegal values. */
-        if (strcmp (solid->linetype, "") == 0)
+        if ((properties.linetype != NULL)
+          && (strcmp (properties.linetype, "") == 0))
         {
-                solid->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_lexer_free_string (fp, properties.linetype);
+                properties.linetype = dxf_strdup (DXF_DEFAULT_LINETYPE);
         }
-        if (strcmp (solid->layer, "") == 0)
+        if ((properties.layer != NULL)
+          && (strcmp (properties.layer, "") == 0))
         {
-                solid->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_lexer_free_string (fp, properties.layer);
+                properties.layer = dxf_strdup (DXF_DEFAULT_LAYER);
         }
-        /* Clean up. */
-        free (temp_string);
+        /* Entities with equal properties share a record. */
+        dxf_graphic_properties_finish (fp, &solid->properties, &properties);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -477,7 +411,7 @@ dxf_3dsolid_write
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *dxf_entity_name = strdup ("3DSOLID");
+        char *dxf_entity_name = dxf_strdup ("3DSOLID");
         DxfProprietaryData *iter = NULL;
         DxfProprietaryData *additional_iter = NULL;
         int i;
@@ -489,7 +423,7 @@ dxf_3dsolid_write
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (solid == NULL)
@@ -498,41 +432,41 @@ dxf_3dsolid_write
                   (_("Error in %s () a NULL pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (fp->acad_version_number < AutoCAD_13)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () illegal DXF version for this %s entity with id-code: %x.\n")),
+                  (_("Warning in %s () illegal DXF version for this %s entity with id-code: %lx.\n")),
                   __FUNCTION__, dxf_entity_name, dxf_3dsolid_get_id_code (solid));
         }
         if (strcmp (dxf_3dsolid_get_linetype (solid), "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_3dsolid_get_id_code (solid));
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                dxf_3dsolid_set_linetype (solid, strdup (DXF_DEFAULT_LINETYPE));
+                dxf_3dsolid_set_linetype (solid, DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (dxf_3dsolid_get_layer (solid), "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty layer string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty layer string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_3dsolid_get_id_code (solid));
                 fprintf (stderr,
                   (_("\t%s entity is relocated to layer 0")),
                   dxf_entity_name);
-                dxf_3dsolid_set_layer (solid, (strdup (DXF_DEFAULT_LAYER)));
+                dxf_3dsolid_set_layer (solid, (dxf_strdup (DXF_DEFAULT_LAYER)));
         }
         /* Start writing output. */
         i = 1;
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
-        if (dxf_3dsolid_get_id_code (solid) != -1)
+        dxf_write_string (fp, 0, dxf_entity_name);
+        if (solid->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", dxf_3dsolid_get_id_code (solid));
+                dxf_write_hex (fp, 5, dxf_3dsolid_get_id_code (solid));
         }
         /*!
          * \todo for version R14.\n
@@ -547,97 +481,97 @@ dxf_3dsolid_write
         if ((strcmp (dxf_3dsolid_get_dictionary_owner_soft (solid), "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", dxf_3dsolid_get_dictionary_owner_soft (solid));
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, dxf_3dsolid_get_dictionary_owner_soft (solid));
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (dxf_3dsolid_get_dictionary_owner_hard (solid), "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", dxf_3dsolid_get_dictionary_owner_hard (solid));
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, dxf_3dsolid_get_dictionary_owner_hard (solid));
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbEntity\n");
+                dxf_write_string (fp, 100, "AcDbEntity");
         }
         if (dxf_3dsolid_get_paperspace (solid) == DXF_PAPERSPACE)
         {
-                fprintf (fp->fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_int (fp, 67, DXF_PAPERSPACE);
         }
-        fprintf (fp->fp, "  8\n%s\n", dxf_3dsolid_get_layer (solid));
+        dxf_write_string (fp, 8, dxf_3dsolid_get_layer (solid));
         if (strcmp (dxf_3dsolid_get_linetype (solid), DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp->fp, "  6\n%s\n", dxf_3dsolid_get_linetype (solid));
+                dxf_write_string (fp, 6, dxf_3dsolid_get_linetype (solid));
         }
         if ((fp->acad_version_number >= AutoCAD_2008)
           && (strcmp (dxf_3dsolid_get_material (solid), "") != 0))
         {
-                fprintf (fp->fp, "347\n%s\n", dxf_3dsolid_get_material (solid));
+                dxf_write_string (fp, 347, dxf_3dsolid_get_material (solid));
         }
         if (dxf_3dsolid_get_color (solid) != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp->fp, " 62\n%d\n", dxf_3dsolid_get_color (solid));
+                dxf_write_int (fp, 62, dxf_3dsolid_get_color (solid));
         }
         if (fp->acad_version_number >= AutoCAD_2002)
         {
-                fprintf (fp->fp, "370\n%d\n", dxf_3dsolid_get_lineweight (solid));
+                dxf_write_int (fp, 370, dxf_3dsolid_get_lineweight (solid));
         }
         if ((fp->acad_version_number <= AutoCAD_11)
           && DXF_FLATLAND
           && (dxf_3dsolid_get_elevation (solid) != 0.0))
         {
-                fprintf (fp->fp, " 38\n%f\n", dxf_3dsolid_get_elevation (solid));
+                dxf_write_double (fp, 38, dxf_3dsolid_get_elevation (solid));
         }
         if (dxf_3dsolid_get_thickness (solid) != 0.0)
         {
-                fprintf (fp->fp, " 39\n%f\n", dxf_3dsolid_get_thickness (solid));
+                dxf_write_double (fp, 39, dxf_3dsolid_get_thickness (solid));
         }
         if (dxf_3dsolid_get_linetype_scale (solid) != 1.0)
         {
-                fprintf (fp->fp, " 48\n%f\n", dxf_3dsolid_get_linetype_scale (solid));
+                dxf_write_double (fp, 48, dxf_3dsolid_get_linetype_scale (solid));
         }
         if (dxf_3dsolid_get_visibility (solid) != 0)
         {
-                fprintf (fp->fp, " 60\n%d\n", dxf_3dsolid_get_visibility (solid));
+                dxf_write_int (fp, 60, dxf_3dsolid_get_visibility (solid));
         }
         if (fp->acad_version_number >= AutoCAD_2000)
         {
 #ifdef BUILD_64
-                fprintf (fp->fp, "160\n%d\n", dxf_3dsolid_get_graphics_data_size (solid));
+                dxf_write_int (fp, 160, dxf_3dsolid_get_graphics_data_size (solid));
 #else
-                fprintf (fp->fp, " 92\n%d\n", dxf_3dsolid_get_graphics_data_size (solid));
+                dxf_write_int (fp, 92, dxf_3dsolid_get_graphics_data_size (solid));
 #endif
                 DxfBinaryGraphicsData *bgd_iter = (DxfBinaryGraphicsData *) dxf_3dsolid_get_binary_graphics_data (solid);
                 while (dxf_binary_graphics_data_get_data_line (bgd_iter) != NULL)
                 {
-                        fprintf (fp->fp, "310\n%s\n", dxf_binary_graphics_data_get_data_line (bgd_iter));
+                        dxf_write_string (fp, 310, dxf_binary_graphics_data_get_data_line (bgd_iter));
                         bgd_iter = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_get_next (bgd_iter);
                 }
         }
         if (fp->acad_version_number >= AutoCAD_2004)
         {
-                fprintf (fp->fp, "420\n%ld\n", dxf_3dsolid_get_color_value (solid));
-                fprintf (fp->fp, "430\n%s\n", dxf_3dsolid_get_color_name (solid));
-                fprintf (fp->fp, "440\n%ld\n", dxf_3dsolid_get_transparency (solid));
+                dxf_write_long (fp, 420, dxf_3dsolid_get_color_value (solid));
+                dxf_write_string (fp, 430, dxf_3dsolid_get_color_name (solid));
+                dxf_write_long (fp, 440, dxf_3dsolid_get_transparency (solid));
         }
         if (fp->acad_version_number >= AutoCAD_2009)
         {
-                fprintf (fp->fp, "390\n%s\n", dxf_3dsolid_get_plot_style_name (solid));
-                fprintf (fp->fp, "284\n%d\n", dxf_3dsolid_get_shadow_mode (solid));
+                dxf_write_string (fp, 390, dxf_3dsolid_get_plot_style_name (solid));
+                dxf_write_int (fp, 284, dxf_3dsolid_get_shadow_mode (solid));
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbModelerGeometry\n");
+                dxf_write_string (fp, 100, "AcDbModelerGeometry");
         }
         if (fp->acad_version_number >= AutoCAD_2008)
         {
-                fprintf (fp->fp, "100\nAcDb3dSolid\n");
+                dxf_write_string (fp, 100, "AcDb3dSolid");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, " 70\n%d\n", dxf_3dsolid_get_modeler_format_version_number (solid));
+                dxf_write_int (fp, 70, dxf_3dsolid_get_modeler_format_version_number (solid));
         }
         iter = (DxfProprietaryData *) dxf_3dsolid_get_proprietary_data (solid);
         additional_iter = (DxfProprietaryData *) dxf_3dsolid_get_additional_proprietary_data (solid);
@@ -645,23 +579,23 @@ dxf_3dsolid_write
         {
                 if (iter->order == i)
                 {
-                        fprintf (fp->fp, "  1\n%s\n", dxf_proprietary_data_get_line (iter));
+                        dxf_write_string (fp, 1, dxf_proprietary_data_get_line (iter));
                         iter = (DxfProprietaryData *) dxf_proprietary_data_get_next (iter);
                         i++;
                 }
                 if (additional_iter->order == i)
                 {
-                        fprintf (fp->fp, "  3\n%s\n", dxf_proprietary_data_get_line (additional_iter));
+                        dxf_write_string (fp, 3, dxf_proprietary_data_get_line (additional_iter));
                         additional_iter = (DxfProprietaryData *) dxf_proprietary_data_get_next (additional_iter);
                         i++;
                 }
         }
         if (fp->acad_version_number >= AutoCAD_2008)
         {
-                fprintf (fp->fp, "350\n%s\n", dxf_3dsolid_get_history (solid));
+                dxf_write_string (fp, 350, dxf_3dsolid_get_history (solid));
         }
         /* Clean up. */
-        free (dxf_entity_name);
+        dxf_free (dxf_entity_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -695,18 +629,14 @@ dxf_3dsolid_free
                 __FUNCTION__);
               return (EXIT_FAILURE);
         }
-        free (dxf_3dsolid_get_linetype (solid));
-        free (dxf_3dsolid_get_layer (solid));
+        dxf_graphic_properties_free (solid->properties);
         dxf_binary_graphics_data_free_chain (dxf_3dsolid_get_binary_graphics_data (solid));
-        free (dxf_3dsolid_get_dictionary_owner_soft (solid));
-        free (dxf_3dsolid_get_material (solid));
-        free (dxf_3dsolid_get_dictionary_owner_hard (solid));
-        free (dxf_3dsolid_get_plot_style_name (solid));
-        free (dxf_3dsolid_get_color_name (solid));
+        dxf_free (solid->dictionary_owner_soft);
+        dxf_free (solid->dictionary_owner_hard);
         dxf_proprietary_data_free_chain (dxf_3dsolid_get_proprietary_data (solid));
         dxf_proprietary_data_free_chain (dxf_3dsolid_get_additional_proprietary_data (solid));
-        free (dxf_3dsolid_get_history (solid));
-        free (solid);
+        dxf_free (solid->history);
+        dxf_free (solid);
         solid = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -726,7 +656,7 @@ dxf_3dsolid_free_chain
                 /*!< a pointer to the chain of DXF \c 3DSOLID entities. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (solids == NULL)
@@ -752,7 +682,7 @@ dxf_3dsolid_free_chain
  *
  * \return ID code.
  */
-int
+long
 dxf_3dsolid_get_id_code
 (
         Dxf3dsolid *solid
@@ -792,7 +722,7 @@ dxf_3dsolid_set_id_code
 (
         Dxf3dsolid *solid,
                 /*!< a pointer to a DXF \c 3DSOLID entity. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -847,7 +777,7 @@ dxf_3dsolid_get_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        if (solid->linetype ==  NULL)
+        if (solid->properties->linetype ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found.\n")),
@@ -857,7 +787,7 @@ dxf_3dsolid_get_linetype
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (solid->linetype));
+        return (dxf_strdup (solid->properties->linetype));
 }
 
 
@@ -891,7 +821,12 @@ dxf_3dsolid_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        solid->linetype = strdup (linetype);
+        if (dxf_graphic_properties_unshare (&solid->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (solid->properties->linetype);
+        solid->properties->linetype = dxf_strdup (linetype);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -922,7 +857,7 @@ dxf_3dsolid_get_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        if (solid->layer ==  NULL)
+        if (solid->properties->layer ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found.\n")),
@@ -932,7 +867,7 @@ dxf_3dsolid_get_layer
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (solid->layer));
+        return (dxf_strdup (solid->properties->layer));
 }
 
 
@@ -966,7 +901,12 @@ dxf_3dsolid_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        solid->layer = strdup (layer);
+        if (dxf_graphic_properties_unshare (&solid->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (solid->properties->layer);
+        solid->properties->layer = dxf_strdup (layer);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1000,7 +940,7 @@ dxf_3dsolid_get_elevation
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (solid->elevation);
+        return (solid->properties->elevation);
 }
 
 
@@ -1027,7 +967,11 @@ dxf_3dsolid_set_elevation
                   __FUNCTION__);
                 return (NULL);
         }
-        solid->elevation = elevation;
+        if (dxf_graphic_properties_unshare (&solid->properties) == NULL)
+        {
+                return (NULL);
+        }
+        solid->properties->elevation = elevation;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1058,7 +1002,7 @@ dxf_3dsolid_get_thickness
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (solid->thickness < 0.0)
+        if (solid->properties->thickness < 0.0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found.\n")),
@@ -1068,7 +1012,7 @@ dxf_3dsolid_get_thickness
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (solid->thickness);
+        return (solid->properties->thickness);
 }
 
 
@@ -1102,7 +1046,11 @@ dxf_3dsolid_set_thickness
                   __FUNCTION__);
                 return (NULL);
         }
-        solid->thickness = thickness;
+        if (dxf_graphic_properties_unshare (&solid->properties) == NULL)
+        {
+                return (NULL);
+        }
+        solid->properties->thickness = thickness;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1133,7 +1081,7 @@ dxf_3dsolid_get_linetype_scale
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (solid->linetype_scale < 0.0)
+        if (solid->properties->linetype_scale < 0.0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found.\n")),
@@ -1143,7 +1091,7 @@ dxf_3dsolid_get_linetype_scale
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (solid->linetype_scale);
+        return (solid->properties->linetype_scale);
 }
 
 
@@ -1177,7 +1125,11 @@ dxf_3dsolid_set_linetype_scale
                   __FUNCTION__);
                 return (NULL);
         }
-        solid->linetype_scale = linetype_scale;
+        if (dxf_graphic_properties_unshare (&solid->properties) == NULL)
+        {
+                return (NULL);
+        }
+        solid->properties->linetype_scale = linetype_scale;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1208,14 +1160,14 @@ dxf_3dsolid_get_visibility
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (solid->visibility < 0)
+        if (solid->properties->visibility < 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (solid->visibility > 1)
+        if (solid->properties->visibility > 1)
         {
                 fprintf (stderr,
                   (_("Error in %s () an out of range value was found.\n")),
@@ -1225,7 +1177,7 @@ dxf_3dsolid_get_visibility
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (solid->visibility);
+        return (solid->properties->visibility);
 }
 
 
@@ -1266,7 +1218,11 @@ dxf_3dsolid_set_visibility
                   __FUNCTION__);
                 return (NULL);
         }
-        solid->visibility = visibility;
+        if (dxf_graphic_properties_unshare (&solid->properties) == NULL)
+        {
+                return (NULL);
+        }
+        solid->properties->visibility = visibility;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1297,7 +1253,7 @@ dxf_3dsolid_get_color
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (solid->color < 0)
+        if (solid->properties->color < 0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found.\n")),
@@ -1306,7 +1262,7 @@ dxf_3dsolid_get_color
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (solid->color);
+        return (solid->properties->color);
 }
 
 
@@ -1339,7 +1295,11 @@ dxf_3dsolid_set_color
                   (_("Warning in %s () a negativevalue was passed.\n")),
                   __FUNCTION__);
         }
-        solid->color = color;
+        if (dxf_graphic_properties_unshare (&solid->properties) == NULL)
+        {
+                return (NULL);
+        }
+        solid->properties->color = color;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1370,13 +1330,13 @@ dxf_3dsolid_get_paperspace
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (solid->paperspace < 0)
+        if (solid->properties->paperspace < 0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found.\n")),
                   __FUNCTION__);
         }
-        if (solid->paperspace > 1)
+        if (solid->properties->paperspace > 1)
         {
                 fprintf (stderr,
                   (_("Warning in %s () an out of range value was found.\n")),
@@ -1385,7 +1345,7 @@ dxf_3dsolid_get_paperspace
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (solid->paperspace);
+        return (solid->properties->paperspace);
 }
 
 
@@ -1426,7 +1386,11 @@ dxf_3dsolid_set_paperspace
                   __FUNCTION__);
                 return (NULL);
         }
-        solid->paperspace = paperspace;
+        if (dxf_graphic_properties_unshare (&solid->properties) == NULL)
+        {
+                return (NULL);
+        }
+        solid->properties->paperspace = paperspace;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1550,14 +1514,14 @@ dxf_3dsolid_get_shadow_mode
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (solid->shadow_mode < 0)
+        if (solid->properties->shadow_mode < 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (solid->shadow_mode > 3)
+        if (solid->properties->shadow_mode > 3)
         {
                 fprintf (stderr,
                   (_("Error in %s () an out of range value was found.\n")),
@@ -1567,7 +1531,7 @@ dxf_3dsolid_get_shadow_mode
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (solid->shadow_mode);
+        return (solid->properties->shadow_mode);
 }
 
 
@@ -1611,7 +1575,11 @@ dxf_3dsolid_set_shadow_mode
                   __FUNCTION__);
                 return (NULL);
         }
-        solid->shadow_mode = shadow_mode;
+        if (dxf_graphic_properties_unshare (&solid->properties) == NULL)
+        {
+                return (NULL);
+        }
+        solid->properties->shadow_mode = shadow_mode;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1738,7 +1706,7 @@ dxf_3dsolid_get_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (solid->dictionary_owner_soft));
+        return (dxf_strdup (solid->dictionary_owner_soft));
 }
 
 
@@ -1774,7 +1742,7 @@ dxf_3dsolid_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        solid->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        solid->dictionary_owner_soft = dxf_strdup (dictionary_owner_soft);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1809,7 +1777,7 @@ dxf_3dsolid_get_material
                   __FUNCTION__);
                 return (NULL);
         }
-        if (solid->material ==  NULL)
+        if (solid->properties->material ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found.\n")),
@@ -1819,7 +1787,7 @@ dxf_3dsolid_get_material
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (solid->material));
+        return (dxf_strdup (solid->properties->material));
 }
 
 
@@ -1857,7 +1825,12 @@ dxf_3dsolid_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        solid->material = strdup (material);
+        if (dxf_graphic_properties_unshare (&solid->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (solid->properties->material);
+        solid->properties->material = dxf_strdup (material);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1901,7 +1874,7 @@ dxf_3dsolid_get_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (solid->dictionary_owner_hard));
+        return (dxf_strdup (solid->dictionary_owner_hard));
 }
 
 
@@ -1937,7 +1910,7 @@ dxf_3dsolid_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        solid->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        solid->dictionary_owner_hard = dxf_strdup (dictionary_owner_hard);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1972,7 +1945,7 @@ dxf_3dsolid_get_lineweight
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (solid->lineweight);
+        return (solid->properties->lineweight);
 }
 
 
@@ -2002,7 +1975,11 @@ dxf_3dsolid_set_lineweight
                   __FUNCTION__);
                 return (NULL);
         }
-        solid->lineweight = lineweight;
+        if (dxf_graphic_properties_unshare (&solid->properties) == NULL)
+        {
+                return (NULL);
+        }
+        solid->properties->lineweight = lineweight;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2034,7 +2011,7 @@ dxf_3dsolid_get_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        if (solid->plot_style_name ==  NULL)
+        if (solid->properties->plot_style_name ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found.\n")),
@@ -2044,7 +2021,7 @@ dxf_3dsolid_get_plot_style_name
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (solid->plot_style_name));
+        return (dxf_strdup (solid->properties->plot_style_name));
 }
 
 
@@ -2082,7 +2059,12 @@ dxf_3dsolid_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        solid->plot_style_name = strdup (plot_style_name);
+        if (dxf_graphic_properties_unshare (&solid->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (solid->properties->plot_style_name);
+        solid->properties->plot_style_name = dxf_strdup (plot_style_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2117,7 +2099,7 @@ dxf_3dsolid_get_color_value
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (solid->color_value);
+        return (solid->properties->color_value);
 }
 
 
@@ -2147,7 +2129,11 @@ dxf_3dsolid_set_color_value
                   __FUNCTION__);
                 return (NULL);
         }
-        solid->color_value = color_value;
+        if (dxf_graphic_properties_unshare (&solid->properties) == NULL)
+        {
+                return (NULL);
+        }
+        solid->properties->color_value = color_value;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2179,7 +2165,7 @@ dxf_3dsolid_get_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        if (solid->color_name ==  NULL)
+        if (solid->properties->color_name ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found.\n")),
@@ -2189,7 +2175,7 @@ dxf_3dsolid_get_color_name
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (solid->color_name));
+        return (dxf_strdup (solid->properties->color_name));
 }
 
 
@@ -2227,7 +2213,12 @@ dxf_3dsolid_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        solid->color_name = strdup (color_name);
+        if (dxf_graphic_properties_unshare (&solid->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (solid->properties->color_name);
+        solid->properties->color_name = dxf_strdup (color_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2262,7 +2253,7 @@ dxf_3dsolid_get_transparency
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (solid->transparency);
+        return (solid->properties->transparency);
 }
 
 
@@ -2292,7 +2283,11 @@ dxf_3dsolid_set_transparency
                   __FUNCTION__);
                 return (NULL);
         }
-        solid->transparency = transparency;
+        if (dxf_graphic_properties_unshare (&solid->properties) == NULL)
+        {
+                return (NULL);
+        }
+        solid->properties->transparency = transparency;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2582,7 +2577,7 @@ dxf_3dsolid_get_history
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (solid->history));
+        return (dxf_strdup (solid->history));
 }
 
 
@@ -2616,7 +2611,7 @@ dxf_3dsolid_set_history
                   __FUNCTION__);
                 return (NULL);
         }
-        solid->history = strdup (history);
+        solid->history = dxf_strdup (history);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -52,6 +52,9 @@
 
 
 #include "acad_proxy_entity.h"
+#include "arena.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -74,7 +77,7 @@ dxf_acad_proxy_entity_new ()
         size = sizeof (DxfAcadProxyEntity);
         /* avoid malloc of 0 bytes */
         if (size == 0) size = 1;
-        if ((acad_proxy_entity = malloc (size)) == NULL)
+        if ((acad_proxy_entity = dxf_malloc (size)) == NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () could not allocate memory for a DxfAcadProxyEntity struct.\n")),
@@ -125,23 +128,9 @@ dxf_acad_proxy_entity_init
                 return (NULL);
         }
         dxf_acad_proxy_entity_set_id_code (acad_proxy_entity, 0);
-        dxf_acad_proxy_entity_set_linetype (acad_proxy_entity, strdup (DXF_DEFAULT_LINETYPE));
-        dxf_acad_proxy_entity_set_layer (acad_proxy_entity, strdup (DXF_DEFAULT_LAYER));
-        dxf_acad_proxy_entity_set_elevation (acad_proxy_entity, 0.0);
-        dxf_acad_proxy_entity_set_thickness (acad_proxy_entity, 0.0);
-        dxf_acad_proxy_entity_set_linetype_scale (acad_proxy_entity, DXF_DEFAULT_LINETYPE_SCALE);
-        dxf_acad_proxy_entity_set_visibility (acad_proxy_entity, 0);
-        dxf_acad_proxy_entity_set_color (acad_proxy_entity, DXF_COLOR_BYLAYER);
-        dxf_acad_proxy_entity_set_paperspace (acad_proxy_entity, DXF_PAPERSPACE);
-        dxf_acad_proxy_entity_set_shadow_mode (acad_proxy_entity, 0);
-        dxf_acad_proxy_entity_set_dictionary_owner_soft (acad_proxy_entity, strdup (""));
-        dxf_acad_proxy_entity_set_material (acad_proxy_entity, strdup (""));
-        dxf_acad_proxy_entity_set_dictionary_owner_hard (acad_proxy_entity, strdup (""));
-        dxf_acad_proxy_entity_set_lineweight (acad_proxy_entity, 0);
-        dxf_acad_proxy_entity_set_plot_style_name (acad_proxy_entity, strdup (""));
-        dxf_acad_proxy_entity_set_color_value (acad_proxy_entity, 0);
-        dxf_acad_proxy_entity_set_color_name (acad_proxy_entity, strdup (""));
-        dxf_acad_proxy_entity_set_transparency (acad_proxy_entity, 0);
+        acad_proxy_entity->properties = dxf_graphic_properties_default ();
+        dxf_acad_proxy_entity_set_dictionary_owner_soft (acad_proxy_entity, "");
+        dxf_acad_proxy_entity_set_dictionary_owner_hard (acad_proxy_entity, "");
         dxf_acad_proxy_entity_set_original_custom_object_data_format (acad_proxy_entity, 1);
         dxf_acad_proxy_entity_set_proxy_entity_class_id (acad_proxy_entity, DXF_DEFAULT_PROXY_ENTITY_ID);
         dxf_acad_proxy_entity_set_application_entity_class_id (acad_proxy_entity, 0);
@@ -153,7 +142,7 @@ dxf_acad_proxy_entity_init
         dxf_acad_proxy_entity_set_binary_entity_data (acad_proxy_entity, (DxfBinaryEntityData *) dxf_binary_entity_data_new ());
         dxf_binary_entity_data_init (dxf_acad_proxy_entity_get_binary_entity_data (acad_proxy_entity));
         dxf_acad_proxy_entity_set_object_id (acad_proxy_entity, (DxfObjectId *) dxf_object_id_new ());
-        dxf_object_id_set_data (dxf_acad_proxy_entity_get_object_id (acad_proxy_entity), strdup (""));
+        dxf_object_id_set_data (dxf_acad_proxy_entity_get_object_id (acad_proxy_entity), dxf_strdup (""));
         dxf_acad_proxy_entity_set_next (acad_proxy_entity, NULL);
 #if DEBUG
         DXF_DEBUG_END
@@ -186,9 +175,12 @@ dxf_acad_proxy_entity_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfGraphicProperties properties;
+        DxfPair pair;
         int i; /* flags whether group code 330, 340, 350 or 360 has been
                 * parsed for a first time. */
+        DxfBinaryGraphicsData *binary_graphics_data = NULL;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -196,8 +188,6 @@ dxf_acad_proxy_entity_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (fp->acad_version_number < AutoCAD_13)
@@ -214,269 +204,222 @@ dxf_acad_proxy_entity_read
                 acad_proxy_entity = dxf_acad_proxy_entity_new ();
                 acad_proxy_entity = dxf_acad_proxy_entity_init (acad_proxy_entity);
         }
+        binary_graphics_data = (DxfBinaryGraphicsData *) acad_proxy_entity->binary_graphics_data;
         i = 0;
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        dxf_graphic_properties_start (&properties, acad_proxy_entity->properties);
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        /* Clean up. */
-                        free (temp_string);
-                        fclose (fp->fp);
-                        return (NULL);
-                }
-                else if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &acad_proxy_entity->id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing the linetype
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", acad_proxy_entity->linetype);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing the layer
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", acad_proxy_entity->layer);
-                }
-                else if ((fp->acad_version_number <= AutoCAD_11)
-                  && DXF_FLATLAND
-                  && (strcmp (temp_string, "38") == 0)
-                  && (acad_proxy_entity->elevation != 0.0))
-                {
-                        /* Now follows a string containing the
-                         * elevation. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &acad_proxy_entity->elevation);
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &acad_proxy_entity->thickness);
-                }
-                else if (strcmp (temp_string, "48") == 0)
-                {
-                        /* Now follows a string containing the linetype
-                         * scale value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &acad_proxy_entity->linetype_scale);
-                }
-                else if (strcmp (temp_string, "60") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing the object
-                         * visability value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &acad_proxy_entity->visibility);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else if (strcmp (temp_string, "62") == 0)
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &acad_proxy_entity->color);
-                }
-                else if ((fp->acad_version_number >= AutoCAD_2000)
-                  && (strcmp (temp_string, "70") == 0))
-                {
-                        /* Now follows a string containing the original
-                         * custom object data format value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &acad_proxy_entity->original_custom_object_data_format);
-                        if (acad_proxy_entity->original_custom_object_data_format != 1)
-                        {
-                                fprintf (stderr,
-                                  (_("Error in %s () found a bad original custom object data format value in: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "90") == 0)
-                {
-                        /* Now follows a string containing the proxy
-                         * entity ID value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &acad_proxy_entity->proxy_entity_class_id);
-                        if (acad_proxy_entity->proxy_entity_class_id != DXF_DEFAULT_PROXY_ENTITY_ID)
-                        {
-                                fprintf (stderr,
-                                  (_("Warning in %s () found a bad proxy entity class ID in: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "91") == 0)
-                {
-                        /* Now follows a string containing the application
-                         * entity ID value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &acad_proxy_entity->application_entity_class_id);
-                        if (acad_proxy_entity->application_entity_class_id < 500)
-                        {
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                acad_proxy_entity->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 6:
+                                /* Now follows a string containing the linetype
+                                 * name. */
+                                dxf_lexer_free_string (fp, properties.linetype);
+                                properties.linetype = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 8:
+                                /* Now follows a string containing the layer
+                                 * name. */
+                                dxf_lexer_free_string (fp, properties.layer);
+                                properties.layer = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 38:
+                                if ((fp->acad_version_number <= AutoCAD_11)
+                                  && DXF_FLATLAND
+                                  && (properties.elevation != 0.0))
+                                {
+                                        /* Now follows a string containing the
+                                         * elevation. */
+                                        properties.elevation = dxf_pair_get_double (&pair);
+                                }
+                                break;
+                        case 39:
+                                /* Now follows a string containing the
+                                 * thickness. */
+                                properties.thickness = dxf_pair_get_double (&pair);
+                                break;
+                        case 48:
+                                /* Now follows a string containing the linetype
+                                 * scale value. */
+                                properties.linetype_scale = dxf_pair_get_double (&pair);
+                                break;
+                        case 60:
+                                /* Now follows a string containing the object
+                                 * visability value. */
+                                properties.visibility = dxf_pair_get_int (&pair);
+                                break;
+                        case 62:
+                                /* Now follows a string containing the
+                                 * color value. */
+                                properties.color = dxf_pair_get_int (&pair);
+                                break;
+                        case 70:
+                                if (fp->acad_version_number >= AutoCAD_2000)
+                                {
+                                        /* Now follows a string containing the original
+                                         * custom object data format value. */
+                                        acad_proxy_entity->original_custom_object_data_format = dxf_pair_get_int (&pair);
+                                        if (acad_proxy_entity->original_custom_object_data_format != 1)
+                                        {
+                                                fprintf (stderr,
+                                                  (_("Error in %s () found a bad original custom object data format value in: %s in line: %d.\n")),
+                                                  __FUNCTION__, fp->filename, fp->line_number);
+                                        }
+                                }
+                                break;
+                        case 90:
+                                /* Now follows a string containing the proxy
+                                 * entity ID value. */
+                                acad_proxy_entity->proxy_entity_class_id = dxf_pair_get_int (&pair);
+                                if (acad_proxy_entity->proxy_entity_class_id != DXF_DEFAULT_PROXY_ENTITY_ID)
+                                {
+                                        fprintf (stderr,
+                                          (_("Warning in %s () found a bad proxy entity class ID in: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                }
+                                break;
+                        case 91:
+                                /* Now follows a string containing the application
+                                 * entity ID value. */
+                                acad_proxy_entity->application_entity_class_id = dxf_pair_get_int (&pair);
+                                if (acad_proxy_entity->application_entity_class_id < 500)
+                                {
+                                        fprintf (stderr,
+                                          (_("Warning in %s () found a bad value in application entity class ID in: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                }
+                                break;
+                        case 92:
+                                /* Now follows a string containing the graphics
+                                 * data size value (bytes). */
+                                acad_proxy_entity->graphics_data_size = dxf_pair_get_int (&pair);
+                                break;
+                        case 93:
+                                /* Now follows a string containing the entity
+                                 * data size value (bits). */
+                                acad_proxy_entity->graphics_data_size = dxf_pair_get_int (&pair);
+                                break;
+                        case 95:
+                                if (fp->acad_version_number >= AutoCAD_2000)
+                                {
+                                        /* Now follows a string containing the object
+                                         * drawing format value. */
+                                        acad_proxy_entity->object_drawing_format = dxf_pair_get_long (&pair);
+                                }
+                                break;
+                        case 100:
+                                if (fp->acad_version_number >= AutoCAD_13)
+                                {
+                                        /* Now follows a string containing the
+                                         * subclass marker value. */
+                                        dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                        if ((strcmp (temp_string, "AcDbEntity") != 0)
+                                          && ((strcmp (temp_string, "AcDbZombieEntity") != 0))
+                                          && ((strcmp (temp_string, "AcDbProxyEntity") != 0)))
+                                        {
+                                                fprintf (stderr,
+                                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                                  __FUNCTION__, fp->filename, fp->line_number);
+                                        }
+                                }
+                                break;
+                        case 284:
+                                /* Now follows a string containing the shadow
+                                 * mode value. */
+                                properties.shadow_mode = dxf_pair_get_int (&pair);
+                                break;
+                        case 310:
+                                /* Now follows a string containing binary
+                                 * graphics data. */
+                                binary_graphics_data = dxf_binary_graphics_data_append_line
+                                  (binary_graphics_data,
+                                  dxf_pair_get_string (&pair));
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, acad_proxy_entity->dictionary_owner_soft);
+                                acad_proxy_entity->dictionary_owner_soft = dxf_pair_intern_string (fp, &pair);
+                                i++;
+                                break;
+                        case 340:
+                        case 350:
+                        case 360:
+                                if (!i) /* For the very first object_id. */
+                                {
+                                        dxf_object_id_set_group_code (acad_proxy_entity->object_id, pair.group_code);
+                                        /* Now follows a string containing an object id line of data. */
+                                        acad_proxy_entity->object_id->data = dxf_pair_get_string (&pair);
+                                }
+                                else /* For following object_id's. */
+                                {
+                                        DxfObjectId *iter = dxf_object_id_get_last ((DxfObjectId *) acad_proxy_entity->object_id);
+                                        iter = dxf_object_id_init ((DxfObjectId *) iter->next);
+                                        dxf_object_id_set_group_code (iter, pair.group_code);
+                                        /* Now follows a string containing an object id line of data. */
+                                        dxf_free (iter->data);
+                                        iter->data = dxf_pair_get_string (&pair);
+                                }
+                                i++;
+                                break;
+                        case 347:
+                                /* Now follows a string containing a
+                                 * hard-pointer ID/handle to material object. */
+                                dxf_lexer_free_string (fp, properties.material);
+                                properties.material = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 370:
+                                /* Now follows a string containing the lineweight
+                                 * value. */
+                                properties.lineweight = dxf_pair_get_int (&pair);
+                                break;
+                        case 390:
+                                /* Now follows a string containing a plot style
+                                 * name value. */
+                                dxf_lexer_free_string (fp, properties.plot_style_name);
+                                properties.plot_style_name = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 420:
+                                /* Now follows a string containing a color value. */
+                                properties.color_value = dxf_pair_get_long (&pair);
+                                break;
+                        case 430:
+                                /* Now follows a string containing a color
+                                 * name value. */
+                                dxf_lexer_free_string (fp, properties.color_name);
+                                properties.color_name = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 440:
+                                /* Now follows a string containing a transparency
+                                 * value. */
+                                properties.transparency = dxf_pair_get_long (&pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, "DXF comment: %s\n", temp_string);
+                                break;
+                        default:
                                 fprintf (stderr,
-                                  (_("Warning in %s () found a bad value in application entity class ID in: %s in line: %d.\n")),
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
                                   __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "92") == 0)
-                {
-                        /* Now follows a string containing the graphics
-                         * data size value (bytes). */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &acad_proxy_entity->graphics_data_size);
-                }
-                else if (strcmp (temp_string, "93") == 0)
-                {
-                        /* Now follows a string containing the entity
-                         * data size value (bits). */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &acad_proxy_entity->graphics_data_size);
-                }
-                else if ((fp->acad_version_number >= AutoCAD_2000)
-                  && (strcmp (temp_string, "95") == 0))
-                {
-                        /* Now follows a string containing the object
-                         * drawing format value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%ld\n", &acad_proxy_entity->object_drawing_format);
-                }
-                else if ((fp->acad_version_number >= AutoCAD_13)
-                  && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if ((strcmp (temp_string, "AcDbEntity") != 0)
-                          && ((strcmp (temp_string, "AcDbZombieEntity") != 0))
-                          && ((strcmp (temp_string, "AcDbProxyEntity") != 0)))
-                        {
-                                fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "284") == 0)
-                {
-                        /* Now follows a string containing the shadow
-                         * mode value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &acad_proxy_entity->shadow_mode);
-                }
-                else if (strcmp (temp_string, "310") == 0)
-                {
-                        /* Now follows a string containing binary
-                         * graphics data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", acad_proxy_entity->binary_graphics_data->data_line);
-                        dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) acad_proxy_entity->binary_graphics_data->next);
-                        acad_proxy_entity->binary_graphics_data = (DxfBinaryGraphicsData *) acad_proxy_entity->binary_graphics_data->next;
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", acad_proxy_entity->dictionary_owner_soft);
-                        i++;
-                }
-                else if ((strcmp (temp_string, "330") == 0)
-                  || (strcmp (temp_string, "340") == 0)
-                  || (strcmp (temp_string, "350") == 0)
-                  || (strcmp (temp_string, "360") == 0))
-                {
-                        if (!i) /* For the very first object_id. */
-                        {
-                                dxf_object_id_set_group_code (acad_proxy_entity->object_id, atoi (temp_string));
-                                /* Now follows a string containing an object id line of data. */
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%s\n", acad_proxy_entity->object_id->data);
-                        }
-                        else /* For following object_id's. */
-                        {
-                                DxfObjectId *iter = dxf_object_id_get_last ((DxfObjectId *) acad_proxy_entity->object_id);
-                                iter = dxf_object_id_init ((DxfObjectId *) iter->next);
-                                dxf_object_id_set_group_code (iter, atoi (temp_string));
-                                /* Now follows a string containing an object id line of data. */
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%s\n", iter->data);
-                        }
-                        i++;
-                }
-                else if (strcmp (temp_string, "347") == 0)
-                {
-                        /* Now follows a string containing a
-                         * hard-pointer ID/handle to material object. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", acad_proxy_entity->material);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", acad_proxy_entity->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "370") == 0)
-                {
-                        /* Now follows a string containing the lineweight
-                         * value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &acad_proxy_entity->lineweight);
-                }
-                else if (strcmp (temp_string, "390") == 0)
-                {
-                        /* Now follows a string containing a plot style
-                         * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", acad_proxy_entity->plot_style_name);
-                }
-                else if (strcmp (temp_string, "420") == 0)
-                {
-                        /* Now follows a string containing a color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%ld\n", &acad_proxy_entity->color_value);
-                }
-                else if (strcmp (temp_string, "430") == 0)
-                {
-                        /* Now follows a string containing a color
-                         * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", acad_proxy_entity->color_name);
-                }
-                else if (strcmp (temp_string, "440") == 0)
-                {
-                        /* Now follows a string containing a transparency
-                         * value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%ld\n", &acad_proxy_entity->transparency);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
-        /* Clean up. */
-        free (temp_string);
+        /* Entities with equal properties share a record. */
+        dxf_graphic_properties_finish (fp, &acad_proxy_entity->properties, &properties);
 #if DEBUG
         fprintf (stderr,
           (_("Information from %s() read %d object_id's from %s.\n")),
@@ -514,7 +457,7 @@ dxf_acad_proxy_entity_write
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (acad_proxy_entity == NULL)
@@ -523,7 +466,7 @@ dxf_acad_proxy_entity_write
                   (_("Error in %s () a NULL pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (fp->acad_version_number < AutoCAD_13)
@@ -534,7 +477,7 @@ dxf_acad_proxy_entity_write
                           (_("Error in %s () illegal DXF version for this entity.\n")),
                           __FUNCTION__);
                         fprintf (stderr,
-                          (_("\t entity %s with ID code %d is omitted from output.\n")),
+                          (_("\t entity %s with ID code %ld is omitted from output.\n")),
                           dxf_entity_name, dxf_acad_proxy_entity_get_id_code (acad_proxy_entity));
                         return (EXIT_FAILURE);
                 }
@@ -547,17 +490,17 @@ dxf_acad_proxy_entity_write
         }
         if (fp->acad_version_number <= AutoCAD_13)
         {
-                dxf_entity_name = strdup ("ACAD_ZOMBIE_ENTITY");
+                dxf_entity_name = dxf_strdup ("ACAD_ZOMBIE_ENTITY");
         }
         else if (fp->acad_version_number >= AutoCAD_14)
         {
-                dxf_entity_name = strdup ("ACAD_PROXY_ENTITY");
+                dxf_entity_name = dxf_strdup ("ACAD_PROXY_ENTITY");
         }
         if ((strcmp (dxf_acad_proxy_entity_get_layer (acad_proxy_entity), "") == 0)
           || (dxf_acad_proxy_entity_get_layer (acad_proxy_entity) == NULL))
         {
                 fprintf (stderr,
-                  (_("Warning in %s () invalid layer string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () invalid layer string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_acad_proxy_entity_get_id_code (acad_proxy_entity));
                 fprintf (stderr,
                   (_("    %s entity is relocated to layer 0\n")),
@@ -567,7 +510,7 @@ dxf_acad_proxy_entity_write
         if (dxf_acad_proxy_entity_get_linetype (acad_proxy_entity) == NULL)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () invalid linetype string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () invalid linetype string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_acad_proxy_entity_get_id_code (acad_proxy_entity));
                 fprintf (stderr,
                   (_("\t%s linetype is set to %s\n")),
@@ -575,10 +518,10 @@ dxf_acad_proxy_entity_write
                 dxf_acad_proxy_entity_set_linetype (acad_proxy_entity, DXF_DEFAULT_LINETYPE);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
-        if (dxf_acad_proxy_entity_get_id_code (acad_proxy_entity) != -1)
+        dxf_write_string (fp, 0, dxf_entity_name);
+        if (acad_proxy_entity->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", dxf_acad_proxy_entity_get_id_code (acad_proxy_entity));
+                dxf_write_hex (fp, 5, dxf_acad_proxy_entity_get_id_code (acad_proxy_entity));
         }
         /*!
          * \todo for version R14.\n
@@ -593,87 +536,87 @@ dxf_acad_proxy_entity_write
         if ((strcmp (dxf_acad_proxy_entity_get_dictionary_owner_soft (acad_proxy_entity), "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", dxf_acad_proxy_entity_get_dictionary_owner_soft (acad_proxy_entity));
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, dxf_acad_proxy_entity_get_dictionary_owner_soft (acad_proxy_entity));
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (dxf_acad_proxy_entity_get_dictionary_owner_hard (acad_proxy_entity), "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", dxf_acad_proxy_entity_get_dictionary_owner_hard (acad_proxy_entity));
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, dxf_acad_proxy_entity_get_dictionary_owner_hard (acad_proxy_entity));
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbEntity\n");
+                dxf_write_string (fp, 100, "AcDbEntity");
         }
         if (dxf_acad_proxy_entity_get_paperspace (acad_proxy_entity) == DXF_PAPERSPACE)
         {
-                fprintf (fp->fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_int (fp, 67, DXF_PAPERSPACE);
         }
-        fprintf (fp->fp, "  8\n%s\n", dxf_acad_proxy_entity_get_layer (acad_proxy_entity));
+        dxf_write_string (fp, 8, dxf_acad_proxy_entity_get_layer (acad_proxy_entity));
         if (strcmp (dxf_acad_proxy_entity_get_linetype (acad_proxy_entity), DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp->fp, "  6\n%s\n", dxf_acad_proxy_entity_get_linetype (acad_proxy_entity));
+                dxf_write_string (fp, 6, dxf_acad_proxy_entity_get_linetype (acad_proxy_entity));
         }
         if ((fp->acad_version_number >= AutoCAD_2008)
           && (strcmp (dxf_acad_proxy_entity_get_material (acad_proxy_entity), "") != 0))
         {
-                fprintf (fp->fp, "347\n%s\n", dxf_acad_proxy_entity_get_material (acad_proxy_entity));
+                dxf_write_string (fp, 347, dxf_acad_proxy_entity_get_material (acad_proxy_entity));
         }
         if (dxf_acad_proxy_entity_get_color (acad_proxy_entity) != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp->fp, " 62\n%d\n", dxf_acad_proxy_entity_get_color (acad_proxy_entity));
+                dxf_write_int (fp, 62, dxf_acad_proxy_entity_get_color (acad_proxy_entity));
         }
         if (fp->acad_version_number >= AutoCAD_2002)
         {
-                fprintf (fp->fp, "370\n%d\n", dxf_acad_proxy_entity_get_lineweight (acad_proxy_entity));
+                dxf_write_int (fp, 370, dxf_acad_proxy_entity_get_lineweight (acad_proxy_entity));
         }
         if ((fp->acad_version_number <= AutoCAD_11)
           && DXF_FLATLAND
           && (dxf_acad_proxy_entity_get_elevation (acad_proxy_entity) != 0.0))
         {
-                fprintf (fp->fp, " 38\n%f\n", dxf_acad_proxy_entity_get_elevation (acad_proxy_entity));
+                dxf_write_double (fp, 38, dxf_acad_proxy_entity_get_elevation (acad_proxy_entity));
         }
         if ((fp->acad_version_number <= AutoCAD_13)
           && (dxf_acad_proxy_entity_get_thickness (acad_proxy_entity) != 0.0))
         {
-                fprintf (fp->fp, " 39\n%f\n", dxf_acad_proxy_entity_get_thickness (acad_proxy_entity));
+                dxf_write_double (fp, 39, dxf_acad_proxy_entity_get_thickness (acad_proxy_entity));
         }
-        fprintf (fp->fp, " 48\n%f\n", dxf_acad_proxy_entity_get_linetype_scale (acad_proxy_entity));
-        fprintf (fp->fp, " 60\n%d\n", dxf_acad_proxy_entity_get_visibility (acad_proxy_entity));
+        dxf_write_double (fp, 48, dxf_acad_proxy_entity_get_linetype_scale (acad_proxy_entity));
+        dxf_write_int (fp, 60, dxf_acad_proxy_entity_get_visibility (acad_proxy_entity));
         if (fp->acad_version_number >= AutoCAD_2004)
         {
-                fprintf (fp->fp, "420\n%ld\n", dxf_acad_proxy_entity_get_color_value (acad_proxy_entity));
-                fprintf (fp->fp, "430\n%s\n", dxf_acad_proxy_entity_get_color_name (acad_proxy_entity));
-                fprintf (fp->fp, "440\n%ld\n", dxf_acad_proxy_entity_get_transparency (acad_proxy_entity));
+                dxf_write_long (fp, 420, dxf_acad_proxy_entity_get_color_value (acad_proxy_entity));
+                dxf_write_string (fp, 430, dxf_acad_proxy_entity_get_color_name (acad_proxy_entity));
+                dxf_write_long (fp, 440, dxf_acad_proxy_entity_get_transparency (acad_proxy_entity));
         }
         if (fp->acad_version_number >= AutoCAD_2009)
         {
-                fprintf (fp->fp, "390\n%s\n", dxf_acad_proxy_entity_get_plot_style_name (acad_proxy_entity));
-                fprintf (fp->fp, "284\n%d\n", dxf_acad_proxy_entity_get_shadow_mode (acad_proxy_entity));
+                dxf_write_string (fp, 390, dxf_acad_proxy_entity_get_plot_style_name (acad_proxy_entity));
+                dxf_write_int (fp, 284, dxf_acad_proxy_entity_get_shadow_mode (acad_proxy_entity));
         }
         if (fp->acad_version_number == AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbZombieEntity\n");
+                dxf_write_string (fp, 100, "AcDbZombieEntity");
         }
         if (fp->acad_version_number >= AutoCAD_14)
         {
-                fprintf (fp->fp, "100\nAcDbProxyEntity\n");
+                dxf_write_string (fp, 100, "AcDbProxyEntity");
         }
         if (fp->acad_version_number >= AutoCAD_2000)
         {
-                fprintf (fp->fp, " 70\n%d\n", dxf_acad_proxy_entity_get_original_custom_object_data_format (acad_proxy_entity));
+                dxf_write_int (fp, 70, dxf_acad_proxy_entity_get_original_custom_object_data_format (acad_proxy_entity));
         }
-        fprintf (fp->fp, " 90\n%d\n", dxf_acad_proxy_entity_get_proxy_entity_class_id (acad_proxy_entity));
-        fprintf (fp->fp, " 91\n%d\n", dxf_acad_proxy_entity_get_application_entity_class_id (acad_proxy_entity));
+        dxf_write_int (fp, 90, dxf_acad_proxy_entity_get_proxy_entity_class_id (acad_proxy_entity));
+        dxf_write_int (fp, 91, dxf_acad_proxy_entity_get_application_entity_class_id (acad_proxy_entity));
         if (fp->acad_version_number >= AutoCAD_14)
         {
 #ifdef BUILD_64
-                fprintf (fp->fp, "160\n%d\n", dxf_acad_proxy_entity_get_graphics_data_size (acad_proxy_entity));
+                dxf_write_int (fp, 160, dxf_acad_proxy_entity_get_graphics_data_size (acad_proxy_entity));
 #else
-                fprintf (fp->fp, " 92\n%d\n", dxf_acad_proxy_entity_get_graphics_data_size (acad_proxy_entity));
+                dxf_write_int (fp, 92, dxf_acad_proxy_entity_get_graphics_data_size (acad_proxy_entity));
 #endif
                 if (dxf_acad_proxy_entity_get_binary_graphics_data (acad_proxy_entity) != NULL)
                 {
@@ -681,35 +624,35 @@ dxf_acad_proxy_entity_write
                         iter = dxf_acad_proxy_entity_get_binary_graphics_data (acad_proxy_entity);
                         while (iter != NULL)
                         {
-                                fprintf (fp->fp, "310\n%s\n", dxf_binary_graphics_data_get_data_line (iter));
+                                dxf_write_string (fp, 310, dxf_binary_graphics_data_get_data_line (iter));
                                 iter = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_get_next (iter);
                         }
                 }
         }
-        fprintf (fp->fp, " 93\n%d\n", dxf_acad_proxy_entity_get_entity_data_size (acad_proxy_entity));
+        dxf_write_int (fp, 93, dxf_acad_proxy_entity_get_entity_data_size (acad_proxy_entity));
         if (dxf_object_id_get_data (dxf_acad_proxy_entity_get_object_id (acad_proxy_entity)) != NULL)
         {
                 DxfObjectId *object_id_iter;
                 object_id_iter = dxf_acad_proxy_entity_get_object_id (acad_proxy_entity);
                         while (object_id_iter != NULL)
                         {
-                                fprintf (fp->fp, "%d\n%s\n",
+                                dxf_write_string (fp,
                                         dxf_object_id_get_group_code (dxf_acad_proxy_entity_get_object_id (acad_proxy_entity)),
                                         dxf_object_id_get_data (dxf_acad_proxy_entity_get_object_id (acad_proxy_entity)));
                                 object_id_iter = (DxfObjectId *) dxf_object_id_get_next (object_id_iter);
                         }
         }
-        fprintf (fp->fp, " 94\n  0\n");
+        dxf_write_string (fp, 94, "  0");
         if (fp->acad_version_number >= AutoCAD_2000)
         {
-                fprintf (fp->fp, " 95\n%ld\n", dxf_acad_proxy_entity_get_object_drawing_format (acad_proxy_entity));
+                dxf_write_long (fp, 95, dxf_acad_proxy_entity_get_object_drawing_format (acad_proxy_entity));
         }
         if (fp->acad_version_number >= AutoCAD_2000)
         {
-                fprintf (fp->fp, " 70\n%d\n", dxf_acad_proxy_entity_get_original_custom_object_data_format (acad_proxy_entity));
+                dxf_write_int (fp, 70, dxf_acad_proxy_entity_get_original_custom_object_data_format (acad_proxy_entity));
         }
         /* Clean up. */
-        free (dxf_entity_name);
+        dxf_free (dxf_entity_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -744,19 +687,15 @@ dxf_acad_proxy_entity_free
                 __FUNCTION__);
               return (EXIT_FAILURE);
         }
-        free (dxf_acad_proxy_entity_get_linetype (acad_proxy_entity));
-        free (dxf_acad_proxy_entity_get_layer (acad_proxy_entity));
-        free (dxf_acad_proxy_entity_get_dictionary_owner_soft (acad_proxy_entity));
-        free (dxf_acad_proxy_entity_get_material (acad_proxy_entity));
-        free (dxf_acad_proxy_entity_get_dictionary_owner_hard (acad_proxy_entity));
-        free (dxf_acad_proxy_entity_get_plot_style_name (acad_proxy_entity));
-        free (dxf_acad_proxy_entity_get_color_name (acad_proxy_entity));
+        dxf_graphic_properties_free (acad_proxy_entity->properties);
+        dxf_free (acad_proxy_entity->dictionary_owner_soft);
+        dxf_free (acad_proxy_entity->dictionary_owner_hard);
         dxf_binary_graphics_data_free_chain (dxf_acad_proxy_entity_get_binary_graphics_data (acad_proxy_entity));
         for (i = 0; i < DXF_MAX_PARAM; i++)
         {
-                free (acad_proxy_entity->object_id);
+                dxf_free (acad_proxy_entity->object_id);
         }
-        free (acad_proxy_entity);
+        dxf_free (acad_proxy_entity);
         acad_proxy_entity = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -776,7 +715,7 @@ dxf_acad_proxy_entity_free_chain
                 /*!< a pointer to the chain of DXF ACAD_PROXY_ENTITY entities. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (acad_proxy_entities == NULL)
@@ -802,7 +741,7 @@ dxf_acad_proxy_entity_free_chain
  *
  * \return ID code.
  */
-int
+long
 dxf_acad_proxy_entity_get_id_code
 (
         DxfAcadProxyEntity *acad_proxy_entity
@@ -842,7 +781,7 @@ dxf_acad_proxy_entity_set_id_code
 (
         DxfAcadProxyEntity *acad_proxy_entity,
                 /*!< a pointer to a DXF \c ACAD_PROXY_ENTITY entity. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -897,7 +836,7 @@ dxf_acad_proxy_entity_get_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        if (acad_proxy_entity->linetype ==  NULL)
+        if (acad_proxy_entity->properties->linetype ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the linetype member.\n")),
@@ -907,7 +846,7 @@ dxf_acad_proxy_entity_get_linetype
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (acad_proxy_entity->linetype));
+        return (dxf_strdup (acad_proxy_entity->properties->linetype));
 }
 
 
@@ -941,7 +880,12 @@ dxf_acad_proxy_entity_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        acad_proxy_entity->linetype = strdup (linetype);
+        if (dxf_graphic_properties_unshare (&acad_proxy_entity->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (acad_proxy_entity->properties->linetype);
+        acad_proxy_entity->properties->linetype = dxf_strdup (linetype);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -972,7 +916,7 @@ dxf_acad_proxy_entity_get_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        if (acad_proxy_entity->layer ==  NULL)
+        if (acad_proxy_entity->properties->layer ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the layer member.\n")),
@@ -982,7 +926,7 @@ dxf_acad_proxy_entity_get_layer
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (acad_proxy_entity->layer));
+        return (dxf_strdup (acad_proxy_entity->properties->layer));
 }
 
 
@@ -1016,7 +960,12 @@ dxf_acad_proxy_entity_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        acad_proxy_entity->layer = strdup (layer);
+        if (dxf_graphic_properties_unshare (&acad_proxy_entity->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (acad_proxy_entity->properties->layer);
+        acad_proxy_entity->properties->layer = dxf_strdup (layer);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1050,7 +999,7 @@ dxf_acad_proxy_entity_get_elevation
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (acad_proxy_entity->elevation);
+        return (acad_proxy_entity->properties->elevation);
 }
 
 
@@ -1080,7 +1029,11 @@ dxf_acad_proxy_entity_set_elevation
                   __FUNCTION__);
                 return (NULL);
         }
-        acad_proxy_entity->elevation = elevation;
+        if (dxf_graphic_properties_unshare (&acad_proxy_entity->properties) == NULL)
+        {
+                return (NULL);
+        }
+        acad_proxy_entity->properties->elevation = elevation;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1111,7 +1064,7 @@ dxf_acad_proxy_entity_get_thickness
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (acad_proxy_entity->thickness < 0.0)
+        if (acad_proxy_entity->properties->thickness < 0.0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found in the thickness member.\n")),
@@ -1120,7 +1073,7 @@ dxf_acad_proxy_entity_get_thickness
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (acad_proxy_entity->thickness);
+        return (acad_proxy_entity->properties->thickness);
 }
 
 
@@ -1156,7 +1109,11 @@ dxf_acad_proxy_entity_set_thickness
                   (_("Warning in %s () a negative thickness value was passed.\n")),
                   __FUNCTION__);
         }
-        acad_proxy_entity->thickness = thickness;
+        if (dxf_graphic_properties_unshare (&acad_proxy_entity->properties) == NULL)
+        {
+                return (NULL);
+        }
+        acad_proxy_entity->properties->thickness = thickness;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1187,7 +1144,7 @@ dxf_acad_proxy_entity_get_linetype_scale
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (acad_proxy_entity->linetype_scale < 0.0)
+        if (acad_proxy_entity->properties->linetype_scale < 0.0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found in the linetype scale member.\n")),
@@ -1197,7 +1154,7 @@ dxf_acad_proxy_entity_get_linetype_scale
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (acad_proxy_entity->linetype_scale);
+        return (acad_proxy_entity->properties->linetype_scale);
 }
 
 
@@ -1231,7 +1188,11 @@ dxf_acad_proxy_entity_set_linetype_scale
                   __FUNCTION__);
                 return (NULL);
         }
-        acad_proxy_entity->linetype_scale = linetype_scale;
+        if (dxf_graphic_properties_unshare (&acad_proxy_entity->properties) == NULL)
+        {
+                return (NULL);
+        }
+        acad_proxy_entity->properties->linetype_scale = linetype_scale;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1262,14 +1223,14 @@ dxf_acad_proxy_entity_get_visibility
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (acad_proxy_entity->visibility < 0)
+        if (acad_proxy_entity->properties->visibility < 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found in the visibility member.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (acad_proxy_entity->visibility > 1)
+        if (acad_proxy_entity->properties->visibility > 1)
         {
                 fprintf (stderr,
                   (_("Error in %s () an out of range value was found in the visibility member.\n")),
@@ -1279,7 +1240,7 @@ dxf_acad_proxy_entity_get_visibility
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (acad_proxy_entity->visibility);
+        return (acad_proxy_entity->properties->visibility);
 }
 
 
@@ -1320,7 +1281,11 @@ dxf_acad_proxy_entity_set_visibility
                   __FUNCTION__);
                 return (NULL);
         }
-        acad_proxy_entity->visibility = visibility;
+        if (dxf_graphic_properties_unshare (&acad_proxy_entity->properties) == NULL)
+        {
+                return (NULL);
+        }
+        acad_proxy_entity->properties->visibility = visibility;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1351,7 +1316,7 @@ dxf_acad_proxy_entity_get_color
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (acad_proxy_entity->color < 0)
+        if (acad_proxy_entity->properties->color < 0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found in the color member.\n")),
@@ -1360,7 +1325,7 @@ dxf_acad_proxy_entity_get_color
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (acad_proxy_entity->color);
+        return (acad_proxy_entity->properties->color);
 }
 
 
@@ -1395,7 +1360,11 @@ dxf_acad_proxy_entity_set_color
                 fprintf (stderr,
                   (_("\teffectively turning this entity it's visibility off.\n")));
         }
-        acad_proxy_entity->color = color;
+        if (dxf_graphic_properties_unshare (&acad_proxy_entity->properties) == NULL)
+        {
+                return (NULL);
+        }
+        acad_proxy_entity->properties->color = color;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1427,13 +1396,13 @@ dxf_acad_proxy_entity_get_paperspace
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (acad_proxy_entity->paperspace < 0)
+        if (acad_proxy_entity->properties->paperspace < 0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found in the paperspace member.\n")),
                   __FUNCTION__);
         }
-        if (acad_proxy_entity->paperspace > 1)
+        if (acad_proxy_entity->properties->paperspace > 1)
         {
                 fprintf (stderr,
                   (_("Warning in %s () an out of range value was found in the paperspace member.\n")),
@@ -1442,7 +1411,7 @@ dxf_acad_proxy_entity_get_paperspace
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (acad_proxy_entity->paperspace);
+        return (acad_proxy_entity->properties->paperspace);
 }
 
 
@@ -1483,7 +1452,11 @@ dxf_acad_proxy_entity_set_paperspace
                   __FUNCTION__);
                 return (NULL);
         }
-        acad_proxy_entity->paperspace = paperspace;
+        if (dxf_graphic_properties_unshare (&acad_proxy_entity->properties) == NULL)
+        {
+                return (NULL);
+        }
+        acad_proxy_entity->properties->paperspace = paperspace;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1515,14 +1488,14 @@ dxf_acad_proxy_entity_get_shadow_mode
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (acad_proxy_entity->shadow_mode < 0)
+        if (acad_proxy_entity->properties->shadow_mode < 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found in the shadow_mode member.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (acad_proxy_entity->shadow_mode > 3)
+        if (acad_proxy_entity->properties->shadow_mode > 3)
         {
                 fprintf (stderr,
                   (_("Error in %s () an out of range value was found in the shadow_mode member.\n")),
@@ -1532,7 +1505,7 @@ dxf_acad_proxy_entity_get_shadow_mode
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (acad_proxy_entity->shadow_mode);
+        return (acad_proxy_entity->properties->shadow_mode);
 }
 
 
@@ -1576,7 +1549,11 @@ dxf_acad_proxy_entity_set_shadow_mode
                   __FUNCTION__);
                 return (NULL);
         }
-        acad_proxy_entity->shadow_mode = shadow_mode;
+        if (dxf_graphic_properties_unshare (&acad_proxy_entity->properties) == NULL)
+        {
+                return (NULL);
+        }
+        acad_proxy_entity->properties->shadow_mode = shadow_mode;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1620,7 +1597,7 @@ dxf_acad_proxy_entity_get_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (acad_proxy_entity->dictionary_owner_soft));
+        return (dxf_strdup (acad_proxy_entity->dictionary_owner_soft));
 }
 
 
@@ -1656,7 +1633,7 @@ dxf_acad_proxy_entity_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        acad_proxy_entity->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        acad_proxy_entity->dictionary_owner_soft = dxf_strdup (dictionary_owner_soft);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1690,7 +1667,7 @@ dxf_acad_proxy_entity_get_material
                   __FUNCTION__);
                 return (NULL);
         }
-        if (acad_proxy_entity->material ==  NULL)
+        if (acad_proxy_entity->properties->material ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the material member.\n")),
@@ -1700,7 +1677,7 @@ dxf_acad_proxy_entity_get_material
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (acad_proxy_entity->material));
+        return (dxf_strdup (acad_proxy_entity->properties->material));
 }
 
 
@@ -1739,7 +1716,12 @@ dxf_acad_proxy_entity_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        acad_proxy_entity->material = strdup (material);
+        if (dxf_graphic_properties_unshare (&acad_proxy_entity->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (acad_proxy_entity->properties->material);
+        acad_proxy_entity->properties->material = dxf_strdup (material);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1783,7 +1765,7 @@ dxf_acad_proxy_entity_get_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (acad_proxy_entity->dictionary_owner_hard));
+        return (dxf_strdup (acad_proxy_entity->dictionary_owner_hard));
 }
 
 
@@ -1819,7 +1801,7 @@ dxf_acad_proxy_entity_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        acad_proxy_entity->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        acad_proxy_entity->dictionary_owner_hard = dxf_strdup (dictionary_owner_hard);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1854,7 +1836,7 @@ dxf_acad_proxy_entity_get_lineweight
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (acad_proxy_entity->lineweight);
+        return (acad_proxy_entity->properties->lineweight);
 }
 
 
@@ -1884,7 +1866,11 @@ dxf_acad_proxy_entity_set_lineweight
                   __FUNCTION__);
                 return (NULL);
         }
-        acad_proxy_entity->lineweight = lineweight;
+        if (dxf_graphic_properties_unshare (&acad_proxy_entity->properties) == NULL)
+        {
+                return (NULL);
+        }
+        acad_proxy_entity->properties->lineweight = lineweight;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1917,7 +1903,7 @@ dxf_acad_proxy_entity_get_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        if (acad_proxy_entity->plot_style_name ==  NULL)
+        if (acad_proxy_entity->properties->plot_style_name ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the plot_style_name member.\n")),
@@ -1927,7 +1913,7 @@ dxf_acad_proxy_entity_get_plot_style_name
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (acad_proxy_entity->plot_style_name));
+        return (dxf_strdup (acad_proxy_entity->properties->plot_style_name));
 }
 
 
@@ -1965,7 +1951,12 @@ dxf_acad_proxy_entity_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        acad_proxy_entity->plot_style_name = strdup (plot_style_name);
+        if (dxf_graphic_properties_unshare (&acad_proxy_entity->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (acad_proxy_entity->properties->plot_style_name);
+        acad_proxy_entity->properties->plot_style_name = dxf_strdup (plot_style_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2000,7 +1991,7 @@ dxf_acad_proxy_entity_get_color_value
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (acad_proxy_entity->color_value);
+        return (acad_proxy_entity->properties->color_value);
 }
 
 
@@ -2030,7 +2021,11 @@ dxf_acad_proxy_entity_set_color_value
                   __FUNCTION__);
                 return (NULL);
         }
-        acad_proxy_entity->color_value = color_value;
+        if (dxf_graphic_properties_unshare (&acad_proxy_entity->properties) == NULL)
+        {
+                return (NULL);
+        }
+        acad_proxy_entity->properties->color_value = color_value;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2062,7 +2057,7 @@ dxf_acad_proxy_entity_get_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        if (acad_proxy_entity->color_name ==  NULL)
+        if (acad_proxy_entity->properties->color_name ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the color_name member.\n")),
@@ -2072,7 +2067,7 @@ dxf_acad_proxy_entity_get_color_name
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (acad_proxy_entity->color_name));
+        return (dxf_strdup (acad_proxy_entity->properties->color_name));
 }
 
 
@@ -2110,7 +2105,12 @@ dxf_acad_proxy_entity_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        acad_proxy_entity->color_name = strdup (color_name);
+        if (dxf_graphic_properties_unshare (&acad_proxy_entity->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (acad_proxy_entity->properties->color_name);
+        acad_proxy_entity->properties->color_name = dxf_strdup (color_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2145,7 +2145,7 @@ dxf_acad_proxy_entity_get_transparency
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (acad_proxy_entity->transparency);
+        return (acad_proxy_entity->properties->transparency);
 }
 
 
@@ -2175,7 +2175,11 @@ dxf_acad_proxy_entity_set_transparency
                   __FUNCTION__);
                 return (NULL);
         }
-        acad_proxy_entity->transparency = transparency;
+        if (dxf_graphic_properties_unshare (&acad_proxy_entity->properties) == NULL)
+        {
+                return (NULL);
+        }
+        acad_proxy_entity->properties->transparency = transparency;
 #if DEBUG
         DXF_DEBUG_END
 #endif
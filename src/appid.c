@@ -54,6 +54,8 @@
 
 
 #include "appid.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -124,10 +126,10 @@ dxf_appid_init
                 return (NULL);
         }
         dxf_appid_set_id_code (appid, 0);
-        dxf_appid_set_application_name (appid, strdup (""));
+        dxf_appid_set_application_name (appid, "");
         dxf_appid_set_flag (appid, 0);
-        dxf_appid_set_dictionary_owner_soft (appid, strdup (""));
-        dxf_appid_set_dictionary_owner_hard (appid, strdup (""));
+        dxf_appid_set_dictionary_owner_soft (appid, "");
+        dxf_appid_set_dictionary_owner_hard (appid, "");
         dxf_appid_set_next (appid, NULL);
 #if DEBUG
         DXF_DEBUG_END
@@ -160,7 +162,8 @@ dxf_appid_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfPair pair;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -168,8 +171,6 @@ dxf_appid_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (appid == NULL)
@@ -180,71 +181,57 @@ dxf_appid_read
                 appid = dxf_appid_new ();
                 appid = dxf_appid_init (appid);
         }
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        fclose (fp->fp);
-                        /* Clean up. */
-                        free (temp_string);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &appid->id_code);
-                }
-                else if (strcmp (temp_string, "2") == 0)
-                {
-                        /* Now follows a string containing an application
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", appid->application_name);
-                }
-                else if (strcmp (temp_string, "70") == 0)
-                {
-                        /* Now follows a string containing the
-                         * standard flag value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &appid->flag);
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", appid->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", appid->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "999") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else
+                switch (pair.group_code)
                 {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                appid->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 2:
+                                /* Now follows a string containing an application
+                                 * name. */
+                                free (appid->application_name);
+                                appid->application_name = dxf_pair_get_string (&pair);
+                                break;
+                        case 70:
+                                /* Now follows a string containing the
+                                 * standard flag value. */
+                                appid->flag = dxf_pair_get_int (&pair);
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner dictionary. */
+                                free (appid->dictionary_owner_soft);
+                                appid->dictionary_owner_soft = dxf_pair_get_string (&pair);
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                free (appid->dictionary_owner_hard);
+                                appid->dictionary_owner_hard = dxf_pair_get_string (&pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, "DXF comment: %s\n", temp_string);
+                                break;
+                        default:
+                                fprintf (stderr,
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
+                                  __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
-        /* Clean up. */
-        free (temp_string);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -293,7 +280,7 @@ dxf_appid_write
           || (strcmp (dxf_appid_get_application_name (appid), "") == 0))
         {
                 fprintf (stderr,
-                  (_("Error in %s empty string for the %s entity with id-code: %x\n")),
+                  (_("Error in %s empty string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_appid_get_id_code (appid));
                 fprintf (stderr,
                   (_("\t%s entity is discarded from output.\n")),
@@ -309,10 +296,10 @@ dxf_appid_write
                   __FUNCTION__);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
-        if (dxf_appid_get_id_code (appid) != -1)
+        dxf_write_string (fp, 0, dxf_entity_name);
+        if (appid->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", dxf_appid_get_id_code (appid));
+                dxf_write_hex (fp, 5, dxf_appid_get_id_code (appid));
         }
         /*!
          * \todo for version R14.\n
@@ -327,24 +314,24 @@ dxf_appid_write
         if ((strcmp (dxf_appid_get_dictionary_owner_soft (appid), "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", dxf_appid_get_dictionary_owner_soft (appid));
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, dxf_appid_get_dictionary_owner_soft (appid));
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (dxf_appid_get_dictionary_owner_hard (appid), "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", dxf_appid_get_dictionary_owner_hard (appid));
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, dxf_appid_get_dictionary_owner_hard (appid));
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbSymbolTableRecord\n");
-                fprintf (fp->fp, "100\nAcDbRegAppTableRecord\n");
+                dxf_write_string (fp, 100, "AcDbSymbolTableRecord");
+                dxf_write_string (fp, 100, "AcDbRegAppTableRecord");
         }
-        fprintf (fp->fp, "  2\n%s\n", dxf_appid_get_application_name (appid));
-        fprintf (fp->fp, " 70\n%d\n", dxf_appid_get_flag (appid));
+        dxf_write_string (fp, 2, dxf_appid_get_application_name (appid));
+        dxf_write_int (fp, 70, dxf_appid_get_flag (appid));
         /* Clean up. */
         free (dxf_entity_name);
 #if DEBUG
@@ -402,7 +389,7 @@ dxf_appid_free_chain
                  * entries. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (appids == NULL)
@@ -414,6 +401,7 @@ dxf_appid_free_chain
         while (appids != NULL)
         {
                 struct DxfAppid *iter = appids->next;
+                appids->next = NULL;
                 dxf_appid_free (appids);
                 appids = (DxfAppid *) iter;
         }
@@ -428,7 +416,7 @@ dxf_appid_free_chain
  *
  * \return ID code.
  */
-int
+long
 dxf_appid_get_id_code
 (
         DxfAppid *appid
@@ -461,7 +449,7 @@ dxf_appid_set_id_code
 (
         DxfAppid *appid,
                 /*!< a pointer to a DXF \c APPID symbol table entry. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -69,7 +69,7 @@ extern "C" {
 typedef struct
 dxf_appid_struct
 {
-        int id_code;
+        long id_code;
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file.\n
@@ -136,7 +136,7 @@ dxf_appid_free_chain
 (
         DxfAppid *appids
 );
-int
+long
 dxf_appid_get_id_code
 (
         DxfAppid *appid
@@ -145,7 +145,7 @@ DxfAppid *
 dxf_appid_set_id_code
 (
         DxfAppid *appid,
-        int id_code
+        long id_code
 );
 char *
 dxf_appid_get_application_name
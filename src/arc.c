@@ -40,6 +40,9 @@
 
 
 #include "arc.h"
+#include "arena.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -62,7 +65,7 @@ dxf_arc_new ()
         size = sizeof (DxfArc);
         /* avoid malloc of 0 bytes */
         if (size == 0) size = 1;
-        if ((arc = malloc (size)) == NULL)
+        if ((arc = dxf_malloc (size)) == NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () could not allocate memory.\n")),
@@ -113,26 +116,12 @@ dxf_arc_init
                 return (NULL);
         }
         dxf_arc_set_id_code (arc, 0);
-        dxf_arc_set_linetype (arc, strdup (DXF_DEFAULT_LINETYPE));
-        dxf_arc_set_layer (arc, strdup (DXF_DEFAULT_LAYER));
-        dxf_arc_set_elevation (arc, 0.0);
-        dxf_arc_set_thickness (arc, 0.0);
-        dxf_arc_set_linetype_scale (arc, DXF_DEFAULT_LINETYPE_SCALE);
-        dxf_arc_set_visibility (arc, DXF_DEFAULT_VISIBILITY);
-        dxf_arc_set_color (arc, DXF_COLOR_BYLAYER);
-        dxf_arc_set_paperspace (arc, DXF_MODELSPACE);
+        arc->properties = dxf_graphic_properties_default ();
         dxf_arc_set_graphics_data_size (arc, 0);
-        dxf_arc_set_shadow_mode (arc, 0);
         dxf_arc_set_binary_graphics_data (arc, (DxfBinaryGraphicsData *) dxf_binary_graphics_data_new ());
         dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) dxf_arc_get_binary_graphics_data (arc));
-        dxf_arc_set_dictionary_owner_soft (arc, strdup (""));
-        dxf_arc_set_material (arc, strdup (""));
-        dxf_arc_set_dictionary_owner_hard (arc, strdup (""));
-        dxf_arc_set_lineweight (arc, 0);
-        dxf_arc_set_plot_style_name (arc, strdup (""));
-        dxf_arc_set_color_value (arc, 0);
-        dxf_arc_set_color_name (arc, strdup (""));
-        dxf_arc_set_transparency (arc, 0);
+        dxf_arc_set_dictionary_owner_soft (arc, "");
+        dxf_arc_set_dictionary_owner_hard (arc, "");
         dxf_arc_set_p0 (arc, dxf_point_new ());
         dxf_point_init ((DxfPoint *) dxf_arc_get_p0 (arc));
         dxf_arc_set_x0 (arc, 0.0);
@@ -175,7 +164,9 @@ dxf_arc_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfGraphicProperties properties;
+        DxfPair pair;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -183,8 +174,6 @@ dxf_arc_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (arc == NULL)
@@ -195,200 +184,166 @@ dxf_arc_read
                 arc = dxf_arc_new ();
                 arc = dxf_arc_init (arc);
         }
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        dxf_graphic_properties_start (&properties, arc->properties);
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        fclose (fp->fp);
-                        /* Clean up. */
-                        free (temp_string);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &arc->id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", arc->linetype);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", arc->layer);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the center point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &arc->p0->x0);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the center point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &arc->p0->y0);
-                }
-                else if (strcmp (temp_string, "30") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the center point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &arc->p0->z0);
-                }
-                else if ((fp->acad_version_number <= AutoCAD_11)
-                        && (strcmp (temp_string, "38") == 0))
-                {
-                        /* Now follows a string containing the
-                         * elevation. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &arc->elevation);
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &arc->thickness);
-                }
-                else if (strcmp (temp_string, "40") == 0)
-                {
-                        /* Now follows a string containing the
-                         * radius. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &arc->radius);
-                }
-                else if (strcmp (temp_string, "48") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing the linetype
-                         * scale. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &arc->linetype_scale);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else if (strcmp (temp_string, "50") == 0)
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing the
-                         * start angle. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &arc->start_angle);
-                }
-                else if (strcmp (temp_string, "51") == 0)
-                {
-                        /* Now follows a string containing the
-                         * end angle. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &arc->end_angle);
-                }
-                else if (strcmp (temp_string, "60") == 0)
-                {
-                        /* Now follows a string containing the
-                         * visibility value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &arc->visibility);
-                }
-                else if (strcmp (temp_string, "62") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &arc->color);
-                }
-                else if (strcmp (temp_string, "67") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &arc->paperspace);
-                }
-                else if ((fp->acad_version_number >= AutoCAD_13)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if ((strcmp (temp_string, "AcDbEntity") != 0)
-                        && ((strcmp (temp_string, "AcDbCircle") != 0)))
-                        {
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                arc->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 6:
+                                /* Now follows a string containing a linetype
+                                 * name. */
+                                dxf_lexer_free_string (fp, properties.linetype);
+                                properties.linetype = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 8:
+                                /* Now follows a string containing a layer name. */
+                                dxf_lexer_free_string (fp, properties.layer);
+                                properties.layer = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 10:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the center point. */
+                                arc->p0->x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 20:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the center point. */
+                                arc->p0->y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 30:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the center point. */
+                                arc->p0->z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 38:
+                                if (fp->acad_version_number <= AutoCAD_11)
+                                {
+                                        /* Now follows a string containing the
+                                         * elevation. */
+                                        properties.elevation = dxf_pair_get_double (&pair);
+                                }
+                                break;
+                        case 39:
+                                /* Now follows a string containing the
+                                 * thickness. */
+                                properties.thickness = dxf_pair_get_double (&pair);
+                                break;
+                        case 40:
+                                /* Now follows a string containing the
+                                 * radius. */
+                                arc->radius = dxf_pair_get_double (&pair);
+                                break;
+                        case 48:
+                                /* Now follows a string containing the linetype
+                                 * scale. */
+                                properties.linetype_scale = dxf_pair_get_double (&pair);
+                                break;
+                        case 50:
+                                /* Now follows a string containing the
+                                 * start angle. */
+                                arc->start_angle = dxf_pair_get_double (&pair);
+                                break;
+                        case 51:
+                                /* Now follows a string containing the
+                                 * end angle. */
+                                arc->end_angle = dxf_pair_get_double (&pair);
+                                break;
+                        case 60:
+                                /* Now follows a string containing the
+                                 * visibility value. */
+                                properties.visibility = dxf_pair_get_int (&pair);
+                                break;
+                        case 62:
+                                /* Now follows a string containing the
+                                 * color value. */
+                                properties.color = dxf_pair_get_int (&pair);
+                                break;
+                        case 67:
+                                /* Now follows a string containing the
+                                 * paperspace value. */
+                                properties.paperspace = dxf_pair_get_int (&pair);
+                                break;
+                        case 100:
+                                if (fp->acad_version_number >= AutoCAD_13)
+                                {
+                                        /* Now follows a string containing the
+                                         * subclass marker value. */
+                                        dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                        if ((strcmp (temp_string, "AcDbEntity") != 0)
+                                        && ((strcmp (temp_string, "AcDbCircle") != 0)))
+                                        {
+                                                fprintf (stderr,
+                                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                                  __FUNCTION__, fp->filename, fp->line_number);
+                                        }
+                                }
+                                break;
+                        case 210:
+                                /* Now follows a string containing the
+                                 * X-value of the extrusion vector. */
+                                arc->extr_x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 220:
+                                /* Now follows a string containing the
+                                 * Y-value of the extrusion vector. */
+                                arc->extr_y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 230:
+                                /* Now follows a string containing the
+                                 * Z-value of the extrusion vector. */
+                                arc->extr_z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, arc->dictionary_owner_soft);
+                                arc->dictionary_owner_soft = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, arc->dictionary_owner_hard);
+                                arc->dictionary_owner_hard = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, "DXF comment: %s\n", temp_string);
+                                break;
+                        default:
                                 fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
                                   __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "210") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &arc->extr_x0);
-                }
-                else if (strcmp (temp_string, "220") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &arc->extr_y0);
-                }
-                else if (strcmp (temp_string, "230") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &arc->extr_z0);
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", arc->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", arc->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
         /* Handle omitted members and/or illegal values. */
-        if (strcmp (arc->linetype, "") == 0)
+        if ((properties.linetype != NULL)
+          && (strcmp (properties.linetype, "") == 0))
         {
-                arc->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_lexer_free_string (fp, properties.linetype);
+                properties.linetype = dxf_strdup (DXF_DEFAULT_LINETYPE);
         }
-        if (strcmp (arc->layer, "") == 0)
+        if ((properties.layer != NULL)
+          && (strcmp (properties.layer, "") == 0))
         {
-                arc->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_lexer_free_string (fp, properties.layer);
+                properties.layer = dxf_strdup (DXF_DEFAULT_LAYER);
         }
-        /* Clean up. */
-        free (temp_string);
+        /* Entities with equal properties share a record. */
+        dxf_graphic_properties_finish (fp, &arc->properties, &properties);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -414,7 +369,7 @@ dxf_arc_write
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *dxf_entity_name = strdup ("ARC");
+        char *dxf_entity_name = dxf_strdup ("ARC");
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -423,7 +378,7 @@ dxf_arc_write
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (arc == NULL)
@@ -432,84 +387,84 @@ dxf_arc_write
                   (_("Error in %s () a NULL pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (dxf_arc_get_start_angle (arc) == dxf_arc_get_end_angle (arc))
         {
                 fprintf (stderr,
-                  (_("Error in %s () start angle and end angle are identical for the %s entity with id-code: %x.\n")),
+                  (_("Error in %s () start angle and end angle are identical for the %s entity with id-code: %lx.\n")),
                     __FUNCTION__, dxf_entity_name, dxf_arc_get_id_code (arc));
                 fprintf (stderr,
                   (_("\tskipping %s entity.\n")), dxf_entity_name);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (dxf_arc_get_start_angle (arc)> 360.0)
         {
-                fprintf (stderr, "Error in dxf_arc_write () start angle is greater than 360 degrees for the %s entity with id-code: %x.\n",
+                fprintf (stderr, "Error in dxf_arc_write () start angle is greater than 360 degrees for the %s entity with id-code: %lx.\n",
                         dxf_entity_name, dxf_arc_get_id_code (arc));
                 fprintf (stderr, "\tskipping %s entity.\n",
                         dxf_entity_name);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (dxf_arc_get_start_angle (arc) < 0.0)
         {
-                fprintf (stderr, "Error in dxf_arc_write () start angle is lesser than 0 degrees for the %s entity with id-code: %x.\n",
+                fprintf (stderr, "Error in dxf_arc_write () start angle is lesser than 0 degrees for the %s entity with id-code: %lx.\n",
                         dxf_entity_name, dxf_arc_get_id_code (arc));
                 fprintf (stderr, "\tskipping %s entity.\n",
                         dxf_entity_name);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (dxf_arc_get_end_angle (arc) > 360.0)
         {
-                fprintf (stderr, "Error in dxf_arc_write () end angle is greater than 360 degrees for the %s entity with id-code: %x.\n",
+                fprintf (stderr, "Error in dxf_arc_write () end angle is greater than 360 degrees for the %s entity with id-code: %lx.\n",
                         dxf_entity_name, dxf_arc_get_id_code (arc));
                 fprintf (stderr, "\tskipping %s entity.\n",
                         dxf_entity_name);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (dxf_arc_get_end_angle (arc) < 0.0)
         {
-                fprintf (stderr, "Error in dxf_arc_write () end angle is lesser than 0 degrees for the %s entity with id-code: %x.\n",
+                fprintf (stderr, "Error in dxf_arc_write () end angle is lesser than 0 degrees for the %s entity with id-code: %lx.\n",
                         dxf_entity_name, dxf_arc_get_id_code (arc));
                 fprintf (stderr, "\tskipping %s entity.\n",
                         dxf_entity_name);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (dxf_arc_get_radius (arc) == 0.0)
         {
-                fprintf (stderr, "Error in dxf_arc_write () radius value equals 0.0 for the %s entity with id-code: %x.\n",
+                fprintf (stderr, "Error in dxf_arc_write () radius value equals 0.0 for the %s entity with id-code: %lx.\n",
                         dxf_entity_name, dxf_arc_get_id_code (arc));
                 fprintf (stderr, "\tskipping %s entity.\n",
                         dxf_entity_name);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (strcmp (dxf_arc_get_linetype (arc), "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_arc_get_id_code (arc));
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                dxf_arc_set_linetype (arc, strdup (DXF_DEFAULT_LINETYPE));
+                dxf_arc_set_linetype (arc, DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (dxf_arc_get_layer (arc), "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty layer string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty layer string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_arc_get_id_code (arc));
                 fprintf (stderr,
                   (_("\t%s entity is relocated to layer 0")),
@@ -517,10 +472,10 @@ dxf_arc_write
                 dxf_arc_set_layer (arc, DXF_DEFAULT_LAYER);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
-        if (dxf_arc_get_id_code (arc) != -1)
+        dxf_write_string (fp, 0, dxf_entity_name);
+        if (arc->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", dxf_arc_get_id_code (arc));
+                dxf_write_hex (fp, 5, dxf_arc_get_id_code (arc));
         }
         /*!
          * \todo for version R14.\n
@@ -535,77 +490,77 @@ dxf_arc_write
         if ((strcmp (dxf_arc_get_dictionary_owner_soft (arc), "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", dxf_arc_get_dictionary_owner_soft (arc));
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, dxf_arc_get_dictionary_owner_soft (arc));
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (dxf_arc_get_dictionary_owner_hard (arc), "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", dxf_arc_get_dictionary_owner_hard (arc));
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, dxf_arc_get_dictionary_owner_hard (arc));
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbEntity\n");
+                dxf_write_string (fp, 100, "AcDbEntity");
         }
         if (dxf_arc_get_paperspace (arc) == DXF_PAPERSPACE)
         {
-                fprintf (fp->fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_int (fp, 67, DXF_PAPERSPACE);
         }
-        fprintf (fp->fp, "  8\n%s\n", dxf_arc_get_layer (arc));
+        dxf_write_string (fp, 8, dxf_arc_get_layer (arc));
         if (strcmp (dxf_arc_get_linetype (arc), DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp->fp, "  6\n%s\n", dxf_arc_get_linetype (arc));
+                dxf_write_string (fp, 6, dxf_arc_get_linetype (arc));
         }
         if ((fp->acad_version_number <= AutoCAD_11)
           && DXF_FLATLAND
           && (dxf_arc_get_elevation (arc) != 0.0))
         {
-                fprintf (fp->fp, " 38\n%f\n", dxf_arc_get_elevation (arc));
+                dxf_write_double (fp, 38, dxf_arc_get_elevation (arc));
         }
         if (dxf_arc_get_color (arc) != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp->fp, " 62\n%d\n", dxf_arc_get_color (arc));
+                dxf_write_int (fp, 62, dxf_arc_get_color (arc));
         }
         if (dxf_arc_get_linetype_scale (arc) != 1.0)
         {
-                fprintf (fp->fp, " 48\n%f\n", dxf_arc_get_linetype_scale (arc));
+                dxf_write_double (fp, 48, dxf_arc_get_linetype_scale (arc));
         }
         if (dxf_arc_get_visibility (arc) != 0)
         {
-                fprintf (fp->fp, " 60\n%d\n", dxf_arc_get_visibility (arc));
+                dxf_write_int (fp, 60, dxf_arc_get_visibility (arc));
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbCircle\n");
+                dxf_write_string (fp, 100, "AcDbCircle");
         }
         if (dxf_arc_get_thickness (arc) != 0.0)
         {
-                fprintf (fp->fp, " 39\n%f\n", dxf_arc_get_thickness (arc));
+                dxf_write_double (fp, 39, dxf_arc_get_thickness (arc));
         }
-        fprintf (fp->fp, " 10\n%f\n", dxf_arc_get_x0 (arc));
-        fprintf (fp->fp, " 20\n%f\n", dxf_arc_get_y0 (arc));
-        fprintf (fp->fp, " 30\n%f\n", dxf_arc_get_z0 (arc));
-        fprintf (fp->fp, " 40\n%f\n", dxf_arc_get_radius (arc));
+        dxf_write_double (fp, 10, dxf_arc_get_x0 (arc));
+        dxf_write_double (fp, 20, dxf_arc_get_y0 (arc));
+        dxf_write_double (fp, 30, dxf_arc_get_z0 (arc));
+        dxf_write_double (fp, 40, dxf_arc_get_radius (arc));
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbArc\n");
+                dxf_write_string (fp, 100, "AcDbArc");
         }
-        fprintf (fp->fp, " 50\n%f\n", dxf_arc_get_start_angle (arc));
-        fprintf (fp->fp, " 51\n%f\n", dxf_arc_get_end_angle (arc));
+        dxf_write_double (fp, 50, dxf_arc_get_start_angle (arc));
+        dxf_write_double (fp, 51, dxf_arc_get_end_angle (arc));
         if ((fp->acad_version_number >= AutoCAD_12)
                 && (dxf_arc_get_extr_x0 (arc) != 0.0)
                 && (dxf_arc_get_extr_y0 (arc) != 0.0)
                 && (dxf_arc_get_extr_z0 (arc) != 1.0))
         {
-                fprintf (fp->fp, "210\n%f\n", dxf_arc_get_extr_x0 (arc));
-                fprintf (fp->fp, "220\n%f\n", dxf_arc_get_extr_y0 (arc));
-                fprintf (fp->fp, "230\n%f\n", dxf_arc_get_extr_z0 (arc));
+                dxf_write_double (fp, 210, dxf_arc_get_extr_x0 (arc));
+                dxf_write_double (fp, 220, dxf_arc_get_extr_y0 (arc));
+                dxf_write_double (fp, 230, dxf_arc_get_extr_z0 (arc));
         }
         /* Clean up. */
-        free (dxf_entity_name);
+        dxf_free (dxf_entity_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -638,15 +593,12 @@ dxf_arc_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (arc->linetype);
-        free (arc->layer);
-        free (arc->dictionary_owner_soft);
-        free (arc->material);
-        free (arc->dictionary_owner_hard);
-        free (arc->plot_style_name);
-        free (arc->color_name);
+        dxf_graphic_properties_free (arc->properties);
+        dxf_free (arc->dictionary_owner_soft);
+        dxf_free (arc->dictionary_owner_hard);
+        dxf_binary_graphics_data_free_chain (arc->binary_graphics_data);
         dxf_point_free (arc->p0);
-        free (arc);
+        dxf_free (arc);
         arc = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -666,7 +618,7 @@ dxf_arc_free_chain
                 /*!< a pointer to the chain of DXF \c ARC entities. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (arcs == NULL)
@@ -692,7 +644,7 @@ dxf_arc_free_chain
  *
  * \return ID code.
  */
-int
+long
 dxf_arc_get_id_code
 (
         DxfArc *arc
@@ -732,7 +684,7 @@ dxf_arc_set_id_code
 (
         DxfArc *arc,
                 /*!< a pointer to a DXF \c ARC entity. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -787,7 +739,7 @@ dxf_arc_get_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        if (arc->linetype ==  NULL)
+        if (arc->properties->linetype ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found.\n")),
@@ -797,7 +749,7 @@ dxf_arc_get_linetype
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (arc->linetype));
+        return (dxf_strdup (arc->properties->linetype));
 }
 
 
@@ -831,7 +783,12 @@ dxf_arc_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        arc->linetype = strdup (linetype);
+        if (dxf_graphic_properties_unshare (&arc->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (arc->properties->linetype);
+        arc->properties->linetype = dxf_strdup (linetype);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -862,7 +819,7 @@ dxf_arc_get_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        if (arc->layer ==  NULL)
+        if (arc->properties->layer ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found.\n")),
@@ -872,7 +829,7 @@ dxf_arc_get_layer
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (arc->layer));
+        return (dxf_strdup (arc->properties->layer));
 }
 
 
@@ -906,7 +863,12 @@ dxf_arc_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        arc->layer = strdup (layer);
+        if (dxf_graphic_properties_unshare (&arc->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (arc->properties->layer);
+        arc->properties->layer = dxf_strdup (layer);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -940,7 +902,7 @@ dxf_arc_get_elevation
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (arc->elevation);
+        return (arc->properties->elevation);
 }
 
 
@@ -967,7 +929,11 @@ dxf_arc_set_elevation
                   __FUNCTION__);
                 return (NULL);
         }
-        arc->elevation = elevation;
+        if (dxf_graphic_properties_unshare (&arc->properties) == NULL)
+        {
+                return (NULL);
+        }
+        arc->properties->elevation = elevation;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -998,7 +964,7 @@ dxf_arc_get_thickness
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (arc->thickness < 0.0)
+        if (arc->properties->thickness < 0.0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found.\n")),
@@ -1008,7 +974,7 @@ dxf_arc_get_thickness
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (arc->thickness);
+        return (arc->properties->thickness);
 }
 
 
@@ -1042,7 +1008,11 @@ dxf_arc_set_thickness
                   __FUNCTION__);
                 return (NULL);
         }
-        arc->thickness = thickness;
+        if (dxf_graphic_properties_unshare (&arc->properties) == NULL)
+        {
+                return (NULL);
+        }
+        arc->properties->thickness = thickness;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1073,7 +1043,7 @@ dxf_arc_get_linetype_scale
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (arc->linetype_scale < 0.0)
+        if (arc->properties->linetype_scale < 0.0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found.\n")),
@@ -1083,7 +1053,7 @@ dxf_arc_get_linetype_scale
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (arc->linetype_scale);
+        return (arc->properties->linetype_scale);
 }
 
 
@@ -1117,7 +1087,11 @@ dxf_arc_set_linetype_scale
                   __FUNCTION__);
                 return (NULL);
         }
-        arc->linetype_scale = linetype_scale;
+        if (dxf_graphic_properties_unshare (&arc->properties) == NULL)
+        {
+                return (NULL);
+        }
+        arc->properties->linetype_scale = linetype_scale;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1148,14 +1122,14 @@ dxf_arc_get_visibility
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (arc->visibility < 0)
+        if (arc->properties->visibility < 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (arc->visibility > 1)
+        if (arc->properties->visibility > 1)
         {
                 fprintf (stderr,
                   (_("Error in %s () an out of range value was found.\n")),
@@ -1165,7 +1139,7 @@ dxf_arc_get_visibility
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (arc->visibility);
+        return (arc->properties->visibility);
 }
 
 
@@ -1206,7 +1180,11 @@ dxf_arc_set_visibility
                   __FUNCTION__);
                 return (NULL);
         }
-        arc->visibility = visibility;
+        if (dxf_graphic_properties_unshare (&arc->properties) == NULL)
+        {
+                return (NULL);
+        }
+        arc->properties->visibility = visibility;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1237,7 +1215,7 @@ dxf_arc_get_color
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (arc->color < 0)
+        if (arc->properties->color < 0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found.\n")),
@@ -1246,7 +1224,7 @@ dxf_arc_get_color
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (arc->color);
+        return (arc->properties->color);
 }
 
 
@@ -1279,7 +1257,11 @@ dxf_arc_set_color
                   (_("Warning in %s () a negative value was passed.\n")),
                   __FUNCTION__);
         }
-        arc->color = color;
+        if (dxf_graphic_properties_unshare (&arc->properties) == NULL)
+        {
+                return (NULL);
+        }
+        arc->properties->color = color;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1310,13 +1292,13 @@ dxf_arc_get_paperspace
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (arc->paperspace < 0)
+        if (arc->properties->paperspace < 0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found.\n")),
                   __FUNCTION__);
         }
-        if (arc->paperspace > 1)
+        if (arc->properties->paperspace > 1)
         {
                 fprintf (stderr,
                   (_("Warning in %s () an out of range value was found.\n")),
@@ -1325,7 +1307,7 @@ dxf_arc_get_paperspace
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (arc->paperspace);
+        return (arc->properties->paperspace);
 }
 
 
@@ -1366,7 +1348,11 @@ dxf_arc_set_paperspace
                   __FUNCTION__);
                 return (NULL);
         }
-        arc->paperspace = paperspace;
+        if (dxf_graphic_properties_unshare (&arc->properties) == NULL)
+        {
+                return (NULL);
+        }
+        arc->properties->paperspace = paperspace;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1489,14 +1475,14 @@ dxf_arc_get_shadow_mode
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (arc->shadow_mode < 0)
+        if (arc->properties->shadow_mode < 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (arc->shadow_mode > 3)
+        if (arc->properties->shadow_mode > 3)
         {
                 fprintf (stderr,
                   (_("Error in %s () an out of range value was found.\n")),
@@ -1506,7 +1492,7 @@ dxf_arc_get_shadow_mode
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (arc->shadow_mode);
+        return (arc->properties->shadow_mode);
 }
 
 
@@ -1550,7 +1536,11 @@ dxf_arc_set_shadow_mode
                   __FUNCTION__);
                 return (NULL);
         }
-        arc->shadow_mode = shadow_mode;
+        if (dxf_graphic_properties_unshare (&arc->properties) == NULL)
+        {
+                return (NULL);
+        }
+        arc->properties->shadow_mode = shadow_mode;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1674,7 +1664,7 @@ dxf_arc_get_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (arc->dictionary_owner_soft));
+        return (dxf_strdup (arc->dictionary_owner_soft));
 }
 
 
@@ -1710,7 +1700,7 @@ dxf_arc_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        arc->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        arc->dictionary_owner_soft = dxf_strdup (dictionary_owner_soft);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1744,7 +1734,7 @@ dxf_arc_get_material
                   __FUNCTION__);
                 return (NULL);
         }
-        if (arc->material ==  NULL)
+        if (arc->properties->material ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found.\n")),
@@ -1754,7 +1744,7 @@ dxf_arc_get_material
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (arc->material));
+        return (dxf_strdup (arc->properties->material));
 }
 
 
@@ -1792,7 +1782,12 @@ dxf_arc_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        arc->material = strdup (material);
+        if (dxf_graphic_properties_unshare (&arc->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (arc->properties->material);
+        arc->properties->material = dxf_strdup (material);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1836,7 +1831,7 @@ dxf_arc_get_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (arc->dictionary_owner_hard));
+        return (dxf_strdup (arc->dictionary_owner_hard));
 }
 
 
@@ -1872,7 +1867,7 @@ dxf_arc_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        arc->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        arc->dictionary_owner_hard = dxf_strdup (dictionary_owner_hard);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1907,7 +1902,7 @@ dxf_arc_get_lineweight
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (arc->lineweight);
+        return (arc->properties->lineweight);
 }
 
 
@@ -1937,7 +1932,11 @@ dxf_arc_set_lineweight
                   __FUNCTION__);
                 return (NULL);
         }
-        arc->lineweight = lineweight;
+        if (dxf_graphic_properties_unshare (&arc->properties) == NULL)
+        {
+                return (NULL);
+        }
+        arc->properties->lineweight = lineweight;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1969,7 +1968,7 @@ dxf_arc_get_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        if (arc->plot_style_name ==  NULL)
+        if (arc->properties->plot_style_name ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found.\n")),
@@ -1979,7 +1978,7 @@ dxf_arc_get_plot_style_name
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (arc->plot_style_name));
+        return (dxf_strdup (arc->properties->plot_style_name));
 }
 
 
@@ -2017,7 +2016,12 @@ dxf_arc_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        arc->plot_style_name = strdup (plot_style_name);
+        if (dxf_graphic_properties_unshare (&arc->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (arc->properties->plot_style_name);
+        arc->properties->plot_style_name = dxf_strdup (plot_style_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2052,7 +2056,7 @@ dxf_arc_get_color_value
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (arc->color_value);
+        return (arc->properties->color_value);
 }
 
 
@@ -2082,7 +2086,11 @@ dxf_arc_set_color_value
                   __FUNCTION__);
                 return (NULL);
         }
-        arc->color_value = color_value;
+        if (dxf_graphic_properties_unshare (&arc->properties) == NULL)
+        {
+                return (NULL);
+        }
+        arc->properties->color_value = color_value;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2114,7 +2122,7 @@ dxf_arc_get_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        if (arc->color_name ==  NULL)
+        if (arc->properties->color_name ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found.\n")),
@@ -2124,7 +2132,7 @@ dxf_arc_get_color_name
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (arc->color_name));
+        return (dxf_strdup (arc->properties->color_name));
 }
 
 
@@ -2162,7 +2170,12 @@ dxf_arc_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        arc->color_name = strdup (color_name);
+        if (dxf_graphic_properties_unshare (&arc->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (arc->properties->color_name);
+        arc->properties->color_name = dxf_strdup (color_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2197,7 +2210,7 @@ dxf_arc_get_transparency
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (arc->transparency);
+        return (arc->properties->transparency);
 }
 
 
@@ -2227,7 +2240,11 @@ dxf_arc_set_transparency
                   __FUNCTION__);
                 return (NULL);
         }
-        arc->transparency = transparency;
+        if (dxf_graphic_properties_unshare (&arc->properties) == NULL)
+        {
+                return (NULL);
+        }
+        arc->properties->transparency = transparency;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2247,7 +2264,7 @@ dxf_arc_get_p0
                 /*!< a pointer to a DXF \c ARC entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2286,7 +2303,7 @@ dxf_arc_set_p0
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2325,7 +2342,7 @@ dxf_arc_get_x0
                 /*!< a pointer to a DXF \c ARC entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2368,7 +2385,7 @@ dxf_arc_set_x0
                  * \c ARC entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2407,7 +2424,7 @@ dxf_arc_get_y0
                 /*!< a pointer to a DXF \c ARC entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2450,7 +2467,7 @@ dxf_arc_set_y0
                  * \c ARC entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2489,7 +2506,7 @@ dxf_arc_get_z0
                 /*!< a pointer to a DXF \c ARC entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2532,7 +2549,7 @@ dxf_arc_set_z0
                  * \c ARC entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2781,7 +2798,7 @@ dxf_arc_get_length
                 /*!< a pointer to a DXF \c ARC entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2829,7 +2846,7 @@ dxf_arc_get_extrusion_vector_as_point
                 /*!< a pointer to a DXF \c ARC entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         DxfPoint *point = NULL;
@@ -2873,7 +2890,7 @@ dxf_arc_get_extr_x0
                 /*!< a pointer to a DXF \c ARC entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2909,7 +2926,7 @@ dxf_arc_set_extr_x0
                  * DXF \c ARC entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2941,7 +2958,7 @@ dxf_arc_get_extr_y0
                 /*!< a pointer to a DXF \c ARC entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2977,7 +2994,7 @@ dxf_arc_set_extr_y0
                  * DXF \c ARC entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3009,7 +3026,7 @@ dxf_arc_get_extr_z0
                 /*!< a pointer to a DXF \c ARC entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3045,7 +3062,7 @@ dxf_arc_set_extr_z0
                  * DXF \c ARC entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
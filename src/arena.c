@@ -0,0 +1,784 @@
+/*!
+ * \file arena.c
+ *
+ * \author Copyright (C) 2017 by the libDXF developers.
+ *
+ * \brief Region allocator for the contents of a drawing.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+
+
+#include "arena.h"
+
+#if !defined (MSDOS) && !defined (_WIN32)
+#include <pthread.h>
+#include <sys/mman.h>
+#endif
+
+
+#define DXF_ARENA_ROUND(size) \
+        (((size) + DXF_ARENA_ALIGNMENT - 1) & ~((size_t) DXF_ARENA_ALIGNMENT - 1))
+        /*!< \brief \c size rounded up to a multiple of
+         * DXF_ARENA_ALIGNMENT. */
+#define DXF_ARENA_BLOCK_HEADER DXF_ARENA_ROUND (sizeof (DxfArenaBlock))
+        /*!< \brief Bytes in front of the memory of a block. */
+
+
+#if !defined (MSDOS) && !defined (_WIN32)
+static pthread_key_t dxf_arena_key;
+        /*!< \brief The current arena of each thread. */
+static pthread_once_t dxf_arena_key_once = PTHREAD_ONCE_INIT;
+        /*!< \brief Creates \c dxf_arena_key once. */
+
+
+/*!
+ * \brief Create the key of the current arena of a thread.
+ */
+static void
+dxf_arena_create_key ()
+{
+        pthread_key_create (&dxf_arena_key, NULL);
+}
+
+
+#ifndef MAP_NORESERVE
+#define MAP_NORESERVE 0
+        /*!< \brief Not every platform knows about reserving swap. */
+#endif
+
+
+static char *dxf_arena_region = NULL;
+        /*!< \brief First byte of the address space holding the blocks of
+         * all arenas, \c NULL when it could not be reserved. */
+static size_t dxf_arena_region_granules = 0;
+        /*!< \brief Number of granules in \c dxf_arena_region. */
+static unsigned char *dxf_arena_region_map = NULL;
+        /*!< \brief For each granule of \c dxf_arena_region \c TRUE while
+         * it is part of a block, \c FALSE otherwise. */
+static size_t dxf_arena_region_hint = 0;
+        /*!< \brief Granule to start looking for free granules at. */
+static pthread_once_t dxf_arena_region_once = PTHREAD_ONCE_INIT;
+        /*!< \brief Reserves \c dxf_arena_region once. */
+static pthread_mutex_t dxf_arena_region_lock = PTHREAD_MUTEX_INITIALIZER;
+        /*!< \brief Guards \c dxf_arena_region_map and
+         * \c dxf_arena_region_hint while blocks are taken and given
+         * back. */
+
+
+/*!
+ * \brief Reserve the address space of the blocks of all arenas.
+ *
+ * The address space is not accessible and takes no memory until a
+ * block is taken from it.
+ */
+static void
+dxf_arena_reserve ()
+{
+        size_t size;
+        void *region;
+
+        for (size = DXF_ARENA_REGION_SIZE; size >= 16 * DXF_ARENA_BLOCK_SIZE; size /= 2)
+        {
+                region = mmap (NULL, size, PROT_NONE,
+                  MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+                if (region == MAP_FAILED)
+                {
+                        continue;
+                }
+                dxf_arena_region_map = calloc (size / DXF_ARENA_GRANULE, 1);
+                if (dxf_arena_region_map == NULL)
+                {
+                        munmap (region, size);
+                        return;
+                }
+                dxf_arena_region = region;
+                dxf_arena_region_granules = size / DXF_ARENA_GRANULE;
+                return;
+        }
+}
+
+
+/*!
+ * \brief Find \c granules free granules in a row in
+ * \c dxf_arena_region, from granule \c first on.
+ *
+ * The caller holds \c dxf_arena_region_lock.
+ *
+ * \return the first of the granules, or \c dxf_arena_region_granules
+ * when there are not as many free in a row.
+ */
+static size_t
+dxf_arena_find_granules
+(
+        size_t first,
+                /*!< the granule to start at. */
+        size_t granules
+                /*!< number of granules. */
+)
+{
+        size_t run = 0;
+        size_t i;
+
+        for (i = first; i < dxf_arena_region_granules; i++)
+        {
+                run = (dxf_arena_region_map[i]) ? 0 : run + 1;
+                if (run == granules)
+                {
+                        return (i + 1 - granules);
+                }
+        }
+        return (dxf_arena_region_granules);
+}
+
+
+/*!
+ * \brief Take a block of at least \c size bytes, including its header,
+ * from the region of the arenas.
+ *
+ * \return the block with its size set, or \c NULL when no memory could
+ * be allocated.
+ */
+static DxfArenaBlock *
+dxf_arena_block_new
+(
+        size_t size
+                /*!< number of bytes. */
+)
+{
+        DxfArenaBlock *block;
+        size_t granules;
+        size_t first;
+
+        pthread_once (&dxf_arena_region_once, dxf_arena_reserve);
+        if ((dxf_arena_region == NULL)
+          || (size > dxf_arena_region_granules * DXF_ARENA_GRANULE))
+        {
+                return (NULL);
+        }
+        granules = (size + DXF_ARENA_GRANULE - 1) / DXF_ARENA_GRANULE;
+        pthread_mutex_lock (&dxf_arena_region_lock);
+        first = dxf_arena_find_granules (dxf_arena_region_hint, granules);
+        if (first == dxf_arena_region_granules)
+        {
+                first = dxf_arena_find_granules (0, granules);
+        }
+        if (first < dxf_arena_region_granules)
+        {
+                memset (&dxf_arena_region_map[first], TRUE, granules);
+                dxf_arena_region_hint = first + granules;
+        }
+        pthread_mutex_unlock (&dxf_arena_region_lock);
+        if (first == dxf_arena_region_granules)
+        {
+                return (NULL);
+        }
+        block = (DxfArenaBlock *) (dxf_arena_region + first * DXF_ARENA_GRANULE);
+        if (mprotect (block, granules * DXF_ARENA_GRANULE,
+          PROT_READ | PROT_WRITE) != 0)
+        {
+                pthread_mutex_lock (&dxf_arena_region_lock);
+                memset (&dxf_arena_region_map[first], FALSE, granules);
+                pthread_mutex_unlock (&dxf_arena_region_lock);
+                return (NULL);
+        }
+        block->size = granules * DXF_ARENA_GRANULE - DXF_ARENA_BLOCK_HEADER;
+        return (block);
+}
+
+
+/*!
+ * \brief Give \c block back to the region of the arenas.
+ *
+ * Its memory is returned to the system, the address space stays
+ * reserved.
+ */
+static void
+dxf_arena_block_free
+(
+        DxfArenaBlock *block
+                /*!< the block. */
+)
+{
+        size_t granules;
+        size_t first;
+
+        granules = (DXF_ARENA_BLOCK_HEADER + block->size) / DXF_ARENA_GRANULE;
+        first = (size_t) ((char *) block - dxf_arena_region) / DXF_ARENA_GRANULE;
+        mmap (block, granules * DXF_ARENA_GRANULE, PROT_NONE,
+          MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_FIXED, -1, 0);
+        pthread_mutex_lock (&dxf_arena_region_lock);
+        memset (&dxf_arena_region_map[first], FALSE, granules);
+        if (first < dxf_arena_region_hint)
+        {
+                dxf_arena_region_hint = first;
+        }
+        pthread_mutex_unlock (&dxf_arena_region_lock);
+}
+#else
+static DxfArena *dxf_arena_current = NULL;
+        /*!< \brief The current arena. */
+
+
+/*!
+ * \brief The memory of a block of an arena.
+ */
+typedef struct
+dxf_arena_range_struct
+{
+        const char *start;
+                /*!< First byte of the block. */
+        const char *end;
+                /*!< First byte after the block. */
+} DxfArenaRange;
+
+
+static DxfArenaRange *dxf_arena_ranges = NULL;
+        /*!< \brief The blocks of all arenas, sorted by address. */
+static int dxf_arena_range_count = 0;
+        /*!< \brief Number of blocks in \c dxf_arena_ranges. */
+static int dxf_arena_range_size = 0;
+        /*!< \brief Allocated number of elements in
+         * \c dxf_arena_ranges. */
+
+
+/*!
+ * \brief Find the first block in \c dxf_arena_ranges which ends after
+ * \c memory.
+ *
+ * \return the position of the block, or \c dxf_arena_range_count when
+ * there is none.
+ */
+static int
+dxf_arena_find_range
+(
+        const char *memory
+                /*!< the address. */
+)
+{
+        int low = 0;
+        int high = dxf_arena_range_count;
+        int middle;
+
+        while (low < high)
+        {
+                middle = low + (high - low) / 2;
+                if (dxf_arena_ranges[middle].end <= memory)
+                {
+                        low = middle + 1;
+                }
+                else
+                {
+                        high = middle;
+                }
+        }
+        return (low);
+}
+
+
+/*!
+ * \brief Allocate a block of \c size bytes, including its header, and
+ * record it as memory of an arena.
+ *
+ * Without \c mmap () there is no region to take the blocks from, the
+ * blocks are kept sorted by address instead.
+ *
+ * \return the block with its size set, or \c NULL when no memory could
+ * be allocated.
+ */
+static DxfArenaBlock *
+dxf_arena_block_new
+(
+        size_t size
+                /*!< number of bytes. */
+)
+{
+        DxfArenaBlock *block;
+        DxfArenaRange *ranges;
+        int count;
+        int i;
+
+        if (dxf_arena_range_count == dxf_arena_range_size)
+        {
+                count = (dxf_arena_range_size == 0) ? 64 : 2 * dxf_arena_range_size;
+                ranges = realloc (dxf_arena_ranges, (size_t) count * sizeof (DxfArenaRange));
+                if (ranges == NULL)
+                {
+                        return (NULL);
+                }
+                dxf_arena_ranges = ranges;
+                dxf_arena_range_size = count;
+        }
+        block = malloc (size);
+        if (block == NULL)
+        {
+                return (NULL);
+        }
+        block->size = size - DXF_ARENA_BLOCK_HEADER;
+        i = dxf_arena_find_range ((const char *) block);
+        memmove (&dxf_arena_ranges[i + 1], &dxf_arena_ranges[i],
+          (size_t) (dxf_arena_range_count - i) * sizeof (DxfArenaRange));
+        dxf_arena_ranges[i].start = (const char *) block;
+        dxf_arena_ranges[i].end = (const char *) block + size;
+        dxf_arena_range_count++;
+        return (block);
+}
+
+
+/*!
+ * \brief Forget \c block as memory of an arena and free it.
+ */
+static void
+dxf_arena_block_free
+(
+        DxfArenaBlock *block
+                /*!< the block. */
+)
+{
+        int i;
+
+        i = dxf_arena_find_range ((const char *) block);
+        if ((i < dxf_arena_range_count)
+          && (dxf_arena_ranges[i].start == (const char *) block))
+        {
+                memmove (&dxf_arena_ranges[i], &dxf_arena_ranges[i + 1],
+                  (size_t) (dxf_arena_range_count - i - 1) * sizeof (DxfArenaRange));
+                dxf_arena_range_count--;
+        }
+        if (dxf_arena_range_count == 0)
+        {
+                free (dxf_arena_ranges);
+                dxf_arena_ranges = NULL;
+                dxf_arena_range_size = 0;
+        }
+        free (block);
+}
+#endif
+
+
+/*!
+ * \brief Allocate an empty \c DxfArena.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when succesful.
+ */
+DxfArena *
+dxf_arena_new ()
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfArena *arena = NULL;
+
+        if ((arena = malloc (sizeof (DxfArena))) == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory for a DxfArena struct.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        arena->blocks = NULL;
+        arena->block_size = DXF_ARENA_BLOCK_SIZE;
+        arena->next = NULL;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (arena);
+}
+
+
+/*!
+ * \brief Hand out \c size bytes from \c arena.
+ *
+ * The memory is not cleared.
+ *
+ * \return a pointer to the memory, or \c NULL when no memory could be
+ * allocated.
+ */
+void *
+dxf_arena_alloc
+(
+        DxfArena *arena,
+                /*!< the arena. */
+        size_t size
+                /*!< number of bytes. */
+)
+{
+        DxfArenaBlock *block;
+        size_t need;
+        size_t block_size;
+        char *piece;
+
+        /* Do some basic checks. */
+        if (arena == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        need = DXF_ARENA_ROUND (size);
+        block = arena->blocks;
+        if ((block == NULL) || (block->size - block->used < need))
+        {
+                block_size = arena->block_size;
+                if (block_size < DXF_ARENA_BLOCK_HEADER + need)
+                {
+                        block_size = DXF_ARENA_BLOCK_HEADER + need;
+                }
+                block = dxf_arena_block_new (block_size);
+                if (block == NULL)
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () could not allocate memory.\n")),
+                          __FUNCTION__);
+                        return (NULL);
+                }
+                block->used = 0;
+                block->next = arena->blocks;
+                arena->blocks = block;
+        }
+        piece = (char *) block + DXF_ARENA_BLOCK_HEADER + block->used;
+        block->used += need;
+        return (piece);
+}
+
+
+/*!
+ * \brief Make \c arena the current arena of the calling thread.
+ *
+ * While a thread has a current arena, dxf_malloc (), dxf_calloc () and
+ * dxf_strdup () take memory from it.  Pass \c NULL to return to
+ * \c malloc ().
+ *
+ * \return the previous current arena of the thread.
+ */
+DxfArena *
+dxf_arena_set_current
+(
+        DxfArena *arena
+                /*!< the arena, or \c NULL. */
+)
+{
+        DxfArena *previous;
+
+        previous = dxf_arena_get_current ();
+#if !defined (MSDOS) && !defined (_WIN32)
+        pthread_setspecific (dxf_arena_key, arena);
+#else
+        dxf_arena_current = arena;
+#endif
+        return (previous);
+}
+
+
+/*!
+ * \brief Get the current arena of the calling thread.
+ *
+ * \return the current arena, or \c NULL when there is none.
+ */
+DxfArena *
+dxf_arena_get_current ()
+{
+#if !defined (MSDOS) && !defined (_WIN32)
+        pthread_once (&dxf_arena_key_once, dxf_arena_create_key);
+        return ((DxfArena *) pthread_getspecific (dxf_arena_key));
+#else
+        return (dxf_arena_current);
+#endif
+}
+
+
+/*!
+ * \brief Release all memory of \c arena and of the arenas chained to
+ * it.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_arena_free
+(
+        DxfArena *arena
+                /*!< the arena. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfArena *next;
+        DxfArenaBlock *block;
+
+        /* Do some basic checks. */
+        if (arena == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        while (arena != NULL)
+        {
+                while (arena->blocks != NULL)
+                {
+                        block = arena->blocks;
+                        arena->blocks = block->next;
+                        dxf_arena_block_free (block);
+                }
+                next = arena->next;
+                free (arena);
+                arena = next;
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Allocate \c size bytes from the current arena, or with
+ * \c malloc () when there is none.
+ *
+ * \return a pointer to the memory, or \c NULL when no memory could be
+ * allocated.
+ */
+void *
+dxf_malloc
+(
+        size_t size
+                /*!< number of bytes. */
+)
+{
+        DxfArena *arena;
+
+        arena = dxf_arena_get_current ();
+        if (arena == NULL)
+        {
+                return (malloc (size));
+        }
+        return (dxf_arena_alloc (arena, size));
+}
+
+
+/*!
+ * \brief Allocate \c count times \c size cleared bytes like
+ * dxf_malloc ().
+ *
+ * \return a pointer to the memory, or \c NULL when no memory could be
+ * allocated.
+ */
+void *
+dxf_calloc
+(
+        size_t count,
+                /*!< number of elements. */
+        size_t size
+                /*!< number of bytes of an element. */
+)
+{
+        DxfArena *arena;
+        void *memory;
+
+        arena = dxf_arena_get_current ();
+        if (arena == NULL)
+        {
+                return (calloc (count, size));
+        }
+        if ((size != 0) && (count > (size_t) -1 / size))
+        {
+                return (NULL);
+        }
+        memory = dxf_arena_alloc (arena, count * size);
+        if (memory != NULL)
+        {
+                memset (memory, 0, count * size);
+        }
+        return (memory);
+}
+
+
+/*!
+ * \brief Copy \c string like \c strdup (), into the current arena when
+ * there is one.
+ *
+ * \return the copy, or \c NULL when no memory could be allocated.
+ */
+char *
+dxf_strdup
+(
+        const char *string
+                /*!< the string. */
+)
+{
+        char *copy;
+        size_t size;
+
+        size = strlen (string) + 1;
+        copy = dxf_malloc (size);
+        if (copy != NULL)
+        {
+                memcpy (copy, string, size);
+        }
+        return (copy);
+}
+
+
+/*!
+ * \brief Tell whether \c memory was handed out by an arena which has not
+ * been freed yet.
+ *
+ * All arenas take their blocks from one reserved region of address
+ * space, so this is a bounds check and a look at the granule of
+ * \c memory, without taking a lock.
+ *
+ * \return \c TRUE when \c memory belongs to an arena, \c FALSE
+ * otherwise.
+ */
+int
+dxf_arena_owns
+(
+        const void *memory
+                /*!< the memory, or \c NULL. */
+)
+{
+#if !defined (MSDOS) && !defined (_WIN32)
+        size_t offset;
+
+        pthread_once (&dxf_arena_region_once, dxf_arena_reserve);
+        if (((const char *) memory < dxf_arena_region)
+          || (memory == NULL))
+        {
+                return (FALSE);
+        }
+        offset = (size_t) ((const char *) memory - dxf_arena_region);
+        if (offset >= dxf_arena_region_granules * DXF_ARENA_GRANULE)
+        {
+                return (FALSE);
+        }
+        return (dxf_arena_region_map[offset / DXF_ARENA_GRANULE]);
+#else
+        int i;
+
+        if (memory == NULL)
+        {
+                return (FALSE);
+        }
+        i = dxf_arena_find_range (memory);
+        return ((i < dxf_arena_range_count)
+          && (dxf_arena_ranges[i].start <= (const char *) memory));
+#endif
+}
+
+
+/*!
+ * \brief Free memory from dxf_malloc () like \c free ().
+ *
+ * Memory of an arena is left alone, whether or not an arena is
+ * current, it is released with its arena.
+ */
+void
+dxf_free
+(
+        void *memory
+                /*!< the memory, or \c NULL. */
+)
+{
+        if (!dxf_arena_owns (memory))
+        {
+                free (memory);
+        }
+}
+
+
+/*!
+ * \brief Make room for \c needed elements of \c size bytes in
+ * \c array, which holds \c count elements and has room for
+ * \c capacity.
+ *
+ * The first reservation of a known number of elements allocates exactly
+ * that many, later ones at least double the room.  The memory comes from
+ * dxf_malloc (), the elements in use are copied and the old memory is
+ * given to dxf_free ().
+ *
+ * \return the array with room for \c needed elements, or \c NULL when
+ * no memory could be allocated, in which case \c array is left alone.
+ */
+void *
+dxf_array_reserve
+(
+        void *array,
+                /*!< the array, or \c NULL when it is empty. */
+        int count,
+                /*!< number of elements in use. */
+        int *capacity,
+                /*!< number of elements there is room for, updated. */
+        int needed,
+                /*!< number of elements to make room for. */
+        size_t size
+                /*!< number of bytes of an element. */
+)
+{
+        void *grown;
+        int room;
+
+        if (needed <= *capacity)
+        {
+                return (array);
+        }
+        room = *capacity * 2;
+        if (room < needed)
+        {
+                room = needed;
+        }
+        if ((size != 0) && ((size_t) room > (size_t) -1 / size))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        grown = dxf_malloc ((size_t) room * size);
+        if (grown == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        if (count > 0)
+        {
+                memcpy (grown, array, (size_t) count * size);
+        }
+        dxf_free (array);
+        *capacity = room;
+        return (grown);
+}
+
+
+/* EOF */
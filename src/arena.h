@@ -0,0 +1,166 @@
+/*!
+ * \file arena.h
+ *
+ * \author Copyright (C) 2017 by the libDXF developers.
+ *
+ * \brief Region allocator for the contents of a drawing, header file.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+
+
+#ifndef LIBDXF_SRC_ARENA_H
+#define LIBDXF_SRC_ARENA_H
+
+
+#include "global.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define DXF_ARENA_BLOCK_SIZE (1024 * 1024)
+        /*!< \brief Number of bytes a DxfArena allocates at once. */
+#define DXF_ARENA_ALIGNMENT 8
+        /*!< \brief Alignment of the memory handed out by a DxfArena,
+         * enough for the doubles and pointers of an entity. */
+#define DXF_ARENA_GRANULE (64 * 1024)
+        /*!< \brief Blocks are taken from the region of the arenas in
+         * multiples of this many bytes. */
+#define DXF_ARENA_REGION_SIZE ((size_t) 1 << ((sizeof (void *) > 4) ? 36 : 29))
+        /*!< \brief Number of bytes of address space reserved for the
+         * blocks of all arenas, 64 GiB on 64 bit platforms and 512 MiB
+         * on others.  Halved until the reservation succeeds. */
+
+
+/*!
+ * \brief A block of memory of a DxfArena.
+ */
+typedef struct
+dxf_arena_block_struct
+{
+        size_t size;
+                /*!< Number of bytes in the block, after this header. */
+        size_t used;
+                /*!< Number of bytes handed out. */
+        struct dxf_arena_block_struct *next;
+                /*!< The block filled before this one. */
+} DxfArenaBlock;
+
+
+/*!
+ * \brief A region of memory, handed out in pieces and released at once.
+ *
+ * Pieces are not freed one by one, dxf_free () leaves them alone.
+ * dxf_arena_free () releases them all, together with the arenas chained
+ * to \c next.\n
+ * An arena is not locked.  Give each thread its own arena and chain
+ * them afterwards.
+ */
+typedef struct
+dxf_arena_struct
+{
+        DxfArenaBlock *blocks;
+                /*!< Blocks, the block being filled first. */
+        size_t block_size;
+                /*!< Number of bytes allocated at once, including the
+                 * header of the block, DXF_ARENA_BLOCK_SIZE unless
+                 * changed before the first allocation. */
+        struct dxf_arena_struct *next;
+                /*!< Next arena released together with this one. */
+} DxfArena;
+
+
+DxfArena *
+dxf_arena_new ();
+void *
+dxf_arena_alloc
+(
+        DxfArena *arena,
+        size_t size
+);
+DxfArena *
+dxf_arena_set_current
+(
+        DxfArena *arena
+);
+DxfArena *
+dxf_arena_get_current ();
+int
+dxf_arena_free
+(
+        DxfArena *arena
+);
+int
+dxf_arena_owns
+(
+        const void *memory
+);
+void *
+dxf_malloc
+(
+        size_t size
+);
+void *
+dxf_calloc
+(
+        size_t count,
+        size_t size
+);
+char *
+dxf_strdup
+(
+        const char *string
+);
+void
+dxf_free
+(
+        void *memory
+);
+void *
+dxf_array_reserve
+(
+        void *array,
+        int count,
+        int *capacity,
+        int needed,
+        size_t size
+);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* LIBDXF_SRC_ARENA_H */
+
+
+/* EOF */
@@ -39,6 +39,9 @@
 
 
 #include "attdef.h"
+#include "arena.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -58,7 +61,7 @@ dxf_attdef_new ()
         size = sizeof (DxfAttdef);
         /* avoid malloc of 0 bytes */
         if (size == 0) size = 1;
-        if ((attdef = malloc (size)) == NULL)
+        if ((attdef = dxf_malloc (size)) == NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () could not allocate memory.\n")),
@@ -108,30 +111,16 @@ dxf_attdef_init
               return (NULL);
         }
         dxf_attdef_set_id_code (attdef, 0);
-        dxf_attdef_set_linetype (attdef, strdup (DXF_DEFAULT_LINETYPE));
-        dxf_attdef_set_layer (attdef, strdup (DXF_DEFAULT_LAYER));
-        dxf_attdef_set_elevation (attdef, 0.0);
-        dxf_attdef_set_thickness (attdef, 0.0);
-        dxf_attdef_set_linetype_scale (attdef, DXF_DEFAULT_LINETYPE_SCALE);
-        dxf_attdef_set_visibility (attdef, DXF_DEFAULT_VISIBILITY);
-        dxf_attdef_set_color (attdef, DXF_COLOR_BYLAYER);
-        dxf_attdef_set_paperspace (attdef, DXF_MODELSPACE);
+        attdef->properties = dxf_graphic_properties_default ();
         dxf_attdef_set_graphics_data_size (attdef, 0);
-        dxf_attdef_set_shadow_mode (attdef, 0);
         dxf_attdef_set_binary_graphics_data (attdef, (DxfBinaryGraphicsData *) dxf_binary_graphics_data_new ());
         dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) dxf_attdef_get_binary_graphics_data (attdef));
-        dxf_attdef_set_dictionary_owner_soft (attdef, strdup (""));
-        dxf_attdef_set_material (attdef, strdup (""));
-        dxf_attdef_set_dictionary_owner_hard (attdef, strdup (""));
-        dxf_attdef_set_lineweight (attdef, 0);
-        dxf_attdef_set_plot_style_name (attdef, strdup (""));
-        dxf_attdef_set_color_value (attdef, 0);
-        dxf_attdef_set_color_name (attdef, strdup (""));
-        dxf_attdef_set_transparency (attdef, 0);
-        dxf_attdef_set_default_value (attdef, strdup (""));
-        dxf_attdef_set_tag_value (attdef, strdup (""));
-        dxf_attdef_set_prompt_value (attdef, strdup (""));
-        dxf_attdef_set_text_style (attdef, strdup (DXF_DEFAULT_TEXTSTYLE));
+        dxf_attdef_set_dictionary_owner_soft (attdef, "");
+        dxf_attdef_set_dictionary_owner_hard (attdef, "");
+        dxf_attdef_set_default_value (attdef, "");
+        dxf_attdef_set_tag_value (attdef, "");
+        dxf_attdef_set_prompt_value (attdef, "");
+        dxf_attdef_set_text_style (attdef, DXF_DEFAULT_TEXTSTYLE);
         dxf_attdef_set_p0 (attdef, dxf_point_new ());
         dxf_point_init ((DxfPoint *) dxf_attdef_get_p0 (attdef));
         dxf_attdef_set_x0 (attdef, 0.0);
@@ -185,7 +174,9 @@ dxf_attdef_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfGraphicProperties properties;
+        DxfPair pair;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -193,8 +184,6 @@ dxf_attdef_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (attdef == NULL)
@@ -205,297 +194,237 @@ dxf_attdef_read
                 attdef = dxf_attdef_new ();
                 attdef = dxf_attdef_init (attdef);
         }
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        dxf_graphic_properties_start (&properties, attdef->properties);
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        fclose (fp->fp);
-                        /* Clean up. */
-                        free (temp_string);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "1") == 0)
-                {
-                        /* Now follows a string containing the attribute
-                         * default value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", attdef->default_value);
-                }
-                else if (strcmp (temp_string, "2") == 0)
-                {
-                        /* Now follows a string containing a tag value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", attdef->tag_value);
-                }
-                else if (strcmp (temp_string, "3") == 0)
-                {
-                        /* Now follows a string containing a prompt
-                         * value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", attdef->prompt_value);
-                }
-                else if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &attdef->id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", attdef->linetype);
-                }
-                else if (strcmp (temp_string, "7") == 0)
-                {
-                        /* Now follows a string containing a text style. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", attdef->text_style);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", attdef->layer);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the center point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &attdef->p0->x0);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the center point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &attdef->p0->y0);
-                }
-                else if (strcmp (temp_string, "30") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the center point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &attdef->p0->z0);
-                }
-                else if (strcmp (temp_string, "11") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the align point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &attdef->p1->x0);
-                }
-                else if (strcmp (temp_string, "21") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the align point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &attdef->p1->y0);
-                }
-                else if (strcmp (temp_string, "31") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the align point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &attdef->p1->z0);
-                }
-                else if ((fp->acad_version_number <= AutoCAD_11)
-                        && (strcmp (temp_string, "38") == 0)
-                        && (attdef->elevation = 0.0))
-                {
-                        /* Elevation is a pre AutoCAD R11 variable
-                         * so additional testing for the version should
-                         * probably be added.
-                         * Now follows a string containing the
-                         * elevation. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &attdef->elevation);
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &attdef->thickness);
-                }
-                else if (strcmp (temp_string, "40") == 0)
-                {
-                        /* Now follows a string containing the
-                         * height. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &attdef->height);
-                }
-                else if (strcmp (temp_string, "41") == 0)
-                {
-                        /* Now follows a string containing the
-                         * relative X-scale. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &attdef->rel_x_scale);
-                }
-                else if (strcmp (temp_string, "48") == 0)
-                {
-                        /* Now follows a string containing the linetype
-                         * scale. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &attdef->linetype_scale);
-                }
-                else if (strcmp (temp_string, "50") == 0)
-                {
-                        /* Now follows a string containing the
-                         * rotation angle. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &attdef->rot_angle);
-                }
-                else if (strcmp (temp_string, "51") == 0)
-                {
-                        /* Now follows a string containing the
-                         * end angle. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &attdef->obl_angle);
-                }
-                else if (strcmp (temp_string, "60") == 0)
-                {
-                        /* Now follows a string containing the
-                         * visibility value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &attdef->visibility);
-                }
-                else if (strcmp (temp_string, "62") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &attdef->color);
-                }
-                else if (strcmp (temp_string, "67") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &attdef->paperspace);
-                }
-                else if (strcmp (temp_string, "70") == 0)
-                {
-                        /* Now follows a string containing the
-                         * attribute flags value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &attdef->attr_flags);
-                }
-                else if (strcmp (temp_string, "71") == 0)
-                {
-                        /* Now follows a string containing the
-                         * text flags value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &attdef->text_flags);
-                }
-                else if (strcmp (temp_string, "72") == 0)
-                {
-                        /* Now follows a string containing the
-                         * horizontal alignment value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &attdef->hor_align);
-                }
-                else if (strcmp (temp_string, "73") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing the
-                         * field length value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &attdef->field_length);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else if (strcmp (temp_string, "74") == 0)
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing the
-                         * vertical alignment value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &attdef->vert_align);
-                }
-                else if ((fp->acad_version_number >= AutoCAD_13)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Subclass markers are post AutoCAD R12
-                         * variable so additional testing for the
-                         * version should probably be added here.
-                         * Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if ((strcmp (temp_string, "AcDbEntity") != 0)
-                        && (strcmp (temp_string, "AcDbText") != 0)
-                        && (strcmp (temp_string, "AcDbAttributeDefinition") != 0))
-                        {
+                        case 1:
+                                /* Now follows a string containing the attribute
+                                 * default value. */
+                                dxf_free (attdef->default_value);
+                                attdef->default_value = dxf_pair_get_string (&pair);
+                                break;
+                        case 2:
+                                /* Now follows a string containing a tag value. */
+                                dxf_free (attdef->tag_value);
+                                attdef->tag_value = dxf_pair_get_string (&pair);
+                                break;
+                        case 3:
+                                /* Now follows a string containing a prompt
+                                 * value. */
+                                dxf_free (attdef->prompt_value);
+                                attdef->prompt_value = dxf_pair_get_string (&pair);
+                                break;
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                attdef->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 6:
+                                /* Now follows a string containing a linetype
+                                 * name. */
+                                dxf_lexer_free_string (fp, properties.linetype);
+                                properties.linetype = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 7:
+                                /* Now follows a string containing a text style. */
+                                dxf_free (attdef->text_style);
+                                attdef->text_style = dxf_pair_get_string (&pair);
+                                break;
+                        case 8:
+                                /* Now follows a string containing a layer name. */
+                                dxf_lexer_free_string (fp, properties.layer);
+                                properties.layer = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 10:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the center point. */
+                                attdef->p0->x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 20:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the center point. */
+                                attdef->p0->y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 30:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the center point. */
+                                attdef->p0->z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 11:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the align point. */
+                                attdef->p1->x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 21:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the align point. */
+                                attdef->p1->y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 31:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the align point. */
+                                attdef->p1->z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 38:
+                                if ((fp->acad_version_number <= AutoCAD_11)
+                                  && (properties.elevation = 0.0))
+                                {
+                                        /* Elevation is a pre AutoCAD R11 variable
+                                         * so additional testing for the version should
+                                         * probably be added.
+                                         * Now follows a string containing the
+                                         * elevation. */
+                                        properties.elevation = dxf_pair_get_double (&pair);
+                                }
+                                break;
+                        case 39:
+                                /* Now follows a string containing the
+                                 * thickness. */
+                                properties.thickness = dxf_pair_get_double (&pair);
+                                break;
+                        case 40:
+                                /* Now follows a string containing the
+                                 * height. */
+                                attdef->height = dxf_pair_get_double (&pair);
+                                break;
+                        case 41:
+                                /* Now follows a string containing the
+                                 * relative X-scale. */
+                                attdef->rel_x_scale = dxf_pair_get_double (&pair);
+                                break;
+                        case 48:
+                                /* Now follows a string containing the linetype
+                                 * scale. */
+                                properties.linetype_scale = dxf_pair_get_double (&pair);
+                                break;
+                        case 50:
+                                /* Now follows a string containing the
+                                 * rotation angle. */
+                                attdef->rot_angle = dxf_pair_get_double (&pair);
+                                break;
+                        case 51:
+                                /* Now follows a string containing the
+                                 * end angle. */
+                                attdef->obl_angle = dxf_pair_get_double (&pair);
+                                break;
+                        case 60:
+                                /* Now follows a string containing the
+                                 * visibility value. */
+                                properties.visibility = dxf_pair_get_int (&pair);
+                                break;
+                        case 62:
+                                /* Now follows a string containing the
+                                 * color value. */
+                                properties.color = dxf_pair_get_int (&pair);
+                                break;
+                        case 67:
+                                /* Now follows a string containing the
+                                 * paperspace value. */
+                                properties.paperspace = dxf_pair_get_int (&pair);
+                                break;
+                        case 70:
+                                /* Now follows a string containing the
+                                 * attribute flags value. */
+                                attdef->attr_flags = dxf_pair_get_int (&pair);
+                                break;
+                        case 71:
+                                /* Now follows a string containing the
+                                 * text flags value. */
+                                attdef->text_flags = dxf_pair_get_int (&pair);
+                                break;
+                        case 72:
+                                /* Now follows a string containing the
+                                 * horizontal alignment value. */
+                                attdef->hor_align = dxf_pair_get_int (&pair);
+                                break;
+                        case 73:
+                                /* Now follows a string containing the
+                                 * field length value. */
+                                attdef->field_length = dxf_pair_get_int (&pair);
+                                break;
+                        case 74:
+                                /* Now follows a string containing the
+                                 * vertical alignment value. */
+                                attdef->vert_align = dxf_pair_get_int (&pair);
+                                break;
+                        case 100:
+                                if (fp->acad_version_number >= AutoCAD_13)
+                                {
+                                        /* Subclass markers are post AutoCAD R12
+                                         * variable so additional testing for the
+                                         * version should probably be added here.
+                                         * Now follows a string containing the
+                                         * subclass marker value. */
+                                        dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                        if ((strcmp (temp_string, "AcDbEntity") != 0)
+                                        && (strcmp (temp_string, "AcDbText") != 0)
+                                        && (strcmp (temp_string, "AcDbAttributeDefinition") != 0))
+                                        {
+                                                fprintf (stderr,
+                                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                                  __FUNCTION__, fp->filename, fp->line_number);
+                                        }
+                                }
+                                break;
+                        case 210:
+                                /* Now follows a string containing the
+                                 * X-value of the extrusion vector. */
+                                attdef->extr_x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 220:
+                                /* Now follows a string containing the
+                                 * Y-value of the extrusion vector. */
+                                attdef->extr_y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 230:
+                                /* Now follows a string containing the
+                                 * Z-value of the extrusion vector. */
+                                attdef->extr_z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, attdef->dictionary_owner_soft);
+                                attdef->dictionary_owner_soft = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, attdef->dictionary_owner_hard);
+                                attdef->dictionary_owner_hard = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, "DXF comment: %s\n", temp_string);
+                                break;
+                        default:
                                 fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
                                   __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "210") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &attdef->extr_x0);
-                }
-                else if (strcmp (temp_string, "220") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &attdef->extr_y0);
-                }
-                else if (strcmp (temp_string, "230") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &attdef->extr_z0);
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", attdef->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", attdef->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
         /* Handle omitted members and/or illegal values. */
-        if (strcmp (dxf_attdef_get_linetype (attdef), "") == 0)
+        if (strcmp (attdef->properties->linetype, "") == 0)
         {
-                dxf_attdef_set_linetype (attdef, strdup (DXF_DEFAULT_LINETYPE));
+                dxf_attdef_set_linetype (attdef, DXF_DEFAULT_LINETYPE);
         }
-        if (strcmp (dxf_attdef_get_layer (attdef), "") == 0)
+        if (strcmp (attdef->properties->layer, "") == 0)
         {
-                dxf_attdef_set_layer (attdef, strdup (DXF_DEFAULT_LAYER));
+                dxf_attdef_set_layer (attdef, DXF_DEFAULT_LAYER);
         }
-        /* Clean up. */
-        free (temp_string);
+        /* Entities with equal properties share a record. */
+        dxf_graphic_properties_finish (fp, &attdef->properties, &properties);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -518,7 +447,7 @@ dxf_attdef_write
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *dxf_entity_name = strdup ("ATTDEF");
+        char *dxf_entity_name = dxf_strdup ("ATTDEF");
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -527,7 +456,7 @@ dxf_attdef_write
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (attdef == NULL)
@@ -536,52 +465,52 @@ dxf_attdef_write
                   (_("Error in %s () a NULL pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (strcmp (dxf_attdef_get_tag_value (attdef), "") == 0)
         {
                 fprintf (stderr,
-                  (_("Error in %s () default tag value string is empty for the %s entity with id-code: %x.\n")),
+                  (_("Error in %s () default tag value string is empty for the %s entity with id-code: %lx.\n")),
                   __FUNCTION__, dxf_entity_name, dxf_attdef_get_id_code (attdef));
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (strcmp (dxf_attdef_get_text_style (attdef), "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () text style string is empty for the %s entity with id-code: %x.\n")),
+                  (_("Warning in %s () text style string is empty for the %s entity with id-code: %lx.\n")),
                   __FUNCTION__, dxf_entity_name, dxf_attdef_get_id_code (attdef));
                 fprintf (stderr,
                   (_("\tdefault text style STANDARD applied to %s entity.\n")),
                   dxf_entity_name);
-                dxf_attdef_set_text_style (attdef, strdup (DXF_DEFAULT_TEXTSTYLE));
+                dxf_attdef_set_text_style (attdef, DXF_DEFAULT_TEXTSTYLE);
         }
         if (strcmp (dxf_attdef_get_linetype (attdef), "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_attdef_get_id_code (attdef));
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                dxf_attdef_set_linetype (attdef, strdup (DXF_DEFAULT_LINETYPE));
+                dxf_attdef_set_linetype (attdef, DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (dxf_attdef_get_layer (attdef), "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty layer string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty layer string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_attdef_get_id_code (attdef));
                 fprintf (stderr,
                   (_("\t%s entity is relocated to layer 0")),
                   dxf_entity_name);
-                dxf_attdef_set_layer (attdef, strdup (DXF_DEFAULT_LAYER));
+                dxf_attdef_set_layer (attdef, DXF_DEFAULT_LAYER);
         }
         if (dxf_attdef_get_height (attdef) == 0.0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () height has a value of 0.0 for the %s entity with id-code: %x.\n")),
+                  (_("Warning in %s () height has a value of 0.0 for the %s entity with id-code: %lx.\n")),
                   __FUNCTION__, dxf_entity_name, dxf_attdef_get_id_code (attdef));
                 fprintf (stderr,
                   (_("\tdefault height of 1.0 applied to %s entity.\n")),
@@ -591,7 +520,7 @@ dxf_attdef_write
         if (dxf_attdef_get_rel_x_scale (attdef) == 0.0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () relative X-scale factor has a value of 0.0 for the %s entity with id-code: %x.\n")),
+                  (_("Warning in %s () relative X-scale factor has a value of 0.0 for the %s entity with id-code: %lx.\n")),
                   __FUNCTION__, dxf_entity_name, dxf_attdef_get_id_code (attdef));
                 fprintf (stderr,
                   (_("\tdefault relative X-scale of 1.0 applied to %s entity.\n")),
@@ -599,10 +528,10 @@ dxf_attdef_write
                 dxf_attdef_set_rel_x_scale (attdef, 1.0);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
-        if (dxf_attdef_get_id_code (attdef) != -1)
+        dxf_write_string (fp, 0, dxf_entity_name);
+        if (attdef->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", dxf_attdef_get_id_code (attdef));
+                dxf_write_hex (fp, 5, dxf_attdef_get_id_code (attdef));
         }
         /*!
          * \todo for version R14.\n
@@ -617,93 +546,93 @@ dxf_attdef_write
         if ((strcmp (dxf_attdef_get_dictionary_owner_soft (attdef), "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", dxf_attdef_get_dictionary_owner_soft (attdef));
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, dxf_attdef_get_dictionary_owner_soft (attdef));
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (dxf_attdef_get_dictionary_owner_hard (attdef), "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", dxf_attdef_get_dictionary_owner_hard (attdef));
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, dxf_attdef_get_dictionary_owner_hard (attdef));
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbEntity\n");
+                dxf_write_string (fp, 100, "AcDbEntity");
         }
-        if (attdef->paperspace == DXF_PAPERSPACE)
+        if (attdef->properties->paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp->fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_int (fp, 67, DXF_PAPERSPACE);
         }
-        fprintf (fp->fp, "  8\n%s\n", dxf_attdef_get_layer (attdef));
+        dxf_write_string (fp, 8, dxf_attdef_get_layer (attdef));
         if (strcmp (dxf_attdef_get_linetype (attdef), DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp->fp, "  6\n%s\n", dxf_attdef_get_linetype (attdef));
+                dxf_write_string (fp, 6, dxf_attdef_get_linetype (attdef));
         }
         if (dxf_attdef_get_color (attdef) != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp->fp, " 62\n%d\n", dxf_attdef_get_color (attdef));
+                dxf_write_int (fp, 62, dxf_attdef_get_color (attdef));
         }
         if (dxf_attdef_get_linetype_scale (attdef) != 1.0)
         {
-                fprintf (fp->fp, " 48\n%f\n", dxf_attdef_get_linetype_scale (attdef));
+                dxf_write_double (fp, 48, dxf_attdef_get_linetype_scale (attdef));
         }
         if (dxf_attdef_get_visibility (attdef) != 0)
         {
-                fprintf (fp->fp, " 60\n%d\n", dxf_attdef_get_visibility (attdef));
+                dxf_write_int (fp, 60, dxf_attdef_get_visibility (attdef));
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbText\n");
+                dxf_write_string (fp, 100, "AcDbText");
         }
         if (dxf_attdef_get_thickness (attdef) != 0.0)
         {
-                fprintf (fp->fp, " 39\n%f\n", dxf_attdef_get_thickness (attdef));
+                dxf_write_double (fp, 39, dxf_attdef_get_thickness (attdef));
         }
-        fprintf (fp->fp, " 10\n%f\n", dxf_attdef_get_x0 (attdef));
-        fprintf (fp->fp, " 20\n%f\n", dxf_attdef_get_y0 (attdef));
-        fprintf (fp->fp, " 30\n%f\n", dxf_attdef_get_z0 (attdef));
-        fprintf (fp->fp, " 40\n%f\n", dxf_attdef_get_height (attdef));
-        fprintf (fp->fp, "  1\n%s\n", dxf_attdef_get_default_value (attdef));
+        dxf_write_double (fp, 10, dxf_attdef_get_x0 (attdef));
+        dxf_write_double (fp, 20, dxf_attdef_get_y0 (attdef));
+        dxf_write_double (fp, 30, dxf_attdef_get_z0 (attdef));
+        dxf_write_double (fp, 40, dxf_attdef_get_height (attdef));
+        dxf_write_string (fp, 1, dxf_attdef_get_default_value (attdef));
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbAttributeDefinition\n");
+                dxf_write_string (fp, 100, "AcDbAttributeDefinition");
         }
-        fprintf (fp->fp, "  3\n%s\n", dxf_attdef_get_prompt_value (attdef));
-        fprintf (fp->fp, "  2\n%s\n", dxf_attdef_get_tag_value (attdef));
-        fprintf (fp->fp, " 70\n%d\n", dxf_attdef_get_attr_flags (attdef));
+        dxf_write_string (fp, 3, dxf_attdef_get_prompt_value (attdef));
+        dxf_write_string (fp, 2, dxf_attdef_get_tag_value (attdef));
+        dxf_write_int (fp, 70, dxf_attdef_get_attr_flags (attdef));
         if (dxf_attdef_get_field_length (attdef) != 0)
         {
-                fprintf (fp->fp, " 73\n%d\n", dxf_attdef_get_field_length (attdef));
+                dxf_write_int (fp, 73, dxf_attdef_get_field_length (attdef));
         }
         if (dxf_attdef_get_rot_angle (attdef) != 0.0)
         {
-                fprintf (fp->fp, " 50\n%f\n", dxf_attdef_get_rot_angle (attdef));
+                dxf_write_double (fp, 50, dxf_attdef_get_rot_angle (attdef));
         }
         if (dxf_attdef_get_rel_x_scale (attdef) != 1.0)
         {
-                fprintf (fp->fp, " 41\n%f\n", dxf_attdef_get_rel_x_scale (attdef));
+                dxf_write_double (fp, 41, dxf_attdef_get_rel_x_scale (attdef));
         }
         if (dxf_attdef_get_obl_angle (attdef) != 0.0)
         {
-                fprintf (fp->fp, " 51\n%f\n", dxf_attdef_get_obl_angle (attdef));
+                dxf_write_double (fp, 51, dxf_attdef_get_obl_angle (attdef));
         }
         if (strcmp (dxf_attdef_get_text_style (attdef), "STANDARD") != 0)
         {
-                fprintf (fp->fp, "  7\n%s\n", dxf_attdef_get_text_style (attdef));
+                dxf_write_string (fp, 7, dxf_attdef_get_text_style (attdef));
         }
         if (dxf_attdef_get_text_flags (attdef) != 0)
         {
-                fprintf (fp->fp, " 71\n%d\n", dxf_attdef_get_text_flags (attdef));
+                dxf_write_int (fp, 71, dxf_attdef_get_text_flags (attdef));
         }
         if (dxf_attdef_get_hor_align (attdef) != 0)
         {
-                fprintf (fp->fp, " 72\n%d\n", dxf_attdef_get_hor_align (attdef));
+                dxf_write_int (fp, 72, dxf_attdef_get_hor_align (attdef));
         }
         if (dxf_attdef_get_vert_align (attdef) != 0)
         {
-                fprintf (fp->fp, " 74\n%d\n", dxf_attdef_get_vert_align (attdef));
+                dxf_write_int (fp, 74, dxf_attdef_get_vert_align (attdef));
         }
         if ((dxf_attdef_get_hor_align (attdef) != 0) || (dxf_attdef_get_vert_align (attdef) != 0))
         {
@@ -712,7 +641,7 @@ dxf_attdef_write
                         && (dxf_attdef_get_z0 (attdef) == dxf_attdef_get_z1 (attdef)))
                 {
                         fprintf (stderr,
-                          (_("Warning in %s () insertion point and alignment point are identical for the %s entity with id-code: %x.\n")),
+                          (_("Warning in %s () insertion point and alignment point are identical for the %s entity with id-code: %lx.\n")),
                           __FUNCTION__, dxf_entity_name, dxf_attdef_get_id_code (attdef));
                         fprintf (stderr,
                           (_("\tdefault justification applied to %s entity.\n")),
@@ -722,19 +651,19 @@ dxf_attdef_write
                 }
                 else
                 {
-                        fprintf (fp->fp, " 11\n%f\n", dxf_attdef_get_x1 (attdef));
-                        fprintf (fp->fp, " 21\n%f\n", dxf_attdef_get_y1 (attdef));
-                        fprintf (fp->fp, " 31\n%f\n", dxf_attdef_get_z1 (attdef));
+                        dxf_write_double (fp, 11, dxf_attdef_get_x1 (attdef));
+                        dxf_write_double (fp, 21, dxf_attdef_get_y1 (attdef));
+                        dxf_write_double (fp, 31, dxf_attdef_get_z1 (attdef));
                 }
         }
         if (fp->acad_version_number >= AutoCAD_12)
         {
-                fprintf (fp->fp, "210\n%f\n", dxf_attdef_get_extr_x0 (attdef));
-                fprintf (fp->fp, "220\n%f\n", dxf_attdef_get_extr_y0 (attdef));
-                fprintf (fp->fp, "230\n%f\n", dxf_attdef_get_extr_z0 (attdef));
+                dxf_write_double (fp, 210, dxf_attdef_get_extr_x0 (attdef));
+                dxf_write_double (fp, 220, dxf_attdef_get_extr_y0 (attdef));
+                dxf_write_double (fp, 230, dxf_attdef_get_extr_z0 (attdef));
         }
         /* Clean up. */
-        free (dxf_entity_name);
+        dxf_free (dxf_entity_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -766,15 +695,17 @@ dxf_attdef_free
                 __FUNCTION__);
               return (EXIT_FAILURE);
         }
-        free (attdef->linetype);
-        free (attdef->layer);
-        free (attdef->default_value);
-        free (attdef->tag_value);
-        free (attdef->prompt_value);
-        free (attdef->text_style);
-        free (attdef->dictionary_owner_soft);
-        free (attdef->dictionary_owner_hard);
-        free (attdef);
+        dxf_graphic_properties_free (attdef->properties);
+        dxf_free (attdef->default_value);
+        dxf_free (attdef->tag_value);
+        dxf_free (attdef->prompt_value);
+        dxf_free (attdef->text_style);
+        dxf_free (attdef->dictionary_owner_soft);
+        dxf_free (attdef->dictionary_owner_hard);
+        dxf_binary_graphics_data_free_chain (attdef->binary_graphics_data);
+        dxf_point_free (attdef->p0);
+        dxf_point_free (attdef->p1);
+        dxf_free (attdef);
         attdef = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -794,7 +725,7 @@ dxf_attdef_free_chain
                 /*!< pointer to the chain of DXF \c ATTDEF entities. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (attdefs == NULL)
@@ -820,7 +751,7 @@ dxf_attdef_free_chain
  *
  * \return ID code.
  */
-int
+long
 dxf_attdef_get_id_code
 (
         DxfAttdef *attdef
@@ -860,7 +791,7 @@ dxf_attdef_set_id_code
 (
         DxfAttdef *attdef,
                 /*!< a pointer to a DXF \c ATTDEF entity. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -915,7 +846,7 @@ dxf_attdef_get_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        if (attdef->linetype ==  NULL)
+        if (attdef->properties->linetype ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found.\n")),
@@ -925,7 +856,7 @@ dxf_attdef_get_linetype
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (attdef->linetype));
+        return (dxf_strdup (attdef->properties->linetype));
 }
 
 
@@ -959,7 +890,12 @@ dxf_attdef_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        attdef->linetype = strdup (linetype);
+        if (dxf_graphic_properties_unshare (&attdef->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (attdef->properties->linetype);
+        attdef->properties->linetype = dxf_strdup (linetype);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -990,7 +926,7 @@ dxf_attdef_get_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        if (attdef->layer ==  NULL)
+        if (attdef->properties->layer ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found.\n")),
@@ -1000,7 +936,7 @@ dxf_attdef_get_layer
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (attdef->layer));
+        return (dxf_strdup (attdef->properties->layer));
 }
 
 
@@ -1034,7 +970,12 @@ dxf_attdef_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        attdef->layer = strdup (layer);
+        if (dxf_graphic_properties_unshare (&attdef->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (attdef->properties->layer);
+        attdef->properties->layer = dxf_strdup (layer);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1068,7 +1009,7 @@ dxf_attdef_get_elevation
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (attdef->elevation);
+        return (attdef->properties->elevation);
 }
 
 
@@ -1095,7 +1036,11 @@ dxf_attdef_set_elevation
                   __FUNCTION__);
                 return (NULL);
         }
-        attdef->elevation = elevation;
+        if (dxf_graphic_properties_unshare (&attdef->properties) == NULL)
+        {
+                return (NULL);
+        }
+        attdef->properties->elevation = elevation;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1126,7 +1071,7 @@ dxf_attdef_get_thickness
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (attdef->thickness < 0.0)
+        if (attdef->properties->thickness < 0.0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found.\n")),
@@ -1136,7 +1081,7 @@ dxf_attdef_get_thickness
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (attdef->thickness);
+        return (attdef->properties->thickness);
 }
 
 
@@ -1170,7 +1115,11 @@ dxf_attdef_set_thickness
                   __FUNCTION__);
                 return (NULL);
         }
-        attdef->thickness = thickness;
+        if (dxf_graphic_properties_unshare (&attdef->properties) == NULL)
+        {
+                return (NULL);
+        }
+        attdef->properties->thickness = thickness;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1201,7 +1150,7 @@ dxf_attdef_get_linetype_scale
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (attdef->linetype_scale < 0.0)
+        if (attdef->properties->linetype_scale < 0.0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found.\n")),
@@ -1211,7 +1160,7 @@ dxf_attdef_get_linetype_scale
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (attdef->linetype_scale);
+        return (attdef->properties->linetype_scale);
 }
 
 
@@ -1245,7 +1194,11 @@ dxf_attdef_set_linetype_scale
                   __FUNCTION__);
                 return (NULL);
         }
-        attdef->linetype_scale = linetype_scale;
+        if (dxf_graphic_properties_unshare (&attdef->properties) == NULL)
+        {
+                return (NULL);
+        }
+        attdef->properties->linetype_scale = linetype_scale;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1276,14 +1229,14 @@ dxf_attdef_get_visibility
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (attdef->visibility < 0)
+        if (attdef->properties->visibility < 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (attdef->visibility > 1)
+        if (attdef->properties->visibility > 1)
         {
                 fprintf (stderr,
                   (_("Error in %s () an out of range value was found.\n")),
@@ -1293,7 +1246,7 @@ dxf_attdef_get_visibility
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (attdef->visibility);
+        return (attdef->properties->visibility);
 }
 
 
@@ -1334,7 +1287,11 @@ dxf_attdef_set_visibility
                   __FUNCTION__);
                 return (NULL);
         }
-        attdef->visibility = visibility;
+        if (dxf_graphic_properties_unshare (&attdef->properties) == NULL)
+        {
+                return (NULL);
+        }
+        attdef->properties->visibility = visibility;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1365,7 +1322,7 @@ dxf_attdef_get_color
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (attdef->color < 0)
+        if (attdef->properties->color < 0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found.\n")),
@@ -1374,7 +1331,7 @@ dxf_attdef_get_color
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (attdef->color);
+        return (attdef->properties->color);
 }
 
 
@@ -1407,7 +1364,11 @@ dxf_attdef_set_color
                   (_("Warning in %s () a negative value was passed.\n")),
                   __FUNCTION__);
         }
-        attdef->color = color;
+        if (dxf_graphic_properties_unshare (&attdef->properties) == NULL)
+        {
+                return (NULL);
+        }
+        attdef->properties->color = color;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1438,13 +1399,13 @@ dxf_attdef_get_paperspace
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (attdef->paperspace < 0)
+        if (attdef->properties->paperspace < 0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found.\n")),
                   __FUNCTION__);
         }
-        if (attdef->paperspace > 1)
+        if (attdef->properties->paperspace > 1)
         {
                 fprintf (stderr,
                   (_("Warning in %s () an out of range value was found.\n")),
@@ -1453,7 +1414,7 @@ dxf_attdef_get_paperspace
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (attdef->paperspace);
+        return (attdef->properties->paperspace);
 }
 
 
@@ -1494,7 +1455,11 @@ dxf_attdef_set_paperspace
                   __FUNCTION__);
                 return (NULL);
         }
-        attdef->paperspace = paperspace;
+        if (dxf_graphic_properties_unshare (&attdef->properties) == NULL)
+        {
+                return (NULL);
+        }
+        attdef->properties->paperspace = paperspace;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1619,14 +1584,14 @@ dxf_attdef_get_shadow_mode
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (attdef->shadow_mode < 0)
+        if (attdef->properties->shadow_mode < 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (attdef->shadow_mode > 3)
+        if (attdef->properties->shadow_mode > 3)
         {
                 fprintf (stderr,
                   (_("Error in %s () an out of range value was found.\n")),
@@ -1636,7 +1601,7 @@ dxf_attdef_get_shadow_mode
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (attdef->shadow_mode);
+        return (attdef->properties->shadow_mode);
 }
 
 
@@ -1680,7 +1645,11 @@ dxf_attdef_set_shadow_mode
                   __FUNCTION__);
                 return (NULL);
         }
-        attdef->shadow_mode = shadow_mode;
+        if (dxf_graphic_properties_unshare (&attdef->properties) == NULL)
+        {
+                return (NULL);
+        }
+        attdef->properties->shadow_mode = shadow_mode;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1804,7 +1773,7 @@ dxf_attdef_get_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (attdef->dictionary_owner_soft));
+        return (dxf_strdup (attdef->dictionary_owner_soft));
 }
 
 
@@ -1840,7 +1809,7 @@ dxf_attdef_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        attdef->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        attdef->dictionary_owner_soft = dxf_strdup (dictionary_owner_soft);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1874,7 +1843,7 @@ dxf_attdef_get_material
                   __FUNCTION__);
                 return (NULL);
         }
-        if (attdef->material ==  NULL)
+        if (attdef->properties->material ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found.\n")),
@@ -1884,7 +1853,7 @@ dxf_attdef_get_material
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (attdef->material));
+        return (dxf_strdup (attdef->properties->material));
 }
 
 
@@ -1922,7 +1891,12 @@ dxf_attdef_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        attdef->material = strdup (material);
+        if (dxf_graphic_properties_unshare (&attdef->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (attdef->properties->material);
+        attdef->properties->material = dxf_strdup (material);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1966,7 +1940,7 @@ dxf_attdef_get_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (attdef->dictionary_owner_hard));
+        return (dxf_strdup (attdef->dictionary_owner_hard));
 }
 
 
@@ -2002,7 +1976,7 @@ dxf_attdef_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        attdef->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        attdef->dictionary_owner_hard = dxf_strdup (dictionary_owner_hard);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2037,7 +2011,7 @@ dxf_attdef_get_lineweight
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (attdef->lineweight);
+        return (attdef->properties->lineweight);
 }
 
 
@@ -2067,7 +2041,11 @@ dxf_attdef_set_lineweight
                   __FUNCTION__);
                 return (NULL);
         }
-        attdef->lineweight = lineweight;
+        if (dxf_graphic_properties_unshare (&attdef->properties) == NULL)
+        {
+                return (NULL);
+        }
+        attdef->properties->lineweight = lineweight;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2099,7 +2077,7 @@ dxf_attdef_get_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        if (attdef->plot_style_name ==  NULL)
+        if (attdef->properties->plot_style_name ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found.\n")),
@@ -2109,7 +2087,7 @@ dxf_attdef_get_plot_style_name
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (attdef->plot_style_name));
+        return (dxf_strdup (attdef->properties->plot_style_name));
 }
 
 
@@ -2147,7 +2125,12 @@ dxf_attdef_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        attdef->plot_style_name = strdup (plot_style_name);
+        if (dxf_graphic_properties_unshare (&attdef->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (attdef->properties->plot_style_name);
+        attdef->properties->plot_style_name = dxf_strdup (plot_style_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2182,7 +2165,7 @@ dxf_attdef_get_color_value
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (attdef->color_value);
+        return (attdef->properties->color_value);
 }
 
 
@@ -2212,7 +2195,11 @@ dxf_attdef_set_color_value
                   __FUNCTION__);
                 return (NULL);
         }
-        attdef->color_value = color_value;
+        if (dxf_graphic_properties_unshare (&attdef->properties) == NULL)
+        {
+                return (NULL);
+        }
+        attdef->properties->color_value = color_value;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2244,7 +2231,7 @@ dxf_attdef_get_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        if (attdef->color_name ==  NULL)
+        if (attdef->properties->color_name ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found.\n")),
@@ -2254,7 +2241,7 @@ dxf_attdef_get_color_name
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (attdef->color_name));
+        return (dxf_strdup (attdef->properties->color_name));
 }
 
 
@@ -2292,7 +2279,12 @@ dxf_attdef_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        attdef->color_name = strdup (color_name);
+        if (dxf_graphic_properties_unshare (&attdef->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (attdef->properties->color_name);
+        attdef->properties->color_name = dxf_strdup (color_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2327,7 +2319,7 @@ dxf_attdef_get_transparency
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (attdef->transparency);
+        return (attdef->properties->transparency);
 }
 
 
@@ -2357,7 +2349,11 @@ dxf_attdef_set_transparency
                   __FUNCTION__);
                 return (NULL);
         }
-        attdef->transparency = transparency;
+        if (dxf_graphic_properties_unshare (&attdef->properties) == NULL)
+        {
+                return (NULL);
+        }
+        attdef->properties->transparency = transparency;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2400,7 +2396,7 @@ dxf_attdef_get_default_value
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (attdef->default_value));
+        return (dxf_strdup (attdef->default_value));
 }
 
 
@@ -2435,7 +2431,7 @@ dxf_attdef_set_default_value
                   __FUNCTION__);
                 return (NULL);
         }
-        attdef->default_value = strdup (default_value);
+        attdef->default_value = dxf_strdup (default_value);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2478,7 +2474,7 @@ dxf_attdef_get_tag_value
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (attdef->tag_value));
+        return (dxf_strdup (attdef->tag_value));
 }
 
 
@@ -2513,7 +2509,7 @@ dxf_attdef_set_tag_value
                   __FUNCTION__);
                 return (NULL);
         }
-        attdef->tag_value = strdup (tag_value);
+        attdef->tag_value = dxf_strdup (tag_value);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2556,7 +2552,7 @@ dxf_attdef_get_prompt_value
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (attdef->prompt_value));
+        return (dxf_strdup (attdef->prompt_value));
 }
 
 
@@ -2591,7 +2587,7 @@ dxf_attdef_set_prompt_value
                   __FUNCTION__);
                 return (NULL);
         }
-        attdef->prompt_value = strdup (prompt_value);
+        attdef->prompt_value = dxf_strdup (prompt_value);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2634,7 +2630,7 @@ dxf_attdef_get_text_style
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (attdef->text_style));
+        return (dxf_strdup (attdef->text_style));
 }
 
 
@@ -2669,7 +2665,7 @@ dxf_attdef_set_text_style
                   __FUNCTION__);
                 return (NULL);
         }
-        attdef->text_style = strdup (text_style);
+        attdef->text_style = dxf_strdup (text_style);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2689,7 +2685,7 @@ dxf_attdef_get_p0
                 /*!< a pointer to a DXF \c ATTDEF entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2729,7 +2725,7 @@ dxf_attdef_set_p0
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2768,7 +2764,7 @@ dxf_attdef_get_x0
                 /*!< a pointer to a DXF \c ATTDEF entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2811,7 +2807,7 @@ dxf_attdef_set_x0
                  * DXF \c ATTDEF entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2850,7 +2846,7 @@ dxf_attdef_get_y0
                 /*!< a pointer to a DXF \c ATTDEF entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2893,7 +2889,7 @@ dxf_attdef_set_y0
                  * DXF \c ATTDEF entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2932,7 +2928,7 @@ dxf_attdef_get_z0
                 /*!< a pointer to a DXF \c ATTDEF entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2975,7 +2971,7 @@ dxf_attdef_set_z0
                  * DXF \c ATTDEF entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3013,7 +3009,7 @@ dxf_attdef_get_p1
                 /*!< a pointer to a DXF \c ATTDEF entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3053,7 +3049,7 @@ dxf_attdef_set_p1
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3092,7 +3088,7 @@ dxf_attdef_get_x1
                 /*!< a pointer to a DXF \c ATTDEF entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3135,7 +3131,7 @@ dxf_attdef_set_x1
                  * a DXF \c ATTDEF entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3174,7 +3170,7 @@ dxf_attdef_get_y1
                 /*!< a pointer to a DXF \c ATTDEF entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3217,7 +3213,7 @@ dxf_attdef_set_y1
                  * \c ATTDEF entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3256,7 +3252,7 @@ dxf_attdef_get_z1
                 /*!< a pointer to a DXF \c ATTDEF entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3299,7 +3295,7 @@ dxf_attdef_set_z1
                  * a DXF \c ATTDEF entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -4167,7 +4163,7 @@ dxf_attdef_get_extr_x0
                 /*!< a pointer to a DXF \c ATTDEF entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -4202,7 +4198,7 @@ dxf_attdef_set_extr_x0
                 /*!< the X-value of the extrusion vector of the entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -4234,7 +4230,7 @@ dxf_attdef_get_extr_y0
                 /*!< a pointer to a DXF \c ATTDEF entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -4270,7 +4266,7 @@ dxf_attdef_set_extr_y0
                  * \c ATTDEF entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -4302,7 +4298,7 @@ dxf_attdef_get_extr_z0
                 /*!< a pointer to a DXF \c ATTDEF entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -4338,7 +4334,7 @@ dxf_attdef_set_extr_z0
                  * \c ATTDEF entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -4372,7 +4368,7 @@ dxf_attdef_get_extrusion_vector_as_point
                 /*!< a pointer to a DXF \c ATTDEF entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         DxfPoint *point = NULL;
@@ -39,6 +39,9 @@
 
 
 #include "attrib.h"
+#include "arena.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -58,7 +61,7 @@ dxf_attrib_new ()
         size = sizeof (DxfAttrib);
         /* avoid malloc of 0 bytes */
         if (size == 0) size = 1;
-        if ((attrib = malloc (size)) == NULL)
+        if ((attrib = dxf_malloc (size)) == NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () could not allocate memory for a DxfAttrib struct.\n")),
@@ -109,29 +112,15 @@ dxf_attrib_init
                 return (NULL);
         }
         dxf_attrib_set_id_code (attrib, 0);
-        dxf_attrib_set_linetype (attrib, strdup (DXF_DEFAULT_LINETYPE));
-        dxf_attrib_set_text_style (attrib, strdup (DXF_DEFAULT_TEXTSTYLE));
-        dxf_attrib_set_layer (attrib, strdup (DXF_DEFAULT_LAYER));
-        dxf_attrib_set_elevation (attrib, 0.0);
-        dxf_attrib_set_thickness (attrib, 0.0);
-        dxf_attrib_set_linetype_scale (attrib, DXF_DEFAULT_LINETYPE_SCALE);
-        dxf_attrib_set_visibility (attrib, DXF_DEFAULT_VISIBILITY);
-        dxf_attrib_set_color (attrib, DXF_COLOR_BYLAYER);
-        dxf_attrib_set_paperspace (attrib, DXF_MODELSPACE);
+        attrib->properties = dxf_graphic_properties_default ();
+        dxf_attrib_set_text_style (attrib, DXF_DEFAULT_TEXTSTYLE);
         dxf_attrib_set_graphics_data_size (attrib, 0);
-        dxf_attrib_set_shadow_mode (attrib, 0);
         dxf_attrib_set_binary_graphics_data (attrib, (DxfBinaryGraphicsData *) dxf_binary_graphics_data_new ());
         dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) dxf_attrib_get_binary_graphics_data (attrib));
         dxf_attrib_set_dictionary_owner_soft (attrib, strdup(""));
-        dxf_attrib_set_material (attrib, strdup (""));
         dxf_attrib_set_dictionary_owner_hard (attrib, strdup(""));
-        dxf_attrib_set_lineweight (attrib, 0);
-        dxf_attrib_set_plot_style_name (attrib, strdup (""));
-        dxf_attrib_set_color_value (attrib, 0);
-        dxf_attrib_set_color_name (attrib, strdup (""));
-        dxf_attrib_set_transparency (attrib, 0);
-        dxf_attrib_set_default_value (attrib, strdup (""));
-        dxf_attrib_set_tag_value (attrib, strdup (""));
+        dxf_attrib_set_default_value (attrib, "");
+        dxf_attrib_set_tag_value (attrib, "");
         dxf_attrib_set_p0 (attrib, dxf_point_new ());
         dxf_point_init ((DxfPoint *) dxf_attrib_get_p0 (attrib));
         dxf_attrib_set_x0 (attrib, 0.0);
@@ -154,7 +143,6 @@ dxf_attrib_init
         dxf_attrib_set_extr_x0 (attrib, 0.0);
         dxf_attrib_set_extr_y0 (attrib, 0.0);
         dxf_attrib_set_extr_z0 (attrib, 1.0);
-        dxf_attrib_set_lineweight (attrib, 0);
         dxf_attrib_set_next (attrib, NULL);
 #if DEBUG
         DXF_DEBUG_END
@@ -186,7 +174,9 @@ dxf_attrib_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfGraphicProperties properties;
+        DxfPair pair;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -194,8 +184,6 @@ dxf_attrib_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (attrib == NULL)
@@ -206,294 +194,235 @@ dxf_attrib_read
                 attrib = dxf_attrib_new ();
                 attrib = dxf_attrib_init (attrib);
         }
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        dxf_graphic_properties_start (&properties, attrib->properties);
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        fclose (fp->fp);
-                        /* Clean up. */
-                        free (temp_string);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "1") == 0)
-                {
-                        /* Now follows a string containing the attribute
-                         * value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", attrib->default_value);
-                }
-                else if (strcmp (temp_string, "2") == 0)
-                {
-                        /* Now follows a string containing a tag value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", attrib->tag_value);
-                }
-                else if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &attrib->id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", attrib->linetype);
-                }
-                else if (strcmp (temp_string, "7") == 0)
-                {
-                        /* Now follows a string containing a text style. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", attrib->text_style);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", attrib->layer);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the start point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &attrib->p0->x0);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the start point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &attrib->p0->y0);
-                }
-                else if (strcmp (temp_string, "30") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the start point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &attrib->p0->z0);
-                }
-                else if (strcmp (temp_string, "11") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the align point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &attrib->p1->x0);
-                }
-                else if (strcmp (temp_string, "21") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the align point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &attrib->p1->y0);
-                }
-                else if (strcmp (temp_string, "31") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the align point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &attrib->p1->z0);
-                }
-                else if ((fp->acad_version_number <= AutoCAD_11)
-                        && (strcmp (temp_string, "38") == 0)
-                        && (attrib->elevation = 0.0))
-                {
-                        /* Elevation is a pre AutoCAD R11 variable
-                         * so additional testing for the version should
-                         * probably be added.
-                         * Now follows a string containing the
-                         * elevation. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &attrib->elevation);
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &attrib->thickness);
-                }
-                else if (strcmp (temp_string, "40") == 0)
-                {
-                        /* Now follows a string containing the
-                         * height. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &attrib->height);
-                }
-                else if (strcmp (temp_string, "41") == 0)
-                {
-                        /* Now follows a string containing the
-                         * relative X-scale. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &attrib->rel_x_scale);
-                }
-                else if (strcmp (temp_string, "48") == 0)
-                {
-                        /* Now follows a string containing the linetype
-                         * scale. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &attrib->linetype_scale);
-                }
-                else if (strcmp (temp_string, "50") == 0)
-                {
-                        /* Now follows a string containing the
-                         * rotation angle. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &attrib->rot_angle);
-                }
-                else if (strcmp (temp_string, "51") == 0)
-                {
-                        /* Now follows a string containing the
-                         * end angle. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &attrib->obl_angle);
-                }
-                else if (strcmp (temp_string, "60") == 0)
-                {
-                        /* Now follows a string containing the
-                         * visibility value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &attrib->visibility);
-                }
-                else if (strcmp (temp_string, "62") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &attrib->color);
-                }
-                else if (strcmp (temp_string, "67") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &attrib->paperspace);
-                }
-                else if (strcmp (temp_string, "70") == 0)
-                {
-                        /* Now follows a string containing the
-                         * attribute flags value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &attrib->attr_flags);
-                }
-                else if (strcmp (temp_string, "71") == 0)
-                {
-                        /* Now follows a string containing the
-                         * text flags value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &attrib->text_flags);
-                }
-                else if (strcmp (temp_string, "72") == 0)
-                {
-                        /* Now follows a string containing the
-                         * horizontal alignment value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &attrib->hor_align);
-                }
-                else if (strcmp (temp_string, "73") == 0)
-                {
-                        /* Now follows a string containing the
-                         * field length value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &attrib->field_length);
-                }
-                else if (strcmp (temp_string, "74") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing the
-                         * vertical alignment value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &attrib->vert_align);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else if ((fp->acad_version_number >= AutoCAD_12)
-                        && (strcmp (temp_string, "100") == 0))
+                switch (pair.group_code)
                 {
-                        /* Subclass markers are post AutoCAD R12
-                         * variable so additional testing for the
-                         * version should probably be added here.
-                         * Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if ((strcmp (temp_string, "AcDbEntity") != 0)
-                        && (strcmp (temp_string, "AcDbText") != 0)
-                        && (strcmp (temp_string, "AcDbAttribute") != 0))
-                        {
+                        case 1:
+                                /* Now follows a string containing the attribute
+                                 * value. */
+                                dxf_free (attrib->default_value);
+                                attrib->default_value = dxf_pair_get_string (&pair);
+                                break;
+                        case 2:
+                                /* Now follows a string containing a tag value. */
+                                dxf_free (attrib->tag_value);
+                                attrib->tag_value = dxf_pair_get_string (&pair);
+                                break;
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                attrib->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 6:
+                                /* Now follows a string containing a linetype
+                                 * name. */
+                                dxf_lexer_free_string (fp, properties.linetype);
+                                properties.linetype = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 7:
+                                /* Now follows a string containing a text style. */
+                                dxf_free (attrib->text_style);
+                                attrib->text_style = dxf_pair_get_string (&pair);
+                                break;
+                        case 8:
+                                /* Now follows a string containing a layer name. */
+                                dxf_lexer_free_string (fp, properties.layer);
+                                properties.layer = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 10:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the start point. */
+                                attrib->p0->x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 20:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the start point. */
+                                attrib->p0->y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 30:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the start point. */
+                                attrib->p0->z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 11:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the align point. */
+                                attrib->p1->x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 21:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the align point. */
+                                attrib->p1->y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 31:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the align point. */
+                                attrib->p1->z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 38:
+                                if ((fp->acad_version_number <= AutoCAD_11)
+                                  && (properties.elevation = 0.0))
+                                {
+                                        /* Elevation is a pre AutoCAD R11 variable
+                                         * so additional testing for the version should
+                                         * probably be added.
+                                         * Now follows a string containing the
+                                         * elevation. */
+                                        properties.elevation = dxf_pair_get_double (&pair);
+                                }
+                                break;
+                        case 39:
+                                /* Now follows a string containing the
+                                 * thickness. */
+                                properties.thickness = dxf_pair_get_double (&pair);
+                                break;
+                        case 40:
+                                /* Now follows a string containing the
+                                 * height. */
+                                attrib->height = dxf_pair_get_double (&pair);
+                                break;
+                        case 41:
+                                /* Now follows a string containing the
+                                 * relative X-scale. */
+                                attrib->rel_x_scale = dxf_pair_get_double (&pair);
+                                break;
+                        case 48:
+                                /* Now follows a string containing the linetype
+                                 * scale. */
+                                properties.linetype_scale = dxf_pair_get_double (&pair);
+                                break;
+                        case 50:
+                                /* Now follows a string containing the
+                                 * rotation angle. */
+                                attrib->rot_angle = dxf_pair_get_double (&pair);
+                                break;
+                        case 51:
+                                /* Now follows a string containing the
+                                 * end angle. */
+                                attrib->obl_angle = dxf_pair_get_double (&pair);
+                                break;
+                        case 60:
+                                /* Now follows a string containing the
+                                 * visibility value. */
+                                properties.visibility = dxf_pair_get_int (&pair);
+                                break;
+                        case 62:
+                                /* Now follows a string containing the
+                                 * color value. */
+                                properties.color = dxf_pair_get_int (&pair);
+                                break;
+                        case 67:
+                                /* Now follows a string containing the
+                                 * paperspace value. */
+                                properties.paperspace = dxf_pair_get_int (&pair);
+                                break;
+                        case 70:
+                                /* Now follows a string containing the
+                                 * attribute flags value. */
+                                attrib->attr_flags = dxf_pair_get_int (&pair);
+                                break;
+                        case 71:
+                                /* Now follows a string containing the
+                                 * text flags value. */
+                                attrib->text_flags = dxf_pair_get_int (&pair);
+                                break;
+                        case 72:
+                                /* Now follows a string containing the
+                                 * horizontal alignment value. */
+                                attrib->hor_align = dxf_pair_get_int (&pair);
+                                break;
+                        case 73:
+                                /* Now follows a string containing the
+                                 * field length value. */
+                                attrib->field_length = dxf_pair_get_int (&pair);
+                                break;
+                        case 74:
+                                /* Now follows a string containing the
+                                 * vertical alignment value. */
+                                attrib->vert_align = dxf_pair_get_int (&pair);
+                                break;
+                        case 100:
+                                if (fp->acad_version_number >= AutoCAD_12)
+                                {
+                                        /* Subclass markers are post AutoCAD R12
+                                         * variable so additional testing for the
+                                         * version should probably be added here.
+                                         * Now follows a string containing the
+                                         * subclass marker value. */
+                                        dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                        if ((strcmp (temp_string, "AcDbEntity") != 0)
+                                        && (strcmp (temp_string, "AcDbText") != 0)
+                                        && (strcmp (temp_string, "AcDbAttribute") != 0))
+                                        {
+                                                fprintf (stderr,
+                                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                                  __FUNCTION__, fp->filename, fp->line_number);
+                                        }
+                                }
+                                break;
+                        case 210:
+                                /* Now follows a string containing the
+                                 * X-value of the extrusion vector. */
+                                attrib->extr_x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 220:
+                                /* Now follows a string containing the
+                                 * Y-value of the extrusion vector. */
+                                attrib->extr_y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 230:
+                                /* Now follows a string containing the
+                                 * Z-value of the extrusion vector. */
+                                attrib->extr_z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, attrib->dictionary_owner_soft);
+                                attrib->dictionary_owner_soft = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, attrib->dictionary_owner_hard);
+                                attrib->dictionary_owner_hard = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, "DXF comment: %s\n", temp_string);
+                                break;
+                        default:
                                 fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
                                   __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "210") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &attrib->extr_x0);
-                }
-                else if (strcmp (temp_string, "220") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &attrib->extr_y0);
-                }
-                else if (strcmp (temp_string, "230") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &attrib->extr_z0);
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", attrib->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", attrib->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
         /* Handle omitted members and/or illegal values. */
-        if (strcmp (dxf_attrib_get_linetype (attrib), "") == 0)
+        if (strcmp (attrib->properties->linetype, "") == 0)
         {
-                dxf_attrib_set_linetype (attrib, strdup (DXF_DEFAULT_LINETYPE));
+                dxf_attrib_set_linetype (attrib, DXF_DEFAULT_LINETYPE);
         }
-        if (strcmp (dxf_attrib_get_layer (attrib), "") == 0)
+        if (strcmp (attrib->properties->layer, "") == 0)
         {
-                dxf_attrib_set_layer (attrib, strdup (DXF_DEFAULT_LAYER));
+                dxf_attrib_set_layer (attrib, DXF_DEFAULT_LAYER);
         }
-        /* Clean up. */
-        free (temp_string);
+        /* Entities with equal properties share a record. */
+        dxf_graphic_properties_finish (fp, &attrib->properties, &properties);
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (EXIT_SUCCESS);
+        return (attrib);
 }
 
 
@@ -512,7 +441,7 @@ dxf_attrib_write
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *dxf_entity_name = strdup ("ATTRIB");
+        char *dxf_entity_name = dxf_strdup ("ATTRIB");
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -521,7 +450,7 @@ dxf_attrib_write
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (attrib == NULL)
@@ -530,61 +459,61 @@ dxf_attrib_write
                   (_("Error in %s () a NULL pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (strcmp (dxf_attrib_get_default_value (attrib), "") == 0)
         {
                 fprintf (stderr,
-                  (_("Error in %s () default value string is empty for the %s entity with id-code: %x.\n")),
+                  (_("Error in %s () default value string is empty for the %s entity with id-code: %lx.\n")),
                   __FUNCTION__, dxf_entity_name, dxf_attrib_get_id_code (attrib));
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (strcmp (dxf_attrib_get_tag_value (attrib), "") == 0)
         {
                 fprintf (stderr,
-                  (_("Error in %s () tag value string is empty for the %s entity with id-code: %x.\n")),
+                  (_("Error in %s () tag value string is empty for the %s entity with id-code: %lx.\n")),
                   __FUNCTION__, dxf_entity_name, dxf_attrib_get_id_code (attrib));
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (strcmp (dxf_attrib_get_text_style (attrib), "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () text style string is empty for the %s entity with id-code: %x.\n")),
+                  (_("Warning in %s () text style string is empty for the %s entity with id-code: %lx.\n")),
                   __FUNCTION__, dxf_entity_name, dxf_attrib_get_id_code (attrib));
                 fprintf (stderr,
                   (_("\tdefault text style STANDARD applied to %s entity.\n")),
                   dxf_entity_name);
-                dxf_attrib_set_text_style (attrib, strdup (DXF_DEFAULT_TEXTSTYLE));
+                dxf_attrib_set_text_style (attrib, DXF_DEFAULT_TEXTSTYLE);
         }
         if (strcmp (dxf_attrib_get_linetype (attrib), "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_attrib_get_id_code (attrib));
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                dxf_attrib_set_linetype (attrib, strdup (DXF_DEFAULT_LINETYPE));
+                dxf_attrib_set_linetype (attrib, DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (dxf_attrib_get_layer (attrib), "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty layer string for the %s entity with id-code: %x.\n")),
+                  (_("Warning in %s () empty layer string for the %s entity with id-code: %lx.\n")),
                   __FUNCTION__, dxf_entity_name, dxf_attrib_get_id_code (attrib));
                 fprintf (stderr,
                   (_("\t%s entity is relocated to the default layer.\n")),
                   dxf_entity_name);
-                dxf_attrib_set_layer (attrib, strdup (DXF_DEFAULT_LAYER));
+                dxf_attrib_set_layer (attrib, DXF_DEFAULT_LAYER);
         }
         if (dxf_attrib_get_height (attrib) == 0.0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () height has a value of 0.0 for the %s entity with id-code: %x.\n")),
+                  (_("Warning in %s () height has a value of 0.0 for the %s entity with id-code: %lx.\n")),
                   __FUNCTION__, dxf_entity_name, dxf_attrib_get_id_code (attrib));
                 fprintf (stderr,
                   (_("\tdefault height of 1.0 applied to %s entity.\n")),
@@ -594,7 +523,7 @@ dxf_attrib_write
         if (dxf_attrib_get_rel_x_scale (attrib) == 0.0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () relative X-scale factor has a value of 0.0 for the %s entity with id-code: %x.\n")),
+                  (_("Warning in %s () relative X-scale factor has a value of 0.0 for the %s entity with id-code: %lx.\n")),
                   __FUNCTION__, dxf_entity_name, dxf_attrib_get_id_code (attrib));
                 fprintf (stderr,
                   (_("\tdefault relative X-scale of 1.0 applied to %s entity.\n")),
@@ -602,10 +531,10 @@ dxf_attrib_write
                 dxf_attrib_set_rel_x_scale (attrib, 1.0);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
-        if (dxf_attrib_get_id_code (attrib) != -1)
+        dxf_write_string (fp, 0, dxf_entity_name);
+        if (attrib->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", dxf_attrib_get_id_code (attrib));
+                dxf_write_hex (fp, 5, dxf_attrib_get_id_code (attrib));
         }
         /*!
          * \todo for version R14.\n
@@ -620,98 +549,98 @@ dxf_attrib_write
         if ((strcmp (dxf_attrib_get_dictionary_owner_soft (attrib), "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", dxf_attrib_get_dictionary_owner_soft (attrib));
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, dxf_attrib_get_dictionary_owner_soft (attrib));
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (dxf_attrib_get_dictionary_owner_hard (attrib), "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", dxf_attrib_get_dictionary_owner_hard (attrib));
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, dxf_attrib_get_dictionary_owner_hard (attrib));
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbEntity\n");
+                dxf_write_string (fp, 100, "AcDbEntity");
         }
         if (dxf_attrib_get_paperspace (attrib) == DXF_PAPERSPACE)
         {
-                fprintf (fp->fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_int (fp, 67, DXF_PAPERSPACE);
         }
-        fprintf (fp->fp, "  8\n%s\n", dxf_attrib_get_layer (attrib));
+        dxf_write_string (fp, 8, dxf_attrib_get_layer (attrib));
         if (strcmp (dxf_attrib_get_linetype (attrib), DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp->fp, "  6\n%s\n", dxf_attrib_get_linetype (attrib));
+                dxf_write_string (fp, 6, dxf_attrib_get_linetype (attrib));
         }
         if (dxf_attrib_get_color (attrib) != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp->fp, " 62\n%d\n", dxf_attrib_get_color (attrib));
+                dxf_write_int (fp, 62, dxf_attrib_get_color (attrib));
         }
         if (dxf_attrib_get_linetype_scale (attrib) != 1.0)
         {
-                fprintf (fp->fp, " 48\n%f\n", dxf_attrib_get_linetype_scale (attrib));
+                dxf_write_double (fp, 48, dxf_attrib_get_linetype_scale (attrib));
         }
         if (dxf_attrib_get_visibility (attrib) != 0)
         {
-                fprintf (fp->fp, " 60\n%d\n", dxf_attrib_get_visibility (attrib));
+                dxf_write_int (fp, 60, dxf_attrib_get_visibility (attrib));
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbText\n");
+                dxf_write_string (fp, 100, "AcDbText");
         }
         if ((fp->acad_version_number <= AutoCAD_11)
           && DXF_FLATLAND
           && (dxf_attrib_get_elevation (attrib) != 0.0))
         {
-                fprintf (fp->fp, " 38\n%f\n", dxf_attrib_get_elevation (attrib));
+                dxf_write_double (fp, 38, dxf_attrib_get_elevation (attrib));
         }
         if (dxf_attrib_get_thickness (attrib) != 0.0)
         {
-                fprintf (fp->fp, " 39\n%f\n", dxf_attrib_get_thickness (attrib));
+                dxf_write_double (fp, 39, dxf_attrib_get_thickness (attrib));
         }
-        fprintf (fp->fp, " 10\n%f\n", dxf_attrib_get_x0 (attrib));
-        fprintf (fp->fp, " 20\n%f\n", dxf_attrib_get_y0 (attrib));
-        fprintf (fp->fp, " 30\n%f\n", dxf_attrib_get_z0 (attrib));
-        fprintf (fp->fp, " 40\n%f\n", dxf_attrib_get_height (attrib));
-        fprintf (fp->fp, "  1\n%s\n", dxf_attrib_get_default_value (attrib));
+        dxf_write_double (fp, 10, dxf_attrib_get_x0 (attrib));
+        dxf_write_double (fp, 20, dxf_attrib_get_y0 (attrib));
+        dxf_write_double (fp, 30, dxf_attrib_get_z0 (attrib));
+        dxf_write_double (fp, 40, dxf_attrib_get_height (attrib));
+        dxf_write_string (fp, 1, dxf_attrib_get_default_value (attrib));
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbAttribute\n");
+                dxf_write_string (fp, 100, "AcDbAttribute");
         }
-        fprintf (fp->fp, "  2\n%s\n", dxf_attrib_get_tag_value (attrib));
-        fprintf (fp->fp, " 70\n%d\n", dxf_attrib_get_attr_flags (attrib));
+        dxf_write_string (fp, 2, dxf_attrib_get_tag_value (attrib));
+        dxf_write_int (fp, 70, dxf_attrib_get_attr_flags (attrib));
         if (dxf_attrib_get_field_length (attrib) != 0)
         {
-                fprintf (fp->fp, " 73\n%d\n", dxf_attrib_get_field_length (attrib));
+                dxf_write_int (fp, 73, dxf_attrib_get_field_length (attrib));
         }
         if (dxf_attrib_get_rot_angle (attrib) != 0.0)
         {
-                fprintf (fp->fp, " 50\n%f\n", dxf_attrib_get_rot_angle (attrib));
+                dxf_write_double (fp, 50, dxf_attrib_get_rot_angle (attrib));
         }
         if (dxf_attrib_get_rel_x_scale (attrib)!= 1.0)
         {
-                fprintf (fp->fp, " 41\n%f\n", dxf_attrib_get_rel_x_scale (attrib));
+                dxf_write_double (fp, 41, dxf_attrib_get_rel_x_scale (attrib));
         }
         if (dxf_attrib_get_obl_angle (attrib) != 0.0)
         {
-                fprintf (fp->fp, " 51\n%f\n", dxf_attrib_get_obl_angle (attrib));
+                dxf_write_double (fp, 51, dxf_attrib_get_obl_angle (attrib));
         }
         if (strcmp (dxf_attrib_get_text_style (attrib), "STANDARD") != 0)
         {
-                fprintf (fp->fp, "  7\n%s\n", dxf_attrib_get_text_style (attrib));
+                dxf_write_string (fp, 7, dxf_attrib_get_text_style (attrib));
         }
         if (dxf_attrib_get_text_flags (attrib) != 0)
         {
-                fprintf (fp->fp, " 71\n%d\n", dxf_attrib_get_text_flags (attrib));
+                dxf_write_int (fp, 71, dxf_attrib_get_text_flags (attrib));
         }
         if (dxf_attrib_get_hor_align (attrib) != 0)
         {
-                fprintf (fp->fp, " 72\n%d\n", dxf_attrib_get_hor_align (attrib));
+                dxf_write_int (fp, 72, dxf_attrib_get_hor_align (attrib));
         }
         if (dxf_attrib_get_vert_align (attrib) != 0)
         {
-                fprintf (fp->fp, " 74\n%d\n", dxf_attrib_get_vert_align (attrib));
+                dxf_write_int (fp, 74, dxf_attrib_get_vert_align (attrib));
         }
         if ((dxf_attrib_get_hor_align (attrib) != 0) || (dxf_attrib_get_vert_align (attrib) != 0))
         {
@@ -720,7 +649,7 @@ dxf_attrib_write
                         && (dxf_attrib_get_z0 (attrib) == dxf_attrib_get_z0 (attrib)))
                 {
                         fprintf (stderr,
-                          (_("Warning in %s () insertion point and alignment point are identical for the %s entity with id-code: %x.\n")),
+                          (_("Warning in %s () insertion point and alignment point are identical for the %s entity with id-code: %lx.\n")),
                           __FUNCTION__, dxf_entity_name, dxf_attrib_get_id_code (attrib));
                         fprintf (stderr,
                           (_("    default justification applied to %s entity\n")),
@@ -730,9 +659,9 @@ dxf_attrib_write
                 }
                 else
                 {
-                        fprintf (fp->fp, " 11\n%f\n", dxf_attrib_get_x1 (attrib));
-                        fprintf (fp->fp, " 21\n%f\n", dxf_attrib_get_y1 (attrib));
-                        fprintf (fp->fp, " 31\n%f\n", dxf_attrib_get_z1 (attrib));
+                        dxf_write_double (fp, 11, dxf_attrib_get_x1 (attrib));
+                        dxf_write_double (fp, 21, dxf_attrib_get_y1 (attrib));
+                        dxf_write_double (fp, 31, dxf_attrib_get_z1 (attrib));
                 }
         }
         if ((fp->acad_version_number >= AutoCAD_12)
@@ -740,12 +669,12 @@ dxf_attrib_write
                 && (dxf_attrib_get_extr_y0 (attrib) != 0.0)
                 && (dxf_attrib_get_extr_z0 (attrib) != 1.0))
         {
-                fprintf (fp->fp, "210\n%f\n", dxf_attrib_get_extr_x0 (attrib));
-                fprintf (fp->fp, "220\n%f\n", dxf_attrib_get_extr_y0 (attrib));
-                fprintf (fp->fp, "230\n%f\n", dxf_attrib_get_extr_z0 (attrib));
+                dxf_write_double (fp, 210, dxf_attrib_get_extr_x0 (attrib));
+                dxf_write_double (fp, 220, dxf_attrib_get_extr_y0 (attrib));
+                dxf_write_double (fp, 230, dxf_attrib_get_extr_z0 (attrib));
         }
         /* Clean up. */
-        free (dxf_entity_name);
+        dxf_free (dxf_entity_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -777,20 +706,16 @@ dxf_attrib_free
                 __FUNCTION__);
               return (EXIT_FAILURE);
         }
-        free (attrib->linetype);
-        free (attrib->layer);
-        free (attrib->default_value);
-        free (attrib->tag_value);
-        free (attrib->text_style);
+        dxf_graphic_properties_free (attrib->properties);
+        dxf_free (attrib->default_value);
+        dxf_free (attrib->tag_value);
+        dxf_free (attrib->text_style);
         dxf_binary_graphics_data_free_chain (attrib->binary_graphics_data);
-        free (attrib->dictionary_owner_soft);
-        free (attrib->material);
-        free (attrib->dictionary_owner_hard);
-        free (attrib->plot_style_name);
-        free (attrib->color_name);
+        dxf_free (attrib->dictionary_owner_soft);
+        dxf_free (attrib->dictionary_owner_hard);
         dxf_point_free (attrib->p0);
         dxf_point_free (attrib->p1);
-        free (attrib);
+        dxf_free (attrib);
         attrib = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -810,7 +735,7 @@ dxf_attrib_free_chain
                 /*!< pointer to the chain of DXF ATTRIB entities. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (attribs == NULL)
@@ -836,7 +761,7 @@ dxf_attrib_free_chain
  *
  * \return ID code.
  */
-int
+long
 dxf_attrib_get_id_code
 (
         DxfAttrib *attrib
@@ -876,7 +801,7 @@ dxf_attrib_set_id_code
 (
         DxfAttrib *attrib,
                 /*!< a pointer to a DXF \c ATTRIB entity. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -931,7 +856,7 @@ dxf_attrib_get_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        if (attrib->linetype ==  NULL)
+        if (attrib->properties->linetype ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the linetype member.\n")),
@@ -941,7 +866,7 @@ dxf_attrib_get_linetype
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (attrib->linetype));
+        return (dxf_strdup (attrib->properties->linetype));
 }
 
 
@@ -975,7 +900,12 @@ dxf_attrib_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        attrib->linetype = strdup (linetype);
+        if (dxf_graphic_properties_unshare (&attrib->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (attrib->properties->linetype);
+        attrib->properties->linetype = dxf_strdup (linetype);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1006,7 +936,7 @@ dxf_attrib_get_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        if (attrib->layer ==  NULL)
+        if (attrib->properties->layer ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the layer member.\n")),
@@ -1016,7 +946,7 @@ dxf_attrib_get_layer
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (attrib->layer));
+        return (dxf_strdup (attrib->properties->layer));
 }
 
 
@@ -1050,7 +980,12 @@ dxf_attrib_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        attrib->layer = strdup (layer);
+        if (dxf_graphic_properties_unshare (&attrib->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (attrib->properties->layer);
+        attrib->properties->layer = dxf_strdup (layer);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1084,7 +1019,7 @@ dxf_attrib_get_elevation
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (attrib->elevation);
+        return (attrib->properties->elevation);
 }
 
 
@@ -1111,7 +1046,11 @@ dxf_attrib_set_elevation
                   __FUNCTION__);
                 return (NULL);
         }
-        attrib->elevation = elevation;
+        if (dxf_graphic_properties_unshare (&attrib->properties) == NULL)
+        {
+                return (NULL);
+        }
+        attrib->properties->elevation = elevation;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1142,7 +1081,7 @@ dxf_attrib_get_thickness
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (attrib->thickness < 0.0)
+        if (attrib->properties->thickness < 0.0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found in the thickness member.\n")),
@@ -1152,7 +1091,7 @@ dxf_attrib_get_thickness
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (attrib->thickness);
+        return (attrib->properties->thickness);
 }
 
 
@@ -1186,7 +1125,11 @@ dxf_attrib_set_thickness
                   __FUNCTION__);
                 return (NULL);
         }
-        attrib->thickness = thickness;
+        if (dxf_graphic_properties_unshare (&attrib->properties) == NULL)
+        {
+                return (NULL);
+        }
+        attrib->properties->thickness = thickness;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1217,7 +1160,7 @@ dxf_attrib_get_linetype_scale
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (attrib->linetype_scale < 0.0)
+        if (attrib->properties->linetype_scale < 0.0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found in the linetype scale member.\n")),
@@ -1227,7 +1170,7 @@ dxf_attrib_get_linetype_scale
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (attrib->linetype_scale);
+        return (attrib->properties->linetype_scale);
 }
 
 
@@ -1261,7 +1204,11 @@ dxf_attrib_set_linetype_scale
                   __FUNCTION__);
                 return (NULL);
         }
-        attrib->linetype_scale = linetype_scale;
+        if (dxf_graphic_properties_unshare (&attrib->properties) == NULL)
+        {
+                return (NULL);
+        }
+        attrib->properties->linetype_scale = linetype_scale;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1292,14 +1239,14 @@ dxf_attrib_get_visibility
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (attrib->visibility < 0)
+        if (attrib->properties->visibility < 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found in the visibility member.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (attrib->visibility > 1)
+        if (attrib->properties->visibility > 1)
         {
                 fprintf (stderr,
                   (_("Error in %s () an out of range value was found in the visibility member.\n")),
@@ -1309,7 +1256,7 @@ dxf_attrib_get_visibility
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (attrib->visibility);
+        return (attrib->properties->visibility);
 }
 
 
@@ -1350,7 +1297,11 @@ dxf_attrib_set_visibility
                   __FUNCTION__);
                 return (NULL);
         }
-        attrib->visibility = visibility;
+        if (dxf_graphic_properties_unshare (&attrib->properties) == NULL)
+        {
+                return (NULL);
+        }
+        attrib->properties->visibility = visibility;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1381,7 +1332,7 @@ dxf_attrib_get_color
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (attrib->color < 0)
+        if (attrib->properties->color < 0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found in the color member.\n")),
@@ -1390,7 +1341,7 @@ dxf_attrib_get_color
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (attrib->color);
+        return (attrib->properties->color);
 }
 
 
@@ -1425,7 +1376,11 @@ dxf_attrib_set_color
                 fprintf (stderr,
                   (_("\teffectively turning this entity it's visibility off.\n")));
         }
-        attrib->color = color;
+        if (dxf_graphic_properties_unshare (&attrib->properties) == NULL)
+        {
+                return (NULL);
+        }
+        attrib->properties->color = color;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1456,13 +1411,13 @@ dxf_attrib_get_paperspace
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (attrib->paperspace < 0)
+        if (attrib->properties->paperspace < 0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found in the paperspace member.\n")),
                   __FUNCTION__);
         }
-        if (attrib->paperspace > 1)
+        if (attrib->properties->paperspace > 1)
         {
                 fprintf (stderr,
                   (_("Warning in %s () an out of range value was found in the paperspace member.\n")),
@@ -1471,7 +1426,7 @@ dxf_attrib_get_paperspace
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (attrib->paperspace);
+        return (attrib->properties->paperspace);
 }
 
 
@@ -1512,7 +1467,11 @@ dxf_attrib_set_paperspace
                   __FUNCTION__);
                 return (NULL);
         }
-        attrib->paperspace = paperspace;
+        if (dxf_graphic_properties_unshare (&attrib->properties) == NULL)
+        {
+                return (NULL);
+        }
+        attrib->properties->paperspace = paperspace;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1637,14 +1596,14 @@ dxf_attrib_get_shadow_mode
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (attrib->shadow_mode < 0)
+        if (attrib->properties->shadow_mode < 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found in the shadow_mode member.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (attrib->shadow_mode > 3)
+        if (attrib->properties->shadow_mode > 3)
         {
                 fprintf (stderr,
                   (_("Error in %s () an out of range value was found in the shadow_mode member.\n")),
@@ -1654,7 +1613,7 @@ dxf_attrib_get_shadow_mode
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (attrib->shadow_mode);
+        return (attrib->properties->shadow_mode);
 }
 
 
@@ -1698,7 +1657,11 @@ dxf_attrib_set_shadow_mode
                   __FUNCTION__);
                 return (NULL);
         }
-        attrib->shadow_mode = shadow_mode;
+        if (dxf_graphic_properties_unshare (&attrib->properties) == NULL)
+        {
+                return (NULL);
+        }
+        attrib->properties->shadow_mode = shadow_mode;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1822,7 +1785,7 @@ dxf_attrib_get_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (attrib->dictionary_owner_soft));
+        return (dxf_strdup (attrib->dictionary_owner_soft));
 }
 
 
@@ -1858,7 +1821,7 @@ dxf_attrib_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        attrib->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        attrib->dictionary_owner_soft = dxf_strdup (dictionary_owner_soft);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1892,7 +1855,7 @@ dxf_attrib_get_material
                   __FUNCTION__);
                 return (NULL);
         }
-        if (attrib->material ==  NULL)
+        if (attrib->properties->material ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the material member.\n")),
@@ -1902,7 +1865,7 @@ dxf_attrib_get_material
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (attrib->material));
+        return (dxf_strdup (attrib->properties->material));
 }
 
 
@@ -1940,7 +1903,12 @@ dxf_attrib_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        attrib->material = strdup (material);
+        if (dxf_graphic_properties_unshare (&attrib->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (attrib->properties->material);
+        attrib->properties->material = dxf_strdup (material);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1984,7 +1952,7 @@ dxf_attrib_get_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (attrib->dictionary_owner_hard));
+        return (dxf_strdup (attrib->dictionary_owner_hard));
 }
 
 
@@ -2020,7 +1988,7 @@ dxf_attrib_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        attrib->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        attrib->dictionary_owner_hard = dxf_strdup (dictionary_owner_hard);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2055,7 +2023,7 @@ dxf_attrib_get_lineweight
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (attrib->lineweight);
+        return (attrib->properties->lineweight);
 }
 
 
@@ -2085,7 +2053,11 @@ dxf_attrib_set_lineweight
                   __FUNCTION__);
                 return (NULL);
         }
-        attrib->lineweight = lineweight;
+        if (dxf_graphic_properties_unshare (&attrib->properties) == NULL)
+        {
+                return (NULL);
+        }
+        attrib->properties->lineweight = lineweight;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2117,7 +2089,7 @@ dxf_attrib_get_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        if (attrib->plot_style_name ==  NULL)
+        if (attrib->properties->plot_style_name ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the plot_style_name member.\n")),
@@ -2127,7 +2099,7 @@ dxf_attrib_get_plot_style_name
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (attrib->plot_style_name));
+        return (dxf_strdup (attrib->properties->plot_style_name));
 }
 
 
@@ -2165,7 +2137,12 @@ dxf_attrib_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        attrib->plot_style_name = strdup (plot_style_name);
+        if (dxf_graphic_properties_unshare (&attrib->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (attrib->properties->plot_style_name);
+        attrib->properties->plot_style_name = dxf_strdup (plot_style_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2200,7 +2177,7 @@ dxf_attrib_get_color_value
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (attrib->color_value);
+        return (attrib->properties->color_value);
 }
 
 
@@ -2230,7 +2207,11 @@ dxf_attrib_set_color_value
                   __FUNCTION__);
                 return (NULL);
         }
-        attrib->color_value = color_value;
+        if (dxf_graphic_properties_unshare (&attrib->properties) == NULL)
+        {
+                return (NULL);
+        }
+        attrib->properties->color_value = color_value;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2262,7 +2243,7 @@ dxf_attrib_get_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        if (attrib->color_name ==  NULL)
+        if (attrib->properties->color_name ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the color_name member.\n")),
@@ -2272,7 +2253,7 @@ dxf_attrib_get_color_name
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (attrib->color_name));
+        return (dxf_strdup (attrib->properties->color_name));
 }
 
 
@@ -2310,7 +2291,12 @@ dxf_attrib_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        attrib->color_name = strdup (color_name);
+        if (dxf_graphic_properties_unshare (&attrib->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (attrib->properties->color_name);
+        attrib->properties->color_name = dxf_strdup (color_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2345,7 +2331,7 @@ dxf_attrib_get_transparency
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (attrib->transparency);
+        return (attrib->properties->transparency);
 }
 
 
@@ -2375,7 +2361,11 @@ dxf_attrib_set_transparency
                   __FUNCTION__);
                 return (NULL);
         }
-        attrib->transparency = transparency;
+        if (dxf_graphic_properties_unshare (&attrib->properties) == NULL)
+        {
+                return (NULL);
+        }
+        attrib->properties->transparency = transparency;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2418,7 +2408,7 @@ dxf_attrib_get_default_value
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (attrib->default_value));
+        return (dxf_strdup (attrib->default_value));
 }
 
 
@@ -2453,7 +2443,7 @@ dxf_attrib_set_default_value
                   __FUNCTION__);
                 return (NULL);
         }
-        attrib->default_value = strdup (default_value);
+        attrib->default_value = dxf_strdup (default_value);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2496,7 +2486,7 @@ dxf_attrib_get_tag_value
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (attrib->tag_value));
+        return (dxf_strdup (attrib->tag_value));
 }
 
 
@@ -2531,7 +2521,7 @@ dxf_attrib_set_tag_value
                   __FUNCTION__);
                 return (NULL);
         }
-        attrib->tag_value = strdup (tag_value);
+        attrib->tag_value = dxf_strdup (tag_value);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2574,7 +2564,7 @@ dxf_attrib_get_text_style
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (attrib->text_style));
+        return (dxf_strdup (attrib->text_style));
 }
 
 
@@ -2609,7 +2599,7 @@ dxf_attrib_set_text_style
                   __FUNCTION__);
                 return (NULL);
         }
-        attrib->text_style = strdup (text_style);
+        attrib->text_style = dxf_strdup (text_style);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2629,7 +2619,7 @@ dxf_attrib_get_p0
                 /*!< a pointer to a DXF \c ATTRIB entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2668,7 +2658,7 @@ dxf_attrib_set_p0
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2707,7 +2697,7 @@ dxf_attrib_get_x0
                 /*!< a pointer to a DXF \c ATTRIB entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2750,7 +2740,7 @@ dxf_attrib_set_x0
                  * \c ATTRIB entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2789,7 +2779,7 @@ dxf_attrib_get_y0
                 /*!< a pointer to a DXF \c ATTRIB entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2832,7 +2822,7 @@ dxf_attrib_set_y0
                  * \c ATTRIB entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2871,7 +2861,7 @@ dxf_attrib_get_z0
                 /*!< a pointer to a DXF \c ATTRIB entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2914,7 +2904,7 @@ dxf_attrib_set_z0
                  * \c ATTRIB entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2952,7 +2942,7 @@ dxf_attrib_get_p1
                 /*!< a pointer to a DXF \c ATTRIB entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2991,7 +2981,7 @@ dxf_attrib_set_p1
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3030,7 +3020,7 @@ dxf_attrib_get_x1
                 /*!< a pointer to a DXF \c ATTRIB entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3072,7 +3062,7 @@ dxf_attrib_set_x1
                 /*!< the X-value \c x1 of a DXF \c ATTRIB entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3111,7 +3101,7 @@ dxf_attrib_get_y1
                 /*!< a pointer to a DXF \c ATTRIB entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3153,7 +3143,7 @@ dxf_attrib_set_y1
                 /*!< the Y-value \c y1 of a DXF \c ATTRIB entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3192,7 +3182,7 @@ dxf_attrib_get_z1
                 /*!< a pointer to a DXF \c ATTRIB entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3234,7 +3224,7 @@ dxf_attrib_set_z1
                 /*!< the Z-value \c z1 of a DXF \c ATTRIB entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -4101,7 +4091,7 @@ dxf_attrib_get_extr_x0
                 /*!< a pointer to a DXF \c ATTRIB entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -4137,7 +4127,7 @@ dxf_attrib_set_extr_x0
                  * \c ATTRIB entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -4169,7 +4159,7 @@ dxf_attrib_get_extr_y0
                 /*!< a pointer to a DXF \c ATTRIB entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -4205,7 +4195,7 @@ dxf_attrib_set_extr_y0
                  * \c ATTRIB entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -4237,7 +4227,7 @@ dxf_attrib_get_extr_z0
                 /*!< a pointer to a DXF \c ATTRIB entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -4273,7 +4263,7 @@ dxf_attrib_set_extr_z0
                  * \c ATTRIB entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -4307,7 +4297,7 @@ dxf_attrib_get_extrusion_vector_as_point
                 /*!< a pointer to a DXF \c ATTRIB entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         DxfPoint *point = NULL;
@@ -33,6 +33,8 @@
 
 
 #include "binary_entity_data.h"
+#include "arena.h"
+#include "writer.h"
 
 
 /*!
@@ -52,7 +54,7 @@ dxf_binary_entity_data_new ()
         size = sizeof (DxfBinaryEntityData);
         /* avoid malloc of 0 bytes */
         if (size == 0) size = 1;
-        if ((data = malloc (size)) == NULL)
+        if ((data = dxf_malloc (size)) == NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () could not allocate memory for a DxfBinaryEntityData struct.\n")),
@@ -102,7 +104,7 @@ dxf_binary_entity_data_init
                   __FUNCTION__);
                 return (NULL);
         }
-        dxf_binary_entity_data_set_data_line (data, strdup (""));
+        dxf_binary_entity_data_set_data_line (data, "");
         dxf_binary_entity_data_set_next (data, NULL);
 #if DEBUG
         DXF_DEBUG_END
@@ -138,7 +140,7 @@ dxf_binary_entity_data_write
                 return (EXIT_FAILURE);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "310\n%s\n", data->data_line);
+        dxf_write_string (fp, 310, data->data_line);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -179,8 +181,8 @@ dxf_binary_entity_data_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (data->data_line);
-        free (data);
+        dxf_free (data->data_line);
+        dxf_free (data);
         data = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -201,7 +203,7 @@ dxf_binary_entity_data_free_chain
                  * entity data objects. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -256,7 +258,7 @@ dxf_binary_entity_data_get_data_line
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (data->data_line));
+        return (dxf_strdup (data->data_line));
 }
 
 
@@ -290,7 +292,9 @@ dxf_binary_entity_data_set_data_line
                   __FUNCTION__);
                 return (NULL);
         }
-        data->data_line = strdup (data_line);
+        data_line = dxf_strdup (data_line);
+        dxf_free (data->data_line);
+        data->data_line = data_line;
 #if DEBUG
         DXF_DEBUG_END
 #endif
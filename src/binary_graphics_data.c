@@ -33,6 +33,8 @@
 
 
 #include "binary_graphics_data.h"
+#include "arena.h"
+#include "writer.h"
 
 
 /*!
@@ -52,7 +54,7 @@ dxf_binary_graphics_data_new ()
         size = sizeof (DxfBinaryGraphicsData);
         /* avoid malloc of 0 bytes */
         if (size == 0) size = 1;
-        if ((data = malloc (size)) == NULL)
+        if ((data = dxf_malloc (size)) == NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () could not allocate memory for a DxfBinaryGraphicsData struct.\n")),
@@ -102,7 +104,7 @@ dxf_binary_graphics_data_init
                   __FUNCTION__);
                 return (NULL);
         }
-        dxf_binary_graphics_data_set_data_line (data, strdup (""));
+        dxf_binary_graphics_data_set_data_line (data, "");
         dxf_binary_graphics_data_set_length (data, 0);
         dxf_binary_graphics_data_set_next (data, NULL);
 #if DEBUG
@@ -112,6 +114,68 @@ dxf_binary_graphics_data_init
 }
 
 
+/*!
+ * \brief Append a data line read from a group code 310 to a chain of
+ * binary graphics data objects.
+ *
+ * The empty object created by an entity's init function is filled
+ * first, each following line gets a new object linked after \c last.
+ * The chain takes ownership of \c data_line.
+ *
+ * \return a pointer to the object now holding \c data_line, or
+ * \c NULL when an error occurred.
+ */
+DxfBinaryGraphicsData *
+dxf_binary_graphics_data_append_line
+(
+        DxfBinaryGraphicsData *last,
+                /*!< a pointer to the last binary graphics data object
+                 * in the chain. */
+        char *data_line
+                /*!< a string containing the data_line, allocated by
+                 * the caller. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfBinaryGraphicsData *data = NULL;
+
+        /* Do some basic checks. */
+        if ((last == NULL) || (data_line == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                dxf_free (data_line);
+                return (NULL);
+        }
+        if ((last->data_line == NULL) || (last->data_line[0] == '\0'))
+        {
+                data = last;
+        }
+        else
+        {
+                data = dxf_binary_graphics_data_new ();
+                if (data == NULL)
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () could not allocate memory for a DxfBinaryGraphicsData struct.\n")),
+                          __FUNCTION__);
+                        dxf_free (data_line);
+                        return (NULL);
+                }
+                last->next = (struct DxfBinaryGraphicsData *) data;
+        }
+        dxf_free (data->data_line);
+        data->data_line = data_line;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (data);
+}
+
+
 /*!
  * \brief Write DXF output to fp for a binary graphics data object.
  *
@@ -139,7 +203,7 @@ dxf_binary_graphics_data_write
                 return (EXIT_FAILURE);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "310\n%s\n", data->data_line);
+        dxf_write_string (fp, 310, data->data_line);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -180,8 +244,8 @@ dxf_binary_graphics_data_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (data->data_line);
-        free (data);
+        dxf_free (data->data_line);
+        dxf_free (data);
         data = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -202,7 +266,7 @@ dxf_binary_graphics_data_free_chain
                  * objects. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -257,7 +321,7 @@ dxf_binary_graphics_data_get_data_line
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (data->data_line));
+        return (dxf_strdup (data->data_line));
 }
 
 
@@ -291,7 +355,9 @@ dxf_binary_graphics_data_set_data_line
                   __FUNCTION__);
                 return (NULL);
         }
-        data->data_line = strdup (data_line);
+        data_line = dxf_strdup (data_line);
+        dxf_free (data->data_line);
+        data->data_line = data_line;
 #if DEBUG
         DXF_DEBUG_END
 #endif
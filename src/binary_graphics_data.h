@@ -70,6 +70,12 @@ dxf_binary_graphics_data_init
 (
         DxfBinaryGraphicsData *data
 );
+DxfBinaryGraphicsData *
+dxf_binary_graphics_data_append_line
+(
+        DxfBinaryGraphicsData *last,
+        char *data_line
+);
 int
 dxf_binary_graphics_data_write
 (
@@ -39,6 +39,8 @@
 
 
 #include "block.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -109,12 +111,12 @@ dxf_block_init
                   __FUNCTION__);
                 return (NULL);
         }
-        dxf_block_set_xref_name (block, strdup (""));
-        dxf_block_set_block_name (block, strdup (""));
-        dxf_block_set_block_name_additional (block, strdup (""));
-        dxf_block_set_description (block, strdup (""));
+        dxf_block_set_xref_name (block, "");
+        dxf_block_set_block_name (block, "");
+        dxf_block_set_block_name_additional (block, "");
+        dxf_block_set_description (block, "");
         dxf_block_set_id_code (block, 0);
-        dxf_block_set_layer (block, strdup (DXF_DEFAULT_LAYER));
+        dxf_block_set_layer (block, DXF_DEFAULT_LAYER);
         dxf_block_set_p0 (block, dxf_point_new ());
         dxf_point_init ((DxfPoint *) dxf_block_get_p0 (block));
         dxf_block_set_x0 (block, 0.0);
@@ -124,7 +126,7 @@ dxf_block_init
         dxf_block_set_extr_x0 (block, 0.0);
         dxf_block_set_extr_y0 (block, 0.0);
         dxf_block_set_extr_z0 (block, 1.0);
-        dxf_block_set_dictionary_owner_soft (block, strdup (""));
+        dxf_block_set_dictionary_owner_soft (block, "");
         dxf_block_set_endblk (block, (struct DxfEndblk *) dxf_endblk_new ());
         dxf_block_set_next (block, NULL);
 #if DEBUG
@@ -163,7 +165,8 @@ dxf_block_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfPair pair;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -171,8 +174,6 @@ dxf_block_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (block == NULL)
@@ -183,135 +184,126 @@ dxf_block_read
                 block = dxf_block_new ();
                 block = dxf_block_init (block);
         }
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        fclose (fp->fp);
-                        /* Clean up. */
-                        free (temp_string);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "1") == 0)
-                {
-                        /* Now follows a string containing a external
-                         * reference name. */
-                        fscanf (fp->fp, "%s\n", block->xref_name);
-                }
-                else if (strcmp (temp_string, "2") == 0)
-                {
-                        /* Now follows a string containing a block name. */
-                        fscanf (fp->fp, "%s\n", block->block_name);
-                }
-                else if (strcmp (temp_string, "3") == 0)
-                {
-                        /* Now follows a string containing a block name. */
-                        fscanf (fp->fp, "%s\n", block->block_name_additional);
-                }
-                else if (strcmp (temp_string, "4") == 0)
-                {
-                        /* Now follows a string containing a description. */
-                        fscanf (fp->fp, "%s\n", block->description);
-                }
-                else if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        fscanf (fp->fp, "%x\n", &block->id_code);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        fscanf (fp->fp, "%s\n", block->layer);
-                }
-                else if (strcmp (temp_string, "10") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing the
-                         * X-coordinate of the center point. */
-                        fscanf (fp->fp, "%lf\n", &block->p0->x0);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else if (strcmp (temp_string, "20") == 0)
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the center point. */
-                        fscanf (fp->fp, "%lf\n", &block->p0->y0);
-                }
-                else if (strcmp (temp_string, "30") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the center point. */
-                        fscanf (fp->fp, "%lf\n", &block->p0->z0);
-                }
-                else if ((fp->acad_version_number <= AutoCAD_11)
-                        && (strcmp (temp_string, "38") == 0)
-                        && (block->p0->z0 = 0.0))
-                {
-                        /* Elevation is a pre AutoCAD R11 variable
-                         * so additional testing for the version should
-                         * probably be added.
-                         * Now follows a string containing the
-                         * elevation. */
-                        fscanf (fp->fp, "%lf\n", &block->p0->z0);
-                }
-                else if (strcmp (temp_string, "70") == 0)
-                {
-                        /* Now follows a string containing the block
-                         * type value. */
-                        fscanf (fp->fp, "%d\n", &block->block_type);
-                }
-                else if ((fp->acad_version_number >= AutoCAD_13)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if ((strcmp (temp_string, "AcDbEntity") != 0)
-                        && ((strcmp (temp_string, "AcDbBlockBegin") != 0)))
-                        {
+                        case 1:
+                                /* Now follows a string containing a external
+                                 * reference name. */
+                                free (block->xref_name);
+                                block->xref_name = dxf_pair_get_string (&pair);
+                                break;
+                        case 2:
+                                /* Now follows a string containing a block name. */
+                                free (block->block_name);
+                                block->block_name = dxf_pair_get_string (&pair);
+                                break;
+                        case 3:
+                                /* Now follows a string containing a block name. */
+                                free (block->block_name_additional);
+                                block->block_name_additional = dxf_pair_get_string (&pair);
+                                break;
+                        case 4:
+                                /* Now follows a string containing a description. */
+                                free (block->description);
+                                block->description = dxf_pair_get_string (&pair);
+                                break;
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                block->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 8:
+                                /* Now follows a string containing a layer name. */
+                                free (block->layer);
+                                block->layer = dxf_pair_get_string (&pair);
+                                break;
+                        case 10:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the center point. */
+                                block->p0->x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 20:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the center point. */
+                                block->p0->y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 30:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the center point. */
+                                block->p0->z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 38:
+                                if ((fp->acad_version_number <= AutoCAD_11)
+                                  && (block->p0->z0 = 0.0))
+                                {
+                                        /* Elevation is a pre AutoCAD R11 variable
+                                         * so additional testing for the version should
+                                         * probably be added.
+                                         * Now follows a string containing the
+                                         * elevation. */
+                                        block->p0->z0 = dxf_pair_get_double (&pair);
+                                }
+                                break;
+                        case 70:
+                                /* Now follows a string containing the block
+                                 * type value. */
+                                block->block_type = dxf_pair_get_int (&pair);
+                                break;
+                        case 100:
+                                if (fp->acad_version_number >= AutoCAD_13)
+                                {
+                                        /* Now follows a string containing the
+                                         * subclass marker value. */
+                                        dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                        if ((strcmp (temp_string, "AcDbEntity") != 0)
+                                        && ((strcmp (temp_string, "AcDbBlockBegin") != 0)))
+                                        {
+                                                fprintf (stderr,
+                                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                                  __FUNCTION__, fp->filename, fp->line_number);
+                                        }
+                                }
+                                break;
+                        case 210:
+                                /* Now follows a string containing the
+                                 * X-value of the extrusion vector. */
+                                block->extr_x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 220:
+                                /* Now follows a string containing the
+                                 * Y-value of the extrusion vector. */
+                                block->extr_y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 230:
+                                /* Now follows a string containing the
+                                 * Z-value of the extrusion vector. */
+                                block->extr_z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner object. */
+                                free (block->dictionary_owner_soft);
+                                block->dictionary_owner_soft = dxf_pair_get_string (&pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, "DXF comment: %s\n", temp_string);
+                                break;
+                        default:
                                 fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
                                   __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "210") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the extrusion vector. */
-                        fscanf (fp->fp, "%lf\n", &block->extr_x0);
-                }
-                else if (strcmp (temp_string, "220") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the extrusion vector. */
-                        fscanf (fp->fp, "%lf\n", &block->extr_y0);
-                }
-                else if (strcmp (temp_string, "230") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the extrusion vector. */
-                        fscanf (fp->fp, "%lf\n", &block->extr_z0);
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner object. */
-                        fscanf (fp->fp, "%s\n", block->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
         /* Handle omitted members and/or illegal values. */
@@ -319,13 +311,16 @@ dxf_block_read
          * \todo Resolve this quick hack for preventing an empty block
          * name string in a more elegant manner.
          */
-        if (strcmp (dxf_block_get_block_name (block), "") == 0)
+        if (strcmp (block->block_name, "") == 0)
         {
-                sprintf (block->block_name, "%i", block->id_code);
+                sprintf (temp_string, "%li", block->id_code);
+                free (block->block_name);
+                block->block_name = strdup (temp_string);
         }
-        if (strcmp (dxf_block_get_layer (block), "") == 0)
+        if (strcmp (block->layer, "") == 0)
         {
-                dxf_block_set_layer (block, strdup (DXF_DEFAULT_LAYER));
+                free (block->layer);
+                block->layer = strdup (DXF_DEFAULT_LAYER);
         }
         if (dxf_block_get_block_type (block) == 0)
         {
@@ -336,8 +331,6 @@ dxf_block_read
                   (_("\tblock type value is reset to 1.\n")));
                 dxf_block_set_block_type (block, 1);
         }
-        /* Clean up. */
-        free (temp_string);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -388,7 +381,7 @@ dxf_block_write
         if (dxf_block_get_block_name (block) == NULL)
         {
                 fprintf (stderr,
-                  (_("Error in %s () empty block name string for the %s entity with id-code: %x\n")),
+                  (_("Error in %s () empty block name string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_block_get_id_code (block));
                 fprintf (stderr,
                   (_("\t%s entity is discarded from output.\n")),
@@ -400,7 +393,7 @@ dxf_block_write
         if (dxf_block_get_endblk (block) == NULL)
         {
                 fprintf (stderr,
-                  (_("Error in %s () NULL pointer to endblk was passed or the %s entity with id-code: %x\n")),
+                  (_("Error in %s () NULL pointer to endblk was passed or the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_block_get_id_code (block));
                 fprintf (stderr,
                   (_("\t%s entity is discarded from output.\n")),
@@ -415,7 +408,7 @@ dxf_block_write
           || (dxf_block_get_block_type (block) != 32)))
         {
                 fprintf (stderr,
-                  (_("Error in %s () empty xref path name string for the %s entity with id-code: %x\n")),
+                  (_("Error in %s () empty xref path name string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_block_get_id_code (block));
                 fprintf (stderr,
                   (_("\t%s entity is discarded from output.\n")),
@@ -427,14 +420,14 @@ dxf_block_write
         if (dxf_block_get_description (block) == NULL)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () NULL pointer to description string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () NULL pointer to description string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_block_get_id_code (block));
                 dxf_block_set_description (block, strdup (""));
         }
         if (strcmp (dxf_block_get_layer (block), "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty layer string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty layer string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_block_get_id_code (block));
                 fprintf (stderr,
                   (_("\t%s entity is relocated to layer 0.\n")),
@@ -444,16 +437,16 @@ dxf_block_write
         if (dxf_block_get_dictionary_owner_soft (block) == NULL)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () NULL pointer to soft owner object string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () NULL pointer to soft owner object string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_block_get_id_code (block));
                 dxf_block_set_dictionary_owner_soft (block, strdup (""));
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_string (fp, 0, dxf_entity_name);
         if ((fp->acad_version_number >= AutoCAD_13)
-          && (dxf_block_get_id_code (block) != -1))
+          && (block->id_code != -1))
         {
-                fprintf (fp->fp, "  5\n%x\n", dxf_block_get_id_code (block));
+                dxf_write_hex (fp, 5, dxf_block_get_id_code (block));
         }
         /*!
          * \todo for version R14.\n
@@ -468,36 +461,36 @@ dxf_block_write
         if ((strcmp (dxf_block_get_dictionary_owner_soft (block), "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "330\n%s\n", dxf_block_get_dictionary_owner_soft (block));
+                dxf_write_string (fp, 330, dxf_block_get_dictionary_owner_soft (block));
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbEntity\n");
+                dxf_write_string (fp, 100, "AcDbEntity");
         }
-        fprintf (fp->fp, "  8\n%s\n", dxf_block_get_layer (block));
+        dxf_write_string (fp, 8, dxf_block_get_layer (block));
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbBlockBegin\n");
+                dxf_write_string (fp, 100, "AcDbBlockBegin");
         }
-        fprintf (fp->fp, "  2\n%s\n", dxf_block_get_block_name (block));
-        fprintf (fp->fp, " 70\n%d\n", dxf_block_get_block_type (block));
-        fprintf (fp->fp, " 10\n%f\n", dxf_block_get_x0 (block));
-        fprintf (fp->fp, " 20\n%f\n", dxf_block_get_y0 (block));
-        fprintf (fp->fp, " 30\n%f\n", dxf_block_get_z0 (block));
+        dxf_write_string (fp, 2, dxf_block_get_block_name (block));
+        dxf_write_int (fp, 70, dxf_block_get_block_type (block));
+        dxf_write_double (fp, 10, dxf_block_get_x0 (block));
+        dxf_write_double (fp, 20, dxf_block_get_y0 (block));
+        dxf_write_double (fp, 30, dxf_block_get_z0 (block));
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "  3\n%s\n", dxf_block_get_block_name (block));
+                dxf_write_string (fp, 3, dxf_block_get_block_name (block));
         }
         if ((fp->acad_version_number >= AutoCAD_13)
         && ((dxf_block_get_block_type (block) && 4)
         || (dxf_block_get_block_type (block) && 32)))
         {
-                fprintf (fp->fp, "  1\n%s\n", dxf_block_get_xref_name (block));
+                dxf_write_string (fp, 1, dxf_block_get_xref_name (block));
         }
         if ((fp->acad_version_number >= AutoCAD_2000)
         && (strcmp (dxf_block_get_description (block), "") != 0))
         {
-                fprintf (fp->fp, "  4\n%s\n", dxf_block_get_description (block));
+                dxf_write_string (fp, 4, dxf_block_get_description (block));
         }
         endblk = (DxfEndblk *) dxf_block_get_endblk (block);
         dxf_endblk_write (fp, endblk);
@@ -575,6 +568,14 @@ dxf_block_free
         free (block->description);
         free (block->layer);
         free (block->dictionary_owner_soft);
+        if (block->p0 != NULL)
+        {
+                dxf_point_free (block->p0);
+        }
+        if (block->endblk != NULL)
+        {
+                dxf_endblk_free ((DxfEndblk *) block->endblk);
+        }
         free (block);
         block = NULL;
 #if DEBUG
@@ -595,7 +596,7 @@ dxf_block_free_chain
                 /*!< pointer to the chain of DXF \c BLOCK entities. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (blocks == NULL)
@@ -607,6 +608,7 @@ dxf_block_free_chain
         while (blocks != NULL)
         {
                 struct DxfBlock *iter = blocks->next;
+                blocks->next = NULL;
                 dxf_block_free (blocks);
                 blocks = (DxfBlock *) iter;
         }
@@ -933,7 +935,7 @@ dxf_block_set_description
  *
  * \return ID code.
  */
-int
+long
 dxf_block_get_id_code
 (
         DxfBlock *block
@@ -973,7 +975,7 @@ dxf_block_set_id_code
 (
         DxfBlock *block,
                 /*!< a pointer to a DXF \c BLOCK entity. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -1092,7 +1094,7 @@ dxf_block_get_p0
                 /*!< a pointer to a DXF \c BLOCK entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -1131,7 +1133,7 @@ dxf_block_set_p0
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -1170,7 +1172,7 @@ dxf_block_get_x0
                 /*!< a pointer to a DXF \c BLOCK entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -1213,7 +1215,7 @@ dxf_block_set_x0
                  * \c ARC entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -1252,7 +1254,7 @@ dxf_block_get_y0
                 /*!< a pointer to a DXF \c BLOCK entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -1295,7 +1297,7 @@ dxf_block_set_y0
                  * \c BLOCK entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -1334,7 +1336,7 @@ dxf_block_get_z0
                 /*!< a pointer to a DXF \c BLOCK entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -1377,7 +1379,7 @@ dxf_block_set_z0
                  * \c BLOCK entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -1677,7 +1679,7 @@ dxf_block_get_extr_x0
                 /*!< a pointer to a DXF \c BLOCK entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -1713,7 +1715,7 @@ dxf_block_set_extr_x0
                  * DXF \c BLOCK entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -1745,7 +1747,7 @@ dxf_block_get_extr_y0
                 /*!< a pointer to a DXF \c BLOCK entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -1781,7 +1783,7 @@ dxf_block_set_extr_y0
                  * DXF \c BLOCK entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -1813,7 +1815,7 @@ dxf_block_get_extr_z0
                 /*!< a pointer to a DXF \c BLOCK entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -1849,7 +1851,7 @@ dxf_block_set_extr_z0
                  * DXF \c BLOCK entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -1883,7 +1885,7 @@ dxf_block_get_extrusion_vector_as_point
                 /*!< a pointer to a DXF \c BLOCK entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         DxfPoint *point = NULL;
@@ -88,7 +88,7 @@ dxf_block_struct
         char *description;
                 /*!< Block description (optional).\n
                  * Group code = 4. */
-        int id_code;
+        long id_code;
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file.\n
@@ -218,7 +218,7 @@ dxf_block_set_description
         DxfBlock *block,
         char *description
 );
-int
+long
 dxf_block_get_id_code
 (
         DxfBlock *block
@@ -227,7 +227,7 @@ DxfBlock *
 dxf_block_set_id_code
 (
         DxfBlock *block,
-        int id_code
+        long id_code
 );
 char *
 dxf_block_get_layer
@@ -42,6 +42,8 @@
 
 
 #include "block_record.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -112,10 +114,10 @@ dxf_block_record_init
                 return (NULL);
         }
         dxf_block_record_set_id_code (block_record, 0);
-        dxf_block_record_set_block_name (block_record, strdup (""));
+        dxf_block_record_set_block_name (block_record, "");
         dxf_block_record_set_flag (block_record, 0);
-        dxf_block_record_set_dictionary_owner_soft (block_record, strdup (""));
-        dxf_block_record_set_dictionary_owner_hard (block_record, strdup (""));
+        dxf_block_record_set_dictionary_owner_soft (block_record, "");
+        dxf_block_record_set_dictionary_owner_hard (block_record, "");
         dxf_block_record_set_next (block_record, NULL);
 #if DEBUG
         DXF_DEBUG_END
@@ -148,7 +150,8 @@ dxf_block_record_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfPair pair;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -156,8 +159,6 @@ dxf_block_record_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (block_record == NULL)
@@ -168,71 +169,57 @@ dxf_block_record_read
                 block_record = dxf_block_record_new ();
                 block_record = dxf_block_record_init (block_record);
         }
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        fclose (fp->fp);
-                        /* Clean up. */
-                        free (temp_string);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &block_record->id_code);
-                }
-                else if (strcmp (temp_string, "2") == 0)
-                {
-                        /* Now follows a string containing an application
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", block_record->block_name);
-                }
-                else if (strcmp (temp_string, "70") == 0)
-                {
-                        /* Now follows a string containing the
-                         * standard flag value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &block_record->flag);
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", block_record->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", block_record->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "999") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else
+                switch (pair.group_code)
                 {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                block_record->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 2:
+                                /* Now follows a string containing an application
+                                 * name. */
+                                free (block_record->block_name);
+                                block_record->block_name = dxf_pair_get_string (&pair);
+                                break;
+                        case 70:
+                                /* Now follows a string containing the
+                                 * standard flag value. */
+                                block_record->flag = dxf_pair_get_int (&pair);
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner dictionary. */
+                                free (block_record->dictionary_owner_soft);
+                                block_record->dictionary_owner_soft = dxf_pair_get_string (&pair);
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                free (block_record->dictionary_owner_hard);
+                                block_record->dictionary_owner_hard = dxf_pair_get_string (&pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, "DXF comment: %s\n", temp_string);
+                                break;
+                        default:
+                                fprintf (stderr,
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
+                                  __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
-        /* Clean up. */
-        free (temp_string);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -290,7 +277,7 @@ dxf_block_record_write
           || (strcmp (dxf_block_record_get_block_name (block_record), "") == 0))
         {
                 fprintf (stderr,
-                  (_("Error in %s empty block name string for the %s entity with id-code: %x\n")),
+                  (_("Error in %s empty block name string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_block_record_get_id_code (block_record));
                 fprintf (stderr,
                   (_("\t%s entity is discarded from output.\n")),
@@ -300,10 +287,10 @@ dxf_block_record_write
                 return (EXIT_FAILURE);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
-        if (dxf_block_record_get_id_code (block_record) != -1)
+        dxf_write_string (fp, 0, dxf_entity_name);
+        if (block_record->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", dxf_block_record_get_id_code (block_record));
+                dxf_write_hex (fp, 5, dxf_block_record_get_id_code (block_record));
         }
         /*!
          * \todo for version R14.\n
@@ -318,24 +305,24 @@ dxf_block_record_write
         if ((strcmp (dxf_block_record_get_dictionary_owner_soft (block_record), "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", dxf_block_record_get_dictionary_owner_soft (block_record));
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, dxf_block_record_get_dictionary_owner_soft (block_record));
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (dxf_block_record_get_dictionary_owner_hard (block_record), "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", dxf_block_record_get_dictionary_owner_hard (block_record));
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, dxf_block_record_get_dictionary_owner_hard (block_record));
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbSymbolTableRecord\n");
-                fprintf (fp->fp, "100\nAcDbRegAppTableRecord\n");
+                dxf_write_string (fp, 100, "AcDbSymbolTableRecord");
+                dxf_write_string (fp, 100, "AcDbRegAppTableRecord");
         }
-        fprintf (fp->fp, "  2\n%s\n", dxf_block_record_get_block_name (block_record));
-        fprintf (fp->fp, " 70\n%d\n", dxf_block_record_get_flag (block_record));
+        dxf_write_string (fp, 2, dxf_block_record_get_block_name (block_record));
+        dxf_write_int (fp, 70, dxf_block_record_get_flag (block_record));
         /* Clean up. */
         free (dxf_entity_name);
 #if DEBUG
@@ -392,7 +379,7 @@ dxf_block_record_free_chain
                 /*!< pointer to the chain of DXF \c BLOCK_RECORD entities. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (block_records == NULL)
@@ -403,7 +390,8 @@ dxf_block_record_free_chain
         }
         while (block_records != NULL)
         {
-                struct DxfBlockRecord *iter= block_records->next;
+                struct DxfBlockRecord *iter = block_records->next;
+                block_records->next = NULL;
                 dxf_block_record_free (block_records);
                 block_records = (DxfBlockRecord *) iter;
         }
@@ -418,7 +406,7 @@ dxf_block_record_free_chain
  *
  * \return ID code.
  */
-int
+long
 dxf_block_record_get_id_code
 (
         DxfBlockRecord *block_record
@@ -460,7 +448,7 @@ dxf_block_record_set_id_code
         DxfBlockRecord *block_record,
                 /*!< a pointer to a DXF \c BLOCK_RECORD symbol table
                  * entry. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -63,7 +63,7 @@ extern "C" {
 typedef struct
 dxf_block_record_struct
 {
-        int id_code;
+        long id_code;
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file.\n
@@ -130,7 +130,7 @@ dxf_block_record_free_chain
 (
         DxfBlockRecord *block_records
 );
-int
+long
 dxf_block_record_get_id_code
 (
         DxfBlockRecord *block_record
@@ -139,7 +139,7 @@ DxfBlockRecord *
 dxf_block_record_set_id_code
 (
         DxfBlockRecord *block_record,
-        int id_code
+        long id_code
 );
 char *
 dxf_block_record_get_block_name
@@ -41,6 +41,9 @@
 
 
 #include "body.h"
+#include "arena.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -60,7 +63,7 @@ dxf_body_new ()
         size = sizeof (DxfBody);
         /* avoid malloc of 0 bytes */
         if (size == 0) size = 1;
-        if ((body = malloc (size)) == NULL)
+        if ((body = dxf_malloc (size)) == NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () could not allocate memory for a DxfBody struct.\n")),
@@ -111,26 +114,12 @@ dxf_body_init
                 return (NULL);
         }
         dxf_body_set_id_code (body, 0);
-        dxf_body_set_linetype (body, strdup (DXF_DEFAULT_LINETYPE));
-        dxf_body_set_layer (body, strdup (DXF_DEFAULT_LAYER));
-        dxf_body_set_elevation (body, 0.0);
-        dxf_body_set_thickness (body, 0.0);
-        dxf_body_set_linetype_scale (body, DXF_DEFAULT_LINETYPE_SCALE);
-        dxf_body_set_visibility (body, DXF_DEFAULT_VISIBILITY);
-        dxf_body_set_color (body, DXF_COLOR_BYLAYER);
-        dxf_body_set_paperspace (body, DXF_MODELSPACE);
+        body->properties = dxf_graphic_properties_default ();
         dxf_body_set_graphics_data_size (body, 0);
-        dxf_body_set_shadow_mode (body, 0);
         dxf_body_set_binary_graphics_data (body, (DxfBinaryGraphicsData *) dxf_binary_graphics_data_init (body->binary_graphics_data));
         dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) dxf_body_get_binary_graphics_data (body));
-        dxf_body_set_dictionary_owner_soft (body, strdup (""));
-        dxf_body_set_material (body, strdup (""));
-        dxf_body_set_dictionary_owner_hard (body, strdup (""));
-        dxf_body_set_lineweight (body, 0);
-        dxf_body_set_plot_style_name (body, strdup (""));
-        dxf_body_set_color_value (body, 0);
-        dxf_body_set_color_name (body, strdup (""));
-        dxf_body_set_transparency (body, 0);
+        dxf_body_set_dictionary_owner_soft (body, "");
+        dxf_body_set_dictionary_owner_hard (body, "");
         dxf_body_set_proprietary_data (body, (DxfProprietaryData *) dxf_proprietary_data_init (body->proprietary_data));
         dxf_body_set_proprietary_data (body, (DxfProprietaryData *) dxf_proprietary_data_init (body->additional_proprietary_data));
         dxf_body_set_modeler_format_version_number (body, 1);
@@ -165,7 +154,9 @@ dxf_body_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfGraphicProperties properties;
+        DxfPair pair;
         int i;
 
         /* Do some basic checks. */
@@ -174,8 +165,6 @@ dxf_body_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (body == NULL)
@@ -193,149 +182,133 @@ dxf_body_read
                   __FUNCTION__);
         }
         i = 0;
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        dxf_graphic_properties_start (&properties, body->properties);
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        fclose (fp->fp);
-                        /* Clean up. */
-                        free (temp_string);
-                        return (NULL);
-                }
-                else if (strcmp (temp_string, "  1") == 0)
-                {
-                        /* Now follows a string containing proprietary
-                         * data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", body->proprietary_data->line);
-                        body->proprietary_data->order = i;
-                        i++;
-                        dxf_proprietary_data_init ((DxfProprietaryData *) body->proprietary_data->next);
-                        body->proprietary_data = (DxfProprietaryData *) body->proprietary_data->next;
-                }
-                else if (strcmp (temp_string, "  3") == 0)
-                {
-                        /* Now follows a string containing additional
-                         * proprietary data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", body->additional_proprietary_data->line);
-                        body->additional_proprietary_data->order = i;
-                        i++;
-                        dxf_proprietary_data_init ((DxfProprietaryData *) body->additional_proprietary_data->next);
-                        body->additional_proprietary_data = (DxfProprietaryData *) body->additional_proprietary_data->next;
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &body->id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", body->linetype);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", body->layer);
-                }
-                else if ((fp->acad_version_number <= AutoCAD_11)
-                  && DXF_FLATLAND
-                  && (strcmp (temp_string, "38") == 0))
-                {
-                        /* Now follows a string containing the
-                         * elevation. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &body->elevation);
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &body->thickness);
-                }
-                else if (strcmp (temp_string, "62") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &body->color);
-                }
-                else if (strcmp (temp_string, "67") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &body->paperspace);
-                }
-                else if ((fp->acad_version_number >= AutoCAD_13)
-                        && (strcmp (temp_string, "70") == 0))
-                {
-                        /* Now follows a string containing the modeler
-                         * format version number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &body->modeler_format_version_number);
-                }
-                else if ((fp->acad_version_number >= AutoCAD_13)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "AcDbModelerGeometry") != 0)
-                        {
-                                fprintf (stderr, "Warning in dxf_body_read () found a bad subclass marker in: %s in line: %d.\n",
-                                        fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", body->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", body->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "999") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else
+                switch (pair.group_code)
                 {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                        case 1:
+                                /* Now follows a string containing proprietary
+                                 * data. */
+                                body->proprietary_data->line = dxf_pair_get_string (&pair);
+                                body->proprietary_data->order = i;
+                                i++;
+                                dxf_proprietary_data_init ((DxfProprietaryData *) body->proprietary_data->next);
+                                body->proprietary_data = (DxfProprietaryData *) body->proprietary_data->next;
+                                break;
+                        case 3:
+                                /* Now follows a string containing additional
+                                 * proprietary data. */
+                                body->additional_proprietary_data->line = dxf_pair_get_string (&pair);
+                                body->additional_proprietary_data->order = i;
+                                i++;
+                                dxf_proprietary_data_init ((DxfProprietaryData *) body->additional_proprietary_data->next);
+                                body->additional_proprietary_data = (DxfProprietaryData *) body->additional_proprietary_data->next;
+                                break;
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                body->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 6:
+                                /* Now follows a string containing a linetype
+                                 * name. */
+                                dxf_lexer_free_string (fp, properties.linetype);
+                                properties.linetype = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 8:
+                                /* Now follows a string containing a layer name. */
+                                dxf_lexer_free_string (fp, properties.layer);
+                                properties.layer = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 38:
+                                if ((fp->acad_version_number <= AutoCAD_11)
+                                  && DXF_FLATLAND)
+                                {
+                                        /* Now follows a string containing the
+                                         * elevation. */
+                                        properties.elevation = dxf_pair_get_double (&pair);
+                                }
+                                break;
+                        case 39:
+                                /* Now follows a string containing the
+                                 * thickness. */
+                                properties.thickness = dxf_pair_get_double (&pair);
+                                break;
+                        case 62:
+                                /* Now follows a string containing the
+                                 * color value. */
+                                properties.color = dxf_pair_get_int (&pair);
+                                break;
+                        case 67:
+                                /* Now follows a string containing the
+                                 * paperspace value. */
+                                properties.paperspace = dxf_pair_get_int (&pair);
+                                break;
+                        case 70:
+                                if (fp->acad_version_number >= AutoCAD_13)
+                                {
+                                        /* Now follows a string containing the modeler
+                                         * format version number. */
+                                        body->modeler_format_version_number = dxf_pair_get_int (&pair);
+                                }
+                                break;
+                        case 100:
+                                if (fp->acad_version_number >= AutoCAD_13)
+                                {
+                                        /* Now follows a string containing the
+                                         * subclass marker value. */
+                                        dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                        if (strcmp (temp_string, "AcDbModelerGeometry") != 0)
+                                        {
+                                                fprintf (stderr, "Warning in dxf_body_read () found a bad subclass marker in: %s in line: %d.\n",
+                                                        fp->filename, fp->line_number);
+                                        }
+                                }
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, body->dictionary_owner_soft);
+                                body->dictionary_owner_soft = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, body->dictionary_owner_hard);
+                                body->dictionary_owner_hard = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, "DXF comment: %s\n", temp_string);
+                                break;
+                        default:
+                                fprintf (stderr,
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
+                                  __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
         /* Handle omitted members and/or illegal values. */
-        if (strcmp (body->linetype, "") == 0)
+        if ((properties.linetype != NULL)
+          && (strcmp (properties.linetype, "") == 0))
         {
-                body->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_lexer_free_string (fp, properties.linetype);
+                properties.linetype = dxf_strdup (DXF_DEFAULT_LINETYPE);
         }
-        if (strcmp (body->layer, "") == 0)
+        if ((properties.layer != NULL)
+          && (strcmp (properties.layer, "") == 0))
         {
-                body->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_lexer_free_string (fp, properties.layer);
+                properties.layer = dxf_strdup (DXF_DEFAULT_LAYER);
         }
         if (body->modeler_format_version_number == 0)
         {
@@ -346,8 +319,8 @@ dxf_body_read
                   (_("\tmodeler format version number is reset to 1.\n")));
                 body->modeler_format_version_number = 1;
         }
-        /* Clean up. */
-        free (temp_string);
+        /* Entities with equal properties share a record. */
+        dxf_graphic_properties_finish (fp, &body->properties, &properties);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -373,7 +346,7 @@ dxf_body_write
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *dxf_entity_name = strdup ("BODY");
+        char *dxf_entity_name = dxf_strdup ("BODY");
         DxfProprietaryData *iter = NULL;
         DxfProprietaryData *additional_iter = NULL;
         int i;
@@ -385,7 +358,7 @@ dxf_body_write
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (body == NULL)
@@ -394,41 +367,41 @@ dxf_body_write
                   (_("Error in %s () a NULL pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (fp->acad_version_number < AutoCAD_13)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () illegal DXF version for this %s entity with id-code: %x.\n")),
+                  (_("Warning in %s () illegal DXF version for this %s entity with id-code: %lx.\n")),
                   __FUNCTION__, dxf_entity_name, dxf_body_get_id_code (body));
         }
         if (strcmp (dxf_body_get_linetype (body), "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_body_get_id_code (body));
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                dxf_body_set_linetype (body, strdup (DXF_DEFAULT_LAYER));
+                dxf_body_set_linetype (body, DXF_DEFAULT_LAYER);
         }
         if (strcmp (dxf_body_get_layer (body), "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty layer string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty layer string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_body_get_id_code (body));
                 fprintf (stderr,
                   (_("\t%s entity is relocated to layer 0")),
                   dxf_entity_name);
-                dxf_body_set_layer (body, strdup (DXF_DEFAULT_LAYER));
+                dxf_body_set_layer (body, DXF_DEFAULT_LAYER);
         }
         /* Start writing output. */
         i = 1;
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
-        if (dxf_body_get_id_code (body) != -1)
+        dxf_write_string (fp, 0, dxf_entity_name);
+        if (body->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", dxf_body_get_id_code (body));
+                dxf_write_hex (fp, 5, dxf_body_get_id_code (body));
         }
         /*!
          * \todo for version R14.\n
@@ -443,59 +416,59 @@ dxf_body_write
         if ((strcmp (dxf_body_get_dictionary_owner_soft (body), "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", dxf_body_get_dictionary_owner_soft (body));
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, dxf_body_get_dictionary_owner_soft (body));
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (dxf_body_get_dictionary_owner_hard (body), "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", dxf_body_get_dictionary_owner_hard (body));
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, dxf_body_get_dictionary_owner_hard (body));
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbEntity\n");
+                dxf_write_string (fp, 100, "AcDbEntity");
         }
         if (dxf_body_get_paperspace (body) == DXF_PAPERSPACE)
         {
-                fprintf (fp->fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_int (fp, 67, DXF_PAPERSPACE);
         }
-        fprintf (fp->fp, "  8\n%s\n", dxf_body_get_layer (body));
+        dxf_write_string (fp, 8, dxf_body_get_layer (body));
         if (strcmp (dxf_body_get_linetype (body), DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp->fp, "  6\n%s\n", dxf_body_get_linetype (body));
+                dxf_write_string (fp, 6, dxf_body_get_linetype (body));
         }
         if ((fp->acad_version_number <= AutoCAD_11)
           && DXF_FLATLAND
           && (dxf_body_get_elevation (body) != 0.0))
         {
-                fprintf (fp->fp, " 38\n%f\n", dxf_body_get_elevation (body));
+                dxf_write_double (fp, 38, dxf_body_get_elevation (body));
         }
         if (dxf_body_get_thickness (body) != 0.0)
         {
-                fprintf (fp->fp, " 39\n%f\n", dxf_body_get_thickness (body));
+                dxf_write_double (fp, 39, dxf_body_get_thickness (body));
         }
         if (dxf_body_get_linetype_scale (body) != 1.0)
         {
-                fprintf (fp->fp, " 48\n%f\n", dxf_body_get_linetype_scale (body));
+                dxf_write_double (fp, 48, dxf_body_get_linetype_scale (body));
         }
         if (dxf_body_get_visibility (body) != 0)
         {
-                fprintf (fp->fp, " 60\n%d\n", dxf_body_get_visibility (body));
+                dxf_write_int (fp, 60, dxf_body_get_visibility (body));
         }
         if (dxf_body_get_color (body) != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp->fp, " 62\n%d\n", dxf_body_get_color (body));
+                dxf_write_int (fp, 62, dxf_body_get_color (body));
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbModelerGeometry\n");
+                dxf_write_string (fp, 100, "AcDbModelerGeometry");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, " 70\n%d\n", dxf_body_get_modeler_format_version_number (body));
+                dxf_write_int (fp, 70, dxf_body_get_modeler_format_version_number (body));
         }
         iter = (DxfProprietaryData *) dxf_body_get_proprietary_data (body);
         additional_iter = (DxfProprietaryData *) dxf_body_get_additional_proprietary_data (body);
@@ -503,19 +476,19 @@ dxf_body_write
         {
                 if (iter->order == i)
                 {
-                        fprintf (fp->fp, "  1\n%s\n", dxf_proprietary_data_get_line (iter));
+                        dxf_write_string (fp, 1, dxf_proprietary_data_get_line (iter));
                         iter = (DxfProprietaryData *) dxf_proprietary_data_get_next (iter);
                         i++;
                 }
                 if (additional_iter->order == i)
                 {
-                        fprintf (fp->fp, "  3\n%s\n", dxf_proprietary_data_get_line (additional_iter));
+                        dxf_write_string (fp, 3, dxf_proprietary_data_get_line (additional_iter));
                         additional_iter = (DxfProprietaryData *) dxf_proprietary_data_get_next (additional_iter);
                         i++;
                 }
         }
         /* Clean up. */
-        free (dxf_entity_name);
+        dxf_free (dxf_entity_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -549,13 +522,12 @@ dxf_body_free
                 __FUNCTION__);
               return (EXIT_FAILURE);
         }
-        free (body->linetype);
-        free (body->layer);
+        dxf_graphic_properties_free (body->properties);
         dxf_proprietary_data_free_chain (body->proprietary_data);
         dxf_proprietary_data_free_chain (body->additional_proprietary_data);
-        free (body->dictionary_owner_soft);
-        free (body->dictionary_owner_hard);
-        free (body);
+        dxf_free (body->dictionary_owner_soft);
+        dxf_free (body->dictionary_owner_hard);
+        dxf_free (body);
         body = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -575,7 +547,7 @@ dxf_body_free_chain
                 /*!< pointer to the chain of DXF \c BODY entities. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (bodies == NULL)
@@ -601,7 +573,7 @@ dxf_body_free_chain
  *
  * \return ID code.
  */
-int
+long
 dxf_body_get_id_code
 (
         DxfBody *body
@@ -641,7 +613,7 @@ dxf_body_set_id_code
 (
         DxfBody *body,
                 /*!< a pointer to a DXF \c BODY entity. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -696,7 +668,7 @@ dxf_body_get_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        if (body->linetype ==  NULL)
+        if (body->properties->linetype ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the linetype member.\n")),
@@ -706,7 +678,7 @@ dxf_body_get_linetype
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (body->linetype));
+        return (dxf_strdup (body->properties->linetype));
 }
 
 
@@ -740,7 +712,12 @@ dxf_body_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        body->linetype = strdup (linetype);
+        if (dxf_graphic_properties_unshare (&body->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (body->properties->linetype);
+        body->properties->linetype = dxf_strdup (linetype);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -771,7 +748,7 @@ dxf_body_get_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        if (body->layer ==  NULL)
+        if (body->properties->layer ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the layer member.\n")),
@@ -781,7 +758,7 @@ dxf_body_get_layer
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (body->layer));
+        return (dxf_strdup (body->properties->layer));
 }
 
 
@@ -815,7 +792,12 @@ dxf_body_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        body->layer = strdup (layer);
+        if (dxf_graphic_properties_unshare (&body->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (body->properties->layer);
+        body->properties->layer = dxf_strdup (layer);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -849,7 +831,7 @@ dxf_body_get_elevation
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (body->elevation);
+        return (body->properties->elevation);
 }
 
 
@@ -876,7 +858,11 @@ dxf_body_set_elevation
                   __FUNCTION__);
                 return (NULL);
         }
-        body->elevation = elevation;
+        if (dxf_graphic_properties_unshare (&body->properties) == NULL)
+        {
+                return (NULL);
+        }
+        body->properties->elevation = elevation;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -907,7 +893,7 @@ dxf_body_get_thickness
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (body->thickness < 0.0)
+        if (body->properties->thickness < 0.0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found in the thickness member.\n")),
@@ -917,7 +903,7 @@ dxf_body_get_thickness
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (body->thickness);
+        return (body->properties->thickness);
 }
 
 
@@ -951,7 +937,11 @@ dxf_body_set_thickness
                   __FUNCTION__);
                 return (NULL);
         }
-        body->thickness = thickness;
+        if (dxf_graphic_properties_unshare (&body->properties) == NULL)
+        {
+                return (NULL);
+        }
+        body->properties->thickness = thickness;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -982,7 +972,7 @@ dxf_body_get_linetype_scale
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (body->linetype_scale < 0.0)
+        if (body->properties->linetype_scale < 0.0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found in the linetype scale member.\n")),
@@ -992,7 +982,7 @@ dxf_body_get_linetype_scale
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (body->linetype_scale);
+        return (body->properties->linetype_scale);
 }
 
 
@@ -1026,7 +1016,11 @@ dxf_body_set_linetype_scale
                   __FUNCTION__);
                 return (NULL);
         }
-        body->linetype_scale = linetype_scale;
+        if (dxf_graphic_properties_unshare (&body->properties) == NULL)
+        {
+                return (NULL);
+        }
+        body->properties->linetype_scale = linetype_scale;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1057,14 +1051,14 @@ dxf_body_get_visibility
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (body->visibility < 0)
+        if (body->properties->visibility < 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found in the visibility member.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (body->visibility > 1)
+        if (body->properties->visibility > 1)
         {
                 fprintf (stderr,
                   (_("Error in %s () an out of range value was found in the visibility member.\n")),
@@ -1074,7 +1068,7 @@ dxf_body_get_visibility
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (body->visibility);
+        return (body->properties->visibility);
 }
 
 
@@ -1115,7 +1109,11 @@ dxf_body_set_visibility
                   __FUNCTION__);
                 return (NULL);
         }
-        body->visibility = visibility;
+        if (dxf_graphic_properties_unshare (&body->properties) == NULL)
+        {
+                return (NULL);
+        }
+        body->properties->visibility = visibility;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1146,7 +1144,7 @@ dxf_body_get_color
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (body->color < 0)
+        if (body->properties->color < 0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found in the color member.\n")),
@@ -1155,7 +1153,7 @@ dxf_body_get_color
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (body->color);
+        return (body->properties->color);
 }
 
 
@@ -1190,7 +1188,11 @@ dxf_body_set_color
                 fprintf (stderr,
                   (_("\teffectively turning this entity it's visibility off.\n")));
         }
-        body->color = color;
+        if (dxf_graphic_properties_unshare (&body->properties) == NULL)
+        {
+                return (NULL);
+        }
+        body->properties->color = color;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1221,13 +1223,13 @@ dxf_body_get_paperspace
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (body->paperspace < 0)
+        if (body->properties->paperspace < 0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found in the paperspace member.\n")),
                   __FUNCTION__);
         }
-        if (body->paperspace > 1)
+        if (body->properties->paperspace > 1)
         {
                 fprintf (stderr,
                   (_("Warning in %s () an out of range value was found in the paperspace member.\n")),
@@ -1236,7 +1238,7 @@ dxf_body_get_paperspace
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (body->paperspace);
+        return (body->properties->paperspace);
 }
 
 
@@ -1277,7 +1279,11 @@ dxf_body_set_paperspace
                   __FUNCTION__);
                 return (NULL);
         }
-        body->paperspace = paperspace;
+        if (dxf_graphic_properties_unshare (&body->properties) == NULL)
+        {
+                return (NULL);
+        }
+        body->properties->paperspace = paperspace;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1401,14 +1407,14 @@ dxf_body_get_shadow_mode
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (body->shadow_mode < 0)
+        if (body->properties->shadow_mode < 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found in the shadow_mode member.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (body->shadow_mode > 3)
+        if (body->properties->shadow_mode > 3)
         {
                 fprintf (stderr,
                   (_("Error in %s () an out of range value was found in the shadow_mode member.\n")),
@@ -1418,7 +1424,7 @@ dxf_body_get_shadow_mode
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (body->shadow_mode);
+        return (body->properties->shadow_mode);
 }
 
 
@@ -1462,7 +1468,11 @@ dxf_body_set_shadow_mode
                   __FUNCTION__);
                 return (NULL);
         }
-        body->shadow_mode = shadow_mode;
+        if (dxf_graphic_properties_unshare (&body->properties) == NULL)
+        {
+                return (NULL);
+        }
+        body->properties->shadow_mode = shadow_mode;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1589,7 +1599,7 @@ dxf_body_get_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (body->dictionary_owner_soft));
+        return (dxf_strdup (body->dictionary_owner_soft));
 }
 
 
@@ -1625,7 +1635,7 @@ dxf_body_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        body->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        body->dictionary_owner_soft = dxf_strdup (dictionary_owner_soft);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1660,7 +1670,7 @@ dxf_body_get_material
                   __FUNCTION__);
                 return (NULL);
         }
-        if (body->material ==  NULL)
+        if (body->properties->material ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the material member.\n")),
@@ -1670,7 +1680,7 @@ dxf_body_get_material
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (body->material));
+        return (dxf_strdup (body->properties->material));
 }
 
 
@@ -1708,7 +1718,12 @@ dxf_body_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        body->material = strdup (material);
+        if (dxf_graphic_properties_unshare (&body->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (body->properties->material);
+        body->properties->material = dxf_strdup (material);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1752,7 +1767,7 @@ dxf_body_get_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (body->dictionary_owner_hard));
+        return (dxf_strdup (body->dictionary_owner_hard));
 }
 
 
@@ -1788,7 +1803,7 @@ dxf_body_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        body->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        body->dictionary_owner_hard = dxf_strdup (dictionary_owner_hard);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1823,7 +1838,7 @@ dxf_body_get_lineweight
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (body->lineweight);
+        return (body->properties->lineweight);
 }
 
 
@@ -1853,7 +1868,11 @@ dxf_body_set_lineweight
                   __FUNCTION__);
                 return (NULL);
         }
-        body->lineweight = lineweight;
+        if (dxf_graphic_properties_unshare (&body->properties) == NULL)
+        {
+                return (NULL);
+        }
+        body->properties->lineweight = lineweight;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1885,7 +1904,7 @@ dxf_body_get_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        if (body->plot_style_name ==  NULL)
+        if (body->properties->plot_style_name ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the plot_style_name member.\n")),
@@ -1895,7 +1914,7 @@ dxf_body_get_plot_style_name
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (body->plot_style_name));
+        return (dxf_strdup (body->properties->plot_style_name));
 }
 
 
@@ -1933,7 +1952,12 @@ dxf_body_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        body->plot_style_name = strdup (plot_style_name);
+        if (dxf_graphic_properties_unshare (&body->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (body->properties->plot_style_name);
+        body->properties->plot_style_name = dxf_strdup (plot_style_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1968,7 +1992,7 @@ dxf_body_get_color_value
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (body->color_value);
+        return (body->properties->color_value);
 }
 
 
@@ -1998,7 +2022,11 @@ dxf_body_set_color_value
                   __FUNCTION__);
                 return (NULL);
         }
-        body->color_value = color_value;
+        if (dxf_graphic_properties_unshare (&body->properties) == NULL)
+        {
+                return (NULL);
+        }
+        body->properties->color_value = color_value;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2030,7 +2058,7 @@ dxf_body_get_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        if (body->color_name ==  NULL)
+        if (body->properties->color_name ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the color_name member.\n")),
@@ -2040,7 +2068,7 @@ dxf_body_get_color_name
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (body->color_name));
+        return (dxf_strdup (body->properties->color_name));
 }
 
 
@@ -2078,7 +2106,12 @@ dxf_body_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        body->color_name = strdup (color_name);
+        if (dxf_graphic_properties_unshare (&body->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (body->properties->color_name);
+        body->properties->color_name = dxf_strdup (color_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2113,7 +2146,7 @@ dxf_body_get_transparency
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (body->transparency);
+        return (body->properties->transparency);
 }
 
 
@@ -2143,7 +2176,11 @@ dxf_body_set_transparency
                   __FUNCTION__);
                 return (NULL);
         }
-        body->transparency = transparency;
+        if (dxf_graphic_properties_unshare (&body->properties) == NULL)
+        {
+                return (NULL);
+        }
+        body->properties->transparency = transparency;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -39,6 +39,9 @@
 
 
 #include "circle.h"
+#include "arena.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -58,7 +61,7 @@ dxf_circle_new ()
         size = sizeof (DxfCircle);
         /* avoid malloc of 0 bytes */
         if (size == 0) size = 1;
-        if ((circle = malloc (size)) == NULL)
+        if ((circle = dxf_malloc (size)) == NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () could not allocate memory for a DxfCircle struct.\n")),
@@ -109,26 +112,12 @@ dxf_circle_init
               return (NULL);
         }
         dxf_circle_set_id_code (circle, 0);
-        dxf_circle_set_linetype (circle, strdup (DXF_DEFAULT_LINETYPE));
-        dxf_circle_set_layer (circle, strdup (DXF_DEFAULT_LAYER));
-        dxf_circle_set_elevation (circle, 0.0);
-        dxf_circle_set_thickness (circle, 0.0);
-        dxf_circle_set_linetype_scale (circle, DXF_DEFAULT_LINETYPE_SCALE);
-        dxf_circle_set_visibility (circle, DXF_DEFAULT_VISIBILITY);
-        dxf_circle_set_color (circle, DXF_COLOR_BYLAYER);
-        dxf_circle_set_paperspace (circle, DXF_MODELSPACE);
+        circle->properties = dxf_graphic_properties_default ();
         dxf_circle_set_graphics_data_size (circle, 0);
-        dxf_circle_set_shadow_mode (circle, 0);
         dxf_circle_set_binary_graphics_data (circle, (DxfBinaryGraphicsData *) dxf_binary_graphics_data_new ());
         dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) dxf_circle_get_binary_graphics_data (circle));
-        dxf_circle_set_dictionary_owner_soft (circle, strdup (""));
-        dxf_circle_set_material (circle, strdup (""));
-        dxf_circle_set_dictionary_owner_hard (circle, strdup (""));
-        dxf_circle_set_lineweight (circle, 0);
-        dxf_circle_set_plot_style_name (circle, strdup (""));
-        dxf_circle_set_color_value (circle, 0);
-        dxf_circle_set_color_name (circle, strdup (""));
-        dxf_circle_set_transparency (circle, 0);
+        dxf_circle_set_dictionary_owner_soft (circle, "");
+        dxf_circle_set_dictionary_owner_hard (circle, "");
         dxf_circle_set_p0 (circle, dxf_point_new ());
         dxf_point_init ((DxfPoint *) dxf_circle_get_p0 (circle));
         dxf_circle_set_radius (circle, 0.0);
@@ -166,7 +155,9 @@ dxf_circle_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfGraphicProperties properties;
+        DxfPair pair;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -174,8 +165,6 @@ dxf_circle_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (circle == NULL)
@@ -186,187 +175,157 @@ dxf_circle_read
                 circle = dxf_circle_new ();
                 circle = dxf_circle_init (circle);
         }
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        dxf_graphic_properties_start (&properties, circle->properties);
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        fclose (fp->fp);
-                        /* Clean up. */
-                        free (temp_string);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &circle->id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", circle->linetype);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", circle->layer);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the center point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &circle->p0->x0);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the center point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &circle->p0->y0);
-                }
-                else if (strcmp (temp_string, "30") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the center point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &circle->p0->z0);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else if ((fp->acad_version_number <= AutoCAD_11)
-                        && (strcmp (temp_string, "38") == 0)
-                        && (circle->elevation != 0.0))
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing the
-                         * elevation. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &circle->elevation);
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &circle->thickness);
-                }
-                else if (strcmp (temp_string, "40") == 0)
-                {
-                        /* Now follows a string containing the
-                         * radius. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &circle->radius);
-                }
-                else if (strcmp (temp_string, "48") == 0)
-                {
-                        /* Now follows a string containing the linetype
-                         * scale. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &circle->linetype_scale);
-                }
-                else if (strcmp (temp_string, "60") == 0)
-                {
-                        /* Now follows a string containing the
-                         * visibility value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &circle->visibility);
-                }
-                else if (strcmp (temp_string, "62") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &circle->color);
-                }
-                else if (strcmp (temp_string, "67") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &circle->paperspace);
-                }
-                else if ((fp->acad_version_number >= AutoCAD_13)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if ((strcmp (temp_string, "AcDbEntity") != 0)
-                        && (strcmp (temp_string, "AcDbCircle") != 0))
-                        {
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                circle->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 6:
+                                /* Now follows a string containing a linetype
+                                 * name. */
+                                dxf_lexer_free_string (fp, properties.linetype);
+                                properties.linetype = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 8:
+                                /* Now follows a string containing a layer name. */
+                                dxf_lexer_free_string (fp, properties.layer);
+                                properties.layer = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 10:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the center point. */
+                                circle->p0->x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 20:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the center point. */
+                                circle->p0->y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 30:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the center point. */
+                                circle->p0->z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 38:
+                                if ((fp->acad_version_number <= AutoCAD_11)
+                                  && (properties.elevation != 0.0))
+                                {
+                                        /* Now follows a string containing the
+                                         * elevation. */
+                                        properties.elevation = dxf_pair_get_double (&pair);
+                                }
+                                break;
+                        case 39:
+                                /* Now follows a string containing the
+                                 * thickness. */
+                                properties.thickness = dxf_pair_get_double (&pair);
+                                break;
+                        case 40:
+                                /* Now follows a string containing the
+                                 * radius. */
+                                circle->radius = dxf_pair_get_double (&pair);
+                                break;
+                        case 48:
+                                /* Now follows a string containing the linetype
+                                 * scale. */
+                                properties.linetype_scale = dxf_pair_get_double (&pair);
+                                break;
+                        case 60:
+                                /* Now follows a string containing the
+                                 * visibility value. */
+                                properties.visibility = dxf_pair_get_int (&pair);
+                                break;
+                        case 62:
+                                /* Now follows a string containing the
+                                 * color value. */
+                                properties.color = dxf_pair_get_int (&pair);
+                                break;
+                        case 67:
+                                /* Now follows a string containing the
+                                 * paperspace value. */
+                                properties.paperspace = dxf_pair_get_int (&pair);
+                                break;
+                        case 100:
+                                if (fp->acad_version_number >= AutoCAD_13)
+                                {
+                                        /* Now follows a string containing the
+                                         * subclass marker value. */
+                                        dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                        if ((strcmp (temp_string, "AcDbEntity") != 0)
+                                        && (strcmp (temp_string, "AcDbCircle") != 0))
+                                        {
+                                                fprintf (stderr,
+                                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                                  __FUNCTION__, fp->filename, fp->line_number);
+                                        }
+                                }
+                                break;
+                        case 210:
+                                /* Now follows a string containing the
+                                 * X-value of the extrusion vector. */
+                                circle->extr_x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 220:
+                                /* Now follows a string containing the
+                                 * Y-value of the extrusion vector. */
+                                circle->extr_y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 230:
+                                /* Now follows a string containing the
+                                 * Z-value of the extrusion vector. */
+                                circle->extr_z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, circle->dictionary_owner_soft);
+                                circle->dictionary_owner_soft = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, circle->dictionary_owner_hard);
+                                circle->dictionary_owner_hard = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, "DXF comment: %s\n", temp_string);
+                                break;
+                        default:
                                 fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
                                   __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "210") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &circle->extr_x0);
-                }
-                else if (strcmp (temp_string, "220") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &circle->extr_y0);
-                }
-                else if (strcmp (temp_string, "230") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &circle->extr_z0);
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", circle->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", circle->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
         /* Handle omitted members and/or illegal values. */
-        if (strcmp (dxf_circle_get_linetype (circle), "") == 0)
+        if ((properties.linetype != NULL)
+          && (strcmp (properties.linetype, "") == 0))
         {
-                dxf_circle_set_linetype (circle, strdup (DXF_DEFAULT_LINETYPE));
+                dxf_lexer_free_string (fp, properties.linetype);
+                properties.linetype = dxf_strdup (DXF_DEFAULT_LINETYPE);
         }
-        if (strcmp (dxf_circle_get_layer (circle), "") == 0)
+        if ((properties.layer != NULL)
+          && (strcmp (properties.layer, "") == 0))
         {
-                dxf_circle_set_layer (circle, strdup (DXF_DEFAULT_LAYER));
+                dxf_lexer_free_string (fp, properties.layer);
+                properties.layer = dxf_strdup (DXF_DEFAULT_LAYER);
         }
-        /* Clean up. */
-        free (temp_string);
+        /* Entities with equal properties share a record. */
+        dxf_graphic_properties_finish (fp, &circle->properties, &properties);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -389,7 +348,7 @@ dxf_circle_write
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *dxf_entity_name = strdup ("CIRCLE");
+        char *dxf_entity_name = dxf_strdup ("CIRCLE");
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -398,7 +357,7 @@ dxf_circle_write
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (circle == NULL)
@@ -407,43 +366,43 @@ dxf_circle_write
                   (_("Error in %s () a NULL pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (dxf_circle_get_radius (circle) == 0.0)
         {
                 fprintf (stderr,
-                  (_("Error in %s () radius value equals 0.0 for the %s entity with id-code: %x\n")),
+                  (_("Error in %s () radius value equals 0.0 for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_circle_get_id_code (circle));
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (strcmp (dxf_circle_get_linetype (circle), "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_circle_get_id_code (circle));
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                dxf_circle_set_linetype (circle, strdup (DXF_DEFAULT_LINETYPE));
+                dxf_circle_set_linetype (circle, DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (dxf_circle_get_layer (circle), "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty layer string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty layer string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_circle_get_id_code (circle));
                 fprintf (stderr,
                   (_("\t%s entity is relocated to layer 0")),
                   dxf_entity_name );
-                dxf_circle_set_layer (circle, strdup (DXF_DEFAULT_LAYER));
+                dxf_circle_set_layer (circle, DXF_DEFAULT_LAYER);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
-        if (dxf_circle_get_id_code (circle) != -1)
+        dxf_write_string (fp, 0, dxf_entity_name);
+        if (circle->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", dxf_circle_get_id_code (circle));
+                dxf_write_hex (fp, 5, dxf_circle_get_id_code (circle));
         }
         /*!
          * \todo for version R14.\n
@@ -458,71 +417,71 @@ dxf_circle_write
         if ((strcmp (dxf_circle_get_dictionary_owner_soft (circle), "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", dxf_circle_get_dictionary_owner_soft (circle));
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, dxf_circle_get_dictionary_owner_soft (circle));
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (dxf_circle_get_dictionary_owner_hard (circle), "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", dxf_circle_get_dictionary_owner_hard (circle));
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, dxf_circle_get_dictionary_owner_hard (circle));
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbEntity\n");
+                dxf_write_string (fp, 100, "AcDbEntity");
         }
         if (dxf_circle_get_paperspace (circle) == DXF_PAPERSPACE)
         {
-                fprintf (fp->fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_int (fp, 67, DXF_PAPERSPACE);
         }
-        fprintf (fp->fp, "  8\n%s\n", dxf_circle_get_layer (circle));
+        dxf_write_string (fp, 8, dxf_circle_get_layer (circle));
         if (strcmp (dxf_circle_get_linetype (circle), DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp->fp, "  6\n%s\n", dxf_circle_get_linetype (circle));
+                dxf_write_string (fp, 6, dxf_circle_get_linetype (circle));
         }
         if (dxf_circle_get_color (circle) != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp->fp, " 62\n%d\n", dxf_circle_get_color (circle));
+                dxf_write_int (fp, 62, dxf_circle_get_color (circle));
         }
         if (dxf_circle_get_linetype_scale (circle) != 1.0)
         {
-                fprintf (fp->fp, " 48\n%f\n", dxf_circle_get_linetype_scale (circle));
+                dxf_write_double (fp, 48, dxf_circle_get_linetype_scale (circle));
         }
         if (dxf_circle_get_visibility (circle) != 0)
         {
-                fprintf (fp->fp, " 60\n%d\n", dxf_circle_get_visibility (circle));
+                dxf_write_int (fp, 60, dxf_circle_get_visibility (circle));
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbCircle\n");
+                dxf_write_string (fp, 100, "AcDbCircle");
         }
         if ((fp->acad_version_number <= AutoCAD_11)
           && DXF_FLATLAND
           && (dxf_circle_get_elevation (circle) != 0.0))
         {
-                fprintf (fp->fp, " 38\n%f\n", dxf_circle_get_elevation (circle));
+                dxf_write_double (fp, 38, dxf_circle_get_elevation (circle));
         }
         if (dxf_circle_get_thickness (circle) != 0.0)
         {
-                fprintf (fp->fp, " 39\n%f\n", dxf_circle_get_thickness (circle));
+                dxf_write_double (fp, 39, dxf_circle_get_thickness (circle));
         }
-        fprintf (fp->fp, " 10\n%f\n", dxf_circle_get_x0 (circle));
-        fprintf (fp->fp, " 20\n%f\n", dxf_circle_get_y0 (circle));
-        fprintf (fp->fp, " 30\n%f\n", dxf_circle_get_z0 (circle));
-        fprintf (fp->fp, " 40\n%f\n", dxf_circle_get_radius (circle));
+        dxf_write_double (fp, 10, dxf_circle_get_x0 (circle));
+        dxf_write_double (fp, 20, dxf_circle_get_y0 (circle));
+        dxf_write_double (fp, 30, dxf_circle_get_z0 (circle));
+        dxf_write_double (fp, 40, dxf_circle_get_radius (circle));
         if ((fp->acad_version_number >= AutoCAD_12)
                 && (circle->extr_x0 != 0.0)
                 && (circle->extr_y0 != 0.0)
                 && (circle->extr_z0 != 1.0))
         {
-                fprintf (fp->fp, "210\n%f\n", circle->extr_x0);
-                fprintf (fp->fp, "220\n%f\n", circle->extr_y0);
-                fprintf (fp->fp, "230\n%f\n", circle->extr_z0);
+                dxf_write_double (fp, 210, circle->extr_x0);
+                dxf_write_double (fp, 220, circle->extr_y0);
+                dxf_write_double (fp, 230, circle->extr_z0);
         }
         /* Clean up. */
-        free (dxf_entity_name);
+        dxf_free (dxf_entity_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -555,11 +514,12 @@ dxf_circle_free
                 __FUNCTION__);
               return (EXIT_FAILURE);
         }
-        free (circle->linetype);
-        free (circle->layer);
-        free (circle->dictionary_owner_soft);
-        free (circle->dictionary_owner_hard);
-        free (circle);
+        dxf_graphic_properties_free (circle->properties);
+        dxf_free (circle->dictionary_owner_soft);
+        dxf_free (circle->dictionary_owner_hard);
+        dxf_binary_graphics_data_free_chain (circle->binary_graphics_data);
+        dxf_point_free (circle->p0);
+        dxf_free (circle);
         circle = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -579,7 +539,7 @@ dxf_circle_free_chain
                 /*!< pointer to the chain of DXF \c CIRCLE entities. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (circles == NULL)
@@ -605,7 +565,7 @@ dxf_circle_free_chain
  *
  * \return ID code.
  */
-int
+long
 dxf_circle_get_id_code
 (
         DxfCircle *circle
@@ -645,7 +605,7 @@ dxf_circle_set_id_code
 (
         DxfCircle *circle,
                 /*!< a pointer to a DXF \c CIRCLE entity. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -700,7 +660,7 @@ dxf_circle_get_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        if (circle->linetype ==  NULL)
+        if (circle->properties->linetype ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the linetype member.\n")),
@@ -710,7 +670,7 @@ dxf_circle_get_linetype
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (circle->linetype));
+        return (dxf_strdup (circle->properties->linetype));
 }
 
 
@@ -744,7 +704,12 @@ dxf_circle_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        circle->linetype = strdup (linetype);
+        if (dxf_graphic_properties_unshare (&circle->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (circle->properties->linetype);
+        circle->properties->linetype = dxf_strdup (linetype);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -775,7 +740,7 @@ dxf_circle_get_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        if (circle->layer ==  NULL)
+        if (circle->properties->layer ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the layer member.\n")),
@@ -785,7 +750,7 @@ dxf_circle_get_layer
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (circle->layer));
+        return (dxf_strdup (circle->properties->layer));
 }
 
 
@@ -819,7 +784,12 @@ dxf_circle_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        circle->layer = strdup (layer);
+        if (dxf_graphic_properties_unshare (&circle->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (circle->properties->layer);
+        circle->properties->layer = dxf_strdup (layer);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -853,7 +823,7 @@ dxf_circle_get_elevation
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (circle->elevation);
+        return (circle->properties->elevation);
 }
 
 
@@ -880,7 +850,11 @@ dxf_circle_set_elevation
                   __FUNCTION__);
                 return (NULL);
         }
-        circle->elevation = elevation;
+        if (dxf_graphic_properties_unshare (&circle->properties) == NULL)
+        {
+                return (NULL);
+        }
+        circle->properties->elevation = elevation;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -911,7 +885,7 @@ dxf_circle_get_thickness
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (circle->thickness < 0.0)
+        if (circle->properties->thickness < 0.0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found in the thickness member.\n")),
@@ -921,7 +895,7 @@ dxf_circle_get_thickness
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (circle->thickness);
+        return (circle->properties->thickness);
 }
 
 
@@ -955,7 +929,11 @@ dxf_circle_set_thickness
                   __FUNCTION__);
                 return (NULL);
         }
-        circle->thickness = thickness;
+        if (dxf_graphic_properties_unshare (&circle->properties) == NULL)
+        {
+                return (NULL);
+        }
+        circle->properties->thickness = thickness;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -986,7 +964,7 @@ dxf_circle_get_linetype_scale
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (circle->linetype_scale < 0.0)
+        if (circle->properties->linetype_scale < 0.0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found in the linetype scale member.\n")),
@@ -996,7 +974,7 @@ dxf_circle_get_linetype_scale
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (circle->linetype_scale);
+        return (circle->properties->linetype_scale);
 }
 
 
@@ -1030,7 +1008,11 @@ dxf_circle_set_linetype_scale
                   __FUNCTION__);
                 return (NULL);
         }
-        circle->linetype_scale = linetype_scale;
+        if (dxf_graphic_properties_unshare (&circle->properties) == NULL)
+        {
+                return (NULL);
+        }
+        circle->properties->linetype_scale = linetype_scale;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1061,14 +1043,14 @@ dxf_circle_get_visibility
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (circle->visibility < 0)
+        if (circle->properties->visibility < 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found in the visibility member.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (circle->visibility > 1)
+        if (circle->properties->visibility > 1)
         {
                 fprintf (stderr,
                   (_("Error in %s () an out of range value was found in the visibility member.\n")),
@@ -1078,7 +1060,7 @@ dxf_circle_get_visibility
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (circle->visibility);
+        return (circle->properties->visibility);
 }
 
 
@@ -1119,7 +1101,11 @@ dxf_circle_set_visibility
                   __FUNCTION__);
                 return (NULL);
         }
-        circle->visibility = visibility;
+        if (dxf_graphic_properties_unshare (&circle->properties) == NULL)
+        {
+                return (NULL);
+        }
+        circle->properties->visibility = visibility;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1150,7 +1136,7 @@ dxf_circle_get_color
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (circle->color < 0)
+        if (circle->properties->color < 0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found in the color member.\n")),
@@ -1159,7 +1145,7 @@ dxf_circle_get_color
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (circle->color);
+        return (circle->properties->color);
 }
 
 
@@ -1194,7 +1180,11 @@ dxf_circle_set_color
                 fprintf (stderr,
                   (_("\teffectively turning this entity it's visibility off.\n")));
         }
-        circle->color = color;
+        if (dxf_graphic_properties_unshare (&circle->properties) == NULL)
+        {
+                return (NULL);
+        }
+        circle->properties->color = color;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1225,13 +1215,13 @@ dxf_circle_get_paperspace
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (circle->paperspace < 0)
+        if (circle->properties->paperspace < 0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found in the paperspace member.\n")),
                   __FUNCTION__);
         }
-        if (circle->paperspace > 1)
+        if (circle->properties->paperspace > 1)
         {
                 fprintf (stderr,
                   (_("Warning in %s () an out of range value was found in the paperspace member.\n")),
@@ -1240,7 +1230,7 @@ dxf_circle_get_paperspace
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (circle->paperspace);
+        return (circle->properties->paperspace);
 }
 
 
@@ -1281,7 +1271,11 @@ dxf_circle_set_paperspace
                   __FUNCTION__);
                 return (NULL);
         }
-        circle->paperspace = paperspace;
+        if (dxf_graphic_properties_unshare (&circle->properties) == NULL)
+        {
+                return (NULL);
+        }
+        circle->properties->paperspace = paperspace;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1406,14 +1400,14 @@ dxf_circle_get_shadow_mode
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (circle->shadow_mode < 0)
+        if (circle->properties->shadow_mode < 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found in the shadow_mode member.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (circle->shadow_mode > 3)
+        if (circle->properties->shadow_mode > 3)
         {
                 fprintf (stderr,
                   (_("Error in %s () an out of range value was found in the shadow_mode member.\n")),
@@ -1423,7 +1417,7 @@ dxf_circle_get_shadow_mode
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (circle->shadow_mode);
+        return (circle->properties->shadow_mode);
 }
 
 
@@ -1467,7 +1461,11 @@ dxf_circle_set_shadow_mode
                   __FUNCTION__);
                 return (NULL);
         }
-        circle->shadow_mode = shadow_mode;
+        if (dxf_graphic_properties_unshare (&circle->properties) == NULL)
+        {
+                return (NULL);
+        }
+        circle->properties->shadow_mode = shadow_mode;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1594,7 +1592,7 @@ dxf_circle_get_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (circle->dictionary_owner_soft));
+        return (dxf_strdup (circle->dictionary_owner_soft));
 }
 
 
@@ -1630,7 +1628,7 @@ dxf_circle_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        circle->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        circle->dictionary_owner_soft = dxf_strdup (dictionary_owner_soft);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1665,7 +1663,7 @@ dxf_circle_get_material
                   __FUNCTION__);
                 return (NULL);
         }
-        if (circle->material ==  NULL)
+        if (circle->properties->material ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the material member.\n")),
@@ -1675,7 +1673,7 @@ dxf_circle_get_material
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (circle->material));
+        return (dxf_strdup (circle->properties->material));
 }
 
 
@@ -1713,7 +1711,12 @@ dxf_circle_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        circle->material = strdup (material);
+        if (dxf_graphic_properties_unshare (&circle->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (circle->properties->material);
+        circle->properties->material = dxf_strdup (material);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1757,7 +1760,7 @@ dxf_circle_get_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (circle->dictionary_owner_hard));
+        return (dxf_strdup (circle->dictionary_owner_hard));
 }
 
 
@@ -1793,7 +1796,7 @@ dxf_circle_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        circle->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        circle->dictionary_owner_hard = dxf_strdup (dictionary_owner_hard);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1828,7 +1831,7 @@ dxf_circle_get_lineweight
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (circle->lineweight);
+        return (circle->properties->lineweight);
 }
 
 
@@ -1858,7 +1861,11 @@ dxf_circle_set_lineweight
                   __FUNCTION__);
                 return (NULL);
         }
-        circle->lineweight = lineweight;
+        if (dxf_graphic_properties_unshare (&circle->properties) == NULL)
+        {
+                return (NULL);
+        }
+        circle->properties->lineweight = lineweight;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1890,7 +1897,7 @@ dxf_circle_get_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        if (circle->plot_style_name ==  NULL)
+        if (circle->properties->plot_style_name ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the plot_style_name member.\n")),
@@ -1900,7 +1907,7 @@ dxf_circle_get_plot_style_name
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (circle->plot_style_name));
+        return (dxf_strdup (circle->properties->plot_style_name));
 }
 
 
@@ -1938,7 +1945,12 @@ dxf_circle_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        circle->plot_style_name = strdup (plot_style_name);
+        if (dxf_graphic_properties_unshare (&circle->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (circle->properties->plot_style_name);
+        circle->properties->plot_style_name = dxf_strdup (plot_style_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1973,7 +1985,7 @@ dxf_circle_get_color_value
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (circle->color_value);
+        return (circle->properties->color_value);
 }
 
 
@@ -2003,7 +2015,11 @@ dxf_circle_set_color_value
                   __FUNCTION__);
                 return (NULL);
         }
-        circle->color_value = color_value;
+        if (dxf_graphic_properties_unshare (&circle->properties) == NULL)
+        {
+                return (NULL);
+        }
+        circle->properties->color_value = color_value;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2035,7 +2051,7 @@ dxf_circle_get_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        if (circle->color_name ==  NULL)
+        if (circle->properties->color_name ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the color_name member.\n")),
@@ -2045,7 +2061,7 @@ dxf_circle_get_color_name
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (circle->color_name));
+        return (dxf_strdup (circle->properties->color_name));
 }
 
 
@@ -2083,7 +2099,12 @@ dxf_circle_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        circle->color_name = strdup (color_name);
+        if (dxf_graphic_properties_unshare (&circle->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (circle->properties->color_name);
+        circle->properties->color_name = dxf_strdup (color_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2118,7 +2139,7 @@ dxf_circle_get_transparency
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (circle->transparency);
+        return (circle->properties->transparency);
 }
 
 
@@ -2148,7 +2169,11 @@ dxf_circle_set_transparency
                   __FUNCTION__);
                 return (NULL);
         }
-        circle->transparency = transparency;
+        if (dxf_graphic_properties_unshare (&circle->properties) == NULL)
+        {
+                return (NULL);
+        }
+        circle->properties->transparency = transparency;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2168,7 +2193,7 @@ dxf_circle_get_p0
                 /*!< a pointer to a DXF \c CIRCLE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2207,7 +2232,7 @@ dxf_circle_set_p0
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2246,7 +2271,7 @@ dxf_circle_get_x0
                 /*!< a pointer to a DXF \c CIRCLE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2289,7 +2314,7 @@ dxf_circle_set_x0
                  * \c CIRCLE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2328,7 +2353,7 @@ dxf_circle_get_y0
                 /*!< a pointer to a DXF \c CIRCLE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2371,7 +2396,7 @@ dxf_circle_set_y0
                  * \c CIRCLE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2410,7 +2435,7 @@ dxf_circle_get_z0
                 /*!< a pointer to a DXF \c CIRCLE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2453,7 +2478,7 @@ dxf_circle_set_z0
                  * \c CIRCLE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2583,7 +2608,7 @@ dxf_circle_get_extrusion_vector_as_point
                 /*!< a pointer to a DXF \c CIRCLE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         DxfPoint *point = NULL;
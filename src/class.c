@@ -41,6 +41,8 @@
 
 
 #include "class.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -110,10 +112,10 @@ dxf_class_init
                 __FUNCTION__);
               return (NULL);
         }
-        dxf_class_set_record_type (class, strdup (""));
-        dxf_class_set_record_name (class, strdup (""));
-        dxf_class_set_class_name (class, strdup (""));
-        dxf_class_set_app_name (class, strdup (""));
+        dxf_class_set_record_type (class, "");
+        dxf_class_set_record_name (class, "");
+        dxf_class_set_class_name (class, "");
+        dxf_class_set_app_name (class, "");
         dxf_class_set_proxy_cap_flag (class, 0);
         dxf_class_set_was_a_proxy_flag (class, 0);
         dxf_class_set_is_an_entity_flag (class, 0);
@@ -148,7 +150,8 @@ dxf_class_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfPair pair;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -156,8 +159,6 @@ dxf_class_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (class == NULL)
@@ -168,90 +169,75 @@ dxf_class_read
                 class = dxf_class_new ();
                 class = dxf_class_init (class);
         }
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        fclose (fp->fp);
-                        /* Clean up. */
-                        free (temp_string);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "0") == 0)
-                {
-                        /* Now follows a string containing a record type
-                         * number. */
-                        /*! \bug \c record_type has group code 0 which
-                         * will cause a parsing error and \c record_type
-                         * and other \c class variables  will not be
-                         * read. See the while condition above.
-                         */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", class->record_type);
-                }
-                else if (strcmp (temp_string, "1") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing a record
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", class->record_name);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else if (strcmp (temp_string, "2") == 0)
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing a class name.
-                         */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", class->class_name);
-                }
-                else if (strcmp (temp_string, "3") == 0)
-                {
-                        /* Now follows a string containing the
-                         * application name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", class->app_name);
-                }
-                else if (strcmp (temp_string, "90") == 0)
-                {
-                        /* Now follows a string containing the
-                         * proxy cap flag value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &class->proxy_cap_flag);
-                }
-                else if (strcmp (temp_string, "280") == 0)
-                {
-                        /* Now follows a string containing the
-                         * was a proxy flag value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &class->was_a_proxy_flag);
-                }
-                else if (strcmp (temp_string, "281") == 0)
-                {
-                        /* Now follows a string containing the
-                         * is an entity flag value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &class->is_an_entity_flag);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                        case 0:
+                                /* Now follows a string containing a record type
+                                 * number. */
+                                /*! \bug \c record_type has group code 0 which
+                                 * will cause a parsing error and \c record_type
+                                 * and other \c class variables  will not be
+                                 * read. See the while condition above.
+                                 */
+                                free (class->record_type);
+                                class->record_type = dxf_pair_get_string (&pair);
+                                break;
+                        case 1:
+                                /* Now follows a string containing a record
+                                 * name. */
+                                free (class->record_name);
+                                class->record_name = dxf_pair_get_string (&pair);
+                                break;
+                        case 2:
+                                /* Now follows a string containing a class name.
+                                 */
+                                free (class->class_name);
+                                class->class_name = dxf_pair_get_string (&pair);
+                                break;
+                        case 3:
+                                /* Now follows a string containing the
+                                 * application name. */
+                                free (class->app_name);
+                                class->app_name = dxf_pair_get_string (&pair);
+                                break;
+                        case 90:
+                                /* Now follows a string containing the
+                                 * proxy cap flag value. */
+                                class->proxy_cap_flag = dxf_pair_get_int (&pair);
+                                break;
+                        case 280:
+                                /* Now follows a string containing the
+                                 * was a proxy flag value. */
+                                class->was_a_proxy_flag = dxf_pair_get_int (&pair);
+                                break;
+                        case 281:
+                                /* Now follows a string containing the
+                                 * is an entity flag value. */
+                                class->is_an_entity_flag = dxf_pair_get_int (&pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, "DXF comment: %s\n", temp_string);
+                                break;
+                        default:
+                                fprintf (stderr,
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
+                                  __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
         /* Handle omitted members and/or illegal values. */
-        if (strcmp (dxf_class_get_record_type (class), "") == 0)
+        if (strcmp (class->record_type, "") == 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () empty record type string after reading from: %s before line: %d.\n")),
@@ -259,22 +245,20 @@ dxf_class_read
                 return (NULL);
 
         }
-        if (strcmp (dxf_class_get_record_name (class), "") == 0)
+        if (strcmp (class->record_name, "") == 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () empty record name string after reading from: %s before line: %d.\n")),
                   __FUNCTION__, fp->filename, fp->line_number);
                 return (NULL);
         }
-        if (strcmp (dxf_class_get_class_name (class), "") == 0)
+        if (strcmp (class->class_name, "") == 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () empty class name string after reading from: %s before line: %d.\n")),
                   __FUNCTION__, fp->filename, fp->line_number);
                 return (NULL);
         }
-        /* Clean up. */
-        free (temp_string);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -362,16 +346,16 @@ dxf_class_write
                 dxf_class_set_app_name (class, strdup (""));
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
-        fprintf (fp->fp, "  1\n%s\n", dxf_class_get_record_name (class));
-        fprintf (fp->fp, "  2\n%s\n", dxf_class_get_class_name (class));
+        dxf_write_string (fp, 0, dxf_entity_name);
+        dxf_write_string (fp, 1, dxf_class_get_record_name (class));
+        dxf_write_string (fp, 2, dxf_class_get_class_name (class));
         if (fp->acad_version_number >= AutoCAD_14)
         {
-                fprintf (fp->fp, "  3\n%s\n", dxf_class_get_app_name (class));
+                dxf_write_string (fp, 3, dxf_class_get_app_name (class));
         }
-        fprintf (fp->fp, " 90\n%d\n", dxf_class_get_proxy_cap_flag (class));
-        fprintf (fp->fp, "280\n%d\n", dxf_class_get_was_a_proxy_flag (class));
-        fprintf (fp->fp, "281\n%d\n", dxf_class_get_is_an_entity_flag (class));
+        dxf_write_int (fp, 90, dxf_class_get_proxy_cap_flag (class));
+        dxf_write_int (fp, 280, dxf_class_get_was_a_proxy_flag (class));
+        dxf_write_int (fp, 281, dxf_class_get_is_an_entity_flag (class));
         /* Clean up. */
         free (dxf_entity_name);
 #if DEBUG
@@ -406,7 +390,7 @@ dxf_class_write_endclass
                 return (EXIT_FAILURE);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\nENDSEC\n");
+        dxf_write_string (fp, 0, "ENDSEC");
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -463,7 +447,7 @@ dxf_class_free_chain
                 /*!< pointer to the chain of DXF \c CLASS classes. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (classes == NULL)
@@ -475,6 +459,7 @@ dxf_class_free_chain
         while (classes != NULL)
         {
                 struct DxfClass *iter = classes->next;
+                classes->next = NULL;
                 dxf_class_free (classes);
                 classes = (DxfClass *) iter;
         }
@@ -2222,7 +2222,7 @@ dxf_RGB_color_free
                  * RGB Color. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2243,7 +2243,7 @@ dxf_RGB_color_free
         free (RGB_color->name);
         free (RGB_color);
         RGB_color = NULL;
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_END
 #endif
         return (EXIT_SUCCESS);
@@ -2267,7 +2267,7 @@ dxf_RGB_color_free_chain
                 /*!< a pointer to the chain of DXF \c COLOR entities. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (colors == NULL)
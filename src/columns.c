@@ -0,0 +1,890 @@
+/*!
+ * \file columns.c
+ *
+ * \author Copyright (C) 2017 by the libDXF developers.
+ *
+ * \brief Columnar store of simple entities.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+
+#include "columns.h"
+#include "lexer.h"
+#include "writer.h"
+
+
+/*!
+ * \brief Hash of a layer name (FNV-1a).
+ */
+static uint32_t
+dxf_columns_hash
+(
+        const char *layer
+                /*!< the layer name. */
+)
+{
+        uint32_t hash = UINT32_C (2166136261);
+
+        for (; *layer != '\0'; layer++)
+        {
+                hash = (hash ^ (unsigned char) *layer) * UINT32_C (16777619);
+        }
+        return (hash);
+}
+
+
+/*!
+ * \brief Grow one column of a table to \c capacity rows.
+ *
+ * A column which is \c NULL is not allocated.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when no memory
+ * could be allocated.
+ */
+static int
+dxf_columns_grow_column
+(
+        void **column,
+                /*!< the column. */
+        int capacity,
+                /*!< the new number of rows. */
+        size_t size
+                /*!< size of one row in bytes. */
+)
+{
+        void *grown;
+
+        if (*column == NULL)
+        {
+                return (EXIT_SUCCESS);
+        }
+        grown = realloc (*column, (size_t) capacity * size);
+        if (grown == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        *column = grown;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Set up the columns of \c table for entities of type \c type.
+ *
+ * The columns start with one row, so the ones an entity type has can be
+ * told from the ones it has not.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when no memory
+ * could be allocated.
+ */
+static int
+dxf_columns_table_init
+(
+        DxfColumnsTable *table,
+                /*!< the table. */
+        DxfEntityType type
+                /*!< type of the entities. */
+)
+{
+        int has_end = (type == LINE);
+        int has_radius = ((type == CIRCLE) || (type == ARC));
+        int has_angles = (type == ARC);
+
+        table->type = type;
+        table->count = 0;
+        table->capacity = 1;
+        table->id_code = malloc (sizeof (long));
+        table->layer = malloc (sizeof (int));
+        table->color = malloc (sizeof (int));
+        table->x0 = malloc (sizeof (double));
+        table->y0 = malloc (sizeof (double));
+        table->z0 = malloc (sizeof (double));
+        table->x1 = has_end ? malloc (sizeof (double)) : NULL;
+        table->y1 = has_end ? malloc (sizeof (double)) : NULL;
+        table->z1 = has_end ? malloc (sizeof (double)) : NULL;
+        table->radius = has_radius ? malloc (sizeof (double)) : NULL;
+        table->start_angle = has_angles ? malloc (sizeof (double)) : NULL;
+        table->end_angle = has_angles ? malloc (sizeof (double)) : NULL;
+        if ((table->id_code == NULL)
+          || (table->layer == NULL)
+          || (table->color == NULL)
+          || (table->x0 == NULL)
+          || (table->y0 == NULL)
+          || (table->z0 == NULL)
+          || (has_end && ((table->x1 == NULL) || (table->y1 == NULL) || (table->z1 == NULL)))
+          || (has_radius && (table->radius == NULL))
+          || (has_angles && ((table->start_angle == NULL) || (table->end_angle == NULL))))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Free the columns of \c table.
+ */
+static void
+dxf_columns_table_free
+(
+        DxfColumnsTable *table
+                /*!< the table. */
+)
+{
+        free (table->id_code);
+        free (table->layer);
+        free (table->color);
+        free (table->x0);
+        free (table->y0);
+        free (table->z0);
+        free (table->x1);
+        free (table->y1);
+        free (table->z1);
+        free (table->radius);
+        free (table->start_angle);
+        free (table->end_angle);
+}
+
+
+/*!
+ * \brief Allocate an empty \c DxfColumns.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when succesful.
+ */
+DxfColumns *
+dxf_columns_new ()
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfColumns *columns = NULL;
+
+        if ((columns = calloc (1, sizeof (DxfColumns))) == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory for a DxfColumns struct.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        if ((dxf_columns_table_init (&columns->line, LINE) != EXIT_SUCCESS)
+          || (dxf_columns_table_init (&columns->point, POINT) != EXIT_SUCCESS)
+          || (dxf_columns_table_init (&columns->circle, CIRCLE) != EXIT_SUCCESS)
+          || (dxf_columns_table_init (&columns->arc, ARC) != EXIT_SUCCESS))
+        {
+                dxf_columns_free (columns);
+                return (NULL);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (columns);
+}
+
+
+/*!
+ * \brief Get the table of \c columns holding entities of type \c type.
+ *
+ * \return the table, or \c NULL when entities of type \c type are not
+ * stored in columns.
+ */
+DxfColumnsTable *
+dxf_columns_get_table
+(
+        DxfColumns *columns,
+                /*!< the columnar store. */
+        DxfEntityType type
+                /*!< type of the entities. */
+)
+{
+        if (columns == NULL)
+        {
+                return (NULL);
+        }
+        switch (type)
+        {
+                case LINE:
+                        return (&columns->line);
+                case POINT:
+                        return (&columns->point);
+                case CIRCLE:
+                        return (&columns->circle);
+                case ARC:
+                        return (&columns->arc);
+                default:
+                        return (NULL);
+        }
+}
+
+
+/*!
+ * \brief Get the id of the layer named \c layer, adding the layer when
+ * it is new.
+ *
+ * \return the id, or -1 when an error occurred.
+ */
+int
+dxf_columns_get_layer_id
+(
+        DxfColumns *columns,
+                /*!< the columnar store. */
+        const char *layer
+                /*!< the layer name. */
+)
+{
+        char **layers;
+        int *slots;
+        int capacity;
+        int id;
+        int i;
+
+        /* Do some basic checks. */
+        if ((columns == NULL) || (layer == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (-1);
+        }
+        if (columns->layer_slots != NULL)
+        {
+                i = (int) (dxf_columns_hash (layer) & (uint32_t) (columns->layer_slot_capacity - 1));
+                while (columns->layer_slots[i] != 0)
+                {
+                        id = columns->layer_slots[i] - 1;
+                        if (strcmp (columns->layers[id], layer) == 0)
+                        {
+                                return (id);
+                        }
+                        i = (i + 1) & (columns->layer_slot_capacity - 1);
+                }
+        }
+        /* A new layer, keep at least half of the slots free. */
+        if (columns->number_of_layers == columns->layer_capacity)
+        {
+                capacity = (columns->layer_capacity > 0) ? 2 * columns->layer_capacity : DXF_COLUMNS_MIN_LAYER_SLOTS / 2;
+                layers = realloc (columns->layers, (size_t) capacity * sizeof (char *));
+                if (layers == NULL)
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () could not allocate memory.\n")),
+                          __FUNCTION__);
+                        return (-1);
+                }
+                columns->layers = layers;
+                columns->layer_capacity = capacity;
+                slots = calloc ((size_t) (2 * capacity), sizeof (int));
+                if (slots == NULL)
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () could not allocate memory.\n")),
+                          __FUNCTION__);
+                        return (-1);
+                }
+                free (columns->layer_slots);
+                columns->layer_slots = slots;
+                columns->layer_slot_capacity = 2 * capacity;
+                for (id = 0; id < columns->number_of_layers; id++)
+                {
+                        i = (int) (dxf_columns_hash (columns->layers[id]) & (uint32_t) (columns->layer_slot_capacity - 1));
+                        while (columns->layer_slots[i] != 0)
+                        {
+                                i = (i + 1) & (columns->layer_slot_capacity - 1);
+                        }
+                        columns->layer_slots[i] = id + 1;
+                }
+        }
+        id = columns->number_of_layers;
+        columns->layers[id] = strdup (layer);
+        if (columns->layers[id] == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (-1);
+        }
+        i = (int) (dxf_columns_hash (layer) & (uint32_t) (columns->layer_slot_capacity - 1));
+        while (columns->layer_slots[i] != 0)
+        {
+                i = (i + 1) & (columns->layer_slot_capacity - 1);
+        }
+        columns->layer_slots[i] = id + 1;
+        columns->number_of_layers++;
+        return (id);
+}
+
+
+/*!
+ * \brief Get the name of the layer with id \c id.
+ *
+ * \return the layer name, or \c NULL when there is no such layer.
+ */
+const char *
+dxf_columns_get_layer_name
+(
+        DxfColumns *columns,
+                /*!< the columnar store. */
+        int id
+                /*!< the layer id. */
+)
+{
+        if ((columns == NULL) || (id < 0) || (id >= columns->number_of_layers))
+        {
+                return (NULL);
+        }
+        return (columns->layers[id]);
+}
+
+
+/*!
+ * \brief Make room for \c needed rows in \c table.
+ *
+ * The columns grow to twice their size at least, so rows are added in
+ * amortized constant time.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_columns_table_reserve
+(
+        DxfColumnsTable *table,
+                /*!< the table. */
+        int needed
+                /*!< number of rows needed. */
+)
+{
+        int capacity;
+
+        /* Do some basic checks. */
+        if (table == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (needed <= table->capacity)
+        {
+                return (EXIT_SUCCESS);
+        }
+        capacity = 2 * table->capacity;
+        if (capacity < needed)
+        {
+                capacity = needed;
+        }
+        /* A column which grew keeps its rows when a later one fails,
+         * the capacity is only raised when all of them grew. */
+        if ((dxf_columns_grow_column ((void **) &table->id_code, capacity, sizeof (long)) != EXIT_SUCCESS)
+          || (dxf_columns_grow_column ((void **) &table->layer, capacity, sizeof (int)) != EXIT_SUCCESS)
+          || (dxf_columns_grow_column ((void **) &table->color, capacity, sizeof (int)) != EXIT_SUCCESS)
+          || (dxf_columns_grow_column ((void **) &table->x0, capacity, sizeof (double)) != EXIT_SUCCESS)
+          || (dxf_columns_grow_column ((void **) &table->y0, capacity, sizeof (double)) != EXIT_SUCCESS)
+          || (dxf_columns_grow_column ((void **) &table->z0, capacity, sizeof (double)) != EXIT_SUCCESS)
+          || (dxf_columns_grow_column ((void **) &table->x1, capacity, sizeof (double)) != EXIT_SUCCESS)
+          || (dxf_columns_grow_column ((void **) &table->y1, capacity, sizeof (double)) != EXIT_SUCCESS)
+          || (dxf_columns_grow_column ((void **) &table->z1, capacity, sizeof (double)) != EXIT_SUCCESS)
+          || (dxf_columns_grow_column ((void **) &table->radius, capacity, sizeof (double)) != EXIT_SUCCESS)
+          || (dxf_columns_grow_column ((void **) &table->start_angle, capacity, sizeof (double)) != EXIT_SUCCESS)
+          || (dxf_columns_grow_column ((void **) &table->end_angle, capacity, sizeof (double)) != EXIT_SUCCESS))
+        {
+                return (EXIT_FAILURE);
+        }
+        table->capacity = capacity;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Add a row for an entity of type \c type to \c columns.
+ *
+ * The row holds the defaults of a new entity: no handle, layer
+ * \c DXF_DEFAULT_LAYER, color \c DXF_COLOR_BYLAYER and zero for all
+ * numbers.
+ *
+ * \return the index of the row, or -1 when an error occurred.
+ */
+int
+dxf_columns_add_row
+(
+        DxfColumns *columns,
+                /*!< the columnar store. */
+        DxfEntityType type
+                /*!< type of the entity. */
+)
+{
+        DxfColumnsTable *table;
+        int layer;
+        int row;
+
+        table = dxf_columns_get_table (columns, type);
+        if (table == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer or unsupported type was passed.\n")),
+                  __FUNCTION__);
+                return (-1);
+        }
+        layer = dxf_columns_get_layer_id (columns, DXF_DEFAULT_LAYER);
+        if ((layer < 0)
+          || (dxf_columns_table_reserve (table, table->count + 1) != EXIT_SUCCESS))
+        {
+                return (-1);
+        }
+        row = table->count;
+        table->id_code[row] = 0;
+        table->layer[row] = layer;
+        table->color[row] = DXF_COLOR_BYLAYER;
+        table->x0[row] = 0.0;
+        table->y0[row] = 0.0;
+        table->z0[row] = 0.0;
+        if (table->x1 != NULL)
+        {
+                table->x1[row] = 0.0;
+                table->y1[row] = 0.0;
+                table->z1[row] = 0.0;
+        }
+        if (table->radius != NULL)
+        {
+                table->radius[row] = 0.0;
+        }
+        if (table->start_angle != NULL)
+        {
+                table->start_angle[row] = 0.0;
+                table->end_angle[row] = 0.0;
+        }
+        table->count++;
+        return (row);
+}
+
+
+/*!
+ * \brief Read an entity of type \c type into a new row of \c columns.
+ *
+ * The last pair read from file was the (0, name) pair starting the
+ * entity.  The groups up to the next group code 0 are read, the ones
+ * without a column are skipped.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_columns_read_entity
+(
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
+        DxfColumns *columns,
+                /*!< the columnar store. */
+        DxfEntityType type
+                /*!< type of the entity. */
+)
+{
+        char layer[DXF_MAX_STRING_LENGTH];
+        DxfColumnsTable *table;
+        DxfPair pair;
+        int row;
+
+        /* Do some basic checks. */
+        if (fp == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL file pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        row = dxf_columns_add_row (columns, type);
+        if (row < 0)
+        {
+                return (EXIT_FAILURE);
+        }
+        table = dxf_columns_get_table (columns, type);
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
+        {
+                switch (pair.group_code)
+                {
+                        case 0:
+                                /* Leave the start of the following
+                                 * entity for the caller. */
+                                dxf_lexer_unread_pair (fp);
+                                return (EXIT_SUCCESS);
+                        case 5:
+                                table->id_code[row] = dxf_pair_get_hex (&pair);
+                                break;
+                        case 8:
+                                dxf_pair_copy_string (&pair, layer, sizeof (layer));
+                                table->layer[row] = dxf_columns_get_layer_id (columns, layer);
+                                if (table->layer[row] < 0)
+                                {
+                                        return (EXIT_FAILURE);
+                                }
+                                break;
+                        case 62:
+                                table->color[row] = dxf_pair_get_int (&pair);
+                                break;
+                        case 10:
+                                table->x0[row] = dxf_pair_get_double (&pair);
+                                break;
+                        case 20:
+                                table->y0[row] = dxf_pair_get_double (&pair);
+                                break;
+                        case 30:
+                                table->z0[row] = dxf_pair_get_double (&pair);
+                                break;
+                        case 11:
+                                if (table->x1 != NULL)
+                                {
+                                        table->x1[row] = dxf_pair_get_double (&pair);
+                                }
+                                break;
+                        case 21:
+                                if (table->y1 != NULL)
+                                {
+                                        table->y1[row] = dxf_pair_get_double (&pair);
+                                }
+                                break;
+                        case 31:
+                                if (table->z1 != NULL)
+                                {
+                                        table->z1[row] = dxf_pair_get_double (&pair);
+                                }
+                                break;
+                        case 40:
+                                if (table->radius != NULL)
+                                {
+                                        table->radius[row] = dxf_pair_get_double (&pair);
+                                }
+                                break;
+                        case 50:
+                                /* The angle of a POINT has no column. */
+                                if (table->start_angle != NULL)
+                                {
+                                        table->start_angle[row] = dxf_pair_get_double (&pair);
+                                }
+                                break;
+                        case 51:
+                                if (table->end_angle != NULL)
+                                {
+                                        table->end_angle[row] = dxf_pair_get_double (&pair);
+                                }
+                                break;
+                        default:
+                                break;
+                }
+        }
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Write the entities of one table of \c columns.
+ */
+static void
+dxf_columns_write_table
+(
+        DxfFile *fp,
+                /*!< DXF file pointer to an output file (or device). */
+        DxfColumns *columns,
+                /*!< the columnar store. */
+        DxfColumnsTable *table,
+                /*!< the table. */
+        const char *name,
+                /*!< name of the entities. */
+        const char *subclass
+                /*!< subclass marker of the entities. */
+)
+{
+        int i;
+
+        for (i = 0; i < table->count; i++)
+        {
+                dxf_write_string (fp, 0, name);
+                if (table->id_code[i] != 0)
+                {
+                        dxf_write_hex (fp, 5, table->id_code[i]);
+                }
+                if (fp->acad_version_number >= AutoCAD_13)
+                {
+                        dxf_write_string (fp, 100, "AcDbEntity");
+                }
+                dxf_write_string (fp, 8, columns->layers[table->layer[i]]);
+                if (table->color[i] != DXF_COLOR_BYLAYER)
+                {
+                        dxf_write_int (fp, 62, table->color[i]);
+                }
+                if (fp->acad_version_number >= AutoCAD_13)
+                {
+                        dxf_write_string (fp, 100, subclass);
+                }
+                dxf_write_double (fp, 10, table->x0[i]);
+                dxf_write_double (fp, 20, table->y0[i]);
+                dxf_write_double (fp, 30, table->z0[i]);
+                if (table->x1 != NULL)
+                {
+                        dxf_write_double (fp, 11, table->x1[i]);
+                        dxf_write_double (fp, 21, table->y1[i]);
+                        dxf_write_double (fp, 31, table->z1[i]);
+                }
+                if (table->radius != NULL)
+                {
+                        dxf_write_double (fp, 40, table->radius[i]);
+                }
+                if (table->start_angle != NULL)
+                {
+                        if (fp->acad_version_number >= AutoCAD_13)
+                        {
+                                dxf_write_string (fp, 100, "AcDbArc");
+                        }
+                        dxf_write_double (fp, 50, table->start_angle[i]);
+                        dxf_write_double (fp, 51, table->end_angle[i]);
+                }
+        }
+}
+
+
+/*!
+ * \brief Write DXF output to a file for all entities in \c columns.
+ *
+ * The \c LINE entities are written first, followed by the \c POINT,
+ * \c CIRCLE and \c ARC entities.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_columns_write
+(
+        DxfFile *fp,
+                /*!< DXF file pointer to an output file (or device). */
+        DxfColumns *columns
+                /*!< the columnar store. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (fp == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL file pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (columns == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        dxf_columns_write_table (fp, columns, &columns->line, "LINE", "AcDbLine");
+        dxf_columns_write_table (fp, columns, &columns->point, "POINT", "AcDbPoint");
+        dxf_columns_write_table (fp, columns, &columns->circle, "CIRCLE", "AcDbCircle");
+        dxf_columns_write_table (fp, columns, &columns->arc, "ARC", "AcDbCircle");
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Append the rows of one table of \c more to the same table of
+ * \c columns.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_columns_append_table
+(
+        DxfColumnsTable *table,
+                /*!< the table to append to. */
+        DxfColumnsTable *more,
+                /*!< the table to take the rows from. */
+        const int *layers
+                /*!< the ids in \c columns of the layers of \c more. */
+)
+{
+        size_t count = (size_t) more->count;
+        int start = table->count;
+        int i;
+
+        if (dxf_columns_table_reserve (table, table->count + more->count) != EXIT_SUCCESS)
+        {
+                return (EXIT_FAILURE);
+        }
+        memcpy (&table->id_code[start], more->id_code, count * sizeof (long));
+        memcpy (&table->color[start], more->color, count * sizeof (int));
+        memcpy (&table->x0[start], more->x0, count * sizeof (double));
+        memcpy (&table->y0[start], more->y0, count * sizeof (double));
+        memcpy (&table->z0[start], more->z0, count * sizeof (double));
+        if (table->x1 != NULL)
+        {
+                memcpy (&table->x1[start], more->x1, count * sizeof (double));
+                memcpy (&table->y1[start], more->y1, count * sizeof (double));
+                memcpy (&table->z1[start], more->z1, count * sizeof (double));
+        }
+        if (table->radius != NULL)
+        {
+                memcpy (&table->radius[start], more->radius, count * sizeof (double));
+        }
+        if (table->start_angle != NULL)
+        {
+                memcpy (&table->start_angle[start], more->start_angle, count * sizeof (double));
+                memcpy (&table->end_angle[start], more->end_angle, count * sizeof (double));
+        }
+        for (i = 0; i < more->count; i++)
+        {
+                table->layer[start + i] = layers[more->layer[i]];
+        }
+        table->count += more->count;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Move all rows of \c more to the ends of the tables of
+ * \c columns, and free \c more.
+ *
+ * Used to join entities read from consecutive parts of a section, the
+ * order of the entities is kept.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_columns_append
+(
+        DxfColumns *columns,
+                /*!< the columnar store to append to. */
+        DxfColumns *more
+                /*!< the columnar store to take the rows from. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        int *layers;
+        int result = EXIT_SUCCESS;
+        int i;
+
+        /* Do some basic checks. */
+        if ((columns == NULL) || (more == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        /* The layer ids of more become ids in columns. */
+        layers = malloc ((size_t) (more->number_of_layers + 1) * sizeof (int));
+        if (layers == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        for (i = 0; i < more->number_of_layers; i++)
+        {
+                layers[i] = dxf_columns_get_layer_id (columns, more->layers[i]);
+                if (layers[i] < 0)
+                {
+                        result = EXIT_FAILURE;
+                }
+        }
+        if ((result != EXIT_SUCCESS)
+          || (dxf_columns_append_table (&columns->line, &more->line, layers) != EXIT_SUCCESS)
+          || (dxf_columns_append_table (&columns->point, &more->point, layers) != EXIT_SUCCESS)
+          || (dxf_columns_append_table (&columns->circle, &more->circle, layers) != EXIT_SUCCESS)
+          || (dxf_columns_append_table (&columns->arc, &more->arc, layers) != EXIT_SUCCESS))
+        {
+                result = EXIT_FAILURE;
+        }
+        free (layers);
+        dxf_columns_free (more);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (result);
+}
+
+
+/*!
+ * \brief Free the allocated memory for a \c DxfColumns and all it's
+ * data fields.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_columns_free
+(
+        DxfColumns *columns
+                /*!< the columnar store. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        int i;
+
+        /* Do some basic checks. */
+        if (columns == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        dxf_columns_table_free (&columns->line);
+        dxf_columns_table_free (&columns->point);
+        dxf_columns_table_free (&columns->circle);
+        dxf_columns_table_free (&columns->arc);
+        for (i = 0; i < columns->number_of_layers; i++)
+        {
+                free (columns->layers[i]);
+        }
+        free (columns->layers);
+        free (columns->layer_slots);
+        free (columns);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/* EOF */
@@ -0,0 +1,210 @@
+/*!
+ * \file columns.h
+ *
+ * \author Copyright (C) 2017 by the libDXF developers.
+ *
+ * \brief Columnar store of simple entities, header file.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#ifndef LIBDXF_SRC_COLUMNS_H
+#define LIBDXF_SRC_COLUMNS_H
+
+
+#include "global.h"
+#include "entity.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define DXF_COLUMNS_MIN_LAYER_SLOTS 16
+        /*!< \brief Smallest number of slots in the layer index of a
+         * DxfColumns. */
+
+
+/*!
+ * \brief Entities of one type, stored column by column.
+ *
+ * Row \c i of every column belongs to the \c i th entity.\n
+ * Only the columns an entity type has are allocated, the others are
+ * \c NULL.
+ */
+typedef struct
+dxf_columns_table_struct
+{
+        DxfEntityType type;
+                /*!< Type of the entities (\c LINE, \c POINT, \c CIRCLE
+                 * or \c ARC). */
+        int count;
+                /*!< Number of rows. */
+        int capacity;
+                /*!< Number of rows the columns have room for. */
+        long *id_code;
+                /*!< Handles, 0 for an entity without one.\n
+                 * Group code = 5. */
+        int *layer;
+                /*!< Layer ids, an index in the \c layers of the
+                 * DxfColumns.\n
+                 * Group code = 8. */
+        int *color;
+                /*!< Colors.\n
+                 * Group code = 62. */
+        double *x0;
+                /*!< X-values of the start or center points.\n
+                 * Group code = 10. */
+        double *y0;
+                /*!< Y-values of the start or center points.\n
+                 * Group code = 20. */
+        double *z0;
+                /*!< Z-values of the start or center points.\n
+                 * Group code = 30. */
+        double *x1;
+                /*!< X-values of the end points, \c LINE only.\n
+                 * Group code = 11. */
+        double *y1;
+                /*!< Y-values of the end points, \c LINE only.\n
+                 * Group code = 21. */
+        double *z1;
+                /*!< Z-values of the end points, \c LINE only.\n
+                 * Group code = 31. */
+        double *radius;
+                /*!< Radii, \c CIRCLE and \c ARC only.\n
+                 * Group code = 40. */
+        double *start_angle;
+                /*!< Start angles, \c ARC only.\n
+                 * Group code = 50. */
+        double *end_angle;
+                /*!< End angles, \c ARC only.\n
+                 * Group code = 51. */
+} DxfColumnsTable;
+
+
+/*!
+ * \brief Columnar store of the \c LINE, \c POINT, \c CIRCLE and \c ARC
+ * entities of a drawing.
+ *
+ * Only the geometry, the handle, the layer and the color of the
+ * entities are kept.\n
+ * Layer names are stored once, the entities refer to them by id.
+ */
+typedef struct
+dxf_columns_struct
+{
+        DxfColumnsTable line;
+                /*!< The \c LINE entities. */
+        DxfColumnsTable point;
+                /*!< The \c POINT entities. */
+        DxfColumnsTable circle;
+                /*!< The \c CIRCLE entities. */
+        DxfColumnsTable arc;
+                /*!< The \c ARC entities. */
+        char **layers;
+                /*!< Layer names by id. */
+        int number_of_layers;
+                /*!< Number of entries in \c layers. */
+        int layer_capacity;
+                /*!< Number of entries \c layers has room for. */
+        int *layer_slots;
+                /*!< Open addressing hash table from layer names to
+                 * their ids plus one, 0 in an empty slot. */
+        int layer_slot_capacity;
+                /*!< Number of slots, a power of two, at least twice
+                 * \c number_of_layers. */
+} DxfColumns;
+
+
+DxfColumns *
+dxf_columns_new ();
+DxfColumnsTable *
+dxf_columns_get_table
+(
+        DxfColumns *columns,
+        DxfEntityType type
+);
+int
+dxf_columns_get_layer_id
+(
+        DxfColumns *columns,
+        const char *layer
+);
+const char *
+dxf_columns_get_layer_name
+(
+        DxfColumns *columns,
+        int id
+);
+int
+dxf_columns_table_reserve
+(
+        DxfColumnsTable *table,
+        int needed
+);
+int
+dxf_columns_add_row
+(
+        DxfColumns *columns,
+        DxfEntityType type
+);
+int
+dxf_columns_read_entity
+(
+        DxfFile *fp,
+        DxfColumns *columns,
+        DxfEntityType type
+);
+int
+dxf_columns_write
+(
+        DxfFile *fp,
+        DxfColumns *columns
+);
+int
+dxf_columns_append
+(
+        DxfColumns *columns,
+        DxfColumns *more
+);
+int
+dxf_columns_free
+(
+        DxfColumns *columns
+);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* LIBDXF_SRC_COLUMNS_H */
+
+
+/* EOF */
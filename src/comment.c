@@ -38,6 +38,7 @@
  */
 
 #include "comment.h"
+#include "writer.h"
 
 /*!
  * \brief Allocate memory for a DXF \c COMMENT.
@@ -47,7 +48,7 @@
 DxfComment *
 dxf_comment_new ()
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         DxfComment *comment = NULL;
@@ -67,7 +68,7 @@ dxf_comment_new ()
         {
                 memset (comment, 0, size);
         }
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_END
 #endif
         return (comment);
@@ -88,7 +89,7 @@ dxf_comment_init
                 /*!< a pointer to the DXF \c COMMENT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -109,7 +110,7 @@ dxf_comment_init
         dxf_comment_set_id_code (comment, 0);
         dxf_comment_set_value (comment, strdup (""));
         dxf_comment_set_next (comment, NULL);
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_END
 #endif
         return (comment);
@@ -156,7 +157,7 @@ dxf_comment_write
         DxfComment *iter = (DxfComment *) comment;
         while (dxf_comment_get_value (iter) != NULL)
         {
-                fprintf (fp->fp, "999\n%s\n", dxf_comment_get_value (iter));
+                dxf_write_string (fp, 999, dxf_comment_get_value (iter));
                 iter = dxf_comment_get_next (iter);
         }
 #if DEBUG
@@ -181,7 +182,7 @@ dxf_comment_free
                  * entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (comment->next != NULL)
@@ -194,7 +195,7 @@ dxf_comment_free
         free (dxf_comment_get_value (comment));
         free (comment);
         comment = NULL;
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_END
 #endif
         return (EXIT_SUCCESS);
@@ -212,7 +213,7 @@ dxf_comment_free_chain
                 /*!< a pointer to the chain of DXF \c COMMENT entities. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (comments == NULL)
@@ -238,7 +239,7 @@ dxf_comment_free_chain
  *
  * \return ID code.
  */
-int
+long
 dxf_comment_get_id_code
 (
         DxfComment *comment
@@ -278,7 +279,7 @@ dxf_comment_set_id_code
 (
         DxfComment *comment,
                 /*!< a pointer to a DXF \c COMMENT entity. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -320,7 +321,7 @@ dxf_comment_get_value
                 /*!< a pointer to the chain of DXF \c COMMENT entities. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (comment == NULL)
@@ -356,7 +357,7 @@ dxf_comment_set_value
                 /*!< the comment value (string) to be set.*/
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (comment == NULL)
@@ -366,7 +367,7 @@ dxf_comment_set_value
                   __FUNCTION__);
               return (NULL);
         }
-        if (value != NULL)
+        if (value == NULL)
         {
               fprintf (stderr,
                   (_("Error in %s () a NULL pointer was passed.\n")),
@@ -56,7 +56,7 @@ extern "C" {
 typedef struct
 dxf_comment_struct
 {
-        int id_code;
+        long id_code;
                 /*!< group code = 5\n
                  * Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
@@ -93,7 +93,7 @@ dxf_comment_free_chain
 (
         DxfComment *comments
 );
-int
+long
 dxf_comment_get_id_code
 (
         DxfComment *comment
@@ -102,7 +102,7 @@ DxfComment *
 dxf_comment_set_id_code
 (
         DxfComment *comment,
-        int id_code
+        long id_code
 );
 char *
 dxf_comment_get_value
@@ -0,0 +1,761 @@
+/*!
+ * \file compress.c
+ *
+ * \author Copyright (C) 2017 by the libDXF developers.
+ *
+ * \brief Transparent compression of DXF files.
+ *
+ * Compressed DXF files are read and written through a stdio stream
+ * created with \c fopencookie (), which decompresses or compresses the
+ * data on the fly, so the readers and writers work unchanged on
+ * \c .dxf.gz and \c .dxf.zst files.\n
+ * gzip support needs zlib, Zstandard support needs libzstd, both need
+ * \c fopencookie (); all are detected by configure.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#define _GNU_SOURCE
+#ifdef HAVE_CONFIG_H
+#  include "libdxf.h"
+#endif
+#include "compress.h"
+#if defined (HAVE_FOPENCOOKIE) && defined (HAVE_ZLIB_H) \
+  && defined (HAVE_LIBZ)
+#  include <zlib.h>
+#  define DXF_COMPRESS_GZIP 1
+#endif
+#if defined (HAVE_FOPENCOOKIE) && defined (HAVE_ZSTD_H) \
+  && defined (HAVE_LIBZSTD)
+#  include <zstd.h>
+#  if ZSTD_VERSION_NUMBER >= 10400
+        /* ZSTD_compressStream2 () and ZSTD_DCtx_reset () are stable
+         * since Zstandard 1.4.0. */
+#    define DXF_COMPRESS_ZSTD 1
+#  endif
+#endif
+
+
+#define DXF_COMPRESS_MAGIC_SIZE 4
+        /*!< \brief Number of bytes needed to recognise a compressed
+         * file. */
+
+
+#ifdef DXF_COMPRESS_ZSTD
+/*!
+ * \brief State of a Zstandard compressed stream.
+ */
+typedef struct
+dxf_compress_zstd
+{
+        FILE *fp;
+                /*!< The underlying (compressed) file. */
+        ZSTD_DCtx *dctx;
+                /*!< Decompression context, or \c NULL when writing. */
+        ZSTD_CCtx *cctx;
+                /*!< Compression context, or \c NULL when reading. */
+        char *buffer;
+                /*!< Buffer for the compressed data. */
+        size_t buffer_size;
+                /*!< Allocated size of \c buffer in bytes. */
+        ZSTD_inBuffer in;
+                /*!< Compressed data not yet consumed when reading. */
+        int eof;
+                /*!< The end of the underlying file has been reached. */
+        off64_t position;
+                /*!< Number of uncompressed bytes read or written. */
+} DxfCompressZstd;
+#endif
+
+
+#ifdef DXF_COMPRESS_GZIP
+static ssize_t
+dxf_compress_gzip_read
+(
+        void *cookie,
+        char *buf,
+        size_t size
+)
+{
+        int n;
+
+        if (size > INT_MAX)
+        {
+                size = INT_MAX;
+        }
+        n = gzread ((gzFile) cookie, buf, (unsigned int) size);
+        return ((ssize_t) n);
+}
+
+
+static ssize_t
+dxf_compress_gzip_write
+(
+        void *cookie,
+        const char *buf,
+        size_t size
+)
+{
+        int n;
+
+        if (size > INT_MAX)
+        {
+                size = INT_MAX;
+        }
+        /* gzwrite () returns 0 on errors, which stdio takes as an
+         * error as well. */
+        n = gzwrite ((gzFile) cookie, buf, (unsigned int) size);
+        return ((ssize_t) n);
+}
+
+
+static int
+dxf_compress_gzip_seek
+(
+        void *cookie,
+        off64_t *offset,
+        int whence
+)
+{
+        z_off_t position;
+
+        /* zlib emulates seeking backwards in a compressed file by
+         * decompressing it again from the start. */
+        position = gzseek ((gzFile) cookie, (z_off_t) *offset, whence);
+        if (position == -1)
+        {
+                return (-1);
+        }
+        *offset = (off64_t) position;
+        return (0);
+}
+
+
+static int
+dxf_compress_gzip_close
+(
+        void *cookie
+)
+{
+        return (gzclose ((gzFile) cookie) == Z_OK ? 0 : EOF);
+}
+#endif
+
+
+#ifdef DXF_COMPRESS_ZSTD
+static ssize_t
+dxf_compress_zstd_read
+(
+        void *cookie,
+        char *buf,
+        size_t size
+)
+{
+        DxfCompressZstd *zstd = (DxfCompressZstd *) cookie;
+        ZSTD_outBuffer out;
+        size_t ret;
+        size_t before;
+
+        out.dst = buf;
+        out.size = size;
+        out.pos = 0;
+        while (out.pos < out.size)
+        {
+                if ((zstd->in.pos == zstd->in.size) && !zstd->eof)
+                {
+                        zstd->in.size = fread (zstd->buffer, 1,
+                          zstd->buffer_size, zstd->fp);
+                        zstd->in.pos = 0;
+                        if (zstd->in.size == 0)
+                        {
+                                zstd->eof = TRUE;
+                        }
+                }
+                before = out.pos;
+                ret = ZSTD_decompressStream (zstd->dctx, &out, &zstd->in);
+                if (ZSTD_isError (ret))
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () %s.\n")),
+                          __FUNCTION__, ZSTD_getErrorName (ret));
+                        return (-1);
+                }
+                /* Nothing left in the file nor in the decompressor. */
+                if (zstd->eof && (out.pos == before))
+                {
+                        break;
+                }
+        }
+        zstd->position += (off64_t) out.pos;
+        return ((ssize_t) out.pos);
+}
+
+
+static ssize_t
+dxf_compress_zstd_write
+(
+        void *cookie,
+        const char *buf,
+        size_t size
+)
+{
+        DxfCompressZstd *zstd = (DxfCompressZstd *) cookie;
+        ZSTD_inBuffer in;
+        ZSTD_outBuffer out;
+        size_t ret;
+
+        in.src = buf;
+        in.size = size;
+        in.pos = 0;
+        while (in.pos < in.size)
+        {
+                out.dst = zstd->buffer;
+                out.size = zstd->buffer_size;
+                out.pos = 0;
+                ret = ZSTD_compressStream2 (zstd->cctx, &out, &in, ZSTD_e_continue);
+                if (ZSTD_isError (ret))
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () %s.\n")),
+                          __FUNCTION__, ZSTD_getErrorName (ret));
+                        return (0);
+                }
+                if (fwrite (zstd->buffer, 1, out.pos, zstd->fp) != out.pos)
+                {
+                        return (0);
+                }
+        }
+        zstd->position += (off64_t) size;
+        return ((ssize_t) size);
+}
+
+
+/*!
+ * \brief Seeks in a Zstandard compressed stream which is read, like
+ * \c gzseek () does for gzip.
+ *
+ * Seeking forward decompresses and discards the data in between,
+ * seeking backward starts decompressing again from the start of the
+ * file.  This is only meant for the short look ahead done when a file
+ * is opened, e.g. by dxf_lexer_detect_binary ().\n
+ * A stream which is written can only report its position.
+ */
+static int
+dxf_compress_zstd_seek
+(
+        void *cookie,
+        off64_t *offset,
+        int whence
+)
+{
+        DxfCompressZstd *zstd = (DxfCompressZstd *) cookie;
+        char scratch[4096];
+        off64_t target;
+        ssize_t n;
+        size_t size;
+
+        switch (whence)
+        {
+                case SEEK_SET:
+                        target = *offset;
+                        break;
+                case SEEK_CUR:
+                        target = zstd->position + *offset;
+                        break;
+                default:
+                        return (-1);
+        }
+        if ((target < 0)
+          || ((zstd->cctx != NULL) && (target != zstd->position)))
+        {
+                return (-1);
+        }
+        if (target < zstd->position)
+        {
+                if (fseek (zstd->fp, 0, SEEK_SET) != 0)
+                {
+                        return (-1);
+                }
+                ZSTD_DCtx_reset (zstd->dctx, ZSTD_reset_session_only);
+                zstd->in.size = 0;
+                zstd->in.pos = 0;
+                zstd->eof = FALSE;
+                zstd->position = 0;
+        }
+        while (zstd->position < target)
+        {
+                size = sizeof (scratch);
+                if ((off64_t) size > target - zstd->position)
+                {
+                        size = (size_t) (target - zstd->position);
+                }
+                n = dxf_compress_zstd_read (zstd, scratch, size);
+                if (n <= 0)
+                {
+                        return (-1);
+                }
+        }
+        *offset = zstd->position;
+        return (0);
+}
+
+
+static int
+dxf_compress_zstd_close
+(
+        void *cookie
+)
+{
+        DxfCompressZstd *zstd = (DxfCompressZstd *) cookie;
+        ZSTD_inBuffer in;
+        ZSTD_outBuffer out;
+        size_t ret = 1;
+        int status = 0;
+
+        if (zstd->cctx != NULL)
+        {
+                /* Flush the frame epilogue. */
+                in.src = NULL;
+                in.size = 0;
+                in.pos = 0;
+                while (ret != 0)
+                {
+                        out.dst = zstd->buffer;
+                        out.size = zstd->buffer_size;
+                        out.pos = 0;
+                        ret = ZSTD_compressStream2 (zstd->cctx, &out, &in, ZSTD_e_end);
+                        if (ZSTD_isError (ret))
+                        {
+                                fprintf (stderr,
+                                  (_("Error in %s () %s.\n")),
+                                  __FUNCTION__, ZSTD_getErrorName (ret));
+                                status = EOF;
+                                break;
+                        }
+                        if (fwrite (zstd->buffer, 1, out.pos, zstd->fp) != out.pos)
+                        {
+                                status = EOF;
+                                break;
+                        }
+                }
+                ZSTD_freeCCtx (zstd->cctx);
+        }
+        if (zstd->dctx != NULL)
+        {
+                ZSTD_freeDCtx (zstd->dctx);
+        }
+        if (fclose (zstd->fp) != 0)
+        {
+                status = EOF;
+        }
+        free (zstd->buffer);
+        free (zstd);
+        return (status);
+}
+
+
+/*!
+ * \brief Opens a Zstandard compressed stream on \c fp.
+ *
+ * When writing, the compression is spread over one worker thread per
+ * online processor, provided libzstd was built with multithreading
+ * support; otherwise it silently compresses in the calling thread.
+ */
+static FILE *
+dxf_compress_zstd_open
+(
+        FILE *fp,
+                /*!< The underlying (compressed) file. */
+        int writing
+                /*!< Compress instead of decompress. */
+)
+{
+        DxfCompressZstd *zstd = NULL;
+        cookie_io_functions_t functions;
+        FILE *stream;
+        long processors;
+
+        zstd = malloc (sizeof (DxfCompressZstd));
+        if (zstd == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        zstd->fp = fp;
+        zstd->dctx = NULL;
+        zstd->cctx = NULL;
+        zstd->in.src = NULL;
+        zstd->in.size = 0;
+        zstd->in.pos = 0;
+        zstd->eof = FALSE;
+        zstd->position = 0;
+        if (writing)
+        {
+                zstd->cctx = ZSTD_createCCtx ();
+                zstd->buffer_size = ZSTD_CStreamOutSize ();
+        }
+        else
+        {
+                zstd->dctx = ZSTD_createDCtx ();
+                zstd->buffer_size = ZSTD_DStreamInSize ();
+        }
+        zstd->buffer = malloc (zstd->buffer_size);
+        if (((zstd->cctx == NULL) && (zstd->dctx == NULL))
+          || (zstd->buffer == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                ZSTD_freeCCtx (zstd->cctx);
+                ZSTD_freeDCtx (zstd->dctx);
+                free (zstd->buffer);
+                free (zstd);
+                return (NULL);
+        }
+        zstd->in.src = zstd->buffer;
+        if (writing)
+        {
+                ZSTD_CCtx_setParameter (zstd->cctx,
+                  ZSTD_c_compressionLevel, ZSTD_CLEVEL_DEFAULT);
+                processors = sysconf (_SC_NPROCESSORS_ONLN);
+                if (processors > 1)
+                {
+                        ZSTD_CCtx_setParameter (zstd->cctx,
+                          ZSTD_c_nbWorkers, (int) processors);
+                }
+        }
+        functions.read = writing ? NULL : dxf_compress_zstd_read;
+        functions.write = writing ? dxf_compress_zstd_write : NULL;
+        functions.seek = dxf_compress_zstd_seek;
+        functions.close = dxf_compress_zstd_close;
+        stream = fopencookie (zstd, writing ? "w" : "r", functions);
+        if (stream == NULL)
+        {
+                /* Leave closing fp to the caller. */
+                ZSTD_freeCCtx (zstd->cctx);
+                ZSTD_freeDCtx (zstd->dctx);
+                free (zstd->buffer);
+                free (zstd);
+        }
+        return (stream);
+}
+#endif
+
+
+/*!
+ * \brief Tells whether this build reads and writes files compressed
+ * with \c compression.
+ *
+ * \return \c TRUE when supported, \c FALSE otherwise.
+ */
+int
+dxf_compress_supported
+(
+        DxfCompression compression
+                /*!< Compression format. */
+)
+{
+        switch (compression)
+        {
+                case DXF_COMPRESSION_NONE:
+                        return (TRUE);
+#ifdef DXF_COMPRESS_GZIP
+                case DXF_COMPRESSION_GZIP:
+                        return (TRUE);
+#endif
+#ifdef DXF_COMPRESS_ZSTD
+                case DXF_COMPRESSION_ZSTD:
+                        return (TRUE);
+#endif
+                default:
+                        return (FALSE);
+        }
+}
+
+
+/*!
+ * \brief Detects the compression of an existing file from its first
+ * bytes.
+ *
+ * \return the compression format, \c DXF_COMPRESSION_NONE for a plain
+ * DXF file or when the file could not be read.
+ */
+DxfCompression
+dxf_compress_detect
+(
+        const char *filename
+                /*!< Name of the file. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        unsigned char magic[DXF_COMPRESS_MAGIC_SIZE];
+        DxfCompression compression = DXF_COMPRESSION_NONE;
+        FILE *fp;
+
+        if (filename == NULL)
+        {
+                return (DXF_COMPRESSION_NONE);
+        }
+        fp = fopen (filename, "rb");
+        if (fp == NULL)
+        {
+                return (DXF_COMPRESSION_NONE);
+        }
+        if (fread (magic, 1, DXF_COMPRESS_MAGIC_SIZE, fp) == DXF_COMPRESS_MAGIC_SIZE)
+        {
+                if ((magic[0] == 0x1f) && (magic[1] == 0x8b))
+                {
+                        compression = DXF_COMPRESSION_GZIP;
+                }
+                else if ((magic[0] == 0x28) && (magic[1] == 0xb5)
+                  && (magic[2] == 0x2f) && (magic[3] == 0xfd))
+                {
+                        compression = DXF_COMPRESSION_ZSTD;
+                }
+        }
+        fclose (fp);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (compression);
+}
+
+
+/*!
+ * \brief Chooses the compression of a file to be written from the
+ * extension of its name: \c .gz for gzip, \c .zst for Zstandard.
+ *
+ * \return the compression format, \c DXF_COMPRESSION_NONE for any other
+ * extension.
+ */
+DxfCompression
+dxf_compress_from_filename
+(
+        const char *filename
+                /*!< Name of the file. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        const char *extension;
+
+        if (filename == NULL)
+        {
+                return (DXF_COMPRESSION_NONE);
+        }
+        extension = strrchr (filename, '.');
+        if (extension == NULL)
+        {
+                return (DXF_COMPRESSION_NONE);
+        }
+        if (strcmp (extension, ".gz") == 0)
+        {
+                return (DXF_COMPRESSION_GZIP);
+        }
+        if (strcmp (extension, ".zst") == 0)
+        {
+                return (DXF_COMPRESSION_ZSTD);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (DXF_COMPRESSION_NONE);
+}
+
+
+/*!
+ * \brief Opens a stdio stream on \c filename which transparently
+ * decompresses (\c mode "r") or compresses (\c mode "w") the data.
+ *
+ * For \c DXF_COMPRESSION_NONE this is a plain \c fopen ().
+ *
+ * \return the stream, to be closed with \c fclose (), or \c NULL when
+ * the file could not be opened or the format is not supported by this
+ * build.
+ */
+FILE *
+dxf_compress_fopen
+(
+        const char *filename,
+                /*!< Name of the file. */
+        const char *mode,
+                /*!< "r" or "rb" for reading, "w" or "wb" for writing. */
+        DxfCompression compression
+                /*!< Compression format of the file. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        FILE *stream = NULL;
+
+        if ((filename == NULL) || (mode == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        switch (compression)
+        {
+                case DXF_COMPRESSION_NONE:
+                        stream = fopen (filename, mode);
+                        break;
+#ifdef DXF_COMPRESS_GZIP
+                case DXF_COMPRESSION_GZIP:
+                {
+                        cookie_io_functions_t functions;
+                        gzFile gz;
+                        int writing = (mode[0] == 'w');
+
+                        gz = gzopen (filename, writing ? "wb" : "rb");
+                        if (gz == NULL)
+                        {
+                                break;
+                        }
+                        gzbuffer (gz, 128 * 1024);
+                        functions.read = writing ? NULL : dxf_compress_gzip_read;
+                        functions.write = writing ? dxf_compress_gzip_write : NULL;
+                        functions.seek = dxf_compress_gzip_seek;
+                        functions.close = dxf_compress_gzip_close;
+                        stream = fopencookie (gz, writing ? "w" : "r", functions);
+                        if (stream == NULL)
+                        {
+                                gzclose (gz);
+                        }
+                        break;
+                }
+#endif
+#ifdef DXF_COMPRESS_ZSTD
+                case DXF_COMPRESSION_ZSTD:
+                {
+                        FILE *fp;
+                        int writing = (mode[0] == 'w');
+
+                        fp = fopen (filename, writing ? "wb" : "rb");
+                        if (fp == NULL)
+                        {
+                                break;
+                        }
+                        stream = dxf_compress_zstd_open (fp, writing);
+                        if (stream == NULL)
+                        {
+                                fclose (fp);
+                        }
+                        break;
+                }
+#endif
+                default:
+                        fprintf (stderr,
+                          (_("Error in %s () file: %s is compressed in a format not supported by this build.\n")),
+                          __FUNCTION__, filename);
+                        break;
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (stream);
+}
+
+
+/*!
+ * \brief Reads the remainder of \c fp into a newly allocated buffer.
+ *
+ * Used to hold a decompressed file in memory where the file would
+ * otherwise be memory mapped.
+ *
+ * \return the buffer, to be freed with \c free (), or \c NULL when an
+ * error occurred or nothing was read.
+ */
+char *
+dxf_compress_read_all
+(
+        FILE *fp,
+                /*!< Stream to read from. */
+        size_t *size
+                /*!< Returns the number of bytes read. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        char *buffer = NULL;
+        char *grown;
+        size_t allocated = 1024 * 1024;
+        size_t used = 0;
+        size_t n;
+
+        if ((fp == NULL) || (size == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        buffer = malloc (allocated);
+        while (buffer != NULL)
+        {
+                n = fread (buffer + used, 1, allocated - used, fp);
+                used += n;
+                if (used < allocated)
+                {
+                        break;
+                }
+                allocated *= 2;
+                grown = realloc (buffer, allocated);
+                if (grown == NULL)
+                {
+                        free (buffer);
+                }
+                buffer = grown;
+        }
+        if (buffer == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        if (ferror (fp) || (used == 0))
+        {
+                free (buffer);
+                return (NULL);
+        }
+        *size = used;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (buffer);
+}
+
+
+/* EOF */
@@ -0,0 +1,102 @@
+/*!
+ * \file compress.h
+ *
+ * \author Copyright (C) 2017 by the libDXF developers.
+ *
+ * \brief Transparent compression of DXF files, header file.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+
+
+#ifndef LIBDXF_SRC_COMPRESS_H
+#define LIBDXF_SRC_COMPRESS_H
+
+
+#include "global.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*!
+ * \brief Compression formats of DXF files.
+ */
+typedef enum
+dxf_compression
+{
+        DXF_COMPRESSION_NONE = 0,
+                /*!< Plain DXF file. */
+        DXF_COMPRESSION_GZIP,
+                /*!< gzip compressed DXF file (\c .dxf.gz). */
+        DXF_COMPRESSION_ZSTD
+                /*!< Zstandard compressed DXF file (\c .dxf.zst). */
+} DxfCompression;
+
+
+int
+dxf_compress_supported
+(
+        DxfCompression compression
+);
+DxfCompression
+dxf_compress_detect
+(
+        const char *filename
+);
+DxfCompression
+dxf_compress_from_filename
+(
+        const char *filename
+);
+FILE *
+dxf_compress_fopen
+(
+        const char *filename,
+        const char *mode,
+        DxfCompression compression
+);
+char *
+dxf_compress_read_all
+(
+        FILE *fp,
+        size_t *size
+);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* LIBDXF_SRC_COMPRESS_H */
+
+
+/* EOF */
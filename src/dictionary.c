@@ -41,6 +41,8 @@
 
 
 #include "dictionary.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -51,7 +53,7 @@
 DxfDictionary *
 dxf_dictionary_new ()
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         DxfDictionary *dictionary = NULL;
@@ -71,7 +73,7 @@ dxf_dictionary_new ()
         {
                 memset (dictionary, 0, size);
         }
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_END
 #endif
         return (dictionary);
@@ -145,7 +147,8 @@ dxf_dictionary_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfPair pair;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -153,8 +156,6 @@ dxf_dictionary_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (fp->acad_version_number < AutoCAD_13)
@@ -171,85 +172,72 @@ dxf_dictionary_read
                 dictionary = dxf_dictionary_new ();
                 dictionary = dxf_dictionary_init (dictionary);
         }
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        /* Clean up. */
-                        free (temp_string);
-                        fclose (fp->fp);
-                        return (NULL);
-                }
-                else if (strcmp (temp_string, "3") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing additional
-                         * proprietary data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", dictionary->entry_name);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                if (strcmp (temp_string, "5") == 0)
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &dictionary->id_code);
-                }
-                else if ((fp->acad_version_number >= AutoCAD_13)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "AcDbDictionary") != 0)
-                        {
+                        case 3:
+                                /* Now follows a string containing additional
+                                 * proprietary data. */
+                                free (dictionary->entry_name);
+                                dictionary->entry_name = dxf_pair_get_string (&pair);
+                                break;
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                dictionary->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 100:
+                                if (fp->acad_version_number >= AutoCAD_13)
+                                {
+                                        /* Now follows a string containing the
+                                         * subclass marker value. */
+                                        dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                        if (strcmp (temp_string, "AcDbDictionary") != 0)
+                                        {
+                                                fprintf (stderr,
+                                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                                  __FUNCTION__, fp->filename, fp->line_number);
+                                        }
+                                }
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner dictionary. */
+                                free (dictionary->dictionary_owner_soft);
+                                dictionary->dictionary_owner_soft = dxf_pair_get_string (&pair);
+                                break;
+                        case 350:
+                                /* Now follows a string containing a handle to ae
+                                 * entry object. */
+                                free (dictionary->entry_object_handle);
+                                dictionary->entry_object_handle = dxf_pair_get_string (&pair);
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                free (dictionary->dictionary_owner_hard);
+                                dictionary->dictionary_owner_hard = dxf_pair_get_string (&pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, (_("DXF comment: %s\n")), temp_string);
+                                break;
+                        default:
                                 fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
                                   __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", dictionary->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "350") == 0)
-                {
-                        /* Now follows a string containing a handle to ae
-                         * entry object. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", dictionary->entry_object_handle);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", dictionary->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, (_("DXF comment: %s\n")), temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
-        /* Clean up. */
-        free (temp_string);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -299,7 +287,7 @@ dxf_dictionary_write
         if (strcmp (dxf_dictionary_get_entry_name (dictionary), "") == 0)
         {
                 fprintf (stderr,
-                  (_("Error in %s () empty entry name string for the %s entity with id-code: %x\n")),
+                  (_("Error in %s () empty entry name string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_dictionary_get_id_code (dictionary));
                 /* Clean up. */
                 free (dxf_entity_name);
@@ -308,14 +296,14 @@ dxf_dictionary_write
         if (fp->acad_version_number < AutoCAD_13)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () illegal DXF version for this %s entity with id-code: %x.\n")),
+                  (_("Warning in %s () illegal DXF version for this %s entity with id-code: %lx.\n")),
                   __FUNCTION__, dxf_entity_name, dxf_dictionary_get_id_code (dictionary));
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
-        if (dxf_dictionary_get_id_code (dictionary) != -1)
+        dxf_write_string (fp, 0, dxf_entity_name);
+        if (dictionary->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", dxf_dictionary_get_id_code (dictionary));
+                dxf_write_hex (fp, 5, dxf_dictionary_get_id_code (dictionary));
         }
         /*!
          * \todo for version R14.\n
@@ -330,23 +318,23 @@ dxf_dictionary_write
         if ((strcmp (dxf_dictionary_get_dictionary_owner_soft (dictionary), "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", dxf_dictionary_get_dictionary_owner_soft (dictionary));
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, dxf_dictionary_get_dictionary_owner_soft (dictionary));
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (dictionary->dictionary_owner_hard, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", dxf_dictionary_get_dictionary_owner_hard (dictionary));
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, dxf_dictionary_get_dictionary_owner_hard (dictionary));
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbDictionary\n");
+                dxf_write_string (fp, 100, "AcDbDictionary");
         }
-        fprintf (fp->fp, "  3\n%s\n", dxf_dictionary_get_entry_name (dictionary));
-        fprintf (fp->fp, "350\n%s\n", dxf_dictionary_get_entry_object_handle (dictionary));
+        dxf_write_string (fp, 3, dxf_dictionary_get_entry_name (dictionary));
+        dxf_write_string (fp, 350, dxf_dictionary_get_entry_object_handle (dictionary));
         /* Clean up. */
         free (dxf_entity_name);
 #if DEBUG
@@ -406,7 +394,7 @@ dxf_dictionary_free_chain
                 /*!< a pointer to the chain of DXF \c DICTIONARY objects. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (dictionaries == NULL)
@@ -432,7 +420,7 @@ dxf_dictionary_free_chain
  *
  * \return ID code.
  */
-int
+long
 dxf_dictionary_get_id_code
 (
         DxfDictionary *dictionary
@@ -472,7 +460,7 @@ dxf_dictionary_set_id_code
 (
         DxfDictionary *dictionary,
                 /*!< a pointer to a DXF \c DICTIONARY object. */
-        int id_code
+        long id_code
                 /*!< Identification number for the object.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
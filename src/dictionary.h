@@ -59,7 +59,7 @@ typedef struct
 dxf_dictionary_struct
 {
         /* Members common for all DXF group objects. */
-        int id_code;
+        long id_code;
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file.\n
@@ -112,7 +112,7 @@ dxf_dictionary_free_chain
 (
         DxfDictionary *dictionaries
 );
-int
+long
 dxf_dictionary_get_id_code
 (
         DxfDictionary *dictionary
@@ -121,7 +121,7 @@ DxfDictionary *
 dxf_dictionary_set_id_code
 (
         DxfDictionary *dictionary,
-        int id_code
+        long id_code
 );
 char *
 dxf_dictionary_get_dictionary_owner_soft
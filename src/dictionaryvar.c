@@ -41,6 +41,8 @@
 
 
 #include "dictionaryvar.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -51,7 +53,7 @@
 DxfDictionaryVar *
 dxf_dictionaryvar_new ()
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         DxfDictionaryVar *dictionaryvar = NULL;
@@ -71,7 +73,7 @@ dxf_dictionaryvar_new ()
         {
                 memset (dictionaryvar, 0, size);
         }
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_END
 #endif
         return (dictionaryvar);
@@ -145,7 +147,8 @@ dxf_dictionaryvar_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfPair pair;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -153,8 +156,6 @@ dxf_dictionaryvar_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (fp->acad_version_number < AutoCAD_14)
@@ -171,85 +172,72 @@ dxf_dictionaryvar_read
                 dictionaryvar = dxf_dictionaryvar_new ();
                 dictionaryvar = dxf_dictionaryvar_init (dictionaryvar);
         }
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        /* Clean up. */
-                        free (temp_string);
-                        fclose (fp->fp);
-                        return (NULL);
-                }
-                else if (strcmp (temp_string, "1") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing additional
-                         * proprietary data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", dictionaryvar->value);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                if (strcmp (temp_string, "5") == 0)
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &dictionaryvar->id_code);
-                }
-                else if ((fp->acad_version_number >= AutoCAD_13)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "DictionaryVariables") != 0)
-                        {
+                        case 1:
+                                /* Now follows a string containing additional
+                                 * proprietary data. */
+                                free (dictionaryvar->value);
+                                dictionaryvar->value = dxf_pair_get_string (&pair);
+                                break;
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                dictionaryvar->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 100:
+                                if (fp->acad_version_number >= AutoCAD_13)
+                                {
+                                        /* Now follows a string containing the
+                                         * subclass marker value. */
+                                        dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                        if (strcmp (temp_string, "DictionaryVariables") != 0)
+                                        {
+                                                fprintf (stderr,
+                                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                                  __FUNCTION__, fp->filename, fp->line_number);
+                                        }
+                                }
+                                break;
+                        case 280:
+                                /* Now follows a string containing a handle to ae
+                                 * entry object. */
+                                free (dictionaryvar->object_schema_number);
+                                dictionaryvar->object_schema_number = dxf_pair_get_string (&pair);
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner dictionary. */
+                                free (dictionaryvar->dictionary_owner_soft);
+                                dictionaryvar->dictionary_owner_soft = dxf_pair_get_string (&pair);
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                free (dictionaryvar->dictionary_owner_hard);
+                                dictionaryvar->dictionary_owner_hard = dxf_pair_get_string (&pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, (_("DXF comment: %s\n")), temp_string);
+                                break;
+                        default:
                                 fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
                                   __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "280") == 0)
-                {
-                        /* Now follows a string containing a handle to ae
-                         * entry object. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", dictionaryvar->object_schema_number);
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", dictionaryvar->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", dictionaryvar->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, (_("DXF comment: %s\n")), temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
-        /* Clean up. */
-        free (temp_string);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -299,26 +287,26 @@ dxf_dictionaryvar_write
         if (strcmp (dxf_dictionaryvar_get_value (dictionaryvar), "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty value string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty value string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_dictionaryvar_get_id_code (dictionaryvar));
         }
         if (strcmp (dxf_dictionaryvar_get_object_schema_number (dictionaryvar), "0") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty object schema number string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty object schema number string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_dictionaryvar_get_id_code (dictionaryvar));
         }
         if (fp->acad_version_number < AutoCAD_14)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () illegal DXF version for this %s entity with id-code: %x.\n")),
+                  (_("Warning in %s () illegal DXF version for this %s entity with id-code: %lx.\n")),
                   __FUNCTION__, dxf_entity_name, dxf_dictionaryvar_get_id_code (dictionaryvar));
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
-        if (dxf_dictionaryvar_get_id_code (dictionaryvar) != -1)
+        dxf_write_string (fp, 0, dxf_entity_name);
+        if (dictionaryvar->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", dxf_dictionaryvar_get_id_code (dictionaryvar));
+                dxf_write_hex (fp, 5, dxf_dictionaryvar_get_id_code (dictionaryvar));
         }
         /*!
          * \todo for version R14.\n
@@ -333,23 +321,23 @@ dxf_dictionaryvar_write
         if ((strcmp (dxf_dictionaryvar_get_dictionary_owner_soft (dictionaryvar), "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", dxf_dictionaryvar_get_dictionary_owner_soft (dictionaryvar));
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, dxf_dictionaryvar_get_dictionary_owner_soft (dictionaryvar));
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (dxf_dictionaryvar_get_dictionary_owner_hard (dictionaryvar), "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", dxf_dictionaryvar_get_dictionary_owner_hard (dictionaryvar));
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, dxf_dictionaryvar_get_dictionary_owner_hard (dictionaryvar));
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nDictionaryVariables\n");
+                dxf_write_string (fp, 100, "DictionaryVariables");
         }
-        fprintf (fp->fp, "280\n%s\n", dxf_dictionaryvar_get_object_schema_number (dictionaryvar));
-        fprintf (fp->fp, "  1\n%s\n", dxf_dictionaryvar_get_value (dictionaryvar));
+        dxf_write_string (fp, 280, dxf_dictionaryvar_get_object_schema_number (dictionaryvar));
+        dxf_write_string (fp, 1, dxf_dictionaryvar_get_value (dictionaryvar));
         /* Clean up. */
         free (dxf_entity_name);
 #if DEBUG
@@ -409,7 +397,7 @@ dxf_dictionaryvar_free_chain
                 /*!< pointer to the chain of DXF \c DICTIONARYVAR objects. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (dictionaryvars == NULL)
@@ -435,7 +423,7 @@ dxf_dictionaryvar_free_chain
  *
  * \return ID code.
  */
-int
+long
 dxf_dictionaryvar_get_id_code
 (
         DxfDictionaryVar *dictionaryvar
@@ -475,7 +463,7 @@ dxf_dictionaryvar_set_id_code
 (
         DxfDictionaryVar *dictionaryvar,
                 /*!< a pointer to a DXF \c DICTIONARYVAR object. */
-        int id_code
+        long id_code
                 /*!< Identification number for the object.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -59,7 +59,7 @@ typedef struct
 dxf_dictionaryvar_struct
 {
         /* Members common for all DXF group objects. */
-        int id_code;
+        long id_code;
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file.\n
@@ -112,7 +112,7 @@ dxf_dictionaryvar_free_chain
 (
         DxfDictionaryVar *dictionaryvars
 );
-int
+long
 dxf_dictionaryvar_get_id_code
 (
         DxfDictionaryVar *dictionaryvar
@@ -121,7 +121,7 @@ DxfDictionaryVar *
 dxf_dictionaryvar_set_id_code
 (
         DxfDictionaryVar *dictionaryvar,
-        int id_code
+        long id_code
 );
 char *
 dxf_dictionaryvar_get_dictionary_owner_soft
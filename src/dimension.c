@@ -40,6 +40,9 @@
 
 
 #include "dimension.h"
+#include "arena.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -62,7 +65,7 @@ dxf_dimension_new ()
         size = sizeof (DxfDimension);
         /* avoid malloc of 0 bytes */
         if (size == 0) size = 1;
-        if ((dimension = malloc (size)) == NULL)
+        if ((dimension = dxf_malloc (size)) == NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () could not allocate memory for a DxfDimension struct.\n")),
@@ -114,37 +117,44 @@ dxf_dimension_init
               return (NULL);
         }
         dxf_dimension_set_id_code (dimension, 0);
-        dxf_dimension_set_linetype (dimension, strdup (DXF_DEFAULT_LINETYPE));
-        dxf_dimension_set_layer (dimension, strdup (DXF_DEFAULT_LAYER));
-        dxf_dimension_set_elevation (dimension, 0.0);
-        dxf_dimension_set_thickness (dimension, 0.0);
-        dxf_dimension_set_linetype_scale (dimension, DXF_DEFAULT_LINETYPE_SCALE);
-        dxf_dimension_set_visibility (dimension, DXF_DEFAULT_VISIBILITY);
-        dxf_dimension_set_color (dimension, DXF_COLOR_BYLAYER);
-        dxf_dimension_set_paperspace (dimension, DXF_PAPERSPACE);
-        dxf_dimension_set_dictionary_owner_soft (dimension, strdup (""));
-        dxf_dimension_set_dictionary_owner_hard (dimension, strdup (""));
-        dxf_dimension_set_dim_text (dimension, strdup (""));
-        dxf_dimension_set_dimblock_name (dimension, strdup (""));
-        dxf_dimension_set_dimstyle_name (dimension, strdup (""));
+        dimension->properties = dxf_graphic_properties_default ();
+        dxf_dimension_set_dictionary_owner_soft (dimension, "");
+        dxf_dimension_set_dictionary_owner_hard (dimension, "");
+        dxf_dimension_set_dim_text (dimension, "");
+        dxf_dimension_set_dimblock_name (dimension, "");
+        dxf_dimension_set_dimstyle_name (dimension, "");
+        dxf_dimension_set_p0 (dimension, dxf_point_new ());
+        dxf_point_init ((DxfPoint *) dxf_dimension_get_p0 (dimension));
         dxf_dimension_set_x0 (dimension, 0.0);
         dxf_dimension_set_y0 (dimension, 0.0);
         dxf_dimension_set_z0 (dimension, 0.0);
+        dxf_dimension_set_p1 (dimension, dxf_point_new ());
+        dxf_point_init ((DxfPoint *) dxf_dimension_get_p1 (dimension));
         dxf_dimension_set_x1 (dimension, 0.0);
         dxf_dimension_set_y1 (dimension, 0.0);
         dxf_dimension_set_z1 (dimension, 0.0);
+        dxf_dimension_set_p2 (dimension, dxf_point_new ());
+        dxf_point_init ((DxfPoint *) dxf_dimension_get_p2 (dimension));
         dxf_dimension_set_x2 (dimension, 0.0);
         dxf_dimension_set_y2 (dimension, 0.0);
         dxf_dimension_set_z2 (dimension, 0.0);
+        dxf_dimension_set_p3 (dimension, dxf_point_new ());
+        dxf_point_init ((DxfPoint *) dxf_dimension_get_p3 (dimension));
         dxf_dimension_set_x3 (dimension, 0.0);
         dxf_dimension_set_y3 (dimension, 0.0);
         dxf_dimension_set_z3 (dimension, 0.0);
+        dxf_dimension_set_p4 (dimension, dxf_point_new ());
+        dxf_point_init ((DxfPoint *) dxf_dimension_get_p4 (dimension));
         dxf_dimension_set_x4 (dimension, 0.0);
         dxf_dimension_set_y4 (dimension, 0.0);
         dxf_dimension_set_z4 (dimension, 0.0);
+        dxf_dimension_set_p5 (dimension, dxf_point_new ());
+        dxf_point_init ((DxfPoint *) dxf_dimension_get_p5 (dimension));
         dxf_dimension_set_x5 (dimension, 0.0);
         dxf_dimension_set_y5 (dimension, 0.0);
         dxf_dimension_set_z5 (dimension, 0.0);
+        dxf_dimension_set_p6 (dimension, dxf_point_new ());
+        dxf_point_init ((DxfPoint *) dxf_dimension_get_p6 (dimension));
         dxf_dimension_set_x6 (dimension, 0.0);
         dxf_dimension_set_y6 (dimension, 0.0);
         dxf_dimension_set_z6 (dimension, 0.0);
@@ -192,7 +202,9 @@ dxf_dimension_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfGraphicProperties properties;
+        DxfPair pair;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -200,8 +212,6 @@ dxf_dimension_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (dimension == NULL)
@@ -212,420 +222,327 @@ dxf_dimension_read
                 dimension = dxf_dimension_new ();
                 dimension = dxf_dimension_init (dimension);
         }
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        dxf_graphic_properties_start (&properties, dimension->properties);
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        fclose (fp->fp);
-                        /* Clean up. */
-                        free (temp_string);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "1") == 0)
-                {
-                        /* Now follows a string containing a dimension
-                         * text string. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", dimension->dim_text);
-                }
-                if (strcmp (temp_string, "2") == 0)
-                {
-                        /* Now follows a string containing a dimension
-                         * block name string. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", dimension->dimblock_name);
-                }
-                if (strcmp (temp_string, "3") == 0)
-                {
-                        /* Now follows a string containing a dimension
-                         * style name string. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", dimension->dimstyle_name);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &dimension->id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", dimension->linetype);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", dimension->layer);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the definition point for all
-                         * dimension types. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimension->p0->x0);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the definition point for all
-                         * dimension types. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimension->p0->y0);
-                }
-                else if (strcmp (temp_string, "30") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the definition point for all
-                         * dimension types. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimension->p0->z0);
-                }
-                else if (strcmp (temp_string, "11") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the middle point of dimension text. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimension->p1->x0);
-                }
-                else if (strcmp (temp_string, "21") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the middle point of dimension text. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimension->p1->y0);
-                }
-                else if (strcmp (temp_string, "31") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the middle point of dimension text. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimension->p1->z0);
-                }
-                else if (strcmp (temp_string, "12") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing the
-                         * X-value of the dimension block translation
-                         * vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimension->p2->x0);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else if (strcmp (temp_string, "22") == 0)
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing the
-                         * Y-value of the dimension block translation
-                         * vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimension->p2->y0);
-                }
-                else if (strcmp (temp_string, "32") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the dimension block translation
-                         * vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimension->p2->z0);
-                }
-                else if (strcmp (temp_string, "13") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the definition point for linear and
-                         * angular dimensions. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimension->p3->x0);
-                }
-                else if (strcmp (temp_string, "23") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the definition point for linear and
-                         * angular dimensions. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimension->p3->y0);
-                }
-                else if (strcmp (temp_string, "33") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the definition point for linear and
-                         * angular dimensions. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimension->p3->z0);
-                }
-                else if (strcmp (temp_string, "14") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the definition point for linear and
-                         * angular dimensions. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimension->p4->x0);
-                }
-                else if (strcmp (temp_string, "24") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the definition point for linear and
-                         * angular dimensions. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimension->p4->y0);
-                }
-                else if (strcmp (temp_string, "34") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the definition point for linear and
-                         * angular dimensions. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimension->p4->z0);
-                }
-                else if (strcmp (temp_string, "15") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the definition point for diameter,
-                         * radius, and angular dimensions. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimension->p5->x0);
-                }
-                else if (strcmp (temp_string, "25") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the definition point for diameter,
-                         * radius, and angular dimensions. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimension->p5->y0);
-                }
-                else if (strcmp (temp_string, "35") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the definition point for diameter,
-                         * radius, and angular dimensions. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimension->p5->z0);
-                }
-                else if (strcmp (temp_string, "16") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the point defining dimension arc for
-                         * angular dimensions. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimension->p6->x0);
-                }
-                else if (strcmp (temp_string, "26") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the point defining dimension arc for
-                         * angular dimensions. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimension->p6->y0);
-                }
-                else if (strcmp (temp_string, "36") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the point defining dimension arc for
-                         * angular dimensions. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimension->p6->z0);
-                }
-                else if (strcmp (temp_string, "38") == 0)
-                {
-                        /* Now follows a string containing the
-                         * elevation. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimension->elevation);
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimension->thickness);
-                }
-                else if (strcmp (temp_string, "40") == 0)
-                {
-                        /* Now follows a string containing the leader
-                         * length. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimension->leader_length);
-                }
-                else if (strcmp (temp_string, "41") == 0)
-                {
-                        /* Now follows a string containing the text line
-                         * spacing factor. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimension->text_line_spacing_factor);
-                }
-                else if (strcmp (temp_string, "42") == 0)
-                {
-                        /* Now follows a string containing the actual
-                         * measurement. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimension->actual_measurement);
-                }
-                else if (strcmp (temp_string, "48") == 0)
-                {
-                        /* Now follows a string containing the linetype
-                         * scale. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimension->linetype_scale);
-                }
-                else if (strcmp (temp_string, "50") == 0)
-                {
-                        /* Now follows a string containing the angle of
-                         * rotated, horizontal, or vertical linear
-                         * dimensions. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimension->angle);
-                }
-                else if (strcmp (temp_string, "51") == 0)
-                {
-                        /* Now follows a string containing the horizontal
-                         * direction. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimension->hor_dir);
-                }
-                else if (strcmp (temp_string, "52") == 0)
-                {
-                        /* Now follows a string containing the oblique
-                         * angle. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimension->obl_angle);
-                }
-                else if (strcmp (temp_string, "53") == 0)
-                {
-                        /* Now follows a string containing the text
-                         * angle. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimension->text_angle);
-                }
-                else if (strcmp (temp_string, "60") == 0)
-                {
-                        /* Now follows a string containing the
-                         * visibility value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &dimension->visibility);
-                }
-                else if (strcmp (temp_string, "62") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &dimension->color);
-                }
-                else if (strcmp (temp_string, "67") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &dimension->paperspace);
-                }
-                else if (strcmp (temp_string, "70") == 0)
-                {
-                        /* Now follows a string containing a flag
-                         * value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &dimension->flag);
-                }
-                else if (strcmp (temp_string, "71") == 0)
-                {
-                        /* Now follows a string containing the attachment
-                         * point value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &dimension->attachment_point);
-                }
-                else if (strcmp (temp_string, "72") == 0)
-                {
-                        /* Now follows a string containing the text line
-                         * spacing value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &dimension->text_line_spacing);
-                }
-                else if ((fp->acad_version_number >= AutoCAD_13)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if ((strcmp (temp_string, "AcDbEntity") != 0)
-                          && (strcmp (temp_string, "AcDbDimension") != 0)
-                          && (strcmp (temp_string, "AcDbAlignedDimension") != 0)
-                          && (strcmp (temp_string, "AcDbRotatedDimension") != 0)
-                          && (strcmp (temp_string, "AcDb3PointAngularDimension") != 0)
-                          && (strcmp (temp_string, "AcDbDiametricDimension") != 0)
-                          && (strcmp (temp_string, "AcDbRadialDimension") != 0)
-                          && (strcmp (temp_string, "AcDbOrdinateDimension") != 0))
-                        {
+                        case 1:
+                                /* Now follows a string containing a dimension
+                                 * text string. */
+                                dxf_free (dimension->dim_text);
+                                dimension->dim_text = dxf_pair_get_string (&pair);
+                                break;
+                        case 2:
+                                /* Now follows a string containing a dimension
+                                 * block name string. */
+                                dxf_free (dimension->dimblock_name);
+                                dimension->dimblock_name = dxf_pair_get_string (&pair);
+                                break;
+                        case 3:
+                                /* Now follows a string containing a dimension
+                                 * style name string. */
+                                dxf_free (dimension->dimstyle_name);
+                                dimension->dimstyle_name = dxf_pair_get_string (&pair);
+                                break;
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                dimension->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 6:
+                                /* Now follows a string containing a linetype
+                                 * name. */
+                                dxf_lexer_free_string (fp, properties.linetype);
+                                properties.linetype = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 8:
+                                /* Now follows a string containing a layer name. */
+                                dxf_lexer_free_string (fp, properties.layer);
+                                properties.layer = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 10:
+                                /* Now follows a string containing the
+                                 * X-value of the definition point for all
+                                 * dimension types. */
+                                dimension->p0->x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 20:
+                                /* Now follows a string containing the
+                                 * Y-value of the definition point for all
+                                 * dimension types. */
+                                dimension->p0->y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 30:
+                                /* Now follows a string containing the
+                                 * Z-value of the definition point for all
+                                 * dimension types. */
+                                dimension->p0->z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 11:
+                                /* Now follows a string containing the
+                                 * X-value of the middle point of dimension text. */
+                                dimension->p1->x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 21:
+                                /* Now follows a string containing the
+                                 * Y-value of the middle point of dimension text. */
+                                dimension->p1->y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 31:
+                                /* Now follows a string containing the
+                                 * Z-value of the middle point of dimension text. */
+                                dimension->p1->z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 12:
+                                /* Now follows a string containing the
+                                 * X-value of the dimension block translation
+                                 * vector. */
+                                dimension->p2->x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 22:
+                                /* Now follows a string containing the
+                                 * Y-value of the dimension block translation
+                                 * vector. */
+                                dimension->p2->y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 32:
+                                /* Now follows a string containing the
+                                 * Z-value of the dimension block translation
+                                 * vector. */
+                                dimension->p2->z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 13:
+                                /* Now follows a string containing the
+                                 * X-value of the definition point for linear and
+                                 * angular dimensions. */
+                                dimension->p3->x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 23:
+                                /* Now follows a string containing the
+                                 * Y-value of the definition point for linear and
+                                 * angular dimensions. */
+                                dimension->p3->y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 33:
+                                /* Now follows a string containing the
+                                 * Z-value of the definition point for linear and
+                                 * angular dimensions. */
+                                dimension->p3->z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 14:
+                                /* Now follows a string containing the
+                                 * X-value of the definition point for linear and
+                                 * angular dimensions. */
+                                dimension->p4->x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 24:
+                                /* Now follows a string containing the
+                                 * Y-value of the definition point for linear and
+                                 * angular dimensions. */
+                                dimension->p4->y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 34:
+                                /* Now follows a string containing the
+                                 * Z-value of the definition point for linear and
+                                 * angular dimensions. */
+                                dimension->p4->z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 15:
+                                /* Now follows a string containing the
+                                 * X-value of the definition point for diameter,
+                                 * radius, and angular dimensions. */
+                                dimension->p5->x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 25:
+                                /* Now follows a string containing the
+                                 * Y-value of the definition point for diameter,
+                                 * radius, and angular dimensions. */
+                                dimension->p5->y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 35:
+                                /* Now follows a string containing the
+                                 * Z-value of the definition point for diameter,
+                                 * radius, and angular dimensions. */
+                                dimension->p5->z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 16:
+                                /* Now follows a string containing the
+                                 * X-value of the point defining dimension arc for
+                                 * angular dimensions. */
+                                dimension->p6->x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 26:
+                                /* Now follows a string containing the
+                                 * Y-value of the point defining dimension arc for
+                                 * angular dimensions. */
+                                dimension->p6->y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 36:
+                                /* Now follows a string containing the
+                                 * Z-value of the point defining dimension arc for
+                                 * angular dimensions. */
+                                dimension->p6->z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 38:
+                                /* Now follows a string containing the
+                                 * elevation. */
+                                properties.elevation = dxf_pair_get_double (&pair);
+                                break;
+                        case 39:
+                                /* Now follows a string containing the
+                                 * thickness. */
+                                properties.thickness = dxf_pair_get_double (&pair);
+                                break;
+                        case 40:
+                                /* Now follows a string containing the leader
+                                 * length. */
+                                dimension->leader_length = dxf_pair_get_double (&pair);
+                                break;
+                        case 41:
+                                /* Now follows a string containing the text line
+                                 * spacing factor. */
+                                dimension->text_line_spacing_factor = dxf_pair_get_double (&pair);
+                                break;
+                        case 42:
+                                /* Now follows a string containing the actual
+                                 * measurement. */
+                                dimension->actual_measurement = dxf_pair_get_double (&pair);
+                                break;
+                        case 48:
+                                /* Now follows a string containing the linetype
+                                 * scale. */
+                                properties.linetype_scale = dxf_pair_get_double (&pair);
+                                break;
+                        case 50:
+                                /* Now follows a string containing the angle of
+                                 * rotated, horizontal, or vertical linear
+                                 * dimensions. */
+                                dimension->angle = dxf_pair_get_double (&pair);
+                                break;
+                        case 51:
+                                /* Now follows a string containing the horizontal
+                                 * direction. */
+                                dimension->hor_dir = dxf_pair_get_double (&pair);
+                                break;
+                        case 52:
+                                /* Now follows a string containing the oblique
+                                 * angle. */
+                                dimension->obl_angle = dxf_pair_get_double (&pair);
+                                break;
+                        case 53:
+                                /* Now follows a string containing the text
+                                 * angle. */
+                                dimension->text_angle = dxf_pair_get_double (&pair);
+                                break;
+                        case 60:
+                                /* Now follows a string containing the
+                                 * visibility value. */
+                                properties.visibility = dxf_pair_get_int (&pair);
+                                break;
+                        case 62:
+                                /* Now follows a string containing the
+                                 * color value. */
+                                properties.color = dxf_pair_get_int (&pair);
+                                break;
+                        case 67:
+                                /* Now follows a string containing the
+                                 * paperspace value. */
+                                properties.paperspace = dxf_pair_get_int (&pair);
+                                break;
+                        case 70:
+                                /* Now follows a string containing a flag
+                                 * value. */
+                                dimension->flag = dxf_pair_get_int (&pair);
+                                break;
+                        case 71:
+                                /* Now follows a string containing the attachment
+                                 * point value. */
+                                dimension->attachment_point = dxf_pair_get_int (&pair);
+                                break;
+                        case 72:
+                                /* Now follows a string containing the text line
+                                 * spacing value. */
+                                dimension->text_line_spacing = dxf_pair_get_int (&pair);
+                                break;
+                        case 100:
+                                if (fp->acad_version_number >= AutoCAD_13)
+                                {
+                                        /* Now follows a string containing the
+                                         * subclass marker value. */
+                                        dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                        if ((strcmp (temp_string, "AcDbEntity") != 0)
+                                          && (strcmp (temp_string, "AcDbDimension") != 0)
+                                          && (strcmp (temp_string, "AcDbAlignedDimension") != 0)
+                                          && (strcmp (temp_string, "AcDbRotatedDimension") != 0)
+                                          && (strcmp (temp_string, "AcDb3PointAngularDimension") != 0)
+                                          && (strcmp (temp_string, "AcDbDiametricDimension") != 0)
+                                          && (strcmp (temp_string, "AcDbRadialDimension") != 0)
+                                          && (strcmp (temp_string, "AcDbOrdinateDimension") != 0))
+                                        {
+                                                fprintf (stderr,
+                                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                                  __FUNCTION__, fp->filename, fp->line_number);
+                                        }
+                                }
+                                break;
+                        case 210:
+                                /* Now follows a string containing the
+                                 * X-value of the extrusion vector. */
+                                dimension->extr_x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 220:
+                                /* Now follows a string containing the
+                                 * Y-value of the extrusion vector. */
+                                dimension->extr_y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 230:
+                                /* Now follows a string containing the
+                                 * Z-value of the extrusion vector. */
+                                dimension->extr_z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, dimension->dictionary_owner_soft);
+                                dimension->dictionary_owner_soft = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, dimension->dictionary_owner_hard);
+                                dimension->dictionary_owner_hard = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, "DXF comment: %s\n", temp_string);
+                                break;
+                        default:
                                 fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
                                   __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "210") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimension->extr_x0);
-                }
-                else if (strcmp (temp_string, "220") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimension->extr_y0);
-                }
-                else if (strcmp (temp_string, "230") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimension->extr_z0);
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", dimension->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", dimension->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
         /* Handle omitted members and/or illegal values. */
-        if (strcmp (dxf_dimension_get_linetype (dimension), "") == 0)
+        if (strcmp (dimension->properties->linetype, "") == 0)
         {
-                dxf_dimension_set_linetype (dimension, strdup (DXF_DEFAULT_LINETYPE));
+                dxf_dimension_set_linetype (dimension, DXF_DEFAULT_LINETYPE);
         }
-        if (strcmp (dxf_dimension_get_layer (dimension), "") == 0)
+        if (strcmp (dimension->properties->layer, "") == 0)
         {
-                dxf_dimension_set_layer (dimension, strdup (DXF_DEFAULT_LAYER));
+                dxf_dimension_set_layer (dimension, DXF_DEFAULT_LAYER);
         }
-        /* Clean up. */
-        free (temp_string);
+        /* Entities with equal properties share a record. */
+        dxf_graphic_properties_finish (fp, &dimension->properties, &properties);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -652,7 +569,7 @@ dxf_dimension_write
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *dxf_entity_name = strdup ("DIMENSION");
+        char *dxf_entity_name = dxf_strdup ("DIMENSION");
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -661,7 +578,7 @@ dxf_dimension_write
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (dimension == NULL)
@@ -670,7 +587,7 @@ dxf_dimension_write
                   (_("Error in %s () a NULL pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if ((dxf_dimension_get_flag (dimension) > 6)
@@ -680,24 +597,24 @@ dxf_dimension_write
                   (_("Error in %s () an out of range flag value was detected.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (strcmp (dxf_dimension_get_layer (dimension), "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty layer string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty layer string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_dimension_get_id_code (dimension));
                 fprintf (stderr,
                   (_("\t%s entity is relocated to layer 0")),
                   dxf_entity_name);
-                dxf_dimension_set_layer (dimension, strdup (DXF_DEFAULT_LAYER));
+                dxf_dimension_set_layer (dimension, DXF_DEFAULT_LAYER);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
-        if (dxf_dimension_get_id_code (dimension) != -1)
+        dxf_write_string (fp, 0, dxf_entity_name);
+        if (dimension->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", dxf_dimension_get_id_code (dimension));
+                dxf_write_hex (fp, 5, dxf_dimension_get_id_code (dimension));
         }
         /*!
          * \todo for version R14.\n
@@ -712,89 +629,89 @@ dxf_dimension_write
         if ((strcmp (dxf_dimension_get_dictionary_owner_soft (dimension), "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", dxf_dimension_get_dictionary_owner_soft (dimension));
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, dxf_dimension_get_dictionary_owner_soft (dimension));
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (dxf_dimension_get_dictionary_owner_hard (dimension), "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", dxf_dimension_get_dictionary_owner_hard (dimension));
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, dxf_dimension_get_dictionary_owner_hard (dimension));
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbEntity\n");
+                dxf_write_string (fp, 100, "AcDbEntity");
         }
         if (dxf_dimension_get_paperspace (dimension) == DXF_PAPERSPACE)
         {
-                fprintf (fp->fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_int (fp, 67, DXF_PAPERSPACE);
         }
-        fprintf (fp->fp, "  8\n%s\n", dxf_dimension_get_layer (dimension));
+        dxf_write_string (fp, 8, dxf_dimension_get_layer (dimension));
         if (strcmp (dxf_dimension_get_linetype (dimension), DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp->fp, "  6\n%s\n", dxf_dimension_get_linetype (dimension));
+                dxf_write_string (fp, 6, dxf_dimension_get_linetype (dimension));
         }
         if (dxf_dimension_get_color (dimension) != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp->fp, " 62\n%d\n", dxf_dimension_get_color (dimension));
+                dxf_write_int (fp, 62, dxf_dimension_get_color (dimension));
         }
         if (dxf_dimension_get_linetype_scale (dimension) != 1.0)
         {
-                fprintf (fp->fp, " 48\n%f\n", dxf_dimension_get_linetype_scale (dimension));
+                dxf_write_double (fp, 48, dxf_dimension_get_linetype_scale (dimension));
         }
         if (dxf_dimension_get_visibility (dimension) != 0)
         {
-                fprintf (fp->fp, " 60\n%d\n", dxf_dimension_get_visibility (dimension));
+                dxf_write_int (fp, 60, dxf_dimension_get_visibility (dimension));
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbDimension\n");
+                dxf_write_string (fp, 100, "AcDbDimension");
         }
-        fprintf (fp->fp, "  2\n%s\n", dxf_dimension_get_dimblock_name (dimension));
-        fprintf (fp->fp, " 10\n%f\n", dxf_dimension_get_x0 (dimension));
-        fprintf (fp->fp, " 20\n%f\n", dxf_dimension_get_y0 (dimension));
-        fprintf (fp->fp, " 30\n%f\n", dxf_dimension_get_z0 (dimension));
-        fprintf (fp->fp, " 11\n%f\n", dxf_dimension_get_x1 (dimension));
-        fprintf (fp->fp, " 21\n%f\n", dxf_dimension_get_y1 (dimension));
-        fprintf (fp->fp, " 31\n%f\n", dxf_dimension_get_z1 (dimension));
-        fprintf (fp->fp, " 70\n%d\n", dxf_dimension_get_flag (dimension));
+        dxf_write_string (fp, 2, dxf_dimension_get_dimblock_name (dimension));
+        dxf_write_double (fp, 10, dxf_dimension_get_x0 (dimension));
+        dxf_write_double (fp, 20, dxf_dimension_get_y0 (dimension));
+        dxf_write_double (fp, 30, dxf_dimension_get_z0 (dimension));
+        dxf_write_double (fp, 11, dxf_dimension_get_x1 (dimension));
+        dxf_write_double (fp, 21, dxf_dimension_get_y1 (dimension));
+        dxf_write_double (fp, 31, dxf_dimension_get_z1 (dimension));
+        dxf_write_int (fp, 70, dxf_dimension_get_flag (dimension));
         if (fp->acad_version_number >= AutoCAD_2000)
         {
-                fprintf (fp->fp, " 71\n%d\n", dxf_dimension_get_attachment_point (dimension));
-                fprintf (fp->fp, " 72\n%d\n", dxf_dimension_get_text_line_spacing (dimension));
-                fprintf (fp->fp, " 41\n%f\n", dxf_dimension_get_text_line_spacing_factor (dimension));
-                fprintf (fp->fp, " 42\n%f\n", dxf_dimension_get_actual_measurement (dimension));
-        }
-        fprintf (fp->fp, "  1\n%s\n", dxf_dimension_get_dim_text (dimension));
-        fprintf (fp->fp, " 53\n%f\n", dxf_dimension_get_text_angle (dimension));
-        fprintf (fp->fp, " 51\n%f\n", dxf_dimension_get_hor_dir (dimension));
-        fprintf (fp->fp, "210\n%fn", dxf_dimension_get_extr_x0 (dimension));
-        fprintf (fp->fp, "220\n%fn", dxf_dimension_get_extr_y0 (dimension));
-        fprintf (fp->fp, "230\n%fn", dxf_dimension_get_extr_z0 (dimension));
-        fprintf (fp->fp, "  3\n%s\n", dxf_dimension_get_dimstyle_name (dimension));
+                dxf_write_int (fp, 71, dxf_dimension_get_attachment_point (dimension));
+                dxf_write_int (fp, 72, dxf_dimension_get_text_line_spacing (dimension));
+                dxf_write_double (fp, 41, dxf_dimension_get_text_line_spacing_factor (dimension));
+                dxf_write_double (fp, 42, dxf_dimension_get_actual_measurement (dimension));
+        }
+        dxf_write_string (fp, 1, dxf_dimension_get_dim_text (dimension));
+        dxf_write_double (fp, 53, dxf_dimension_get_text_angle (dimension));
+        dxf_write_double (fp, 51, dxf_dimension_get_hor_dir (dimension));
+        dxf_write_double (fp, 210, dxf_dimension_get_extr_x0 (dimension));
+        dxf_write_double (fp, 220, dxf_dimension_get_extr_y0 (dimension));
+        dxf_write_double (fp, 230, dxf_dimension_get_extr_z0 (dimension));
+        dxf_write_string (fp, 3, dxf_dimension_get_dimstyle_name (dimension));
         /* Rotated, horizontal, or vertical dimension. */
         if (dxf_dimension_get_flag (dimension) == 0)
         {
                 if (fp->acad_version_number >= AutoCAD_13)
                 {
-                        fprintf (fp->fp, "100\nAcDbAlignedDimension\n");
+                        dxf_write_string (fp, 100, "AcDbAlignedDimension");
                 }
-                fprintf (fp->fp, " 12\n%f\n", dxf_dimension_get_x2 (dimension));
-                fprintf (fp->fp, " 22\n%f\n", dxf_dimension_get_y2 (dimension));
-                fprintf (fp->fp, " 32\n%f\n", dxf_dimension_get_z2 (dimension));
-                fprintf (fp->fp, " 13\n%f\n", dxf_dimension_get_x3 (dimension));
-                fprintf (fp->fp, " 23\n%f\n", dxf_dimension_get_y3 (dimension));
-                fprintf (fp->fp, " 33\n%f\n", dxf_dimension_get_z3 (dimension));
-                fprintf (fp->fp, " 14\n%f\n", dxf_dimension_get_x4 (dimension));
-                fprintf (fp->fp, " 24\n%f\n", dxf_dimension_get_y4 (dimension));
-                fprintf (fp->fp, " 34\n%f\n", dxf_dimension_get_z4 (dimension));
-                fprintf (fp->fp, " 50\n%f\n", dxf_dimension_get_angle (dimension));
-                fprintf (fp->fp, " 52\n%f\n", dxf_dimension_get_obl_angle (dimension));
+                dxf_write_double (fp, 12, dxf_dimension_get_x2 (dimension));
+                dxf_write_double (fp, 22, dxf_dimension_get_y2 (dimension));
+                dxf_write_double (fp, 32, dxf_dimension_get_z2 (dimension));
+                dxf_write_double (fp, 13, dxf_dimension_get_x3 (dimension));
+                dxf_write_double (fp, 23, dxf_dimension_get_y3 (dimension));
+                dxf_write_double (fp, 33, dxf_dimension_get_z3 (dimension));
+                dxf_write_double (fp, 14, dxf_dimension_get_x4 (dimension));
+                dxf_write_double (fp, 24, dxf_dimension_get_y4 (dimension));
+                dxf_write_double (fp, 34, dxf_dimension_get_z4 (dimension));
+                dxf_write_double (fp, 50, dxf_dimension_get_angle (dimension));
+                dxf_write_double (fp, 52, dxf_dimension_get_obl_angle (dimension));
                 if (fp->acad_version_number >= AutoCAD_13)
                 {
-                        fprintf (fp->fp, "100\nAcDbRotatedDimension\n");
+                        dxf_write_string (fp, 100, "AcDbRotatedDimension");
                 }
         }
         /* Aligned dimension. */
@@ -802,103 +719,103 @@ dxf_dimension_write
         {
                 if (fp->acad_version_number >= AutoCAD_13)
                 {
-                        fprintf (fp->fp, "100\nAcDbAlignedDimension\n");
+                        dxf_write_string (fp, 100, "AcDbAlignedDimension");
                 }
-                fprintf (fp->fp, " 12\n%f\n", dxf_dimension_get_x2 (dimension));
-                fprintf (fp->fp, " 22\n%f\n", dxf_dimension_get_y2 (dimension));
-                fprintf (fp->fp, " 32\n%f\n", dxf_dimension_get_z2 (dimension));
-                fprintf (fp->fp, " 13\n%f\n", dxf_dimension_get_x3 (dimension));
-                fprintf (fp->fp, " 23\n%f\n", dxf_dimension_get_y3 (dimension));
-                fprintf (fp->fp, " 33\n%f\n", dxf_dimension_get_z3 (dimension));
-                fprintf (fp->fp, " 14\n%f\n", dxf_dimension_get_x4 (dimension));
-                fprintf (fp->fp, " 24\n%f\n", dxf_dimension_get_y4 (dimension));
-                fprintf (fp->fp, " 34\n%f\n", dxf_dimension_get_z4 (dimension));
-                fprintf (fp->fp, " 50\n%f\n", dxf_dimension_get_angle (dimension));
+                dxf_write_double (fp, 12, dxf_dimension_get_x2 (dimension));
+                dxf_write_double (fp, 22, dxf_dimension_get_y2 (dimension));
+                dxf_write_double (fp, 32, dxf_dimension_get_z2 (dimension));
+                dxf_write_double (fp, 13, dxf_dimension_get_x3 (dimension));
+                dxf_write_double (fp, 23, dxf_dimension_get_y3 (dimension));
+                dxf_write_double (fp, 33, dxf_dimension_get_z3 (dimension));
+                dxf_write_double (fp, 14, dxf_dimension_get_x4 (dimension));
+                dxf_write_double (fp, 24, dxf_dimension_get_y4 (dimension));
+                dxf_write_double (fp, 34, dxf_dimension_get_z4 (dimension));
+                dxf_write_double (fp, 50, dxf_dimension_get_angle (dimension));
         }
         /* Angular dimension. */
         else if (dxf_dimension_get_flag (dimension) == 2)
         {
                 if (fp->acad_version_number >= AutoCAD_13)
                 {
-                        fprintf (fp->fp, "100\nAcDb3PointAngularDimension\n");
+                        dxf_write_string (fp, 100, "AcDb3PointAngularDimension");
                 }
-                fprintf (fp->fp, " 13\n%f\n", dxf_dimension_get_x3 (dimension));
-                fprintf (fp->fp, " 23\n%f\n", dxf_dimension_get_y3 (dimension));
-                fprintf (fp->fp, " 33\n%f\n", dxf_dimension_get_z3 (dimension));
-                fprintf (fp->fp, " 14\n%f\n", dxf_dimension_get_x4 (dimension));
-                fprintf (fp->fp, " 24\n%f\n", dxf_dimension_get_y4 (dimension));
-                fprintf (fp->fp, " 34\n%f\n", dxf_dimension_get_z4 (dimension));
-                fprintf (fp->fp, " 15\n%f\n", dxf_dimension_get_x5 (dimension));
-                fprintf (fp->fp, " 25\n%f\n", dxf_dimension_get_y5 (dimension));
-                fprintf (fp->fp, " 35\n%f\n", dxf_dimension_get_z5 (dimension));
-                fprintf (fp->fp, " 16\n%f\n", dxf_dimension_get_x6 (dimension));
-                fprintf (fp->fp, " 26\n%f\n", dxf_dimension_get_y6 (dimension));
-                fprintf (fp->fp, " 36\n%f\n", dxf_dimension_get_z6 (dimension));
+                dxf_write_double (fp, 13, dxf_dimension_get_x3 (dimension));
+                dxf_write_double (fp, 23, dxf_dimension_get_y3 (dimension));
+                dxf_write_double (fp, 33, dxf_dimension_get_z3 (dimension));
+                dxf_write_double (fp, 14, dxf_dimension_get_x4 (dimension));
+                dxf_write_double (fp, 24, dxf_dimension_get_y4 (dimension));
+                dxf_write_double (fp, 34, dxf_dimension_get_z4 (dimension));
+                dxf_write_double (fp, 15, dxf_dimension_get_x5 (dimension));
+                dxf_write_double (fp, 25, dxf_dimension_get_y5 (dimension));
+                dxf_write_double (fp, 35, dxf_dimension_get_z5 (dimension));
+                dxf_write_double (fp, 16, dxf_dimension_get_x6 (dimension));
+                dxf_write_double (fp, 26, dxf_dimension_get_y6 (dimension));
+                dxf_write_double (fp, 36, dxf_dimension_get_z6 (dimension));
         }
         /* Diameter dimension. */
         else if (dxf_dimension_get_flag (dimension) == 3)
         {
                 if (fp->acad_version_number >= AutoCAD_13)
                 {
-                        fprintf (fp->fp, "100\nAcDbDiametricDimension\n");
+                        dxf_write_string (fp, 100, "AcDbDiametricDimension");
                 }
-                fprintf (fp->fp, " 15\n%f\n", dxf_dimension_get_x5 (dimension));
-                fprintf (fp->fp, " 25\n%f\n", dxf_dimension_get_y5 (dimension));
-                fprintf (fp->fp, " 35\n%f\n", dxf_dimension_get_z5 (dimension));
-                fprintf (fp->fp, " 40\n%f\n", dxf_dimension_get_leader_length (dimension));
+                dxf_write_double (fp, 15, dxf_dimension_get_x5 (dimension));
+                dxf_write_double (fp, 25, dxf_dimension_get_y5 (dimension));
+                dxf_write_double (fp, 35, dxf_dimension_get_z5 (dimension));
+                dxf_write_double (fp, 40, dxf_dimension_get_leader_length (dimension));
         }
         /* Radius dimension. */
         else if (dxf_dimension_get_flag (dimension) == 4)
         {
                 if (fp->acad_version_number >= AutoCAD_13)
                 {
-                        fprintf (fp->fp, "100\nAcDbRadialDimension\n");
+                        dxf_write_string (fp, 100, "AcDbRadialDimension");
                 }
-                fprintf (fp->fp, " 15\n%f\n", dxf_dimension_get_x5 (dimension));
-                fprintf (fp->fp, " 25\n%f\n", dxf_dimension_get_y5 (dimension));
-                fprintf (fp->fp, " 35\n%f\n", dxf_dimension_get_z5 (dimension));
-                fprintf (fp->fp, " 40\n%f\n", dxf_dimension_get_leader_length (dimension));
+                dxf_write_double (fp, 15, dxf_dimension_get_x5 (dimension));
+                dxf_write_double (fp, 25, dxf_dimension_get_y5 (dimension));
+                dxf_write_double (fp, 35, dxf_dimension_get_z5 (dimension));
+                dxf_write_double (fp, 40, dxf_dimension_get_leader_length (dimension));
         }
         /* Angular 3-point dimension. */
         else if (dxf_dimension_get_flag (dimension) == 5)
         {
                 if (fp->acad_version_number >= AutoCAD_13)
                 {
-                        fprintf (fp->fp, "100\nAcDb3PointAngularDimension\n");
+                        dxf_write_string (fp, 100, "AcDb3PointAngularDimension");
                 }
-                fprintf (fp->fp, " 13\n%f\n", dxf_dimension_get_x3 (dimension));
-                fprintf (fp->fp, " 23\n%f\n", dxf_dimension_get_y3 (dimension));
-                fprintf (fp->fp, " 33\n%f\n", dxf_dimension_get_z3 (dimension));
-                fprintf (fp->fp, " 14\n%f\n", dxf_dimension_get_x4 (dimension));
-                fprintf (fp->fp, " 24\n%f\n", dxf_dimension_get_y4 (dimension));
-                fprintf (fp->fp, " 34\n%f\n", dxf_dimension_get_z4 (dimension));
-                fprintf (fp->fp, " 15\n%f\n", dxf_dimension_get_x5 (dimension));
-                fprintf (fp->fp, " 25\n%f\n", dxf_dimension_get_y5 (dimension));
-                fprintf (fp->fp, " 35\n%f\n", dxf_dimension_get_z5 (dimension));
-                fprintf (fp->fp, " 16\n%f\n", dxf_dimension_get_x6 (dimension));
-                fprintf (fp->fp, " 26\n%f\n", dxf_dimension_get_y6 (dimension));
-                fprintf (fp->fp, " 36\n%f\n", dxf_dimension_get_z6 (dimension));
+                dxf_write_double (fp, 13, dxf_dimension_get_x3 (dimension));
+                dxf_write_double (fp, 23, dxf_dimension_get_y3 (dimension));
+                dxf_write_double (fp, 33, dxf_dimension_get_z3 (dimension));
+                dxf_write_double (fp, 14, dxf_dimension_get_x4 (dimension));
+                dxf_write_double (fp, 24, dxf_dimension_get_y4 (dimension));
+                dxf_write_double (fp, 34, dxf_dimension_get_z4 (dimension));
+                dxf_write_double (fp, 15, dxf_dimension_get_x5 (dimension));
+                dxf_write_double (fp, 25, dxf_dimension_get_y5 (dimension));
+                dxf_write_double (fp, 35, dxf_dimension_get_z5 (dimension));
+                dxf_write_double (fp, 16, dxf_dimension_get_x6 (dimension));
+                dxf_write_double (fp, 26, dxf_dimension_get_y6 (dimension));
+                dxf_write_double (fp, 36, dxf_dimension_get_z6 (dimension));
         }
         /* Ordinate dimension. */
         else if (dxf_dimension_get_flag (dimension) == 6)
         {
                 if (fp->acad_version_number >= AutoCAD_13)
                 {
-                        fprintf (fp->fp, "100\nAcDbOrdinateDimension\n");
+                        dxf_write_string (fp, 100, "AcDbOrdinateDimension");
                 }
-                fprintf (fp->fp, " 13\n%f\n", dxf_dimension_get_x3 (dimension));
-                fprintf (fp->fp, " 23\n%f\n", dxf_dimension_get_y3 (dimension));
-                fprintf (fp->fp, " 33\n%f\n", dxf_dimension_get_z3 (dimension));
-                fprintf (fp->fp, " 14\n%f\n", dxf_dimension_get_x4 (dimension));
-                fprintf (fp->fp, " 24\n%f\n", dxf_dimension_get_y4 (dimension));
-                fprintf (fp->fp, " 34\n%f\n", dxf_dimension_get_z4 (dimension));
+                dxf_write_double (fp, 13, dxf_dimension_get_x3 (dimension));
+                dxf_write_double (fp, 23, dxf_dimension_get_y3 (dimension));
+                dxf_write_double (fp, 33, dxf_dimension_get_z3 (dimension));
+                dxf_write_double (fp, 14, dxf_dimension_get_x4 (dimension));
+                dxf_write_double (fp, 24, dxf_dimension_get_y4 (dimension));
+                dxf_write_double (fp, 34, dxf_dimension_get_z4 (dimension));
         }
         if (dxf_dimension_get_thickness (dimension) != 0.0)
         {
-                fprintf (fp->fp, " 39\n%f\n", dxf_dimension_get_thickness (dimension));
+                dxf_write_double (fp, 39, dxf_dimension_get_thickness (dimension));
         }
         /* Clean up. */
-        free (dxf_entity_name);
+        dxf_free (dxf_entity_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -931,14 +848,20 @@ dxf_dimension_free
                 __FUNCTION__);
               return (EXIT_FAILURE);
         }
-        free (dimension->linetype);
-        free (dimension->layer);
-        free (dimension->dim_text);
-        free (dimension->dimblock_name);
-        free (dimension->dimstyle_name);
-        free (dimension->dictionary_owner_soft);
-        free (dimension->dictionary_owner_hard);
-        free (dimension);
+        dxf_graphic_properties_free (dimension->properties);
+        dxf_free (dimension->dim_text);
+        dxf_free (dimension->dimblock_name);
+        dxf_free (dimension->dimstyle_name);
+        dxf_free (dimension->dictionary_owner_soft);
+        dxf_free (dimension->dictionary_owner_hard);
+        dxf_point_free (dimension->p0);
+        dxf_point_free (dimension->p1);
+        dxf_point_free (dimension->p2);
+        dxf_point_free (dimension->p3);
+        dxf_point_free (dimension->p4);
+        dxf_point_free (dimension->p5);
+        dxf_point_free (dimension->p6);
+        dxf_free (dimension);
         dimension = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -958,7 +881,7 @@ dxf_dimension_free_chain
                 /*!< pointer to the chain of DXF \c DIMENSION entities. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (dimensions == NULL)
@@ -985,7 +908,7 @@ dxf_dimension_free_chain
  *
  * \return \c id_code, or \c DXF_ERROR when an error occurred.
  */
-int
+long
 dxf_dimension_get_id_code
 (
         DxfDimension *dimension
@@ -1028,7 +951,7 @@ dxf_dimension_set_id_code
 (
         DxfDimension *dimension,
                 /*!< a pointer to a DXF \c DIMENSION entity. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -1083,7 +1006,7 @@ dxf_dimension_get_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        if (dimension->linetype ==  NULL)
+        if (dimension->properties->linetype ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the linetype member.\n")),
@@ -1093,7 +1016,7 @@ dxf_dimension_get_linetype
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (dimension->linetype));
+        return (dxf_strdup (dimension->properties->linetype));
 }
 
 
@@ -1130,7 +1053,12 @@ dxf_dimension_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        dimension->linetype = strdup (linetype);
+        if (dxf_graphic_properties_unshare (&dimension->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (dimension->properties->linetype);
+        dimension->properties->linetype = dxf_strdup (linetype);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1161,7 +1089,7 @@ dxf_dimension_get_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        if (dimension->layer ==  NULL)
+        if (dimension->properties->layer ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the layer member.\n")),
@@ -1171,7 +1099,7 @@ dxf_dimension_get_layer
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (dimension->layer));
+        return (dxf_strdup (dimension->properties->layer));
 }
 
 
@@ -1208,7 +1136,12 @@ dxf_dimension_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        dimension->layer = strdup (layer);
+        if (dxf_graphic_properties_unshare (&dimension->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (dimension->properties->layer);
+        dimension->properties->layer = dxf_strdup (layer);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1242,7 +1175,7 @@ dxf_dimension_get_elevation
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (dimension->elevation);
+        return (dimension->properties->elevation);
 }
 
 
@@ -1272,7 +1205,11 @@ dxf_dimension_set_elevation
                   __FUNCTION__);
                 return (NULL);
         }
-        dimension->elevation = elevation;
+        if (dxf_graphic_properties_unshare (&dimension->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dimension->properties->elevation = elevation;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1303,7 +1240,7 @@ dxf_dimension_get_thickness
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (dimension->thickness < 0.0)
+        if (dimension->properties->thickness < 0.0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found in the thickness member.\n")),
@@ -1313,7 +1250,7 @@ dxf_dimension_get_thickness
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (dimension->thickness);
+        return (dimension->properties->thickness);
 }
 
 
@@ -1350,7 +1287,11 @@ dxf_dimension_set_thickness
                   __FUNCTION__);
                 return (NULL);
         }
-        dimension->thickness = thickness;
+        if (dxf_graphic_properties_unshare (&dimension->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dimension->properties->thickness = thickness;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1381,7 +1322,7 @@ dxf_dimension_get_linetype_scale
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (dimension->linetype_scale < 0.0)
+        if (dimension->properties->linetype_scale < 0.0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found in the linetype scale member.\n")),
@@ -1391,7 +1332,7 @@ dxf_dimension_get_linetype_scale
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (dimension->linetype_scale);
+        return (dimension->properties->linetype_scale);
 }
 
 
@@ -1428,7 +1369,11 @@ dxf_dimension_set_linetype_scale
                   __FUNCTION__);
                 return (NULL);
         }
-        dimension->linetype_scale = linetype_scale;
+        if (dxf_graphic_properties_unshare (&dimension->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dimension->properties->linetype_scale = linetype_scale;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1459,14 +1404,14 @@ dxf_dimension_get_visibility
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (dimension->visibility < 0)
+        if (dimension->properties->visibility < 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found in the visibility member.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (dimension->visibility > 1)
+        if (dimension->properties->visibility > 1)
         {
                 fprintf (stderr,
                   (_("Error in %s () an out of range value was found in the visibility member.\n")),
@@ -1476,7 +1421,7 @@ dxf_dimension_get_visibility
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (dimension->visibility);
+        return (dimension->properties->visibility);
 }
 
 
@@ -1520,7 +1465,11 @@ dxf_dimension_set_visibility
                   __FUNCTION__);
                 return (NULL);
         }
-        dimension->visibility = visibility;
+        if (dxf_graphic_properties_unshare (&dimension->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dimension->properties->visibility = visibility;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1551,7 +1500,7 @@ dxf_dimension_get_color
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (dimension->color < 0)
+        if (dimension->properties->color < 0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found in the color member.\n")),
@@ -1560,7 +1509,7 @@ dxf_dimension_get_color
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (dimension->color);
+        return (dimension->properties->color);
 }
 
 
@@ -1598,7 +1547,11 @@ dxf_dimension_set_color
                 fprintf (stderr,
                   (_("\teffectively turning this entity it's visibility off.\n")));
         }
-        dimension->color = color;
+        if (dxf_graphic_properties_unshare (&dimension->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dimension->properties->color = color;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1630,13 +1583,13 @@ dxf_dimension_get_paperspace
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (dimension->paperspace < 0)
+        if (dimension->properties->paperspace < 0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found in the paperspace member.\n")),
                   __FUNCTION__);
         }
-        if (dimension->paperspace > 1)
+        if (dimension->properties->paperspace > 1)
         {
                 fprintf (stderr,
                   (_("Warning in %s () an out of range value was found in the paperspace member.\n")),
@@ -1645,7 +1598,7 @@ dxf_dimension_get_paperspace
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (dimension->paperspace);
+        return (dimension->properties->paperspace);
 }
 
 
@@ -1689,7 +1642,11 @@ dxf_dimension_set_paperspace
                   __FUNCTION__);
                 return (NULL);
         }
-        dimension->paperspace = paperspace;
+        if (dxf_graphic_properties_unshare (&dimension->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dimension->properties->paperspace = paperspace;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1813,14 +1770,14 @@ dxf_dimension_get_shadow_mode
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (dimension->shadow_mode < 0)
+        if (dimension->properties->shadow_mode < 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found in the shadow_mode member.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (dimension->shadow_mode > 3)
+        if (dimension->properties->shadow_mode > 3)
         {
                 fprintf (stderr,
                   (_("Error in %s () an out of range value was found in the shadow_mode member.\n")),
@@ -1830,7 +1787,7 @@ dxf_dimension_get_shadow_mode
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (dimension->shadow_mode);
+        return (dimension->properties->shadow_mode);
 }
 
 
@@ -1874,7 +1831,11 @@ dxf_dimension_set_shadow_mode
                   __FUNCTION__);
                 return (NULL);
         }
-        dimension->shadow_mode = shadow_mode;
+        if (dxf_graphic_properties_unshare (&dimension->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dimension->properties->shadow_mode = shadow_mode;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2003,7 +1964,7 @@ dxf_dimension_get_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (dimension->dictionary_owner_soft));
+        return (dxf_strdup (dimension->dictionary_owner_soft));
 }
 
 
@@ -2042,7 +2003,7 @@ dxf_dimension_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        dimension->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        dimension->dictionary_owner_soft = dxf_strdup (dictionary_owner_soft);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2076,7 +2037,7 @@ dxf_dimension_get_material
                   __FUNCTION__);
                 return (NULL);
         }
-        if (dimension->material ==  NULL)
+        if (dimension->properties->material ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the material member.\n")),
@@ -2086,7 +2047,7 @@ dxf_dimension_get_material
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (dimension->material));
+        return (dxf_strdup (dimension->properties->material));
 }
 
 
@@ -2125,7 +2086,12 @@ dxf_dimension_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        dimension->material = strdup (material);
+        if (dxf_graphic_properties_unshare (&dimension->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (dimension->properties->material);
+        dimension->properties->material = dxf_strdup (material);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2170,7 +2136,7 @@ dxf_dimension_get_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (dimension->dictionary_owner_hard));
+        return (dxf_strdup (dimension->dictionary_owner_hard));
 }
 
 
@@ -2209,7 +2175,7 @@ dxf_dimension_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        dimension->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        dimension->dictionary_owner_hard = dxf_strdup (dictionary_owner_hard);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2244,7 +2210,7 @@ dxf_dimension_get_lineweight
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (dimension->lineweight);
+        return (dimension->properties->lineweight);
 }
 
 
@@ -2274,7 +2240,11 @@ dxf_dimension_set_lineweight
                   __FUNCTION__);
                 return (NULL);
         }
-        dimension->lineweight = lineweight;
+        if (dxf_graphic_properties_unshare (&dimension->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dimension->properties->lineweight = lineweight;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2306,7 +2276,7 @@ dxf_dimension_get_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        if (dimension->plot_style_name ==  NULL)
+        if (dimension->properties->plot_style_name ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the plot_style_name member.\n")),
@@ -2316,7 +2286,7 @@ dxf_dimension_get_plot_style_name
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (dimension->plot_style_name));
+        return (dxf_strdup (dimension->properties->plot_style_name));
 }
 
 
@@ -2354,7 +2324,12 @@ dxf_dimension_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        dimension->plot_style_name = strdup (plot_style_name);
+        if (dxf_graphic_properties_unshare (&dimension->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (dimension->properties->plot_style_name);
+        dimension->properties->plot_style_name = dxf_strdup (plot_style_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2389,7 +2364,7 @@ dxf_dimension_get_color_value
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (dimension->color_value);
+        return (dimension->properties->color_value);
 }
 
 
@@ -2419,7 +2394,11 @@ dxf_dimension_set_color_value
                   __FUNCTION__);
                 return (NULL);
         }
-        dimension->color_value = color_value;
+        if (dxf_graphic_properties_unshare (&dimension->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dimension->properties->color_value = color_value;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2451,7 +2430,7 @@ dxf_dimension_get_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        if (dimension->color_name ==  NULL)
+        if (dimension->properties->color_name ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the color_name member.\n")),
@@ -2461,7 +2440,7 @@ dxf_dimension_get_color_name
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (dimension->color_name));
+        return (dxf_strdup (dimension->properties->color_name));
 }
 
 
@@ -2499,7 +2478,12 @@ dxf_dimension_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        dimension->color_name = strdup (color_name);
+        if (dxf_graphic_properties_unshare (&dimension->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (dimension->properties->color_name);
+        dimension->properties->color_name = dxf_strdup (color_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2534,7 +2518,7 @@ dxf_dimension_get_transparency
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (dimension->transparency);
+        return (dimension->properties->transparency);
 }
 
 
@@ -2564,7 +2548,11 @@ dxf_dimension_set_transparency
                   __FUNCTION__);
                 return (NULL);
         }
-        dimension->transparency = transparency;
+        if (dxf_graphic_properties_unshare (&dimension->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dimension->properties->transparency = transparency;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2606,7 +2594,7 @@ dxf_dimension_get_dim_text
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (dimension->dim_text));
+        return (dxf_strdup (dimension->dim_text));
 }
 
 
@@ -2643,7 +2631,7 @@ dxf_dimension_set_dim_text
                   __FUNCTION__);
                 return (NULL);
         }
-        dimension->dim_text = strdup (dim_text);
+        dimension->dim_text = dxf_strdup (dim_text);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2685,7 +2673,7 @@ dxf_dimension_get_dimblock_name
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (dimension->dimblock_name));
+        return (dxf_strdup (dimension->dimblock_name));
 }
 
 
@@ -2722,7 +2710,8 @@ dxf_dimension_set_dimblock_name
                   __FUNCTION__);
                 return (NULL);
         }
-        dimension->dimblock_name = strdup (dimblock_name);
+        dxf_free (dimension->dimblock_name);
+        dimension->dimblock_name = dxf_strdup (dimblock_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2764,7 +2753,7 @@ dxf_dimension_get_dimstyle_name
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (dimension->dimstyle_name));
+        return (dxf_strdup (dimension->dimstyle_name));
 }
 
 
@@ -2801,7 +2790,8 @@ dxf_dimension_set_dimstyle_name
                   __FUNCTION__);
                 return (NULL);
         }
-        dimension->dimblock_name = strdup (dimstyle_name);
+        dxf_free (dimension->dimstyle_name);
+        dimension->dimstyle_name = dxf_strdup (dimstyle_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2823,7 +2813,7 @@ dxf_dimension_get_p0
                 /*!< a pointer to a DXF \c DIMENSION entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2864,7 +2854,7 @@ dxf_dimension_set_p0
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2904,7 +2894,7 @@ dxf_dimension_get_x0
                 /*!< a pointer to a DXF \c DIMENSION entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2945,7 +2935,7 @@ dxf_dimension_set_x0
                 /*!< the X-value \c x0 of the definition point. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2985,7 +2975,7 @@ dxf_dimension_get_y0
                 /*!< a pointer to a DXF \c DIMENSION entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3026,7 +3016,7 @@ dxf_dimension_set_y0
                 /*!< the Y-value \c y0 of the definition point. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3066,7 +3056,7 @@ dxf_dimension_get_z0
                 /*!< a pointer to a DXF \c DIMENSION entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3107,7 +3097,7 @@ dxf_dimension_set_z0
                 /*!< the Z-value \c z0 of the definition point. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3147,7 +3137,7 @@ dxf_dimension_get_p1
                 /*!< a pointer to a DXF \c DIMENSION entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3188,7 +3178,7 @@ dxf_dimension_set_p1
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3228,7 +3218,7 @@ dxf_dimension_get_x1
                 /*!< a pointer to a DXF \c DIMENSION entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3269,7 +3259,7 @@ dxf_dimension_set_x1
                 /*!< the X-value \c x1 of the middle point. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3309,7 +3299,7 @@ dxf_dimension_get_y1
                 /*!< a pointer to a DXF \c DIMENSION entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3350,7 +3340,7 @@ dxf_dimension_set_y1
                 /*!< the Y-value \c y1 of the middle point. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3391,7 +3381,7 @@ dxf_dimension_get_z1
                 /*!< a pointer to a DXF \c DIMENSION entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3432,7 +3422,7 @@ dxf_dimension_set_z1
                 /*!< the Z-coordinate value \c z1 of the middle point. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3472,7 +3462,7 @@ dxf_dimension_get_p2
                 /*!< a pointer to a DXF \c DIMENSION entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3513,7 +3503,7 @@ dxf_dimension_set_p2
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3553,7 +3543,7 @@ dxf_dimension_get_x2
                 /*!< a pointer to a DXF \c DIMENSION entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3594,7 +3584,7 @@ dxf_dimension_set_x2
                 /*!< the X-value \c x2 of the definition point. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3634,7 +3624,7 @@ dxf_dimension_get_y2
                 /*!< a pointer to a DXF \c DIMENSION entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3676,7 +3666,7 @@ dxf_dimension_set_y2
                  * point. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3716,7 +3706,7 @@ dxf_dimension_get_z2
                 /*!< a pointer to a DXF \c DIMENSION entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3757,7 +3747,7 @@ dxf_dimension_set_z2
                 /*!< the Z-value \c z2 of the definition point. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3797,7 +3787,7 @@ dxf_dimension_get_p3
                 /*!< a pointer to a DXF \c DIMENSION entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3838,7 +3828,7 @@ dxf_dimension_set_p3
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3878,7 +3868,7 @@ dxf_dimension_get_x3
                 /*!< a pointer to a DXF \c DIMENSION entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3920,7 +3910,7 @@ dxf_dimension_set_x3
                  * point. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3960,7 +3950,7 @@ dxf_dimension_get_y3
                 /*!< a pointer to a DXF \c DIMENSION entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -4002,7 +3992,7 @@ dxf_dimension_set_y3
                  * point. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -4042,7 +4032,7 @@ dxf_dimension_get_z3
                 /*!< a pointer to a DXF \c DIMENSION entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -4084,7 +4074,7 @@ dxf_dimension_set_z3
                  * point. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -4124,7 +4114,7 @@ dxf_dimension_get_p4
                 /*!< a pointer to a DXF \c DIMENSION entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -4165,7 +4155,7 @@ dxf_dimension_set_p4
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -4205,7 +4195,7 @@ dxf_dimension_get_x4
                 /*!< a pointer to a DXF \c DIMENSION entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -4246,7 +4236,7 @@ dxf_dimension_set_x4
                 /*!< the X-value \c x4 of the definition point. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -4286,7 +4276,7 @@ dxf_dimension_get_y4
                 /*!< a pointer to a DXF \c DIMENSION entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -4327,7 +4317,7 @@ dxf_dimension_set_y4
                 /*!< the Y-value \c y4 of the definition point. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -4367,7 +4357,7 @@ dxf_dimension_get_z4
                 /*!< a pointer to a DXF \c DIMENSION entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -4408,7 +4398,7 @@ dxf_dimension_set_z4
                 /*!< the Z-value \c z4 of the definition point. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -4448,7 +4438,7 @@ dxf_dimension_get_p5
                 /*!< a pointer to a DXF \c DIMENSION entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -4489,7 +4479,7 @@ dxf_dimension_set_p5
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -4529,7 +4519,7 @@ dxf_dimension_get_x5
                 /*!< a pointer to a DXF \c DIMENSION entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -4570,7 +4560,7 @@ dxf_dimension_set_x5
                 /*!< the X-value \c x5 of the definition point. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -4610,7 +4600,7 @@ dxf_dimension_get_y5
                 /*!< a pointer to a DXF \c DIMENSION entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -4651,7 +4641,7 @@ dxf_dimension_set_y5
                 /*!< the Y-value \c y5 of the definition point. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -4691,7 +4681,7 @@ dxf_dimension_get_z5
                 /*!< a pointer to a DXF \c DIMENSION entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -4732,7 +4722,7 @@ dxf_dimension_set_z5
                 /*!< the Z-value \c z5 of the definition point. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -4772,7 +4762,7 @@ dxf_dimension_get_p6
                 /*!< a pointer to a DXF \c DIMENSION entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -4813,7 +4803,7 @@ dxf_dimension_set_p6
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -4853,7 +4843,7 @@ dxf_dimension_get_x6
                 /*!< a pointer to a DXF \c DIMENSION entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -4894,7 +4884,7 @@ dxf_dimension_set_x6
                 /*!< the X-value \c x6 of the definition point. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -4934,7 +4924,7 @@ dxf_dimension_get_y6
                 /*!< a pointer to a DXF \c DIMENSION entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -4975,7 +4965,7 @@ dxf_dimension_set_y6
                 /*!< the Y-value \c y6 of the definition point. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -5015,7 +5005,7 @@ dxf_dimension_get_z6
                 /*!< a pointer to a DXF \c DIMENSION entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -5056,7 +5046,7 @@ dxf_dimension_set_z6
                 /*!< the Z-value \c z6 of the definition point. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -5816,7 +5806,7 @@ dxf_dimension_get_extr_x0
                 /*!< a pointer to a DXF \c DIMENSION entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -5850,7 +5840,7 @@ dxf_dimension_set_extr_x0
                 /*!< the X-value \c extr_x0 of the extrusion vector. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -5883,7 +5873,7 @@ dxf_dimension_get_extr_y0
                 /*!< a pointer to a DXF \c DIMENSION entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -5917,7 +5907,7 @@ dxf_dimension_set_extr_y0
                 /*!< the Y-value \c extr_y0 of the extrusion vector. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -5950,7 +5940,7 @@ dxf_dimension_get_extr_z0
                 /*!< a pointer to a DXF \c DIMENSION entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -5984,7 +5974,7 @@ dxf_dimension_set_extr_z0
                 /*!< the Z-value \c extr_z0 of the extrusion vector. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -6019,7 +6009,7 @@ dxf_dimension_get_extrusion_vector_as_point
                 /*!< a pointer to a DXF \c DIMENSION entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         DxfPoint *point = NULL;
@@ -39,6 +39,8 @@
 
 
 #include "dimstyle.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -112,12 +114,12 @@ dxf_dimstyle_init
                 __FUNCTION__);
               return (NULL);
         }
-        dxf_dimstyle_set_dimstyle_name (dimstyle, strdup (""));
-        dxf_dimstyle_set_dimpost (dimstyle, strdup (""));
-        dxf_dimstyle_set_dimapost (dimstyle, strdup (""));
-        dxf_dimstyle_set_dimblk (dimstyle, strdup (""));
-        dxf_dimstyle_set_dimblk1 (dimstyle, strdup (""));
-        dxf_dimstyle_set_dimblk2 (dimstyle, strdup (""));
+        dxf_dimstyle_set_dimstyle_name (dimstyle, "");
+        dxf_dimstyle_set_dimpost (dimstyle, "");
+        dxf_dimstyle_set_dimapost (dimstyle, "");
+        dxf_dimstyle_set_dimblk (dimstyle, "");
+        dxf_dimstyle_set_dimblk1 (dimstyle, "");
+        dxf_dimstyle_set_dimblk2 (dimstyle, "");
         dxf_dimstyle_set_dimscale (dimstyle, 0.0);
         dxf_dimstyle_set_dimasz (dimstyle, 0.0);
         dxf_dimstyle_set_dimexo (dimstyle, 0.0);
@@ -228,113 +230,113 @@ dxf_dimstyle_write
         if (fp->acad_version_number < AutoCAD_13)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () illegal DXF version for this %s entity with id-code: %x.\n")),
+                  (_("Warning in %s () illegal DXF version for this %s entity with id-code: %lx.\n")),
                   __FUNCTION__, dxf_entity_name, dimstyle->id_code);
         }
         if (!dxf_dimstyle_get_dimpost (dimstyle))
         {
-                dxf_dimstyle_set_dimpost (dimstyle, strdup (""));
+                dxf_dimstyle_set_dimpost (dimstyle, "");
         }
         if (!dxf_dimstyle_get_dimapost (dimstyle))
         {
-                dxf_dimstyle_set_dimapost (dimstyle, strdup (""));
+                dxf_dimstyle_set_dimapost (dimstyle, "");
         }
         if (!dxf_dimstyle_get_dimblk (dimstyle))
         {
-                dxf_dimstyle_set_dimblk (dimstyle, strdup (""));
+                dxf_dimstyle_set_dimblk (dimstyle, "");
         }
         if (!dxf_dimstyle_get_dimblk1 (dimstyle))
         {
-                dxf_dimstyle_set_dimblk1 (dimstyle, strdup (""));
+                dxf_dimstyle_set_dimblk1 (dimstyle, "");
         }
         if (!dxf_dimstyle_get_dimblk2 (dimstyle))
         {
-                dxf_dimstyle_set_dimblk2 (dimstyle, strdup (""));
+                dxf_dimstyle_set_dimblk2 (dimstyle, "");
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
-        if (dxf_dimstyle_get_id_code (dimstyle) != -1)
+        dxf_write_string (fp, 0, dxf_entity_name);
+        if (dimstyle->id_code != -1)
         {
-                fprintf (fp->fp, "105\n%x\n", dxf_dimstyle_get_id_code (dimstyle));
+                dxf_write_hex (fp, 105, dxf_dimstyle_get_id_code (dimstyle));
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbSymbolTableRecord\n");
+                dxf_write_string (fp, 100, "AcDbSymbolTableRecord");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbDimStyleTableRecord\n");
+                dxf_write_string (fp, 100, "AcDbDimStyleTableRecord");
         }
-        fprintf (fp->fp, "  2\n%s\n", dxf_dimstyle_get_dimstyle_name (dimstyle));
-        fprintf (fp->fp, " 70\n%d\n", dxf_dimstyle_get_flag (dimstyle));
-        fprintf (fp->fp, "  3\n%s\n", dxf_dimstyle_get_dimpost (dimstyle));
-        fprintf (fp->fp, "  4\n%s\n", dxf_dimstyle_get_dimapost (dimstyle));
+        dxf_write_string (fp, 2, dxf_dimstyle_get_dimstyle_name (dimstyle));
+        dxf_write_int (fp, 70, dxf_dimstyle_get_flag (dimstyle));
+        dxf_write_string (fp, 3, dxf_dimstyle_get_dimpost (dimstyle));
+        dxf_write_string (fp, 4, dxf_dimstyle_get_dimapost (dimstyle));
         if (fp->acad_version_number < AutoCAD_2000)
         {
-                fprintf (fp->fp, "  5\n%s\n", dxf_dimstyle_get_dimblk (dimstyle));
+                dxf_write_string (fp, 5, dxf_dimstyle_get_dimblk (dimstyle));
         }
         if (fp->acad_version_number < AutoCAD_2000)
         {
-                fprintf (fp->fp, "  6\n%s\n", dxf_dimstyle_get_dimblk1 (dimstyle));
+                dxf_write_string (fp, 6, dxf_dimstyle_get_dimblk1 (dimstyle));
         }
         if (fp->acad_version_number < AutoCAD_2000)
         {
-                fprintf (fp->fp, "  7\n%s\n", dxf_dimstyle_get_dimblk2 (dimstyle));
-        }
-        fprintf (fp->fp, " 40\n%f\n", dxf_dimstyle_get_dimscale (dimstyle));
-        fprintf (fp->fp, " 41\n%f\n", dxf_dimstyle_get_dimasz (dimstyle));
-        fprintf (fp->fp, " 42\n%f\n", dxf_dimstyle_get_dimexo (dimstyle));
-        fprintf (fp->fp, " 43\n%f\n", dxf_dimstyle_get_dimdli (dimstyle));
-        fprintf (fp->fp, " 44\n%f\n", dxf_dimstyle_get_dimexe (dimstyle));
-        fprintf (fp->fp, " 45\n%f\n", dxf_dimstyle_get_dimrnd (dimstyle));
-        fprintf (fp->fp, " 46\n%f\n", dxf_dimstyle_get_dimdle (dimstyle));
-        fprintf (fp->fp, " 47\n%f\n", dxf_dimstyle_get_dimtp (dimstyle));
-        fprintf (fp->fp, " 48\n%f\n", dxf_dimstyle_get_dimtm (dimstyle));
-        fprintf (fp->fp, "140\n%f\n", dxf_dimstyle_get_dimtxt (dimstyle));
-        fprintf (fp->fp, "141\n%f\n", dxf_dimstyle_get_dimcen (dimstyle));
-        fprintf (fp->fp, "142\n%f\n", dxf_dimstyle_get_dimtsz (dimstyle));
-        fprintf (fp->fp, "143\n%f\n", dxf_dimstyle_get_dimaltf (dimstyle));
-        fprintf (fp->fp, "144\n%f\n", dxf_dimstyle_get_dimlfac (dimstyle));
-        fprintf (fp->fp, "145\n%f\n", dxf_dimstyle_get_dimtvp (dimstyle));
-        fprintf (fp->fp, "146\n%f\n", dxf_dimstyle_get_dimtfac (dimstyle));
-        fprintf (fp->fp, "147\n%f\n", dxf_dimstyle_get_dimgap (dimstyle));
-        fprintf (fp->fp, " 71\n%d\n", dxf_dimstyle_get_dimtol (dimstyle));
-        fprintf (fp->fp, " 72\n%d\n", dxf_dimstyle_get_dimlim (dimstyle));
-        fprintf (fp->fp, " 73\n%d\n", dxf_dimstyle_get_dimtih (dimstyle));
-        fprintf (fp->fp, " 74\n%d\n", dxf_dimstyle_get_dimtoh (dimstyle));
-        fprintf (fp->fp, " 75\n%d\n", dxf_dimstyle_get_dimse1 (dimstyle));
-        fprintf (fp->fp, " 76\n%d\n", dxf_dimstyle_get_dimse2 (dimstyle));
-        fprintf (fp->fp, " 77\n%d\n", dxf_dimstyle_get_dimtad (dimstyle));
-        fprintf (fp->fp, " 78\n%d\n", dxf_dimstyle_get_dimzin (dimstyle));
-        fprintf (fp->fp, "170\n%d\n", dxf_dimstyle_get_dimalt (dimstyle));
-        fprintf (fp->fp, "171\n%d\n", dxf_dimstyle_get_dimaltd (dimstyle));
-        fprintf (fp->fp, "172\n%d\n", dxf_dimstyle_get_dimtofl (dimstyle));
-        fprintf (fp->fp, "173\n%d\n", dxf_dimstyle_get_dimsah (dimstyle));
-        fprintf (fp->fp, "174\n%d\n", dxf_dimstyle_get_dimtix (dimstyle));
-        fprintf (fp->fp, "175\n%d\n", dxf_dimstyle_get_dimsoxd (dimstyle));
-        fprintf (fp->fp, "176\n%d\n", dxf_dimstyle_get_dimclrd (dimstyle));
-        fprintf (fp->fp, "177\n%d\n", dxf_dimstyle_get_dimclre (dimstyle));
-        fprintf (fp->fp, "178\n%d\n", dxf_dimstyle_get_dimclrt (dimstyle));
+                dxf_write_string (fp, 7, dxf_dimstyle_get_dimblk2 (dimstyle));
+        }
+        dxf_write_double (fp, 40, dxf_dimstyle_get_dimscale (dimstyle));
+        dxf_write_double (fp, 41, dxf_dimstyle_get_dimasz (dimstyle));
+        dxf_write_double (fp, 42, dxf_dimstyle_get_dimexo (dimstyle));
+        dxf_write_double (fp, 43, dxf_dimstyle_get_dimdli (dimstyle));
+        dxf_write_double (fp, 44, dxf_dimstyle_get_dimexe (dimstyle));
+        dxf_write_double (fp, 45, dxf_dimstyle_get_dimrnd (dimstyle));
+        dxf_write_double (fp, 46, dxf_dimstyle_get_dimdle (dimstyle));
+        dxf_write_double (fp, 47, dxf_dimstyle_get_dimtp (dimstyle));
+        dxf_write_double (fp, 48, dxf_dimstyle_get_dimtm (dimstyle));
+        dxf_write_double (fp, 140, dxf_dimstyle_get_dimtxt (dimstyle));
+        dxf_write_double (fp, 141, dxf_dimstyle_get_dimcen (dimstyle));
+        dxf_write_double (fp, 142, dxf_dimstyle_get_dimtsz (dimstyle));
+        dxf_write_double (fp, 143, dxf_dimstyle_get_dimaltf (dimstyle));
+        dxf_write_double (fp, 144, dxf_dimstyle_get_dimlfac (dimstyle));
+        dxf_write_double (fp, 145, dxf_dimstyle_get_dimtvp (dimstyle));
+        dxf_write_double (fp, 146, dxf_dimstyle_get_dimtfac (dimstyle));
+        dxf_write_double (fp, 147, dxf_dimstyle_get_dimgap (dimstyle));
+        dxf_write_int (fp, 71, dxf_dimstyle_get_dimtol (dimstyle));
+        dxf_write_int (fp, 72, dxf_dimstyle_get_dimlim (dimstyle));
+        dxf_write_int (fp, 73, dxf_dimstyle_get_dimtih (dimstyle));
+        dxf_write_int (fp, 74, dxf_dimstyle_get_dimtoh (dimstyle));
+        dxf_write_int (fp, 75, dxf_dimstyle_get_dimse1 (dimstyle));
+        dxf_write_int (fp, 76, dxf_dimstyle_get_dimse2 (dimstyle));
+        dxf_write_int (fp, 77, dxf_dimstyle_get_dimtad (dimstyle));
+        dxf_write_int (fp, 78, dxf_dimstyle_get_dimzin (dimstyle));
+        dxf_write_int (fp, 170, dxf_dimstyle_get_dimalt (dimstyle));
+        dxf_write_int (fp, 171, dxf_dimstyle_get_dimaltd (dimstyle));
+        dxf_write_int (fp, 172, dxf_dimstyle_get_dimtofl (dimstyle));
+        dxf_write_int (fp, 173, dxf_dimstyle_get_dimsah (dimstyle));
+        dxf_write_int (fp, 174, dxf_dimstyle_get_dimtix (dimstyle));
+        dxf_write_int (fp, 175, dxf_dimstyle_get_dimsoxd (dimstyle));
+        dxf_write_int (fp, 176, dxf_dimstyle_get_dimclrd (dimstyle));
+        dxf_write_int (fp, 177, dxf_dimstyle_get_dimclre (dimstyle));
+        dxf_write_int (fp, 178, dxf_dimstyle_get_dimclrt (dimstyle));
         if ((fp->acad_version_number >= AutoCAD_13)
           && (fp->acad_version_number < AutoCAD_2000))
         {
-                fprintf (fp->fp, "270\n%d\n", dxf_dimstyle_get_dimunit (dimstyle));
-                fprintf (fp->fp, "271\n%d\n", dxf_dimstyle_get_dimdec (dimstyle));
-                fprintf (fp->fp, "272\n%d\n", dxf_dimstyle_get_dimtdec (dimstyle));
-                fprintf (fp->fp, "273\n%d\n", dxf_dimstyle_get_dimaltu (dimstyle));
-                fprintf (fp->fp, "274\n%d\n", dxf_dimstyle_get_dimalttd (dimstyle));
-                fprintf (fp->fp, "340\n%s\n", dxf_dimstyle_get_dimtxsty (dimstyle));
-                fprintf (fp->fp, "275\n%d\n", dxf_dimstyle_get_dimaunit (dimstyle));
-                fprintf (fp->fp, "280\n%d\n", dxf_dimstyle_get_dimjust (dimstyle));
-                fprintf (fp->fp, "281\n%d\n", dxf_dimstyle_get_dimsd1 (dimstyle));
-                fprintf (fp->fp, "282\n%d\n", dxf_dimstyle_get_dimsd2 (dimstyle));
-                fprintf (fp->fp, "283\n%d\n", dxf_dimstyle_get_dimtolj (dimstyle));
-                fprintf (fp->fp, "284\n%d\n", dxf_dimstyle_get_dimtzin (dimstyle));
-                fprintf (fp->fp, "285\n%d\n", dxf_dimstyle_get_dimaltz (dimstyle));
-                fprintf (fp->fp, "286\n%d\n", dxf_dimstyle_get_dimalttz (dimstyle));
-                fprintf (fp->fp, "287\n%d\n", dxf_dimstyle_get_dimfit (dimstyle));
-                fprintf (fp->fp, "288\n%d\n", dxf_dimstyle_get_dimupt (dimstyle));
-                fprintf (fp->fp, "  0\nENDTAB\n");
+                dxf_write_int (fp, 270, dxf_dimstyle_get_dimunit (dimstyle));
+                dxf_write_int (fp, 271, dxf_dimstyle_get_dimdec (dimstyle));
+                dxf_write_int (fp, 272, dxf_dimstyle_get_dimtdec (dimstyle));
+                dxf_write_int (fp, 273, dxf_dimstyle_get_dimaltu (dimstyle));
+                dxf_write_int (fp, 274, dxf_dimstyle_get_dimalttd (dimstyle));
+                dxf_write_string (fp, 340, dxf_dimstyle_get_dimtxsty (dimstyle));
+                dxf_write_int (fp, 275, dxf_dimstyle_get_dimaunit (dimstyle));
+                dxf_write_int (fp, 280, dxf_dimstyle_get_dimjust (dimstyle));
+                dxf_write_int (fp, 281, dxf_dimstyle_get_dimsd1 (dimstyle));
+                dxf_write_int (fp, 282, dxf_dimstyle_get_dimsd2 (dimstyle));
+                dxf_write_int (fp, 283, dxf_dimstyle_get_dimtolj (dimstyle));
+                dxf_write_int (fp, 284, dxf_dimstyle_get_dimtzin (dimstyle));
+                dxf_write_int (fp, 285, dxf_dimstyle_get_dimaltz (dimstyle));
+                dxf_write_int (fp, 286, dxf_dimstyle_get_dimalttz (dimstyle));
+                dxf_write_int (fp, 287, dxf_dimstyle_get_dimfit (dimstyle));
+                dxf_write_int (fp, 288, dxf_dimstyle_get_dimupt (dimstyle));
+                dxf_write_string (fp, 0, "ENDTAB");
         }
         /* Clean up. */
         free (dxf_entity_name);
@@ -368,7 +370,8 @@ dxf_dimstyle_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfPair pair;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -376,8 +379,6 @@ dxf_dimstyle_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (dimstyle == NULL)
@@ -388,492 +389,355 @@ dxf_dimstyle_read
                 dimstyle = dxf_dimstyle_new ();
                 dimstyle = dxf_dimstyle_init (dimstyle);
         }
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        /* Clean up. */
-                        free (temp_string);
-                        fclose (fp->fp);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "2") == 0)
-                {
-                        /* Now follows a string containing a dimension
-                         * style name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", dimstyle->dimstyle_name);
-                }
-                else if (strcmp (temp_string, "3") == 0)
-                {
-                        /* Now follows a string containing a general
-                         * dimensioning suffix. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", dimstyle->dimpost);
-                }
-                else if (strcmp (temp_string, "4") == 0)
-                {
-                        /* Now follows a string containing an alternate
-                         * dimensioning suffix. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", dimstyle->dimapost);
-                }
-                else if ((fp->acad_version_number < AutoCAD_2000)
-                        && (strcmp (temp_string, "5") == 0))
-                {
-                        /* Now follows a string containing an arrow
-                         * block name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", dimstyle->dimblk);
-                }
-                else if ((fp->acad_version_number < AutoCAD_2000)
-                        && (strcmp (temp_string, "6") == 0))
-                {
-                        /* Now follows a string containing a first arrow
-                         * block name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", dimstyle->dimblk1);
-                }
-#if 0
-/*!
- * \todo For AutoCAD versions > 2000 the value of group code 6 has to be
- * tested before overwriting the id_code.
- */
-                else if ((fp->acad_version_number >= AutoCAD_2000)
-                        && (strcmp (temp_string, "6") == 0))
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &dimstyle->id_code);
-                }
-#endif
-                else if ((fp->acad_version_number < AutoCAD_2000)
-                        && (strcmp (temp_string, "7") == 0))
-                {
-                        /* Now follows a string containing a first arrow
-                         * block name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", dimstyle->dimblk2);
-                }
-#if 0
-/*!
- * \todo For AutoCAD versions > 2000 the value of group code 7 has to be
- * tested before overwriting the id_code.
- */
-                else if ((fp->acad_version_number >= AutoCAD_2000)
-                        && (strcmp (temp_string, "7") == 0))
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &dimstyle->id_code);
-                }
-#endif
-                else if (strcmp (temp_string, "40") == 0)
-                {
-                        /* Now follows a string containing an overall
-                         * dimensioning scale factor. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimstyle->dimscale);
-                }
-                else if (strcmp (temp_string, "41") == 0)
-                {
-                        /* Now follows a string containing a
-                         * dimensioning arrow size. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimstyle->dimasz);
-                }
-                else if (strcmp (temp_string, "42") == 0)
-                {
-                        /* Now follows a string containing a
-                         * extension line offset. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimstyle->dimexo);
-                }
-                else if (strcmp (temp_string, "43") == 0)
-                {
-                        /* Now follows a string containing a
-                         * dimension line increment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimstyle->dimdli);
-                }
-                else if (strcmp (temp_string, "44") == 0)
-                {
-                        /* Now follows a string containing a
-                         * extension line extension. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimstyle->dimexe);
-                }
-                else if (strcmp (temp_string, "45") == 0)
-                {
-                        /* Now follows a string containing a
-                         * rounding value for dimension distances. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimstyle->dimrnd);
-                }
-                else if (strcmp (temp_string, "46") == 0)
-                {
-                        /* Now follows a string containing a
-                         * dimension line extension. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimstyle->dimdle);
-                }
-                else if (strcmp (temp_string, "47") == 0)
-                {
-                        /* Now follows a string containing a
-                         * plus tolerance. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimstyle->dimtp);
-                }
-                else if (strcmp (temp_string, "48") == 0)
-                {
-                        /* Now follows a string containing a
-                         * minus tolerance. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimstyle->dimtm);
-                }
-                else if (strcmp (temp_string, "70") == 0)
-                {
-                        /* Now follows a string containing a flag. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &dimstyle->flag);
-                }
-                else if (strcmp (temp_string, "71") == 0)
-                {
-                        /* Now follows a string containing a dimension
-                         * tolerances flag. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &dimstyle->dimtol);
-                }
-                else if (strcmp (temp_string, "72") == 0)
-                {
-                        /* Now follows a string containing a dimension
-                         * limits flag. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &dimstyle->dimlim);
-                }
-                else if (strcmp (temp_string, "73") == 0)
-                {
-                        /* Now follows a string containing a dimension
-                         * text inside horizontal flag. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &dimstyle->dimtih);
-                }
-                else if (strcmp (temp_string, "74") == 0)
-                {
-                        /* Now follows a string containing a dimension
-                         * text outside horizontal flag. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &dimstyle->dimtoh);
-                }
-                else if (strcmp (temp_string, "75") == 0)
-                {
-                        /* Now follows a string containing a first
-                         * extension line suppression flag. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &dimstyle->dimse1);
-                }
-                else if (strcmp (temp_string, "76") == 0)
-                {
-                        /* Now follows a string containing a second
-                         * extension line suppression flag. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &dimstyle->dimse2);
-                }
-                else if (strcmp (temp_string, "77") == 0)
-                {
-                        /* Now follows a string containing a text above
-                         * dimension line flag. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &dimstyle->dimtad);
-                }
-                else if (strcmp (temp_string, "78") == 0)
-                {
-                        /* Now follows a string containing a zero
-                         * suppression for "feet & inch" dimensions
-                         * flag. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &dimstyle->dimzin);
-                }
-                else if ((fp->acad_version_number >= AutoCAD_13)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if ((strcmp (temp_string, "AcDbSymbolTableRecord") != 0)
-                        && (strcmp (temp_string, "AcDbDimStyleTableRecord") != 0))
-                        {
-                                fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "105") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &dimstyle->id_code);
-                }
-                else if (strcmp (temp_string, "140") == 0)
-                {
-                        /* Now follows a string containing a
-                         * dimensioning text height. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimstyle->dimtxt);
-                }
-                else if (strcmp (temp_string, "141") == 0)
-                {
-                        /* Now follows a string containing a size of
-                         * center mark/lines. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimstyle->dimcen);
-                }
-                else if (strcmp (temp_string, "142") == 0)
-                {
-                        /* Now follows a string containing a
-                         * dimensioning tick size: 0 = no ticks. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimstyle->dimtsz);
-                }
-                else if (strcmp (temp_string, "143") == 0)
-                {
-                        /* Now follows a string containing a
-                         * alternate unit scale factor. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimstyle->dimaltf);
-                }
-                else if (strcmp (temp_string, "144") == 0)
-                {
-                        /* Now follows a string containing a linear
-                         * measurements scale factor. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimstyle->dimlfac);
-                }
-                else if (strcmp (temp_string, "145") == 0)
-                {
-                        /* Now follows a string containing a text
-                         * vertical position. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimstyle->dimtvp);
-                }
-                else if (strcmp (temp_string, "146") == 0)
-                {
-                        /* Now follows a string containing a dimension
-                         * tolerance display scale factor. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimstyle->dimtfac);
-                }
-                else if (strcmp (temp_string, "147") == 0)
-                {
-                        /* Now follows a string containing a dimension
-                         * line gap. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &dimstyle->dimgap);
-                }
-                else if (strcmp (temp_string, "170") == 0)
-                {
-                        /* Now follows a string containing a alternate
-                         * unit dimensioning flag. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &dimstyle->dimalt);
-                }
-                else if (strcmp (temp_string, "171") == 0)
-                {
-                        /* Now follows a string containing a alternate
-                         * unit decimal places. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &dimstyle->dimaltd);
-                }
-                else if (strcmp (temp_string, "172") == 0)
-                {
-                        /* Now follows a string containing a text
-                         * outside extensions, force line extensions
-                         * between extensions flag. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &dimstyle->dimtofl);
-                }
-                else if (strcmp (temp_string, "173") == 0)
-                {
-                        /* Now follows a string containing a use
-                         * separate arrow blocks flag. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &dimstyle->dimsah);
-                }
-                else if (strcmp (temp_string, "174") == 0)
-                {
-                        /* Now follows a string containing a force text
-                         * inside extensions flag. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &dimstyle->dimtix);
-                }
-                else if (strcmp (temp_string, "175") == 0)
-                {
-                        /* Now follows a string containing a suppress
-                         * outside-extensions dimension lines flag. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &dimstyle->dimsoxd);
-                }
-                else if (strcmp (temp_string, "176") == 0)
-                {
-                        /* Now follows a string containing a dimension
-                         * line color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &dimstyle->dimclrd);
-                }
-                else if (strcmp (temp_string, "177") == 0)
-                {
-                        /* Now follows a string containing a dimension
-                         * extension line color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &dimstyle->dimclre);
-                }
-                else if (strcmp (temp_string, "178") == 0)
-                {
-                        /* Now follows a string containing a dimension
-                         * text color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &dimstyle->dimclrt);
-                }
-                else if (strcmp (temp_string, "270") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing a units
-                         * format for all dimension style family members
-                         * except angular. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &dimstyle->dimunit);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else if (strcmp (temp_string, "271") == 0)
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing a number of
-                         * decimal places for the tolerance values of
-                         * a primary units dimension. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &dimstyle->dimdec);
-                }
-                else if (strcmp (temp_string, "272") == 0)
-                {
-                        /* Now follows a string containing a number of
-                         * decimal places to display the tolerance
-                         * values. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &dimstyle->dimtdec);
-                }
-                else if (strcmp (temp_string, "273") == 0)
-                {
-                        /* Now follows a string containing a units
-                         * format for alternate units of all dimension
-                         * style family members except angular. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &dimstyle->dimaltu);
-                }
-                else if (strcmp (temp_string, "274") == 0)
-                {
-                        /* Now follows a string containing a number of
-                         * decimal places for tolerance values of an
-                         * alternate units dimension. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &dimstyle->dimalttd);
-                }
-                else if (strcmp (temp_string, "275") == 0)
-                {
-                        /* Now follows a string containing an angle
-                         * format for angular dimensions. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &dimstyle->dimaunit);
-                }
-                else if (strcmp (temp_string, "280") == 0)
-                {
-                        /* Now follows a string containing a horizontal
-                         * dimension text position. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &dimstyle->dimjust);
-                }
-                else if (strcmp (temp_string, "281") == 0)
-                {
-                        /* Now follows a string containing suppression
-                         * of first extension line. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &dimstyle->dimsd1);
-                }
-                else if (strcmp (temp_string, "282") == 0)
-                {
-                        /* Now follows a string containing suppression
-                         * of second extension line. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &dimstyle->dimsd2);
-                }
-                else if (strcmp (temp_string, "283") == 0)
-                {
-                        /* Now follows a string containing vertical
-                         * justification for tolerance values. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &dimstyle->dimtolj);
-                }
-                else if (strcmp (temp_string, "284") == 0)
-                {
-                        /* Now follows a string containing suppression
-                         * of zeros for tolerance values. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &dimstyle->dimtzin);
-                }
-                else if (strcmp (temp_string, "285") == 0)
-                {
-                        /* Now follows a string containing toggles
-                         * suppression of zeros for alternate unit
-                         * dimension values. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &dimstyle->dimaltz);
-                }
-                else if (strcmp (temp_string, "286") == 0)
-                {
-                        /* Now follows a string containing toggles
-                         * suppression of zeros for tolerance values. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &dimstyle->dimalttz);
-                }
-                else if (strcmp (temp_string, "287") == 0)
-                {
-                        /* Now follows a string containing placement of
-                         * text and arrowheads. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &dimstyle->dimfit);
-                }
-                else if (strcmp (temp_string, "288") == 0)
-                {
-                        /* Now follows a string containing cursor
-                         * functionality for user positioned text. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &dimstyle->dimupt);
-                }
-                else if (strcmp (temp_string, "340") == 0)
-                {
-                        /* Now follows a string containing dimension
-                         * text style. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", dimstyle->dimtxsty);
+                        case 2:
+                                /* Now follows a string containing a dimension
+                                 * style name. */
+                                free (dimstyle->dimstyle_name);
+                                dimstyle->dimstyle_name = dxf_pair_get_string (&pair);
+                                break;
+                        case 3:
+                                /* Now follows a string containing a general
+                                 * dimensioning suffix. */
+                                free (dimstyle->dimpost);
+                                dimstyle->dimpost = dxf_pair_get_string (&pair);
+                                break;
+                        case 4:
+                                /* Now follows a string containing an alternate
+                                 * dimensioning suffix. */
+                                free (dimstyle->dimapost);
+                                dimstyle->dimapost = dxf_pair_get_string (&pair);
+                                break;
+                        case 5:
+                                if (fp->acad_version_number < AutoCAD_2000)
+                                {
+                                        /* Now follows a string containing an arrow
+                                         * block name. */
+                                        free (dimstyle->dimblk);
+                                        dimstyle->dimblk = dxf_pair_get_string (&pair);
+                                }
+                                break;
+                        case 6:
+                                if (fp->acad_version_number < AutoCAD_2000)
+                                {
+                                        /* Now follows a string containing a first arrow
+                                         * block name. */
+                                        free (dimstyle->dimblk1);
+                                        dimstyle->dimblk1 = dxf_pair_get_string (&pair);
+                                }
+                                break;
+                        case 7:
+                                if (fp->acad_version_number < AutoCAD_2000)
+                                {
+                                        /* Now follows a string containing a first arrow
+                                         * block name. */
+                                        free (dimstyle->dimblk2);
+                                        dimstyle->dimblk2 = dxf_pair_get_string (&pair);
+                                }
+                                break;
+                        case 40:
+                                /* Now follows a string containing an overall
+                                 * dimensioning scale factor. */
+                                dimstyle->dimscale = dxf_pair_get_double (&pair);
+                                break;
+                        case 41:
+                                /* Now follows a string containing a
+                                 * dimensioning arrow size. */
+                                dimstyle->dimasz = dxf_pair_get_double (&pair);
+                                break;
+                        case 42:
+                                /* Now follows a string containing a
+                                 * extension line offset. */
+                                dimstyle->dimexo = dxf_pair_get_double (&pair);
+                                break;
+                        case 43:
+                                /* Now follows a string containing a
+                                 * dimension line increment. */
+                                dimstyle->dimdli = dxf_pair_get_double (&pair);
+                                break;
+                        case 44:
+                                /* Now follows a string containing a
+                                 * extension line extension. */
+                                dimstyle->dimexe = dxf_pair_get_double (&pair);
+                                break;
+                        case 45:
+                                /* Now follows a string containing a
+                                 * rounding value for dimension distances. */
+                                dimstyle->dimrnd = dxf_pair_get_double (&pair);
+                                break;
+                        case 46:
+                                /* Now follows a string containing a
+                                 * dimension line extension. */
+                                dimstyle->dimdle = dxf_pair_get_double (&pair);
+                                break;
+                        case 47:
+                                /* Now follows a string containing a
+                                 * plus tolerance. */
+                                dimstyle->dimtp = dxf_pair_get_double (&pair);
+                                break;
+                        case 48:
+                                /* Now follows a string containing a
+                                 * minus tolerance. */
+                                dimstyle->dimtm = dxf_pair_get_double (&pair);
+                                break;
+                        case 70:
+                                /* Now follows a string containing a flag. */
+                                dimstyle->flag = dxf_pair_get_int (&pair);
+                                break;
+                        case 71:
+                                /* Now follows a string containing a dimension
+                                 * tolerances flag. */
+                                dimstyle->dimtol = dxf_pair_get_int (&pair);
+                                break;
+                        case 72:
+                                /* Now follows a string containing a dimension
+                                 * limits flag. */
+                                dimstyle->dimlim = dxf_pair_get_int (&pair);
+                                break;
+                        case 73:
+                                /* Now follows a string containing a dimension
+                                 * text inside horizontal flag. */
+                                dimstyle->dimtih = dxf_pair_get_int (&pair);
+                                break;
+                        case 74:
+                                /* Now follows a string containing a dimension
+                                 * text outside horizontal flag. */
+                                dimstyle->dimtoh = dxf_pair_get_int (&pair);
+                                break;
+                        case 75:
+                                /* Now follows a string containing a first
+                                 * extension line suppression flag. */
+                                dimstyle->dimse1 = dxf_pair_get_int (&pair);
+                                break;
+                        case 76:
+                                /* Now follows a string containing a second
+                                 * extension line suppression flag. */
+                                dimstyle->dimse2 = dxf_pair_get_int (&pair);
+                                break;
+                        case 77:
+                                /* Now follows a string containing a text above
+                                 * dimension line flag. */
+                                dimstyle->dimtad = dxf_pair_get_int (&pair);
+                                break;
+                        case 78:
+                                /* Now follows a string containing a zero
+                                 * suppression for "feet & inch" dimensions
+                                 * flag. */
+                                dimstyle->dimzin = dxf_pair_get_int (&pair);
+                                break;
+                        case 100:
+                                if (fp->acad_version_number >= AutoCAD_13)
+                                {
+                                        /* Now follows a string containing the
+                                         * subclass marker value. */
+                                        dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                        if ((strcmp (temp_string, "AcDbSymbolTableRecord") != 0)
+                                        && (strcmp (temp_string, "AcDbDimStyleTableRecord") != 0))
+                                        {
+                                                fprintf (stderr,
+                                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                                  __FUNCTION__, fp->filename, fp->line_number);
+                                        }
+                                }
+                                break;
+                        case 105:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                dimstyle->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 140:
+                                /* Now follows a string containing a
+                                 * dimensioning text height. */
+                                dimstyle->dimtxt = dxf_pair_get_double (&pair);
+                                break;
+                        case 141:
+                                /* Now follows a string containing a size of
+                                 * center mark/lines. */
+                                dimstyle->dimcen = dxf_pair_get_double (&pair);
+                                break;
+                        case 142:
+                                /* Now follows a string containing a
+                                 * dimensioning tick size: 0 = no ticks. */
+                                dimstyle->dimtsz = dxf_pair_get_double (&pair);
+                                break;
+                        case 143:
+                                /* Now follows a string containing a
+                                 * alternate unit scale factor. */
+                                dimstyle->dimaltf = dxf_pair_get_double (&pair);
+                                break;
+                        case 144:
+                                /* Now follows a string containing a linear
+                                 * measurements scale factor. */
+                                dimstyle->dimlfac = dxf_pair_get_double (&pair);
+                                break;
+                        case 145:
+                                /* Now follows a string containing a text
+                                 * vertical position. */
+                                dimstyle->dimtvp = dxf_pair_get_double (&pair);
+                                break;
+                        case 146:
+                                /* Now follows a string containing a dimension
+                                 * tolerance display scale factor. */
+                                dimstyle->dimtfac = dxf_pair_get_double (&pair);
+                                break;
+                        case 147:
+                                /* Now follows a string containing a dimension
+                                 * line gap. */
+                                dimstyle->dimgap = dxf_pair_get_double (&pair);
+                                break;
+                        case 170:
+                                /* Now follows a string containing a alternate
+                                 * unit dimensioning flag. */
+                                dimstyle->dimalt = dxf_pair_get_int (&pair);
+                                break;
+                        case 171:
+                                /* Now follows a string containing a alternate
+                                 * unit decimal places. */
+                                dimstyle->dimaltd = dxf_pair_get_int (&pair);
+                                break;
+                        case 172:
+                                /* Now follows a string containing a text
+                                 * outside extensions, force line extensions
+                                 * between extensions flag. */
+                                dimstyle->dimtofl = dxf_pair_get_int (&pair);
+                                break;
+                        case 173:
+                                /* Now follows a string containing a use
+                                 * separate arrow blocks flag. */
+                                dimstyle->dimsah = dxf_pair_get_int (&pair);
+                                break;
+                        case 174:
+                                /* Now follows a string containing a force text
+                                 * inside extensions flag. */
+                                dimstyle->dimtix = dxf_pair_get_int (&pair);
+                                break;
+                        case 175:
+                                /* Now follows a string containing a suppress
+                                 * outside-extensions dimension lines flag. */
+                                dimstyle->dimsoxd = dxf_pair_get_int (&pair);
+                                break;
+                        case 176:
+                                /* Now follows a string containing a dimension
+                                 * line color value. */
+                                dimstyle->dimclrd = dxf_pair_get_int (&pair);
+                                break;
+                        case 177:
+                                /* Now follows a string containing a dimension
+                                 * extension line color value. */
+                                dimstyle->dimclre = dxf_pair_get_int (&pair);
+                                break;
+                        case 178:
+                                /* Now follows a string containing a dimension
+                                 * text color value. */
+                                dimstyle->dimclrt = dxf_pair_get_int (&pair);
+                                break;
+                        case 270:
+                                /* Now follows a string containing a units
+                                 * format for all dimension style family members
+                                 * except angular. */
+                                dimstyle->dimunit = dxf_pair_get_int (&pair);
+                                break;
+                        case 271:
+                                /* Now follows a string containing a number of
+                                 * decimal places for the tolerance values of
+                                 * a primary units dimension. */
+                                dimstyle->dimdec = dxf_pair_get_int (&pair);
+                                break;
+                        case 272:
+                                /* Now follows a string containing a number of
+                                 * decimal places to display the tolerance
+                                 * values. */
+                                dimstyle->dimtdec = dxf_pair_get_int (&pair);
+                                break;
+                        case 273:
+                                /* Now follows a string containing a units
+                                 * format for alternate units of all dimension
+                                 * style family members except angular. */
+                                dimstyle->dimaltu = dxf_pair_get_int (&pair);
+                                break;
+                        case 274:
+                                /* Now follows a string containing a number of
+                                 * decimal places for tolerance values of an
+                                 * alternate units dimension. */
+                                dimstyle->dimalttd = dxf_pair_get_int (&pair);
+                                break;
+                        case 275:
+                                /* Now follows a string containing an angle
+                                 * format for angular dimensions. */
+                                dimstyle->dimaunit = dxf_pair_get_int (&pair);
+                                break;
+                        case 280:
+                                /* Now follows a string containing a horizontal
+                                 * dimension text position. */
+                                dimstyle->dimjust = dxf_pair_get_int (&pair);
+                                break;
+                        case 281:
+                                /* Now follows a string containing suppression
+                                 * of first extension line. */
+                                dimstyle->dimsd1 = dxf_pair_get_int (&pair);
+                                break;
+                        case 282:
+                                /* Now follows a string containing suppression
+                                 * of second extension line. */
+                                dimstyle->dimsd2 = dxf_pair_get_int (&pair);
+                                break;
+                        case 283:
+                                /* Now follows a string containing vertical
+                                 * justification for tolerance values. */
+                                dimstyle->dimtolj = dxf_pair_get_int (&pair);
+                                break;
+                        case 284:
+                                /* Now follows a string containing suppression
+                                 * of zeros for tolerance values. */
+                                dimstyle->dimtzin = dxf_pair_get_int (&pair);
+                                break;
+                        case 285:
+                                /* Now follows a string containing toggles
+                                 * suppression of zeros for alternate unit
+                                 * dimension values. */
+                                dimstyle->dimaltz = dxf_pair_get_int (&pair);
+                                break;
+                        case 286:
+                                /* Now follows a string containing toggles
+                                 * suppression of zeros for tolerance values. */
+                                dimstyle->dimalttz = dxf_pair_get_int (&pair);
+                                break;
+                        case 287:
+                                /* Now follows a string containing placement of
+                                 * text and arrowheads. */
+                                dimstyle->dimfit = dxf_pair_get_int (&pair);
+                                break;
+                        case 288:
+                                /* Now follows a string containing cursor
+                                 * functionality for user positioned text. */
+                                dimstyle->dimupt = dxf_pair_get_int (&pair);
+                                break;
+                        case 340:
+                                /* Now follows a string containing dimension
+                                 * text style. */
+                                free (dimstyle->dimtxsty);
+                                dimstyle->dimtxsty = dxf_pair_get_string (&pair);
+                                break;
                 }
         }
         /* Handle omitted members and/or illegal values. */
-        if (strcmp (dxf_dimstyle_get_dimstyle_name (dimstyle), "") == 0)
+        if (strcmp (dimstyle->dimstyle_name, "") == 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () dimstyle_name value is empty.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
-        /* Clean up. */
-        free (temp_string);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -906,12 +770,13 @@ dxf_dimstyle_free
                 __FUNCTION__);
               return (EXIT_FAILURE);
         }
-        free (dxf_dimstyle_get_dimstyle_name (dimstyle));
-        free (dxf_dimstyle_get_dimpost (dimstyle));
-        free (dxf_dimstyle_get_dimapost (dimstyle));
-        free (dxf_dimstyle_get_dimblk (dimstyle));
-        free (dxf_dimstyle_get_dimblk1 (dimstyle));
-        free (dxf_dimstyle_get_dimblk2 (dimstyle));
+        free (dimstyle->dimstyle_name);
+        free (dimstyle->dimpost);
+        free (dimstyle->dimapost);
+        free (dimstyle->dimblk);
+        free (dimstyle->dimblk1);
+        free (dimstyle->dimblk2);
+        free (dimstyle->dimtxsty);
         free (dimstyle);
         dimstyle = NULL;
 #if DEBUG
@@ -933,7 +798,7 @@ dxf_dimstyle_free_chain
                  * tables. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (dimstyles == NULL)
@@ -945,6 +810,7 @@ dxf_dimstyle_free_chain
         while (dimstyles != NULL)
         {
                 struct DxfDimStyle *iter = dimstyles->next;
+                dimstyles->next = NULL;
                 dxf_dimstyle_free (dimstyles);
                 dimstyles = (DxfDimStyle *) iter;
         }
@@ -2675,7 +2541,7 @@ dxf_dimstyle_set_dimzin
  *
  * \return ID code.
  */
-int
+long
 dxf_dimstyle_get_id_code
 (
         DxfDimStyle *dimstyle
@@ -2710,7 +2576,7 @@ dxf_dimstyle_set_id_code
         DxfDimStyle *dimstyle,
                 /*!< a pointer to a DXF dimenstion style symbol table
                  * (\c DIMSTYLE). */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -141,7 +141,7 @@ dxf_dimstyle_struct
         int dimzin;
                 /*!< Zero suppression for "feet & inch" dimensions.\n
                  * Group code = 78. */
-        int id_code;
+        long id_code;
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the
                  * DXF file.\n
@@ -611,7 +611,7 @@ dxf_dimstyle_set_dimzin
         DxfDimStyle *dimstyle,
         int dimzin
 );
-int
+long
 dxf_dimstyle_get_id_code
 (
         DxfDimStyle *dimstyle
@@ -620,7 +620,7 @@ DxfDimStyle *
 dxf_dimstyle_set_id_code
 (
         DxfDimStyle *dimstyle,
-        int id_code
+        long id_code
 );
 double
 dxf_dimstyle_get_dimtxt
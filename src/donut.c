@@ -113,25 +113,11 @@ dxf_donut_init
         }
         /* Members common for all DXF drawable entities. */
         dxf_donut_set_id_code (donut, 0);
-        dxf_donut_set_linetype (donut, strdup (DXF_DEFAULT_LINETYPE));
-        dxf_donut_set_layer (donut, strdup (DXF_DEFAULT_LAYER));
-        dxf_donut_set_elevation (donut, 0.0);
-        dxf_donut_set_thickness (donut, 0.0);
-        dxf_donut_set_linetype_scale (donut, DXF_DEFAULT_LINETYPE_SCALE);
-        dxf_donut_set_visibility (donut, DXF_DEFAULT_VISIBILITY);
-        dxf_donut_set_color (donut, DXF_COLOR_BYLAYER);
-        dxf_donut_set_paperspace (donut, DXF_MODELSPACE);
+        donut->properties = dxf_graphic_properties_default ();
         dxf_donut_set_graphics_data_size (donut, 0);
-        dxf_donut_set_shadow_mode (donut, 0);
         dxf_donut_set_binary_graphics_data (donut, (DxfBinaryGraphicsData *) dxf_binary_graphics_data_new ());
-        dxf_donut_set_dictionary_owner_soft (donut, strdup (""));
-        dxf_donut_set_material (donut, strdup (""));
-        dxf_donut_set_dictionary_owner_hard (donut, strdup (""));
-        dxf_donut_set_lineweight (donut, 0);
-        dxf_donut_set_plot_style_name (donut, strdup (""));
-        dxf_donut_set_color_value (donut, 0);
-        dxf_donut_set_color_name (donut, strdup (""));
-        dxf_donut_set_transparency (donut, 0);
+        dxf_donut_set_dictionary_owner_soft (donut, "");
+        dxf_donut_set_dictionary_owner_hard (donut, "");
         /* Specific members for a libDXF donut. */
         dxf_donut_set_x0 (donut, 0.0);
         dxf_donut_set_y0 (donut, 0.0);
@@ -174,7 +160,7 @@ dxf_donut_write
         char *dxf_entity_name = strdup ("POLYLINE");
         double start_width;
         double end_width;
-        int id_code = -1;
+        long id_code = -1;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -198,7 +184,7 @@ dxf_donut_write
         if (dxf_donut_get_outside_diameter (donut) > dxf_donut_get_inside_diameter (donut))
         {
                 fprintf (stderr,
-                  (_("Error in %s () outside diameter is smaller than the inside diameter for the %s entity with id-code: %x\n")),
+                  (_("Error in %s () outside diameter is smaller than the inside diameter for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, id_code);
                 /* Clean up. */
                 free (dxf_entity_name);
@@ -209,7 +195,7 @@ dxf_donut_write
         if (strcmp (dxf_donut_get_linetype (donut), "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_donut_get_id_code (donut));
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
@@ -219,12 +205,12 @@ dxf_donut_write
         if (strcmp (dxf_donut_get_layer (donut), "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty layer string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty layer string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, id_code);
                 fprintf (stderr,
                   (_("\t%s entity is relocated to layer 0\n")),
                   dxf_entity_name);
-                dxf_donut_set_layer (donut, strdup (DXF_DEFAULT_LAYER));
+                dxf_donut_set_layer (donut, DXF_DEFAULT_LAYER);
         }
         /* Create and write a polyline primitive. */
         dxf_polyline_new (polyline);
@@ -232,17 +218,13 @@ dxf_donut_write
         id_code = fp->last_id_code;
         id_code++;
         polyline->id_code = id_code;
-        polyline->linetype = dxf_donut_get_linetype (donut);
-        polyline->layer = dxf_donut_get_layer (donut);
-        polyline->p0->x0 = dxf_donut_get_x0 (donut);
-        polyline->p0->y0 = dxf_donut_get_y0 (donut);
-        polyline->p0->z0 = dxf_donut_get_z0 (donut);
-        polyline->thickness = dxf_donut_get_thickness (donut);
+        polyline->properties = dxf_graphic_properties_copy (donut->properties);
+        polyline->p0.x0 = dxf_donut_get_x0 (donut);
+        polyline->p0.y0 = dxf_donut_get_y0 (donut);
+        polyline->p0.z0 = dxf_donut_get_z0 (donut);
         polyline->start_width = 0.5 * start_width;
         polyline->end_width = 0.5 * end_width;
-        polyline->color = dxf_donut_get_color (donut);
         polyline->vertices_follow = 1;
-        polyline->paperspace = dxf_donut_get_paperspace (donut);
         polyline->flag = 1;
         polyline->polygon_mesh_M_vertex_count = 0;
         polyline->polygon_mesh_N_vertex_count = 0;
@@ -257,18 +239,14 @@ dxf_donut_write
         id_code = fp->last_id_code;
         id_code++;
         vertex_1->id_code = id_code;
-        vertex_1->layer = dxf_donut_get_layer (donut);
-        vertex_1->linetype = dxf_donut_get_linetype (donut);
+        vertex_1->properties = dxf_graphic_properties_copy (donut->properties);
         vertex_1->x0 = dxf_donut_get_x0 (donut) - (0.25 * (dxf_donut_get_outside_diameter (donut) + dxf_donut_get_inside_diameter (donut)));
         vertex_1->y0 = dxf_donut_get_y0 (donut);
         vertex_1->z0 = dxf_donut_get_z0 (donut);
-        vertex_1->thickness = dxf_donut_get_thickness (donut);
         vertex_1->start_width = 0.5 * start_width;
         vertex_1->end_width = 0.5 * end_width;
         vertex_1->bulge = 1;
         vertex_1->curve_fit_tangent_direction = 0.0;
-        vertex_1->color = dxf_donut_get_color (donut);
-        vertex_1->paperspace = dxf_donut_get_paperspace (donut);
         vertex_1->flag = 0;
         dxf_vertex_write (fp, vertex_1);
         /*! \todo Hook up this vertex to the list of vertices. */
@@ -278,18 +256,14 @@ dxf_donut_write
         id_code = fp->last_id_code;
         id_code++;
         vertex_2->id_code = id_code;
-        vertex_2->layer = dxf_donut_get_layer (donut);
-        vertex_2->linetype = dxf_donut_get_linetype (donut);
+        vertex_2->properties = dxf_graphic_properties_copy (donut->properties);
         vertex_2->x0 = dxf_donut_get_x0 (donut) + (0.25 * (dxf_donut_get_outside_diameter (donut) + dxf_donut_get_inside_diameter (donut)));
         vertex_2->y0 = dxf_donut_get_y0 (donut);
         vertex_2->z0 = dxf_donut_get_z0 (donut);
-        vertex_2->thickness = dxf_donut_get_thickness (donut);
         vertex_2->start_width = 0.5 * start_width;
         vertex_2->end_width = 0.5 * end_width;
         vertex_2->bulge = 1;
         vertex_2->curve_fit_tangent_direction = 0.0;
-        vertex_2->color = dxf_donut_get_color (donut);
-        vertex_2->paperspace = dxf_donut_get_paperspace (donut);
         vertex_2->flag = 0;
         dxf_vertex_write (fp, vertex_2);
         /*! \todo Hook up this vertex to the list of vertices. */
@@ -337,10 +311,10 @@ dxf_donut_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (donut->linetype);
-        free (donut->layer);
+        dxf_graphic_properties_free (donut->properties);
         free (donut->dictionary_owner_soft);
         free (donut->dictionary_owner_hard);
+        dxf_binary_graphics_data_free_chain (donut->binary_graphics_data);
         free (donut);
         donut = NULL;
 #if DEBUG
@@ -367,7 +341,7 @@ dxf_donut_free_chain
                 /*!< pointer to the chain of DXF donut entities. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (donuts == NULL)
@@ -393,7 +367,7 @@ dxf_donut_free_chain
  *
  * \return \c id_code.
  */
-int
+long
 dxf_donut_get_id_code
 (
         DxfDonut *donut
@@ -435,7 +409,7 @@ dxf_donut_set_id_code
 (
         DxfDonut *donut,
                 /*!< a pointer to a libDXF \c donut entity. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -490,7 +464,7 @@ dxf_donut_get_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        if (donut->linetype ==  NULL)
+        if (donut->properties->linetype ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the linetype member.\n")),
@@ -500,7 +474,7 @@ dxf_donut_get_linetype
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (donut->linetype));
+        return (strdup (donut->properties->linetype));
 }
 
 
@@ -540,7 +514,12 @@ dxf_donut_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        donut->linetype = strdup (linetype);
+        if (dxf_graphic_properties_unshare (&donut->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (donut->properties->linetype);
+        donut->properties->linetype = strdup (linetype);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -572,7 +551,7 @@ dxf_donut_get_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        if (donut->layer ==  NULL)
+        if (donut->properties->layer ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the layer member.\n")),
@@ -582,7 +561,7 @@ dxf_donut_get_layer
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (donut->layer));
+        return (strdup (donut->properties->layer));
 }
 
 
@@ -621,7 +600,12 @@ dxf_donut_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        donut->layer = strdup (layer);
+        if (dxf_graphic_properties_unshare (&donut->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (donut->properties->layer);
+        donut->properties->layer = strdup (layer);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -655,7 +639,7 @@ dxf_donut_get_elevation
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (donut->elevation);
+        return (donut->properties->elevation);
 }
 
 
@@ -685,7 +669,11 @@ dxf_donut_set_elevation
                   __FUNCTION__);
                 return (NULL);
         }
-        donut->elevation = elevation;
+        if (dxf_graphic_properties_unshare (&donut->properties) == NULL)
+        {
+                return (NULL);
+        }
+        donut->properties->elevation = elevation;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -716,7 +704,7 @@ dxf_donut_get_thickness
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (donut->thickness < 0.0)
+        if (donut->properties->thickness < 0.0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found in the thickness member.\n")),
@@ -725,7 +713,7 @@ dxf_donut_get_thickness
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (donut->thickness);
+        return (donut->properties->thickness);
 }
 
 
@@ -761,7 +749,11 @@ dxf_donut_set_thickness
                   (_("Warning in %s () a negative thickness value was passed.\n")),
                   __FUNCTION__);
         }
-        donut->thickness = thickness;
+        if (dxf_graphic_properties_unshare (&donut->properties) == NULL)
+        {
+                return (NULL);
+        }
+        donut->properties->thickness = thickness;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -792,7 +784,7 @@ dxf_donut_get_linetype_scale
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (donut->linetype_scale < 0.0)
+        if (donut->properties->linetype_scale < 0.0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found in the linetype_scale member.\n")),
@@ -801,7 +793,7 @@ dxf_donut_get_linetype_scale
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (donut->linetype_scale);
+        return (donut->properties->linetype_scale);
 }
 
 
@@ -837,7 +829,11 @@ dxf_donut_set_linetype_scale
                   (_("Warning in %s () a negative linetype_scale value was passed.\n")),
                   __FUNCTION__);
         }
-        donut->linetype_scale = linetype_scale;
+        if (dxf_graphic_properties_unshare (&donut->properties) == NULL)
+        {
+                return (NULL);
+        }
+        donut->properties->linetype_scale = linetype_scale;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -868,14 +864,14 @@ dxf_donut_get_visibility
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (donut->visibility < 0)
+        if (donut->properties->visibility < 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found in the visibility member.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (donut->visibility > 1)
+        if (donut->properties->visibility > 1)
         {
                 fprintf (stderr,
                   (_("Error in %s () an out of range value was found in the visibility member.\n")),
@@ -885,7 +881,7 @@ dxf_donut_get_visibility
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (donut->visibility);
+        return (donut->properties->visibility);
 }
 
 
@@ -929,7 +925,11 @@ dxf_donut_set_visibility
                   __FUNCTION__);
                 return (NULL);
         }
-        donut->visibility = visibility;
+        if (dxf_graphic_properties_unshare (&donut->properties) == NULL)
+        {
+                return (NULL);
+        }
+        donut->properties->visibility = visibility;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -960,7 +960,7 @@ dxf_donut_get_color
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (donut->color < 0)
+        if (donut->properties->color < 0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found in the color member.\n")),
@@ -969,7 +969,7 @@ dxf_donut_get_color
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (donut->color);
+        return (donut->properties->color);
 }
 
 
@@ -1007,7 +1007,11 @@ dxf_donut_set_color
                 fprintf (stderr,
                   (_("\teffectively turning this entity it's visibility off.\n")));
         }
-        donut->color = color;
+        if (dxf_graphic_properties_unshare (&donut->properties) == NULL)
+        {
+                return (NULL);
+        }
+        donut->properties->color = color;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1039,13 +1043,13 @@ dxf_donut_get_paperspace
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (donut->paperspace < 0)
+        if (donut->properties->paperspace < 0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found in the paperspace member.\n")),
                   __FUNCTION__);
         }
-        if (donut->paperspace > 1)
+        if (donut->properties->paperspace > 1)
         {
                 fprintf (stderr,
                   (_("Warning in %s () an out of range value was found in the paperspace member.\n")),
@@ -1054,7 +1058,7 @@ dxf_donut_get_paperspace
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (donut->paperspace);
+        return (donut->properties->paperspace);
 }
 
 
@@ -1098,7 +1102,11 @@ dxf_donut_set_paperspace
                   __FUNCTION__);
                 return (NULL);
         }
-        donut->paperspace = paperspace;
+        if (dxf_graphic_properties_unshare (&donut->properties) == NULL)
+        {
+                return (NULL);
+        }
+        donut->properties->paperspace = paperspace;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1222,14 +1230,14 @@ dxf_donut_get_shadow_mode
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (donut->shadow_mode < 0)
+        if (donut->properties->shadow_mode < 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found in the shadow_mode member.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (donut->shadow_mode > 3)
+        if (donut->properties->shadow_mode > 3)
         {
                 fprintf (stderr,
                   (_("Error in %s () an out of range value was found in the shadow_mode member.\n")),
@@ -1239,7 +1247,7 @@ dxf_donut_get_shadow_mode
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (donut->shadow_mode);
+        return (donut->properties->shadow_mode);
 }
 
 
@@ -1283,7 +1291,11 @@ dxf_donut_set_shadow_mode
                   __FUNCTION__);
                 return (NULL);
         }
-        donut->shadow_mode = shadow_mode;
+        if (dxf_graphic_properties_unshare (&donut->properties) == NULL)
+        {
+                return (NULL);
+        }
+        donut->properties->shadow_mode = shadow_mode;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1478,7 +1490,7 @@ dxf_donut_get_material
                   __FUNCTION__);
                 return (NULL);
         }
-        if (donut->material ==  NULL)
+        if (donut->properties->material ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the material member.\n")),
@@ -1488,7 +1500,7 @@ dxf_donut_get_material
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (donut->material));
+        return (strdup (donut->properties->material));
 }
 
 
@@ -1527,7 +1539,12 @@ dxf_donut_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        donut->material = strdup (material);
+        if (dxf_graphic_properties_unshare (&donut->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (donut->properties->material);
+        donut->properties->material = strdup (material);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1645,7 +1662,7 @@ dxf_donut_get_lineweight
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (donut->lineweight);
+        return (donut->properties->lineweight);
 }
 
 
@@ -1675,7 +1692,11 @@ dxf_donut_set_lineweight
                   __FUNCTION__);
                 return (NULL);
         }
-        donut->lineweight = lineweight;
+        if (dxf_graphic_properties_unshare (&donut->properties) == NULL)
+        {
+                return (NULL);
+        }
+        donut->properties->lineweight = lineweight;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1707,7 +1728,7 @@ dxf_donut_get_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        if (donut->plot_style_name ==  NULL)
+        if (donut->properties->plot_style_name ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the plot_style_name member.\n")),
@@ -1717,7 +1738,7 @@ dxf_donut_get_plot_style_name
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (donut->plot_style_name));
+        return (strdup (donut->properties->plot_style_name));
 }
 
 
@@ -1755,7 +1776,12 @@ dxf_donut_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        donut->plot_style_name = strdup (plot_style_name);
+        if (dxf_graphic_properties_unshare (&donut->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (donut->properties->plot_style_name);
+        donut->properties->plot_style_name = strdup (plot_style_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1790,7 +1816,7 @@ dxf_donut_get_color_value
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (donut->color_value);
+        return (donut->properties->color_value);
 }
 
 
@@ -1820,7 +1846,11 @@ dxf_donut_set_color_value
                   __FUNCTION__);
                 return (NULL);
         }
-        donut->color_value = color_value;
+        if (dxf_graphic_properties_unshare (&donut->properties) == NULL)
+        {
+                return (NULL);
+        }
+        donut->properties->color_value = color_value;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1852,7 +1882,7 @@ dxf_donut_get_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        if (donut->color_name ==  NULL)
+        if (donut->properties->color_name ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the color_name member.\n")),
@@ -1862,7 +1892,7 @@ dxf_donut_get_color_name
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (donut->color_name));
+        return (strdup (donut->properties->color_name));
 }
 
 
@@ -1900,7 +1930,12 @@ dxf_donut_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        donut->color_name = strdup (color_name);
+        if (dxf_graphic_properties_unshare (&donut->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (donut->properties->color_name);
+        donut->properties->color_name = strdup (color_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1935,7 +1970,7 @@ dxf_donut_get_transparency
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (donut->transparency);
+        return (donut->properties->transparency);
 }
 
 
@@ -1965,7 +2000,11 @@ dxf_donut_set_transparency
                   __FUNCTION__);
                 return (NULL);
         }
-        donut->transparency = transparency;
+        if (dxf_graphic_properties_unshare (&donut->properties) == NULL)
+        {
+                return (NULL);
+        }
+        donut->properties->transparency = transparency;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1985,7 +2024,7 @@ dxf_donut_get_p0
                 /*!< a pointer to a libDXF \c donut entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2025,7 +2064,7 @@ dxf_donut_set_p0
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2064,7 +2103,7 @@ dxf_donut_get_x0
                 /*!< a pointer to a libDXF \c donut entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2107,7 +2146,7 @@ dxf_donut_set_x0
                  * libDXF \c donut entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2146,7 +2185,7 @@ dxf_donut_get_y0
                 /*!< a pointer to a libDXF \c donut entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2189,7 +2228,7 @@ dxf_donut_set_y0
                  * libDXF \c donut entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2228,7 +2267,7 @@ dxf_donut_get_z0
                 /*!< a pointer to a libDXF \c donut entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2271,7 +2310,7 @@ dxf_donut_set_z0
                  * \c donut entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2309,7 +2348,7 @@ dxf_donut_get_outside_diameter
                 /*!< a pointer to a DXF \c 3DFACE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2344,7 +2383,7 @@ dxf_donut_set_outside_diameter
                  * entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2375,7 +2414,7 @@ dxf_donut_get_inside_diameter
                 /*!< a pointer to a DXF \c 3DFACE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2410,7 +2449,7 @@ dxf_donut_set_inside_diameter
                  * entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
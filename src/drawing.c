@@ -33,6 +33,76 @@
 
 
 #include "drawing.h"
+#include "arena.h"
+#include "lexer.h"
+#include "section.h"
+#include "util.h"
+#include "appid.h"
+#include "block_record.h"
+#include "dimstyle.h"
+#include "layer.h"
+#include "ltype.h"
+#include "style.h"
+#include "ucs.h"
+#include "view.h"
+#include "vport.h"
+
+#if !defined (MSDOS) && !defined (_WIN32)
+#include <pthread.h>
+#endif
+
+
+#define DXF_DRAWING_MAX_JOBS 64
+        /*!< \brief Maximum number of sections and parts of sections read
+         * by dxf_drawing_read (). */
+#define DXF_DRAWING_MIN_CHUNK_SIZE (1024 * 1024)
+        /*!< \brief An \c ENTITIES section is not split in parts smaller
+         * than this number of bytes. */
+
+
+/*!
+ * \brief One section to be read by dxf_drawing_read ().
+ */
+typedef struct
+dxf_drawing_job_struct
+{
+        DxfFile *fp;
+                /*!< The memory mapped file. */
+        DxfSectionRange *range;
+                /*!< Location of the section. */
+        void *result;
+                /*!< What was read: a DxfHeader, a DxfClass list,
+                 * DxfTables, a DxfBlock list, a DxfEntities container,
+                 * or \c NULL. */
+        DxfArena *arena;
+                /*!< Arena holding the entities of an \c ENTITIES
+                 * section, or \c NULL. */
+        DxfColumns *columns;
+                /*!< Columnar store for the simple entities of an
+                 * \c ENTITIES section, or \c NULL. */
+        int status;
+                /*!< \c EXIT_FAILURE when the section could not be
+                 * read. */
+} DxfDrawingJob;
+
+
+/*!
+ * \brief Jobs shared by the threads of dxf_drawing_read ().
+ */
+typedef struct
+dxf_drawing_pool_struct
+{
+        DxfDrawingJob *jobs;
+                /*!< Jobs, largest section first. */
+        int count;
+                /*!< Number of jobs. */
+        int next;
+                /*!< First job not taken by a thread yet. */
+#if !defined (MSDOS) && !defined (_WIN32)
+        pthread_mutex_t lock;
+                /*!< Protects \c next. */
+#endif
+} DxfDrawingPool;
 
 
 /*!
@@ -123,6 +193,11 @@ dxf_drawing_init
  * \brief Free the allocated memory for a libDXF drawing and all it's
  * data fields.
  *
+ * When the drawing owns arenas (see dxf_drawing_read ()) everything the
+ * entities hold is in the arenas and the pools of the drawing, which
+ * are released at once without visiting the entities.  Otherwise the
+ * entities are freed one by one.
+ *
  * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
  * occurred.
  */
@@ -137,12 +212,60 @@ dxf_drawing_free
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        dxf_header_free ((DxfHeader *) drawing->header);
-        dxf_class_free_chain ((DxfClass *) drawing->class_list);
-        dxf_block_free_chain ((DxfBlock *) drawing->block_list);
-        //dxf_entities_free_chain ((DxfEntities *) drawing->entities_list);
-        dxf_object_free_chain ((DxfObject *) drawing->object_list);
-        dxf_thumbnail_free ((DxfThumbnail *) drawing->thumbnail);
+        /* Sections which were not read are NULL. */
+        if (drawing->header != NULL)
+        {
+                dxf_header_free ((DxfHeader *) drawing->header);
+        }
+        if (drawing->class_list != NULL)
+        {
+                dxf_class_free_chain ((DxfClass *) drawing->class_list);
+        }
+        if (drawing->tables_list != NULL)
+        {
+                dxf_tables_free ((DxfTables *) drawing->tables_list);
+        }
+        if (drawing->block_list != NULL)
+        {
+                dxf_block_free_chain ((DxfBlock *) drawing->block_list);
+        }
+        if ((drawing->entities_list != NULL) && (drawing->arena != NULL))
+        {
+                /* Only the container is not in the arenas. */
+                free (drawing->entities_list);
+        }
+        else if (drawing->entities_list != NULL)
+        {
+                dxf_entities_free ((DxfEntities *) drawing->entities_list);
+        }
+        if (drawing->object_list != NULL)
+        {
+                dxf_object_free_chain ((DxfObject *) drawing->object_list);
+        }
+        if (drawing->thumbnail != NULL)
+        {
+                dxf_thumbnail_free ((DxfThumbnail *) drawing->thumbnail);
+        }
+        if (drawing->handles != NULL)
+        {
+                dxf_handle_table_free (drawing->handles);
+        }
+        if (drawing->properties != NULL)
+        {
+                dxf_graphic_properties_pool_free (drawing->properties);
+        }
+        if (drawing->strings != NULL)
+        {
+                dxf_string_pool_free (drawing->strings);
+        }
+        if (drawing->arena != NULL)
+        {
+                dxf_arena_free (drawing->arena);
+        }
+        if (drawing->columns != NULL)
+        {
+                dxf_columns_free (drawing->columns);
+        }
         free (drawing);
         drawing = NULL;
 #if DEBUG
@@ -728,4 +851,1444 @@ dxf_drawing_set_thumbnail
 }
 
 
+/*!
+ * \brief Read the \c CLASSES section from \c fp into \c classes.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when a class
+ * could not be read, \c classes is \c NULL then.
+ */
+static int
+dxf_drawing_read_classes
+(
+        DxfFile *fp,
+                /*!< DXF file handle of the section. */
+        DxfClass **classes
+                /*!< the list of classes, \c NULL for an empty
+                 * section. */
+)
+{
+        DxfClass *last = NULL;
+        DxfClass *class;
+        DxfPair pair;
+        int status = EXIT_SUCCESS;
+
+        *classes = NULL;
+        while ((status == EXIT_SUCCESS)
+          && (dxf_lexer_read_pair (fp, &pair) == 1))
+        {
+                if ((pair.group_code != 0)
+                  || (!dxf_pair_value_is (&pair, "CLASS")))
+                {
+                        continue;
+                }
+                class = dxf_class_init (dxf_class_new ());
+                if (class == NULL)
+                {
+                        status = EXIT_FAILURE;
+                        continue;
+                }
+                /* The record type is the value of the group code 0
+                 * pair, which dxf_class_read () does not see. */
+                free (class->record_type);
+                class->record_type = dxf_pair_get_string (&pair);
+                if (dxf_class_read (fp, class) == NULL)
+                {
+                        dxf_class_free (class);
+                        status = EXIT_FAILURE;
+                        continue;
+                }
+                if (last == NULL)
+                {
+                        *classes = class;
+                }
+                else
+                {
+                        last->next = (struct DxfClass *) class;
+                }
+                last = class;
+        }
+        if ((status != EXIT_SUCCESS) && (*classes != NULL))
+        {
+                dxf_class_free_chain (*classes);
+                *classes = NULL;
+        }
+        return (status);
+}
+
+
+/*!
+ * \brief Define a function reading the records of one table of the
+ * \c TABLES section into the list \c list of a DxfTables.
+ *
+ * The function reads \c record records with the reader of \c prefix
+ * until the \c ENDTAB marker, the group code 0 pair starting a record
+ * has been read by then.  Records are appended, a table found twice
+ * adds to the same list.
+ */
+#define DXF_DRAWING_READ_TABLE(function, prefix, record, list) \
+static int \
+function \
+( \
+        DxfFile *fp, \
+        DxfTables *tables \
+) \
+{ \
+        record *last = (record *) tables->list; \
+        record *entry; \
+        DxfPair pair; \
+ \
+        while ((last != NULL) && (last->next != NULL)) \
+        { \
+                last = (record *) last->next; \
+        } \
+        while (dxf_lexer_read_pair (fp, &pair) == 1) \
+        { \
+                if (pair.group_code != 0) \
+                { \
+                        continue; \
+                } \
+                if (dxf_pair_value_is (&pair, "ENDTAB")) \
+                { \
+                        break; \
+                } \
+                entry = prefix##_init (prefix##_new ()); \
+                if (entry == NULL) \
+                { \
+                        return (EXIT_FAILURE); \
+                } \
+                if (prefix##_read (fp, entry) == NULL) \
+                { \
+                        prefix##_free (entry); \
+                        return (EXIT_FAILURE); \
+                } \
+                if (last == NULL) \
+                { \
+                        tables->list = (struct record *) entry; \
+                } \
+                else \
+                { \
+                        last->next = (struct record *) entry; \
+                } \
+                last = entry; \
+        } \
+        return (EXIT_SUCCESS); \
+}
+
+DXF_DRAWING_READ_TABLE (dxf_drawing_read_appids, dxf_appid, DxfAppid, appids)
+DXF_DRAWING_READ_TABLE (dxf_drawing_read_block_records, dxf_block_record, DxfBlockRecord, block_records)
+DXF_DRAWING_READ_TABLE (dxf_drawing_read_dimstyles, dxf_dimstyle, DxfDimStyle, dimstyles)
+DXF_DRAWING_READ_TABLE (dxf_drawing_read_layers, dxf_layer, DxfLayer, layers)
+DXF_DRAWING_READ_TABLE (dxf_drawing_read_ltypes, dxf_ltype, DxfLType, ltypes)
+DXF_DRAWING_READ_TABLE (dxf_drawing_read_styles, dxf_style, DxfStyle, styles)
+DXF_DRAWING_READ_TABLE (dxf_drawing_read_ucss, dxf_ucs, DxfUcs, ucss)
+DXF_DRAWING_READ_TABLE (dxf_drawing_read_views, dxf_view, DxfView, views)
+DXF_DRAWING_READ_TABLE (dxf_drawing_read_vports, dxf_vport, DxfVPort, vports)
+
+
+/*!
+ * \brief A table of the \c TABLES section and the function reading
+ * its records.
+ */
+typedef struct
+dxf_drawing_table_struct
+{
+        const char *name;
+                /*!< Name of the table, the value of its group code 2. */
+        int (*read) (DxfFile *fp, DxfTables *tables);
+                /*!< Reads the records of the table. */
+} DxfDrawingTable;
+
+
+/*!
+ * \brief All tables which can be read.
+ */
+static const DxfDrawingTable dxf_drawing_tables[] =
+{
+        {"APPID", dxf_drawing_read_appids},
+        {"BLOCK_RECORD", dxf_drawing_read_block_records},
+        {"DIMSTYLE", dxf_drawing_read_dimstyles},
+        {"LAYER", dxf_drawing_read_layers},
+        {"LTYPE", dxf_drawing_read_ltypes},
+        {"STYLE", dxf_drawing_read_styles},
+        {"UCS", dxf_drawing_read_ucss},
+        {"VIEW", dxf_drawing_read_views},
+        {"VPORT", dxf_drawing_read_vports}
+};
+
+
+/*!
+ * \brief Read the \c TABLES section from \c fp.
+ *
+ * Every \c TABLE is read by the reader of its name, the records of a
+ * table with an unknown name are skipped.
+ *
+ * \return the tables, or \c NULL when a record could not be read.
+ */
+static DxfTables *
+dxf_drawing_read_tables
+(
+        DxfFile *fp
+                /*!< DXF file handle of the section. */
+)
+{
+        DxfTables *tables;
+        DxfPair pair;
+        size_t i;
+
+        tables = dxf_tables_init (dxf_tables_new ());
+        if (tables == NULL)
+        {
+                return (NULL);
+        }
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
+        {
+                /* The name follows the group code 0 pair starting a
+                 * table. */
+                if ((pair.group_code != 0)
+                  || (!dxf_pair_value_is (&pair, "TABLE"))
+                  || (dxf_lexer_read_pair (fp, &pair) != 1)
+                  || (pair.group_code != 2))
+                {
+                        continue;
+                }
+                for (i = 0; i < sizeof (dxf_drawing_tables) / sizeof (dxf_drawing_tables[0]); i++)
+                {
+                        if (dxf_pair_value_is (&pair, dxf_drawing_tables[i].name))
+                        {
+                                break;
+                        }
+                }
+                if (i == sizeof (dxf_drawing_tables) / sizeof (dxf_drawing_tables[0]))
+                {
+                        continue;
+                }
+                if (dxf_drawing_tables[i].read (fp, tables) != EXIT_SUCCESS)
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () could not read a record of the %s table.\n")),
+                          __FUNCTION__, dxf_drawing_tables[i].name);
+                        dxf_tables_free (tables);
+                        return (NULL);
+                }
+        }
+        return (tables);
+}
+
+
+/*!
+ * \brief Read the \c BLOCKS section from \c fp into \c blocks.
+ *
+ * The entities inside the blocks are skipped, a DxfBlock has no place
+ * to store them.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when a block
+ * could not be read, \c blocks is \c NULL then.
+ */
+static int
+dxf_drawing_read_blocks
+(
+        DxfFile *fp,
+                /*!< DXF file handle of the section. */
+        DxfBlock **blocks
+                /*!< the list of blocks, \c NULL for an empty
+                 * section. */
+)
+{
+        DxfBlock *last = NULL;
+        DxfBlock *block;
+        DxfPair pair;
+        int status = EXIT_SUCCESS;
+
+        *blocks = NULL;
+        while ((status == EXIT_SUCCESS)
+          && (dxf_lexer_read_pair (fp, &pair) == 1))
+        {
+                if ((pair.group_code != 0)
+                  || (!dxf_pair_value_is (&pair, "BLOCK")))
+                {
+                        continue;
+                }
+                block = dxf_block_init (dxf_block_new ());
+                if (block == NULL)
+                {
+                        status = EXIT_FAILURE;
+                        continue;
+                }
+                if (dxf_block_read (fp, block) == NULL)
+                {
+                        dxf_block_free (block);
+                        status = EXIT_FAILURE;
+                        continue;
+                }
+                if (last == NULL)
+                {
+                        *blocks = block;
+                }
+                else
+                {
+                        last->next = (struct DxfBlock *) block;
+                }
+                last = block;
+        }
+        if ((status != EXIT_SUCCESS) && (*blocks != NULL))
+        {
+                dxf_block_free_chain (*blocks);
+                *blocks = NULL;
+        }
+        return (status);
+}
+
+
+/*!
+ * \brief Read the \c OBJECTS section from \c fp into \c objects.
+ *
+ * Every object is kept as a generic DxfObject, a list of its group
+ * codes and values.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an object
+ * could not be read, \c objects is \c NULL then.
+ */
+static int
+dxf_drawing_read_objects
+(
+        DxfFile *fp,
+                /*!< DXF file handle of the section. */
+        DxfObject **objects
+                /*!< the list of objects, \c NULL for an empty
+                 * section. */
+)
+{
+        DxfObject *last = NULL;
+        DxfObject *object;
+        DxfPair pair;
+        int status = EXIT_SUCCESS;
+
+        *objects = NULL;
+        while ((status == EXIT_SUCCESS)
+          && (dxf_lexer_read_pair (fp, &pair) == 1))
+        {
+                if (pair.group_code != 0)
+                {
+                        continue;
+                }
+                dxf_lexer_unread_pair (fp);
+                object = dxf_object_init (dxf_object_new ());
+                if (object == NULL)
+                {
+                        status = EXIT_FAILURE;
+                        continue;
+                }
+                if (dxf_object_read (fp, object) == NULL)
+                {
+                        dxf_object_free (object);
+                        status = EXIT_FAILURE;
+                        continue;
+                }
+                if (last == NULL)
+                {
+                        *objects = object;
+                }
+                else
+                {
+                        last->next = (struct DxfObject *) object;
+                }
+                last = object;
+        }
+        if ((status != EXIT_SUCCESS) && (*objects != NULL))
+        {
+                dxf_object_free_chain (*objects);
+                *objects = NULL;
+        }
+        return (status);
+}
+
+
+/*!
+ * \brief Read the section of \c job.
+ */
+static void
+dxf_drawing_read_job
+(
+        DxfDrawingJob *job
+                /*!< the section to read. */
+)
+{
+        DxfFile *fp;
+        DxfHeader *header;
+        DxfClass *classes;
+        DxfBlock *blocks;
+        DxfObject *objects;
+        DxfEntities *entities;
+        DxfArena *previous;
+        const char *name = job->range->name;
+
+        if (job->range->start == job->range->end)
+        {
+                /* An empty section, nothing to read. */
+                return;
+        }
+        fp = dxf_read_init_window (job->fp, job->range->start, job->range->end);
+        if (fp == NULL)
+        {
+                job->status = EXIT_FAILURE;
+                return;
+        }
+        if (strcmp (name, "HEADER") == 0)
+        {
+                header = dxf_header_new ();
+                if (header != NULL)
+                {
+                        /* dxf_header_read () gives up at the first
+                         * variable it does not know, keep what was read
+                         * up to there. */
+                        dxf_header_read (fp, header);
+                }
+                job->result = header;
+        }
+        else if (strcmp (name, "CLASSES") == 0)
+        {
+                job->status = dxf_drawing_read_classes (fp, &classes);
+                job->result = classes;
+        }
+        else if (strcmp (name, "TABLES") == 0)
+        {
+                job->result = dxf_drawing_read_tables (fp);
+                if (job->result == NULL)
+                {
+                        job->status = EXIT_FAILURE;
+                }
+        }
+        else if (strcmp (name, "BLOCKS") == 0)
+        {
+                job->status = dxf_drawing_read_blocks (fp, &blocks);
+                job->result = blocks;
+        }
+        else if (strcmp (name, "OBJECTS") == 0)
+        {
+                job->status = dxf_drawing_read_objects (fp, &objects);
+                job->result = objects;
+        }
+        else if (strcmp (name, "ENTITIES") == 0)
+        {
+                entities = dxf_entities_new ();
+                if (entities != NULL)
+                {
+                        /* Everything an entity holds is taken from the
+                         * arena of the job, the container is not. */
+                        job->arena = dxf_arena_new ();
+                        previous = dxf_arena_set_current (job->arena);
+                        fp->columns = job->columns;
+                        job->status = dxf_entities_read (fp, entities);
+                        dxf_arena_set_current (previous);
+                }
+                job->result = entities;
+        }
+        dxf_read_close (fp);
+}
+
+
+/*!
+ * \brief Read jobs from \c pool until all jobs have been taken.
+ */
+static void *
+dxf_drawing_read_worker
+(
+        void *data
+                /*!< the DxfDrawingPool. */
+)
+{
+        DxfDrawingPool *pool = data;
+        int job;
+
+        for (;;)
+        {
+#if !defined (MSDOS) && !defined (_WIN32)
+                pthread_mutex_lock (&pool->lock);
+#endif
+                job = pool->next;
+                if (job < pool->count)
+                {
+                        pool->next++;
+                }
+#if !defined (MSDOS) && !defined (_WIN32)
+                pthread_mutex_unlock (&pool->lock);
+#endif
+                if (job >= pool->count)
+                {
+                        break;
+                }
+                dxf_drawing_read_job (&pool->jobs[job]);
+        }
+        return (NULL);
+}
+
+
+/*!
+ * \brief Compare two jobs by the size of their sections, largest first.
+ */
+static int
+dxf_drawing_compare_jobs
+(
+        const void *a,
+        const void *b
+)
+{
+        const DxfDrawingJob *job_a = a;
+        const DxfDrawingJob *job_b = b;
+        size_t size_a = job_a->range->end - job_a->range->start;
+        size_t size_b = job_b->range->end - job_b->range->start;
+
+        return ((size_a < size_b) - (size_a > size_b));
+}
+
+
+/*!
+ * \brief Compare two jobs by the location of their sections in the
+ * file.
+ */
+static int
+dxf_drawing_compare_offsets
+(
+        const void *a,
+        const void *b
+)
+{
+        const DxfDrawingJob *job_a = a;
+        const DxfDrawingJob *job_b = b;
+
+        return ((job_a->range->start > job_b->range->start)
+          - (job_a->range->start < job_b->range->start));
+}
+
+
+/*!
+ * \brief Read a drawing from a DXF file, reading the sections
+ * concurrently.
+ *
+ * The file is memory mapped and scanned once for the locations of its
+ * sections, after which the sections are read concurrently by up to
+ * \c threads threads, largest section first.\n
+ * A large \c ENTITIES section is split in parts at entity boundaries
+ * (see dxf_section_split ()), which are read concurrently as well and
+ * joined in file order afterwards.\n
+ * The \c HEADER, \c CLASSES, \c TABLES, \c BLOCKS, \c ENTITIES and
+ * \c OBJECTS sections are read, the \c TABLES section into the lists
+ * of \c tables_list, one for each table.\n
+ * The entities share their layer, linetype, color and pointer strings,
+ * and the objects all their strings, through the string pool of the
+ * drawing, so equal strings have equal pointers.  Entities with equal
+ * graphic properties share one record of the drawing as well (see
+ * graphic_properties.h).\n
+ * Everything the entities hold is taken from per-thread arenas, which
+ * dxf_drawing_free () releases at once without visiting the entities.
+ * Make \c arena of the drawing the current arena of the thread (see
+ * dxf_arena_set_current ()) while changing or adding entities, so that
+ * what their setters allocate is released with it, and change the
+ * entities from one thread at a time.  dxf_free () leaves memory of an
+ * arena alone.\n
+ * On platforms without \c mmap () or threads the sections are read one
+ * after another.
+ *
+ * \return a pointer to the drawing, to be freed with
+ * dxf_drawing_free (), or \c NULL when an error occurred, including
+ * a section which could not be read completely.
+ */
+DxfDrawing *
+dxf_drawing_read
+(
+        const char *filename,
+                /*!< filename of input file (or device). */
+        int threads
+                /*!< maximum number of threads to use, or \c 0 for one
+                 * thread per online processor. */
+)
+{
+        return (dxf_drawing_read_filtered (filename, threads, NULL));
+}
+
+
+/*!
+ * \brief Read a drawing from a DXF file, for dxf_drawing_read_filtered ()
+ * and dxf_drawing_read_columnar ().
+ *
+ * \return a pointer to the drawing, to be freed with
+ * dxf_drawing_free (), or \c NULL when an error occurred.
+ */
+static DxfDrawing *
+dxf_drawing_read_sections
+(
+        const char *filename,
+                /*!< filename of input file (or device). */
+        int threads,
+                /*!< maximum number of threads to use, or \c 0 for one
+                 * thread per online processor. */
+        DxfFilter *filter,
+                /*!< the filter, or \c NULL to read every entity. */
+        int columnar
+                /*!< \c TRUE to read the simple entities into the
+                 * columns of the drawing. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfDrawing *drawing;
+        DxfFile *fp;
+        DxfSectionRange ranges[DXF_MAX_SECTIONS];
+        DxfSectionRange parts[DXF_DRAWING_MAX_JOBS];
+        DxfDrawingJob jobs[DXF_DRAWING_MAX_JOBS];
+        DxfDrawingPool pool;
+        size_t size;
+        int sections;
+        int count = 0;
+        int chunks;
+        int i;
+        int j;
+#if !defined (MSDOS) && !defined (_WIN32)
+        pthread_t workers[DXF_DRAWING_MAX_JOBS];
+        int started = 0;
+#endif
+
+        fp = dxf_read_init_mmap (filename);
+        if (fp == NULL)
+        {
+                return (NULL);
+        }
+        if (fp->buffer == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not map file: %s into memory.\n")),
+                  __FUNCTION__, filename);
+                dxf_read_close (fp);
+                return (NULL);
+        }
+        /* The windows of the sections inherit the filter. */
+        fp->filter = filter;
+        drawing = dxf_drawing_new ();
+        if (drawing == NULL)
+        {
+                dxf_read_close (fp);
+                return (NULL);
+        }
+        /* Entities share their layer names, linetypes and pointers
+         * through the pool of the drawing, the windows of the sections
+         * inherit it. */
+        drawing->strings = dxf_string_pool_new ();
+        fp->strings = drawing->strings;
+        if (drawing->strings != NULL)
+        {
+                drawing->properties = dxf_graphic_properties_pool_new (drawing->strings);
+                fp->properties = drawing->properties;
+        }
+#if !defined (MSDOS) && !defined (_WIN32)
+        if (threads <= 0)
+        {
+                threads = (int) sysconf (_SC_NPROCESSORS_ONLN);
+        }
+#else
+        threads = 1;
+#endif
+        dxf_lexer_detect_binary (fp);
+        sections = dxf_section_index (fp, ranges, DXF_MAX_SECTIONS);
+        for (i = 0; i < sections; i++)
+        {
+                /* All sections are read with the version of the
+                 * drawing. */
+                if (strcmp (ranges[i].name, "HEADER") == 0)
+                {
+                        fp->acad_version_number = dxf_section_read_version (fp, &ranges[i]);
+                }
+                /* A large ENTITIES section is split at entity
+                 * boundaries, and the parts are read in parallel. */
+                size = ranges[i].end - ranges[i].start;
+                chunks = 1;
+                if ((strcmp (ranges[i].name, "ENTITIES") == 0)
+                  && (threads > 1)
+                  && (size >= 2 * DXF_DRAWING_MIN_CHUNK_SIZE))
+                {
+                        chunks = threads;
+                        if ((size_t) chunks > size / DXF_DRAWING_MIN_CHUNK_SIZE)
+                        {
+                                chunks = (int) (size / DXF_DRAWING_MIN_CHUNK_SIZE);
+                        }
+                }
+                if (chunks > DXF_DRAWING_MAX_JOBS - (sections - i - 1) - count)
+                {
+                        chunks = DXF_DRAWING_MAX_JOBS - (sections - i - 1) - count;
+                }
+                if (chunks > 1)
+                {
+                        chunks = dxf_section_split (fp, &ranges[i],
+                          &parts[count], chunks);
+                }
+                if (chunks < 2)
+                {
+                        parts[count] = ranges[i];
+                        chunks = 1;
+                }
+                for (j = 0; j < chunks; j++)
+                {
+                        jobs[count].fp = fp;
+                        jobs[count].range = &parts[count];
+                        jobs[count].result = NULL;
+                        jobs[count].arena = NULL;
+                        jobs[count].columns = NULL;
+                        jobs[count].status = EXIT_SUCCESS;
+                        if (columnar
+                          && (strcmp (ranges[i].name, "ENTITIES") == 0))
+                        {
+                                jobs[count].columns = dxf_columns_new ();
+                        }
+                        count++;
+                }
+        }
+        if (count > 0)
+        {
+                qsort (jobs, (size_t) count, sizeof (DxfDrawingJob),
+                  dxf_drawing_compare_jobs);
+        }
+        pool.jobs = jobs;
+        pool.count = count;
+        pool.next = 0;
+#if !defined (MSDOS) && !defined (_WIN32)
+        if (threads > pool.count)
+        {
+                threads = pool.count;
+        }
+        pthread_mutex_init (&pool.lock, NULL);
+        /* The calling thread is a worker as well. */
+        for (i = 1; i < threads; i++)
+        {
+                if (pthread_create (&workers[started], NULL,
+                  dxf_drawing_read_worker, &pool) == 0)
+                {
+                        started++;
+                }
+        }
+        dxf_drawing_read_worker (&pool);
+        for (i = 0; i < started; i++)
+        {
+                pthread_join (workers[i], NULL);
+        }
+        pthread_mutex_destroy (&pool.lock);
+#else
+        dxf_drawing_read_worker (&pool);
+#endif
+        /* Put the parts of a section back in file order. */
+        if (count > 0)
+        {
+                qsort (jobs, (size_t) count, sizeof (DxfDrawingJob),
+                  dxf_drawing_compare_offsets);
+        }
+        for (i = 0; i < count; i++)
+        {
+                if (jobs[i].arena != NULL)
+                {
+                        /* The arenas of the parts are released
+                         * together with the drawing. */
+                        jobs[i].arena->next = drawing->arena;
+                        drawing->arena = jobs[i].arena;
+                }
+                if (jobs[i].columns != NULL)
+                {
+                        /* The columns of the parts are joined in file
+                         * order. */
+                        if (drawing->columns == NULL)
+                        {
+                                drawing->columns = jobs[i].columns;
+                        }
+                        else
+                        {
+                                dxf_columns_append (drawing->columns,
+                                  jobs[i].columns);
+                        }
+                }
+                if (jobs[i].result == NULL)
+                {
+                        continue;
+                }
+                if (strcmp (jobs[i].range->name, "HEADER") == 0)
+                {
+                        dxf_drawing_set_header (drawing, jobs[i].result);
+                }
+                else if (strcmp (jobs[i].range->name, "CLASSES") == 0)
+                {
+                        dxf_drawing_set_class_list (drawing, jobs[i].result);
+                }
+                else if (strcmp (jobs[i].range->name, "TABLES") == 0)
+                {
+                        dxf_drawing_set_tables_list (drawing, jobs[i].result);
+                }
+                else if (strcmp (jobs[i].range->name, "BLOCKS") == 0)
+                {
+                        dxf_drawing_set_block_list (drawing, jobs[i].result);
+                }
+                else if (strcmp (jobs[i].range->name, "OBJECTS") == 0)
+                {
+                        dxf_drawing_set_object_list (drawing, jobs[i].result);
+                }
+                else if (strcmp (jobs[i].range->name, "ENTITIES") == 0)
+                {
+                        if (drawing->entities_list == NULL)
+                        {
+                                dxf_drawing_set_entities_list (drawing, jobs[i].result);
+                        }
+                        else
+                        {
+                                dxf_entities_append ((DxfEntities *) drawing->entities_list,
+                                  jobs[i].result);
+                        }
+                }
+        }
+        dxf_read_close (fp);
+        for (i = 0; i < count; i++)
+        {
+                if (jobs[i].status != EXIT_SUCCESS)
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () could not read the %s section of file: %s.\n")),
+                          __FUNCTION__, jobs[i].range->name, filename);
+                        dxf_drawing_free (drawing);
+                        return (NULL);
+                }
+        }
+        dxf_drawing_index_handles (drawing);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (drawing);
+}
+
+
+/*!
+ * \brief Read a drawing from a DXF file like dxf_drawing_read (), keeping
+ * only the entities of the \c ENTITIES section which pass \c filter.
+ *
+ * Entities which do not pass are skipped without being allocated.
+ *
+ * \return a pointer to the drawing, to be freed with
+ * dxf_drawing_free (), or \c NULL when an error occurred.
+ */
+DxfDrawing *
+dxf_drawing_read_filtered
+(
+        const char *filename,
+                /*!< filename of input file (or device). */
+        int threads,
+                /*!< maximum number of threads to use, or \c 0 for one
+                 * thread per online processor. */
+        DxfFilter *filter
+                /*!< the filter, or \c NULL to read every entity. */
+)
+{
+        return (dxf_drawing_read_sections (filename, threads, filter, FALSE));
+}
+
+
+/*!
+ * \brief Read a drawing from a DXF file like dxf_drawing_read_filtered (),
+ * storing the \c LINE, \c POINT, \c CIRCLE and \c ARC entities in the
+ * columns of the drawing.
+ *
+ * These entities are read straight into contiguous arrays (see
+ * columns.h) instead of the lists of \c entities_list, only their
+ * geometry, handle, layer and color are kept.  The columns can be
+ * scanned without following pointers, and written with
+ * dxf_columns_write ().\n
+ * Entities in columns are not in the handle index of the drawing.
+ *
+ * \return a pointer to the drawing, to be freed with
+ * dxf_drawing_free (), or \c NULL when an error occurred.
+ */
+DxfDrawing *
+dxf_drawing_read_columnar
+(
+        const char *filename,
+                /*!< filename of input file (or device). */
+        int threads,
+                /*!< maximum number of threads to use, or \c 0 for one
+                 * thread per online processor. */
+        DxfFilter *filter
+                /*!< the filter, or \c NULL to read every entity. */
+)
+{
+        return (dxf_drawing_read_sections (filename, threads, filter, TRUE));
+}
+
+
+/*!
+ * \brief Pointers resolved by dxf_drawing_resolve_handles ().
+ */
+typedef struct
+dxf_drawing_resolve_struct
+{
+        DxfHandleTable *table;
+                /*!< Handles of the drawing. */
+        void (*callback) (DxfHandleEntry *from, int group_code,
+          DxfHandleEntry *to, void *user_data);
+                /*!< Called for every pointer. */
+        void *user_data;
+                /*!< Passed unchanged to \c callback. */
+} DxfDrawingResolve;
+
+
+/*!
+ * \brief Group codes of the pointers of an entity.
+ */
+static const int dxf_drawing_pointer_codes[] = {330, 347, 360, 390};
+
+
+/*!
+ * \brief The handle of a record as stored in a DxfHandleTable.
+ *
+ * \return \c id_code, or 0 when the record has no handle (\c id_code
+ * is 0 or -1).
+ */
+static uint64_t
+dxf_drawing_handle
+(
+        long id_code
+                /*!< the \c id_code member of the record. */
+)
+{
+        return ((id_code > 0) ? (uint64_t) id_code : 0);
+}
+
+
+/*!
+ * \brief The handle (group code 5) of an object.
+ *
+ * \return the handle, or 0 when the object has none.
+ */
+static uint64_t
+dxf_drawing_object_handle
+(
+        DxfObject *object
+                /*!< the object. */
+)
+{
+        int i;
+
+        for (i = 0; i < object->number_of_parameters; i++)
+        {
+                if ((object->parameter[i].group_code == 5)
+                  && (object->parameter[i].value.S != NULL))
+                {
+                        return (dxf_handle_parse (object->parameter[i].value.S));
+                }
+        }
+        return (0);
+}
+
+
+/*!
+ * \brief Add the handle of an entity to the handle table in
+ * \c user_data.
+ */
+static void
+dxf_drawing_index_entity
+(
+        DxfEntityType type,
+                /*!< type of the entity. */
+        void *entity,
+                /*!< the entity. */
+        void *user_data
+                /*!< the DxfHandleTable. */
+)
+{
+        dxf_handle_table_insert (user_data,
+          dxf_drawing_handle (dxf_entities_get_id_code (type, entity)),
+          DXF_HANDLE_KIND_ENTITY, type, entity);
+}
+
+
+/*!
+ * \brief Find the entry of the record pointing for
+ * dxf_drawing_resolve_handles ().
+ *
+ * A record without a handle of its own, or whose handle is carried by
+ * an earlier record, is described by \c self with handle 0.
+ *
+ * \return the entry of the record in the handle table, or \c self.
+ */
+static DxfHandleEntry *
+dxf_drawing_resolve_from
+(
+        DxfDrawingResolve *resolve,
+                /*!< the resolve pass. */
+        DxfHandleEntry *self,
+                /*!< room for the entry of a record without one. */
+        uint64_t handle,
+                /*!< handle of the record, or 0. */
+        DxfHandleKind kind,
+                /*!< kind of the record. */
+        DxfEntityType type,
+                /*!< type of an entity. */
+        void *object
+                /*!< the record. */
+)
+{
+        DxfHandleEntry *from;
+
+        from = dxf_handle_table_lookup (resolve->table, handle);
+        if ((from != NULL) && (from->object == object))
+        {
+                return (from);
+        }
+        self->handle = 0;
+        self->kind = kind;
+        self->type = type;
+        self->object = object;
+        return (self);
+}
+
+
+/*!
+ * \brief Resolve the pointer of \c from with group code \c group_code,
+ * when it has one.
+ */
+static void
+dxf_drawing_resolve_pointer
+(
+        DxfDrawingResolve *resolve,
+                /*!< the resolve pass. */
+        DxfHandleEntry *from,
+                /*!< the record pointing. */
+        int group_code,
+                /*!< group code of the pointer. */
+        const char *handle
+                /*!< the pointer, or \c NULL. */
+)
+{
+        if ((handle == NULL) || (*handle == '\0'))
+        {
+                return;
+        }
+        resolve->callback (from, group_code,
+          dxf_handle_table_lookup (resolve->table, dxf_handle_parse (handle)),
+          resolve->user_data);
+}
+
+
+/*!
+ * \brief Resolve the pointers of an entity for
+ * dxf_drawing_resolve_handles ().
+ */
+static void
+dxf_drawing_resolve_entity
+(
+        DxfEntityType type,
+                /*!< type of the entity. */
+        void *entity,
+                /*!< the entity. */
+        void *user_data
+                /*!< the DxfDrawingResolve. */
+)
+{
+        DxfDrawingResolve *resolve = user_data;
+        DxfHandleEntry self;
+        DxfHandleEntry *from;
+        size_t i;
+
+        from = dxf_drawing_resolve_from (resolve, &self,
+          dxf_drawing_handle (dxf_entities_get_id_code (type, entity)),
+          DXF_HANDLE_KIND_ENTITY, type, entity);
+        for (i = 0; i < sizeof (dxf_drawing_pointer_codes) / sizeof (int); i++)
+        {
+                dxf_drawing_resolve_pointer (resolve, from,
+                  dxf_drawing_pointer_codes[i],
+                  dxf_entities_get_pointer (type, entity,
+                  dxf_drawing_pointer_codes[i]));
+        }
+}
+
+
+/*!
+ * \brief Define the function adding the handles of the records of the
+ * table \c list of a DxfTables to a DxfHandleTable.
+ */
+#define DXF_DRAWING_INDEX_TABLE(list, record, kind) \
+static void \
+dxf_drawing_index_##list \
+( \
+        DxfTables *tables, \
+        DxfHandleTable *table \
+) \
+{ \
+        record *entry; \
+ \
+        for (entry = (record *) tables->list; entry != NULL; \
+          entry = (record *) entry->next) \
+        { \
+                dxf_handle_table_insert (table, \
+                  dxf_drawing_handle (entry->id_code), kind, \
+                  UNKNOWN_ENTITY, entry); \
+        } \
+}
+
+DXF_DRAWING_INDEX_TABLE (appids, DxfAppid, DXF_HANDLE_KIND_APPID)
+DXF_DRAWING_INDEX_TABLE (block_records, DxfBlockRecord, DXF_HANDLE_KIND_BLOCK_RECORD)
+DXF_DRAWING_INDEX_TABLE (dimstyles, DxfDimStyle, DXF_HANDLE_KIND_DIMSTYLE)
+DXF_DRAWING_INDEX_TABLE (layers, DxfLayer, DXF_HANDLE_KIND_LAYER)
+DXF_DRAWING_INDEX_TABLE (ltypes, DxfLType, DXF_HANDLE_KIND_LTYPE)
+DXF_DRAWING_INDEX_TABLE (styles, DxfStyle, DXF_HANDLE_KIND_STYLE)
+DXF_DRAWING_INDEX_TABLE (ucss, DxfUcs, DXF_HANDLE_KIND_UCS)
+DXF_DRAWING_INDEX_TABLE (views, DxfView, DXF_HANDLE_KIND_VIEW)
+DXF_DRAWING_INDEX_TABLE (vports, DxfVPort, DXF_HANDLE_KIND_VPORT)
+
+
+/*!
+ * \brief Define the function resolving the soft (330) and hard (360)
+ * owner pointers of the records of the table \c list of a DxfTables.
+ */
+#define DXF_DRAWING_RESOLVE_TABLE(list, record, kind) \
+static void \
+dxf_drawing_resolve_##list \
+( \
+        DxfTables *tables, \
+        DxfDrawingResolve *resolve \
+) \
+{ \
+        DxfHandleEntry self; \
+        DxfHandleEntry *from; \
+        record *entry; \
+ \
+        for (entry = (record *) tables->list; entry != NULL; \
+          entry = (record *) entry->next) \
+        { \
+                from = dxf_drawing_resolve_from (resolve, &self, \
+                  dxf_drawing_handle (entry->id_code), kind, \
+                  UNKNOWN_ENTITY, entry); \
+                dxf_drawing_resolve_pointer (resolve, from, 330, \
+                  entry->dictionary_owner_soft); \
+                dxf_drawing_resolve_pointer (resolve, from, 360, \
+                  entry->dictionary_owner_hard); \
+        } \
+}
+
+DXF_DRAWING_RESOLVE_TABLE (appids, DxfAppid, DXF_HANDLE_KIND_APPID)
+DXF_DRAWING_RESOLVE_TABLE (block_records, DxfBlockRecord, DXF_HANDLE_KIND_BLOCK_RECORD)
+DXF_DRAWING_RESOLVE_TABLE (ltypes, DxfLType, DXF_HANDLE_KIND_LTYPE)
+DXF_DRAWING_RESOLVE_TABLE (styles, DxfStyle, DXF_HANDLE_KIND_STYLE)
+DXF_DRAWING_RESOLVE_TABLE (ucss, DxfUcs, DXF_HANDLE_KIND_UCS)
+DXF_DRAWING_RESOLVE_TABLE (views, DxfView, DXF_HANDLE_KIND_VIEW)
+DXF_DRAWING_RESOLVE_TABLE (vports, DxfVPort, DXF_HANDLE_KIND_VPORT)
+
+
+/*!
+ * \brief Resolve the text style pointer (340) of the records of the
+ * \c DIMSTYLE table.
+ */
+static void
+dxf_drawing_resolve_dimstyles
+(
+        DxfTables *tables,
+                /*!< the tables. */
+        DxfDrawingResolve *resolve
+                /*!< the resolve pass. */
+)
+{
+        DxfHandleEntry self;
+        DxfHandleEntry *from;
+        DxfDimStyle *dimstyle;
+
+        for (dimstyle = (DxfDimStyle *) tables->dimstyles; dimstyle != NULL;
+          dimstyle = (DxfDimStyle *) dimstyle->next)
+        {
+                from = dxf_drawing_resolve_from (resolve, &self,
+                  dxf_drawing_handle (dimstyle->id_code),
+                  DXF_HANDLE_KIND_DIMSTYLE, UNKNOWN_ENTITY, dimstyle);
+                dxf_drawing_resolve_pointer (resolve, from, 340,
+                  dimstyle->dimtxsty);
+        }
+}
+
+
+/*!
+ * \brief Resolve the owner (330 and 360), material (347) and plot
+ * style (390) pointers of the records of the \c LAYER table.
+ */
+static void
+dxf_drawing_resolve_layers
+(
+        DxfTables *tables,
+                /*!< the tables. */
+        DxfDrawingResolve *resolve
+                /*!< the resolve pass. */
+)
+{
+        DxfHandleEntry self;
+        DxfHandleEntry *from;
+        DxfLayer *layer;
+
+        for (layer = (DxfLayer *) tables->layers; layer != NULL;
+          layer = (DxfLayer *) layer->next)
+        {
+                from = dxf_drawing_resolve_from (resolve, &self,
+                  dxf_drawing_handle (layer->id_code),
+                  DXF_HANDLE_KIND_LAYER, UNKNOWN_ENTITY, layer);
+                dxf_drawing_resolve_pointer (resolve, from, 330,
+                  layer->dictionary_owner_soft);
+                dxf_drawing_resolve_pointer (resolve, from, 347,
+                  layer->material);
+                dxf_drawing_resolve_pointer (resolve, from, 360,
+                  layer->dictionary_owner_hard);
+                dxf_drawing_resolve_pointer (resolve, from, 390,
+                  layer->plot_style_name);
+        }
+}
+
+
+/*!
+ * \brief A table of the \c TABLES section and the functions indexing
+ * and resolving the handles of its records.
+ */
+typedef struct
+dxf_drawing_handle_table_struct
+{
+        void (*index) (DxfTables *tables, DxfHandleTable *table);
+                /*!< Adds the handles of the records. */
+        void (*resolve) (DxfTables *tables, DxfDrawingResolve *resolve);
+                /*!< Resolves the pointers of the records. */
+} DxfDrawingHandleTable;
+
+
+/*!
+ * \brief All tables carrying handles, in the order of the \c TABLES
+ * section.
+ */
+static const DxfDrawingHandleTable dxf_drawing_handle_tables[] =
+{
+        {dxf_drawing_index_vports, dxf_drawing_resolve_vports},
+        {dxf_drawing_index_ltypes, dxf_drawing_resolve_ltypes},
+        {dxf_drawing_index_layers, dxf_drawing_resolve_layers},
+        {dxf_drawing_index_styles, dxf_drawing_resolve_styles},
+        {dxf_drawing_index_views, dxf_drawing_resolve_views},
+        {dxf_drawing_index_ucss, dxf_drawing_resolve_ucss},
+        {dxf_drawing_index_appids, dxf_drawing_resolve_appids},
+        {dxf_drawing_index_dimstyles, dxf_drawing_resolve_dimstyles},
+        {dxf_drawing_index_block_records, dxf_drawing_resolve_block_records}
+};
+
+
+/*!
+ * \brief Resolve the pointers of an object for
+ * dxf_drawing_resolve_handles ().
+ *
+ * Every handle valued group code but the handle of the object itself
+ * is a pointer: owners, reactors and the entries of a dictionary.
+ */
+static void
+dxf_drawing_resolve_object
+(
+        DxfDrawingResolve *resolve,
+                /*!< the resolve pass. */
+        DxfObject *object
+                /*!< the object. */
+)
+{
+        DxfHandleEntry self;
+        DxfHandleEntry *from;
+        DxfParam *parameter;
+        int i;
+
+        from = dxf_drawing_resolve_from (resolve, &self,
+          dxf_drawing_object_handle (object), DXF_HANDLE_KIND_OBJECT,
+          UNKNOWN_ENTITY, object);
+        for (i = 0; i < object->number_of_parameters; i++)
+        {
+                parameter = &object->parameter[i];
+                if ((parameter->group_code != 5)
+                  && (parameter->type == DXF_GROUP_CODE_TYPE_HANDLE))
+                {
+                        dxf_drawing_resolve_pointer (resolve, from,
+                          parameter->group_code, parameter->value.S);
+                }
+        }
+}
+
+
+/*!
+ * \brief Build the table of the handles of the table records, blocks,
+ * entities and objects in \c drawing.
+ *
+ * dxf_drawing_read () builds the table while loading, call this
+ * function again after adding or removing records.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_drawing_index_handles
+(
+        DxfDrawing *drawing
+                /*!< a pointer to a libDXF drawing. */
+)
+{
+        DxfHandleTable *table;
+        DxfBlock *block;
+        DxfObject *object;
+        size_t i;
+
+        /* Do some basic checks. */
+        if (drawing == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        table = dxf_handle_table_new (0);
+        if (table == NULL)
+        {
+                return (EXIT_FAILURE);
+        }
+        if (drawing->tables_list != NULL)
+        {
+                for (i = 0; i < sizeof (dxf_drawing_handle_tables) / sizeof (DxfDrawingHandleTable); i++)
+                {
+                        dxf_drawing_handle_tables[i].index
+                          ((DxfTables *) drawing->tables_list, table);
+                }
+        }
+        for (block = (DxfBlock *) drawing->block_list; block != NULL;
+          block = (DxfBlock *) block->next)
+        {
+                dxf_handle_table_insert (table,
+                  dxf_drawing_handle (block->id_code),
+                  DXF_HANDLE_KIND_BLOCK, UNKNOWN_ENTITY, block);
+        }
+        if (drawing->entities_list != NULL)
+        {
+                dxf_entities_walk ((DxfEntities *) drawing->entities_list,
+                  dxf_drawing_index_entity, table);
+        }
+        for (object = (DxfObject *) drawing->object_list; object != NULL;
+          object = (DxfObject *) object->next)
+        {
+                dxf_handle_table_insert (table,
+                  dxf_drawing_object_handle (object),
+                  DXF_HANDLE_KIND_OBJECT, UNKNOWN_ENTITY, object);
+        }
+        if (drawing->handles != NULL)
+        {
+                dxf_handle_table_free (drawing->handles);
+        }
+        drawing->handles = table;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Find the table record, block, entity or object carrying
+ * \c handle in \c drawing.
+ *
+ * Use dxf_handle_parse () for a handle as written in a DXF file.
+ *
+ * \return the record, or \c NULL when no record carries the handle.
+ */
+DxfHandleEntry *
+dxf_drawing_lookup_handle
+(
+        DxfDrawing *drawing,
+                /*!< a pointer to a libDXF drawing. */
+        uint64_t handle
+                /*!< the handle. */
+)
+{
+        if (drawing == NULL)
+        {
+                return (NULL);
+        }
+        if ((drawing->handles == NULL)
+          && (dxf_drawing_index_handles (drawing) == EXIT_FAILURE))
+        {
+                return (NULL);
+        }
+        return (dxf_handle_table_lookup (drawing->handles, handle));
+}
+
+
+/*!
+ * \brief Resolve every pointer of the table records, blocks, entities
+ * and objects in \c drawing.
+ *
+ * \c callback is called for every pointer, with the record pointing
+ * and the record pointed to: the soft (330) and hard (360) owners of
+ * the table records, blocks and entities, the material (347) and plot
+ * style (390) of the layers and entities, the text style (340) of the
+ * dimension styles and every handle valued group code of the objects.
+ * Table records come first, then the blocks, the entities list by list
+ * and the objects.  The record pointed to is \c NULL for a pointer to a
+ * record which was not read (e.g. a \c TABLE header).
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_drawing_resolve_handles
+(
+        DxfDrawing *drawing,
+                /*!< a pointer to a libDXF drawing. */
+        void (*callback) (DxfHandleEntry *from, int group_code,
+          DxfHandleEntry *to, void *user_data),
+                /*!< called for every pointer. */
+        void *user_data
+                /*!< passed unchanged to \c callback. */
+)
+{
+        DxfDrawingResolve resolve;
+        DxfHandleEntry self;
+        DxfHandleEntry *from;
+        DxfBlock *block;
+        DxfObject *object;
+        size_t i;
+
+        /* Do some basic checks. */
+        if ((drawing == NULL) || (callback == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if ((drawing->handles == NULL)
+          && (dxf_drawing_index_handles (drawing) == EXIT_FAILURE))
+        {
+                return (EXIT_FAILURE);
+        }
+        resolve.table = drawing->handles;
+        resolve.callback = callback;
+        resolve.user_data = user_data;
+        if (drawing->tables_list != NULL)
+        {
+                for (i = 0; i < sizeof (dxf_drawing_handle_tables) / sizeof (DxfDrawingHandleTable); i++)
+                {
+                        dxf_drawing_handle_tables[i].resolve
+                          ((DxfTables *) drawing->tables_list, &resolve);
+                }
+        }
+        for (block = (DxfBlock *) drawing->block_list; block != NULL;
+          block = (DxfBlock *) block->next)
+        {
+                from = dxf_drawing_resolve_from (&resolve, &self,
+                  dxf_drawing_handle (block->id_code),
+                  DXF_HANDLE_KIND_BLOCK, UNKNOWN_ENTITY, block);
+                dxf_drawing_resolve_pointer (&resolve, from, 330,
+                  block->dictionary_owner_soft);
+        }
+        if (drawing->entities_list != NULL)
+        {
+                dxf_entities_walk ((DxfEntities *) drawing->entities_list,
+                  dxf_drawing_resolve_entity, &resolve);
+        }
+        for (object = (DxfObject *) drawing->object_list; object != NULL;
+          object = (DxfObject *) object->next)
+        {
+                dxf_drawing_resolve_object (&resolve, object);
+        }
+        return (EXIT_SUCCESS);
+}
+
+
 /* EOF*/
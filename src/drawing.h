@@ -37,12 +37,18 @@
 
 
 #include "global.h"
+#include "arena.h"
 #include "header.h"
 #include "class.h"
 #include "tables.h"
 #include "block.h"
 #include "global.h"
 #include "entities.h"
+#include "columns.h"
+#include "filter.h"
+#include "graphic_properties.h"
+#include "handle_table.h"
+#include "string_pool.h"
 #include "object.h"
 #include "thumbnail.h"
 
@@ -72,6 +78,24 @@ dxf_drawing_struct
         /*!< Objects section data (single linked list).*/
     struct DxfThumbnail *thumbnail;
         /*!< Thumbnail data.*/
+    struct dxf_handle_table_struct *handles;
+        /*!< Handles of the table records, blocks, entities and
+         * objects, or \c NULL when they have not been indexed (see
+         * dxf_drawing_index_handles ()).*/
+    struct dxf_string_pool_struct *strings;
+        /*!< Pool holding the layer, linetype, color and pointer strings
+         * of the entities, or \c NULL when they have their own copies.*/
+    struct dxf_graphic_properties_pool_struct *properties;
+        /*!< Pool holding the graphic property records shared by the
+         * entities, or \c NULL when they have records of their own.*/
+    struct dxf_arena_struct *arena;
+        /*!< Arenas holding the entities, released by
+         * dxf_drawing_free () without visiting the entities, or \c NULL
+         * when the entities were allocated one by one.*/
+    struct dxf_columns_struct *columns;
+        /*!< The \c LINE, \c POINT, \c CIRCLE and \c ARC entities in
+         * columns, or \c NULL when they are in \c entities_list (see
+         * dxf_drawing_read_columnar ()).*/
 } DxfDrawing;
 
 
@@ -83,6 +107,45 @@ dxf_drawing_init
         DxfDrawing *drawing,
         int acad_version_number
 );
+DxfDrawing *
+dxf_drawing_read
+(
+        const char *filename,
+        int threads
+);
+DxfDrawing *
+dxf_drawing_read_filtered
+(
+        const char *filename,
+        int threads,
+        DxfFilter *filter
+);
+DxfDrawing *
+dxf_drawing_read_columnar
+(
+        const char *filename,
+        int threads,
+        DxfFilter *filter
+);
+int
+dxf_drawing_index_handles
+(
+        DxfDrawing *drawing
+);
+DxfHandleEntry *
+dxf_drawing_lookup_handle
+(
+        DxfDrawing *drawing,
+        uint64_t handle
+);
+int
+dxf_drawing_resolve_handles
+(
+        DxfDrawing *drawing,
+        void (*callback) (DxfHandleEntry *from, int group_code,
+          DxfHandleEntry *to, void *user_data),
+        void *user_data
+);
 int
 dxf_drawing_free
 (
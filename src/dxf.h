@@ -42,6 +42,7 @@
 #include "acad_proxy_entity.h"
 #include "appid.h"
 #include "arc.h"
+#include "arena.h"
 #include "attdef.h"
 #include "attrib.h"
 #include "binary_entity_data.h"
@@ -52,21 +53,28 @@
 #include "circle.h"
 #include "class.h"
 #include "color.h"
+#include "columns.h"
 #include "comment.h"
+#include "compress.h"
 #include "dictionary.h"
 #include "dictionaryvar.h"
 #include "dimension.h"
 #include "dimstyle.h"
 #include "donut.h"
+#include "drawing.h"
 #include "ellipse.h"
 #include "endblk.h"
 #include "endsec.h"
 #include "endtab.h"
 #include "entities.h"
 #include "entity.h"
+#include "entity_index.h"
 #include "file.h"
+#include "filter.h"
 #include "global.h"
+#include "graphic_properties.h"
 #include "group.h"
+#include "handle_table.h"
 #include "hatch.h"
 #include "header.h"
 #include "helix.h"
@@ -78,12 +86,14 @@
 #include "layer.h"
 #include "layer_index.h"
 #include "leader.h"
+#include "lexer.h"
 #include "line.h"
 #include "ltype.h"
 #include "lwpolyline.h"
 #include "mline.h"
 #include "mlinestyle.h"
 #include "mtext.h"
+#include "number.h"
 #include "object.h"
 #include "object_ptr.h"
 #include "oleframe.h"
@@ -101,6 +111,8 @@
 #include "sortentstable.h"
 #include "spatial_filter.h"
 #include "spatial_index.h"
+#include "stream.h"
+#include "string_pool.h"
 #include "style.h"
 #include "table.h"
 #include "tables.h"
@@ -114,6 +126,7 @@
 #include "view.h"
 #include "viewport.h"
 #include "vport.h"
+#include "writer.h"
 #include "xline.h"
 #include "xrecord.h"
 
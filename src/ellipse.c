@@ -39,6 +39,9 @@
 
 
 #include "ellipse.h"
+#include "arena.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -61,7 +64,7 @@ dxf_ellipse_new ()
         size = sizeof (DxfEllipse);
         /* avoid malloc of 0 bytes */
         if (size == 0) size = 1;
-        if ((ellipse = malloc (size)) == NULL)
+        if ((ellipse = dxf_malloc (size)) == NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () could not allocate memory for a DxfEllipse struct.\n")),
@@ -112,25 +115,11 @@ dxf_ellipse_init
               return (NULL);
         }
         dxf_ellipse_set_id_code (ellipse, 0);
-        dxf_ellipse_set_linetype (ellipse, strdup (DXF_DEFAULT_LINETYPE));
-        dxf_ellipse_set_layer (ellipse, strdup (DXF_DEFAULT_LAYER));
-        dxf_ellipse_set_elevation (ellipse, 0.0);
-        dxf_ellipse_set_thickness (ellipse, 0.0);
-        dxf_ellipse_set_linetype_scale (ellipse, DXF_DEFAULT_LINETYPE_SCALE);
-        dxf_ellipse_set_visibility (ellipse, DXF_DEFAULT_VISIBILITY);
-        dxf_ellipse_set_color (ellipse, DXF_COLOR_BYLAYER);
-        dxf_ellipse_set_paperspace (ellipse, DXF_MODELSPACE);
+        ellipse->properties = dxf_graphic_properties_default ();
         dxf_ellipse_set_graphics_data_size (ellipse, 0);
-        dxf_ellipse_set_shadow_mode (ellipse, 0);
         dxf_ellipse_set_binary_graphics_data (ellipse, (DxfBinaryGraphicsData *) dxf_binary_graphics_data_new ());
-        dxf_ellipse_set_dictionary_owner_soft (ellipse, strdup (""));
-        dxf_ellipse_set_material (ellipse, strdup (""));
-        dxf_ellipse_set_dictionary_owner_hard (ellipse, strdup (""));
-        dxf_ellipse_set_lineweight (ellipse, 0);
-        dxf_ellipse_set_plot_style_name (ellipse, strdup (""));
-        dxf_ellipse_set_color_value (ellipse, 0);
-        dxf_ellipse_set_color_name (ellipse, strdup (""));
-        dxf_ellipse_set_transparency (ellipse, 0);
+        dxf_ellipse_set_dictionary_owner_soft (ellipse, "");
+        dxf_ellipse_set_dictionary_owner_hard (ellipse, "");
         dxf_ellipse_set_p0 (ellipse, (DxfPoint *) dxf_point_new ());
         dxf_point_init ((DxfPoint *) dxf_ellipse_get_p0 (ellipse));
         dxf_ellipse_set_x0 (ellipse, 0.0);
@@ -178,7 +167,9 @@ dxf_ellipse_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfGraphicProperties properties;
+        DxfPair pair;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -186,8 +177,6 @@ dxf_ellipse_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (ellipse == NULL)
@@ -198,228 +187,188 @@ dxf_ellipse_read
                 ellipse = dxf_ellipse_new ();
                 ellipse = dxf_ellipse_init (ellipse);
         }
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        dxf_graphic_properties_start (&properties, ellipse->properties);
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        fclose (fp->fp);
-                        /* Clean up. */
-                        free (temp_string);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &ellipse->id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", ellipse->linetype);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", ellipse->layer);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the center point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ellipse->x0);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the center point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ellipse->y0);
-                }
-                else if (strcmp (temp_string, "30") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the center point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ellipse->z0);
-                }
-                else if (strcmp (temp_string, "11") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the center point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ellipse->x1);
-                }
-                else if (strcmp (temp_string, "21") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the center point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ellipse->y1);
-                }
-                else if (strcmp (temp_string, "31") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the center point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ellipse->z1);
-                }
-                else if ((fp->acad_version_number <= AutoCAD_11)
-                        && (strcmp (temp_string, "38") == 0)
-                        && (ellipse->elevation = 0.0))
-                {
-                        /* Elevation is a pre AutoCAD R11 variable
-                         * so additional testing for the version should
-                         * probably be added.
-                         * Now follows a string containing the
-                         * elevation. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ellipse->elevation);
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ellipse->thickness);
-                }
-                else if (strcmp (temp_string, "40") == 0)
-                {
-                        /* Now follows a string containing the
-                         * radius. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ellipse->ratio);
-                }
-                else if (strcmp (temp_string, "41") == 0)
-                {
-                        /* Now follows a string containing the
-                         * start angle. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ellipse->start_angle);
-                }
-                else if (strcmp (temp_string, "42") == 0)
-                {
-                        /* Now follows a string containing the
-                         * end angle. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ellipse->end_angle);
-                }
-                else if (strcmp (temp_string, "48") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing the linetype
-                         * scale. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ellipse->linetype_scale);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else if (strcmp (temp_string, "60") == 0)
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing the
-                         * visibility value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &ellipse->visibility);
-                }
-                else if (strcmp (temp_string, "62") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &ellipse->color);
-                }
-                else if (strcmp (temp_string, "67") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &ellipse->paperspace);
-                }
-                else if ((fp->acad_version_number >= AutoCAD_12)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Subclass markers are post AutoCAD R12
-                         * variable so additional testing for the
-                         * version should probably be added here.
-                         * Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if ((strcmp (temp_string, "AcDbEntity") != 0)
-                        && ((strcmp (temp_string, "AcDbEllipse") != 0)))
-                        {
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                ellipse->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 6:
+                                /* Now follows a string containing a linetype
+                                 * name. */
+                                dxf_lexer_free_string (fp, properties.linetype);
+                                properties.linetype = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 8:
+                                /* Now follows a string containing a layer name. */
+                                dxf_lexer_free_string (fp, properties.layer);
+                                properties.layer = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 10:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the center point. */
+                                ellipse->x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 20:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the center point. */
+                                ellipse->y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 30:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the center point. */
+                                ellipse->z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 11:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the center point. */
+                                ellipse->x1 = dxf_pair_get_double (&pair);
+                                break;
+                        case 21:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the center point. */
+                                ellipse->y1 = dxf_pair_get_double (&pair);
+                                break;
+                        case 31:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the center point. */
+                                ellipse->z1 = dxf_pair_get_double (&pair);
+                                break;
+                        case 38:
+                                if ((fp->acad_version_number <= AutoCAD_11)
+                                  && (properties.elevation = 0.0))
+                                {
+                                        /* Elevation is a pre AutoCAD R11 variable
+                                         * so additional testing for the version should
+                                         * probably be added.
+                                         * Now follows a string containing the
+                                         * elevation. */
+                                        properties.elevation = dxf_pair_get_double (&pair);
+                                }
+                                break;
+                        case 39:
+                                /* Now follows a string containing the
+                                 * thickness. */
+                                properties.thickness = dxf_pair_get_double (&pair);
+                                break;
+                        case 40:
+                                /* Now follows a string containing the
+                                 * radius. */
+                                ellipse->ratio = dxf_pair_get_double (&pair);
+                                break;
+                        case 41:
+                                /* Now follows a string containing the
+                                 * start angle. */
+                                ellipse->start_angle = dxf_pair_get_double (&pair);
+                                break;
+                        case 42:
+                                /* Now follows a string containing the
+                                 * end angle. */
+                                ellipse->end_angle = dxf_pair_get_double (&pair);
+                                break;
+                        case 48:
+                                /* Now follows a string containing the linetype
+                                 * scale. */
+                                properties.linetype_scale = dxf_pair_get_double (&pair);
+                                break;
+                        case 60:
+                                /* Now follows a string containing the
+                                 * visibility value. */
+                                properties.visibility = dxf_pair_get_int (&pair);
+                                break;
+                        case 62:
+                                /* Now follows a string containing the
+                                 * color value. */
+                                properties.color = dxf_pair_get_int (&pair);
+                                break;
+                        case 67:
+                                /* Now follows a string containing the
+                                 * paperspace value. */
+                                properties.paperspace = dxf_pair_get_int (&pair);
+                                break;
+                        case 100:
+                                if (fp->acad_version_number >= AutoCAD_12)
+                                {
+                                        /* Subclass markers are post AutoCAD R12
+                                         * variable so additional testing for the
+                                         * version should probably be added here.
+                                         * Now follows a string containing the
+                                         * subclass marker value. */
+                                        dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                        if ((strcmp (temp_string, "AcDbEntity") != 0)
+                                        && ((strcmp (temp_string, "AcDbEllipse") != 0)))
+                                        {
+                                                fprintf (stderr,
+                                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                                  __FUNCTION__, fp->filename, fp->line_number);
+                                        }
+                                }
+                                break;
+                        case 210:
+                                /* Now follows a string containing the
+                                 * X-value of the extrusion vector. */
+                                ellipse->extr_x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 220:
+                                /* Now follows a string containing the
+                                 * Y-value of the extrusion vector. */
+                                ellipse->extr_y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 230:
+                                /* Now follows a string containing the
+                                 * Z-value of the extrusion vector. */
+                                ellipse->extr_z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, ellipse->dictionary_owner_soft);
+                                ellipse->dictionary_owner_soft = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, ellipse->dictionary_owner_hard);
+                                ellipse->dictionary_owner_hard = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, "DXF comment: %s\n", temp_string);
+                                break;
+                        default:
                                 fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
                                   __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "210") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ellipse->extr_x0);
-                }
-                else if (strcmp (temp_string, "220") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ellipse->extr_y0);
-                }
-                else if (strcmp (temp_string, "230") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ellipse->extr_z0);
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", ellipse->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", ellipse->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
         /* Handle omitted members and/or illegal values. */
-        if (strcmp (ellipse->linetype, "") == 0)
+        if ((properties.linetype != NULL)
+          && (strcmp (properties.linetype, "") == 0))
         {
-                ellipse->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_lexer_free_string (fp, properties.linetype);
+                properties.linetype = dxf_strdup (DXF_DEFAULT_LINETYPE);
         }
-        if (strcmp (ellipse->layer, "") == 0)
+        if ((properties.layer != NULL)
+          && (strcmp (properties.layer, "") == 0))
         {
-                ellipse->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_lexer_free_string (fp, properties.layer);
+                properties.layer = dxf_strdup (DXF_DEFAULT_LAYER);
         }
-        /* Clean up. */
-        free (temp_string);
+        /* Entities with equal properties share a record. */
+        dxf_graphic_properties_finish (fp, &ellipse->properties, &properties);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -448,7 +397,7 @@ dxf_ellipse_write
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *dxf_entity_name = strdup ("ELLIPSE");
+        char *dxf_entity_name = dxf_strdup ("ELLIPSE");
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -457,7 +406,7 @@ dxf_ellipse_write
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (fp->acad_version_number < AutoCAD_13)
@@ -466,7 +415,7 @@ dxf_ellipse_write
                   (_("Error in %s () illegal DXF version for this entity.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (ellipse == NULL)
@@ -475,43 +424,43 @@ dxf_ellipse_write
                   (_("Error in %s () a NULL pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (ellipse->ratio == 0.0)
         {
                 fprintf (stderr,
-                  (_("Error in %s () ratio value equals 0.0 for the %s entity with id-code: %x\n")),
+                  (_("Error in %s () ratio value equals 0.0 for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, ellipse->id_code);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
-        if (strcmp (ellipse->linetype, "") == 0)
+        if (strcmp (ellipse->properties->linetype, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, ellipse->id_code);
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                ellipse->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_ellipse_set_linetype (ellipse, DXF_DEFAULT_LINETYPE);
         }
-        if (strcmp (ellipse->layer, "") == 0)
+        if (strcmp (ellipse->properties->layer, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty layer string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty layer string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, ellipse->id_code);
                 fprintf (stderr,
                   (_("\t%s entity is relocated to layer 0")),
                   dxf_entity_name);
-                ellipse->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_ellipse_set_layer (ellipse, DXF_DEFAULT_LAYER);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_string (fp, 0, dxf_entity_name);
         if (ellipse->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", ellipse->id_code);
+                dxf_write_hex (fp, 5, ellipse->id_code);
         }
         /*!
          * \todo for version R14.\n
@@ -526,71 +475,71 @@ dxf_ellipse_write
         if ((strcmp (ellipse->dictionary_owner_soft, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", ellipse->dictionary_owner_soft);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, ellipse->dictionary_owner_soft);
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (ellipse->dictionary_owner_hard, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", ellipse->dictionary_owner_hard);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, ellipse->dictionary_owner_hard);
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbEntity\n");
+                dxf_write_string (fp, 100, "AcDbEntity");
         }
-        if (ellipse->paperspace == DXF_PAPERSPACE)
+        if (ellipse->properties->paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp->fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_int (fp, 67, DXF_PAPERSPACE);
         }
-        fprintf (fp->fp, "  8\n%s\n", ellipse->layer);
-        if (strcmp (ellipse->linetype, DXF_DEFAULT_LINETYPE) != 0)
+        dxf_write_string (fp, 8, ellipse->properties->layer);
+        if (strcmp (ellipse->properties->linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp->fp, "  6\n%s\n", ellipse->linetype);
+                dxf_write_string (fp, 6, ellipse->properties->linetype);
         }
         if ((fp->acad_version_number <= AutoCAD_11)
           && DXF_FLATLAND
-          && (ellipse->elevation != 0.0))
+          && (ellipse->properties->elevation != 0.0))
         {
-                fprintf (fp->fp, " 38\n%f\n", ellipse->elevation);
+                dxf_write_double (fp, 38, ellipse->properties->elevation);
         }
         if ((fp->acad_version_number <= AutoCAD_13)
-          && (ellipse->thickness != 0.0))
+          && (ellipse->properties->thickness != 0.0))
         {
-                fprintf (fp->fp, " 39\n%f\n", ellipse->thickness);
+                dxf_write_double (fp, 39, ellipse->properties->thickness);
         }
-        if (ellipse->color != DXF_COLOR_BYLAYER)
+        if (ellipse->properties->color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp->fp, " 62\n%d\n", ellipse->color);
+                dxf_write_int (fp, 62, ellipse->properties->color);
         }
-        if (ellipse->linetype_scale != 1.0)
+        if (ellipse->properties->linetype_scale != 1.0)
         {
-                fprintf (fp->fp, " 48\n%f\n", ellipse->linetype_scale);
+                dxf_write_double (fp, 48, ellipse->properties->linetype_scale);
         }
-        if (ellipse->visibility != 0)
+        if (ellipse->properties->visibility != 0)
         {
-                fprintf (fp->fp, " 60\n%d\n", ellipse->visibility);
+                dxf_write_int (fp, 60, ellipse->properties->visibility);
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbEllipse\n");
-        }
-        fprintf (fp->fp, " 10\n%f\n", ellipse->x0);
-        fprintf (fp->fp, " 20\n%f\n", ellipse->y0);
-        fprintf (fp->fp, " 30\n%f\n", ellipse->z0);
-        fprintf (fp->fp, " 11\n%f\n", ellipse->x1);
-        fprintf (fp->fp, " 21\n%f\n", ellipse->y1);
-        fprintf (fp->fp, " 31\n%f\n", ellipse->z1);
-        fprintf (fp->fp, " 210\n%f\n", ellipse->extr_x0);
-        fprintf (fp->fp, " 220\n%f\n", ellipse->extr_y0);
-        fprintf (fp->fp, " 230\n%f\n", ellipse->extr_z0);
-        fprintf (fp->fp, " 40\n%f\n", ellipse->ratio);
-        fprintf (fp->fp, " 41\n%f\n", ellipse->start_angle);
-        fprintf (fp->fp, " 42\n%f\n", ellipse->end_angle);
+                dxf_write_string (fp, 100, "AcDbEllipse");
+        }
+        dxf_write_double (fp, 10, ellipse->x0);
+        dxf_write_double (fp, 20, ellipse->y0);
+        dxf_write_double (fp, 30, ellipse->z0);
+        dxf_write_double (fp, 11, ellipse->x1);
+        dxf_write_double (fp, 21, ellipse->y1);
+        dxf_write_double (fp, 31, ellipse->z1);
+        dxf_write_double (fp, 210, ellipse->extr_x0);
+        dxf_write_double (fp, 220, ellipse->extr_y0);
+        dxf_write_double (fp, 230, ellipse->extr_z0);
+        dxf_write_double (fp, 40, ellipse->ratio);
+        dxf_write_double (fp, 41, ellipse->start_angle);
+        dxf_write_double (fp, 42, ellipse->end_angle);
         /* Clean up. */
-        free (dxf_entity_name);
+        dxf_free (dxf_entity_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -623,11 +572,13 @@ dxf_ellipse_free
                 __FUNCTION__);
               return (EXIT_FAILURE);
         }
-        free (ellipse->linetype);
-        free (ellipse->layer);
-        free (ellipse->dictionary_owner_soft);
-        free (ellipse->dictionary_owner_hard);
-        free (ellipse);
+        dxf_graphic_properties_free (ellipse->properties);
+        dxf_free (ellipse->dictionary_owner_soft);
+        dxf_free (ellipse->dictionary_owner_hard);
+        dxf_binary_graphics_data_free_chain (ellipse->binary_graphics_data);
+        dxf_point_free (ellipse->p0);
+        dxf_point_free (ellipse->p1);
+        dxf_free (ellipse);
         ellipse = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -647,7 +598,7 @@ dxf_ellipse_free_chain
                 /*!< pointer to the chain of DXF \c ELLIPSE entities. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (ellipses == NULL)
@@ -673,7 +624,7 @@ dxf_ellipse_free_chain
  *
  * \return \c id_code.
  */
-int
+long
 dxf_ellipse_get_id_code
 (
         DxfEllipse *ellipse
@@ -713,7 +664,7 @@ dxf_ellipse_set_id_code
 (
         DxfEllipse *ellipse,
                 /*!< a pointer to a DXF \c ELLIPSE entity. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -768,7 +719,7 @@ dxf_ellipse_get_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        if (ellipse->linetype ==  NULL)
+        if (ellipse->properties->linetype ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the linetype member.\n")),
@@ -778,7 +729,7 @@ dxf_ellipse_get_linetype
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (ellipse->linetype));
+        return (dxf_strdup (ellipse->properties->linetype));
 }
 
 
@@ -812,7 +763,12 @@ dxf_ellipse_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        ellipse->linetype = strdup (linetype);
+        if (dxf_graphic_properties_unshare (&ellipse->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (ellipse->properties->linetype);
+        ellipse->properties->linetype = dxf_strdup (linetype);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -843,7 +799,7 @@ dxf_ellipse_get_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        if (ellipse->layer ==  NULL)
+        if (ellipse->properties->layer ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the layer member.\n")),
@@ -853,7 +809,7 @@ dxf_ellipse_get_layer
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (ellipse->layer));
+        return (dxf_strdup (ellipse->properties->layer));
 }
 
 
@@ -887,7 +843,12 @@ dxf_ellipse_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        ellipse->layer = strdup (layer);
+        if (dxf_graphic_properties_unshare (&ellipse->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (ellipse->properties->layer);
+        ellipse->properties->layer = dxf_strdup (layer);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -921,7 +882,7 @@ dxf_ellipse_get_elevation
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (ellipse->elevation);
+        return (ellipse->properties->elevation);
 }
 
 
@@ -948,7 +909,11 @@ dxf_ellipse_set_elevation
                   __FUNCTION__);
                 return (NULL);
         }
-        ellipse->elevation = elevation;
+        if (dxf_graphic_properties_unshare (&ellipse->properties) == NULL)
+        {
+                return (NULL);
+        }
+        ellipse->properties->elevation = elevation;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -979,7 +944,7 @@ dxf_ellipse_get_thickness
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (ellipse->thickness < 0.0)
+        if (ellipse->properties->thickness < 0.0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found in the thickness member.\n")),
@@ -989,7 +954,7 @@ dxf_ellipse_get_thickness
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (ellipse->thickness);
+        return (ellipse->properties->thickness);
 }
 
 
@@ -1023,7 +988,11 @@ dxf_ellipse_set_thickness
                   __FUNCTION__);
                 return (NULL);
         }
-        ellipse->thickness = thickness;
+        if (dxf_graphic_properties_unshare (&ellipse->properties) == NULL)
+        {
+                return (NULL);
+        }
+        ellipse->properties->thickness = thickness;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1054,7 +1023,7 @@ dxf_ellipse_get_linetype_scale
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (ellipse->linetype_scale < 0.0)
+        if (ellipse->properties->linetype_scale < 0.0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found in the linetype scale member.\n")),
@@ -1064,7 +1033,7 @@ dxf_ellipse_get_linetype_scale
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (ellipse->linetype_scale);
+        return (ellipse->properties->linetype_scale);
 }
 
 
@@ -1098,7 +1067,11 @@ dxf_ellipse_set_linetype_scale
                   __FUNCTION__);
                 return (NULL);
         }
-        ellipse->linetype_scale = linetype_scale;
+        if (dxf_graphic_properties_unshare (&ellipse->properties) == NULL)
+        {
+                return (NULL);
+        }
+        ellipse->properties->linetype_scale = linetype_scale;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1129,14 +1102,14 @@ dxf_ellipse_get_visibility
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (ellipse->visibility < 0)
+        if (ellipse->properties->visibility < 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found in the visibility member.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (ellipse->visibility > 1)
+        if (ellipse->properties->visibility > 1)
         {
                 fprintf (stderr,
                   (_("Error in %s () an out of range value was found in the visibility member.\n")),
@@ -1146,7 +1119,7 @@ dxf_ellipse_get_visibility
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (ellipse->visibility);
+        return (ellipse->properties->visibility);
 }
 
 
@@ -1187,7 +1160,11 @@ dxf_ellipse_set_visibility
                   __FUNCTION__);
                 return (NULL);
         }
-        ellipse->visibility = visibility;
+        if (dxf_graphic_properties_unshare (&ellipse->properties) == NULL)
+        {
+                return (NULL);
+        }
+        ellipse->properties->visibility = visibility;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1218,7 +1195,7 @@ dxf_ellipse_get_color
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (ellipse->color < 0)
+        if (ellipse->properties->color < 0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found in the color member.\n")),
@@ -1227,7 +1204,7 @@ dxf_ellipse_get_color
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (ellipse->color);
+        return (ellipse->properties->color);
 }
 
 
@@ -1262,7 +1239,11 @@ dxf_ellipse_set_color
                 fprintf (stderr,
                   (_("\teffectively turning this entity it's visibility off.\n")));
         }
-        ellipse->color = color;
+        if (dxf_graphic_properties_unshare (&ellipse->properties) == NULL)
+        {
+                return (NULL);
+        }
+        ellipse->properties->color = color;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1293,13 +1274,13 @@ dxf_ellipse_get_paperspace
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (ellipse->paperspace < 0)
+        if (ellipse->properties->paperspace < 0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found in the paperspace member.\n")),
                   __FUNCTION__);
         }
-        if (ellipse->paperspace > 1)
+        if (ellipse->properties->paperspace > 1)
         {
                 fprintf (stderr,
                   (_("Warning in %s () an out of range value was found in the paperspace member.\n")),
@@ -1308,7 +1289,7 @@ dxf_ellipse_get_paperspace
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (ellipse->paperspace);
+        return (ellipse->properties->paperspace);
 }
 
 
@@ -1349,7 +1330,11 @@ dxf_ellipse_set_paperspace
                   __FUNCTION__);
                 return (NULL);
         }
-        ellipse->paperspace = paperspace;
+        if (dxf_graphic_properties_unshare (&ellipse->properties) == NULL)
+        {
+                return (NULL);
+        }
+        ellipse->properties->paperspace = paperspace;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1474,14 +1459,14 @@ dxf_ellipse_get_shadow_mode
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (ellipse->shadow_mode < 0)
+        if (ellipse->properties->shadow_mode < 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found in the shadow_mode member.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (ellipse->shadow_mode > 3)
+        if (ellipse->properties->shadow_mode > 3)
         {
                 fprintf (stderr,
                   (_("Error in %s () an out of range value was found in the shadow_mode member.\n")),
@@ -1491,7 +1476,7 @@ dxf_ellipse_get_shadow_mode
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (ellipse->shadow_mode);
+        return (ellipse->properties->shadow_mode);
 }
 
 
@@ -1535,7 +1520,11 @@ dxf_ellipse_set_shadow_mode
                   __FUNCTION__);
                 return (NULL);
         }
-        ellipse->shadow_mode = shadow_mode;
+        if (dxf_graphic_properties_unshare (&ellipse->properties) == NULL)
+        {
+                return (NULL);
+        }
+        ellipse->properties->shadow_mode = shadow_mode;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1659,7 +1648,7 @@ dxf_ellipse_get_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (ellipse->dictionary_owner_soft));
+        return (dxf_strdup (ellipse->dictionary_owner_soft));
 }
 
 
@@ -1695,7 +1684,7 @@ dxf_ellipse_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        ellipse->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        ellipse->dictionary_owner_soft = dxf_strdup (dictionary_owner_soft);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1729,7 +1718,7 @@ dxf_ellipse_get_material
                   __FUNCTION__);
                 return (NULL);
         }
-        if (ellipse->material ==  NULL)
+        if (ellipse->properties->material ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the material member.\n")),
@@ -1739,7 +1728,7 @@ dxf_ellipse_get_material
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (ellipse->material));
+        return (dxf_strdup (ellipse->properties->material));
 }
 
 
@@ -1777,7 +1766,12 @@ dxf_ellipse_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        ellipse->material = strdup (material);
+        if (dxf_graphic_properties_unshare (&ellipse->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (ellipse->properties->material);
+        ellipse->properties->material = dxf_strdup (material);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1821,7 +1815,7 @@ dxf_ellipse_get_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (ellipse->dictionary_owner_hard));
+        return (dxf_strdup (ellipse->dictionary_owner_hard));
 }
 
 
@@ -1857,7 +1851,7 @@ dxf_ellipse_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        ellipse->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        ellipse->dictionary_owner_hard = dxf_strdup (dictionary_owner_hard);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1892,7 +1886,7 @@ dxf_ellipse_get_lineweight
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (ellipse->lineweight);
+        return (ellipse->properties->lineweight);
 }
 
 
@@ -1922,7 +1916,11 @@ dxf_ellipse_set_lineweight
                   __FUNCTION__);
                 return (NULL);
         }
-        ellipse->lineweight = lineweight;
+        if (dxf_graphic_properties_unshare (&ellipse->properties) == NULL)
+        {
+                return (NULL);
+        }
+        ellipse->properties->lineweight = lineweight;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1954,7 +1952,7 @@ dxf_ellipse_get_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        if (ellipse->plot_style_name ==  NULL)
+        if (ellipse->properties->plot_style_name ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the plot_style_name member.\n")),
@@ -1964,7 +1962,7 @@ dxf_ellipse_get_plot_style_name
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (ellipse->plot_style_name));
+        return (dxf_strdup (ellipse->properties->plot_style_name));
 }
 
 
@@ -2002,7 +2000,12 @@ dxf_ellipse_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        ellipse->plot_style_name = strdup (plot_style_name);
+        if (dxf_graphic_properties_unshare (&ellipse->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (ellipse->properties->plot_style_name);
+        ellipse->properties->plot_style_name = dxf_strdup (plot_style_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2037,7 +2040,7 @@ dxf_ellipse_get_color_value
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (ellipse->color_value);
+        return (ellipse->properties->color_value);
 }
 
 
@@ -2067,7 +2070,11 @@ dxf_ellipse_set_color_value
                   __FUNCTION__);
                 return (NULL);
         }
-        ellipse->color_value = color_value;
+        if (dxf_graphic_properties_unshare (&ellipse->properties) == NULL)
+        {
+                return (NULL);
+        }
+        ellipse->properties->color_value = color_value;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2099,7 +2106,7 @@ dxf_ellipse_get_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        if (ellipse->color_name ==  NULL)
+        if (ellipse->properties->color_name ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the color_name member.\n")),
@@ -2109,7 +2116,7 @@ dxf_ellipse_get_color_name
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (ellipse->color_name));
+        return (dxf_strdup (ellipse->properties->color_name));
 }
 
 
@@ -2147,7 +2154,12 @@ dxf_ellipse_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        ellipse->color_name = strdup (color_name);
+        if (dxf_graphic_properties_unshare (&ellipse->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (ellipse->properties->color_name);
+        ellipse->properties->color_name = dxf_strdup (color_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2182,7 +2194,7 @@ dxf_ellipse_get_transparency
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (ellipse->transparency);
+        return (ellipse->properties->transparency);
 }
 
 
@@ -2212,7 +2224,11 @@ dxf_ellipse_set_transparency
                   __FUNCTION__);
                 return (NULL);
         }
-        ellipse->transparency = transparency;
+        if (dxf_graphic_properties_unshare (&ellipse->properties) == NULL)
+        {
+                return (NULL);
+        }
+        ellipse->properties->transparency = transparency;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2232,7 +2248,7 @@ dxf_ellipse_get_p0
                 /*!< a pointer to a DXF \c ELLIPSE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2271,7 +2287,7 @@ dxf_ellipse_set_p0
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2310,7 +2326,7 @@ dxf_ellipse_get_x0
                 /*!< a pointer to a DXF \c ELLIPSE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2353,7 +2369,7 @@ dxf_ellipse_set_x0
                  * \c ELLIPSE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2392,7 +2408,7 @@ dxf_ellipse_get_y0
                 /*!< a pointer to a DXF \c ELLIPSE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2435,7 +2451,7 @@ dxf_ellipse_set_y0
                  * \c ELLIPSE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2474,7 +2490,7 @@ dxf_ellipse_get_z0
                 /*!< a pointer to a DXF \c ELLIPSE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2517,7 +2533,7 @@ dxf_ellipse_set_z0
                  * \c ELLIPSE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2556,7 +2572,7 @@ dxf_ellipse_get_p1
                 /*!< a pointer to a DXF \c ELLIPSE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2589,7 +2605,7 @@ dxf_ellipse_set_p1
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2628,7 +2644,7 @@ dxf_ellipse_get_x1
                 /*!< a pointer to a DXF \c ELLIPSE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2670,7 +2686,7 @@ dxf_ellipse_set_x1
                 /*!< the X-value \c x1 of a DXF \c ELLIPSE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2709,7 +2725,7 @@ dxf_ellipse_get_y1
                 /*!< a pointer to a DXF \c ELLIPSE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2751,7 +2767,7 @@ dxf_ellipse_set_y1
                 /*!< the Y-value \c y1 of a DXF \c ELLIPSE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2790,7 +2806,7 @@ dxf_ellipse_get_z1
                 /*!< a pointer to a DXF \c ELLIPSE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2832,7 +2848,7 @@ dxf_ellipse_set_z1
                 /*!< the Z-value \c z1 of a DXF \c ELLIPSE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2918,7 +2934,7 @@ dxf_ellipse_set_ratio
                 /*!< the \c ratio of a DXF \c ELLIPSE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3072,7 +3088,7 @@ dxf_ellipse_get_extr_x0
                 /*!< a pointer to a DXF \c ELLIPSE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3108,7 +3124,7 @@ dxf_ellipse_set_extr_x0
                  * \c ELLIPSE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3140,7 +3156,7 @@ dxf_ellipse_get_extr_y0
                 /*!< a pointer to a DXF \c ELLIPSE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3176,7 +3192,7 @@ dxf_ellipse_set_extr_y0
                  * \c ELLIPSE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3208,7 +3224,7 @@ dxf_ellipse_get_extr_z0
                 /*!< a pointer to a DXF \c ELLIPSE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3244,7 +3260,7 @@ dxf_ellipse_set_extr_z0
                  * \c ELLIPSE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3278,7 +3294,7 @@ dxf_ellipse_get_extrusion_vector_as_point
                 /*!< a pointer to a DXF \c ELLIPSE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         DxfPoint *point = NULL;
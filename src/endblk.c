@@ -33,6 +33,8 @@
 
 
 #include "endblk.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -160,7 +162,8 @@ dxf_endblk_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfPair pair;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -168,8 +171,6 @@ dxf_endblk_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (endblk == NULL)
@@ -180,47 +181,43 @@ dxf_endblk_read
                 endblk = dxf_endblk_new ();
                 endblk = dxf_endblk_init (endblk);
         }
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
+                if (pair.group_code == 0)
                 {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        fclose (fp->fp);
-                        /* Clean up. */
-                        free (temp_string);
-                        return (NULL);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else if (strcmp (temp_string, "5") == 0)
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        fscanf (fp->fp, "%x\n", &endblk->id_code);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        fscanf (fp->fp, "%s\n", endblk->layer);
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner object. */
-                        fscanf (fp->fp, "%s\n", endblk->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                endblk->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 8:
+                                /* Now follows a string containing a layer name. */
+                                free (endblk->layer);
+                                endblk->layer = dxf_pair_get_string (&pair);
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner object. */
+                                free (endblk->dictionary_owner_soft);
+                                endblk->dictionary_owner_soft = dxf_pair_get_string (&pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, "DXF comment: %s\n", temp_string);
+                                break;
+                        default:
+                                fprintf (stderr,
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
+                                  __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
         /* Handle ommitted members and/or illegal values. */
@@ -228,8 +225,6 @@ dxf_endblk_read
         {
                 endblk->layer = strdup (DXF_DEFAULT_LAYER);
         }
-        /* Clean up. */
-        free (temp_string);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -277,10 +272,10 @@ dxf_endblk_write
                 return (EXIT_FAILURE);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\nENDBLK\n");
+        dxf_write_string (fp, 0, "ENDBLK");
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "  5\n%x\n", dxf_endblk_get_id_code (endblk));
+                dxf_write_hex (fp, 5, dxf_endblk_get_id_code (endblk));
         }
         /*!
          * \todo for version R14.\n
@@ -294,9 +289,9 @@ dxf_endblk_write
          */
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbEntity\n");
-                fprintf (fp->fp, "  8\n%s\n", dxf_endblk_get_layer (endblk));
-                fprintf (fp->fp, "100\nAcDbBlockEnd\n");
+                dxf_write_string (fp, 100, "AcDbEntity");
+                dxf_write_string (fp, 8, dxf_endblk_get_layer (endblk));
+                dxf_write_string (fp, 100, "AcDbBlockEnd");
         }
 #if DEBUG
         DXF_DEBUG_END
@@ -328,8 +323,8 @@ dxf_endblk_free
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        free (dxf_endblk_get_layer (endblk));
-        free (dxf_endblk_get_dictionary_owner_soft (endblk));
+        free (endblk->layer);
+        free (endblk->dictionary_owner_soft);
         free (endblk);
         endblk = NULL;
 #if DEBUG
@@ -350,7 +345,7 @@ dxf_endblk_free
  * \version According to DXF R13.
  * \version According to DXF R14.
  */
-int
+long
 dxf_endblk_get_id_code
 (
         DxfEndblk *endblk
@@ -399,7 +394,7 @@ dxf_endblk_set_id_code
 (
         DxfEndblk *endblk,
                 /*!< a pointer to a DxfEndblk (a DXF \c ENDBLK entity). */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
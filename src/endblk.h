@@ -74,7 +74,7 @@ extern "C" {
 typedef struct
 dxf_endblk_struct
 {
-        int id_code;
+        long id_code;
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file.\n
@@ -109,7 +109,7 @@ int dxf_endblk_free
 (
         DxfEndblk *endblk
 );
-int
+long
 dxf_endblk_get_id_code
 (
         DxfEndblk *endblk
@@ -118,7 +118,7 @@ DxfEndblk *
 dxf_endblk_set_id_code
 (
         DxfEndblk *endblk,
-        int id_code
+        long id_code
 );
 char *
 dxf_endblk_get_layer
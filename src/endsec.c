@@ -33,6 +33,7 @@
 
 
 #include "endsec.h"
+#include "writer.h"
 
 
 /*!
@@ -67,7 +68,7 @@ dxf_endsec_write
                 return (EXIT_FAILURE);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\nENDSEC\n");
+        dxf_write_string (fp, 0, "ENDSEC");
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -33,6 +33,7 @@
 
 
 #include "endtab.h"
+#include "writer.h"
 
 
 /*!
@@ -67,7 +68,7 @@ dxf_endtab_write
                 return (EXIT_FAILURE);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\nENDTAB\n");
+        dxf_write_string (fp, 0, "ENDTAB");
 #if DEBUG
         DXF_DEBUG_END
 #endif
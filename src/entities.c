@@ -51,7 +51,966 @@
  */
 
 
+#include <stddef.h>
+
 #include "entities.h"
+#include "arena.h"
+#include "columns.h"
+#include "filter.h"
+#include "graphic_properties.h"
+#include "lexer.h"
+#include "string_pool.h"
+#include "util.h"
+#include "writer.h"
+#include "3dface.h"
+#include "3dline.h"
+#include "3dsolid.h"
+#include "acad_proxy_entity.h"
+#include "arc.h"
+#include "attdef.h"
+#include "attrib.h"
+#include "body.h"
+#include "circle.h"
+#include "dimension.h"
+#include "ellipse.h"
+#include "helix.h"
+#include "image.h"
+#include "insert.h"
+#include "leader.h"
+#include "line.h"
+#include "lwpolyline.h"
+#include "mline.h"
+#include "mtext.h"
+#include "oleframe.h"
+#include "ole2frame.h"
+#include "point.h"
+#include "polyline.h"
+#include "ray.h"
+#include "region.h"
+#include "seqend.h"
+#include "shape.h"
+#include "solid.h"
+#include "spline.h"
+#include "table.h"
+#include "text.h"
+#include "tolerance.h"
+#include "trace.h"
+#include "vertex.h"
+#include "viewport.h"
+#include "xline.h"
+
+#if !defined (MSDOS) && !defined (_WIN32)
+#include <pthread.h>
+#endif
+
+
+#define DXF_ENTITIES_MIN_JOB_SIZE 1024
+        /*!< \brief dxf_entities_write () does not hand out jobs of fewer
+         * entities than this to a thread. */
+#define DXF_ENTITIES_MAX_THREADS 64
+        /*!< \brief Maximum number of threads used by
+         * dxf_entities_write (). */
+#define DXF_ENTITIES_JOBS_PER_THREAD 8
+        /*!< \brief dxf_entities_write () splits the entities in about
+         * this many jobs per thread, to balance the load. */
+#define DXF_ENTITIES_STRINGS 2
+        /*!< \brief Number of string members of an entity which are
+         * shared through a string pool. */
+#define DXF_ENTITIES_OWNER_SOFT 0
+        /*!< \brief Index of the soft owner (330) in the \c strings of a
+         * DxfEntitiesRow. */
+#define DXF_ENTITIES_OWNER_HARD 1
+        /*!< \brief Index of the hard owner (360). */
+
+
+/*!
+ * \brief Functions and storage for one type of entity.
+ */
+typedef struct
+dxf_entities_row_struct
+{
+        const char *name;
+                /*!< Name of the entity in a DXF file. */
+        DxfEntityType type;
+                /*!< Type of the entity. */
+        void *(*entity_new) (void);
+                /*!< Allocate an entity. */
+        void *(*entity_init) (void *entity);
+                /*!< Initialize an entity. */
+        void *(*entity_read) (DxfFile *fp, void *entity);
+                /*!< Read an entity. */
+        int (*entity_free) (void *entity);
+                /*!< Free an entity. */
+        int (*entity_write) (DxfFile *fp, void *entity);
+                /*!< Write an entity. */
+        long list;
+                /*!< Offset of the list for this type of entity in a
+                 * DxfEntities struct, or -1 when there is none. */
+        size_t next;
+                /*!< Offset of the \c next member in the entity. */
+        long id_code;
+                /*!< Offset of the \c id_code member in the entity. */
+        long strings[DXF_ENTITIES_STRINGS];
+                /*!< Offsets of the \c dictionary_owner_soft and
+                 * \c dictionary_owner_hard members in the entity, or -1
+                 * for a member it does not have.  These strings are
+                 * shared through the string pool of a drawing. */
+        long properties;
+                /*!< Offset of the \c properties member of the entity,
+                 * which keeps its graphic properties in a
+                 * DxfGraphicProperties record, or -1. */
+} DxfEntitiesRow;
+
+
+/*!
+ * \brief Define the functions of a row for the entities of \c prefix,
+ * except the one freeing an entity.
+ *
+ * They take and return the untyped pointers of a DxfEntitiesRow, and
+ * call the functions of the entity with the pointer types these
+ * declare.
+ */
+#define DXF_ENTITIES_FUNCTIONS_NO_FREE(prefix, entity) \
+static void * \
+prefix##_row_new (void) \
+{ \
+        return (prefix##_new ()); \
+} \
+ \
+static void * \
+prefix##_row_init (void *data) \
+{ \
+        return (prefix##_init ((entity *) data)); \
+} \
+ \
+static void * \
+prefix##_row_read (DxfFile *fp, void *data) \
+{ \
+        return (prefix##_read (fp, (entity *) data)); \
+} \
+ \
+static int \
+prefix##_row_write (DxfFile *fp, void *data) \
+{ \
+        return (prefix##_write (fp, (entity *) data)); \
+}
+
+/*!
+ * \brief Define all functions of a row for the entities of \c prefix.
+ */
+#define DXF_ENTITIES_FUNCTIONS(prefix, entity) \
+DXF_ENTITIES_FUNCTIONS_NO_FREE (prefix, entity) \
+ \
+static int \
+prefix##_row_free (void *data) \
+{ \
+        return (prefix##_free ((entity *) data)); \
+}
+
+DXF_ENTITIES_FUNCTIONS_NO_FREE (dxf_3dface, Dxf3dface)
+
+
+/*!
+ * \brief Free a \c 3DFACE for its row, dxf_3dface_free () returns
+ * \c NULL when done.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_3dface_row_free
+(
+        void *data
+                /*!< the \c 3DFACE entity. */
+)
+{
+        return ((dxf_3dface_free ((Dxf3dface *) data) == NULL) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+DXF_ENTITIES_FUNCTIONS (dxf_3dline, Dxf3dline)
+DXF_ENTITIES_FUNCTIONS (dxf_3dsolid, Dxf3dsolid)
+DXF_ENTITIES_FUNCTIONS (dxf_acad_proxy_entity, DxfAcadProxyEntity)
+DXF_ENTITIES_FUNCTIONS (dxf_arc, DxfArc)
+DXF_ENTITIES_FUNCTIONS (dxf_attdef, DxfAttdef)
+DXF_ENTITIES_FUNCTIONS (dxf_attrib, DxfAttrib)
+DXF_ENTITIES_FUNCTIONS (dxf_body, DxfBody)
+DXF_ENTITIES_FUNCTIONS (dxf_circle, DxfCircle)
+DXF_ENTITIES_FUNCTIONS (dxf_dimension, DxfDimension)
+DXF_ENTITIES_FUNCTIONS (dxf_ellipse, DxfEllipse)
+DXF_ENTITIES_FUNCTIONS (dxf_helix, DxfHelix)
+DXF_ENTITIES_FUNCTIONS (dxf_image, DxfImage)
+DXF_ENTITIES_FUNCTIONS (dxf_insert, DxfInsert)
+DXF_ENTITIES_FUNCTIONS (dxf_leader, DxfLeader)
+DXF_ENTITIES_FUNCTIONS (dxf_line, DxfLine)
+DXF_ENTITIES_FUNCTIONS (dxf_lwpolyline, DxfLWPolyline)
+DXF_ENTITIES_FUNCTIONS (dxf_mline, DxfMline)
+DXF_ENTITIES_FUNCTIONS (dxf_mtext, DxfMtext)
+DXF_ENTITIES_FUNCTIONS (dxf_ole2frame, DxfOle2Frame)
+DXF_ENTITIES_FUNCTIONS (dxf_oleframe, DxfOleFrame)
+DXF_ENTITIES_FUNCTIONS (dxf_point, DxfPoint)
+DXF_ENTITIES_FUNCTIONS (dxf_polyline, DxfPolyline)
+DXF_ENTITIES_FUNCTIONS (dxf_ray, DxfRay)
+DXF_ENTITIES_FUNCTIONS (dxf_region, DxfRegion)
+DXF_ENTITIES_FUNCTIONS (dxf_seqend, DxfSeqend)
+DXF_ENTITIES_FUNCTIONS (dxf_shape, DxfShape)
+DXF_ENTITIES_FUNCTIONS (dxf_solid, DxfSolid)
+DXF_ENTITIES_FUNCTIONS (dxf_spline, DxfSpline)
+DXF_ENTITIES_FUNCTIONS (dxf_table, DxfTable)
+DXF_ENTITIES_FUNCTIONS (dxf_text, DxfText)
+DXF_ENTITIES_FUNCTIONS (dxf_tolerance, DxfTolerance)
+DXF_ENTITIES_FUNCTIONS (dxf_trace, DxfTrace)
+DXF_ENTITIES_FUNCTIONS (dxf_vertex, DxfVertex)
+DXF_ENTITIES_FUNCTIONS (dxf_viewport, DxfViewport)
+DXF_ENTITIES_FUNCTIONS (dxf_xline, DxfXLine)
+
+#undef DXF_ENTITIES_FUNCTIONS
+#undef DXF_ENTITIES_FUNCTIONS_NO_FREE
+
+
+#define DXF_ENTITIES_FIELD(entity, member) ((long) offsetof (entity, member))
+
+#define DXF_ENTITIES_ROW(name, type, prefix, entity, list) \
+        { \
+                name, \
+                type, \
+                prefix##_row_new, \
+                prefix##_row_init, \
+                prefix##_row_read, \
+                prefix##_row_free, \
+                prefix##_row_write, \
+                offsetof (DxfEntities, list), \
+                offsetof (entity, next), \
+                DXF_ENTITIES_FIELD (entity, id_code), \
+                { \
+                        DXF_ENTITIES_FIELD (entity, dictionary_owner_soft), \
+                        DXF_ENTITIES_FIELD (entity, dictionary_owner_hard) \
+                }, \
+                DXF_ENTITIES_FIELD (entity, properties) \
+        }
+
+/*!
+ * \brief All entities which can be read, sorted by name.
+ */
+static const DxfEntitiesRow dxf_entities_rows[] =
+{
+        DXF_ENTITIES_ROW ("3DFACE", DFACE, dxf_3dface,
+          Dxf3dface, dface_list),
+        DXF_ENTITIES_ROW ("3DLINE", DLINE, dxf_3dline,
+          Dxf3dline, dline_list),
+        DXF_ENTITIES_ROW ("3DSOLID", DSOLID, dxf_3dsolid,
+          Dxf3dsolid, dsolid_list),
+        DXF_ENTITIES_ROW ("ACAD_PROXY_ENTITY", ACADPROXYENTITY, dxf_acad_proxy_entity,
+          DxfAcadProxyEntity, acad_proxy_entity_list),
+        DXF_ENTITIES_ROW ("ACAD_TABLE", TABLE, dxf_table,
+          DxfTable, table_list),
+        DXF_ENTITIES_ROW ("ACAD_ZOMBIE_ENTITY", ACADPROXYENTITY, dxf_acad_proxy_entity,
+          DxfAcadProxyEntity, acad_proxy_entity_list),
+        DXF_ENTITIES_ROW ("ARC", ARC, dxf_arc,
+          DxfArc, arc_list),
+        DXF_ENTITIES_ROW ("ATTDEF", ATTDEF, dxf_attdef,
+          DxfAttdef, attdef_list),
+        DXF_ENTITIES_ROW ("ATTRIB", ATTRIB, dxf_attrib,
+          DxfAttrib, attrib_list),
+        DXF_ENTITIES_ROW ("BODY", BODY, dxf_body,
+          DxfBody, body_list),
+        DXF_ENTITIES_ROW ("CIRCLE", CIRCLE, dxf_circle,
+          DxfCircle, circle_list),
+        DXF_ENTITIES_ROW ("DIMENSION", DIMENSION, dxf_dimension,
+          DxfDimension, dimension_list),
+        DXF_ENTITIES_ROW ("ELLIPSE", ELLIPSE, dxf_ellipse,
+          DxfEllipse, ellipse_list),
+        DXF_ENTITIES_ROW ("HELIX", HELIX, dxf_helix,
+          DxfHelix, helix_list),
+        DXF_ENTITIES_ROW ("IMAGE", IMAGE, dxf_image,
+          DxfImage, image_list),
+        DXF_ENTITIES_ROW ("INSERT", INSERT, dxf_insert,
+          DxfInsert, insert_list),
+        DXF_ENTITIES_ROW ("LEADER", LEADER, dxf_leader,
+          DxfLeader, leader_list),
+        DXF_ENTITIES_ROW ("LINE", LINE, dxf_line,
+          DxfLine, line_list),
+        DXF_ENTITIES_ROW ("LWPOLYLINE", LWPOLYLINE, dxf_lwpolyline,
+          DxfLWPolyline, lw_polyline_list),
+        DXF_ENTITIES_ROW ("MLINE", MLINE, dxf_mline,
+          DxfMline, mline_list),
+        DXF_ENTITIES_ROW ("MTEXT", MTEXT, dxf_mtext,
+          DxfMtext, mtext_list),
+        DXF_ENTITIES_ROW ("OLE2FRAME", OLE2FRAME, dxf_ole2frame,
+          DxfOle2Frame, ole2frame_list),
+        DXF_ENTITIES_ROW ("OLEFRAME", OLEFRAME, dxf_oleframe,
+          DxfOleFrame, oleframe_list),
+        DXF_ENTITIES_ROW ("POINT", POINT, dxf_point,
+          DxfPoint, point_list),
+        DXF_ENTITIES_ROW ("POLYLINE", POLYLINE, dxf_polyline,
+          DxfPolyline, polyline_list),
+        DXF_ENTITIES_ROW ("RAY", RAY, dxf_ray,
+          DxfRay, ray_list),
+        DXF_ENTITIES_ROW ("REGION", REGION, dxf_region,
+          DxfRegion, region_list),
+        /* A SEQEND ends the VERTEX or ATTRIB entities of the
+         * entity before it, it is not kept. */
+        {
+                "SEQEND",
+                SEQEND,
+                dxf_seqend_row_new,
+                dxf_seqend_row_init,
+                dxf_seqend_row_read,
+                dxf_seqend_row_free,
+                dxf_seqend_row_write,
+                -1, 0, -1,
+                {-1, -1},
+                -1
+        },
+        DXF_ENTITIES_ROW ("SHAPE", SHAPE, dxf_shape,
+          DxfShape, shape_list),
+        DXF_ENTITIES_ROW ("SOLID", SOLID, dxf_solid,
+          DxfSolid, solid_list),
+        DXF_ENTITIES_ROW ("SPLINE", SPLINE, dxf_spline,
+          DxfSpline, spline_list),
+        DXF_ENTITIES_ROW ("TEXT", TEXT, dxf_text,
+          DxfText, text_list),
+        DXF_ENTITIES_ROW ("TOLERANCE", TOLERANCE, dxf_tolerance,
+          DxfTolerance, tolerance_list),
+        DXF_ENTITIES_ROW ("TRACE", TRACE, dxf_trace,
+          DxfTrace, trace_list),
+        DXF_ENTITIES_ROW ("VERTEX", VERTEX, dxf_vertex,
+          DxfVertex, vertex_list),
+        DXF_ENTITIES_ROW ("VIEWPORT", VIEWPORT, dxf_viewport,
+          DxfViewport, viewport_list),
+        DXF_ENTITIES_ROW ("XLINE", XLINE, dxf_xline,
+          DxfXLine, xline_list)
+};
+
+#undef DXF_ENTITIES_ROW
+#undef DXF_ENTITIES_FIELD
+
+#define DXF_ENTITIES_ROWS (sizeof (dxf_entities_rows) / sizeof (dxf_entities_rows[0]))
+
+
+/*!
+ * \brief A run of consecutive entities of one list, to be serialized by
+ * dxf_entities_write ().
+ */
+typedef struct
+dxf_entities_write_job_struct
+{
+        const DxfEntitiesRow *row;
+                /*!< The row of the list. */
+        void *first;
+                /*!< First entity of the run. */
+        size_t count;
+                /*!< Number of entities in the run. */
+        DxfFile *output;
+                /*!< Memory file holding the serialized entities. */
+        int status;
+                /*!< \c EXIT_SUCCESS, or \c EXIT_FAILURE when an entity
+                 * could not be written. */
+        int done;
+                /*!< The job has been serialized. */
+} DxfEntitiesWriteJob;
+
+
+/*!
+ * \brief Jobs shared by the threads of dxf_entities_write ().
+ *
+ * Threads take jobs in order, but stay at most \c window jobs ahead of
+ * the job written out last, so only a bounded part of the section is
+ * held in memory.
+ */
+typedef struct
+dxf_entities_write_pool_struct
+{
+        DxfFile *fp;
+                /*!< The output file. */
+        DxfEntitiesWriteJob *jobs;
+                /*!< Jobs, in output order. */
+        size_t count;
+                /*!< Number of jobs. */
+        size_t next;
+                /*!< First job not taken by a thread yet. */
+        size_t written;
+                /*!< Number of jobs written to \c fp. */
+        size_t window;
+                /*!< Maximum number of jobs taken but not written. */
+#if !defined (MSDOS) && !defined (_WIN32)
+        pthread_mutex_t lock;
+                /*!< Protects \c next, \c written and the \c done flags
+                 * of the jobs. */
+        pthread_cond_t changed;
+                /*!< Signalled when a job is done or written. */
+#endif
+} DxfEntitiesWritePool;
+
+
+/*!
+ * \brief Find the row of the entity type \c type.
+ */
+static const DxfEntitiesRow *
+dxf_entities_find_row
+(
+        DxfEntityType type
+                /*!< type of the entity. */
+)
+{
+        size_t i;
+
+        for (i = 0; i < DXF_ENTITIES_ROWS; i++)
+        {
+                if (dxf_entities_rows[i].type == type)
+                {
+                        return (&dxf_entities_rows[i]);
+                }
+        }
+        return (NULL);
+}
+
+
+/*!
+ * \brief Find the last link of the list for \c row in \c entities.
+ *
+ * \return a pointer to the \c NULL pointer ending the list.
+ */
+static void **
+dxf_entities_find_tail
+(
+        DxfEntities *entities,
+                /*!< the entities container. */
+        const DxfEntitiesRow *row
+                /*!< the row of the list, which has a list. */
+)
+{
+        void **tail;
+
+        tail = (void **) ((char *) entities + row->list);
+        while (*tail != NULL)
+        {
+                tail = (void **) ((char *) *tail + row->next);
+        }
+        return (tail);
+}
+
+
+/*!
+ * \brief Allocate memory for an empty \c DxfEntities container.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when succesful.
+ */
+DxfEntities *
+dxf_entities_new ()
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfEntities *entities = NULL;
+
+        entities = calloc (1, sizeof (DxfEntities));
+        if (entities == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory for a DxfEntities struct.\n")),
+                  __FUNCTION__);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (entities);
+}
+
+
+/*!
+ * \brief Free a \c DxfEntities container and all entities in it.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_entities_free
+(
+        DxfEntities *entities
+                /*!< a pointer to the entities container. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        const DxfEntitiesRow *row;
+        void **list;
+        void *entity;
+        void *next;
+        size_t i;
+
+        /* Do some basic checks. */
+        if (entities == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        for (i = 0; i < DXF_ENTITIES_ROWS; i++)
+        {
+                row = &dxf_entities_rows[i];
+                if (row->list < 0)
+                {
+                        continue;
+                }
+                list = (void **) ((char *) entities + row->list);
+                entity = *list;
+                while (entity != NULL)
+                {
+                        /* The free functions refuse entities which are
+                         * still part of a chain. */
+                        next = *(void **) ((char *) entity + row->next);
+                        *(void **) ((char *) entity + row->next) = NULL;
+                        row->entity_free (entity);
+                        entity = next;
+                }
+                /* Some types share a list. */
+                *list = NULL;
+        }
+        free (entities);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Get the type of the entity which starts with the group code 0
+ * pair \c pair.
+ *
+ * \return the type of the entity, or \c UNKNOWN_ENTITY for an entity
+ * which can not be read.
+ */
+DxfEntityType
+dxf_entities_get_type
+(
+        DxfPair *pair
+                /*!< the group code 0 pair starting the entity. */
+)
+{
+        size_t low = 0;
+        size_t high = DXF_ENTITIES_ROWS;
+        size_t middle;
+        size_t length;
+        int cmp;
+
+        while (low < high)
+        {
+                middle = (low + high) / 2;
+                length = strlen (dxf_entities_rows[middle].name);
+                cmp = strncmp (dxf_entities_rows[middle].name, pair->value.data,
+                  (length < pair->value.length) ? length : pair->value.length);
+                if (cmp == 0)
+                {
+                        cmp = (length > pair->value.length) - (length < pair->value.length);
+                }
+                if (cmp == 0)
+                {
+                        return (dxf_entities_rows[middle].type);
+                }
+                if (cmp < 0)
+                {
+                        low = middle + 1;
+                }
+                else
+                {
+                        high = middle;
+                }
+        }
+        return (UNKNOWN_ENTITY);
+}
+
+
+/*!
+ * \brief Replace the string members of \c entity by their copies in
+ * \c pool.
+ *
+ * The reader took the strings it read from the pool already, this
+ * shares the defaults set by the \c init function as well.
+ */
+static void
+dxf_entities_share_strings
+(
+        DxfStringPool *pool,
+                /*!< the string pool. */
+        const DxfEntitiesRow *row,
+                /*!< the row of the entity. */
+        void *entity
+                /*!< the entity. */
+)
+{
+        char **member;
+        char *shared;
+        int i;
+
+        for (i = 0; i < DXF_ENTITIES_STRINGS; i++)
+        {
+                if (row->strings[i] < 0)
+                {
+                        continue;
+                }
+                member = (char **) ((char *) entity + row->strings[i]);
+                if (*member == NULL)
+                {
+                        continue;
+                }
+                shared = dxf_string_pool_intern (pool, *member);
+                if ((shared != NULL) && (shared != *member))
+                {
+                        dxf_free (*member);
+                        *member = shared;
+                }
+        }
+}
+
+
+/*!
+ * \brief Allocate, initialize and read an entity of type \c type.
+ *
+ * The group code 0 pair starting the entity has been read already.
+ *
+ * \return a pointer to the entity, which has to be freed with
+ * dxf_entities_free_entity (), or \c NULL when an error occurred.
+ */
+void *
+dxf_entities_read_entity
+(
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
+        DxfEntityType type
+                /*!< type of the entity. */
+)
+{
+        const DxfEntitiesRow *row;
+        void *entity;
+
+        row = dxf_entities_find_row (type);
+        if (row == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () can not read an entity of type %d.\n")),
+                  __FUNCTION__, type);
+                return (NULL);
+        }
+        entity = row->entity_init (row->entity_new ());
+        if (entity == NULL)
+        {
+                return (NULL);
+        }
+        entity = row->entity_read (fp, entity);
+        if ((entity != NULL) && (fp->strings != NULL))
+        {
+                dxf_entities_share_strings (fp->strings, row, entity);
+        }
+        return (entity);
+}
+
+
+/*!
+ * \brief Skip the groups of an entity.
+ *
+ * The group code 0 pair starting the next entity is left for the
+ * caller.
+ */
+void
+dxf_entities_skip_entity
+(
+        DxfFile *fp
+                /*!< DXF file handle of input file (or device). */
+)
+{
+        DxfPair pair;
+
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
+        {
+                if (pair.group_code == 0)
+                {
+                        dxf_lexer_unread_pair (fp);
+                        break;
+                }
+        }
+}
+
+
+/*!
+ * \brief Free an entity of type \c type.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_entities_free_entity
+(
+        DxfEntityType type,
+                /*!< type of the entity. */
+        void *entity
+                /*!< the entity. */
+)
+{
+        const DxfEntitiesRow *row;
+
+        row = dxf_entities_find_row (type);
+        if ((row == NULL) || (entity == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer or unknown type was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        row->entity_free (entity);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Write an entity of type \c type.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_entities_write_entity
+(
+        DxfFile *fp,
+                /*!< DXF file pointer to an output file (or device). */
+        DxfEntityType type,
+                /*!< type of the entity. */
+        void *entity
+                /*!< the entity. */
+)
+{
+        const DxfEntitiesRow *row;
+
+        row = dxf_entities_find_row (type);
+        if ((fp == NULL) || (row == NULL) || (entity == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer or unknown type was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        return (row->entity_write (fp, entity));
+}
+
+
+/*!
+ * \brief Get the handle (\c id_code) of an entity of type \c type.
+ *
+ * \return the handle, or 0 when the entity has none.
+ */
+long
+dxf_entities_get_id_code
+(
+        DxfEntityType type,
+                /*!< type of the entity. */
+        void *entity
+                /*!< the entity. */
+)
+{
+        const DxfEntitiesRow *row;
+
+        row = dxf_entities_find_row (type);
+        if ((row == NULL) || (row->id_code < 0) || (entity == NULL))
+        {
+                return (0);
+        }
+        return (*(long *) ((char *) entity + row->id_code));
+}
+
+
+/*!
+ * \brief Set the handle (\c id_code) of an entity of type \c type.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when the
+ * entity has no handle.
+ */
+int
+dxf_entities_set_id_code
+(
+        DxfEntityType type,
+                /*!< type of the entity. */
+        void *entity,
+                /*!< the entity. */
+        long id_code
+                /*!< the handle. */
+)
+{
+        const DxfEntitiesRow *row;
+
+        row = dxf_entities_find_row (type);
+        if ((row == NULL) || (row->id_code < 0) || (entity == NULL))
+        {
+                return (EXIT_FAILURE);
+        }
+        *(long *) ((char *) entity + row->id_code) = id_code;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Get the handle an entity of type \c type points to with group
+ * code \c group_code.
+ *
+ * The pointers of an entity are its soft owner (330), hard owner (360),
+ * material (347) and plot style (390).
+ *
+ * \return the handle as read from the file, or \c NULL when the entity
+ * has no such pointer.
+ */
+char *
+dxf_entities_get_pointer
+(
+        DxfEntityType type,
+                /*!< type of the entity. */
+        void *entity,
+                /*!< the entity. */
+        int group_code
+                /*!< group code of the pointer. */
+)
+{
+        const DxfEntitiesRow *row;
+        DxfGraphicProperties *properties;
+        long offset;
+
+        row = dxf_entities_find_row (type);
+        if ((row == NULL) || (entity == NULL))
+        {
+                return (NULL);
+        }
+        if ((row->properties >= 0)
+          && ((group_code == 347) || (group_code == 390)))
+        {
+                properties = *(DxfGraphicProperties **) ((char *) entity + row->properties);
+                return ((group_code == 347) ? properties->material : properties->plot_style_name);
+        }
+        switch (group_code)
+        {
+                case 330:
+                        offset = row->strings[DXF_ENTITIES_OWNER_SOFT];
+                        break;
+                case 360:
+                        offset = row->strings[DXF_ENTITIES_OWNER_HARD];
+                        break;
+                default:
+                        offset = -1;
+                        break;
+        }
+        if (offset < 0)
+        {
+                return (NULL);
+        }
+        return (*(char **) ((char *) entity + offset));
+}
+
+
+/*!
+ * \brief Read the entities of an \c ENTITIES section into the lists of
+ * \c entities.
+ *
+ * The (0, "SECTION") and (2, "ENTITIES") pairs have been read already;
+ * reading continues up to and including the \c ENDSEC marker, or the
+ * end of the input.\n
+ * Entities are appended to the list for their type in file order.
+ * Entities which can not be read, or which have no list in a
+ * DxfEntities struct (\c SEQEND), are skipped.\n
+ * When \c fp has a columnar store, the \c LINE, \c POINT, \c CIRCLE
+ * and \c ARC entities are added to it instead of to the lists.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_entities_read
+(
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
+        DxfEntities *entities
+                /*!< the container to append the entities to. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        void **tails[DXF_ENTITIES_ROWS];
+        const DxfEntitiesRow *row;
+        DxfEntityType type;
+        DxfPair pair;
+        void *entity;
+        size_t i;
+
+        /* Do some basic checks. */
+        if ((fp == NULL) || (entities == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        /* Find the last link of every list, rows sharing a list share
+         * the tail as well. */
+        for (i = 0; i < DXF_ENTITIES_ROWS; i++)
+        {
+                row = &dxf_entities_rows[i];
+                tails[i] = NULL;
+                if (row->list >= 0)
+                {
+                        tails[i] = dxf_entities_find_tail (entities, row);
+                }
+        }
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
+        {
+                if (pair.group_code != 0)
+                {
+                        /* Stray group, ignore it. */
+                        continue;
+                }
+                if (dxf_pair_value_is (&pair, "ENDSEC"))
+                {
+                        break;
+                }
+                type = dxf_entities_get_type (&pair);
+                row = dxf_entities_find_row (type);
+                if ((row == NULL) || (row->list < 0))
+                {
+                        dxf_entities_skip_entity (fp);
+                        continue;
+                }
+                if (dxf_filter_skip_entity (fp, type))
+                {
+                        continue;
+                }
+                if (dxf_columns_get_table (fp->columns, type) != NULL)
+                {
+                        /* Simple entities go straight into their
+                         * columns, no struct is allocated. */
+                        if (dxf_columns_read_entity (fp, fp->columns, type) != EXIT_SUCCESS)
+                        {
+                                return (EXIT_FAILURE);
+                        }
+                        continue;
+                }
+                entity = dxf_entities_read_entity (fp, type);
+                if (entity == NULL)
+                {
+                        return (EXIT_FAILURE);
+                }
+                /* Use the tail of the first row for this list. */
+                i = 0;
+                while (dxf_entities_rows[i].list != row->list)
+                {
+                        i++;
+                }
+                *tails[i] = entity;
+                tails[i] = (void **) ((char *) entity + row->next);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
 
 
 /*!
@@ -82,6 +1041,580 @@ dxf_entities_read_table
 }
 
 
+/*!
+ * \brief Move all entities of \c more to the ends of the lists of
+ * \c entities, and free \c more.
+ *
+ * Used to join entities read from consecutive parts of a section, the
+ * order of the entities is kept.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_entities_append
+(
+        DxfEntities *entities,
+                /*!< the container to append to. */
+        DxfEntities *more
+                /*!< the container to take the entities from. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        const DxfEntitiesRow *row;
+        void **list;
+        size_t i;
+
+        /* Do some basic checks. */
+        if ((entities == NULL) || (more == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        for (i = 0; i < DXF_ENTITIES_ROWS; i++)
+        {
+                row = &dxf_entities_rows[i];
+                if (row->list < 0)
+                {
+                        continue;
+                }
+                /* Rows sharing a list see it empty the second time. */
+                list = (void **) ((char *) more + row->list);
+                if (*list != NULL)
+                {
+                        *dxf_entities_find_tail (entities, row) = *list;
+                        *list = NULL;
+                }
+        }
+        free (more);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Test whether \c row is the first row for its list.
+ *
+ * Rows which share a list with an earlier row, and rows without a
+ * list, are skipped when all lists are walked.
+ */
+static int
+dxf_entities_is_first_row
+(
+        size_t row
+                /*!< index of the row. */
+)
+{
+        size_t i;
+
+        if (dxf_entities_rows[row].list < 0)
+        {
+                return (FALSE);
+        }
+        for (i = 0; i < row; i++)
+        {
+                if (dxf_entities_rows[i].list == dxf_entities_rows[row].list)
+                {
+                        return (FALSE);
+                }
+        }
+        return (TRUE);
+}
+
+
+/*!
+ * \brief Call \c callback for every entity in \c entities.
+ *
+ * The lists are walked in the order of their names, the entities of a
+ * list in file order.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_entities_walk
+(
+        DxfEntities *entities,
+                /*!< the entities. */
+        void (*callback) (DxfEntityType type, void *entity, void *user_data),
+                /*!< called for every entity. */
+        void *user_data
+                /*!< passed unchanged to \c callback. */
+)
+{
+        const DxfEntitiesRow *row;
+        void *entity;
+        size_t i;
+
+        /* Do some basic checks. */
+        if ((entities == NULL) || (callback == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        for (i = 0; i < DXF_ENTITIES_ROWS; i++)
+        {
+                if (!dxf_entities_is_first_row (i))
+                {
+                        continue;
+                }
+                row = &dxf_entities_rows[i];
+                entity = *(void **) ((char *) entities + row->list);
+                while (entity != NULL)
+                {
+                        callback (row->type, entity, user_data);
+                        entity = *(void **) ((char *) entity + row->next);
+                }
+        }
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Detach the strings of a private graphic property record which
+ * belong to \c pool.
+ */
+static void
+dxf_entities_release_properties
+(
+        DxfGraphicProperties *properties,
+                /*!< the record. */
+        DxfStringPool *pool
+                /*!< the string pool. */
+)
+{
+        if (dxf_string_pool_owns (pool, properties->linetype))
+        {
+                properties->linetype = NULL;
+        }
+        if (dxf_string_pool_owns (pool, properties->layer))
+        {
+                properties->layer = NULL;
+        }
+        if (dxf_string_pool_owns (pool, properties->material))
+        {
+                properties->material = NULL;
+        }
+        if (dxf_string_pool_owns (pool, properties->plot_style_name))
+        {
+                properties->plot_style_name = NULL;
+        }
+        if (dxf_string_pool_owns (pool, properties->color_name))
+        {
+                properties->color_name = NULL;
+        }
+}
+
+
+/*!
+ * \brief Detach the string members of the entities in \c entities which
+ * belong to \c pool.
+ *
+ * The members are set to \c NULL, so the entities can be freed before
+ * the pool is.  The strings of private graphic property records are
+ * detached as well, shared records are left to their pool.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_entities_release_strings
+(
+        DxfEntities *entities,
+                /*!< the entities. */
+        DxfStringPool *pool
+                /*!< the string pool. */
+)
+{
+        const DxfEntitiesRow *row;
+        DxfGraphicProperties *properties;
+        void *entity;
+        char **member;
+        size_t i;
+        int j;
+
+        /* Do some basic checks. */
+        if ((entities == NULL) || (pool == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        for (i = 0; i < DXF_ENTITIES_ROWS; i++)
+        {
+                if (!dxf_entities_is_first_row (i))
+                {
+                        continue;
+                }
+                row = &dxf_entities_rows[i];
+                entity = *(void **) ((char *) entities + row->list);
+                while (entity != NULL)
+                {
+                        for (j = 0; j < DXF_ENTITIES_STRINGS; j++)
+                        {
+                                if (row->strings[j] < 0)
+                                {
+                                        continue;
+                                }
+                                member = (char **) ((char *) entity + row->strings[j]);
+                                if (dxf_string_pool_owns (pool, *member))
+                                {
+                                        *member = NULL;
+                                }
+                        }
+                        if (row->properties >= 0)
+                        {
+                                properties = *(DxfGraphicProperties **) ((char *) entity + row->properties);
+                                if (!properties->shared)
+                                {
+                                        dxf_entities_release_properties (properties, pool);
+                                }
+                        }
+                        entity = *(void **) ((char *) entity + row->next);
+                }
+        }
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Write at most \c count entities of the list of \c row,
+ * starting with \c entity.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an entity
+ * could not be written.
+ */
+static int
+dxf_entities_write_run
+(
+        DxfFile *fp,
+                /*!< DXF file pointer to an output file (or device). */
+        const DxfEntitiesRow *row,
+                /*!< the row of the list. */
+        void *entity,
+                /*!< first entity. */
+        size_t count
+                /*!< maximum number of entities. */
+)
+{
+        int status = EXIT_SUCCESS;
+
+        while ((entity != NULL) && (count > 0))
+        {
+                if (row->entity_write (fp, entity) == EXIT_FAILURE)
+                {
+                        status = EXIT_FAILURE;
+                }
+                entity = *(void **) ((char *) entity + row->next);
+                count--;
+        }
+        return (status);
+}
+
+
+/*!
+ * \brief Serialize the entities of \c job into a new memory file.
+ */
+static void
+dxf_entities_write_job
+(
+        DxfEntitiesWriteJob *job,
+                /*!< the job. */
+        DxfFile *fp
+                /*!< the output file, whose format is used. */
+)
+{
+        job->output = dxf_write_init_memory (fp);
+        if (job->output == NULL)
+        {
+                job->status = EXIT_FAILURE;
+                return;
+        }
+        job->status = dxf_entities_write_run (job->output, job->row,
+          job->first, job->count);
+}
+
+
+#if !defined (MSDOS) && !defined (_WIN32)
+/*!
+ * \brief Serialize jobs from \c pool until all jobs have been taken.
+ */
+static void *
+dxf_entities_write_worker
+(
+        void *data
+                /*!< the DxfEntitiesWritePool. */
+)
+{
+        DxfEntitiesWritePool *pool = data;
+        size_t job;
+
+        pthread_mutex_lock (&pool->lock);
+        for (;;)
+        {
+                while ((pool->next < pool->count)
+                  && (pool->next >= pool->written + pool->window))
+                {
+                        pthread_cond_wait (&pool->changed, &pool->lock);
+                }
+                if (pool->next >= pool->count)
+                {
+                        break;
+                }
+                job = pool->next++;
+                pthread_mutex_unlock (&pool->lock);
+                dxf_entities_write_job (&pool->jobs[job], pool->fp);
+                pthread_mutex_lock (&pool->lock);
+                pool->jobs[job].done = TRUE;
+                pthread_cond_broadcast (&pool->changed);
+        }
+        pthread_mutex_unlock (&pool->lock);
+        return (NULL);
+}
+
+
+/*!
+ * \brief Write the jobs of \c pool to the output file in order.
+ *
+ * The calling thread serializes jobs itself while the job to be
+ * written next is not available yet.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_entities_write_jobs
+(
+        DxfEntitiesWritePool *pool
+                /*!< the pool. */
+)
+{
+        DxfEntitiesWriteJob *job;
+        int status = EXIT_SUCCESS;
+        size_t next;
+        size_t i;
+
+        for (i = 0; i < pool->count; i++)
+        {
+                job = &pool->jobs[i];
+                pthread_mutex_lock (&pool->lock);
+                while (!job->done)
+                {
+                        if ((pool->next < pool->count)
+                          && (pool->next < pool->written + pool->window))
+                        {
+                                next = pool->next++;
+                                pthread_mutex_unlock (&pool->lock);
+                                dxf_entities_write_job (&pool->jobs[next], pool->fp);
+                                pthread_mutex_lock (&pool->lock);
+                                pool->jobs[next].done = TRUE;
+                                pthread_cond_broadcast (&pool->changed);
+                        }
+                        else
+                        {
+                                pthread_cond_wait (&pool->changed, &pool->lock);
+                        }
+                }
+                pthread_mutex_unlock (&pool->lock);
+                if ((job->status == EXIT_FAILURE)
+                  || (job->output == NULL)
+                  || (dxf_write_append (pool->fp, job->output) == EXIT_FAILURE))
+                {
+                        status = EXIT_FAILURE;
+                }
+                if (job->output != NULL)
+                {
+                        dxf_write_close (job->output);
+                        job->output = NULL;
+                }
+                pthread_mutex_lock (&pool->lock);
+                pool->written = i + 1;
+                pthread_cond_broadcast (&pool->changed);
+                pthread_mutex_unlock (&pool->lock);
+        }
+        return (status);
+}
+#endif
+
+
+/*!
+ * \brief Write an \c ENTITIES section with all entities in
+ * \c entities.
+ *
+ * The lists are written in the order of the entity names, each list
+ * from head to tail.\n
+ * With more than one thread, the lists are cut into runs of
+ * consecutive entities, which \c threads threads serialize into
+ * memory files; the calling thread writes the runs to \c fp in order.
+ * The output is byte for byte the same as with one thread.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_entities_write
+(
+        DxfFile *fp,
+                /*!< DXF file pointer to an output file (or device). */
+        DxfEntities *entities,
+                /*!< the entities container. */
+        int threads
+                /*!< maximum number of threads to use, or \c 0 for one
+                 * thread per processor. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        const DxfEntitiesRow *row;
+        DxfEntitiesWritePool pool;
+        int status = EXIT_SUCCESS;
+        size_t total = 0;
+        size_t job_size;
+        size_t n;
+        size_t i;
+        void *entity;
+#if !defined (MSDOS) && !defined (_WIN32)
+        pthread_t workers[DXF_ENTITIES_MAX_THREADS];
+        int started = 0;
+        int t;
+#endif
+
+        if ((fp == NULL) || (entities == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+#if !defined (MSDOS) && !defined (_WIN32)
+        if (threads <= 0)
+        {
+                threads = (int) sysconf (_SC_NPROCESSORS_ONLN);
+        }
+        if (threads > DXF_ENTITIES_MAX_THREADS)
+        {
+                threads = DXF_ENTITIES_MAX_THREADS;
+        }
+#else
+        threads = 1;
+#endif
+        for (i = 0; i < DXF_ENTITIES_ROWS; i++)
+        {
+                if (!dxf_entities_is_first_row (i))
+                {
+                        continue;
+                }
+                row = &dxf_entities_rows[i];
+                entity = *(void **) ((char *) entities + row->list);
+                for (; entity != NULL; entity = *(void **) ((char *) entity + row->next))
+                {
+                        total++;
+                }
+        }
+        dxf_write_string (fp, 0, "SECTION");
+        dxf_write_string (fp, 2, "ENTITIES");
+        job_size = total / ((size_t) threads * DXF_ENTITIES_JOBS_PER_THREAD);
+        if (job_size < DXF_ENTITIES_MIN_JOB_SIZE)
+        {
+                job_size = DXF_ENTITIES_MIN_JOB_SIZE;
+        }
+        pool.jobs = NULL;
+        if ((threads > 1) && (total >= 2 * job_size))
+        {
+                pool.jobs = malloc (((total / job_size) + DXF_ENTITIES_ROWS)
+                  * sizeof (DxfEntitiesWriteJob));
+        }
+        if (pool.jobs == NULL)
+        {
+                /* Not worth the threads, or no memory for the jobs. */
+                for (i = 0; i < DXF_ENTITIES_ROWS; i++)
+                {
+                        if (!dxf_entities_is_first_row (i))
+                        {
+                                continue;
+                        }
+                        row = &dxf_entities_rows[i];
+                        if (dxf_entities_write_run (fp, row,
+                          *(void **) ((char *) entities + row->list),
+                          total) == EXIT_FAILURE)
+                        {
+                                status = EXIT_FAILURE;
+                        }
+                }
+        }
+#if !defined (MSDOS) && !defined (_WIN32)
+        else
+        {
+                pool.fp = fp;
+                pool.count = 0;
+                pool.next = 0;
+                pool.written = 0;
+                pool.window = 2 * (size_t) threads;
+                for (i = 0; i < DXF_ENTITIES_ROWS; i++)
+                {
+                        if (!dxf_entities_is_first_row (i))
+                        {
+                                continue;
+                        }
+                        row = &dxf_entities_rows[i];
+                        entity = *(void **) ((char *) entities + row->list);
+                        n = 0;
+                        for (; entity != NULL; entity = *(void **) ((char *) entity + row->next))
+                        {
+                                if ((n % job_size) == 0)
+                                {
+                                        pool.jobs[pool.count].row = row;
+                                        pool.jobs[pool.count].first = entity;
+                                        pool.jobs[pool.count].count = 0;
+                                        pool.jobs[pool.count].output = NULL;
+                                        pool.jobs[pool.count].status = EXIT_SUCCESS;
+                                        pool.jobs[pool.count].done = FALSE;
+                                        pool.count++;
+                                }
+                                pool.jobs[pool.count - 1].count++;
+                                n++;
+                        }
+                }
+                pthread_mutex_init (&pool.lock, NULL);
+                pthread_cond_init (&pool.changed, NULL);
+                for (t = 1; t < threads; t++)
+                {
+                        if (pthread_create (&workers[started], NULL,
+                          dxf_entities_write_worker, &pool) == 0)
+                        {
+                                started++;
+                        }
+                }
+                status = dxf_entities_write_jobs (&pool);
+                for (t = 0; t < started; t++)
+                {
+                        pthread_join (workers[t], NULL);
+                }
+                pthread_cond_destroy (&pool.changed);
+                pthread_mutex_destroy (&pool.lock);
+                free (pool.jobs);
+        }
+#endif
+        if (dxf_write_string (fp, 0, "ENDSEC") == EXIT_FAILURE)
+        {
+                status = EXIT_FAILURE;
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (status);
+}
+
 /*!
  * \brief Write DXF output to a file for a DXF \c ENTITIES table.
  */
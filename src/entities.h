@@ -56,6 +56,8 @@
 
 
 #include "global.h"
+#include "entity.h"
+#include "string_pool.h"
 
 
 #ifdef __cplusplus
@@ -69,6 +71,7 @@ extern "C" {
 typedef struct dxf_entities_struct
 {
     struct Dxf3dface *dface_list;
+    struct Dxf3dline *dline_list;
     struct Dxf3dsolid *dsolid_list;
     struct DxfAcadProxyEntity *acad_proxy_entity_list;
     struct DxfArc *arc_list;
@@ -111,7 +114,7 @@ typedef struct dxf_entities_struct
     struct DxfVertex *vertex_list;
     struct DxfViewport *viewport_list;
     //struct DxfWipeout *wipeout_list;
-    //struct DxfXline *xline_list;
+    struct DxfXLine *xline_list;
 } DxfEntities;
 
 
@@ -124,6 +127,94 @@ dxf_entities_read_table
        char *dxf_entities_list,
        int acad_version_number
 );
+DxfEntities *
+dxf_entities_new ();
+int
+dxf_entities_free
+(
+        DxfEntities *entities
+);
+DxfEntityType
+dxf_entities_get_type
+(
+        DxfPair *pair
+);
+void *
+dxf_entities_read_entity
+(
+        DxfFile *fp,
+        DxfEntityType type
+);
+void
+dxf_entities_skip_entity
+(
+        DxfFile *fp
+);
+int
+dxf_entities_free_entity
+(
+        DxfEntityType type,
+        void *entity
+);
+int
+dxf_entities_write_entity
+(
+        DxfFile *fp,
+        DxfEntityType type,
+        void *entity
+);
+long
+dxf_entities_get_id_code
+(
+        DxfEntityType type,
+        void *entity
+);
+int
+dxf_entities_set_id_code
+(
+        DxfEntityType type,
+        void *entity,
+        long id_code
+);
+char *
+dxf_entities_get_pointer
+(
+        DxfEntityType type,
+        void *entity,
+        int group_code
+);
+int
+dxf_entities_read
+(
+        DxfFile *fp,
+        DxfEntities *entities
+);
+int
+dxf_entities_append
+(
+        DxfEntities *entities,
+        DxfEntities *more
+);
+int
+dxf_entities_walk
+(
+        DxfEntities *entities,
+        void (*callback) (DxfEntityType type, void *entity, void *user_data),
+        void *user_data
+);
+int
+dxf_entities_release_strings
+(
+        DxfEntities *entities,
+        DxfStringPool *pool
+);
+int
+dxf_entities_write
+(
+        DxfFile *fp,
+        DxfEntities *entities,
+        int threads
+);
 int
 dxf_entities_write_table
 (
@@ -49,6 +49,7 @@ dxf_entity_type
 {
         UNKNOWN_ENTITY,
         DFACE,
+        DLINE,
         DSOLID,
         ACADPROXYENTITY,
         ARC,
@@ -69,6 +70,7 @@ dxf_entity_type
         MESH,
         MLEADER,
         MLEADERSTYLE,
+        MLINE,
         MTEXT,
         OLEFRAME,
         OLE2FRAME,
@@ -77,6 +79,7 @@ dxf_entity_type
         RAY,
         REGION,
         SECTION,
+        SEQEND,
         SHAPE,
         SOLID,
         SPLINE,
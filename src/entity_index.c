@@ -0,0 +1,1346 @@
+/*!
+ * \file entity_index.c
+ *
+ * \author Copyright (C) 2017 by the libDXF developers.
+ *
+ * \brief Lazily decoded index of the entities in a DXF file.
+ *
+ * dxf_entity_index_open () only records the type, handle, layer and
+ * location of every entity in the \c ENTITIES section.\n
+ * Entities are decoded the first time they are asked for with
+ * dxf_entity_index_get (), and can be evicted again to bound the memory
+ * used.\n
+ * The entries of the symbol tables in the \c TABLES section are indexed
+ * the same way.  Changed, added and deleted entities and entries are
+ * tracked, so dxf_entity_index_save () copies everything else verbatim
+ * from the mapped file and only writes what changed.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+
+
+#define _GNU_SOURCE
+#ifdef HAVE_CONFIG_H
+#  include "libdxf.h"
+#endif
+
+#include <stddef.h>
+
+#include "entity_index.h"
+#include "appid.h"
+#include "block_record.h"
+#include "compress.h"
+#include "dimstyle.h"
+#include "entities.h"
+#include "layer.h"
+#include "lexer.h"
+#include "ltype.h"
+#include "section.h"
+#include "style.h"
+#include "ucs.h"
+#include "util.h"
+#include "view.h"
+#include "vport.h"
+#include "writer.h"
+
+
+/*!
+ * \brief Functions for the entries of one symbol table.
+ */
+typedef struct
+dxf_entity_index_table_struct
+{
+        const char *name;
+                /*!< Name of the entries in a DXF file. */
+        void *(*entry_new) (void);
+                /*!< Allocate an entry. */
+        void *(*entry_init) (void *entry);
+                /*!< Initialize an entry. */
+        void *(*entry_read) (DxfFile *fp, void *entry);
+                /*!< Read an entry. */
+        int (*entry_write) (DxfFile *fp, void *entry);
+                /*!< Write an entry. */
+        int (*entry_free) (void *entry);
+                /*!< Free an entry. */
+        size_t id_code;
+                /*!< Offset of the \c id_code member in the entry. */
+} DxfEntityIndexTable;
+
+
+/*!
+ * \brief Define the functions of a symbol table for the entries of
+ * \c prefix.
+ *
+ * They take and return the untyped pointers of a DxfEntityIndexTable,
+ * and call the functions of the entry with the pointer types these
+ * declare.
+ */
+#define DXF_ENTITY_INDEX_FUNCTIONS(prefix, entry) \
+static void * \
+prefix##_table_new (void) \
+{ \
+        return (prefix##_new ()); \
+} \
+ \
+static void * \
+prefix##_table_init (void *data) \
+{ \
+        return (prefix##_init ((entry *) data)); \
+} \
+ \
+static void * \
+prefix##_table_read (DxfFile *fp, void *data) \
+{ \
+        return (prefix##_read (fp, (entry *) data)); \
+} \
+ \
+static int \
+prefix##_table_write (DxfFile *fp, void *data) \
+{ \
+        return (prefix##_write (fp, (entry *) data)); \
+} \
+ \
+static int \
+prefix##_table_free (void *data) \
+{ \
+        return (prefix##_free ((entry *) data)); \
+}
+
+DXF_ENTITY_INDEX_FUNCTIONS (dxf_appid, DxfAppid)
+DXF_ENTITY_INDEX_FUNCTIONS (dxf_block_record, DxfBlockRecord)
+DXF_ENTITY_INDEX_FUNCTIONS (dxf_dimstyle, DxfDimStyle)
+DXF_ENTITY_INDEX_FUNCTIONS (dxf_layer, DxfLayer)
+DXF_ENTITY_INDEX_FUNCTIONS (dxf_ltype, DxfLType)
+DXF_ENTITY_INDEX_FUNCTIONS (dxf_style, DxfStyle)
+DXF_ENTITY_INDEX_FUNCTIONS (dxf_ucs, DxfUcs)
+DXF_ENTITY_INDEX_FUNCTIONS (dxf_view, DxfView)
+DXF_ENTITY_INDEX_FUNCTIONS (dxf_vport, DxfVPort)
+
+#undef DXF_ENTITY_INDEX_FUNCTIONS
+
+
+#define DXF_ENTITY_INDEX_TABLE(name, prefix, entry) \
+        { \
+                name, \
+                prefix##_table_new, \
+                prefix##_table_init, \
+                prefix##_table_read, \
+                prefix##_table_write, \
+                prefix##_table_free, \
+                offsetof (entry, id_code) \
+        }
+
+/*!
+ * \brief All symbol tables, sorted by name.
+ */
+static const DxfEntityIndexTable dxf_entity_index_tables[] =
+{
+        DXF_ENTITY_INDEX_TABLE ("APPID", dxf_appid, DxfAppid),
+        DXF_ENTITY_INDEX_TABLE ("BLOCK_RECORD", dxf_block_record, DxfBlockRecord),
+        DXF_ENTITY_INDEX_TABLE ("DIMSTYLE", dxf_dimstyle, DxfDimStyle),
+        DXF_ENTITY_INDEX_TABLE ("LAYER", dxf_layer, DxfLayer),
+        DXF_ENTITY_INDEX_TABLE ("LTYPE", dxf_ltype, DxfLType),
+        DXF_ENTITY_INDEX_TABLE ("STYLE", dxf_style, DxfStyle),
+        DXF_ENTITY_INDEX_TABLE ("UCS", dxf_ucs, DxfUcs),
+        DXF_ENTITY_INDEX_TABLE ("VIEW", dxf_view, DxfView),
+        DXF_ENTITY_INDEX_TABLE ("VPORT", dxf_vport, DxfVPort)
+};
+
+#undef DXF_ENTITY_INDEX_TABLE
+
+#define DXF_ENTITY_INDEX_TABLES (sizeof (dxf_entity_index_tables) / sizeof (dxf_entity_index_tables[0]))
+
+
+/*!
+ * \brief Find the symbol table of the entry started by \c pair.
+ *
+ * \return the number of the symbol table, or -1 when \c pair does not
+ * start a symbol table entry (\c TABLE, \c ENDTAB, ...).
+ */
+static int
+dxf_entity_index_find_table
+(
+        DxfPair *pair
+                /*!< a group code 0 pair. */
+)
+{
+        size_t i;
+
+        for (i = 0; i < DXF_ENTITY_INDEX_TABLES; i++)
+        {
+                if (dxf_pair_value_is (pair, dxf_entity_index_tables[i].name))
+                {
+                        return ((int) i);
+                }
+        }
+        return (-1);
+}
+
+
+/*!
+ * \brief Find the layer named by the value of \c pair in the layers of
+ * \c index, and add it when it is not there yet.
+ *
+ * \return the index of the layer name, or -1 when an error occurred.
+ */
+static int
+dxf_entity_index_find_layer
+(
+        DxfEntityIndex *index,
+                /*!< the index. */
+        DxfPair *pair
+                /*!< a group code 8 pair. */
+)
+{
+        char name[DXF_MAX_STRING_LENGTH];
+        char **layers;
+        int i;
+
+        dxf_pair_copy_string (pair, name, sizeof (name));
+        /* Drawings have few layers, and entities on one layer tend to
+         * follow each other, so search backwards. */
+        for (i = index->layer_count - 1; i >= 0; i--)
+        {
+                if (strcmp (index->layers[i], name) == 0)
+                {
+                        return (i);
+                }
+        }
+        layers = realloc (index->layers,
+          (size_t) (index->layer_count + 1) * sizeof (char *));
+        if (layers == NULL)
+        {
+                return (-1);
+        }
+        index->layers = layers;
+        index->layers[index->layer_count] = strdup (name);
+        if (index->layers[index->layer_count] == NULL)
+        {
+                return (-1);
+        }
+        index->layer_count++;
+        return (index->layer_count - 1);
+}
+
+
+/*!
+ * \brief Add a record for an entity, or for an entry of symbol table
+ * \c table, starting at \c offset to \c index.
+ *
+ * \return a pointer to the new record, or \c NULL when no memory was
+ * allocated.
+ */
+static DxfEntityIndexRecord *
+dxf_entity_index_add
+(
+        DxfEntityIndex *index,
+                /*!< the index. */
+        DxfEntityType type,
+                /*!< type of the entity. */
+        int table,
+                /*!< symbol table of the entry, or -1 for an entity. */
+        size_t offset
+                /*!< offset of the entity in the file. */
+)
+{
+        DxfEntityIndexRecord **records;
+        DxfEntityIndexRecord *grown;
+        DxfEntityIndexRecord *record;
+        int *count;
+        int *size;
+        int new_size;
+
+        if (table < 0)
+        {
+                records = &index->records;
+                count = &index->count;
+                size = &index->size;
+        }
+        else
+        {
+                records = &index->table_records;
+                count = &index->table_count;
+                size = &index->table_size;
+        }
+        if (*count == *size)
+        {
+                new_size = (*size == 0) ? 1024 : 2 * *size;
+                grown = realloc (*records,
+                  (size_t) new_size * sizeof (DxfEntityIndexRecord));
+                if (grown == NULL)
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () could not allocate memory for the entity index.\n")),
+                          __FUNCTION__);
+                        return (NULL);
+                }
+                *records = grown;
+                *size = new_size;
+        }
+        record = &(*records)[*count];
+        record->type = type;
+        record->id_code = 0;
+        record->layer = -1;
+        record->offset = offset;
+        record->length = 0;
+        record->entity = NULL;
+        record->table = table;
+        record->dirty = FALSE;
+        record->deleted = FALSE;
+        (*count)++;
+        return (record);
+}
+
+
+/*!
+ * \brief Record every entity of the \c ENTITIES section, or every
+ * symbol table entry of the \c TABLES section, at \c range in
+ * \c index.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_entity_index_scan
+(
+        DxfEntityIndex *index,
+                /*!< the index. */
+        DxfSectionRange *range,
+                /*!< location of the section. */
+        int tables
+                /*!< \c TRUE for the \c TABLES section. */
+)
+{
+        DxfFile *window;
+        DxfEntityIndexRecord *record = NULL;
+        DxfPair pair;
+        size_t position;
+        int table;
+        int result = EXIT_SUCCESS;
+
+        window = dxf_read_init_window (index->fp, range->start, range->end);
+        if (window == NULL)
+        {
+                return (EXIT_FAILURE);
+        }
+        position = window->position;
+        while (dxf_lexer_read_pair (window, &pair) == 1)
+        {
+                if (pair.group_code == 0)
+                {
+                        if (record != NULL)
+                        {
+                                record->length = range->start
+                                  + position - record->offset;
+                                record = NULL;
+                        }
+                        if (dxf_pair_value_is (&pair, "ENDSEC"))
+                        {
+                                break;
+                        }
+                        if (tables)
+                        {
+                                /* TABLE and ENDTAB groups are not
+                                 * recorded. */
+                                table = dxf_entity_index_find_table (&pair);
+                                if (table < 0)
+                                {
+                                        position = window->position;
+                                        continue;
+                                }
+                                record = dxf_entity_index_add (index,
+                                  UNKNOWN_ENTITY, table,
+                                  range->start + position);
+                        }
+                        else
+                        {
+                                record = dxf_entity_index_add (index,
+                                  dxf_entities_get_type (&pair), -1,
+                                  range->start + position);
+                        }
+                        if (record == NULL)
+                        {
+                                result = EXIT_FAILURE;
+                                break;
+                        }
+                }
+                else if ((record != NULL)
+                  && ((pair.group_code == 5)
+                  || ((pair.group_code == 105) && (record->table >= 0)))
+                  && (record->id_code == 0))
+                {
+                        /* A DIMSTYLE entry has its handle in group
+                         * code 105. */
+                        record->id_code = dxf_pair_get_hex (&pair);
+                }
+                else if ((record != NULL) && (pair.group_code == 8)
+                  && (record->layer == -1))
+                {
+                        record->layer = dxf_entity_index_find_layer (index, &pair);
+                }
+                position = window->position;
+        }
+        if (record != NULL)
+        {
+                /* No ENDSEC marker. */
+                record->length = range->end - record->offset;
+        }
+        dxf_read_close (window);
+        return (result);
+}
+
+
+/*!
+ * \brief Build an index of the entities in a DXF file.
+ *
+ * The file is memory mapped and the \c ENTITIES section is scanned once,
+ * storing only the type, handle, layer and location of every entity.
+ * The \c TABLES section is scanned the same way for the symbol table
+ * entries.\n
+ * The file stays mapped until dxf_entity_index_close () is called.
+ *
+ * \return a pointer to the index, or \c NULL when an error occurred.
+ */
+DxfEntityIndex *
+dxf_entity_index_open
+(
+        const char *filename
+                /*!< filename of input file (or device). */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfEntityIndex *index;
+        DxfSectionRange ranges[DXF_MAX_SECTIONS];
+        int sections;
+        int i;
+
+        index = calloc (1, sizeof (DxfEntityIndex));
+        if (index == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory for a DxfEntityIndex struct.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        index->fp = dxf_read_init_mmap (filename);
+        if ((index->fp == NULL) || (index->fp->buffer == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not map file: %s into memory.\n")),
+                  __FUNCTION__, filename);
+                dxf_entity_index_close (index);
+                return (NULL);
+        }
+        dxf_lexer_detect_binary (index->fp);
+        sections = dxf_section_index (index->fp, ranges, DXF_MAX_SECTIONS);
+        for (i = 0; i < sections; i++)
+        {
+                if (strcmp (ranges[i].name, "HEADER") == 0)
+                {
+                        /* Entities are decoded with the version of the
+                         * drawing. */
+                        index->fp->acad_version_number =
+                          dxf_section_read_version (index->fp, &ranges[i]);
+                }
+                else if ((strcmp (ranges[i].name, "TABLES") == 0)
+                  && (dxf_entity_index_scan (index, &ranges[i], TRUE) != EXIT_SUCCESS))
+                {
+                        dxf_entity_index_close (index);
+                        return (NULL);
+                }
+                else if (strcmp (ranges[i].name, "ENTITIES") == 0)
+                {
+                        if (dxf_entity_index_scan (index, &ranges[i], FALSE) != EXIT_SUCCESS)
+                        {
+                                dxf_entity_index_close (index);
+                                return (NULL);
+                        }
+                        index->entities_end = ranges[i].end;
+                }
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (index);
+}
+
+
+/*!
+ * \brief Remove \c record from the decoded entities which may be
+ * evicted, keeping the order of the others.
+ */
+static void
+dxf_entity_index_forget
+(
+        DxfEntityIndex *index,
+                /*!< the index. */
+        int record
+                /*!< number of the record. */
+)
+{
+        int i;
+        int j;
+
+        if (index->limit == 0)
+        {
+                return;
+        }
+        for (i = 0; i < index->decoded_count; i++)
+        {
+                if (index->decoded[(index->decoded_first + i) % index->limit] == record)
+                {
+                        break;
+                }
+        }
+        for (j = i; j < index->decoded_count - 1; j++)
+        {
+                index->decoded[(index->decoded_first + j) % index->limit] =
+                  index->decoded[(index->decoded_first + j + 1) % index->limit];
+        }
+        if (i < index->decoded_count)
+        {
+                index->decoded_count--;
+        }
+}
+
+
+/*!
+ * \brief Get the entity of \c record, decoding it when this has not been
+ * done yet.
+ *
+ * The entity is owned by the index.\n
+ * When a limit has been set with dxf_entity_index_set_limit (), decoding
+ * an entity may evict the entity which was decoded longest ago, after
+ * which pointers to that entity are no longer valid.
+ *
+ * \return a pointer to the entity, of the type given in the record, or
+ * \c NULL for an entity which can not be decoded or when an error
+ * occurred.
+ */
+void *
+dxf_entity_index_get
+(
+        DxfEntityIndex *index,
+                /*!< the index. */
+        int record
+                /*!< number of the record. */
+)
+{
+        DxfEntityIndexRecord *entry;
+        DxfFile *window;
+        DxfPair pair;
+        int oldest;
+
+        /* Do some basic checks. */
+        if ((index == NULL) || (record < 0) || (record >= index->count))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer or an invalid record was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        entry = &index->records[record];
+        if ((entry->entity != NULL) || (entry->type == UNKNOWN_ENTITY)
+          || (entry->deleted))
+        {
+                return (entry->entity);
+        }
+        if ((index->limit > 0) && (index->decoded_count == index->limit))
+        {
+                oldest = index->decoded[index->decoded_first];
+                dxf_entity_index_evict (index, oldest);
+        }
+        window = dxf_read_init_window (index->fp, entry->offset,
+          entry->offset + entry->length);
+        if (window == NULL)
+        {
+                return (NULL);
+        }
+        /* Skip the group code 0 pair, the readers start after it. */
+        if (dxf_lexer_read_pair (window, &pair) == 1)
+        {
+                entry->entity = dxf_entities_read_entity (window, entry->type);
+        }
+        dxf_read_close (window);
+        if ((entry->entity != NULL) && (index->limit > 0))
+        {
+                index->decoded[(index->decoded_first + index->decoded_count)
+                  % index->limit] = record;
+                index->decoded_count++;
+        }
+        return (entry->entity);
+}
+
+
+/*!
+ * \brief Free the decoded entity of \c record, if any.
+ *
+ * The entity is decoded again when it is asked for next time.  A
+ * changed entity (see dxf_entity_index_set_dirty ()) is kept until the
+ * index is closed.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_entity_index_evict
+(
+        DxfEntityIndex *index,
+                /*!< the index. */
+        int record
+                /*!< number of the record. */
+)
+{
+        DxfEntityIndexRecord *entry;
+
+        /* Do some basic checks. */
+        if ((index == NULL) || (record < 0) || (record >= index->count))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer or an invalid record was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        entry = &index->records[record];
+        if (entry->entity == NULL)
+        {
+                return (EXIT_SUCCESS);
+        }
+        if (entry->dirty)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a changed entity can not be evicted.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        dxf_entities_free_entity (entry->type, entry->entity);
+        entry->entity = NULL;
+        dxf_entity_index_forget (index, record);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Limit the number of decoded entities kept by \c index.
+ *
+ * All entities decoded so far, except changed ones, are evicted.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_entity_index_set_limit
+(
+        DxfEntityIndex *index,
+                /*!< the index. */
+        int limit
+                /*!< maximum number of decoded entities, or 0 for no
+                 * limit. */
+)
+{
+        int *decoded = NULL;
+        int i;
+
+        /* Do some basic checks. */
+        if ((index == NULL) || (limit < 0))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer or a negative limit was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (limit > 0)
+        {
+                decoded = malloc ((size_t) limit * sizeof (int));
+                if (decoded == NULL)
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () could not allocate memory.\n")),
+                          __FUNCTION__);
+                        return (EXIT_FAILURE);
+                }
+        }
+        for (i = 0; i < index->count; i++)
+        {
+                if ((index->records[i].entity != NULL)
+                  && (!index->records[i].dirty))
+                {
+                        dxf_entities_free_entity (index->records[i].type,
+                          index->records[i].entity);
+                        index->records[i].entity = NULL;
+                }
+        }
+        free (index->decoded);
+        index->decoded = decoded;
+        index->limit = limit;
+        index->decoded_count = 0;
+        index->decoded_first = 0;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Get the layer name of \c record.
+ *
+ * \return the layer name, owned by the index, or \c NULL when the
+ * entity has no layer or an error occurred.
+ */
+const char *
+dxf_entity_index_get_layer
+(
+        DxfEntityIndex *index,
+                /*!< the index. */
+        int record
+                /*!< number of the record. */
+)
+{
+        /* Do some basic checks. */
+        if ((index == NULL) || (record < 0) || (record >= index->count))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer or an invalid record was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        if (index->records[record].layer < 0)
+        {
+                return (NULL);
+        }
+        return (index->layers[index->records[record].layer]);
+}
+
+
+/*!
+ * \brief Get the symbol table entry of \c record, decoding it when this
+ * has not been done yet.
+ *
+ * The entry is owned by the index.
+ *
+ * \return a pointer to the entry, a \c DxfLayer for a record of the
+ * \c LAYER table and so on (see dxf_entity_index_get_table_name ()),
+ * or \c NULL when an error occurred.
+ */
+void *
+dxf_entity_index_get_table_record
+(
+        DxfEntityIndex *index,
+                /*!< the index. */
+        int record
+                /*!< number of the symbol table record. */
+)
+{
+        const DxfEntityIndexTable *table;
+        DxfEntityIndexRecord *entry;
+        DxfFile *window;
+        DxfPair pair;
+
+        /* Do some basic checks. */
+        if ((index == NULL) || (record < 0) || (record >= index->table_count))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer or an invalid record was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        entry = &index->table_records[record];
+        if ((entry->entity != NULL) || (entry->deleted))
+        {
+                return (entry->entity);
+        }
+        table = &dxf_entity_index_tables[entry->table];
+        window = dxf_read_init_window (index->fp, entry->offset,
+          entry->offset + entry->length);
+        if (window == NULL)
+        {
+                return (NULL);
+        }
+        /* Skip the group code 0 pair, the readers start after it. */
+        if (dxf_lexer_read_pair (window, &pair) == 1)
+        {
+                entry->entity = table->entry_read (window,
+                  table->entry_init (table->entry_new ()));
+        }
+        dxf_read_close (window);
+        return (entry->entity);
+}
+
+
+/*!
+ * \brief Get the name of the symbol table of \c record.
+ *
+ * \return the name of the entries of the table (\c "LAYER", \c "LTYPE",
+ * ...), or \c NULL when an error occurred.
+ */
+const char *
+dxf_entity_index_get_table_name
+(
+        DxfEntityIndex *index,
+                /*!< the index. */
+        int record
+                /*!< number of the symbol table record. */
+)
+{
+        /* Do some basic checks. */
+        if ((index == NULL) || (record < 0) || (record >= index->table_count))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer or an invalid record was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        return (dxf_entity_index_tables[index->table_records[record].table].name);
+}
+
+
+/*!
+ * \brief Mark the decoded entity of \c record as changed.
+ *
+ * A changed entity is not evicted, and is written by
+ * dxf_entity_index_save () in place of its original groups.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_entity_index_set_dirty
+(
+        DxfEntityIndex *index,
+                /*!< the index. */
+        int record
+                /*!< number of the record. */
+)
+{
+        /* Do some basic checks. */
+        if ((index == NULL) || (record < 0) || (record >= index->count))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer or an invalid record was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (index->records[record].entity == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () the entity was not decoded.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (!index->records[record].dirty)
+        {
+                index->records[record].dirty = TRUE;
+                dxf_entity_index_forget (index, record);
+        }
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Mark the decoded symbol table entry of \c record as changed.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_entity_index_set_table_record_dirty
+(
+        DxfEntityIndex *index,
+                /*!< the index. */
+        int record
+                /*!< number of the symbol table record. */
+)
+{
+        /* Do some basic checks. */
+        if ((index == NULL) || (record < 0) || (record >= index->table_count))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer or an invalid record was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (index->table_records[record].entity == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () the symbol table entry was not decoded.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        index->table_records[record].dirty = TRUE;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Add \c entity at the end of the \c ENTITIES section.
+ *
+ * The index takes ownership of \c entity.\n
+ * The handle of the entity is not checked against the handles in the
+ * file, nor is \c $HANDSEED in the header raised.
+ *
+ * \return the number of the new record, or -1 when an error occurred.
+ */
+int
+dxf_entity_index_add_entity
+(
+        DxfEntityIndex *index,
+                /*!< the index. */
+        DxfEntityType type,
+                /*!< type of the entity. */
+        void *entity
+                /*!< the entity. */
+)
+{
+        DxfEntityIndexRecord *record;
+
+        /* Do some basic checks. */
+        if ((index == NULL) || (entity == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (-1);
+        }
+        if (index->entities_end == 0)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () the file has no ENTITIES section.\n")),
+                  __FUNCTION__);
+                return (-1);
+        }
+        /* An added entity takes up no bytes of the file, just in front
+         * of the ENDSEC marker, so the records stay in file order. */
+        record = dxf_entity_index_add (index, type, -1, index->entities_end);
+        if (record == NULL)
+        {
+                return (-1);
+        }
+        record->entity = entity;
+        record->dirty = TRUE;
+        return (index->count - 1);
+}
+
+
+/*!
+ * \brief Delete the entity of \c record.
+ *
+ * The decoded entity, if any, is freed and the entity is left out by
+ * dxf_entity_index_save ().  Entities following a \c POLYLINE or an
+ * \c INSERT (\c VERTEX, \c ATTRIB and \c SEQEND) have records of their
+ * own, which have to be deleted too.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_entity_index_delete
+(
+        DxfEntityIndex *index,
+                /*!< the index. */
+        int record
+                /*!< number of the record. */
+)
+{
+        DxfEntityIndexRecord *entry;
+
+        /* Do some basic checks. */
+        if ((index == NULL) || (record < 0) || (record >= index->count))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer or an invalid record was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        entry = &index->records[record];
+        if (entry->entity != NULL)
+        {
+                if (!entry->dirty)
+                {
+                        dxf_entity_index_forget (index, record);
+                }
+                dxf_entities_free_entity (entry->type, entry->entity);
+                entry->entity = NULL;
+        }
+        entry->dirty = FALSE;
+        entry->deleted = TRUE;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Copy the bytes \c start up to \c end of the file of \c index
+ * verbatim to \c out.
+ *
+ * Large ranges of an uncompressed file are handed to
+ * \c copy_file_range (), which lets the kernel (or the file system)
+ * copy them without passing them through user space.  Otherwise, and
+ * when that fails, the bytes are written from the mapping.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_entity_index_copy
+(
+        DxfEntityIndex *index,
+                /*!< the index. */
+        DxfFile *out,
+                /*!< the output file. */
+        int source,
+                /*!< file descriptor of the file of \c index, or -1. */
+        size_t start,
+                /*!< offset of the first byte to copy. */
+        size_t end
+                /*!< offset of the byte following the last byte to
+                 * copy. */
+)
+{
+#ifdef HAVE_COPY_FILE_RANGE
+        loff_t offset;
+        ssize_t copied;
+#endif
+
+        if (end <= start)
+        {
+                return (EXIT_SUCCESS);
+        }
+#ifdef HAVE_COPY_FILE_RANGE
+        if ((source >= 0) && (end - start >= DXF_ENTITY_INDEX_MIN_COPY_SIZE)
+          && (out->compression == DXF_COMPRESSION_NONE))
+        {
+                if (dxf_write_flush (out) == EXIT_FAILURE)
+                {
+                        return (EXIT_FAILURE);
+                }
+                offset = (loff_t) start;
+                while (start < end)
+                {
+                        copied = copy_file_range (source, &offset,
+                          fileno (out->fp), NULL, end - start, 0);
+                        if (copied <= 0)
+                        {
+                                break;
+                        }
+                        start += (size_t) copied;
+                }
+                /* The stream did not see what was written to its file
+                 * descriptor. */
+                if (fseek (out->fp, 0, SEEK_END) != 0)
+                {
+                        return (EXIT_FAILURE);
+                }
+        }
+#endif
+        return (dxf_write_raw (out, index->fp->buffer + start, end - start));
+}
+
+
+/*!
+ * \brief Get the handle of the decoded entity or symbol table entry of
+ * \c record.
+ *
+ * \return the handle, or 0 when it has none.
+ */
+static long
+dxf_entity_index_get_id_code
+(
+        DxfEntityIndexRecord *record
+                /*!< the record. */
+)
+{
+        if (record->table >= 0)
+        {
+                return (*(long *) ((char *) record->entity
+                  + dxf_entity_index_tables[record->table].id_code));
+        }
+        return (dxf_entities_get_id_code (record->type, record->entity));
+}
+
+
+/*!
+ * \brief Set the handle of the decoded entity or symbol table entry of
+ * \c record.
+ */
+static void
+dxf_entity_index_set_id_code
+(
+        DxfEntityIndexRecord *record,
+                /*!< the record. */
+        long id_code
+                /*!< the handle. */
+)
+{
+        if (record->table >= 0)
+        {
+                *(long *) ((char *) record->entity
+                  + dxf_entity_index_tables[record->table].id_code) = id_code;
+                return;
+        }
+        dxf_entities_set_id_code (record->type, record->entity, id_code);
+}
+
+
+/*!
+ * \brief Write the changed entity or symbol table entry of \c record to
+ * \c out.
+ *
+ * Handles are optional before R13, so an entity which was read (or
+ * added) without a handle is written without group code 5 as well,
+ * instead of with handle 0.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_entity_index_write_record
+(
+        DxfFile *out,
+                /*!< the output file. */
+        DxfEntityIndexRecord *record
+                /*!< the record. */
+)
+{
+        int no_handle;
+        int result;
+
+        no_handle = (record->id_code == 0)
+          && (out->acad_version_number < AutoCAD_13)
+          && (dxf_entity_index_get_id_code (record) == 0);
+        if (no_handle)
+        {
+                /* The writers leave out the handle -1. */
+                dxf_entity_index_set_id_code (record, -1);
+        }
+        if (record->table >= 0)
+        {
+                result = dxf_entity_index_tables[record->table].entry_write
+                  (out, record->entity);
+        }
+        else
+        {
+                result = dxf_entities_write_entity (out, record->type,
+                  record->entity);
+        }
+        if (no_handle)
+        {
+                dxf_entity_index_set_id_code (record, 0);
+        }
+        return (result);
+}
+
+
+/*!
+ * \brief Save the drawing of \c index, with its changes, to a file.
+ *
+ * Only the changed and added entities and symbol table entries are
+ * written with the dxf_*_write () functions.  Everything else, the
+ * header, the blocks, the objects and all unchanged entities, is copied
+ * verbatim from the mapped file, so saving a large drawing after a few
+ * edits costs little more than copying the file.\n
+ * The file is written in the format (ASCII or binary) of the file of
+ * \c index, and is compressed as \c filename asks for (see
+ * dxf_write_init ()).  It can not be the file of \c index itself, which
+ * is still mapped: save to another file and rename that.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_entity_index_save
+(
+        DxfEntityIndex *index,
+                /*!< the index. */
+        const char *filename
+                /*!< filename of the output file (or device). */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfFile *out;
+        DxfEntityIndexRecord *record;
+        struct stat source_stat;
+        struct stat out_stat;
+        size_t position;
+        int source = -1;
+        int i = 0;
+        int j = 0;
+        int result = EXIT_SUCCESS;
+
+        /* Do some basic checks. */
+        if ((index == NULL) || (filename == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if ((stat (index->fp->filename, &source_stat) == 0)
+          && (stat (filename, &out_stat) == 0)
+          && (source_stat.st_dev == out_stat.st_dev)
+          && (source_stat.st_ino == out_stat.st_ino))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () can not save to the indexed file: %s.\n")),
+                  __FUNCTION__, filename);
+                return (EXIT_FAILURE);
+        }
+        out = dxf_write_init (filename, index->fp->binary);
+        if (out == NULL)
+        {
+                return (EXIT_FAILURE);
+        }
+        /* Write changes in the format of the original groups. */
+        out->binary = index->fp->binary;
+        out->acad_version_number = index->fp->acad_version_number;
+#ifdef HAVE_COPY_FILE_RANGE
+        if (index->fp->compression == DXF_COMPRESSION_NONE)
+        {
+                source = open (index->fp->filename, O_RDONLY);
+        }
+#endif
+        /* dxf_write_init () wrote the binary sentinel already. */
+        position = (index->fp->binary) ? DXF_BINARY_SENTINEL_LENGTH : 0;
+        while ((result == EXIT_SUCCESS)
+          && ((i < index->table_count) || (j < index->count)))
+        {
+                /* Merge the symbol table entries and the entities in
+                 * file order. */
+                if ((j == index->count)
+                  || ((i < index->table_count)
+                  && (index->table_records[i].offset <= index->records[j].offset)))
+                {
+                        record = &index->table_records[i++];
+                }
+                else
+                {
+                        record = &index->records[j++];
+                }
+                if ((!record->dirty) && (!record->deleted))
+                {
+                        continue;
+                }
+                result = dxf_entity_index_copy (index, out, source,
+                  position, record->offset);
+                if ((result == EXIT_SUCCESS) && (record->dirty))
+                {
+                        result = dxf_entity_index_write_record (out, record);
+                }
+                position = record->offset + record->length;
+        }
+        if (result == EXIT_SUCCESS)
+        {
+                result = dxf_entity_index_copy (index, out, source,
+                  position, index->fp->buffer_size);
+        }
+        if ((result == EXIT_SUCCESS) && (dxf_write_flush (out) == EXIT_FAILURE))
+        {
+                result = EXIT_FAILURE;
+        }
+        if (result == EXIT_FAILURE)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not write to file: %s.\n")),
+                  __FUNCTION__, filename);
+        }
+        if (source >= 0)
+        {
+                close (source);
+        }
+        dxf_write_close (out);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (result);
+}
+
+
+/*!
+ * \brief Free an index, all entities and symbol table entries decoded
+ * through it, and unmap the file.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_entity_index_close
+(
+        DxfEntityIndex *index
+                /*!< the index. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        int i;
+
+        /* Do some basic checks. */
+        if (index == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        for (i = 0; i < index->count; i++)
+        {
+                if (index->records[i].entity != NULL)
+                {
+                        dxf_entities_free_entity (index->records[i].type,
+                          index->records[i].entity);
+                }
+        }
+        for (i = 0; i < index->table_count; i++)
+        {
+                if (index->table_records[i].entity != NULL)
+                {
+                        dxf_entity_index_tables[index->table_records[i].table].entry_free
+                          (index->table_records[i].entity);
+                }
+        }
+        for (i = 0; i < index->layer_count; i++)
+        {
+                free (index->layers[i]);
+        }
+        free (index->layers);
+        free (index->records);
+        free (index->table_records);
+        free (index->decoded);
+        if (index->fp != NULL)
+        {
+                dxf_read_close (index->fp);
+        }
+        free (index);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/* EOF */
@@ -0,0 +1,223 @@
+/*!
+ * \file entity_index.h
+ *
+ * \author Copyright (C) 2017 by the libDXF developers.
+ *
+ * \brief Lazily decoded index of the entities in a DXF file, header file.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+
+
+#ifndef LIBDXF_SRC_ENTITY_INDEX_H
+#define LIBDXF_SRC_ENTITY_INDEX_H
+
+
+#include "global.h"
+#include "entity.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define DXF_ENTITY_INDEX_MIN_COPY_SIZE (1024 * 1024)
+        /*!< \brief dxf_entity_index_save () hands unchanged ranges of at
+         * least this many bytes to \c copy_file_range (). */
+
+
+/*!
+ * \brief Location and summary of one entity in a DXF file.
+ */
+typedef struct
+dxf_entity_index_record_struct
+{
+        DxfEntityType type;
+                /*!< Type of the entity, \c UNKNOWN_ENTITY for an entity
+                 * which can not be decoded. */
+        unsigned long id_code;
+                /*!< Handle of the entity (group code 5), or 0. */
+        int layer;
+                /*!< Index of the layer name in the \c layers of the
+                 * index, or -1. */
+        size_t offset;
+                /*!< Offset of the group code 0 pair of the entity in the
+                 * file. */
+        size_t length;
+                /*!< Length of the entity in the file in bytes. */
+        void *entity;
+                /*!< The decoded entity (or symbol table entry), or
+                 * \c NULL when not decoded. */
+        int table;
+                /*!< Symbol table of a record in the \c TABLES section
+                 * (see dxf_entity_index_get_table_name ()), or -1 for
+                 * an entity. */
+        int dirty;
+                /*!< \c TRUE when the decoded entity was changed or
+                 * added, and has to be written by
+                 * dxf_entity_index_save (). */
+        int deleted;
+                /*!< \c TRUE when the entity was deleted. */
+} DxfEntityIndexRecord;
+
+
+/*!
+ * \brief Index of the entities in the \c ENTITIES section of a DXF file.
+ *
+ * Only the index is built when the file is opened, entities are
+ * decoded when they are first asked for.
+ */
+typedef struct
+dxf_entity_index_struct
+{
+        DxfFile *fp;
+                /*!< The memory mapped file. */
+        DxfEntityIndexRecord *records;
+                /*!< The entities in file order. */
+        int count;
+                /*!< Number of entities in \c records. */
+        int size;
+                /*!< Allocated number of elements in \c records. */
+        char **layers;
+                /*!< Distinct layer names. */
+        int layer_count;
+                /*!< Number of names in \c layers. */
+        int limit;
+                /*!< Maximum number of decoded entities, or 0 for no
+                 * limit. */
+        int *decoded;
+                /*!< Records of the decoded entities, oldest first, as a
+                 * ring of \c limit elements. */
+        int decoded_count;
+                /*!< Number of decoded entities in \c decoded. */
+        int decoded_first;
+                /*!< Position of the oldest decoded entity in
+                 * \c decoded. */
+        DxfEntityIndexRecord *table_records;
+                /*!< The entries of the symbol tables in file order. */
+        int table_count;
+                /*!< Number of entries in \c table_records. */
+        int table_size;
+                /*!< Allocated number of elements in
+                 * \c table_records. */
+        size_t entities_end;
+                /*!< Offset of the \c ENDSEC marker of the \c ENTITIES
+                 * section, where added entities are written, or 0 when
+                 * there is no \c ENTITIES section. */
+} DxfEntityIndex;
+
+
+DxfEntityIndex *
+dxf_entity_index_open
+(
+        const char *filename
+);
+void *
+dxf_entity_index_get
+(
+        DxfEntityIndex *index,
+        int record
+);
+int
+dxf_entity_index_evict
+(
+        DxfEntityIndex *index,
+        int record
+);
+int
+dxf_entity_index_set_limit
+(
+        DxfEntityIndex *index,
+        int limit
+);
+const char *
+dxf_entity_index_get_layer
+(
+        DxfEntityIndex *index,
+        int record
+);
+void *
+dxf_entity_index_get_table_record
+(
+        DxfEntityIndex *index,
+        int record
+);
+const char *
+dxf_entity_index_get_table_name
+(
+        DxfEntityIndex *index,
+        int record
+);
+int
+dxf_entity_index_set_dirty
+(
+        DxfEntityIndex *index,
+        int record
+);
+int
+dxf_entity_index_set_table_record_dirty
+(
+        DxfEntityIndex *index,
+        int record
+);
+int
+dxf_entity_index_add_entity
+(
+        DxfEntityIndex *index,
+        DxfEntityType type,
+        void *entity
+);
+int
+dxf_entity_index_delete
+(
+        DxfEntityIndex *index,
+        int record
+);
+int
+dxf_entity_index_save
+(
+        DxfEntityIndex *index,
+        const char *filename
+);
+int
+dxf_entity_index_close
+(
+        DxfEntityIndex *index
+);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* LIBDXF_SRC_ENTITY_INDEX_H */
+
+
+/* EOF */
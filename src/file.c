@@ -33,6 +33,8 @@
 
 
 #include "file.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 char *dxf_entities_list;
@@ -45,8 +47,10 @@ DxfThumbnail *dxf_thumbnail;
  * \brief Function opens and reads a DXF file.
  * 
  * After opening the DXF file with the name \c filename the file is read
- * line by line until a line containing the \c SECTION keyword is
+ * group by group until a group containing the \c SECTION keyword is
  * encountered.\n
+ * Both ASCII and binary DXF files are accepted, a binary DXF file is
+ * recognised by its sentinel.\n
  * At this point a function which reads the \c SECTION until the
  * \c ENDSEC keyword is encountered and the invoked fuction returns here.
  */
@@ -59,6 +63,7 @@ dxf_file_read
 {
         char temp_string[DXF_MAX_STRING_LENGTH];
         DxfFile *fp;
+        DxfPair pair;
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
@@ -71,46 +76,40 @@ dxf_file_read
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        while (fp)
+        /* A binary DXF file is decoded by the lexer into the same pairs
+         * as an ASCII DXF file. */
+        dxf_lexer_detect_binary (fp);
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                dxf_read_line (temp_string, fp);
-                if (strcmp (temp_string, "999") == 0)
+                if (pair.group_code == 999)
                 {
                         /* Flush dxf comments to stdout as some apps put meta
                          * data regarding the correct loading of libraries in
                          * front of dxf data (sections, tables, entities etc.
                          */
-                        dxf_read_line (temp_string, fp);
+                        dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
                         fprintf (stdout, "DXF comment: %s\n", temp_string);
                 }
-                else if (strcmp (temp_string, "0") == 0)
+                else if ((pair.group_code == 0)
+                  && (dxf_pair_value_is (&pair, "SECTION")))
                 {
-                /* Now follows some meaningfull dxf data. */
-                        while (!feof (fp->fp))
-                        {
-                                dxf_read_line (temp_string, fp);
-                                if (strcmp (temp_string, "SECTION") == 0)
-                                {
-                                         /* We have found the beginning of a
-                                          * SECTION. */
-                                        dxf_section_read (fp);
-                                }
-                                else
-                                {
-                                         /* We were expecting a dxf SECTION and
-                                          * got something else. */
-                                        fprintf (stderr,
-                                          (_("Warning: in line %d \"SECTION\" was expected, \"%s\" was found.\n")),
-                                          fp->line_number, temp_string);
-                                }
-                        }
+                        /* We have found the beginning of a SECTION. */
+                        dxf_section_read (fp);
+                }
+                else if ((pair.group_code == 0)
+                  && (dxf_pair_value_is (&pair, "EOF")))
+                {
+                        /* We have found the end of the file. */
+                        break;
                 }
                 else
                 {
+                        /* We were expecting a dxf SECTION and got
+                         * something else. */
+                        dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
                         fprintf (stderr,
-                          (_("Warning: unexpected string encountered while reading line %d from: %s.\n")),
-                          fp->line_number , fp->filename);
-                        return (EXIT_FAILURE);
+                          (_("Warning: in line %d \"SECTION\" was expected, \"%s\" was found.\n")),
+                          fp->line_number, temp_string);
                 }
         }
         dxf_read_close (fp);
@@ -191,7 +190,7 @@ dxf_file_write_eof
                 return (EXIT_FAILURE);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\nEOF\n");
+        dxf_write_string (fp, 0, "EOF");
 #if DEBUG
         DXF_DEBUG_END
 #endif
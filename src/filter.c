@@ -0,0 +1,548 @@
+/*!
+ * \file filter.c
+ *
+ * \author Copyright (C) 2017 by the libDXF developers.
+ *
+ * \brief Read-time filter for the entities of a DXF file.
+ *
+ * A filter set on a \c DxfFile is checked by the entity readers as
+ * soon as the group code 0 pair of an entity has been read.  The type
+ * is checked first.  Layer, space and window are then checked on the
+ * raw groups of the entity, looking ahead with the lexer.  A rejected
+ * entity is skipped up to the next group code 0 pair, without
+ * allocating its struct or converting any value except, for a window,
+ * its coordinates.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+
+
+#include "filter.h"
+#include "entities.h"
+#include "lexer.h"
+
+
+/*!
+ * \brief Allocate memory for a \c DxfFilter.
+ *
+ * Fill the memory contents with zeros.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when succesful.
+ */
+DxfFilter *
+dxf_filter_new ()
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfFilter *filter = NULL;
+        size_t size;
+
+        size = sizeof (DxfFilter);
+        /* avoid malloc of 0 bytes */
+        if (size == 0) size = 1;
+        if ((filter = malloc (size)) == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory for a DxfFilter struct.\n")),
+                  __FUNCTION__);
+                filter = NULL;
+        }
+        else
+        {
+                memset (filter, 0, size);
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (filter);
+}
+
+
+/*!
+ * \brief Allocate memory and initialize data fields in a \c DxfFilter
+ * which accepts every entity.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when succesful.
+ */
+DxfFilter *
+dxf_filter_init
+(
+        DxfFilter *filter
+                /*!< the filter. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (filter == NULL)
+        {
+                fprintf (stderr,
+                  (_("Warning in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                filter = dxf_filter_new ();
+        }
+        if (filter == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory for a DxfFilter struct.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        filter->types = 0;
+        filter->layers = NULL;
+        filter->layer_count = 0;
+        filter->paperspace = DXF_FILTER_ANY_SPACE;
+        filter->window = FALSE;
+        filter->x_min = 0.0;
+        filter->y_min = 0.0;
+        filter->x_max = 0.0;
+        filter->y_max = 0.0;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (filter);
+}
+
+
+/*!
+ * \brief Accept entities of type \c type.
+ *
+ * Once a type has been added only the added types are accepted.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_filter_add_type
+(
+        DxfFilter *filter,
+                /*!< the filter. */
+        DxfEntityType type
+                /*!< type of the entities to accept. */
+)
+{
+        /* Do some basic checks. */
+        if (filter == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if ((type <= UNKNOWN_ENTITY) || ((int) type >= 64))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () an invalid entity type was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        filter->types |= DXF_FILTER_TYPE_BIT (type);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Accept entities on the layers matching \c pattern.
+ *
+ * In \c pattern a \c * matches any number of characters and a \c ? any
+ * one character, e.g. \c "TITLE*".  Like layer names in AutoCAD the
+ * match ignores case.\n
+ * Once a pattern has been added only entities on a layer matching one
+ * of the added patterns are accepted.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_filter_add_layer
+(
+        DxfFilter *filter,
+                /*!< the filter. */
+        const char *pattern
+                /*!< the layer name pattern. */
+)
+{
+        char **layers;
+
+        /* Do some basic checks. */
+        if ((filter == NULL) || (pattern == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        layers = realloc (filter->layers,
+          (size_t) (filter->layer_count + 1) * sizeof (char *));
+        if (layers == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        filter->layers = layers;
+        filter->layers[filter->layer_count] = strdup (pattern);
+        if (filter->layers[filter->layer_count] == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        filter->layer_count++;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Accept only entities in model space or only entities in paper
+ * space.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_filter_set_paperspace
+(
+        DxfFilter *filter,
+                /*!< the filter. */
+        int paperspace
+                /*!< 0 for model space, 1 for paper space, or
+                 * \c DXF_FILTER_ANY_SPACE for both. */
+)
+{
+        /* Do some basic checks. */
+        if (filter == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if ((paperspace != DXF_FILTER_ANY_SPACE)
+          && (paperspace != DXF_MODELSPACE)
+          && (paperspace != DXF_PAPERSPACE))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () an invalid paperspace value was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        filter->paperspace = paperspace;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Accept only entities with a point inside a window.
+ *
+ * The points of an entity are the coordinates in group codes 10 ... 18
+ * (X) and 20 ... 28 (Y), e.g. the start and end point of a \c LINE or
+ * the insertion point of an \c INSERT.  An entity is accepted when at
+ * least one of them lies inside the window, borders included.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_filter_set_window
+(
+        DxfFilter *filter,
+                /*!< the filter. */
+        double x_min,
+                /*!< X of a corner of the window. */
+        double y_min,
+                /*!< Y of a corner of the window. */
+        double x_max,
+                /*!< X of the opposite corner of the window. */
+        double y_max
+                /*!< Y of the opposite corner of the window. */
+)
+{
+        /* Do some basic checks. */
+        if (filter == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        filter->x_min = (x_min < x_max) ? x_min : x_max;
+        filter->x_max = (x_min < x_max) ? x_max : x_min;
+        filter->y_min = (y_min < y_max) ? y_min : y_max;
+        filter->y_max = (y_min < y_max) ? y_max : y_min;
+        filter->window = TRUE;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Test if the layer name \c name matches \c pattern (see
+ * dxf_filter_add_layer ()).
+ *
+ * \return \c TRUE when the name matches, \c FALSE otherwise.
+ */
+int
+dxf_filter_match_layer
+(
+        const char *pattern,
+                /*!< the pattern. */
+        const char *name
+                /*!< the layer name. */
+)
+{
+        const char *star = NULL;
+        const char *retry = NULL;
+
+        while (*name != '\0')
+        {
+                if (*pattern == '*')
+                {
+                        /* Try to match the rest of the pattern here,
+                         * and one character further on when that
+                         * fails. */
+                        star = ++pattern;
+                        retry = name;
+                }
+                else if ((*pattern != '\0')
+                  && ((*pattern == '?')
+                  || (toupper ((unsigned char) *pattern) == toupper ((unsigned char) *name))))
+                {
+                        pattern++;
+                        name++;
+                }
+                else if (star != NULL)
+                {
+                        pattern = star;
+                        name = ++retry;
+                }
+                else
+                {
+                        return (FALSE);
+                }
+        }
+        while (*pattern == '*')
+        {
+                pattern++;
+        }
+        return (*pattern == '\0');
+}
+
+
+/*!
+ * \brief Read the groups of an entity, up to the next group code 0
+ * pair, and test them against the layer, space and window of
+ * \c filter.
+ *
+ * \return \c TRUE when the entity passes, \c FALSE otherwise.
+ */
+static int
+dxf_filter_accepts
+(
+        DxfFilter *filter,
+                /*!< the filter. */
+        DxfFile *fp
+                /*!< DXF file handle of input file (or device). */
+)
+{
+        char layer[DXF_MAX_STRING_LENGTH];
+        double x[9];
+        double y;
+        DxfPair pair;
+        int have_x = 0;
+        int have_layer = FALSE;
+        int space = DXF_MODELSPACE;
+        int inside = !filter->window;
+        int i;
+        int k;
+
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
+        {
+                if (pair.group_code == 0)
+                {
+                        dxf_lexer_unread_pair (fp);
+                        break;
+                }
+                if ((pair.group_code == 8) && (!have_layer))
+                {
+                        dxf_pair_copy_string (&pair, layer, sizeof (layer));
+                        have_layer = TRUE;
+                }
+                else if (pair.group_code == 67)
+                {
+                        space = dxf_pair_get_int (&pair);
+                }
+                else if ((!inside) && (pair.group_code >= 10)
+                  && (pair.group_code <= 18))
+                {
+                        k = pair.group_code - 10;
+                        x[k] = dxf_pair_get_double (&pair);
+                        have_x |= 1 << k;
+                }
+                else if ((!inside) && (pair.group_code >= 20)
+                  && (pair.group_code <= 28)
+                  && (have_x & (1 << (pair.group_code - 20))))
+                {
+                        k = pair.group_code - 20;
+                        y = dxf_pair_get_double (&pair);
+                        inside = (x[k] >= filter->x_min)
+                          && (x[k] <= filter->x_max)
+                          && (y >= filter->y_min)
+                          && (y <= filter->y_max);
+                }
+        }
+        if ((!inside)
+          || ((filter->paperspace != DXF_FILTER_ANY_SPACE)
+          && (space != filter->paperspace)))
+        {
+                return (FALSE);
+        }
+        if (filter->layer_count == 0)
+        {
+                return (TRUE);
+        }
+        if (!have_layer)
+        {
+                /* Entities without a layer are on layer 0. */
+                strcpy (layer, "0");
+        }
+        for (i = 0; i < filter->layer_count; i++)
+        {
+                if (dxf_filter_match_layer (filter->layers[i], layer))
+                {
+                        return (TRUE);
+                }
+        }
+        return (FALSE);
+}
+
+
+/*!
+ * \brief Skip the entity of type \c type when it does not pass the
+ * filter of \c fp.
+ *
+ * Called by the entity readers right after the group code 0 pair
+ * starting an entity.  The type is tested without reading further.
+ * Layer, space and window are tested on the groups of the entity,
+ * after which the read position returns to the start of the entity if
+ * it passes.\n
+ * On a stream which can not seek (a pipe) only the type is tested.
+ *
+ * \return \c TRUE when the entity was skipped, the group code 0 pair
+ * of the next entity is left for the caller, or \c FALSE when the
+ * entity is to be read.
+ */
+int
+dxf_filter_skip_entity
+(
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
+        DxfEntityType type
+                /*!< type of the entity. */
+)
+{
+        DxfFilter *filter;
+        DxfLexerPosition start;
+
+        if ((fp == NULL) || (fp->filter == NULL))
+        {
+                return (FALSE);
+        }
+        filter = fp->filter;
+        if ((filter->types != 0)
+          && (((int) type <= UNKNOWN_ENTITY) || ((int) type >= 64)
+          || ((filter->types & DXF_FILTER_TYPE_BIT (type)) == 0)))
+        {
+                dxf_entities_skip_entity (fp);
+                return (TRUE);
+        }
+        if ((filter->layer_count == 0)
+          && (filter->paperspace == DXF_FILTER_ANY_SPACE)
+          && (!filter->window))
+        {
+                return (FALSE);
+        }
+        if (dxf_lexer_save_position (fp, &start) == EXIT_FAILURE)
+        {
+                return (FALSE);
+        }
+        if (!dxf_filter_accepts (filter, fp))
+        {
+                return (TRUE);
+        }
+        dxf_lexer_restore_position (fp, &start);
+        return (FALSE);
+}
+
+
+/*!
+ * \brief Free the allocated memory for a \c DxfFilter and all it's data
+ * fields.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_filter_free
+(
+        DxfFilter *filter
+                /*!< the filter. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        int i;
+
+        /* Do some basic checks. */
+        if (filter == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        for (i = 0; i < filter->layer_count; i++)
+        {
+                free (filter->layers[i]);
+        }
+        free (filter->layers);
+        free (filter);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/* EOF */
@@ -0,0 +1,152 @@
+/*!
+ * \file filter.h
+ *
+ * \author Copyright (C) 2017 by the libDXF developers.
+ *
+ * \brief Read-time filter for the entities of a DXF file, header file.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+
+#ifndef LIBDXF_SRC_FILTER_H
+#define LIBDXF_SRC_FILTER_H
+
+
+#include "global.h"
+#include "entity.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define DXF_FILTER_ANY_SPACE -1
+        /*!< \brief Accept entities in model space and in paper space. */
+#define DXF_FILTER_TYPE_BIT(type) (((uint64_t) 1) << (type))
+        /*!< \brief Bit of an entity type in the \c types of a
+         * DxfFilter. */
+
+
+/*!
+ * \brief Definition of a read-time entity filter.
+ *
+ * An entity is read when it passes every criterion which is set.
+ */
+typedef struct
+dxf_filter_struct
+{
+        uint64_t types;
+                /*!< Accepted entity types (see DXF_FILTER_TYPE_BIT ()),
+                 * or 0 for all types. */
+        char **layers;
+                /*!< Accepted layer name patterns, \c * matches any
+                 * number of characters and \c ? any one character. */
+        int layer_count;
+                /*!< Number of patterns in \c layers, or 0 for all
+                 * layers. */
+        int paperspace;
+                /*!< 0 for model space, 1 for paper space, or
+                 * \c DXF_FILTER_ANY_SPACE.\n
+                 * Group code = 67. */
+        int window;
+                /*!< \c TRUE when only entities with a point inside the
+                 * window are accepted. */
+        double x_min;
+                /*!< Lower left corner of the window. */
+        double y_min;
+                /*!< Lower left corner of the window. */
+        double x_max;
+                /*!< Upper right corner of the window. */
+        double y_max;
+                /*!< Upper right corner of the window. */
+} DxfFilter;
+
+
+DxfFilter *
+dxf_filter_new ();
+DxfFilter *
+dxf_filter_init
+(
+        DxfFilter *filter
+);
+int
+dxf_filter_add_type
+(
+        DxfFilter *filter,
+        DxfEntityType type
+);
+int
+dxf_filter_add_layer
+(
+        DxfFilter *filter,
+        const char *pattern
+);
+int
+dxf_filter_set_paperspace
+(
+        DxfFilter *filter,
+        int paperspace
+);
+int
+dxf_filter_set_window
+(
+        DxfFilter *filter,
+        double x_min,
+        double y_min,
+        double x_max,
+        double y_max
+);
+int
+dxf_filter_match_layer
+(
+        const char *pattern,
+        const char *name
+);
+int
+dxf_filter_skip_entity
+(
+        DxfFile *fp,
+        DxfEntityType type
+);
+int
+dxf_filter_free
+(
+        DxfFilter *filter
+);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* LIBDXF_SRC_FILTER_H */
+
+
+/* EOF */
@@ -167,6 +167,16 @@
         /*!< \brief A DXF error is -1. */
 #endif
 
+#if defined (__GNUC__)
+#  define DXF_DEPRECATED __attribute__ ((deprecated))
+        /*!< \brief Mark a function as deprecated, the compiler warns
+         * about its callers. */
+#else
+#  define DXF_DEPRECATED
+        /*!< \brief Mark a function as deprecated, not supported by
+         * this compiler. */
+#endif
+
 #define DXF_DEBUG_BEGIN \
         fprintf (stderr, \
           (_("[File: %s: line: %d] Entering %s () function.\n")), \
@@ -184,6 +194,40 @@
          * Compile with -DDEBUG compiler directive enabled. */
 
 
+/*!
+ * \brief A read-only view into the contents of a DXF file.
+ *
+ * The data is <b>not</b> terminated with a \c NUL character.\n
+ * For a memory mapped file the data stays valid until the \c DxfFile
+ * is closed, otherwise until the next line is read.
+ */
+typedef struct
+dxf_slice_struct
+{
+        const char *data;
+                /*!< Start of the slice. */
+        size_t length;
+                /*!< Length of the slice in bytes. */
+} DxfSlice;
+
+
+/*!
+ * \brief A group code and the value belonging to it, as returned by
+ * the lexer.
+ */
+typedef struct
+dxf_pair_struct
+{
+        int group_code;
+                /*!< Group code. */
+        DxfSlice value;
+                /*!< Value of the group, still unparsed. */
+        int binary;
+                /*!< \c value holds the raw little endian bytes of a
+                 * number read from a binary DXF file, instead of text. */
+} DxfPair;
+
+
 /*!
  * \brief DXF definition of a DXF file.
  */
@@ -202,6 +246,66 @@ dxf_file_struct
         /*!< AutoCAD version number. */
     int follow_strict_version_rules;
         /*!< follow strict rules when writing to file. */
+    char *buffer;
+        /*!< Start of the memory mapped contents of the file.\n
+         * \c NULL when the file is read through stdio. */
+    size_t buffer_size;
+        /*!< Size of the memory mapped contents in bytes. */
+    size_t position;
+        /*!< Read position in the memory mapped contents.\n
+         * The stream in \c fp is only positioned there when one of the
+         * stdio based dxf_read_* () functions needs it. */
+    char *line_buffer;
+        /*!< Buffer holding the last line read by the lexer when the
+         * file is read through stdio. */
+    size_t line_buffer_size;
+        /*!< Allocated size of \c line_buffer in bytes. */
+    DxfPair pair;
+        /*!< Last group code / value pair read by the lexer. */
+    int pair_pending;
+        /*!< The lexer returns \c pair once more on the next read. */
+    int binary;
+        /*!< Size in bytes of a group code in a binary DXF file (1 or
+         * 2), or 0 for an ASCII DXF file. */
+    struct dxf_file_struct *parent;
+        /*!< The file this file is a window on, which owns the memory
+         * mapping, or \c NULL. */
+    int compression;
+        /*!< Compression format of the file on disk (see
+         * \c DxfCompression).\n
+         * For a compressed file \c buffer holds the decompressed
+         * contents in allocated memory instead of a memory mapping. */
+    char *write_buffer;
+        /*!< Output buffer of a file opened with dxf_write_init () or
+         * dxf_write_init_memory (), or \c NULL.\n
+         * The writer collects groups here and hands them to \c fp in
+         * large blocks.  A memory file has no \c fp, its buffer grows
+         * to hold everything written. */
+    size_t write_buffer_size;
+        /*!< Allocated size of \c write_buffer in bytes. */
+    size_t write_length;
+        /*!< Number of bytes in \c write_buffer not yet written to
+         * \c fp. */
+    int decimals;
+        /*!< Number of decimals the writer uses for floating point
+         * values, or -1 for the shortest text which reads back as the
+         * same value (see dxf_write_set_decimals ()). */
+    struct dxf_filter_struct *filter;
+        /*!< Entities not passing this filter are skipped while
+         * reading the \c ENTITIES section (see filter.h), or \c NULL
+         * to read all entities. */
+    struct dxf_string_pool_struct *strings;
+        /*!< Pool for the layer, linetype, color and pointer strings of
+         * the entities read (see string_pool.h), or \c NULL to give
+         * every entity its own copies. */
+    struct dxf_graphic_properties_pool_struct *properties;
+        /*!< Pool for the graphic property records of the entities
+         * read which share them (see graphic_properties.h), or \c NULL
+         * to give every entity a record of its own. */
+    struct dxf_columns_struct *columns;
+        /*!< Columnar store receiving the \c LINE, \c POINT, \c CIRCLE
+         * and \c ARC entities read from the \c ENTITIES section
+         * (see columns.h), or \c NULL to read them as structs. */
 } DxfFile;
 
 
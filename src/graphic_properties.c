@@ -0,0 +1,784 @@
+/*!
+ * \file graphic_properties.c
+ *
+ * \author Copyright (C) 2017 by the libDXF developers.
+ *
+ * \brief Shared graphic properties of entities.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+
+
+
+#include "graphic_properties.h"
+#include "arena.h"
+#include "lexer.h"
+
+
+/*!
+ * \brief The properties of a new entity.
+ */
+static DxfGraphicProperties dxf_graphic_properties_defaults =
+{
+        DXF_DEFAULT_LINETYPE,
+        DXF_DEFAULT_LAYER,
+        0.0,
+        0.0,
+        DXF_DEFAULT_LINETYPE_SCALE,
+        DXF_DEFAULT_VISIBILITY,
+        DXF_COLOR_BYLAYER,
+        DXF_MODELSPACE,
+        0,
+        "",
+        0,
+        "",
+        0,
+        "",
+        0,
+        TRUE,
+        -1
+};
+
+
+/*!
+ * \brief Get the shared record with the properties of a new entity:
+ * linetype \c BYLAYER, layer "0", color \c BYLAYER, model space and
+ * empty or zero values for the other properties.
+ *
+ * \return the shared record.
+ */
+DxfGraphicProperties *
+dxf_graphic_properties_default ()
+{
+        return (&dxf_graphic_properties_defaults);
+}
+
+
+/*!
+ * \brief Allocate a private copy of \c properties, with copies of its
+ * strings.
+ *
+ * \return the copy, or \c NULL when no memory could be allocated.
+ */
+static DxfGraphicProperties *
+dxf_graphic_properties_clone
+(
+        DxfGraphicProperties *properties
+                /*!< the record to copy. */
+)
+{
+        DxfGraphicProperties *copy;
+
+        if ((copy = dxf_malloc (sizeof (DxfGraphicProperties))) == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory for a DxfGraphicProperties struct.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        *copy = *properties;
+        copy->linetype = dxf_strdup (properties->linetype);
+        copy->layer = dxf_strdup (properties->layer);
+        copy->material = dxf_strdup (properties->material);
+        copy->plot_style_name = dxf_strdup (properties->plot_style_name);
+        copy->color_name = dxf_strdup (properties->color_name);
+        copy->shared = FALSE;
+        copy->id = -1;
+        return (copy);
+}
+
+
+/*!
+ * \brief Make sure \c *properties is a record of its own, which can be
+ * changed.
+ *
+ * A shared record is replaced by a private copy with copies of its
+ * strings, a private record is left as it is.
+ *
+ * \return the private record, or \c NULL when no memory could be
+ * allocated.
+ */
+DxfGraphicProperties *
+dxf_graphic_properties_unshare
+(
+        DxfGraphicProperties **properties
+                /*!< the record of the entity. */
+)
+{
+        DxfGraphicProperties *copy;
+
+        /* Do some basic checks. */
+        if ((properties == NULL) || (*properties == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        if (!(*properties)->shared)
+        {
+                return (*properties);
+        }
+        copy = dxf_graphic_properties_clone (*properties);
+        if (copy != NULL)
+        {
+                *properties = copy;
+        }
+        return (copy);
+}
+
+
+/*!
+ * \brief Get a record with the properties of \c properties for another
+ * entity.
+ *
+ * A shared record is shared once more, a private record is copied.
+ *
+ * \return the record, or \c NULL when an error occurred.
+ */
+DxfGraphicProperties *
+dxf_graphic_properties_copy
+(
+        DxfGraphicProperties *properties
+                /*!< the record to copy. */
+)
+{
+        /* Do some basic checks. */
+        if (properties == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        if (properties->shared)
+        {
+                return (properties);
+        }
+        return (dxf_graphic_properties_clone (properties));
+}
+
+
+/*!
+ * \brief Free a private record and its strings.
+ *
+ * Shared records belong to their pool (or to libDXF for the default
+ * record) and are left alone.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_graphic_properties_free
+(
+        DxfGraphicProperties *properties
+                /*!< the record. */
+)
+{
+        if ((properties == NULL) || (properties->shared))
+        {
+                return (EXIT_SUCCESS);
+        }
+        dxf_free (properties->linetype);
+        dxf_free (properties->layer);
+        dxf_free (properties->material);
+        dxf_free (properties->plot_style_name);
+        dxf_free (properties->color_name);
+        dxf_free (properties);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Prepare \c read for reading the properties of an entity which
+ * has the record \c properties.
+ *
+ * The numbers are copied from \c properties, the strings are set to
+ * \c NULL for "not read".  The reader of the entity stores the values
+ * it reads in \c read, and passes it to
+ * dxf_graphic_properties_finish () afterwards, so no record is
+ * allocated for an entity which ends up sharing one.
+ */
+void
+dxf_graphic_properties_start
+(
+        DxfGraphicProperties *read,
+                /*!< the properties to read into. */
+        DxfGraphicProperties *properties
+                /*!< the current record of the entity. */
+)
+{
+        *read = *properties;
+        read->linetype = NULL;
+        read->layer = NULL;
+        read->material = NULL;
+        read->plot_style_name = NULL;
+        read->color_name = NULL;
+        read->shared = FALSE;
+        read->id = -1;
+}
+
+
+/*!
+ * \brief Set the string \c *member of a record to \c string when that
+ * was read.
+ */
+static void
+dxf_graphic_properties_take_string
+(
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
+        char **member,
+                /*!< the member of the record. */
+        char *string
+                /*!< the string read, or \c NULL. */
+)
+{
+        if (string != NULL)
+        {
+                dxf_lexer_free_string (fp, *member);
+                *member = string;
+        }
+}
+
+
+/*!
+ * \brief Give an entity the properties read by its reader.
+ *
+ * When \c fp has a pool of records, \c *properties is replaced by the
+ * record of the pool with the properties read, and the strings read
+ * are released.  Otherwise the entity gets a private record which
+ * takes the strings read.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when no memory
+ * could be allocated.
+ */
+int
+dxf_graphic_properties_finish
+(
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
+        DxfGraphicProperties **properties,
+                /*!< the record of the entity. */
+        DxfGraphicProperties *read
+                /*!< the properties read, prepared with
+                 * dxf_graphic_properties_start (). */
+)
+{
+        DxfGraphicProperties merged;
+        DxfGraphicProperties *record;
+
+        if (fp->properties != NULL)
+        {
+                merged = *read;
+                merged.linetype = (read->linetype != NULL) ? read->linetype : (*properties)->linetype;
+                merged.layer = (read->layer != NULL) ? read->layer : (*properties)->layer;
+                merged.material = (read->material != NULL) ? read->material : (*properties)->material;
+                merged.plot_style_name = (read->plot_style_name != NULL) ? read->plot_style_name : (*properties)->plot_style_name;
+                merged.color_name = (read->color_name != NULL) ? read->color_name : (*properties)->color_name;
+                record = dxf_graphic_properties_pool_intern (fp->properties, &merged);
+                if (record != NULL)
+                {
+                        dxf_lexer_free_string (fp, read->linetype);
+                        dxf_lexer_free_string (fp, read->layer);
+                        dxf_lexer_free_string (fp, read->material);
+                        dxf_lexer_free_string (fp, read->plot_style_name);
+                        dxf_lexer_free_string (fp, read->color_name);
+                        dxf_graphic_properties_free (*properties);
+                        *properties = record;
+                        return (EXIT_SUCCESS);
+                }
+        }
+        record = dxf_graphic_properties_unshare (properties);
+        if (record == NULL)
+        {
+                dxf_lexer_free_string (fp, read->linetype);
+                dxf_lexer_free_string (fp, read->layer);
+                dxf_lexer_free_string (fp, read->material);
+                dxf_lexer_free_string (fp, read->plot_style_name);
+                dxf_lexer_free_string (fp, read->color_name);
+                return (EXIT_FAILURE);
+        }
+        dxf_graphic_properties_take_string (fp, &record->linetype, read->linetype);
+        dxf_graphic_properties_take_string (fp, &record->layer, read->layer);
+        dxf_graphic_properties_take_string (fp, &record->material, read->material);
+        dxf_graphic_properties_take_string (fp, &record->plot_style_name, read->plot_style_name);
+        dxf_graphic_properties_take_string (fp, &record->color_name, read->color_name);
+        record->elevation = read->elevation;
+        record->thickness = read->thickness;
+        record->linetype_scale = read->linetype_scale;
+        record->visibility = read->visibility;
+        record->color = read->color;
+        record->paperspace = read->paperspace;
+        record->shadow_mode = read->shadow_mode;
+        record->lineweight = read->lineweight;
+        record->color_value = read->color_value;
+        record->transparency = read->transparency;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Add \c size bytes at \c data to the FNV-1a hash \c hash.
+ *
+ * \return the new hash.
+ */
+static uint64_t
+dxf_graphic_properties_hash_bytes
+(
+        uint64_t hash,
+                /*!< the hash so far. */
+        const void *data,
+                /*!< the bytes. */
+        size_t size
+                /*!< number of bytes. */
+)
+{
+        const unsigned char *bytes = data;
+        size_t i;
+
+        for (i = 0; i < size; i++)
+        {
+                hash ^= bytes[i];
+                hash *= UINT64_C (0x100000001B3);
+        }
+        return (hash);
+}
+
+
+/*!
+ * \brief Hash of a record whose strings are in the string pool, so the
+ * string pointers stand for their contents.
+ */
+static uint64_t
+dxf_graphic_properties_hash
+(
+        const DxfGraphicProperties *p
+                /*!< the record. */
+)
+{
+        uint64_t hash = UINT64_C (0xCBF29CE484222325);
+
+        hash = dxf_graphic_properties_hash_bytes (hash, &p->linetype, sizeof (p->linetype));
+        hash = dxf_graphic_properties_hash_bytes (hash, &p->layer, sizeof (p->layer));
+        hash = dxf_graphic_properties_hash_bytes (hash, &p->elevation, sizeof (p->elevation));
+        hash = dxf_graphic_properties_hash_bytes (hash, &p->thickness, sizeof (p->thickness));
+        hash = dxf_graphic_properties_hash_bytes (hash, &p->linetype_scale, sizeof (p->linetype_scale));
+        hash = dxf_graphic_properties_hash_bytes (hash, &p->visibility, sizeof (p->visibility));
+        hash = dxf_graphic_properties_hash_bytes (hash, &p->color, sizeof (p->color));
+        hash = dxf_graphic_properties_hash_bytes (hash, &p->paperspace, sizeof (p->paperspace));
+        hash = dxf_graphic_properties_hash_bytes (hash, &p->shadow_mode, sizeof (p->shadow_mode));
+        hash = dxf_graphic_properties_hash_bytes (hash, &p->material, sizeof (p->material));
+        hash = dxf_graphic_properties_hash_bytes (hash, &p->lineweight, sizeof (p->lineweight));
+        hash = dxf_graphic_properties_hash_bytes (hash, &p->plot_style_name, sizeof (p->plot_style_name));
+        hash = dxf_graphic_properties_hash_bytes (hash, &p->color_value, sizeof (p->color_value));
+        hash = dxf_graphic_properties_hash_bytes (hash, &p->color_name, sizeof (p->color_name));
+        hash = dxf_graphic_properties_hash_bytes (hash, &p->transparency, sizeof (p->transparency));
+        return (hash);
+}
+
+
+/*!
+ * \brief Test if two records with strings from the same string pool
+ * are equal.
+ *
+ * The floating point members are compared bit by bit, as they are
+ * hashed.
+ *
+ * \return \c TRUE when equal, \c FALSE otherwise.
+ */
+static int
+dxf_graphic_properties_equal
+(
+        const DxfGraphicProperties *a,
+                /*!< a record. */
+        const DxfGraphicProperties *b
+                /*!< another record. */
+)
+{
+        return ((a->linetype == b->linetype)
+          && (a->layer == b->layer)
+          && (memcmp (&a->elevation, &b->elevation, sizeof (double)) == 0)
+          && (memcmp (&a->thickness, &b->thickness, sizeof (double)) == 0)
+          && (memcmp (&a->linetype_scale, &b->linetype_scale, sizeof (double)) == 0)
+          && (a->visibility == b->visibility)
+          && (a->color == b->color)
+          && (a->paperspace == b->paperspace)
+          && (a->shadow_mode == b->shadow_mode)
+          && (a->material == b->material)
+          && (a->lineweight == b->lineweight)
+          && (a->plot_style_name == b->plot_style_name)
+          && (a->color_value == b->color_value)
+          && (a->color_name == b->color_name)
+          && (a->transparency == b->transparency));
+}
+
+
+/*!
+ * \brief Find the slot of a record in \c pool.
+ *
+ * \return the slot holding an equal record, or the empty slot where it
+ * belongs.
+ */
+static DxfGraphicPropertiesSlot *
+dxf_graphic_properties_pool_find
+(
+        DxfGraphicPropertiesPool *pool,
+                /*!< the pool. */
+        uint64_t hash,
+                /*!< hash of the record. */
+        const DxfGraphicProperties *properties
+                /*!< the record. */
+)
+{
+        DxfGraphicPropertiesSlot *slot;
+        size_t i;
+
+        i = (size_t) hash & (pool->capacity - 1);
+        for (;;)
+        {
+                slot = &pool->slots[i];
+                if ((slot->record == NULL)
+                  || ((slot->hash == hash)
+                  && dxf_graphic_properties_equal (slot->record, properties)))
+                {
+                        return (slot);
+                }
+                i = (i + 1) & (pool->capacity - 1);
+        }
+}
+
+
+/*!
+ * \brief Double the number of slots of \c pool.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when no memory
+ * could be allocated.
+ */
+static int
+dxf_graphic_properties_pool_grow
+(
+        DxfGraphicPropertiesPool *pool
+                /*!< the pool. */
+)
+{
+        DxfGraphicPropertiesSlot *slots;
+        DxfGraphicProperties **records;
+        size_t capacity;
+        size_t i;
+        size_t j;
+
+        capacity = pool->capacity * 2;
+        slots = calloc (capacity, sizeof (DxfGraphicPropertiesSlot));
+        records = realloc (pool->records, (capacity / 2) * sizeof (DxfGraphicProperties *));
+        if ((slots == NULL) || (records == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                free (slots);
+                if (records != NULL)
+                {
+                        pool->records = records;
+                }
+                return (EXIT_FAILURE);
+        }
+        pool->records = records;
+        for (i = 0; i < pool->capacity; i++)
+        {
+                if (pool->slots[i].record == NULL)
+                {
+                        continue;
+                }
+                j = (size_t) pool->slots[i].hash & (capacity - 1);
+                while (slots[j].record != NULL)
+                {
+                        j = (j + 1) & (capacity - 1);
+                }
+                slots[j] = pool->slots[i];
+        }
+        free (pool->slots);
+        pool->slots = slots;
+        pool->capacity = capacity;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Allocate an empty \c DxfGraphicPropertiesPool, which takes the
+ * strings of its records from \c strings.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when succesful.
+ */
+DxfGraphicPropertiesPool *
+dxf_graphic_properties_pool_new
+(
+        DxfStringPool *strings
+                /*!< the string pool. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfGraphicPropertiesPool *pool = NULL;
+
+        /* Do some basic checks. */
+        if (strings == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        if ((pool = malloc (sizeof (DxfGraphicPropertiesPool))) == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory for a DxfGraphicPropertiesPool struct.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        pool->strings = strings;
+        pool->capacity = DXF_GRAPHIC_PROPERTIES_MIN_CAPACITY;
+        pool->count = 0;
+        pool->slots = calloc (pool->capacity, sizeof (DxfGraphicPropertiesSlot));
+        pool->records = malloc ((pool->capacity / 2) * sizeof (DxfGraphicProperties *));
+        if ((pool->slots == NULL) || (pool->records == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                free (pool->slots);
+                free (pool->records);
+                free (pool);
+                return (NULL);
+        }
+#if !defined (MSDOS) && !defined (_WIN32)
+        pthread_mutex_init (&pool->lock, NULL);
+#endif
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (pool);
+}
+
+
+/*!
+ * \brief Get the record of \c pool with the same properties as
+ * \c properties, adding it when the pool has none yet.
+ *
+ * \c properties itself is not changed, its strings are looked up in
+ * (or copied into) the string pool.
+ *
+ * \return the shared record, or \c NULL when an error occurred.
+ */
+DxfGraphicProperties *
+dxf_graphic_properties_pool_intern
+(
+        DxfGraphicPropertiesPool *pool,
+                /*!< the pool. */
+        DxfGraphicProperties *properties
+                /*!< the properties. */
+)
+{
+        DxfGraphicProperties key;
+        DxfGraphicPropertiesSlot *slot;
+        DxfGraphicProperties *result = NULL;
+        uint64_t hash;
+
+        /* Do some basic checks. */
+        if ((pool == NULL) || (properties == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        key = *properties;
+        key.linetype = dxf_string_pool_intern (pool->strings, (properties->linetype != NULL) ? properties->linetype : "");
+        key.layer = dxf_string_pool_intern (pool->strings, (properties->layer != NULL) ? properties->layer : "");
+        key.material = dxf_string_pool_intern (pool->strings, (properties->material != NULL) ? properties->material : "");
+        key.plot_style_name = dxf_string_pool_intern (pool->strings, (properties->plot_style_name != NULL) ? properties->plot_style_name : "");
+        key.color_name = dxf_string_pool_intern (pool->strings, (properties->color_name != NULL) ? properties->color_name : "");
+        if ((key.linetype == NULL)
+          || (key.layer == NULL)
+          || (key.material == NULL)
+          || (key.plot_style_name == NULL)
+          || (key.color_name == NULL))
+        {
+                return (NULL);
+        }
+        key.shared = TRUE;
+        hash = dxf_graphic_properties_hash (&key);
+#if !defined (MSDOS) && !defined (_WIN32)
+        pthread_mutex_lock (&pool->lock);
+#endif
+        slot = dxf_graphic_properties_pool_find (pool, hash, &key);
+        if (slot->record != NULL)
+        {
+                result = slot->record;
+        }
+        else if ((2 * (pool->count + 1) <= pool->capacity)
+          || (dxf_graphic_properties_pool_grow (pool) == EXIT_SUCCESS))
+        {
+                result = malloc (sizeof (DxfGraphicProperties));
+                if (result == NULL)
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () could not allocate memory for a DxfGraphicProperties struct.\n")),
+                          __FUNCTION__);
+                }
+                else
+                {
+                        *result = key;
+                        result->id = (int) pool->count;
+                        slot = dxf_graphic_properties_pool_find (pool, hash, &key);
+                        slot->hash = hash;
+                        slot->record = result;
+                        pool->records[pool->count] = result;
+                        pool->count++;
+                }
+        }
+#if !defined (MSDOS) && !defined (_WIN32)
+        pthread_mutex_unlock (&pool->lock);
+#endif
+        return (result);
+}
+
+
+/*!
+ * \brief Get the record with id \c id from \c pool.
+ *
+ * \return the record, or \c NULL when the pool has no such record.
+ */
+DxfGraphicProperties *
+dxf_graphic_properties_pool_get
+(
+        DxfGraphicPropertiesPool *pool,
+                /*!< the pool. */
+        int id
+                /*!< the id of the record. */
+)
+{
+        DxfGraphicProperties *result = NULL;
+
+        if ((pool == NULL) || (id < 0))
+        {
+                return (NULL);
+        }
+#if !defined (MSDOS) && !defined (_WIN32)
+        pthread_mutex_lock (&pool->lock);
+#endif
+        if ((size_t) id < pool->count)
+        {
+                result = pool->records[id];
+        }
+#if !defined (MSDOS) && !defined (_WIN32)
+        pthread_mutex_unlock (&pool->lock);
+#endif
+        return (result);
+}
+
+
+/*!
+ * \brief Get the number of records in \c pool.
+ *
+ * \return the number of records.
+ */
+size_t
+dxf_graphic_properties_pool_count
+(
+        DxfGraphicPropertiesPool *pool
+                /*!< the pool. */
+)
+{
+        size_t count;
+
+        if (pool == NULL)
+        {
+                return (0);
+        }
+#if !defined (MSDOS) && !defined (_WIN32)
+        pthread_mutex_lock (&pool->lock);
+#endif
+        count = pool->count;
+#if !defined (MSDOS) && !defined (_WIN32)
+        pthread_mutex_unlock (&pool->lock);
+#endif
+        return (count);
+}
+
+
+/*!
+ * \brief Free the allocated memory for a \c DxfGraphicPropertiesPool
+ * and all the records in it.
+ *
+ * The strings of the records belong to the string pool, which has to
+ * be freed separately.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_graphic_properties_pool_free
+(
+        DxfGraphicPropertiesPool *pool
+                /*!< the pool. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        size_t i;
+
+        /* Do some basic checks. */
+        if (pool == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        for (i = 0; i < pool->count; i++)
+        {
+                free (pool->records[i]);
+        }
+        free (pool->records);
+        free (pool->slots);
+#if !defined (MSDOS) && !defined (_WIN32)
+        pthread_mutex_destroy (&pool->lock);
+#endif
+        free (pool);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/* EOF */
@@ -0,0 +1,258 @@
+/*!
+ * \file graphic_properties.h
+ *
+ * \author Copyright (C) 2017 by the libDXF developers.
+ *
+ * \brief Shared graphic properties of entities, header file.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+
+
+
+#ifndef LIBDXF_SRC_GRAPHIC_PROPERTIES_H
+#define LIBDXF_SRC_GRAPHIC_PROPERTIES_H
+
+
+#include "global.h"
+#include "string_pool.h"
+
+#if !defined (MSDOS) && !defined (_WIN32)
+#include <pthread.h>
+#endif
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define DXF_GRAPHIC_PROPERTIES_MIN_CAPACITY 64
+        /*!< \brief Smallest number of slots in a
+         * DxfGraphicPropertiesPool. */
+
+
+/*!
+ * \brief The graphic properties an entity has in common with most other
+ * entities.
+ *
+ * Entities which have the same properties point to the same record.
+ * A shared record must not be changed, an entity gets a private copy
+ * with dxf_graphic_properties_unshare () before one of its properties
+ * is set.
+ */
+typedef struct
+dxf_graphic_properties_struct
+{
+        char *linetype;
+                /*!< The linetype of the entity.\n
+                 * Defaults to \c BYLAYER if ommitted in the DXF file.\n
+                 * Group code = 6. */
+        char *layer;
+                /*!< Layer on which the entity is drawn.\n
+                 * Defaults to layer "0" if no valid layername is given.\n
+                 * Group code = 8. */
+        double elevation;
+                /*!< Elevation of the entity in the local Z-direction.\n
+                 * Group code = 38.\n
+                 * \deprecated As of version R11. */
+        double thickness;
+                /*!< Thickness of the entity in the local Z-direction.\n
+                 * Group code = 39. */
+        double linetype_scale;
+                /*!< Linetype scale (optional).\n
+                 * Group code = 48.\n
+                 * \since Introduced in version R13. */
+        int16_t visibility;
+                /*!< Object visibility (optional):\n
+                 * <ol>
+                 * <li value = "0"> Visible</li>
+                 * <li value = "1"> Invisible</li>
+                 * </ol>
+                 * Group code = 60.\n
+                 * \since Introduced in version R13. */
+        int color;
+                /*!< Color of the entity.\n
+                 * Defaults to \c BYLAYER if ommitted in the DXF file.\n
+                 * Group code = 62. */
+        int paperspace;
+                /*!< Entities are to be drawn on either \c PAPERSPACE or
+                 * \c MODELSPACE.\n
+                 * Group code = 67.\n
+                 * \since Introduced in version R13. */
+        int16_t shadow_mode;
+                /*!< Shadow mode.\n
+                 * Group code = 284.\n
+                 * \since Introduced in version R2009. */
+        char *material;
+                /*!< Hard-pointer ID/handle to material object (present if
+                 * not BYLAYER).\n
+                 * Group code = 347.\n
+                 * \since Introduced in version R2008. */
+        int16_t lineweight;
+                /*!< Lineweight enum value.\n
+                 * Group code = 370.\n
+                 * \since Introduced in version R2002. */
+        char *plot_style_name;
+                /*!< Hard pointer ID / handle of PlotStyleName object.\n
+                 * Group code = 390.\n
+                 * \since Introduced in version R2009. */
+        long color_value;
+                /*!< A 24-bit color value.\n
+                 * Group code = 420.\n
+                 * \since Introduced in version R2004. */
+        char *color_name;
+                /*!< Color name.\n
+                 * Group code = 430.\n
+                 * \since Introduced in version R2004. */
+        long transparency;
+                /*!< Transparency value.\n
+                 * Group code = 440.\n
+                 * \since Introduced in version R2004. */
+        int shared;
+                /*!< \c TRUE when the record is shared and must not be
+                 * changed or freed, \c FALSE when it belongs to a single
+                 * entity. */
+        int id;
+                /*!< Number of the record in its
+                 * DxfGraphicPropertiesPool, or -1 when it is in none. */
+} DxfGraphicProperties;
+
+
+/*!
+ * \brief One slot of a DxfGraphicPropertiesPool.
+ */
+typedef struct
+dxf_graphic_properties_slot_struct
+{
+        uint64_t hash;
+                /*!< Hash of \c record. */
+        DxfGraphicProperties *record;
+                /*!< The record, \c NULL in an empty slot. */
+} DxfGraphicPropertiesSlot;
+
+
+/*!
+ * \brief A pool of shared graphic property records.
+ *
+ * Every distinct set of properties is stored once, and numbered in
+ * the order the records were added, so two entities with records from
+ * the same pool have equal properties when their record pointers (or
+ * ids) are equal.  The strings of the records are taken from a string
+ * pool.\n
+ * The pool can be shared by threads.
+ */
+typedef struct
+dxf_graphic_properties_pool_struct
+{
+        DxfStringPool *strings;
+                /*!< Pool holding the strings of the records. */
+        DxfGraphicPropertiesSlot *slots;
+                /*!< Open addressing hash table, a power of two of
+                 * slots. */
+        size_t capacity;
+                /*!< Number of slots. */
+        DxfGraphicProperties **records;
+                /*!< The records by id. */
+        size_t count;
+                /*!< Number of records, at most half of \c capacity. */
+#if !defined (MSDOS) && !defined (_WIN32)
+        pthread_mutex_t lock;
+                /*!< Protects the pool. */
+#endif
+} DxfGraphicPropertiesPool;
+
+
+DxfGraphicProperties *
+dxf_graphic_properties_default ();
+DxfGraphicProperties *
+dxf_graphic_properties_unshare
+(
+        DxfGraphicProperties **properties
+);
+DxfGraphicProperties *
+dxf_graphic_properties_copy
+(
+        DxfGraphicProperties *properties
+);
+int
+dxf_graphic_properties_free
+(
+        DxfGraphicProperties *properties
+);
+void
+dxf_graphic_properties_start
+(
+        DxfGraphicProperties *read,
+        DxfGraphicProperties *properties
+);
+int
+dxf_graphic_properties_finish
+(
+        DxfFile *fp,
+        DxfGraphicProperties **properties,
+        DxfGraphicProperties *read
+);
+DxfGraphicPropertiesPool *
+dxf_graphic_properties_pool_new
+(
+        DxfStringPool *strings
+);
+DxfGraphicProperties *
+dxf_graphic_properties_pool_intern
+(
+        DxfGraphicPropertiesPool *pool,
+        DxfGraphicProperties *properties
+);
+DxfGraphicProperties *
+dxf_graphic_properties_pool_get
+(
+        DxfGraphicPropertiesPool *pool,
+        int id
+);
+size_t
+dxf_graphic_properties_pool_count
+(
+        DxfGraphicPropertiesPool *pool
+);
+int
+dxf_graphic_properties_pool_free
+(
+        DxfGraphicPropertiesPool *pool
+);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* LIBDXF_SRC_GRAPHIC_PROPERTIES_H */
+
+
+/* EOF */
@@ -35,6 +35,8 @@
 
 
 #include "group.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -159,7 +161,8 @@ dxf_group_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfPair pair;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -167,8 +170,6 @@ dxf_group_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (fp->acad_version_number < AutoCAD_13)
@@ -185,98 +186,81 @@ dxf_group_read
                 group = dxf_group_new ();
                 group = dxf_group_init (group);
         }
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        /* Clean up. */
-                        free (temp_string);
-                        fclose (fp->fp);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "5") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &group->id_code);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else if (strcmp (temp_string, "70") == 0)
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing the
-                         * unnamed flag value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &group->unnamed_flag);
-                }
-                else if (strcmp (temp_string, "71") == 0)
-                {
-                        /* Now follows a string containing the
-                         * selectability flag value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &group->selectability_flag);
-                }
-                else if ((fp->acad_version_number >= AutoCAD_13)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "AcDbGroup") != 0)
-                        {
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                group->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 70:
+                                /* Now follows a string containing the
+                                 * unnamed flag value. */
+                                group->unnamed_flag = dxf_pair_get_int (&pair);
+                                break;
+                        case 71:
+                                /* Now follows a string containing the
+                                 * selectability flag value. */
+                                group->selectability_flag = dxf_pair_get_int (&pair);
+                                break;
+                        case 100:
+                                if (fp->acad_version_number >= AutoCAD_13)
+                                {
+                                        /* Now follows a string containing the
+                                         * subclass marker value. */
+                                        dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                        if (strcmp (temp_string, "AcDbGroup") != 0)
+                                        {
+                                                fprintf (stderr,
+                                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                                  __FUNCTION__, fp->filename, fp->line_number);
+                                        }
+                                }
+                                break;
+                        case 300:
+                                /* Now follows a string containing a description. */
+                                free (group->description);
+                                group->description = dxf_pair_get_string (&pair);
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner dictionary. */
+                                free (group->dictionary_owner_soft);
+                                group->dictionary_owner_soft = dxf_pair_get_string (&pair);
+                                break;
+                        case 340:
+                                /* Now follows a string containing a handle to an
+                                 * entry in group object. */
+                                free (group->handle_entity_in_group);
+                                group->handle_entity_in_group = dxf_pair_get_string (&pair);
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                free (group->dictionary_owner_hard);
+                                group->dictionary_owner_hard = dxf_pair_get_string (&pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, (_("DXF comment: %s\n")), temp_string);
+                                break;
+                        default:
                                 fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
                                   __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "300") == 0)
-                {
-                        /* Now follows a string containing a description. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", group->description);
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", group->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "340") == 0)
-                {
-                        /* Now follows a string containing a handle to an
-                         * entry in group object. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", group->handle_entity_in_group);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", group->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, (_("DXF comment: %s\n")), temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
-        /* Clean up. */
-        free (temp_string);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -332,7 +316,7 @@ dxf_group_write
         if (strcmp (group->description, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Error in %s () empty description string for the %s entity with id-code: %x\n")),
+                  (_("Error in %s () empty description string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, group->id_code);
                 /* Clean up. */
                 free (dxf_entity_name);
@@ -341,7 +325,7 @@ dxf_group_write
         if (strcmp (group->handle_entity_in_group, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Error in %s () empty string for handle entity in group for the %s entity with id-code: %x\n")),
+                  (_("Error in %s () empty string for handle entity in group for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, group->id_code);
                 /* Clean up. */
                 free (dxf_entity_name);
@@ -350,14 +334,14 @@ dxf_group_write
         if (fp->acad_version_number < AutoCAD_13)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () illegal DXF version for this %s entity with id-code: %x.\n")),
+                  (_("Warning in %s () illegal DXF version for this %s entity with id-code: %lx.\n")),
                   __FUNCTION__, dxf_entity_name, group->id_code);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_string (fp, 0, dxf_entity_name);
         if (group->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", group->id_code);
+                dxf_write_hex (fp, 5, group->id_code);
         }
         /*!
          * \todo for version R14.\n
@@ -372,25 +356,25 @@ dxf_group_write
         if ((strcmp (group->dictionary_owner_soft, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", group->dictionary_owner_soft);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, group->dictionary_owner_soft);
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (group->dictionary_owner_hard, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", group->dictionary_owner_hard);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, group->dictionary_owner_hard);
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbGroup\n");
+                dxf_write_string (fp, 100, "AcDbGroup");
         }
-        fprintf (fp->fp, "300\n%s\n", group->description);
-        fprintf (fp->fp, " 70\n%d\n", group->unnamed_flag);
-        fprintf (fp->fp, " 71\n%d\n", group->selectability_flag);
-        fprintf (fp->fp, "340\n%s\n", group->handle_entity_in_group);
+        dxf_write_string (fp, 300, group->description);
+        dxf_write_int (fp, 70, group->unnamed_flag);
+        dxf_write_int (fp, 71, group->selectability_flag);
+        dxf_write_string (fp, 340, group->handle_entity_in_group);
         /* Clean up. */
         free (dxf_entity_name);
 #if DEBUG
@@ -462,7 +446,7 @@ dxf_group_free_chain
                 /*!< pointer to the chain of DXF \c GROUP objects. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (groups == NULL)
@@ -494,7 +478,7 @@ dxf_group_free_chain
  * \version According to DXF R13.
  * \version According to DXF R14.
  */
-int
+long
 dxf_group_get_id_code
 (
         DxfGroup *group
@@ -543,7 +527,7 @@ dxf_group_set_id_code
 (
         DxfGroup *group,
                 /*!< a pointer to a DXF \c GROUP object. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
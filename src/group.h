@@ -59,7 +59,7 @@ typedef struct
 dxf_group
 {
         /* Members common for all DXF group objects. */
-        int id_code;
+        long id_code;
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file.\n
@@ -127,7 +127,7 @@ dxf_group_free_chain
 (
         DxfGroup *groups
 );
-int
+long
 dxf_group_get_id_code
 (
         DxfGroup *group
@@ -136,7 +136,7 @@ DxfGroup *
 dxf_group_set_id_code
 (
         DxfGroup *group,
-        int id_code
+        long id_code
 );
 char *
 dxf_group_get_dictionary_owner_soft
@@ -0,0 +1,349 @@
+/*!
+ * \file handle_table.c
+ *
+ * \author Copyright (C) 2017 by the libDXF developers.
+ *
+ * \brief Hash table of the handles in a drawing.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+
+
+#include "handle_table.h"
+
+
+/*!
+ * \brief Slot to start probing for \c handle in a table of \c capacity
+ * slots.
+ *
+ * Handles are mostly consecutive numbers, multiplying spreads them over
+ * the table.
+ */
+static size_t
+dxf_handle_table_slot
+(
+        uint64_t handle,
+                /*!< the handle. */
+        size_t capacity
+                /*!< number of slots, a power of two. */
+)
+{
+        uint64_t hash;
+
+        hash = handle * UINT64_C (0x9E3779B97F4A7C15);
+        return ((size_t) (hash ^ (hash >> 32)) & (capacity - 1));
+}
+
+
+/*!
+ * \brief Store \c entry in the first free slot from its own slot on.
+ *
+ * The table has a free slot and does not hold the handle yet.
+ */
+static void
+dxf_handle_table_place
+(
+        DxfHandleEntry *entries,
+                /*!< the slots. */
+        size_t capacity,
+                /*!< number of slots. */
+        const DxfHandleEntry *entry
+                /*!< the record to store. */
+)
+{
+        size_t i;
+
+        i = dxf_handle_table_slot (entry->handle, capacity);
+        while (entries[i].handle != 0)
+        {
+                i = (i + 1) & (capacity - 1);
+        }
+        entries[i] = *entry;
+}
+
+
+/*!
+ * \brief Double the number of slots of \c table.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when no memory
+ * could be allocated.
+ */
+static int
+dxf_handle_table_grow
+(
+        DxfHandleTable *table
+                /*!< the table. */
+)
+{
+        DxfHandleEntry *entries;
+        size_t capacity;
+        size_t i;
+
+        capacity = table->capacity * 2;
+        entries = calloc (capacity, sizeof (DxfHandleEntry));
+        if (entries == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        for (i = 0; i < table->capacity; i++)
+        {
+                if (table->entries[i].handle != 0)
+                {
+                        dxf_handle_table_place (entries, capacity,
+                          &table->entries[i]);
+                }
+        }
+        free (table->entries);
+        table->entries = entries;
+        table->capacity = capacity;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Convert a handle as written in a DXF file (a hexadecimal
+ * string) to its value.
+ *
+ * \return the value, or 0 when \c handle is \c NULL, empty or not a
+ * hexadecimal number.
+ */
+uint64_t
+dxf_handle_parse
+(
+        const char *handle
+                /*!< the handle. */
+)
+{
+        uint64_t value = 0;
+        int digit;
+
+        if ((handle == NULL) || (*handle == '\0'))
+        {
+                return (0);
+        }
+        for (; *handle != '\0'; handle++)
+        {
+                if ((*handle >= '0') && (*handle <= '9'))
+                {
+                        digit = *handle - '0';
+                }
+                else if ((*handle >= 'A') && (*handle <= 'F'))
+                {
+                        digit = *handle - 'A' + 10;
+                }
+                else if ((*handle >= 'a') && (*handle <= 'f'))
+                {
+                        digit = *handle - 'a' + 10;
+                }
+                else
+                {
+                        return (0);
+                }
+                value = (value << 4) | (uint64_t) digit;
+        }
+        return (value);
+}
+
+
+/*!
+ * \brief Allocate an empty \c DxfHandleTable with room for \c count
+ * handles.
+ *
+ * The table grows when more handles are inserted.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when succesful.
+ */
+DxfHandleTable *
+dxf_handle_table_new
+(
+        size_t count
+                /*!< expected number of handles. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfHandleTable *table = NULL;
+        size_t capacity = DXF_HANDLE_TABLE_MIN_CAPACITY;
+
+        /* Keep at least half of the slots free. */
+        while (capacity < 2 * count)
+        {
+                capacity *= 2;
+        }
+        if ((table = malloc (sizeof (DxfHandleTable))) == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory for a DxfHandleTable struct.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        table->entries = calloc (capacity, sizeof (DxfHandleEntry));
+        if (table->entries == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                free (table);
+                return (NULL);
+        }
+        table->capacity = capacity;
+        table->count = 0;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (table);
+}
+
+
+/*!
+ * \brief Add the record \c object carrying \c handle to \c table.
+ *
+ * A handle is unique within a drawing, when it turns up again the first
+ * record keeps it.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when the handle
+ * is 0 or in the table already, or when an error occurred.
+ */
+int
+dxf_handle_table_insert
+(
+        DxfHandleTable *table,
+                /*!< the table. */
+        uint64_t handle,
+                /*!< the handle of the record. */
+        DxfHandleKind kind,
+                /*!< kind of the record. */
+        DxfEntityType type,
+                /*!< type of an entity. */
+        void *object
+                /*!< the record. */
+)
+{
+        DxfHandleEntry entry;
+
+        /* Do some basic checks. */
+        if ((table == NULL) || (object == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if ((handle == 0) || (dxf_handle_table_lookup (table, handle) != NULL))
+        {
+                return (EXIT_FAILURE);
+        }
+        if ((2 * (table->count + 1) > table->capacity)
+          && (dxf_handle_table_grow (table) == EXIT_FAILURE))
+        {
+                return (EXIT_FAILURE);
+        }
+        entry.handle = handle;
+        entry.kind = kind;
+        entry.type = type;
+        entry.object = object;
+        dxf_handle_table_place (table->entries, table->capacity, &entry);
+        table->count++;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Find the record carrying \c handle in \c table.
+ *
+ * \return the record, or \c NULL when the handle is not in the table.
+ */
+DxfHandleEntry *
+dxf_handle_table_lookup
+(
+        DxfHandleTable *table,
+                /*!< the table. */
+        uint64_t handle
+                /*!< the handle. */
+)
+{
+        size_t i;
+
+        if ((table == NULL) || (handle == 0))
+        {
+                return (NULL);
+        }
+        i = dxf_handle_table_slot (handle, table->capacity);
+        while (table->entries[i].handle != 0)
+        {
+                if (table->entries[i].handle == handle)
+                {
+                        return (&table->entries[i]);
+                }
+                i = (i + 1) & (table->capacity - 1);
+        }
+        return (NULL);
+}
+
+
+/*!
+ * \brief Free the allocated memory for a \c DxfHandleTable.
+ *
+ * The records in the table are not freed.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_handle_table_free
+(
+        DxfHandleTable *table
+                /*!< the table. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (table == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        free (table->entries);
+        free (table);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/* EOF */
@@ -0,0 +1,162 @@
+/*!
+ * \file handle_table.h
+ *
+ * \author Copyright (C) 2017 by the libDXF developers.
+ *
+ * \brief Hash table of the handles in a drawing, header file.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+
+
+#ifndef LIBDXF_SRC_HANDLE_TABLE_H
+#define LIBDXF_SRC_HANDLE_TABLE_H
+
+
+#include "global.h"
+#include "entity.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define DXF_HANDLE_TABLE_MIN_CAPACITY 64
+        /*!< \brief Smallest number of slots in a DxfHandleTable. */
+
+
+/*!
+ * \brief Kinds of records found in a DxfHandleTable.
+ */
+typedef enum
+dxf_handle_kind
+{
+        DXF_HANDLE_KIND_ENTITY,
+                /*!< An entity, \c object points to the struct for
+                 * \c type. */
+        DXF_HANDLE_KIND_BLOCK,
+                /*!< A DxfBlock. */
+        DXF_HANDLE_KIND_OBJECT,
+                /*!< A DxfObject of the \c OBJECTS section. */
+        DXF_HANDLE_KIND_APPID,
+                /*!< A DxfAppid of the \c APPID table. */
+        DXF_HANDLE_KIND_BLOCK_RECORD,
+                /*!< A DxfBlockRecord of the \c BLOCK_RECORD table. */
+        DXF_HANDLE_KIND_DIMSTYLE,
+                /*!< A DxfDimStyle of the \c DIMSTYLE table. */
+        DXF_HANDLE_KIND_LAYER,
+                /*!< A DxfLayer of the \c LAYER table. */
+        DXF_HANDLE_KIND_LTYPE,
+                /*!< A DxfLType of the \c LTYPE table. */
+        DXF_HANDLE_KIND_STYLE,
+                /*!< A DxfStyle of the \c STYLE table. */
+        DXF_HANDLE_KIND_UCS,
+                /*!< A DxfUcs of the \c UCS table. */
+        DXF_HANDLE_KIND_VIEW,
+                /*!< A DxfView of the \c VIEW table. */
+        DXF_HANDLE_KIND_VPORT
+                /*!< A DxfVPort of the \c VPORT table. */
+} DxfHandleKind;
+
+
+/*!
+ * \brief One record in a DxfHandleTable.
+ */
+typedef struct
+dxf_handle_entry_struct
+{
+        uint64_t handle;
+                /*!< Handle of the record, 0 in an empty slot. */
+        DxfHandleKind kind;
+                /*!< Kind of the record. */
+        DxfEntityType type;
+                /*!< Type of an entity. */
+        void *object;
+                /*!< The record. */
+} DxfHandleEntry;
+
+
+/*!
+ * \brief Open addressing hash table from handles to the records
+ * carrying them.
+ */
+typedef struct
+dxf_handle_table_struct
+{
+        DxfHandleEntry *entries;
+                /*!< Slots, a power of two of them. */
+        size_t capacity;
+                /*!< Number of slots. */
+        size_t count;
+                /*!< Number of slots in use, at most half of
+                 * \c capacity. */
+} DxfHandleTable;
+
+
+uint64_t
+dxf_handle_parse
+(
+        const char *handle
+);
+DxfHandleTable *
+dxf_handle_table_new
+(
+        size_t count
+);
+int
+dxf_handle_table_insert
+(
+        DxfHandleTable *table,
+        uint64_t handle,
+        DxfHandleKind kind,
+        DxfEntityType type,
+        void *object
+);
+DxfHandleEntry *
+dxf_handle_table_lookup
+(
+        DxfHandleTable *table,
+        uint64_t handle
+);
+int
+dxf_handle_table_free
+(
+        DxfHandleTable *table
+);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* LIBDXF_SRC_HANDLE_TABLE_H */
+
+
+/* EOF */
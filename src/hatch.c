@@ -37,6 +37,8 @@
 
 
 #include "hatch.h"
+#include "arena.h"
+#include "writer.h"
 
 
 /* dxf_hatch functions. */
@@ -109,22 +111,16 @@ dxf_hatch_init
                 return (NULL);
         }
         hatch->id_code = 0;
-        hatch->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        hatch->layer = strdup (DXF_DEFAULT_LAYER);
+        hatch->properties = dxf_graphic_properties_default ();
         hatch->x0 = 0.0;
         hatch->y0 = 0.0;
         hatch->z0 = 0.0;
         hatch->extr_x0 = 0.0;
         hatch->extr_y0 = 0.0;
         hatch->extr_z0 = 0.0;
-        hatch->thickness = 0.0;
         hatch->pattern_scale = 1.0;
         hatch->pixel_size = 1.0;
         hatch->pattern_angle = 0.0;
-        hatch->linetype_scale = DXF_DEFAULT_LINETYPE_SCALE;
-        hatch->visibility = DXF_DEFAULT_VISIBILITY;
-        hatch->color = DXF_COLOR_BYLAYER;
-        hatch->paperspace = DXF_MODELSPACE;
         hatch->solid_fill = 0;
         hatch->associative = 1;
         hatch->hatch_style = 0;
@@ -197,31 +193,31 @@ dxf_hatch_write
                 free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
-        if (strcmp (hatch->layer, "") == 0)
+        if (strcmp (hatch->properties->layer, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning: empty layer string for the %s entity with id-code: %x\n")),
+                  (_("Warning: empty layer string for the %s entity with id-code: %lx\n")),
                         dxf_entity_name, hatch->id_code);
                 fprintf (stderr,
                   (_("    %s entity is relocated to layer 0")),
                         dxf_entity_name);
-                hatch->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_hatch_set_layer (hatch, DXF_DEFAULT_LAYER);
         }
-        if (strcmp (hatch->linetype, "") == 0)
+        if (strcmp (hatch->properties->linetype, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning: empty linetype string for the %s entity with id-code: %x\n")),
+                  (_("Warning: empty linetype string for the %s entity with id-code: %lx\n")),
                         dxf_entity_name, hatch->id_code);
                 fprintf (stderr,
                   (_("    %s entity is reset to default linetype")),
                         dxf_entity_name);
-                hatch->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_hatch_set_linetype (hatch, DXF_DEFAULT_LINETYPE);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_string (fp, 0, dxf_entity_name);
         if (hatch->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", hatch->id_code);
+                dxf_write_hex (fp, 5, hatch->id_code);
         }
         /*!
          * \todo for version R14.\n
@@ -236,91 +232,91 @@ dxf_hatch_write
         if ((strcmp (hatch->dictionary_owner_soft, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", hatch->dictionary_owner_soft);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, hatch->dictionary_owner_soft);
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (hatch->dictionary_owner_hard, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", hatch->dictionary_owner_hard);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, hatch->dictionary_owner_hard);
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbEntity\n");
+                dxf_write_string (fp, 100, "AcDbEntity");
         }
-        if (hatch->paperspace == DXF_PAPERSPACE)
+        if (hatch->properties->paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp->fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_int (fp, 67, DXF_PAPERSPACE);
         }
-        fprintf (fp->fp, "  8\n%s\n", hatch->layer);
-        if (strcmp (hatch->linetype, DXF_DEFAULT_LINETYPE) != 0)
+        dxf_write_string (fp, 8, hatch->properties->layer);
+        if (strcmp (hatch->properties->linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp->fp, "  6\n%s\n", hatch->linetype);
+                dxf_write_string (fp, 6, hatch->properties->linetype);
         }
         if ((fp->acad_version_number <= AutoCAD_11)
           && DXF_FLATLAND
-          && (hatch->elevation != 0.0))
+          && (hatch->properties->elevation != 0.0))
         {
-                fprintf (fp->fp, " 38\n%f\n", hatch->elevation);
+                dxf_write_double (fp, 38, hatch->properties->elevation);
         }
-        if (hatch->thickness != 0.0)
+        if (hatch->properties->thickness != 0.0)
         {
-                fprintf (fp->fp, " 39\n%f\n", hatch->thickness);
+                dxf_write_double (fp, 39, hatch->properties->thickness);
         }
-        if (hatch->color != DXF_COLOR_BYLAYER)
+        if (hatch->properties->color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp->fp, " 62\n%d\n", hatch->color);
+                dxf_write_int (fp, 62, hatch->properties->color);
         }
-        if (hatch->linetype_scale != 1.0)
+        if (hatch->properties->linetype_scale != 1.0)
         {
-                fprintf (fp->fp, " 48\n%f\n", hatch->linetype_scale);
+                dxf_write_double (fp, 48, hatch->properties->linetype_scale);
         }
-        if (hatch->visibility != 0)
+        if (hatch->properties->visibility != 0)
         {
-                fprintf (fp->fp, " 60\n%d\n", hatch->visibility);
+                dxf_write_int (fp, 60, hatch->properties->visibility);
         }
         if (hatch->graphics_data_size > 0)
         {
-                fprintf (fp->fp, " 92\n%d\n", hatch->graphics_data_size);
+                dxf_write_int (fp, 92, hatch->graphics_data_size);
         }
         data = (DxfBinaryGraphicsData *) hatch->binary_graphics_data;
         while (data != NULL)
         {
-                fprintf (fp->fp, "310\n%s\n", data->data_line);
+                dxf_write_string (fp, 310, data->data_line);
                 data = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_get_next (data);
         }
-        fprintf (fp->fp, "100\nAcDbHatch\n");
-        fprintf (fp->fp, " 10\n%f\n", hatch->x0);
-        fprintf (fp->fp, " 20\n%f\n", hatch->y0);
-        fprintf (fp->fp, " 30\n%f\n", hatch->z0);
-        fprintf (fp->fp, "210\n%f\n", hatch->extr_x0);
-        fprintf (fp->fp, "220\n%f\n", hatch->extr_y0);
-        fprintf (fp->fp, "230\n%f\n", hatch->extr_z0);
-        fprintf (fp->fp, "  2\n%s\n", hatch->pattern_name);
-        fprintf (fp->fp, " 70\n%d\n", hatch->solid_fill);
-        fprintf (fp->fp, " 71\n%d\n", hatch->associative);
-        fprintf (fp->fp, " 91\n%d\n", hatch->number_of_boundary_paths);
+        dxf_write_string (fp, 100, "AcDbHatch");
+        dxf_write_double (fp, 10, hatch->x0);
+        dxf_write_double (fp, 20, hatch->y0);
+        dxf_write_double (fp, 30, hatch->z0);
+        dxf_write_double (fp, 210, hatch->extr_x0);
+        dxf_write_double (fp, 220, hatch->extr_y0);
+        dxf_write_double (fp, 230, hatch->extr_z0);
+        dxf_write_string (fp, 2, hatch->pattern_name);
+        dxf_write_int (fp, 70, hatch->solid_fill);
+        dxf_write_int (fp, 71, hatch->associative);
+        dxf_write_int (fp, 91, hatch->number_of_boundary_paths);
         dxf_hatch_boundary_path_write (fp, (DxfHatchBoundaryPath *) hatch->paths);
-        fprintf (fp->fp, " 75\n%d\n", hatch->hatch_style);
-        fprintf (fp->fp, " 76\n%d\n", hatch->hatch_pattern_type);
+        dxf_write_int (fp, 75, hatch->hatch_style);
+        dxf_write_int (fp, 76, hatch->hatch_pattern_type);
         if (!hatch->solid_fill)
         {
-                fprintf (fp->fp, " 52\n%f\n", hatch->pattern_angle);
-                fprintf (fp->fp, " 41\n%f\n", hatch->pattern_scale);
-                fprintf (fp->fp, " 77\n%d\n", hatch->pattern_double);
+                dxf_write_double (fp, 52, hatch->pattern_angle);
+                dxf_write_double (fp, 41, hatch->pattern_scale);
+                dxf_write_int (fp, 77, hatch->pattern_double);
         }
-        fprintf (fp->fp, " 78\n%d\n", hatch->number_of_pattern_def_lines);
+        dxf_write_int (fp, 78, hatch->number_of_pattern_def_lines);
         line = (DxfHatchPatternDefLine *) hatch->def_lines;
         while (line != NULL)
         {
                 dxf_hatch_pattern_def_line_write (fp, (DxfHatchPatternDefLine *) line);
                 line = (DxfHatchPatternDefLine *) line->next;
         }
-        fprintf (fp->fp, " 47\n%f\n", hatch->pixel_size);
-        fprintf (fp->fp, " 98\n%d\n", hatch->number_of_seed_points);
+        dxf_write_double (fp, 47, hatch->pixel_size);
+        dxf_write_int (fp, 98, hatch->number_of_seed_points);
         point = (DxfHatchPatternSeedPoint *) hatch->seed_points;
         while (point != NULL)
         {
@@ -372,8 +368,7 @@ dxf_hatch_free
                 return (EXIT_FAILURE);
         }
         free (hatch->pattern_name);
-        free (hatch->linetype);
-        free (hatch->layer);
+        dxf_graphic_properties_free (hatch->properties);
         free (hatch->def_lines);
         free (hatch->paths);
         free (hatch->seed_points);
@@ -401,7 +396,7 @@ dxf_hatch_free_chain
                 /*!< pointer to the chain of DXF \c HATCH entities. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -428,7 +423,7 @@ dxf_hatch_free_chain
  *
  * \return ID code.
  */
-int
+long
 dxf_hatch_get_id_code
 (
         DxfHatch *hatch
@@ -471,7 +466,7 @@ dxf_hatch_set_id_code
 (
         DxfHatch *hatch,
                 /*!< a pointer to a DXF \c HATCH pattern. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -528,14 +523,14 @@ dxf_hatch_get_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        if (hatch->linetype ==  NULL)
+        if (hatch->properties->linetype ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the linetype member.\n")),
                   __FUNCTION__);
                 return (NULL);
         }
-        result = strdup (hatch->linetype);
+        result = strdup (hatch->properties->linetype);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -573,7 +568,12 @@ dxf_hatch_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        hatch->linetype = strdup (linetype);
+        if (dxf_graphic_properties_unshare (&hatch->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (hatch->properties->linetype);
+        hatch->properties->linetype = strdup (linetype);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -606,14 +606,14 @@ dxf_hatch_get_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        if (hatch->layer ==  NULL)
+        if (hatch->properties->layer ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the layer member.\n")),
                   __FUNCTION__);
                 return (NULL);
         }
-        result = strdup (hatch->layer);
+        result = strdup (hatch->properties->layer);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -651,7 +651,12 @@ dxf_hatch_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        hatch->layer = strdup (layer);
+        if (dxf_graphic_properties_unshare (&hatch->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (hatch->properties->layer);
+        hatch->properties->layer = strdup (layer);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -684,7 +689,7 @@ dxf_hatch_get_elevation
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        result = hatch->elevation;
+        result = hatch->properties->elevation;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -715,7 +720,11 @@ dxf_hatch_set_elevation
                   __FUNCTION__);
                 return (NULL);
         }
-        hatch->elevation = elevation;
+        if (dxf_graphic_properties_unshare (&hatch->properties) == NULL)
+        {
+                return (NULL);
+        }
+        hatch->properties->elevation = elevation;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -748,13 +757,13 @@ dxf_hatch_get_thickness
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (hatch->thickness < 0.0)
+        if (hatch->properties->thickness < 0.0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found in the thickness member.\n")),
                   __FUNCTION__);
         }
-        result = hatch->thickness;
+        result = hatch->properties->thickness;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -791,7 +800,11 @@ dxf_hatch_set_thickness
                   (_("Warning in %s () a negative thickness value was passed.\n")),
                   __FUNCTION__);
         }
-        hatch->thickness = thickness;
+        if (dxf_graphic_properties_unshare (&hatch->properties) == NULL)
+        {
+                return (NULL);
+        }
+        hatch->properties->thickness = thickness;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -824,14 +837,14 @@ dxf_hatch_get_linetype_scale
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (hatch->linetype_scale < 0.0)
+        if (hatch->properties->linetype_scale < 0.0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found in the linetype scale member.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        result = hatch->linetype_scale;
+        result = hatch->properties->linetype_scale;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -869,7 +882,11 @@ dxf_hatch_set_linetype_scale
                   __FUNCTION__);
                 return (NULL);
         }
-        hatch->linetype_scale = linetype_scale;
+        if (dxf_graphic_properties_unshare (&hatch->properties) == NULL)
+        {
+                return (NULL);
+        }
+        hatch->properties->linetype_scale = linetype_scale;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -902,21 +919,21 @@ dxf_hatch_get_visibility
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (hatch->visibility < 0)
+        if (hatch->properties->visibility < 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found in the visibility member.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (hatch->visibility > 1)
+        if (hatch->properties->visibility > 1)
         {
                 fprintf (stderr,
                   (_("Error in %s () an out of range value was found in the visibility member.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        result = hatch->visibility;
+        result = hatch->properties->visibility;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -961,7 +978,11 @@ dxf_hatch_set_visibility
                   __FUNCTION__);
                 return (NULL);
         }
-        hatch->visibility = visibility;
+        if (dxf_graphic_properties_unshare (&hatch->properties) == NULL)
+        {
+                return (NULL);
+        }
+        hatch->properties->visibility = visibility;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -994,13 +1015,13 @@ dxf_hatch_get_color
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (hatch->color < 0)
+        if (hatch->properties->color < 0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found in the color member.\n")),
                   __FUNCTION__);
         }
-        result = hatch->color;
+        result = hatch->properties->color;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1039,7 +1060,11 @@ dxf_hatch_set_color
                 fprintf (stderr,
                   (_("\teffectively turning this entity it's visibility off.\n")));
         }
-        hatch->color = color;
+        if (dxf_graphic_properties_unshare (&hatch->properties) == NULL)
+        {
+                return (NULL);
+        }
+        hatch->properties->color = color;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1072,19 +1097,19 @@ dxf_hatch_get_paperspace
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (hatch->paperspace < 0)
+        if (hatch->properties->paperspace < 0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found in the paperspace member.\n")),
                   __FUNCTION__);
         }
-        if (hatch->paperspace > 1)
+        if (hatch->properties->paperspace > 1)
         {
                 fprintf (stderr,
                   (_("Warning in %s () an out of range value was found in the paperspace member.\n")),
                   __FUNCTION__);
         }
-        result = hatch->paperspace;
+        result = hatch->properties->paperspace;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1129,7 +1154,11 @@ dxf_hatch_set_paperspace
                   __FUNCTION__);
                 return (NULL);
         }
-        hatch->paperspace = paperspace;
+        if (dxf_graphic_properties_unshare (&hatch->properties) == NULL)
+        {
+                return (NULL);
+        }
+        hatch->properties->paperspace = paperspace;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2971,7 +3000,7 @@ dxf_hatch_pattern_free_chain
                 /*!< pointer to the chain of DXF \c HATCH patterns. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2998,7 +3027,7 @@ dxf_hatch_pattern_free_chain
  *
  * \return ID code.
  */
-int
+long
 dxf_hatch_pattern_get_id_code
 (
         DxfHatchPattern *pattern
@@ -3041,7 +3070,7 @@ dxf_hatch_pattern_set_id_code
 (
         DxfHatchPattern *pattern,
                 /*!< a pointer to a DXF \c HATCH pattern. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -3593,7 +3622,7 @@ dxf_hatch_pattern_def_line_dash_free_chain
                  * definition line dashes. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3885,12 +3914,12 @@ dxf_hatch_pattern_def_line_write
                 return (EXIT_FAILURE);
         }
         /* Start writing output. */
-        fprintf (fp->fp, " 53\n%f\n", line->angle);
-        fprintf (fp->fp, " 43\n%f\n", line->x0);
-        fprintf (fp->fp, " 44\n%f\n", line->y0);
-        fprintf (fp->fp, " 45\n%f\n", line->x1);
-        fprintf (fp->fp, " 46\n%f\n", line->y1);
-        fprintf (fp->fp, " 79\n%d\n", line->number_of_dash_items);
+        dxf_write_double (fp, 53, line->angle);
+        dxf_write_double (fp, 43, line->x0);
+        dxf_write_double (fp, 44, line->y0);
+        dxf_write_double (fp, 45, line->x1);
+        dxf_write_double (fp, 46, line->y1);
+        dxf_write_int (fp, 79, line->number_of_dash_items);
         if (line->number_of_dash_items > 0)
         {
                 /* Draw hatch pattern definition line dash items. */
@@ -3906,7 +3935,7 @@ dxf_hatch_pattern_def_line_write
                 }
                 while (dash != NULL)
                 {
-                        fprintf (fp->fp, " 49\n%f\n", dash->length);
+                        dxf_write_double (fp, 49, dash->length);
                         i++;
                         dash = dxf_hatch_pattern_def_line_dash_get_next (dash);
                 }
@@ -3985,7 +4014,7 @@ dxf_hatch_pattern_def_line_free_chain
                  * definition lines. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -4012,7 +4041,7 @@ dxf_hatch_pattern_def_line_free_chain
  *
  * \return ID code.
  */
-int
+long
 dxf_hatch_pattern_def_line_get_id_code
 (
         DxfHatchPatternDefLine *line
@@ -4055,7 +4084,7 @@ dxf_hatch_pattern_def_line_set_id_code
 (
         DxfHatchPatternDefLine *line,
                 /*!< a pointer to a DXF \c HATCH pattern def line. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -4766,8 +4795,8 @@ dxf_hatch_pattern_seedpoint_write
                 return (EXIT_FAILURE);
         }
         /* Start writing output. */
-        fprintf (fp->fp, " 10\n%f\n", seedpoint->x0);
-        fprintf (fp->fp, " 20\n%f\n", seedpoint->y0);
+        dxf_write_double (fp, 10, seedpoint->x0);
+        dxf_write_double (fp, 20, seedpoint->y0);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -4829,7 +4858,7 @@ dxf_hatch_pattern_seedpoint_free_chain
                  * points. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -4856,7 +4885,7 @@ dxf_hatch_pattern_seedpoint_free_chain
  *
  * \return ID code.
  */
-int
+long
 dxf_hatch_pattern_seedpoint_get_id_code
 (
         DxfHatchPatternSeedPoint *point
@@ -4899,7 +4928,7 @@ dxf_hatch_pattern_seedpoint_set_id_code
 (
         DxfHatchPatternSeedPoint *point,
                 /*!< a pointer to a DXF \c HATCH pattern seed point. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -5362,7 +5391,7 @@ dxf_hatch_boundary_path_free_chain
                 /*!< pointer to the chain of DXF \c HATCH boundary paths. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -5389,7 +5418,7 @@ dxf_hatch_boundary_path_free_chain
  *
  * \return ID code.
  */
-int
+long
 dxf_hatch_boundary_path_get_id_code
 (
         DxfHatchBoundaryPath *path
@@ -5432,7 +5461,7 @@ dxf_hatch_boundary_path_set_id_code
 (
         DxfHatchBoundaryPath *path,
                 /*!< a pointer to a DXF \c HATCH boundary path. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -5809,8 +5838,8 @@ dxf_hatch_boundary_path_polyline_write
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        fprintf (fp->fp, " 73\n%d\n", polyline->is_closed);
-        fprintf (fp->fp, " 93\n%d\n", polyline->number_of_vertices);
+        dxf_write_int (fp, 73, polyline->is_closed);
+        dxf_write_int (fp, 93, polyline->number_of_vertices);
         /* draw hatch boundary vertices. */
         iter = dxf_hatch_boundary_path_polyline_vertex_new ();
         iter = (DxfHatchBoundaryPathPolylineVertex *) polyline->vertices;
@@ -5898,7 +5927,7 @@ dxf_hatch_boundary_path_polyline_free_chain
                  * polylines. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -5925,7 +5954,7 @@ dxf_hatch_boundary_path_polyline_free_chain
  *
  * \return ID code.
  */
-int
+long
 dxf_hatch_boundary_path_polyline_get_id_code
 (
         DxfHatchBoundaryPathPolyline *polyline
@@ -5968,7 +5997,7 @@ dxf_hatch_boundary_path_polyline_set_id_code
 (
         DxfHatchBoundaryPathPolyline *polyline,
                 /*!< a pointer to a DXF \c HATCH boundary path polyline. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -6656,12 +6685,12 @@ dxf_hatch_boundary_path_polyline_vertex_write
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        fprintf (fp->fp, " 10\n%f\n", vertex->x0);
-        fprintf (fp->fp, " 20\n%f\n", vertex->y0);
-        fprintf (fp->fp, " 72\n%d\n", vertex->has_bulge);
+        dxf_write_double (fp, 10, vertex->x0);
+        dxf_write_double (fp, 20, vertex->y0);
+        dxf_write_int (fp, 72, vertex->has_bulge);
         if (vertex->has_bulge)
         {
-                fprintf (fp->fp, " 42\n%f\n", vertex->bulge);
+                dxf_write_double (fp, 42, vertex->bulge);
         }
 #if DEBUG
         DXF_DEBUG_END
@@ -6724,7 +6753,7 @@ dxf_hatch_boundary_path_polyline_vertex_free_chain
                  * polyline vertices. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -6752,7 +6781,7 @@ dxf_hatch_boundary_path_polyline_vertex_free_chain
  *
  * \return ID code.
  */
-int
+long
 dxf_hatch_boundary_path_polyline_vertex_get_id_code
 (
         DxfHatchBoundaryPathPolylineVertex *vertex
@@ -6798,7 +6827,7 @@ dxf_hatch_boundary_path_polyline_vertex_set_id_code
         DxfHatchBoundaryPathPolylineVertex *vertex,
                 /*!< a pointer to a DXF \c HATCH boundary path polyline
                  * vertex. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -7427,7 +7456,7 @@ dxf_hatch_boundary_path_edge_free_chain
                  * edges. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -7454,7 +7483,7 @@ dxf_hatch_boundary_path_edge_free_chain
  *
  * \return ID code.
  */
-int
+long
 dxf_hatch_boundary_path_edge_get_id_code
 (
         DxfHatchBoundaryPathEdge *edge
@@ -7497,7 +7526,7 @@ dxf_hatch_boundary_path_edge_set_id_code
 (
         DxfHatchBoundaryPathEdge *edge,
                 /*!< a pointer to a DXF \c HATCH boundary path edge. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -8106,7 +8135,7 @@ dxf_hatch_boundary_path_edge_arc_free_chain
                  * edge arcs. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -8133,7 +8162,7 @@ dxf_hatch_boundary_path_edge_arc_free_chain
  *
  * \return ID code.
  */
-int
+long
 dxf_hatch_boundary_path_edge_arc_get_id_code
 (
         DxfHatchBoundaryPathEdgeArc *arc
@@ -8176,7 +8205,7 @@ dxf_hatch_boundary_path_edge_arc_set_id_code
 (
         DxfHatchBoundaryPathEdgeArc *arc,
                 /*!< a pointer to a DXF \c HATCH boundary path edge arc. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -8350,13 +8379,13 @@ dxf_hatch_boundary_path_edge_arc_get_center_point
 (
         DxfHatchBoundaryPathEdgeArc *arc,
                 /*!< a pointer to a DXF \c HATCH boundary path edge arc. */
-        int id_code
+        long id_code
                 /*!< Identification number for the \c DXfPoint entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         DxfPoint *p1 = NULL;
@@ -8407,7 +8436,7 @@ dxf_hatch_boundary_path_edge_arc_set_center_point
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -8954,7 +8983,7 @@ dxf_hatch_boundary_path_edge_ellipse_free_chain
                  * edge ellipses. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -8982,7 +9011,7 @@ dxf_hatch_boundary_path_edge_ellipse_free_chain
  *
  * \return ID code.
  */
-int
+long
 dxf_hatch_boundary_path_edge_ellipse_get_id_code
 (
         DxfHatchBoundaryPathEdgeEllipse *ellipse
@@ -9027,7 +9056,7 @@ dxf_hatch_boundary_path_edge_ellipse_set_id_code
         DxfHatchBoundaryPathEdgeEllipse *ellipse,
                 /*!< a pointer to a DXF \c HATCH boundary path edge
                  * ellipse. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -9209,13 +9238,13 @@ dxf_hatch_boundary_path_edge_ellipse_get_center_point
         DxfHatchBoundaryPathEdgeEllipse *ellipse,
                 /*!< a pointer to a DXF \c HATCH boundary path edge
                  * ellipse. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         DxfPoint *p1 = NULL;
@@ -9268,7 +9297,7 @@ dxf_hatch_boundary_path_edge_ellipse_set_center_point
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -9445,13 +9474,13 @@ dxf_hatch_boundary_path_edge_ellipse_get_end_point
         DxfHatchBoundaryPathEdgeEllipse *ellipse,
                 /*!< a pointer to a DXF \c HATCH boundary path edge
                  * ellipse. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         DxfPoint *p1 = NULL;
@@ -9504,7 +9533,7 @@ dxf_hatch_boundary_path_edge_ellipse_set_end_point
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -10064,7 +10093,7 @@ dxf_hatch_boundary_path_edge_line_free_chain
                  * edge lines. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -10091,7 +10120,7 @@ dxf_hatch_boundary_path_edge_line_free_chain
  *
  * \return ID code.
  */
-int
+long
 dxf_hatch_boundary_path_edge_line_get_id_code
 (
         DxfHatchBoundaryPathEdgeLine *line
@@ -10136,7 +10165,7 @@ dxf_hatch_boundary_path_edge_line_set_id_code
         DxfHatchBoundaryPathEdgeLine *line,
                 /*!< a pointer to a DXF \c HATCH boundary path edge
                  * line. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -10312,13 +10341,13 @@ dxf_hatch_boundary_path_edge_line_get_start_point
 (
         DxfHatchBoundaryPathEdgeLine *line,
                 /*!< a pointer to a DXF \c HATCH boundary path edge line. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         DxfPoint *p1 = NULL;
@@ -10377,7 +10406,7 @@ dxf_hatch_boundary_path_edge_line_set_start_point
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -10548,13 +10577,13 @@ dxf_hatch_boundary_path_edge_line_get_end_point
 (
         DxfHatchBoundaryPathEdgeLine *line,
                 /*!< a pointer to a DXF \c HATCH boundary path edge line. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         DxfPoint *p2 = NULL;
@@ -10613,7 +10642,7 @@ dxf_hatch_boundary_path_edge_line_set_end_point
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -10777,8 +10806,6 @@ dxf_hatch_boundary_path_edge_spline_init
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        int i;
-
         /* Do some basic checks. */
         if (spline == NULL)
         {
@@ -10799,10 +10826,8 @@ dxf_hatch_boundary_path_edge_spline_init
         spline->rational = 0;
         spline->periodic = 0;
         spline->number_of_knots = 0;
-        for (i = 0; i >= DXF_MAX_HATCH_BOUNDARY_PATH_EDGE_SPLINE_KNOTS; i++)
-        {
-                spline->knots[i] = 0.0;
-        }
+        spline->knots = NULL;
+        spline->knots_capacity = 0;
         spline->number_of_control_points = 0;
         spline->control_points = NULL;
         spline->next = NULL;
@@ -10847,6 +10872,7 @@ dxf_hatch_boundary_path_edge_spline_free
                 return (EXIT_FAILURE);
         }
         free (spline->control_points);
+        dxf_free (spline->knots);
         free (spline);
         spline = NULL;
 #if DEBUG
@@ -10868,7 +10894,7 @@ dxf_hatch_boundary_path_edge_spline_free_chain
                  * edge splines. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -10895,7 +10921,7 @@ dxf_hatch_boundary_path_edge_spline_free_chain
  *
  * \return ID code.
  */
-int
+long
 dxf_hatch_boundary_path_edge_spline_get_id_code
 (
         DxfHatchBoundaryPathEdgeSpline *spline
@@ -10940,7 +10966,7 @@ dxf_hatch_boundary_path_edge_spline_set_id_code
         DxfHatchBoundaryPathEdgeSpline *spline,
                 /*!< a pointer to a DXF \c HATCH boundary path edge
                  * spline. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -11241,6 +11267,9 @@ dxf_hatch_boundary_path_edge_spline_set_number_of_knots
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        double *knots;
+        int i;
+
         /* Do some basic checks. */
         if (spline == NULL)
         {
@@ -11256,6 +11285,18 @@ dxf_hatch_boundary_path_edge_spline_set_number_of_knots
                   __FUNCTION__);
                 return (NULL);
         }
+        knots = dxf_array_reserve (spline->knots, spline->number_of_knots,
+          &spline->knots_capacity, number_of_knots, sizeof (double));
+        if (knots == NULL)
+        {
+                return (NULL);
+        }
+        spline->knots = knots;
+        /* New knot values start at 0.0. */
+        for (i = spline->number_of_knots; i < number_of_knots; i++)
+        {
+                spline->knots[i] = 0.0;
+        }
         spline->number_of_knots = number_of_knots;
 #if DEBUG
         DXF_DEBUG_END
@@ -11267,9 +11308,12 @@ dxf_hatch_boundary_path_edge_spline_set_number_of_knots
 /*!
  * \brief Get the knot values from a DXF \c HATCH boundary path spline.
  *
- * \return pointer to the knot values.
+ * \c number_of_knots values are copied into \c knots.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
  *
- * \warning No checks are performed on the returned pointer (double).
+ * \warning No checks are performed on the size of \c knots.
  */
 int
 dxf_hatch_boundary_path_edge_spline_get_knots
@@ -11277,7 +11321,7 @@ dxf_hatch_boundary_path_edge_spline_get_knots
         DxfHatchBoundaryPathEdgeSpline *spline,
                 /*!< a pointer to a DXF \c HATCH boundary path edge
                  * spline. */
-        double knots[DXF_MAX_HATCH_BOUNDARY_PATH_EDGE_SPLINE_KNOTS]
+        double knots[]
                 /*!< array of knot values. */
 )
 {
@@ -11294,7 +11338,7 @@ dxf_hatch_boundary_path_edge_spline_get_knots
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        for (i = 1; i < DXF_MAX_HATCH_BOUNDARY_PATH_EDGE_SPLINE_KNOTS; i++)
+        for (i = 0; i < spline->number_of_knots; i++)
         {
                 knots[i] = spline->knots[i];
         }
@@ -11307,6 +11351,9 @@ dxf_hatch_boundary_path_edge_spline_get_knots
 
 /*!
  * \brief Set the knot values for a DXF \c HATCH boundary path spline.
+ *
+ * \c number_of_knots values are copied from \c knots, set the
+ * \c number_of_knots first.
  */
 DxfHatchBoundaryPathEdgeSpline *
 dxf_hatch_boundary_path_edge_spline_set_knots
@@ -11314,9 +11361,9 @@ dxf_hatch_boundary_path_edge_spline_set_knots
         DxfHatchBoundaryPathEdgeSpline *spline,
                 /*!< a pointer to a DXF \c HATCH boundary path edge
                  * spline. */
-        double knots[DXF_MAX_HATCH_BOUNDARY_PATH_EDGE_SPLINE_KNOTS]
-                /*!< an array containing the additional proprietary data
-                 * for the entity. */
+        double knots[]
+                /*!< an array containing the knot values for the
+                 * entity. */
 )
 {
 #if DEBUG
@@ -11332,15 +11379,15 @@ dxf_hatch_boundary_path_edge_spline_set_knots
                   __FUNCTION__);
                 return (NULL);
         }
-        for (i = 1; i < DXF_MAX_HATCH_BOUNDARY_PATH_EDGE_SPLINE_KNOTS; i++)
+        if (knots == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        for (i = 0; i < spline->number_of_knots; i++)
         {
-                if (&knots[i] ==  NULL)
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () a NULL pointer was found in the knots array at element %d.\n")),
-                          __FUNCTION__, i);
-                        return (NULL);
-                }
                 spline->knots[i] = knots[i];
         }
 #if DEBUG
@@ -12151,13 +12198,6 @@ dxf_hatch_boundary_path_edge_spline_insert_control_point
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (position > DXF_MAX_HATCH_BOUNDARY_PATH_EDGE_SPLINE_KNOTS)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () received a position greater than DXF_MAX_HATCH_BOUNDARY_PATH_EDGE_SPLINE_KNOTS.\n")),
-                  __FUNCTION__);
-                return (EXIT_FAILURE);
-        }
         if (control_point == NULL)
         {
                 fprintf (stderr,
@@ -12290,13 +12330,6 @@ dxf_hatch_boundary_path_edge_spline_remove_control_point
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (position >= DXF_MAX_HATCH_BOUNDARY_PATH_EDGE_SPLINE_KNOTS)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () received a position greater than DXF_MAX_HATCH_BOUNDARY_PATH_EDGE_SPLINE_KNOTS.\n")),
-                  __FUNCTION__);
-                return (EXIT_FAILURE);
-        }
         if (spline->number_of_control_points <= position)
         {
                 fprintf (stderr,
@@ -12527,8 +12560,8 @@ dxf_hatch_boundary_path_edge_spline_copy_control_points
  * \brief Append a knot value to a \c HATCH boundary path edge spline
  * entity.
  *
- * After testing for a \c NULL pointer or an array pointer overflow,
- * both the knot value is appended and the \c number_of_knots is
+ * After testing for a \c NULL pointer and making room for one more knot
+ * value, both the knot value is appended and the \c number_of_knots is
  * increased by 1.
  *
  * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
@@ -12546,6 +12579,8 @@ dxf_hatch_boundary_path_edge_spline_append_knot_value
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        double *knots;
+
         /* Do some basic checks. */
         if (spline == NULL)
         {
@@ -12554,14 +12589,15 @@ dxf_hatch_boundary_path_edge_spline_append_knot_value
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if ((spline->number_of_knots + 1) > DXF_MAX_HATCH_BOUNDARY_PATH_EDGE_SPLINE_KNOTS)
+        knots = dxf_array_reserve (spline->knots, spline->number_of_knots,
+          &spline->knots_capacity, spline->number_of_knots + 1,
+          sizeof (double));
+        if (knots == NULL)
         {
-                fprintf (stderr,
-                  (("Error in %s () resulted in a array pointer overflow.\n")),
-                  __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        spline->knots[spline->number_of_knots + 1] = knot_value;
+        spline->knots = knots;
+        spline->knots[spline->number_of_knots] = knot_value;
         spline->number_of_knots++;
 #if DEBUG
         DXF_DEBUG_END
@@ -12574,9 +12610,9 @@ dxf_hatch_boundary_path_edge_spline_append_knot_value
  * \brief Prepend a knot value to a \c HATCH boundary path edge spline
  * entity.
  *
- * After testing for a \c NULL pointer or an array pointer overflow, all
- * the \c knots[] values are shifted one position up, the knot value is
- * prepended and the \c number_of_knots is increased by 1.
+ * After testing for a \c NULL pointer and making room for one more knot
+ * value, all the \c knots[] values are shifted one position up, the knot
+ * value is prepended and the \c number_of_knots is increased by 1.
  *
  * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
  * occurred.
@@ -12593,6 +12629,7 @@ dxf_hatch_boundary_path_edge_spline_prepend_knot_value
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        double *knots;
         int i;
 
         /* Do some basic checks. */
@@ -12603,16 +12640,17 @@ dxf_hatch_boundary_path_edge_spline_prepend_knot_value
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if ((spline->number_of_knots + 1) > DXF_MAX_HATCH_BOUNDARY_PATH_EDGE_SPLINE_KNOTS)
+        knots = dxf_array_reserve (spline->knots, spline->number_of_knots,
+          &spline->knots_capacity, spline->number_of_knots + 1,
+          sizeof (double));
+        if (knots == NULL)
         {
-                fprintf (stderr,
-                  (_("Error in %s () resulted in a array pointer overflow.\n")),
-                  __FUNCTION__);
                 return (EXIT_FAILURE);
         }
+        spline->knots = knots;
         for (i = spline->number_of_knots; i > 0; i--)
         {
-                spline->knots[i + 1] = spline->knots[i];
+                spline->knots[i] = spline->knots[i - 1];
         }
         spline->knots[0] = knot_value;
         spline->number_of_knots++;
@@ -12627,8 +12665,8 @@ dxf_hatch_boundary_path_edge_spline_prepend_knot_value
  * \brief Get a knot value from a \c HATCH boundary path edge spline
  * entity.
  *
- * After testing for a \c NULL pointer or an array pointer overflow, the
- * desired knot value at \c position is returned.
+ * After testing for a \c NULL pointer or a position outside the knot
+ * values, the desired knot value at \c position is returned.
  *
  * \return the knot value.
  */
@@ -12638,7 +12676,7 @@ dxf_hatch_boundary_path_edge_spline_get_knot_value
         DxfHatchBoundaryPathEdgeSpline *spline,
                 /*!< DXF \c HATCH boundary path edge spline entity. */
         int position
-                /*!< position in the array of knot values [0 .. DXF_MAX_HATCH_BOUNDARY_PATH_EDGE_SPLINE_KNOTS]. */
+                /*!< position in the array of knot values [0 .. \c number_of_knots - 1]. */
 )
 {
 #if DEBUG
@@ -12654,20 +12692,13 @@ dxf_hatch_boundary_path_edge_spline_get_knot_value
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (position <= 0)
+        if ((position < 0) || (position >= spline->number_of_knots))
         {
                 fprintf (stderr,
                   (_("Error in %s () received an invalid value in position.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (position > DXF_MAX_HATCH_BOUNDARY_PATH_EDGE_SPLINE_KNOTS)
-        {
-                fprintf (stderr,
-                  (_("Error in  %s () received a position greater than DXF_MAX_HATCH_BOUNDARY_PATH_EDGE_SPLINE_KNOTS.\n")),
-                  __FUNCTION__);
-                return (EXIT_FAILURE);
-        }
         knot_value = spline->knots[position];
 #if DEBUG
         DXF_DEBUG_END
@@ -12679,8 +12710,8 @@ dxf_hatch_boundary_path_edge_spline_get_knot_value
 /*!
  * \brief Set a knot value to a \c HATCH boundary path edge spline entity.
  *
- * After testing for a \c NULL pointer or an array pointer overflow, the
- * desired knot value at \c position is set.
+ * After testing for a \c NULL pointer or a position outside the knot
+ * values, the desired knot value at \c position is set.
  *
  * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
  * occurred.
@@ -12691,7 +12722,7 @@ dxf_hatch_boundary_path_edge_spline_set_knot_value
         DxfHatchBoundaryPathEdgeSpline *spline,
                 /*!< DXF \c HATCH boundary path edge spline entity. */
         int position,
-                /*!< position in the array of knot values [0 .. DXF_MAX_HATCH_BOUNDARY_PATH_EDGE_SPLINE_KNOTS]. */
+                /*!< position in the array of knot values [0 .. \c number_of_knots - 1]. */
         double knot_value
                 /*!< knot value. */
 )
@@ -12707,20 +12738,13 @@ dxf_hatch_boundary_path_edge_spline_set_knot_value
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (position <= 0)
+        if ((position < 0) || (position >= spline->number_of_knots))
         {
                 fprintf (stderr,
                   (_("Error in %s () received an invalid value in position.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (position > DXF_MAX_HATCH_BOUNDARY_PATH_EDGE_SPLINE_KNOTS)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () received a position greater than DXF_MAX_HATCH_BOUNDARY_PATH_EDGE_SPLINE_KNOTS.\n")),
-                  __FUNCTION__);
-                return (EXIT_FAILURE);
-        }
         spline->knots[position] = knot_value;
 #if DEBUG
         DXF_DEBUG_END
@@ -12733,10 +12757,11 @@ dxf_hatch_boundary_path_edge_spline_set_knot_value
  * \brief Insert a knot value into a \c HATCH boundary path edge spline
  * entity.
  *
- * After testing for a \c NULL pointer or an array pointer overflow, all
- * the knot values upwards of \c knots[\c position] are shifted one
- * position,  the knot value is inserted at \c knots[\c position] and
- * the  \c number_of_knots is increased by 1.
+ * After testing for a \c NULL pointer or a position outside the knot
+ * values and making room for one more knot value, all the knot values
+ * upwards of \c knots[\c position] are shifted one position,  the knot
+ * value is inserted at \c knots[\c position] and the
+ * \c number_of_knots is increased by 1.
  *
  * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
  * occurred.
@@ -12747,7 +12772,7 @@ dxf_hatch_boundary_path_edge_spline_insert_knot_value
         DxfHatchBoundaryPathEdgeSpline *spline,
                 /*!< DXF \c HATCH boundary path edge spline entity. */
         int position,
-                /*!< position in the array of knot values [0 .. DXF_MAX_HATCH_BOUNDARY_PATH_EDGE_SPLINE_KNOTS]. */
+                /*!< position in the array of knot values [0 .. \c number_of_knots]. */
         double knot_value
                 /*!< knot value. */
 )
@@ -12755,6 +12780,7 @@ dxf_hatch_boundary_path_edge_spline_insert_knot_value
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        double *knots;
         int i;
 
         /* Do some basic checks. */
@@ -12765,30 +12791,24 @@ dxf_hatch_boundary_path_edge_spline_insert_knot_value
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if ((spline->number_of_knots + 1) > DXF_MAX_HATCH_BOUNDARY_PATH_EDGE_SPLINE_KNOTS)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () resulted in a array pointer overflow.\n")),
-                  __FUNCTION__);
-                return (EXIT_FAILURE);
-        }
-        if (position <= 0)
+        if ((position < 0) || (position > spline->number_of_knots))
         {
                 fprintf (stderr,
                   (_("Error in %s () received an invalid value in position.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (position >= DXF_MAX_HATCH_BOUNDARY_PATH_EDGE_SPLINE_KNOTS)
+        knots = dxf_array_reserve (spline->knots, spline->number_of_knots,
+          &spline->knots_capacity, spline->number_of_knots + 1,
+          sizeof (double));
+        if (knots == NULL)
         {
-                fprintf (stderr,
-                  (_("Error in %s () received a position greater than DXF_MAX_HATCH_BOUNDARY_PATH_EDGE_SPLINE_KNOTS.\n")),
-                  __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        for (i = spline->number_of_knots; i <= position; i--)
+        spline->knots = knots;
+        for (i = spline->number_of_knots; i > position; i--)
         {
-                spline->knots[i + 1] = spline->knots[i];
+                spline->knots[i] = spline->knots[i - 1];
         }
         spline->knots[position] = knot_value;
         spline->number_of_knots++;
@@ -12803,9 +12823,10 @@ dxf_hatch_boundary_path_edge_spline_insert_knot_value
  * \brief Remove a knot value from a \c HATCH boundary path edge spline
  * entity.
  *
- * After testing for a \c NULL pointer or an array pointer overflow, all
- * the knot values upwards of \c knots[\c position] are shifted one
- * position down, and the \c number_of_knots is decreased by 1.
+ * After testing for a \c NULL pointer or a position outside the knot
+ * values, all the knot values upwards of \c knots[\c position] are
+ * shifted one position down, and the \c number_of_knots is decreased
+ * by 1.
  *
  * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
  * occurred.
@@ -12816,7 +12837,7 @@ dxf_hatch_boundary_path_edge_spline_remove_knot_value
         DxfHatchBoundaryPathEdgeSpline *spline,
                 /*!< DXF \c HATCH boundary path edge spline entity. */
         int position
-                /*!< position in the array of knot values [0 .. DXF_MAX_HATCH_BOUNDARY_PATH_EDGE_SPLINE_KNOTS]. */
+                /*!< position in the array of knot values [0 .. \c number_of_knots - 1]. */
 )
 {
 #if DEBUG
@@ -12832,35 +12853,14 @@ dxf_hatch_boundary_path_edge_spline_remove_knot_value
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (spline->number_of_knots > DXF_MAX_HATCH_BOUNDARY_PATH_EDGE_SPLINE_KNOTS)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () resulted in a array pointer overflow.\n")),
-                  __FUNCTION__);
-                return (EXIT_FAILURE);
-        }
-        if ((spline->number_of_knots - 1) < 0)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () resulted in a array pointer underflow.\n")),
-                  __FUNCTION__);
-                return (EXIT_FAILURE);
-        }
-        if (position <= 0)
+        if ((position < 0) || (position >= spline->number_of_knots))
         {
                 fprintf (stderr,
                   (_("Error in %s () received an invalid value in position.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (position >= DXF_MAX_HATCH_BOUNDARY_PATH_EDGE_SPLINE_KNOTS)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () received a position greater than DXF_MAX_HATCH_BOUNDARY_PATH_EDGE_SPLINE_KNOTS.\n")),
-                  __FUNCTION__);
-                return (EXIT_FAILURE);
-        }
-        for (i = position; i >= spline->number_of_knots; i++)
+        for (i = position; i < spline->number_of_knots - 1; i++)
         {
                 spline->knots[i] = spline->knots[i + 1];
         }
@@ -12876,12 +12876,12 @@ dxf_hatch_boundary_path_edge_spline_remove_knot_value
  * \brief Copy knot values from a \c HATCH boundary path edge spline
  * entity into an array.
  *
- * After testing for a \c NULL pointer or an array pointer overflow, all
- * the knot values from \c spline (source) are copied into an array
- * \c knot_values (destination).
+ * After testing for a \c NULL pointer, all the knot values from
+ * \c spline (source) are copied into an array \c knot_values
+ * (destination).
  *
  * \warning Make sure enough memory is allocated for the destination
- * array.
+ * array, \c number_of_knots values.
  *
  * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
  * occurred.
@@ -12891,7 +12891,7 @@ dxf_hatch_boundary_path_edge_spline_copy_knot_values
 (
         DxfHatchBoundaryPathEdgeSpline *spline,
                 /*!< DXF \c HATCH boundary path edge spline entity (source). */
-        double *knot_values[DXF_MAX_HATCH_BOUNDARY_PATH_EDGE_SPLINE_KNOTS]
+        double *knot_values[]
                 /*!< Array of knot values (destination). */
 )
 {
@@ -12908,13 +12908,6 @@ dxf_hatch_boundary_path_edge_spline_copy_knot_values
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (spline->number_of_knots > DXF_MAX_HATCH_BOUNDARY_PATH_EDGE_SPLINE_KNOTS)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () resulted in a array pointer overflow.\n")),
-                  __FUNCTION__);
-                return (EXIT_FAILURE);
-        }
         for (i = 0; i < spline->number_of_knots; i++)
         {
                 *knot_values[i] = spline->knots[i];
@@ -13062,7 +13055,7 @@ dxf_hatch_boundary_path_edge_spline_control_point_free_chain
                  * edge spline control points. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -13090,7 +13083,7 @@ dxf_hatch_boundary_path_edge_spline_control_point_free_chain
  *
  * \return ID code.
  */
-int
+long
 dxf_hatch_boundary_path_edge_spline_cp_get_id_code
 (
         DxfHatchBoundaryPathEdgeSplineCp *control_point
@@ -13136,7 +13129,7 @@ dxf_hatch_boundary_path_edge_spline_cp_set_id_code
         DxfHatchBoundaryPathEdgeSplineCp *control_point,
                 /*!< a pointer to a DXF \c HATCH boundary path spline
                  * control point. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -13318,13 +13311,13 @@ dxf_hatch_boundary_path_edge_spline_cp_get_point
         DxfHatchBoundaryPathEdgeSplineCp *control_point,
                 /*!< a pointer to a DXF \c HATCH boundary path spline
                  * control point. */
-        int id_code
+        long id_code
                 /*!< Identification number for the \c DXfPoint entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         DxfPoint *p1 = NULL;
@@ -13378,7 +13371,7 @@ dxf_hatch_boundary_path_edge_spline_cp_set_point
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -43,6 +43,7 @@
 #include <math.h>
 
 #include "global.h"
+#include "graphic_properties.h"
 #include "point.h"
 #include "binary_graphics_data.h"
 
@@ -53,7 +54,6 @@ extern "C" {
 
 
 #define DXF_MAX_HATCH_PATTERN_DEF_LINE_DASH_ITEMS 16
-#define DXF_MAX_HATCH_BOUNDARY_PATH_EDGE_SPLINE_KNOTS 64
 
 
 /*!
@@ -62,7 +62,7 @@ extern "C" {
 typedef struct
 dxf_hatch_boundary_path_edge_arc
 {
-        int id_code;
+        long id_code;
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the
                  * DXF file.\n
@@ -94,7 +94,7 @@ dxf_hatch_boundary_path_edge_arc
 typedef struct
 dxf_hatch_boundary_path_edge_ellipse
 {
-        int id_code;
+        long id_code;
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the
                  * DXF file.\n
@@ -135,7 +135,7 @@ dxf_hatch_boundary_path_edge_ellipse
 typedef struct
 dxf_hatch_boundary_path_edge_line
 {
-        int id_code;
+        long id_code;
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the
                  * DXF file.\n
@@ -165,7 +165,7 @@ dxf_hatch_boundary_path_edge_line
 typedef struct
 dxf_hatch_boundary_path_edge_spline_cp
 {
-        int id_code;
+        long id_code;
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the
                  * DXF file.\n
@@ -191,7 +191,7 @@ dxf_hatch_boundary_path_edge_spline_cp
 typedef struct
 dxf_hatch_boundary_path_edge_spline
 {
-        int id_code;
+        long id_code;
                 /*!< group code = 5. */
         int degree;
                 /*!< group code = 94. */
@@ -202,10 +202,13 @@ dxf_hatch_boundary_path_edge_spline
         int number_of_knots;
                 /*!< Number of knots.\n
                  * Group code = 95. */
-        double knots[DXF_MAX_HATCH_BOUNDARY_PATH_EDGE_SPLINE_KNOTS];
+        double *knots;
                 /*!< Knot values control the shape of the curve as it
-                 * passes through the control points.\n
+                 * passes through the control points,
+                 * \c number_of_knots entries.\n
                  * Group code = 40. */
+        int knots_capacity;
+                /*!< Number of entries \c knots has room for. */
         int number_of_control_points;
                 /*!< Number of control points.\n
                  * Group code = 96. */
@@ -226,7 +229,7 @@ dxf_hatch_boundary_path_edge_spline
 typedef struct
 dxf_hatch_boundary_path_edge
 {
-        int id_code;
+        long id_code;
                 /*!< Treat the boundary path edge as if it were a single
                  * (composite) entity.\n
                  * Group code = 5. */
@@ -259,7 +262,7 @@ dxf_hatch_boundary_path_edge
 typedef struct
 dxf_hatch_boundary_path_polyline_vertex
 {
-        int id_code;
+        long id_code;
                 /*!< Group code = 5.*/
         double x0;
                 /*!< Group code = 10. */
@@ -286,7 +289,7 @@ dxf_hatch_boundary_path_polyline_vertex
 typedef struct
 dxf_hatch_boundary_path_polyline
 {
-        int id_code;
+        long id_code;
                 /*!< Group code = 5. */
         int is_closed;
                 /*!< Group code = 73. */
@@ -313,7 +316,7 @@ dxf_hatch_boundary_path_polyline
 typedef struct
 dxf_hatch_boundary_path
 {
-        int id_code;
+        long id_code;
                 /*!< Treat the boundary path as if it were a single
                  * (composite) entity.\n
                  * Group code = 5. */
@@ -353,7 +356,7 @@ dxf_hatch_pattern_def_line_dash
 typedef struct
 dxf_hatch_pattern_def_line
 {
-        int id_code;
+        long id_code;
                 /*!< group code = 5. */
         double angle;
                 /*!< Hatch pattern line angle.\n
@@ -388,7 +391,7 @@ dxf_hatch_pattern_def_line
 typedef struct
 dxf_hatch_pattern_seedpoint
 {
-        int id_code;
+        long id_code;
                 /*!< group code = 5. */
         double x0;
                 /*!< Seed point X-value.\n
@@ -408,7 +411,7 @@ dxf_hatch_pattern_seedpoint
 typedef struct
 dxf_hatch_pattern
 {
-        int id_code;
+        long id_code;
                 /*!< group code = 5. */
         int number_of_def_lines;
                 /*!< Number of hatch pattern definition lines.\n
@@ -433,50 +436,16 @@ typedef struct
 dxf_hatch
 {
         /* Members common for all DXF drawable entities. */
-        int id_code;
+        long id_code;
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file.\n
                  * Group code = 5. */
-        char *linetype;
-                /*!< The linetype of the entity.\n
-                 * Defaults to \c BYLAYER if ommitted in the DXF file.\n
-                 * Group code = 6. */
-        char *layer;
-                /*!< Layer on which the entity is drawn.\n
-                 * Defaults to layer "0" if no valid layername is given.\n
-                 * Group code = 8. */
-        double elevation;
-                /*!< Elevation of the arc in the local Z-direction.\n
-                 * Defaults to 0.0 if omitted in the DXF file, or prior
-                 * to DXF version R12, or DXF_FLATLAND equals 0 (default).\n
-                 * Group code = 38. */
-        double thickness;
-                /*!< Thickness of the arc in the local Z-direction.\n
-                 * Defaults to 0.0 if ommitted in the DXF file.\n
-                 * Group code = 39. */
-        double linetype_scale;
-                /*!< Linetype scale (optional).\n
-                 * Group code = 48. */
-        int16_t visibility;
-                /*!< Object visibility (optional):\n
-                 * <ol>
-                 * <li value = "0"> Visible</li>
-                 * <li value = "1"> Invisible</li>
-                 * </ol>
-                 * Group code = 60. */
-        int color;
-                /*!< Color of the entity.\n
-                 * Defaults to \c BYLAYER if ommitted in the DXF file.\n
-                 * Note that entities encapsulated in a block with the
-                 * color \c BYBLOCK are represented in the "native" color of
-                 * the \c BLOCK entity.\n
-                 * Group code = 62. */
-        int paperspace;
-                /*!< Entities are to be drawn on either \c PAPERSPACE or
-                 * \c MODELSPACE.\n
-                 * Optional, defaults to \c DXF_MODELSPACE (0).\n
-                 * Group code = 67. */
+        DxfGraphicProperties *properties;
+                /*!< Linetype, layer, color and the other graphic
+                 * properties, shared with the entities which have
+                 * the same (see graphic_properties.h).\n
+                 * Group codes = 6, 8, 38, 39, 48, 60, 62 and 67. */
         int graphics_data_size;
                 /*!< The number of bytes in the image (and subsequent
                  * binary chunk records) (optional).\n
@@ -600,7 +569,7 @@ dxf_hatch_free_chain
 (
         DxfHatch *hatches
 );
-int
+long
 dxf_hatch_get_id_code
 (
         DxfHatch *hatch
@@ -609,7 +578,7 @@ DxfHatch *
 dxf_hatch_set_id_code
 (
         DxfHatch *hatch,
-        int id_code
+        long id_code
 );
 char *
 dxf_hatch_get_linetype
@@ -959,7 +928,7 @@ dxf_hatch_pattern_free_chain
 (
         DxfHatchPattern *patterns
 );
-int
+long
 dxf_hatch_pattern_get_id_code
 (
         DxfHatchPattern *pattern
@@ -968,7 +937,7 @@ DxfHatchPattern *
 dxf_hatch_pattern_set_id_code
 (
         DxfHatchPattern *pattern,
-        int id_code
+        long id_code
 );
 int
 dxf_hatch_pattern_get_number_of_def_lines
@@ -1089,7 +1058,7 @@ dxf_hatch_pattern_def_line_free_chain
 (
         DxfHatchPatternDefLine *lines
 );
-int
+long
 dxf_hatch_pattern_def_line_get_id_code
 (
         DxfHatchPatternDefLine *line
@@ -1098,7 +1067,7 @@ DxfHatchPatternDefLine *
 dxf_hatch_pattern_def_line_set_id_code
 (
         DxfHatchPatternDefLine *line,
-        int id_code
+        long id_code
 );
 double
 dxf_hatch_pattern_def_line_get_angle
@@ -1212,7 +1181,7 @@ dxf_hatch_pattern_seedpoint_free_chain
 (
         DxfHatchPatternSeedPoint *hatch_pattern_seed_points
 );
-int
+long
 dxf_hatch_pattern_seedpoint_get_id_code
 (
         DxfHatchPatternSeedPoint *point
@@ -1221,7 +1190,7 @@ DxfHatchPatternSeedPoint *
 dxf_hatch_pattern_seedpoint_set_id_code
 (
         DxfHatchPatternSeedPoint *point,
-        int id_code
+        long id_code
 );
 double
 dxf_hatch_pattern_seedpoint_get_x0
@@ -1280,7 +1249,7 @@ dxf_hatch_boundary_path_free_chain
 (
         DxfHatchBoundaryPath *hatch_boundary_paths
 );
-int
+long
 dxf_hatch_boundary_path_get_id_code
 (
         DxfHatchBoundaryPath *path
@@ -1289,7 +1258,7 @@ DxfHatchBoundaryPath *
 dxf_hatch_boundary_path_set_id_code
 (
         DxfHatchBoundaryPath *path,
-        int id_code
+        long id_code
 );
 DxfHatchBoundaryPathEdge *
 dxf_hatch_boundary_path_get_edges
@@ -1348,7 +1317,7 @@ dxf_hatch_boundary_path_polyline_free_chain
 (
         DxfHatchBoundaryPathPolyline *polylines
 );
-int
+long
 dxf_hatch_boundary_path_polyline_get_id_code
 (
         DxfHatchBoundaryPathPolyline *polyline
@@ -1357,7 +1326,7 @@ DxfHatchBoundaryPathPolyline *
 dxf_hatch_boundary_path_polyline_set_id_code
 (
         DxfHatchBoundaryPathPolyline *polyline,
-        int id_code
+        long id_code
 );
 int
 dxf_hatch_boundary_path_polyline_get_is_closed
@@ -1438,7 +1407,7 @@ dxf_hatch_boundary_path_polyline_vertex_free_chain
 (
         DxfHatchBoundaryPathPolylineVertex *hatch_boundary_path_polyline_vertices
 );
-int
+long
 dxf_hatch_boundary_path_polyline_vertex_get_id_code
 (
         DxfHatchBoundaryPathPolylineVertex *vertex
@@ -1447,7 +1416,7 @@ DxfHatchBoundaryPathPolylineVertex *
 dxf_hatch_boundary_path_polyline_vertex_set_id_code
 (
         DxfHatchBoundaryPathPolylineVertex *vertex,
-        int id_code
+        long id_code
 );
 double
 dxf_hatch_boundary_path_polyline_vertex_get_x0
@@ -1528,7 +1497,7 @@ dxf_hatch_boundary_path_edge_free_chain
 (
         DxfHatchBoundaryPathEdge *edges
 );
-int
+long
 dxf_hatch_boundary_path_edge_get_id_code
 (
         DxfHatchBoundaryPathEdge *edge
@@ -1537,7 +1506,7 @@ DxfHatchBoundaryPathEdge *
 dxf_hatch_boundary_path_edge_set_id_code
 (
         DxfHatchBoundaryPathEdge *edge,
-        int id_code
+        long id_code
 );
 DxfHatchBoundaryPathEdgeArc *
 dxf_hatch_boundary_path_edge_get_arcs
@@ -1612,7 +1581,7 @@ dxf_hatch_boundary_path_edge_arc_free_chain
 (
         DxfHatchBoundaryPathEdgeArc *hatch_boundary_path_edge_arcs
 );
-int
+long
 dxf_hatch_boundary_path_edge_arc_get_id_code
 (
         DxfHatchBoundaryPathEdgeArc *arc
@@ -1621,7 +1590,7 @@ DxfHatchBoundaryPathEdgeArc *
 dxf_hatch_boundary_path_edge_arc_set_id_code
 (
         DxfHatchBoundaryPathEdgeArc *arc,
-        int id_code
+        long id_code
 );
 double
 dxf_hatch_boundary_path_edge_arc_get_x0
@@ -1649,7 +1618,7 @@ DxfPoint *
 dxf_hatch_boundary_path_edge_arc_get_center_point
 (
         DxfHatchBoundaryPathEdgeArc *arc,
-        int id_code
+        long id_code
 );
 DxfHatchBoundaryPathEdgeArc *
 dxf_hatch_boundary_path_edge_arc_set_center_point
@@ -1730,7 +1699,7 @@ dxf_hatch_boundary_path_edge_ellipse_free_chain
 (
         DxfHatchBoundaryPathEdgeEllipse *hatch_boundary_path_edge_ellipses
 );
-int
+long
 dxf_hatch_boundary_path_edge_ellipse_get_id_code
 (
         DxfHatchBoundaryPathEdgeEllipse *ellipse
@@ -1739,7 +1708,7 @@ DxfHatchBoundaryPathEdgeEllipse *
 dxf_hatch_boundary_path_edge_ellipse_set_id_code
 (
         DxfHatchBoundaryPathEdgeEllipse *ellipse,
-        int id_code
+        long id_code
 );
 double
 dxf_hatch_boundary_path_edge_ellipse_get_x0
@@ -1767,7 +1736,7 @@ DxfPoint *
 dxf_hatch_boundary_path_edge_ellipse_get_center_point
 (
         DxfHatchBoundaryPathEdgeEllipse *ellipse,
-        int id_code
+        long id_code
 );
 DxfHatchBoundaryPathEdgeEllipse *
 dxf_hatch_boundary_path_edge_ellipse_set_center_point
@@ -1801,7 +1770,7 @@ DxfPoint *
 dxf_hatch_boundary_path_edge_ellipse_get_end_point
 (
         DxfHatchBoundaryPathEdgeEllipse *ellipse,
-        int id_code
+        long id_code
 );
 DxfHatchBoundaryPathEdgeEllipse *
 dxf_hatch_boundary_path_edge_ellipse_set_end_point
@@ -1882,7 +1851,7 @@ dxf_hatch_boundary_path_edge_line_free_chain
 (
         DxfHatchBoundaryPathEdgeLine *hatch_boundary_path_edge_lines
 );
-int
+long
 dxf_hatch_boundary_path_edge_line_get_id_code
 (
         DxfHatchBoundaryPathEdgeLine *line
@@ -1891,7 +1860,7 @@ DxfHatchBoundaryPathEdgeLine *
 dxf_hatch_boundary_path_edge_line_set_id_code
 (
         DxfHatchBoundaryPathEdgeLine *line,
-        int id_code
+        long id_code
 );
 double
 dxf_hatch_boundary_path_edge_line_get_x0
@@ -1919,7 +1888,7 @@ DxfPoint *
 dxf_hatch_boundary_path_edge_line_get_start_point
 (
         DxfHatchBoundaryPathEdgeLine *line,
-        int id_code
+        long id_code
 );
 DxfHatchBoundaryPathEdgeLine *
 dxf_hatch_boundary_path_edge_line_set_start_point
@@ -1953,7 +1922,7 @@ DxfPoint *
 dxf_hatch_boundary_path_edge_line_get_end_point
 (
         DxfHatchBoundaryPathEdgeLine *line,
-        int id_code
+        long id_code
 );
 DxfHatchBoundaryPathEdgeLine *
 dxf_hatch_boundary_path_edge_line_set_end_point
@@ -1990,7 +1959,7 @@ dxf_hatch_boundary_path_edge_spline_free_chain
 (
         DxfHatchBoundaryPathEdgeSpline *hatch_boundary_path_edge_splines
 );
-int
+long
 dxf_hatch_boundary_path_edge_spline_get_id_code
 (
         DxfHatchBoundaryPathEdgeSpline *spline
@@ -1999,7 +1968,7 @@ DxfHatchBoundaryPathEdgeSpline *
 dxf_hatch_boundary_path_edge_spline_set_id_code
 (
         DxfHatchBoundaryPathEdgeSpline *spline,
-        int id_code
+        long id_code
 );
 int
 dxf_hatch_boundary_path_edge_spline_get_degree
@@ -2049,13 +2018,13 @@ int
 dxf_hatch_boundary_path_edge_spline_get_knots
 (
         DxfHatchBoundaryPathEdgeSpline *spline,
-        double knots[DXF_MAX_HATCH_BOUNDARY_PATH_EDGE_SPLINE_KNOTS]
+        double knots[]
 );
 DxfHatchBoundaryPathEdgeSpline *
 dxf_hatch_boundary_path_edge_spline_set_knots
 (
         DxfHatchBoundaryPathEdgeSpline *spline,
-        double knots[DXF_MAX_HATCH_BOUNDARY_PATH_EDGE_SPLINE_KNOTS]
+        double knots[]
 );
 int
 dxf_hatch_boundary_path_edge_spline_get_number_of_control_points
@@ -2175,7 +2144,7 @@ int
 dxf_hatch_boundary_path_edge_spline_copy_knot_values
 (
         DxfHatchBoundaryPathEdgeSpline *spline,
-        double *knot_values[DXF_MAX_HATCH_BOUNDARY_PATH_EDGE_SPLINE_KNOTS]
+        double *knot_values[]
 );
 /* dxf_hatch_boundary_path_edge_splie_control_point functions. */
 DxfHatchBoundaryPathEdgeSplineCp *
@@ -2195,7 +2164,7 @@ dxf_hatch_boundary_path_edge_spline_control_point_free_chain
 (
         DxfHatchBoundaryPathEdgeSplineCp *hatch_boundary_path_edge_spline_control_points
 );
-int
+long
 dxf_hatch_boundary_path_edge_spline_cp_get_id_code
 (
         DxfHatchBoundaryPathEdgeSplineCp *control_point
@@ -2204,7 +2173,7 @@ DxfHatchBoundaryPathEdgeSplineCp *
 dxf_hatch_boundary_path_edge_spline_cp_set_id_code
 (
         DxfHatchBoundaryPathEdgeSplineCp *control_point,
-        int id_code
+        long id_code
 );
 double
 dxf_hatch_boundary_path_edge_spline_cp_get_x0
@@ -2232,7 +2201,7 @@ DxfPoint *
 dxf_hatch_boundary_path_edge_spline_cp_get_point
 (
         DxfHatchBoundaryPathEdgeSplineCp *control_point,
-        int id_code
+        long id_code
 );
 DxfHatchBoundaryPathEdgeSplineCp *
 dxf_hatch_boundary_path_edge_spline_cp_set_point
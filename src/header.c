@@ -37,6 +37,126 @@
 #include "section.h"
 #include "util.h"
 #include "point.h"
+#include "lexer.h"
+#include "writer.h"
+#include <stddef.h>
+
+
+#define DXF_HEADER_ANY_VERSION INT_MAX
+        /*!< \brief Upper bound of the versions of a header variable which
+         * is not obsolete. */
+
+
+/*!
+ * \brief Value types of header variables.
+ */
+typedef enum
+dxf_header_variable_type
+{
+        DXF_HEADER_VARIABLE_STRING,
+        DXF_HEADER_VARIABLE_INT,
+        DXF_HEADER_VARIABLE_DOUBLE
+} DxfHeaderVariableType;
+
+
+/*!
+ * \brief Where and when dxf_header_read_parser () stores a header
+ * variable.
+ */
+typedef struct
+dxf_header_variable_struct
+{
+        const char *name;
+                /*!< Name of the variable, including the \c $. */
+        DxfHeaderVariableType type;
+                /*!< Type of the values. */
+        int count;
+                /*!< Number of values, 2 or 3 for the coordinates of a
+                 * point. */
+        size_t offset;
+                /*!< Offset of the member in a DxfHeader.  The
+                 * coordinates of a point are consecutive doubles. */
+        int min_version;
+                /*!< First AutoCAD version with the variable. */
+        int max_version;
+                /*!< Last AutoCAD version with the variable, or
+                 * \c DXF_HEADER_ANY_VERSION. */
+} DxfHeaderVariable;
+
+
+/*!
+ * \brief All header variables read by dxf_header_read_parser (),
+ * sorted by name for a binary search.
+ */
+static const DxfHeaderVariable dxf_header_variables[] =
+{
+        { "$ACADMAINTVER", DXF_HEADER_VARIABLE_INT, 1, offsetof (DxfHeader, AcadMaintVer), AC1015, DXF_HEADER_ANY_VERSION },
+        { "$ATTMODE", DXF_HEADER_VARIABLE_INT, 1, offsetof (DxfHeader, AttMode), 0, DXF_HEADER_ANY_VERSION },
+        { "$AUNITS", DXF_HEADER_VARIABLE_INT, 1, offsetof (DxfHeader, AUnits), 0, DXF_HEADER_ANY_VERSION },
+        { "$AUPREC", DXF_HEADER_VARIABLE_INT, 1, offsetof (DxfHeader, AUPrec), 0, DXF_HEADER_ANY_VERSION },
+        { "$CECOLOR", DXF_HEADER_VARIABLE_INT, 1, offsetof (DxfHeader, CEColor), 0, DXF_HEADER_ANY_VERSION },
+        { "$CELTSCALE", DXF_HEADER_VARIABLE_DOUBLE, 1, offsetof (DxfHeader, CELTScale), AC1012, DXF_HEADER_ANY_VERSION },
+        { "$CELTYPE", DXF_HEADER_VARIABLE_STRING, 1, offsetof (DxfHeader, CELType), 0, DXF_HEADER_ANY_VERSION },
+        { "$CLAYER", DXF_HEADER_VARIABLE_STRING, 1, offsetof (DxfHeader, CLayer), 0, DXF_HEADER_ANY_VERSION },
+        { "$DELOBJ", DXF_HEADER_VARIABLE_INT, 1, offsetof (DxfHeader, DelObj), AC1012, AC1014 },
+        { "$DIMADEC", DXF_HEADER_VARIABLE_INT, 1, offsetof (DxfHeader, DimADEC), AC1015, DXF_HEADER_ANY_VERSION },
+        { "$DIMASZ", DXF_HEADER_VARIABLE_DOUBLE, 1, offsetof (DxfHeader, DimASZ), 0, DXF_HEADER_ANY_VERSION },
+        { "$DIMAUNIT", DXF_HEADER_VARIABLE_INT, 1, offsetof (DxfHeader, DimAUNIT), AC1012, DXF_HEADER_ANY_VERSION },
+        { "$DIMEXE", DXF_HEADER_VARIABLE_DOUBLE, 1, offsetof (DxfHeader, DimEXE), 0, DXF_HEADER_ANY_VERSION },
+        { "$DIMEXO", DXF_HEADER_VARIABLE_DOUBLE, 1, offsetof (DxfHeader, DimEXO), 0, DXF_HEADER_ANY_VERSION },
+        { "$DIMGAP", DXF_HEADER_VARIABLE_DOUBLE, 1, offsetof (DxfHeader, DimGAP), 0, DXF_HEADER_ANY_VERSION },
+        { "$DIMLUNIT", DXF_HEADER_VARIABLE_INT, 1, offsetof (DxfHeader, DimLUNIT), AC1015, DXF_HEADER_ANY_VERSION },
+        { "$DIMSCALE", DXF_HEADER_VARIABLE_DOUBLE, 1, offsetof (DxfHeader, DimSCALE), 0, DXF_HEADER_ANY_VERSION },
+        { "$DIMSTYLE", DXF_HEADER_VARIABLE_STRING, 1, offsetof (DxfHeader, DimSTYLE), 0, DXF_HEADER_ANY_VERSION },
+        { "$DIMTXT", DXF_HEADER_VARIABLE_DOUBLE, 1, offsetof (DxfHeader, DimTXT), 0, DXF_HEADER_ANY_VERSION },
+        { "$DISPSILH", DXF_HEADER_VARIABLE_INT, 1, offsetof (DxfHeader, DispSilH), 0, AC1015 },
+        { "$DRAGMODE", DXF_HEADER_VARIABLE_INT, 1, offsetof (DxfHeader, DragMode), 0, AC1014 },
+        { "$DWGCODEPAGE", DXF_HEADER_VARIABLE_STRING, 1, offsetof (DxfHeader, DWGCodePage), AC1012, DXF_HEADER_ANY_VERSION },
+        { "$EXTMAX", DXF_HEADER_VARIABLE_DOUBLE, 3, offsetof (DxfHeader, ExtMax.x0), 0, DXF_HEADER_ANY_VERSION },
+        { "$EXTMIN", DXF_HEADER_VARIABLE_DOUBLE, 3, offsetof (DxfHeader, ExtMin.x0), 0, DXF_HEADER_ANY_VERSION },
+        { "$FILLMODE", DXF_HEADER_VARIABLE_INT, 1, offsetof (DxfHeader, FillMode), 0, DXF_HEADER_ANY_VERSION },
+        { "$GRIDMODE", DXF_HEADER_VARIABLE_INT, 1, offsetof (DxfHeader, GridMode), AC1009, DXF_HEADER_ANY_VERSION },
+        { "$GRIDUNIT", DXF_HEADER_VARIABLE_DOUBLE, 2, offsetof (DxfHeader, GridUnit.x0), AC1009, DXF_HEADER_ANY_VERSION },
+        { "$HANDSEED", DXF_HEADER_VARIABLE_STRING, 1, offsetof (DxfHeader, HandSeed), 0, DXF_HEADER_ANY_VERSION },
+        { "$INSBASE", DXF_HEADER_VARIABLE_DOUBLE, 3, offsetof (DxfHeader, InsBase.x0), 0, DXF_HEADER_ANY_VERSION },
+        { "$INSUNITS", DXF_HEADER_VARIABLE_INT, 1, offsetof (DxfHeader, InsUnits), AC1015, DXF_HEADER_ANY_VERSION },
+        { "$LIMMAX", DXF_HEADER_VARIABLE_DOUBLE, 2, offsetof (DxfHeader, LimMax.x0), 0, DXF_HEADER_ANY_VERSION },
+        { "$LIMMIN", DXF_HEADER_VARIABLE_DOUBLE, 2, offsetof (DxfHeader, LimMin.x0), 0, DXF_HEADER_ANY_VERSION },
+        { "$LTSCALE", DXF_HEADER_VARIABLE_DOUBLE, 1, offsetof (DxfHeader, LTScale), 0, DXF_HEADER_ANY_VERSION },
+        { "$LUNITS", DXF_HEADER_VARIABLE_INT, 1, offsetof (DxfHeader, LUnits), 0, DXF_HEADER_ANY_VERSION },
+        { "$LUPREC", DXF_HEADER_VARIABLE_INT, 1, offsetof (DxfHeader, LUPrec), 0, DXF_HEADER_ANY_VERSION },
+        { "$MIRRTEXT", DXF_HEADER_VARIABLE_INT, 1, offsetof (DxfHeader, MirrText), 0, DXF_HEADER_ANY_VERSION },
+        { "$ORTHOMODE", DXF_HEADER_VARIABLE_INT, 1, offsetof (DxfHeader, OrthoMode), 0, DXF_HEADER_ANY_VERSION },
+        { "$OSMODE", DXF_HEADER_VARIABLE_INT, 1, offsetof (DxfHeader, OSMode), 0, AC1014 },
+        { "$PLIMMAX", DXF_HEADER_VARIABLE_DOUBLE, 2, offsetof (DxfHeader, PLimMax.x0), 0, DXF_HEADER_ANY_VERSION },
+        { "$PLIMMIN", DXF_HEADER_VARIABLE_DOUBLE, 2, offsetof (DxfHeader, PLimMin.x0), 0, DXF_HEADER_ANY_VERSION },
+        { "$QTEXTMODE", DXF_HEADER_VARIABLE_INT, 1, offsetof (DxfHeader, QTextMode), 0, DXF_HEADER_ANY_VERSION },
+        { "$REGENMODE", DXF_HEADER_VARIABLE_INT, 1, offsetof (DxfHeader, RegenMode), 0, DXF_HEADER_ANY_VERSION },
+        { "$SPLINESEGS", DXF_HEADER_VARIABLE_INT, 1, offsetof (DxfHeader, SPLineSegs), 0, DXF_HEADER_ANY_VERSION },
+        { "$TEXTSIZE", DXF_HEADER_VARIABLE_DOUBLE, 1, offsetof (DxfHeader, TextSize), 0, DXF_HEADER_ANY_VERSION },
+        { "$TEXTSTYLE", DXF_HEADER_VARIABLE_STRING, 1, offsetof (DxfHeader, TextStyle), 0, DXF_HEADER_ANY_VERSION },
+        { "$TRACEWID", DXF_HEADER_VARIABLE_DOUBLE, 1, offsetof (DxfHeader, TraceWid), 0, DXF_HEADER_ANY_VERSION }
+};
+
+#define DXF_HEADER_VARIABLES (sizeof (dxf_header_variables) / sizeof (dxf_header_variables[0]))
+
+
+/*!
+ * \brief Compare the name \c key with the name of a header variable,
+ * for bsearch ().
+ */
+static int
+dxf_header_variable_compare
+(
+        const void *key,
+                /*!< the name. */
+        const void *variable
+                /*!< a DxfHeaderVariable. */
+)
+{
+        return (strcmp ((const char *) key,
+          ((const DxfHeaderVariable *) variable)->name));
+}
 
 
 /*!
@@ -722,109 +842,218 @@ dxf_header_write_metric_new
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        fprintf (fp->fp, "  0\nSECTION\n");
-        fprintf (fp->fp, "  2\nHEADER\n");
-        fprintf (fp->fp, "  9\n$ACADVER\n  1\nAC1014\n");
-        fprintf (fp->fp, "  9\n$ACADMAINTVER\n 70\n     0\n");
-        fprintf (fp->fp, "  9\n$DWGCODEPAGE\n  3\nANSI_1252\n");
-        fprintf (fp->fp, "  9\n$INSBASE\n 10\n0.0\n 20\n0.0\n 30\n0.0\n");
-        fprintf (fp->fp, "  9\n$EXTMIN\n 10\n-0.012816\n 20\n-0.009063\n 30\n-0.001526\n");
-        fprintf (fp->fp, "  9\n$EXTMAX\n 10\n88.01056\n 20\n35.022217\n 30\n0.0\n");
-        fprintf (fp->fp, "  9\n$LIMMIN\n 10\n0.0\n 20\n0.0\n");
-        fprintf (fp->fp, "  9\n$LIMMAX\n 10\n420.0\n 20\n297.0\n");
-        fprintf (fp->fp, "  9\n$ORTHOMODE\n 70\n     0\n");
-        fprintf (fp->fp, "  9\n$REGENMODE\n 70\n     1\n");
-        fprintf (fp->fp, "  9\n$FILLMODE\n 70\n     1\n");
-        fprintf (fp->fp, "  9\n$QTEXTMODE\n 70\n     0\n");
-        fprintf (fp->fp, "  9\n$MIRRTEXT\n 70\n     1\n");
-        fprintf (fp->fp, "  9\n$DRAGMODE\n 70\n     2\n");
-        fprintf (fp->fp, "  9\n$LTSCALE\n 40\n1.0\n");
-        fprintf (fp->fp, "  9\n$OSMODE\n 70\n   125\n");
-        fprintf (fp->fp, "  9\n$ATTMODE\n 70\n     1\n");
-        fprintf (fp->fp, "  9\n$TEXTSIZE\n 40\n2.5\n");
-        fprintf (fp->fp, "  9\n$TRACEWID\n 40\n1.0\n");
-        fprintf (fp->fp, "  9\n$TEXTSTYLE\n  7\nSTANDARD\n");
-        fprintf (fp->fp, "  9\n$CLAYER\n  8\n0\n");
-        fprintf (fp->fp, "  9\n$CELTYPE\n  6\nBYLAYER\n");
-        fprintf (fp->fp, "  9\n$CECOLOR\n 62\n   256\n");
-        fprintf (fp->fp, "  9\n$CELTSCALE\n 40\n1.0\n");
-        fprintf (fp->fp, "  9\n$DELOBJ\n 70\n     1\n");
-        fprintf (fp->fp, "  9\n$DISPSILH\n 70\n     0\n");
-        fprintf (fp->fp, "  9\n$DIMSCALE\n 40\n1.0\n");
-        fprintf (fp->fp, "  9\n$DIMASZ\n 40\n2.5\n");
-        fprintf (fp->fp, "  9\n$DIMEXO\n 40\n0.625\n");
-        fprintf (fp->fp, "  9\n$DIMDLI\n 40\n3.75\n");
-        fprintf (fp->fp, "  9\n$DIMRND\n 40\n0.0\n");
-        fprintf (fp->fp, "  9\n$DIMDLE\n 40\n0.0\n");
-        fprintf (fp->fp, "  9\n$DIMEXE\n 40\n1.25\n");
-        fprintf (fp->fp, "  9\n$DIMTP\n 40\n0.0\n");
-        fprintf (fp->fp, "  9\n$DIMTM\n 40\n0.0\n");
-        fprintf (fp->fp, "  9\n$DIMTXT\n 40\n2.5\n");
-        fprintf (fp->fp, "  9\n$DIMCEN\n 40\n2.5\n");
-        fprintf (fp->fp, "  9\n$DIMTSZ\n 40\n0.0\n");
-        fprintf (fp->fp, "  9\n$DIMTOL\n 70\n     0\n");
-        fprintf (fp->fp, "  9\n$DIMLIM\n 70\n     0\n");
-        fprintf (fp->fp, "  9\n$DIMTIH\n 70\n     0\n");
-        fprintf (fp->fp, "  9\n$DIMTOH\n 70\n     0\n");
-        fprintf (fp->fp, "  9\n$DIMSE1\n 70\n     0\n");
-        fprintf (fp->fp, "  9\n$DIMSE2\n 70\n     0\n");
-        fprintf (fp->fp, "  9\n$DIMTAD\n 70\n     1\n");
-        fprintf (fp->fp, "  9\n$DIMZIN\n 70\n     8\n");
-        fprintf (fp->fp, "  9\n$DIMBLK\n  1\n\n");
-        fprintf (fp->fp, "  9\n$DIMASO\n 70\n     1\n");
-        fprintf (fp->fp, "  9\n$DIMSHO\n 70\n     1\n");
-        fprintf (fp->fp, "  9\n$DIMPOST\n  1\n\n");
-        fprintf (fp->fp, "  9\n$DIMAPOST\n  1\n\n");
-        fprintf (fp->fp, "  9\n$DIMALT\n 70\n     0\n");
-        fprintf (fp->fp, "  9\n$DIMALTD\n 70\n     4\n");
-        fprintf (fp->fp, "  9\n$DIMALTF\n 40\n0.0394\n");
-        fprintf (fp->fp, "  9\n$DIMLFAC\n 40\n1.0\n");
-        fprintf (fp->fp, "  9\n$DIMTOFL\n 70\n     1\n");
-        fprintf (fp->fp, "  9\n$DIMTVP\n 40\n0.0\n");
-        fprintf (fp->fp, "  9\n$DIMTIX\n 70\n     0\n");
-        fprintf (fp->fp, "  9\n$DIMSOXD\n 70\n     0\n");
-        fprintf (fp->fp, "  9\n$DIMSAH\n 70\n     0\n");
-        fprintf (fp->fp, "  9\n$DIMBLK1\n  1\n\n");
-        fprintf (fp->fp, "  9\n$DIMBLK2\n  1\n\n");
-        fprintf (fp->fp, "  9\n$DIMSTYLE\n  2\nSTANDARD\n");
-        fprintf (fp->fp, "  9\n$DIMCLRD\n 70\n     0\n");
-        fprintf (fp->fp, "  9\n$DIMCLRE\n 70\n     0\n");
-        fprintf (fp->fp, "  9\n$DIMCLRT\n 70\n     0\n");
-        fprintf (fp->fp, "  9\n$DIMTFAC\n 40\n1.0\n");
-        fprintf (fp->fp, "  9\n$DIMGAP\n 40\n0.625\n");
-        fprintf (fp->fp, "  9\n$DIMJUST\n 70\n     0\n");
-        fprintf (fp->fp, "  9\n$DIMSD1\n 70\n     0\n");
-        fprintf (fp->fp, "  9\n$DIMSD2\n 70\n     0\n");
-        fprintf (fp->fp, "  9\n$DIMTOLJ\n 70\n     1\n");
-        fprintf (fp->fp, "  9\n$DIMTZIN\n 70\n     0\n");
-        fprintf (fp->fp, "  9\n$DIMALTZ\n 70\n     0\n");
-        fprintf (fp->fp, "  9\n$DIMALTTZ\n 70\n     0\n");
-        fprintf (fp->fp, "  9\n$DIMFIT\n 70\n     3\n");
-        fprintf (fp->fp, "  9\n$DIMUPT\n 70\n     0\n");
-        fprintf (fp->fp, "  9\n$DIMUNIT\n 70\n     2\n");
-        fprintf (fp->fp, "  9\n$DIMDEC\n 70\n     4\n");
-        fprintf (fp->fp, "  9\n$DIMTDEC\n 70\n     4\n");
-        fprintf (fp->fp, "  9\n$DIMALTU\n 70\n     2\n");
-        fprintf (fp->fp, "  9\n$DIMALTTD\n 70\n     2\n");
-        fprintf (fp->fp, "  9\n$DIMTXSTY\n  7\nSTANDARD\n");
-        fprintf (fp->fp, "  9\n$DIMAUNIT\n 70\n     0\n");
-        fprintf (fp->fp, "  9\n$LUNITS\n 70\n     2\n");
-        fprintf (fp->fp, "  9\n$LUPREC\n 70\n     4\n");
-        fprintf (fp->fp, "  9\n$SKETCHINC\n 40\n1.0\n");
-        fprintf (fp->fp, "  9\n$FILLETRAD\n 40\n1.0\n");
-        fprintf (fp->fp, "  9\n$AUNITS\n 70\n     0\n");
-        fprintf (fp->fp, "  9\n$AUPREC\n 70\n     0\n");
-        fprintf (fp->fp, "  9\n$MENU\n  1\n.\n");
-        fprintf (fp->fp, "  9\n$ELEVATION\n 40\n0.0\n");
-        fprintf (fp->fp, "  9\n$PELEVATION\n 40\n0.0\n");
-        fprintf (fp->fp, "  9\n$THICKNESS\n 40\n0.0\n");
-        fprintf (fp->fp, "  9\n$LIMCHECK\n 70\n     0\n");
-        fprintf (fp->fp, "  9\n$BLIPMODE\n 70\n     0\n");
-        fprintf (fp->fp, "  9\n$CHAMFERA\n 40\n10.0\n");
-        fprintf (fp->fp, "  9\n$CHAMFERB\n 40\n10.0\n");
-        fprintf (fp->fp, "  9\n$CHAMFERC\n 40\n0.0\n");
-        fprintf (fp->fp, "  9\n$CHAMFERD\n 40\n0.0\n");
-        fprintf (fp->fp, "  9\n$SKPOLY\n 70\n     0\n");
+        dxf_write_string (fp, 0, "SECTION");
+        dxf_write_string (fp, 2, "HEADER");
+        dxf_write_string (fp, 9, "$ACADVER");
+        dxf_write_string (fp, 1, "AC1014");
+        dxf_write_string (fp, 9, "$ACADMAINTVER");
+        dxf_write_string (fp, 70, "     0");
+        dxf_write_string (fp, 9, "$DWGCODEPAGE");
+        dxf_write_string (fp, 3, "ANSI_1252");
+        dxf_write_string (fp, 9, "$INSBASE");
+        dxf_write_string (fp, 10, "0.0");
+        dxf_write_string (fp, 20, "0.0");
+        dxf_write_string (fp, 30, "0.0");
+        dxf_write_string (fp, 9, "$EXTMIN");
+        dxf_write_string (fp, 10, "-0.012816");
+        dxf_write_string (fp, 20, "-0.009063");
+        dxf_write_string (fp, 30, "-0.001526");
+        dxf_write_string (fp, 9, "$EXTMAX");
+        dxf_write_string (fp, 10, "88.01056");
+        dxf_write_string (fp, 20, "35.022217");
+        dxf_write_string (fp, 30, "0.0");
+        dxf_write_string (fp, 9, "$LIMMIN");
+        dxf_write_string (fp, 10, "0.0");
+        dxf_write_string (fp, 20, "0.0");
+        dxf_write_string (fp, 9, "$LIMMAX");
+        dxf_write_string (fp, 10, "420.0");
+        dxf_write_string (fp, 20, "297.0");
+        dxf_write_string (fp, 9, "$ORTHOMODE");
+        dxf_write_string (fp, 70, "     0");
+        dxf_write_string (fp, 9, "$REGENMODE");
+        dxf_write_string (fp, 70, "     1");
+        dxf_write_string (fp, 9, "$FILLMODE");
+        dxf_write_string (fp, 70, "     1");
+        dxf_write_string (fp, 9, "$QTEXTMODE");
+        dxf_write_string (fp, 70, "     0");
+        dxf_write_string (fp, 9, "$MIRRTEXT");
+        dxf_write_string (fp, 70, "     1");
+        dxf_write_string (fp, 9, "$DRAGMODE");
+        dxf_write_string (fp, 70, "     2");
+        dxf_write_string (fp, 9, "$LTSCALE");
+        dxf_write_string (fp, 40, "1.0");
+        dxf_write_string (fp, 9, "$OSMODE");
+        dxf_write_string (fp, 70, "   125");
+        dxf_write_string (fp, 9, "$ATTMODE");
+        dxf_write_string (fp, 70, "     1");
+        dxf_write_string (fp, 9, "$TEXTSIZE");
+        dxf_write_string (fp, 40, "2.5");
+        dxf_write_string (fp, 9, "$TRACEWID");
+        dxf_write_string (fp, 40, "1.0");
+        dxf_write_string (fp, 9, "$TEXTSTYLE");
+        dxf_write_string (fp, 7, "STANDARD");
+        dxf_write_string (fp, 9, "$CLAYER");
+        dxf_write_string (fp, 8, "0");
+        dxf_write_string (fp, 9, "$CELTYPE");
+        dxf_write_string (fp, 6, "BYLAYER");
+        dxf_write_string (fp, 9, "$CECOLOR");
+        dxf_write_string (fp, 62, "   256");
+        dxf_write_string (fp, 9, "$CELTSCALE");
+        dxf_write_string (fp, 40, "1.0");
+        dxf_write_string (fp, 9, "$DELOBJ");
+        dxf_write_string (fp, 70, "     1");
+        dxf_write_string (fp, 9, "$DISPSILH");
+        dxf_write_string (fp, 70, "     0");
+        dxf_write_string (fp, 9, "$DIMSCALE");
+        dxf_write_string (fp, 40, "1.0");
+        dxf_write_string (fp, 9, "$DIMASZ");
+        dxf_write_string (fp, 40, "2.5");
+        dxf_write_string (fp, 9, "$DIMEXO");
+        dxf_write_string (fp, 40, "0.625");
+        dxf_write_string (fp, 9, "$DIMDLI");
+        dxf_write_string (fp, 40, "3.75");
+        dxf_write_string (fp, 9, "$DIMRND");
+        dxf_write_string (fp, 40, "0.0");
+        dxf_write_string (fp, 9, "$DIMDLE");
+        dxf_write_string (fp, 40, "0.0");
+        dxf_write_string (fp, 9, "$DIMEXE");
+        dxf_write_string (fp, 40, "1.25");
+        dxf_write_string (fp, 9, "$DIMTP");
+        dxf_write_string (fp, 40, "0.0");
+        dxf_write_string (fp, 9, "$DIMTM");
+        dxf_write_string (fp, 40, "0.0");
+        dxf_write_string (fp, 9, "$DIMTXT");
+        dxf_write_string (fp, 40, "2.5");
+        dxf_write_string (fp, 9, "$DIMCEN");
+        dxf_write_string (fp, 40, "2.5");
+        dxf_write_string (fp, 9, "$DIMTSZ");
+        dxf_write_string (fp, 40, "0.0");
+        dxf_write_string (fp, 9, "$DIMTOL");
+        dxf_write_string (fp, 70, "     0");
+        dxf_write_string (fp, 9, "$DIMLIM");
+        dxf_write_string (fp, 70, "     0");
+        dxf_write_string (fp, 9, "$DIMTIH");
+        dxf_write_string (fp, 70, "     0");
+        dxf_write_string (fp, 9, "$DIMTOH");
+        dxf_write_string (fp, 70, "     0");
+        dxf_write_string (fp, 9, "$DIMSE1");
+        dxf_write_string (fp, 70, "     0");
+        dxf_write_string (fp, 9, "$DIMSE2");
+        dxf_write_string (fp, 70, "     0");
+        dxf_write_string (fp, 9, "$DIMTAD");
+        dxf_write_string (fp, 70, "     1");
+        dxf_write_string (fp, 9, "$DIMZIN");
+        dxf_write_string (fp, 70, "     8");
+        dxf_write_string (fp, 9, "$DIMBLK");
+        dxf_write_string (fp, 1, "");
+        dxf_write_string (fp, 9, "$DIMASO");
+        dxf_write_string (fp, 70, "     1");
+        dxf_write_string (fp, 9, "$DIMSHO");
+        dxf_write_string (fp, 70, "     1");
+        dxf_write_string (fp, 9, "$DIMPOST");
+        dxf_write_string (fp, 1, "");
+        dxf_write_string (fp, 9, "$DIMAPOST");
+        dxf_write_string (fp, 1, "");
+        dxf_write_string (fp, 9, "$DIMALT");
+        dxf_write_string (fp, 70, "     0");
+        dxf_write_string (fp, 9, "$DIMALTD");
+        dxf_write_string (fp, 70, "     4");
+        dxf_write_string (fp, 9, "$DIMALTF");
+        dxf_write_string (fp, 40, "0.0394");
+        dxf_write_string (fp, 9, "$DIMLFAC");
+        dxf_write_string (fp, 40, "1.0");
+        dxf_write_string (fp, 9, "$DIMTOFL");
+        dxf_write_string (fp, 70, "     1");
+        dxf_write_string (fp, 9, "$DIMTVP");
+        dxf_write_string (fp, 40, "0.0");
+        dxf_write_string (fp, 9, "$DIMTIX");
+        dxf_write_string (fp, 70, "     0");
+        dxf_write_string (fp, 9, "$DIMSOXD");
+        dxf_write_string (fp, 70, "     0");
+        dxf_write_string (fp, 9, "$DIMSAH");
+        dxf_write_string (fp, 70, "     0");
+        dxf_write_string (fp, 9, "$DIMBLK1");
+        dxf_write_string (fp, 1, "");
+        dxf_write_string (fp, 9, "$DIMBLK2");
+        dxf_write_string (fp, 1, "");
+        dxf_write_string (fp, 9, "$DIMSTYLE");
+        dxf_write_string (fp, 2, "STANDARD");
+        dxf_write_string (fp, 9, "$DIMCLRD");
+        dxf_write_string (fp, 70, "     0");
+        dxf_write_string (fp, 9, "$DIMCLRE");
+        dxf_write_string (fp, 70, "     0");
+        dxf_write_string (fp, 9, "$DIMCLRT");
+        dxf_write_string (fp, 70, "     0");
+        dxf_write_string (fp, 9, "$DIMTFAC");
+        dxf_write_string (fp, 40, "1.0");
+        dxf_write_string (fp, 9, "$DIMGAP");
+        dxf_write_string (fp, 40, "0.625");
+        dxf_write_string (fp, 9, "$DIMJUST");
+        dxf_write_string (fp, 70, "     0");
+        dxf_write_string (fp, 9, "$DIMSD1");
+        dxf_write_string (fp, 70, "     0");
+        dxf_write_string (fp, 9, "$DIMSD2");
+        dxf_write_string (fp, 70, "     0");
+        dxf_write_string (fp, 9, "$DIMTOLJ");
+        dxf_write_string (fp, 70, "     1");
+        dxf_write_string (fp, 9, "$DIMTZIN");
+        dxf_write_string (fp, 70, "     0");
+        dxf_write_string (fp, 9, "$DIMALTZ");
+        dxf_write_string (fp, 70, "     0");
+        dxf_write_string (fp, 9, "$DIMALTTZ");
+        dxf_write_string (fp, 70, "     0");
+        dxf_write_string (fp, 9, "$DIMFIT");
+        dxf_write_string (fp, 70, "     3");
+        dxf_write_string (fp, 9, "$DIMUPT");
+        dxf_write_string (fp, 70, "     0");
+        dxf_write_string (fp, 9, "$DIMUNIT");
+        dxf_write_string (fp, 70, "     2");
+        dxf_write_string (fp, 9, "$DIMDEC");
+        dxf_write_string (fp, 70, "     4");
+        dxf_write_string (fp, 9, "$DIMTDEC");
+        dxf_write_string (fp, 70, "     4");
+        dxf_write_string (fp, 9, "$DIMALTU");
+        dxf_write_string (fp, 70, "     2");
+        dxf_write_string (fp, 9, "$DIMALTTD");
+        dxf_write_string (fp, 70, "     2");
+        dxf_write_string (fp, 9, "$DIMTXSTY");
+        dxf_write_string (fp, 7, "STANDARD");
+        dxf_write_string (fp, 9, "$DIMAUNIT");
+        dxf_write_string (fp, 70, "     0");
+        dxf_write_string (fp, 9, "$LUNITS");
+        dxf_write_string (fp, 70, "     2");
+        dxf_write_string (fp, 9, "$LUPREC");
+        dxf_write_string (fp, 70, "     4");
+        dxf_write_string (fp, 9, "$SKETCHINC");
+        dxf_write_string (fp, 40, "1.0");
+        dxf_write_string (fp, 9, "$FILLETRAD");
+        dxf_write_string (fp, 40, "1.0");
+        dxf_write_string (fp, 9, "$AUNITS");
+        dxf_write_string (fp, 70, "     0");
+        dxf_write_string (fp, 9, "$AUPREC");
+        dxf_write_string (fp, 70, "     0");
+        dxf_write_string (fp, 9, "$MENU");
+        dxf_write_string (fp, 1, ".");
+        dxf_write_string (fp, 9, "$ELEVATION");
+        dxf_write_string (fp, 40, "0.0");
+        dxf_write_string (fp, 9, "$PELEVATION");
+        dxf_write_string (fp, 40, "0.0");
+        dxf_write_string (fp, 9, "$THICKNESS");
+        dxf_write_string (fp, 40, "0.0");
+        dxf_write_string (fp, 9, "$LIMCHECK");
+        dxf_write_string (fp, 70, "     0");
+        dxf_write_string (fp, 9, "$BLIPMODE");
+        dxf_write_string (fp, 70, "     0");
+        dxf_write_string (fp, 9, "$CHAMFERA");
+        dxf_write_string (fp, 40, "10.0");
+        dxf_write_string (fp, 9, "$CHAMFERB");
+        dxf_write_string (fp, 40, "10.0");
+        dxf_write_string (fp, 9, "$CHAMFERC");
+        dxf_write_string (fp, 40, "0.0");
+        dxf_write_string (fp, 9, "$CHAMFERD");
+        dxf_write_string (fp, 40, "0.0");
+        dxf_write_string (fp, 9, "$SKPOLY");
+        dxf_write_string (fp, 70, "     0");
         time_t now;
         if (time(&now) != (time_t)(-1))
         {
@@ -836,72 +1065,155 @@ dxf_header_write_metric_new
             fraction_day=(current_time->tm_hour+(current_time->tm_min/60.0)+(current_time->tm_sec/3600.0))/24.0;
             /* Transforms the current local clock time in fraction of day.*/
 
-            fprintf (fp->fp, "  9\n$TDCREATE\n 40\n%7.9f\n", JD+fraction_day);
-            fprintf (fp->fp, "  9\n$TDUPDATE\n 40\n%7.9f\n", JD+fraction_day);
+            dxf_write_string (fp, 9, "$TDCREATE");
+            dxf_write_double (fp, 40, JD+fraction_day);
+            dxf_write_string (fp, 9, "$TDUPDATE");
+            dxf_write_double (fp, 40, JD+fraction_day);
         }
-        fprintf (fp->fp, "  9\n$TDINDWG\n 40\n0.0000000000\n");
-        fprintf (fp->fp, "  9\n$TDUSRTIMER\n 40\n0.0000000000\n");
+        dxf_write_string (fp, 9, "$TDINDWG");
+        dxf_write_string (fp, 40, "0.0000000000");
+        dxf_write_string (fp, 9, "$TDUSRTIMER");
+        dxf_write_string (fp, 40, "0.0000000000");
         /* In a new DXF file, $TDINDWG and $TDUSERTIMER are always 0, can change the decimal precision in according to the DXF version.*/
-        fprintf (fp->fp, "  9\n$USRTIMER\n 70\n     1\n");
-        fprintf (fp->fp, "  9\n$ANGBASE\n 50\n0.0\n");
-        fprintf (fp->fp, "  9\n$ANGDIR\n 70\n     0\n");
-        fprintf (fp->fp, "  9\n$PDMODE\n 70\n    98\n");
-        fprintf (fp->fp, "  9\n$PDSIZE\n 40\n0.0\n");
-        fprintf (fp->fp, "  9\n$PLINEWID\n 40\n0.0\n");
-        fprintf (fp->fp, "  9\n$COORDS\n 70\n     2\n");
-        fprintf (fp->fp, "  9\n$SPLFRAME\n 70\n     0\n");
-        fprintf (fp->fp, "  9\n$SPLINETYPE\n 70\n     6\n");
-        fprintf (fp->fp, "  9\n$SPLINESEGS\n 70\n     8\n");
-        fprintf (fp->fp, "  9\n$ATTDIA\n 70\n     0\n");
-        fprintf (fp->fp, "  9\n$ATTREQ\n 70\n     1\n");
-        fprintf (fp->fp, "  9\n$HANDLING\n 70\n     1\n");
-        fprintf (fp->fp, "  9\n$HANDSEED\n  5\n262\n");
-        fprintf (fp->fp, "  9\n$SURFTAB1\n 70\n     6\n");
-        fprintf (fp->fp, "  9\n$SURFTAB2\n 70\n     6\n");
-        fprintf (fp->fp, "  9\n$SURFTYPE\n 70\n     6\n");
-        fprintf (fp->fp, "  9\n$SURFU\n 70\n     6\n");
-        fprintf (fp->fp, "  9\n$SURFV\n 70\n     6\n");
-        fprintf (fp->fp, "  9\n$UCSNAME\n  2\n\n");
-        fprintf (fp->fp, "  9\n$UCSORG\n 10\n0.0\n 20\n0.0\n 30\n0.0\n");
-        fprintf (fp->fp, "  9\n$UCSXDIR\n 10\n1.0\n 20\n0.0\n 30\n0.0\n");
-        fprintf (fp->fp, "  9\n$UCSYDIR\n 10\n0.0\n 20\n1.0\n 30\n0.0\n");
-        fprintf (fp->fp, "  9\n$PUCSNAME\n  2\n\n");
-        fprintf (fp->fp, "  9\n$PUCSORG\n 10\n0.0\n 20\n0.0\n 30\n0.0\n");
-        fprintf (fp->fp, "  9\n$PUCSXDIR\n 10\n1.0\n 20\n0.0\n 30\n0.0\n");
-        fprintf (fp->fp, "  9\n$PUCSYDIR\n 10\n0.0\n 20\n1.0\n 30\n0.0\n");
-        fprintf (fp->fp, "  9\n$USERI1\n 70\n     0\n");
-        fprintf (fp->fp, "  9\n$USERI2\n 70\n     0\n");
-        fprintf (fp->fp, "  9\n$USERI3\n 70\n     0\n");
-        fprintf (fp->fp, "  9\n$USERI4\n 70\n     0\n");
-        fprintf (fp->fp, "  9\n$USERI5\n 70\n     0\n");
-        fprintf (fp->fp, "  9\n$USERR1\n 40\n0.0\n");
-        fprintf (fp->fp, "  9\n$USERR2\n 40\n0.0\n");
-        fprintf (fp->fp, "  9\n$USERR3\n 40\n0.0\n");
-        fprintf (fp->fp, "  9\n$USERR4\n 40\n0.0\n");
-        fprintf (fp->fp, "  9\n$USERR5\n 40\n0.0\n");
-        fprintf (fp->fp, "  9\n$WORLDVIEW\n 70\n     1\n");
-        fprintf (fp->fp, "  9\n$SHADEDGE\n 70\n     3\n");
-        fprintf (fp->fp, "  9\n$SHADEDIF\n 70\n    70\n");
-        fprintf (fp->fp, "  9\n$TILEMODE\n 70\n     1\n");
-        fprintf (fp->fp, "  9\n$MAXACTVP\n 70\n    48\n");
-        fprintf (fp->fp, "  9\n$PINSBASE\n 10\n0.0\n 20\n0.0\n 30\n0.0\n");
-        fprintf (fp->fp, "  9\n$PLIMCHECK\n 70\n     0\n");
-        fprintf (fp->fp, "  9\n$PEXTMIN\n 10\n1.000000E+20\n 20\n1.000000E+20\n 30\n1.000000E+20\n");
-        fprintf (fp->fp, "  9\n$PEXTMAX\n 10\n-1.000000E+20\n 20\n-1.000000E+20\n 30\n-1.000000E+20\n");
-        fprintf (fp->fp, "  9\n$PLIMMIN\n 10\n0.0\n 20\n0.0\n");
-        fprintf (fp->fp, "  9\n$PLIMMAX\n 10\n420.0\n 20\n297.0");
-        fprintf (fp->fp, "  9\n$UNITMODE\n 70\n     0\n");
-        fprintf (fp->fp, "  9\n$VISRETAIN\n 70\n     1\n");
-        fprintf (fp->fp, "  9\n$PLINEGEN\n 70\n     0\n");
-        fprintf (fp->fp, "  9\n$PSLTSCALE\n 70\n     1\n");
-        fprintf (fp->fp, "  9\n$TREEDEPTH\n 70\n  3020\n");
-        fprintf (fp->fp, "  9\n$PICKSTYLE\n 70\n     1\n");
-        fprintf (fp->fp, "  9\n$CMLSTYLE\n  2\nSTANDARD\n");
-        fprintf (fp->fp, "  9\n$CMLJUST\n 70\n     0\n");
-        fprintf (fp->fp, "  9\n$CMLSCALE\n 40\n1.0\n");
-        fprintf (fp->fp, "  9\n$PROXYGRAPHICS\n 70\n     1\n");
-        fprintf (fp->fp, "  9\n$MEASUREMENT\n 70\n     0\n");
-        fprintf (fp->fp, "  0\nENDSEC\n");
+        dxf_write_string (fp, 9, "$USRTIMER");
+        dxf_write_string (fp, 70, "     1");
+        dxf_write_string (fp, 9, "$ANGBASE");
+        dxf_write_string (fp, 50, "0.0");
+        dxf_write_string (fp, 9, "$ANGDIR");
+        dxf_write_string (fp, 70, "     0");
+        dxf_write_string (fp, 9, "$PDMODE");
+        dxf_write_string (fp, 70, "    98");
+        dxf_write_string (fp, 9, "$PDSIZE");
+        dxf_write_string (fp, 40, "0.0");
+        dxf_write_string (fp, 9, "$PLINEWID");
+        dxf_write_string (fp, 40, "0.0");
+        dxf_write_string (fp, 9, "$COORDS");
+        dxf_write_string (fp, 70, "     2");
+        dxf_write_string (fp, 9, "$SPLFRAME");
+        dxf_write_string (fp, 70, "     0");
+        dxf_write_string (fp, 9, "$SPLINETYPE");
+        dxf_write_string (fp, 70, "     6");
+        dxf_write_string (fp, 9, "$SPLINESEGS");
+        dxf_write_string (fp, 70, "     8");
+        dxf_write_string (fp, 9, "$ATTDIA");
+        dxf_write_string (fp, 70, "     0");
+        dxf_write_string (fp, 9, "$ATTREQ");
+        dxf_write_string (fp, 70, "     1");
+        dxf_write_string (fp, 9, "$HANDLING");
+        dxf_write_string (fp, 70, "     1");
+        dxf_write_string (fp, 9, "$HANDSEED");
+        dxf_write_string (fp, 5, "262");
+        dxf_write_string (fp, 9, "$SURFTAB1");
+        dxf_write_string (fp, 70, "     6");
+        dxf_write_string (fp, 9, "$SURFTAB2");
+        dxf_write_string (fp, 70, "     6");
+        dxf_write_string (fp, 9, "$SURFTYPE");
+        dxf_write_string (fp, 70, "     6");
+        dxf_write_string (fp, 9, "$SURFU");
+        dxf_write_string (fp, 70, "     6");
+        dxf_write_string (fp, 9, "$SURFV");
+        dxf_write_string (fp, 70, "     6");
+        dxf_write_string (fp, 9, "$UCSNAME");
+        dxf_write_string (fp, 2, "");
+        dxf_write_string (fp, 9, "$UCSORG");
+        dxf_write_string (fp, 10, "0.0");
+        dxf_write_string (fp, 20, "0.0");
+        dxf_write_string (fp, 30, "0.0");
+        dxf_write_string (fp, 9, "$UCSXDIR");
+        dxf_write_string (fp, 10, "1.0");
+        dxf_write_string (fp, 20, "0.0");
+        dxf_write_string (fp, 30, "0.0");
+        dxf_write_string (fp, 9, "$UCSYDIR");
+        dxf_write_string (fp, 10, "0.0");
+        dxf_write_string (fp, 20, "1.0");
+        dxf_write_string (fp, 30, "0.0");
+        dxf_write_string (fp, 9, "$PUCSNAME");
+        dxf_write_string (fp, 2, "");
+        dxf_write_string (fp, 9, "$PUCSORG");
+        dxf_write_string (fp, 10, "0.0");
+        dxf_write_string (fp, 20, "0.0");
+        dxf_write_string (fp, 30, "0.0");
+        dxf_write_string (fp, 9, "$PUCSXDIR");
+        dxf_write_string (fp, 10, "1.0");
+        dxf_write_string (fp, 20, "0.0");
+        dxf_write_string (fp, 30, "0.0");
+        dxf_write_string (fp, 9, "$PUCSYDIR");
+        dxf_write_string (fp, 10, "0.0");
+        dxf_write_string (fp, 20, "1.0");
+        dxf_write_string (fp, 30, "0.0");
+        dxf_write_string (fp, 9, "$USERI1");
+        dxf_write_string (fp, 70, "     0");
+        dxf_write_string (fp, 9, "$USERI2");
+        dxf_write_string (fp, 70, "     0");
+        dxf_write_string (fp, 9, "$USERI3");
+        dxf_write_string (fp, 70, "     0");
+        dxf_write_string (fp, 9, "$USERI4");
+        dxf_write_string (fp, 70, "     0");
+        dxf_write_string (fp, 9, "$USERI5");
+        dxf_write_string (fp, 70, "     0");
+        dxf_write_string (fp, 9, "$USERR1");
+        dxf_write_string (fp, 40, "0.0");
+        dxf_write_string (fp, 9, "$USERR2");
+        dxf_write_string (fp, 40, "0.0");
+        dxf_write_string (fp, 9, "$USERR3");
+        dxf_write_string (fp, 40, "0.0");
+        dxf_write_string (fp, 9, "$USERR4");
+        dxf_write_string (fp, 40, "0.0");
+        dxf_write_string (fp, 9, "$USERR5");
+        dxf_write_string (fp, 40, "0.0");
+        dxf_write_string (fp, 9, "$WORLDVIEW");
+        dxf_write_string (fp, 70, "     1");
+        dxf_write_string (fp, 9, "$SHADEDGE");
+        dxf_write_string (fp, 70, "     3");
+        dxf_write_string (fp, 9, "$SHADEDIF");
+        dxf_write_string (fp, 70, "    70");
+        dxf_write_string (fp, 9, "$TILEMODE");
+        dxf_write_string (fp, 70, "     1");
+        dxf_write_string (fp, 9, "$MAXACTVP");
+        dxf_write_string (fp, 70, "    48");
+        dxf_write_string (fp, 9, "$PINSBASE");
+        dxf_write_string (fp, 10, "0.0");
+        dxf_write_string (fp, 20, "0.0");
+        dxf_write_string (fp, 30, "0.0");
+        dxf_write_string (fp, 9, "$PLIMCHECK");
+        dxf_write_string (fp, 70, "     0");
+        dxf_write_string (fp, 9, "$PEXTMIN");
+        dxf_write_string (fp, 10, "1.000000E+20");
+        dxf_write_string (fp, 20, "1.000000E+20");
+        dxf_write_string (fp, 30, "1.000000E+20");
+        dxf_write_string (fp, 9, "$PEXTMAX");
+        dxf_write_string (fp, 10, "-1.000000E+20");
+        dxf_write_string (fp, 20, "-1.000000E+20");
+        dxf_write_string (fp, 30, "-1.000000E+20");
+        dxf_write_string (fp, 9, "$PLIMMIN");
+        dxf_write_string (fp, 10, "0.0");
+        dxf_write_string (fp, 20, "0.0");
+        dxf_write_string (fp, 9, "$PLIMMAX");
+        dxf_write_string (fp, 10, "420.0");
+        dxf_write_string (fp, 20, "297.0");
+        dxf_write_string (fp, 9, "$UNITMODE");
+        dxf_write_string (fp, 70, "     0");
+        dxf_write_string (fp, 9, "$VISRETAIN");
+        dxf_write_string (fp, 70, "     1");
+        dxf_write_string (fp, 9, "$PLINEGEN");
+        dxf_write_string (fp, 70, "     0");
+        dxf_write_string (fp, 9, "$PSLTSCALE");
+        dxf_write_string (fp, 70, "     1");
+        dxf_write_string (fp, 9, "$TREEDEPTH");
+        dxf_write_string (fp, 70, "  3020");
+        dxf_write_string (fp, 9, "$PICKSTYLE");
+        dxf_write_string (fp, 70, "     1");
+        dxf_write_string (fp, 9, "$CMLSTYLE");
+        dxf_write_string (fp, 2, "STANDARD");
+        dxf_write_string (fp, 9, "$CMLJUST");
+        dxf_write_string (fp, 70, "     0");
+        dxf_write_string (fp, 9, "$CMLSCALE");
+        dxf_write_string (fp, 40, "1.0");
+        dxf_write_string (fp, 9, "$PROXYGRAPHICS");
+        dxf_write_string (fp, 70, "     1");
+        dxf_write_string (fp, 9, "$MEASUREMENT");
+        dxf_write_string (fp, 70, "     0");
+        dxf_write_string (fp, 0, "ENDSEC");
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -946,233 +1258,796 @@ dxf_header_write
                 return (EXIT_FAILURE);
         }
         dxf_section_write (fp, dxf_entity_name);
-        fprintf (fp->fp, "  9\n$ACADVER\n  1\n%s\n", header->AcadVer);
-        if (fp->acad_version_number >= AC1014) fprintf (fp->fp, "  9\n$ACADMAINTVER\n 70\n%i\n", header->AcadMaintVer);
-        if (fp->acad_version_number >= AC1012) fprintf (fp->fp, "  9\n$DWGCODEPAGE\n  3\n%s\n", header->DWGCodePage);
-        if (fp->acad_version_number >= AC1018) fprintf (fp->fp, "  9\n$LASTSAVEDBY\n  1\n%s\n", getenv("USER"));
-        fprintf (fp->fp, "  9\n$INSBASE\n 10\n%f\n 20\n%f\n 30\n%f\n", header->InsBase.x0, header->InsBase.y0, header->InsBase.z0);
-        fprintf (fp->fp, "  9\n$EXTMIN\n 10\n%f\n 20\n%f\n 30\n%f\n", header->ExtMin.x0, header->ExtMin.y0, header->ExtMin.z0);
-        fprintf (fp->fp, "  9\n$EXTMAX\n 10\n%f\n 20\n%f\n 30\n%f\n", header->ExtMax.x0, header->ExtMax.y0, header->ExtMax.z0);
-        fprintf (fp->fp, "  9\n$LIMMIN\n 10\n%f\n 20\n%f\n", header->LimMin.x0, header->LimMin.y0);
-        fprintf (fp->fp, "  9\n$LIMMAX\n 10\n%f\n 20\n%f\n", header->LimMax.x0, header->LimMax.y0);
-        fprintf (fp->fp, "  9\n$ORTHOMODE\n 70\n%i\n", header->OrthoMode);
-        fprintf (fp->fp, "  9\n$REGENMODE\n 70\n%i\n", header->RegenMode);
-        fprintf (fp->fp, "  9\n$FILLMODE\n 70\n%i\n", header->FillMode);
-        fprintf (fp->fp, "  9\n$QTEXTMODE\n 70\n%i\n", header->QTextMode);
-        fprintf (fp->fp, "  9\n$MIRRTEXT\n 70\n%i\n", header->MirrText);
-        if (fp->acad_version_number <= AC1015) fprintf (fp->fp, "  9\n$DRAGMODE\n 70\n%i\n", header->DragMode);
-        fprintf (fp->fp, "  9\n$LTSCALE\n 40\n%f\n", header->LTScale);
-        if (fp->acad_version_number <= AC1014) fprintf (fp->fp, "  9\n$OSMODE\n 70\n%i\n", header->OSMode);
-        fprintf (fp->fp, "  9\n$ATTMODE\n 70\n%i\n", header->AttMode);
-        fprintf (fp->fp, "  9\n$TEXTSIZE\n 40\n%f\n", header->TextSize);
-        fprintf (fp->fp, "  9\n$TRACEWID\n 40\n%f\n", header->TraceWid);
-        fprintf (fp->fp, "  9\n$TEXTSTYLE\n  7\n%s\n", header->TextStyle);
-        fprintf (fp->fp, "  9\n$CLAYER\n  8\n%s\n", header->CLayer);
-        fprintf (fp->fp, "  9\n$CELTYPE\n  6\n%s\n", header->CELType);
-        fprintf (fp->fp, "  9\n$CECOLOR\n 62\n%i\n", header->CEColor);
-        if (fp->acad_version_number >= AC1012) fprintf (fp->fp, "  9\n$CELTSCALE\n 40\n%f\n", header->CELTScale);
+        dxf_write_string (fp, 9, "$ACADVER");
+        dxf_write_string (fp, 1, header->AcadVer);
+        if (fp->acad_version_number >= AC1014)
+        {
+                dxf_write_string (fp, 9, "$ACADMAINTVER");
+                dxf_write_int (fp, 70, header->AcadMaintVer);
+        }
+        if (fp->acad_version_number >= AC1012)
+        {
+                dxf_write_string (fp, 9, "$DWGCODEPAGE");
+                dxf_write_string (fp, 3, header->DWGCodePage);
+        }
+        if (fp->acad_version_number >= AC1018)
+        {
+                dxf_write_string (fp, 9, "$LASTSAVEDBY");
+                dxf_write_string (fp, 1, getenv("USER"));
+        }
+        dxf_write_string (fp, 9, "$INSBASE");
+        dxf_write_double (fp, 10, header->InsBase.x0);
+        dxf_write_double (fp, 20, header->InsBase.y0);
+        dxf_write_double (fp, 30, header->InsBase.z0);
+        dxf_write_string (fp, 9, "$EXTMIN");
+        dxf_write_double (fp, 10, header->ExtMin.x0);
+        dxf_write_double (fp, 20, header->ExtMin.y0);
+        dxf_write_double (fp, 30, header->ExtMin.z0);
+        dxf_write_string (fp, 9, "$EXTMAX");
+        dxf_write_double (fp, 10, header->ExtMax.x0);
+        dxf_write_double (fp, 20, header->ExtMax.y0);
+        dxf_write_double (fp, 30, header->ExtMax.z0);
+        dxf_write_string (fp, 9, "$LIMMIN");
+        dxf_write_double (fp, 10, header->LimMin.x0);
+        dxf_write_double (fp, 20, header->LimMin.y0);
+        dxf_write_string (fp, 9, "$LIMMAX");
+        dxf_write_double (fp, 10, header->LimMax.x0);
+        dxf_write_double (fp, 20, header->LimMax.y0);
+        dxf_write_string (fp, 9, "$ORTHOMODE");
+        dxf_write_int (fp, 70, header->OrthoMode);
+        dxf_write_string (fp, 9, "$REGENMODE");
+        dxf_write_int (fp, 70, header->RegenMode);
+        dxf_write_string (fp, 9, "$FILLMODE");
+        dxf_write_int (fp, 70, header->FillMode);
+        dxf_write_string (fp, 9, "$QTEXTMODE");
+        dxf_write_int (fp, 70, header->QTextMode);
+        dxf_write_string (fp, 9, "$MIRRTEXT");
+        dxf_write_int (fp, 70, header->MirrText);
+        if (fp->acad_version_number <= AC1015)
+        {
+                dxf_write_string (fp, 9, "$DRAGMODE");
+                dxf_write_int (fp, 70, header->DragMode);
+        }
+        dxf_write_string (fp, 9, "$LTSCALE");
+        dxf_write_double (fp, 40, header->LTScale);
+        if (fp->acad_version_number <= AC1014)
+        {
+                dxf_write_string (fp, 9, "$OSMODE");
+                dxf_write_int (fp, 70, header->OSMode);
+        }
+        dxf_write_string (fp, 9, "$ATTMODE");
+        dxf_write_int (fp, 70, header->AttMode);
+        dxf_write_string (fp, 9, "$TEXTSIZE");
+        dxf_write_double (fp, 40, header->TextSize);
+        dxf_write_string (fp, 9, "$TRACEWID");
+        dxf_write_double (fp, 40, header->TraceWid);
+        dxf_write_string (fp, 9, "$TEXTSTYLE");
+        dxf_write_string (fp, 7, header->TextStyle);
+        dxf_write_string (fp, 9, "$CLAYER");
+        dxf_write_string (fp, 8, header->CLayer);
+        dxf_write_string (fp, 9, "$CELTYPE");
+        dxf_write_string (fp, 6, header->CELType);
+        dxf_write_string (fp, 9, "$CECOLOR");
+        dxf_write_int (fp, 62, header->CEColor);
+        if (fp->acad_version_number >= AC1012)
+        {
+                dxf_write_string (fp, 9, "$CELTSCALE");
+                dxf_write_double (fp, 40, header->CELTScale);
+        }
         if ((fp->acad_version_number == AC1012)
-          || (fp->acad_version_number == AC1014)) fprintf (fp->fp, "  9\n$DELOBJ\n 70\n%i\n", header->DelObj);
-        if (fp->acad_version_number <= AC1012) fprintf (fp->fp, "  9\n$DISPSILH\n 70\n%i\n", header->DispSilH);
-        fprintf (fp->fp, "  9\n$DIMSCALE\n 40\n%f\n", header->DimSCALE);
-        fprintf (fp->fp, "  9\n$DIMASZ\n 40\n%f\n", header->DimASZ);
-        fprintf (fp->fp, "  9\n$DIMEXO\n 40\n%f\n", header->DimEXO);
-        fprintf (fp->fp, "  9\n$DIMDLI\n 40\n%f\n", header->DimDLI);
-        fprintf (fp->fp, "  9\n$DIMRND\n 40\n%f\n", header->DimRND);
-        fprintf (fp->fp, "  9\n$DIMDLE\n 40\n%f\n", header->DimDLE);
-        fprintf (fp->fp, "  9\n$DIMEXE\n 40\n%f\n", header->DimEXE);
-        fprintf (fp->fp, "  9\n$DIMTP\n 40\n%f\n", header->DimTP);
-        fprintf (fp->fp, "  9\n$DIMTM\n 40\n%f\n", header->DimTM);
-        fprintf (fp->fp, "  9\n$DIMTXT\n 40\n%f\n", header->DimTXT);
-        fprintf (fp->fp, "  9\n$DIMCEN\n 40\n%f\n", header->DimCEN);
-        fprintf (fp->fp, "  9\n$DIMTSZ\n 40\n%f\n", header->DimTSZ);
-        fprintf (fp->fp, "  9\n$DIMTOL\n 70\n%i\n", header->DimTOL);
-        fprintf (fp->fp, "  9\n$DIMLIM\n 70\n%i\n", header->DimLIM);
-        fprintf (fp->fp, "  9\n$DIMTIH\n 70\n%i\n", header->DimTIH);
-        fprintf (fp->fp, "  9\n$DIMTOH\n 70\n%i\n", header->DimTOH);
-        fprintf (fp->fp, "  9\n$DIMSE1\n 70\n%i\n", header->DimSE1);
-        fprintf (fp->fp, "  9\n$DIMSE2\n 70\n%i\n", header->DimSE2);
-        fprintf (fp->fp, "  9\n$DIMTAD\n 70\n%i\n", header->DimTAD);
-        fprintf (fp->fp, "  9\n$DIMZIN\n 70\n%i\n", header->DimZIN);
-        fprintf (fp->fp, "  9\n$DIMBLK\n  1\n%s\n", header->DimBLK);
-        fprintf (fp->fp, "  9\n$DIMASO\n 70\n%i\n", header->DimASO);
-        fprintf (fp->fp, "  9\n$DIMSHO\n 70\n%i\n", header->DimSHO);
-        fprintf (fp->fp, "  9\n$DIMPOST\n  1\n%s\n", header->DimPOST);
-        fprintf (fp->fp, "  9\n$DIMAPOST\n  1\n%s\n", header->DimAPOST);
-        fprintf (fp->fp, "  9\n$DIMALT\n 70\n%i\n", header->DimALT);
-        fprintf (fp->fp, "  9\n$DIMALTD\n 70\n%i\n", header->DimALTD);
-        fprintf (fp->fp, "  9\n$DIMALTF\n 40\n%f\n", header->DimALTF);
-        fprintf (fp->fp, "  9\n$DIMLFAC\n 40\n%f\n", header->DimLFAC);
-        fprintf (fp->fp, "  9\n$DIMTOFL\n 70\n%i\n", header->DimTOFL);
-        fprintf (fp->fp, "  9\n$DIMTVP\n 40\n%f\n", header->DimTVP);
-        fprintf (fp->fp, "  9\n$DIMTIX\n 70\n%i\n", header->DimTIX);
-        fprintf (fp->fp, "  9\n$DIMSOXD\n 70\n%i\n", header->DimSOXD);
-        fprintf (fp->fp, "  9\n$DIMSAH\n 70\n%i\n", header->DimSAH);
-        fprintf (fp->fp, "  9\n$DIMBLK1\n  1\n%s\n", header->DimBLK1);
-        fprintf (fp->fp, "  9\n$DIMBLK2\n  1\n%s\n", header->DimBLK2);
-        fprintf (fp->fp, "  9\n$DIMSTYLE\n  2\n%s\n", header->DimSTYLE);
-        fprintf (fp->fp, "  9\n$DIMCLRD\n 70\n%i\n", header->DimCLRD);
-        fprintf (fp->fp, "  9\n$DIMCLRE\n 70\n%i\n", header->DimCLRE);
-        fprintf (fp->fp, "  9\n$DIMCLRT\n 70\n%i\n", header->DimCLRT);
-        fprintf (fp->fp, "  9\n$DIMTFAC\n 40\n%f\n", header->DimTFAC);
-        fprintf (fp->fp, "  9\n$DIMGAP\n 40\n%f\n", header->DimGAP);
-        if (fp->acad_version_number >= AC1012) fprintf (fp->fp, "  9\n$DIMJUST\n 70\n%i\n", header->DimJUST);
-        if (fp->acad_version_number >= AC1012) fprintf (fp->fp, "  9\n$DIMSD1\n 70\n%i\n", header->DimSD1);
-        if (fp->acad_version_number >= AC1012) fprintf (fp->fp, "  9\n$DIMSD2\n 70\n%i\n", header->DimSD2);
-        if (fp->acad_version_number >= AC1012) fprintf (fp->fp, "  9\n$DIMTOLJ\n 70\n%i\n", header->DimTOLJ);
-        if (fp->acad_version_number >= AC1012) fprintf (fp->fp, "  9\n$DIMTZIN\n 70\n%i\n", header->DimTZIN);
-        if (fp->acad_version_number >= AC1012) fprintf (fp->fp, "  9\n$DIMALTZ\n 70\n%i\n", header->DimALTZ);
-        if (fp->acad_version_number >= AC1012) fprintf (fp->fp, "  9\n$DIMALTTZ\n 70\n%i\n", header->DimALTTZ);
+          || (fp->acad_version_number == AC1014))
+        {
+                dxf_write_string (fp, 9, "$DELOBJ");
+                dxf_write_int (fp, 70, header->DelObj);
+        }
+        if (fp->acad_version_number <= AC1012)
+        {
+                dxf_write_string (fp, 9, "$DISPSILH");
+                dxf_write_int (fp, 70, header->DispSilH);
+        }
+        dxf_write_string (fp, 9, "$DIMSCALE");
+        dxf_write_double (fp, 40, header->DimSCALE);
+        dxf_write_string (fp, 9, "$DIMASZ");
+        dxf_write_double (fp, 40, header->DimASZ);
+        dxf_write_string (fp, 9, "$DIMEXO");
+        dxf_write_double (fp, 40, header->DimEXO);
+        dxf_write_string (fp, 9, "$DIMDLI");
+        dxf_write_double (fp, 40, header->DimDLI);
+        dxf_write_string (fp, 9, "$DIMRND");
+        dxf_write_double (fp, 40, header->DimRND);
+        dxf_write_string (fp, 9, "$DIMDLE");
+        dxf_write_double (fp, 40, header->DimDLE);
+        dxf_write_string (fp, 9, "$DIMEXE");
+        dxf_write_double (fp, 40, header->DimEXE);
+        dxf_write_string (fp, 9, "$DIMTP");
+        dxf_write_double (fp, 40, header->DimTP);
+        dxf_write_string (fp, 9, "$DIMTM");
+        dxf_write_double (fp, 40, header->DimTM);
+        dxf_write_string (fp, 9, "$DIMTXT");
+        dxf_write_double (fp, 40, header->DimTXT);
+        dxf_write_string (fp, 9, "$DIMCEN");
+        dxf_write_double (fp, 40, header->DimCEN);
+        dxf_write_string (fp, 9, "$DIMTSZ");
+        dxf_write_double (fp, 40, header->DimTSZ);
+        dxf_write_string (fp, 9, "$DIMTOL");
+        dxf_write_int (fp, 70, header->DimTOL);
+        dxf_write_string (fp, 9, "$DIMLIM");
+        dxf_write_int (fp, 70, header->DimLIM);
+        dxf_write_string (fp, 9, "$DIMTIH");
+        dxf_write_int (fp, 70, header->DimTIH);
+        dxf_write_string (fp, 9, "$DIMTOH");
+        dxf_write_int (fp, 70, header->DimTOH);
+        dxf_write_string (fp, 9, "$DIMSE1");
+        dxf_write_int (fp, 70, header->DimSE1);
+        dxf_write_string (fp, 9, "$DIMSE2");
+        dxf_write_int (fp, 70, header->DimSE2);
+        dxf_write_string (fp, 9, "$DIMTAD");
+        dxf_write_int (fp, 70, header->DimTAD);
+        dxf_write_string (fp, 9, "$DIMZIN");
+        dxf_write_int (fp, 70, header->DimZIN);
+        dxf_write_string (fp, 9, "$DIMBLK");
+        dxf_write_string (fp, 1, header->DimBLK);
+        dxf_write_string (fp, 9, "$DIMASO");
+        dxf_write_int (fp, 70, header->DimASO);
+        dxf_write_string (fp, 9, "$DIMSHO");
+        dxf_write_int (fp, 70, header->DimSHO);
+        dxf_write_string (fp, 9, "$DIMPOST");
+        dxf_write_string (fp, 1, header->DimPOST);
+        dxf_write_string (fp, 9, "$DIMAPOST");
+        dxf_write_string (fp, 1, header->DimAPOST);
+        dxf_write_string (fp, 9, "$DIMALT");
+        dxf_write_int (fp, 70, header->DimALT);
+        dxf_write_string (fp, 9, "$DIMALTD");
+        dxf_write_int (fp, 70, header->DimALTD);
+        dxf_write_string (fp, 9, "$DIMALTF");
+        dxf_write_double (fp, 40, header->DimALTF);
+        dxf_write_string (fp, 9, "$DIMLFAC");
+        dxf_write_double (fp, 40, header->DimLFAC);
+        dxf_write_string (fp, 9, "$DIMTOFL");
+        dxf_write_int (fp, 70, header->DimTOFL);
+        dxf_write_string (fp, 9, "$DIMTVP");
+        dxf_write_double (fp, 40, header->DimTVP);
+        dxf_write_string (fp, 9, "$DIMTIX");
+        dxf_write_int (fp, 70, header->DimTIX);
+        dxf_write_string (fp, 9, "$DIMSOXD");
+        dxf_write_int (fp, 70, header->DimSOXD);
+        dxf_write_string (fp, 9, "$DIMSAH");
+        dxf_write_int (fp, 70, header->DimSAH);
+        dxf_write_string (fp, 9, "$DIMBLK1");
+        dxf_write_string (fp, 1, header->DimBLK1);
+        dxf_write_string (fp, 9, "$DIMBLK2");
+        dxf_write_string (fp, 1, header->DimBLK2);
+        dxf_write_string (fp, 9, "$DIMSTYLE");
+        dxf_write_string (fp, 2, header->DimSTYLE);
+        dxf_write_string (fp, 9, "$DIMCLRD");
+        dxf_write_int (fp, 70, header->DimCLRD);
+        dxf_write_string (fp, 9, "$DIMCLRE");
+        dxf_write_int (fp, 70, header->DimCLRE);
+        dxf_write_string (fp, 9, "$DIMCLRT");
+        dxf_write_int (fp, 70, header->DimCLRT);
+        dxf_write_string (fp, 9, "$DIMTFAC");
+        dxf_write_double (fp, 40, header->DimTFAC);
+        dxf_write_string (fp, 9, "$DIMGAP");
+        dxf_write_double (fp, 40, header->DimGAP);
+        if (fp->acad_version_number >= AC1012)
+        {
+                dxf_write_string (fp, 9, "$DIMJUST");
+                dxf_write_int (fp, 70, header->DimJUST);
+        }
+        if (fp->acad_version_number >= AC1012)
+        {
+                dxf_write_string (fp, 9, "$DIMSD1");
+                dxf_write_int (fp, 70, header->DimSD1);
+        }
+        if (fp->acad_version_number >= AC1012)
+        {
+                dxf_write_string (fp, 9, "$DIMSD2");
+                dxf_write_int (fp, 70, header->DimSD2);
+        }
+        if (fp->acad_version_number >= AC1012)
+        {
+                dxf_write_string (fp, 9, "$DIMTOLJ");
+                dxf_write_int (fp, 70, header->DimTOLJ);
+        }
+        if (fp->acad_version_number >= AC1012)
+        {
+                dxf_write_string (fp, 9, "$DIMTZIN");
+                dxf_write_int (fp, 70, header->DimTZIN);
+        }
+        if (fp->acad_version_number >= AC1012)
+        {
+                dxf_write_string (fp, 9, "$DIMALTZ");
+                dxf_write_int (fp, 70, header->DimALTZ);
+        }
+        if (fp->acad_version_number >= AC1012)
+        {
+                dxf_write_string (fp, 9, "$DIMALTTZ");
+                dxf_write_int (fp, 70, header->DimALTTZ);
+        }
         if ((fp->acad_version_number == AC1012)
-          || (fp->acad_version_number == AC1014)) fprintf (fp->fp, "  9\n$DIMFIT\n 70\n%i\n", header->DimFIT);
-        if (fp->acad_version_number >= AC1012) fprintf (fp->fp, "  9\n$DIMUPT\n 70\n%i\n", header->DimUPT);
+          || (fp->acad_version_number == AC1014))
+        {
+                dxf_write_string (fp, 9, "$DIMFIT");
+                dxf_write_int (fp, 70, header->DimFIT);
+        }
+        if (fp->acad_version_number >= AC1012)
+        {
+                dxf_write_string (fp, 9, "$DIMUPT");
+                dxf_write_int (fp, 70, header->DimUPT);
+        }
         if ((fp->acad_version_number == AC1012) ||
-          (fp->acad_version_number == AC1014)) fprintf (fp->fp, "  9\n$DIMUNIT\n 70\n%i\n", header->DimUNIT);
-        if (fp->acad_version_number >= AC1012) fprintf (fp->fp, "  9\n$DIMDEC\n 70\n%i\n", header->DimDEC);
-        if (fp->acad_version_number >= AC1012) fprintf (fp->fp, "  9\n$DIMTDEC\n 70\n%i\n", header->DimTDEC);
-        if (fp->acad_version_number >= AC1012) fprintf (fp->fp, "  9\n$DIMALTU\n 70\n%i\n", header->DimALTU);
-        if (fp->acad_version_number >= AC1012) fprintf (fp->fp, "  9\n$DIMALTTD\n 70\n%i\n", header->DimALTTD);
-        if (fp->acad_version_number >= AC1012) fprintf (fp->fp, "  9\n$DIMTXSTY\n  7\n%s\n", header->DimTXSTY);
-        if (fp->acad_version_number >= AC1012) fprintf (fp->fp, "  9\n$DIMAUNIT\n 70\n%i\n", header->DimAUNIT);
-        if (fp->acad_version_number >= AC1015) fprintf (fp->fp, "  9\n$DIMADEC\n 70\n%i\n", header->DimADEC);
-        if (fp->acad_version_number >= AC1015) fprintf (fp->fp, "  9\n$DIMALTRND\n 40\n%f\n", header->DimALTRND);
-        if (fp->acad_version_number >= AC1015) fprintf (fp->fp, "  9\n$DIMAZIN\n 70\n%i\n", header->DimAZIN);
-        if (fp->acad_version_number >= AC1015) fprintf (fp->fp, "  9\n$DIMDSEP\n 70\n%i\n", header->DimDSEP);
-        if (fp->acad_version_number >= AC1015) fprintf (fp->fp, "  9\n$DIMATFIT\n 70\n%i\n", header->DimATFIT);
-        if (fp->acad_version_number >= AC1015) fprintf (fp->fp, "  9\n$DIMFRAC\n 70\n%i\n", header->DimFRAC);
-        if (fp->acad_version_number >= AC1015) fprintf (fp->fp, "  9\n$DIMLDRBLK\n  1\n%s\n", header->DimLDRBLK);
-        if (fp->acad_version_number >= AC1015) fprintf (fp->fp, "  9\n$DIMLUNIT\n 70\n%i\n", header->DimLUNIT);
-        if (fp->acad_version_number >= AC1015) fprintf (fp->fp, "  9\n$DIMLWD\n 70\n%i\n", header->DimLWD);
-        if (fp->acad_version_number >= AC1015) fprintf (fp->fp, "  9\n$DIMLWE\n 70\n%i\n", header->DimLWE);
-        if (fp->acad_version_number >= AC1015) fprintf (fp->fp, "  9\n$DIMTMOVE\n 70\n%i\n", header->DimTMOVE);
-        fprintf (fp->fp, "  9\n$LUNITS\n 70\n%i\n", header->LUnits);
-        fprintf (fp->fp, "  9\n$LUPREC\n 70\n%i\n", header->LUPrec);
-        fprintf (fp->fp, "  9\n$SKETCHINC\n 40\n%f\n", header->Sketchinc);
-        fprintf (fp->fp, "  9\n$FILLETRAD\n 40\n%f\n", header->FilletRad);
-        fprintf (fp->fp, "  9\n$AUNITS\n 70\n%i\n", header->AUnits);
-        fprintf (fp->fp, "  9\n$AUPREC\n 70\n%i\n", header->AUPrec);
-        fprintf (fp->fp, "  9\n$MENU\n  1\n%s\n", header->Menu);
-        fprintf (fp->fp, "  9\n$ELEVATION\n 40\n%f\n", header->Elevation);
-        fprintf (fp->fp, "  9\n$PELEVATION\n 40\n%f\n", header->PElevation);
-        fprintf (fp->fp, "  9\n$THICKNESS\n 40\n%f\n", header->Thickness);
-        fprintf (fp->fp, "  9\n$LIMCHECK\n 70\n%i\n", header->LimCheck);
-        if (fp->acad_version_number <= AC1014) fprintf (fp->fp, "  9\n$BLIPMODE\n 70\n%i\n", header->BlipMode);
-        fprintf (fp->fp, "  9\n$CHAMFERA\n 40\n%f\n", header->ChamferA);
-        fprintf (fp->fp, "  9\n$CHAMFERB\n 40\n%f\n", header->ChamferB);
-        if (fp->acad_version_number >= AC1012) fprintf (fp->fp, "  9\n$CHAMFERC\n 40\n%f\n", header->ChamferC);
-        if (fp->acad_version_number >= AC1012) fprintf (fp->fp, "  9\n$CHAMFERD\n 40\n%f\n", header->ChamferD);
-        fprintf (fp->fp, "  9\n$SKPOLY\n 70\n%i\n", header->SKPoly);
-        fprintf (fp->fp, "  9\n$TDCREATE\n 40\n%f\n", header->TDCreate);
-        if (fp->acad_version_number >= AC1015) fprintf (fp->fp, "  9\n$TDUCREATE\n 40\n%f\n", header->TDUCreate);
-        fprintf (fp->fp, "  9\n$TDUPDATE\n 40\n%f\n", header->TDUpdate);
-        if (fp->acad_version_number >= AC1015) fprintf (fp->fp, "  9\n$TDUUPDATE\n 40\n%f\n", header->TDUUpdate);
-        fprintf (fp->fp, "  9\n$TDINDWG\n 40\n%f\n", header->TDInDWG);
-        fprintf (fp->fp, "  9\n$TDUSRTIMER\n 40\n%f\n", header->TDUSRTimer);
-        fprintf (fp->fp, "  9\n$USRTIMER\n 70\n%i\n", header->USRTimer);
-        fprintf (fp->fp, "  9\n$ANGBASE\n 50\n%f\n", header->AngBase);
-        fprintf (fp->fp, "  9\n$ANGDIR\n 70\n%i\n", header->AngDir);
-        fprintf (fp->fp, "  9\n$PDMODE\n 70\n%i\n", header->PDMode);
-        fprintf (fp->fp, "  9\n$PDSIZE\n 40\n%f\n", header->PDSize);
-        fprintf (fp->fp, "  9\n$PLINEWID\n 40\n%f\n", header->PLineWid);
-        if (fp->acad_version_number <= AC1014) fprintf (fp->fp, "  9\n$COORDS\n 70\n%i\n", header->Coords);
-        fprintf (fp->fp, "  9\n$SPLFRAME\n 70\n%i\n", header->SPLFrame);
-        fprintf (fp->fp, "  9\n$SPLINETYPE\n 70\n%i\n", header->SPLineType);
-        if (fp->acad_version_number <= AC1014) fprintf (fp->fp, "  9\n$ATTDIA\n 70\n%i\n", header->AttDia);
-        if (fp->acad_version_number <= AC1014) fprintf (fp->fp, "  9\n$ATTREQ\n 70\n%i\n", header->AttReq);
-        if (fp->acad_version_number <= AC1014) fprintf (fp->fp, "  9\n$HANDLING\n 70\n%i\n", header->Handling);
-        fprintf (fp->fp, "  9\n$SPLINESEGS\n 70\n%i\n", header->SPLineSegs);
-        fprintf (fp->fp, "  9\n$HANDSEED\n  5\n%s\n", header->HandSeed);
-        fprintf (fp->fp, "  9\n$SURFTAB1\n 70\n%i\n", header->SurfTab1);
-        fprintf (fp->fp, "  9\n$SURFTAB2\n 70\n%i\n", header->SurfTab2);
-        fprintf (fp->fp, "  9\n$SURFTYPE\n 70\n%i\n", header->SurfType);
-        fprintf (fp->fp, "  9\n$SURFU\n 70\n%i\n", header->SurfU);
-        fprintf (fp->fp, "  9\n$SURFV\n 70\n%i\n", header->SurfV);
-        if (fp->acad_version_number >= AC1015) fprintf (fp->fp, "  9\n$UCSBASE\n  2\n%s\n", header->UCSBase);
-        fprintf (fp->fp, "  9\n$UCSNAME\n  2\n%s\n", header->UCSName);
-        fprintf (fp->fp, "  9\n$UCSORG\n 10\n%f\n 20\n%f\n 30\n%f\n", header->UCSOrg.x0, header->UCSOrg.y0, header->UCSOrg.z0);
-        fprintf (fp->fp, "  9\n$UCSXDIR\n 10\n%f\n 20\n%f\n 30\n%f\n", header->UCSXDir.x0, header->UCSXDir.y0, header->UCSXDir.z0);
-        fprintf (fp->fp, "  9\n$UCSYDIR\n 10\n%f\n 20\n%f\n 30\n%f\n", header->UCSYDir.x0, header->UCSYDir.y0, header->UCSYDir.z0);
-        if (fp->acad_version_number >= AC1015) fprintf (fp->fp, "  9\n$UCSORTHOREF\n  2\n%s\n", header->UCSOrthoRef);
-        if (fp->acad_version_number >= AC1015) fprintf (fp->fp, "  9\n$UCSORTHOVIEW\n 70\n%i\n", header->UCSOrthoView);
-        if (fp->acad_version_number >= AC1015) fprintf (fp->fp, "  9\n$UCSORGTOP\n 10\n%f\n 20\n%f\n 30\n%f\n", header->UCSOrgTop.x0, header->UCSOrgTop.y0, header->UCSOrgTop.z0);
-        if (fp->acad_version_number >= AC1015) fprintf (fp->fp, "  9\n$UCSORGBOTTOM\n 10\n%f\n 20\n%f\n 30\n%f\n", header->UCSOrgBottom.x0, header->UCSOrgBottom.y0, header->UCSOrgBottom.z0);
-        if (fp->acad_version_number >= AC1015) fprintf (fp->fp, "  9\n$UCSORGLEFT\n 10\n%f\n 20\n%f\n 30\n%f\n", header->UCSOrgLeft.x0, header->UCSOrgLeft.y0, header->UCSOrgLeft.z0);
-        if (fp->acad_version_number >= AC1015) fprintf (fp->fp, "  9\n$UCSORGRIGHT\n 10\n%f\n 20\n%f\n 30\n%f\n", header->UCSOrgRight.x0, header->UCSOrgRight.y0, header->UCSOrgRight.z0);
-        if (fp->acad_version_number >= AC1015) fprintf (fp->fp, "  9\n$UCSORGFRONT\n 10\n%f\n 20\n%f\n 30\n%f\n", header->UCSOrgFront.x0, header->UCSOrgFront.y0, header->UCSOrgFront.z0);
-        if (fp->acad_version_number >= AC1015) fprintf (fp->fp, "  9\n$UCSORGBACK\n 10\n%f\n 20\n%f\n 30\n%f\n", header->UCSOrgBack.x0, header->UCSOrgBack.y0, header->UCSOrgBack.z0);
-        if (fp->acad_version_number >= AC1015) fprintf (fp->fp, "  9\n$PUCSBASE\n  2\n%s\n", header->PUCSBase);
-        fprintf (fp->fp, "  9\n$PUCSNAME\n  2\n%s\n", header->PUCSName);
-        fprintf (fp->fp, "  9\n$PUCSORG\n 10\n%f\n 20\n%f\n 30\n%f\n", header->PUCSOrg.x0, header->PUCSOrg.y0, header->PUCSOrg.z0);
-        fprintf (fp->fp, "  9\n$PUCSXDIR\n 10\n%f\n 20\n%f\n 30\n%f\n", header->PUCSXDir.x0, header->PUCSXDir.y0, header->PUCSXDir.z0);
-        fprintf (fp->fp, "  9\n$PUCSYDIR\n 10\n%f\n 20\n%f\n 30\n%f\n", header->PUCSYDir.x0, header->PUCSYDir.y0, header->PUCSYDir.z0);
-        if (fp->acad_version_number >= AC1015) fprintf (fp->fp, "  9\n$PUCSORTHOREF\n  2\n%s\n", header->PUCSOrthoRef);
-        if (fp->acad_version_number >= AC1015) fprintf (fp->fp, "  9\n$PUCSORTHOVIEW\n 70\n%i\n", header->PUCSOrthoView);
-        if (fp->acad_version_number >= AC1015) fprintf (fp->fp, "  9\n$PUCSORGTOP\n 10\n%f\n 20\n%f\n 30\n%f\n", header->PUCSOrgTop.x0, header->PUCSOrgTop.y0, header->PUCSOrgTop.z0);
-        if (fp->acad_version_number >= AC1015) fprintf (fp->fp, "  9\n$PUCSORGBOTTOM\n 10\n%f\n 20\n%f\n 30\n%f\n", header->PUCSOrgBottom.x0, header->PUCSOrgBottom.y0, header->PUCSOrgBottom.z0);
-        if (fp->acad_version_number >= AC1015) fprintf (fp->fp, "  9\n$PUCSORGLEFT\n 10\n%f\n 20\n%f\n 30\n%f\n", header->PUCSOrgLeft.x0, header->PUCSOrgLeft.y0, header->PUCSOrgLeft.z0);
-        if (fp->acad_version_number >= AC1015) fprintf (fp->fp, "  9\n$PUCSORGRIGHT\n 10\n%f\n 20\n%f\n 30\n%f\n", header->PUCSOrgRight.x0, header->PUCSOrgRight.y0, header->PUCSOrgRight.z0);
-        if (fp->acad_version_number >= AC1015) fprintf (fp->fp, "  9\n$PUCSORGFRONT\n 10\n%f\n 20\n%f\n 30\n%f\n", header->PUCSOrgFront.x0, header->PUCSOrgFront.y0, header->PUCSOrgFront.z0);
-        if (fp->acad_version_number >= AC1015) fprintf (fp->fp, "  9\n$PUCSORGBACK\n 10\n%f\n 20\n%f\n 30\n%f\n", header->PUCSOrgBack.x0, header->PUCSOrgBack.y0, header->PUCSOrgBack.z0);
-        fprintf (fp->fp, "  9\n$USERI1\n 70\n%i\n", header->UserI1);
-        fprintf (fp->fp, "  9\n$USERI2\n 70\n%i\n", header->UserI2);
-        fprintf (fp->fp, "  9\n$USERI3\n 70\n%i\n", header->UserI3);
-        fprintf (fp->fp, "  9\n$USERI4\n 70\n%i\n", header->UserI4);
-        fprintf (fp->fp, "  9\n$USERI5\n 70\n%i\n", header->UserI5);
-        fprintf (fp->fp, "  9\n$USERR1\n 40\n%f\n", header->UserR1);
-        fprintf (fp->fp, "  9\n$USERR2\n 40\n%f\n", header->UserR2);
-        fprintf (fp->fp, "  9\n$USERR3\n 40\n%f\n", header->UserR3);
-        fprintf (fp->fp, "  9\n$USERR4\n 40\n%f\n", header->UserR4);
-        fprintf (fp->fp, "  9\n$USERR5\n 40\n%f\n", header->UserR5);
-        fprintf (fp->fp, "  9\n$WORLDVIEW\n 70\n%i\n", header->WorldView);
-        fprintf (fp->fp, "  9\n$SHADEDGE\n 70\n%i\n", header->ShadEdge);
-        fprintf (fp->fp, "  9\n$SHADEDIF\n 70\n%i\n", header->ShadeDif);
-        fprintf (fp->fp, "  9\n$TILEMODE\n 70\n%i\n", header->TileMode);
-        fprintf (fp->fp, "  9\n$MAXACTVP\n 70\n%i\n", header->MaxActVP);
-        fprintf (fp->fp, "  9\n$PINSBASE\n 10\n%f\n 20\n%f\n 30\n%f\n", header->PInsBase.x0, header->PInsBase.y0, header->PInsBase.z0);
-        fprintf (fp->fp, "  9\n$PLIMCHECK\n 70\n%i\n", header->PLimCheck);
-        fprintf (fp->fp, "  9\n$PEXTMIN\n 10\n%f\n 20\n%f\n 30\n%f\n", header->PExtMin.x0, header->PExtMin.y0, header->PExtMin.z0);
-        fprintf (fp->fp, "  9\n$PEXTMAX\n 10\n%f\n 20\n%f\n 30\n%f\n", header->PExtMax.x0, header->PExtMax.y0, header->PExtMax.z0);
-        fprintf (fp->fp, "  9\n$PLIMMIN\n 10\n%f\n 20\n%f\n", header->PLimMin.x0, header->PLimMin.y0);
-        fprintf (fp->fp, "  9\n$PLIMMAX\n 10\n%f\n 20\n%f\n", header->PLimMax.x0, header->PLimMax.y0);
-        fprintf (fp->fp, "  9\n$UNITMODE\n 70\n%i\n", header->UnitMode);
-        fprintf (fp->fp, "  9\n$VISRETAIN\n 70\n%i\n", header->VisRetain);
-        fprintf (fp->fp, "  9\n$PLINEGEN\n 70\n%i\n", header->PLineGen);
-        fprintf (fp->fp, "  9\n$PSLTSCALE\n 70\n%i\n", header->PSLTScale);
-        if (fp->acad_version_number >= AC1012) fprintf (fp->fp, "  9\n$TREEDEPTH\n 70\n%i\n", header->TreeDepth);
+          (fp->acad_version_number == AC1014))
+        {
+                dxf_write_string (fp, 9, "$DIMUNIT");
+                dxf_write_int (fp, 70, header->DimUNIT);
+        }
+        if (fp->acad_version_number >= AC1012)
+        {
+                dxf_write_string (fp, 9, "$DIMDEC");
+                dxf_write_int (fp, 70, header->DimDEC);
+        }
+        if (fp->acad_version_number >= AC1012)
+        {
+                dxf_write_string (fp, 9, "$DIMTDEC");
+                dxf_write_int (fp, 70, header->DimTDEC);
+        }
+        if (fp->acad_version_number >= AC1012)
+        {
+                dxf_write_string (fp, 9, "$DIMALTU");
+                dxf_write_int (fp, 70, header->DimALTU);
+        }
+        if (fp->acad_version_number >= AC1012)
+        {
+                dxf_write_string (fp, 9, "$DIMALTTD");
+                dxf_write_int (fp, 70, header->DimALTTD);
+        }
+        if (fp->acad_version_number >= AC1012)
+        {
+                dxf_write_string (fp, 9, "$DIMTXSTY");
+                dxf_write_string (fp, 7, header->DimTXSTY);
+        }
+        if (fp->acad_version_number >= AC1012)
+        {
+                dxf_write_string (fp, 9, "$DIMAUNIT");
+                dxf_write_int (fp, 70, header->DimAUNIT);
+        }
+        if (fp->acad_version_number >= AC1015)
+        {
+                dxf_write_string (fp, 9, "$DIMADEC");
+                dxf_write_int (fp, 70, header->DimADEC);
+        }
+        if (fp->acad_version_number >= AC1015)
+        {
+                dxf_write_string (fp, 9, "$DIMALTRND");
+                dxf_write_double (fp, 40, header->DimALTRND);
+        }
+        if (fp->acad_version_number >= AC1015)
+        {
+                dxf_write_string (fp, 9, "$DIMAZIN");
+                dxf_write_int (fp, 70, header->DimAZIN);
+        }
+        if (fp->acad_version_number >= AC1015)
+        {
+                dxf_write_string (fp, 9, "$DIMDSEP");
+                dxf_write_int (fp, 70, header->DimDSEP);
+        }
+        if (fp->acad_version_number >= AC1015)
+        {
+                dxf_write_string (fp, 9, "$DIMATFIT");
+                dxf_write_int (fp, 70, header->DimATFIT);
+        }
+        if (fp->acad_version_number >= AC1015)
+        {
+                dxf_write_string (fp, 9, "$DIMFRAC");
+                dxf_write_int (fp, 70, header->DimFRAC);
+        }
+        if (fp->acad_version_number >= AC1015)
+        {
+                dxf_write_string (fp, 9, "$DIMLDRBLK");
+                dxf_write_string (fp, 1, header->DimLDRBLK);
+        }
+        if (fp->acad_version_number >= AC1015)
+        {
+                dxf_write_string (fp, 9, "$DIMLUNIT");
+                dxf_write_int (fp, 70, header->DimLUNIT);
+        }
+        if (fp->acad_version_number >= AC1015)
+        {
+                dxf_write_string (fp, 9, "$DIMLWD");
+                dxf_write_int (fp, 70, header->DimLWD);
+        }
+        if (fp->acad_version_number >= AC1015)
+        {
+                dxf_write_string (fp, 9, "$DIMLWE");
+                dxf_write_int (fp, 70, header->DimLWE);
+        }
+        if (fp->acad_version_number >= AC1015)
+        {
+                dxf_write_string (fp, 9, "$DIMTMOVE");
+                dxf_write_int (fp, 70, header->DimTMOVE);
+        }
+        dxf_write_string (fp, 9, "$LUNITS");
+        dxf_write_int (fp, 70, header->LUnits);
+        dxf_write_string (fp, 9, "$LUPREC");
+        dxf_write_int (fp, 70, header->LUPrec);
+        dxf_write_string (fp, 9, "$SKETCHINC");
+        dxf_write_double (fp, 40, header->Sketchinc);
+        dxf_write_string (fp, 9, "$FILLETRAD");
+        dxf_write_double (fp, 40, header->FilletRad);
+        dxf_write_string (fp, 9, "$AUNITS");
+        dxf_write_int (fp, 70, header->AUnits);
+        dxf_write_string (fp, 9, "$AUPREC");
+        dxf_write_int (fp, 70, header->AUPrec);
+        dxf_write_string (fp, 9, "$MENU");
+        dxf_write_string (fp, 1, header->Menu);
+        dxf_write_string (fp, 9, "$ELEVATION");
+        dxf_write_double (fp, 40, header->Elevation);
+        dxf_write_string (fp, 9, "$PELEVATION");
+        dxf_write_double (fp, 40, header->PElevation);
+        dxf_write_string (fp, 9, "$THICKNESS");
+        dxf_write_double (fp, 40, header->Thickness);
+        dxf_write_string (fp, 9, "$LIMCHECK");
+        dxf_write_int (fp, 70, header->LimCheck);
+        if (fp->acad_version_number <= AC1014)
+        {
+                dxf_write_string (fp, 9, "$BLIPMODE");
+                dxf_write_int (fp, 70, header->BlipMode);
+        }
+        dxf_write_string (fp, 9, "$CHAMFERA");
+        dxf_write_double (fp, 40, header->ChamferA);
+        dxf_write_string (fp, 9, "$CHAMFERB");
+        dxf_write_double (fp, 40, header->ChamferB);
+        if (fp->acad_version_number >= AC1012)
+        {
+                dxf_write_string (fp, 9, "$CHAMFERC");
+                dxf_write_double (fp, 40, header->ChamferC);
+        }
+        if (fp->acad_version_number >= AC1012)
+        {
+                dxf_write_string (fp, 9, "$CHAMFERD");
+                dxf_write_double (fp, 40, header->ChamferD);
+        }
+        dxf_write_string (fp, 9, "$SKPOLY");
+        dxf_write_int (fp, 70, header->SKPoly);
+        dxf_write_string (fp, 9, "$TDCREATE");
+        dxf_write_double (fp, 40, header->TDCreate);
+        if (fp->acad_version_number >= AC1015)
+        {
+                dxf_write_string (fp, 9, "$TDUCREATE");
+                dxf_write_double (fp, 40, header->TDUCreate);
+        }
+        dxf_write_string (fp, 9, "$TDUPDATE");
+        dxf_write_double (fp, 40, header->TDUpdate);
+        if (fp->acad_version_number >= AC1015)
+        {
+                dxf_write_string (fp, 9, "$TDUUPDATE");
+                dxf_write_double (fp, 40, header->TDUUpdate);
+        }
+        dxf_write_string (fp, 9, "$TDINDWG");
+        dxf_write_double (fp, 40, header->TDInDWG);
+        dxf_write_string (fp, 9, "$TDUSRTIMER");
+        dxf_write_double (fp, 40, header->TDUSRTimer);
+        dxf_write_string (fp, 9, "$USRTIMER");
+        dxf_write_int (fp, 70, header->USRTimer);
+        dxf_write_string (fp, 9, "$ANGBASE");
+        dxf_write_double (fp, 50, header->AngBase);
+        dxf_write_string (fp, 9, "$ANGDIR");
+        dxf_write_int (fp, 70, header->AngDir);
+        dxf_write_string (fp, 9, "$PDMODE");
+        dxf_write_int (fp, 70, header->PDMode);
+        dxf_write_string (fp, 9, "$PDSIZE");
+        dxf_write_double (fp, 40, header->PDSize);
+        dxf_write_string (fp, 9, "$PLINEWID");
+        dxf_write_double (fp, 40, header->PLineWid);
+        if (fp->acad_version_number <= AC1014)
+        {
+                dxf_write_string (fp, 9, "$COORDS");
+                dxf_write_int (fp, 70, header->Coords);
+        }
+        dxf_write_string (fp, 9, "$SPLFRAME");
+        dxf_write_int (fp, 70, header->SPLFrame);
+        dxf_write_string (fp, 9, "$SPLINETYPE");
+        dxf_write_int (fp, 70, header->SPLineType);
+        if (fp->acad_version_number <= AC1014)
+        {
+                dxf_write_string (fp, 9, "$ATTDIA");
+                dxf_write_int (fp, 70, header->AttDia);
+        }
+        if (fp->acad_version_number <= AC1014)
+        {
+                dxf_write_string (fp, 9, "$ATTREQ");
+                dxf_write_int (fp, 70, header->AttReq);
+        }
+        if (fp->acad_version_number <= AC1014)
+        {
+                dxf_write_string (fp, 9, "$HANDLING");
+                dxf_write_int (fp, 70, header->Handling);
+        }
+        dxf_write_string (fp, 9, "$SPLINESEGS");
+        dxf_write_int (fp, 70, header->SPLineSegs);
+        dxf_write_string (fp, 9, "$HANDSEED");
+        dxf_write_string (fp, 5, header->HandSeed);
+        dxf_write_string (fp, 9, "$SURFTAB1");
+        dxf_write_int (fp, 70, header->SurfTab1);
+        dxf_write_string (fp, 9, "$SURFTAB2");
+        dxf_write_int (fp, 70, header->SurfTab2);
+        dxf_write_string (fp, 9, "$SURFTYPE");
+        dxf_write_int (fp, 70, header->SurfType);
+        dxf_write_string (fp, 9, "$SURFU");
+        dxf_write_int (fp, 70, header->SurfU);
+        dxf_write_string (fp, 9, "$SURFV");
+        dxf_write_int (fp, 70, header->SurfV);
+        if (fp->acad_version_number >= AC1015)
+        {
+                dxf_write_string (fp, 9, "$UCSBASE");
+                dxf_write_string (fp, 2, header->UCSBase);
+        }
+        dxf_write_string (fp, 9, "$UCSNAME");
+        dxf_write_string (fp, 2, header->UCSName);
+        dxf_write_string (fp, 9, "$UCSORG");
+        dxf_write_double (fp, 10, header->UCSOrg.x0);
+        dxf_write_double (fp, 20, header->UCSOrg.y0);
+        dxf_write_double (fp, 30, header->UCSOrg.z0);
+        dxf_write_string (fp, 9, "$UCSXDIR");
+        dxf_write_double (fp, 10, header->UCSXDir.x0);
+        dxf_write_double (fp, 20, header->UCSXDir.y0);
+        dxf_write_double (fp, 30, header->UCSXDir.z0);
+        dxf_write_string (fp, 9, "$UCSYDIR");
+        dxf_write_double (fp, 10, header->UCSYDir.x0);
+        dxf_write_double (fp, 20, header->UCSYDir.y0);
+        dxf_write_double (fp, 30, header->UCSYDir.z0);
+        if (fp->acad_version_number >= AC1015)
+        {
+                dxf_write_string (fp, 9, "$UCSORTHOREF");
+                dxf_write_string (fp, 2, header->UCSOrthoRef);
+        }
+        if (fp->acad_version_number >= AC1015)
+        {
+                dxf_write_string (fp, 9, "$UCSORTHOVIEW");
+                dxf_write_int (fp, 70, header->UCSOrthoView);
+        }
+        if (fp->acad_version_number >= AC1015)
+        {
+                dxf_write_string (fp, 9, "$UCSORGTOP");
+                dxf_write_double (fp, 10, header->UCSOrgTop.x0);
+                dxf_write_double (fp, 20, header->UCSOrgTop.y0);
+                dxf_write_double (fp, 30, header->UCSOrgTop.z0);
+        }
+        if (fp->acad_version_number >= AC1015)
+        {
+                dxf_write_string (fp, 9, "$UCSORGBOTTOM");
+                dxf_write_double (fp, 10, header->UCSOrgBottom.x0);
+                dxf_write_double (fp, 20, header->UCSOrgBottom.y0);
+                dxf_write_double (fp, 30, header->UCSOrgBottom.z0);
+        }
+        if (fp->acad_version_number >= AC1015)
+        {
+                dxf_write_string (fp, 9, "$UCSORGLEFT");
+                dxf_write_double (fp, 10, header->UCSOrgLeft.x0);
+                dxf_write_double (fp, 20, header->UCSOrgLeft.y0);
+                dxf_write_double (fp, 30, header->UCSOrgLeft.z0);
+        }
+        if (fp->acad_version_number >= AC1015)
+        {
+                dxf_write_string (fp, 9, "$UCSORGRIGHT");
+                dxf_write_double (fp, 10, header->UCSOrgRight.x0);
+                dxf_write_double (fp, 20, header->UCSOrgRight.y0);
+                dxf_write_double (fp, 30, header->UCSOrgRight.z0);
+        }
+        if (fp->acad_version_number >= AC1015)
+        {
+                dxf_write_string (fp, 9, "$UCSORGFRONT");
+                dxf_write_double (fp, 10, header->UCSOrgFront.x0);
+                dxf_write_double (fp, 20, header->UCSOrgFront.y0);
+                dxf_write_double (fp, 30, header->UCSOrgFront.z0);
+        }
+        if (fp->acad_version_number >= AC1015)
+        {
+                dxf_write_string (fp, 9, "$UCSORGBACK");
+                dxf_write_double (fp, 10, header->UCSOrgBack.x0);
+                dxf_write_double (fp, 20, header->UCSOrgBack.y0);
+                dxf_write_double (fp, 30, header->UCSOrgBack.z0);
+        }
+        if (fp->acad_version_number >= AC1015)
+        {
+                dxf_write_string (fp, 9, "$PUCSBASE");
+                dxf_write_string (fp, 2, header->PUCSBase);
+        }
+        dxf_write_string (fp, 9, "$PUCSNAME");
+        dxf_write_string (fp, 2, header->PUCSName);
+        dxf_write_string (fp, 9, "$PUCSORG");
+        dxf_write_double (fp, 10, header->PUCSOrg.x0);
+        dxf_write_double (fp, 20, header->PUCSOrg.y0);
+        dxf_write_double (fp, 30, header->PUCSOrg.z0);
+        dxf_write_string (fp, 9, "$PUCSXDIR");
+        dxf_write_double (fp, 10, header->PUCSXDir.x0);
+        dxf_write_double (fp, 20, header->PUCSXDir.y0);
+        dxf_write_double (fp, 30, header->PUCSXDir.z0);
+        dxf_write_string (fp, 9, "$PUCSYDIR");
+        dxf_write_double (fp, 10, header->PUCSYDir.x0);
+        dxf_write_double (fp, 20, header->PUCSYDir.y0);
+        dxf_write_double (fp, 30, header->PUCSYDir.z0);
+        if (fp->acad_version_number >= AC1015)
+        {
+                dxf_write_string (fp, 9, "$PUCSORTHOREF");
+                dxf_write_string (fp, 2, header->PUCSOrthoRef);
+        }
+        if (fp->acad_version_number >= AC1015)
+        {
+                dxf_write_string (fp, 9, "$PUCSORTHOVIEW");
+                dxf_write_int (fp, 70, header->PUCSOrthoView);
+        }
+        if (fp->acad_version_number >= AC1015)
+        {
+                dxf_write_string (fp, 9, "$PUCSORGTOP");
+                dxf_write_double (fp, 10, header->PUCSOrgTop.x0);
+                dxf_write_double (fp, 20, header->PUCSOrgTop.y0);
+                dxf_write_double (fp, 30, header->PUCSOrgTop.z0);
+        }
+        if (fp->acad_version_number >= AC1015)
+        {
+                dxf_write_string (fp, 9, "$PUCSORGBOTTOM");
+                dxf_write_double (fp, 10, header->PUCSOrgBottom.x0);
+                dxf_write_double (fp, 20, header->PUCSOrgBottom.y0);
+                dxf_write_double (fp, 30, header->PUCSOrgBottom.z0);
+        }
+        if (fp->acad_version_number >= AC1015)
+        {
+                dxf_write_string (fp, 9, "$PUCSORGLEFT");
+                dxf_write_double (fp, 10, header->PUCSOrgLeft.x0);
+                dxf_write_double (fp, 20, header->PUCSOrgLeft.y0);
+                dxf_write_double (fp, 30, header->PUCSOrgLeft.z0);
+        }
+        if (fp->acad_version_number >= AC1015)
+        {
+                dxf_write_string (fp, 9, "$PUCSORGRIGHT");
+                dxf_write_double (fp, 10, header->PUCSOrgRight.x0);
+                dxf_write_double (fp, 20, header->PUCSOrgRight.y0);
+                dxf_write_double (fp, 30, header->PUCSOrgRight.z0);
+        }
+        if (fp->acad_version_number >= AC1015)
+        {
+                dxf_write_string (fp, 9, "$PUCSORGFRONT");
+                dxf_write_double (fp, 10, header->PUCSOrgFront.x0);
+                dxf_write_double (fp, 20, header->PUCSOrgFront.y0);
+                dxf_write_double (fp, 30, header->PUCSOrgFront.z0);
+        }
+        if (fp->acad_version_number >= AC1015)
+        {
+                dxf_write_string (fp, 9, "$PUCSORGBACK");
+                dxf_write_double (fp, 10, header->PUCSOrgBack.x0);
+                dxf_write_double (fp, 20, header->PUCSOrgBack.y0);
+                dxf_write_double (fp, 30, header->PUCSOrgBack.z0);
+        }
+        dxf_write_string (fp, 9, "$USERI1");
+        dxf_write_int (fp, 70, header->UserI1);
+        dxf_write_string (fp, 9, "$USERI2");
+        dxf_write_int (fp, 70, header->UserI2);
+        dxf_write_string (fp, 9, "$USERI3");
+        dxf_write_int (fp, 70, header->UserI3);
+        dxf_write_string (fp, 9, "$USERI4");
+        dxf_write_int (fp, 70, header->UserI4);
+        dxf_write_string (fp, 9, "$USERI5");
+        dxf_write_int (fp, 70, header->UserI5);
+        dxf_write_string (fp, 9, "$USERR1");
+        dxf_write_double (fp, 40, header->UserR1);
+        dxf_write_string (fp, 9, "$USERR2");
+        dxf_write_double (fp, 40, header->UserR2);
+        dxf_write_string (fp, 9, "$USERR3");
+        dxf_write_double (fp, 40, header->UserR3);
+        dxf_write_string (fp, 9, "$USERR4");
+        dxf_write_double (fp, 40, header->UserR4);
+        dxf_write_string (fp, 9, "$USERR5");
+        dxf_write_double (fp, 40, header->UserR5);
+        dxf_write_string (fp, 9, "$WORLDVIEW");
+        dxf_write_int (fp, 70, header->WorldView);
+        dxf_write_string (fp, 9, "$SHADEDGE");
+        dxf_write_int (fp, 70, header->ShadEdge);
+        dxf_write_string (fp, 9, "$SHADEDIF");
+        dxf_write_int (fp, 70, header->ShadeDif);
+        dxf_write_string (fp, 9, "$TILEMODE");
+        dxf_write_int (fp, 70, header->TileMode);
+        dxf_write_string (fp, 9, "$MAXACTVP");
+        dxf_write_int (fp, 70, header->MaxActVP);
+        dxf_write_string (fp, 9, "$PINSBASE");
+        dxf_write_double (fp, 10, header->PInsBase.x0);
+        dxf_write_double (fp, 20, header->PInsBase.y0);
+        dxf_write_double (fp, 30, header->PInsBase.z0);
+        dxf_write_string (fp, 9, "$PLIMCHECK");
+        dxf_write_int (fp, 70, header->PLimCheck);
+        dxf_write_string (fp, 9, "$PEXTMIN");
+        dxf_write_double (fp, 10, header->PExtMin.x0);
+        dxf_write_double (fp, 20, header->PExtMin.y0);
+        dxf_write_double (fp, 30, header->PExtMin.z0);
+        dxf_write_string (fp, 9, "$PEXTMAX");
+        dxf_write_double (fp, 10, header->PExtMax.x0);
+        dxf_write_double (fp, 20, header->PExtMax.y0);
+        dxf_write_double (fp, 30, header->PExtMax.z0);
+        dxf_write_string (fp, 9, "$PLIMMIN");
+        dxf_write_double (fp, 10, header->PLimMin.x0);
+        dxf_write_double (fp, 20, header->PLimMin.y0);
+        dxf_write_string (fp, 9, "$PLIMMAX");
+        dxf_write_double (fp, 10, header->PLimMax.x0);
+        dxf_write_double (fp, 20, header->PLimMax.y0);
+        dxf_write_string (fp, 9, "$UNITMODE");
+        dxf_write_int (fp, 70, header->UnitMode);
+        dxf_write_string (fp, 9, "$VISRETAIN");
+        dxf_write_int (fp, 70, header->VisRetain);
+        dxf_write_string (fp, 9, "$PLINEGEN");
+        dxf_write_int (fp, 70, header->PLineGen);
+        dxf_write_string (fp, 9, "$PSLTSCALE");
+        dxf_write_int (fp, 70, header->PSLTScale);
+        if (fp->acad_version_number >= AC1012)
+        {
+                dxf_write_string (fp, 9, "$TREEDEPTH");
+                dxf_write_int (fp, 70, header->TreeDepth);
+        }
         if ((fp->acad_version_number == AC1012)
-          || (fp->acad_version_number == AC1014)) fprintf (fp->fp, "  9\n$PICKSTYLE\n 70\n%i\n", header->PickStyle);
-        if (fp->acad_version_number >= AC1012) fprintf (fp->fp, "  9\n$CMLSTYLE\n  2\n%s\n", header->CMLStyle);
-        if (fp->acad_version_number >= AC1012) fprintf (fp->fp, "  9\n$CMLJUST\n 70\n%i\n", header->CMLJust);
-        if (fp->acad_version_number >= AC1012) fprintf (fp->fp, "  9\n$CMLSCALE\n 40\n%f\n", header->CMLScale);
-        if (fp->acad_version_number >= AC1014) fprintf (fp->fp, "  9\n$PROXYGRAPHICS\n 70\n%i\n", header->ProxyGraphics);
-        if (fp->acad_version_number >= AC1014) fprintf (fp->fp, "  9\n$MEASUREMENT\n 70\n%i\n", header->Measurement);
-        if (fp->acad_version_number == AC1012) fprintf (fp->fp, "  9\n$SAVEIMAGES\n 70\n%i\n", header->SaveImages);
-        if (fp->acad_version_number >= AC1015) fprintf (fp->fp, "  9\n$CELWEIGHT\n370\n%i\n", header->CELWeight);
-        if (fp->acad_version_number >= AC1015) fprintf (fp->fp, "  9\n$ENDCAPS\n280\n%i\n", header->EndCaps);
-        if (fp->acad_version_number >= AC1015) fprintf (fp->fp, "  9\n$JOINSTYLE\n280\n%i\n", header->JoinStyle);
-        if (fp->acad_version_number >= AC1015) fprintf (fp->fp, "  9\n$LWDISPLAY\n290\n%i\n", header->LWDisplay);
-        if (fp->acad_version_number >= AC1015) fprintf (fp->fp, "  9\n$INSUNITS\n 70\n%i\n", header->InsUnits);
-        if (fp->acad_version_number >= AC1015) fprintf (fp->fp, "  9\n$HYPERLINKBASE\n  1\n%s\n", header->HyperLinkBase);
-        if (fp->acad_version_number >= AC1015) fprintf (fp->fp, "  9\n$STYLESHEET\n  1\n%s\n", header->StyleSheet);
-        if (fp->acad_version_number >= AC1015) fprintf (fp->fp, "  9\n$XEDIT\n290\n%i\n", header->XEdit);
-        if (fp->acad_version_number >= AC1015) fprintf (fp->fp, "  9\n$CEPSNTYPE\n380\n%i\n", header->CEPSNType);
-        if (fp->acad_version_number >= AC1015) fprintf (fp->fp, "  9\n$PSTYLEMODE\n290\n%i\n", header->PStyleMode);
-        if (fp->acad_version_number >= AC1015) fprintf (fp->fp, "  9\n$FINGERPRINTGUID\n  2\n%s\n", header->FingerPrintGUID);
-        if (fp->acad_version_number >= AC1015) fprintf (fp->fp, "  9\n$VERSIONGUID\n  2\n%s\n", header->VersionGUID);
-        if (fp->acad_version_number >= AC1015) fprintf (fp->fp, "  9\n$EXTNAMES\n290\n%i\n", header->ExtNames);
-        if (fp->acad_version_number >= AC1015) fprintf (fp->fp, "  9\n$PSVPSCALE\n 40\n%f\n", header->PSVPScale);
-        if (fp->acad_version_number >= AC1015) fprintf (fp->fp, "  9\n$OLESTARTUP\n290\n%i\n", header->OLEStartUp);
-        if (fp->acad_version_number >= AC1018) fprintf (fp->fp, "  9\n$SORTENTS\n280\n%i\n", header->SortEnts);
-        if (fp->acad_version_number >= AC1018) fprintf (fp->fp, "  9\n$INDEXCTL\n280\n%i\n", header->IndexCtl);
-        if (fp->acad_version_number >= AC1018) fprintf (fp->fp, "  9\n$HIDETEXT\n280\n%i\n", header->HideText);
-        if (fp->acad_version_number >= AC1018) fprintf (fp->fp, "  9\n$XCLIPFRAME\n290\n%i\n", header->XClipFrame);
-        if (fp->acad_version_number >= AC1018) fprintf (fp->fp, "  9\n$HALOGAP\n280\n%i\n", header->HaloGap);
-        if (fp->acad_version_number >= AC1018) fprintf (fp->fp, "  9\n$OBSCOLOR\n 70\n%i\n", header->ObsColor);
-        if (fp->acad_version_number >= AC1018) fprintf (fp->fp, "  9\n$OBSLTYPE\n280\n%i\n", header->ObsLType);
-        if (fp->acad_version_number >= AC1018) fprintf (fp->fp, "  9\n$INTERSECTIONDISPLAY\n280\n%i\n", header->InterSectionDisplay);
-        if (fp->acad_version_number >= AC1018) fprintf (fp->fp, "  9\n$INTERSECTIONCOLOR\n 70\n%i\n", header->InterSectionColor);
-        if (fp->acad_version_number >= AC1018) fprintf (fp->fp, "  9\n$DIMASSOC\n280\n%i\n", header->DimASSOC);
-        if (fp->acad_version_number >= AC1018) fprintf (fp->fp, "  9\n$PROJECTNAME\n  1\n%s\n", header->ProjectName);
+          || (fp->acad_version_number == AC1014))
+        {
+                dxf_write_string (fp, 9, "$PICKSTYLE");
+                dxf_write_int (fp, 70, header->PickStyle);
+        }
+        if (fp->acad_version_number >= AC1012)
+        {
+                dxf_write_string (fp, 9, "$CMLSTYLE");
+                dxf_write_string (fp, 2, header->CMLStyle);
+        }
+        if (fp->acad_version_number >= AC1012)
+        {
+                dxf_write_string (fp, 9, "$CMLJUST");
+                dxf_write_int (fp, 70, header->CMLJust);
+        }
+        if (fp->acad_version_number >= AC1012)
+        {
+                dxf_write_string (fp, 9, "$CMLSCALE");
+                dxf_write_double (fp, 40, header->CMLScale);
+        }
+        if (fp->acad_version_number >= AC1014)
+        {
+                dxf_write_string (fp, 9, "$PROXYGRAPHICS");
+                dxf_write_int (fp, 70, header->ProxyGraphics);
+        }
+        if (fp->acad_version_number >= AC1014)
+        {
+                dxf_write_string (fp, 9, "$MEASUREMENT");
+                dxf_write_int (fp, 70, header->Measurement);
+        }
+        if (fp->acad_version_number == AC1012)
+        {
+                dxf_write_string (fp, 9, "$SAVEIMAGES");
+                dxf_write_int (fp, 70, header->SaveImages);
+        }
+        if (fp->acad_version_number >= AC1015)
+        {
+                dxf_write_string (fp, 9, "$CELWEIGHT");
+                dxf_write_int (fp, 370, header->CELWeight);
+        }
+        if (fp->acad_version_number >= AC1015)
+        {
+                dxf_write_string (fp, 9, "$ENDCAPS");
+                dxf_write_int (fp, 280, header->EndCaps);
+        }
+        if (fp->acad_version_number >= AC1015)
+        {
+                dxf_write_string (fp, 9, "$JOINSTYLE");
+                dxf_write_int (fp, 280, header->JoinStyle);
+        }
+        if (fp->acad_version_number >= AC1015)
+        {
+                dxf_write_string (fp, 9, "$LWDISPLAY");
+                dxf_write_int (fp, 290, header->LWDisplay);
+        }
+        if (fp->acad_version_number >= AC1015)
+        {
+                dxf_write_string (fp, 9, "$INSUNITS");
+                dxf_write_int (fp, 70, header->InsUnits);
+        }
+        if (fp->acad_version_number >= AC1015)
+        {
+                dxf_write_string (fp, 9, "$HYPERLINKBASE");
+                dxf_write_string (fp, 1, header->HyperLinkBase);
+        }
+        if (fp->acad_version_number >= AC1015)
+        {
+                dxf_write_string (fp, 9, "$STYLESHEET");
+                dxf_write_string (fp, 1, header->StyleSheet);
+        }
+        if (fp->acad_version_number >= AC1015)
+        {
+                dxf_write_string (fp, 9, "$XEDIT");
+                dxf_write_int (fp, 290, header->XEdit);
+        }
+        if (fp->acad_version_number >= AC1015)
+        {
+                dxf_write_string (fp, 9, "$CEPSNTYPE");
+                dxf_write_int (fp, 380, header->CEPSNType);
+        }
+        if (fp->acad_version_number >= AC1015)
+        {
+                dxf_write_string (fp, 9, "$PSTYLEMODE");
+                dxf_write_int (fp, 290, header->PStyleMode);
+        }
+        if (fp->acad_version_number >= AC1015)
+        {
+                dxf_write_string (fp, 9, "$FINGERPRINTGUID");
+                dxf_write_string (fp, 2, header->FingerPrintGUID);
+        }
+        if (fp->acad_version_number >= AC1015)
+        {
+                dxf_write_string (fp, 9, "$VERSIONGUID");
+                dxf_write_string (fp, 2, header->VersionGUID);
+        }
+        if (fp->acad_version_number >= AC1015)
+        {
+                dxf_write_string (fp, 9, "$EXTNAMES");
+                dxf_write_int (fp, 290, header->ExtNames);
+        }
+        if (fp->acad_version_number >= AC1015)
+        {
+                dxf_write_string (fp, 9, "$PSVPSCALE");
+                dxf_write_double (fp, 40, header->PSVPScale);
+        }
+        if (fp->acad_version_number >= AC1015)
+        {
+                dxf_write_string (fp, 9, "$OLESTARTUP");
+                dxf_write_int (fp, 290, header->OLEStartUp);
+        }
+        if (fp->acad_version_number >= AC1018)
+        {
+                dxf_write_string (fp, 9, "$SORTENTS");
+                dxf_write_int (fp, 280, header->SortEnts);
+        }
+        if (fp->acad_version_number >= AC1018)
+        {
+                dxf_write_string (fp, 9, "$INDEXCTL");
+                dxf_write_int (fp, 280, header->IndexCtl);
+        }
+        if (fp->acad_version_number >= AC1018)
+        {
+                dxf_write_string (fp, 9, "$HIDETEXT");
+                dxf_write_int (fp, 280, header->HideText);
+        }
+        if (fp->acad_version_number >= AC1018)
+        {
+                dxf_write_string (fp, 9, "$XCLIPFRAME");
+                dxf_write_int (fp, 290, header->XClipFrame);
+        }
+        if (fp->acad_version_number >= AC1018)
+        {
+                dxf_write_string (fp, 9, "$HALOGAP");
+                dxf_write_int (fp, 280, header->HaloGap);
+        }
+        if (fp->acad_version_number >= AC1018)
+        {
+                dxf_write_string (fp, 9, "$OBSCOLOR");
+                dxf_write_int (fp, 70, header->ObsColor);
+        }
+        if (fp->acad_version_number >= AC1018)
+        {
+                dxf_write_string (fp, 9, "$OBSLTYPE");
+                dxf_write_int (fp, 280, header->ObsLType);
+        }
+        if (fp->acad_version_number >= AC1018)
+        {
+                dxf_write_string (fp, 9, "$INTERSECTIONDISPLAY");
+                dxf_write_int (fp, 280, header->InterSectionDisplay);
+        }
+        if (fp->acad_version_number >= AC1018)
+        {
+                dxf_write_string (fp, 9, "$INTERSECTIONCOLOR");
+                dxf_write_int (fp, 70, header->InterSectionColor);
+        }
+        if (fp->acad_version_number >= AC1018)
+        {
+                dxf_write_string (fp, 9, "$DIMASSOC");
+                dxf_write_int (fp, 280, header->DimASSOC);
+        }
+        if (fp->acad_version_number >= AC1018)
+        {
+                dxf_write_string (fp, 9, "$PROJECTNAME");
+                dxf_write_string (fp, 1, header->ProjectName);
+        }
         dxf_endsec_write (fp);
         /* Clean up. */
         free (dxf_entity_name);
@@ -1196,15 +2071,15 @@ dxf_header_read_parse_string
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char tstring[255];
-        int n, ret = SUCCESS;
+        DxfPair pair;
+        int ret = SUCCESS;
         if (strcmp (temp_string, header_var) == 0 && version_expression)
         {
                 ret = FOUND;
-                dxf_read_scanf (fp, "%i\n%s\n", &n, tstring);
-                if (dxf_read_is_string(n))
+                if ((dxf_lexer_read_pair (fp, &pair) == 1)
+                  && dxf_read_is_string (pair.group_code))
                 {
-                        *value_string = strdup(tstring);
+                        *value_string = dxf_pair_get_string (&pair);
                 }
                 else
                         ret = FAIL;
@@ -1232,7 +2107,8 @@ dxf_header_read_parse_int
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        int f, tvar, n, ret = SUCCESS;
+        DxfPair pair;
+        int ret = SUCCESS;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -1260,10 +2136,10 @@ dxf_header_read_parse_int
          * -3 makes it version agnostic */
         if (strcmp (temp_string, header_var) == 0  && version_expression)
         {
-                f = dxf_read_scanf (fp, "%i\n%i\n", &n, &tvar);
-                if (f > 0 && dxf_read_is_int(n))
+                if ((dxf_lexer_read_pair (fp, &pair) == 1)
+                  && dxf_read_is_int (pair.group_code))
                 {
-                        *value = tvar;
+                        *value = dxf_pair_get_int (&pair);
                         ret = FOUND;                                
                 }
                 else
@@ -1294,9 +2170,9 @@ dxf_header_read_parse_n_double
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        int f, n, i, ret = SUCCESS;
+        int i, ret = SUCCESS;
         double *dvar;
-        double tvar;
+        DxfPair pair;
         va_list dlist;
 
         /* Do some basic checks. */
@@ -1331,10 +2207,10 @@ dxf_header_read_parse_n_double
                 {
                         dvar = va_arg(dlist, double *);
                         /* prepare the string to read all vars */
-                        f = dxf_read_scanf (fp, "%d\n%'lf\n", &n, &tvar);
-                        if (f > 0 && dxf_read_is_double (n))
+                        if ((dxf_lexer_read_pair (fp, &pair) == 1)
+                          && dxf_read_is_double (pair.group_code))
                         {
-                                *dvar = tvar;
+                                *dvar = dxf_pair_get_double (&pair);
                         }
                         else
                         {
@@ -1356,6 +2232,14 @@ dxf_header_read_parse_n_double
 
 /*!
  * \brief Parses the header from a DXF file, with no particulary order.
+ *
+ * Looks up the variable named \c temp_string in the sorted table of
+ * known header variables and stores the value(s) following it in the
+ * member of \c header described there.
+ *
+ * \return \c FOUND when the value(s) were stored, \c FAIL when the
+ * variable is unknown, does not exist in \c acad_version_number, or
+ * its values could not be read.
  */
 int
 dxf_header_read_parser
@@ -1365,13 +2249,19 @@ dxf_header_read_parser
         DxfHeader *header,
                 /*!< DXF header to be initialized.\n */
         char * temp_string,
+                /*!< name of the variable, including the \c $. */
         int acad_version_number
+                /*!< AutoCAD version of the file. */
 )
 {
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        int ret;
+        const DxfHeaderVariable *variable;
+        char *member;
+        char **string;
+        DxfPair pair;
+        int i;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -1399,460 +2289,53 @@ dxf_header_read_parser
         * \todo: add some kind of control to what we have already read
         * and check if we read all header data.
         */
-        ret = dxf_header_read_parse_int (fp, temp_string, "$ACADMAINTVER",
-                                         &header->AcadMaintVer,
-                                         acad_version_number > AC1014);
-        dxf_return(ret);
-                
-        ret = dxf_header_read_parse_string (fp, temp_string, "$DWGCODEPAGE",
-                                            &header->DWGCodePage,
-                                            acad_version_number >= AC1012);
-        dxf_return(ret);
-        
-        ret = dxf_header_read_parse_n_double (fp, temp_string, "$INSBASE",
-                                              TRUE,
-                                              3,
-                                              &header->InsBase.x0,
-                                              &header->InsBase.y0,
-                                              &header->InsBase.z0);
-        dxf_return(ret);
-
-        ret = dxf_header_read_parse_n_double (fp, temp_string, "$EXTMIN",
-                                              TRUE,
-                                              3,
-                                              &header->ExtMin.x0,
-                                              &header->ExtMin.y0,
-                                              &header->ExtMin.z0);
-        dxf_return(ret);
-
-        ret = dxf_header_read_parse_n_double (fp, temp_string, "$EXTMAX",
-                                              TRUE,
-                                              3,
-                                              &header->ExtMax.x0,
-                                              &header->ExtMax.y0,
-                                              &header->ExtMax.z0);
-        dxf_return(ret);
-
-        ret = dxf_header_read_parse_n_double (fp, temp_string, "$LIMMIN",
-                                              TRUE,
-                                              2,
-                                              &header->LimMin.x0,
-                                              &header->LimMin.y0);
-        dxf_return(ret);
-
-        ret = dxf_header_read_parse_n_double (fp, temp_string, "$LIMMAX",
-                                              TRUE,
-                                              2,
-                                              &header->LimMax.x0,
-                                              &header->LimMax.y0);
-        dxf_return(ret);
-
-        ret = dxf_header_read_parse_int (fp, temp_string, "$ORTHOMODE",
-                                         &header->OrthoMode,
-                                         TRUE);
-        dxf_return(ret);
-
-        ret = dxf_header_read_parse_int (fp, temp_string, "$REGENMODE",
-                                         &header->RegenMode,
-                                         TRUE);
-        dxf_return(ret);
-
-        ret = dxf_header_read_parse_int (fp, temp_string, "$FILLMODE",
-                                         &header->FillMode,
-                                         TRUE);
-        dxf_return(ret);
-
-        ret = dxf_header_read_parse_int (fp, temp_string, "$QTEXTMODE",
-                                         &header->QTextMode,
-                                         TRUE);
-        dxf_return(ret);
-
-        ret = dxf_header_read_parse_int (fp, temp_string, "$MIRRTEXT",
-                                         &header->MirrText,
-                                         TRUE);
-        dxf_return(ret);
-
-        ret = dxf_header_read_parse_int (fp, temp_string, "$DRAGMODE",
-                                         &header->MirrText,
-                                         acad_version_number < AC1015);
-        dxf_return(ret);
-
-        ret = dxf_header_read_parse_n_double (fp, temp_string, "$LTSCALE",
-                                              TRUE,
-                                              1,
-                                              &header->LTScale);
-        dxf_return(ret);
-
-        ret = dxf_header_read_parse_int (fp, temp_string, "$OSMODE",
-                                         &header->OSMode,
-                                         acad_version_number <= AC1014);
-        dxf_return(ret);
-
-        ret = dxf_header_read_parse_int (fp, temp_string, "$ATTMODE",
-                                         &header->AttMode,
-                                         TRUE);
-        dxf_return(ret);
-    
-        ret = dxf_header_read_parse_n_double (fp, temp_string, "$TEXTSIZE",
-                                              TRUE,
-                                              1,
-                                              &header->TextSize);
-        dxf_return(ret);
-
-        ret = dxf_header_read_parse_n_double (fp, temp_string, "$TRACEWID",
-                                              TRUE,
-                                              1,
-                                              &header->TraceWid);
-        dxf_return(ret);
-
-        ret = dxf_header_read_parse_string (fp, temp_string, "$TEXTSTYLE",
-                                            &header->TextStyle,
-                                            TRUE);
-        dxf_return(ret);
-
-        ret = dxf_header_read_parse_string (fp, temp_string, "$CLAYER",
-                                            &header->CLayer,
-                                            TRUE);
-        dxf_return(ret);
-
-        ret = dxf_header_read_parse_string (fp, temp_string, "$CELTYPE",
-                                            &header->CELType,
-                                            TRUE);
-        dxf_return(ret);
-
-        ret = dxf_header_read_parse_int (fp, temp_string, "$CECOLOR",
-                                         &header->CEColor,
-                                         TRUE);
-        dxf_return(ret);
-
-        ret = dxf_header_read_parse_n_double (fp, temp_string, "$CELTSCALE",
-                                              acad_version_number >= AC1012,
-                                              1,
-                                              &header->CELTScale);
-        dxf_return(ret);
-
-        ret = dxf_header_read_parse_int (fp, temp_string, "$DELOBJ",
-                                         &header->DelObj,
-                                         (acad_version_number == AC1012)
-                                         || (acad_version_number == AC1014));
-        dxf_return(ret);
-
-        /*! \todo FIXME: changed from AC1012 to AC1015 */
-        ret = dxf_header_read_parse_int (fp, temp_string, "$DISPSILH",
-                                         &header->DispSilH,
-                                         acad_version_number <= AC1015);
-        dxf_return(ret);
-
-        ret = dxf_header_read_parse_n_double (fp, temp_string, "$DIMSCALE",
-                                              TRUE,
-                                              1,
-                                              &header->DimSCALE);
-        dxf_return(ret);
-
-        ret = dxf_header_read_parse_n_double (fp, temp_string, "$DIMASZ",
-                                              TRUE,
-                                              1,
-                                              &header->DimASZ);
-        dxf_return(ret);
-
-        ret = dxf_header_read_parse_n_double (fp, temp_string, "$DIMEXO",
-                                              TRUE,
-                                              1,
-                                              &header->DimEXO);
-        dxf_return(ret);
-
-        /*
-        fprintf (fp, "  9\n$DIMDLI\n 40\n%f\n", header->DimDLI);
-        fprintf (fp, "  9\n$DIMRND\n 40\n%f\n", header->DimRND);
-        fprintf (fp, "  9\n$DIMDLE\n 40\n%f\n", header->DimDLE);
-        */
-        ret = dxf_header_read_parse_n_double (fp, temp_string, "$DIMEXE",
-                                              TRUE,
-                                              1,
-                                              &header->DimEXE);
-        dxf_return(ret);
-        /*
-        fprintf (fp, "  9\n$DIMTP\n 40\n%f\n", header->DimTP);
-        fprintf (fp, "  9\n$DIMTM\n 40\n%f\n", header->DimTM);
-        */
-        ret = dxf_header_read_parse_n_double (fp, temp_string, "$DIMTXT",
-                                              TRUE,
-                                              1,
-                                              &header->DimTXT);
-        dxf_return(ret);
-        /*
-        fprintf (fp, "  9\n$DIMCEN\n 40\n%f\n", header->DimCEN);
-        fprintf (fp, "  9\n$DIMTSZ\n 40\n%f\n", header->DimTSZ);
-        fprintf (fp, "  9\n$DIMTOL\n 70\n%i\n", header->DimTOL);
-        fprintf (fp, "  9\n$DIMLIM\n 70\n%i\n", header->DimLIM);
-        fprintf (fp, "  9\n$DIMTIH\n 70\n%i\n", header->DimTIH);
-        fprintf (fp, "  9\n$DIMTOH\n 70\n%i\n", header->DimTOH);
-        fprintf (fp, "  9\n$DIMSE1\n 70\n%i\n", header->DimSE1);
-        fprintf (fp, "  9\n$DIMSE2\n 70\n%i\n", header->DimSE2);
-        fprintf (fp, "  9\n$DIMTAD\n 70\n%i\n", header->DimTAD);
-        fprintf (fp, "  9\n$DIMZIN\n 70\n%i\n", header->DimZIN);
-        fprintf (fp, "  9\n$DIMBLK\n  1\n%s\n", header->DimBLK);
-        fprintf (fp, "  9\n$DIMASO\n 70\n%i\n", header->DimASO);
-        fprintf (fp, "  9\n$DIMSHO\n 70\n%i\n", header->DimSHO);
-        fprintf (fp, "  9\n$DIMPOST\n  1\n%s\n", header->DimPOST);
-        fprintf (fp, "  9\n$DIMAPOST\n  1\n%s\n", header->DimAPOST);
-        fprintf (fp, "  9\n$DIMALT\n 70\n%i\n", header->DimALT);
-        fprintf (fp, "  9\n$DIMALTD\n 70\n%i\n", header->DimALTD);
-        fprintf (fp, "  9\n$DIMALTF\n 40\n%f\n", header->DimALTF);
-        fprintf (fp, "  9\n$DIMLFAC\n 40\n%f\n", header->DimLFAC);
-        fprintf (fp, "  9\n$DIMTOFL\n 70\n%i\n", header->DimTOFL);
-        fprintf (fp, "  9\n$DIMTVP\n 40\n%f\n", header->DimTVP);
-        fprintf (fp, "  9\n$DIMTIX\n 70\n%i\n", header->DimTIX);
-        fprintf (fp, "  9\n$DIMSOXD\n 70\n%i\n", header->DimSOXD);
-        fprintf (fp, "  9\n$DIMSAH\n 70\n%i\n", header->DimSAH);
-        fprintf (fp, "  9\n$DIMBLK1\n  1\n%s\n", header->DimBLK1);
-        fprintf (fp, "  9\n$DIMBLK2\n  1\n%s\n", header->DimBLK2);
-        */
-        ret = dxf_header_read_parse_string (fp, temp_string, "$DIMSTYLE",
-                                            &header->DimSTYLE,
-                                            TRUE);
-        dxf_return(ret);
-        /*
-        fprintf (fp, "  9\n$DIMCLRD\n 70\n%i\n", header->DimCLRD);
-        fprintf (fp, "  9\n$DIMCLRE\n 70\n%i\n", header->DimCLRE);
-        fprintf (fp, "  9\n$DIMCLRT\n 70\n%i\n", header->DimCLRT);
-        fprintf (fp, "  9\n$DIMTFAC\n 40\n%f\n", header->DimTFAC);
-        */
-        ret = dxf_header_read_parse_n_double (fp, temp_string, "$DIMGAP",
-                                              TRUE,
-                                              1,
-                                              &header->DimGAP);
-        dxf_return(ret);
-        /*
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$DIMJUST\n 70\n%i\n", header->DimJUST);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$DIMSD1\n 70\n%i\n", header->DimSD1);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$DIMSD2\n 70\n%i\n", header->DimSD2);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$DIMTOLJ\n 70\n%i\n", header->DimTOLJ);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$DIMTZIN\n 70\n%i\n", header->DimTZIN);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$DIMALTZ\n 70\n%i\n", header->DimALTZ);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$DIMALTTZ\n 70\n%i\n", header->DimALTTZ);
-        if ((acad_version_number == AC1012) || (acad_version_number == AC1014)) fprintf (fp, "  9\n$DIMFIT\n 70\n%i\n", header->DimFIT);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$DIMUPT\n 70\n%i\n", header->DimUPT);
-        if ((acad_version_number == AC1012) || (acad_version_number == AC1014)) fprintf (fp, "  9\n$DIMUNIT\n 70\n%i\n", header->DimUNIT);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$DIMDEC\n 70\n%i\n", header->DimDEC);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$DIMTDEC\n 70\n%i\n", header->DimTDEC);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$DIMALTU\n 70\n%i\n", header->DimALTU);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$DIMALTTD\n 70\n%i\n", header->DimALTTD);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$DIMTXSTY\n  7\n%s\n", header->DimTXSTY);
-        */
-        ret = dxf_header_read_parse_int (fp, temp_string, "$DIMAUNIT",
-                                         &header->DimAUNIT,
-                                         acad_version_number >= AC1012);
-        dxf_return(ret);
-    
-        ret = dxf_header_read_parse_int (fp, temp_string, "$DIMADEC",
-                                         &header->DimADEC,
-                                         acad_version_number >= AC1015);
-        dxf_return(ret);
-        /*
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$DIMALTRND\n 40\n%f\n", header->DimALTRND);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$DIMAZIN\n 70\n%i\n", header->DimAZIN);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$DIMDSEP\n 70\n%i\n", header->DimDSEP);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$DIMATFIT\n 70\n%i\n", header->DimATFIT);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$DIMFRAC\n 70\n%i\n", header->DimFRAC);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$DIMLDRBLK\n  1\n%s\n", header->DimLDRBLK);
-        */
-        ret = dxf_header_read_parse_int (fp, temp_string, "$DIMLUNIT",
-                                         &header->DimLUNIT,
-                                         acad_version_number >= AC1015);
-        dxf_return(ret);
-        /*
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$DIMLWD\n 70\n%i\n", header->DimLWD);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$DIMLWE\n 70\n%i\n", header->DimLWE);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$DIMTMOVE\n 70\n%i\n", header->DimTMOVE);
-        */
-        ret = dxf_header_read_parse_int (fp, temp_string, "$LUNITS",
-                                         &header->LUnits,
-                                         TRUE);
-        dxf_return(ret);
-        
-        ret = dxf_header_read_parse_int (fp, temp_string, "$LUPREC",
-                                         &header->LUPrec,
-                                         TRUE);
-        dxf_return(ret);
-        /*
-        fprintf (fp, "  9\n$SKETCHINC\n 40\n%f\n", header->Sketchinc);
-        fprintf (fp, "  9\n$FILLETRAD\n 40\n%f\n", header->FilletRad);
-        */
-        ret = dxf_header_read_parse_int (fp, temp_string, "$AUNITS",
-                                         &header->AUnits,
-                                         TRUE);
-        dxf_return(ret);
-    
-        ret = dxf_header_read_parse_int (fp, temp_string, "$AUPREC",
-                                         &header->AUPrec,
-                                         TRUE);
-        dxf_return(ret);
-        /*
-        fprintf (fp, "  9\n$MENU\n  1\n%s\n", header->Menu);
-        fprintf (fp, "  9\n$ELEVATION\n 40\n%f\n", header->Elevation);
-        fprintf (fp, "  9\n$PELEVATION\n 40\n%f\n", header->PElevation);
-        fprintf (fp, "  9\n$THICKNESS\n 40\n%f\n", header->Thickness);
-        fprintf (fp, "  9\n$LIMCHECK\n 70\n%i\n", header->LimCheck);
-        if (acad_version_number <= AC1014) fprintf (fp, "  9\n$BLIPMODE\n 70\n%i\n", header->BlipMode);
-        fprintf (fp, "  9\n$CHAMFERA\n 40\n%f\n", header->ChamferA);
-        fprintf (fp, "  9\n$CHAMFERB\n 40\n%f\n", header->ChamferB);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$CHAMFERC\n 40\n%f\n", header->ChamferC);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$CHAMFERD\n 40\n%f\n", header->ChamferD);
-        fprintf (fp, "  9\n$SKPOLY\n 70\n%i\n", header->SKPoly);
-        fprintf (fp, "  9\n$TDCREATE\n 40\n%f\n", header->TDCreate);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$TDUCREATE\n 40\n%f\n", header->TDUCreate);
-        fprintf (fp, "  9\n$TDUPDATE\n 40\n%f\n", header->TDUpdate);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$TDUUPDATE\n 40\n%f\n", header->TDUUpdate);
-        fprintf (fp, "  9\n$TDINDWG\n 40\n%f\n", header->TDInDWG);
-        fprintf (fp, "  9\n$TDUSRTIMER\n 40\n%f\n", header->TDUSRTimer);
-        fprintf (fp, "  9\n$USRTIMER\n 70\n%i\n", header->USRTimer);
-        fprintf (fp, "  9\n$ANGBASE\n 50\n%f\n", header->AngBase);
-        fprintf (fp, "  9\n$ANGDIR\n 70\n%i\n", header->AngDir);
-        fprintf (fp, "  9\n$PDMODE\n 70\n%i\n", header->PDMode);
-        fprintf (fp, "  9\n$PDSIZE\n 40\n%f\n", header->PDSize);
-        fprintf (fp, "  9\n$PLINEWID\n 40\n%f\n", header->PLineWid);
-        if (acad_version_number <= AC1014) fprintf (fp, "  9\n$COORDS\n 70\n%i\n", header->Coords);
-        fprintf (fp, "  9\n$SPLFRAME\n 70\n%i\n", header->SPLFrame);
-        fprintf (fp, "  9\n$SPLINETYPE\n 70\n%i\n", header->SPLineType);
-        if (acad_version_number <= AC1014) fprintf (fp, "  9\n$ATTDIA\n 70\n%i\n", header->AttDia);
-        if (acad_version_number <= AC1014) fprintf (fp, "  9\n$ATTREQ\n 70\n%i\n", header->AttReq);
-        if (acad_version_number <= AC1014) fprintf (fp, "  9\n$HANDLING\n 70\n%i\n", header->Handling);
-        */
-        ret = dxf_header_read_parse_int (fp, temp_string, "$SPLINESEGS",
-                                         &header->SPLineSegs,
-                                         TRUE);
-        dxf_return(ret);
-        
-        ret = dxf_header_read_parse_string (fp, temp_string, "$HANDSEED",
-                                            &header->HandSeed,
-                                            TRUE);
-        dxf_return(ret);
-    /*
-        fprintf (fp, "  9\n$SURFTAB1\n 70\n%i\n", header->SurfTab1);
-        fprintf (fp, "  9\n$SURFTAB2\n 70\n%i\n", header->SurfTab2);
-        fprintf (fp, "  9\n$SURFTYPE\n 70\n%i\n", header->SurfType);
-        fprintf (fp, "  9\n$SURFU\n 70\n%i\n", header->SurfU);
-        fprintf (fp, "  9\n$SURFV\n 70\n%i\n", header->SurfV);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$UCSBASE\n  2\n%s\n", header->UCSBase);
-        fprintf (fp, "  9\n$UCSNAME\n  2\n%s\n", header->UCSName);
-        fprintf (fp, "  9\n$UCSORG\n 10\n%f\n 20\n%f\n 30\n%f\n", header->UCSOrg.x0, header->UCSOrg.y0, header->UCSOrg.z0);
-        fprintf (fp, "  9\n$UCSXDIR\n 10\n%f\n 20\n%f\n 30\n%f\n", header->UCSXDir.x0, header->UCSXDir.y0, header->UCSXDir.z0);
-        fprintf (fp, "  9\n$UCSYDIR\n 10\n%f\n 20\n%f\n 30\n%f\n", header->UCSYDir.x0, header->UCSYDir.y0, header->UCSYDir.z0);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$UCSORTHOREF\n  2\n%s\n", header->UCSOrthoRef);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$UCSORTHOVIEW\n 70\n%i\n", header->UCSOrthoView);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$UCSORGTOP\n 10\n%f\n 20\n%f\n 30\n%f\n", header->UCSOrgTop.x0, header->UCSOrgTop.y0, header->UCSOrgTop.z0);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$UCSORGBOTTOM\n 10\n%f\n 20\n%f\n 30\n%f\n", header->UCSOrgBottom.x0, header->UCSOrgBottom.y0, header->UCSOrgBottom.z0);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$UCSORGLEFT\n 10\n%f\n 20\n%f\n 30\n%f\n", header->UCSOrgLeft.x0, header->UCSOrgLeft.y0, header->UCSOrgLeft.z0);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$UCSORGRIGHT\n 10\n%f\n 20\n%f\n 30\n%f\n", header->UCSOrgRight.x0, header->UCSOrgRight.y0, header->UCSOrgRight.z0);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$UCSORGFRONT\n 10\n%f\n 20\n%f\n 30\n%f\n", header->UCSOrgFront.x0, header->UCSOrgFront.y0, header->UCSOrgFront.z0);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$UCSORGBACK\n 10\n%f\n 20\n%f\n 30\n%f\n", header->UCSOrgBack.x0, header->UCSOrgBack.y0, header->UCSOrgBack.z0);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$PUCSBASE\n  2\n%s\n", header->PUCSBase);
-        fprintf (fp, "  9\n$PUCSNAME\n  2\n%s\n", header->PUCSName);
-        fprintf (fp, "  9\n$PUCSORG\n 10\n%f\n 20\n%f\n 30\n%f\n", header->PUCSOrg.x0, header->PUCSOrg.y0, header->PUCSOrg.z0);
-        fprintf (fp, "  9\n$PUCSXDIR\n 10\n%f\n 20\n%f\n 30\n%f\n", header->PUCSXDir.x0, header->PUCSXDir.y0, header->PUCSXDir.z0);
-        fprintf (fp, "  9\n$PUCSYDIR\n 10\n%f\n 20\n%f\n 30\n%f\n", header->PUCSYDir.x0, header->PUCSYDir.y0, header->PUCSYDir.z0);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$PUCSORTHOREF\n  2\n%s\n", header->PUCSOrthoRef);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$PUCSORTHOVIEW\n 70\n%i\n", header->PUCSOrthoView);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$PUCSORGTOP\n 10\n%f\n 20\n%f\n 30\n%f\n", header->PUCSOrgTop.x0, header->PUCSOrgTop.y0, header->PUCSOrgTop.z0);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$PUCSORGBOTTOM\n 10\n%f\n 20\n%f\n 30\n%f\n", header->PUCSOrgBottom.x0, header->PUCSOrgBottom.y0, header->PUCSOrgBottom.z0);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$PUCSORGLEFT\n 10\n%f\n 20\n%f\n 30\n%f\n", header->PUCSOrgLeft.x0, header->PUCSOrgLeft.y0, header->PUCSOrgLeft.z0);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$PUCSORGRIGHT\n 10\n%f\n 20\n%f\n 30\n%f\n", header->PUCSOrgRight.x0, header->PUCSOrgRight.y0, header->PUCSOrgRight.z0);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$PUCSORGFRONT\n 10\n%f\n 20\n%f\n 30\n%f\n", header->PUCSOrgFront.x0, header->PUCSOrgFront.y0, header->PUCSOrgFront.z0);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$PUCSORGBACK\n 10\n%f\n 20\n%f\n 30\n%f\n", header->PUCSOrgBack.x0, header->PUCSOrgBack.y0, header->PUCSOrgBack.z0);
-        fprintf (fp, "  9\n$USERI1\n 70\n%i\n", header->UserI1);
-        fprintf (fp, "  9\n$USERI2\n 70\n%i\n", header->UserI2);
-        fprintf (fp, "  9\n$USERI3\n 70\n%i\n", header->UserI3);
-        fprintf (fp, "  9\n$USERI4\n 70\n%i\n", header->UserI4);
-        fprintf (fp, "  9\n$USERI5\n 70\n%i\n", header->UserI5);
-        fprintf (fp, "  9\n$USERR1\n 40\n%f\n", header->UserR1);
-        fprintf (fp, "  9\n$USERR2\n 40\n%f\n", header->UserR2);
-        fprintf (fp, "  9\n$USERR3\n 40\n%f\n", header->UserR3);
-        fprintf (fp, "  9\n$USERR4\n 40\n%f\n", header->UserR4);
-        fprintf (fp, "  9\n$USERR5\n 40\n%f\n", header->UserR5);
-        fprintf (fp, "  9\n$WORLDVIEW\n 70\n%i\n", header->WorldView);
-        fprintf (fp, "  9\n$SHADEDGE\n 70\n%i\n", header->ShadEdge);
-        fprintf (fp, "  9\n$SHADEDIF\n 70\n%i\n", header->ShadeDif);
-        fprintf (fp, "  9\n$TILEMODE\n 70\n%i\n", header->TileMode);
-        fprintf (fp, "  9\n$MAXACTVP\n 70\n%i\n", header->MaxActVP);
-        fprintf (fp, "  9\n$PINSBASE\n 10\n%f\n 20\n%f\n 30\n%f\n", header->PInsBase.x0, header->PInsBase.y0, header->PInsBase.z0);
-        fprintf (fp, "  9\n$PLIMCHECK\n 70\n%i\n", header->PLimCheck);
-        fprintf (fp, "  9\n$PEXTMIN\n 10\n%f\n 20\n%f\n 30\n%f\n", header->PExtMin.x0, header->PExtMin.y0, header->PExtMin.z0);
-        fprintf (fp, "  9\n$PEXTMAX\n 10\n%f\n 20\n%f\n 30\n%f\n", header->PExtMax.x0, header->PExtMax.y0, header->PExtMax.z0);
-        */
-        ret = dxf_header_read_parse_n_double (fp, temp_string, "$PLIMMIN",
-                                              TRUE,
-                                              2,
-                                              &header->PLimMin.x0,
-                                              header->PLimMin.y0);
-        dxf_return(ret);
-    
-        ret = dxf_header_read_parse_n_double (fp, temp_string, "$PLIMMAX",
-                                              TRUE,
-                                              2,
-                                              &header->PLimMax.x0,
-                                              header->PLimMax.y0);
-        dxf_return(ret);
-        /*
-        fprintf (fp, "  9\n$UNITMODE\n 70\n%i\n", header->UnitMode);
-        fprintf (fp, "  9\n$VISRETAIN\n 70\n%i\n", header->VisRetain);
-        fprintf (fp, "  9\n$PLINEGEN\n 70\n%i\n", header->PLineGen);
-        fprintf (fp, "  9\n$PSLTSCALE\n 70\n%i\n", header->PSLTScale);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$TREEDEPTH\n 70\n%i\n", header->TreeDepth);
-        if ((acad_version_number == AC1012) || (acad_version_number == AC1014)) fprintf (fp, "  9\n$PICKSTYLE\n 70\n%i\n", header->PickStyle);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$CMLSTYLE\n  2\n%s\n", header->CMLStyle);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$CMLJUST\n 70\n%i\n", header->CMLJust);
-        if (acad_version_number >= AC1012) fprintf (fp, "  9\n$CMLSCALE\n 40\n%f\n", header->CMLScale);
-        if (acad_version_number >= AC1014) fprintf (fp, "  9\n$PROXYGRAPHICS\n 70\n%i\n", header->ProxyGraphics);
-        if (acad_version_number >= AC1014) fprintf (fp, "  9\n$MEASUREMENT\n 70\n%i\n", header->Measurement);
-        if (acad_version_number == AC1012) fprintf (fp, "  9\n$SAVEIMAGES\n 70\n%i\n", header->SaveImages);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$CELWEIGHT\n370\n%i\n", header->CELWeight);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$ENDCAPS\n280\n%i\n", header->EndCaps);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$JOINSTYLE\n280\n%i\n", header->JoinStyle);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$LWDISPLAY\n290\n%i\n", header->LWDisplay);
-        */
-        ret = dxf_header_read_parse_int (fp, temp_string, "$INSUNITS",
-                                         &header->InsUnits,
-                                         acad_version_number >= AC1015);
-        dxf_return(ret);
-        /*
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$HYPERLINKBASE\n  1\n%s\n", header->HyperLinkBase);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$STYLESHEET\n  1\n%s\n", header->StyleSheet);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$XEDIT\n290\n%i\n", header->XEdit);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$CEPSNTYPE\n380\n%i\n", header->CEPSNType);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$PSTYLEMODE\n290\n%i\n", header->PStyleMode);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$FINGERPRINTGUID\n  2\n%s\n", header->FingerPrintGUID);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$VERSIONGUID\n  2\n%s\n", header->VersionGUID);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$EXTNAMES\n290\n%i\n", header->ExtNames);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$PSVPSCALE\n 40\n%f\n", header->PSVPScale);
-        if (acad_version_number >= AC1015) fprintf (fp, "  9\n$OLESTARTUP\n290\n%i\n", header->OLEStartUp);
-        if (acad_version_number >= AC1018) fprintf (fp, "  9\n$SORTENTS\n280\n%i\n", header->SortEnts);
-        if (acad_version_number >= AC1018) fprintf (fp, "  9\n$INDEXCTL\n280\n%i\n", header->IndexCtl);
-        if (acad_version_number >= AC1018) fprintf (fp, "  9\n$HIDETEXT\n280\n%i\n", header->HideText);
-        if (acad_version_number >= AC1018) fprintf (fp, "  9\n$XCLIPFRAME\n290\n%i\n", header->XClipFrame);
-        if (acad_version_number >= AC1018) fprintf (fp, "  9\n$HALOGAP\n280\n%i\n", header->HaloGap);
-        if (acad_version_number >= AC1018) fprintf (fp, "  9\n$OBSCOLOR\n 70\n%i\n", header->ObsColor);
-        if (acad_version_number >= AC1018) fprintf (fp, "  9\n$OBSLTYPE\n280\n%i\n", header->ObsLType);
-        if (acad_version_number >= AC1018) fprintf (fp, "  9\n$INTERSECTIONDISPLAY\n280\n%i\n", header->InterSectionDisplay);
-        if (acad_version_number >= AC1018) fprintf (fp, "  9\n$INTERSECTIONCOLOR\n 70\n%i\n", header->InterSectionColor);
-        if (acad_version_number >= AC1018) fprintf (fp, "  9\n$DIMASSOC\n280\n%i\n", header->DimASSOC);
-        if (acad_version_number >= AC1018) fprintf (fp, "  9\n$PROJECTNAME\n  1\n%s\n", header->ProjectName);        
-*/
-        ret = dxf_header_read_parse_n_double (fp, temp_string, "$GRIDUNIT",
-                                              acad_version_number >= AC1009,
-                                              2,
-                                              &header->GridUnit.x0,
-                                              &header->GridUnit.y0);
-        dxf_return(ret);
-
-        ret = dxf_header_read_parse_int (fp, temp_string, "$GRIDMODE",
-                                         &header->GridMode,
-                                         acad_version_number >= AC1009);
-        dxf_return(ret);
+        variable = bsearch (temp_string, dxf_header_variables,
+          DXF_HEADER_VARIABLES, sizeof (DxfHeaderVariable),
+          dxf_header_variable_compare);
+        if ((variable == NULL)
+          || (acad_version_number < variable->min_version)
+          || (acad_version_number > variable->max_version))
+        {
+                return (FAIL);
+        }
+        member = (char *) header + variable->offset;
+        for (i = 0; i < variable->count; i++)
+        {
+                if (dxf_lexer_read_pair (fp, &pair) != 1)
+                {
+                        return (FAIL);
+                }
+                switch (variable->type)
+                {
+                        case DXF_HEADER_VARIABLE_STRING:
+                                if (!dxf_read_is_string (pair.group_code))
+                                {
+                                        return (FAIL);
+                                }
+                                string = (char **) member;
+                                free (*string);
+                                *string = dxf_pair_get_string (&pair);
+                                break;
+                        case DXF_HEADER_VARIABLE_INT:
+                                if (!dxf_read_is_int (pair.group_code))
+                                {
+                                        return (FAIL);
+                                }
+                                *(int *) member = dxf_pair_get_int (&pair);
+                                break;
+                        case DXF_HEADER_VARIABLE_DOUBLE:
+                                if (!dxf_read_is_double (pair.group_code))
+                                {
+                                        return (FAIL);
+                                }
+                                ((double *) member)[i] = dxf_pair_get_double (&pair);
+                                break;
+                }
+        }
 #if DEBUG
         DXF_DEBUG_END
 #endif
-       return FALSE;
+        return (FOUND);
 }
 
 /*!
@@ -1871,7 +2354,8 @@ dxf_header_read
         DXF_DEBUG_BEGIN
 #endif
         char temp_string[255];
-        int n, acad_version_number, ret;
+        int acad_version_number, ret;
+        DxfPair pair;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -1897,7 +2381,11 @@ dxf_header_read
                 return (NULL);
         }
         /* first of all we MUST read the version number */
-        dxf_read_scanf (fp, "%i\n%s\n", &n, temp_string);
+        if (dxf_lexer_read_pair (fp, &pair) != 1)
+        {
+                return (NULL);
+        }
+        dxf_pair_copy_string (&pair, temp_string, sizeof (temp_string));
         ret = dxf_header_read_parse_string (fp, temp_string,
           "$ACADVER", &header->AcadVer, TRUE);
         dxf_return_val_if_fail (ret, FALSE);
@@ -1908,13 +2396,12 @@ dxf_header_read
         header->_AcadVer = acad_version_number;
     
         /* a loop to read all the header with no particulary order */
-        while (!feof (fp->fp))
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                /* reads the next header content */
-                dxf_read_scanf (fp, "%i\n%s\n", &n, temp_string);
                 /* if it is a valid line */
-                if (n == 9)
+                if (pair.group_code == 9)
                 {
+                        dxf_pair_copy_string (&pair, temp_string, sizeof (temp_string));
                         /* parses the header content and extract info to the header struct */
                         ret = dxf_header_read_parser (fp, header,
                           temp_string, acad_version_number);
@@ -1923,13 +2410,16 @@ dxf_header_read
                                 return FALSE;
                 }
                 /* or it can be the end of the section */
-                else if (n == 0 && strcmp (temp_string, "ENDSEC") == 0)
+                else if (pair.group_code == 0)
                 {
 #if DEBUG
                         fprintf (stderr,
                           (_("[File: %s: line: %d] read_header :: Section Ended.\n")),
                           __FILE__, __LINE__);
 #endif
+                        /* Leave the ENDSEC marker for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }        
         }
 #if DEBUG
@@ -1959,7 +2449,7 @@ dxf_header_free
                  * entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (header == NULL)
@@ -2024,7 +2514,7 @@ dxf_header_free
         free (header->ProjectName);
         free (header);
         header = NULL;
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_END
 #endif
         return (header);
@@ -49,7 +49,7 @@ extern "C" {
 typedef struct
 dxf_header
 {
-        int id_code;
+        long id_code;
                 /*!< group code = 5. */
         char *AcadVer;
                 /*!< */
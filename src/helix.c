@@ -35,6 +35,9 @@
 
 
 #include "helix.h"
+#include "arena.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -57,7 +60,7 @@ dxf_helix_new ()
         size = sizeof (DxfHelix);
         /* avoid malloc of 0 bytes */
         if (size == 0) size = 1;
-        if ((helix = malloc (size)) == NULL)
+        if ((helix = dxf_malloc (size)) == NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () could not allocate memory for a DxfHelix struct.\n")),
@@ -108,34 +111,21 @@ dxf_helix_init
               return (NULL);
         }
         helix->id_code = 0;
-        helix->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        helix->layer = strdup (DXF_DEFAULT_LAYER);
+        helix->properties = dxf_graphic_properties_default ();
         helix->p0 = dxf_point_init (helix->p0);
         helix->p1 = dxf_point_init (helix->p1);
         helix->p2 = dxf_point_init (helix->p2);
-        helix->thickness = 0.0;
         helix->radius = 0.0;
         helix->number_of_turns = 0.0;
         helix->turn_height = 0.0;
-        helix->linetype_scale = 0.0;
-        helix->visibility = 0;
-        helix->color = DXF_COLOR_BYLAYER;
-        helix->paperspace = DXF_MODELSPACE;
         helix->major_release_number = 0;
         helix->maintainance_release_number = 0;
         helix->graphics_data_size = 0;
         helix->constraint_type = 0;
-        helix->shadow_mode = 0;
         helix->handedness = 0;
         helix->binary_graphics_data = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_init (helix->binary_graphics_data);
-        helix->dictionary_owner_hard = strdup ("");
-        helix->material = strdup ("");
-        helix->dictionary_owner_soft = strdup ("");
-        helix->lineweight = 0;
-        helix->plot_style_name = strdup ("");
-        helix->color_value = 0;
-        helix->color_name = strdup ("");
-        helix->transparency = 0;
+        helix->dictionary_owner_hard = dxf_strdup ("");
+        helix->dictionary_owner_soft = dxf_strdup ("");
         helix->spline = (DxfSpline *) dxf_spline_init (helix->spline);
         helix->next = NULL;
 #if DEBUG
@@ -169,8 +159,11 @@ dxf_helix_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfGraphicProperties properties;
+        DxfPair pair;
         int i;
+        DxfBinaryGraphicsData *binary_graphics_data = NULL;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -178,8 +171,6 @@ dxf_helix_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (helix == NULL)
@@ -190,316 +181,250 @@ dxf_helix_read
                 helix = dxf_helix_new ();
                 helix = dxf_helix_init (helix);
         }
+        binary_graphics_data = (DxfBinaryGraphicsData *) helix->binary_graphics_data;
         i = 0;
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        dxf_graphic_properties_start (&properties, helix->properties);
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        fclose (fp->fp);
-                        /* Clean up. */
-                        free (temp_string);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &helix->id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", helix->linetype);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", helix->layer);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the axis base point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &helix->p0->x0);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the axis base point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &helix->p0->y0);
-                }
-                else if (strcmp (temp_string, "30") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the axis base point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &helix->p0->z0);
-                }
-                else if (strcmp (temp_string, "11") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the start point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &helix->p1->x0);
-                }
-                else if (strcmp (temp_string, "21") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the start point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &helix->p1->y0);
-                }
-                else if (strcmp (temp_string, "31") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the start point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &helix->p1->z0);
-                }
-                else if (strcmp (temp_string, "12") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the axis vector point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &helix->p2->x0);
-                }
-                else if (strcmp (temp_string, "22") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the axis vector point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &helix->p2->y0);
-                }
-                else if (strcmp (temp_string, "32") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the axis vector point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &helix->p2->z0);
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &helix->thickness);
-                }
-                else if (strcmp (temp_string, "40") == 0)
-                {
-                        /* Now follows a string containing the
-                         * radius. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &helix->radius);
-                }
-                else if (strcmp (temp_string, "41") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing the number of
-                         * turns. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &helix->number_of_turns);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else if (strcmp (temp_string, "42") == 0)
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing the turn
-                         * height. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &helix->turn_height);
-                }
-                else if (strcmp (temp_string, "48") == 0)
-                {
-                        /* Now follows a string containing the linetype
-                         * scale. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &helix->linetype_scale);
-                }
-                else if (strcmp (temp_string, "60") == 0)
-                {
-                        /* Now follows a string containing the
-                         * visibility value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &helix->visibility);
-                }
-                else if (strcmp (temp_string, "62") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &helix->color);
-                }
-                else if (strcmp (temp_string, "67") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &helix->paperspace);
-                }
-                else if (strcmp (temp_string, "90") == 0)
-                {
-                        /* Now follows a string containing a major
-                         * release number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%ld\n", &helix->major_release_number);
-                }
-                else if (strcmp (temp_string, "91") == 0)
-                {
-                        /* Now follows a string containing a maintenance
-                         * release number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%ld\n", &helix->maintainance_release_number);
-                }
-                else if (strcmp (temp_string, "92") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &helix->graphics_data_size);
-                }
-                else if (strcmp (temp_string, "100") == 0)
-                {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if ((strcmp (temp_string, "AcDbSpline") == 0))
-                        {
-                                helix->spline = dxf_spline_read (fp, helix->spline);
-                        }
-                        else if ((strcmp (temp_string, "AcDbEntity") != 0)
-                                && ((strcmp (temp_string, "AcDbHelix") != 0)))
-                        {
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                helix->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 6:
+                                /* Now follows a string containing a linetype
+                                 * name. */
+                                dxf_lexer_free_string (fp, properties.linetype);
+                                properties.linetype = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 8:
+                                /* Now follows a string containing a layer name. */
+                                dxf_lexer_free_string (fp, properties.layer);
+                                properties.layer = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 10:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the axis base point. */
+                                helix->p0->x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 20:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the axis base point. */
+                                helix->p0->y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 30:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the axis base point. */
+                                helix->p0->z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 11:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the start point. */
+                                helix->p1->x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 21:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the start point. */
+                                helix->p1->y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 31:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the start point. */
+                                helix->p1->z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 12:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the axis vector point. */
+                                helix->p2->x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 22:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the axis vector point. */
+                                helix->p2->y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 32:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the axis vector point. */
+                                helix->p2->z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 39:
+                                /* Now follows a string containing the
+                                 * thickness. */
+                                properties.thickness = dxf_pair_get_double (&pair);
+                                break;
+                        case 40:
+                                /* Now follows a string containing the
+                                 * radius. */
+                                helix->radius = dxf_pair_get_double (&pair);
+                                break;
+                        case 41:
+                                /* Now follows a string containing the number of
+                                 * turns. */
+                                helix->number_of_turns = dxf_pair_get_double (&pair);
+                                break;
+                        case 42:
+                                /* Now follows a string containing the turn
+                                 * height. */
+                                helix->turn_height = dxf_pair_get_double (&pair);
+                                break;
+                        case 48:
+                                /* Now follows a string containing the linetype
+                                 * scale. */
+                                properties.linetype_scale = dxf_pair_get_double (&pair);
+                                break;
+                        case 60:
+                                /* Now follows a string containing the
+                                 * visibility value. */
+                                properties.visibility = dxf_pair_get_int (&pair);
+                                break;
+                        case 62:
+                                /* Now follows a string containing the
+                                 * color value. */
+                                properties.color = dxf_pair_get_int (&pair);
+                                break;
+                        case 67:
+                                /* Now follows a string containing the
+                                 * paperspace value. */
+                                properties.paperspace = dxf_pair_get_int (&pair);
+                                break;
+                        case 90:
+                                /* Now follows a string containing a major
+                                 * release number. */
+                                helix->major_release_number = dxf_pair_get_long (&pair);
+                                break;
+                        case 91:
+                                /* Now follows a string containing a maintenance
+                                 * release number. */
+                                helix->maintainance_release_number = dxf_pair_get_long (&pair);
+                                break;
+                        case 92:
+                                /* Now follows a string containing the
+                                 * paperspace value. */
+                                helix->graphics_data_size = dxf_pair_get_int (&pair);
+                                break;
+                        case 100:
+                                /* Now follows a string containing the
+                                 * subclass marker value. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                if ((strcmp (temp_string, "AcDbSpline") == 0))
+                                {
+                                        helix->spline = dxf_spline_read (fp, helix->spline);
+                                }
+                                else if ((strcmp (temp_string, "AcDbEntity") != 0)
+                                        && ((strcmp (temp_string, "AcDbHelix") != 0)))
+                                {
+                                        fprintf (stderr,
+                                          (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                }
+                                break;
+                        case 160:
+                                /* Now follows a string containing the
+                                 * graphics data size value. */
+                                helix->graphics_data_size = dxf_pair_get_int (&pair);
+                                break;
+                        case 280:
+                                /* Now follows a string containing a constraint
+                                 * type value. */
+                                helix->constraint_type = dxf_pair_get_int (&pair);
+                                break;
+                        case 284:
+                                /* Now follows a string containing the shadow
+                                 * mode value. */
+                                properties.shadow_mode = dxf_pair_get_int (&pair);
+                                break;
+                        case 290:
+                                /* Now follows a string containing a handedness
+                                 * value. */
+                                helix->handedness = dxf_pair_get_int (&pair);
+                                break;
+                        case 310:
+                                /* Now follows a string containing binary
+                                 * graphics data. */
+                                binary_graphics_data = dxf_binary_graphics_data_append_line
+                                  (binary_graphics_data,
+                                  dxf_pair_get_string (&pair));
+                                break;
+                        case 330:
+                                /* Now follows a string containing a
+                                 * soft-pointer ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, helix->dictionary_owner_soft);
+                                helix->dictionary_owner_soft = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 347:
+                                /* Now follows a string containing a
+                                 * hard-pointer ID/handle to material object. */
+                                dxf_lexer_free_string (fp, properties.material);
+                                properties.material = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 360:
+                                /* Now follows a string containing a
+                                 * hard-pointer ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, helix->dictionary_owner_hard);
+                                helix->dictionary_owner_hard = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 370:
+                                /* Now follows a string containing the lineweight
+                                 * value. */
+                                properties.lineweight = dxf_pair_get_int (&pair);
+                                break;
+                        case 390:
+                                /* Now follows a string containing a plot style
+                                 * name value. */
+                                dxf_lexer_free_string (fp, properties.plot_style_name);
+                                properties.plot_style_name = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 420:
+                                /* Now follows a string containing a color value. */
+                                properties.color_value = dxf_pair_get_long (&pair);
+                                break;
+                        case 430:
+                                /* Now follows a string containing a color
+                                 * name value. */
+                                dxf_lexer_free_string (fp, properties.color_name);
+                                properties.color_name = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 440:
+                                /* Now follows a string containing a transparency
+                                 * value. */
+                                properties.transparency = dxf_pair_get_long (&pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, "DXF comment: %s\n", temp_string);
+                                break;
+                        default:
                                 fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
                                   __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "160") == 0)
-                {
-                        /* Now follows a string containing the
-                         * graphics data size value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &helix->graphics_data_size);
-                }
-                else if (strcmp (temp_string, "280") == 0)
-                {
-                        /* Now follows a string containing a constraint
-                         * type value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &helix->constraint_type);
-                }
-                else if (strcmp (temp_string, "284") == 0)
-                {
-                        /* Now follows a string containing the shadow
-                         * mode value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &helix->shadow_mode);
-                }
-                else if (strcmp (temp_string, "290") == 0)
-                {
-                        /* Now follows a string containing a handedness
-                         * value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &helix->handedness);
-                }
-                else if (strcmp (temp_string, "310") == 0)
-                {
-                        /* Now follows a string containing binary
-                         * graphics data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", helix->binary_graphics_data->data_line);
-                        dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) helix->binary_graphics_data->next);
-                        helix->binary_graphics_data = (DxfBinaryGraphicsData *) helix->binary_graphics_data->next;
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing a
-                         * soft-pointer ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", helix->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "347") == 0)
-                {
-                        /* Now follows a string containing a
-                         * hard-pointer ID/handle to material object. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", helix->material);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing a
-                         * hard-pointer ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", helix->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "370") == 0)
-                {
-                        /* Now follows a string containing the lineweight
-                         * value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &helix->lineweight);
-                }
-                else if (strcmp (temp_string, "390") == 0)
-                {
-                        /* Now follows a string containing a plot style
-                         * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", helix->plot_style_name);
-                }
-                else if (strcmp (temp_string, "420") == 0)
-                {
-                        /* Now follows a string containing a color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%ld\n", &helix->color_value);
-                }
-                else if (strcmp (temp_string, "430") == 0)
-                {
-                        /* Now follows a string containing a color
-                         * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", helix->color_name);
-                }
-                else if (strcmp (temp_string, "440") == 0)
-                {
-                        /* Now follows a string containing a transparency
-                         * value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%ld\n", &helix->transparency);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
         /* Handle omitted members and/or illegal values. */
-        if (strcmp (helix->linetype, "") == 0)
+        if ((properties.linetype != NULL)
+          && (strcmp (properties.linetype, "") == 0))
         {
-                helix->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_lexer_free_string (fp, properties.linetype);
+                properties.linetype = dxf_strdup (DXF_DEFAULT_LINETYPE);
         }
-        if (strcmp (helix->layer, "") == 0)
+        if ((properties.layer != NULL)
+          && (strcmp (properties.layer, "") == 0))
         {
-                helix->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_lexer_free_string (fp, properties.layer);
+                properties.layer = dxf_strdup (DXF_DEFAULT_LAYER);
         }
-        /* Clean up. */
-        free (temp_string);
+        /* Entities with equal properties share a record. */
+        dxf_graphic_properties_finish (fp, &helix->properties, &properties);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -525,7 +450,7 @@ dxf_helix_write
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *dxf_entity_name = strdup ("HELIX");
+        char *dxf_entity_name = dxf_strdup ("HELIX");
         int i;
 
         /* Do some basic checks. */
@@ -535,7 +460,7 @@ dxf_helix_write
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (helix == NULL)
@@ -544,18 +469,18 @@ dxf_helix_write
                   (_("Error in %s () a NULL pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (helix->radius == 0.0)
         {
                 fprintf (stderr,
-                  (_("Error in %s () radius value equals 0.0 for the %s entity with id-code: %x.\n")),
+                  (_("Error in %s () radius value equals 0.0 for the %s entity with id-code: %lx.\n")),
                   __FUNCTION__, dxf_entity_name, helix->id_code);
                 fprintf (stderr, "    skipping %s entity.\n",
                         dxf_entity_name);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (fp->acad_version_number < AutoCAD_2007)
@@ -564,141 +489,141 @@ dxf_helix_write
                   (_("Warning in %s () illegal DXF version for this entity.\n")),
                   __FUNCTION__);
         }
-        if (strcmp (helix->linetype, "") == 0)
+        if (strcmp (helix->properties->linetype, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, helix->id_code);
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                helix->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_helix_set_linetype (helix, DXF_DEFAULT_LINETYPE);
         }
-        if (strcmp (helix->layer, "") == 0)
+        if (strcmp (helix->properties->layer, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty layer string for the %s entity with id-code: %x.\n")),
+                  (_("Warning in %s () empty layer string for the %s entity with id-code: %lx.\n")),
                   __FUNCTION__, dxf_entity_name, helix->id_code);
                 fprintf (stderr,
                   (_("\t%s entity is relocated to default layer.\n")),
                   dxf_entity_name);
-                helix->layer = DXF_DEFAULT_LAYER;
+                dxf_helix_set_layer (helix, DXF_DEFAULT_LAYER);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_string (fp, 0, dxf_entity_name);
         if (helix->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", helix->id_code);
+                dxf_write_hex (fp, 5, helix->id_code);
         }
-        fprintf (fp->fp, "330\n%s\n", helix->dictionary_owner_soft);
-        fprintf (fp->fp, "100\nAcDbEntity\n");
-        if (helix->paperspace != DXF_MODELSPACE)
+        dxf_write_string (fp, 330, helix->dictionary_owner_soft);
+        dxf_write_string (fp, 100, "AcDbEntity");
+        if (helix->properties->paperspace != DXF_MODELSPACE)
         {
-                fprintf (fp->fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_int (fp, 67, DXF_PAPERSPACE);
         }
-        fprintf (fp->fp, "  8\n%s\n", helix->layer);
-        if (strcmp (helix->linetype, DXF_DEFAULT_LINETYPE) != 0)
+        dxf_write_string (fp, 8, helix->properties->layer);
+        if (strcmp (helix->properties->linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp->fp, "  6\n%s\n", helix->linetype);
+                dxf_write_string (fp, 6, helix->properties->linetype);
         }
-        if (strcmp (helix->material, "") != 0)
+        if (strcmp (helix->properties->material, "") != 0)
         {
-                fprintf (fp->fp, "347\n%s\n", helix->material);
+                dxf_write_string (fp, 347, helix->properties->material);
         }
-        if (helix->color != DXF_COLOR_BYLAYER)
+        if (helix->properties->color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp->fp, " 62\n%d\n", helix->color);
+                dxf_write_int (fp, 62, helix->properties->color);
         }
-        fprintf (fp->fp, "370\n%d\n", helix->lineweight);
-        if (helix->thickness != 0.0)
+        dxf_write_int (fp, 370, helix->properties->lineweight);
+        if (helix->properties->thickness != 0.0)
         {
-                fprintf (fp->fp, " 39\n%f\n", helix->thickness);
+                dxf_write_double (fp, 39, helix->properties->thickness);
         }
-        if (helix->linetype_scale != 1.0)
+        if (helix->properties->linetype_scale != 1.0)
         {
-                fprintf (fp->fp, " 48\n%f\n", helix->linetype_scale);
+                dxf_write_double (fp, 48, helix->properties->linetype_scale);
         }
-        if (helix->visibility != 0)
+        if (helix->properties->visibility != 0)
         {
-                fprintf (fp->fp, " 60\n%d\n", helix->visibility);
+                dxf_write_int (fp, 60, helix->properties->visibility);
         }
 #ifdef BUILD_64
-        fprintf (fp->fp, "160\n%d\n", helix->graphics_data_size);
+        dxf_write_int (fp, 160, helix->graphics_data_size);
 #else
-        fprintf (fp->fp, " 92\n%d\n", helix->graphics_data_size);
+        dxf_write_int (fp, 92, helix->graphics_data_size);
 #endif
         while (helix->binary_graphics_data != NULL)
         {
-                fprintf (fp->fp, "310\n%s\n", helix->binary_graphics_data->data_line);
+                dxf_write_string (fp, 310, helix->binary_graphics_data->data_line);
                 helix->binary_graphics_data = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_get_next (helix->binary_graphics_data);
         }
-        fprintf (fp->fp, "420\n%ld\n", helix->color_value);
-        fprintf (fp->fp, "430\n%s\n", helix->color_name);
-        fprintf (fp->fp, "440\n%ld\n", helix->transparency);
-        fprintf (fp->fp, "390\n%s\n", helix->plot_style_name);
-        fprintf (fp->fp, "284\n%d\n", helix->shadow_mode);
+        dxf_write_long (fp, 420, helix->properties->color_value);
+        dxf_write_string (fp, 430, helix->properties->color_name);
+        dxf_write_long (fp, 440, helix->properties->transparency);
+        dxf_write_string (fp, 390, helix->properties->plot_style_name);
+        dxf_write_int (fp, 284, helix->properties->shadow_mode);
         /* Write a spline to a DxfFile. */
         helix->spline->flag = 0;
         helix->spline->degree = 3;
-        fprintf (fp->fp, "100\nAcDbSpline\n");
-        fprintf (fp->fp, " 70\n%d\n", helix->spline->flag);
-        fprintf (fp->fp, " 71\n%d\n", helix->spline->degree);
-        fprintf (fp->fp, " 72\n%d\n", helix->spline->number_of_knots);
-        fprintf (fp->fp, " 73\n%d\n", helix->spline->number_of_control_points);
-        fprintf (fp->fp, " 74\n%d\n", helix->spline->number_of_fit_points);
-        fprintf (fp->fp, " 42\n%f\n", helix->spline->knot_tolerance);
-        fprintf (fp->fp, " 43\n%f\n", helix->spline->control_point_tolerance);
-        fprintf (fp->fp, " 12\n%f\n", helix->spline->p2->x0);
-        fprintf (fp->fp, " 22\n%f\n", helix->spline->p2->y0);
-        fprintf (fp->fp, " 32\n%f\n", helix->spline->p2->z0);
-        fprintf (fp->fp, " 13\n%f\n", helix->spline->p3->x0);
-        fprintf (fp->fp, " 23\n%f\n", helix->spline->p3->y0);
-        fprintf (fp->fp, " 33\n%f\n", helix->spline->p3->z0);
+        dxf_write_string (fp, 100, "AcDbSpline");
+        dxf_write_int (fp, 70, helix->spline->flag);
+        dxf_write_int (fp, 71, helix->spline->degree);
+        dxf_write_int (fp, 72, helix->spline->number_of_knots);
+        dxf_write_int (fp, 73, helix->spline->number_of_control_points);
+        dxf_write_int (fp, 74, helix->spline->number_of_fit_points);
+        dxf_write_double (fp, 42, helix->spline->knot_tolerance);
+        dxf_write_double (fp, 43, helix->spline->control_point_tolerance);
+        dxf_write_double (fp, 12, helix->spline->p2.x0);
+        dxf_write_double (fp, 22, helix->spline->p2.y0);
+        dxf_write_double (fp, 32, helix->spline->p2.z0);
+        dxf_write_double (fp, 13, helix->spline->p3.x0);
+        dxf_write_double (fp, 23, helix->spline->p3.y0);
+        dxf_write_double (fp, 33, helix->spline->p3.z0);
         for (i = 0; i < helix->spline->number_of_knots; i++)
         {
-                fprintf (fp->fp, " 40\n%f\n", helix->spline->knot_value[i]);
+                dxf_write_double (fp, 40, helix->spline->knot_value[i]);
         }
         if (helix->spline->number_of_fit_points != 0)
         {
                 for (i = 0; i < helix->spline->number_of_fit_points; i++)
                 {
-                        fprintf (fp->fp, " 41\n%f\n", helix->spline->weight_value[i]);
+                        dxf_write_double (fp, 41, helix->spline->weight_value[i]);
                 }
         }
         while (helix->spline->p0 != NULL)
         {
-                fprintf (fp->fp, " 10\n%f\n", helix->spline->p0->x0);
-                fprintf (fp->fp, " 20\n%f\n", helix->spline->p0->y0);
-                fprintf (fp->fp, " 30\n%f\n", helix->spline->p0->z0);
+                dxf_write_double (fp, 10, helix->spline->p0->x0);
+                dxf_write_double (fp, 20, helix->spline->p0->y0);
+                dxf_write_double (fp, 30, helix->spline->p0->z0);
                 helix->spline->p0 = (DxfPoint *) helix->spline->p0->next;
         }
         while (helix->spline->p1 != NULL)
         {
-                fprintf (fp->fp, " 11\n%f\n", helix->spline->p1->x0);
-                fprintf (fp->fp, " 21\n%f\n", helix->spline->p1->y0);
-                fprintf (fp->fp, " 31\n%f\n", helix->spline->p1->z0);
+                dxf_write_double (fp, 11, helix->spline->p1->x0);
+                dxf_write_double (fp, 21, helix->spline->p1->y0);
+                dxf_write_double (fp, 31, helix->spline->p1->z0);
                 helix->spline->p1 = (DxfPoint *) helix->spline->p1->next;
         }
         /* Continue writing helix entity parameters. */
-        fprintf (fp->fp, "100\nAcDbHelix\n");
-        fprintf (fp->fp, " 90\n%ld\n", helix->major_release_number);
-        fprintf (fp->fp, " 91\n%ld\n", helix->maintainance_release_number);
-        fprintf (fp->fp, " 10\n%f\n", helix->p0->x0);
-        fprintf (fp->fp, " 20\n%f\n", helix->p0->y0);
-        fprintf (fp->fp, " 30\n%f\n", helix->p0->z0);
-        fprintf (fp->fp, " 11\n%f\n", helix->p1->x0);
-        fprintf (fp->fp, " 21\n%f\n", helix->p1->y0);
-        fprintf (fp->fp, " 31\n%f\n", helix->p1->z0);
-        fprintf (fp->fp, " 12\n%f\n", helix->p2->x0);
-        fprintf (fp->fp, " 22\n%f\n", helix->p2->y0);
-        fprintf (fp->fp, " 32\n%f\n", helix->p2->z0);
-        fprintf (fp->fp, " 40\n%f\n", helix->radius);
-        fprintf (fp->fp, " 41\n%f\n", helix->number_of_turns);
-        fprintf (fp->fp, " 42\n%f\n", helix->turn_height);
-        fprintf (fp->fp, "290\n%d\n", helix->handedness);
-        fprintf (fp->fp, "280\n%d\n", helix->constraint_type);
+        dxf_write_string (fp, 100, "AcDbHelix");
+        dxf_write_long (fp, 90, helix->major_release_number);
+        dxf_write_long (fp, 91, helix->maintainance_release_number);
+        dxf_write_double (fp, 10, helix->p0->x0);
+        dxf_write_double (fp, 20, helix->p0->y0);
+        dxf_write_double (fp, 30, helix->p0->z0);
+        dxf_write_double (fp, 11, helix->p1->x0);
+        dxf_write_double (fp, 21, helix->p1->y0);
+        dxf_write_double (fp, 31, helix->p1->z0);
+        dxf_write_double (fp, 12, helix->p2->x0);
+        dxf_write_double (fp, 22, helix->p2->y0);
+        dxf_write_double (fp, 32, helix->p2->z0);
+        dxf_write_double (fp, 40, helix->radius);
+        dxf_write_double (fp, 41, helix->number_of_turns);
+        dxf_write_double (fp, 42, helix->turn_height);
+        dxf_write_int (fp, 290, helix->handedness);
+        dxf_write_int (fp, 280, helix->constraint_type);
         /* Clean up. */
-        free (dxf_entity_name);
+        dxf_free (dxf_entity_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -731,18 +656,14 @@ dxf_helix_free
                 __FUNCTION__);
               return (EXIT_FAILURE);
         }
-        free (dxf_helix_get_linetype (helix));
-        free (dxf_helix_get_layer (helix));
+        dxf_graphic_properties_free (helix->properties);
         dxf_binary_graphics_data_free_chain ((DxfBinaryGraphicsData *) dxf_helix_get_binary_graphics_data (helix));
-        free (dxf_helix_get_dictionary_owner_hard (helix));
-        free (dxf_helix_get_material (helix));
-        free (dxf_helix_get_dictionary_owner_soft (helix));
-        free (dxf_helix_get_plot_style_name (helix));
-        free (dxf_helix_get_color_name (helix));
+        dxf_free (helix->dictionary_owner_hard);
+        dxf_free (helix->dictionary_owner_soft);
         dxf_point_free (dxf_helix_get_p0 (helix));
         dxf_point_free (dxf_helix_get_p1 (helix));
         dxf_point_free (dxf_helix_get_p2 (helix));
-        free (helix);
+        dxf_free (helix);
         helix = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -763,7 +684,7 @@ dxf_helix_free_chain
                  * \c HELIX entities. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (helices == NULL)
@@ -790,7 +711,7 @@ dxf_helix_free_chain
  * \return \c id_code when successful, or \c EXIT_FAILURE when an error
  * occurred.
  */
-int
+long
 dxf_helix_get_id_code
 (
         DxfHelix *helix
@@ -833,7 +754,7 @@ dxf_helix_set_id_code
 (
         DxfHelix *helix,
                 /*!< a pointer to a DXF \c HELIX entity. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -888,7 +809,7 @@ dxf_helix_get_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        if (helix->linetype ==  NULL)
+        if (helix->properties->linetype ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the linetype member.\n")),
@@ -898,7 +819,7 @@ dxf_helix_get_linetype
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (helix->linetype));
+        return (dxf_strdup (helix->properties->linetype));
 }
 
 
@@ -935,7 +856,12 @@ dxf_helix_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        helix->linetype = strdup (linetype);
+        if (dxf_graphic_properties_unshare (&helix->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (helix->properties->linetype);
+        helix->properties->linetype = dxf_strdup (linetype);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -966,7 +892,7 @@ dxf_helix_get_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        if (helix->layer ==  NULL)
+        if (helix->properties->layer ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the layer member.\n")),
@@ -976,7 +902,7 @@ dxf_helix_get_layer
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (helix->layer));
+        return (dxf_strdup (helix->properties->layer));
 }
 
 
@@ -1013,7 +939,12 @@ dxf_helix_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        helix->layer = strdup (layer);
+        if (dxf_graphic_properties_unshare (&helix->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (helix->properties->layer);
+        helix->properties->layer = dxf_strdup (layer);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1045,7 +976,7 @@ dxf_helix_get_thickness
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (helix->thickness < 0.0)
+        if (helix->properties->thickness < 0.0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found in the thickness member.\n")),
@@ -1054,7 +985,7 @@ dxf_helix_get_thickness
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (helix->thickness);
+        return (helix->properties->thickness);
 }
 
 
@@ -1090,7 +1021,11 @@ dxf_helix_set_thickness
                   (_("Warning in %s () a negative thickness value was passed.\n")),
                   __FUNCTION__);
         }
-        helix->thickness = thickness;
+        if (dxf_graphic_properties_unshare (&helix->properties) == NULL)
+        {
+                return (NULL);
+        }
+        helix->properties->thickness = thickness;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1122,7 +1057,7 @@ dxf_helix_get_linetype_scale
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (helix->linetype_scale < 0.0)
+        if (helix->properties->linetype_scale < 0.0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found in the linetype scale member.\n")),
@@ -1132,7 +1067,7 @@ dxf_helix_get_linetype_scale
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (helix->linetype_scale);
+        return (helix->properties->linetype_scale);
 }
 
 
@@ -1169,7 +1104,11 @@ dxf_helix_set_linetype_scale
                   __FUNCTION__);
                 return (NULL);
         }
-        helix->linetype_scale = linetype_scale;
+        if (dxf_graphic_properties_unshare (&helix->properties) == NULL)
+        {
+                return (NULL);
+        }
+        helix->properties->linetype_scale = linetype_scale;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1201,14 +1140,14 @@ dxf_helix_get_visibility
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (helix->visibility < 0)
+        if (helix->properties->visibility < 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found in the visibility member.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (helix->visibility > 1)
+        if (helix->properties->visibility > 1)
         {
                 fprintf (stderr,
                   (_("Error in %s () an out of range value was found in the visibility member.\n")),
@@ -1218,7 +1157,7 @@ dxf_helix_get_visibility
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (helix->visibility);
+        return (helix->properties->visibility);
 }
 
 
@@ -1262,7 +1201,11 @@ dxf_helix_set_visibility
                   __FUNCTION__);
                 return (NULL);
         }
-        helix->visibility = visibility;
+        if (dxf_graphic_properties_unshare (&helix->properties) == NULL)
+        {
+                return (NULL);
+        }
+        helix->properties->visibility = visibility;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1294,7 +1237,7 @@ dxf_helix_get_color
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (helix->color < 0)
+        if (helix->properties->color < 0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found in the color member.\n")),
@@ -1303,7 +1246,7 @@ dxf_helix_get_color
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (helix->color);
+        return (helix->properties->color);
 }
 
 
@@ -1341,7 +1284,11 @@ dxf_helix_set_color
                 fprintf (stderr,
                   (_("\teffectively turning this entity it's visibility off.\n")));
         }
-        helix->color = color;
+        if (dxf_graphic_properties_unshare (&helix->properties) == NULL)
+        {
+                return (NULL);
+        }
+        helix->properties->color = color;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1373,13 +1320,13 @@ dxf_helix_get_paperspace
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (helix->paperspace < 0)
+        if (helix->properties->paperspace < 0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found in the paperspace member.\n")),
                   __FUNCTION__);
         }
-        if (helix->paperspace > 1)
+        if (helix->properties->paperspace > 1)
         {
                 fprintf (stderr,
                   (_("Warning in %s () an out of range value was found in the paperspace member.\n")),
@@ -1388,7 +1335,7 @@ dxf_helix_get_paperspace
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (helix->paperspace);
+        return (helix->properties->paperspace);
 }
 
 
@@ -1433,7 +1380,11 @@ dxf_helix_set_paperspace
                   __FUNCTION__);
                 return (NULL);
         }
-        helix->paperspace = paperspace;
+        if (dxf_graphic_properties_unshare (&helix->properties) == NULL)
+        {
+                return (NULL);
+        }
+        helix->properties->paperspace = paperspace;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1557,14 +1508,14 @@ dxf_helix_get_shadow_mode
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (helix->shadow_mode < 0)
+        if (helix->properties->shadow_mode < 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found in the shadow_mode member.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (helix->shadow_mode > 3)
+        if (helix->properties->shadow_mode > 3)
         {
                 fprintf (stderr,
                   (_("Error in %s () an out of range value was found in the shadow_mode member.\n")),
@@ -1574,7 +1525,7 @@ dxf_helix_get_shadow_mode
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (helix->shadow_mode);
+        return (helix->properties->shadow_mode);
 }
 
 
@@ -1618,7 +1569,11 @@ dxf_helix_set_shadow_mode
                   __FUNCTION__);
                 return (NULL);
         }
-        helix->shadow_mode = shadow_mode;
+        if (dxf_graphic_properties_unshare (&helix->properties) == NULL)
+        {
+                return (NULL);
+        }
+        helix->properties->shadow_mode = shadow_mode;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1746,7 +1701,7 @@ dxf_helix_get_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (helix->dictionary_owner_soft));
+        return (dxf_strdup (helix->dictionary_owner_soft));
 }
 
 
@@ -1785,7 +1740,7 @@ dxf_helix_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        helix->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        helix->dictionary_owner_soft = dxf_strdup (dictionary_owner_soft);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1819,7 +1774,7 @@ dxf_helix_get_material
                   __FUNCTION__);
                 return (NULL);
         }
-        if (helix->material ==  NULL)
+        if (helix->properties->material ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the material member.\n")),
@@ -1829,7 +1784,7 @@ dxf_helix_get_material
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (helix->material));
+        return (dxf_strdup (helix->properties->material));
 }
 
 
@@ -1867,7 +1822,12 @@ dxf_helix_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        helix->material = strdup (material);
+        if (dxf_graphic_properties_unshare (&helix->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (helix->properties->material);
+        helix->properties->material = dxf_strdup (material);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1912,7 +1872,7 @@ dxf_helix_get_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (helix->dictionary_owner_hard));
+        return (dxf_strdup (helix->dictionary_owner_hard));
 }
 
 
@@ -1951,7 +1911,7 @@ dxf_helix_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        helix->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        helix->dictionary_owner_hard = dxf_strdup (dictionary_owner_hard);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1986,7 +1946,7 @@ dxf_helix_get_lineweight
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (helix->lineweight);
+        return (helix->properties->lineweight);
 }
 
 
@@ -2016,7 +1976,11 @@ dxf_helix_set_lineweight
                   __FUNCTION__);
                 return (NULL);
         }
-        helix->lineweight = lineweight;
+        if (dxf_graphic_properties_unshare (&helix->properties) == NULL)
+        {
+                return (NULL);
+        }
+        helix->properties->lineweight = lineweight;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2048,7 +2012,7 @@ dxf_helix_get_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        if (helix->plot_style_name ==  NULL)
+        if (helix->properties->plot_style_name ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the plot_style_name member.\n")),
@@ -2058,7 +2022,7 @@ dxf_helix_get_plot_style_name
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (helix->plot_style_name));
+        return (dxf_strdup (helix->properties->plot_style_name));
 }
 
 
@@ -2096,7 +2060,12 @@ dxf_helix_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        helix->plot_style_name = strdup (plot_style_name);
+        if (dxf_graphic_properties_unshare (&helix->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (helix->properties->plot_style_name);
+        helix->properties->plot_style_name = dxf_strdup (plot_style_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2131,7 +2100,7 @@ dxf_helix_get_color_value
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (helix->color_value);
+        return (helix->properties->color_value);
 }
 
 
@@ -2161,7 +2130,11 @@ dxf_helix_set_color_value
                   __FUNCTION__);
                 return (NULL);
         }
-        helix->color_value = color_value;
+        if (dxf_graphic_properties_unshare (&helix->properties) == NULL)
+        {
+                return (NULL);
+        }
+        helix->properties->color_value = color_value;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2193,7 +2166,7 @@ dxf_helix_get_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        if (helix->color_name ==  NULL)
+        if (helix->properties->color_name ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the color_name member.\n")),
@@ -2203,7 +2176,7 @@ dxf_helix_get_color_name
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (helix->color_name));
+        return (dxf_strdup (helix->properties->color_name));
 }
 
 
@@ -2241,7 +2214,12 @@ dxf_helix_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        helix->color_name = strdup (color_name);
+        if (dxf_graphic_properties_unshare (&helix->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (helix->properties->color_name);
+        helix->properties->color_name = dxf_strdup (color_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2276,7 +2254,7 @@ dxf_helix_get_transparency
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (helix->transparency);
+        return (helix->properties->transparency);
 }
 
 
@@ -2306,7 +2284,11 @@ dxf_helix_set_transparency
                   __FUNCTION__);
                 return (NULL);
         }
-        helix->transparency = transparency;
+        if (dxf_graphic_properties_unshare (&helix->properties) == NULL)
+        {
+                return (NULL);
+        }
+        helix->properties->transparency = transparency;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -41,6 +41,8 @@
 
 
 #include "idbuffer.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -145,7 +147,8 @@ dxf_idbuffer_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfPair pair;
         int i;
         DxfIdbufferEntityPointer *entity_pointer = NULL;
 
@@ -155,8 +158,6 @@ dxf_idbuffer_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (fp->acad_version_number < AutoCAD_14)
@@ -175,82 +176,70 @@ dxf_idbuffer_read
         }
         i = 0;
         entity_pointer = (DxfIdbufferEntityPointer *) dxf_idbuffer_entity_pointer_init (entity_pointer);
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        /* Clean up. */
-                        free (temp_string);
-                        fclose (fp->fp);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "5") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &idbuffer->id_code);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else if (strcmp (temp_string, "100") == 0)
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "AcDbIdBuffer") != 0)
-                        {
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                idbuffer->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 100:
+                                /* Now follows a string containing the
+                                 * subclass marker value. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                if (strcmp (temp_string, "AcDbIdBuffer") != 0)
+                                {
+                                        fprintf (stderr,
+                                          (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                }
+                                break;
+                        case 330:
+                                if (i == 0)
+                                {
+                                        /* Now follows a string containing Soft-pointer
+                                         * ID/handle to owner dictionary. */
+                                        free (idbuffer->dictionary_owner_soft);
+                                        idbuffer->dictionary_owner_soft = dxf_pair_get_string (&pair);
+                                        i++;
+                                }
+                                else if (i > 0)
+                                {
+                                        /* Now follows a string containing a Soft
+                                         * pointer reference to entity. */
+                                        free (entity_pointer->soft_pointer);
+                                        entity_pointer->soft_pointer = dxf_pair_get_string (&pair);
+                                        dxf_idbuffer_entity_pointer_init ((DxfIdbufferEntityPointer *) entity_pointer->next);
+                                        entity_pointer = (DxfIdbufferEntityPointer *) entity_pointer->next;
+                                }
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                free (idbuffer->dictionary_owner_hard);
+                                idbuffer->dictionary_owner_hard = dxf_pair_get_string (&pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, (_("DXF comment: %s\n")), temp_string);
+                                break;
+                        default:
                                 fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
                                   __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if ((strcmp (temp_string, "330") == 0)
-                  && (i == 0))
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", idbuffer->dictionary_owner_soft);
-                        i++;
-                }
-                else if ((strcmp (temp_string, "330") == 0)
-                  && (i > 0))
-                {
-                        /* Now follows a string containing a Soft
-                         * pointer reference to entity. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", entity_pointer->soft_pointer);
-                        dxf_idbuffer_entity_pointer_init ((DxfIdbufferEntityPointer *) entity_pointer->next);
-                        entity_pointer = (DxfIdbufferEntityPointer *) entity_pointer->next;
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", idbuffer->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, (_("DXF comment: %s\n")), temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
-        /* Clean up. */
-        free (temp_string);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -301,14 +290,14 @@ dxf_idbuffer_write
         if (fp->acad_version_number < AutoCAD_14)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () illegal DXF version for this %s entity with id-code: %x.\n")),
+                  (_("Warning in %s () illegal DXF version for this %s entity with id-code: %lx.\n")),
                   __FUNCTION__, dxf_entity_name, dxf_idbuffer_get_id_code (idbuffer));
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
-        if (dxf_idbuffer_get_id_code (idbuffer) != -1)
+        dxf_write_string (fp, 0, dxf_entity_name);
+        if (idbuffer->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", dxf_idbuffer_get_id_code (idbuffer));
+                dxf_write_hex (fp, 5, dxf_idbuffer_get_id_code (idbuffer));
         }
         /*!
          * \todo for version R14.\n
@@ -323,25 +312,25 @@ dxf_idbuffer_write
         if ((strcmp (idbuffer->dictionary_owner_soft, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", dxf_idbuffer_get_dictionary_owner_soft (idbuffer));
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, dxf_idbuffer_get_dictionary_owner_soft (idbuffer));
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (idbuffer->dictionary_owner_hard, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", dxf_idbuffer_get_dictionary_owner_hard (idbuffer));
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, dxf_idbuffer_get_dictionary_owner_hard (idbuffer));
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbIdBuffer\n");
+                dxf_write_string (fp, 100, "AcDbIdBuffer");
         }
         entity_pointer = (DxfIdbufferEntityPointer *) dxf_idbuffer_get_entity_pointer (idbuffer);
         while (idbuffer->entity_pointer != NULL)
         {
-                fprintf (fp->fp, "330\n%s\n", dxf_idbuffer_entity_pointer_get_soft_pointer (dxf_idbuffer_get_entity_pointer (idbuffer)));
+                dxf_write_string (fp, 330, dxf_idbuffer_entity_pointer_get_soft_pointer (dxf_idbuffer_get_entity_pointer (idbuffer)));
                 entity_pointer = dxf_idbuffer_entity_pointer_get_next (dxf_idbuffer_get_entity_pointer (idbuffer));
         }
         /* Clean up. */
@@ -402,7 +391,7 @@ dxf_idbuffer_free_chain
                 /*!< pointer to the chain of DXF \c IDBUFFER objects. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (id_buffers == NULL)
@@ -429,7 +418,7 @@ dxf_idbuffer_free_chain
  * \return \c id_code when successful, or \c EXIT_FAILURE when an error
  * occurred.
  */
-int
+long
 dxf_idbuffer_get_id_code
 (
         DxfIdbuffer *idbuffer
@@ -472,7 +461,7 @@ dxf_idbuffer_set_id_code
 (
         DxfIdbuffer *idbuffer,
                 /*!< a pointer to a DXF \c IDBUFFER. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -961,7 +950,7 @@ dxf_idbuffer_entity_pointer_free_chain
                  * \c DxfIdbufferEntityPointer structs. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (entity_pointers == NULL)
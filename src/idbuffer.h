@@ -75,7 +75,7 @@ typedef struct
 dxf_idbuffer
 {
         /* Members common for all DXF objects. */
-        int id_code;
+        long id_code;
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file.\n
@@ -127,7 +127,7 @@ dxf_idbuffer_free_chain
 (
         DxfIdbuffer *id_buffers
 );
-int
+long
 dxf_idbuffer_get_id_code
 (
         DxfIdbuffer *idbuffer
@@ -136,7 +136,7 @@ DxfIdbuffer *
 dxf_idbuffer_set_id_code
 (
         DxfIdbuffer *idbuffer,
-        int id_code
+        long id_code
 );
 char *
 dxf_idbuffer_get_dictionary_owner_soft
@@ -45,6 +45,9 @@
 
 
 #include "image.h"
+#include "arena.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -67,7 +70,7 @@ dxf_image_new ()
         size = sizeof (DxfImage);
         /* avoid malloc of 0 bytes */
         if (size == 0) size = 1;
-        if ((image = malloc (size)) == NULL)
+        if ((image = dxf_malloc (size)) == NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () could not allocate memory for a DxfImage struct.\n")),
@@ -118,34 +121,12 @@ dxf_image_init
               return (NULL);
         }
         dxf_image_set_id_code (image, 0);
-        dxf_image_set_linetype (image, strdup (DXF_DEFAULT_LINETYPE));
-        dxf_image_set_layer (image, strdup (DXF_DEFAULT_LAYER));
-        dxf_image_set_elevation (image, 0.0);
-        dxf_image_set_thickness (image, 0.0);
-        dxf_image_set_linetype_scale (image, DXF_DEFAULT_LINETYPE_SCALE);
-        dxf_image_set_visibility (image, DXF_DEFAULT_VISIBILITY);
-        dxf_image_set_color (image, DXF_COLOR_BYLAYER);
-        dxf_image_set_paperspace (image, DXF_MODELSPACE);
+        image->properties = dxf_graphic_properties_default ();
         dxf_image_set_graphics_data_size (image, 0);
-        dxf_image_set_shadow_mode (image, 0);
         dxf_image_set_binary_graphics_data (image, (DxfBinaryGraphicsData *) dxf_binary_graphics_data_new ());
         dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) dxf_image_get_binary_graphics_data (image));
-        dxf_image_set_dictionary_owner_soft (image, strdup (""));
-        dxf_image_set_material (image, strdup (""));
-        dxf_image_set_dictionary_owner_hard (image, strdup (""));
-        dxf_image_set_lineweight (image, 0);
-        dxf_image_set_plot_style_name (image, strdup (""));
-        dxf_image_set_color_value (image, 0);
-        dxf_image_set_color_name (image, strdup (""));
-        dxf_image_set_transparency (image, 0);
-        dxf_image_set_p0 (image, (DxfPoint *) dxf_point_new ());
-        dxf_point_init ((DxfPoint *) dxf_image_get_p0 (image));
-        dxf_image_set_p1 (image, (DxfPoint *) dxf_point_new ());
-        dxf_point_init ((DxfPoint *) dxf_image_get_p1 (image));
-        dxf_image_set_p2 (image, (DxfPoint *) dxf_point_new ());
-        dxf_point_init ((DxfPoint *) dxf_image_get_p2 (image));
-        dxf_image_set_p3 (image, (DxfPoint *) dxf_point_new ());
-        dxf_point_init ((DxfPoint *) dxf_image_get_p3 (image));
+        dxf_image_set_dictionary_owner_soft (image, "");
+        dxf_image_set_dictionary_owner_hard (image, "");
         dxf_image_set_p4 (image, (DxfPoint *) dxf_point_new ());
         dxf_point_init ((DxfPoint *) dxf_image_get_p4 (image));
         dxf_image_set_image_display_properties (image, 0);
@@ -156,8 +137,8 @@ dxf_image_init
         dxf_image_set_brightness (image, 50);
         dxf_image_set_contrast (image, 50);
         dxf_image_set_fade (image, 50);
-        dxf_image_set_imagedef_object (image, strdup (""));
-        dxf_image_set_imagedef_reactor_object (image, strdup (""));
+        dxf_image_set_imagedef_object (image, "");
+        dxf_image_set_imagedef_reactor_object (image, "");
         dxf_image_set_next (image, NULL);
 #if DEBUG
         DXF_DEBUG_END
@@ -189,7 +170,9 @@ dxf_image_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfGraphicProperties properties;
+        DxfPair pair;
         DxfPoint *iter = NULL;
         int next_x4;
 
@@ -199,8 +182,6 @@ dxf_image_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (image == NULL)
@@ -213,300 +194,241 @@ dxf_image_read
         }
         iter = (DxfPoint *) image->p4;
         next_x4 = 0;
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        dxf_graphic_properties_start (&properties, image->properties);
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        fclose (fp->fp);
-                        /* Clean up. */
-                        free (temp_string);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &image->id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", image->linetype);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", image->layer);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the insertion point coordinate. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &image->p0->x0);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the insertion point coordinate. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &image->p0->y0);
-                }
-                else if (strcmp (temp_string, "30") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the insertion point coordinate. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &image->p0->z0);
-                }
-                else if (strcmp (temp_string, "11") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the U-vector of a single pixel. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &image->p1->x0);
-                }
-                else if (strcmp (temp_string, "21") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the U-vector of a single pixel. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &image->p1->y0);
-                }
-                else if (strcmp (temp_string, "31") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the U-vector of a single pixel. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &image->p1->z0);
-                }
-                else if (strcmp (temp_string, "12") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the V-vector of a single pixel. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &image->p2->x0);
-                }
-                else if (strcmp (temp_string, "22") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the V-vector of a single pixel. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &image->p2->y0);
-                }
-                else if (strcmp (temp_string, "32") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing the
-                         * Z-value of the V-vector of a single pixel. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &image->p2->z0);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else if (strcmp (temp_string, "13") == 0)
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing the
-                         * U-value of image size in pixels. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &image->p3->x0);
-                }
-                else if (strcmp (temp_string, "23") == 0)
-                {
-                        /* Now follows a string containing the
-                         * V-value of image size in pixels. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &image->p3->y0);
-                }
-                else if (strcmp (temp_string, "14") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of a clip boundary vertex. */
-                        (fp->line_number)++;
-                        if (next_x4)
-                        {
-                                iter->next = (struct DxfPoint *) dxf_point_new ();
-                                iter->next = (struct DxfPoint *) dxf_point_init ((DxfPoint *) iter->next);
-                                iter = (DxfPoint *) iter->next;
-                                next_x4 = 0;
-                        }
-                        fscanf (fp->fp, "%lf\n", &iter->x0);
-                }
-                else if (strcmp (temp_string, "24") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of a clip boundary vertex. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &iter->y0);
-                        next_x4 = 1;
-                }
-                else if ((fp->acad_version_number <= AutoCAD_11)
-                        && (strcmp (temp_string, "38") == 0)
-                        && (image->elevation != 0.0))
-                {
-                        /* Now follows a string containing the
-                         * elevation. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &image->elevation);
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &image->thickness);
-                }
-                else if (strcmp (temp_string, "48") == 0)
-                {
-                        /* Now follows a string containing the linetype
-                         * scale. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &image->linetype_scale);
-                }
-                else if (strcmp (temp_string, "60") == 0)
-                {
-                        /* Now follows a string containing the
-                         * visibility value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &image->visibility);
-                }
-                else if (strcmp (temp_string, "62") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &image->color);
-                }
-                else if (strcmp (temp_string, "67") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &image->paperspace);
-                }
-                else if (strcmp (temp_string, "70") == 0)
-                {
-                        /* Now follows a string containing the
-                         * image display properties. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &image->image_display_properties);
-                }
-                else if (strcmp (temp_string, "71") == 0)
-                {
-                        /* Now follows a string containing the
-                         * clipping boundary type. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &image->clipping_boundary_type);
-                }
-                else if (strcmp (temp_string, "90") == 0)
-                {
-                        /* Now follows a string containing the class
-                         * version. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%ld\n", &image->class_version);
-                }
-                else if (strcmp (temp_string, "91") == 0)
-                {
-                        /* Now follows a string containing the number of
-                         * clip boundary vertices. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%ld\n", &image->number_of_clip_boundary_vertices);
-                }
-                else if ((fp->acad_version_number >= AutoCAD_13)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if ((strcmp (temp_string, "AcDbEntity") != 0)
-                        && ((strcmp (temp_string, "AcDbRasterImage") != 0)))
-                        {
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                image->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 6:
+                                /* Now follows a string containing a linetype
+                                 * name. */
+                                dxf_lexer_free_string (fp, properties.linetype);
+                                properties.linetype = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 8:
+                                /* Now follows a string containing a layer name. */
+                                dxf_lexer_free_string (fp, properties.layer);
+                                properties.layer = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 10:
+                                /* Now follows a string containing the
+                                 * X-value of the insertion point coordinate. */
+                                image->p0.x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 20:
+                                /* Now follows a string containing the
+                                 * Y-value of the insertion point coordinate. */
+                                image->p0.y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 30:
+                                /* Now follows a string containing the
+                                 * Z-value of the insertion point coordinate. */
+                                image->p0.z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 11:
+                                /* Now follows a string containing the
+                                 * X-value of the U-vector of a single pixel. */
+                                image->p1.x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 21:
+                                /* Now follows a string containing the
+                                 * Y-value of the U-vector of a single pixel. */
+                                image->p1.y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 31:
+                                /* Now follows a string containing the
+                                 * Z-value of the U-vector of a single pixel. */
+                                image->p1.z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 12:
+                                /* Now follows a string containing the
+                                 * X-value of the V-vector of a single pixel. */
+                                image->p2.x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 22:
+                                /* Now follows a string containing the
+                                 * Y-value of the V-vector of a single pixel. */
+                                image->p2.y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 32:
+                                /* Now follows a string containing the
+                                 * Z-value of the V-vector of a single pixel. */
+                                image->p2.z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 13:
+                                /* Now follows a string containing the
+                                 * U-value of image size in pixels. */
+                                image->p3.x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 23:
+                                /* Now follows a string containing the
+                                 * V-value of image size in pixels. */
+                                image->p3.y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 14:
+                                /* Now follows a string containing the
+                                 * X-value of a clip boundary vertex. */
+                                if (next_x4)
+                                {
+                                        iter->next = (struct DxfPoint *) dxf_point_new ();
+                                        iter->next = (struct DxfPoint *) dxf_point_init ((DxfPoint *) iter->next);
+                                        iter = (DxfPoint *) iter->next;
+                                        next_x4 = 0;
+                                }
+                                iter->x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 24:
+                                /* Now follows a string containing the
+                                 * Y-value of a clip boundary vertex. */
+                                iter->y0 = dxf_pair_get_double (&pair);
+                                next_x4 = 1;
+                                break;
+                        case 38:
+                                if ((fp->acad_version_number <= AutoCAD_11)
+                                  && (properties.elevation != 0.0))
+                                {
+                                        /* Now follows a string containing the
+                                         * elevation. */
+                                        properties.elevation = dxf_pair_get_double (&pair);
+                                }
+                                break;
+                        case 39:
+                                /* Now follows a string containing the
+                                 * thickness. */
+                                properties.thickness = dxf_pair_get_double (&pair);
+                                break;
+                        case 48:
+                                /* Now follows a string containing the linetype
+                                 * scale. */
+                                properties.linetype_scale = dxf_pair_get_double (&pair);
+                                break;
+                        case 60:
+                                /* Now follows a string containing the
+                                 * visibility value. */
+                                properties.visibility = dxf_pair_get_int (&pair);
+                                break;
+                        case 62:
+                                /* Now follows a string containing the
+                                 * color value. */
+                                properties.color = dxf_pair_get_int (&pair);
+                                break;
+                        case 67:
+                                /* Now follows a string containing the
+                                 * paperspace value. */
+                                properties.paperspace = dxf_pair_get_int (&pair);
+                                break;
+                        case 70:
+                                /* Now follows a string containing the
+                                 * image display properties. */
+                                image->image_display_properties = dxf_pair_get_int (&pair);
+                                break;
+                        case 71:
+                                /* Now follows a string containing the
+                                 * clipping boundary type. */
+                                image->clipping_boundary_type = dxf_pair_get_int (&pair);
+                                break;
+                        case 90:
+                                /* Now follows a string containing the class
+                                 * version. */
+                                image->class_version = dxf_pair_get_long (&pair);
+                                break;
+                        case 91:
+                                /* Now follows a string containing the number of
+                                 * clip boundary vertices. */
+                                image->number_of_clip_boundary_vertices = dxf_pair_get_long (&pair);
+                                break;
+                        case 100:
+                                if (fp->acad_version_number >= AutoCAD_13)
+                                {
+                                        /* Now follows a string containing the
+                                         * subclass marker value. */
+                                        dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                        if ((strcmp (temp_string, "AcDbEntity") != 0)
+                                        && ((strcmp (temp_string, "AcDbRasterImage") != 0)))
+                                        {
+                                                fprintf (stderr,
+                                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                                  __FUNCTION__, fp->filename, fp->line_number);
+                                        }
+                                }
+                                break;
+                        case 280:
+                                /* Now follows a string containing the clipping
+                                 * state. */
+                                image->clipping_state = dxf_pair_get_int (&pair);
+                                break;
+                        case 281:
+                                /* Now follows a string containing the
+                                 * brightness value. */
+                                image->brightness = dxf_pair_get_int (&pair);
+                                break;
+                        case 282:
+                                /* Now follows a string containing the contrast
+                                 * value. */
+                                image->contrast = dxf_pair_get_int (&pair);
+                                break;
+                        case 283:
+                                /* Now follows a string containing the fade
+                                 * value. */
+                                image->fade = dxf_pair_get_int (&pair);
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, image->dictionary_owner_soft);
+                                image->dictionary_owner_soft = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 340:
+                                /* Now follows a string containing a hard
+                                 * reference to imagedef object. */
+                                dxf_free (image->imagedef_object);
+                                image->imagedef_object = dxf_pair_get_string (&pair);
+                                break;
+                        case 360:
+                                /* Now follows a string containing a hard
+                                 * reference to imagedef_reactor object. */
+                                dxf_free (image->imagedef_reactor_object);
+                                image->imagedef_reactor_object = dxf_pair_get_string (&pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, "DXF comment: %s\n", temp_string);
+                                break;
+                        default:
                                 fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
                                   __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "280") == 0)
-                {
-                        /* Now follows a string containing the clipping
-                         * state. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &image->clipping_state);
-                }
-                else if (strcmp (temp_string, "281") == 0)
-                {
-                        /* Now follows a string containing the
-                         * brightness value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &image->brightness);
-                }
-                else if (strcmp (temp_string, "282") == 0)
-                {
-                        /* Now follows a string containing the contrast
-                         * value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &image->contrast);
-                }
-                else if (strcmp (temp_string, "283") == 0)
-                {
-                        /* Now follows a string containing the fade
-                         * value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &image->fade);
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", image->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "340") == 0)
-                {
-                        /* Now follows a string containing a hard
-                         * reference to imagedef object. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", image->imagedef_object);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing a hard
-                         * reference to imagedef_reactor object. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", image->imagedef_reactor_object);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
         /* Handle omitted members and/or illegal values. */
-        if (strcmp (image->linetype, "") == 0)
+        if ((properties.linetype != NULL)
+          && (strcmp (properties.linetype, "") == 0))
         {
-                image->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_lexer_free_string (fp, properties.linetype);
+                properties.linetype = dxf_strdup (DXF_DEFAULT_LINETYPE);
         }
-        if (strcmp (image->layer, "") == 0)
+        if ((properties.layer != NULL)
+          && (strcmp (properties.layer, "") == 0))
         {
-                image->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_lexer_free_string (fp, properties.layer);
+                properties.layer = dxf_strdup (DXF_DEFAULT_LAYER);
         }
-        /* Clean up. */
-        free (temp_string);
+        /* Entities with equal properties share a record. */
+        dxf_graphic_properties_finish (fp, &image->properties, &properties);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -532,7 +454,7 @@ dxf_image_write
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *dxf_entity_name = strdup ("IMAGE");
+        char *dxf_entity_name = dxf_strdup ("IMAGE");
         DxfPoint *iter = NULL;
 
         /* Do some basic checks. */
@@ -542,7 +464,7 @@ dxf_image_write
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (image == NULL)
@@ -551,7 +473,7 @@ dxf_image_write
                   (_("Error in %s () a NULL pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (fp->acad_version_number < AutoCAD_14)
@@ -563,17 +485,17 @@ dxf_image_write
         if (strcmp (dxf_image_get_linetype (image), "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_image_get_id_code (image));
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                dxf_image_set_linetype (image, strdup (DXF_DEFAULT_LINETYPE));
+                dxf_image_set_linetype (image, DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (dxf_image_get_layer (image), "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty layer string for the %s entity with id-code: %x.\n")),
+                  (_("Warning in %s () empty layer string for the %s entity with id-code: %lx.\n")),
                   __FUNCTION__, dxf_entity_name, dxf_image_get_id_code (image));
                 fprintf (stderr,
                   (_("\t%s entity is relocated to default layer.\n")),
@@ -581,10 +503,10 @@ dxf_image_write
                 dxf_image_set_layer (image, DXF_DEFAULT_LAYER);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
-        if (dxf_image_get_id_code (image) != -1)
+        dxf_write_string (fp, 0, dxf_entity_name);
+        if (image->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", dxf_image_get_id_code (image));
+                dxf_write_hex (fp, 5, dxf_image_get_id_code (image));
         }
         /*!
          * \todo for version R14.\n
@@ -599,89 +521,89 @@ dxf_image_write
         if ((strcmp (dxf_image_get_dictionary_owner_soft (image), "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", dxf_image_get_dictionary_owner_soft (image));
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, dxf_image_get_dictionary_owner_soft (image));
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (dxf_image_get_dictionary_owner_hard (image), "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", dxf_image_get_dictionary_owner_hard (image));
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, dxf_image_get_dictionary_owner_hard (image));
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbEntity\n");
+                dxf_write_string (fp, 100, "AcDbEntity");
         }
         if (dxf_image_get_paperspace (image) == DXF_PAPERSPACE)
         {
-                fprintf (fp->fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_int (fp, 67, DXF_PAPERSPACE);
         }
-        fprintf (fp->fp, "  8\n%s\n", dxf_image_get_layer (image));
+        dxf_write_string (fp, 8, dxf_image_get_layer (image));
         if (strcmp (dxf_image_get_linetype (image), DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp->fp, "  6\n%s\n", dxf_image_get_linetype (image));
+                dxf_write_string (fp, 6, dxf_image_get_linetype (image));
         }
         if ((fp->acad_version_number <= AutoCAD_11)
           && DXF_FLATLAND
           && (dxf_image_get_elevation (image) != 0.0))
         {
-                fprintf (fp->fp, " 38\n%f\n", dxf_image_get_elevation (image));
+                dxf_write_double (fp, 38, dxf_image_get_elevation (image));
         }
         if (dxf_image_get_color (image) != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp->fp, " 62\n%d\n", dxf_image_get_color (image));
+                dxf_write_int (fp, 62, dxf_image_get_color (image));
         }
         if (dxf_image_get_linetype_scale (image) != 1.0)
         {
-                fprintf (fp->fp, " 48\n%f\n", dxf_image_get_linetype_scale (image));
+                dxf_write_double (fp, 48, dxf_image_get_linetype_scale (image));
         }
         if (dxf_image_get_visibility (image) != 0)
         {
-                fprintf (fp->fp, " 60\n%d\n", dxf_image_get_visibility (image));
+                dxf_write_int (fp, 60, dxf_image_get_visibility (image));
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbRasterImage\n");
+                dxf_write_string (fp, 100, "AcDbRasterImage");
         }
         if (dxf_image_get_thickness (image) != 0.0)
         {
-                fprintf (fp->fp, " 39\n%f\n", dxf_image_get_thickness (image));
-        }
-        fprintf (fp->fp, " 90\n%ld\n", dxf_image_get_class_version (image));
-        fprintf (fp->fp, " 10\n%f\n", dxf_image_get_x0 (image));
-        fprintf (fp->fp, " 20\n%f\n", dxf_image_get_y0 (image));
-        fprintf (fp->fp, " 30\n%f\n", dxf_image_get_z0 (image));
-        fprintf (fp->fp, " 11\n%f\n", dxf_image_get_x1 (image));
-        fprintf (fp->fp, " 21\n%f\n", dxf_image_get_y1 (image));
-        fprintf (fp->fp, " 31\n%f\n", dxf_image_get_z1 (image));
-        fprintf (fp->fp, " 12\n%f\n", dxf_image_get_x2 (image));
-        fprintf (fp->fp, " 22\n%f\n", dxf_image_get_y2 (image));
-        fprintf (fp->fp, " 32\n%f\n", dxf_image_get_z2 (image));
-        fprintf (fp->fp, " 13\n%f\n", dxf_image_get_x3 (image));
-        fprintf (fp->fp, " 23\n%f\n", dxf_image_get_y3 (image));
-        fprintf (fp->fp, "340\n%s\n", dxf_image_get_imagedef_object (image));
-        fprintf (fp->fp, " 70\n%d\n", dxf_image_get_image_display_properties (image));
-        fprintf (fp->fp, "280\n%d\n", dxf_image_get_clipping_state (image));
-        fprintf (fp->fp, "281\n%d\n", dxf_image_get_brightness (image));
-        fprintf (fp->fp, "282\n%d\n", dxf_image_get_contrast (image));
-        fprintf (fp->fp, "283\n%d\n", dxf_image_get_fade (image));
-        fprintf (fp->fp, "360\n%s\n", dxf_image_get_imagedef_reactor_object (image));
-        fprintf (fp->fp, " 71\n%d\n", dxf_image_get_clipping_boundary_type (image));
-        fprintf (fp->fp, " 91\n%ld\n", dxf_image_get_number_of_clip_boundary_vertices (image));
+                dxf_write_double (fp, 39, dxf_image_get_thickness (image));
+        }
+        dxf_write_long (fp, 90, dxf_image_get_class_version (image));
+        dxf_write_double (fp, 10, dxf_image_get_x0 (image));
+        dxf_write_double (fp, 20, dxf_image_get_y0 (image));
+        dxf_write_double (fp, 30, dxf_image_get_z0 (image));
+        dxf_write_double (fp, 11, dxf_image_get_x1 (image));
+        dxf_write_double (fp, 21, dxf_image_get_y1 (image));
+        dxf_write_double (fp, 31, dxf_image_get_z1 (image));
+        dxf_write_double (fp, 12, dxf_image_get_x2 (image));
+        dxf_write_double (fp, 22, dxf_image_get_y2 (image));
+        dxf_write_double (fp, 32, dxf_image_get_z2 (image));
+        dxf_write_double (fp, 13, dxf_image_get_x3 (image));
+        dxf_write_double (fp, 23, dxf_image_get_y3 (image));
+        dxf_write_string (fp, 340, dxf_image_get_imagedef_object (image));
+        dxf_write_int (fp, 70, dxf_image_get_image_display_properties (image));
+        dxf_write_int (fp, 280, dxf_image_get_clipping_state (image));
+        dxf_write_int (fp, 281, dxf_image_get_brightness (image));
+        dxf_write_int (fp, 282, dxf_image_get_contrast (image));
+        dxf_write_int (fp, 283, dxf_image_get_fade (image));
+        dxf_write_string (fp, 360, dxf_image_get_imagedef_reactor_object (image));
+        dxf_write_int (fp, 71, dxf_image_get_clipping_boundary_type (image));
+        dxf_write_long (fp, 91, dxf_image_get_number_of_clip_boundary_vertices (image));
         /* Now follows a sinle linked list of points (vertices).
          * We do not keep track of the number of points (vertices),
          * we just traverse down until the first NULL pointer is found.  */
         iter = (DxfPoint *) dxf_image_get_p4 (image);
         while (iter != NULL)
         {
-                fprintf (fp->fp, " 14\n%f\n", iter->x0);
-                fprintf (fp->fp, " 24\n%f\n", iter->y0);
+                dxf_write_double (fp, 14, iter->x0);
+                dxf_write_double (fp, 24, iter->y0);
                 iter = (DxfPoint *) iter->next;
         }
         /* Clean up. */
-        free (dxf_entity_name);
+        dxf_free (dxf_entity_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -714,22 +636,14 @@ dxf_image_free
                 __FUNCTION__);
               return (EXIT_FAILURE);
         }
-        free (dxf_image_get_linetype (image));
-        free (dxf_image_get_layer (image));
+        dxf_graphic_properties_free (image->properties);
         dxf_binary_graphics_data_free_chain (dxf_image_get_binary_graphics_data (image));
-        free (dxf_image_get_dictionary_owner_soft (image));
-        free (dxf_image_get_material (image));
-        free (dxf_image_get_dictionary_owner_hard (image));
-        free (dxf_image_get_plot_style_name (image));
-        free (dxf_image_get_color_name (image));
-        dxf_point_free (dxf_image_get_p0 (image));
-        dxf_point_free (dxf_image_get_p1 (image));
-        dxf_point_free (dxf_image_get_p2 (image));
-        dxf_point_free (dxf_image_get_p3 (image));
+        dxf_free (image->dictionary_owner_soft);
+        dxf_free (image->dictionary_owner_hard);
         dxf_point_free_chain (dxf_image_get_p4 (image));
-        free (dxf_image_get_imagedef_object (image));
-        free (dxf_image_get_imagedef_reactor_object (image));
-        free (image);
+        dxf_free (image->imagedef_object);
+        dxf_free (image->imagedef_reactor_object);
+        dxf_free (image);
         image = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -749,7 +663,7 @@ dxf_image_free_chain
                 /*!< pointer to the chain of DXF \c IMAGE entities. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (images == NULL)
@@ -776,7 +690,7 @@ dxf_image_free_chain
  * \return \c id_code when successful, or \c EXIT_FAILURE when an error
  * occurred.
  */
-int
+long
 dxf_image_get_id_code
 (
         DxfImage *image
@@ -819,7 +733,7 @@ dxf_image_set_id_code
 (
         DxfImage *image,
                 /*!< a pointer to a DXF \c IMAGE entity. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -874,7 +788,7 @@ dxf_image_get_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        if (image->linetype ==  NULL)
+        if (image->properties->linetype ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the linetype member.\n")),
@@ -884,7 +798,7 @@ dxf_image_get_linetype
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (image->linetype));
+        return (dxf_strdup (image->properties->linetype));
 }
 
 
@@ -921,7 +835,12 @@ dxf_image_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        image->linetype = strdup (linetype);
+        if (dxf_graphic_properties_unshare (&image->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (image->properties->linetype);
+        image->properties->linetype = dxf_strdup (linetype);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -952,7 +871,7 @@ dxf_image_get_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        if (image->layer ==  NULL)
+        if (image->properties->layer ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the layer member.\n")),
@@ -962,7 +881,7 @@ dxf_image_get_layer
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (image->layer));
+        return (dxf_strdup (image->properties->layer));
 }
 
 
@@ -999,7 +918,12 @@ dxf_image_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        image->layer = strdup (layer);
+        if (dxf_graphic_properties_unshare (&image->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (image->properties->layer);
+        image->properties->layer = dxf_strdup (layer);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1034,7 +958,7 @@ dxf_image_get_elevation
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (image->elevation);
+        return (image->properties->elevation);
 }
 
 
@@ -1064,7 +988,11 @@ dxf_image_set_elevation
                   __FUNCTION__);
                 return (NULL);
         }
-        image->elevation = elevation;
+        if (dxf_graphic_properties_unshare (&image->properties) == NULL)
+        {
+                return (NULL);
+        }
+        image->properties->elevation = elevation;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1096,7 +1024,7 @@ dxf_image_get_thickness
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (image->thickness < 0.0)
+        if (image->properties->thickness < 0.0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found in the thickness member.\n")),
@@ -1105,7 +1033,7 @@ dxf_image_get_thickness
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (image->thickness);
+        return (image->properties->thickness);
 }
 
 
@@ -1141,7 +1069,11 @@ dxf_image_set_thickness
                   (_("Warning in %s () a negative thickness value was passed.\n")),
                   __FUNCTION__);
         }
-        image->thickness = thickness;
+        if (dxf_graphic_properties_unshare (&image->properties) == NULL)
+        {
+                return (NULL);
+        }
+        image->properties->thickness = thickness;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1173,7 +1105,7 @@ dxf_image_get_linetype_scale
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (image->linetype_scale < 0.0)
+        if (image->properties->linetype_scale < 0.0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found in the linetype scale member.\n")),
@@ -1183,7 +1115,7 @@ dxf_image_get_linetype_scale
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (image->linetype_scale);
+        return (image->properties->linetype_scale);
 }
 
 
@@ -1220,7 +1152,11 @@ dxf_image_set_linetype_scale
                   __FUNCTION__);
                 return (NULL);
         }
-        image->linetype_scale = linetype_scale;
+        if (dxf_graphic_properties_unshare (&image->properties) == NULL)
+        {
+                return (NULL);
+        }
+        image->properties->linetype_scale = linetype_scale;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1252,14 +1188,14 @@ dxf_image_get_visibility
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (image->visibility < 0)
+        if (image->properties->visibility < 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found in the visibility member.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (image->visibility > 1)
+        if (image->properties->visibility > 1)
         {
                 fprintf (stderr,
                   (_("Error in %s () an out of range value was found in the visibility member.\n")),
@@ -1269,7 +1205,7 @@ dxf_image_get_visibility
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (image->visibility);
+        return (image->properties->visibility);
 }
 
 
@@ -1313,7 +1249,11 @@ dxf_image_set_visibility
                   __FUNCTION__);
                 return (NULL);
         }
-        image->visibility = visibility;
+        if (dxf_graphic_properties_unshare (&image->properties) == NULL)
+        {
+                return (NULL);
+        }
+        image->properties->visibility = visibility;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1345,7 +1285,7 @@ dxf_image_get_color
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (image->color < 0)
+        if (image->properties->color < 0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found in the color member.\n")),
@@ -1354,7 +1294,7 @@ dxf_image_get_color
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (image->color);
+        return (image->properties->color);
 }
 
 
@@ -1392,7 +1332,11 @@ dxf_image_set_color
                 fprintf (stderr,
                   (_("\teffectively turning this entity it's visibility off.\n")));
         }
-        image->color = color;
+        if (dxf_graphic_properties_unshare (&image->properties) == NULL)
+        {
+                return (NULL);
+        }
+        image->properties->color = color;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1424,13 +1368,13 @@ dxf_image_get_paperspace
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (image->paperspace < 0)
+        if (image->properties->paperspace < 0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found in the paperspace member.\n")),
                   __FUNCTION__);
         }
-        if (image->paperspace > 1)
+        if (image->properties->paperspace > 1)
         {
                 fprintf (stderr,
                   (_("Warning in %s () an out of range value was found in the paperspace member.\n")),
@@ -1439,7 +1383,7 @@ dxf_image_get_paperspace
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (image->paperspace);
+        return (image->properties->paperspace);
 }
 
 
@@ -1484,7 +1428,11 @@ dxf_image_set_paperspace
                   __FUNCTION__);
                 return (NULL);
         }
-        image->paperspace = paperspace;
+        if (dxf_graphic_properties_unshare (&image->properties) == NULL)
+        {
+                return (NULL);
+        }
+        image->properties->paperspace = paperspace;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1609,14 +1557,14 @@ dxf_image_get_shadow_mode
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (image->shadow_mode < 0)
+        if (image->properties->shadow_mode < 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found in the shadow_mode member.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (image->shadow_mode > 3)
+        if (image->properties->shadow_mode > 3)
         {
                 fprintf (stderr,
                   (_("Error in %s () an out of range value was found in the shadow_mode member.\n")),
@@ -1626,7 +1574,7 @@ dxf_image_get_shadow_mode
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (image->shadow_mode);
+        return (image->properties->shadow_mode);
 }
 
 
@@ -1670,7 +1618,11 @@ dxf_image_set_shadow_mode
                   __FUNCTION__);
                 return (NULL);
         }
-        image->shadow_mode = shadow_mode;
+        if (dxf_graphic_properties_unshare (&image->properties) == NULL)
+        {
+                return (NULL);
+        }
+        image->properties->shadow_mode = shadow_mode;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1799,7 +1751,7 @@ dxf_image_get_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (image->dictionary_owner_soft));
+        return (dxf_strdup (image->dictionary_owner_soft));
 }
 
 
@@ -1838,7 +1790,7 @@ dxf_image_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        image->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        image->dictionary_owner_soft = dxf_strdup (dictionary_owner_soft);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1872,7 +1824,7 @@ dxf_image_get_material
                   __FUNCTION__);
                 return (NULL);
         }
-        if (image->material ==  NULL)
+        if (image->properties->material ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the material member.\n")),
@@ -1882,7 +1834,7 @@ dxf_image_get_material
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (image->material));
+        return (dxf_strdup (image->properties->material));
 }
 
 
@@ -1920,7 +1872,12 @@ dxf_image_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        image->material = strdup (material);
+        if (dxf_graphic_properties_unshare (&image->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (image->properties->material);
+        image->properties->material = dxf_strdup (material);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1965,7 +1922,7 @@ dxf_image_get_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (image->dictionary_owner_hard));
+        return (dxf_strdup (image->dictionary_owner_hard));
 }
 
 
@@ -2004,7 +1961,7 @@ dxf_image_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        image->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        image->dictionary_owner_hard = dxf_strdup (dictionary_owner_hard);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2039,7 +1996,7 @@ dxf_image_get_lineweight
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (image->lineweight);
+        return (image->properties->lineweight);
 }
 
 
@@ -2069,7 +2026,11 @@ dxf_image_set_lineweight
                   __FUNCTION__);
                 return (NULL);
         }
-        image->lineweight = lineweight;
+        if (dxf_graphic_properties_unshare (&image->properties) == NULL)
+        {
+                return (NULL);
+        }
+        image->properties->lineweight = lineweight;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2101,7 +2062,7 @@ dxf_image_get_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        if (image->plot_style_name ==  NULL)
+        if (image->properties->plot_style_name ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the plot_style_name member.\n")),
@@ -2111,7 +2072,7 @@ dxf_image_get_plot_style_name
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (image->plot_style_name));
+        return (dxf_strdup (image->properties->plot_style_name));
 }
 
 
@@ -2149,7 +2110,12 @@ dxf_image_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        image->plot_style_name = strdup (plot_style_name);
+        if (dxf_graphic_properties_unshare (&image->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (image->properties->plot_style_name);
+        image->properties->plot_style_name = dxf_strdup (plot_style_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2184,7 +2150,7 @@ dxf_image_get_color_value
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (image->color_value);
+        return (image->properties->color_value);
 }
 
 
@@ -2214,7 +2180,11 @@ dxf_image_set_color_value
                   __FUNCTION__);
                 return (NULL);
         }
-        image->color_value = color_value;
+        if (dxf_graphic_properties_unshare (&image->properties) == NULL)
+        {
+                return (NULL);
+        }
+        image->properties->color_value = color_value;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2246,7 +2216,7 @@ dxf_image_get_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        if (image->color_name ==  NULL)
+        if (image->properties->color_name ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the color_name member.\n")),
@@ -2256,7 +2226,7 @@ dxf_image_get_color_name
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (image->color_name));
+        return (dxf_strdup (image->properties->color_name));
 }
 
 
@@ -2294,7 +2264,12 @@ dxf_image_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        image->color_name = strdup (color_name);
+        if (dxf_graphic_properties_unshare (&image->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (image->properties->color_name);
+        image->properties->color_name = dxf_strdup (color_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2329,7 +2304,7 @@ dxf_image_get_transparency
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (image->transparency);
+        return (image->properties->transparency);
 }
 
 
@@ -2359,7 +2334,11 @@ dxf_image_set_transparency
                   __FUNCTION__);
                 return (NULL);
         }
-        image->transparency = transparency;
+        if (dxf_graphic_properties_unshare (&image->properties) == NULL)
+        {
+                return (NULL);
+        }
+        image->properties->transparency = transparency;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2370,6 +2349,16 @@ dxf_image_set_transparency
 /*!
  * \brief Get the insertion point \c p0 of a DXF \c IMAGE entity.
  *
+ * The point is a newly allocated copy of the position kept in
+ * \c image, to be freed with dxf_point_free ().  Changing it does not
+ * change \c image.
+ *
+ * \deprecated Before the position was kept in \c image itself this
+ * returned the point held by \c image, which was freed together with it
+ * and whose changes were changes of \c image.  Callers relying on that
+ * leak the copy and lose their changes, use
+ * dxf_image_get_p0_vec3 () instead.
+ *
  * \return the insertion point \c p0.
  */
 DxfPoint *
@@ -2379,7 +2368,7 @@ dxf_image_get_p0
                 /*!< a pointer to a DXF \c IMAGE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2390,23 +2379,52 @@ dxf_image_get_p0
                   __FUNCTION__);
                 return (NULL);
         }
-        if (image->p0 == NULL)
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (dxf_point_new_from_vec3 (&image->p0));
+}
+
+
+/*!
+ * \brief Get the insertion point \c p0 of a DXF \c IMAGE entity, as
+ * kept in \c image.
+ *
+ * Changing the position changes \c image.
+ *
+ * \return a pointer to the position, or \c NULL when an error
+ * occurred.
+ */
+DxfVec3 *
+dxf_image_get_p0_vec3
+(
+        DxfImage *image
+                /*!< a pointer to a DXF \c IMAGE entity. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (image == NULL)
         {
                 fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found.\n")),
+                  (_("Error in %s () a NULL pointer was passed.\n")),
                   __FUNCTION__);
                 return (NULL);
         }
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (image->p0);
+        return (&image->p0);
 }
 
 
 /*!
  * \brief Set the insertion point \c p0 of a DXF \c IMAGE entity.
  *
+ * Only the position of \c p0 is copied, the caller keeps \c p0.
+ *
  * \return a pointer to a DXF \c IMAGE entity.
  */
 DxfImage *
@@ -2418,7 +2436,7 @@ dxf_image_set_p0
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2436,7 +2454,9 @@ dxf_image_set_p0
                   __FUNCTION__);
                 return (NULL);
         }
-        image->p0 = p0;
+        image->p0.x0 = p0->x0;
+        image->p0.y0 = p0->y0;
+        image->p0.z0 = p0->z0;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2457,7 +2477,7 @@ dxf_image_get_x0
                 /*!< a pointer to a DXF \c IMAGE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2469,17 +2489,10 @@ dxf_image_get_x0
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (image->p0 == NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found.\n")),
-                  __FUNCTION__);
-                return (EXIT_FAILURE);
-        }
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (image->p0->x0);
+        return (image->p0.x0);
 }
 
 
@@ -2500,7 +2513,7 @@ dxf_image_set_x0
                  * \c IMAGE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2511,14 +2524,7 @@ dxf_image_set_x0
                   __FUNCTION__);
                 return (NULL);
         }
-        if (image->p0 == NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found.\n")),
-                  __FUNCTION__);
-                return (NULL);
-        }
-        image->p0->x0 = x0;
+        image->p0.x0 = x0;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2539,7 +2545,7 @@ dxf_image_get_y0
                 /*!< a pointer to a DXF \c IMAGE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2551,17 +2557,10 @@ dxf_image_get_y0
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (image->p0 == NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found.\n")),
-                  __FUNCTION__);
-                return (EXIT_FAILURE);
-        }
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (image->p0->y0);
+        return (image->p0.y0);
 }
 
 
@@ -2582,7 +2581,7 @@ dxf_image_set_y0
                  * \c IMAGE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2593,14 +2592,7 @@ dxf_image_set_y0
                   __FUNCTION__);
                 return (NULL);
         }
-        if (image->p0 == NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found.\n")),
-                  __FUNCTION__);
-                return (NULL);
-        }
-        image->p0->y0 = y0;
+        image->p0.y0 = y0;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2621,7 +2613,7 @@ dxf_image_get_z0
                 /*!< a pointer to a DXF \c IMAGE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2633,17 +2625,10 @@ dxf_image_get_z0
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (image->p0 == NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found.\n")),
-                  __FUNCTION__);
-                return (EXIT_FAILURE);
-        }
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (image->p0->z0);
+        return (image->p0.z0);
 }
 
 
@@ -2664,7 +2649,7 @@ dxf_image_set_z0
                  * \c IMAGE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2675,14 +2660,7 @@ dxf_image_set_z0
                   __FUNCTION__);
                 return (NULL);
         }
-        if (image->p0 == NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found.\n")),
-                  __FUNCTION__);
-                return (NULL);
-        }
-        image->p0->z0 = z0;
+        image->p0.z0 = z0;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2694,6 +2672,16 @@ dxf_image_set_z0
  * \brief Get the U-vector of a single pixel \c p1 of a DXF \c IMAGE
  * entity.
  *
+ * The point is a newly allocated copy of the position kept in
+ * \c image, to be freed with dxf_point_free ().  Changing it does not
+ * change \c image.
+ *
+ * \deprecated Before the position was kept in \c image itself this
+ * returned the point held by \c image, which was freed together with it
+ * and whose changes were changes of \c image.  Callers relying on that
+ * leak the copy and lose their changes, use
+ * dxf_image_get_p1_vec3 () instead.
+ *
  * \return the U-vector of a single pixel \c p1.
  */
 DxfPoint *
@@ -2703,7 +2691,7 @@ dxf_image_get_p1
                 /*!< a pointer to a DXF \c IMAGE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2714,17 +2702,44 @@ dxf_image_get_p1
                   __FUNCTION__);
                 return (NULL);
         }
-        if (image->p1 == NULL)
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (dxf_point_new_from_vec3 (&image->p1));
+}
+
+
+/*!
+ * \brief Get the U-vector of a single pixel \c p1 of a DXF \c IMAGE
+ * entity, as kept in \c image.
+ *
+ * Changing the position changes \c image.
+ *
+ * \return a pointer to the position, or \c NULL when an error
+ * occurred.
+ */
+DxfVec3 *
+dxf_image_get_p1_vec3
+(
+        DxfImage *image
+                /*!< a pointer to a DXF \c IMAGE entity. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (image == NULL)
         {
                 fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found.\n")),
+                  (_("Error in %s () a NULL pointer was passed.\n")),
                   __FUNCTION__);
                 return (NULL);
         }
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (image->p1);
+        return (&image->p1);
 }
 
 
@@ -2732,6 +2747,8 @@ dxf_image_get_p1
  * \brief Set the U-vector of a single pixel \c p1 of a DXF \c IMAGE
  * entity.
  *
+ * Only the position of \c p1 is copied, the caller keeps \c p1.
+ *
  * \return a pointer to a DXF \c IMAGE entity.
  */
 DxfImage *
@@ -2743,7 +2760,7 @@ dxf_image_set_p1
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2761,7 +2778,9 @@ dxf_image_set_p1
                   __FUNCTION__);
                 return (NULL);
         }
-        image->p1 = p1;
+        image->p1.x0 = p1->x0;
+        image->p1.y0 = p1->y0;
+        image->p1.z0 = p1->z0;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2782,7 +2801,7 @@ dxf_image_get_x1
                 /*!< a pointer to a DXF \c IMAGE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2794,17 +2813,10 @@ dxf_image_get_x1
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (image->p1 == NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found.\n")),
-                  __FUNCTION__);
-                return (EXIT_FAILURE);
-        }
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (image->p1->x0);
+        return (image->p1.x0);
 }
 
 
@@ -2825,7 +2837,7 @@ dxf_image_set_x1
                  * of a DXF \c IMAGE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2836,14 +2848,7 @@ dxf_image_set_x1
                   __FUNCTION__);
                 return (NULL);
         }
-        if (image->p1 == NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found.\n")),
-                  __FUNCTION__);
-                return (NULL);
-        }
-        image->p1->x0 = x1;
+        image->p1.x0 = x1;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2864,7 +2869,7 @@ dxf_image_get_y1
                 /*!< a pointer to a DXF \c IMAGE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2876,17 +2881,10 @@ dxf_image_get_y1
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (image->p1 == NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found.\n")),
-                  __FUNCTION__);
-                return (EXIT_FAILURE);
-        }
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (image->p1->y0);
+        return (image->p1.y0);
 }
 
 
@@ -2907,7 +2905,7 @@ dxf_image_set_y1
                  * of a DXF \c IMAGE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2918,14 +2916,7 @@ dxf_image_set_y1
                   __FUNCTION__);
                 return (NULL);
         }
-        if (image->p1 == NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found.\n")),
-                  __FUNCTION__);
-                return (NULL);
-        }
-        image->p1->y0 = y1;
+        image->p1.y0 = y1;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2946,7 +2937,7 @@ dxf_image_get_z1
                 /*!< a pointer to a DXF \c IMAGE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2958,17 +2949,10 @@ dxf_image_get_z1
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (image->p1 == NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found.\n")),
-                  __FUNCTION__);
-                return (EXIT_FAILURE);
-        }
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (image->p1->z0);
+        return (image->p1.z0);
 }
 
 
@@ -2989,7 +2973,7 @@ dxf_image_set_z1
                  * of a DXF \c IMAGE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3000,14 +2984,7 @@ dxf_image_set_z1
                   __FUNCTION__);
                 return (NULL);
         }
-        if (image->p1 == NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found.\n")),
-                  __FUNCTION__);
-                return (NULL);
-        }
-        image->p1->z0 = z1;
+        image->p1.z0 = z1;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -3019,6 +2996,16 @@ dxf_image_set_z1
  * \brief Get the V-vector of a single pixel \c p2 of a DXF \c IMAGE
  * entity.
  *
+ * The point is a newly allocated copy of the position kept in
+ * \c image, to be freed with dxf_point_free ().  Changing it does not
+ * change \c image.
+ *
+ * \deprecated Before the position was kept in \c image itself this
+ * returned the point held by \c image, which was freed together with it
+ * and whose changes were changes of \c image.  Callers relying on that
+ * leak the copy and lose their changes, use
+ * dxf_image_get_p2_vec3 () instead.
+ *
  * \return the V-vector of a single pixel \c p2.
  */
 DxfPoint *
@@ -3028,7 +3015,7 @@ dxf_image_get_p2
                 /*!< a pointer to a DXF \c IMAGE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3039,17 +3026,44 @@ dxf_image_get_p2
                   __FUNCTION__);
                 return (NULL);
         }
-        if (image->p2 == NULL)
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (dxf_point_new_from_vec3 (&image->p2));
+}
+
+
+/*!
+ * \brief Get the V-vector of a single pixel \c p2 of a DXF \c IMAGE
+ * entity, as kept in \c image.
+ *
+ * Changing the position changes \c image.
+ *
+ * \return a pointer to the position, or \c NULL when an error
+ * occurred.
+ */
+DxfVec3 *
+dxf_image_get_p2_vec3
+(
+        DxfImage *image
+                /*!< a pointer to a DXF \c IMAGE entity. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (image == NULL)
         {
                 fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found.\n")),
+                  (_("Error in %s () a NULL pointer was passed.\n")),
                   __FUNCTION__);
                 return (NULL);
         }
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (image->p2);
+        return (&image->p2);
 }
 
 
@@ -3057,6 +3071,8 @@ dxf_image_get_p2
  * \brief Set the V-vector of a single pixel \c p2 of a DXF \c IMAGE
  * entity.
  *
+ * Only the position of \c p2 is copied, the caller keeps \c p2.
+ *
  * \return a pointer to a DXF \c IMAGE entity.
  */
 DxfImage *
@@ -3068,7 +3084,7 @@ dxf_image_set_p2
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3086,7 +3102,9 @@ dxf_image_set_p2
                   __FUNCTION__);
                 return (NULL);
         }
-        image->p2 = p2;
+        image->p2.x0 = p2->x0;
+        image->p2.y0 = p2->y0;
+        image->p2.z0 = p2->z0;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -3107,7 +3125,7 @@ dxf_image_get_x2
                 /*!< a pointer to a DXF \c IMAGE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3119,17 +3137,10 @@ dxf_image_get_x2
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (image->p2 == NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found.\n")),
-                  __FUNCTION__);
-                return (EXIT_FAILURE);
-        }
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (image->p2->x0);
+        return (image->p2.x0);
 }
 
 
@@ -3150,7 +3161,7 @@ dxf_image_set_x2
                  * of a DXF \c IMAGE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3161,14 +3172,7 @@ dxf_image_set_x2
                   __FUNCTION__);
                 return (NULL);
         }
-        if (image->p2 == NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found.\n")),
-                  __FUNCTION__);
-                return (NULL);
-        }
-        image->p2->x0 = x2;
+        image->p2.x0 = x2;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -3189,7 +3193,7 @@ dxf_image_get_y2
                 /*!< a pointer to a DXF \c IMAGE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3201,17 +3205,10 @@ dxf_image_get_y2
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (image->p2 == NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found.\n")),
-                  __FUNCTION__);
-                return (EXIT_FAILURE);
-        }
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (image->p2->y0);
+        return (image->p2.y0);
 }
 
 
@@ -3232,7 +3229,7 @@ dxf_image_set_y2
                  * of a DXF \c IMAGE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3243,14 +3240,7 @@ dxf_image_set_y2
                   __FUNCTION__);
                 return (NULL);
         }
-        if (image->p2 == NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found.\n")),
-                  __FUNCTION__);
-                return (NULL);
-        }
-        image->p2->y0 = y2;
+        image->p2.y0 = y2;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -3271,7 +3261,7 @@ dxf_image_get_z2
                 /*!< a pointer to a DXF \c IMAGE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3283,17 +3273,10 @@ dxf_image_get_z2
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (image->p2 == NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found.\n")),
-                  __FUNCTION__);
-                return (EXIT_FAILURE);
-        }
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (image->p2->z0);
+        return (image->p2.z0);
 }
 
 
@@ -3314,7 +3297,7 @@ dxf_image_set_z2
                  * of a DXF \c IMAGE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3325,14 +3308,7 @@ dxf_image_set_z2
                   __FUNCTION__);
                 return (NULL);
         }
-        if (image->p2 == NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found.\n")),
-                  __FUNCTION__);
-                return (NULL);
-        }
-        image->p2->z0 = z2;
+        image->p2.z0 = z2;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -3344,6 +3320,16 @@ dxf_image_set_z2
  * \brief Get the U- and V-value of the image in pixel size \c p3 of a
  * DXF \c IMAGE entity.
  *
+ * The point is a newly allocated copy of the position kept in
+ * \c image, to be freed with dxf_point_free ().  Changing it does not
+ * change \c image.
+ *
+ * \deprecated Before the position was kept in \c image itself this
+ * returned the point held by \c image, which was freed together with it
+ * and whose changes were changes of \c image.  Callers relying on that
+ * leak the copy and lose their changes, use
+ * dxf_image_get_p3_vec3 () instead.
+ *
  * \return the U- and V-value of the image in pixel size \c p3.
  */
 DxfPoint *
@@ -3353,7 +3339,7 @@ dxf_image_get_p3
                 /*!< a pointer to a DXF \c IMAGE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3364,17 +3350,44 @@ dxf_image_get_p3
                   __FUNCTION__);
                 return (NULL);
         }
-        if (image->p3 == NULL)
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (dxf_point_new_from_vec3 (&image->p3));
+}
+
+
+/*!
+ * \brief Get the U- and V-value of the image in pixel size \c p3 of a
+ * DXF \c IMAGE entity, as kept in \c image.
+ *
+ * Changing the position changes \c image.
+ *
+ * \return a pointer to the position, or \c NULL when an error
+ * occurred.
+ */
+DxfVec3 *
+dxf_image_get_p3_vec3
+(
+        DxfImage *image
+                /*!< a pointer to a DXF \c IMAGE entity. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (image == NULL)
         {
                 fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found.\n")),
+                  (_("Error in %s () a NULL pointer was passed.\n")),
                   __FUNCTION__);
                 return (NULL);
         }
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (image->p3);
+        return (&image->p3);
 }
 
 
@@ -3382,6 +3395,8 @@ dxf_image_get_p3
  * \brief Set the U- and V-value of the image in pixel size \c p3 of a
  * DXF \c IMAGE entity.
  *
+ * Only the position of \c p3 is copied, the caller keeps \c p3.
+ *
  * \return a pointer to a DXF \c IMAGE entity.
  */
 DxfImage *
@@ -3393,7 +3408,7 @@ dxf_image_set_p3
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3411,7 +3426,9 @@ dxf_image_set_p3
                   __FUNCTION__);
                 return (NULL);
         }
-        image->p3 = p3;
+        image->p3.x0 = p3->x0;
+        image->p3.y0 = p3->y0;
+        image->p3.z0 = p3->z0;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -3432,7 +3449,7 @@ dxf_image_get_x3
                 /*!< a pointer to a DXF \c IMAGE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3444,17 +3461,10 @@ dxf_image_get_x3
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (image->p3 == NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found.\n")),
-                  __FUNCTION__);
-                return (EXIT_FAILURE);
-        }
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (image->p3->x0);
+        return (image->p3.x0);
 }
 
 
@@ -3475,7 +3485,7 @@ dxf_image_set_x3
                  * DXF \c IMAGE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3486,14 +3496,7 @@ dxf_image_set_x3
                   __FUNCTION__);
                 return (NULL);
         }
-        if (image->p3 == NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found.\n")),
-                  __FUNCTION__);
-                return (NULL);
-        }
-        image->p3->x0 = x3;
+        image->p3.x0 = x3;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -3514,7 +3517,7 @@ dxf_image_get_y3
                 /*!< a pointer to a DXF \c IMAGE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3526,17 +3529,10 @@ dxf_image_get_y3
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (image->p3 == NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found.\n")),
-                  __FUNCTION__);
-                return (EXIT_FAILURE);
-        }
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (image->p3->y0);
+        return (image->p3.y0);
 }
 
 
@@ -3557,7 +3553,7 @@ dxf_image_set_y3
                  * DXF \c IMAGE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3568,14 +3564,7 @@ dxf_image_set_y3
                   __FUNCTION__);
                 return (NULL);
         }
-        if (image->p3 == NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found.\n")),
-                  __FUNCTION__);
-                return (NULL);
-        }
-        image->p3->y0 = y3;
+        image->p3.y0 = y3;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -3596,7 +3585,7 @@ dxf_image_get_p4
                 /*!< a pointer to a DXF \c IMAGE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3636,7 +3625,7 @@ dxf_image_set_p4
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3676,7 +3665,7 @@ dxf_image_get_x4
                 /*!< a pointer to a DXF \c IMAGE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3719,7 +3708,7 @@ dxf_image_set_x4
                  * (multiple entries) \c x4 of a DXF \c IMAGE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3759,7 +3748,7 @@ dxf_image_get_y4
                 /*!< a pointer to a DXF \c IMAGE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3802,7 +3791,7 @@ dxf_image_set_y4
                  * (multiple entries) \c y4 of a DXF \c IMAGE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -4551,7 +4540,7 @@ dxf_image_get_imagedef_object
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (image->imagedef_object));
+        return (dxf_strdup (image->imagedef_object));
 }
 
 
@@ -4589,7 +4578,7 @@ dxf_image_set_imagedef_object
                   __FUNCTION__);
                 return (NULL);
         }
-        image->imagedef_object = strdup (imagedef_object);
+        image->imagedef_object = dxf_strdup (imagedef_object);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -4631,7 +4620,7 @@ dxf_image_get_imagedef_reactor_object
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (image->imagedef_reactor_object));
+        return (dxf_strdup (image->imagedef_reactor_object));
 }
 
 
@@ -4669,7 +4658,7 @@ dxf_image_set_imagedef_reactor_object
                   __FUNCTION__);
                 return (NULL);
         }
-        image->imagedef_reactor_object = strdup (imagedef_reactor_object);
+        image->imagedef_reactor_object = dxf_strdup (imagedef_reactor_object);
 #if DEBUG
         DXF_DEBUG_END
 #endif
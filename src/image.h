@@ -50,6 +50,7 @@
 
 
 #include "global.h"
+#include "graphic_properties.h"
 #include "binary_graphics_data.h"
 #include "point.h"
 
@@ -66,52 +67,17 @@ typedef struct
 dxf_image_struct
 {
         /* Members common for all DXF drawable entities. */
-        int id_code;
+        long id_code;
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file.\n
                  * Group code = 5. */
-        char *linetype;
-                /*!< The linetype of the entity.\n
-                 * Defaults to \c BYLAYER if ommitted in the DXF file.\n
-                 * Group code = 6. */
-        char *layer;
-                /*!< Layer on which the entity is drawn.\n
-                 * Defaults to layer "0" if no valid layername is given.\n
-                 * Group code = 8. */
-        double elevation;
-                /*!< Elevation of the arc in the local Z-direction.\n
-                 * Defaults to 0.0 if omitted in the DXF file, or prior
-                 * to DXF version R12, or DXF_FLATLAND equals 0 (default).\n
-                 * Group code = 38. */
-        double thickness;
-                /*!< Thickness of the arc in the local Z-direction.\n
-                 * Defaults to 0.0 if ommitted in the DXF file.\n
-                 * Group code = 39. */
-        double linetype_scale;
-                /*!< Linetype scale (optional).\n
-                 * Group code = 48. */
-        int16_t visibility;
-                /*!< Object visibility (optional):\n
-                 * <ol>
-                 * <li value = "0"> Visible</li>
-                 * <li value = "1"> Invisible</li>
-                 * </ol>
-                 * Group code = 60.\n
-                 * \since Introduced in version R13. */
-        int color;
-                /*!< Color of the entity.\n
-                 * Defaults to \c BYLAYER if ommitted in the DXF file.\n
-                 * Note that entities encapsulated in a block with the
-                 * color \c BYBLOCK are represented in the "native" color of
-                 * the \c BLOCK entity.\n
-                 * Group code = 62. */
-        int paperspace;
-                /*!< Entities are to be drawn on either \c PAPERSPACE or
-                 * \c MODELSPACE.\n
-                 * Optional, defaults to \c DXF_MODELSPACE (0).\n
-                 * Group code = 67.\n
-                 * \since Introduced in version R13. */
+        DxfGraphicProperties *properties;
+                /*!< Linetype, layer, color and the other graphic
+                 * properties, shared with the entities which have
+                 * the same (see graphic_properties.h).\n
+                 * Group codes = 6, 8, 38, 39, 48, 60, 62, 67, 284, 347,
+                 * 370, 390, 420, 430 and 440. */
         int graphics_data_size;
                 /*!< Number of bytes in the proxy entity graphics
                  * represented in the sub-sequent 310 groups, which are
@@ -121,16 +87,6 @@ dxf_image_struct
                  * \warning On some 64 bit workstations output is
                  * generated with group code "160", thus omitting group
                  * code "92". */
-        int16_t shadow_mode;
-                /*!< Shadow mode:\n
-                 * <ol>
-                 * <li value = "0"> Casts and receives shadows.</li>
-                 * <li value = "1"> Casts shadows.</li>
-                 * <li value = "2"> Receives shadows.</li>
-                 * <li value = "3"> Ignores shadows.</li>
-                 * </ol>\n
-                 * Group code = 284.\n
-                 * \since Introduced in version R2009. */
         DxfBinaryGraphicsData *binary_graphics_data;
                 /*!< Proxy entity graphics data.\n
                  * Multiple lines of 256 characters maximum per line
@@ -141,67 +97,25 @@ dxf_image_struct
                 /*!< Soft-pointer ID/handle to owner dictionary (optional).\n
                  * Group code = 330.\n
                  * \since Introduced in version R14. */
-        char *material;
-                /*!< Hard-pointer ID/handle to material object (present if
-                 * not BYLAYER).\n
-                 * Group code = 347.\n
-                 * \since Introduced in version R2008. */
         char *dictionary_owner_hard;
                 /*!< Hard owner ID/handle to owner dictionary (optional).\n
                  * Group code = 360.\n
                  * \since Introduced in version R14. */
-        int16_t lineweight;
-                /*!< Lineweight enum value.\n
-                 * Stored and moved around as a 16-bit integer.\n
-                 * Group code = 370.\n
-                 * \since Introduced in version R2002. */
-        char *plot_style_name;
-                /*!< Hard pointer ID / handle of PlotStyleName object.\n
-                 * Group code = 390.\n
-                 * \since Introduced in version R2009. */
-        long color_value;
-                /*!< A 24-bit color value that should be dealt with in
-                 * terms of bytes with values of 0 to 255.\n
-                 * The lowest byte is the blue value, the middle byte is
-                 * the green value, and the third byte is the red value.\n
-                 * The top byte is always 0.\n
-                 * The group code cannot be used by custom entities for
-                 * their own data because the group code is reserved for
-                 * AcDbEntity, class-level color data and AcDbEntity,
-                 * class-level transparency data.\n
-                 * Group code = 420.\n
-                 * \since Introduced in version R2004. */
-        char *color_name;
-                /*!< Color name.\n
-                 * The group code cannot be used by custom entities for
-                 * their own data because the group code is reserved for
-                 * AcDbEntity, class-level color data and AcDbEntity,
-                 * class-level transparency data.\n
-                 * Group code = 430.\n
-                 * \since Introduced in version R2004. */
-        long transparency;
-                /*!< Transparency value.\n
-                 * The group code cannot be used by custom entities for
-                 * their own data because the group code is reserved for
-                 * AcDbEntity, class-level color data and AcDbEntity,
-                 * class-level transparency data.\n
-                 * Group code = 440.\n
-                 * \since Introduced in version R2004. */
         /* Specific members for a DXF image. */
-        DxfPoint *p0;
+        DxfVec3 p0;
                 /*!< Insertion point.\n
                  * Group codes = 10, 20 and 30.*/
-        DxfPoint *p1;
+        DxfVec3 p1;
                 /*!< U-vector of a single pixel (points
                  * along the visual bottom of the image, starting at the
                  * insertion point) (in OCS).\n
                  * Group codes = 11, 21 and 31.*/
-        DxfPoint *p2;
+        DxfVec3 p2;
                 /*!< V-vector of a single pixel (points
                  * along the visual left side of the image, starting at
                  * the insertion point) (in OCS).\n
                  * Group codes = 12, 22 and 32.*/
-        DxfPoint *p3;
+        DxfVec3 p3;
                 /*!< U- and V-value of image size in pixels.\n
                  * Group codes = 13 and 23.*/
         DxfPoint *p4;
@@ -288,7 +202,7 @@ dxf_image_free_chain
 (
         DxfImage *images
 );
-int
+long
 dxf_image_get_id_code
 (
         DxfImage *image
@@ -297,7 +211,7 @@ DxfImage *
 dxf_image_set_id_code
 (
         DxfImage *image,
-        int id_code
+        long id_code
 );
 char *
 dxf_image_get_linetype
@@ -510,6 +424,11 @@ dxf_image_set_transparency
 );
 DxfPoint *
 dxf_image_get_p0
+(
+        DxfImage *image
+) DXF_DEPRECATED;
+DxfVec3 *
+dxf_image_get_p0_vec3
 (
         DxfImage *image
 );
@@ -554,6 +473,11 @@ dxf_image_set_z0
 );
 DxfPoint *
 dxf_image_get_p1
+(
+        DxfImage *image
+) DXF_DEPRECATED;
+DxfVec3 *
+dxf_image_get_p1_vec3
 (
         DxfImage *image
 );
@@ -598,6 +522,11 @@ dxf_image_set_z1
 );
 DxfPoint *
 dxf_image_get_p2
+(
+        DxfImage *image
+) DXF_DEPRECATED;
+DxfVec3 *
+dxf_image_get_p2_vec3
 (
         DxfImage *image
 );
@@ -642,6 +571,11 @@ dxf_image_set_z2
 );
 DxfPoint *
 dxf_image_get_p3
+(
+        DxfImage *image
+) DXF_DEPRECATED;
+DxfVec3 *
+dxf_image_get_p3_vec3
 (
         DxfImage *image
 );
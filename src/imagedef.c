@@ -43,6 +43,8 @@
 
 
 #include "imagedef.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -157,7 +159,8 @@ dxf_imagedef_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfPair pair;
         int i;
 
         /* Do some basic checks. */
@@ -166,8 +169,6 @@ dxf_imagedef_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (fp->acad_version_number < AutoCAD_14)
@@ -185,149 +186,122 @@ dxf_imagedef_read
                 imagedef = dxf_imagedef_init (imagedef);
         }
         i = 0;
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        /* Clean up. */
-                        free (temp_string);
-                        fclose (fp->fp);
-                        return (NULL);
-                }
-                else if (strcmp (temp_string, "1") == 0)
-                {
-                        /* Now follows a string containing a file name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", imagedef->file_name);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &imagedef->id_code);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * U-value of the image size in pixels. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &imagedef->x0);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * V-value of the image size in pixels. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &imagedef->y0);
-                }
-                else if (strcmp (temp_string, "11") == 0)
-                {
-                        /* Now follows a string containing the
-                         * U-value of the default size of one pixel in
-                         * AutoCAD units. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &imagedef->x1);
-                }
-                else if (strcmp (temp_string, "12") == 0)
-                {
-                        /* Now follows a string containing the
-                         * V-value of the default size of one pixel in
-                         * AutoCAD units. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &imagedef->y1);
-                }
-                else if (strcmp (temp_string, "90") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing the
-                         * value of class version. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &imagedef->class_version);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else if ((fp->acad_version_number >= AutoCAD_13)
-                        && (strcmp (temp_string, "100") == 0))
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "AcDbRasterImageDef") != 0)
-                        {
+                        case 1:
+                                /* Now follows a string containing a file name. */
+                                free (imagedef->file_name);
+                                imagedef->file_name = dxf_pair_get_string (&pair);
+                                break;
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                imagedef->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 10:
+                                /* Now follows a string containing the
+                                 * U-value of the image size in pixels. */
+                                imagedef->x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 20:
+                                /* Now follows a string containing the
+                                 * V-value of the image size in pixels. */
+                                imagedef->y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 11:
+                                /* Now follows a string containing the
+                                 * U-value of the default size of one pixel in
+                                 * AutoCAD units. */
+                                imagedef->x1 = dxf_pair_get_double (&pair);
+                                break;
+                        case 12:
+                                /* Now follows a string containing the
+                                 * V-value of the default size of one pixel in
+                                 * AutoCAD units. */
+                                imagedef->y1 = dxf_pair_get_double (&pair);
+                                break;
+                        case 90:
+                                /* Now follows a string containing the
+                                 * value of class version. */
+                                imagedef->class_version = dxf_pair_get_int (&pair);
+                                break;
+                        case 100:
+                                if (fp->acad_version_number >= AutoCAD_13)
+                                {
+                                        /* Now follows a string containing the
+                                         * subclass marker value. */
+                                        dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                        if (strcmp (temp_string, "AcDbRasterImageDef") != 0)
+                                        {
+                                                fprintf (stderr,
+                                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                                  __FUNCTION__, fp->filename, fp->line_number);
+                                        }
+                                }
+                                break;
+                        case 280:
+                                /* Now follows a string containing the
+                                 * value of the image is loaded flag. */
+                                imagedef->image_is_loaded_flag = dxf_pair_get_int (&pair);
+                                break;
+                        case 281:
+                                /* Now follows a string containing the
+                                 * value of the resolution units. */
+                                imagedef->resolution_units = dxf_pair_get_int (&pair);
+                                break;
+                        case 330:
+                                if (i == 0)
+                                {
+                                        /* Now follows a string containing Soft-pointer
+                                         * ID/handle to owner dictionary. */
+                                        free (imagedef->dictionary_owner_soft);
+                                        imagedef->dictionary_owner_soft = dxf_pair_get_string (&pair);
+                                        i++;
+                                }
+                                else if (i == 1)
+                                {
+                                        /* Now follows a string containing Soft-pointer
+                                         * ID/handle to owner dictionary. */
+                                        free (imagedef->acad_image_dict_soft);
+                                        imagedef->acad_image_dict_soft = dxf_pair_get_string (&pair);
+                                        i++;
+                                        /*! \todo Check for overrun of array index. */
+                                }
+                                else if (i > 1)
+                                {
+                                        /* Now follows a string containing a Soft
+                                         * pointer reference to entity. */
+                                        imagedef->imagedef_reactor_soft[i] = dxf_pair_get_string (&pair);
+                                        i++;
+                                }
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                free (imagedef->dictionary_owner_hard);
+                                imagedef->dictionary_owner_hard = dxf_pair_get_string (&pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, (_("DXF comment: %s\n")), temp_string);
+                                break;
+                        default:
                                 fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
                                   __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "280") == 0)
-                {
-                        /* Now follows a string containing the
-                         * value of the image is loaded flag. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &imagedef->image_is_loaded_flag);
-                }
-                else if (strcmp (temp_string, "281") == 0)
-                {
-                        /* Now follows a string containing the
-                         * value of the resolution units. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &imagedef->resolution_units);
-                }
-                else if ((strcmp (temp_string, "330") == 0)
-                  && (i == 0))
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", imagedef->dictionary_owner_soft);
-                        i++;
-                }
-                else if ((strcmp (temp_string, "330") == 0)
-                  && (i == 1))
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", imagedef->acad_image_dict_soft);
-                        i++;
-                        /*! \todo Check for overrun of array index. */
-                }
-                else if ((strcmp (temp_string, "330") == 0)
-                  && (i > 1))
-                {
-                        /* Now follows a string containing a Soft
-                         * pointer reference to entity. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", imagedef->imagedef_reactor_soft[i]);
-                        i++;
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", imagedef->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, (_("DXF comment: %s\n")), temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
-        /* Clean up. */
-        free (temp_string);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -377,14 +351,14 @@ dxf_imagedef_write
         if (fp->acad_version_number < AutoCAD_14)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () illegal DXF version for this %s entity with id-code: %x.\n")),
+                  (_("Warning in %s () illegal DXF version for this %s entity with id-code: %lx.\n")),
                   __FUNCTION__, dxf_entity_name, imagedef->id_code);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
-        if (dxf_imagedef_get_id_code (imagedef) != -1)
+        dxf_write_string (fp, 0, dxf_entity_name);
+        if (imagedef->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", dxf_imagedef_get_id_code (imagedef));
+                dxf_write_hex (fp, 5, dxf_imagedef_get_id_code (imagedef));
         }
         /*!
          * \todo for version R14.\n
@@ -399,40 +373,40 @@ dxf_imagedef_write
         if ((strcmp (imagedef->dictionary_owner_soft, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", dxf_imagedef_get_dictionary_owner_soft (imagedef));
-                fprintf (fp->fp, "330\n%s\n", dxf_imagedef_get_acad_image_dict_soft (imagedef));
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, dxf_imagedef_get_dictionary_owner_soft (imagedef));
+                dxf_write_string (fp, 330, dxf_imagedef_get_acad_image_dict_soft (imagedef));
                 if (dxf_imagedef_get_imagedef_reactor (imagedef) != NULL)
                 {
                         DxfImagedefReactor *iter;
                         iter = dxf_imagedef_get_imagedef_reactor (imagedef);
                         while (iter != NULL)
                         {
-                                fprintf (fp->fp, "330\n%s\n", dxf_imagedef_reactor_get_associated_image_object (iter));
+                                dxf_write_string (fp, 330, dxf_imagedef_reactor_get_associated_image_object (iter));
                                 iter = (DxfImagedefReactor *) dxf_imagedef_reactor_get_next (iter);
                         }
                 }
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (imagedef->dictionary_owner_hard, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", dxf_imagedef_get_dictionary_owner_hard (imagedef));
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, dxf_imagedef_get_dictionary_owner_hard (imagedef));
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbRasterImageDef\n");
+                dxf_write_string (fp, 100, "AcDbRasterImageDef");
         }
-        fprintf (fp->fp, " 90\n%d\n", dxf_imagedef_get_class_version (imagedef));
-        fprintf (fp->fp, "  1\n%s\n", dxf_imagedef_get_file_name (imagedef));
-        fprintf (fp->fp, " 10\n%f\n", dxf_imagedef_get_x0 (imagedef));
-        fprintf (fp->fp, " 20\n%f\n", dxf_imagedef_get_y0 (imagedef));
-        fprintf (fp->fp, " 11\n%f\n", dxf_imagedef_get_x1 (imagedef));
-        fprintf (fp->fp, " 12\n%f\n", dxf_imagedef_get_y1 (imagedef));
-        fprintf (fp->fp, "280\n%d\n", dxf_imagedef_get_image_is_loaded_flag (imagedef));
-        fprintf (fp->fp, "281\n%d\n", dxf_imagedef_get_resolution_units (imagedef));
+        dxf_write_int (fp, 90, dxf_imagedef_get_class_version (imagedef));
+        dxf_write_string (fp, 1, dxf_imagedef_get_file_name (imagedef));
+        dxf_write_double (fp, 10, dxf_imagedef_get_x0 (imagedef));
+        dxf_write_double (fp, 20, dxf_imagedef_get_y0 (imagedef));
+        dxf_write_double (fp, 11, dxf_imagedef_get_x1 (imagedef));
+        dxf_write_double (fp, 12, dxf_imagedef_get_y1 (imagedef));
+        dxf_write_int (fp, 280, dxf_imagedef_get_image_is_loaded_flag (imagedef));
+        dxf_write_int (fp, 281, dxf_imagedef_get_resolution_units (imagedef));
         /* Clean up. */
         free (dxf_entity_name);
 #if DEBUG
@@ -498,7 +472,7 @@ dxf_imagedef_free_chain
                 /*!< pointer to the chain of DXF \c IMAGEDEF objects. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (imagedefs == NULL)
@@ -525,7 +499,7 @@ dxf_imagedef_free_chain
  * \return \c id_code when successful, or \c EXIT_FAILURE when an error
  * occurred.
  */
-int
+long
 dxf_imagedef_get_id_code
 (
         DxfImagedef *imagedef
@@ -568,7 +542,7 @@ dxf_imagedef_set_id_code
 (
         DxfImagedef *imagedef,
                 /*!< a pointer to a DXF \c IMAGEDEF object. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -859,7 +833,7 @@ dxf_imagedef_get_p0
                 /*!< a pointer to a DXF \c IMAGEDEF object. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -898,7 +872,7 @@ dxf_imagedef_set_p0
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -937,7 +911,7 @@ dxf_imagedef_get_x0
                 /*!< a pointer to a DXF \c IMAGEDEF object. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -980,7 +954,7 @@ dxf_imagedef_set_x0
                  * DXF \c IMAGEDEF object. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -1019,7 +993,7 @@ dxf_imagedef_get_y0
                 /*!< a pointer to a DXF \c IMAGEDEF object. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -1062,7 +1036,7 @@ dxf_imagedef_set_y0
                  * DXF \c IMAGEDEF object. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -1101,7 +1075,7 @@ dxf_imagedef_get_p1
                 /*!< a pointer to a DXF \c IMAGEDEF object. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -1141,7 +1115,7 @@ dxf_imagedef_set_p1
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -1180,7 +1154,7 @@ dxf_imagedef_get_x1
                 /*!< a pointer to a DXF \c IMAGEDEF object. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -1223,7 +1197,7 @@ dxf_imagedef_set_x1
                  * AutoCAD units \c x1 of a DXF \c IMAGEDEF object. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -1262,7 +1236,7 @@ dxf_imagedef_get_y1
                 /*!< a pointer to a DXF \c IMAGEDEF object. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -1305,7 +1279,7 @@ dxf_imagedef_set_y1
                  * AutoCAD units \c y1 of a DXF \c IMAGEDEF object. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
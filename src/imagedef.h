@@ -63,7 +63,7 @@ typedef struct
 dxf_imagedef_struct
 {
         /* Members common for all DXF group objects. */
-        int id_code;
+        long id_code;
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file.\n
@@ -167,7 +167,7 @@ dxf_imagedef_free_chain
 (
         DxfImagedef *imagedefs
 );
-int
+long
 dxf_imagedef_get_id_code
 (
         DxfImagedef *imagedef
@@ -176,7 +176,7 @@ DxfImagedef *
 dxf_imagedef_set_id_code
 (
         DxfImagedef *imagedef,
-        int id_code
+        long id_code
 );
 char *
 dxf_imagedef_get_dictionary_owner_soft
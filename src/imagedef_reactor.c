@@ -44,6 +44,8 @@
 
 
 #include "imagedef_reactor.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -151,7 +153,8 @@ dxf_imagedef_reactor_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfPair pair;
         int i;
 
         /* Do some basic checks. */
@@ -160,8 +163,6 @@ dxf_imagedef_reactor_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (fp->acad_version_number < AutoCAD_14)
@@ -179,89 +180,77 @@ dxf_imagedef_reactor_read
                 imagedef_reactor = dxf_imagedef_reactor_init (imagedef_reactor);
         }
         i = 0;
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        /* Clean up. */
-                        free (temp_string);
-                        fclose (fp->fp);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &imagedef_reactor->id_code);
-                }
-                else if (strcmp (temp_string, "90") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing the
-                         * value of class version. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &imagedef_reactor->class_version);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else if ((fp->acad_version_number >= AutoCAD_13)
-                        && (strcmp (temp_string, "100") == 0))
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "AcDbRasterImageDef") != 0)
-                        {
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                imagedef_reactor->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 90:
+                                /* Now follows a string containing the
+                                 * value of class version. */
+                                imagedef_reactor->class_version = dxf_pair_get_int (&pair);
+                                break;
+                        case 100:
+                                if (fp->acad_version_number >= AutoCAD_13)
+                                {
+                                        /* Now follows a string containing the
+                                         * subclass marker value. */
+                                        dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                        if (strcmp (temp_string, "AcDbRasterImageDef") != 0)
+                                        {
+                                                fprintf (stderr,
+                                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                                  __FUNCTION__, fp->filename, fp->line_number);
+                                        }
+                                }
+                                break;
+                        case 330:
+                                if (i == 0)
+                                {
+                                        /* Now follows a string containing Soft-pointer
+                                         * ID/handle to owner dictionary. */
+                                        free (imagedef_reactor->dictionary_owner_soft);
+                                        imagedef_reactor->dictionary_owner_soft = dxf_pair_get_string (&pair);
+                                        i++;
+                                }
+                                else if (i == 1)
+                                {
+                                        /* Now follows a string containing object ID for
+                                         * associated image object. */
+                                        free (imagedef_reactor->associated_image_object);
+                                        imagedef_reactor->associated_image_object = dxf_pair_get_string (&pair);
+                                        i++;
+                                }
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                free (imagedef_reactor->dictionary_owner_hard);
+                                imagedef_reactor->dictionary_owner_hard = dxf_pair_get_string (&pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, (_("DXF comment: %s\n")), temp_string);
+                                break;
+                        default:
                                 fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
                                   __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if ((strcmp (temp_string, "330") == 0)
-                  && (i == 0))
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", imagedef_reactor->dictionary_owner_soft);
-                        i++;
-                }
-                else if ((strcmp (temp_string, "330") == 0)
-                  && (i == 1))
-                {
-                        /* Now follows a string containing object ID for
-                         * associated image object. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", imagedef_reactor->associated_image_object);
-                        i++;
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", imagedef_reactor->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, (_("DXF comment: %s\n")), temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
-        /* Clean up. */
-        free (temp_string);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -312,7 +301,7 @@ dxf_imagedef_reactor_write
         if (fp->acad_version_number < AutoCAD_14)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () illegal DXF version for this %s entity with id-code: %x.\n")),
+                  (_("Warning in %s () illegal DXF version for this %s entity with id-code: %lx.\n")),
                   __FUNCTION__, dxf_entity_name, dxf_imagedef_reactor_get_id_code (imagedef_reactor));
         }
         if (fp->acad_version_number == AutoCAD_14)
@@ -320,10 +309,10 @@ dxf_imagedef_reactor_write
                 dxf_imagedef_reactor_set_class_version (imagedef_reactor, 2);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
-        if (dxf_imagedef_reactor_get_id_code (imagedef_reactor) != -1)
+        dxf_write_string (fp, 0, dxf_entity_name);
+        if (imagedef_reactor->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", dxf_imagedef_reactor_get_id_code (imagedef_reactor));
+                dxf_write_hex (fp, 5, dxf_imagedef_reactor_get_id_code (imagedef_reactor));
         }
         /*!
          * \todo for version R14.\n
@@ -338,23 +327,23 @@ dxf_imagedef_reactor_write
         if ((strcmp (dxf_imagedef_reactor_get_dictionary_owner_soft (imagedef_reactor), "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", dxf_imagedef_reactor_get_dictionary_owner_soft (imagedef_reactor));
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, dxf_imagedef_reactor_get_dictionary_owner_soft (imagedef_reactor));
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (dxf_imagedef_reactor_get_dictionary_owner_hard (imagedef_reactor), "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", dxf_imagedef_reactor_get_dictionary_owner_hard (imagedef_reactor));
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, dxf_imagedef_reactor_get_dictionary_owner_hard (imagedef_reactor));
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbRasterImageDefReactor\n");
+                dxf_write_string (fp, 100, "AcDbRasterImageDefReactor");
         }
-        fprintf (fp->fp, " 90\n%d\n", dxf_imagedef_reactor_get_class_version (imagedef_reactor));
-        fprintf (fp->fp, "330\n%s\n", dxf_imagedef_reactor_get_associated_image_object (imagedef_reactor));
+        dxf_write_int (fp, 90, dxf_imagedef_reactor_get_class_version (imagedef_reactor));
+        dxf_write_string (fp, 330, dxf_imagedef_reactor_get_associated_image_object (imagedef_reactor));
         /* Clean up. */
         free (dxf_entity_name);
 #if DEBUG
@@ -414,7 +403,7 @@ dxf_imagedef_reactor_free_chain
                  * objects. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (imagedef_reactors == NULL)
@@ -441,7 +430,7 @@ dxf_imagedef_reactor_free_chain
  * \return \c id_code when successful, or \c EXIT_FAILURE when an error
  * occurred.
  */
-int
+long
 dxf_imagedef_reactor_get_id_code
 (
         DxfImagedefReactor *imagedef_reactor
@@ -484,7 +473,7 @@ dxf_imagedef_reactor_set_id_code
 (
         DxfImagedefReactor *imagedef_reactor,
                 /*!< a pointer to a DXF \c IMAGEDEF_REACTOR object. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
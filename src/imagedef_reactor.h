@@ -63,7 +63,7 @@ typedef struct
 dxf_imagedef_reactor_struct
 {
         /* Members common for all DXF group objects. */
-        int id_code;
+        long id_code;
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file.\n
@@ -119,7 +119,7 @@ dxf_imagedef_reactor_free_chain
 (
         DxfImagedefReactor *imagedef_reactors
 );
-int
+long
 dxf_imagedef_reactor_get_id_code
 (
         DxfImagedefReactor *imagedef_reactor
@@ -128,7 +128,7 @@ DxfImagedefReactor *
 dxf_imagedef_reactor_set_id_code
 (
         DxfImagedefReactor *imagedef_reactor,
-        int id_code
+        long id_code
 );
 char *
 dxf_imagedef_reactor_get_dictionary_owner_soft
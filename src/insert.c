@@ -45,6 +45,9 @@
 
 
 #include "insert.h"
+#include "arena.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -64,7 +67,7 @@ dxf_insert_new ()
         size = sizeof (DxfInsert);
         /* avoid malloc of 0 bytes */
         if (size == 0) size = 1;
-        if ((insert = malloc (size)) == NULL)
+        if ((insert = dxf_malloc (size)) == NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () could not allocate memory for a DxfInsert struct.\n")),
@@ -114,29 +117,13 @@ dxf_insert_init
               return (NULL);
         }
         dxf_insert_set_id_code (insert, 0);
-        dxf_insert_set_linetype (insert, strdup (DXF_DEFAULT_LINETYPE));
-        dxf_insert_set_layer (insert, strdup (DXF_DEFAULT_LAYER));
-        dxf_insert_set_elevation (insert, 0.0);
-        dxf_insert_set_thickness (insert, 0.0);
-        dxf_insert_set_linetype_scale (insert, DXF_DEFAULT_LINETYPE_SCALE);
-        dxf_insert_set_visibility (insert, DXF_DEFAULT_VISIBILITY);
-        dxf_insert_set_color (insert, DXF_COLOR_BYLAYER);
-        dxf_insert_set_paperspace (insert, DXF_MODELSPACE);
+        insert->properties = dxf_graphic_properties_default ();
         dxf_insert_set_graphics_data_size (insert, 0);
-        dxf_insert_set_shadow_mode (insert, 0);
         dxf_insert_set_binary_graphics_data (insert, (DxfBinaryGraphicsData *) dxf_binary_graphics_data_new ());
         dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) dxf_insert_get_binary_graphics_data (insert));
-        dxf_insert_set_dictionary_owner_soft (insert, strdup (""));
-        dxf_insert_set_material (insert, strdup (""));
-        dxf_insert_set_dictionary_owner_hard (insert, strdup (""));
-        dxf_insert_set_lineweight (insert, 0.0);
-        dxf_insert_set_plot_style_name (insert, strdup (""));
-        dxf_insert_set_color_value (insert, 0);
-        dxf_insert_set_color_name (insert, strdup (""));
-        dxf_insert_set_transparency (insert, 0);
-        dxf_insert_set_block_name (insert, strdup (""));
-        dxf_insert_set_p0 (insert, dxf_point_new ());
-        dxf_point_init ((DxfPoint *) dxf_insert_get_p0 (insert));
+        dxf_insert_set_dictionary_owner_soft (insert, "");
+        dxf_insert_set_dictionary_owner_hard (insert, "");
+        dxf_insert_set_block_name (insert, "");
         dxf_insert_set_x0 (insert, 0.0);
         dxf_insert_set_y0 (insert, 0.0);
         dxf_insert_set_z0 (insert, 0.0);
@@ -183,7 +170,9 @@ dxf_insert_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfGraphicProperties properties;
+        DxfPair pair;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -191,8 +180,6 @@ dxf_insert_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (insert == NULL)
@@ -203,255 +190,204 @@ dxf_insert_read
                 insert = dxf_insert_new ();
                 insert = dxf_insert_init (insert);
         }
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        dxf_graphic_properties_start (&properties, insert->properties);
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        fclose (fp->fp);
-                        /* Clean up. */
-                        free (temp_string);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "2") == 0)
-                {
-                        /* Now follows a string containing a block name
-                         * value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", insert->block_name);
-                }
-                else if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &insert->id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", insert->linetype);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", insert->layer);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the center point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &insert->p0->x0);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the center point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &insert->p0->y0);
-                }
-                else if (strcmp (temp_string, "30") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the center point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &insert->p0->z0);
-                }
-                else if ((fp->acad_version_number <= AutoCAD_11)
-                        && (strcmp (temp_string, "38") == 0)
-                        && (insert->elevation != 0.0))
-                {
-                        /* Now follows a string containing the
-                         * elevation. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &insert->elevation);
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &insert->thickness);
-                }
-                else if (strcmp (temp_string, "41") == 0)
-                {
-                        /* Now follows a string containing the
-                         * relative X-scale. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &insert->rel_x_scale);
-                }
-                else if (strcmp (temp_string, "42") == 0)
-                {
-                        /* Now follows a string containing the
-                         * relative Y-scale. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &insert->rel_y_scale);
-                }
-                else if (strcmp (temp_string, "43") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing the
-                         * relative Z-scale. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &insert->rel_z_scale);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else if (strcmp (temp_string, "44") == 0)
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing the
-                         * column spacing. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &insert->column_spacing);
-                }
-                else if (strcmp (temp_string, "45") == 0)
-                {
-                        /* Now follows a string containing the
-                         * row spacing. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &insert->row_spacing);
-                }
-                else if (strcmp (temp_string, "48") == 0)
-                {
-                        /* Now follows a string containing the linetype
-                         * scale. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &insert->linetype_scale);
-                }
-                else if (strcmp (temp_string, "50") == 0)
-                {
-                        /* Now follows a string containing the
-                         * rotation angle. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &insert->rot_angle);
-                }
-                else if (strcmp (temp_string, "60") == 0)
-                {
-                        /* Now follows a string containing the
-                         * visibility value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &insert->visibility);
-                }
-                else if (strcmp (temp_string, "62") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &insert->color);
-                }
-                else if (strcmp (temp_string, "66") == 0)
-                {
-                        /* Now follows a string containing the
-                         * attributes follow flag. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &insert->attributes_follow);
-                        /*!
-                         * \todo After a set attributes_follow flag is
-                         * detected, parsing of following entities should
-                         * be implemented until the end of sequence
-                         * marker (\c SEQEND) is encountered. */
-                }
-                else if (strcmp (temp_string, "67") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &insert->paperspace);
-                }
-                else if (strcmp (temp_string, "70") == 0)
-                {
-                        /* Now follows a string containing the
-                         * number of columns. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &insert->columns);
-                }
-                else if (strcmp (temp_string, "71") == 0)
-                {
-                        /* Now follows a string containing the
-                         * number of rows. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &insert->rows);
-                }
-                else if ((fp->acad_version_number >= AutoCAD_13)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if ((strcmp (temp_string, "AcDbEntity") != 0)
-                        && (strcmp (temp_string, "AcDbBlockReference") != 0))
-                        {
+                        case 2:
+                                /* Now follows a string containing a block name
+                                 * value. */
+                                dxf_free (insert->block_name);
+                                insert->block_name = dxf_pair_get_string (&pair);
+                                break;
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                insert->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 6:
+                                /* Now follows a string containing a linetype
+                                 * name. */
+                                dxf_lexer_free_string (fp, properties.linetype);
+                                properties.linetype = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 8:
+                                /* Now follows a string containing a layer name. */
+                                dxf_lexer_free_string (fp, properties.layer);
+                                properties.layer = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 10:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the center point. */
+                                insert->p0.x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 20:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the center point. */
+                                insert->p0.y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 30:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the center point. */
+                                insert->p0.z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 38:
+                                if ((fp->acad_version_number <= AutoCAD_11)
+                                  && (properties.elevation != 0.0))
+                                {
+                                        /* Now follows a string containing the
+                                         * elevation. */
+                                        properties.elevation = dxf_pair_get_double (&pair);
+                                }
+                                break;
+                        case 39:
+                                /* Now follows a string containing the
+                                 * thickness. */
+                                properties.thickness = dxf_pair_get_double (&pair);
+                                break;
+                        case 41:
+                                /* Now follows a string containing the
+                                 * relative X-scale. */
+                                insert->rel_x_scale = dxf_pair_get_double (&pair);
+                                break;
+                        case 42:
+                                /* Now follows a string containing the
+                                 * relative Y-scale. */
+                                insert->rel_y_scale = dxf_pair_get_double (&pair);
+                                break;
+                        case 43:
+                                /* Now follows a string containing the
+                                 * relative Z-scale. */
+                                insert->rel_z_scale = dxf_pair_get_double (&pair);
+                                break;
+                        case 44:
+                                /* Now follows a string containing the
+                                 * column spacing. */
+                                insert->column_spacing = dxf_pair_get_double (&pair);
+                                break;
+                        case 45:
+                                /* Now follows a string containing the
+                                 * row spacing. */
+                                insert->row_spacing = dxf_pair_get_double (&pair);
+                                break;
+                        case 48:
+                                /* Now follows a string containing the linetype
+                                 * scale. */
+                                properties.linetype_scale = dxf_pair_get_double (&pair);
+                                break;
+                        case 50:
+                                /* Now follows a string containing the
+                                 * rotation angle. */
+                                insert->rot_angle = dxf_pair_get_double (&pair);
+                                break;
+                        case 60:
+                                /* Now follows a string containing the
+                                 * visibility value. */
+                                properties.visibility = dxf_pair_get_int (&pair);
+                                break;
+                        case 62:
+                                /* Now follows a string containing the
+                                 * color value. */
+                                properties.color = dxf_pair_get_int (&pair);
+                                break;
+                        case 66:
+                                /* Now follows a string containing the
+                                 * attributes follow flag. */
+                                insert->attributes_follow = dxf_pair_get_int (&pair);
+                                /*!
+                                 * \todo After a set attributes_follow flag is
+                                 * detected, parsing of following entities should
+                                 * be implemented until the end of sequence
+                                 * marker (\c SEQEND) is encountered. */
+                                break;
+                        case 67:
+                                /* Now follows a string containing the
+                                 * paperspace value. */
+                                properties.paperspace = dxf_pair_get_int (&pair);
+                                break;
+                        case 70:
+                                /* Now follows a string containing the
+                                 * number of columns. */
+                                insert->columns = dxf_pair_get_int (&pair);
+                                break;
+                        case 71:
+                                /* Now follows a string containing the
+                                 * number of rows. */
+                                insert->rows = dxf_pair_get_int (&pair);
+                                break;
+                        case 100:
+                                if (fp->acad_version_number >= AutoCAD_13)
+                                {
+                                        /* Now follows a string containing the
+                                         * subclass marker value. */
+                                        dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                        if ((strcmp (temp_string, "AcDbEntity") != 0)
+                                        && (strcmp (temp_string, "AcDbBlockReference") != 0))
+                                        {
+                                                fprintf (stderr,
+                                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                                  __FUNCTION__, fp->filename, fp->line_number);
+                                        }
+                                }
+                                break;
+                        case 210:
+                                /* Now follows a string containing the
+                                 * X-value of the extrusion vector. */
+                                insert->extr_x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 220:
+                                /* Now follows a string containing the
+                                 * Y-value of the extrusion vector. */
+                                insert->extr_y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 230:
+                                /* Now follows a string containing the
+                                 * Z-value of the extrusion vector. */
+                                insert->extr_z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, insert->dictionary_owner_soft);
+                                insert->dictionary_owner_soft = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, insert->dictionary_owner_hard);
+                                insert->dictionary_owner_hard = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, "DXF comment: %s\n", temp_string);
+                                break;
+                        default:
                                 fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
                                   __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "210") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &insert->extr_x0);
-                }
-                else if (strcmp (temp_string, "220") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &insert->extr_y0);
-                }
-                else if (strcmp (temp_string, "230") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &insert->extr_z0);
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", insert->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", insert->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
         /* Handle omitted members and/or illegal values. */
-        if (strcmp (dxf_insert_get_linetype (insert), "") == 0)
+        if (strcmp (insert->properties->linetype, "") == 0)
         {
-                dxf_insert_set_linetype (insert, strdup (DXF_DEFAULT_LINETYPE));
+                dxf_insert_set_linetype (insert, DXF_DEFAULT_LINETYPE);
         }
-        if (strcmp (dxf_insert_get_layer (insert), "") == 0)
+        if (strcmp (insert->properties->layer, "") == 0)
         {
-                dxf_insert_set_layer (insert, strdup (DXF_DEFAULT_LAYER));
+                dxf_insert_set_layer (insert, DXF_DEFAULT_LAYER);
         }
-        /* Clean up. */
-        free (temp_string);
+        /* Entities with equal properties share a record. */
+        dxf_graphic_properties_finish (fp, &insert->properties, &properties);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -477,7 +413,7 @@ dxf_insert_write
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *dxf_entity_name = strdup ("INSERT");
+        char *dxf_entity_name = dxf_strdup ("INSERT");
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -486,7 +422,7 @@ dxf_insert_write
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (insert == NULL)
@@ -495,33 +431,33 @@ dxf_insert_write
                   (_("Error in %s () a NULL pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (strcmp (dxf_insert_get_linetype (insert), "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_insert_get_id_code (insert));
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                dxf_insert_set_linetype (insert, strdup (DXF_DEFAULT_LINETYPE));
+                dxf_insert_set_linetype (insert, DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (dxf_insert_get_layer (insert), "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty layer string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty layer string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_insert_get_id_code (insert));
                 fprintf (stderr,
                   (_("\t%s entity is relocated to layer 0.\n")),
                   dxf_entity_name);
-                dxf_insert_set_layer (insert, strdup (DXF_DEFAULT_LAYER));
+                dxf_insert_set_layer (insert, DXF_DEFAULT_LAYER);
         }
         if (dxf_insert_get_rel_x_scale (insert) == 0.0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () relative X-scale factor has a value of 0.0 for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () relative X-scale factor has a value of 0.0 for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_insert_get_id_code (insert));
                 fprintf (stderr,
                   (_("\tdefault relative X-scale of 1.0 applied to %s entity.\n")),
@@ -531,7 +467,7 @@ dxf_insert_write
         if (dxf_insert_get_rel_y_scale (insert) == 0.0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () relative Y-scale factor has a value of 0.0 for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () relative Y-scale factor has a value of 0.0 for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_insert_get_id_code (insert));
                 fprintf (stderr,
                   (_("\tdefault relative Y-scale of 1.0 applied to %s entity.\n")),
@@ -541,7 +477,7 @@ dxf_insert_write
         if (dxf_insert_get_rel_z_scale (insert) == 0.0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () relative Z-scale factor has a value of 0.0 for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () relative Z-scale factor has a value of 0.0 for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_insert_get_id_code (insert));
                 fprintf (stderr,
                   (_("\tdefault relative Z-scale of 1.0 applied to %s entity.\n")),
@@ -552,7 +488,7 @@ dxf_insert_write
           && (dxf_insert_get_column_spacing (insert) == 0.0))
         {
                 fprintf (stderr,
-                  (_("Warning in %s () number of columns is greater than 1 and the column spacing has a value of 0.0 for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () number of columns is greater than 1 and the column spacing has a value of 0.0 for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_insert_get_id_code (insert));
                 fprintf (stderr,
                   (_("\tdefault number of columns value of 1 applied to %s entity.\n")),
@@ -563,7 +499,7 @@ dxf_insert_write
           && (dxf_insert_get_row_spacing (insert) == 0.0))
         {
                 fprintf (stderr,
-                  (_("Warning in %s () number of rows is greater than 1 and the row spacing has a value of 0.0 for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () number of rows is greater than 1 and the row spacing has a value of 0.0 for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_insert_get_id_code (insert));
                 fprintf (stderr,
                   (_("\tdefault number of rows value of 1 applied to %s entity.\n")),
@@ -571,10 +507,10 @@ dxf_insert_write
                 dxf_insert_set_rows (insert, 1);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
-        if (dxf_insert_get_id_code (insert) != -1)
+        dxf_write_string (fp, 0, dxf_entity_name);
+        if (insert->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", dxf_insert_get_id_code (insert));
+                dxf_write_hex (fp, 5, dxf_insert_get_id_code (insert));
         }
         /*!
          * \todo for version R14.\n
@@ -589,111 +525,111 @@ dxf_insert_write
         if ((strcmp (dxf_insert_get_dictionary_owner_soft (insert), "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", dxf_insert_get_dictionary_owner_soft (insert));
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, dxf_insert_get_dictionary_owner_soft (insert));
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (dxf_insert_get_dictionary_owner_hard (insert), "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", dxf_insert_get_dictionary_owner_hard (insert));
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, dxf_insert_get_dictionary_owner_hard (insert));
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbEntity\n");
+                dxf_write_string (fp, 100, "AcDbEntity");
         }
         if (dxf_insert_get_paperspace (insert) == DXF_PAPERSPACE)
         {
-                fprintf (fp->fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_int (fp, 67, DXF_PAPERSPACE);
         }
-        fprintf (fp->fp, "  8\n%s\n", dxf_insert_get_layer (insert));
+        dxf_write_string (fp, 8, dxf_insert_get_layer (insert));
         if (strcmp (dxf_insert_get_linetype (insert), DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp->fp, "  6\n%s\n", dxf_insert_get_linetype (insert));
+                dxf_write_string (fp, 6, dxf_insert_get_linetype (insert));
         }
         if ((fp->acad_version_number <= AutoCAD_11)
           && DXF_FLATLAND
           && (dxf_insert_get_elevation (insert) != 0.0))
         {
-                fprintf (fp->fp, " 38\n%f\n", dxf_insert_get_elevation (insert));
+                dxf_write_double (fp, 38, dxf_insert_get_elevation (insert));
         }
         if (dxf_insert_get_thickness (insert) != 0.0)
         {
-                fprintf (fp->fp, " 39\n%f\n", dxf_insert_get_thickness (insert));
+                dxf_write_double (fp, 39, dxf_insert_get_thickness (insert));
         }
         if (dxf_insert_get_color (insert)!= DXF_COLOR_BYLAYER)
         {
-                fprintf (fp->fp, " 62\n%d\n", dxf_insert_get_color (insert));
+                dxf_write_int (fp, 62, dxf_insert_get_color (insert));
         }
         if (dxf_insert_get_linetype_scale (insert) != 1.0)
         {
-                fprintf (fp->fp, " 48\n%f\n", dxf_insert_get_linetype_scale (insert));
+                dxf_write_double (fp, 48, dxf_insert_get_linetype_scale (insert));
         }
         if (dxf_insert_get_visibility (insert) != 0)
         {
-                fprintf (fp->fp, " 60\n%d\n", dxf_insert_get_visibility (insert));
+                dxf_write_int (fp, 60, dxf_insert_get_visibility (insert));
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbBlockReference\n");
+                dxf_write_string (fp, 100, "AcDbBlockReference");
         }
         if (dxf_insert_get_attributes_follow (insert) != 0)
         {
-                fprintf (fp->fp, " 66\n%d\n", dxf_insert_get_attributes_follow (insert));
+                dxf_write_int (fp, 66, dxf_insert_get_attributes_follow (insert));
                 /*!
                  * \todo After a set attributes_follow flag is
                  * detected, the writing of following entities should
                  * be implemented and an end of sequence
                  * marker (\c SEQEND) written. */
         }
-        fprintf (fp->fp, "  2\n%s\n", dxf_insert_get_block_name (insert));
-        fprintf (fp->fp, " 10\n%f\n", dxf_insert_get_x0 (insert));
-        fprintf (fp->fp, " 20\n%f\n", dxf_insert_get_y0 (insert));
-        fprintf (fp->fp, " 30\n%f\n", dxf_insert_get_z0 (insert));
+        dxf_write_string (fp, 2, dxf_insert_get_block_name (insert));
+        dxf_write_double (fp, 10, dxf_insert_get_x0 (insert));
+        dxf_write_double (fp, 20, dxf_insert_get_y0 (insert));
+        dxf_write_double (fp, 30, dxf_insert_get_z0 (insert));
         if (dxf_insert_get_rel_x_scale (insert) != 1.0)
         {
-                fprintf (fp->fp, " 41\n%f\n", dxf_insert_get_rel_x_scale (insert));
+                dxf_write_double (fp, 41, dxf_insert_get_rel_x_scale (insert));
         }
         if (dxf_insert_get_rel_y_scale (insert) != 1.0)
         {
-                fprintf (fp->fp, " 42\n%f\n", dxf_insert_get_rel_y_scale (insert));
+                dxf_write_double (fp, 42, dxf_insert_get_rel_y_scale (insert));
         }
         if (dxf_insert_get_rel_z_scale (insert) != 1.0)
         {
-                fprintf (fp->fp, " 43\n%f\n", dxf_insert_get_rel_z_scale (insert));
+                dxf_write_double (fp, 43, dxf_insert_get_rel_z_scale (insert));
         }
         if (dxf_insert_get_rot_angle (insert) != 0.0)
         {
-                fprintf (fp->fp, " 50\n%f\n", dxf_insert_get_rot_angle (insert));
+                dxf_write_double (fp, 50, dxf_insert_get_rot_angle (insert));
         }
         if (dxf_insert_get_columns (insert) > 1)
         {
-                fprintf (fp->fp, " 70\n%d\n", dxf_insert_get_columns (insert));
+                dxf_write_int (fp, 70, dxf_insert_get_columns (insert));
         }
         if (dxf_insert_get_rows (insert) > 1)
         {
-                fprintf (fp->fp, " 71\n%d\n", dxf_insert_get_rows (insert));
+                dxf_write_int (fp, 71, dxf_insert_get_rows (insert));
         }
         if ((dxf_insert_get_columns (insert) > 1)
           && (dxf_insert_get_column_spacing (insert) > 0.0))
         {
-                fprintf (fp->fp, " 44\n%f\n", dxf_insert_get_column_spacing (insert));
+                dxf_write_double (fp, 44, dxf_insert_get_column_spacing (insert));
         }
         if ((dxf_insert_get_rows (insert) > 1)
           && (dxf_insert_get_row_spacing (insert) > 0.0))
         {
-                fprintf (fp->fp, " 45\n%f\n", dxf_insert_get_row_spacing (insert));
+                dxf_write_double (fp, 45, dxf_insert_get_row_spacing (insert));
         }
         if (fp->acad_version_number >= AutoCAD_12)
         {
-                fprintf (fp->fp, "210\n%f\n", dxf_insert_get_extr_x0 (insert));
-                fprintf (fp->fp, "220\n%f\n", dxf_insert_get_extr_y0 (insert));
-                fprintf (fp->fp, "230\n%f\n", dxf_insert_get_extr_z0 (insert));
+                dxf_write_double (fp, 210, dxf_insert_get_extr_x0 (insert));
+                dxf_write_double (fp, 220, dxf_insert_get_extr_y0 (insert));
+                dxf_write_double (fp, 230, dxf_insert_get_extr_z0 (insert));
         }
         /* Clean up. */
-        free (dxf_entity_name);
+        dxf_free (dxf_entity_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -726,16 +662,12 @@ dxf_insert_free
                 __FUNCTION__);
               return (EXIT_FAILURE);
         }
-        free (dxf_insert_get_linetype (insert));
-        free (dxf_insert_get_layer (insert));
+        dxf_graphic_properties_free (insert->properties);
         dxf_binary_graphics_data_free_chain (dxf_insert_get_binary_graphics_data (insert));
-        free (dxf_insert_get_dictionary_owner_soft (insert));
-        free (dxf_insert_get_material (insert));
-        free (dxf_insert_get_dictionary_owner_hard (insert));
-        free (dxf_insert_get_plot_style_name (insert));
-        free (dxf_insert_get_color_name (insert));
-        free (dxf_insert_get_block_name (insert));
-        free (insert);
+        dxf_free (insert->dictionary_owner_soft);
+        dxf_free (insert->dictionary_owner_hard);
+        dxf_free (insert->block_name);
+        dxf_free (insert);
         insert = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -755,7 +687,7 @@ dxf_insert_free_chain
                 /*!< pointer to the chain of DXF \c INSERT entities. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (inserts == NULL)
@@ -781,7 +713,7 @@ dxf_insert_free_chain
  *
  * \return ID code.
  */
-int
+long
 dxf_insert_get_id_code
 (
         DxfInsert *insert
@@ -821,7 +753,7 @@ dxf_insert_set_id_code
 (
         DxfInsert *insert,
                 /*!< a pointer to a DXF \c INSERT entity. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -876,7 +808,7 @@ dxf_insert_get_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        if (insert->linetype ==  NULL)
+        if (insert->properties->linetype ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found.\n")),
@@ -886,7 +818,7 @@ dxf_insert_get_linetype
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (insert->linetype));
+        return (dxf_strdup (insert->properties->linetype));
 }
 
 
@@ -920,7 +852,12 @@ dxf_insert_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        insert->linetype = strdup (linetype);
+        if (dxf_graphic_properties_unshare (&insert->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (insert->properties->linetype);
+        insert->properties->linetype = dxf_strdup (linetype);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -951,7 +888,7 @@ dxf_insert_get_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        if (insert->layer ==  NULL)
+        if (insert->properties->layer ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found.\n")),
@@ -961,7 +898,7 @@ dxf_insert_get_layer
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (insert->layer));
+        return (dxf_strdup (insert->properties->layer));
 }
 
 
@@ -995,7 +932,12 @@ dxf_insert_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        insert->layer = strdup (layer);
+        if (dxf_graphic_properties_unshare (&insert->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (insert->properties->layer);
+        insert->properties->layer = dxf_strdup (layer);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1029,7 +971,7 @@ dxf_insert_get_elevation
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (insert->elevation);
+        return (insert->properties->elevation);
 }
 
 
@@ -1056,7 +998,11 @@ dxf_insert_set_elevation
                   __FUNCTION__);
                 return (NULL);
         }
-        insert->elevation = elevation;
+        if (dxf_graphic_properties_unshare (&insert->properties) == NULL)
+        {
+                return (NULL);
+        }
+        insert->properties->elevation = elevation;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1087,7 +1033,7 @@ dxf_insert_get_thickness
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (insert->thickness < 0.0)
+        if (insert->properties->thickness < 0.0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found.\n")),
@@ -1097,7 +1043,7 @@ dxf_insert_get_thickness
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (insert->thickness);
+        return (insert->properties->thickness);
 }
 
 
@@ -1131,7 +1077,11 @@ dxf_insert_set_thickness
                   __FUNCTION__);
                 return (NULL);
         }
-        insert->thickness = thickness;
+        if (dxf_graphic_properties_unshare (&insert->properties) == NULL)
+        {
+                return (NULL);
+        }
+        insert->properties->thickness = thickness;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1162,7 +1112,7 @@ dxf_insert_get_linetype_scale
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (insert->linetype_scale < 0.0)
+        if (insert->properties->linetype_scale < 0.0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found.\n")),
@@ -1172,7 +1122,7 @@ dxf_insert_get_linetype_scale
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (insert->linetype_scale);
+        return (insert->properties->linetype_scale);
 }
 
 
@@ -1206,7 +1156,11 @@ dxf_insert_set_linetype_scale
                   __FUNCTION__);
                 return (NULL);
         }
-        insert->linetype_scale = linetype_scale;
+        if (dxf_graphic_properties_unshare (&insert->properties) == NULL)
+        {
+                return (NULL);
+        }
+        insert->properties->linetype_scale = linetype_scale;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1237,14 +1191,14 @@ dxf_insert_get_visibility
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (insert->visibility < 0)
+        if (insert->properties->visibility < 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (insert->visibility > 1)
+        if (insert->properties->visibility > 1)
         {
                 fprintf (stderr,
                   (_("Error in %s () an out of range value was found.\n")),
@@ -1254,7 +1208,7 @@ dxf_insert_get_visibility
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (insert->visibility);
+        return (insert->properties->visibility);
 }
 
 
@@ -1295,7 +1249,11 @@ dxf_insert_set_visibility
                   __FUNCTION__);
                 return (NULL);
         }
-        insert->visibility = visibility;
+        if (dxf_graphic_properties_unshare (&insert->properties) == NULL)
+        {
+                return (NULL);
+        }
+        insert->properties->visibility = visibility;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1326,7 +1284,7 @@ dxf_insert_get_color
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (insert->color < 0)
+        if (insert->properties->color < 0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found.\n")),
@@ -1335,7 +1293,7 @@ dxf_insert_get_color
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (insert->color);
+        return (insert->properties->color);
 }
 
 
@@ -1370,7 +1328,11 @@ dxf_insert_set_color
                 fprintf (stderr,
                   (_("\teffectively turning this entity it's visibility off.\n")));
         }
-        insert->color = color;
+        if (dxf_graphic_properties_unshare (&insert->properties) == NULL)
+        {
+                return (NULL);
+        }
+        insert->properties->color = color;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1401,13 +1363,13 @@ dxf_insert_get_paperspace
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (insert->paperspace < 0)
+        if (insert->properties->paperspace < 0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found.\n")),
                   __FUNCTION__);
         }
-        if (insert->paperspace > 1)
+        if (insert->properties->paperspace > 1)
         {
                 fprintf (stderr,
                   (_("Warning in %s () an out of range value was found.\n")),
@@ -1416,7 +1378,7 @@ dxf_insert_get_paperspace
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (insert->paperspace);
+        return (insert->properties->paperspace);
 }
 
 
@@ -1457,7 +1419,11 @@ dxf_insert_set_paperspace
                   __FUNCTION__);
                 return (NULL);
         }
-        insert->paperspace = paperspace;
+        if (dxf_graphic_properties_unshare (&insert->properties) == NULL)
+        {
+                return (NULL);
+        }
+        insert->properties->paperspace = paperspace;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1582,14 +1548,14 @@ dxf_insert_get_shadow_mode
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (insert->shadow_mode < 0)
+        if (insert->properties->shadow_mode < 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (insert->shadow_mode > 3)
+        if (insert->properties->shadow_mode > 3)
         {
                 fprintf (stderr,
                   (_("Error in %s () an out of range value was found.\n")),
@@ -1599,7 +1565,7 @@ dxf_insert_get_shadow_mode
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (insert->shadow_mode);
+        return (insert->properties->shadow_mode);
 }
 
 
@@ -1643,7 +1609,11 @@ dxf_insert_set_shadow_mode
                   __FUNCTION__);
                 return (NULL);
         }
-        insert->shadow_mode = shadow_mode;
+        if (dxf_graphic_properties_unshare (&insert->properties) == NULL)
+        {
+                return (NULL);
+        }
+        insert->properties->shadow_mode = shadow_mode;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1767,7 +1737,7 @@ dxf_insert_get_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (insert->dictionary_owner_soft));
+        return (dxf_strdup (insert->dictionary_owner_soft));
 }
 
 
@@ -1803,7 +1773,7 @@ dxf_insert_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        insert->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        insert->dictionary_owner_soft = dxf_strdup (dictionary_owner_soft);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1837,7 +1807,7 @@ dxf_insert_get_material
                   __FUNCTION__);
                 return (NULL);
         }
-        if (insert->material ==  NULL)
+        if (insert->properties->material ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found.\n")),
@@ -1847,7 +1817,7 @@ dxf_insert_get_material
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (insert->material));
+        return (dxf_strdup (insert->properties->material));
 }
 
 
@@ -1885,7 +1855,12 @@ dxf_insert_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        insert->material = strdup (material);
+        if (dxf_graphic_properties_unshare (&insert->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (insert->properties->material);
+        insert->properties->material = dxf_strdup (material);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1929,7 +1904,7 @@ dxf_insert_get_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (insert->dictionary_owner_hard));
+        return (dxf_strdup (insert->dictionary_owner_hard));
 }
 
 
@@ -1965,7 +1940,7 @@ dxf_insert_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        insert->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        insert->dictionary_owner_hard = dxf_strdup (dictionary_owner_hard);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2000,7 +1975,7 @@ dxf_insert_get_lineweight
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (insert->lineweight);
+        return (insert->properties->lineweight);
 }
 
 
@@ -2030,7 +2005,11 @@ dxf_insert_set_lineweight
                   __FUNCTION__);
                 return (NULL);
         }
-        insert->lineweight = lineweight;
+        if (dxf_graphic_properties_unshare (&insert->properties) == NULL)
+        {
+                return (NULL);
+        }
+        insert->properties->lineweight = lineweight;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2062,7 +2041,7 @@ dxf_insert_get_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        if (insert->plot_style_name ==  NULL)
+        if (insert->properties->plot_style_name ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found.\n")),
@@ -2072,7 +2051,7 @@ dxf_insert_get_plot_style_name
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (insert->plot_style_name));
+        return (dxf_strdup (insert->properties->plot_style_name));
 }
 
 
@@ -2110,7 +2089,12 @@ dxf_insert_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        insert->plot_style_name = strdup (plot_style_name);
+        if (dxf_graphic_properties_unshare (&insert->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (insert->properties->plot_style_name);
+        insert->properties->plot_style_name = dxf_strdup (plot_style_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2145,7 +2129,7 @@ dxf_insert_get_color_value
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (insert->color_value);
+        return (insert->properties->color_value);
 }
 
 
@@ -2175,7 +2159,11 @@ dxf_insert_set_color_value
                   __FUNCTION__);
                 return (NULL);
         }
-        insert->color_value = color_value;
+        if (dxf_graphic_properties_unshare (&insert->properties) == NULL)
+        {
+                return (NULL);
+        }
+        insert->properties->color_value = color_value;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2207,7 +2195,7 @@ dxf_insert_get_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        if (insert->color_name ==  NULL)
+        if (insert->properties->color_name ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found.\n")),
@@ -2217,7 +2205,7 @@ dxf_insert_get_color_name
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (insert->color_name));
+        return (dxf_strdup (insert->properties->color_name));
 }
 
 
@@ -2255,7 +2243,12 @@ dxf_insert_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        insert->color_name = strdup (color_name);
+        if (dxf_graphic_properties_unshare (&insert->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (insert->properties->color_name);
+        insert->properties->color_name = dxf_strdup (color_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2290,7 +2283,7 @@ dxf_insert_get_transparency
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (insert->transparency);
+        return (insert->properties->transparency);
 }
 
 
@@ -2320,7 +2313,11 @@ dxf_insert_set_transparency
                   __FUNCTION__);
                 return (NULL);
         }
-        insert->transparency = transparency;
+        if (dxf_graphic_properties_unshare (&insert->properties) == NULL)
+        {
+                return (NULL);
+        }
+        insert->properties->transparency = transparency;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2362,7 +2359,7 @@ dxf_insert_get_block_name
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (insert->block_name));
+        return (dxf_strdup (insert->block_name));
 }
 
 
@@ -2400,7 +2397,7 @@ dxf_insert_set_block_name
                   __FUNCTION__);
                 return (NULL);
         }
-        insert->block_name = strdup (block_name);
+        insert->block_name = dxf_strdup (block_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2411,6 +2408,16 @@ dxf_insert_set_block_name
 /*!
  * \brief Get the base point \c p0 of a DXF \c INSERT entity.
  *
+ * The point is a newly allocated copy of the position kept in
+ * \c insert, to be freed with dxf_point_free ().  Changing it does not
+ * change \c insert.
+ *
+ * \deprecated Before the position was kept in \c insert itself this
+ * returned the point held by \c insert, which was freed together with it
+ * and whose changes were changes of \c insert.  Callers relying on that
+ * leak the copy and lose their changes, use
+ * dxf_insert_get_p0_vec3 () instead.
+ *
  * \return the base point \c p0.
  */
 DxfPoint *
@@ -2420,7 +2427,7 @@ dxf_insert_get_p0
                 /*!< a pointer to a DXF \c INSERT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2431,23 +2438,52 @@ dxf_insert_get_p0
                   __FUNCTION__);
                 return (NULL);
         }
-        if (insert->p0 == NULL)
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (dxf_point_new_from_vec3 (&insert->p0));
+}
+
+
+/*!
+ * \brief Get the base point \c p0 of a DXF \c INSERT entity, as kept in
+ * \c insert.
+ *
+ * Changing the position changes \c insert.
+ *
+ * \return a pointer to the position, or \c NULL when an error
+ * occurred.
+ */
+DxfVec3 *
+dxf_insert_get_p0_vec3
+(
+        DxfInsert *insert
+                /*!< a pointer to a DXF \c INSERT entity. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (insert == NULL)
         {
                 fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found.\n")),
+                  (_("Error in %s () a NULL pointer was passed.\n")),
                   __FUNCTION__);
                 return (NULL);
         }
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (insert->p0);
+        return (&insert->p0);
 }
 
 
 /*!
  * \brief Set the base point \c p0 of a DXF \c INSERT entity.
  *
+ * Only the position of \c p0 is copied, the caller keeps \c p0.
+ *
  * \return a pointer to a DXF \c INSERT entity.
  */
 DxfInsert *
@@ -2459,7 +2495,7 @@ dxf_insert_set_p0
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2477,7 +2513,9 @@ dxf_insert_set_p0
                   __FUNCTION__);
                 return (NULL);
         }
-        insert->p0 = p0;
+        insert->p0.x0 = p0->x0;
+        insert->p0.y0 = p0->y0;
+        insert->p0.z0 = p0->z0;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2498,7 +2536,7 @@ dxf_insert_get_x0
                 /*!< a pointer to a DXF \c INSERT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2510,17 +2548,10 @@ dxf_insert_get_x0
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (insert->p0 == NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found.\n")),
-                  __FUNCTION__);
-                return (EXIT_FAILURE);
-        }
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (insert->p0->x0);
+        return (insert->p0.x0);
 }
 
 
@@ -2541,7 +2572,7 @@ dxf_insert_set_x0
                  * \c INSERT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2552,14 +2583,7 @@ dxf_insert_set_x0
                   __FUNCTION__);
                 return (NULL);
         }
-        if (insert->p0 == NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found.\n")),
-                  __FUNCTION__);
-                return (NULL);
-        }
-        insert->p0->x0 = x0;
+        insert->p0.x0 = x0;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2580,7 +2604,7 @@ dxf_insert_get_y0
                 /*!< a pointer to a DXF \c INSERT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2592,17 +2616,10 @@ dxf_insert_get_y0
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (insert->p0 == NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found.\n")),
-                  __FUNCTION__);
-                return (EXIT_FAILURE);
-        }
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (insert->p0->y0);
+        return (insert->p0.y0);
 }
 
 
@@ -2623,7 +2640,7 @@ dxf_insert_set_y0
                  * \c INSERT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2634,14 +2651,7 @@ dxf_insert_set_y0
                   __FUNCTION__);
                 return (NULL);
         }
-        if (insert->p0 == NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found.\n")),
-                  __FUNCTION__);
-                return (NULL);
-        }
-        insert->p0->y0 = y0;
+        insert->p0.y0 = y0;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2662,7 +2672,7 @@ dxf_insert_get_z0
                 /*!< a pointer to a DXF \c INSERT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2674,17 +2684,10 @@ dxf_insert_get_z0
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (insert->p0 == NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found.\n")),
-                  __FUNCTION__);
-                return (EXIT_FAILURE);
-        }
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (insert->p0->z0);
+        return (insert->p0.z0);
 }
 
 
@@ -2705,7 +2708,7 @@ dxf_insert_set_z0
                  * \c INSERT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2716,14 +2719,7 @@ dxf_insert_set_z0
                   __FUNCTION__);
                 return (NULL);
         }
-        if (insert->p0 == NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found.\n")),
-                  __FUNCTION__);
-                return (NULL);
-        }
-        insert->p0->z0 = z0;
+        insert->p0.z0 = z0;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2744,7 +2740,7 @@ dxf_insert_get_rel_x_scale
                 /*!< a pointer to a DXF \c INSERT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2786,7 +2782,7 @@ dxf_insert_set_rel_x_scale
                  * \c INSERT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2824,7 +2820,7 @@ dxf_insert_get_rel_y_scale
                 /*!< a pointer to a DXF \c INSERT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2866,7 +2862,7 @@ dxf_insert_set_rel_y_scale
                  * \c INSERT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2904,7 +2900,7 @@ dxf_insert_get_rel_z_scale
                 /*!< a pointer to a DXF \c INSERT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2946,7 +2942,7 @@ dxf_insert_set_rel_z_scale
                  * \c INSERT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2984,7 +2980,7 @@ dxf_insert_get_column_spacing
                 /*!< a pointer to a DXF \c INSERT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3026,7 +3022,7 @@ dxf_insert_set_column_spacing
                  * \c INSERT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3064,7 +3060,7 @@ dxf_insert_get_row_spacing
                 /*!< a pointer to a DXF \c INSERT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3105,7 +3101,7 @@ dxf_insert_set_row_spacing
                  * \c INSERT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3143,7 +3139,7 @@ dxf_insert_get_rot_angle
                 /*!< a pointer to a DXF \c INSERT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3186,7 +3182,7 @@ dxf_insert_set_rot_angle
                  * \c INSERT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3476,7 +3472,7 @@ dxf_insert_get_extr_x0
                 /*!< a pointer to a DXF \c INSERT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3512,7 +3508,7 @@ dxf_insert_set_extr_x0
                  * DXF \c ARC entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3544,7 +3540,7 @@ dxf_insert_get_extr_y0
                 /*!< a pointer to a DXF \c INSERT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3580,7 +3576,7 @@ dxf_insert_set_extr_y0
                  * DXF \c INSERT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3612,7 +3608,7 @@ dxf_insert_get_extr_z0
                 /*!< a pointer to a DXF \c INSERT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3648,7 +3644,7 @@ dxf_insert_set_extr_z0
                  * DXF \c INSERT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -38,6 +38,8 @@
 
 
 #include "layer.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -111,16 +113,16 @@ dxf_layer_init
               return (NULL);
         }
         dxf_layer_set_id_code (layer, 0);
-        dxf_layer_set_layer_name (layer, strdup (""));
-        dxf_layer_set_linetype (layer, strdup (DXF_DEFAULT_LINETYPE));
+        dxf_layer_set_layer_name (layer, "");
+        dxf_layer_set_linetype (layer, DXF_DEFAULT_LINETYPE);
         dxf_layer_set_color (layer, DXF_COLOR_BYLAYER);
         dxf_layer_set_flag (layer, 0);
         dxf_layer_set_plotting_flag (layer, 0);
-        dxf_layer_set_dictionary_owner_soft (layer, strdup (""));
-        dxf_layer_set_material (layer, strdup (""));
-        dxf_layer_set_dictionary_owner_hard (layer, strdup (""));
+        dxf_layer_set_dictionary_owner_soft (layer, "");
+        dxf_layer_set_material (layer, "");
+        dxf_layer_set_dictionary_owner_hard (layer, "");
         dxf_layer_set_lineweight (layer, 0);
-        dxf_layer_set_plot_style_name (layer, strdup (""));
+        dxf_layer_set_plot_style_name (layer, "");
         dxf_layer_set_next (layer, NULL);
 #if DEBUG
         DXF_DEBUG_END
@@ -152,7 +154,8 @@ dxf_layer_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfPair pair;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -160,8 +163,6 @@ dxf_layer_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (layer == NULL)
@@ -172,116 +173,102 @@ dxf_layer_read
                 layer = dxf_layer_new ();
                 layer = dxf_layer_init (layer);
         }
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        fclose (fp->fp);
-                        /* Clean up. */
-                        free (temp_string);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "2") == 0)
-                {
-                        /* Now follows a string containing the layer
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", layer->layer_name);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing the linetype
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", layer->linetype);
-                }
-                else if (strcmp (temp_string, "62") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &layer->color);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else if (strcmp (temp_string, "70") == 0)
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing the
-                         * flag value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &layer->flag);
-                }
-                else if ((fp->acad_version_number >= AutoCAD_13)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if ((strcmp (temp_string, "AcDbSymbolTable") != 0)
-                        && ((strcmp (temp_string, "AcDbLayerTableRecord") != 0)))
-                        {
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                layer->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 2:
+                                /* Now follows a string containing the layer
+                                 * name. */
+                                free (layer->layer_name);
+                                layer->layer_name = dxf_pair_get_string (&pair);
+                                break;
+                        case 6:
+                                /* Now follows a string containing the linetype
+                                 * name. */
+                                free (layer->linetype);
+                                layer->linetype = dxf_pair_get_string (&pair);
+                                break;
+                        case 62:
+                                /* Now follows a string containing the
+                                 * color value. */
+                                layer->color = dxf_pair_get_int (&pair);
+                                break;
+                        case 70:
+                                /* Now follows a string containing the
+                                 * flag value. */
+                                layer->flag = dxf_pair_get_int (&pair);
+                                break;
+                        case 100:
+                                if (fp->acad_version_number >= AutoCAD_13)
+                                {
+                                        /* Now follows a string containing the
+                                         * subclass marker value. */
+                                        dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                        if ((strcmp (temp_string, "AcDbSymbolTable") != 0)
+                                        && ((strcmp (temp_string, "AcDbLayerTableRecord") != 0)))
+                                        {
+                                                fprintf (stderr,
+                                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                                  __FUNCTION__, fp->filename, fp->line_number);
+                                        }
+                                }
+                                break;
+                        case 290:
+                                /* Now follows a string containing the plotting
+                                 * flag value. */
+                                layer->plotting_flag = dxf_pair_get_int (&pair);
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner dictionary. */
+                                free (layer->dictionary_owner_soft);
+                                layer->dictionary_owner_soft = dxf_pair_get_string (&pair);
+                                break;
+                        case 347:
+                                /* Now follows a string containing the material. */
+                                free (layer->material);
+                                layer->material = dxf_pair_get_string (&pair);
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                free (layer->dictionary_owner_hard);
+                                layer->dictionary_owner_hard = dxf_pair_get_string (&pair);
+                                break;
+                        case 370:
+                                /* Now follows a string containing the
+                                 * lineweight. */
+                                layer->lineweight = dxf_pair_get_int (&pair);
+                                break;
+                        case 390:
+                                /* Now follows a string containing the plot style
+                                 * name. */
+                                free (layer->plot_style_name);
+                                layer->plot_style_name = dxf_pair_get_string (&pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, "DXF comment: %s\n", temp_string);
+                                break;
+                        default:
                                 fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
                                   __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "290") == 0)
-                {
-                        /* Now follows a string containing the plotting
-                         * flag value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &layer->plotting_flag);
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", layer->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "347") == 0)
-                {
-                        /* Now follows a string containing the material. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", layer->material);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", layer->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "370") == 0)
-                {
-                        /* Now follows a string containing the
-                         * lineweight. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &layer->lineweight);
-                }
-                else if (strcmp (temp_string, "390") == 0)
-                {
-                        /* Now follows a string containing the plot style
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", layer->plot_style_name);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
         /* Handle omitted members and/or illegal values. */
@@ -296,10 +283,9 @@ dxf_layer_read
         }
         if (strcmp (layer->linetype, "") == 0)
         {
+                free (layer->linetype);
                 layer->linetype = strdup (DXF_DEFAULT_LINETYPE);
         }
-        /* Clean up. */
-        free (temp_string);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -363,13 +349,13 @@ dxf_layer_write
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                dxf_layer_set_linetype (layer, strdup (DXF_DEFAULT_LINETYPE));
+                dxf_layer_set_linetype (layer, DXF_DEFAULT_LINETYPE);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_string (fp, 0, dxf_entity_name);
         if (layer->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", dxf_layer_get_id_code (layer));
+                dxf_write_hex (fp, 5, dxf_layer_get_id_code (layer));
         }
         /*!
          * \todo for version R14.\n
@@ -384,31 +370,31 @@ dxf_layer_write
         if ((strcmp (dxf_layer_get_dictionary_owner_soft (layer), "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", dxf_layer_get_dictionary_owner_soft (layer));
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, dxf_layer_get_dictionary_owner_soft (layer));
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_14)
         {
-                fprintf (fp->fp, "100\nAcDbSymbolTable\n");
+                dxf_write_string (fp, 100, "AcDbSymbolTable");
         }
         if (fp->acad_version_number >= AutoCAD_14)
         {
-                fprintf (fp->fp, "100\nAcDbLayerTableRecord\n");
+                dxf_write_string (fp, 100, "AcDbLayerTableRecord");
         }
-        fprintf (fp->fp, "  2\n%s\n", dxf_layer_get_layer_name (layer));
-        fprintf (fp->fp, " 70\n%d\n", dxf_layer_get_flag (layer));
-        fprintf (fp->fp, " 62\n%d\n", dxf_layer_get_color (layer));
-        fprintf (fp->fp, "  6\n%s\n", dxf_layer_get_linetype (layer));
+        dxf_write_string (fp, 2, dxf_layer_get_layer_name (layer));
+        dxf_write_int (fp, 70, dxf_layer_get_flag (layer));
+        dxf_write_int (fp, 62, dxf_layer_get_color (layer));
+        dxf_write_string (fp, 6, dxf_layer_get_linetype (layer));
         if (fp->acad_version_number >= AutoCAD_2000)
         {
-                fprintf (fp->fp, "290\n%d\n", dxf_layer_get_plotting_flag (layer));
-                fprintf (fp->fp, "370\n%hd\n", dxf_layer_get_lineweight (layer));
-                fprintf (fp->fp, "390\n%s\n", dxf_layer_get_plot_style_name (layer));
+                dxf_write_int (fp, 290, dxf_layer_get_plotting_flag (layer));
+                dxf_write_int (fp, 370, dxf_layer_get_lineweight (layer));
+                dxf_write_string (fp, 390, dxf_layer_get_plot_style_name (layer));
         }
         if (fp->acad_version_number >= AutoCAD_2007)
         {
-                fprintf (fp->fp, "347\n%s\n", dxf_layer_get_material (layer));
+                dxf_write_string (fp, 347, dxf_layer_get_material (layer));
         }
         /* Clean up. */
         free (dxf_entity_name);
@@ -444,12 +430,12 @@ dxf_layer_free
                 __FUNCTION__);
               return (EXIT_FAILURE);
         }
-        free (dxf_layer_get_layer_name (layer));
-        free (dxf_layer_get_linetype (layer));
-        free (dxf_layer_get_dictionary_owner_soft (layer));
-        free (dxf_layer_get_material (layer));
-        free (dxf_layer_get_dictionary_owner_hard (layer));
-        free (dxf_layer_get_plot_style_name (layer));
+        free (layer->layer_name);
+        free (layer->linetype);
+        free (layer->dictionary_owner_soft);
+        free (layer->material);
+        free (layer->dictionary_owner_hard);
+        free (layer->plot_style_name);
         free (layer);
         layer = NULL;
 #if DEBUG
@@ -476,7 +462,7 @@ dxf_layer_free_chain
                 /*!< pointer to the chain of DXF \c LAYER tables. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (layers == NULL)
@@ -488,6 +474,7 @@ dxf_layer_free_chain
         while (layers != NULL)
         {
                 struct DxfLayer *iter = layers->next;
+                layers->next = NULL;
                 dxf_layer_free (layers);
                 layers = (DxfLayer *) iter;
         }
@@ -502,7 +489,7 @@ dxf_layer_free_chain
  *
  * \return ID code.
  */
-int
+long
 dxf_layer_get_id_code
 (
         DxfLayer *layer
@@ -542,7 +529,7 @@ dxf_layer_set_id_code
 (
         DxfLayer *layer,
                 /*!< a pointer to a DXF \c LAYER entity. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -54,7 +54,7 @@ extern "C" {
 typedef struct
 dxf_layer_struct
 {
-        int id_code;
+        long id_code;
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file.\n
@@ -138,7 +138,7 @@ dxf_layer_free_chain
 (
         DxfLayer *layers
 );
-int
+long
 dxf_layer_get_id_code
 (
         DxfLayer *layer
@@ -147,7 +147,7 @@ DxfLayer *
 dxf_layer_set_id_code
 (
         DxfLayer *layer,
-        int id_code
+        long id_code
 );
 char *
 dxf_layer_get_layer_name
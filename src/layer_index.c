@@ -60,6 +60,9 @@
 
 
 #include "layer_index.h"
+#include "arena.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -114,8 +117,6 @@ dxf_layer_index_init
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        int i;
-
         /* Do some basic checks. */
         if (layer_index == NULL)
         {
@@ -138,11 +139,12 @@ dxf_layer_index_init
         layer_index->layer_name = (DxfLayerName *) dxf_layer_name_new ();
         layer_index->layer_name = (DxfLayerName *) dxf_layer_name_init (layer_index->layer_name);
         layer_index->layer_name->name = strdup ("");
-        for (i = 0; i < DXF_MAX_PARAM; i++)
-        {
-                layer_index->number_of_entries[i] = 0;
-                layer_index->hard_owner_reference[i] = strdup ("");
-        }
+        layer_index->number_of_entries = NULL;
+        layer_index->number_of_entries_count = 0;
+        layer_index->number_of_entries_capacity = 0;
+        layer_index->hard_owner_reference = NULL;
+        layer_index->number_of_hard_owner_references = 0;
+        layer_index->hard_owner_reference_capacity = 0;
         layer_index->next = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -174,11 +176,13 @@ dxf_layer_index_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfPair pair;
         DxfLayerName *iter;
         int i;
-        int j;
         int k;
+        int32_t *numbers_of_entries;
+        char **hard_owner_references;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -186,8 +190,6 @@ dxf_layer_index_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (fp->acad_version_number < AutoCAD_14)
@@ -205,116 +207,116 @@ dxf_layer_index_read
                 layer_index = dxf_layer_index_init (layer_index);
         }
         i = 0;
-        j = 0;
         k = 0;
         iter = (DxfLayerName *) layer_index->layer_name; /* Pointer to first entry. */
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        /* Clean up. */
-                        free (temp_string);
-                        fclose (fp->fp);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "5") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &layer_index->id_code);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                if (strcmp (temp_string, "8") == 0)
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing a layer name
-                         * (multiple entries may exist). */
-                        if (i > 0) /* Create a pointer for the next entry. */
-                        {
-                                dxf_layer_name_init ((DxfLayerName *) iter->next);
-                                iter = (DxfLayerName *) iter->next;
-                        }
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", iter->name);
-                        i++; /* Increase number of entries. */
-                }
-                if (strcmp (temp_string, "40") == 0)
-                {
-                        /* Now follows a string containing a time stamp. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &layer_index->time_stamp);
-                }
-                if (strcmp (temp_string, "90") == 0)
-                {
-                        /* Now follows a string containing a number of
-                         * entries in the LAYER_INDEX list (multiple
-                         * entries may exist). */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &layer_index->number_of_entries[j]);
-                        j++;
-                }
-                else if ((fp->acad_version_number >= AutoCAD_13)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if ((strcmp (temp_string, "AcDbIndex") != 0)
-                          && (strcmp (temp_string, "AcDbLayerIndex") != 0))
-                        {
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                layer_index->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 8:
+                                /* Now follows a string containing a layer name
+                                 * (multiple entries may exist). */
+                                if (i > 0) /* Create a pointer for the next entry. */
+                                {
+                                        dxf_layer_name_init ((DxfLayerName *) iter->next);
+                                        iter = (DxfLayerName *) iter->next;
+                                }
+                                free (iter->name);
+                                iter->name = dxf_pair_get_string (&pair);
+                                i++; /* Increase number of entries. */
+                                break;
+                        case 40:
+                                /* Now follows a string containing a time stamp. */
+                                layer_index->time_stamp = dxf_pair_get_double (&pair);
+                                break;
+                        case 90:
+                                /* Now follows a string containing a number of
+                                 * entries in the LAYER_INDEX list (multiple
+                                 * entries may exist). */
+                                numbers_of_entries = dxf_array_reserve (layer_index->number_of_entries,
+                                  layer_index->number_of_entries_count,
+                                  &layer_index->number_of_entries_capacity,
+                                  layer_index->number_of_entries_count + 1,
+                                  sizeof (int32_t));
+                                if (numbers_of_entries != NULL)
+                                {
+                                        layer_index->number_of_entries = numbers_of_entries;
+                                        layer_index->number_of_entries[layer_index->number_of_entries_count] = dxf_pair_get_int (&pair);
+                                        layer_index->number_of_entries_count++;
+                                }
+                                break;
+                        case 100:
+                                if (fp->acad_version_number >= AutoCAD_13)
+                                {
+                                        /* Now follows a string containing the
+                                         * subclass marker value. */
+                                        dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                        if ((strcmp (temp_string, "AcDbIndex") != 0)
+                                          && (strcmp (temp_string, "AcDbLayerIndex") != 0))
+                                        {
+                                                fprintf (stderr,
+                                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                                  __FUNCTION__, fp->filename, fp->line_number);
+                                        }
+                                }
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner dictionary. */
+                                free (layer_index->dictionary_owner_soft);
+                                layer_index->dictionary_owner_soft = dxf_pair_get_string (&pair);
+                                break;
+                        case 360:
+                                if (k == 0)
+                                {
+                                        /* Now follows a string containing Hard owner
+                                         * ID/handle to owner dictionary. */
+                                        free (layer_index->dictionary_owner_hard);
+                                        layer_index->dictionary_owner_hard = dxf_pair_get_string (&pair);
+                                        k++;
+                                }
+                                else if (k > 0)
+                                {
+                                        /* Now follows a string containing a Hard owner
+                                         * reference LAYER_INDEX (multiple entries may
+                                         * exist). */
+                                        hard_owner_references = dxf_array_reserve (layer_index->hard_owner_reference,
+                                          layer_index->number_of_hard_owner_references,
+                                          &layer_index->hard_owner_reference_capacity,
+                                          layer_index->number_of_hard_owner_references + 1,
+                                          sizeof (char *));
+                                        if (hard_owner_references != NULL)
+                                        {
+                                                layer_index->hard_owner_reference = hard_owner_references;
+                                                layer_index->hard_owner_reference[layer_index->number_of_hard_owner_references] = dxf_pair_get_string (&pair);
+                                                layer_index->number_of_hard_owner_references++;
+                                        }
+                                }
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, (_("DXF comment: %s\n")), temp_string);
+                                break;
+                        default:
                                 fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
                                   __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", layer_index->dictionary_owner_soft);
-                }
-                else if ((strcmp (temp_string, "360") == 0)
-                  && (k == 0))
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", layer_index->dictionary_owner_hard);
-                        k++;
-                }
-                else if ((strcmp (temp_string, "360") == 0)
-                  && (k > 0))
-                {
-                        /* Now follows a string containing a Hard owner
-                         * reference LAYER_INDEX (multiple entries may
-                         * exist). */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", layer_index->hard_owner_reference[k]);
-                        k++;
-                        /*! \todo Check for overrun of array index. */
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, (_("DXF comment: %s\n")), temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
-        /* Clean up. */
-        free (temp_string);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -366,14 +368,14 @@ dxf_layer_index_write
         if (fp->acad_version_number < AutoCAD_14)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () illegal DXF version for this %s entity with id-code: %x.\n")),
+                  (_("Warning in %s () illegal DXF version for this %s entity with id-code: %lx.\n")),
                   __FUNCTION__, dxf_entity_name, layer_index->id_code);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_string (fp, 0, dxf_entity_name);
         if (layer_index->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", layer_index->id_code);
+                dxf_write_hex (fp, 5, layer_index->id_code);
         }
         /*!
          * \todo for version R14.\n
@@ -388,37 +390,37 @@ dxf_layer_index_write
         if ((strcmp (layer_index->dictionary_owner_soft, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", layer_index->dictionary_owner_soft);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, layer_index->dictionary_owner_soft);
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (layer_index->dictionary_owner_hard, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", layer_index->dictionary_owner_hard);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, layer_index->dictionary_owner_hard);
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbIndex\n");
+                dxf_write_string (fp, 100, "AcDbIndex");
         }
-        fprintf (fp->fp, " 40\n%lf\n", layer_index->time_stamp);
+        dxf_write_double (fp, 40, layer_index->time_stamp);
         iter = (DxfLayerName *) layer_index->layer_name;
         i = 0;
         while (strlen (iter->name) > 0)
         {
-                fprintf (fp->fp, "  8\n%s\n", iter->name);
+                dxf_write_string (fp, 8, iter->name);
                 iter = (DxfLayerName *) iter->next;
                 i++;
         }
-        i = 0;
-        while (strlen (layer_index->layer_name->name) > 0)
+        for (i = 0; i < layer_index->number_of_hard_owner_references; i++)
         {
-                fprintf (fp->fp, "360\n%s\n", layer_index->hard_owner_reference[i]);
-                fprintf (fp->fp, " 90\n%d\n", layer_index->number_of_entries[i]);
-                i++;
-                /*! \todo Check for overrun of array index. */
+                dxf_write_string (fp, 360, layer_index->hard_owner_reference[i]);
+                if (i < layer_index->number_of_entries_count)
+                {
+                        dxf_write_int (fp, 90, layer_index->number_of_entries[i]);
+                }
         }
         /* Clean up. */
         free (dxf_entity_name);
@@ -460,10 +462,12 @@ dxf_layer_index_free
         free (layer_index->dictionary_owner_soft);
         free (layer_index->dictionary_owner_hard);
         dxf_layer_name_free_chain (layer_index->layer_name);
-        for (i = 0; i < DXF_MAX_PARAM; i++)
+        for (i = 0; i < layer_index->number_of_hard_owner_references; i++)
         {
                 free (layer_index->hard_owner_reference[i]);
         }
+        dxf_free (layer_index->hard_owner_reference);
+        dxf_free (layer_index->number_of_entries);
         free (layer_index);
         layer_index = NULL;
 #if DEBUG
@@ -484,7 +488,7 @@ dxf_layer_index_free_chain
                 /*!< pointer to the chain of DXF \c LAYER_INDEX objects. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (layer_indices == NULL)
@@ -510,7 +514,7 @@ dxf_layer_index_free_chain
  *
  * \return ID code.
  */
-int
+long
 dxf_layer_index_get_id_code
 (
         DxfLayerIndex *layer_index
@@ -550,7 +554,7 @@ dxf_layer_index_set_id_code
 (
         DxfLayerIndex *layer_index,
                 /*!< a pointer to a DXF \c LAYER_INDEX object. */
-        int id_code
+        long id_code
                 /*!< Identification number for the object.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
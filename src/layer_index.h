@@ -79,7 +79,7 @@ typedef struct
 dxf_layer_index_struct
 {
         /* Members common for all DXF group objects. */
-        int id_code;
+        long id_code;
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file.\n
@@ -97,14 +97,26 @@ dxf_layer_index_struct
         double time_stamp;
                 /*!< Time stamp (Julian date).\n
                  * Group code = 40. */
-        int32_t number_of_entries[DXF_MAX_PARAM];
+        int32_t *number_of_entries;
                 /*!< Number of entries in the IDBUFFER list (multiple
-                 * entries may exist).\n
+                 * entries may exist), \c number_of_entries_count
+                 * entries.\n
                  * Group code = 90. */
-        char *hard_owner_reference[DXF_MAX_PARAM];
+        int number_of_entries_count;
+                /*!< Number of entries in \c number_of_entries. */
+        int number_of_entries_capacity;
+                /*!< Number of entries \c number_of_entries has room
+                 * for. */
+        char **hard_owner_reference;
                 /*!< Hard owner reference to IDBUFFER (multiple entries
-                 * may exist).\n
+                 * may exist), \c number_of_hard_owner_references
+                 * entries.\n
                  * Group code = 360. */
+        int number_of_hard_owner_references;
+                /*!< Number of entries in \c hard_owner_reference. */
+        int hard_owner_reference_capacity;
+                /*!< Number of entries \c hard_owner_reference has room
+                 * for. */
         struct DxfLayerIndex *next;
                 /*!< Pointer to the next DxfLayerIndex.\n
                  * \c NULL in the last DxfLayerIndex. */
@@ -140,7 +152,7 @@ dxf_layer_index_free_chain
 (
         DxfLayerIndex *layer_indices
 );
-int
+long
 dxf_layer_index_get_id_code
 (
         DxfLayerIndex *layer_index
@@ -149,7 +161,7 @@ DxfLayerIndex *
 dxf_layer_index_set_id_code
 (
         DxfLayerIndex *layer_index,
-        int id_code
+        long id_code
 );
 char *
 dxf_layer_index_get_dictionary_owner_soft
@@ -167,7 +167,7 @@ dxf_layer_name_free_chain
                 /*!< pointer to the chain of DXF \c LAYER_NAME objects. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (layer_names == NULL)
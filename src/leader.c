@@ -41,6 +41,9 @@
 
 
 #include "leader.h"
+#include "arena.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -63,7 +66,7 @@ dxf_leader_new ()
         size = sizeof (DxfLeader);
         /* avoid malloc of 0 bytes */
         if (size == 0) size = 1;
-        if ((leader = malloc (size)) == NULL)
+        if ((leader = dxf_malloc (size)) == NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () could not allocate memory for a DxfArc struct.\n")),
@@ -114,17 +117,10 @@ dxf_leader_init
                 return (NULL);
         }
         leader->id_code = 0;
-        leader->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        leader->layer = strdup (DXF_DEFAULT_LAYER);
-        leader->elevation = 0.0;
-        leader->thickness = 0.0;
-        leader->linetype_scale = DXF_DEFAULT_LINETYPE_SCALE;
-        leader->visibility = DXF_DEFAULT_VISIBILITY;
-        leader->color = DXF_COLOR_BYLAYER;
-        leader->paperspace = DXF_MODELSPACE;
-        leader->dictionary_owner_soft = strdup ("");
-        leader->dictionary_owner_hard = strdup ("");
-        leader->dimension_style_name = strdup ("");
+        leader->properties = dxf_graphic_properties_default ();
+        leader->dictionary_owner_soft = dxf_strdup ("");
+        leader->dictionary_owner_hard = dxf_strdup ("");
+        leader->dimension_style_name = dxf_strdup ("");
         leader->p0 = dxf_point_new ();
         leader->p0->x0 = 0.0;
         leader->p0->y0 = 0.0;
@@ -153,7 +149,7 @@ dxf_leader_init
         leader->p3->x0 = 0.0;
         leader->p3->y0 = 0.0;
         leader->p3->z0 = 0.0;
-        leader->annotation_reference_hard = strdup ("");
+        leader->annotation_reference_hard = dxf_strdup ("");
         leader->next = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -185,7 +181,9 @@ dxf_leader_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfGraphicProperties properties;
+        DxfPair pair;
         DxfPoint *iter;
         int i;
 
@@ -195,8 +193,6 @@ dxf_leader_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (fp->acad_version_number < AutoCAD_13)
@@ -215,329 +211,261 @@ dxf_leader_read
         }
         i = 0; /* Number of found vertices. */
         iter = (DxfPoint *) leader->p0; /* Pointer to first vertex */
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        dxf_graphic_properties_start (&properties, leader->properties);
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        /* Clean up. */
-                        free (temp_string);
-                        fclose (fp->fp);
-                        return (NULL);
-                }
-                else if (strcmp (temp_string, "  3") == 0)
-                {
-                        /* Now follows a string containing additional
-                         * proprietary data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", leader->dimension_style_name);
-                }
-                if (strcmp (temp_string, "5") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &leader->id_code);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else if (strcmp (temp_string, "6") == 0)
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", leader->linetype);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", leader->layer);
-                }
-                else if ((strcmp (temp_string, "10") == 0)
-                  || (strcmp (temp_string, "20") == 0)
-                  || (strcmp (temp_string, "30") == 0))
-                {
-                        if (strcmp (temp_string, "10") == 0)
-                        {
-                                /* Now follows a string containing the X-value
-                                 * of the Vertex coordinates (one entry for each
-                                 * vertex). */
-                                if (i > 0) /* Create a pointer for the next vertex. */
+                        case 3:
+                                /* Now follows a string containing additional
+                                 * proprietary data. */
+                                dxf_free (leader->dimension_style_name);
+                                leader->dimension_style_name = dxf_pair_get_string (&pair);
+                                break;
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                leader->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 6:
+                                /* Now follows a string containing a linetype
+                                 * name. */
+                                dxf_lexer_free_string (fp, properties.linetype);
+                                properties.linetype = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 8:
+                                /* Now follows a string containing a layer name. */
+                                dxf_lexer_free_string (fp, properties.layer);
+                                properties.layer = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 10:
+                        case 20:
+                        case 30:
+                                if (strcmp (temp_string, "10") == 0)
                                 {
-                                        dxf_point_init ((DxfPoint *) iter->next);
-                                        iter = (DxfPoint *) iter->next;
+                                        /* Now follows a string containing the X-value
+                                         * of the Vertex coordinates (one entry for each
+                                         * vertex). */
+                                        if (i > 0) /* Create a pointer for the next vertex. */
+                                        {
+                                                dxf_point_init ((DxfPoint *) iter->next);
+                                                iter = (DxfPoint *) iter->next;
+                                        }
+                                        iter->x0 = dxf_pair_get_double (&pair);
                                 }
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%lf\n", &iter->x0);
-                        }
-                        else if (strcmp (temp_string, "20") == 0)
-                        {
-                                /* Now follows a string containing the Y-value
-                                 * of the Vertex coordinates (one entry for each
-                                 * vertex). */
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%lf\n", &iter->y0);
-                        }
-                        else if (strcmp (temp_string, "30") == 0)
-                        {
-                                /* Now follows a string containing the Z-value
-                                 * of the Vertex coordinates (one entry for each
-                                 * vertex). */
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%lf\n", &iter->z0);
-                                i++; /* Increase the number of found vertices. */
-                        }
-                }
-                else if ((fp->acad_version_number <= AutoCAD_11)
-                  && DXF_FLATLAND
-                  && (strcmp (temp_string, "38") == 0))
-                {
-                        /* Now follows a string containing the
-                         * elevation. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &leader->elevation);
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &leader->thickness);
-                }
-                else if (strcmp (temp_string, "40") == 0)
-                {
-                        /* Now follows a string containing the text
-                         * annotation height. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &leader->text_annotation_height);
-                }
-                else if (strcmp (temp_string, "41") == 0)
-                {
-                        /* Now follows a string containing the text
-                         * annotation width. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &leader->text_annotation_width);
-                }
-                else if (strcmp (temp_string, "48") == 0)
-                {
-                        /* Now follows a string containing the linetype
-                         * scale. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &leader->linetype_scale);
-                }
-                else if (strcmp (temp_string, "60") == 0)
-                {
-                        /* Now follows a string containing the
-                         * visibility value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &leader->visibility);
-                }
-                else if (strcmp (temp_string, "62") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &leader->color);
-                }
-                else if (strcmp (temp_string, "67") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &leader->paperspace);
-                }
-                else if (strcmp (temp_string, "71") == 0)
-                {
-                        /* Now follows a string containing the arrow
-                         * head flag. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &leader->arrow_head_flag);
-                }
-                else if (strcmp (temp_string, "72") == 0)
-                {
-                        /* Now follows a string containing the path type. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &leader->path_type);
-                }
-                else if (strcmp (temp_string, "73") == 0)
-                {
-                        /* Now follows a string containing the creation
-                         * flag. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &leader->creation_flag);
-                }
-                else if (strcmp (temp_string, "74") == 0)
-                {
-                        /* Now follows a string containing the hookline
-                         * direction flag. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &leader->hookline_direction_flag);
-                }
-                else if (strcmp (temp_string, "75") == 0)
-                {
-                        /* Now follows a string containing the hookline
-                         * flag. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &leader->hookline_flag);
-                }
-                else if (strcmp (temp_string, "76") == 0)
-                {
-                        /* Now follows a string containing the number of
-                         * vertices. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &leader->number_vertices);
-                }
-                else if (strcmp (temp_string, "77") == 0)
-                {
-                        /* Now follows a string containing the leader
-                         * color. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &leader->leader_color);
-                }
-                else if ((fp->acad_version_number >= AutoCAD_13)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "AcDbLeader") != 0)
-                        {
+                                else if (strcmp (temp_string, "20") == 0)
+                                {
+                                        /* Now follows a string containing the Y-value
+                                         * of the Vertex coordinates (one entry for each
+                                         * vertex). */
+                                        iter->y0 = dxf_pair_get_double (&pair);
+                                }
+                                else if (strcmp (temp_string, "30") == 0)
+                                {
+                                        /* Now follows a string containing the Z-value
+                                         * of the Vertex coordinates (one entry for each
+                                         * vertex). */
+                                        iter->z0 = dxf_pair_get_double (&pair);
+                                        i++; /* Increase the number of found vertices. */
+                                }
+                                break;
+                        case 38:
+                                if ((fp->acad_version_number <= AutoCAD_11)
+                                  && DXF_FLATLAND)
+                                {
+                                        /* Now follows a string containing the
+                                         * elevation. */
+                                        properties.elevation = dxf_pair_get_double (&pair);
+                                }
+                                break;
+                        case 39:
+                                /* Now follows a string containing the
+                                 * thickness. */
+                                properties.thickness = dxf_pair_get_double (&pair);
+                                break;
+                        case 40:
+                                /* Now follows a string containing the text
+                                 * annotation height. */
+                                leader->text_annotation_height = dxf_pair_get_double (&pair);
+                                break;
+                        case 41:
+                                /* Now follows a string containing the text
+                                 * annotation width. */
+                                leader->text_annotation_width = dxf_pair_get_double (&pair);
+                                break;
+                        case 48:
+                                /* Now follows a string containing the linetype
+                                 * scale. */
+                                properties.linetype_scale = dxf_pair_get_double (&pair);
+                                break;
+                        case 60:
+                                /* Now follows a string containing the
+                                 * visibility value. */
+                                properties.visibility = dxf_pair_get_int (&pair);
+                                break;
+                        case 62:
+                                /* Now follows a string containing the
+                                 * color value. */
+                                properties.color = dxf_pair_get_int (&pair);
+                                break;
+                        case 67:
+                                /* Now follows a string containing the
+                                 * paperspace value. */
+                                properties.paperspace = dxf_pair_get_int (&pair);
+                                break;
+                        case 71:
+                                /* Now follows a string containing the arrow
+                                 * head flag. */
+                                leader->arrow_head_flag = dxf_pair_get_int (&pair);
+                                break;
+                        case 72:
+                                /* Now follows a string containing the path type. */
+                                leader->path_type = dxf_pair_get_int (&pair);
+                                break;
+                        case 73:
+                                /* Now follows a string containing the creation
+                                 * flag. */
+                                leader->creation_flag = dxf_pair_get_int (&pair);
+                                break;
+                        case 74:
+                                /* Now follows a string containing the hookline
+                                 * direction flag. */
+                                leader->hookline_direction_flag = dxf_pair_get_int (&pair);
+                                break;
+                        case 75:
+                                /* Now follows a string containing the hookline
+                                 * flag. */
+                                leader->hookline_flag = dxf_pair_get_int (&pair);
+                                break;
+                        case 76:
+                                /* Now follows a string containing the number of
+                                 * vertices. */
+                                leader->number_vertices = dxf_pair_get_int (&pair);
+                                break;
+                        case 77:
+                                /* Now follows a string containing the leader
+                                 * color. */
+                                leader->leader_color = dxf_pair_get_int (&pair);
+                                break;
+                        case 100:
+                                if (fp->acad_version_number >= AutoCAD_13)
+                                {
+                                        /* Now follows a string containing the
+                                         * subclass marker value. */
+                                        dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                        if (strcmp (temp_string, "AcDbLeader") != 0)
+                                        {
+                                                fprintf (stderr,
+                                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                                  __FUNCTION__, fp->filename, fp->line_number);
+                                        }
+                                }
+                                break;
+                        case 210:
+                                /* Now follows a string containing the
+                                 * X-value of the extrusion vector. */
+                                leader->extr_x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 220:
+                                /* Now follows a string containing the
+                                 * Y-value of the extrusion vector. */
+                                leader->extr_y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 230:
+                                /* Now follows a string containing the
+                                 * Z-value of the extrusion vector. */
+                                leader->extr_z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 211:
+                                /* Now follows a string containing the
+                                 * X-value of the "Horizontal" direction for
+                                 * leader. */
+                                leader->p1->x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 221:
+                                /* Now follows a string containing the
+                                 * Y-value of the "Horizontal" direction for
+                                 * leader. */
+                                leader->p1->y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 231:
+                                /* Now follows a string containing the
+                                 * Z-value of the "Horizontal" direction for
+                                 * leader. */
+                                leader->p1->z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 212:
+                                /* Now follows a string containing the
+                                 * X-value of the Block reference insertion
+                                 * point offset from last leader vertex. */
+                                leader->p2->x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 222:
+                                /* Now follows a string containing the
+                                 * Y-value of the Block reference insertion
+                                 * point offset from last leader vertex. */
+                                leader->p2->y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 232:
+                                /* Now follows a string containing the
+                                 * Z-value of the Block reference insertion
+                                 * point offset from last leader vertex. */
+                                leader->p2->z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 213:
+                                /* Now follows a string containing the
+                                 * X-value of the Annotation placement point
+                                 * offset from last leader vertex. */
+                                leader->p3->x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 223:
+                                /* Now follows a string containing the
+                                 * Y-value of the Annotation placement point
+                                 * offset from last leader vertex. */
+                                leader->p3->y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 233:
+                                /* Now follows a string containing the
+                                 * Z-value of the Annotation placement point
+                                 * offset from last leader vertex. */
+                                leader->p3->z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, leader->dictionary_owner_soft);
+                                leader->dictionary_owner_soft = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 340:
+                                /* Now follows a string containing Hard
+                                 * reference to associated annotation (mtext,
+                                 * tolerance, or insert entity). */
+                                dxf_free (leader->annotation_reference_hard);
+                                leader->annotation_reference_hard = dxf_pair_get_string (&pair);
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, leader->dictionary_owner_hard);
+                                leader->dictionary_owner_hard = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, (_("DXF comment: %s\n")), temp_string);
+                                break;
+                        default:
                                 fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
                                   __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "210") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &leader->extr_x0);
-                }
-                else if (strcmp (temp_string, "220") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &leader->extr_y0);
-                }
-                else if (strcmp (temp_string, "230") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &leader->extr_z0);
-                }
-                else if (strcmp (temp_string, "211") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the "Horizontal" direction for
-                         * leader. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &leader->p1->x0);
-                }
-                else if (strcmp (temp_string, "221") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the "Horizontal" direction for
-                         * leader. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &leader->p1->y0);
-                }
-                else if (strcmp (temp_string, "231") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the "Horizontal" direction for
-                         * leader. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &leader->p1->z0);
-                }
-                else if (strcmp (temp_string, "212") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the Block reference insertion
-                         * point offset from last leader vertex. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &leader->p2->x0);
-                }
-                else if (strcmp (temp_string, "222") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the Block reference insertion
-                         * point offset from last leader vertex. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &leader->p2->y0);
-                }
-                else if (strcmp (temp_string, "232") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the Block reference insertion
-                         * point offset from last leader vertex. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &leader->p2->z0);
-                }
-                else if (strcmp (temp_string, "213") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the Annotation placement point
-                         * offset from last leader vertex. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &leader->p3->x0);
-                }
-                else if (strcmp (temp_string, "223") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the Annotation placement point
-                         * offset from last leader vertex. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &leader->p3->y0);
-                }
-                else if (strcmp (temp_string, "233") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the Annotation placement point
-                         * offset from last leader vertex. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &leader->p3->z0);
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", leader->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "340") == 0)
-                {
-                        /* Now follows a string containing Hard
-                         * reference to associated annotation (mtext,
-                         * tolerance, or insert entity). */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", leader->annotation_reference_hard);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", leader->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, (_("DXF comment: %s\n")), temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
         if (i != leader->number_vertices)
@@ -547,16 +475,20 @@ dxf_leader_read
                   __FUNCTION__);
         }
         /* Handle omitted members and/or illegal values. */
-        if (strcmp (leader->linetype, "") == 0)
+        if ((properties.linetype != NULL)
+          && (strcmp (properties.linetype, "") == 0))
         {
-                leader->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_lexer_free_string (fp, properties.linetype);
+                properties.linetype = dxf_strdup (DXF_DEFAULT_LINETYPE);
         }
-        if (strcmp (leader->layer, "") == 0)
+        if ((properties.layer != NULL)
+          && (strcmp (properties.layer, "") == 0))
         {
-                leader->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_lexer_free_string (fp, properties.layer);
+                properties.layer = dxf_strdup (DXF_DEFAULT_LAYER);
         }
-        /* Clean up. */
-        free (temp_string);
+        /* Entities with equal properties share a record. */
+        dxf_graphic_properties_finish (fp, &leader->properties, &properties);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -582,7 +514,7 @@ dxf_leader_write
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *dxf_entity_name = strdup ("LEADER");
+        char *dxf_entity_name = dxf_strdup ("LEADER");
         int i;
         DxfPoint *iter;
 
@@ -593,7 +525,7 @@ dxf_leader_write
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (leader == NULL)
@@ -602,7 +534,7 @@ dxf_leader_write
                   (_("Error in %s () a NULL pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (leader->p0 == NULL)
@@ -611,40 +543,40 @@ dxf_leader_write
                   (_("Error in %s () a NULL pointer was found.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (fp->acad_version_number < AutoCAD_13)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () illegal DXF version for this %s entity with id-code: %x.\n")),
+                  (_("Warning in %s () illegal DXF version for this %s entity with id-code: %lx.\n")),
                   __FUNCTION__, dxf_entity_name, leader->id_code);
         }
-        if (strcmp (leader->linetype, "") == 0)
+        if (strcmp (leader->properties->linetype, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, leader->id_code);
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                leader->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_leader_set_linetype (leader, DXF_DEFAULT_LINETYPE);
         }
-        if (strcmp (leader->layer, "") == 0)
+        if (strcmp (leader->properties->layer, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty layer string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty layer string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, leader->id_code);
                 fprintf (stderr,
                   (_("\t%s entity is relocated to layer 0")),
                   dxf_entity_name);
-                leader->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_leader_set_layer (leader, DXF_DEFAULT_LAYER);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_string (fp, 0, dxf_entity_name);
         if (leader->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", leader->id_code);
+                dxf_write_hex (fp, 5, leader->id_code);
         }
         /*!
          * \todo for version R14.\n
@@ -659,72 +591,72 @@ dxf_leader_write
         if ((strcmp (leader->dictionary_owner_soft, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", leader->dictionary_owner_soft);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, leader->dictionary_owner_soft);
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (leader->dictionary_owner_hard, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", leader->dictionary_owner_hard);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, leader->dictionary_owner_hard);
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbEntity\n");
+                dxf_write_string (fp, 100, "AcDbEntity");
         }
-        if (leader->paperspace == DXF_PAPERSPACE)
+        if (leader->properties->paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp->fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_int (fp, 67, DXF_PAPERSPACE);
         }
-        fprintf (fp->fp, "  8\n%s\n", leader->layer);
-        if (strcmp (leader->linetype, DXF_DEFAULT_LINETYPE) != 0)
+        dxf_write_string (fp, 8, leader->properties->layer);
+        if (strcmp (leader->properties->linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp->fp, "  6\n%s\n", leader->linetype);
+                dxf_write_string (fp, 6, leader->properties->linetype);
         }
-        if (leader->color != DXF_COLOR_BYLAYER)
+        if (leader->properties->color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp->fp, " 62\n%d\n", leader->color);
+                dxf_write_int (fp, 62, leader->properties->color);
         }
         if ((fp->acad_version_number <= AutoCAD_11)
           && DXF_FLATLAND
-          && (leader->elevation != 0.0))
+          && (leader->properties->elevation != 0.0))
         {
-                fprintf (fp->fp, " 38\n%f\n", leader->elevation);
+                dxf_write_double (fp, 38, leader->properties->elevation);
         }
-        if (leader->thickness != 0.0)
+        if (leader->properties->thickness != 0.0)
         {
-                fprintf (fp->fp, " 39\n%f\n", leader->thickness);
+                dxf_write_double (fp, 39, leader->properties->thickness);
         }
-        if (leader->linetype_scale != 1.0)
+        if (leader->properties->linetype_scale != 1.0)
         {
-                fprintf (fp->fp, " 48\n%f\n", leader->linetype_scale);
+                dxf_write_double (fp, 48, leader->properties->linetype_scale);
         }
-        if (leader->visibility != 0)
+        if (leader->properties->visibility != 0)
         {
-                fprintf (fp->fp, " 60\n%d\n", leader->visibility);
+                dxf_write_int (fp, 60, leader->properties->visibility);
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbLeader\n");
-        }
-        fprintf (fp->fp, "  3\n%s\n", leader->dimension_style_name);
-        fprintf (fp->fp, " 71\n%d\n", leader->arrow_head_flag);
-        fprintf (fp->fp, " 72\n%d\n", leader->path_type);
-        fprintf (fp->fp, " 73\n%d\n", leader->creation_flag);
-        fprintf (fp->fp, " 74\n%d\n", leader->hookline_direction_flag);
-        fprintf (fp->fp, " 75\n%d\n", leader->hookline_flag);
-        fprintf (fp->fp, " 40\n%f\n", leader->text_annotation_height);
-        fprintf (fp->fp, " 41\n%f\n", leader->text_annotation_width);
-        fprintf (fp->fp, " 76\n%d\n", leader->number_vertices);
+                dxf_write_string (fp, 100, "AcDbLeader");
+        }
+        dxf_write_string (fp, 3, leader->dimension_style_name);
+        dxf_write_int (fp, 71, leader->arrow_head_flag);
+        dxf_write_int (fp, 72, leader->path_type);
+        dxf_write_int (fp, 73, leader->creation_flag);
+        dxf_write_int (fp, 74, leader->hookline_direction_flag);
+        dxf_write_int (fp, 75, leader->hookline_flag);
+        dxf_write_double (fp, 40, leader->text_annotation_height);
+        dxf_write_double (fp, 41, leader->text_annotation_width);
+        dxf_write_int (fp, 76, leader->number_vertices);
         iter = (DxfPoint *) leader->p0;
         i = 1;
         while (iter->next != NULL)
         {
-                fprintf (fp->fp, " 10\n%f\n", iter->x0);
-                fprintf (fp->fp, " 20\n%f\n", iter->y0);
-                fprintf (fp->fp, " 30\n%f\n", iter->z0);
+                dxf_write_double (fp, 10, iter->x0);
+                dxf_write_double (fp, 20, iter->y0);
+                dxf_write_double (fp, 30, iter->z0);
                 iter = (DxfPoint *) iter->next;
                 i++;
         }
@@ -734,25 +666,25 @@ dxf_leader_write
                   (_("Warning in %s () actual number of vertices differs from number_vertices value in struct.\n")),
                   __FUNCTION__);
         }
-        fprintf (fp->fp, " 77\n%d\n", leader->leader_color);
-        fprintf (fp->fp, "340\n%s\n", leader->annotation_reference_hard);
-        fprintf (fp->fp, "210\n%f\n", leader->extr_x0);
-        fprintf (fp->fp, "220\n%f\n", leader->extr_y0);
-        fprintf (fp->fp, "230\n%f\n", leader->extr_z0);
-        fprintf (fp->fp, "211\n%f\n", leader->p1->x0);
-        fprintf (fp->fp, "221\n%f\n", leader->p1->y0);
-        fprintf (fp->fp, "231\n%f\n", leader->p1->z0);
-        fprintf (fp->fp, "212\n%f\n", leader->p2->x0);
-        fprintf (fp->fp, "222\n%f\n", leader->p2->y0);
-        fprintf (fp->fp, "232\n%f\n", leader->p2->z0);
-        fprintf (fp->fp, "213\n%f\n", leader->p3->x0);
-        fprintf (fp->fp, "223\n%f\n", leader->p3->y0);
-        fprintf (fp->fp, "233\n%f\n", leader->p3->z0);
+        dxf_write_int (fp, 77, leader->leader_color);
+        dxf_write_string (fp, 340, leader->annotation_reference_hard);
+        dxf_write_double (fp, 210, leader->extr_x0);
+        dxf_write_double (fp, 220, leader->extr_y0);
+        dxf_write_double (fp, 230, leader->extr_z0);
+        dxf_write_double (fp, 211, leader->p1->x0);
+        dxf_write_double (fp, 221, leader->p1->y0);
+        dxf_write_double (fp, 231, leader->p1->z0);
+        dxf_write_double (fp, 212, leader->p2->x0);
+        dxf_write_double (fp, 222, leader->p2->y0);
+        dxf_write_double (fp, 232, leader->p2->z0);
+        dxf_write_double (fp, 213, leader->p3->x0);
+        dxf_write_double (fp, 223, leader->p3->y0);
+        dxf_write_double (fp, 233, leader->p3->z0);
         /*! \todo Xdata belonging to the application ID "ACAD" may
          * follow.\n This describes any dimension overrides that have
          * been applied to this entity. */
         /* Clean up. */
-        free (dxf_entity_name);
+        dxf_free (dxf_entity_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -786,13 +718,12 @@ dxf_leader_free
                 __FUNCTION__);
               return (EXIT_FAILURE);
         }
-        free (leader->linetype);
-        free (leader->layer);
-        free (leader->dictionary_owner_soft);
-        free (leader->dictionary_owner_hard);
-        free (leader->dimension_style_name);
-        free (leader->annotation_reference_hard);
-        free (leader);
+        dxf_graphic_properties_free (leader->properties);
+        dxf_free (leader->dictionary_owner_soft);
+        dxf_free (leader->dictionary_owner_hard);
+        dxf_free (leader->dimension_style_name);
+        dxf_free (leader->annotation_reference_hard);
+        dxf_free (leader);
         leader = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -812,7 +743,7 @@ dxf_leader_free_chain
                 /*!< pointer to the chain of DXF \c LEADER entities. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (leaders == NULL)
@@ -838,7 +769,7 @@ dxf_leader_free_chain
  *
  * \return ID code.
  */
-int
+long
 dxf_leader_get_id_code
 (
         DxfLeader *leader
@@ -878,7 +809,7 @@ dxf_leader_set_id_code
 (
         DxfLeader *leader,
                 /*!< a pointer to a DXF \c LEADER entity. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -933,7 +864,7 @@ dxf_leader_get_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        if (leader->linetype ==  NULL)
+        if (leader->properties->linetype ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found.\n")),
@@ -943,7 +874,7 @@ dxf_leader_get_linetype
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (leader->linetype));
+        return (dxf_strdup (leader->properties->linetype));
 }
 
 
@@ -977,7 +908,12 @@ dxf_leader_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        leader->linetype = strdup (linetype);
+        if (dxf_graphic_properties_unshare (&leader->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (leader->properties->linetype);
+        leader->properties->linetype = dxf_strdup (linetype);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1008,7 +944,7 @@ dxf_leader_get_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        if (leader->layer ==  NULL)
+        if (leader->properties->layer ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found.\n")),
@@ -1018,7 +954,7 @@ dxf_leader_get_layer
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (leader->layer));
+        return (dxf_strdup (leader->properties->layer));
 }
 
 
@@ -1052,7 +988,12 @@ dxf_leader_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        leader->layer = strdup (layer);
+        if (dxf_graphic_properties_unshare (&leader->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (leader->properties->layer);
+        leader->properties->layer = dxf_strdup (layer);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1086,7 +1027,7 @@ dxf_leader_get_elevation
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (leader->elevation);
+        return (leader->properties->elevation);
 }
 
 
@@ -1113,7 +1054,11 @@ dxf_leader_set_elevation
                   __FUNCTION__);
                 return (NULL);
         }
-        leader->elevation = elevation;
+        if (dxf_graphic_properties_unshare (&leader->properties) == NULL)
+        {
+                return (NULL);
+        }
+        leader->properties->elevation = elevation;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1144,7 +1089,7 @@ dxf_leader_get_thickness
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (leader->thickness < 0.0)
+        if (leader->properties->thickness < 0.0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found.\n")),
@@ -1154,7 +1099,7 @@ dxf_leader_get_thickness
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (leader->thickness);
+        return (leader->properties->thickness);
 }
 
 
@@ -1188,7 +1133,11 @@ dxf_leader_set_thickness
                   __FUNCTION__);
                 return (NULL);
         }
-        leader->thickness = thickness;
+        if (dxf_graphic_properties_unshare (&leader->properties) == NULL)
+        {
+                return (NULL);
+        }
+        leader->properties->thickness = thickness;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1219,7 +1168,7 @@ dxf_leader_get_linetype_scale
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (leader->linetype_scale < 0.0)
+        if (leader->properties->linetype_scale < 0.0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found.\n")),
@@ -1229,7 +1178,7 @@ dxf_leader_get_linetype_scale
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (leader->linetype_scale);
+        return (leader->properties->linetype_scale);
 }
 
 
@@ -1263,7 +1212,11 @@ dxf_leader_set_linetype_scale
                   __FUNCTION__);
                 return (NULL);
         }
-        leader->linetype_scale = linetype_scale;
+        if (dxf_graphic_properties_unshare (&leader->properties) == NULL)
+        {
+                return (NULL);
+        }
+        leader->properties->linetype_scale = linetype_scale;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1294,14 +1247,14 @@ dxf_leader_get_visibility
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (leader->visibility < 0)
+        if (leader->properties->visibility < 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (leader->visibility > 1)
+        if (leader->properties->visibility > 1)
         {
                 fprintf (stderr,
                   (_("Error in %s () an out of range value was found.\n")),
@@ -1311,7 +1264,7 @@ dxf_leader_get_visibility
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (leader->visibility);
+        return (leader->properties->visibility);
 }
 
 
@@ -1352,7 +1305,11 @@ dxf_leader_set_visibility
                   __FUNCTION__);
                 return (NULL);
         }
-        leader->visibility = visibility;
+        if (dxf_graphic_properties_unshare (&leader->properties) == NULL)
+        {
+                return (NULL);
+        }
+        leader->properties->visibility = visibility;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1383,7 +1340,7 @@ dxf_leader_get_color
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (leader->color < 0)
+        if (leader->properties->color < 0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found.\n")),
@@ -1392,7 +1349,7 @@ dxf_leader_get_color
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (leader->color);
+        return (leader->properties->color);
 }
 
 
@@ -1425,7 +1382,11 @@ dxf_leader_set_color
                   (_("Warning in %s () a negative value was passed.\n")),
                   __FUNCTION__);
         }
-        leader->color = color;
+        if (dxf_graphic_properties_unshare (&leader->properties) == NULL)
+        {
+                return (NULL);
+        }
+        leader->properties->color = color;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1456,13 +1417,13 @@ dxf_leader_get_paperspace
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (leader->paperspace < 0)
+        if (leader->properties->paperspace < 0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found.\n")),
                   __FUNCTION__);
         }
-        if (leader->paperspace > 1)
+        if (leader->properties->paperspace > 1)
         {
                 fprintf (stderr,
                   (_("Warning in %s () an out of range value was found.\n")),
@@ -1471,7 +1432,7 @@ dxf_leader_get_paperspace
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (leader->paperspace);
+        return (leader->properties->paperspace);
 }
 
 
@@ -1512,7 +1473,11 @@ dxf_leader_set_paperspace
                   __FUNCTION__);
                 return (NULL);
         }
-        leader->paperspace = paperspace;
+        if (dxf_graphic_properties_unshare (&leader->properties) == NULL)
+        {
+                return (NULL);
+        }
+        leader->properties->paperspace = paperspace;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1556,7 +1521,7 @@ dxf_leader_get_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (leader->dictionary_owner_soft));
+        return (dxf_strdup (leader->dictionary_owner_soft));
 }
 
 
@@ -1592,7 +1557,7 @@ dxf_leader_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        leader->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        leader->dictionary_owner_soft = dxf_strdup (dictionary_owner_soft);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1636,7 +1601,7 @@ dxf_leader_get_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (leader->dictionary_owner_hard));
+        return (dxf_strdup (leader->dictionary_owner_hard));
 }
 
 
@@ -1672,7 +1637,7 @@ dxf_leader_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        leader->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        leader->dictionary_owner_hard = dxf_strdup (dictionary_owner_hard);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1714,7 +1679,7 @@ dxf_leader_get_dimension_style_name
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (leader->dimension_style_name));
+        return (dxf_strdup (leader->dimension_style_name));
 }
 
 
@@ -1749,7 +1714,7 @@ dxf_leader_set_dimension_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        leader->layer = strdup (dimension_style_name);
+        dxf_leader_set_layer (leader, dimension_style_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1769,7 +1734,7 @@ dxf_leader_get_p0
                 /*!< a pointer to a DXF \c LEADER entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -1808,7 +1773,7 @@ dxf_leader_set_p0
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -1847,7 +1812,7 @@ dxf_leader_get_x0
                 /*!< a pointer to a DXF \c LEADER entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -1890,7 +1855,7 @@ dxf_leader_set_x0
                  * DXF \c LEADER entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -1929,7 +1894,7 @@ dxf_leader_get_y0
                 /*!< a pointer to a DXF \c LEADER entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -1972,7 +1937,7 @@ dxf_leader_set_y0
                  * DXF \c LEADER entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2011,7 +1976,7 @@ dxf_leader_get_z0
                 /*!< a pointer to a DXF \c LEADER entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2054,7 +2019,7 @@ dxf_leader_set_z0
                  * DXF \c LEADER entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2092,7 +2057,7 @@ dxf_leader_get_text_annotation_height
                 /*!< a pointer to a DXF \c LEADER entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2133,7 +2098,7 @@ dxf_leader_set_text_annotation_height
                  * entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2170,7 +2135,7 @@ dxf_leader_get_text_annotation_width
                 /*!< a pointer to a DXF \c LEADER entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2211,7 +2176,7 @@ dxf_leader_set_text_annotation_width
                  * entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2842,7 +2807,7 @@ dxf_leader_get_extr_x0
                 /*!< a pointer to a DXF \c LEADER entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2878,7 +2843,7 @@ dxf_leader_set_extr_x0
                  * DXF \c LEADER entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2910,7 +2875,7 @@ dxf_leader_get_extr_y0
                 /*!< a pointer to a DXF \c LEADER entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2946,7 +2911,7 @@ dxf_leader_set_extr_y0
                  * DXF \c LEADER entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2978,7 +2943,7 @@ dxf_leader_get_extr_z0
                 /*!< a pointer to a DXF \c LEADER entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3014,7 +2979,7 @@ dxf_leader_set_extr_z0
                  * DXF \c LEADER entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3046,7 +3011,7 @@ dxf_leader_get_p1
                 /*!< a pointer to a DXF \c LEADER entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3086,7 +3051,7 @@ dxf_leader_set_p1
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3125,7 +3090,7 @@ dxf_leader_get_x1
                 /*!< a pointer to a DXF \c LEADER entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3168,7 +3133,7 @@ dxf_leader_set_x1
                  * leader \c x1 of a DXF \c LEADER entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3207,7 +3172,7 @@ dxf_leader_get_y1
                 /*!< a pointer to a DXF \c LEADER entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3250,7 +3215,7 @@ dxf_leader_set_y1
                  * leader \c y1 of a DXF \c LEADER entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3289,7 +3254,7 @@ dxf_leader_get_z1
                 /*!< a pointer to a DXF \c LEADER entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3332,7 +3297,7 @@ dxf_leader_set_z1
                  * leader \c z1 of a DXF \c LEADER entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3371,7 +3336,7 @@ dxf_leader_get_p2
                 /*!< a pointer to a DXF \c LEADER entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3411,7 +3376,7 @@ dxf_leader_set_p2
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3451,7 +3416,7 @@ dxf_leader_get_x2
                 /*!< a pointer to a DXF \c LEADER entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3495,7 +3460,7 @@ dxf_leader_set_x2
                  * \c LEADER entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3535,7 +3500,7 @@ dxf_leader_get_y2
                 /*!< a pointer to a DXF \c LEADER entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3579,7 +3544,7 @@ dxf_leader_set_y2
                  * \c LEADER entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3619,7 +3584,7 @@ dxf_leader_get_z2
                 /*!< a pointer to a DXF \c LEADER entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3663,7 +3628,7 @@ dxf_leader_set_z2
                  * \c LEADER entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3702,7 +3667,7 @@ dxf_leader_get_p3
                 /*!< a pointer to a DXF \c LEADER entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3742,7 +3707,7 @@ dxf_leader_set_p3
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3782,7 +3747,7 @@ dxf_leader_get_x3
                 /*!< a pointer to a DXF \c LEADER entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3826,7 +3791,7 @@ dxf_leader_set_x3
                  * \c LEADER entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3866,7 +3831,7 @@ dxf_leader_get_y3
                 /*!< a pointer to a DXF \c LEADER entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3910,7 +3875,7 @@ dxf_leader_set_y3
                  * \c LEADER entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3950,7 +3915,7 @@ dxf_leader_get_z3
                 /*!< a pointer to a DXF \c LEADER entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3994,7 +3959,7 @@ dxf_leader_set_z3
                  * \c LEADER entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -4056,7 +4021,7 @@ dxf_leader_get_annotation_reference_hard
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (leader->annotation_reference_hard));
+        return (dxf_strdup (leader->annotation_reference_hard));
 }
 
 
@@ -4092,7 +4057,7 @@ dxf_leader_set_annotation_reference_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        leader->annotation_reference_hard = strdup (annotation_reference_hard);
+        leader->annotation_reference_hard = dxf_strdup (annotation_reference_hard);
 #if DEBUG
         DXF_DEBUG_END
 #endif
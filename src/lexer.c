@@ -0,0 +1,1207 @@
+/*!
+ * \file lexer.c
+ *
+ * \author Copyright (C) 2017 by the libDXF developers.
+ *
+ * \brief Group code lexer for DXF files.
+ *
+ * The lexer splits the contents of a DXF file into group code / value
+ * pairs.\n
+ * The group code is returned as an integer, so entity readers can
+ * dispatch on it with a \c switch instead of comparing strings.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#include "lexer.h"
+#include "arena.h"
+#include "number.h"
+#include "string_pool.h"
+
+
+#define UNK DXF_GROUP_CODE_TYPE_UNKNOWN
+#define STR DXF_GROUP_CODE_TYPE_STRING
+#define HDL DXF_GROUP_CODE_TYPE_HANDLE
+#define BIN DXF_GROUP_CODE_TYPE_BINARY
+#define DBL DXF_GROUP_CODE_TYPE_DOUBLE
+#define I16 DXF_GROUP_CODE_TYPE_INT16
+#define I32 DXF_GROUP_CODE_TYPE_INT32
+#define I64 DXF_GROUP_CODE_TYPE_INT64
+#define BOO DXF_GROUP_CODE_TYPE_BOOL
+
+/*!
+ * \brief Value type for every group code, indexed by group code.
+ *
+ * According to the "Group Code Value Types" table of the DXF reference.
+ */
+const unsigned char dxf_group_code_types[DXF_MAX_GROUP_CODE + 1] =
+{
+        /*    0 */ STR, STR, STR, STR, STR, HDL, STR, STR, STR, STR,
+        /*   10 */ DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL,
+        /*   20 */ DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL,
+        /*   30 */ DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL,
+        /*   40 */ DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL,
+        /*   50 */ DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL,
+        /*   60 */ I16, I16, I16, I16, I16, I16, I16, I16, I16, I16,
+        /*   70 */ I16, I16, I16, I16, I16, I16, I16, I16, I16, I16,
+        /*   80 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*   90 */ I32, I32, I32, I32, I32, I32, I32, I32, I32, I32,
+        /*  100 */ STR, STR, STR, UNK, UNK, HDL, UNK, UNK, UNK, UNK,
+        /*  110 */ DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL,
+        /*  120 */ DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL,
+        /*  130 */ DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL,
+        /*  140 */ DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL,
+        /*  150 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  160 */ I64, I64, I64, I64, I64, I64, I64, I64, I64, I64,
+        /*  170 */ I16, I16, I16, I16, I16, I16, I16, I16, I16, I16,
+        /*  180 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  190 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  200 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  210 */ DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL,
+        /*  220 */ DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL,
+        /*  230 */ DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL,
+        /*  240 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  250 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  260 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  270 */ I16, I16, I16, I16, I16, I16, I16, I16, I16, I16,
+        /*  280 */ I16, I16, I16, I16, I16, I16, I16, I16, I16, I16,
+        /*  290 */ BOO, BOO, BOO, BOO, BOO, BOO, BOO, BOO, BOO, BOO,
+        /*  300 */ STR, STR, STR, STR, STR, STR, STR, STR, STR, STR,
+        /*  310 */ BIN, BIN, BIN, BIN, BIN, BIN, BIN, BIN, BIN, BIN,
+        /*  320 */ HDL, HDL, HDL, HDL, HDL, HDL, HDL, HDL, HDL, HDL,
+        /*  330 */ HDL, HDL, HDL, HDL, HDL, HDL, HDL, HDL, HDL, HDL,
+        /*  340 */ HDL, HDL, HDL, HDL, HDL, HDL, HDL, HDL, HDL, HDL,
+        /*  350 */ HDL, HDL, HDL, HDL, HDL, HDL, HDL, HDL, HDL, HDL,
+        /*  360 */ HDL, HDL, HDL, HDL, HDL, HDL, HDL, HDL, HDL, HDL,
+        /*  370 */ I16, I16, I16, I16, I16, I16, I16, I16, I16, I16,
+        /*  380 */ I16, I16, I16, I16, I16, I16, I16, I16, I16, I16,
+        /*  390 */ HDL, HDL, HDL, HDL, HDL, HDL, HDL, HDL, HDL, HDL,
+        /*  400 */ I16, I16, I16, I16, I16, I16, I16, I16, I16, I16,
+        /*  410 */ STR, STR, STR, STR, STR, STR, STR, STR, STR, STR,
+        /*  420 */ I32, I32, I32, I32, I32, I32, I32, I32, I32, I32,
+        /*  430 */ STR, STR, STR, STR, STR, STR, STR, STR, STR, STR,
+        /*  440 */ I32, I32, I32, I32, I32, I32, I32, I32, I32, I32,
+        /*  450 */ I32, I32, I32, I32, I32, I32, I32, I32, I32, I32,
+        /*  460 */ DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL,
+        /*  470 */ STR, STR, STR, STR, STR, STR, STR, STR, STR, STR,
+        /*  480 */ HDL, HDL, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  490 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  500 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  510 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  520 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  530 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  540 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  550 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  560 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  570 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  580 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  590 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  600 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  610 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  620 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  630 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  640 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  650 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  660 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  670 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  680 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  690 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  700 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  710 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  720 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  730 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  740 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  750 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  760 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  770 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  780 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  790 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  800 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  810 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  820 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  830 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  840 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  850 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  860 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  870 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  880 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  890 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  900 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  910 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  920 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  930 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  940 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  950 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  960 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  970 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  980 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK,
+        /*  990 */ UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, UNK, STR,
+        /* 1000 */ STR, STR, STR, STR, BIN, HDL, STR, STR, STR, STR,
+        /* 1010 */ DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL,
+        /* 1020 */ DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL,
+        /* 1030 */ DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL,
+        /* 1040 */ DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL,
+        /* 1050 */ DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL, DBL,
+        /* 1060 */ I16, I16, I16, I16, I16, I16, I16, I16, I16, I16,
+        /* 1070 */ I16, I32
+};
+
+#undef UNK
+#undef STR
+#undef HDL
+#undef BIN
+#undef DBL
+#undef I16
+#undef I32
+#undef I64
+#undef BOO
+
+
+/*!
+ * \brief Get the value type for a group code.
+ *
+ * \return the value type, or \c DXF_GROUP_CODE_TYPE_UNKNOWN for a group
+ * code out of range.
+ */
+DxfGroupCodeType
+dxf_lexer_group_code_type
+(
+        int group_code
+                /*!< group code. */
+)
+{
+        if ((group_code < 0) || (group_code > DXF_MAX_GROUP_CODE))
+        {
+                return (DXF_GROUP_CODE_TYPE_UNKNOWN);
+        }
+        return ((DxfGroupCodeType) dxf_group_code_types[group_code]);
+}
+
+
+/*!
+ * \brief Parse the group code in \c line.
+ *
+ * Leading and trailing white space is allowed, as group codes are right
+ * aligned in a field of three characters.
+ *
+ * \return \c TRUE when a valid group code was found, \c FALSE otherwise.
+ */
+static int
+dxf_lexer_parse_group_code
+(
+        const char *line,
+                /*!< start of the line. */
+        size_t length,
+                /*!< length of the line. */
+        int *group_code
+                /*!< the parsed group code. */
+)
+{
+        const char *end = line + length;
+        int negative = FALSE;
+        int result = 0;
+        int digits = 0;
+
+        while ((line < end) && ((*line == ' ') || (*line == '\t')))
+        {
+                line++;
+        }
+        if ((line < end) && (*line == '-'))
+        {
+                negative = TRUE;
+                line++;
+        }
+        while ((line < end) && ((unsigned) (*line - '0') < 10))
+        {
+                result = (result * 10) + (*line - '0');
+                line++;
+                digits++;
+        }
+        while ((line < end) && ((*line == ' ') || (*line == '\t')))
+        {
+                line++;
+        }
+        if ((digits == 0) || (digits > 9) || (line != end))
+        {
+                return (FALSE);
+        }
+        *group_code = negative ? -result : result;
+        return (TRUE);
+}
+
+
+/*!
+ * \brief Find the end of the line starting at \c start in a memory
+ * mapped file.
+ *
+ * \return a pointer past the line terminator, and the length of the line
+ * without the terminator in \c length.
+ */
+static const char *
+dxf_lexer_scan_line
+(
+        const char *start,
+                /*!< start of the line. */
+        const char *end,
+                /*!< end of the mapping. */
+        size_t *length
+                /*!< length of the line without the terminator. */
+)
+{
+        const char *eol;
+
+        eol = memchr (start, '\n', (size_t) (end - start));
+        if (eol == NULL)
+        {
+                eol = end;
+        }
+        *length = (size_t) (eol - start);
+        if ((*length > 0) && (start[*length - 1] == '\r'))
+        {
+                (*length)--;
+        }
+        return ((eol < end) ? eol + 1 : end);
+}
+
+
+/*!
+ * \brief Read a line through stdio into the line buffer of \c fp.
+ *
+ * \return the length of the line without the terminator, or -1 at the
+ * end of the file.
+ */
+static ssize_t
+dxf_lexer_getline
+(
+        DxfFile *fp
+                /*!< DXF file handle of input file (or device). */
+)
+{
+        ssize_t length;
+
+        length = getline (&fp->line_buffer, &fp->line_buffer_size, fp->fp);
+        if (length < 0)
+        {
+                return (-1);
+        }
+        if ((length > 0) && (fp->line_buffer[length - 1] == '\n'))
+        {
+                length--;
+        }
+        if ((length > 0) && (fp->line_buffer[length - 1] == '\r'))
+        {
+                length--;
+        }
+        fp->line_buffer[length] = '\0';
+        fp->line_number++;
+        return (length);
+}
+
+
+/*!
+ * \brief Get \c n bytes from a binary DXF file.
+ *
+ * For a memory mapped file \c data points into the mapping at
+ * \c cursor, otherwise the bytes are read into the line buffer of
+ * \c fp.
+ *
+ * \return \c TRUE when the bytes were available, \c FALSE otherwise.
+ */
+static int
+dxf_lexer_binary_bytes
+(
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
+        const char **cursor,
+                /*!< read position in the mapping. */
+        size_t n,
+                /*!< number of bytes. */
+        const char **data
+                /*!< the bytes. */
+)
+{
+        char *buffer;
+
+        if (fp->buffer != NULL)
+        {
+                if ((size_t) (fp->buffer + fp->buffer_size - *cursor) < n)
+                {
+                        return (FALSE);
+                }
+                *data = *cursor;
+                *cursor += n;
+                return (TRUE);
+        }
+        if (fp->line_buffer_size < n + 1)
+        {
+                buffer = realloc (fp->line_buffer, n + 1);
+                if (buffer == NULL)
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () could not allocate memory.\n")),
+                          __FUNCTION__);
+                        return (FALSE);
+                }
+                fp->line_buffer = buffer;
+                fp->line_buffer_size = n + 1;
+        }
+        if (fread (fp->line_buffer, 1, n, fp->fp) != n)
+        {
+                return (FALSE);
+        }
+        fp->line_buffer[n] = '\0';
+        *data = fp->line_buffer;
+        return (TRUE);
+}
+
+
+/*!
+ * \brief Get a \c NUL terminated string from a binary DXF file.
+ *
+ * \return \c TRUE when a string was read, \c FALSE otherwise.
+ */
+static int
+dxf_lexer_binary_string
+(
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
+        const char **cursor,
+                /*!< read position in the mapping. */
+        DxfSlice *value
+                /*!< the string, without the terminator. */
+)
+{
+        const char *nul;
+        ssize_t n;
+
+        if (fp->buffer != NULL)
+        {
+                nul = memchr (*cursor, '\0',
+                  (size_t) (fp->buffer + fp->buffer_size - *cursor));
+                if (nul == NULL)
+                {
+                        return (FALSE);
+                }
+                value->data = *cursor;
+                value->length = (size_t) (nul - *cursor);
+                *cursor = nul + 1;
+                return (TRUE);
+        }
+        n = getdelim (&fp->line_buffer, &fp->line_buffer_size, '\0', fp->fp);
+        if (n <= 0)
+        {
+                return (FALSE);
+        }
+        if (fp->line_buffer[n - 1] == '\0')
+        {
+                n--;
+        }
+        value->data = fp->line_buffer;
+        value->length = (size_t) n;
+        return (TRUE);
+}
+
+
+/*!
+ * \brief Read a group of binary data (group codes 310 ... 319 and
+ * 1004) and convert it to hexadecimal text, as found in an ASCII DXF
+ * file.
+ *
+ * \return \c TRUE when the data was read, \c FALSE otherwise.
+ */
+static int
+dxf_lexer_binary_chunk
+(
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
+        const char **cursor,
+                /*!< read position in the mapping. */
+        DxfSlice *value
+                /*!< the hexadecimal text. */
+)
+{
+        static const char hex[] = "0123456789ABCDEF";
+        const char *data;
+        char *buffer;
+        size_t length;
+        size_t i;
+
+        if (!dxf_lexer_binary_bytes (fp, cursor, 1, &data))
+        {
+                return (FALSE);
+        }
+        length = (unsigned char) data[0];
+        if (!dxf_lexer_binary_bytes (fp, cursor, length, &data))
+        {
+                return (FALSE);
+        }
+        if (fp->line_buffer_size < (2 * length) + 1)
+        {
+                /* The data may live in the line buffer itself, so
+                 * allocate a new one. */
+                buffer = malloc ((2 * length) + 1);
+                if (buffer == NULL)
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () could not allocate memory.\n")),
+                          __FUNCTION__);
+                        return (FALSE);
+                }
+                memcpy (buffer, data, length);
+                free (fp->line_buffer);
+                fp->line_buffer = buffer;
+                fp->line_buffer_size = (2 * length) + 1;
+                data = buffer;
+        }
+        else if (data != fp->line_buffer)
+        {
+                memcpy (fp->line_buffer, data, length);
+        }
+        /* Expand from the end, so the data is not overwritten before it
+         * is used. */
+        fp->line_buffer[2 * length] = '\0';
+        for (i = length; i > 0; i--)
+        {
+                unsigned char c = (unsigned char) fp->line_buffer[i - 1];
+
+                fp->line_buffer[(2 * i) - 1] = hex[c & 0x0f];
+                fp->line_buffer[(2 * i) - 2] = hex[c >> 4];
+        }
+        value->data = fp->line_buffer;
+        value->length = 2 * length;
+        return (TRUE);
+}
+
+
+/*!
+ * \brief Read the next group code / value pair from a binary DXF file.
+ *
+ * Strings are returned as text, numbers are returned as their raw
+ * little endian bytes with \c pair->binary set.
+ *
+ * \return 1 when a pair was read, \c EOF at the end of the file or when
+ * an error occurred.
+ */
+static int
+dxf_lexer_read_binary_pair
+(
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
+        DxfPair *pair
+                /*!< the pair read. */
+)
+{
+        const char *cursor = NULL;
+        const char *data;
+        int result = FALSE;
+
+        if (fp->buffer != NULL)
+        {
+                if (fp->position >= fp->buffer_size)
+                {
+                        return (EOF);
+                }
+                cursor = fp->buffer + fp->position;
+        }
+        /* Group codes are 1 byte (2 bytes since R14), in the 1 byte form
+         * the value 255 is followed by a 2 byte extended data group
+         * code. */
+        if (!dxf_lexer_binary_bytes (fp, &cursor, (size_t) fp->binary, &data))
+        {
+                return (EOF);
+        }
+        if (fp->binary == 1)
+        {
+                pair->group_code = (unsigned char) data[0];
+                if (pair->group_code == 255)
+                {
+                        if (!dxf_lexer_binary_bytes (fp, &cursor, 2, &data))
+                        {
+                                return (EOF);
+                        }
+                        pair->group_code = (unsigned char) data[0]
+                          | ((unsigned char) data[1] << 8);
+                }
+        }
+        else
+        {
+                pair->group_code = (int) (int16_t) ((unsigned char) data[0]
+                  | ((unsigned char) data[1] << 8));
+        }
+        pair->binary = TRUE;
+        switch (dxf_lexer_group_code_type (pair->group_code))
+        {
+                case DXF_GROUP_CODE_TYPE_DOUBLE:
+                        pair->value.length = 8;
+                        break;
+                case DXF_GROUP_CODE_TYPE_INT16:
+                        pair->value.length = 2;
+                        break;
+                case DXF_GROUP_CODE_TYPE_INT32:
+                        pair->value.length = 4;
+                        break;
+                case DXF_GROUP_CODE_TYPE_INT64:
+                        pair->value.length = 8;
+                        break;
+                case DXF_GROUP_CODE_TYPE_BOOL:
+                        pair->value.length = 1;
+                        break;
+                case DXF_GROUP_CODE_TYPE_BINARY:
+                        pair->binary = FALSE;
+                        result = dxf_lexer_binary_chunk (fp, &cursor, &pair->value);
+                        break;
+                default:
+                        pair->binary = FALSE;
+                        result = dxf_lexer_binary_string (fp, &cursor, &pair->value);
+                        break;
+        }
+        if (pair->binary)
+        {
+                result = dxf_lexer_binary_bytes (fp, &cursor, pair->value.length, &pair->value.data);
+        }
+        if (!result)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () unexpected end of file while reading from: %s.\n")),
+                  __FUNCTION__, fp->filename);
+                return (EOF);
+        }
+        /* Count a pair as two lines, as in an ASCII DXF file. */
+        fp->line_number += 2;
+        if (fp->buffer != NULL)
+        {
+                fp->position = (size_t) (cursor - fp->buffer);
+        }
+        return (1);
+}
+
+
+/*!
+ * \brief Detect a binary DXF file.
+ *
+ * A binary DXF file starts with the sentinel
+ * "AutoCAD Binary DXF<CR><LF><SUB><NUL>".\n
+ * When found, the sentinel is skipped and \c fp->binary is set to the
+ * size of the group codes in the file, which is found from the first
+ * group (0, "SECTION", or a 999 comment).\n
+ * Otherwise the read position of \c fp is left unchanged.
+ *
+ * \return \c TRUE for a binary DXF file, \c FALSE otherwise.
+ */
+int
+dxf_lexer_detect_binary
+(
+        DxfFile *fp
+                /*!< DXF file handle of input file (or device). */
+)
+{
+        char head[DXF_BINARY_SENTINEL_LENGTH + 2];
+        long pos = 0;
+        size_t n;
+
+        if (fp->buffer != NULL)
+        {
+                n = fp->buffer_size - fp->position;
+                if (n > sizeof (head))
+                {
+                        n = sizeof (head);
+                }
+                memcpy (head, fp->buffer + fp->position, n);
+        }
+        else
+        {
+                pos = ftell (fp->fp);
+                if (pos < 0)
+                {
+                        return (FALSE);
+                }
+                n = fread (head, 1, sizeof (head), fp->fp);
+        }
+        if ((n < sizeof (head))
+          || (memcmp (head, DXF_BINARY_SENTINEL, DXF_BINARY_SENTINEL_LENGTH) != 0))
+        {
+                if (fp->buffer == NULL)
+                {
+                        fseek (fp->fp, pos, SEEK_SET);
+                }
+                return (FALSE);
+        }
+        /* A 1 byte group code 0 is followed by the 'S' of "SECTION",
+         * a 1 byte group code 999 takes the extended form starting
+         * with 255.  Anything else, such as a second NUL byte, is a 2
+         * byte group code. */
+        fp->binary = (((head[DXF_BINARY_SENTINEL_LENGTH] == '\0')
+          && (head[DXF_BINARY_SENTINEL_LENGTH + 1] != '\0'))
+          || ((unsigned char) head[DXF_BINARY_SENTINEL_LENGTH] == 255)) ? 1 : 2;
+        if (fp->buffer != NULL)
+        {
+                fp->position += DXF_BINARY_SENTINEL_LENGTH;
+        }
+        else
+        {
+                fseek (fp->fp, pos + DXF_BINARY_SENTINEL_LENGTH, SEEK_SET);
+        }
+        return (TRUE);
+}
+
+
+/*!
+ * \brief Decode the raw bytes of a number read from a binary DXF file
+ * as a signed integer.
+ */
+static int64_t
+dxf_lexer_binary_integer
+(
+        DxfPair *pair
+                /*!< the pair. */
+)
+{
+        const unsigned char *s = (const unsigned char *) pair->value.data;
+        uint64_t result = 0;
+        size_t i;
+
+        for (i = pair->value.length; i > 0; i--)
+        {
+                result = (result << 8) | s[i - 1];
+        }
+        switch (pair->value.length)
+        {
+                case 2:
+                        return ((int16_t) result);
+                case 4:
+                        return ((int32_t) result);
+                default:
+                        return ((int64_t) result);
+        }
+}
+
+
+/*!
+ * \brief Decode the raw bytes of a number read from a binary DXF file
+ * as a double.
+ */
+static double
+dxf_lexer_binary_double
+(
+        DxfPair *pair
+                /*!< the pair. */
+)
+{
+        uint64_t bits;
+        double result;
+
+        if (dxf_lexer_group_code_type (pair->group_code) != DXF_GROUP_CODE_TYPE_DOUBLE)
+        {
+                return ((double) dxf_lexer_binary_integer (pair));
+        }
+        bits = (uint64_t) dxf_lexer_binary_integer (pair);
+        memcpy (&result, &bits, sizeof (result));
+        return (result);
+}
+
+
+/*!
+ * \brief Format a number read from a binary DXF file as text, for
+ * readers which keep the value as a string.
+ *
+ * \return the length of the text.
+ */
+static size_t
+dxf_lexer_binary_format
+(
+        DxfPair *pair,
+                /*!< the pair. */
+        char *text,
+                /*!< the text. */
+        size_t size
+                /*!< size of \c text. */
+)
+{
+        int n;
+
+        if (dxf_lexer_group_code_type (pair->group_code) == DXF_GROUP_CODE_TYPE_DOUBLE)
+        {
+                n = snprintf (text, size, "%.17g", dxf_lexer_binary_double (pair));
+        }
+        else
+        {
+                n = snprintf (text, size, "%" PRId64, dxf_lexer_binary_integer (pair));
+        }
+        if (n < 0)
+        {
+                n = 0;
+        }
+        return (((size_t) n < size) ? (size_t) n : size - 1);
+}
+
+
+/*!
+ * \brief Read the next group code / value pair from a DXF file.
+ *
+ * For a memory mapped file (see dxf_read_init_mmap ()) the value points
+ * straight into the mapping, otherwise it points into a line buffer
+ * owned by \c fp, which is overwritten by the next read.\n
+ * Leading blanks of an ASCII value are skipped, as the fscanf () based
+ * readers did.\n
+ * Binary DXF files (see dxf_lexer_detect_binary ()) are decoded into the
+ * same pairs, so entity readers work on both formats.
+ *
+ * \return 1 when a pair was read, \c EOF at the end of the file or when
+ * an error occurred.
+ */
+int
+dxf_lexer_read_pair
+(
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
+        DxfPair *pair
+                /*!< the pair read. */
+)
+{
+        size_t length;
+
+        if (fp->pair_pending)
+        {
+                fp->pair_pending = FALSE;
+                *pair = fp->pair;
+                return (1);
+        }
+        if (fp->binary)
+        {
+                if (dxf_lexer_read_binary_pair (fp, pair) != 1)
+                {
+                        return (EOF);
+                }
+                fp->pair = *pair;
+                return (1);
+        }
+        pair->binary = FALSE;
+        if (fp->buffer != NULL)
+        {
+                const char *start;
+                const char *end = fp->buffer + fp->buffer_size;
+                const char *next;
+
+                if (fp->position >= fp->buffer_size)
+                {
+                        return (EOF);
+                }
+                start = fp->buffer + fp->position;
+                next = dxf_lexer_scan_line (start, end, &length);
+                fp->line_number++;
+                if (!dxf_lexer_parse_group_code (start, length, &pair->group_code))
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () invalid group code while reading from: %s in line: %d.\n")),
+                          __FUNCTION__, fp->filename, fp->line_number);
+                        return (EOF);
+                }
+                pair->value.data = next;
+                next = dxf_lexer_scan_line (next, end, &pair->value.length);
+                fp->line_number++;
+                fp->position = (size_t) (next - fp->buffer);
+        }
+        else
+        {
+                ssize_t n;
+
+                n = dxf_lexer_getline (fp);
+                if (n < 0)
+                {
+                        if (ferror (fp->fp))
+                        {
+                                fprintf (stderr,
+                                  (_("Error in %s () while reading from: %s in line: %d.\n")),
+                                  __FUNCTION__, fp->filename, fp->line_number);
+                        }
+                        return (EOF);
+                }
+                if (!dxf_lexer_parse_group_code (fp->line_buffer, (size_t) n, &pair->group_code))
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () invalid group code while reading from: %s in line: %d.\n")),
+                          __FUNCTION__, fp->filename, fp->line_number);
+                        return (EOF);
+                }
+                n = dxf_lexer_getline (fp);
+                if (n < 0)
+                {
+                        n = 0;
+                        fp->line_buffer[0] = '\0';
+                }
+                pair->value.data = fp->line_buffer;
+                pair->value.length = (size_t) n;
+        }
+        while ((pair->value.length > 0)
+          && ((*pair->value.data == ' ') || (*pair->value.data == '\t')))
+        {
+                pair->value.data++;
+                pair->value.length--;
+        }
+        fp->pair = *pair;
+        return (1);
+}
+
+
+/*!
+ * \brief Push back the last pair read, so that it is returned once more
+ * by the next call to dxf_lexer_read_pair ().
+ *
+ * Entity readers use this to leave the group code 0 pair, which starts
+ * the next entity, for their caller.
+ */
+void
+dxf_lexer_unread_pair
+(
+        DxfFile *fp
+                /*!< DXF file handle of input file (or device). */
+)
+{
+        fp->pair_pending = TRUE;
+}
+
+
+/*!
+ * \brief Save the read position of \c fp, so reading can return to it
+ * with dxf_lexer_restore_position () after looking ahead.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when a pair is
+ * pending or the stream of \c fp can not seek (a pipe).
+ */
+int
+dxf_lexer_save_position
+(
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
+        DxfLexerPosition *position
+                /*!< the saved position. */
+)
+{
+        if (fp->pair_pending)
+        {
+                return (EXIT_FAILURE);
+        }
+        position->position = fp->position;
+        position->line_number = fp->line_number;
+        position->offset = 0;
+        if (fp->buffer == NULL)
+        {
+                position->offset = ftell (fp->fp);
+                if (position->offset < 0)
+                {
+                        return (EXIT_FAILURE);
+                }
+        }
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Return to a read position saved with
+ * dxf_lexer_save_position ().
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_lexer_restore_position
+(
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
+        DxfLexerPosition *position
+                /*!< the saved position. */
+)
+{
+        fp->pair_pending = FALSE;
+        fp->position = position->position;
+        fp->line_number = position->line_number;
+        if ((fp->buffer == NULL)
+          && (fseek (fp->fp, position->offset, SEEK_SET) != 0))
+        {
+                return (EXIT_FAILURE);
+        }
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Get the value of a pair as a double.
+ *
+ * \return the value, or 0.0 when the value is not a number.
+ */
+double
+dxf_pair_get_double
+(
+        DxfPair *pair
+                /*!< the pair. */
+)
+{
+        double result;
+
+        if (pair->binary)
+        {
+                return (dxf_lexer_binary_double (pair));
+        }
+        dxf_number_parse_double (pair->value.data, pair->value.length, &result);
+        return (result);
+}
+
+
+/*!
+ * \brief Get the value of a pair as an int.
+ *
+ * \return the value, or 0 when the value is not a number.
+ */
+int
+dxf_pair_get_int
+(
+        DxfPair *pair
+                /*!< the pair. */
+)
+{
+        return ((int) dxf_pair_get_long (pair));
+}
+
+
+/*!
+ * \brief Get the value of a pair as a long.
+ *
+ * \return the value, or 0 when the value is not a number, or
+ * \c LONG_MIN or \c LONG_MAX when it is out of range.
+ */
+long
+dxf_pair_get_long
+(
+        DxfPair *pair
+                /*!< the pair. */
+)
+{
+        long result;
+
+        if (pair->binary)
+        {
+                if (dxf_lexer_group_code_type (pair->group_code) == DXF_GROUP_CODE_TYPE_DOUBLE)
+                {
+                        return ((long) dxf_lexer_binary_double (pair));
+                }
+                return ((long) dxf_lexer_binary_integer (pair));
+        }
+        if ((dxf_number_parse_long (pair->value.data, pair->value.length, &result) == 0)
+          && (result != 0))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () value out of range for group code: %d.\n")),
+                  __FUNCTION__, pair->group_code);
+        }
+        return (result);
+}
+
+
+/*!
+ * \brief Get the value of a pair as a hexadecimal number (handle).
+ *
+ * \return the value, or 0 when the value is not a number, or
+ * \c ULONG_MAX when it is out of range.
+ */
+unsigned long
+dxf_pair_get_hex
+(
+        DxfPair *pair
+                /*!< the pair. */
+)
+{
+        unsigned long result;
+
+        if (pair->binary)
+        {
+                return ((unsigned long) dxf_lexer_binary_integer (pair));
+        }
+        if ((dxf_number_parse_hex (pair->value.data, pair->value.length, &result) == 0)
+          && (result != 0))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () value out of range for group code: %d.\n")),
+                  __FUNCTION__, pair->group_code);
+        }
+        return (result);
+}
+
+
+/*!
+ * \brief Get a copy of the value of a pair as a string.
+ *
+ * \return a pointer to a newly allocated string, to be freed by the
+ * caller, or \c NULL when no memory could be allocated.
+ */
+char *
+dxf_pair_get_string
+(
+        DxfPair *pair
+                /*!< the pair. */
+)
+{
+        char *result;
+        char text[32];
+
+        if (pair->binary)
+        {
+                dxf_lexer_binary_format (pair, text, sizeof (text));
+                return (dxf_strdup (text));
+        }
+        result = dxf_malloc (pair->value.length + 1);
+        if (result == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory for a string.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        memcpy (result, pair->value.data, pair->value.length);
+        result[pair->value.length] = '\0';
+        return (result);
+}
+
+
+/*!
+ * \brief Get the value of a pair as a string from the string pool of
+ * \c fp.
+ *
+ * Without a pool this is dxf_pair_get_string ().  A string from the pool
+ * is shared and must be released with dxf_lexer_free_string ().
+ *
+ * \return the string, or \c NULL when no memory could be allocated.
+ */
+char *
+dxf_pair_intern_string
+(
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
+        DxfPair *pair
+                /*!< the pair. */
+)
+{
+        char text[32];
+
+        if (fp->strings == NULL)
+        {
+                return (dxf_pair_get_string (pair));
+        }
+        if (pair->binary)
+        {
+                dxf_lexer_binary_format (pair, text, sizeof (text));
+                return (dxf_string_pool_intern (fp->strings, text));
+        }
+        return (dxf_string_pool_intern_n (fp->strings, pair->value.data,
+          pair->value.length));
+}
+
+
+/*!
+ * \brief Free \c string unless it is shared in the string pool of
+ * \c fp.
+ */
+void
+dxf_lexer_free_string
+(
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
+        char *string
+                /*!< the string, or \c NULL. */
+)
+{
+        if ((fp->strings == NULL)
+          || (!dxf_string_pool_owns (fp->strings, string)))
+        {
+                dxf_free (string);
+        }
+}
+
+
+/*!
+ * \brief Copy the value of a pair into \c dest.
+ *
+ * At most \c size - 1 characters are copied, \c dest is always
+ * terminated with a \c NUL character.
+ *
+ * \return \c dest.
+ */
+char *
+dxf_pair_copy_string
+(
+        DxfPair *pair,
+                /*!< the pair. */
+        char *dest,
+                /*!< the destination buffer. */
+        size_t size
+                /*!< size of the destination buffer. */
+)
+{
+        size_t length = pair->value.length;
+
+        if (pair->binary)
+        {
+                dxf_lexer_binary_format (pair, dest, size);
+                return (dest);
+        }
+        if (length >= size)
+        {
+                length = size - 1;
+        }
+        memcpy (dest, pair->value.data, length);
+        dest[length] = '\0';
+        return (dest);
+}
+
+
+/*!
+ * \brief Compare the value of a pair with a string.
+ *
+ * \return \c TRUE when the value equals \c value, \c FALSE otherwise.
+ */
+int
+dxf_pair_value_is
+(
+        DxfPair *pair,
+                /*!< the pair. */
+        const char *value
+                /*!< the string to compare with. */
+)
+{
+        size_t length = strlen (value);
+        char text[32];
+
+        if (pair->binary)
+        {
+                dxf_lexer_binary_format (pair, text, sizeof (text));
+                return (strcmp (text, value) == 0);
+        }
+        return ((pair->value.length == length)
+          && (memcmp (pair->value.data, value, length) == 0));
+}
+
+
+/* EOF */
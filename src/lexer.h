@@ -0,0 +1,186 @@
+/*!
+ * \file lexer.h
+ *
+ * \author Copyright (C) 2017 by the libDXF developers.
+ *
+ * \brief Group code lexer for DXF files, header file.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#ifndef LIBDXF_SRC_LEXER_H
+#define LIBDXF_SRC_LEXER_H
+
+
+#include "global.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define DXF_MAX_GROUP_CODE 1071
+        /*!< \brief The highest group code defined in DXF. */
+#define DXF_BINARY_SENTINEL "AutoCAD Binary DXF\r\n\032"
+        /*!< \brief Start of a binary DXF file. */
+#define DXF_BINARY_SENTINEL_LENGTH 22
+        /*!< \brief Length of the binary DXF sentinel, including the
+         * terminating \c NUL byte. */
+
+
+/*!
+ * \brief Value types of DXF group codes.
+ */
+typedef enum
+dxf_group_code_type
+{
+        DXF_GROUP_CODE_TYPE_UNKNOWN = 0,
+        DXF_GROUP_CODE_TYPE_STRING,
+        DXF_GROUP_CODE_TYPE_HANDLE,
+        DXF_GROUP_CODE_TYPE_BINARY,
+        DXF_GROUP_CODE_TYPE_DOUBLE,
+        DXF_GROUP_CODE_TYPE_INT16,
+        DXF_GROUP_CODE_TYPE_INT32,
+        DXF_GROUP_CODE_TYPE_INT64,
+        DXF_GROUP_CODE_TYPE_BOOL
+} DxfGroupCodeType;
+
+
+/*!
+ * \brief A read position saved by dxf_lexer_save_position ().
+ */
+typedef struct
+dxf_lexer_position_struct
+{
+        size_t position;
+                /*!< Read position in the mapping of a memory mapped
+                 * file. */
+        long offset;
+                /*!< Offset in the stream of any other file. */
+        int line_number;
+                /*!< Line number at the position. */
+} DxfLexerPosition;
+
+
+extern const unsigned char dxf_group_code_types[DXF_MAX_GROUP_CODE + 1];
+
+
+DxfGroupCodeType
+dxf_lexer_group_code_type
+(
+        int group_code
+);
+int
+dxf_lexer_read_pair
+(
+        DxfFile *fp,
+        DxfPair *pair
+);
+int
+dxf_lexer_detect_binary
+(
+        DxfFile *fp
+);
+void
+dxf_lexer_unread_pair
+(
+        DxfFile *fp
+);
+int
+dxf_lexer_save_position
+(
+        DxfFile *fp,
+        DxfLexerPosition *position
+);
+int
+dxf_lexer_restore_position
+(
+        DxfFile *fp,
+        DxfLexerPosition *position
+);
+double
+dxf_pair_get_double
+(
+        DxfPair *pair
+);
+int
+dxf_pair_get_int
+(
+        DxfPair *pair
+);
+long
+dxf_pair_get_long
+(
+        DxfPair *pair
+);
+unsigned long
+dxf_pair_get_hex
+(
+        DxfPair *pair
+);
+char *
+dxf_pair_get_string
+(
+        DxfPair *pair
+);
+char *
+dxf_pair_intern_string
+(
+        DxfFile *fp,
+        DxfPair *pair
+);
+void
+dxf_lexer_free_string
+(
+        DxfFile *fp,
+        char *string
+);
+char *
+dxf_pair_copy_string
+(
+        DxfPair *pair,
+        char *dest,
+        size_t size
+);
+int
+dxf_pair_value_is
+(
+        DxfPair *pair,
+        const char *value
+);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* LIBDXF_SRC_LEXER_H */
+
+
+/* EOF */
@@ -40,6 +40,9 @@
 
 
 #include "line.h"
+#include "arena.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -62,7 +65,7 @@ dxf_line_new ()
         size = sizeof (DxfLine);
         /* avoid malloc of 0 bytes */
         if (size == 0) size = 1;
-        if ((line = malloc (size)) == NULL)
+        if ((line = dxf_malloc (size)) == NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () could not allocate memory for a DxfLine struct.\n")),
@@ -113,32 +116,14 @@ dxf_line_init
               return (NULL);
         }
         dxf_line_set_id_code (line, 0);
-        dxf_line_set_linetype (line, strdup (DXF_DEFAULT_LINETYPE));
-        dxf_line_set_layer (line, strdup (DXF_DEFAULT_LAYER));
-        dxf_line_set_elevation (line, 0.0);
-        dxf_line_set_thickness (line, 0.0);
-        dxf_line_set_linetype_scale (line, DXF_DEFAULT_LINETYPE_SCALE);
-        dxf_line_set_visibility (line, DXF_DEFAULT_VISIBILITY);
-        dxf_line_set_color (line, DXF_COLOR_BYLAYER);
-        dxf_line_set_paperspace (line, DXF_MODELSPACE);
+        line->properties = dxf_graphic_properties_default ();
         dxf_line_set_graphics_data_size (line, 0);
-        dxf_line_set_shadow_mode (line, 0);
         dxf_line_set_binary_graphics_data (line, (DxfBinaryGraphicsData *) dxf_binary_graphics_data_new());
-        dxf_line_set_dictionary_owner_soft (line, strdup (""));
-        dxf_line_set_material (line, strdup (""));
-        dxf_line_set_dictionary_owner_hard (line, strdup (""));
-        dxf_line_set_lineweight (line, 0);
-        dxf_line_set_plot_style_name (line, strdup (""));
-        dxf_line_set_color_value (line, 0);
-        dxf_line_set_color_name (line, strdup (""));
-        dxf_line_set_transparency (line, 0);
-        dxf_line_set_p0 (line, (DxfPoint *) dxf_point_new());
-        dxf_point_init ((DxfPoint *) dxf_line_get_p0 (line));
+        dxf_line_set_dictionary_owner_soft (line, "");
+        dxf_line_set_dictionary_owner_hard (line, "");
         dxf_line_set_x0 (line, 0.0);
         dxf_line_set_y0 (line, 0.0);
         dxf_line_set_z0 (line, 0.0);
-        dxf_line_set_p1 (line, (DxfPoint *) dxf_point_new());
-        dxf_point_init ((DxfPoint *) dxf_line_get_p0 (line));
         dxf_line_set_x1 (line, 0.0);
         dxf_line_set_y1 (line, 0.0);
         dxf_line_set_z1 (line, 0.0);
@@ -176,7 +161,10 @@ dxf_line_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfGraphicProperties properties;
+        DxfPair pair;
+        DxfBinaryGraphicsData *binary_graphics_data = NULL;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -184,8 +172,6 @@ dxf_line_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (line == NULL)
@@ -196,269 +182,215 @@ dxf_line_read
                 line = dxf_line_new ();
                 line = dxf_line_init (line);
         }
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        binary_graphics_data = (DxfBinaryGraphicsData *) line->binary_graphics_data;
+        dxf_graphic_properties_start (&properties, line->properties);
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        fclose (fp->fp);
-                        /* Clean up. */
-                        free (temp_string);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &line->id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", line->linetype);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", line->layer);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the start point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &line->p0->x0);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the start point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &line->p0->y0);
-                }
-                else if (strcmp (temp_string, "30") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the start point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &line->p0->z0);
-                }
-                else if (strcmp (temp_string, "11") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the end point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &line->p1->x0);
-                }
-                else if (strcmp (temp_string, "21") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the end point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &line->p1->y0);
-                }
-                else if (strcmp (temp_string, "31") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the end point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &line->p1->z0);
-                }
-                else if (strcmp (temp_string, "38") == 0)
-                {
-                        /* Now follows a string containing the
-                         * elevation. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &line->elevation);
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &line->thickness);
-                }
-                else if (strcmp (temp_string, "48") == 0)
-                {
-                        /* Now follows a string containing the linetype
-                         * scale. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &line->linetype_scale);
-                }
-                else if (strcmp (temp_string, "60") == 0)
-                {
-                        /* Now follows a string containing the
-                         * visibility value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &line->visibility);
-                }
-                else if (strcmp (temp_string, "62") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &line->color);
-                }
-                else if (strcmp (temp_string, "67") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &line->paperspace);
-                }
-                else if (strcmp (temp_string, "92") == 0)
-                {
-                        /* Now follows a string containing the
-                         * graphics data size value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &line->graphics_data_size);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else if (strcmp (temp_string, "100") == 0)
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if ((strcmp (temp_string, "AcDbEntity") != 0)
-                        && ((strcmp (temp_string, "AcDbLine") != 0)))
-                        {
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                line->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 6:
+                                /* Now follows a string containing a linetype
+                                 * name. */
+                                dxf_lexer_free_string (fp, properties.linetype);
+                                properties.linetype = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 8:
+                                /* Now follows a string containing a layer name. */
+                                dxf_lexer_free_string (fp, properties.layer);
+                                properties.layer = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 10:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the start point. */
+                                line->p0.x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 20:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the start point. */
+                                line->p0.y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 30:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the start point. */
+                                line->p0.z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 11:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the end point. */
+                                line->p1.x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 21:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the end point. */
+                                line->p1.y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 31:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the end point. */
+                                line->p1.z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 38:
+                                /* Now follows a string containing the
+                                 * elevation. */
+                                properties.elevation = dxf_pair_get_double (&pair);
+                                break;
+                        case 39:
+                                /* Now follows a string containing the
+                                 * thickness. */
+                                properties.thickness = dxf_pair_get_double (&pair);
+                                break;
+                        case 48:
+                                /* Now follows a string containing the linetype
+                                 * scale. */
+                                properties.linetype_scale = dxf_pair_get_double (&pair);
+                                break;
+                        case 60:
+                                /* Now follows a string containing the
+                                 * visibility value. */
+                                properties.visibility = dxf_pair_get_int (&pair);
+                                break;
+                        case 62:
+                                /* Now follows a string containing the
+                                 * color value. */
+                                properties.color = dxf_pair_get_int (&pair);
+                                break;
+                        case 67:
+                                /* Now follows a string containing the
+                                 * paperspace value. */
+                                properties.paperspace = dxf_pair_get_int (&pair);
+                                break;
+                        case 92:
+                                /* Now follows a string containing the
+                                 * graphics data size value. */
+                                line->graphics_data_size = dxf_pair_get_int (&pair);
+                                break;
+                        case 100:
+                                /* Now follows a string containing the
+                                 * subclass marker value. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                if ((strcmp (temp_string, "AcDbEntity") != 0)
+                                && ((strcmp (temp_string, "AcDbLine") != 0)))
+                                {
+                                        fprintf (stderr,
+                                          (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                }
+                                break;
+                        case 160:
+                                /* Now follows a string containing the
+                                 * graphics data size value. */
+                                line->graphics_data_size = dxf_pair_get_int (&pair);
+                                break;
+                        case 210:
+                                /* Now follows a string containing the
+                                 * X-value of the extrusion vector. */
+                                line->extr_x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 220:
+                                /* Now follows a string containing the
+                                 * Y-value of the extrusion vector. */
+                                line->extr_y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 230:
+                                /* Now follows a string containing the
+                                 * Z-value of the extrusion vector. */
+                                line->extr_z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 284:
+                                /* Now follows a string containing the shadow
+                                 * mode value. */
+                                properties.shadow_mode = dxf_pair_get_int (&pair);
+                                break;
+                        case 310:
+                                /* Now follows a string containing binary
+                                 * graphics data. */
+                                binary_graphics_data = dxf_binary_graphics_data_append_line
+                                  (binary_graphics_data,
+                                  dxf_pair_get_string (&pair));
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, line->dictionary_owner_soft);
+                                line->dictionary_owner_soft = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 347:
+                                /* Now follows a string containing a
+                                 * hard-pointer ID/handle to material object. */
+                                dxf_lexer_free_string (fp, properties.material);
+                                properties.material = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, line->dictionary_owner_hard);
+                                line->dictionary_owner_hard = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 370:
+                                /* Now follows a string containing the lineweight
+                                 * value. */
+                                properties.lineweight = dxf_pair_get_int (&pair);
+                                break;
+                        case 390:
+                                /* Now follows a string containing a plot style
+                                 * name value. */
+                                dxf_lexer_free_string (fp, properties.plot_style_name);
+                                properties.plot_style_name = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 420:
+                                /* Now follows a string containing a color value. */
+                                properties.color_value = dxf_pair_get_long (&pair);
+                                break;
+                        case 430:
+                                /* Now follows a string containing a color
+                                 * name value. */
+                                dxf_lexer_free_string (fp, properties.color_name);
+                                properties.color_name = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 440:
+                                /* Now follows a string containing a transparency
+                                 * value. */
+                                properties.transparency = dxf_pair_get_long (&pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, "DXF comment: %s\n", temp_string);
+                                break;
+                        default:
                                 fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
                                   __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "160") == 0)
-                {
-                        /* Now follows a string containing the
-                         * graphics data size value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &line->graphics_data_size);
-                }
-                else if (strcmp (temp_string, "210") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &line->extr_x0);
-                }
-                else if (strcmp (temp_string, "220") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &line->extr_y0);
-                }
-                else if (strcmp (temp_string, "230") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &line->extr_z0);
-                }
-                else if (strcmp (temp_string, "284") == 0)
-                {
-                        /* Now follows a string containing the shadow
-                         * mode value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &line->shadow_mode);
-                }
-                else if (strcmp (temp_string, "310") == 0)
-                {
-                        /* Now follows a string containing binary
-                         * graphics data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", line->binary_graphics_data->data_line);
-                        dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) line->binary_graphics_data->next);
-                        line->binary_graphics_data = (DxfBinaryGraphicsData *) line->binary_graphics_data->next;
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", line->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "347") == 0)
-                {
-                        /* Now follows a string containing a
-                         * hard-pointer ID/handle to material object. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", line->material);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", line->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "370") == 0)
-                {
-                        /* Now follows a string containing the lineweight
-                         * value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &line->lineweight);
-                }
-                else if (strcmp (temp_string, "390") == 0)
-                {
-                        /* Now follows a string containing a plot style
-                         * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", line->plot_style_name);
-                }
-                else if (strcmp (temp_string, "420") == 0)
-                {
-                        /* Now follows a string containing a color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%ld\n", &line->color_value);
-                }
-                else if (strcmp (temp_string, "430") == 0)
-                {
-                        /* Now follows a string containing a color
-                         * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", line->color_name);
-                }
-                else if (strcmp (temp_string, "440") == 0)
-                {
-                        /* Now follows a string containing a transparency
-                         * value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%ld\n", &line->transparency);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
         /* Handle omitted members and/or illegal values. */
-        if (strcmp (dxf_line_get_linetype (line), "") == 0)
+        if ((properties.linetype != NULL)
+          && (strcmp (properties.linetype, "") == 0))
         {
-                dxf_line_set_linetype (line, strdup (DXF_DEFAULT_LINETYPE));
+                dxf_lexer_free_string (fp, properties.linetype);
+                properties.linetype = dxf_strdup (DXF_DEFAULT_LINETYPE);
         }
-        if (strcmp (dxf_line_get_layer (line), "") == 0)
+        if ((properties.layer != NULL)
+          && (strcmp (properties.layer, "") == 0))
         {
-                dxf_line_set_layer (line, strdup (DXF_DEFAULT_LAYER));
+                dxf_lexer_free_string (fp, properties.layer);
+                properties.layer = dxf_strdup (DXF_DEFAULT_LAYER);
         }
-        /* Clean up. */
-        free (temp_string);
+        /* Entities with equal properties share a record. */
+        dxf_graphic_properties_finish (fp, &line->properties, &properties);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -484,7 +416,7 @@ dxf_line_write
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *dxf_entity_name = strdup ("LINE");
+        char *dxf_entity_name = dxf_strdup ("LINE");
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -493,7 +425,7 @@ dxf_line_write
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (line == NULL)
@@ -502,7 +434,7 @@ dxf_line_write
                   (_("Error in %s () a NULL pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if ((dxf_line_get_x0 (line) == dxf_line_get_x1 (line))
@@ -510,38 +442,38 @@ dxf_line_write
                 && (dxf_line_get_z0 (line) == dxf_line_get_z1 (line)))
         {
                 fprintf (stderr,
-                  (_("Error in %s () start point and end point are identical for the %s entity with id-code: %x\n")),
+                  (_("Error in %s () start point and end point are identical for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_line_get_id_code (line));
                 dxf_entity_skip (dxf_entity_name);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (strcmp (dxf_line_get_linetype (line), "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_line_get_id_code (line));
                 fprintf (stderr,
                   (_("    %s entity is relocated to layer 0\n")),
                   dxf_entity_name);
-                dxf_line_set_linetype (line, strdup (DXF_DEFAULT_LINETYPE));
+                dxf_line_set_linetype (line, DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (dxf_line_get_layer (line), "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty layer string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty layer string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_line_get_id_code (line));
                 fprintf (stderr,
                   (_("    %s entity is relocated to layer 0\n")),
                   dxf_entity_name);
-                dxf_line_set_layer (line, strdup (DXF_DEFAULT_LAYER));
+                dxf_line_set_layer (line, DXF_DEFAULT_LAYER);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
-        if (dxf_line_get_id_code (line) != -1)
+        dxf_write_string (fp, 0, dxf_entity_name);
+        if (line->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", dxf_line_get_id_code (line));
+                dxf_write_hex (fp, 5, dxf_line_get_id_code (line));
         }
         /*!
          * \todo for version R14.\n
@@ -556,68 +488,68 @@ dxf_line_write
         if ((strcmp (dxf_line_get_dictionary_owner_soft (line), "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", dxf_line_get_dictionary_owner_soft (line));
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, dxf_line_get_dictionary_owner_soft (line));
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (dxf_line_get_dictionary_owner_hard (line), "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", dxf_line_get_dictionary_owner_hard (line));
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, dxf_line_get_dictionary_owner_hard (line));
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbEntity\n");
+                dxf_write_string (fp, 100, "AcDbEntity");
         }
         if (dxf_line_get_paperspace (line) == DXF_PAPERSPACE)
         {
-                fprintf (fp->fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_int (fp, 67, DXF_PAPERSPACE);
         }
-        fprintf (fp->fp, "  8\n%s\n", dxf_line_get_layer (line));
+        dxf_write_string (fp, 8, dxf_line_get_layer (line));
         if (strcmp (dxf_line_get_linetype (line), DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp->fp, "  6\n%s\n", dxf_line_get_linetype (line));
+                dxf_write_string (fp, 6, dxf_line_get_linetype (line));
         }
         if ((fp->acad_version_number >= AutoCAD_2008)
           && (strcmp (dxf_line_get_material (line), "") != 0))
         {
-                fprintf (fp->fp, "347\n%s\n", dxf_line_get_material (line));
+                dxf_write_string (fp, 347, dxf_line_get_material (line));
         }
         if (dxf_line_get_color (line) != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp->fp, " 62\n%d\n", dxf_line_get_color (line));
+                dxf_write_int (fp, 62, dxf_line_get_color (line));
         }
         if (fp->acad_version_number >= AutoCAD_2002)
         {
-                fprintf (fp->fp, "370\n%d\n", dxf_line_get_lineweight (line));
+                dxf_write_int (fp, 370, dxf_line_get_lineweight (line));
         }
         if ((fp->acad_version_number <= AutoCAD_11)
           && DXF_FLATLAND
           && (dxf_line_get_elevation (line) != 0.0))
         {
-                fprintf (fp->fp, " 38\n%f\n", dxf_line_get_elevation (line));
+                dxf_write_double (fp, 38, dxf_line_get_elevation (line));
         }
         if (dxf_line_get_thickness (line) != 0.0)
         {
-                fprintf (fp->fp, " 39\n%f\n", dxf_line_get_thickness (line));
+                dxf_write_double (fp, 39, dxf_line_get_thickness (line));
         }
         if (dxf_line_get_linetype_scale (line) != 1.0)
         {
-                fprintf (fp->fp, " 48\n%f\n", dxf_line_get_linetype_scale (line));
+                dxf_write_double (fp, 48, dxf_line_get_linetype_scale (line));
         }
         if (dxf_line_get_visibility (line) != 0)
         {
-                fprintf (fp->fp, " 60\n%d\n", dxf_line_get_visibility (line));
+                dxf_write_int (fp, 60, dxf_line_get_visibility (line));
         }
         if ((fp->acad_version_number >= AutoCAD_2000)
           && (dxf_line_get_graphics_data_size (line) > 0))
         {
 #ifdef BUILD_64
-                fprintf (fp->fp, "160\n%d\n", dxf_line_get_graphics_data_size (line));
+                dxf_write_int (fp, 160, dxf_line_get_graphics_data_size (line));
 #else
-                fprintf (fp->fp, " 92\n%d\n", dxf_line_get_graphics_data_size (line));
+                dxf_write_int (fp, 92, dxf_line_get_graphics_data_size (line));
 #endif
                 if (dxf_line_get_binary_graphics_data (line) != NULL)
                 {
@@ -625,43 +557,43 @@ dxf_line_write
                         iter = dxf_line_get_binary_graphics_data (line);
                         while (iter != NULL)
                         {
-                                fprintf (fp->fp, "310\n%s\n", dxf_binary_graphics_data_get_data_line (iter));
+                                dxf_write_string (fp, 310, dxf_binary_graphics_data_get_data_line (iter));
                                 iter = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_get_next (iter);
                         }
                 }
         }
         if (fp->acad_version_number >= AutoCAD_2004)
         {
-                fprintf (fp->fp, "420\n%ld\n", dxf_line_get_color_value (line));
-                fprintf (fp->fp, "430\n%s\n", dxf_line_get_color_name (line));
-                fprintf (fp->fp, "440\n%ld\n", dxf_line_get_transparency (line));
+                dxf_write_long (fp, 420, dxf_line_get_color_value (line));
+                dxf_write_string (fp, 430, dxf_line_get_color_name (line));
+                dxf_write_long (fp, 440, dxf_line_get_transparency (line));
         }
         if (fp->acad_version_number >= AutoCAD_2009)
         {
-                fprintf (fp->fp, "390\n%s\n", dxf_line_get_plot_style_name (line));
-                fprintf (fp->fp, "284\n%d\n", dxf_line_get_shadow_mode (line));
+                dxf_write_string (fp, 390, dxf_line_get_plot_style_name (line));
+                dxf_write_int (fp, 284, dxf_line_get_shadow_mode (line));
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbLine\n");
+                dxf_write_string (fp, 100, "AcDbLine");
         }
-        fprintf (fp->fp, " 10\n%f\n", dxf_line_get_x0 (line));
-        fprintf (fp->fp, " 20\n%f\n", dxf_line_get_y0 (line));
-        fprintf (fp->fp, " 30\n%f\n", dxf_line_get_z0 (line));
-        fprintf (fp->fp, " 11\n%f\n", dxf_line_get_x1 (line));
-        fprintf (fp->fp, " 21\n%f\n", dxf_line_get_y1 (line));
-        fprintf (fp->fp, " 31\n%f\n", dxf_line_get_z1 (line));
+        dxf_write_double (fp, 10, dxf_line_get_x0 (line));
+        dxf_write_double (fp, 20, dxf_line_get_y0 (line));
+        dxf_write_double (fp, 30, dxf_line_get_z0 (line));
+        dxf_write_double (fp, 11, dxf_line_get_x1 (line));
+        dxf_write_double (fp, 21, dxf_line_get_y1 (line));
+        dxf_write_double (fp, 31, dxf_line_get_z1 (line));
         if ((fp->acad_version_number >= AutoCAD_12)
                 && (dxf_line_get_extr_x0 (line) != 0.0)
                 && (dxf_line_get_extr_y0 (line) != 0.0)
                 && (dxf_line_get_extr_z0 (line) != 1.0))
         {
-                fprintf (fp->fp, "210\n%f\n", dxf_line_get_extr_x0 (line));
-                fprintf (fp->fp, "220\n%f\n", dxf_line_get_extr_y0 (line));
-                fprintf (fp->fp, "230\n%f\n", dxf_line_get_extr_z0 (line));
+                dxf_write_double (fp, 210, dxf_line_get_extr_x0 (line));
+                dxf_write_double (fp, 220, dxf_line_get_extr_y0 (line));
+                dxf_write_double (fp, 230, dxf_line_get_extr_z0 (line));
         }
         /* Clean up. */
-        free (dxf_entity_name);
+        dxf_free (dxf_entity_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -694,17 +626,11 @@ dxf_line_free
                 __FUNCTION__);
               return (EXIT_FAILURE);
         }
-        free (dxf_line_get_linetype (line));
-        free (dxf_line_get_layer (line));
+        dxf_graphic_properties_free (line->properties);
         dxf_binary_graphics_data_free_chain (dxf_line_get_binary_graphics_data (line));
-        free (dxf_line_get_dictionary_owner_soft (line));
-        free (dxf_line_get_material (line));
-        free (dxf_line_get_dictionary_owner_hard (line));
-        free (dxf_line_get_plot_style_name (line));
-        free (dxf_line_get_color_name (line));
-        dxf_point_free (dxf_line_get_p0 (line));
-        dxf_point_free (dxf_line_get_p1 (line));
-        free (line);
+        dxf_free (line->dictionary_owner_soft);
+        dxf_free (line->dictionary_owner_hard);
+        dxf_free (line);
         line = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -724,7 +650,7 @@ dxf_line_free_chain
                 /*!< pointer to the chain of DXF \c LINE entities. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (lines == NULL)
@@ -750,7 +676,7 @@ dxf_line_free_chain
  *
  * \return ID code.
  */
-int
+long
 dxf_line_get_id_code
 (
         DxfLine *line
@@ -790,7 +716,7 @@ dxf_line_set_id_code
 (
         DxfLine *line,
                 /*!< a pointer to a DXF \c LINE entity. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -845,7 +771,7 @@ dxf_line_get_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        if (line->linetype ==  NULL)
+        if (line->properties->linetype ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the linetype member.\n")),
@@ -855,7 +781,7 @@ dxf_line_get_linetype
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (line->linetype));
+        return (dxf_strdup (line->properties->linetype));
 }
 
 
@@ -889,7 +815,12 @@ dxf_line_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        line->linetype = strdup (linetype);
+        if (dxf_graphic_properties_unshare (&line->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (line->properties->linetype);
+        line->properties->linetype = dxf_strdup (linetype);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -920,7 +851,7 @@ dxf_line_get_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        if (line->layer ==  NULL)
+        if (line->properties->layer ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the layer member.\n")),
@@ -930,7 +861,7 @@ dxf_line_get_layer
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (line->layer));
+        return (dxf_strdup (line->properties->layer));
 }
 
 
@@ -964,7 +895,12 @@ dxf_line_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        line->layer = strdup (layer);
+        if (dxf_graphic_properties_unshare (&line->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (line->properties->layer);
+        line->properties->layer = dxf_strdup (layer);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -998,7 +934,7 @@ dxf_line_get_elevation
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (line->elevation);
+        return (line->properties->elevation);
 }
 
 
@@ -1025,7 +961,11 @@ dxf_line_set_elevation
                   __FUNCTION__);
                 return (NULL);
         }
-        line->elevation = elevation;
+        if (dxf_graphic_properties_unshare (&line->properties) == NULL)
+        {
+                return (NULL);
+        }
+        line->properties->elevation = elevation;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1056,7 +996,7 @@ dxf_line_get_thickness
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (line->thickness < 0.0)
+        if (line->properties->thickness < 0.0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found in the thickness member.\n")),
@@ -1066,7 +1006,7 @@ dxf_line_get_thickness
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (line->thickness);
+        return (line->properties->thickness);
 }
 
 
@@ -1100,7 +1040,11 @@ dxf_line_set_thickness
                   __FUNCTION__);
                 return (NULL);
         }
-        line->thickness = thickness;
+        if (dxf_graphic_properties_unshare (&line->properties) == NULL)
+        {
+                return (NULL);
+        }
+        line->properties->thickness = thickness;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1131,7 +1075,7 @@ dxf_line_get_linetype_scale
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (line->linetype_scale < 0.0)
+        if (line->properties->linetype_scale < 0.0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found in the linetype scale member.\n")),
@@ -1141,7 +1085,7 @@ dxf_line_get_linetype_scale
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (line->linetype_scale);
+        return (line->properties->linetype_scale);
 }
 
 
@@ -1175,7 +1119,11 @@ dxf_line_set_linetype_scale
                   __FUNCTION__);
                 return (NULL);
         }
-        line->linetype_scale = linetype_scale;
+        if (dxf_graphic_properties_unshare (&line->properties) == NULL)
+        {
+                return (NULL);
+        }
+        line->properties->linetype_scale = linetype_scale;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1206,14 +1154,14 @@ dxf_line_get_visibility
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (line->visibility < 0)
+        if (line->properties->visibility < 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found in the visibility member.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (line->visibility > 1)
+        if (line->properties->visibility > 1)
         {
                 fprintf (stderr,
                   (_("Error in %s () an out of range value was found in the visibility member.\n")),
@@ -1223,7 +1171,7 @@ dxf_line_get_visibility
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (line->visibility);
+        return (line->properties->visibility);
 }
 
 
@@ -1264,7 +1212,11 @@ dxf_line_set_visibility
                   __FUNCTION__);
                 return (NULL);
         }
-        line->visibility = visibility;
+        if (dxf_graphic_properties_unshare (&line->properties) == NULL)
+        {
+                return (NULL);
+        }
+        line->properties->visibility = visibility;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1295,7 +1247,7 @@ dxf_line_get_color
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (line->color < 0)
+        if (line->properties->color < 0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found in the color member.\n")),
@@ -1304,7 +1256,7 @@ dxf_line_get_color
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (line->color);
+        return (line->properties->color);
 }
 
 
@@ -1339,7 +1291,11 @@ dxf_line_set_color
                 fprintf (stderr,
                   (_("\teffectively turning this entity it's visibility off.\n")));
         }
-        line->color = color;
+        if (dxf_graphic_properties_unshare (&line->properties) == NULL)
+        {
+                return (NULL);
+        }
+        line->properties->color = color;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1370,13 +1326,13 @@ dxf_line_get_paperspace
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (line->paperspace < 0)
+        if (line->properties->paperspace < 0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found in the paperspace member.\n")),
                   __FUNCTION__);
         }
-        if (line->paperspace > 1)
+        if (line->properties->paperspace > 1)
         {
                 fprintf (stderr,
                   (_("Warning in %s () an out of range value was found in the paperspace member.\n")),
@@ -1385,7 +1341,7 @@ dxf_line_get_paperspace
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (line->paperspace);
+        return (line->properties->paperspace);
 }
 
 
@@ -1426,7 +1382,11 @@ dxf_line_set_paperspace
                   __FUNCTION__);
                 return (NULL);
         }
-        line->paperspace = paperspace;
+        if (dxf_graphic_properties_unshare (&line->properties) == NULL)
+        {
+                return (NULL);
+        }
+        line->properties->paperspace = paperspace;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1551,14 +1511,14 @@ dxf_line_get_shadow_mode
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (line->shadow_mode < 0)
+        if (line->properties->shadow_mode < 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found in the shadow_mode member.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (line->shadow_mode > 3)
+        if (line->properties->shadow_mode > 3)
         {
                 fprintf (stderr,
                   (_("Error in %s () an out of range value was found in the shadow_mode member.\n")),
@@ -1568,7 +1528,7 @@ dxf_line_get_shadow_mode
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (line->shadow_mode);
+        return (line->properties->shadow_mode);
 }
 
 
@@ -1612,7 +1572,11 @@ dxf_line_set_shadow_mode
                   __FUNCTION__);
                 return (NULL);
         }
-        line->shadow_mode = shadow_mode;
+        if (dxf_graphic_properties_unshare (&line->properties) == NULL)
+        {
+                return (NULL);
+        }
+        line->properties->shadow_mode = shadow_mode;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1736,7 +1700,7 @@ dxf_line_get_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (line->dictionary_owner_soft));
+        return (dxf_strdup (line->dictionary_owner_soft));
 }
 
 
@@ -1772,7 +1736,7 @@ dxf_line_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        line->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        line->dictionary_owner_soft = dxf_strdup (dictionary_owner_soft);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1807,7 +1771,7 @@ dxf_line_get_material
                   __FUNCTION__);
                 return (NULL);
         }
-        if (line->material ==  NULL)
+        if (line->properties->material ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the material member.\n")),
@@ -1817,7 +1781,7 @@ dxf_line_get_material
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (line->material));
+        return (dxf_strdup (line->properties->material));
 }
 
 
@@ -1856,7 +1820,12 @@ dxf_line_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        line->material = strdup (material);
+        if (dxf_graphic_properties_unshare (&line->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (line->properties->material);
+        line->properties->material = dxf_strdup (material);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1900,7 +1869,7 @@ dxf_line_get_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (line->dictionary_owner_hard));
+        return (dxf_strdup (line->dictionary_owner_hard));
 }
 
 
@@ -1936,7 +1905,7 @@ dxf_line_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        line->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        line->dictionary_owner_hard = dxf_strdup (dictionary_owner_hard);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1971,7 +1940,7 @@ dxf_line_get_lineweight
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (line->lineweight);
+        return (line->properties->lineweight);
 }
 
 
@@ -2001,7 +1970,11 @@ dxf_line_set_lineweight
                   __FUNCTION__);
                 return (NULL);
         }
-        line->lineweight = lineweight;
+        if (dxf_graphic_properties_unshare (&line->properties) == NULL)
+        {
+                return (NULL);
+        }
+        line->properties->lineweight = lineweight;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2033,7 +2006,7 @@ dxf_line_get_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        if (line->plot_style_name ==  NULL)
+        if (line->properties->plot_style_name ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the plot_style_name member.\n")),
@@ -2043,7 +2016,7 @@ dxf_line_get_plot_style_name
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (line->plot_style_name));
+        return (dxf_strdup (line->properties->plot_style_name));
 }
 
 
@@ -2081,7 +2054,12 @@ dxf_line_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        line->plot_style_name = strdup (plot_style_name);
+        if (dxf_graphic_properties_unshare (&line->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (line->properties->plot_style_name);
+        line->properties->plot_style_name = dxf_strdup (plot_style_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2116,7 +2094,7 @@ dxf_line_get_color_value
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (line->color_value);
+        return (line->properties->color_value);
 }
 
 
@@ -2146,7 +2124,11 @@ dxf_line_set_color_value
                   __FUNCTION__);
                 return (NULL);
         }
-        line->color_value = color_value;
+        if (dxf_graphic_properties_unshare (&line->properties) == NULL)
+        {
+                return (NULL);
+        }
+        line->properties->color_value = color_value;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2178,7 +2160,7 @@ dxf_line_get_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        if (line->color_name ==  NULL)
+        if (line->properties->color_name ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the color_name member.\n")),
@@ -2188,7 +2170,7 @@ dxf_line_get_color_name
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (line->color_name));
+        return (dxf_strdup (line->properties->color_name));
 }
 
 
@@ -2226,7 +2208,12 @@ dxf_line_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        line->color_name = strdup (color_name);
+        if (dxf_graphic_properties_unshare (&line->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (line->properties->color_name);
+        line->properties->color_name = dxf_strdup (color_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2261,7 +2248,7 @@ dxf_line_get_transparency
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (line->transparency);
+        return (line->properties->transparency);
 }
 
 
@@ -2291,7 +2278,11 @@ dxf_line_set_transparency
                   __FUNCTION__);
                 return (NULL);
         }
-        line->transparency = transparency;
+        if (dxf_graphic_properties_unshare (&line->properties) == NULL)
+        {
+                return (NULL);
+        }
+        line->properties->transparency = transparency;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2302,6 +2293,16 @@ dxf_line_set_transparency
 /*!
  * \brief Get the start point \c p0 of a DXF \c LINE entity.
  *
+ * The point is a newly allocated copy of the position kept in
+ * \c line, to be freed with dxf_point_free ().  Changing it does not
+ * change \c line.
+ *
+ * \deprecated Before the position was kept in \c line itself this
+ * returned the point held by \c line, which was freed together with it
+ * and whose changes were changes of \c line.  Callers relying on that
+ * leak the copy and lose their changes, use
+ * dxf_line_get_p0_vec3 () instead.
+ *
  * \return the start point \c p0.
  */
 DxfPoint *
@@ -2311,7 +2312,7 @@ dxf_line_get_p0
                 /*!< a pointer to a DXF \c LINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2322,23 +2323,52 @@ dxf_line_get_p0
                   __FUNCTION__);
                 return (NULL);
         }
-        if (line->p0 == NULL)
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (dxf_point_new_from_vec3 (&line->p0));
+}
+
+
+/*!
+ * \brief Get the start point \c p0 of a DXF \c LINE entity, as kept in
+ * \c line.
+ *
+ * Changing the position changes \c line.
+ *
+ * \return a pointer to the position, or \c NULL when an error
+ * occurred.
+ */
+DxfVec3 *
+dxf_line_get_p0_vec3
+(
+        DxfLine *line
+                /*!< a pointer to a DXF \c LINE entity. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (line == NULL)
         {
                 fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found.\n")),
+                  (_("Error in %s () a NULL pointer was passed.\n")),
                   __FUNCTION__);
                 return (NULL);
         }
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return ((DxfPoint *) line->p0);
+        return (&line->p0);
 }
 
 
 /*!
  * \brief Set the start point \c p0 of a DXF \c LINE entity.
  *
+ * Only the position of \c p0 is copied, the caller keeps \c p0.
+ *
  * \return a pointer to a DXF \c LINE entity.
  */
 DxfLine *
@@ -2350,7 +2380,7 @@ dxf_line_set_p0
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2368,7 +2398,9 @@ dxf_line_set_p0
                   __FUNCTION__);
                 return (NULL);
         }
-        line->p0 = p0;
+        line->p0.x0 = p0->x0;
+        line->p0.y0 = p0->y0;
+        line->p0.z0 = p0->z0;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2389,7 +2421,7 @@ dxf_line_get_x0
                 /*!< a pointer to a DXF \c LINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2401,17 +2433,10 @@ dxf_line_get_x0
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (line->p0 == NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was passed.\n")),
-                  __FUNCTION__);
-                return (EXIT_FAILURE);
-        }
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (line->p0->x0);
+        return (line->p0.x0);
 }
 
 
@@ -2432,7 +2457,7 @@ dxf_line_set_x0
                  * \c LINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2443,14 +2468,7 @@ dxf_line_set_x0
                   __FUNCTION__);
                 return (NULL);
         }
-        if (line->p0 == NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found.\n")),
-                  __FUNCTION__);
-                return (NULL);
-        }
-        line->p0->x0 = x0;
+        line->p0.x0 = x0;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2471,7 +2489,7 @@ dxf_line_get_y0
                 /*!< a pointer to a DXF \c LINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2483,17 +2501,10 @@ dxf_line_get_y0
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (line->p0 == NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found.\n")),
-                  __FUNCTION__);
-                return (EXIT_FAILURE);
-        }
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (line->p0->y0);
+        return (line->p0.y0);
 }
 
 
@@ -2514,7 +2525,7 @@ dxf_line_set_y0
                  * \c line entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2525,14 +2536,7 @@ dxf_line_set_y0
                   __FUNCTION__);
                 return (NULL);
         }
-        if (line->p0 == NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found.\n")),
-                  __FUNCTION__);
-                return (NULL);
-        }
-        line->p0->y0 = y0;
+        line->p0.y0 = y0;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2553,7 +2557,7 @@ dxf_line_get_z0
                 /*!< a pointer to a DXF \c LINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2565,17 +2569,10 @@ dxf_line_get_z0
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (line->p0 == NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found.\n")),
-                  __FUNCTION__);
-                return (EXIT_FAILURE);
-        }
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (line->p0->z0);
+        return (line->p0.z0);
 }
 
 
@@ -2596,7 +2593,7 @@ dxf_line_set_z0
                  * \c line entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2607,14 +2604,7 @@ dxf_line_set_z0
                   __FUNCTION__);
                 return (NULL);
         }
-        if (line->p0 == NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found.\n")),
-                  __FUNCTION__);
-                return (NULL);
-        }
-        line->p0->z0 = z0;
+        line->p0.z0 = z0;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2625,6 +2615,16 @@ dxf_line_set_z0
 /*!
  * \brief Get the end point \c p1 of a DXF \c LINE entity.
  *
+ * The point is a newly allocated copy of the position kept in
+ * \c line, to be freed with dxf_point_free ().  Changing it does not
+ * change \c line.
+ *
+ * \deprecated Before the position was kept in \c line itself this
+ * returned the point held by \c line, which was freed together with it
+ * and whose changes were changes of \c line.  Callers relying on that
+ * leak the copy and lose their changes, use
+ * dxf_line_get_p1_vec3 () instead.
+ *
  * \return the end point \c p1.
  */
 DxfPoint *
@@ -2634,7 +2634,7 @@ dxf_line_get_p1
                 /*!< a pointer to a DXF \c LINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2645,23 +2645,52 @@ dxf_line_get_p1
                   __FUNCTION__);
                 return (NULL);
         }
-        if (line->p1 == NULL)
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (dxf_point_new_from_vec3 (&line->p1));
+}
+
+
+/*!
+ * \brief Get the end point \c p1 of a DXF \c LINE entity, as kept in
+ * \c line.
+ *
+ * Changing the position changes \c line.
+ *
+ * \return a pointer to the position, or \c NULL when an error
+ * occurred.
+ */
+DxfVec3 *
+dxf_line_get_p1_vec3
+(
+        DxfLine *line
+                /*!< a pointer to a DXF \c LINE entity. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (line == NULL)
         {
                 fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found.\n")),
+                  (_("Error in %s () a NULL pointer was passed.\n")),
                   __FUNCTION__);
                 return (NULL);
         }
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (line->p1);
+        return (&line->p1);
 }
 
 
 /*!
  * \brief Set the end point \c p1 of a DXF \c LINE entity.
  *
+ * Only the position of \c p1 is copied, the caller keeps \c p1.
+ *
  * \return a pointer to a DXF \c LINE entity.
  */
 DxfLine *
@@ -2673,7 +2702,7 @@ dxf_line_set_p1
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2691,7 +2720,9 @@ dxf_line_set_p1
                   __FUNCTION__);
                 return (NULL);
         }
-        line->p1 = p1;
+        line->p1.x0 = p1->x0;
+        line->p1.y0 = p1->y0;
+        line->p1.z0 = p1->z0;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2712,7 +2743,7 @@ dxf_line_get_x1
                 /*!< a pointer to a DXF \c LINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2724,17 +2755,10 @@ dxf_line_get_x1
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (line->p1 == NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was passed.\n")),
-                  __FUNCTION__);
-                return (EXIT_FAILURE);
-        }
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (line->p1->x0);
+        return (line->p1.x0);
 }
 
 
@@ -2755,7 +2779,7 @@ dxf_line_set_x1
                  * \c LINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2766,14 +2790,7 @@ dxf_line_set_x1
                   __FUNCTION__);
                 return (NULL);
         }
-        if (line->p1 == NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found.\n")),
-                  __FUNCTION__);
-                return (NULL);
-        }
-        line->p1->x0 = x1;
+        line->p1.x0 = x1;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2794,7 +2811,7 @@ dxf_line_get_y1
                 /*!< a pointer to a DXF \c LINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2806,17 +2823,10 @@ dxf_line_get_y1
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (line->p1 == NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found.\n")),
-                  __FUNCTION__);
-                return (EXIT_FAILURE);
-        }
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (line->p1->y0);
+        return (line->p1.y0);
 }
 
 
@@ -2837,7 +2847,7 @@ dxf_line_set_y1
                  * \c line entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2848,14 +2858,7 @@ dxf_line_set_y1
                   __FUNCTION__);
                 return (NULL);
         }
-        if (line->p1 == NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found.\n")),
-                  __FUNCTION__);
-                return (NULL);
-        }
-        line->p1->y0 = y1;
+        line->p1.y0 = y1;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2876,7 +2879,7 @@ dxf_line_get_z1
                 /*!< a pointer to a DXF \c LINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2888,17 +2891,10 @@ dxf_line_get_z1
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (line->p1 == NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found.\n")),
-                  __FUNCTION__);
-                return (EXIT_FAILURE);
-        }
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (line->p1->z0);
+        return (line->p1.z0);
 }
 
 
@@ -2919,7 +2915,7 @@ dxf_line_set_z1
                  * \c line entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2930,14 +2926,7 @@ dxf_line_set_z1
                   __FUNCTION__);
                 return (NULL);
         }
-        if (line->p1 == NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found.\n")),
-                  __FUNCTION__);
-                return (NULL);
-        }
-        line->p1->z0 = z1;
+        line->p1.z0 = z1;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2958,7 +2947,7 @@ dxf_line_get_extr_x0
                 /*!< a pointer to a DXF \c LINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2994,7 +2983,7 @@ dxf_line_set_extr_x0
                  * \c LINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3026,7 +3015,7 @@ dxf_line_get_extr_y0
                 /*!< a pointer to a DXF \c LINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3062,7 +3051,7 @@ dxf_line_set_extr_y0
                  * \c LINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3094,7 +3083,7 @@ dxf_line_get_extr_z0
                 /*!< a pointer to a DXF \c LINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3130,7 +3119,7 @@ dxf_line_set_extr_z0
                  * \c POLYLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3164,7 +3153,7 @@ dxf_line_get_extrusion_vector_as_point
                 /*!< a pointer to a DXF \c LINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         DxfPoint *point = NULL;
@@ -3177,9 +3166,9 @@ dxf_line_get_extrusion_vector_as_point
                   __FUNCTION__);
                 return (NULL);
         }
-        if ((line->p0->x0 == line->p1->x0)
-          && (line->p0->y0 == line->p1->y0)
-          && (line->p0->z0 == line->p1->z0))
+        if ((line->p0.x0 == line->p1.x0)
+          && (line->p0.y0 == line->p1.y0)
+          && (line->p0.z0 == line->p1.z0))
         {
                 fprintf (stderr,
                   (_("Error in %s () a 3DLINE with points with identical coordinates were passed.\n")),
@@ -3375,7 +3364,7 @@ dxf_line_calculate_mid_point
 (
         DxfLine *line,
                 /*!< a pointer to a DXF \c LINE entity. */
-        int id_code,
+        long id_code,
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -3389,10 +3378,11 @@ dxf_line_calculate_mid_point
                  */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         DxfPoint *point = NULL;
+        DxfGraphicProperties *properties;
 
         /* Do some basic checks. */
         if (line == NULL)
@@ -3402,9 +3392,9 @@ dxf_line_calculate_mid_point
                   __FUNCTION__);
                 return (NULL);
         }
-        if ((line->p0->x0 == line->p1->x0)
-          && (line->p0->y0 == line->p1->y0)
-          && (line->p0->z0 == line->p1->z0))
+        if ((line->p0.x0 == line->p1.x0)
+          && (line->p0.y0 == line->p1.y0)
+          && (line->p0.z0 == line->p1.z0))
         {
                 fprintf (stderr,
                   (_("Error in %s () a 3DLINE with points with identical coordinates were passed.\n")),
@@ -3426,35 +3416,27 @@ dxf_line_calculate_mid_point
                 __FUNCTION__);
         }
         point->id_code = id_code;
-        point->x0 = (line->p0->x0 + line->p1->x0) / 2;
-        point->y0 = (line->p0->y0 + line->p1->y0) / 2;
-        point->z0 = (line->p0->z0 + line->p1->z0) / 2;
+        point->x0 = (line->p0.x0 + line->p1.x0) / 2;
+        point->y0 = (line->p0.y0 + line->p1.y0) / 2;
+        point->z0 = (line->p0.z0 + line->p1.z0) / 2;
         switch (inheritance)
         {
                 case 0:
                         /* Do nothing. */
                         break;
                 case 1:
-                        if (line->linetype != NULL)
-                        {
-                                point->linetype = strdup (line->linetype);
-                        }
-                        if (line->layer != NULL)
+                        properties = dxf_graphic_properties_copy (line->properties);
+                        if (properties != NULL)
                         {
-                                point->layer = strdup (line->layer);
+                                point->properties = properties;
                         }
-                        point->thickness = line->thickness;
-                        point->linetype_scale = line->linetype_scale;
-                        point->visibility = line->visibility;
-                        point->color = line->color;
-                        point->paperspace = line->paperspace;
                         if (line->dictionary_owner_soft != NULL)
                         {
-                                point->dictionary_owner_soft = strdup (line->dictionary_owner_soft);
+                                point->dictionary_owner_soft = dxf_strdup (line->dictionary_owner_soft);
                         }
                         if (line->dictionary_owner_hard != NULL)
                         {
-                                point->dictionary_owner_hard = strdup (line->dictionary_owner_hard);
+                                point->dictionary_owner_hard = dxf_strdup (line->dictionary_owner_hard);
                         }
                         break;
                 default:
@@ -3485,7 +3467,7 @@ dxf_line_calculate_length
                 /*!< a pointer to a DXF \c LINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         double length;
@@ -3498,9 +3480,9 @@ dxf_line_calculate_length
                   __FUNCTION__);
                 return (0.0);
         }
-        if ((line->p0->x0 == line->p1->x0)
-          && (line->p0->y0 == line->p1->y0)
-          && (line->p0->z0 == line->p1->z0))
+        if ((line->p0.x0 == line->p1.x0)
+          && (line->p0.y0 == line->p1.y0)
+          && (line->p0.z0 == line->p1.z0))
         {
                 fprintf (stderr,
                   (_("Error in %s () endpoints with identical coordinates were passed.\n")),
@@ -3509,9 +3491,9 @@ dxf_line_calculate_length
         }
         length = sqrt
         (
-          ((line->p1->x0 - line->p0->x0) * (line->p1->x0 - line->p0->x0))
-          + ((line->p1->y0 - line->p0->y0) * (line->p1->y0 - line->p0->y0))
-          + ((line->p1->z0 - line->p0->z0) * (line->p1->z0 - line->p0->z0))
+          ((line->p1.x0 - line->p0.x0) * (line->p1.x0 - line->p0.x0))
+          + ((line->p1.y0 - line->p0.y0) * (line->p1.y0 - line->p0.y0))
+          + ((line->p1.z0 - line->p0.z0) * (line->p1.z0 - line->p0.z0))
         );
 #if DEBUG
         DXF_DEBUG_END
@@ -3535,7 +3517,7 @@ dxf_line_create_from_points
                 /*!< a pointer to a DXF \c POINT entity. */
         DxfPoint *p2,
                 /*!< a pointer to a DXF \c POINT entity. */
-        int id_code,
+        long id_code,
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -3554,6 +3536,7 @@ dxf_line_create_from_points
         DXF_DEBUG_BEGIN
 #endif
         DxfLine *line = NULL;
+        DxfGraphicProperties *properties;
 
         /* Do some basic checks. */
         if ((p1 == NULL) || (p2 == NULL))
@@ -3592,100 +3575,52 @@ dxf_line_create_from_points
                 __FUNCTION__);
         }
         line->id_code = id_code;
-        line->p0->x0 = p1->x0;
-        line->p0->y0 = p1->y0;
-        line->p0->z0 = p1->z0;
-        line->p1->x0 = p2->x0;
-        line->p1->y0 = p2->y0;
-        line->p1->z0 = p2->z0;
+        line->p0.x0 = p1->x0;
+        line->p0.y0 = p1->y0;
+        line->p0.z0 = p1->z0;
+        line->p1.x0 = p2->x0;
+        line->p1.y0 = p2->y0;
+        line->p1.z0 = p2->z0;
         switch (inheritance)
         {
                 case 0:
                         /* Do nothing. */
                         break;
                 case 1:
-                        if (p1->linetype != NULL)
-                        {
-                                line->linetype = p1->linetype;
-                        }
-                        if (p1->layer != NULL)
+                        properties = dxf_graphic_properties_copy (p1->properties);
+                        if (properties != NULL)
                         {
-                                line->layer = p1->layer;
+                                line->properties = properties;
                         }
-                        line->thickness = p1->thickness;
-                        line->linetype_scale = p1->linetype_scale;
-                        line->visibility = p1->visibility;
-                        line->color = p1->color;
-                        line->paperspace = p1->paperspace;
                         line->graphics_data_size = p1->graphics_data_size;
-                        line-> shadow_mode = p1->shadow_mode;
                         /*! \todo Do a deep copy of \c binary_graphics_data. */
                         line->binary_graphics_data = p1->binary_graphics_data;
                         if (p1->dictionary_owner_soft != NULL)
                         {
-                                line->dictionary_owner_soft = strdup (p1->dictionary_owner_soft);
-                        }
-                        if (p1->material != NULL)
-                        {
-                                line->material = strdup (p1->material);
+                                line->dictionary_owner_soft = dxf_strdup (p1->dictionary_owner_soft);
                         }
                         if (p1->dictionary_owner_hard != NULL)
                         {
-                                line->dictionary_owner_hard = strdup (p1->dictionary_owner_hard);
-                        }
-                        line->lineweight = p1->lineweight;
-                        if (p1->plot_style_name != NULL)
-                        {
-                                line->plot_style_name = strdup (p1->plot_style_name);
-                        }
-                        line->color_value = p1->color_value;
-                        if (p1->color_name != NULL)
-                        {
-                                line->color_name = strdup (p1->color_name);
+                                line->dictionary_owner_hard = dxf_strdup (p1->dictionary_owner_hard);
                         }
-                        line->transparency = p1->transparency;
                         break;
                 case 2:
-                        if (p2->linetype != NULL)
+                        properties = dxf_graphic_properties_copy (p2->properties);
+                        if (properties != NULL)
                         {
-                                line->linetype = p2->linetype;
+                                line->properties = properties;
                         }
-                        if (p2->layer != NULL)
-                        {
-                                line->layer = p2->layer;
-                        }
-                        line->thickness = p2->thickness;
-                        line->linetype_scale = p2->linetype_scale;
-                        line->visibility = p2->visibility;
-                        line->color = p2->color;
-                        line->paperspace = p2->paperspace;
                         line->graphics_data_size = p2->graphics_data_size;
-                        line-> shadow_mode = p2->shadow_mode;
                         /*! \todo Do a deep copy of \c binary_graphics_data. */
                         line->binary_graphics_data = p2->binary_graphics_data;
                         if (p2->dictionary_owner_soft != NULL)
                         {
-                                line->dictionary_owner_soft = strdup (p2->dictionary_owner_soft);
-                        }
-                        if (p2->material != NULL)
-                        {
-                                line->material = strdup (p2->material);
+                                line->dictionary_owner_soft = dxf_strdup (p2->dictionary_owner_soft);
                         }
                         if (p2->dictionary_owner_hard != NULL)
                         {
-                                line->dictionary_owner_hard = strdup (p2->dictionary_owner_hard);
-                        }
-                        line->lineweight = p2->lineweight;
-                        if (p2->plot_style_name != NULL)
-                        {
-                                line->plot_style_name = strdup (p2->plot_style_name);
-                        }
-                        line->color_value = p2->color_value;
-                        if (p2->color_name != NULL)
-                        {
-                                line->color_name = strdup (p2->color_name);
+                                line->dictionary_owner_hard = dxf_strdup (p2->dictionary_owner_hard);
                         }
-                        line->transparency = p2->transparency;
                         break;
                 default:
                         fprintf (stderr,
@@ -40,6 +40,8 @@
 
 
 #include "ltype.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -112,13 +114,13 @@ dxf_ltype_init
               return (NULL);
         }
         dxf_ltype_set_id_code (ltype, 0);
-        dxf_ltype_set_linetype_name (ltype, strdup (""));
-        dxf_ltype_set_description (ltype, strdup (""));
+        dxf_ltype_set_linetype_name (ltype, "");
+        dxf_ltype_set_description (ltype, "");
         dxf_ltype_set_total_pattern_length (ltype, 0.0);
         dxf_ltype_set_number_of_linetype_elements (ltype, 0);
-        for ((i = 0); (i <= DXF_MAX_NUMBER_OF_DASH_LENGTH_ITEMS); i++)
+        for (i = 0; i < DXF_MAX_NUMBER_OF_DASH_LENGTH_ITEMS; i++)
         {
-                dxf_ltype_set_complex_text_string (ltype, i, strdup (""));
+                dxf_ltype_set_complex_text_string (ltype, i, "");
                 dxf_ltype_set_complex_x_offset (ltype, i, 0.0);
                 dxf_ltype_set_complex_y_offset (ltype, i, 0.0);
                 dxf_ltype_set_complex_scale (ltype, i, 0.0);
@@ -126,12 +128,12 @@ dxf_ltype_init
                 dxf_ltype_set_complex_rotation (ltype, i, 0.0);
                 dxf_ltype_set_complex_element (ltype, i, 1);
                 dxf_ltype_set_complex_shape_number (ltype, i, 0);
-                dxf_ltype_set_complex_style_pointer (ltype, i, strdup (""));
+                dxf_ltype_set_complex_style_pointer (ltype, i, "");
         }
         dxf_ltype_set_flag (ltype, 0);
         dxf_ltype_set_alignment (ltype, 65);
-        dxf_ltype_set_dictionary_owner_soft (ltype, strdup (""));
-        dxf_ltype_set_dictionary_owner_hard (ltype, strdup (""));
+        dxf_ltype_set_dictionary_owner_soft (ltype, "");
+        dxf_ltype_set_dictionary_owner_hard (ltype, "");
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -162,7 +164,8 @@ dxf_ltype_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfPair pair;
         int element;
 
         /* Do some basic checks. */
@@ -171,8 +174,6 @@ dxf_ltype_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (ltype == NULL)
@@ -184,172 +185,140 @@ dxf_ltype_read
                 ltype = dxf_ltype_init (ltype);
         }
         element = 0;
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        fclose (fp->fp);
-                        /* Clean up. */
-                        free (temp_string);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &ltype->id_code);
-                }
-                else if (strcmp (temp_string, "2") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", ltype->linetype_name);
-                }
-                else if (strcmp (temp_string, "3") == 0)
-                {
-                        /* Now follows a string containing a description. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", ltype->description);
-                }
-                else if (strcmp (temp_string, "9") == 0)
-                {
-                        /* Now follows a string containing a complex
-                         * text string (multiple entries possible). */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", ltype->complex_text_string[element]);
-                }
-                else if (strcmp (temp_string, "40") == 0)
-                {
-                        /* Now follows a string containing the total
-                         * pattern length value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ltype->total_pattern_length);
-                }
-                else if (strcmp (temp_string, "44") == 0)
-                {
-                        /* Now follows a string containing a complex
-                         * x offset value (multiple entries possible). */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ltype->complex_x_offset[element]);
-                }
-                else if (strcmp (temp_string, "45") == 0)
-                {
-                        /* Now follows a string containing a complex
-                         * y offset value (multiple entries possible). */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ltype->complex_y_offset[element]);
-                }
-                else if (strcmp (temp_string, "46") == 0)
-                {
-                        /* Now follows a string containing a complex
-                         * scale value (multiple entries possible). */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ltype->complex_scale[element]);
-                }
-                else if (strcmp (temp_string, "49") == 0)
-                {
-                        /* Now follows a string containing a dash length
-                         * value (multiple entries possible). */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ltype->dash_length[element]);
-                        element++;
-                        /*! \todo We are assuming that 49 is the first
-                         * group code that is encountered for each
-                         * element in the linetype definition.\n
-                         * This assumption breaks the "rule" of parsing
-                         * the dxf file regardless the order in which
-                         * group codes appear within an entity.
-                         */
-                }
-                else if (strcmp (temp_string, "50") == 0)
-                {
-                        /* Now follows a string containing a complex
-                         * rotation value (multiple entries possible). */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ltype->complex_rotation[element]);
-                }
-                else if (strcmp (temp_string, "70") == 0)
-                {
-                        /* Now follows a string containing the
-                         * standard flag value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &ltype->flag);
-                }
-                else if (strcmp (temp_string, "72") == 0)
-                {
-                        /* Now follows a string containing the
-                         * alignment value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &ltype->alignment);
-                }
-                else if (strcmp (temp_string, "73") == 0)
-                {
-                        /* Now follows a string containing the number of
-                         * dash length items value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &ltype->number_of_linetype_elements);
-                }
-                else if (strcmp (temp_string, "74") == 0)
-                {
-                        /* Now follows a string containing a complex
-                         * element value (multiple entries possible). */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &ltype->complex_element[element]);
-                }
-                else if (strcmp (temp_string, "75") == 0)
-                {
-                        /* Now follows a string containing a complex
-                         * element value (multiple entries possible). */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &ltype->complex_shape_number[element]);
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", ltype->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "340") == 0)
-                {
-                        /* Now follows a string containing a complex
-                         * style pointer string (multiple entries possible). */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", ltype->complex_style_pointer[element]);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", ltype->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "999") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else
+                switch (pair.group_code)
                 {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                ltype->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 2:
+                                /* Now follows a string containing a linetype
+                                 * name. */
+                                free (ltype->linetype_name);
+                                ltype->linetype_name = dxf_pair_get_string (&pair);
+                                break;
+                        case 3:
+                                /* Now follows a string containing a description. */
+                                free (ltype->description);
+                                ltype->description = dxf_pair_get_string (&pair);
+                                break;
+                        case 9:
+                                /* Now follows a string containing a complex
+                                 * text string (multiple entries possible). */
+                                free (ltype->complex_text_string[element]);
+                                ltype->complex_text_string[element] = dxf_pair_get_string (&pair);
+                                break;
+                        case 40:
+                                /* Now follows a string containing the total
+                                 * pattern length value. */
+                                ltype->total_pattern_length = dxf_pair_get_double (&pair);
+                                break;
+                        case 44:
+                                /* Now follows a string containing a complex
+                                 * x offset value (multiple entries possible). */
+                                ltype->complex_x_offset[element] = dxf_pair_get_double (&pair);
+                                break;
+                        case 45:
+                                /* Now follows a string containing a complex
+                                 * y offset value (multiple entries possible). */
+                                ltype->complex_y_offset[element] = dxf_pair_get_double (&pair);
+                                break;
+                        case 46:
+                                /* Now follows a string containing a complex
+                                 * scale value (multiple entries possible). */
+                                ltype->complex_scale[element] = dxf_pair_get_double (&pair);
+                                break;
+                        case 49:
+                                /* Now follows a string containing a dash length
+                                 * value (multiple entries possible). */
+                                ltype->dash_length[element] = dxf_pair_get_double (&pair);
+                                if (element < DXF_MAX_NUMBER_OF_DASH_LENGTH_ITEMS - 1)
+                                {
+                                        element++;
+                                }
+                                /*! \todo We are assuming that 49 is the first
+                                 * group code that is encountered for each
+                                 * element in the linetype definition.\n
+                                 * This assumption breaks the "rule" of parsing
+                                 * the dxf file regardless the order in which
+                                 * group codes appear within an entity.
+                                 */
+                                break;
+                        case 50:
+                                /* Now follows a string containing a complex
+                                 * rotation value (multiple entries possible). */
+                                ltype->complex_rotation[element] = dxf_pair_get_double (&pair);
+                                break;
+                        case 70:
+                                /* Now follows a string containing the
+                                 * standard flag value. */
+                                ltype->flag = dxf_pair_get_int (&pair);
+                                break;
+                        case 72:
+                                /* Now follows a string containing the
+                                 * alignment value. */
+                                ltype->alignment = dxf_pair_get_int (&pair);
+                                break;
+                        case 73:
+                                /* Now follows a string containing the number of
+                                 * dash length items value. */
+                                ltype->number_of_linetype_elements = dxf_pair_get_int (&pair);
+                                break;
+                        case 74:
+                                /* Now follows a string containing a complex
+                                 * element value (multiple entries possible). */
+                                ltype->complex_element[element] = dxf_pair_get_int (&pair);
+                                break;
+                        case 75:
+                                /* Now follows a string containing a complex
+                                 * element value (multiple entries possible). */
+                                ltype->complex_shape_number[element] = dxf_pair_get_int (&pair);
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner dictionary. */
+                                free (ltype->dictionary_owner_soft);
+                                ltype->dictionary_owner_soft = dxf_pair_get_string (&pair);
+                                break;
+                        case 340:
+                                /* Now follows a string containing a complex
+                                 * style pointer string (multiple entries possible). */
+                                free (ltype->complex_style_pointer[element]);
+                                ltype->complex_style_pointer[element] = dxf_pair_get_string (&pair);
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                free (ltype->dictionary_owner_hard);
+                                ltype->dictionary_owner_hard = dxf_pair_get_string (&pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, "DXF comment: %s\n", temp_string);
+                                break;
+                        default:
+                                fprintf (stderr,
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
+                                  __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
         /* Handle omitted members and/or illegal values. */
         if (strcmp (ltype->linetype_name, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Error in %s (): empty linetype name string for the entity with id-code: %x\n")),
+                  (_("Error in %s (): empty linetype name string for the entity with id-code: %lx\n")),
                   __FUNCTION__, ltype->id_code);
                 fprintf (stderr,
                   (_("\tentity is discarded from output.\n")));
@@ -359,8 +328,6 @@ dxf_ltype_read
         {
                 ltype->alignment = 65;
         }
-        /* Clean up. */
-        free (temp_string);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -411,7 +378,7 @@ dxf_ltype_write
         if (strcmp (ltype->linetype_name, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s (): empty linetype name string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s (): empty linetype name string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_ltype_get_id_code (ltype));
                 fprintf (stderr,
                   (_("\t%s entity is discarded from output.\n")),
@@ -421,10 +388,10 @@ dxf_ltype_write
                 return (EXIT_FAILURE);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
-        if (dxf_ltype_get_id_code (ltype) != -1)
+        dxf_write_string (fp, 0, dxf_entity_name);
+        if (ltype->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", dxf_ltype_get_id_code (ltype));
+                dxf_write_hex (fp, 5, dxf_ltype_get_id_code (ltype));
         }
         /*!
          * \todo for version R14.\n
@@ -439,109 +406,109 @@ dxf_ltype_write
         if ((strcmp (dxf_ltype_get_dictionary_owner_soft (ltype), "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", dxf_ltype_get_dictionary_owner_soft (ltype));
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, dxf_ltype_get_dictionary_owner_soft (ltype));
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (dxf_ltype_get_dictionary_owner_hard (ltype), "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", dxf_ltype_get_dictionary_owner_hard (ltype));
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, dxf_ltype_get_dictionary_owner_hard (ltype));
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_14)
         {
-                fprintf (fp->fp, "100\nAcDbSymbolTableRecord\n");
-                fprintf (fp->fp, "100\nAcDbLinetypeTableRecord\n");
+                dxf_write_string (fp, 100, "AcDbSymbolTableRecord");
+                dxf_write_string (fp, 100, "AcDbLinetypeTableRecord");
         }
-        fprintf (fp->fp, "  2\n%s\n", dxf_ltype_get_linetype_name (ltype));
-        fprintf (fp->fp, " 70\n%d\n", dxf_ltype_get_flag (ltype));
+        dxf_write_string (fp, 2, dxf_ltype_get_linetype_name (ltype));
+        dxf_write_int (fp, 70, dxf_ltype_get_flag (ltype));
         if (ltype->description)
         {
-                fprintf (fp->fp, "  3\n%s\n", dxf_ltype_get_description (ltype));
+                dxf_write_string (fp, 3, dxf_ltype_get_description (ltype));
         }
         else
         {
-                fprintf (fp->fp, "  3\n\n");
+                dxf_write_string (fp, 3, "");
         }
-        fprintf (fp->fp, " 72\n%d\n", dxf_ltype_get_alignment (ltype));
-        fprintf (fp->fp, " 73\n%d\n", dxf_ltype_get_number_of_linetype_elements (ltype));
-        fprintf (fp->fp, " 40\n%f\n", dxf_ltype_get_total_pattern_length (ltype));
+        dxf_write_int (fp, 72, dxf_ltype_get_alignment (ltype));
+        dxf_write_int (fp, 73, dxf_ltype_get_number_of_linetype_elements (ltype));
+        dxf_write_double (fp, 40, dxf_ltype_get_total_pattern_length (ltype));
         for ((i = 0); (i < dxf_ltype_get_number_of_linetype_elements (ltype)); i++)
         {
-                fprintf (fp->fp, " 49\n%f\n", dxf_ltype_get_dash_length (ltype, i));
-                fprintf (fp->fp, " 74\n%d\n", dxf_ltype_get_complex_element (ltype, i));
+                dxf_write_double (fp, 49, dxf_ltype_get_dash_length (ltype, i));
+                dxf_write_int (fp, 74, dxf_ltype_get_complex_element (ltype, i));
                 switch (dxf_ltype_get_complex_element (ltype, i))
                 {
                         case 0:
                                 /* No embedded shape/text. */
-                                fprintf (fp->fp, " 44\n%f\n", dxf_ltype_get_complex_x_offset (ltype, i));
-                                fprintf (fp->fp, " 45\n%f\n", dxf_ltype_get_complex_y_offset (ltype, i));
-                                fprintf (fp->fp, " 46\n%f\n", dxf_ltype_get_complex_scale (ltype, i));
-                                fprintf (fp->fp, " 75\n0\n");
+                                dxf_write_double (fp, 44, dxf_ltype_get_complex_x_offset (ltype, i));
+                                dxf_write_double (fp, 45, dxf_ltype_get_complex_y_offset (ltype, i));
+                                dxf_write_double (fp, 46, dxf_ltype_get_complex_scale (ltype, i));
+                                dxf_write_string (fp, 75, "0");
                                 break;
                         case 1:
                                 /* Specify an absolute rotation. */
-                                fprintf (fp->fp, " 44\n%f\n", dxf_ltype_get_complex_x_offset (ltype, i));
-                                fprintf (fp->fp, " 45\n%f\n", dxf_ltype_get_complex_y_offset (ltype, i));
-                                fprintf (fp->fp, " 46\n%f\n", dxf_ltype_get_complex_scale (ltype, i));
-                                fprintf (fp->fp, " 75\n0\n");
-                                fprintf (fp->fp, "340\n%s\n", dxf_ltype_get_complex_style_pointer (ltype, i));
+                                dxf_write_double (fp, 44, dxf_ltype_get_complex_x_offset (ltype, i));
+                                dxf_write_double (fp, 45, dxf_ltype_get_complex_y_offset (ltype, i));
+                                dxf_write_double (fp, 46, dxf_ltype_get_complex_scale (ltype, i));
+                                dxf_write_string (fp, 75, "0");
+                                dxf_write_string (fp, 340, dxf_ltype_get_complex_style_pointer (ltype, i));
                                 break;
                         case 2:
                                 /*
                                  * The complex is a text string.
                                  * Use a relative rotation angle.
                                  */
-                                fprintf (fp->fp, "  9\n%s\n", dxf_ltype_get_complex_text_string (ltype, i));
-                                fprintf (fp->fp, " 44\n%f\n", dxf_ltype_get_complex_x_offset (ltype, i));
-                                fprintf (fp->fp, " 45\n%f\n", dxf_ltype_get_complex_y_offset (ltype, i));
-                                fprintf (fp->fp, " 46\n%f\n", dxf_ltype_get_complex_scale (ltype, i));
-                                fprintf (fp->fp, " 50\n%f\n", dxf_ltype_get_complex_rotation (ltype, i));
-                                fprintf (fp->fp, " 75\n0\n");
-                                fprintf (fp->fp, "340\n%s\n", dxf_ltype_get_complex_style_pointer (ltype, i));
+                                dxf_write_string (fp, 9, dxf_ltype_get_complex_text_string (ltype, i));
+                                dxf_write_double (fp, 44, dxf_ltype_get_complex_x_offset (ltype, i));
+                                dxf_write_double (fp, 45, dxf_ltype_get_complex_y_offset (ltype, i));
+                                dxf_write_double (fp, 46, dxf_ltype_get_complex_scale (ltype, i));
+                                dxf_write_double (fp, 50, dxf_ltype_get_complex_rotation (ltype, i));
+                                dxf_write_string (fp, 75, "0");
+                                dxf_write_string (fp, 340, dxf_ltype_get_complex_style_pointer (ltype, i));
                                 break;
                         case 3:
                                 /*
                                  * The complex is a text string.
                                  * Use an absolute rotation angle.
                                  */
-                                fprintf (fp->fp, "  9\n%s\n", dxf_ltype_get_complex_text_string (ltype, i));
-                                fprintf (fp->fp, " 44\n%f\n", dxf_ltype_get_complex_x_offset (ltype, i));
-                                fprintf (fp->fp, " 45\n%f\n", dxf_ltype_get_complex_y_offset (ltype, i));
-                                fprintf (fp->fp, " 46\n%f\n", dxf_ltype_get_complex_scale (ltype, i));
-                                fprintf (fp->fp, " 50\n%f\n", dxf_ltype_get_complex_rotation (ltype, i));
-                                fprintf (fp->fp, " 75\n0\n");
-                                fprintf (fp->fp, "340\n%s\n", dxf_ltype_get_complex_style_pointer (ltype, i));
+                                dxf_write_string (fp, 9, dxf_ltype_get_complex_text_string (ltype, i));
+                                dxf_write_double (fp, 44, dxf_ltype_get_complex_x_offset (ltype, i));
+                                dxf_write_double (fp, 45, dxf_ltype_get_complex_y_offset (ltype, i));
+                                dxf_write_double (fp, 46, dxf_ltype_get_complex_scale (ltype, i));
+                                dxf_write_double (fp, 50, dxf_ltype_get_complex_rotation (ltype, i));
+                                dxf_write_string (fp, 75, "0");
+                                dxf_write_string (fp, 340, dxf_ltype_get_complex_style_pointer (ltype, i));
                                 break;
                         case 4:
                                 /*
                                  * The complex is a shape.
                                  * Use a relative rotation angle.
                                  */
-                                fprintf (fp->fp, " 44\n%f\n", dxf_ltype_get_complex_x_offset (ltype, i));
-                                fprintf (fp->fp, " 45\n%f\n", dxf_ltype_get_complex_y_offset (ltype, i));
-                                fprintf (fp->fp, " 46\n%f\n", dxf_ltype_get_complex_scale (ltype, i));
-                                fprintf (fp->fp, " 50\n%f\n", dxf_ltype_get_complex_rotation (ltype, i));
-                                fprintf (fp->fp, " 75\n%d\n", dxf_ltype_get_complex_shape_number (ltype, i));
-                                fprintf (fp->fp, "340\n%s\n", dxf_ltype_get_complex_style_pointer (ltype, i));
+                                dxf_write_double (fp, 44, dxf_ltype_get_complex_x_offset (ltype, i));
+                                dxf_write_double (fp, 45, dxf_ltype_get_complex_y_offset (ltype, i));
+                                dxf_write_double (fp, 46, dxf_ltype_get_complex_scale (ltype, i));
+                                dxf_write_double (fp, 50, dxf_ltype_get_complex_rotation (ltype, i));
+                                dxf_write_int (fp, 75, dxf_ltype_get_complex_shape_number (ltype, i));
+                                dxf_write_string (fp, 340, dxf_ltype_get_complex_style_pointer (ltype, i));
                                 break;
                         case 5:
                                 /*
                                  * The complex is a shape.
                                  * Use an absolute rotation angle.
                                  */
-                                fprintf (fp->fp, " 44\n%f\n", dxf_ltype_get_complex_x_offset (ltype, i));
-                                fprintf (fp->fp, " 45\n%f\n", dxf_ltype_get_complex_y_offset (ltype, i));
-                                fprintf (fp->fp, " 46\n%f\n", dxf_ltype_get_complex_scale (ltype, i));
-                                fprintf (fp->fp, " 50\n%f\n", dxf_ltype_get_complex_rotation (ltype, i));
-                                fprintf (fp->fp, " 75\n%d\n", dxf_ltype_get_complex_shape_number (ltype, i));
-                                fprintf (fp->fp, "340\n%s\n", dxf_ltype_get_complex_style_pointer (ltype, i));
+                                dxf_write_double (fp, 44, dxf_ltype_get_complex_x_offset (ltype, i));
+                                dxf_write_double (fp, 45, dxf_ltype_get_complex_y_offset (ltype, i));
+                                dxf_write_double (fp, 46, dxf_ltype_get_complex_scale (ltype, i));
+                                dxf_write_double (fp, 50, dxf_ltype_get_complex_rotation (ltype, i));
+                                dxf_write_int (fp, 75, dxf_ltype_get_complex_shape_number (ltype, i));
+                                dxf_write_string (fp, 340, dxf_ltype_get_complex_style_pointer (ltype, i));
                                 break;
                         default:
                                 fprintf (stderr,
-                                  (_("Warning in %s (): unknown complex element code for the %s entity with id-code: %x\n")),
+                                  (_("Warning in %s (): unknown complex element code for the %s entity with id-code: %lx\n")),
                                   __FUNCTION__, dxf_entity_name, dxf_ltype_get_id_code (ltype));
                                 break;
                 }
@@ -582,15 +549,15 @@ dxf_ltype_free
                 __FUNCTION__);
               return (EXIT_FAILURE);
         }
-        free (dxf_ltype_get_linetype_name (ltype));
-        free (dxf_ltype_get_description (ltype));
-        for ((i = 0); (i <= DXF_MAX_NUMBER_OF_DASH_LENGTH_ITEMS); i++)
+        free (ltype->linetype_name);
+        free (ltype->description);
+        for (i = 0; i < DXF_MAX_NUMBER_OF_DASH_LENGTH_ITEMS; i++)
         {
-                free (dxf_ltype_get_complex_text_string (ltype, i));
-                free (dxf_ltype_get_complex_style_pointer (ltype, i));
+                free (ltype->complex_text_string[i]);
+                free (ltype->complex_style_pointer[i]);
         }
-        free (dxf_ltype_get_dictionary_owner_soft (ltype));
-        free (dxf_ltype_get_dictionary_owner_hard (ltype));
+        free (ltype->dictionary_owner_soft);
+        free (ltype->dictionary_owner_hard);
         free (ltype);
         ltype = NULL;
 #if DEBUG
@@ -612,7 +579,7 @@ dxf_ltype_free_chain
                  * entries. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (ltypes == NULL)
@@ -624,6 +591,7 @@ dxf_ltype_free_chain
         while (ltypes != NULL)
         {
                 struct DxfLType *iter = ltypes->next;
+                ltypes->next = NULL;
                 dxf_ltype_free (ltypes);
                 ltypes = (DxfLType *) iter;
         }
@@ -638,7 +606,7 @@ dxf_ltype_free_chain
  *
  * \return ID code.
  */
-int
+long
 dxf_ltype_get_id_code
 (
         DxfLType *ltype
@@ -678,7 +646,7 @@ dxf_ltype_set_id_code
 (
         DxfLType *ltype,
                 /*!< a pointer to a DXF \c LTYPE entity. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -57,7 +57,7 @@ extern "C" {
 typedef struct
 dxf_ltype_struct
 {
-        int id_code;
+        long id_code;
                 /*!< Entity handle; text string of up to 16 hexadecimal
                  * digits (fixed).\n
                  * Group code = 5. */
@@ -182,7 +182,7 @@ dxf_ltype_free_chain
 (
         DxfLType *ltypes
 );
-int
+long
 dxf_ltype_get_id_code
 (
         DxfLType *ltype
@@ -191,7 +191,7 @@ DxfLType *
 dxf_ltype_set_id_code
 (
         DxfLType *ltype,
-        int id_code
+        long id_code
 );
 char *
 dxf_ltype_get_linetype_name
@@ -36,6 +36,9 @@
 
 
 #include "lwpolyline.h"
+#include "arena.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -63,7 +66,7 @@ dxf_lwpolyline_new ()
         size = sizeof (DxfLWPolyline);
         /* avoid malloc of 0 bytes */
         if (size == 0) size = 1;
-        if ((lwpolyline = malloc (size)) == NULL)
+        if ((lwpolyline = dxf_malloc (size)) == NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () could not allocate memory for a DxfLWPolyline struct.\n")),
@@ -120,23 +123,17 @@ dxf_lwpolyline_init
               return (NULL);
         }
         lwpolyline->id_code = 0;
-        lwpolyline->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        lwpolyline->layer = strdup (DXF_DEFAULT_LAYER);
-        lwpolyline->elevation = 0.0;
-        lwpolyline->thickness = 0.0;
-        lwpolyline->linetype_scale = DXF_DEFAULT_LINETYPE_SCALE;
-        lwpolyline->visibility = DXF_DEFAULT_VISIBILITY;
+        lwpolyline->properties = dxf_graphic_properties_default ();
         lwpolyline->constant_width = 0.0;
-        lwpolyline->color = DXF_COLOR_BYLAYER;
-        lwpolyline->paperspace = DXF_MODELSPACE;
         lwpolyline->flag = 0;
         lwpolyline->number_vertices = 0;
         lwpolyline->extr_x0 = 0.0;
         lwpolyline->extr_y0 = 0.0;
         lwpolyline->extr_z0 = 0.0;
-        lwpolyline->dictionary_owner_soft = strdup ("");
-        lwpolyline->dictionary_owner_hard = strdup ("");
-        lwpolyline->vertices = (struct DxfVertex *) dxf_vertex_new ();
+        lwpolyline->dictionary_owner_soft = dxf_strdup ("");
+        lwpolyline->dictionary_owner_hard = dxf_strdup ("");
+        dxf_vertex_array_init (&lwpolyline->packed_vertices, 2);
+        lwpolyline->vertices = NULL;
         lwpolyline->next = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -174,8 +171,11 @@ dxf_lwpolyline_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
-        DxfVertex *iter = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfGraphicProperties properties;
+        DxfPair pair;
+        DxfVertexArray *vertices = NULL;
+        int last = -1;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -183,8 +183,6 @@ dxf_lwpolyline_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (lwpolyline == NULL)
@@ -195,219 +193,195 @@ dxf_lwpolyline_read
                 lwpolyline = dxf_lwpolyline_new ();
                 lwpolyline = dxf_lwpolyline_init (lwpolyline);
         }
-        iter = (DxfVertex *) lwpolyline->vertices;
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        vertices = &lwpolyline->packed_vertices;
+        dxf_graphic_properties_start (&properties, lwpolyline->properties);
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        fclose (fp->fp);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &lwpolyline->id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", lwpolyline->linetype);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", lwpolyline->layer);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                        * X-coordinate of a vertex. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &iter->x0);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                        * Y-coordinate of a vertex. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &iter->y0);
-                }
-                else if ((fp->acad_version_number <= AutoCAD_11)
-                        && (strcmp (temp_string, "38") == 0)
-                        && (lwpolyline->elevation != 0.0))
-                {
-                        /* Now follows a string containing the
-                         * elevation. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &lwpolyline->elevation);
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &lwpolyline->thickness);
-                }
-                else if (strcmp (temp_string, "40") == 0)
-                {
-                        /* Now follows a string containing the
-                         * start width of the vertex. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &iter->start_width);
-                }
-                else if (strcmp (temp_string, "41") == 0)
-                {
-                        /* Now follows a string containing the
-                         * start width of the vertex. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &iter->end_width);
-                }
-                else if (strcmp (temp_string, "42") == 0)
-                {
-                        /* Now follows a string containing the bulge of
-                         * the vertex. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &iter->bulge);
-                        /* The last member of the vertex is read.\n */
-                        /*! \todo The pointer administration needs to be checked for functionality. */
-                         /* Increment iter to next DxfVertex. */
-                        iter->next = (struct DxfVertex *) dxf_vertex_new ();
-                        iter = (DxfVertex *) iter->next;
-                }
-                else if (strcmp (temp_string, "43") == 0)
-                {
-                        /* Now follows a string containing the
-                         * constant width. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &lwpolyline->constant_width);
-                }
-                else if (strcmp (temp_string, "48") == 0)
-                {
-                        /* Now follows a string containing the linetype
-                         * scale. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &lwpolyline->linetype_scale);
-                }
-                else if (strcmp (temp_string, "60") == 0)
-                {
-                        /* Now follows a string containing the
-                         * visibility value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &lwpolyline->visibility);
-                }
-                else if (strcmp (temp_string, "62") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &lwpolyline->color);
-                }
-                else if (strcmp (temp_string, "67") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &lwpolyline->paperspace);
-                }
-                else if (strcmp (temp_string, "70") == 0)
-                {
-                        /* Now follows a string containing the
-                         * flag value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &lwpolyline->flag);
-                }
-                else if (strcmp (temp_string, "90") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing the number
-                         * of following vertices. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &lwpolyline->number_vertices);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else if ((fp->acad_version_number >= AutoCAD_12)
-                        && (strcmp (temp_string, "100") == 0))
+                switch (pair.group_code)
                 {
-                        /* Subclass markers are post AutoCAD R12
-                         * variable so additional testing for the
-                         * version should probably be added here.
-                         * Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                }
-                else if (strcmp (temp_string, "210") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &lwpolyline->extr_x0);
-                }
-                else if (strcmp (temp_string, "220") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &lwpolyline->extr_y0);
-                }
-                else if (strcmp (temp_string, "230") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &lwpolyline->extr_z0);
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", lwpolyline->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", lwpolyline->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                lwpolyline->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 6:
+                                /* Now follows a string containing a linetype
+                                 * name. */
+                                dxf_lexer_free_string (fp, properties.linetype);
+                                properties.linetype = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 8:
+                                /* Now follows a string containing a layer name. */
+                                dxf_lexer_free_string (fp, properties.layer);
+                                properties.layer = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 10:
+                                /* Now follows a string containing the
+                                * X-coordinate of a vertex, which starts
+                                * the vertex. */
+                                last = dxf_vertex_array_append (vertices,
+                                  dxf_pair_get_double (&pair), 0.0, 0.0, 0.0);
+                                break;
+                        case 20:
+                                /* Now follows a string containing the
+                                * Y-coordinate of a vertex. */
+                                if (last >= 0)
+                                {
+                                        vertices->y0[last] = dxf_pair_get_double (&pair);
+                                }
+                                break;
+                        case 38:
+                                if ((fp->acad_version_number <= AutoCAD_11)
+                                  && (properties.elevation != 0.0))
+                                {
+                                        /* Now follows a string containing the
+                                         * elevation. */
+                                        properties.elevation = dxf_pair_get_double (&pair);
+                                }
+                                break;
+                        case 39:
+                                /* Now follows a string containing the
+                                 * thickness. */
+                                properties.thickness = dxf_pair_get_double (&pair);
+                                break;
+                        case 40:
+                                /* Now follows a string containing the
+                                 * start width of the vertex. */
+                                if (last >= 0)
+                                {
+                                        dxf_vertex_array_set_widths (vertices, last,
+                                          dxf_pair_get_double (&pair),
+                                          (vertices->end_width != NULL) ? vertices->end_width[last] : 0.0);
+                                }
+                                break;
+                        case 41:
+                                /* Now follows a string containing the
+                                 * end width of the vertex. */
+                                if (last >= 0)
+                                {
+                                        dxf_vertex_array_set_widths (vertices, last,
+                                          (vertices->start_width != NULL) ? vertices->start_width[last] : 0.0,
+                                          dxf_pair_get_double (&pair));
+                                }
+                                break;
+                        case 42:
+                                /* Now follows a string containing the bulge of
+                                 * the vertex. */
+                                if (last >= 0)
+                                {
+                                        vertices->bulge[last] = dxf_pair_get_double (&pair);
+                                }
+                                break;
+                        case 43:
+                                /* Now follows a string containing the
+                                 * constant width. */
+                                lwpolyline->constant_width = dxf_pair_get_double (&pair);
+                                break;
+                        case 48:
+                                /* Now follows a string containing the linetype
+                                 * scale. */
+                                properties.linetype_scale = dxf_pair_get_double (&pair);
+                                break;
+                        case 60:
+                                /* Now follows a string containing the
+                                 * visibility value. */
+                                properties.visibility = dxf_pair_get_int (&pair);
+                                break;
+                        case 62:
+                                /* Now follows a string containing the
+                                 * color value. */
+                                properties.color = dxf_pair_get_int (&pair);
+                                break;
+                        case 67:
+                                /* Now follows a string containing the
+                                 * paperspace value. */
+                                properties.paperspace = dxf_pair_get_int (&pair);
+                                break;
+                        case 70:
+                                /* Now follows a string containing the
+                                 * flag value. */
+                                lwpolyline->flag = dxf_pair_get_int (&pair);
+                                break;
+                        case 90:
+                                /* Now follows a string containing the number
+                                 * of following vertices. */
+                                lwpolyline->number_vertices = dxf_pair_get_int (&pair);
+                                dxf_vertex_array_reserve (vertices,
+                                  lwpolyline->number_vertices);
+                                break;
+                        case 100:
+                                if (fp->acad_version_number >= AutoCAD_12)
+                                {
+                                        /* Subclass markers are post AutoCAD R12
+                                         * variable so additional testing for the
+                                         * version should probably be added here.
+                                         * Now follows a string containing the
+                                         * subclass marker value. */
+                                        dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                }
+                                break;
+                        case 210:
+                                /* Now follows a string containing the
+                                 * X-value of the extrusion vector. */
+                                lwpolyline->extr_x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 220:
+                                /* Now follows a string containing the
+                                 * Y-value of the extrusion vector. */
+                                lwpolyline->extr_y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 230:
+                                /* Now follows a string containing the
+                                 * Z-value of the extrusion vector. */
+                                lwpolyline->extr_z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, lwpolyline->dictionary_owner_soft);
+                                lwpolyline->dictionary_owner_soft = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, lwpolyline->dictionary_owner_hard);
+                                lwpolyline->dictionary_owner_hard = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, "DXF comment: %s\n", temp_string);
+                                break;
+                        default:
+                                fprintf (stderr,
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
+                                  __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
-        /*! \todo Free memory to the last (unused) vertex in the linked list. */
-
-        /* Set the pointer to the last (unused) vertex in the linked list to NULL. */
-        iter->next = NULL;
+        lwpolyline->number_vertices = vertices->count;
         /* Handle omitted members and/or illegal values. */
-        if (strcmp (lwpolyline->linetype, "") == 0)
+        if ((properties.linetype != NULL)
+          && (strcmp (properties.linetype, "") == 0))
         {
-                lwpolyline->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_lexer_free_string (fp, properties.linetype);
+                properties.linetype = dxf_strdup (DXF_DEFAULT_LINETYPE);
         }
-        if (strcmp (lwpolyline->layer, "") == 0)
+        if ((properties.layer != NULL)
+          && (strcmp (properties.layer, "") == 0))
         {
-                lwpolyline->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_lexer_free_string (fp, properties.layer);
+                properties.layer = dxf_strdup (DXF_DEFAULT_LAYER);
         }
-        /* Clean up. */
-        free (temp_string);
+        /* Entities with equal properties share a record. */
+        dxf_graphic_properties_finish (fp, &lwpolyline->properties, &properties);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -446,8 +420,9 @@ dxf_lwpolyline_write
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *dxf_entity_name = strdup ("LWPOLYLINE");
-        DxfVertex *iter = NULL;
+        char *dxf_entity_name = dxf_strdup ("LWPOLYLINE");
+        DxfVertexArray *vertices = NULL;
+        int i;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -456,7 +431,7 @@ dxf_lwpolyline_write
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (lwpolyline == NULL)
@@ -465,48 +440,48 @@ dxf_lwpolyline_write
                   (_("Error in %s () a NULL pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if ((fp->acad_version_number < AutoCAD_14)
           && (fp->follow_strict_version_rules))
         {
                 fprintf (stderr,
-                  (_("Error in %s () illegal DXF version for this %s entity with id-code: %x.\n")),
+                  (_("Error in %s () illegal DXF version for this %s entity with id-code: %lx.\n")),
                   __FUNCTION__, dxf_entity_name, lwpolyline->id_code);
                 return (EXIT_FAILURE);
         }
         else
         {
                 fprintf (stderr,
-                  (_("Warning in %s () illegal DXF version for this %s entity with id-code: %x.\n")),
+                  (_("Warning in %s () illegal DXF version for this %s entity with id-code: %lx.\n")),
                   __FUNCTION__, dxf_entity_name, lwpolyline->id_code);
         }
-        if (strcmp (lwpolyline->linetype, "") == 0)
+        if (strcmp (lwpolyline->properties->linetype, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, lwpolyline->id_code);
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                lwpolyline->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_lwpolyline_set_linetype (lwpolyline, DXF_DEFAULT_LINETYPE);
         }
-        if (strcmp (lwpolyline->layer, "") == 0)
+        if (strcmp (lwpolyline->properties->layer, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty layer string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty layer string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, lwpolyline->id_code);
                 fprintf (stderr,
                   (_("\t%s entity is relocated to layer 0\n")),
                   dxf_entity_name);
-                lwpolyline->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_lwpolyline_set_layer (lwpolyline, DXF_DEFAULT_LAYER);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_string (fp, 0, dxf_entity_name);
         if (lwpolyline->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", lwpolyline->id_code);
+                dxf_write_hex (fp, 5, lwpolyline->id_code);
         }
         /*!
          * \todo for version R14.\n
@@ -521,81 +496,82 @@ dxf_lwpolyline_write
         if ((strcmp (lwpolyline->dictionary_owner_soft, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", lwpolyline->dictionary_owner_soft);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, lwpolyline->dictionary_owner_soft);
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (lwpolyline->dictionary_owner_hard, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", lwpolyline->dictionary_owner_hard);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, lwpolyline->dictionary_owner_hard);
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbEntity\n");
+                dxf_write_string (fp, 100, "AcDbEntity");
         }
-        if (lwpolyline->paperspace == DXF_PAPERSPACE)
+        if (lwpolyline->properties->paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp->fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_int (fp, 67, DXF_PAPERSPACE);
         }
-        fprintf (fp->fp, "  8\n%s\n", lwpolyline->layer);
-        if (strcmp (lwpolyline->linetype, DXF_DEFAULT_LINETYPE) != 0)
+        dxf_write_string (fp, 8, lwpolyline->properties->layer);
+        if (strcmp (lwpolyline->properties->linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp->fp, "  6\n%s\n", lwpolyline->linetype);
+                dxf_write_string (fp, 6, lwpolyline->properties->linetype);
         }
-        if (lwpolyline->color != DXF_COLOR_BYLAYER)
+        if (lwpolyline->properties->color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp->fp, " 62\n%d\n", lwpolyline->color);
+                dxf_write_int (fp, 62, lwpolyline->properties->color);
         }
-        if (lwpolyline->linetype_scale != 1.0)
+        if (lwpolyline->properties->linetype_scale != 1.0)
         {
-                fprintf (fp->fp, " 48\n%f\n", lwpolyline->linetype_scale);
+                dxf_write_double (fp, 48, lwpolyline->properties->linetype_scale);
         }
-        if (lwpolyline->visibility != 0)
+        if (lwpolyline->properties->visibility != 0)
         {
-                fprintf (fp->fp, " 60\n%d\n", lwpolyline->visibility);
+                dxf_write_int (fp, 60, lwpolyline->properties->visibility);
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbPolyline\n");
+                dxf_write_string (fp, 100, "AcDbPolyline");
         }
-        fprintf (fp->fp, " 90\n%d\n", lwpolyline->number_vertices);
-        fprintf (fp->fp, " 70\n%d\n", lwpolyline->flag);
-        fprintf (fp->fp, " 43\n%f\n", lwpolyline->constant_width);
-        if (lwpolyline->elevation != 0.0)
+        vertices = &lwpolyline->packed_vertices;
+        dxf_write_int (fp, 90, vertices->count);
+        dxf_write_int (fp, 70, lwpolyline->flag);
+        dxf_write_double (fp, 43, lwpolyline->constant_width);
+        if (lwpolyline->properties->elevation != 0.0)
         {
-                fprintf (fp->fp, " 38\n%f\n", lwpolyline->elevation);
+                dxf_write_double (fp, 38, lwpolyline->properties->elevation);
         }
-        if (lwpolyline->thickness != 0.0)
+        if (lwpolyline->properties->thickness != 0.0)
         {
-                fprintf (fp->fp, " 39\n%f\n", lwpolyline->thickness);
+                dxf_write_double (fp, 39, lwpolyline->properties->thickness);
         }
         /* Start of writing (multiple) vertices. */
-        iter = (DxfVertex *) lwpolyline->vertices;
-        while (iter != NULL)
+        for (i = 0; i < vertices->count; i++)
         {
-                fprintf (fp->fp, " 10\n%f\n", iter->x0);
-                fprintf (fp->fp, " 20\n%f\n", iter->y0);
-                if ((iter->start_width != lwpolyline->constant_width)
-                  || (iter->end_width != lwpolyline->constant_width))
+                dxf_write_double (fp, 10, vertices->x0[i]);
+                dxf_write_double (fp, 20, vertices->y0[i]);
+                if (vertices->start_width != NULL)
+                {
+                        dxf_write_double (fp, 40, vertices->start_width[i]);
+                        dxf_write_double (fp, 41, vertices->end_width[i]);
+                }
+                if (vertices->bulge[i] != 0.0)
                 {
-                        fprintf (fp->fp, " 40\n%f\n", iter->start_width);
-                        fprintf (fp->fp, " 41\n%f\n", iter->end_width);
+                        dxf_write_double (fp, 42, vertices->bulge[i]);
                 }
-                fprintf (fp->fp, " 42\n%f\n", iter->bulge);
-                iter = (DxfVertex *) iter->next;
         }
         /* End of writing (multiple) vertices. */
         if (fp->acad_version_number >= AutoCAD_12)
         {
-                fprintf (fp->fp, "210\n%f\n", lwpolyline->extr_x0);
-                fprintf (fp->fp, "220\n%f\n", lwpolyline->extr_y0);
-                fprintf (fp->fp, "230\n%f\n", lwpolyline->extr_z0);
+                dxf_write_double (fp, 210, lwpolyline->extr_x0);
+                dxf_write_double (fp, 220, lwpolyline->extr_y0);
+                dxf_write_double (fp, 230, lwpolyline->extr_z0);
         }
         /* Clean up. */
-        free (dxf_entity_name);
+        dxf_free (dxf_entity_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -633,9 +609,13 @@ dxf_lwpolyline_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (lwpolyline->linetype);
-        free (lwpolyline->layer);
-        free (lwpolyline);
+        dxf_graphic_properties_free (lwpolyline->properties);
+        dxf_vertex_array_free (&lwpolyline->packed_vertices);
+        if (lwpolyline->vertices != NULL)
+        {
+                dxf_vertex_free_chain ((DxfVertex *) lwpolyline->vertices);
+        }
+        dxf_free (lwpolyline);
         lwpolyline = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -661,7 +641,7 @@ dxf_lwpolyline_free_chain
                 /*!< a pointer to the chain of DXF \c LWPOLYLINE entities. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (lwpolylines == NULL)
@@ -687,7 +667,7 @@ dxf_lwpolyline_free_chain
  *
  * \return ID code.
  */
-int
+long
 dxf_lwpolyline_get_id_code
 (
         DxfLWPolyline *lwpolyline
@@ -727,7 +707,7 @@ dxf_lwpolyline_set_id_code
 (
         DxfLWPolyline *lwpolyline,
                 /*!< a pointer to a DXF \c LWPOLYLINE entity. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -782,7 +762,7 @@ dxf_lwpolyline_get_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        if (lwpolyline->linetype ==  NULL)
+        if (lwpolyline->properties->linetype ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found.\n")),
@@ -792,7 +772,7 @@ dxf_lwpolyline_get_linetype
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (lwpolyline->linetype));
+        return (dxf_strdup (lwpolyline->properties->linetype));
 }
 
 
@@ -826,7 +806,12 @@ dxf_lwpolyline_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        lwpolyline->linetype = strdup (linetype);
+        if (dxf_graphic_properties_unshare (&lwpolyline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (lwpolyline->properties->linetype);
+        lwpolyline->properties->linetype = dxf_strdup (linetype);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -857,7 +842,7 @@ dxf_lwpolyline_get_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        if (lwpolyline->layer ==  NULL)
+        if (lwpolyline->properties->layer ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found.\n")),
@@ -867,7 +852,7 @@ dxf_lwpolyline_get_layer
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (lwpolyline->layer));
+        return (dxf_strdup (lwpolyline->properties->layer));
 }
 
 
@@ -901,7 +886,12 @@ dxf_lwpolyline_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        lwpolyline->layer = strdup (layer);
+        if (dxf_graphic_properties_unshare (&lwpolyline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (lwpolyline->properties->layer);
+        lwpolyline->properties->layer = dxf_strdup (layer);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -935,7 +925,7 @@ dxf_lwpolyline_get_elevation
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (lwpolyline->elevation);
+        return (lwpolyline->properties->elevation);
 }
 
 
@@ -962,7 +952,11 @@ dxf_lwpolyline_set_elevation
                   __FUNCTION__);
                 return (NULL);
         }
-        lwpolyline->elevation = elevation;
+        if (dxf_graphic_properties_unshare (&lwpolyline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        lwpolyline->properties->elevation = elevation;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -993,7 +987,7 @@ dxf_lwpolyline_get_thickness
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (lwpolyline->thickness < 0.0)
+        if (lwpolyline->properties->thickness < 0.0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found.\n")),
@@ -1003,7 +997,7 @@ dxf_lwpolyline_get_thickness
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (lwpolyline->thickness);
+        return (lwpolyline->properties->thickness);
 }
 
 
@@ -1037,7 +1031,11 @@ dxf_lwpolyline_set_thickness
                   __FUNCTION__);
                 return (NULL);
         }
-        lwpolyline->thickness = thickness;
+        if (dxf_graphic_properties_unshare (&lwpolyline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        lwpolyline->properties->thickness = thickness;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1068,7 +1066,7 @@ dxf_lwpolyline_get_linetype_scale
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (lwpolyline->linetype_scale < 0.0)
+        if (lwpolyline->properties->linetype_scale < 0.0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found.\n")),
@@ -1078,7 +1076,7 @@ dxf_lwpolyline_get_linetype_scale
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (lwpolyline->linetype_scale);
+        return (lwpolyline->properties->linetype_scale);
 }
 
 
@@ -1112,7 +1110,11 @@ dxf_lwpolyline_set_linetype_scale
                   __FUNCTION__);
                 return (NULL);
         }
-        lwpolyline->linetype_scale = linetype_scale;
+        if (dxf_graphic_properties_unshare (&lwpolyline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        lwpolyline->properties->linetype_scale = linetype_scale;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1143,14 +1145,14 @@ dxf_lwpolyline_get_visibility
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (lwpolyline->visibility < 0)
+        if (lwpolyline->properties->visibility < 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (lwpolyline->visibility > 1)
+        if (lwpolyline->properties->visibility > 1)
         {
                 fprintf (stderr,
                   (_("Error in %s () an out of range value was found.\n")),
@@ -1160,7 +1162,7 @@ dxf_lwpolyline_get_visibility
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (lwpolyline->visibility);
+        return (lwpolyline->properties->visibility);
 }
 
 
@@ -1201,7 +1203,11 @@ dxf_lwpolyline_set_visibility
                   __FUNCTION__);
                 return (NULL);
         }
-        lwpolyline->visibility = visibility;
+        if (dxf_graphic_properties_unshare (&lwpolyline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        lwpolyline->properties->visibility = visibility;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1232,7 +1238,7 @@ dxf_lwpolyline_get_color
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (lwpolyline->color < 0)
+        if (lwpolyline->properties->color < 0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found.\n")),
@@ -1241,7 +1247,7 @@ dxf_lwpolyline_get_color
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (lwpolyline->color);
+        return (lwpolyline->properties->color);
 }
 
 
@@ -1274,7 +1280,11 @@ dxf_lwpolyline_set_color
                   (_("Warning in %s () a negative value was passed.\n")),
                   __FUNCTION__);
         }
-        lwpolyline->color = color;
+        if (dxf_graphic_properties_unshare (&lwpolyline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        lwpolyline->properties->color = color;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1305,13 +1315,13 @@ dxf_lwpolyline_get_paperspace
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (lwpolyline->paperspace < 0)
+        if (lwpolyline->properties->paperspace < 0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found.\n")),
                   __FUNCTION__);
         }
-        if (lwpolyline->paperspace > 1)
+        if (lwpolyline->properties->paperspace > 1)
         {
                 fprintf (stderr,
                   (_("Warning in %s () an out of range value was found.\n")),
@@ -1320,7 +1330,7 @@ dxf_lwpolyline_get_paperspace
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (lwpolyline->paperspace);
+        return (lwpolyline->properties->paperspace);
 }
 
 
@@ -1361,7 +1371,11 @@ dxf_lwpolyline_set_paperspace
                   __FUNCTION__);
                 return (NULL);
         }
-        lwpolyline->paperspace = paperspace;
+        if (dxf_graphic_properties_unshare (&lwpolyline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        lwpolyline->properties->paperspace = paperspace;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1486,14 +1500,14 @@ dxf_lwpolyline_get_shadow_mode
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (lwpolyline->shadow_mode < 0)
+        if (lwpolyline->properties->shadow_mode < 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (lwpolyline->shadow_mode > 3)
+        if (lwpolyline->properties->shadow_mode > 3)
         {
                 fprintf (stderr,
                   (_("Error in %s () an out of range value was found.\n")),
@@ -1503,7 +1517,7 @@ dxf_lwpolyline_get_shadow_mode
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (lwpolyline->shadow_mode);
+        return (lwpolyline->properties->shadow_mode);
 }
 
 
@@ -1547,7 +1561,11 @@ dxf_lwpolyline_set_shadow_mode
                   __FUNCTION__);
                 return (NULL);
         }
-        lwpolyline->shadow_mode = shadow_mode;
+        if (dxf_graphic_properties_unshare (&lwpolyline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        lwpolyline->properties->shadow_mode = shadow_mode;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1671,7 +1689,7 @@ dxf_lwpolyline_get_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (lwpolyline->dictionary_owner_soft));
+        return (dxf_strdup (lwpolyline->dictionary_owner_soft));
 }
 
 
@@ -1707,7 +1725,7 @@ dxf_lwpolyline_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        lwpolyline->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        lwpolyline->dictionary_owner_soft = dxf_strdup (dictionary_owner_soft);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1741,7 +1759,7 @@ dxf_lwpolyline_get_material
                   __FUNCTION__);
                 return (NULL);
         }
-        if (lwpolyline->material ==  NULL)
+        if (lwpolyline->properties->material ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found.\n")),
@@ -1751,7 +1769,7 @@ dxf_lwpolyline_get_material
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (lwpolyline->material));
+        return (dxf_strdup (lwpolyline->properties->material));
 }
 
 
@@ -1790,7 +1808,12 @@ dxf_lwpolyline_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        lwpolyline->material = strdup (material);
+        if (dxf_graphic_properties_unshare (&lwpolyline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (lwpolyline->properties->material);
+        lwpolyline->properties->material = dxf_strdup (material);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1834,7 +1857,7 @@ dxf_lwpolyline_get_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (lwpolyline->dictionary_owner_hard));
+        return (dxf_strdup (lwpolyline->dictionary_owner_hard));
 }
 
 
@@ -1870,7 +1893,7 @@ dxf_lwpolyline_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        lwpolyline->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        lwpolyline->dictionary_owner_hard = dxf_strdup (dictionary_owner_hard);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1905,7 +1928,7 @@ dxf_lwpolyline_get_lineweight
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (lwpolyline->lineweight);
+        return (lwpolyline->properties->lineweight);
 }
 
 
@@ -1935,7 +1958,11 @@ dxf_lwpolyline_set_lineweight
                   __FUNCTION__);
                 return (NULL);
         }
-        lwpolyline->lineweight = lineweight;
+        if (dxf_graphic_properties_unshare (&lwpolyline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        lwpolyline->properties->lineweight = lineweight;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1967,7 +1994,7 @@ dxf_lwpolyline_get_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        if (lwpolyline->plot_style_name ==  NULL)
+        if (lwpolyline->properties->plot_style_name ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found.\n")),
@@ -1977,7 +2004,7 @@ dxf_lwpolyline_get_plot_style_name
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (lwpolyline->plot_style_name));
+        return (dxf_strdup (lwpolyline->properties->plot_style_name));
 }
 
 
@@ -2015,7 +2042,12 @@ dxf_lwpolyline_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        lwpolyline->plot_style_name = strdup (plot_style_name);
+        if (dxf_graphic_properties_unshare (&lwpolyline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (lwpolyline->properties->plot_style_name);
+        lwpolyline->properties->plot_style_name = dxf_strdup (plot_style_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2050,7 +2082,7 @@ dxf_lwpolyline_get_color_value
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (lwpolyline->color_value);
+        return (lwpolyline->properties->color_value);
 }
 
 
@@ -2080,7 +2112,11 @@ dxf_lwpolyline_set_color_value
                   __FUNCTION__);
                 return (NULL);
         }
-        lwpolyline->color_value = color_value;
+        if (dxf_graphic_properties_unshare (&lwpolyline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        lwpolyline->properties->color_value = color_value;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2112,7 +2148,7 @@ dxf_lwpolyline_get_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        if (lwpolyline->color_name ==  NULL)
+        if (lwpolyline->properties->color_name ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found.\n")),
@@ -2122,7 +2158,7 @@ dxf_lwpolyline_get_color_name
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (lwpolyline->color_name));
+        return (dxf_strdup (lwpolyline->properties->color_name));
 }
 
 
@@ -2160,7 +2196,12 @@ dxf_lwpolyline_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        lwpolyline->color_name = strdup (color_name);
+        if (dxf_graphic_properties_unshare (&lwpolyline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (lwpolyline->properties->color_name);
+        lwpolyline->properties->color_name = dxf_strdup (color_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2195,7 +2236,7 @@ dxf_lwpolyline_get_transparency
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (lwpolyline->transparency);
+        return (lwpolyline->properties->transparency);
 }
 
 
@@ -2225,7 +2266,11 @@ dxf_lwpolyline_set_transparency
                   __FUNCTION__);
                 return (NULL);
         }
-        lwpolyline->transparency = transparency;
+        if (dxf_graphic_properties_unshare (&lwpolyline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        lwpolyline->properties->transparency = transparency;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2245,7 +2290,7 @@ dxf_lwpolyline_get_constant_width
                 /*!< a pointer to a DXF \c LWPOLYLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2287,7 +2332,7 @@ dxf_lwpolyline_set_constant_width
                  * entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2476,7 +2521,7 @@ dxf_lwpolyline_get_extr_x0
                 /*!< a pointer to a DXF \c LWPOLYLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2512,7 +2557,7 @@ dxf_lwpolyline_set_extr_x0
                  * DXF \c LWPOLYLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2544,7 +2589,7 @@ dxf_lwpolyline_get_extr_y0
                 /*!< a pointer to a DXF \c LWPOLYLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2580,7 +2625,7 @@ dxf_lwpolyline_set_extr_y0
                  * DXF \c LWPOLYLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2612,7 +2657,7 @@ dxf_lwpolyline_get_extr_z0
                 /*!< a pointer to a DXF \c LWPOLYLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2648,7 +2693,7 @@ dxf_lwpolyline_set_extr_z0
                  * DXF \c LWPOLYLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2671,9 +2716,14 @@ dxf_lwpolyline_set_extr_z0
  * \brief Get the pointer to the first vertex of a linked list of
  * \c vertices from a DXF \c LWPOLYLINE entity.
  *
+ * The vertices are kept in packed arrays, the linked list is built from
+ * them on the first call and belongs to \c lwpolyline.
+ *
  * \return pointer to the first vertex of a linked list of \c vertices.
  *
  * \warning No checks are performed on the returned pointer.
+ * \warning The linked list does not follow later changes to the
+ * vertices made with dxf_lwpolyline_append_vertex ().
  */
 DxfVertex *
 dxf_lwpolyline_get_vertices
@@ -2694,6 +2744,11 @@ dxf_lwpolyline_get_vertices
                 return (NULL);
         }
         if (lwpolyline->vertices == NULL)
+        {
+                lwpolyline->vertices = (struct DxfVertex *)
+                  dxf_vertex_array_to_chain (&lwpolyline->packed_vertices);
+        }
+        if (lwpolyline->vertices == NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the vertices member.\n")),
@@ -2710,6 +2765,9 @@ dxf_lwpolyline_get_vertices
 /*!
  * \brief Set the pointer to the first vertex of a linked list of
  * \c vertices for a DXF \c LWPOLYLINE entity.
+ *
+ * The vertices are copied into the packed arrays of \c lwpolyline, which
+ * takes ownership of the linked list.
  */
 DxfLWPolyline *
 dxf_lwpolyline_set_vertices
@@ -2739,7 +2797,21 @@ dxf_lwpolyline_set_vertices
                   __FUNCTION__);
                 return (NULL);
         }
+        if (dxf_vertex_array_from_chain (&lwpolyline->packed_vertices,
+          vertices) != EXIT_SUCCESS)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        if ((lwpolyline->vertices != NULL)
+          && (lwpolyline->vertices != (struct DxfVertex *) vertices))
+        {
+                dxf_vertex_free_chain ((DxfVertex *) lwpolyline->vertices);
+        }
         lwpolyline->vertices = (struct DxfVertex *) vertices;
+        lwpolyline->number_vertices = lwpolyline->packed_vertices.count;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2747,6 +2819,52 @@ dxf_lwpolyline_set_vertices
 }
 
 
+/*!
+ * \brief Append a vertex to a DXF \c LWPOLYLINE entity.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_lwpolyline_append_vertex
+(
+        DxfLWPolyline *lwpolyline,
+                /*!< a pointer to a DXF \c LWPOLYLINE entity. */
+        double x0,
+                /*!< X-value of the vertex. */
+        double y0,
+                /*!< Y-value of the vertex. */
+        double bulge
+                /*!< bulge of the vertex. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (lwpolyline == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (dxf_vertex_array_append (&lwpolyline->packed_vertices, x0, y0,
+          0.0, bulge) < 0)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        lwpolyline->number_vertices = lwpolyline->packed_vertices.count;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
 /*!
  * \brief Get the pointer to the next \c LWPOLYLINE entity from a DXF 
  * \c LWPOLYLINE entity.
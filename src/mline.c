@@ -41,6 +41,9 @@
 
 
 #include "mline.h"
+#include "arena.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -63,7 +66,7 @@ dxf_mline_new ()
         size = sizeof (DxfMline);
         /* avoid malloc of 0 bytes */
         if (size == 0) size = 1;
-        if ((mline = malloc (size)) == NULL)
+        if ((mline = dxf_malloc (size)) == NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () could not allocate memory for a DxfMline struct.\n")),
@@ -97,8 +100,6 @@ dxf_mline_init
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        int i;
-
         /* Do some basic checks. */
         if (mline == NULL)
         {
@@ -115,27 +116,13 @@ dxf_mline_init
               return (NULL);
         }
         dxf_mline_set_id_code (mline, 0);
-        dxf_mline_set_linetype (mline, strdup (DXF_DEFAULT_LINETYPE));
-        dxf_mline_set_layer (mline, strdup (DXF_DEFAULT_LAYER));
-        dxf_mline_set_elevation (mline, 0.0);
-        dxf_mline_set_thickness (mline, 0.0);
-        dxf_mline_set_linetype_scale (mline, DXF_DEFAULT_LINETYPE_SCALE);
-        dxf_mline_set_visibility (mline, DXF_DEFAULT_VISIBILITY);
-        dxf_mline_set_color (mline, DXF_COLOR_BYLAYER);
-        dxf_mline_set_paperspace (mline, DXF_MODELSPACE);
+        mline->properties = dxf_graphic_properties_default ();
         dxf_mline_set_graphics_data_size (mline, 0);
-        dxf_mline_set_shadow_mode (mline, 0);
         dxf_mline_set_binary_graphics_data (mline, dxf_binary_graphics_data_new ());
         dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) dxf_mline_get_binary_graphics_data (mline));
-        dxf_mline_set_dictionary_owner_soft (mline, strdup (""));
-        dxf_mline_set_material (mline, strdup (""));
-        dxf_mline_set_dictionary_owner_hard (mline, strdup (""));
-        dxf_mline_set_lineweight (mline, 0);
-        dxf_mline_set_plot_style_name (mline, strdup (""));
-        dxf_mline_set_color_value (mline, 0);
-        dxf_mline_set_color_name (mline, strdup (""));
-        dxf_mline_set_transparency (mline, 0);
-        dxf_mline_set_style_name (mline, strdup (""));
+        dxf_mline_set_dictionary_owner_soft (mline, "");
+        dxf_mline_set_dictionary_owner_hard (mline, "");
+        dxf_mline_set_style_name (mline, "");
         dxf_mline_set_p0 (mline, dxf_point_new ());
         dxf_point_init ((DxfPoint *) dxf_mline_get_p0 (mline));
         dxf_mline_set_p1 (mline, dxf_point_new ());
@@ -144,11 +131,12 @@ dxf_mline_init
         dxf_point_init ((DxfPoint *) dxf_mline_get_p2 (mline));
         dxf_mline_set_p3 (mline, dxf_point_new ());
         dxf_point_init ((DxfPoint *) dxf_mline_get_p3 (mline));
-        for (i = 0; i < DXF_MAX_PARAM; i++)
-        {
-                mline->element_parameters[i] = 0.0;
-                mline->area_fill_parameters[i] = 0.0;
-        }
+        mline->element_parameters = NULL;
+        mline->element_parameters_count = 0;
+        mline->element_parameters_capacity = 0;
+        mline->area_fill_parameters = NULL;
+        mline->area_fill_parameters_count = 0;
+        mline->area_fill_parameters_capacity = 0;
         dxf_mline_set_scale_factor (mline, 1.0);
         dxf_mline_set_justification (mline, 0);
         dxf_mline_set_flags (mline, 0);
@@ -158,7 +146,7 @@ dxf_mline_init
         dxf_mline_set_extr_x0 (mline, 0.0);
         dxf_mline_set_extr_y0 (mline, 0.0);
         dxf_mline_set_extr_z0 (mline, 1.0);
-        dxf_mline_set_mlinestyle_dictionary (mline, strdup (""));
+        dxf_mline_set_mlinestyle_dictionary (mline, "");
         dxf_mline_set_next (mline, NULL);
 #if DEBUG
         DXF_DEBUG_END
@@ -190,12 +178,13 @@ dxf_mline_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfGraphicProperties properties;
+        DxfPair pair;
         int i;
         int j;
         int k;
-        int l;
-        int m;
+        double *parameters;
         DxfPoint *iter_p1;
         DxfPoint *iter_p2;
         DxfPoint *iter_p3;
@@ -206,8 +195,6 @@ dxf_mline_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (mline == NULL)
@@ -218,374 +205,326 @@ dxf_mline_read
                 mline = dxf_mline_new ();
                 mline = dxf_mline_init (mline);
         }
-        l = 0;
-        m = 0;
         i = 0; /* Number of found vertices in linked list p1. */
         iter_p1 = (DxfPoint *) mline->p1; /* Pointer to first vertex p1. */
         j = 0; /* Number of found direction vectors in linked list p2. */
         iter_p2 = (DxfPoint *) mline->p2; /* Pointer to first direction vector p2. */
         k = 0;
         iter_p3 = (DxfPoint *) mline->p3; /* Pointer to first direction vector p3. */
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        dxf_graphic_properties_start (&properties, mline->properties);
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        fclose (fp->fp);
-                        /* Clean up. */
-                        free (temp_string);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "2") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing a string of
-                         * up to 32 characters with the name of the
-                         * style used for this mline. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", mline->style_name);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                if (strcmp (temp_string, "5") == 0)
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &mline->id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", mline->linetype);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", mline->layer);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X value of the start point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mline->p0->x0);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y value of the start point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mline->p0->y0);
-                }
-                else if (strcmp (temp_string, "30") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z value of the start point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mline->p0->z0);
-                }
-                else if ((strcmp (temp_string, "11") == 0)
-                  || (strcmp (temp_string, "21") == 0)
-                  || (strcmp (temp_string, "31") == 0))
-                {
-                        if (strcmp (temp_string, "11") == 0)
-                        {
-                                /* Now follows a string containing the X-value
-                                 * of the Vertex coordinates (one entry for each
-                                 * vertex). */
-                                if (i > 0) /* Create a pointer for the next vertex. */
+                        case 2:
+                                /* Now follows a string containing a string of
+                                 * up to 32 characters with the name of the
+                                 * style used for this mline. */
+                                dxf_free (mline->style_name);
+                                mline->style_name = dxf_pair_get_string (&pair);
+                                break;
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                mline->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 6:
+                                /* Now follows a string containing a linetype
+                                 * name. */
+                                dxf_lexer_free_string (fp, properties.linetype);
+                                properties.linetype = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 8:
+                                /* Now follows a string containing a layer name. */
+                                dxf_lexer_free_string (fp, properties.layer);
+                                properties.layer = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 10:
+                                /* Now follows a string containing the
+                                 * X value of the start point. */
+                                mline->p0->x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 20:
+                                /* Now follows a string containing the
+                                 * Y value of the start point. */
+                                mline->p0->y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 30:
+                                /* Now follows a string containing the
+                                 * Z value of the start point. */
+                                mline->p0->z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 11:
+                        case 21:
+                        case 31:
+                                if (strcmp (temp_string, "11") == 0)
                                 {
-                                        dxf_point_init ((DxfPoint *) iter_p1->next);
-                                        iter_p1 = (DxfPoint *) iter_p1->next;
+                                        /* Now follows a string containing the X-value
+                                         * of the Vertex coordinates (one entry for each
+                                         * vertex). */
+                                        if (i > 0) /* Create a pointer for the next vertex. */
+                                        {
+                                                dxf_point_init ((DxfPoint *) iter_p1->next);
+                                                iter_p1 = (DxfPoint *) iter_p1->next;
+                                        }
+                                        iter_p1->x0 = dxf_pair_get_double (&pair);
                                 }
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%lf\n", &iter_p1->x0);
-                        }
-                        else if (strcmp (temp_string, "21") == 0)
-                        {
-                                /* Now follows a string containing the Y-value
-                                 * of the Vertex coordinates (one entry for each
-                                 * vertex). */
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%lf\n", &iter_p1->y0);
-                        }
-                        else if (strcmp (temp_string, "31") == 0)
-                        {
-                                /* Now follows a string containing the Z-value
-                                 * of the Vertex coordinates (one entry for each
-                                 * vertex). */
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%lf\n", &iter_p1->z0);
-                                i++; /* Increase the number of found vertices. */
-                        }
-                }
-                else if ((strcmp (temp_string, "12") == 0)
-                  || (strcmp (temp_string, "22") == 0)
-                  || (strcmp (temp_string, "32") == 0))
-                {
-                        if (strcmp (temp_string, "12") == 0)
-                        {
-                                /* Now follows a string containing the X-value
-                                 * of the Direction vector (one entry for each
-                                 * vector). */
-                                if (j > 0) /* Create a pointer for the next vector. */
+                                else if (strcmp (temp_string, "21") == 0)
                                 {
-                                        dxf_point_init ((DxfPoint *) iter_p2->next);
-                                        iter_p2 = (DxfPoint *) iter_p2->next;
+                                        /* Now follows a string containing the Y-value
+                                         * of the Vertex coordinates (one entry for each
+                                         * vertex). */
+                                        iter_p1->y0 = dxf_pair_get_double (&pair);
                                 }
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%lf\n", &iter_p2->x0);
-                        }
-                        else if (strcmp (temp_string, "22") == 0)
-                        {
-                                /* Now follows a string containing the Y-value
-                                 * of the Direction vector (one entry for each
-                                 * vector). */
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%lf\n", &iter_p2->y0);
-                        }
-                        else if (strcmp (temp_string, "32") == 0)
-                        {
-                                /* Now follows a string containing the Z-value
-                                 * of the Direction vector (one entry for each
-                                 * vector). */
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%lf\n", &iter_p2->z0);
-                                j++; /* Increase the number of found vectors. */
-                        }
-                }
-                else if ((strcmp (temp_string, "13") == 0)
-                  || (strcmp (temp_string, "23") == 0)
-                  || (strcmp (temp_string, "33") == 0))
-                {
-                        if (strcmp (temp_string, "13") == 0)
-                        {
-                                /* Now follows a string containing the X-value
-                                 * of the Direction vector (one entry for each
-                                 * vector). */
-                                if (k > 0) /* Create a pointer for the next vector. */
+                                else if (strcmp (temp_string, "31") == 0)
                                 {
-                                        dxf_point_init ((DxfPoint *) iter_p3->next);
-                                        iter_p3 = (DxfPoint *) iter_p3->next;
+                                        /* Now follows a string containing the Z-value
+                                         * of the Vertex coordinates (one entry for each
+                                         * vertex). */
+                                        iter_p1->z0 = dxf_pair_get_double (&pair);
+                                        i++; /* Increase the number of found vertices. */
                                 }
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%lf\n", &iter_p3->x0);
-                        }
-                        else if (strcmp (temp_string, "23") == 0)
-                        {
-                                /* Now follows a string containing the Y-value
-                                 * of the Direction vector (one entry for each
-                                 * vector). */
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%lf\n", &iter_p3->y0);
-                        }
-                        else if (strcmp (temp_string, "33") == 0)
-                        {
-                                /* Now follows a string containing the Z-value
-                                 * of the Direction vector (one entry for each
-                                 * vector). */
-                                (fp->line_number)++;
-                                fscanf (fp->fp, "%lf\n", &iter_p3->z0);
-                                k++; /* Increase the number of found vectors. */
-                        }
-                }
-                else if ((fp->acad_version_number <= AutoCAD_11)
-                        && (strcmp (temp_string, "38") == 0))
-                {
-                        /* Now follows a string containing the
-                         * elevation. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mline->elevation);
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mline->thickness);
-                }
-                else if (strcmp (temp_string, "40") == 0)
-                {
-                        /* Now follows a string containing the scale
-                         * factor. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mline->scale_factor);
-                }
-                else if (strcmp (temp_string, "41") == 0)
-                {
-                        /* Now follows a string containing the element
-                         * parameters (repeats based on previous code 74). */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mline->element_parameters[l]);
-                        l++;
-                }
-                else if (strcmp (temp_string, "42") == 0)
-                {
-                        /* Now follows a string containing the area fill
-                         * parameters (repeats based on previous code 75). */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mline->area_fill_parameters[m]);
-                        m++;
-                }
-                else if (strcmp (temp_string, "48") == 0)
-                {
-                        /* Now follows a string containing the linetype
-                         * scale. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mline->linetype_scale);
-                }
-                else if (strcmp (temp_string, "60") == 0)
-                {
-                        /* Now follows a string containing the
-                         * visibility value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &mline->visibility);
-                }
-                else if (strcmp (temp_string, "62") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &mline->color);
-                }
-                else if (strcmp (temp_string, "67") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &mline->paperspace);
-                }
-                else if (strcmp (temp_string, "70") == 0)
-                {
-                        /* Now follows a string containing the
-                         * justification value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &mline->justification);
-                }
-                else if (strcmp (temp_string, "71") == 0)
-                {
-                        /* Now follows a string containing the flags
-                         * value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &mline->flags);
-                }
-                else if (strcmp (temp_string, "72") == 0)
-                {
-                        /* Now follows a string containing the number of
-                         * vertices value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &mline->number_of_vertices);
-                }
-                else if (strcmp (temp_string, "73") == 0)
-                {
-                        /* Now follows a string containing the number of
-                         * elements in MLINESTYLE definition. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &mline->number_of_elements);
-                }
-                else if (strcmp (temp_string, "74") == 0)
-                {
-                        /* Now follows a string containing the number of
-                         * parameters for this element (repeats for each
-                         * element in segment). */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &mline->number_of_parameters);
-                }
-                else if (strcmp (temp_string, "75") == 0)
-                {
-                        /* Now follows a string containing the number of
-                         * area fill parameters for this element
-                         * (repeats for each element in segment). */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &mline->number_of_area_fill_parameters);
-                }
-                else if ((fp->acad_version_number >= AutoCAD_13)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if ((strcmp (temp_string, "AcDbEntity") != 0)
-                        && ((strcmp (temp_string, "AcDbMline") != 0)))
-                        {
+                                break;
+                        case 12:
+                        case 22:
+                        case 32:
+                                if (strcmp (temp_string, "12") == 0)
+                                {
+                                        /* Now follows a string containing the X-value
+                                         * of the Direction vector (one entry for each
+                                         * vector). */
+                                        if (j > 0) /* Create a pointer for the next vector. */
+                                        {
+                                                dxf_point_init ((DxfPoint *) iter_p2->next);
+                                                iter_p2 = (DxfPoint *) iter_p2->next;
+                                        }
+                                        iter_p2->x0 = dxf_pair_get_double (&pair);
+                                }
+                                else if (strcmp (temp_string, "22") == 0)
+                                {
+                                        /* Now follows a string containing the Y-value
+                                         * of the Direction vector (one entry for each
+                                         * vector). */
+                                        iter_p2->y0 = dxf_pair_get_double (&pair);
+                                }
+                                else if (strcmp (temp_string, "32") == 0)
+                                {
+                                        /* Now follows a string containing the Z-value
+                                         * of the Direction vector (one entry for each
+                                         * vector). */
+                                        iter_p2->z0 = dxf_pair_get_double (&pair);
+                                        j++; /* Increase the number of found vectors. */
+                                }
+                                break;
+                        case 13:
+                        case 23:
+                        case 33:
+                                if (strcmp (temp_string, "13") == 0)
+                                {
+                                        /* Now follows a string containing the X-value
+                                         * of the Direction vector (one entry for each
+                                         * vector). */
+                                        if (k > 0) /* Create a pointer for the next vector. */
+                                        {
+                                                dxf_point_init ((DxfPoint *) iter_p3->next);
+                                                iter_p3 = (DxfPoint *) iter_p3->next;
+                                        }
+                                        iter_p3->x0 = dxf_pair_get_double (&pair);
+                                }
+                                else if (strcmp (temp_string, "23") == 0)
+                                {
+                                        /* Now follows a string containing the Y-value
+                                         * of the Direction vector (one entry for each
+                                         * vector). */
+                                        iter_p3->y0 = dxf_pair_get_double (&pair);
+                                }
+                                else if (strcmp (temp_string, "33") == 0)
+                                {
+                                        /* Now follows a string containing the Z-value
+                                         * of the Direction vector (one entry for each
+                                         * vector). */
+                                        iter_p3->z0 = dxf_pair_get_double (&pair);
+                                        k++; /* Increase the number of found vectors. */
+                                }
+                                break;
+                        case 38:
+                                if (fp->acad_version_number <= AutoCAD_11)
+                                {
+                                        /* Now follows a string containing the
+                                         * elevation. */
+                                        properties.elevation = dxf_pair_get_double (&pair);
+                                }
+                                break;
+                        case 39:
+                                /* Now follows a string containing the
+                                 * thickness. */
+                                properties.thickness = dxf_pair_get_double (&pair);
+                                break;
+                        case 40:
+                                /* Now follows a string containing the scale
+                                 * factor. */
+                                mline->scale_factor = dxf_pair_get_double (&pair);
+                                break;
+                        case 41:
+                                /* Now follows a string containing the element
+                                 * parameters (repeats based on previous code 74). */
+                                parameters = dxf_array_reserve (mline->element_parameters,
+                                  mline->element_parameters_count,
+                                  &mline->element_parameters_capacity,
+                                  mline->element_parameters_count + 1,
+                                  sizeof (double));
+                                if (parameters != NULL)
+                                {
+                                        mline->element_parameters = parameters;
+                                        mline->element_parameters[mline->element_parameters_count] = dxf_pair_get_double (&pair);
+                                        mline->element_parameters_count++;
+                                }
+                                break;
+                        case 42:
+                                /* Now follows a string containing the area fill
+                                 * parameters (repeats based on previous code 75). */
+                                parameters = dxf_array_reserve (mline->area_fill_parameters,
+                                  mline->area_fill_parameters_count,
+                                  &mline->area_fill_parameters_capacity,
+                                  mline->area_fill_parameters_count + 1,
+                                  sizeof (double));
+                                if (parameters != NULL)
+                                {
+                                        mline->area_fill_parameters = parameters;
+                                        mline->area_fill_parameters[mline->area_fill_parameters_count] = dxf_pair_get_double (&pair);
+                                        mline->area_fill_parameters_count++;
+                                }
+                                break;
+                        case 48:
+                                /* Now follows a string containing the linetype
+                                 * scale. */
+                                properties.linetype_scale = dxf_pair_get_double (&pair);
+                                break;
+                        case 60:
+                                /* Now follows a string containing the
+                                 * visibility value. */
+                                properties.visibility = dxf_pair_get_int (&pair);
+                                break;
+                        case 62:
+                                /* Now follows a string containing the
+                                 * color value. */
+                                properties.color = dxf_pair_get_int (&pair);
+                                break;
+                        case 67:
+                                /* Now follows a string containing the
+                                 * paperspace value. */
+                                properties.paperspace = dxf_pair_get_int (&pair);
+                                break;
+                        case 70:
+                                /* Now follows a string containing the
+                                 * justification value. */
+                                mline->justification = dxf_pair_get_int (&pair);
+                                break;
+                        case 71:
+                                /* Now follows a string containing the flags
+                                 * value. */
+                                mline->flags = dxf_pair_get_int (&pair);
+                                break;
+                        case 72:
+                                /* Now follows a string containing the number of
+                                 * vertices value. */
+                                mline->number_of_vertices = dxf_pair_get_int (&pair);
+                                break;
+                        case 73:
+                                /* Now follows a string containing the number of
+                                 * elements in MLINESTYLE definition. */
+                                mline->number_of_elements = dxf_pair_get_int (&pair);
+                                break;
+                        case 74:
+                                /* Now follows a string containing the number of
+                                 * parameters for this element (repeats for each
+                                 * element in segment). */
+                                mline->number_of_parameters = dxf_pair_get_int (&pair);
+                                break;
+                        case 75:
+                                /* Now follows a string containing the number of
+                                 * area fill parameters for this element
+                                 * (repeats for each element in segment). */
+                                mline->number_of_area_fill_parameters = dxf_pair_get_int (&pair);
+                                break;
+                        case 100:
+                                if (fp->acad_version_number >= AutoCAD_13)
+                                {
+                                        /* Now follows a string containing the
+                                         * subclass marker value. */
+                                        dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                        if ((strcmp (temp_string, "AcDbEntity") != 0)
+                                        && ((strcmp (temp_string, "AcDbMline") != 0)))
+                                        {
+                                                fprintf (stderr,
+                                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                                  __FUNCTION__, fp->filename, fp->line_number);
+                                        }
+                                }
+                                break;
+                        case 210:
+                                /* Now follows a string containing the
+                                 * X value of the extrusion direction. */
+                                mline->extr_x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 220:
+                                /* Now follows a string containing the
+                                 * Y value of the extrusion direction. */
+                                mline->extr_y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 230:
+                                /* Now follows a string containing the
+                                 * Z value of the extrusion direction. */
+                                mline->extr_z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, mline->dictionary_owner_soft);
+                                mline->dictionary_owner_soft = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 340:
+                                /* Now follows a string containing a
+                                 * Pointer-handle/ID of MLINESTYLE dictionary. */
+                                dxf_free (mline->mlinestyle_dictionary);
+                                mline->mlinestyle_dictionary = dxf_pair_get_string (&pair);
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, mline->dictionary_owner_hard);
+                                mline->dictionary_owner_hard = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, "DXF comment: %s\n", temp_string);
+                                break;
+                        default:
                                 fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
                                   __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "210") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X value of the extrusion direction. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mline->extr_x0);
-                }
-                else if (strcmp (temp_string, "220") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y value of the extrusion direction. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mline->extr_y0);
-                }
-                else if (strcmp (temp_string, "230") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z value of the extrusion direction. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mline->extr_z0);
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", mline->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "340") == 0)
-                {
-                        /* Now follows a string containing a
-                         * Pointer-handle/ID of MLINESTYLE dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", mline->mlinestyle_dictionary);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", mline->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
         /* Handle omitted members and/or illegal values. */
-        if (strcmp (dxf_mline_get_linetype (mline), "") == 0)
+        if (strcmp (mline->properties->linetype, "") == 0)
         {
-                dxf_mline_set_linetype (mline, strdup (DXF_DEFAULT_LINETYPE));
+                dxf_mline_set_linetype (mline, DXF_DEFAULT_LINETYPE);
         }
-        if (strcmp (dxf_mline_get_layer (mline), "") == 0)
+        if (strcmp (mline->properties->layer, "") == 0)
         {
-                dxf_mline_set_layer (mline, strdup (DXF_DEFAULT_LAYER));
+                dxf_mline_set_layer (mline, DXF_DEFAULT_LAYER);
         }
-        /* Clean up. */
-        free (temp_string);
+        /* Entities with equal properties share a record. */
+        dxf_graphic_properties_finish (fp, &mline->properties, &properties);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -618,7 +557,7 @@ dxf_mline_write
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *dxf_entity_name = strdup ("MLINE");
+        char *dxf_entity_name = dxf_strdup ("MLINE");
         int i;
         DxfPoint *iter;
 
@@ -629,7 +568,7 @@ dxf_mline_write
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (mline == NULL)
@@ -638,66 +577,48 @@ dxf_mline_write
                   (_("Error in %s () a NULL pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if ((fp->acad_version_number < AutoCAD_13)
           && (fp->follow_strict_version_rules))
         {
                 fprintf (stderr,
-                  (_("Error in %s () illegal DXF version for this %s entity with id-code: %x.\n")),
+                  (_("Error in %s () illegal DXF version for this %s entity with id-code: %lx.\n")),
                   __FUNCTION__, dxf_entity_name, mline->id_code);
                 return (EXIT_FAILURE);
         }
         else
         {
                 fprintf (stderr,
-                  (_("Warning in %s () illegal DXF version for this %s entity with id-code: %x.\n")),
+                  (_("Warning in %s () illegal DXF version for this %s entity with id-code: %lx.\n")),
                   __FUNCTION__, dxf_entity_name, dxf_mline_get_id_code (mline));
         }
         if (strcmp (dxf_mline_get_linetype (mline), "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_mline_get_id_code (mline));
                 fprintf (stderr,
                   (_("    %s entity is relocated to layer 0\n")),
                   dxf_entity_name);
-                dxf_mline_set_linetype (mline, strdup (DXF_DEFAULT_LINETYPE));
+                dxf_mline_set_linetype (mline, DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (dxf_mline_get_layer (mline), "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty layer string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty layer string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_mline_get_id_code (mline));
                 fprintf (stderr,
                   (_("    %s entity is relocated to layer 0\n")),
                   dxf_entity_name);
-                dxf_mline_set_layer (mline, strdup (DXF_DEFAULT_LAYER));
-        }
-        if (dxf_mline_get_number_of_parameters (mline) >= (DXF_MAX_PARAM - 1))
-        {
-                fprintf (stderr,
-                  (_("Error in %s () too many parameters.\n")),
-                  __FUNCTION__);
-                /* Clean up. */
-                free (dxf_entity_name);
-                return (EXIT_FAILURE);
-        }
-        if (dxf_mline_get_number_of_area_fill_parameters (mline) >= (DXF_MAX_PARAM - 1))
-        {
-                fprintf (stderr,
-                  (_("Error in %s () too many area fill parameters.\n")),
-                  __FUNCTION__);
-                /* Clean up. */
-                free (dxf_entity_name);
-                return (EXIT_FAILURE);
+                dxf_mline_set_layer (mline, DXF_DEFAULT_LAYER);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
-        if (dxf_mline_get_id_code (mline) != -1)
+        dxf_write_string (fp, 0, dxf_entity_name);
+        if (mline->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", dxf_mline_get_id_code (mline));
+                dxf_write_hex (fp, 5, dxf_mline_get_id_code (mline));
         }
         /*!
          * \todo for version R14.\n
@@ -712,116 +633,116 @@ dxf_mline_write
         if ((strcmp (mline->dictionary_owner_soft, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", dxf_mline_get_dictionary_owner_soft (mline));
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, dxf_mline_get_dictionary_owner_soft (mline));
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (dxf_mline_get_dictionary_owner_hard (mline), "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", dxf_mline_get_dictionary_owner_hard (mline));
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, dxf_mline_get_dictionary_owner_hard (mline));
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbEntity\n");
+                dxf_write_string (fp, 100, "AcDbEntity");
         }
         if (dxf_mline_get_paperspace (mline) == DXF_PAPERSPACE)
         {
-                fprintf (fp->fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_int (fp, 67, DXF_PAPERSPACE);
         }
-        fprintf (fp->fp, "  8\n%s\n", dxf_mline_get_layer (mline));
+        dxf_write_string (fp, 8, dxf_mline_get_layer (mline));
         if (strcmp (dxf_mline_get_linetype (mline), DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp->fp, "  6\n%s\n", dxf_mline_get_linetype (mline));
+                dxf_write_string (fp, 6, dxf_mline_get_linetype (mline));
         }
         if ((fp->acad_version_number >= AutoCAD_2008)
           && (strcmp (dxf_mline_get_material (mline), "") != 0))
         {
-                fprintf (fp->fp, "347\n%s\n", dxf_mline_get_material (mline));
+                dxf_write_string (fp, 347, dxf_mline_get_material (mline));
         }
         if ((fp->acad_version_number <= AutoCAD_11)
           && DXF_FLATLAND
           && (dxf_mline_get_elevation (mline) != 0.0))
         {
-                fprintf (fp->fp, " 38\n%f\n", dxf_mline_get_elevation (mline));
+                dxf_write_double (fp, 38, dxf_mline_get_elevation (mline));
         }
         if (dxf_mline_get_color (mline) != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp->fp, " 62\n%d\n", dxf_mline_get_color (mline));
+                dxf_write_int (fp, 62, dxf_mline_get_color (mline));
         }
         if (fp->acad_version_number >= AutoCAD_2002)
         {
-                fprintf (fp->fp, "370\n%d\n", dxf_mline_get_lineweight (mline));
+                dxf_write_int (fp, 370, dxf_mline_get_lineweight (mline));
         }
         if (dxf_mline_get_linetype_scale (mline) != 1.0)
         {
-                fprintf (fp->fp, " 48\n%f\n", dxf_mline_get_linetype_scale (mline));
+                dxf_write_double (fp, 48, dxf_mline_get_linetype_scale (mline));
         }
         if (dxf_mline_get_visibility (mline) != 0)
         {
-                fprintf (fp->fp, " 60\n%d\n", dxf_mline_get_visibility (mline));
+                dxf_write_int (fp, 60, dxf_mline_get_visibility (mline));
         }
         if (fp->acad_version_number >= AutoCAD_2000)
         {
 #ifdef BUILD_64
-                fprintf (fp->fp, "160\n%d\n", dxf_mline_get_graphics_data_size (mline));
+                dxf_write_int (fp, 160, dxf_mline_get_graphics_data_size (mline));
 #else
-                fprintf (fp->fp, " 92\n%d\n", dxf_mline_get_graphics_data_size (mline));
+                dxf_write_int (fp, 92, dxf_mline_get_graphics_data_size (mline));
 #endif
                 DxfBinaryGraphicsData *bgd_iter = (DxfBinaryGraphicsData *) dxf_mline_get_binary_graphics_data (mline);
                 while (dxf_binary_graphics_data_get_data_line (bgd_iter) != NULL)
                 {
-                        fprintf (fp->fp, "310\n%s\n", dxf_binary_graphics_data_get_data_line (bgd_iter));
+                        dxf_write_string (fp, 310, dxf_binary_graphics_data_get_data_line (bgd_iter));
                         bgd_iter = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_get_next (bgd_iter);
                 }
         }
         if (fp->acad_version_number >= AutoCAD_2004)
         {
-                fprintf (fp->fp, "420\n%ld\n", dxf_mline_get_color_value (mline));
-                fprintf (fp->fp, "430\n%s\n", dxf_mline_get_color_name (mline));
-                fprintf (fp->fp, "440\n%ld\n", dxf_mline_get_transparency (mline));
+                dxf_write_long (fp, 420, dxf_mline_get_color_value (mline));
+                dxf_write_string (fp, 430, dxf_mline_get_color_name (mline));
+                dxf_write_long (fp, 440, dxf_mline_get_transparency (mline));
         }
         if (fp->acad_version_number >= AutoCAD_2009)
         {
-                fprintf (fp->fp, "390\n%s\n", dxf_mline_get_plot_style_name (mline));
-                fprintf (fp->fp, "284\n%d\n", dxf_mline_get_shadow_mode (mline));
+                dxf_write_string (fp, 390, dxf_mline_get_plot_style_name (mline));
+                dxf_write_int (fp, 284, dxf_mline_get_shadow_mode (mline));
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbMline\n");
+                dxf_write_string (fp, 100, "AcDbMline");
         }
-        if (mline->thickness != 0.0)
+        if (mline->properties->thickness != 0.0)
         {
-                fprintf (fp->fp, " 39\n%f\n", dxf_mline_get_thickness (mline));
+                dxf_write_double (fp, 39, dxf_mline_get_thickness (mline));
         }
-        fprintf (fp->fp, "  2\n%s\n", dxf_mline_get_style_name (mline));
-        fprintf (fp->fp, "340\n%s\n", dxf_mline_get_mlinestyle_dictionary (mline));
-        fprintf (fp->fp, " 40\n%f\n", dxf_mline_get_scale_factor (mline));
-        fprintf (fp->fp, " 70\n%d\n", dxf_mline_get_justification (mline));
-        fprintf (fp->fp, " 71\n%d\n", dxf_mline_get_flags (mline));
-        fprintf (fp->fp, " 72\n%d\n", dxf_mline_get_number_of_vertices (mline));
-        fprintf (fp->fp, " 73\n%d\n", dxf_mline_get_number_of_elements (mline));
-        fprintf (fp->fp, " 10\n%f\n", dxf_mline_get_x0 (mline));
-        fprintf (fp->fp, " 20\n%f\n", dxf_mline_get_y0 (mline));
-        fprintf (fp->fp, " 30\n%f\n", dxf_mline_get_z0 (mline));
+        dxf_write_string (fp, 2, dxf_mline_get_style_name (mline));
+        dxf_write_string (fp, 340, dxf_mline_get_mlinestyle_dictionary (mline));
+        dxf_write_double (fp, 40, dxf_mline_get_scale_factor (mline));
+        dxf_write_int (fp, 70, dxf_mline_get_justification (mline));
+        dxf_write_int (fp, 71, dxf_mline_get_flags (mline));
+        dxf_write_int (fp, 72, dxf_mline_get_number_of_vertices (mline));
+        dxf_write_int (fp, 73, dxf_mline_get_number_of_elements (mline));
+        dxf_write_double (fp, 10, dxf_mline_get_x0 (mline));
+        dxf_write_double (fp, 20, dxf_mline_get_y0 (mline));
+        dxf_write_double (fp, 30, dxf_mline_get_z0 (mline));
         if ((fp->acad_version_number >= AutoCAD_12)
                 && (dxf_mline_get_extr_x0 (mline) != 0.0)
                 && (dxf_mline_get_extr_y0 (mline) != 0.0)
                 && (dxf_mline_get_extr_z0 (mline) != 1.0))
         {
-                fprintf (fp->fp, "210\n%f\n", dxf_mline_get_extr_x0 (mline));
-                fprintf (fp->fp, "220\n%f\n", dxf_mline_get_extr_y0 (mline));
-                fprintf (fp->fp, "230\n%f\n", dxf_mline_get_extr_z0 (mline));
+                dxf_write_double (fp, 210, dxf_mline_get_extr_x0 (mline));
+                dxf_write_double (fp, 220, dxf_mline_get_extr_y0 (mline));
+                dxf_write_double (fp, 230, dxf_mline_get_extr_z0 (mline));
         }
         iter = (DxfPoint *) mline->p1;
         i = 1;
         while (iter->next != NULL)
         {
-                fprintf (fp->fp, " 11\n%f\n", iter->x0);
-                fprintf (fp->fp, " 21\n%f\n", iter->y0);
-                fprintf (fp->fp, " 31\n%f\n", iter->z0);
+                dxf_write_double (fp, 11, iter->x0);
+                dxf_write_double (fp, 21, iter->y0);
+                dxf_write_double (fp, 31, iter->z0);
                 iter = (DxfPoint *) iter->next;
                 i++;
         }
@@ -835,9 +756,9 @@ dxf_mline_write
         i = 1;
         while (iter->next != NULL)
         {
-                fprintf (fp->fp, " 12\n%f\n", iter->x0);
-                fprintf (fp->fp, " 22\n%f\n", iter->y0);
-                fprintf (fp->fp, " 32\n%f\n", iter->z0);
+                dxf_write_double (fp, 12, iter->x0);
+                dxf_write_double (fp, 22, iter->y0);
+                dxf_write_double (fp, 32, iter->z0);
                 iter = (DxfPoint *) iter->next;
                 i++;
         }
@@ -851,9 +772,9 @@ dxf_mline_write
         i = 1;
         while (iter->next != NULL)
         {
-                fprintf (fp->fp, " 13\n%f\n", iter->x0);
-                fprintf (fp->fp, " 23\n%f\n", iter->y0);
-                fprintf (fp->fp, " 33\n%f\n", iter->z0);
+                dxf_write_double (fp, 13, iter->x0);
+                dxf_write_double (fp, 23, iter->y0);
+                dxf_write_double (fp, 33, iter->z0);
                 iter = (DxfPoint *) iter->next;
                 i++;
         }
@@ -863,18 +784,21 @@ dxf_mline_write
                   (_("Warning in %s () actual number of vertices differs from number_of_vertices value in struct.\n")),
                   __FUNCTION__);
         }
-        fprintf (fp->fp, " 74\n%d\n", mline->number_of_parameters);
+        dxf_write_int (fp, 74, mline->number_of_parameters);
         for (i = 0; i < mline->number_of_parameters; i++)
         {
-                fprintf (fp->fp, " 41\n%f\n", mline->element_parameters[i]);
+                /* Parameters which were not read are written as 0.0. */
+                dxf_write_double (fp, 41,
+                  (i < mline->element_parameters_count) ? mline->element_parameters[i] : 0.0);
         }
-        fprintf (fp->fp, " 75\n%d\n", mline->number_of_area_fill_parameters);
+        dxf_write_int (fp, 75, mline->number_of_area_fill_parameters);
         for (i = 0; i < mline->number_of_area_fill_parameters; i++)
         {
-                fprintf (fp->fp, " 42\n%f\n", mline->area_fill_parameters[i]);
+                dxf_write_double (fp, 42,
+                  (i < mline->area_fill_parameters_count) ? mline->area_fill_parameters[i] : 0.0);
         }
         /* Clean up. */
-        free (dxf_entity_name);
+        dxf_free (dxf_entity_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -908,21 +832,19 @@ dxf_mline_free
                 __FUNCTION__);
               return (EXIT_FAILURE);
         }
-        free (mline->linetype);
-        free (mline->layer);
+        dxf_graphic_properties_free (mline->properties);
         dxf_binary_graphics_data_free (mline->binary_graphics_data);
-        free (mline->dictionary_owner_soft);
-        free (mline->material);
-        free (mline->dictionary_owner_hard);
-        free (mline->plot_style_name);
-        free (mline->color_name);
-        free (mline->style_name);
+        dxf_free (mline->dictionary_owner_soft);
+        dxf_free (mline->dictionary_owner_hard);
+        dxf_free (mline->style_name);
         dxf_point_free (mline->p0);
         dxf_point_free_chain (mline->p1);
         dxf_point_free_chain (mline->p2);
         dxf_point_free_chain (mline->p3);
-        free (mline->mlinestyle_dictionary);
-        free (mline);
+        dxf_free (mline->mlinestyle_dictionary);
+        dxf_free (mline->element_parameters);
+        dxf_free (mline->area_fill_parameters);
+        dxf_free (mline);
         mline = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -942,7 +864,7 @@ dxf_mline_free_chain
                 /*!< a pointer to the chain of DXF \c MLINE entities. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (mlines == NULL)
@@ -968,7 +890,7 @@ dxf_mline_free_chain
  *
  * \return ID code.
  */
-int
+long
 dxf_mline_get_id_code
 (
         DxfMline *mline
@@ -1008,7 +930,7 @@ dxf_mline_set_id_code
 (
         DxfMline *mline,
                 /*!< a pointer to a DXF \c MLINE entity. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -1063,7 +985,7 @@ dxf_mline_get_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        if (mline->linetype ==  NULL)
+        if (mline->properties->linetype ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found.\n")),
@@ -1073,7 +995,7 @@ dxf_mline_get_linetype
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (mline->linetype));
+        return (dxf_strdup (mline->properties->linetype));
 }
 
 
@@ -1107,7 +1029,12 @@ dxf_mline_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        mline->linetype = strdup (linetype);
+        if (dxf_graphic_properties_unshare (&mline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (mline->properties->linetype);
+        mline->properties->linetype = dxf_strdup (linetype);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1138,7 +1065,7 @@ dxf_mline_get_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        if (mline->layer ==  NULL)
+        if (mline->properties->layer ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found.\n")),
@@ -1148,7 +1075,7 @@ dxf_mline_get_layer
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (mline->layer));
+        return (dxf_strdup (mline->properties->layer));
 }
 
 
@@ -1182,7 +1109,12 @@ dxf_mline_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        mline->layer = strdup (layer);
+        if (dxf_graphic_properties_unshare (&mline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (mline->properties->layer);
+        mline->properties->layer = dxf_strdup (layer);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1216,7 +1148,7 @@ dxf_mline_get_elevation
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (mline->elevation);
+        return (mline->properties->elevation);
 }
 
 
@@ -1243,7 +1175,11 @@ dxf_mline_set_elevation
                   __FUNCTION__);
                 return (NULL);
         }
-        mline->elevation = elevation;
+        if (dxf_graphic_properties_unshare (&mline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        mline->properties->elevation = elevation;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1274,7 +1210,7 @@ dxf_mline_get_thickness
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (mline->thickness < 0.0)
+        if (mline->properties->thickness < 0.0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found.\n")),
@@ -1284,7 +1220,7 @@ dxf_mline_get_thickness
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (mline->thickness);
+        return (mline->properties->thickness);
 }
 
 
@@ -1318,7 +1254,11 @@ dxf_mline_set_thickness
                   __FUNCTION__);
                 return (NULL);
         }
-        mline->thickness = thickness;
+        if (dxf_graphic_properties_unshare (&mline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        mline->properties->thickness = thickness;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1349,7 +1289,7 @@ dxf_mline_get_linetype_scale
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (mline->linetype_scale < 0.0)
+        if (mline->properties->linetype_scale < 0.0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found.\n")),
@@ -1359,7 +1299,7 @@ dxf_mline_get_linetype_scale
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (mline->linetype_scale);
+        return (mline->properties->linetype_scale);
 }
 
 
@@ -1393,7 +1333,11 @@ dxf_mline_set_linetype_scale
                   __FUNCTION__);
                 return (NULL);
         }
-        mline->linetype_scale = linetype_scale;
+        if (dxf_graphic_properties_unshare (&mline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        mline->properties->linetype_scale = linetype_scale;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1424,14 +1368,14 @@ dxf_mline_get_visibility
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (mline->visibility < 0)
+        if (mline->properties->visibility < 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (mline->visibility > 1)
+        if (mline->properties->visibility > 1)
         {
                 fprintf (stderr,
                   (_("Error in %s () an out of range value was found.\n")),
@@ -1441,7 +1385,7 @@ dxf_mline_get_visibility
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (mline->visibility);
+        return (mline->properties->visibility);
 }
 
 
@@ -1482,7 +1426,11 @@ dxf_mline_set_visibility
                   __FUNCTION__);
                 return (NULL);
         }
-        mline->visibility = visibility;
+        if (dxf_graphic_properties_unshare (&mline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        mline->properties->visibility = visibility;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1513,7 +1461,7 @@ dxf_mline_get_color
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (mline->color < 0)
+        if (mline->properties->color < 0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found.\n")),
@@ -1522,7 +1470,7 @@ dxf_mline_get_color
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (mline->color);
+        return (mline->properties->color);
 }
 
 
@@ -1555,7 +1503,11 @@ dxf_mline_set_color
                   (_("Warning in %s () a negative value was passed.\n")),
                   __FUNCTION__);
         }
-        mline->color = color;
+        if (dxf_graphic_properties_unshare (&mline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        mline->properties->color = color;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1586,13 +1538,13 @@ dxf_mline_get_paperspace
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (mline->paperspace < 0)
+        if (mline->properties->paperspace < 0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found.\n")),
                   __FUNCTION__);
         }
-        if (mline->paperspace > 1)
+        if (mline->properties->paperspace > 1)
         {
                 fprintf (stderr,
                   (_("Warning in %s () an out of range value was found.\n")),
@@ -1601,7 +1553,7 @@ dxf_mline_get_paperspace
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (mline->paperspace);
+        return (mline->properties->paperspace);
 }
 
 
@@ -1642,7 +1594,11 @@ dxf_mline_set_paperspace
                   __FUNCTION__);
                 return (NULL);
         }
-        mline->paperspace = paperspace;
+        if (dxf_graphic_properties_unshare (&mline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        mline->properties->paperspace = paperspace;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1765,14 +1721,14 @@ dxf_mline_get_shadow_mode
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (mline->shadow_mode < 0)
+        if (mline->properties->shadow_mode < 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (mline->shadow_mode > 3)
+        if (mline->properties->shadow_mode > 3)
         {
                 fprintf (stderr,
                   (_("Error in %s () an out of range value was found.\n")),
@@ -1782,7 +1738,7 @@ dxf_mline_get_shadow_mode
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (mline->shadow_mode);
+        return (mline->properties->shadow_mode);
 }
 
 
@@ -1826,7 +1782,11 @@ dxf_mline_set_shadow_mode
                   __FUNCTION__);
                 return (NULL);
         }
-        mline->shadow_mode = shadow_mode;
+        if (dxf_graphic_properties_unshare (&mline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        mline->properties->shadow_mode = shadow_mode;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1950,7 +1910,7 @@ dxf_mline_get_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (mline->dictionary_owner_soft));
+        return (dxf_strdup (mline->dictionary_owner_soft));
 }
 
 
@@ -1986,7 +1946,7 @@ dxf_mline_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        mline->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        mline->dictionary_owner_soft = dxf_strdup (dictionary_owner_soft);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2020,7 +1980,7 @@ dxf_mline_get_material
                   __FUNCTION__);
                 return (NULL);
         }
-        if (mline->material ==  NULL)
+        if (mline->properties->material ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found.\n")),
@@ -2030,7 +1990,7 @@ dxf_mline_get_material
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (mline->material));
+        return (dxf_strdup (mline->properties->material));
 }
 
 
@@ -2068,7 +2028,12 @@ dxf_mline_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        mline->material = strdup (material);
+        if (dxf_graphic_properties_unshare (&mline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (mline->properties->material);
+        mline->properties->material = dxf_strdup (material);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2112,7 +2077,7 @@ dxf_mline_get_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (mline->dictionary_owner_hard));
+        return (dxf_strdup (mline->dictionary_owner_hard));
 }
 
 
@@ -2148,7 +2113,7 @@ dxf_mline_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        mline->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        mline->dictionary_owner_hard = dxf_strdup (dictionary_owner_hard);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2183,7 +2148,7 @@ dxf_mline_get_lineweight
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (mline->lineweight);
+        return (mline->properties->lineweight);
 }
 
 
@@ -2213,7 +2178,11 @@ dxf_mline_set_lineweight
                   __FUNCTION__);
                 return (NULL);
         }
-        mline->lineweight = lineweight;
+        if (dxf_graphic_properties_unshare (&mline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        mline->properties->lineweight = lineweight;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2245,7 +2214,7 @@ dxf_mline_get_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        if (mline->plot_style_name ==  NULL)
+        if (mline->properties->plot_style_name ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found.\n")),
@@ -2255,7 +2224,7 @@ dxf_mline_get_plot_style_name
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (mline->plot_style_name));
+        return (dxf_strdup (mline->properties->plot_style_name));
 }
 
 
@@ -2293,7 +2262,12 @@ dxf_mline_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        mline->plot_style_name = strdup (plot_style_name);
+        if (dxf_graphic_properties_unshare (&mline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (mline->properties->plot_style_name);
+        mline->properties->plot_style_name = dxf_strdup (plot_style_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2328,7 +2302,7 @@ dxf_mline_get_color_value
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (mline->color_value);
+        return (mline->properties->color_value);
 }
 
 
@@ -2358,7 +2332,11 @@ dxf_mline_set_color_value
                   __FUNCTION__);
                 return (NULL);
         }
-        mline->color_value = color_value;
+        if (dxf_graphic_properties_unshare (&mline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        mline->properties->color_value = color_value;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2390,7 +2368,7 @@ dxf_mline_get_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        if (mline->color_name ==  NULL)
+        if (mline->properties->color_name ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found.\n")),
@@ -2400,7 +2378,7 @@ dxf_mline_get_color_name
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (mline->color_name));
+        return (dxf_strdup (mline->properties->color_name));
 }
 
 
@@ -2438,7 +2416,12 @@ dxf_mline_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        mline->color_name = strdup (color_name);
+        if (dxf_graphic_properties_unshare (&mline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (mline->properties->color_name);
+        mline->properties->color_name = dxf_strdup (color_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2473,7 +2456,7 @@ dxf_mline_get_transparency
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (mline->transparency);
+        return (mline->properties->transparency);
 }
 
 
@@ -2503,7 +2486,11 @@ dxf_mline_set_transparency
                   __FUNCTION__);
                 return (NULL);
         }
-        mline->transparency = transparency;
+        if (dxf_graphic_properties_unshare (&mline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        mline->properties->transparency = transparency;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2545,7 +2532,7 @@ dxf_mline_get_style_name
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (mline->style_name));
+        return (dxf_strdup (mline->style_name));
 }
 
 
@@ -2583,7 +2570,7 @@ dxf_mline_set_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        mline->style_name = strdup (style_name);
+        mline->style_name = dxf_strdup (style_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2603,7 +2590,7 @@ dxf_mline_get_p0
                 /*!< a pointer to a DXF \c MLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2642,7 +2629,7 @@ dxf_mline_set_p0
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2681,7 +2668,7 @@ dxf_mline_get_x0
                 /*!< a pointer to a DXF \c MLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2724,7 +2711,7 @@ dxf_mline_set_x0
                  * \c MLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2763,7 +2750,7 @@ dxf_mline_get_y0
                 /*!< a pointer to a DXF \c MLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2806,7 +2793,7 @@ dxf_mline_set_y0
                  * \c MLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2845,7 +2832,7 @@ dxf_mline_get_z0
                 /*!< a pointer to a DXF \c MLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2888,7 +2875,7 @@ dxf_mline_set_z0
                  * \c MLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2927,7 +2914,7 @@ dxf_mline_get_p1
                 /*!< a pointer to a DXF \c MLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2967,7 +2954,7 @@ dxf_mline_set_p1
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3007,7 +2994,7 @@ dxf_mline_get_x1
                 /*!< a pointer to a DXF \c MLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3050,7 +3037,7 @@ dxf_mline_set_x1
                  * vertices \c x1 of a DXF \c MLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3090,7 +3077,7 @@ dxf_mline_get_y1
                 /*!< a pointer to a DXF \c MLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3133,7 +3120,7 @@ dxf_mline_set_y1
                  * vertices \c y1 of a DXF \c MLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3173,7 +3160,7 @@ dxf_mline_get_z1
                 /*!< a pointer to a DXF \c MLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3216,7 +3203,7 @@ dxf_mline_set_z1
                  * vertices \c z1 of a DXF \c MLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3255,7 +3242,7 @@ dxf_mline_get_p2
                 /*!< a pointer to a DXF \c MLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3295,7 +3282,7 @@ dxf_mline_set_p2
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3335,7 +3322,7 @@ dxf_mline_get_x2
                 /*!< a pointer to a DXF \c MLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3379,7 +3366,7 @@ dxf_mline_set_x2
                  * entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3419,7 +3406,7 @@ dxf_mline_get_y2
                 /*!< a pointer to a DXF \c MLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3463,7 +3450,7 @@ dxf_mline_set_y2
                  * entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3503,7 +3490,7 @@ dxf_mline_get_z2
                 /*!< a pointer to a DXF \c MLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3547,7 +3534,7 @@ dxf_mline_set_z2
                  * entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3586,7 +3573,7 @@ dxf_mline_get_p3
                 /*!< a pointer to a DXF \c MLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3626,7 +3613,7 @@ dxf_mline_set_p3
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3667,7 +3654,7 @@ dxf_mline_get_x3
                 /*!< a pointer to a DXF \c MLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3712,7 +3699,7 @@ dxf_mline_set_x3
                  * vertex \c x3 of a DXF \c MLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3753,7 +3740,7 @@ dxf_mline_get_y3
                 /*!< a pointer to a DXF \c MLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3798,7 +3785,7 @@ dxf_mline_set_y3
                  * vertex \c y3 of a DXF \c MLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3839,7 +3826,7 @@ dxf_mline_get_z3
                 /*!< a pointer to a DXF \c MLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3884,7 +3871,7 @@ dxf_mline_set_z3
                  * vertex \c z3 of a DXF \c MLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3922,7 +3909,7 @@ dxf_mline_get_scale_factor
                 /*!< a pointer to a DXF \c MLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3934,13 +3921,6 @@ dxf_mline_get_scale_factor
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (mline->element_parameters == NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found.\n")),
-                  __FUNCTION__);
-                return (EXIT_FAILURE);
-        }
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -3963,7 +3943,7 @@ dxf_mline_set_scale_factor
                 /*!< the \c scale_factor to be set for the entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3994,7 +3974,7 @@ dxf_mline_get_element_parameters
                 /*!< a pointer to a DXF \c MLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -4037,9 +4017,11 @@ dxf_mline_set_element_parameters
                  * be set for the entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        double *parameters;
+
         /* Do some basic checks. */
         if (mline == NULL)
         {
@@ -4055,6 +4037,18 @@ dxf_mline_set_element_parameters
                   __FUNCTION__);
                 return (NULL);
         }
+        if (mline->element_parameters_count == 0)
+        {
+                parameters = dxf_array_reserve (mline->element_parameters,
+                  0, &mline->element_parameters_capacity, 1,
+                  sizeof (double));
+                if (parameters == NULL)
+                {
+                        return (NULL);
+                }
+                mline->element_parameters = parameters;
+                mline->element_parameters_count = 1;
+        }
         *(mline->element_parameters) = *element_parameters;
 #if DEBUG
         DXF_DEBUG_END
@@ -4075,7 +4069,7 @@ dxf_mline_get_area_fill_parameters
                 /*!< a pointer to a DXF \c MLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -4087,6 +4081,13 @@ dxf_mline_get_area_fill_parameters
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
+        if (mline->area_fill_parameters == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was found.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -4111,9 +4112,11 @@ dxf_mline_set_area_fill_parameters
                  * be set for the entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        double *parameters;
+
         /* Do some basic checks. */
         if (mline == NULL)
         {
@@ -4129,6 +4132,18 @@ dxf_mline_set_area_fill_parameters
                   __FUNCTION__);
                 return (NULL);
         }
+        if (mline->area_fill_parameters_count == 0)
+        {
+                parameters = dxf_array_reserve (mline->area_fill_parameters,
+                  0, &mline->area_fill_parameters_capacity, 1,
+                  sizeof (double));
+                if (parameters == NULL)
+                {
+                        return (NULL);
+                }
+                mline->area_fill_parameters = parameters;
+                mline->area_fill_parameters_count = 1;
+        }
         *(mline->area_fill_parameters) = *area_fill_parameters;
 #if DEBUG
         DXF_DEBUG_END
@@ -4633,7 +4648,7 @@ dxf_mline_get_extrusion_vector_as_point
                 /*!< a pointer to a DXF \c MLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         DxfPoint *point = NULL;
@@ -4677,7 +4692,7 @@ dxf_mline_get_extr_x0
                 /*!< a pointer to a DXF \c MLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -4713,7 +4728,7 @@ dxf_mline_set_extr_x0
                  * DXF \c MLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -4745,7 +4760,7 @@ dxf_mline_get_extr_y0
                 /*!< a pointer to a DXF \c MLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -4781,7 +4796,7 @@ dxf_mline_set_extr_y0
                  * DXF \c MLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -4813,7 +4828,7 @@ dxf_mline_get_extr_z0
                 /*!< a pointer to a DXF \c MLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -4849,7 +4864,7 @@ dxf_mline_set_extr_z0
                  * DXF \c MLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -4980,7 +4995,7 @@ dxf_mline_get_mlinestyle_dictionary
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (mline->mlinestyle_dictionary));
+        return (dxf_strdup (mline->mlinestyle_dictionary));
 }
 
 
@@ -5018,7 +5033,7 @@ dxf_mline_set_mlinestyle_dictionary
                   __FUNCTION__);
                 return (NULL);
         }
-        mline->mlinestyle_dictionary = strdup (mlinestyle_dictionary);
+        mline->mlinestyle_dictionary = dxf_strdup (mlinestyle_dictionary);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -41,6 +41,8 @@
 
 
 #include "mlinestyle.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -162,7 +164,8 @@ dxf_mlinestyle_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfPair pair;
         int i;
 
         /* Do some basic checks. */
@@ -171,8 +174,6 @@ dxf_mlinestyle_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (fp->acad_version_number < AutoCAD_14)
@@ -190,145 +191,118 @@ dxf_mlinestyle_read
                 mlinestyle = dxf_mlinestyle_init (mlinestyle);
         }
         i = 0;
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        /* Clean up. */
-                        free (temp_string);
-                        fclose (fp->fp);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "2") == 0)
-                {
-                        /* Now follows a string containing a mlinestyle
-                         * name string. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", mlinestyle->name);
-                }
-                if (strcmp (temp_string, "3") == 0)
-                {
-                        /* Now follows a string containing a description
-                         * string. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", mlinestyle->description);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &mlinestyle->id_code);
-                }
-                if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing an element
-                         * linetype. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", mlinestyle->element_linetype[i]);
-                        i++;
-                }
-                if (strcmp (temp_string, "49") == 0)
-                {
-                        /* Now follows a string containing an element
-                         * offset value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mlinestyle->element_offset[i]);
-                }
-                if (strcmp (temp_string, "51") == 0)
-                {
-                        /* Now follows a string containing a start angle
-                         * value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mlinestyle->start_angle);
-                }
-                if (strcmp (temp_string, "52") == 0)
-                {
-                        /* Now follows a string containing a end angle
-                         * value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mlinestyle->end_angle);
-                }
-                if ((strcmp (temp_string, "62") == 0)
-                  && (i == 0))
-                {
-                        /* Now follows a string containing a fill color
-                         * value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &mlinestyle->color);
-                        i++;
-                }
-                if ((strcmp (temp_string, "62") == 0)
-                  && (i > 0))
-                {
-                        /* Now follows a string containing an element
-                         * color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &mlinestyle->element_color[i]);
-                }
-                if (strcmp (temp_string, "70") == 0)
-                {
-                        /* Now follows a string containing a flags
-                         * value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &mlinestyle->flags);
-                }
-                if (strcmp (temp_string, "71") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing a number of
-                         * elements value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &mlinestyle->number_of_elements);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else if ((fp->acad_version_number >= AutoCAD_13)
-                        && (strcmp (temp_string, "100") == 0))
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "AcDbMlineStyle") != 0)
-                        {
+                        case 2:
+                                /* Now follows a string containing a mlinestyle
+                                 * name string. */
+                                free (mlinestyle->name);
+                                mlinestyle->name = dxf_pair_get_string (&pair);
+                                break;
+                        case 3:
+                                /* Now follows a string containing a description
+                                 * string. */
+                                free (mlinestyle->description);
+                                mlinestyle->description = dxf_pair_get_string (&pair);
+                                break;
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                mlinestyle->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 6:
+                                /* Now follows a string containing an element
+                                 * linetype. */
+                                mlinestyle->element_linetype[i] = dxf_pair_get_string (&pair);
+                                i++;
+                                break;
+                        case 49:
+                                /* Now follows a string containing an element
+                                 * offset value. */
+                                mlinestyle->element_offset[i] = dxf_pair_get_double (&pair);
+                                break;
+                        case 51:
+                                /* Now follows a string containing a start angle
+                                 * value. */
+                                mlinestyle->start_angle = dxf_pair_get_double (&pair);
+                                break;
+                        case 52:
+                                /* Now follows a string containing a end angle
+                                 * value. */
+                                mlinestyle->end_angle = dxf_pair_get_double (&pair);
+                                break;
+                        case 62:
+                                if (i == 0)
+                                {
+                                        /* Now follows a string containing a fill color
+                                         * value. */
+                                        mlinestyle->color = dxf_pair_get_int (&pair);
+                                        i++;
+                                }
+                                else if (i > 0)
+                                {
+                                        /* Now follows a string containing an element
+                                         * color value. */
+                                        mlinestyle->element_color[i] = dxf_pair_get_int (&pair);
+                                }
+                                break;
+                        case 70:
+                                /* Now follows a string containing a flags
+                                 * value. */
+                                mlinestyle->flags = dxf_pair_get_int (&pair);
+                                break;
+                        case 71:
+                                /* Now follows a string containing a number of
+                                 * elements value. */
+                                mlinestyle->number_of_elements = dxf_pair_get_int (&pair);
+                                break;
+                        case 100:
+                                if (fp->acad_version_number >= AutoCAD_13)
+                                {
+                                        /* Now follows a string containing the
+                                         * subclass marker value. */
+                                        dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                        if (strcmp (temp_string, "AcDbMlineStyle") != 0)
+                                        {
+                                                fprintf (stderr,
+                                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                                  __FUNCTION__, fp->filename, fp->line_number);
+                                        }
+                                }
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner dictionary. */
+                                free (mlinestyle->dictionary_owner_soft);
+                                mlinestyle->dictionary_owner_soft = dxf_pair_get_string (&pair);
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                free (mlinestyle->dictionary_owner_hard);
+                                mlinestyle->dictionary_owner_hard = dxf_pair_get_string (&pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, (_("DXF comment: %s\n")), temp_string);
+                                break;
+                        default:
                                 fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
                                   __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", mlinestyle->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", mlinestyle->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, (_("DXF comment: %s\n")), temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
-        /* Clean up. */
-        free (temp_string);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -387,21 +361,21 @@ dxf_mlinestyle_write
           && (fp->follow_strict_version_rules))
         {
                 fprintf (stderr,
-                  (_("Error in %s () illegal DXF version for this %s entity with id-code: %x.\n")),
+                  (_("Error in %s () illegal DXF version for this %s entity with id-code: %lx.\n")),
                   __FUNCTION__, dxf_entity_name, mlinestyle->id_code);
                 return (EXIT_FAILURE);
         }
         else
         {
                 fprintf (stderr,
-                  (_("Warning in %s () illegal DXF version for this %s entity with id-code: %x.\n")),
+                  (_("Warning in %s () illegal DXF version for this %s entity with id-code: %lx.\n")),
                   __FUNCTION__, dxf_entity_name, mlinestyle->id_code);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_string (fp, 0, dxf_entity_name);
         if (mlinestyle->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", mlinestyle->id_code);
+                dxf_write_hex (fp, 5, mlinestyle->id_code);
         }
         /*!
          * \todo for version R14.\n
@@ -416,33 +390,33 @@ dxf_mlinestyle_write
         if ((strcmp (mlinestyle->dictionary_owner_soft, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", mlinestyle->dictionary_owner_soft);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, mlinestyle->dictionary_owner_soft);
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (mlinestyle->dictionary_owner_hard, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", mlinestyle->dictionary_owner_hard);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, mlinestyle->dictionary_owner_hard);
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbMlineStyle\n");
+                dxf_write_string (fp, 100, "AcDbMlineStyle");
         }
-        fprintf (fp->fp, "  2\n%s\n", mlinestyle->name);
-        fprintf (fp->fp, " 70\n%d\n", mlinestyle->flags);
-        fprintf (fp->fp, "  3\n%s\n", mlinestyle->description);
-        fprintf (fp->fp, " 62\n%d\n", mlinestyle->color);
-        fprintf (fp->fp, " 51\n%lf\n", mlinestyle->start_angle);
-        fprintf (fp->fp, " 52\n%lf\n", mlinestyle->end_angle);
-        fprintf (fp->fp, " 71\n%d\n", mlinestyle->number_of_elements);
+        dxf_write_string (fp, 2, mlinestyle->name);
+        dxf_write_int (fp, 70, mlinestyle->flags);
+        dxf_write_string (fp, 3, mlinestyle->description);
+        dxf_write_int (fp, 62, mlinestyle->color);
+        dxf_write_double (fp, 51, mlinestyle->start_angle);
+        dxf_write_double (fp, 52, mlinestyle->end_angle);
+        dxf_write_int (fp, 71, mlinestyle->number_of_elements);
         for (i = 1; i < DXF_MAX_PARAM; i++)
         {
-                fprintf (fp->fp, " 49\n%lf\n", mlinestyle->element_offset[i]);
-                fprintf (fp->fp, " 62\n%d\n", mlinestyle->element_color[i]);
-                fprintf (fp->fp, "  6\n%s\n", mlinestyle->element_linetype[i]);
+                dxf_write_double (fp, 49, mlinestyle->element_offset[i]);
+                dxf_write_int (fp, 62, mlinestyle->element_color[i]);
+                dxf_write_string (fp, 6, mlinestyle->element_linetype[i]);
                 /*! \todo Check for overrun of array index. */
         }
         /* Clean up. */
@@ -510,7 +484,7 @@ dxf_mlinestyle_free_chain
                 /*!< a pointer to the chain of DXF \c MLINESTYLE objects. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (mlinestyles == NULL)
@@ -536,7 +510,7 @@ dxf_mlinestyle_free_chain
  *
  * \return \c id_code.
  */
-int
+long
 dxf_mlinestyle_get_id_code
 (
         DxfMlinestyle *mlinestyle
@@ -576,7 +550,7 @@ dxf_mlinestyle_set_id_code
 (
         DxfMlinestyle *mlinestyle,
                 /*!< a pointer to a DXF \c MLINESTYLE object. */
-        int id_code
+        long id_code
                 /*!< Identification number for the object.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -1017,7 +991,7 @@ dxf_mlinestyle_get_element_offset
                 /*!< a pointer to a DXF \c MLINESTYLE object. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -1060,7 +1034,7 @@ dxf_mlinestyle_set_element_offset
                  * be set for the object. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
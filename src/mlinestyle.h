@@ -70,7 +70,7 @@ typedef struct
 dxf_mlinestyle_struct
 {
         /* Members common for all DXF objects. */
-        int id_code;
+        long id_code;
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file.\n
@@ -163,7 +163,7 @@ dxf_mlinestyle_free_chain
 (
         DxfMlinestyle *mlinestyles
 );
-int
+long
 dxf_mlinestyle_get_id_code
 (
         DxfMlinestyle *mlinestyle
@@ -172,7 +172,7 @@ DxfMlinestyle *
 dxf_mlinestyle_set_id_code
 (
         DxfMlinestyle *mlinestyle,
-        int id_code
+        long id_code
 );
 char *
 dxf_mlinestyle_get_dictionary_owner_soft
@@ -33,6 +33,9 @@
 
 
 #include "mtext.h"
+#include "arena.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -58,7 +61,7 @@ dxf_mtext_new ()
         size = sizeof (DxfMtext);
         /* avoid malloc of 0 bytes */
         if (size == 0) size = 1;
-        if ((mtext = malloc (size)) == NULL)
+        if ((mtext = dxf_malloc (size)) == NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () could not allocate memory for a DxfMtext struct.\n")),
@@ -98,8 +101,6 @@ dxf_mtext_init
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        int i;
-
         /* Do some basic checks. */
         if (mtext == NULL)
         {
@@ -116,22 +117,18 @@ dxf_mtext_init
               return (NULL);
         }
         mtext->id_code = 0;
-        mtext->text_value = strdup ("");
-        for (i = 1; i < DXF_MAX_PARAM; i++)
-        {
-                mtext->text_additional_value[i] = strdup ("");
-        }
-        mtext->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        mtext->text_style = strdup ("");
-        mtext->layer = strdup (DXF_DEFAULT_LAYER);
+        mtext->text_value = dxf_strdup ("");
+        mtext->text_additional_value = NULL;
+        mtext->number_of_text_additional_values = 0;
+        mtext->text_additional_value_capacity = 0;
+        mtext->properties = dxf_graphic_properties_default ();
+        mtext->text_style = dxf_strdup ("");
         mtext->x0 = 0.0;
         mtext->y0 = 0.0;
         mtext->z0 = 0.0;
         mtext->x1 = 0.0;
         mtext->y1 = 0.0;
         mtext->z1 = 0.0;
-        mtext->elevation = 0.0;
-        mtext->thickness = 0.0;
         mtext->height = 0.0;
         mtext->rectangle_width = 0.0;
         mtext->horizontal_width = 0.0;
@@ -142,9 +139,7 @@ dxf_mtext_init
         mtext->column_gutter = 0.0;
         mtext->column_heights = 0.0;
         mtext->rot_angle = 0.0;
-        mtext->color = DXF_COLOR_BYLAYER;
         mtext->background_color = 0;
-        mtext->paperspace = DXF_MODELSPACE;
         mtext->attachment_point = 0;
         mtext->drawing_direction = 0;
         mtext->spacing_style = 0;
@@ -157,7 +152,7 @@ dxf_mtext_init
         mtext->extr_y0 = 0.0;
         mtext->extr_z0 = 0.0;
         mtext->background_color_rgb = 0;
-        mtext->background_color_name = strdup ("");
+        mtext->background_color_name = dxf_strdup ("");
         mtext->background_transparency = 0;
 #if DEBUG
         DXF_DEBUG_END
@@ -175,8 +170,7 @@ dxf_mtext_init
  * section marker \c ENDSEC. \n
  * While parsing the DXF file store data in \c mtext. \n
  *
- * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
- * occurred.
+ * \return a pointer to \c mtext.
  *
  * \version According to DXF R10 (backward compatibility).
  * \version According to DXF R11 (backward compatibility).
@@ -196,7 +190,10 @@ dxf_mtext_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfGraphicProperties properties;
+        DxfPair pair;
+        char **text_additional_values;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -204,8 +201,6 @@ dxf_mtext_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (mtext == NULL)
@@ -216,299 +211,249 @@ dxf_mtext_read
                 mtext = dxf_mtext_new ();
                 mtext = dxf_mtext_init (mtext);
         }
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
-        {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        fclose (fp->fp);
-                        /* Clean up. */
-                        free (temp_string);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "1") == 0)
-                {
-                        /* Now follows a string containing a text value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", mtext->text_value);
-                }
-                else if (strcmp (temp_string, "3") == 0)
-                {
-                        /* Now follows a string containing a text value. */
-                        (fp->line_number)++;
-                        //fscanf (fp->fp, "%s\n", mtext->text_additional_value[number_additional]);
-                        //number_additional++;
-                }
-                /*!< I'm not sure this number_additional is correct.*/
-                else if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &mtext->id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", mtext->linetype);
-                }
-                else if (strcmp (temp_string, "7") == 0)
-                {
-                        /* Now follows a string containing a text style
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", mtext->text_style);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", mtext->layer);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the insertion point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mtext->x0);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the insertion point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mtext->y0);
-                }
-                else if (strcmp (temp_string, "30") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the insertion point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mtext->z0);
-                }
-                else if ((fp->acad_version_number <= AutoCAD_11)
-                  && DXF_FLATLAND
-                  && (strcmp (temp_string, "38") == 0))
-                {
-                        /* Now follows a string containing the
-                         * elevation. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mtext->elevation);
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mtext->thickness);
-                }
-                else if (strcmp (temp_string, "40") == 0)
-                {
-                        /* Now follows a string containing the
-                         * height. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mtext->height);
-                }
-                else if (strcmp (temp_string, "41") == 0)
-                {
-                        /* Now follows a string containing the
-                         * reference rectangle width. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mtext->rectangle_width);
-                }
-                else if (strcmp (temp_string, "42") == 0)
-                {
-                        /* Now follows a string containing the
-                         * horizontal width of the characters. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mtext->horizontal_width);
-                }
-                else if (strcmp (temp_string, "43") == 0)
-                {
-                        /* Now follows a string containing the
-                         * vertical rectangle height. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mtext->rectangle_height);
-                }
-                else if (strcmp (temp_string, "44") == 0)
-                {
-                        /* Now follows a string containing the
-                         * text line spacing factor. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mtext->spacing_factor);
-                }
-                else if (strcmp (temp_string, "45") == 0)
-                {
-                        /* Now follows a string containing the
-                         * fill box scale (border around text). */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mtext->box_scale);
-                }
-                else if (strcmp (temp_string, "48") == 0)
-                {
-                        /* Now follows a string containing the
-                         * column width. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mtext->column_width);
-                }
-                else if (strcmp (temp_string, "49") == 0)
-                {
-                        /* Now follows a string containing the
-                         * column gutter. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mtext->column_gutter);
-                }
-                else if ((fp->acad_version_number <= AutoCAD_2006)
-                        && (strcmp (temp_string, "50") == 0))
-                {
-                        /* Now follows a string containing the
-                         * rotation angle. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mtext->rot_angle);
-                }
-                else if ((fp->acad_version_number >= AutoCAD_2007)
-                        && (strcmp (temp_string, "50") == 0))
-                {
-                        /* Can follows a string containing the
-                         * rotation angle or column heights. */
-                        (fp->line_number)++;
-                /*!< Add more code here, I'm stop because the double use of group code 50*/
-                }
-                else if (strcmp (temp_string, "63") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color to use for background fill. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &mtext->background_color);
-                }
-                else if (strcmp (temp_string, "71") == 0)
-                {
-                        /* Now follows a string containing the
-                         * attachment point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &mtext->attachment_point);
-                }
-                else if (strcmp (temp_string, "72") == 0)
-                {
-                        /* Now follows a string containing the
-                         * drawing direction. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &mtext->drawing_direction);
-                }
-                else if (strcmp (temp_string, "73") == 0)
-                {
-                        /* Now follows a string containing the
-                         * mtext line spacing style. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &mtext->spacing_style);
-                }
-                else if (strcmp (temp_string, "75") == 0)
-                {
-                        /* Now follows a string containing the
-                         * column type. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &mtext->column_type);
-                }
-                else if (strcmp (temp_string, "76") == 0)
-                {
-                        /* Now follows a string containing the
-                         * column count. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &mtext->column_count);
-                }
-                else if (strcmp (temp_string, "78") == 0)
-                {
-                        /* Now follows a string containing the
-                         * column flow reverse. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &mtext->column_flow);
-                }
-                else if (strcmp (temp_string, "79") == 0)
-                {
-                        /* Now follows a string containing the
-                         * column autoheight. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &mtext->column_autoheight);
-                }
-                else if (strcmp (temp_string, "90") == 0)
-                {
-                        /* Now follows a string containing the
-                         * background fill setting. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &mtext->background_fill);
-                }
-                else if ((fp->acad_version_number >= AutoCAD_13)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if ((strcmp (temp_string, "AcDbEntity") != 0)
-                        && ((strcmp (temp_string, "AcDbMText") != 0)))
-                        {
+        dxf_graphic_properties_start (&properties, mtext->properties);
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
+        {
+                if (pair.group_code == 0)
+                {
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
+                }
+                switch (pair.group_code)
+                {
+                        case 1:
+                                /* Now follows a string containing a text value. */
+                                dxf_free (mtext->text_value);
+                                mtext->text_value = dxf_pair_get_string (&pair);
+                                break;
+                        case 3:
+                                /* Now follows a string containing an
+                                 * additional text value. */
+                                text_additional_values = dxf_array_reserve (mtext->text_additional_value,
+                                  mtext->number_of_text_additional_values,
+                                  &mtext->text_additional_value_capacity,
+                                  mtext->number_of_text_additional_values + 1,
+                                  sizeof (char *));
+                                if (text_additional_values != NULL)
+                                {
+                                        mtext->text_additional_value = text_additional_values;
+                                        mtext->text_additional_value[mtext->number_of_text_additional_values] = dxf_pair_get_string (&pair);
+                                        mtext->number_of_text_additional_values++;
+                                }
+                                break;
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                mtext->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 6:
+                                /* Now follows a string containing a linetype
+                                 * name. */
+                                dxf_lexer_free_string (fp, properties.linetype);
+                                properties.linetype = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 7:
+                                /* Now follows a string containing a text style
+                                 * name. */
+                                dxf_free (mtext->text_style);
+                                mtext->text_style = dxf_pair_get_string (&pair);
+                                break;
+                        case 8:
+                                /* Now follows a string containing a layer name. */
+                                dxf_lexer_free_string (fp, properties.layer);
+                                properties.layer = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 10:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the insertion point. */
+                                mtext->x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 20:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the insertion point. */
+                                mtext->y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 30:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the insertion point. */
+                                mtext->z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 38:
+                                if ((fp->acad_version_number <= AutoCAD_11)
+                                  && DXF_FLATLAND)
+                                {
+                                        /* Now follows a string containing the
+                                         * elevation. */
+                                        properties.elevation = dxf_pair_get_double (&pair);
+                                }
+                                break;
+                        case 39:
+                                /* Now follows a string containing the
+                                 * thickness. */
+                                properties.thickness = dxf_pair_get_double (&pair);
+                                break;
+                        case 40:
+                                /* Now follows a string containing the
+                                 * height. */
+                                mtext->height = dxf_pair_get_double (&pair);
+                                break;
+                        case 41:
+                                /* Now follows a string containing the
+                                 * reference rectangle width. */
+                                mtext->rectangle_width = dxf_pair_get_double (&pair);
+                                break;
+                        case 42:
+                                /* Now follows a string containing the
+                                 * horizontal width of the characters. */
+                                mtext->horizontal_width = dxf_pair_get_double (&pair);
+                                break;
+                        case 43:
+                                /* Now follows a string containing the
+                                 * vertical rectangle height. */
+                                mtext->rectangle_height = dxf_pair_get_double (&pair);
+                                break;
+                        case 44:
+                                /* Now follows a string containing the
+                                 * text line spacing factor. */
+                                mtext->spacing_factor = dxf_pair_get_double (&pair);
+                                break;
+                        case 45:
+                                /* Now follows a string containing the
+                                 * fill box scale (border around text). */
+                                mtext->box_scale = dxf_pair_get_double (&pair);
+                                break;
+                        case 48:
+                                /* Now follows a string containing the
+                                 * column width. */
+                                mtext->column_width = dxf_pair_get_double (&pair);
+                                break;
+                        case 49:
+                                /* Now follows a string containing the
+                                 * column gutter. */
+                                mtext->column_gutter = dxf_pair_get_double (&pair);
+                                break;
+                        case 50:
+                                if (fp->acad_version_number <= AutoCAD_2006)
+                                {
+                                        /* Now follows a string containing the
+                                         * rotation angle. */
+                                        mtext->rot_angle = dxf_pair_get_double (&pair);
+                                }
+                                else if (fp->acad_version_number >= AutoCAD_2007)
+                                {
+                                        /* Can follows a string containing the
+                                         * rotation angle or column heights. */
+                                /*!< Add more code here, I'm stop because the double use of group code 50*/
+                                }
+                                break;
+                        case 63:
+                                /* Now follows a string containing the
+                                 * color to use for background fill. */
+                                mtext->background_color = dxf_pair_get_int (&pair);
+                                break;
+                        case 71:
+                                /* Now follows a string containing the
+                                 * attachment point. */
+                                mtext->attachment_point = dxf_pair_get_int (&pair);
+                                break;
+                        case 72:
+                                /* Now follows a string containing the
+                                 * drawing direction. */
+                                mtext->drawing_direction = dxf_pair_get_int (&pair);
+                                break;
+                        case 73:
+                                /* Now follows a string containing the
+                                 * mtext line spacing style. */
+                                mtext->spacing_style = dxf_pair_get_int (&pair);
+                                break;
+                        case 75:
+                                /* Now follows a string containing the
+                                 * column type. */
+                                mtext->column_type = dxf_pair_get_int (&pair);
+                                break;
+                        case 76:
+                                /* Now follows a string containing the
+                                 * column count. */
+                                mtext->column_count = dxf_pair_get_int (&pair);
+                                break;
+                        case 78:
+                                /* Now follows a string containing the
+                                 * column flow reverse. */
+                                mtext->column_flow = dxf_pair_get_int (&pair);
+                                break;
+                        case 79:
+                                /* Now follows a string containing the
+                                 * column autoheight. */
+                                mtext->column_autoheight = dxf_pair_get_int (&pair);
+                                break;
+                        case 90:
+                                /* Now follows a string containing the
+                                 * background fill setting. */
+                                mtext->background_fill = dxf_pair_get_int (&pair);
+                                break;
+                        case 100:
+                                if (fp->acad_version_number >= AutoCAD_13)
+                                {
+                                        /* Now follows a string containing the
+                                         * subclass marker value. */
+                                        dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                        if ((strcmp (temp_string, "AcDbEntity") != 0)
+                                        && ((strcmp (temp_string, "AcDbMText") != 0)))
+                                        {
+                                                fprintf (stderr,
+                                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                                  __FUNCTION__, fp->filename, fp->line_number);
+                                        }
+                                }
+                                break;
+                        case 210:
+                                /* Now follows a string containing the
+                                 * X-value of the extrusion vector. */
+                                mtext->extr_x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 220:
+                                /* Now follows a string containing the
+                                 * Y-value of the extrusion vector. */
+                                mtext->extr_y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 230:
+                                /* Now follows a string containing the
+                                 * Z-value of the extrusion vector. */
+                                mtext->extr_z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, "DXF comment: %s\n", temp_string);
+                                break;
+                        default:
                                 fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
                                   __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "210") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mtext->extr_x0);
-                }
-                else if (strcmp (temp_string, "220") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mtext->extr_y0);
-                }
-                else if (strcmp (temp_string, "230") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &mtext->extr_z0);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
         /* Handle omitted members and/or illegal values. */
-        if (strcmp (mtext->linetype, "") == 0)
+        if ((properties.linetype != NULL)
+          && (strcmp (properties.linetype, "") == 0))
         {
-                mtext->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_lexer_free_string (fp, properties.linetype);
+                properties.linetype = dxf_strdup (DXF_DEFAULT_LINETYPE);
         }
-        if (strcmp (mtext->layer, "") == 0)
+        if ((properties.layer != NULL)
+          && (strcmp (properties.layer, "") == 0))
         {
-                mtext->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_lexer_free_string (fp, properties.layer);
+                properties.layer = dxf_strdup (DXF_DEFAULT_LAYER);
         }
-        /* Clean up. */
-        free (temp_string);
+        /* Entities with equal properties share a record. */
+        dxf_graphic_properties_finish (fp, &mtext->properties, &properties);
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (EXIT_SUCCESS);
+        return (mtext);
 }
 
 
@@ -543,7 +488,7 @@ dxf_mtext_write
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *dxf_entity_name = strdup ("MTEXT");
+        char *dxf_entity_name = dxf_strdup ("MTEXT");
         int i;
 
         /* Do some basic checks. */
@@ -553,7 +498,7 @@ dxf_mtext_write
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (mtext == NULL)
@@ -562,48 +507,56 @@ dxf_mtext_write
                   (_("Error in %s () a NULL pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if ((fp->acad_version_number < AutoCAD_13)
           && (fp->follow_strict_version_rules))
         {
                 fprintf (stderr,
-                  (_("Error in %s () illegal DXF version for this %s entity with id-code: %x.\n")),
+                  (_("Error in %s () illegal DXF version for this %s entity with id-code: %lx.\n")),
                   __FUNCTION__, dxf_entity_name, mtext->id_code);
                 return (EXIT_FAILURE);
         }
         else
         {
                 fprintf (stderr,
-                  (_("Warning in %s () illegal DXF version for this %s entity with id-code: %x.\n")),
+                  (_("Warning in %s () illegal DXF version for this %s entity with id-code: %lx.\n")),
                   __FUNCTION__, dxf_entity_name, mtext->id_code);
         }
-        if (strcmp (mtext->linetype, "") == 0)
+        if (strcmp (mtext->properties->linetype, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, mtext->id_code);
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                mtext->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                if (dxf_graphic_properties_unshare (&mtext->properties) != NULL)
+                {
+                        dxf_free (mtext->properties->linetype);
+                        mtext->properties->linetype = dxf_strdup (DXF_DEFAULT_LINETYPE);
+                }
         }
-        if (strcmp (mtext->layer, "") == 0)
+        if (strcmp (mtext->properties->layer, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty layer string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty layer string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, mtext->id_code);
                 fprintf (stderr,
                   (_("\t%s entity is relocated to layer 0")),
                   dxf_entity_name);
-                mtext->layer = DXF_DEFAULT_LAYER;
+                if (dxf_graphic_properties_unshare (&mtext->properties) != NULL)
+                {
+                        dxf_free (mtext->properties->layer);
+                        mtext->properties->layer = dxf_strdup (DXF_DEFAULT_LAYER);
+                }
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_string (fp, 0, dxf_entity_name);
         if (mtext->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", mtext->id_code);
+                dxf_write_hex (fp, 5, mtext->id_code);
         }
         /*!
          * \todo for version R14.\n
@@ -618,89 +571,87 @@ dxf_mtext_write
         if ((strcmp (mtext->dictionary_owner_soft, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", mtext->dictionary_owner_soft);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, mtext->dictionary_owner_soft);
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (mtext->dictionary_owner_hard, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", mtext->dictionary_owner_hard);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, mtext->dictionary_owner_hard);
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbEntity\n");
+                dxf_write_string (fp, 100, "AcDbEntity");
         }
-        if (mtext->paperspace == DXF_PAPERSPACE)
+        if (mtext->properties->paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp->fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_int (fp, 67, DXF_PAPERSPACE);
         }
-        fprintf (fp->fp, "  8\n%s\n", mtext->layer);
-        if (strcmp (mtext->linetype, DXF_DEFAULT_LINETYPE) != 0)
+        dxf_write_string (fp, 8, mtext->properties->layer);
+        if (strcmp (mtext->properties->linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp->fp, "  6\n%s\n", mtext->linetype);
+                dxf_write_string (fp, 6, mtext->properties->linetype);
         }
-        if (mtext->color != DXF_COLOR_BYLAYER)
+        if (mtext->properties->color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp->fp, " 62\n%d\n", mtext->color);
+                dxf_write_int (fp, 62, mtext->properties->color);
         }
         if ((fp->acad_version_number <= AutoCAD_11)
           && DXF_FLATLAND
-          && (mtext->elevation != 0.0))
+          && (mtext->properties->elevation != 0.0))
         {
-                fprintf (fp->fp, " 38\n%f\n", mtext->elevation);
+                dxf_write_double (fp, 38, mtext->properties->elevation);
         }
-        if (mtext->thickness != 0.0)
+        if (mtext->properties->thickness != 0.0)
         {
-                fprintf (fp->fp, " 39\n%f\n", mtext->thickness);
+                dxf_write_double (fp, 39, mtext->properties->thickness);
         }
-        if (mtext->linetype_scale != 1.0)
+        if (mtext->properties->linetype_scale != 1.0)
         {
-                fprintf (fp->fp, " 48\n%f\n", mtext->linetype_scale);
+                dxf_write_double (fp, 48, mtext->properties->linetype_scale);
         }
-        if (mtext->visibility != 0)
+        if (mtext->properties->visibility != 0)
         {
-                fprintf (fp->fp, " 60\n%d\n", mtext->visibility);
+                dxf_write_int (fp, 60, mtext->properties->visibility);
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbMText\n");
+                dxf_write_string (fp, 100, "AcDbMText");
         }
-        fprintf (fp->fp, " 10\n%f\n", mtext->x0);
-        fprintf (fp->fp, " 20\n%f\n", mtext->y0);
-        fprintf (fp->fp, " 30\n%f\n", mtext->z0);
-        fprintf (fp->fp, " 40\n%f\n", mtext->height);
-        fprintf (fp->fp, " 41\n%f\n", mtext->rectangle_width);
-        fprintf (fp->fp, " 71\n%d\n", mtext->attachment_point);
-        fprintf (fp->fp, " 72\n%d\n", mtext->drawing_direction);
-        fprintf (fp->fp, "  1\n%s\n", mtext->text_value);
-        i = 0;
-        while (strlen (mtext->text_additional_value[i]) > 0)
+        dxf_write_double (fp, 10, mtext->x0);
+        dxf_write_double (fp, 20, mtext->y0);
+        dxf_write_double (fp, 30, mtext->z0);
+        dxf_write_double (fp, 40, mtext->height);
+        dxf_write_double (fp, 41, mtext->rectangle_width);
+        dxf_write_int (fp, 71, mtext->attachment_point);
+        dxf_write_int (fp, 72, mtext->drawing_direction);
+        dxf_write_string (fp, 1, mtext->text_value);
+        for (i = 0; i < mtext->number_of_text_additional_values; i++)
         {
-                fprintf (fp->fp, "  3\n%s\n", mtext->text_additional_value[i]);
-                i++;
+                dxf_write_string (fp, 3, mtext->text_additional_value[i]);
         }
-        fprintf (fp->fp, "  7\n%s\n", mtext->text_style);
+        dxf_write_string (fp, 7, mtext->text_style);
 
         if ((fp->acad_version_number >= AutoCAD_12)
                 && (mtext->extr_x0 != 0.0)
                 && (mtext->extr_y0 != 0.0)
                 && (mtext->extr_z0 != 1.0))
         {
-                fprintf (fp->fp, "210\n%f\n", mtext->extr_x0);
-                fprintf (fp->fp, "220\n%f\n", mtext->extr_y0);
-                fprintf (fp->fp, "230\n%f\n", mtext->extr_z0);
+                dxf_write_double (fp, 210, mtext->extr_x0);
+                dxf_write_double (fp, 220, mtext->extr_y0);
+                dxf_write_double (fp, 230, mtext->extr_z0);
         }
-        fprintf (fp->fp, " 11\n%f\n", mtext->x1);
-        fprintf (fp->fp, " 21\n%f\n", mtext->y1);
-        fprintf (fp->fp, " 31\n%f\n", mtext->z1);
-        fprintf (fp->fp, " 42\n%f\n", mtext->horizontal_width);
-        fprintf (fp->fp, " 43\n%f\n", mtext->rectangle_height);
-        fprintf (fp->fp, " 50\n%f\n", mtext->rot_angle);
+        dxf_write_double (fp, 11, mtext->x1);
+        dxf_write_double (fp, 21, mtext->y1);
+        dxf_write_double (fp, 31, mtext->z1);
+        dxf_write_double (fp, 42, mtext->horizontal_width);
+        dxf_write_double (fp, 43, mtext->rectangle_height);
+        dxf_write_double (fp, 50, mtext->rot_angle);
         /* Clean up. */
-        free (dxf_entity_name);
+        dxf_free (dxf_entity_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -740,18 +691,18 @@ dxf_mtext_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (mtext->linetype);
-        free (mtext->layer);
-        free (mtext->text_value);
-        for (i = 0; i < DXF_MAX_PARAM; i++)
+        dxf_graphic_properties_free (mtext->properties);
+        dxf_free (mtext->text_value);
+        for (i = 0; i < mtext->number_of_text_additional_values; i++)
         {
-                free (mtext->text_additional_value[i]);
+                dxf_free (mtext->text_additional_value[i]);
         }
-        free (mtext->text_style);
-        free (mtext->dictionary_owner_soft);
-        free (mtext->dictionary_owner_hard);
-        free (mtext->background_color_name);
-        free (mtext);
+        dxf_free (mtext->text_additional_value);
+        dxf_free (mtext->text_style);
+        dxf_free (mtext->dictionary_owner_soft);
+        dxf_free (mtext->dictionary_owner_hard);
+        dxf_free (mtext->background_color_name);
+        dxf_free (mtext);
         mtext = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -777,7 +728,7 @@ dxf_mtext_free_chain
                 /*!< a pointer to the chain of DXF \c MTEXT entities. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (mtexts == NULL)
@@ -798,4 +749,45 @@ dxf_mtext_free_chain
 }
 
 
+/*!
+ * \brief Append a copy of \c text_additional_value to the additional
+ * text values of a DXF \c MTEXT entity.
+ *
+ * \return a pointer to \c mtext when successful, or \c NULL when an
+ * error occurred.
+ */
+DxfMtext *
+dxf_mtext_append_text_additional_value
+(
+        DxfMtext *mtext,
+                /*!< a pointer to a DXF \c MTEXT entity. */
+        char *text_additional_value
+                /*!< the additional text value. */
+)
+{
+        char **text_additional_values;
+
+        /* Do some basic checks. */
+        if ((mtext == NULL) || (text_additional_value == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        text_additional_values = dxf_array_reserve (mtext->text_additional_value,
+          mtext->number_of_text_additional_values,
+          &mtext->text_additional_value_capacity,
+          mtext->number_of_text_additional_values + 1, sizeof (char *));
+        if (text_additional_values == NULL)
+        {
+                return (NULL);
+        }
+        mtext->text_additional_value = text_additional_values;
+        mtext->text_additional_value[mtext->number_of_text_additional_values] = dxf_strdup (text_additional_value);
+        mtext->number_of_text_additional_values++;
+        return (mtext);
+}
+
+
 /* EOF */
@@ -37,6 +37,7 @@
 
 
 #include "global.h"
+#include "graphic_properties.h"
 
 
 #ifdef __cplusplus
@@ -57,46 +58,16 @@ typedef struct
 dxf_mtext
 {
         /* Members common for all DXF drawable entities. */
-        int id_code;
+        long id_code;
                 /*!< Identification code for the entity.\n
                  * This is to be an unique sequential code in the DXF
                  * file (the number can be hexadecimal).\n
                  * Group code = 5. */
-        char *linetype;
-                /*!< The linetype of the entity.\n
-                 * Defaults to \c BYLAYER if ommitted in the DXF file.\n
-                 * Group code = 6. */
-        char *layer;
-                /*!< Layer on which the entity is drawn.\n
-                 * Defaults to layer "0" if no valid layername is given.\n
-                 * Group code = 8. */
-        double elevation;
-                /*!< Elevation of the arc in the local Z-direction.\n
-                 * Defaults to 0.0 if omitted in the DXF file, or prior
-                 * to DXF version R12, or DXF_FLATLAND equals 0 (default).\n
-                 * Group code = 38. */
-        double thickness;
-                /*!< Thickness of the arc in the local Z-direction.\n
-                 * Defaults to 0.0 if ommitted in the DXF file.\n
-                * Group code = 39. */
-        double linetype_scale;
-                /*!< group code = 48\n
-                 * Linetype scale (optional). */
-        int16_t visibility;
-                /*!< group code = 60\n
-                 * Object visibility (optional): 0 = Visible; 1 = Invisible. */
-        int color;
-                /*!< Color of the entity.\n
-                 * Defaults to \c BYLAYER if ommitted in the DXF file.\n
-                 * Note that entities encapsulated in a block with the
-                 * color \c BYBLOCK are represented in the "native" color of
-                 * the \c BLOCK entity.\n
-                 * Group code = 62. */
-        int paperspace;
-                /*!< Entities are to be drawn on either \c PAPERSPACE or
-                 * \c MODELSPACE.\n
-                 * Optional, defaults to \c DXF_MODELSPACE (0).\n
-                 * Group code = 67. */
+        DxfGraphicProperties *properties;
+                /*!< Linetype, layer, color and the other graphic
+                 * properties, shared with the entities which have
+                 * the same (see graphic_properties.h).\n
+                 * Group codes = 6, 8, 38, 39, 48, 60, 62 and 67. */
         char *dictionary_owner_soft;
                 /*!< group code = 330\n
                  * Soft-pointer ID/handle to owner dictionary (optional). */
@@ -114,10 +85,16 @@ dxf_mtext
                  * If group 3 codes are used, the last group is a group
                  * 1 and has fewer than 250 characters.\n
                  * Group code = 1. */
-        char *text_additional_value[DXF_MAX_PARAM];
+        char **text_additional_value;
                 /*!< Optional, only if the text string in group 1 is
-                 * greater than 250 characters.\n
+                 * greater than 250 characters,
+                 * \c number_of_text_additional_values entries.\n
                  * Group code = 3. */
+        int number_of_text_additional_values;
+                /*!< Number of entries in \c text_additional_value. */
+        int text_additional_value_capacity;
+                /*!< Number of entries \c text_additional_value has room
+                 * for. */
         char *text_style;
                 /*!< Text style.\n
                  * Optional, defaults to \c STANDARD.\n
@@ -307,6 +284,12 @@ dxf_mtext_free_chain
 (
         DxfMtext *mtexts
 );
+DxfMtext *
+dxf_mtext_append_text_additional_value
+(
+        DxfMtext *mtext,
+        char *text_additional_value
+);
 
 
 #ifdef __cplusplus
@@ -0,0 +1,1677 @@
+/*!
+ * \file number.c
+ *
+ * \author Copyright (C) 2017 by the libDXF developers.
+ *
+ * \brief Locale independent number parsing for DXF values.
+ *
+ * Coordinates, handles and integers make up the bulk of a DXF file, so
+ * these parsers work directly on the value slices handed out by the
+ * lexer and never go through \c strtod () or \c scanf (), which are
+ * slow and honour the current locale (a DXF file always uses a "."
+ * as decimal separator).\n
+ * For the same reasons the writer formats numbers with the
+ * dxf_number_format_* () functions instead of \c printf ().
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+
+
+#include "number.h"
+
+#include <float.h>
+
+
+/*!
+ * \brief Use the exact fast path for short decimal values.
+ *
+ * The fast path relies on double arithmetic being done in double
+ * precision, which is not the case with the x87 FPU.
+ */
+#if defined (FLT_EVAL_METHOD) && (FLT_EVAL_METHOD != 0)
+#define DXF_NUMBER_FAST_PATH 0
+#else
+#define DXF_NUMBER_FAST_PATH 1
+#endif
+
+
+/*!
+ * \brief Maximum number of decimal digits kept by the slow path.
+ *
+ * 800 digits is enough to convert any double exactly.
+ */
+#define DXF_NUMBER_DECIMAL_DIGITS 800
+
+
+/*!
+ * \brief Largest shift done in one step by the slow path.
+ */
+#define DXF_NUMBER_MAX_SHIFT 60
+
+
+/*!
+ * \brief Arbitrary precision decimal number used by the slow path of
+ * dxf_number_parse_double ().
+ */
+typedef struct
+dxf_number_decimal
+{
+        unsigned char d[DXF_NUMBER_DECIMAL_DIGITS];
+                /*!< digits (0 ... 9), most significant first. */
+        int nd;
+                /*!< number of digits used. */
+        int dp;
+                /*!< position of the decimal point. */
+        int negative;
+                /*!< the number is negative. */
+        int truncated;
+                /*!< non-zero digits were dropped beyond \c nd. */
+} DxfNumberDecimal;
+
+
+/*!
+ * \brief Floating point number f * 2^e with a 64 bit significand, as
+ * used by Grisu3 in dxf_number_format_double ().
+ */
+typedef struct
+dxf_number_diy_fp
+{
+        uint64_t f;
+                /*!< significand. */
+        int e;
+                /*!< binary exponent. */
+} DxfNumberDiyFp;
+
+
+/*!
+ * \brief A power of ten 10^decimal_exponent, as f * 2^e rounded to 64
+ * bits.
+ */
+typedef struct
+dxf_number_cached_power
+{
+        uint64_t f;
+                /*!< normalized significand. */
+        int e;
+                /*!< binary exponent. */
+        int decimal_exponent;
+                /*!< decimal exponent. */
+} DxfNumberCachedPower;
+
+
+#define XX 0xff
+
+/*!
+ * \brief Value of every hexadecimal digit, indexed by character.
+ *
+ * Characters which are not a hexadecimal digit map to 0xff.
+ */
+static const unsigned char dxf_number_hex_digits[256] =
+{
+        /* 0x00 */ XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+        /* 0x10 */ XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+        /* 0x20 */ XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+        /* 0x30 */  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, XX, XX, XX, XX, XX, XX,
+        /* 0x40 */ XX, 10, 11, 12, 13, 14, 15, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+        /* 0x50 */ XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+        /* 0x60 */ XX, 10, 11, 12, 13, 14, 15, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+        /* 0x70 */ XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+        /* 0x80 */ XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+        /* 0x90 */ XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+        /* 0xa0 */ XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+        /* 0xb0 */ XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+        /* 0xc0 */ XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+        /* 0xd0 */ XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+        /* 0xe0 */ XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+        /* 0xf0 */ XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX
+};
+
+#undef XX
+
+
+/*!
+ * \brief Exact powers of ten as double.
+ */
+static const double dxf_number_powers_of_ten[] =
+{
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+
+/*!
+ * \brief The decimal digits of 0 ... 99, two characters each.
+ */
+static const char dxf_number_digit_pairs[] =
+        "00010203040506070809"
+        "10111213141516171819"
+        "20212223242526272829"
+        "30313233343536373839"
+        "40414243444546474849"
+        "50515253545556575859"
+        "60616263646566676869"
+        "70717273747576777879"
+        "80818283848586878889"
+        "90919293949596979899";
+
+
+/*!
+ * \brief Every eighth power of ten from 10^-348 to 10^340, for Grisu3.
+ */
+static const DxfNumberCachedPower dxf_number_cached_powers[] =
+{
+        { 0xfa8fd5a0081c0288ULL, -1220, -348 },
+        { 0xbaaee17fa23ebf76ULL, -1193, -340 },
+        { 0x8b16fb203055ac76ULL, -1166, -332 },
+        { 0xcf42894a5dce35eaULL, -1140, -324 },
+        { 0x9a6bb0aa55653b2dULL, -1113, -316 },
+        { 0xe61acf033d1a45dfULL, -1087, -308 },
+        { 0xab70fe17c79ac6caULL, -1060, -300 },
+        { 0xff77b1fcbebcdc4fULL, -1034, -292 },
+        { 0xbe5691ef416bd60cULL, -1007, -284 },
+        { 0x8dd01fad907ffc3cULL, -980, -276 },
+        { 0xd3515c2831559a83ULL, -954, -268 },
+        { 0x9d71ac8fada6c9b5ULL, -927, -260 },
+        { 0xea9c227723ee8bcbULL, -901, -252 },
+        { 0xaecc49914078536dULL, -874, -244 },
+        { 0x823c12795db6ce57ULL, -847, -236 },
+        { 0xc21094364dfb5637ULL, -821, -228 },
+        { 0x9096ea6f3848984fULL, -794, -220 },
+        { 0xd77485cb25823ac7ULL, -768, -212 },
+        { 0xa086cfcd97bf97f4ULL, -741, -204 },
+        { 0xef340a98172aace5ULL, -715, -196 },
+        { 0xb23867fb2a35b28eULL, -688, -188 },
+        { 0x84c8d4dfd2c63f3bULL, -661, -180 },
+        { 0xc5dd44271ad3cdbaULL, -635, -172 },
+        { 0x936b9fcebb25c996ULL, -608, -164 },
+        { 0xdbac6c247d62a584ULL, -582, -156 },
+        { 0xa3ab66580d5fdaf6ULL, -555, -148 },
+        { 0xf3e2f893dec3f126ULL, -529, -140 },
+        { 0xb5b5ada8aaff80b8ULL, -502, -132 },
+        { 0x87625f056c7c4a8bULL, -475, -124 },
+        { 0xc9bcff6034c13053ULL, -449, -116 },
+        { 0x964e858c91ba2655ULL, -422, -108 },
+        { 0xdff9772470297ebdULL, -396, -100 },
+        { 0xa6dfbd9fb8e5b88fULL, -369, -92 },
+        { 0xf8a95fcf88747d94ULL, -343, -84 },
+        { 0xb94470938fa89bcfULL, -316, -76 },
+        { 0x8a08f0f8bf0f156bULL, -289, -68 },
+        { 0xcdb02555653131b6ULL, -263, -60 },
+        { 0x993fe2c6d07b7facULL, -236, -52 },
+        { 0xe45c10c42a2b3b06ULL, -210, -44 },
+        { 0xaa242499697392d3ULL, -183, -36 },
+        { 0xfd87b5f28300ca0eULL, -157, -28 },
+        { 0xbce5086492111aebULL, -130, -20 },
+        { 0x8cbccc096f5088ccULL, -103, -12 },
+        { 0xd1b71758e219652cULL, -77, -4 },
+        { 0x9c40000000000000ULL, -50, 4 },
+        { 0xe8d4a51000000000ULL, -24, 12 },
+        { 0xad78ebc5ac620000ULL, 3, 20 },
+        { 0x813f3978f8940984ULL, 30, 28 },
+        { 0xc097ce7bc90715b3ULL, 56, 36 },
+        { 0x8f7e32ce7bea5c70ULL, 83, 44 },
+        { 0xd5d238a4abe98068ULL, 109, 52 },
+        { 0x9f4f2726179a2245ULL, 136, 60 },
+        { 0xed63a231d4c4fb27ULL, 162, 68 },
+        { 0xb0de65388cc8ada8ULL, 189, 76 },
+        { 0x83c7088e1aab65dbULL, 216, 84 },
+        { 0xc45d1df942711d9aULL, 242, 92 },
+        { 0x924d692ca61be758ULL, 269, 100 },
+        { 0xda01ee641a708deaULL, 295, 108 },
+        { 0xa26da3999aef774aULL, 322, 116 },
+        { 0xf209787bb47d6b85ULL, 348, 124 },
+        { 0xb454e4a179dd1877ULL, 375, 132 },
+        { 0x865b86925b9bc5c2ULL, 402, 140 },
+        { 0xc83553c5c8965d3dULL, 428, 148 },
+        { 0x952ab45cfa97a0b3ULL, 455, 156 },
+        { 0xde469fbd99a05fe3ULL, 481, 164 },
+        { 0xa59bc234db398c25ULL, 508, 172 },
+        { 0xf6c69a72a3989f5cULL, 534, 180 },
+        { 0xb7dcbf5354e9beceULL, 561, 188 },
+        { 0x88fcf317f22241e2ULL, 588, 196 },
+        { 0xcc20ce9bd35c78a5ULL, 614, 204 },
+        { 0x98165af37b2153dfULL, 641, 212 },
+        { 0xe2a0b5dc971f303aULL, 667, 220 },
+        { 0xa8d9d1535ce3b396ULL, 694, 228 },
+        { 0xfb9b7cd9a4a7443cULL, 720, 236 },
+        { 0xbb764c4ca7a44410ULL, 747, 244 },
+        { 0x8bab8eefb6409c1aULL, 774, 252 },
+        { 0xd01fef10a657842cULL, 800, 260 },
+        { 0x9b10a4e5e9913129ULL, 827, 268 },
+        { 0xe7109bfba19c0c9dULL, 853, 276 },
+        { 0xac2820d9623bf429ULL, 880, 284 },
+        { 0x80444b5e7aa7cf85ULL, 907, 292 },
+        { 0xbf21e44003acdd2dULL, 933, 300 },
+        { 0x8e679c2f5e44ff8fULL, 960, 308 },
+        { 0xd433179d9c8cb841ULL, 986, 316 },
+        { 0x9e19db92b4e31ba9ULL, 1013, 324 },
+        { 0xeb96bf6ebadf77d9ULL, 1039, 332 },
+        { 0xaf87023b9bf0ee6bULL, 1066, 340 }
+};
+
+
+/*!
+ * \brief Number of binary digits to shift a decimal by, to get below
+ * 1 for a decimal point at position n.
+ */
+static const int dxf_number_power_table[] =
+{
+        1, 3, 6, 9, 13, 16, 19, 23, 26
+};
+
+
+/*!
+ * \brief Load 8 bytes from \c s as a little endian 64-bit word.
+ *
+ * Compilers turn this into a single load on little endian machines.
+ */
+static uint64_t
+dxf_number_load_eight
+(
+        const unsigned char *s
+                /*!< the bytes. */
+)
+{
+        return ((uint64_t) s[0]
+          | ((uint64_t) s[1] << 8)
+          | ((uint64_t) s[2] << 16)
+          | ((uint64_t) s[3] << 24)
+          | ((uint64_t) s[4] << 32)
+          | ((uint64_t) s[5] << 40)
+          | ((uint64_t) s[6] << 48)
+          | ((uint64_t) s[7] << 56));
+}
+
+
+/*!
+ * \brief Test whether all 8 bytes of \c word are decimal digits.
+ *
+ * \return non-zero when all bytes are in the range '0' ... '9'.
+ */
+static int
+dxf_number_is_eight_digits
+(
+        uint64_t word
+                /*!< 8 characters loaded by dxf_number_load_eight (). */
+)
+{
+        return ((((word & 0xf0f0f0f0f0f0f0f0ULL)
+          | (((word + 0x0606060606060606ULL) & 0xf0f0f0f0f0f0f0f0ULL) >> 4))
+          == 0x3333333333333333ULL));
+}
+
+
+/*!
+ * \brief Convert 8 decimal digits to their value in three
+ * multiplications (SIMD within a register).
+ *
+ * \return the value of the 8 digits.
+ */
+static uint32_t
+dxf_number_parse_eight
+(
+        uint64_t word
+                /*!< 8 digits loaded by dxf_number_load_eight (). */
+)
+{
+        const uint64_t mask = 0x000000ff000000ffULL;
+        const uint64_t mul1 = 0x000f424000000064ULL; /* 100 + (1000000 << 32) */
+        const uint64_t mul2 = 0x0000271000000001ULL; /* 1 + (10000 << 32) */
+
+        word -= 0x3030303030303030ULL;
+        word = (word * 10) + (word >> 8);
+        word = (((word & mask) * mul1)
+          + (((word >> 16) & mask) * mul2)) >> 32;
+        return ((uint32_t) word);
+}
+
+
+/*!
+ * \brief Scan a run of decimal digits into \c mantissa.
+ *
+ * At most 19 significant digits are accumulated, further digits only
+ * set \c truncated.
+ *
+ * \return a pointer past the last digit.
+ */
+static const unsigned char *
+dxf_number_scan_digits
+(
+        const unsigned char *s,
+                /*!< first character. */
+        const unsigned char *end,
+                /*!< end of the value. */
+        uint64_t *mantissa,
+                /*!< accumulated significant digits. */
+        int *digits,
+                /*!< number of significant digits in \c mantissa. */
+        int *truncated
+                /*!< set when significant digits were dropped. */
+)
+{
+        unsigned int d;
+        uint64_t word;
+
+        while (((end - s) >= 8) && (*digits <= 11))
+        {
+                word = dxf_number_load_eight (s);
+                if (!dxf_number_is_eight_digits (word))
+                {
+                        break;
+                }
+                *mantissa = (*mantissa * 100000000) + dxf_number_parse_eight (word);
+                if (*mantissa != 0)
+                {
+                        *digits += 8;
+                }
+                s += 8;
+        }
+        while ((s < end) && ((d = (unsigned int) (*s - '0')) < 10))
+        {
+                if (*digits < 19)
+                {
+                        *mantissa = (*mantissa * 10) + d;
+                        if (*mantissa != 0)
+                        {
+                                (*digits)++;
+                        }
+                }
+                else
+                {
+                        *truncated = TRUE;
+                }
+                s++;
+        }
+        return (s);
+}
+
+
+/*!
+ * \brief Drop trailing zero digits from a decimal.
+ */
+static void
+dxf_number_decimal_trim
+(
+        DxfNumberDecimal *a
+                /*!< the decimal. */
+)
+{
+        while ((a->nd > 0) && (a->d[a->nd - 1] == 0))
+        {
+                a->nd--;
+        }
+        if (a->nd == 0)
+        {
+                a->dp = 0;
+        }
+}
+
+
+/*!
+ * \brief Multiply a decimal by 2^k.
+ */
+static void
+dxf_number_decimal_left_shift
+(
+        DxfNumberDecimal *a,
+                /*!< the decimal. */
+        unsigned int k
+                /*!< the shift, at most \c DXF_NUMBER_MAX_SHIFT. */
+)
+{
+        unsigned char digits[DXF_NUMBER_DECIMAL_DIGITS + 20];
+        int r;
+        int w = (int) sizeof (digits);
+        int nd;
+        uint64_t n = 0;
+
+        /* Produce the new digits from the right, the result has at most
+         * 19 digits more than the original. */
+        for (r = a->nd - 1; r >= 0; r--)
+        {
+                n += (uint64_t) a->d[r] << k;
+                digits[--w] = (unsigned char) (n % 10);
+                n /= 10;
+        }
+        while (n > 0)
+        {
+                digits[--w] = (unsigned char) (n % 10);
+                n /= 10;
+        }
+        nd = (int) sizeof (digits) - w;
+        a->dp += nd - a->nd;
+        if (nd > DXF_NUMBER_DECIMAL_DIGITS)
+        {
+                for (r = w + DXF_NUMBER_DECIMAL_DIGITS; r < (int) sizeof (digits); r++)
+                {
+                        if (digits[r] != 0)
+                        {
+                                a->truncated = TRUE;
+                        }
+                }
+                nd = DXF_NUMBER_DECIMAL_DIGITS;
+        }
+        memcpy (a->d, digits + w, (size_t) nd);
+        a->nd = nd;
+        dxf_number_decimal_trim (a);
+}
+
+
+/*!
+ * \brief Divide a decimal by 2^k.
+ */
+static void
+dxf_number_decimal_right_shift
+(
+        DxfNumberDecimal *a,
+                /*!< the decimal. */
+        unsigned int k
+                /*!< the shift, at most \c DXF_NUMBER_MAX_SHIFT. */
+)
+{
+        int r = 0;
+        int w = 0;
+        uint64_t n = 0;
+        uint64_t mask = ((uint64_t) 1 << k) - 1;
+        unsigned int d;
+
+        /* Pick up enough leading digits to cover the first shift. */
+        for (; (n >> k) == 0; r++)
+        {
+                if (r >= a->nd)
+                {
+                        if (n == 0)
+                        {
+                                a->nd = 0;
+                                return;
+                        }
+                        while ((n >> k) == 0)
+                        {
+                                n *= 10;
+                                r++;
+                        }
+                        break;
+                }
+                n = (n * 10) + a->d[r];
+        }
+        a->dp -= r - 1;
+        /* Pick up a digit, put down a digit. */
+        for (; r < a->nd; r++)
+        {
+                d = (unsigned int) (n >> k);
+                n &= mask;
+                a->d[w++] = (unsigned char) d;
+                n = (n * 10) + a->d[r];
+        }
+        /* Put down the extra digits. */
+        while (n > 0)
+        {
+                d = (unsigned int) (n >> k);
+                n &= mask;
+                if (w < DXF_NUMBER_DECIMAL_DIGITS)
+                {
+                        a->d[w++] = (unsigned char) d;
+                }
+                else if (d > 0)
+                {
+                        a->truncated = TRUE;
+                }
+                n *= 10;
+        }
+        a->nd = w;
+        dxf_number_decimal_trim (a);
+}
+
+
+/*!
+ * \brief Multiply (\c k > 0) or divide (\c k < 0) a decimal by 2^|k|.
+ */
+static void
+dxf_number_decimal_shift
+(
+        DxfNumberDecimal *a,
+                /*!< the decimal. */
+        int k
+                /*!< the shift. */
+)
+{
+        if (a->nd == 0)
+        {
+                return;
+        }
+        if (k > 0)
+        {
+                while (k > DXF_NUMBER_MAX_SHIFT)
+                {
+                        dxf_number_decimal_left_shift (a, DXF_NUMBER_MAX_SHIFT);
+                        k -= DXF_NUMBER_MAX_SHIFT;
+                }
+                dxf_number_decimal_left_shift (a, (unsigned int) k);
+        }
+        else if (k < 0)
+        {
+                while (k < -DXF_NUMBER_MAX_SHIFT)
+                {
+                        dxf_number_decimal_right_shift (a, DXF_NUMBER_MAX_SHIFT);
+                        k += DXF_NUMBER_MAX_SHIFT;
+                }
+                dxf_number_decimal_right_shift (a, (unsigned int) -k);
+        }
+}
+
+
+/*!
+ * \brief Return the integer part of a decimal, rounded half to even.
+ */
+static uint64_t
+dxf_number_decimal_rounded_integer
+(
+        DxfNumberDecimal *a
+                /*!< the decimal. */
+)
+{
+        uint64_t n = 0;
+        int i;
+        int round_up;
+
+        if (a->dp > 20)
+        {
+                return (UINT64_MAX);
+        }
+        for (i = 0; (i < a->dp) && (i < a->nd); i++)
+        {
+                n = (n * 10) + a->d[i];
+        }
+        for (; i < a->dp; i++)
+        {
+                n *= 10;
+        }
+        if ((a->dp < 0) || (a->dp >= a->nd))
+        {
+                round_up = FALSE;
+        }
+        else if ((a->d[a->dp] == 5) && ((a->dp + 1) == a->nd))
+        {
+                /* Exactly halfway, round to even. */
+                round_up = a->truncated
+                  || ((a->dp > 0) && ((a->d[a->dp - 1] % 2) == 1));
+        }
+        else
+        {
+                round_up = (a->d[a->dp] >= 5);
+        }
+        return (round_up ? n + 1 : n);
+}
+
+
+/*!
+ * \brief Read a decimal number from a string which has already been
+ * validated by dxf_number_parse_double ().
+ */
+static void
+dxf_number_decimal_set
+(
+        DxfNumberDecimal *a,
+                /*!< the decimal. */
+        const unsigned char *s,
+                /*!< start of the number. */
+        const unsigned char *end
+                /*!< end of the number. */
+)
+{
+        int seen_dot = FALSE;
+        int exponent = 0;
+        int exponent_negative = FALSE;
+
+        a->nd = 0;
+        a->dp = 0;
+        a->negative = FALSE;
+        a->truncated = FALSE;
+        if ((s < end) && ((*s == '-') || (*s == '+')))
+        {
+                a->negative = (*s == '-');
+                s++;
+        }
+        for (; s < end; s++)
+        {
+                if (*s == '.')
+                {
+                        seen_dot = TRUE;
+                        a->dp = a->nd;
+                        continue;
+                }
+                if ((unsigned int) (*s - '0') >= 10)
+                {
+                        break;
+                }
+                if ((*s == '0') && (a->nd == 0))
+                {
+                        /* Ignore leading zeros. */
+                        a->dp--;
+                        continue;
+                }
+                if (a->nd < DXF_NUMBER_DECIMAL_DIGITS)
+                {
+                        a->d[a->nd++] = (unsigned char) (*s - '0');
+                }
+                else if (*s != '0')
+                {
+                        a->truncated = TRUE;
+                }
+        }
+        if (!seen_dot)
+        {
+                a->dp = a->nd;
+        }
+        if ((s < end) && ((*s == 'e') || (*s == 'E')))
+        {
+                s++;
+                if ((s < end) && ((*s == '-') || (*s == '+')))
+                {
+                        exponent_negative = (*s == '-');
+                        s++;
+                }
+                for (; (s < end) && ((unsigned int) (*s - '0') < 10); s++)
+                {
+                        if (exponent < 10000)
+                        {
+                                exponent = (exponent * 10) + (*s - '0');
+                        }
+                }
+                a->dp += exponent_negative ? -exponent : exponent;
+        }
+        dxf_number_decimal_trim (a);
+}
+
+
+/*!
+ * \brief Convert a decimal to the nearest double.
+ *
+ * This is the simple decimal conversion algorithm: the decimal is
+ * scaled by powers of two until it lies in [0.5, 1), after which the
+ * 53 bits of the mantissa are shifted out and rounded.
+ */
+static double
+dxf_number_decimal_to_double
+(
+        DxfNumberDecimal *a
+                /*!< the decimal, which is modified. */
+)
+{
+        const int mantissa_bits = 52;
+        const int exponent_bits = 11;
+        const int bias = -1023;
+        const int max_exponent = (1 << exponent_bits) - 1;
+        uint64_t mantissa = 0;
+        uint64_t bits;
+        int exponent = 0;
+        int n;
+        double result;
+
+        if ((a->nd == 0) || (a->dp < -330))
+        {
+                /* Zero or underflow. */
+                exponent = bias;
+        }
+        else if (a->dp > 310)
+        {
+                exponent = max_exponent + bias;
+        }
+        else
+        {
+                /* Scale by powers of two until in range [0.5, 1.0). */
+                while (a->dp > 0)
+                {
+                        n = (a->dp >= 9) ? 27 : dxf_number_power_table[a->dp];
+                        dxf_number_decimal_shift (a, -n);
+                        exponent += n;
+                }
+                while ((a->dp < 0) || ((a->dp == 0) && (a->d[0] < 5)))
+                {
+                        n = (-a->dp >= 9) ? 27 : dxf_number_power_table[-a->dp];
+                        dxf_number_decimal_shift (a, n);
+                        exponent -= n;
+                }
+                /* Our range is [0.5, 1) but the floating point range is
+                 * [1, 2). */
+                exponent--;
+                /* Denormalize when below the minimum exponent. */
+                if (exponent < bias + 1)
+                {
+                        n = bias + 1 - exponent;
+                        dxf_number_decimal_shift (a, -n);
+                        exponent += n;
+                }
+                if ((exponent - bias) < max_exponent)
+                {
+                        /* Extract 1 + 52 bits. */
+                        dxf_number_decimal_shift (a, 1 + mantissa_bits);
+                        mantissa = dxf_number_decimal_rounded_integer (a);
+                        /* Rounding might have added a bit, shift down. */
+                        if (mantissa == ((uint64_t) 2 << mantissa_bits))
+                        {
+                                mantissa >>= 1;
+                                exponent++;
+                        }
+                        if ((mantissa & ((uint64_t) 1 << mantissa_bits)) == 0)
+                        {
+                                /* Denormalized. */
+                                exponent = bias;
+                        }
+                }
+                if ((exponent - bias) >= max_exponent)
+                {
+                        /* Overflow to infinity. */
+                        mantissa = 0;
+                        exponent = max_exponent + bias;
+                }
+        }
+        bits = mantissa & (((uint64_t) 1 << mantissa_bits) - 1);
+        bits |= (uint64_t) ((exponent - bias) & max_exponent) << mantissa_bits;
+        if (a->negative)
+        {
+                bits |= (uint64_t) 1 << 63;
+        }
+        memcpy (&result, &bits, sizeof (result));
+        return (result);
+}
+
+
+/*!
+ * \brief Parse a decimal floating point value.
+ *
+ * Accepts optional leading blanks, an optional sign, digits with an
+ * optional "." and an optional exponent, which is the way doubles are
+ * written in a DXF file.\n
+ * Values with at most 19 significant digits and a small exponent, which
+ * covers nearly all coordinates, are converted exactly with a single
+ * multiplication or division.\n
+ * All other values take a slower arbitrary precision path, so that the
+ * result is always the double nearest to the decimal value.
+ *
+ * \return the number of characters consumed, or 0 when \c data does not
+ * start with a number (\c value is then set to 0.0).
+ */
+size_t
+dxf_number_parse_double
+(
+        const char *data,
+                /*!< start of the value. */
+        size_t length,
+                /*!< length of the value. */
+        double *value
+                /*!< the parsed value. */
+)
+{
+        const unsigned char *s = (const unsigned char *) data;
+        const unsigned char *end = s + length;
+        const unsigned char *start;
+        const unsigned char *p;
+        uint64_t mantissa = 0;
+        int digits = 0;
+        int truncated = FALSE;
+        int negative = FALSE;
+        int count;
+        int exponent = 0;
+        int e = 0;
+        int e_negative = FALSE;
+        DxfNumberDecimal decimal;
+
+        *value = 0.0;
+        while ((s < end) && ((*s == ' ') || (*s == '\t')))
+        {
+                s++;
+        }
+        start = s;
+        if ((s < end) && ((*s == '-') || (*s == '+')))
+        {
+                negative = (*s == '-');
+                s++;
+        }
+        p = s;
+        s = dxf_number_scan_digits (s, end, &mantissa, &digits, &truncated);
+        count = (int) (s - p);
+        if ((s < end) && (*s == '.'))
+        {
+                s++;
+                p = s;
+                s = dxf_number_scan_digits (s, end, &mantissa, &digits, &truncated);
+                exponent = -(int) (s - p);
+                count += (int) (s - p);
+        }
+        if (count == 0)
+        {
+                return (0);
+        }
+        if ((s < end) && ((*s == 'e') || (*s == 'E')))
+        {
+                p = s + 1;
+                if ((p < end) && ((*p == '-') || (*p == '+')))
+                {
+                        e_negative = (*p == '-');
+                        p++;
+                }
+                if ((p < end) && ((unsigned int) (*p - '0') < 10))
+                {
+                        for (; (p < end) && ((unsigned int) (*p - '0') < 10); p++)
+                        {
+                                if (e < 10000)
+                                {
+                                        e = (e * 10) + (*p - '0');
+                                }
+                        }
+                        exponent += e_negative ? -e : e;
+                        s = p;
+                }
+        }
+        if (mantissa == 0 && !truncated)
+        {
+                *value = negative ? -0.0 : 0.0;
+                return ((size_t) (s - (const unsigned char *) data));
+        }
+        if (DXF_NUMBER_FAST_PATH
+          && !truncated
+          && (mantissa <= ((uint64_t) 1 << 53)))
+        {
+                if ((exponent >= 0) && (exponent <= 22))
+                {
+                        *value = (double) mantissa
+                          * dxf_number_powers_of_ten[exponent];
+                        *value = negative ? -*value : *value;
+                        return ((size_t) (s - (const unsigned char *) data));
+                }
+                if ((exponent < 0) && (exponent >= -22))
+                {
+                        *value = (double) mantissa
+                          / dxf_number_powers_of_ten[-exponent];
+                        *value = negative ? -*value : *value;
+                        return ((size_t) (s - (const unsigned char *) data));
+                }
+        }
+        /* Slow path. */
+        dxf_number_decimal_set (&decimal, start, s);
+        *value = dxf_number_decimal_to_double (&decimal);
+        return ((size_t) (s - (const unsigned char *) data));
+}
+
+
+/*!
+ * \brief Parse a decimal integer value.
+ *
+ * Accepts optional leading blanks and an optional sign.
+ *
+ * A value which does not fit in a long is a parse error, like with
+ * strtol (), \c value is then set to \c LONG_MIN or \c LONG_MAX and
+ * \c errno to \c ERANGE.
+ *
+ * \return the number of characters consumed, or 0 when \c data does not
+ * start with a number (\c value is then set to 0) or the number is out
+ * of range.
+ */
+size_t
+dxf_number_parse_long
+(
+        const char *data,
+                /*!< start of the value. */
+        size_t length,
+                /*!< length of the value. */
+        long *value
+                /*!< the parsed value. */
+)
+{
+        const unsigned char *s = (const unsigned char *) data;
+        const unsigned char *end = s + length;
+        const unsigned char *p;
+        uint64_t result = 0;
+        int digits = 0;
+        int truncated = FALSE;
+        int negative = FALSE;
+
+        *value = 0;
+        while ((s < end) && ((*s == ' ') || (*s == '\t')))
+        {
+                s++;
+        }
+        if ((s < end) && ((*s == '-') || (*s == '+')))
+        {
+                negative = (*s == '-');
+                s++;
+        }
+        p = s;
+        s = dxf_number_scan_digits (s, end, &result, &digits, &truncated);
+        if (s == p)
+        {
+                return (0);
+        }
+        /* At most 19 digits are kept, which can not wrap around. */
+        if (truncated
+          || (result > (negative
+          ? (uint64_t) LONG_MAX + 1
+          : (uint64_t) LONG_MAX)))
+        {
+                *value = negative ? LONG_MIN : LONG_MAX;
+                errno = ERANGE;
+                return (0);
+        }
+        if (negative && (result == (uint64_t) LONG_MAX + 1))
+        {
+                *value = LONG_MIN;
+        }
+        else
+        {
+                *value = negative ? -(long) result : (long) result;
+        }
+        return ((size_t) (s - (const unsigned char *) data));
+}
+
+
+/*!
+ * \brief Parse a hexadecimal value, as used for handles.
+ *
+ * Accepts optional leading blanks, digits are looked up in a table so
+ * that upper and lower case need no separate branches.
+ *
+ * A value which does not fit in an unsigned long is a parse error,
+ * like with strtoul (), \c value is then set to \c ULONG_MAX and
+ * \c errno to \c ERANGE.
+ *
+ * \return the number of characters consumed, or 0 when \c data does not
+ * start with a hexadecimal digit (\c value is then set to 0) or the
+ * number is out of range.
+ */
+size_t
+dxf_number_parse_hex
+(
+        const char *data,
+                /*!< start of the value. */
+        size_t length,
+                /*!< length of the value. */
+        unsigned long *value
+                /*!< the parsed value. */
+)
+{
+        const unsigned char *s = (const unsigned char *) data;
+        const unsigned char *end = s + length;
+        const unsigned char *p;
+        unsigned long result = 0;
+        unsigned char d;
+
+        while ((s < end) && ((*s == ' ') || (*s == '\t')))
+        {
+                s++;
+        }
+        p = s;
+        while ((s < end) && ((d = dxf_number_hex_digits[*s]) != 0xff))
+        {
+                if (result > (ULONG_MAX >> 4))
+                {
+                        *value = ULONG_MAX;
+                        errno = ERANGE;
+                        return (0);
+                }
+                result = (result << 4) | d;
+                s++;
+        }
+        *value = result;
+        if (s == p)
+        {
+                return (0);
+        }
+        return ((size_t) (s - (const unsigned char *) data));
+}
+
+
+/*!
+ * \brief Write the decimal digits of \c value, most significant
+ * first, two digits per division.
+ *
+ * \return the number of characters written.
+ */
+static size_t
+dxf_number_format_digits
+(
+        char *dest,
+                /*!< destination, room for 20 characters. */
+        uint64_t value
+                /*!< the value. */
+)
+{
+        char digits[20];
+        int i = (int) sizeof (digits);
+        unsigned int pair;
+
+        while (value >= 100)
+        {
+                pair = (unsigned int) (value % 100) * 2;
+                value /= 100;
+                digits[--i] = dxf_number_digit_pairs[pair + 1];
+                digits[--i] = dxf_number_digit_pairs[pair];
+        }
+        if (value >= 10)
+        {
+                pair = (unsigned int) value * 2;
+                digits[--i] = dxf_number_digit_pairs[pair + 1];
+                digits[--i] = dxf_number_digit_pairs[pair];
+        }
+        else
+        {
+                digits[--i] = (char) ('0' + value);
+        }
+        memcpy (dest, digits + i, sizeof (digits) - (size_t) i);
+        return (sizeof (digits) - (size_t) i);
+}
+
+
+/*!
+ * \brief Format an integer like \c printf ("%ld").
+ *
+ * \return the number of characters written, not counting the
+ * terminating \c NUL.
+ */
+size_t
+dxf_number_format_long
+(
+        char *dest,
+                /*!< destination, room for
+                 * \c DXF_NUMBER_MAX_FORMAT_LENGTH characters. */
+        long value
+                /*!< the value. */
+)
+{
+        size_t n = 0;
+        uint64_t magnitude = (uint64_t) value;
+
+        if (value < 0)
+        {
+                dest[n++] = '-';
+                magnitude = 0 - magnitude;
+        }
+        n += dxf_number_format_digits (dest + n, magnitude);
+        dest[n] = '\0';
+        return (n);
+}
+
+
+/*!
+ * \brief Format an unsigned integer like \c printf ("%lx").
+ *
+ * \return the number of characters written, not counting the
+ * terminating \c NUL.
+ */
+size_t
+dxf_number_format_hex
+(
+        char *dest,
+                /*!< destination, room for
+                 * \c DXF_NUMBER_MAX_FORMAT_LENGTH characters. */
+        unsigned long value
+                /*!< the value. */
+)
+{
+        static const char hex[] = "0123456789abcdef";
+        char digits[16];
+        int i = (int) sizeof (digits);
+
+        do
+        {
+                digits[--i] = hex[value & 0xf];
+                value >>= 4;
+        }
+        while (value != 0);
+        memcpy (dest, digits + i, sizeof (digits) - (size_t) i);
+        dest[sizeof (digits) - (size_t) i] = '\0';
+        return (sizeof (digits) - (size_t) i);
+}
+
+
+/*!
+ * \brief Format a floating point number like \c printf ("%.*f").
+ *
+ * Below 10^15 the integral part and the scaled fraction are both exact
+ * integers in a double, so for up to 9 decimals only the rounding of
+ * the last decimal can be off, when the fraction lies within rounding
+ * error of a half.
+ * Those values, as well as larger values, more decimals, infinities and
+ * NaN, are handed to \c snprintf () which rounds exactly.
+ *
+ * \return the number of characters written, not counting the
+ * terminating \c NUL.
+ */
+size_t
+dxf_number_format_fixed
+(
+        char *dest,
+                /*!< destination, room for
+                 * \c DXF_NUMBER_MAX_FORMAT_LENGTH characters. */
+        double value,
+                /*!< the value. */
+        int decimals
+                /*!< number of decimals, 0 ... \c DXF_NUMBER_MAX_DECIMALS. */
+)
+{
+        double magnitude = fabs (value);
+        double integral;
+        double fraction;
+        double scale;
+        uint64_t whole;
+        uint64_t scaled;
+        size_t n = 0;
+        int i;
+
+        if ((decimals < 0) || (decimals > DXF_NUMBER_MAX_DECIMALS))
+        {
+                decimals = (decimals < 0) ? 0 : DXF_NUMBER_MAX_DECIMALS;
+        }
+        if (!(magnitude < 1e15) || (decimals > 9))
+        {
+                return ((size_t) snprintf (dest, DXF_NUMBER_MAX_FORMAT_LENGTH,
+                  "%.*f", decimals, value));
+        }
+        scale = dxf_number_powers_of_ten[decimals];
+        integral = floor (magnitude);
+        /* Both the subtraction and the truncation are exact. */
+        fraction = (magnitude - integral) * scale;
+        scaled = (uint64_t) fraction;
+        fraction -= (double) scaled;
+        if (fabs (fraction - 0.5) < 1e-6)
+        {
+                return ((size_t) snprintf (dest, DXF_NUMBER_MAX_FORMAT_LENGTH,
+                  "%.*f", decimals, value));
+        }
+        whole = (uint64_t) integral;
+        if (fraction > 0.5)
+        {
+                scaled++;
+                if (scaled == (uint64_t) scale)
+                {
+                        scaled = 0;
+                        whole++;
+                }
+        }
+        if (signbit (value))
+        {
+                dest[n++] = '-';
+        }
+        n += dxf_number_format_digits (dest + n, whole);
+        if (decimals > 0)
+        {
+                dest[n++] = '.';
+                for (i = decimals - 1; i >= 0; i--)
+                {
+                        dest[n + (size_t) i] = (char) ('0' + (scaled % 10));
+                        scaled /= 10;
+                }
+                n += (size_t) decimals;
+        }
+        dest[n] = '\0';
+        return (n);
+}
+
+
+/*!
+ * \brief Multiply two DIY floating point numbers, rounding the 128 bit
+ * product of the significands to its upper 64 bits.
+ *
+ * \return the product.
+ */
+static DxfNumberDiyFp
+dxf_number_diy_fp_multiply
+(
+        DxfNumberDiyFp a,
+                /*!< first factor. */
+        DxfNumberDiyFp b
+                /*!< second factor. */
+)
+{
+        const uint64_t mask = 0xffffffffULL;
+        DxfNumberDiyFp result;
+        uint64_t ac = (a.f >> 32) * (b.f >> 32);
+        uint64_t bc = (a.f & mask) * (b.f >> 32);
+        uint64_t ad = (a.f >> 32) * (b.f & mask);
+        uint64_t bd = (a.f & mask) * (b.f & mask);
+        uint64_t middle;
+
+        middle = (bd >> 32) + (ad & mask) + (bc & mask);
+        /* Round half up. */
+        middle += (uint64_t) 1 << 31;
+        result.f = ac + (ad >> 32) + (bc >> 32) + (middle >> 32);
+        result.e = a.e + b.e + 64;
+        return (result);
+}
+
+
+/*!
+ * \brief Shift the significand of \c x left until its top bit is set.
+ *
+ * \return the normalized number.
+ */
+static DxfNumberDiyFp
+dxf_number_diy_fp_normalize
+(
+        DxfNumberDiyFp x
+                /*!< a number with a non-zero significand. */
+)
+{
+        while ((x.f & 0xffc0000000000000ULL) == 0)
+        {
+                x.f <<= 10;
+                x.e -= 10;
+        }
+        while ((x.f & 0x8000000000000000ULL) == 0)
+        {
+                x.f <<= 1;
+                x.e--;
+        }
+        return (x);
+}
+
+
+/*!
+ * \brief Round the last digit of a Grisu3 result towards the exact
+ * value, and check that the result is certainly the shortest correct
+ * one.
+ *
+ * This is the "round and weed" step of Florian Loitsch, "Printing
+ * Floating-Point Numbers Quickly and Accurately with Integers" (2010).
+ * All distances are scaled by the same power of two.
+ *
+ * \return \c TRUE when the digits are correct, \c FALSE when Grisu3
+ * can not decide.
+ */
+static int
+dxf_number_grisu_round_weed
+(
+        char *digits,
+                /*!< the digits generated so far. */
+        int length,
+                /*!< number of digits. */
+        uint64_t distance_too_high_w,
+                /*!< distance from the value to the upper end of the
+                 * unsafe interval. */
+        uint64_t unsafe_interval,
+                /*!< size of the unsafe interval. */
+        uint64_t rest,
+                /*!< distance from the digits to the upper end of the
+                 * unsafe interval. */
+        uint64_t ten_kappa,
+                /*!< weight of the last digit. */
+        uint64_t unit
+                /*!< maximum error of the boundaries. */
+)
+{
+        uint64_t small_distance = distance_too_high_w - unit;
+        uint64_t big_distance = distance_too_high_w + unit;
+
+        /* Move the last digit towards the value as long as it stays
+         * inside the unsafe interval. */
+        while ((rest < small_distance)
+          && (unsafe_interval - rest >= ten_kappa)
+          && ((rest + ten_kappa < small_distance)
+            || (small_distance - rest >= rest + ten_kappa - small_distance)))
+        {
+                digits[length - 1]--;
+                rest += ten_kappa;
+        }
+        /* Could the next lower digit be closer, given the error? */
+        if ((rest < big_distance)
+          && (unsafe_interval - rest >= ten_kappa)
+          && ((rest + ten_kappa < big_distance)
+            || (big_distance - rest > rest + ten_kappa - big_distance)))
+        {
+                return (FALSE);
+        }
+        /* The digits must be inside the safe interval. */
+        return ((2 * unit <= rest) && (rest <= unsafe_interval - 4 * unit));
+}
+
+
+/*!
+ * \brief Generate the shortest digits between the scaled boundaries
+ * \c low and \c high of the scaled value \c w (Grisu3).
+ *
+ * \return \c TRUE when the digits are correct and shortest, \c FALSE
+ * when Grisu3 can not decide.
+ */
+static int
+dxf_number_grisu_digits
+(
+        DxfNumberDiyFp low,
+                /*!< scaled lower boundary. */
+        DxfNumberDiyFp w,
+                /*!< scaled value. */
+        DxfNumberDiyFp high,
+                /*!< scaled upper boundary. */
+        char *digits,
+                /*!< destination, room for 18 digits. */
+        int *length,
+                /*!< returns the number of digits. */
+        int *kappa
+                /*!< returns the decimal exponent of the digit after the
+                 * last one. */
+)
+{
+        uint64_t unit = 1;
+        uint64_t too_low = low.f - unit;
+        uint64_t too_high = high.f + unit;
+        uint64_t unsafe_interval = too_high - too_low;
+        int shift = -w.e;
+        uint64_t one = (uint64_t) 1 << shift;
+        uint32_t integrals = (uint32_t) (too_high >> shift);
+        uint64_t fractionals = too_high & (one - 1);
+        uint32_t divisor = 1;
+        uint64_t rest;
+
+        *kappa = 1;
+        while ((uint64_t) divisor * 10 <= integrals)
+        {
+                divisor *= 10;
+                (*kappa)++;
+        }
+        *length = 0;
+        while (*kappa > 0)
+        {
+                digits[(*length)++] = (char) ('0' + (integrals / divisor));
+                integrals %= divisor;
+                (*kappa)--;
+                rest = ((uint64_t) integrals << shift) + fractionals;
+                if (rest < unsafe_interval)
+                {
+                        return (dxf_number_grisu_round_weed (digits, *length,
+                          too_high - w.f, unsafe_interval, rest,
+                          (uint64_t) divisor << shift, unit));
+                }
+                divisor /= 10;
+        }
+        for (;;)
+        {
+                fractionals *= 10;
+                unit *= 10;
+                unsafe_interval *= 10;
+                digits[(*length)++] = (char) ('0' + (fractionals >> shift));
+                fractionals &= one - 1;
+                (*kappa)--;
+                if (fractionals < unsafe_interval)
+                {
+                        return (dxf_number_grisu_round_weed (digits, *length,
+                          (too_high - w.f) * unit, unsafe_interval,
+                          fractionals, one, unit));
+                }
+        }
+}
+
+
+/*!
+ * \brief Find the shortest decimal digits which read back as the
+ * finite, positive \c value, with Grisu3.
+ *
+ * \return \c TRUE when done, \c FALSE for the few values (about 0.5%)
+ * where Grisu3 can not guarantee the result.
+ */
+static int
+dxf_number_grisu
+(
+        double value,
+                /*!< the value. */
+        char *digits,
+                /*!< destination, room for 18 digits. */
+        int *length,
+                /*!< returns the number of digits. */
+        int *exponent
+                /*!< returns the decimal exponent of the last digit. */
+)
+{
+        const DxfNumberCachedPower *cached;
+        DxfNumberDiyFp w;
+        DxfNumberDiyFp plus;
+        DxfNumberDiyFp minus;
+        DxfNumberDiyFp power;
+        uint64_t bits;
+        uint64_t significand;
+        int biased_exponent;
+        int k;
+        int kappa;
+
+        memcpy (&bits, &value, sizeof (bits));
+        significand = bits & 0x000fffffffffffffULL;
+        biased_exponent = (int) ((bits >> 52) & 0x7ff);
+        if (biased_exponent != 0)
+        {
+                w.f = significand | 0x0010000000000000ULL;
+                w.e = biased_exponent - 1075;
+        }
+        else
+        {
+                w.f = significand;
+                w.e = -1074;
+        }
+        /* The boundaries are halfway to the neighbouring doubles; the
+         * lower neighbour is closer at a power of two. */
+        plus.f = (w.f << 1) + 1;
+        plus.e = w.e - 1;
+        plus = dxf_number_diy_fp_normalize (plus);
+        if ((significand == 0) && (biased_exponent > 1))
+        {
+                minus.f = (w.f << 2) - 1;
+                minus.e = w.e - 2;
+        }
+        else
+        {
+                minus.f = (w.f << 1) - 1;
+                minus.e = w.e - 1;
+        }
+        minus.f <<= minus.e - plus.e;
+        minus.e = plus.e;
+        w = dxf_number_diy_fp_normalize (w);
+        /* Pick the cached power of ten which brings the binary exponent
+         * of the scaled value into the range -60 ... -32. */
+        k = (int) ceil ((-60 - (w.e + 64) + 63) * 0.30102999566398114);
+        cached = &dxf_number_cached_powers[(348 + k - 1) / 8 + 1];
+        power.f = cached->f;
+        power.e = cached->e;
+        if (!dxf_number_grisu_digits (dxf_number_diy_fp_multiply (minus, power),
+          dxf_number_diy_fp_multiply (w, power),
+          dxf_number_diy_fp_multiply (plus, power),
+          digits, length, &kappa))
+        {
+                return (FALSE);
+        }
+        *exponent = kappa - cached->decimal_exponent;
+        return (TRUE);
+}
+
+
+/*!
+ * \brief Find the shortest decimal digits which read back as the
+ * finite, positive \c value, by trying every precision.
+ *
+ * Slow but exact, used where Grisu3 gives up.
+ */
+static void
+dxf_number_shortest_exact
+(
+        double value,
+                /*!< the value. */
+        char *digits,
+                /*!< destination, room for 18 digits. */
+        int *length,
+                /*!< returns the number of digits. */
+        int *exponent
+                /*!< returns the decimal exponent of the last digit. */
+)
+{
+        char text[32];
+        double parsed;
+        char *e;
+        int precision;
+        int n;
+        int i;
+
+        for (precision = 1; precision <= 17; precision++)
+        {
+                n = snprintf (text, sizeof (text), "%.*e", precision - 1, value);
+                dxf_number_parse_double (text, (size_t) n, &parsed);
+                if (parsed == value)
+                {
+                        break;
+                }
+        }
+        /* text is "d.ddde+xx", or "de+xx" for one digit. */
+        e = strchr (text, 'e');
+        *length = 0;
+        for (i = 0; text + i < e; i++)
+        {
+                if (text[i] != '.')
+                {
+                        digits[(*length)++] = text[i];
+                }
+        }
+        *exponent = atoi (e + 1) - (*length - 1);
+}
+
+
+/*!
+ * \brief Format a floating point number with the fewest digits that
+ * read back as exactly the same double.
+ *
+ * The digits are found with Grisu3, or by an exact search for the few
+ * values Grisu3 can not handle.  Values from 10^-5 up to 10^17 are
+ * written in fixed notation with at least one decimal ("12.5", "3.0"),
+ * others in exponential notation ("1.5E+20").  Infinities and NaN are
+ * written as \c printf () does.
+ *
+ * \return the number of characters written, not counting the
+ * terminating \c NUL.
+ */
+size_t
+dxf_number_format_double
+(
+        char *dest,
+                /*!< destination, room for
+                 * \c DXF_NUMBER_MAX_FORMAT_LENGTH characters. */
+        double value
+                /*!< the value. */
+)
+{
+        char digits[20];
+        int length;
+        int exponent;
+        int point;
+        size_t n = 0;
+        int i;
+
+        if (isnan (value) || isinf (value))
+        {
+                return ((size_t) snprintf (dest, DXF_NUMBER_MAX_FORMAT_LENGTH,
+                  "%f", value));
+        }
+        if (signbit (value))
+        {
+                dest[n++] = '-';
+                value = -value;
+        }
+        if (value == 0.0)
+        {
+                memcpy (dest + n, "0.0", 4);
+                return (n + 3);
+        }
+        if (!dxf_number_grisu (value, digits, &length, &exponent))
+        {
+                dxf_number_shortest_exact (value, digits, &length, &exponent);
+        }
+        while ((length > 1) && (digits[length - 1] == '0'))
+        {
+                length--;
+                exponent++;
+        }
+        /* Number of digits before the decimal point. */
+        point = length + exponent;
+        if ((point > 0) && (point <= 17))
+        {
+                if (length <= point)
+                {
+                        memcpy (dest + n, digits, (size_t) length);
+                        n += (size_t) length;
+                        for (i = length; i < point; i++)
+                        {
+                                dest[n++] = '0';
+                        }
+                        dest[n++] = '.';
+                        dest[n++] = '0';
+                }
+                else
+                {
+                        memcpy (dest + n, digits, (size_t) point);
+                        n += (size_t) point;
+                        dest[n++] = '.';
+                        memcpy (dest + n, digits + point, (size_t) (length - point));
+                        n += (size_t) (length - point);
+                }
+        }
+        else if ((point <= 0) && (point > -5))
+        {
+                dest[n++] = '0';
+                dest[n++] = '.';
+                for (i = point; i < 0; i++)
+                {
+                        dest[n++] = '0';
+                }
+                memcpy (dest + n, digits, (size_t) length);
+                n += (size_t) length;
+        }
+        else
+        {
+                dest[n++] = digits[0];
+                dest[n++] = '.';
+                if (length > 1)
+                {
+                        memcpy (dest + n, digits + 1, (size_t) (length - 1));
+                        n += (size_t) (length - 1);
+                }
+                else
+                {
+                        dest[n++] = '0';
+                }
+                dest[n++] = 'E';
+                point--;
+                dest[n++] = (point < 0) ? '-' : '+';
+                if (point < 0)
+                {
+                        point = -point;
+                }
+                if (point < 10)
+                {
+                        dest[n++] = '0';
+                }
+                n += dxf_number_format_digits (dest + n, (uint64_t) point);
+        }
+        dest[n] = '\0';
+        return (n);
+}
+
+
+/* EOF */
@@ -0,0 +1,114 @@
+/*!
+ * \file number.h
+ *
+ * \author Copyright (C) 2017 by the libDXF developers.
+ *
+ * \brief Locale independent number parsing for DXF values, header file.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+
+
+#ifndef LIBDXF_SRC_NUMBER_H
+#define LIBDXF_SRC_NUMBER_H
+
+
+#include "global.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define DXF_NUMBER_MAX_FORMAT_LENGTH 340
+        /*!< \brief Size of the buffer needed by the
+         * dxf_number_format_* () functions, enough for any double
+         * written with \c DXF_NUMBER_MAX_DECIMALS decimals. */
+#define DXF_NUMBER_MAX_DECIMALS 17
+        /*!< \brief Largest number of decimals accepted by
+         * dxf_number_format_fixed (). */
+
+
+size_t
+dxf_number_parse_double
+(
+        const char *data,
+        size_t length,
+        double *value
+);
+size_t
+dxf_number_parse_long
+(
+        const char *data,
+        size_t length,
+        long *value
+);
+size_t
+dxf_number_parse_hex
+(
+        const char *data,
+        size_t length,
+        unsigned long *value
+);
+size_t
+dxf_number_format_long
+(
+        char *dest,
+        long value
+);
+size_t
+dxf_number_format_hex
+(
+        char *dest,
+        unsigned long value
+);
+size_t
+dxf_number_format_fixed
+(
+        char *dest,
+        double value,
+        int decimals
+);
+size_t
+dxf_number_format_double
+(
+        char *dest,
+        double value
+);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* LIBDXF_SRC_NUMBER_H */
+
+
+/* EOF */
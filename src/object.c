@@ -33,6 +33,9 @@
 
 
 #include "object.h"
+#include "arena.h"
+#include "lexer.h"
+#include "writer.h"
 
 
 /*!
@@ -87,8 +90,6 @@ dxf_object_init
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        int i;
-
         /* Do some basic checks. */
         if (object == NULL)
         {
@@ -105,11 +106,107 @@ dxf_object_init
               return (NULL);
         }
         object->entity_type = UNKNOWN_ENTITY;
-        for (i = 0; i < DXF_MAX_PARAM; i++)
+        object->name = NULL;
+        object->parameter = NULL;
+        object->number_of_parameters = 0;
+        object->parameter_capacity = 0;
+        object->next = NULL;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (object);
+}
+
+
+/*!
+ * \brief Read data from a DXF file into a DXF \c object.
+ *
+ * The next pair in the file is the (0, name) pair starting the object,
+ * all pairs up to the following group code 0 are kept as parameters of
+ * the object, in file order.\n
+ * Strings are taken from the string pool of \c fp when it has one.
+ *
+ * \return a pointer to \c object, or \c NULL when an error occurred.
+ */
+DxfObject *
+dxf_object_read
+(
+        DxfFile *fp,
+                /*!< DXF file pointer to an input file (or device). */
+        DxfObject *object
+                /*!< DXF object entity. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfPair pair;
+        DxfParam parameter;
+
+        /* Do some basic checks. */
+        if (fp == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL file pointer was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        if (object == NULL)
         {
-                /*! \todo Add code for initialising a DxfParam. */
+                fprintf (stderr,
+                  (_("Warning in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                object = dxf_object_init (dxf_object_new ());
+                if (object == NULL)
+                {
+                        return (NULL);
+                }
+        }
+        if ((dxf_lexer_read_pair (fp, &pair) != 1)
+          || (pair.group_code != 0))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () no object found while reading line %d from: %s.\n")),
+                  __FUNCTION__, fp->line_number, fp->filename);
+                return (NULL);
+        }
+        dxf_lexer_free_string (fp, object->name);
+        object->name = dxf_pair_intern_string (fp, &pair);
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
+        {
+                if (pair.group_code == 0)
+                {
+                        /* Leave the start of the following object (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
+                }
+                parameter.group_code = (int16_t) pair.group_code;
+                parameter.type = (uint8_t) dxf_lexer_group_code_type (pair.group_code);
+                switch (parameter.type)
+                {
+                        case DXF_GROUP_CODE_TYPE_DOUBLE:
+                                parameter.value.D = dxf_pair_get_double (&pair);
+                                break;
+                        case DXF_GROUP_CODE_TYPE_INT16:
+                        case DXF_GROUP_CODE_TYPE_INT32:
+                        case DXF_GROUP_CODE_TYPE_BOOL:
+                                parameter.value.I = dxf_pair_get_int (&pair);
+                                break;
+                        case DXF_GROUP_CODE_TYPE_INT64:
+                                parameter.value.L = dxf_pair_get_long (&pair);
+                                break;
+                        default:
+                                /* Strings, handles, binary chunks and
+                                 * unknown group codes. */
+                                parameter.value.S = dxf_pair_intern_string (fp, &pair);
+                                break;
+                }
+                if (dxf_object_append_parameter (object, &parameter) == NULL)
+                {
+                        return (NULL);
+                }
         }
-        object->next = NULL;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -118,9 +215,85 @@ dxf_object_init
 
 
 /*!
- * \brief Write DXF output to a file for a table of objects.
+ * \brief Write DXF output to a file for a DXF \c object.
  *
- * Appears only in \c TABLES section.\n
+ * The name of the object is written, followed by its parameters in the
+ * order they were read.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_object_write
+(
+        DxfFile *fp,
+                /*!< DXF file pointer to an output file (or device). */
+        DxfObject *object
+                /*!< DXF object entity. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfParam *parameter;
+        int i;
+
+        /* Do some basic checks. */
+        if (fp == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL file pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (object == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (object->name == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () an object without a name was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        dxf_write_string (fp, 0, object->name);
+        for (i = 0; i < object->number_of_parameters; i++)
+        {
+                parameter = &object->parameter[i];
+                switch (parameter->type)
+                {
+                        case DXF_GROUP_CODE_TYPE_DOUBLE:
+                                dxf_write_double (fp, parameter->group_code, parameter->value.D);
+                                break;
+                        case DXF_GROUP_CODE_TYPE_INT16:
+                        case DXF_GROUP_CODE_TYPE_INT32:
+                        case DXF_GROUP_CODE_TYPE_BOOL:
+                                dxf_write_int (fp, parameter->group_code, parameter->value.I);
+                                break;
+                        case DXF_GROUP_CODE_TYPE_INT64:
+                                dxf_write_long (fp, parameter->group_code, parameter->value.L);
+                                break;
+                        default:
+                                dxf_write_string (fp, parameter->group_code,
+                                  (parameter->value.S != NULL) ? parameter->value.S : "");
+                                break;
+                }
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Write DXF output to a file for a list of objects.
+ *
+ * Appears only in \c OBJECTS section.\n
  */
 int
 dxf_object_write_objects
@@ -134,7 +307,15 @@ dxf_object_write_objects
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        /*! \todo Add code here. */
+        DxfObject *object;
+
+        for (object = dxf_objects_list; object != NULL; object = (DxfObject *) object->next)
+        {
+                if (dxf_object_write (fp, object) != EXIT_SUCCESS)
+                {
+                        return (EXIT_FAILURE);
+                }
+        }
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -160,6 +341,8 @@ dxf_object_free
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
+        int i;
+
         if (object->next != NULL)
         {
                 fprintf (stderr,
@@ -167,6 +350,23 @@ dxf_object_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
+        dxf_free (object->name);
+        for (i = 0; i < object->number_of_parameters; i++)
+        {
+                switch (object->parameter[i].type)
+                {
+                        case DXF_GROUP_CODE_TYPE_DOUBLE:
+                        case DXF_GROUP_CODE_TYPE_INT16:
+                        case DXF_GROUP_CODE_TYPE_INT32:
+                        case DXF_GROUP_CODE_TYPE_INT64:
+                        case DXF_GROUP_CODE_TYPE_BOOL:
+                                break;
+                        default:
+                                dxf_free (object->parameter[i].value.S);
+                                break;
+                }
+        }
+        dxf_free (object->parameter);
         free (object);
         object = NULL;
 #if DEBUG
@@ -188,7 +388,7 @@ dxf_object_free_chain
                 /*!< a pointer to the chain of DXF \c objects. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (objects == NULL)
@@ -200,6 +400,7 @@ dxf_object_free_chain
         while (objects != NULL)
         {
                 struct DxfObject *iter = objects->next;
+                objects->next = NULL;
                 dxf_object_free (objects);
                 objects = (DxfObject *) iter;
         }
@@ -209,4 +410,112 @@ dxf_object_free_chain
 }
 
 
+/*!
+ * \brief Append a parameter to a DXF \c object.
+ *
+ * The parameter is copied, a string value is taken over by the object
+ * and freed with it.
+ *
+ * \return a pointer to \c object, or \c NULL when an error occurred.
+ */
+DxfObject *
+dxf_object_append_parameter
+(
+        DxfObject *object,
+                /*!< DXF object entity. */
+        DxfParam *parameter
+                /*!< the parameter to append. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfParam *parameters;
+
+        /* Do some basic checks. */
+        if ((object == NULL) || (parameter == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        parameters = dxf_array_reserve (object->parameter,
+          object->number_of_parameters, &object->parameter_capacity,
+          object->number_of_parameters + 1, sizeof (DxfParam));
+        if (parameters == NULL)
+        {
+                return (NULL);
+        }
+        object->parameter = parameters;
+        object->parameter[object->number_of_parameters] = *parameter;
+        object->number_of_parameters++;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (object);
+}
+
+
+/*!
+ * \brief Detach the strings of the objects in the chain \c objects
+ * which belong to \c pool.
+ *
+ * The names and string values are set to \c NULL, so the objects can be
+ * freed before the pool is.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_object_release_strings
+(
+        DxfObject *objects,
+                /*!< a pointer to the chain of DXF \c objects. */
+        DxfStringPool *pool
+                /*!< the string pool. */
+)
+{
+        DxfObject *object;
+        DxfParam *parameter;
+        int i;
+
+        /* Do some basic checks. */
+        if (pool == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        for (object = objects; object != NULL; object = (DxfObject *) object->next)
+        {
+                if (dxf_string_pool_owns (pool, object->name))
+                {
+                        object->name = NULL;
+                }
+                for (i = 0; i < object->number_of_parameters; i++)
+                {
+                        parameter = &object->parameter[i];
+                        switch (parameter->type)
+                        {
+                                case DXF_GROUP_CODE_TYPE_DOUBLE:
+                                case DXF_GROUP_CODE_TYPE_INT16:
+                                case DXF_GROUP_CODE_TYPE_INT32:
+                                case DXF_GROUP_CODE_TYPE_INT64:
+                                case DXF_GROUP_CODE_TYPE_BOOL:
+                                        break;
+                                default:
+                                        if (dxf_string_pool_owns (pool, parameter->value.S))
+                                        {
+                                                parameter->value.S = NULL;
+                                        }
+                                        break;
+                        }
+                }
+        }
+        return (EXIT_SUCCESS);
+}
+
+
 /* EOF */
@@ -38,6 +38,7 @@
 
 #include "global.h"
 #include "param.h"
+#include "string_pool.h"
 
 
 #ifdef __cplusplus
@@ -53,8 +54,17 @@ dxf_object
 {
         DxfEntityType entity_type;
                 /*!< dxf entity type. */
-        DxfParam parameter[DXF_MAX_PARAM];
-                /*!< corresponding values stored in here. */
+        char *name;
+                /*!< name of the object (\c DICTIONARY, \c XRECORD,
+                 * ...).\n
+                 * Group code = 0. */
+        DxfParam *parameter;
+                /*!< group codes and values following the name, in file
+                 * order, \c number_of_parameters entries. */
+        int number_of_parameters;
+                /*!< Number of entries in \c parameter. */
+        int parameter_capacity;
+                /*!< Number of entries \c parameter has room for. */
         struct DxfObject *next;
                 /*!< pointer to the next DxfObject.\n
                  * \c NULL in the last DxfObject. */
@@ -62,6 +72,18 @@ dxf_object
 
 
 DxfObject *dxf_object_new ();
+DxfObject *
+dxf_object_read
+(
+        DxfFile *fp,
+        DxfObject *object
+);
+int
+dxf_object_write
+(
+        DxfFile *fp,
+        DxfObject *object
+);
 int
 dxf_object_write_objects
 (
@@ -83,6 +105,18 @@ dxf_object_free_chain
 (
         DxfObject *objects
 );
+DxfObject *
+dxf_object_append_parameter
+(
+        DxfObject *object,
+        DxfParam *parameter
+);
+int
+dxf_object_release_strings
+(
+        DxfObject *objects,
+        DxfStringPool *pool
+);
 
 
 #ifdef __cplusplus
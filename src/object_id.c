@@ -33,6 +33,7 @@
 
 
 #include "object_id.h"
+#include "arena.h"
 
 
 /*!
@@ -52,7 +53,7 @@ dxf_object_id_new ()
         size = sizeof (DxfObjectId);
         /* avoid malloc of 0 bytes */
         if (size == 0) size = 1;
-        if ((object_id = malloc (size)) == NULL)
+        if ((object_id = dxf_malloc (size)) == NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () could not allocate memory for a DxfObjectId struct.\n")),
@@ -102,7 +103,7 @@ dxf_object_id_init
                 __FUNCTION__);
               return (NULL);
         }
-        object_id->data = strdup ("");
+        object_id->data = dxf_strdup ("");
         object_id->next = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -136,8 +137,8 @@ dxf_object_id_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (object_id->data);
-        free (object_id);
+        dxf_free (object_id->data);
+        dxf_free (object_id);
         object_id = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -157,7 +158,7 @@ dxf_object_id_free_chain
                 /*!< a pointer to the chain of DXF \c object_ids. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (object_ids == NULL)
@@ -295,7 +296,7 @@ dxf_object_id_get_data
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (object_id->data));
+        return (dxf_strdup (object_id->data));
 }
 
 
@@ -329,7 +330,7 @@ dxf_object_id_set_data
                   __FUNCTION__);
                 return (NULL);
         }
-        object_id->data = strdup (data);
+        object_id->data = dxf_strdup (data);
 #if DEBUG
         DXF_DEBUG_END
 #endif
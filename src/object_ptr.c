@@ -35,6 +35,8 @@
 
 
 #include "object_ptr.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -162,7 +164,8 @@ dxf_object_ptr_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfPair pair;
         int i;
 
         /* Do some basic checks. */
@@ -171,8 +174,6 @@ dxf_object_ptr_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (fp->acad_version_number < AutoCAD_14)
@@ -190,64 +191,51 @@ dxf_object_ptr_read
                 object_ptr = dxf_object_ptr_init (object_ptr);
         }
         i = 0;
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        /* Clean up. */
-                        free (temp_string);
-                        fclose (fp->fp);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &object_ptr->id_code);
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", object_ptr->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "360") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", object_ptr->dictionary_owner_hard);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else if (strcmp (temp_string, "999") == 0)
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, (_("DXF comment: %s\n")), temp_string);
-                }
-                else if (strcmp (temp_string, "1001") == 0)
-                {
-                        /* Now follows a string containing extended data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", object_ptr->xdata[i]);
-                        i++;
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                object_ptr->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner dictionary. */
+                                free (object_ptr->dictionary_owner_soft);
+                                object_ptr->dictionary_owner_soft = dxf_pair_get_string (&pair);
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                free (object_ptr->dictionary_owner_hard);
+                                object_ptr->dictionary_owner_hard = dxf_pair_get_string (&pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, (_("DXF comment: %s\n")), temp_string);
+                                break;
+                        case 1001:
+                                /* Now follows a string containing extended data. */
+                                object_ptr->xdata[i] = dxf_pair_get_string (&pair);
+                                i++;
+                                break;
+                        default:
+                                fprintf (stderr,
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
+                                  __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
-        /* Clean up. */
-        free (temp_string);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -304,14 +292,14 @@ dxf_object_ptr_write
         if (fp->acad_version_number < AutoCAD_14)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () illegal DXF version for this %s entity with id-code: %x.\n")),
+                  (_("Warning in %s () illegal DXF version for this %s entity with id-code: %lx.\n")),
                   __FUNCTION__, dxf_entity_name, object_ptr->id_code);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_string (fp, 0, dxf_entity_name);
         if (object_ptr->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", object_ptr->id_code);
+                dxf_write_hex (fp, 5, object_ptr->id_code);
         }
         /*!
          * \todo for version R14.\n
@@ -326,21 +314,21 @@ dxf_object_ptr_write
         if ((strcmp (object_ptr->dictionary_owner_soft, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", object_ptr->dictionary_owner_soft);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, object_ptr->dictionary_owner_soft);
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (object_ptr->dictionary_owner_hard, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", object_ptr->dictionary_owner_hard);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, object_ptr->dictionary_owner_hard);
+                dxf_write_string (fp, 102, "}");
         }
         i = 0;
         while (strlen (object_ptr->xdata[i]) > 0)
         {
-                fprintf (fp->fp, "1001\n%s\n", object_ptr->xdata[i]);
+                dxf_write_string (fp, 1001, object_ptr->xdata[i]);
                 i++;
                 /*! \todo Check for overrun of array index. */
         }
@@ -419,7 +407,7 @@ dxf_object_ptr_free_chain
                 /*!< a pointer to the chain of DXF \c OBJECT_PTR objects. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (objectptrs == NULL)
@@ -59,7 +59,7 @@ typedef struct
 dxf_object_ptr
 {
         /* Members common for all DXF objects. */
-        int id_code;
+        long id_code;
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file.\n
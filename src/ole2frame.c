@@ -33,6 +33,9 @@
 
 
 #include "ole2frame.h"
+#include "arena.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -58,7 +61,7 @@ dxf_ole2frame_new ()
         size = sizeof (DxfOle2Frame);
         /* avoid malloc of 0 bytes */
         if (size == 0) size = 1;
-        if ((ole2frame = malloc (size)) == NULL)
+        if ((ole2frame = dxf_malloc (size)) == NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () could not allocate memory for a DxfOle2Frame struct.\n")),
@@ -117,18 +120,11 @@ dxf_ole2frame_init
               return (NULL);
         }
         ole2frame->id_code = 0;
-        ole2frame->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        ole2frame->layer = strdup (DXF_DEFAULT_LAYER);
-        ole2frame->elevation = 0.0;
-        ole2frame->thickness = 0.0;
-        ole2frame->linetype_scale = DXF_DEFAULT_LINETYPE_SCALE;
-        ole2frame->visibility = DXF_DEFAULT_VISIBILITY;
-        ole2frame->color = DXF_COLOR_BYLAYER;
-        ole2frame->paperspace = DXF_MODELSPACE;
-        ole2frame->dictionary_owner_soft = strdup ("");
-        ole2frame->dictionary_owner_hard = strdup ("");
-        ole2frame->end_of_data = strdup ("");
-        ole2frame->length_of_binary_data = strdup ("");
+        ole2frame->properties = dxf_graphic_properties_default ();
+        ole2frame->dictionary_owner_soft = dxf_strdup ("");
+        ole2frame->dictionary_owner_hard = dxf_strdup ("");
+        ole2frame->end_of_data = dxf_strdup ("");
+        ole2frame->length_of_binary_data = dxf_strdup ("");
         ole2frame->x0 = 0.0;
         ole2frame->y0 = 0.0;
         ole2frame->z0 = 0.0;
@@ -141,7 +137,7 @@ dxf_ole2frame_init
         ole2frame->length = 0;
         for (i = 0; i < DXF_MAX_PARAM; i++)
         {
-                ole2frame->binary_data[i] = strdup ("");
+                ole2frame->binary_data[i] = dxf_strdup ("");
         }
         ole2frame->next = NULL;
 #if DEBUG
@@ -180,7 +176,9 @@ dxf_ole2frame_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfGraphicProperties properties;
+        DxfPair pair;
         int i;
 
         /* Do some basic checks. */
@@ -189,8 +187,6 @@ dxf_ole2frame_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (ole2frame == NULL)
@@ -202,234 +198,193 @@ dxf_ole2frame_read
                 ole2frame = dxf_ole2frame_init (ole2frame);
         }
         i = 0;
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        dxf_graphic_properties_start (&properties, ole2frame->properties);
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
+                if (pair.group_code == 0)
                 {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        fclose (fp->fp);
-                        /* Clean up. */
-                        free (temp_string);
-                        return (NULL);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                if (strcmp (temp_string, "1") == 0)
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing a End of Ole
-                         * data marker. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "OLE") != 0)
-                        {
+                        case 1:
+                                /* Now follows a string containing a End of Ole
+                                 * data marker. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                if (strcmp (temp_string, "OLE") != 0)
+                                {
+                                        fprintf (stderr,
+                                          (_("Warning in %s () found a bad End of Ole data marker in: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                }
+                                break;
+                        case 3:
+                                /* Now follows a string containing the length of
+                                 * binary data. */
+                                dxf_free (ole2frame->length_of_binary_data);
+                                ole2frame->length_of_binary_data = dxf_pair_get_string (&pair);
+                                break;
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                ole2frame->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 6:
+                                /* Now follows a string containing a linetype
+                                 * name. */
+                                dxf_lexer_free_string (fp, properties.linetype);
+                                properties.linetype = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 8:
+                                /* Now follows a string containing a layer name. */
+                                dxf_lexer_free_string (fp, properties.layer);
+                                properties.layer = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 10:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the insertion point. */
+                                ole2frame->x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 20:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the insertion point. */
+                                ole2frame->y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 30:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the insertion point. */
+                                ole2frame->z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 11:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the direction vector. */
+                                ole2frame->x1 = dxf_pair_get_double (&pair);
+                                break;
+                        case 21:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the direction vector. */
+                                ole2frame->y1 = dxf_pair_get_double (&pair);
+                                break;
+                        case 31:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the direction vector. */
+                                ole2frame->z1 = dxf_pair_get_double (&pair);
+                                break;
+                        case 38:
+                                if (fp->acad_version_number <= AutoCAD_11)
+                                {
+                                        /* Now follows a string containing the
+                                         * elevation. */
+                                        properties.elevation = dxf_pair_get_double (&pair);
+                                }
+                                break;
+                        case 39:
+                                /* Now follows a string containing the
+                                 * thickness. */
+                                properties.thickness = dxf_pair_get_double (&pair);
+                                break;
+                        case 48:
+                                /* Now follows a string containing the linetype
+                                 * scale. */
+                                properties.linetype_scale = dxf_pair_get_double (&pair);
+                                break;
+                        case 60:
+                                /* Now follows a string containing the
+                                 * visibility value. */
+                                properties.visibility = dxf_pair_get_int (&pair);
+                                break;
+                        case 62:
+                                /* Now follows a string containing the
+                                 * color value. */
+                                properties.color = dxf_pair_get_int (&pair);
+                                break;
+                        case 67:
+                                /* Now follows a string containing the
+                                 * paperspace value. */
+                                properties.paperspace = dxf_pair_get_int (&pair);
+                                break;
+                        case 70:
+                                /* Now follows a string containing the ole
+                                 * version number. */
+                                ole2frame->ole_version_number = dxf_pair_get_int (&pair);
+                                break;
+                        case 71:
+                                /* Now follows a string containing the ole
+                                 * object type. */
+                                ole2frame->ole_object_type = dxf_pair_get_int (&pair);
+                                break;
+                        case 72:
+                                /* Now follows a string containing the tilemode
+                                 * descriptor. */
+                                ole2frame->tilemode_descriptor = dxf_pair_get_int (&pair);
+                                break;
+                        case 90:
+                                /* Now follows a string containing the length of
+                                 * binary data. */
+                                ole2frame->length = dxf_pair_get_long (&pair);
+                                break;
+                        case 100:
+                                if (fp->acad_version_number >= AutoCAD_13)
+                                {
+                                        /* Now follows a string containing the
+                                         * subclass marker value. */
+                                        dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                        if ((strcmp (temp_string, "AcDbEntity") != 0)
+                                        && ((strcmp (temp_string, "AcDbOle2Frame") != 0)))
+                                        {
+                                                fprintf (stderr,
+                                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                                  __FUNCTION__, fp->filename, fp->line_number);
+                                        }
+                                }
+                                break;
+                        case 310:
+                                /* Now follows a string containing binary data. */
+                                ole2frame->binary_data[i] = dxf_pair_get_string (&pair);
+                                i++;
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, ole2frame->dictionary_owner_soft);
+                                ole2frame->dictionary_owner_soft = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, ole2frame->dictionary_owner_hard);
+                                ole2frame->dictionary_owner_hard = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, "DXF comment: %s\n", temp_string);
+                                break;
+                        default:
                                 fprintf (stderr,
-                                  (_("Warning in %s () found a bad End of Ole data marker in: %s in line: %d.\n")),
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
                                   __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                if (strcmp (temp_string, "3") == 0)
-                {
-                        /* Now follows a string containing the length of
-                         * binary data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", ole2frame->length_of_binary_data);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &ole2frame->id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", ole2frame->linetype);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", ole2frame->layer);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the insertion point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ole2frame->x0);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the insertion point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ole2frame->y0);
-                }
-                else if (strcmp (temp_string, "30") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the insertion point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ole2frame->z0);
-                }
-                else if (strcmp (temp_string, "11") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the direction vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ole2frame->x1);
-                }
-                else if (strcmp (temp_string, "21") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the direction vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ole2frame->y1);
-                }
-                else if (strcmp (temp_string, "31") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the direction vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ole2frame->z1);
-                }
-                else if ((fp->acad_version_number <= AutoCAD_11)
-                        && (strcmp (temp_string, "38") == 0))
-                {
-                        /* Now follows a string containing the
-                         * elevation. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ole2frame->elevation);
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ole2frame->thickness);
-                }
-                else if (strcmp (temp_string, "48") == 0)
-                {
-                        /* Now follows a string containing the linetype
-                         * scale. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ole2frame->linetype_scale);
-                }
-                else if (strcmp (temp_string, "60") == 0)
-                {
-                        /* Now follows a string containing the
-                         * visibility value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &ole2frame->visibility);
-                }
-                else if (strcmp (temp_string, "62") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &ole2frame->color);
-                }
-                else if (strcmp (temp_string, "67") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &ole2frame->paperspace);
-                }
-                else if (strcmp (temp_string, "70") == 0)
-                {
-                        /* Now follows a string containing the ole
-                         * version number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &ole2frame->ole_version_number);
-                }
-                else if (strcmp (temp_string, "71") == 0)
-                {
-                        /* Now follows a string containing the ole
-                         * object type. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &ole2frame->ole_object_type);
-                }
-                else if (strcmp (temp_string, "72") == 0)
-                {
-                        /* Now follows a string containing the tilemode
-                         * descriptor. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &ole2frame->tilemode_descriptor);
-                }
-                else if (strcmp (temp_string, "90") == 0)
-                {
-                        /* Now follows a string containing the length of
-                         * binary data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%ld\n", &ole2frame->length);
-                }
-                else if ((fp->acad_version_number >= AutoCAD_13)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if ((strcmp (temp_string, "AcDbEntity") != 0)
-                        && ((strcmp (temp_string, "AcDbOle2Frame") != 0)))
-                        {
-                                fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "310") == 0)
-                {
-                        /* Now follows a string containing binary data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", ole2frame->binary_data[i]);
-                        i++;
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", ole2frame->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", ole2frame->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
         /* Handle omitted members and/or illegal values. */
-        if (strcmp (ole2frame->linetype, "") == 0)
+        if ((properties.linetype != NULL)
+          && (strcmp (properties.linetype, "") == 0))
         {
-                ole2frame->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_lexer_free_string (fp, properties.linetype);
+                properties.linetype = dxf_strdup (DXF_DEFAULT_LINETYPE);
         }
-        if (strcmp (ole2frame->layer, "") == 0)
+        if ((properties.layer != NULL)
+          && (strcmp (properties.layer, "") == 0))
         {
-                ole2frame->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_lexer_free_string (fp, properties.layer);
+                properties.layer = dxf_strdup (DXF_DEFAULT_LAYER);
         }
-        /* Clean up. */
-        free (temp_string);
+        /* Entities with equal properties share a record. */
+        dxf_graphic_properties_finish (fp, &ole2frame->properties, &properties);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -461,7 +416,7 @@ dxf_ole2frame_write
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *dxf_entity_name = strdup ("OLE2FRAME");
+        char *dxf_entity_name = dxf_strdup ("OLE2FRAME");
         int i;
 
         /* Do some basic checks. */
@@ -471,7 +426,7 @@ dxf_ole2frame_write
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (ole2frame == NULL)
@@ -480,7 +435,7 @@ dxf_ole2frame_write
                   (_("Error in %s () a NULL pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (fp->acad_version_number < AutoCAD_14)
@@ -489,31 +444,39 @@ dxf_ole2frame_write
                   (_("Warning in %s () illegal DXF version for this entity.\n")),
                   __FUNCTION__);
         }
-        if (strcmp (ole2frame->linetype, "") == 0)
+        if (strcmp (ole2frame->properties->linetype, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, ole2frame->id_code);
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                ole2frame->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                if (dxf_graphic_properties_unshare (&ole2frame->properties) != NULL)
+                {
+                        dxf_free (ole2frame->properties->linetype);
+                        ole2frame->properties->linetype = dxf_strdup (DXF_DEFAULT_LINETYPE);
+                }
         }
-        if (strcmp (ole2frame->layer, "") == 0)
+        if (strcmp (ole2frame->properties->layer, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty layer string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty layer string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, ole2frame->id_code);
                 fprintf (stderr,
                   (_("\t%s entity is relocated to layer 0")),
                   dxf_entity_name);
-                ole2frame->layer = strdup (DXF_DEFAULT_LAYER);
+                if (dxf_graphic_properties_unshare (&ole2frame->properties) != NULL)
+                {
+                        dxf_free (ole2frame->properties->layer);
+                        ole2frame->properties->layer = dxf_strdup (DXF_DEFAULT_LAYER);
+                }
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_string (fp, 0, dxf_entity_name);
         if (ole2frame->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", ole2frame->id_code);
+                dxf_write_hex (fp, 5, ole2frame->id_code);
         }
         /*!
          * \todo for version R14.\n
@@ -528,76 +491,76 @@ dxf_ole2frame_write
         if ((strcmp (ole2frame->dictionary_owner_soft, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", ole2frame->dictionary_owner_soft);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, ole2frame->dictionary_owner_soft);
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (ole2frame->dictionary_owner_hard, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", ole2frame->dictionary_owner_hard);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, ole2frame->dictionary_owner_hard);
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbEntity\n");
+                dxf_write_string (fp, 100, "AcDbEntity");
         }
-        if (ole2frame->paperspace == DXF_PAPERSPACE)
+        if (ole2frame->properties->paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp->fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_int (fp, 67, DXF_PAPERSPACE);
         }
-        fprintf (fp->fp, "  8\n%s\n", ole2frame->layer);
-        if (strcmp (ole2frame->linetype, DXF_DEFAULT_LINETYPE) != 0)
+        dxf_write_string (fp, 8, ole2frame->properties->layer);
+        if (strcmp (ole2frame->properties->linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp->fp, "  6\n%s\n", ole2frame->linetype);
+                dxf_write_string (fp, 6, ole2frame->properties->linetype);
         }
         if ((fp->acad_version_number <= AutoCAD_11)
           && DXF_FLATLAND
-          && (ole2frame->elevation != 0.0))
+          && (ole2frame->properties->elevation != 0.0))
         {
-                fprintf (fp->fp, " 38\n%f\n", ole2frame->elevation);
+                dxf_write_double (fp, 38, ole2frame->properties->elevation);
         }
-        if (ole2frame->color != DXF_COLOR_BYLAYER)
+        if (ole2frame->properties->color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp->fp, " 62\n%d\n", ole2frame->color);
+                dxf_write_int (fp, 62, ole2frame->properties->color);
         }
-        if (ole2frame->linetype_scale != 1.0)
+        if (ole2frame->properties->linetype_scale != 1.0)
         {
-                fprintf (fp->fp, " 48\n%f\n", ole2frame->linetype_scale);
+                dxf_write_double (fp, 48, ole2frame->properties->linetype_scale);
         }
-        if (ole2frame->visibility != 0)
+        if (ole2frame->properties->visibility != 0)
         {
-                fprintf (fp->fp, " 60\n%d\n", ole2frame->visibility);
+                dxf_write_int (fp, 60, ole2frame->properties->visibility);
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbOle2Frame\n");
+                dxf_write_string (fp, 100, "AcDbOle2Frame");
         }
-        if (ole2frame->thickness != 0.0)
+        if (ole2frame->properties->thickness != 0.0)
         {
-                fprintf (fp->fp, " 39\n%f\n", ole2frame->thickness);
+                dxf_write_double (fp, 39, ole2frame->properties->thickness);
         }
-        fprintf (fp->fp, " 70\n%d\n", ole2frame->ole_version_number);
-        fprintf (fp->fp, "  3\n%s\n", ole2frame->length_of_binary_data);
-        fprintf (fp->fp, " 10\n%f\n", ole2frame->x0);
-        fprintf (fp->fp, " 20\n%f\n", ole2frame->y0);
-        fprintf (fp->fp, " 30\n%f\n", ole2frame->z0);
-        fprintf (fp->fp, " 11\n%f\n", ole2frame->x1);
-        fprintf (fp->fp, " 21\n%f\n", ole2frame->y1);
-        fprintf (fp->fp, " 31\n%f\n", ole2frame->z1);
-        fprintf (fp->fp, " 71\n%d\n", ole2frame->ole_object_type);
-        fprintf (fp->fp, " 72\n%d\n", ole2frame->tilemode_descriptor);
-        fprintf (fp->fp, " 90\n%ld\n", ole2frame->length);
+        dxf_write_int (fp, 70, ole2frame->ole_version_number);
+        dxf_write_string (fp, 3, ole2frame->length_of_binary_data);
+        dxf_write_double (fp, 10, ole2frame->x0);
+        dxf_write_double (fp, 20, ole2frame->y0);
+        dxf_write_double (fp, 30, ole2frame->z0);
+        dxf_write_double (fp, 11, ole2frame->x1);
+        dxf_write_double (fp, 21, ole2frame->y1);
+        dxf_write_double (fp, 31, ole2frame->z1);
+        dxf_write_int (fp, 71, ole2frame->ole_object_type);
+        dxf_write_int (fp, 72, ole2frame->tilemode_descriptor);
+        dxf_write_long (fp, 90, ole2frame->length);
         i = 0;
         while (strlen (ole2frame->binary_data[i]) > 0)
         {
-                fprintf (fp->fp, "310\n%s\n", ole2frame->binary_data[i]);
+                dxf_write_string (fp, 310, ole2frame->binary_data[i]);
                 i++;
         }
-        fprintf (fp->fp, "  1\nOLE\n");
+        dxf_write_string (fp, 1, "OLE");
         /* Clean up. */
-        free (dxf_entity_name);
+        dxf_free (dxf_entity_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -638,17 +601,16 @@ dxf_ole2frame_free
                 __FUNCTION__);
               return (EXIT_FAILURE);
         }
-        free (ole2frame->end_of_data);
-        free (ole2frame->length_of_binary_data);
-        free (ole2frame->linetype);
-        free (ole2frame->layer);
-        free (ole2frame->dictionary_owner_soft);
-        free (ole2frame->dictionary_owner_hard);
+        dxf_free (ole2frame->end_of_data);
+        dxf_free (ole2frame->length_of_binary_data);
+        dxf_graphic_properties_free (ole2frame->properties);
+        dxf_free (ole2frame->dictionary_owner_soft);
+        dxf_free (ole2frame->dictionary_owner_hard);
         for (i = 0; i < DXF_MAX_PARAM; i++)
         {
-                free (ole2frame->binary_data[i]);
+                dxf_free (ole2frame->binary_data[i]);
         }
-        free (ole2frame);
+        dxf_free (ole2frame);
         ole2frame = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -674,7 +636,7 @@ dxf_ole2frame_free_chain
                 /*!< a pointer to the chain of DXF \c OLE2FRAME entities. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (ole2frames == NULL)
@@ -33,6 +33,9 @@
 
 
 #include "oleframe.h"
+#include "arena.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -55,7 +58,7 @@ dxf_oleframe_new ()
         size = sizeof (DxfOleFrame);
         /* avoid malloc of 0 bytes */
         if (size == 0) size = 1;
-        if ((oleframe = malloc (size)) == NULL)
+        if ((oleframe = dxf_malloc (size)) == NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () could not allocate memory for a DxfOleFrame struct.\n")),
@@ -111,21 +114,14 @@ dxf_oleframe_init
               return (NULL);
         }
         oleframe->id_code = 0;
-        oleframe->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        oleframe->layer = strdup (DXF_DEFAULT_LAYER);
-        oleframe->elevation = 0.0;
-        oleframe->thickness = 0.0;
-        oleframe->linetype_scale = DXF_DEFAULT_LINETYPE_SCALE;
-        oleframe->visibility = DXF_DEFAULT_VISIBILITY;
-        oleframe->color = DXF_COLOR_BYLAYER;
-        oleframe->paperspace = DXF_MODELSPACE;
-        oleframe->dictionary_owner_soft = strdup ("");
-        oleframe->dictionary_owner_hard = strdup ("");
+        oleframe->properties = dxf_graphic_properties_default ();
+        oleframe->dictionary_owner_soft = dxf_strdup ("");
+        oleframe->dictionary_owner_hard = dxf_strdup ("");
         oleframe->ole_version_number = 1;
         oleframe->length = 0;
         for (i = 0; i < DXF_MAX_PARAM; i++)
         {
-                oleframe->binary_data[i] = strdup ("");
+                oleframe->binary_data[i] = dxf_strdup ("");
         }
         oleframe->next = NULL;
 #if DEBUG
@@ -161,7 +157,9 @@ dxf_oleframe_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfGraphicProperties properties;
+        DxfPair pair;
         int i;
 
         /* Do some basic checks. */
@@ -170,8 +168,6 @@ dxf_oleframe_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (oleframe == NULL)
@@ -183,172 +179,148 @@ dxf_oleframe_read
                 oleframe = dxf_oleframe_init (oleframe);
         }
         i = 0;
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        dxf_graphic_properties_start (&properties, oleframe->properties);
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
+                if (pair.group_code == 0)
                 {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        fclose (fp->fp);
-                        /* Clean up. */
-                        free (temp_string);
-                        return (NULL);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                if (strcmp (temp_string, "1") == 0)
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing a End of Ole
-                         * data marker. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "OLE") != 0)
-                        {
+                        case 1:
+                                /* Now follows a string containing a End of Ole
+                                 * data marker. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                if (strcmp (temp_string, "OLE") != 0)
+                                {
+                                        fprintf (stderr,
+                                          (_("Warning in %s () found a bad End of Ole data marker in: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                }
+                                break;
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                oleframe->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 6:
+                                /* Now follows a string containing a linetype
+                                 * name. */
+                                dxf_lexer_free_string (fp, properties.linetype);
+                                properties.linetype = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 8:
+                                /* Now follows a string containing a layer name. */
+                                dxf_lexer_free_string (fp, properties.layer);
+                                properties.layer = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 38:
+                                if ((fp->acad_version_number <= AutoCAD_11)
+                                  && (properties.elevation != 0.0))
+                                {
+                                        /* Now follows a string containing the
+                                         * elevation. */
+                                        properties.elevation = dxf_pair_get_double (&pair);
+                                }
+                                break;
+                        case 39:
+                                /* Now follows a string containing the
+                                 * thickness. */
+                                properties.thickness = dxf_pair_get_double (&pair);
+                                break;
+                        case 48:
+                                /* Now follows a string containing the linetype
+                                 * scale. */
+                                properties.linetype_scale = dxf_pair_get_double (&pair);
+                                break;
+                        case 60:
+                                /* Now follows a string containing the
+                                 * visibility value. */
+                                properties.visibility = dxf_pair_get_int (&pair);
+                                break;
+                        case 62:
+                                /* Now follows a string containing the
+                                 * color value. */
+                                properties.color = dxf_pair_get_int (&pair);
+                                break;
+                        case 67:
+                                /* Now follows a string containing the
+                                 * paperspace value. */
+                                properties.paperspace = dxf_pair_get_int (&pair);
+                                break;
+                        case 70:
+                                /* Now follows a string containing the ole
+                                 * version number. */
+                                oleframe->ole_version_number = dxf_pair_get_int (&pair);
+                                break;
+                        case 90:
+                                /* Now follows a string containing the length of
+                                 * binary data. */
+                                oleframe->length = dxf_pair_get_long (&pair);
+                                break;
+                        case 100:
+                                if (fp->acad_version_number >= AutoCAD_13)
+                                {
+                                        /* Now follows a string containing the
+                                         * subclass marker value. */
+                                        dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                        if ((strcmp (temp_string, "AcDbEntity") != 0)
+                                        && ((strcmp (temp_string, "AcDbOleFrame") != 0)))
+                                        {
+                                                fprintf (stderr,
+                                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                                  __FUNCTION__, fp->filename, fp->line_number);
+                                        }
+                                }
+                                break;
+                        case 310:
+                                /* Now follows a string containing binary data. */
+                                oleframe->binary_data[i] = dxf_pair_get_string (&pair);
+                                i++;
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, oleframe->dictionary_owner_soft);
+                                oleframe->dictionary_owner_soft = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, oleframe->dictionary_owner_hard);
+                                oleframe->dictionary_owner_hard = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, "DXF comment: %s\n", temp_string);
+                                break;
+                        default:
                                 fprintf (stderr,
-                                  (_("Warning in %s () found a bad End of Ole data marker in: %s in line: %d.\n")),
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
                                   __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &oleframe->id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", oleframe->linetype);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", oleframe->layer);
-                }
-                else if ((fp->acad_version_number <= AutoCAD_11)
-                        && (strcmp (temp_string, "38") == 0)
-                        && (oleframe->elevation != 0.0))
-                {
-                        /* Now follows a string containing the
-                         * elevation. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &oleframe->elevation);
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &oleframe->thickness);
-                }
-                else if (strcmp (temp_string, "48") == 0)
-                {
-                        /* Now follows a string containing the linetype
-                         * scale. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &oleframe->linetype_scale);
-                }
-                else if (strcmp (temp_string, "60") == 0)
-                {
-                        /* Now follows a string containing the
-                         * visibility value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &oleframe->visibility);
-                }
-                else if (strcmp (temp_string, "62") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &oleframe->color);
-                }
-                else if (strcmp (temp_string, "67") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &oleframe->paperspace);
-                }
-                else if (strcmp (temp_string, "70") == 0)
-                {
-                        /* Now follows a string containing the ole
-                         * version number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &oleframe->ole_version_number);
-                }
-                else if (strcmp (temp_string, "90") == 0)
-                {
-                        /* Now follows a string containing the length of
-                         * binary data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%ld\n", &oleframe->length);
-                }
-                else if ((fp->acad_version_number >= AutoCAD_13)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if ((strcmp (temp_string, "AcDbEntity") != 0)
-                        && ((strcmp (temp_string, "AcDbOleFrame") != 0)))
-                        {
-                                fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "310") == 0)
-                {
-                        /* Now follows a string containing binary data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", oleframe->binary_data[i]);
-                        i++;
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", oleframe->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", oleframe->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
         /* Handle omitted members and/or illegal values. */
-        if (strcmp (oleframe->linetype, "") == 0)
+        if ((properties.linetype != NULL)
+          && (strcmp (properties.linetype, "") == 0))
         {
-                oleframe->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_lexer_free_string (fp, properties.linetype);
+                properties.linetype = dxf_strdup (DXF_DEFAULT_LINETYPE);
         }
-        if (strcmp (oleframe->layer, "") == 0)
+        if ((properties.layer != NULL)
+          && (strcmp (properties.layer, "") == 0))
         {
-                oleframe->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_lexer_free_string (fp, properties.layer);
+                properties.layer = dxf_strdup (DXF_DEFAULT_LAYER);
         }
-        /* Clean up. */
-        free (temp_string);
+        /* Entities with equal properties share a record. */
+        dxf_graphic_properties_finish (fp, &oleframe->properties, &properties);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -377,7 +349,7 @@ dxf_oleframe_write
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *dxf_entity_name = strdup ("OLEFRAME");
+        char *dxf_entity_name = dxf_strdup ("OLEFRAME");
         int i;
 
         /* Do some basic checks. */
@@ -387,7 +359,7 @@ dxf_oleframe_write
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (oleframe == NULL)
@@ -396,7 +368,7 @@ dxf_oleframe_write
                   (_("Error in %s () a NULL pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (fp->acad_version_number < AutoCAD_13)
@@ -405,31 +377,39 @@ dxf_oleframe_write
                   (_("Warning in %s () illegal DXF version for this entity.\n")),
                   __FUNCTION__);
         }
-        if (strcmp (oleframe->linetype, "") == 0)
+        if (strcmp (oleframe->properties->linetype, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, oleframe->id_code);
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                oleframe->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                if (dxf_graphic_properties_unshare (&oleframe->properties) != NULL)
+                {
+                        dxf_free (oleframe->properties->linetype);
+                        oleframe->properties->linetype = dxf_strdup (DXF_DEFAULT_LINETYPE);
+                }
         }
-        if (strcmp (oleframe->layer, "") == 0)
+        if (strcmp (oleframe->properties->layer, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty layer string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty layer string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, oleframe->id_code);
                 fprintf (stderr,
                   (_("\t%s entity is relocated to layer 0")),
                   dxf_entity_name);
-                oleframe->layer = strdup (DXF_DEFAULT_LAYER);
+                if (dxf_graphic_properties_unshare (&oleframe->properties) != NULL)
+                {
+                        dxf_free (oleframe->properties->layer);
+                        oleframe->properties->layer = dxf_strdup (DXF_DEFAULT_LAYER);
+                }
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_string (fp, 0, dxf_entity_name);
         if (oleframe->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", oleframe->id_code);
+                dxf_write_hex (fp, 5, oleframe->id_code);
         }
         /*!
          * \todo for version R14.\n
@@ -444,67 +424,67 @@ dxf_oleframe_write
         if ((strcmp (oleframe->dictionary_owner_soft, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", oleframe->dictionary_owner_soft);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, oleframe->dictionary_owner_soft);
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (oleframe->dictionary_owner_hard, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", oleframe->dictionary_owner_hard);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, oleframe->dictionary_owner_hard);
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbEntity\n");
+                dxf_write_string (fp, 100, "AcDbEntity");
         }
-        if (oleframe->paperspace == DXF_PAPERSPACE)
+        if (oleframe->properties->paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp->fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_int (fp, 67, DXF_PAPERSPACE);
         }
-        fprintf (fp->fp, "  8\n%s\n", oleframe->layer);
-        if (strcmp (oleframe->linetype, DXF_DEFAULT_LINETYPE) != 0)
+        dxf_write_string (fp, 8, oleframe->properties->layer);
+        if (strcmp (oleframe->properties->linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp->fp, "  6\n%s\n", oleframe->linetype);
+                dxf_write_string (fp, 6, oleframe->properties->linetype);
         }
         if ((fp->acad_version_number <= AutoCAD_11)
           && DXF_FLATLAND
-          && (oleframe->elevation != 0.0))
+          && (oleframe->properties->elevation != 0.0))
         {
-                fprintf (fp->fp, " 38\n%f\n", oleframe->elevation);
+                dxf_write_double (fp, 38, oleframe->properties->elevation);
         }
-        if (oleframe->color != DXF_COLOR_BYLAYER)
+        if (oleframe->properties->color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp->fp, " 62\n%d\n", oleframe->color);
+                dxf_write_int (fp, 62, oleframe->properties->color);
         }
-        if (oleframe->linetype_scale != 1.0)
+        if (oleframe->properties->linetype_scale != 1.0)
         {
-                fprintf (fp->fp, " 48\n%f\n", oleframe->linetype_scale);
+                dxf_write_double (fp, 48, oleframe->properties->linetype_scale);
         }
-        if (oleframe->visibility != 0)
+        if (oleframe->properties->visibility != 0)
         {
-                fprintf (fp->fp, " 60\n%d\n", oleframe->visibility);
+                dxf_write_int (fp, 60, oleframe->properties->visibility);
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbOleFrame\n");
+                dxf_write_string (fp, 100, "AcDbOleFrame");
         }
-        if (oleframe->thickness != 0.0)
+        if (oleframe->properties->thickness != 0.0)
         {
-                fprintf (fp->fp, " 39\n%f\n", oleframe->thickness);
+                dxf_write_double (fp, 39, oleframe->properties->thickness);
         }
-        fprintf (fp->fp, " 70\n%d\n", oleframe->ole_version_number);
-        fprintf (fp->fp, " 90\n%ld\n", oleframe->length);
+        dxf_write_int (fp, 70, oleframe->ole_version_number);
+        dxf_write_long (fp, 90, oleframe->length);
         i = 0;
         while (strlen (oleframe->binary_data[i]) > 0)
         {
-                fprintf (fp->fp, "310\n%s\n", oleframe->binary_data[i]);
+                dxf_write_string (fp, 310, oleframe->binary_data[i]);
                 i++;
         }
-        fprintf (fp->fp, "  1\nOLE\n");
+        dxf_write_string (fp, 1, "OLE");
         /* Clean up. */
-        free (dxf_entity_name);
+        dxf_free (dxf_entity_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -542,15 +522,14 @@ dxf_oleframe_free
                 __FUNCTION__);
               return (EXIT_FAILURE);
         }
-        free (oleframe->linetype);
-        free (oleframe->layer);
-        free (oleframe->dictionary_owner_soft);
-        free (oleframe->dictionary_owner_hard);
+        dxf_graphic_properties_free (oleframe->properties);
+        dxf_free (oleframe->dictionary_owner_soft);
+        dxf_free (oleframe->dictionary_owner_hard);
         for (i = 0; i < DXF_MAX_PARAM; i++)
         {
-                free (oleframe->binary_data[i]);
+                dxf_free (oleframe->binary_data[i]);
         }
-        free (oleframe);
+        dxf_free (oleframe);
         oleframe = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -576,7 +555,7 @@ dxf_oleframe_free_chain
                 /*!< a pointer to the chain of DXF \c OLEFRAME entities. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (oleframes == NULL)
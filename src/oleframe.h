@@ -37,6 +37,7 @@
 
 
 #include "global.h"
+#include "graphic_properties.h"
 
 
 #ifdef __cplusplus
@@ -54,46 +55,16 @@ typedef struct
 dxf_oleframe
 {
         /* Members common for all DXF drawable entities. */
-        int id_code;
+        long id_code;
                 /*!< group code = 5\n
                  * Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
-        char *linetype;
-                /*!< group code = 6\n
-                 * The linetype of the entity.\n
-                 * Defaults to \c BYLAYER if ommitted in the DXF file. */
-        char *layer;
-                /*!< group code = 8\n
-                 * Layer on which the entity is drawn.\n
-                 * Defaults to layer "0" if no valid layername is given. */
-        double elevation;
-                /*!< group code = 38\n
-                 * Elevation of the arc in the local Z-direction.\n
-                 * Defaults to 0.0 if omitted in the DXF file, or prior
-                 * to DXF version R12, or DXF_FLATLAND equals 0 (default). */
-        double thickness;
-                /*!< group code = 39\n
-                 * Thickness of the arc in the local Z-direction.\n
-                 * Defaults to 0.0 if ommitted in the DXF file. */
-        double linetype_scale;
-                /*!< group code = 48\n
-                 * Linetype scale (optional). */
-        int16_t visibility;
-                /*!< group code = 60\n
-                 * Object visibility (optional): 0 = Visible; 1 = Invisible. */
-        int color;
-                /*!< group code = 62\n
-                 * Color of the entity.\n
-                 * Defaults to \c BYLAYER if ommitted in the DXF file.\n
-                 * Note that entities encapsulated in a block with the
-                 * color \c BYBLOCK are represented in the "native" color of
-                 * the \c BLOCK entity. */
-        int paperspace;
-                /*!< group code = 67\n
-                 * Entities are to be drawn on either \c PAPERSPACE or
-                 * \c MODELSPACE.\n
-                 * Optional, defaults to \c DXF_MODELSPACE (0). */
+        DxfGraphicProperties *properties;
+                /*!< Linetype, layer, color and the other graphic
+                 * properties, shared with the entities which have
+                 * the same (see graphic_properties.h).\n
+                 * Group codes = 6, 8, 38, 39, 48, 60, 62 and 67. */
         char *dictionary_owner_soft;
                 /*!< group code = 330\n
                  * Soft-pointer ID/handle to owner dictionary (optional). */
@@ -46,18 +46,35 @@ extern "C" {
 
 /*!
  * \brief DXF parameter definition.
+ *
+ * A group code with its value, the type of the value is packed next to
+ * the group code.\n
+ * Numbers are held inline, strings (including handles and binary
+ * chunks in their hexadecimal form) are referenced, they are shared
+ * through the string pool of the drawing when read by
+ * dxf_drawing_read ().
  */
-typedef union
+typedef struct
 dxf_param
 {
-        int group_code;
+        int16_t group_code;
                 /*!< parameter group code. */
-        int I;
-                /*!< integer value. */
-        double D;
-                /*!< double value. */
-        char S[DXF_MAX_STRING_LENGTH];
-                /*!< string value. */
+        uint8_t type;
+                /*!< type of the value, a DxfGroupCodeType. */
+        union
+        {
+                int I;
+                        /*!< integer value (16 and 32 bit integers
+                         * and booleans). */
+                long L;
+                        /*!< long value (64 bit integers). */
+                double D;
+                        /*!< double value. */
+                char *S;
+                        /*!< string value (strings, handles and
+                         * binary chunks). */
+        } value;
+                /*!< value of the parameter. */
 } DxfParam;
 
 
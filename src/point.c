@@ -54,6 +54,9 @@
 
 
 #include "point.h"
+#include "arena.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -73,7 +76,7 @@ dxf_point_new ()
         size = sizeof (DxfPoint);
         /* avoid malloc of 0 bytes */
         if (size == 0) size = 1;
-        if ((point = malloc (size)) == NULL)
+        if ((point = dxf_malloc (size)) == NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () could not allocate memory for a DxfPoint struct.\n")),
@@ -123,23 +126,16 @@ dxf_point_init
                 return (NULL);
         }
         point->id_code = 0;
-        point->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        point->layer = strdup (DXF_DEFAULT_LAYER);
+        point->properties = dxf_graphic_properties_default ();
         point->x0 = 0.0;
         point->y0 = 0.0;
         point->z0 = 0.0;
-        point->elevation = 0.0;
-        point->thickness = 0.0;
-        point->linetype_scale = DXF_DEFAULT_LINETYPE_SCALE;
         point->angle_to_X = 0.0;
-        point->visibility = DXF_DEFAULT_VISIBILITY;
-        point->color = DXF_COLOR_BYLAYER;
-        point->paperspace = DXF_MODELSPACE;
         point->extr_x0 = 0.0;
         point->extr_y0 = 0.0;
         point->extr_z0 = 0.0;
-        point->dictionary_owner_soft = strdup ("");
-        point->dictionary_owner_hard = strdup ("");
+        point->dictionary_owner_soft = dxf_strdup ("");
+        point->dictionary_owner_hard = dxf_strdup ("");
         point->next = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -172,7 +168,9 @@ dxf_point_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfGraphicProperties properties;
+        DxfPair pair;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -180,8 +178,6 @@ dxf_point_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (point == NULL)
@@ -192,187 +188,157 @@ dxf_point_read
                 point = dxf_point_new ();
                 point = dxf_point_init (point);
         }
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        dxf_graphic_properties_start (&properties, point->properties);
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        fclose (fp->fp);
-                        /* Clean up. */
-                        free (temp_string);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &point->id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", point->linetype);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", point->layer);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the center point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &point->x0);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the center point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &point->y0);
-                }
-                else if (strcmp (temp_string, "30") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the center point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &point->z0);
-                }
-                else if ((fp->acad_version_number <= AutoCAD_11)
-                        && (strcmp (temp_string, "38") == 0)
-                        && (point->elevation != 0.0))
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing the
-                         * elevation. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &point->elevation);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else if (strcmp (temp_string, "39") == 0)
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &point->thickness);
-                }
-                else if (strcmp (temp_string, "48") == 0)
-                {
-                        /* Now follows a string containing the linetype
-                         * scale. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &point->linetype_scale);
-                }
-                else if (strcmp (temp_string, "50") == 0)
-                {
-                        /* Now follows a string containing the
-                         * start angle. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &point->angle_to_X);
-                }
-                else if (strcmp (temp_string, "60") == 0)
-                {
-                        /* Now follows a string containing the
-                         * visibility value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &point->visibility);
-                }
-                else if (strcmp (temp_string, "62") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &point->color);
-                }
-                else if (strcmp (temp_string, "67") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &point->paperspace);
-                }
-                else if ((fp->acad_version_number >= AutoCAD_13)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if ((strcmp (temp_string, "AcDbEntity") != 0)
-                        && ((strcmp (temp_string, "AcDbPoint") != 0)))
-                        {
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                point->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 6:
+                                /* Now follows a string containing a linetype
+                                 * name. */
+                                dxf_lexer_free_string (fp, properties.linetype);
+                                properties.linetype = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 8:
+                                /* Now follows a string containing a layer name. */
+                                dxf_lexer_free_string (fp, properties.layer);
+                                properties.layer = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 10:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the center point. */
+                                point->x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 20:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the center point. */
+                                point->y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 30:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the center point. */
+                                point->z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 38:
+                                if ((fp->acad_version_number <= AutoCAD_11)
+                                  && (properties.elevation != 0.0))
+                                {
+                                        /* Now follows a string containing the
+                                         * elevation. */
+                                        properties.elevation = dxf_pair_get_double (&pair);
+                                }
+                                break;
+                        case 39:
+                                /* Now follows a string containing the
+                                 * thickness. */
+                                properties.thickness = dxf_pair_get_double (&pair);
+                                break;
+                        case 48:
+                                /* Now follows a string containing the linetype
+                                 * scale. */
+                                properties.linetype_scale = dxf_pair_get_double (&pair);
+                                break;
+                        case 50:
+                                /* Now follows a string containing the
+                                 * start angle. */
+                                point->angle_to_X = dxf_pair_get_double (&pair);
+                                break;
+                        case 60:
+                                /* Now follows a string containing the
+                                 * visibility value. */
+                                properties.visibility = dxf_pair_get_int (&pair);
+                                break;
+                        case 62:
+                                /* Now follows a string containing the
+                                 * color value. */
+                                properties.color = dxf_pair_get_int (&pair);
+                                break;
+                        case 67:
+                                /* Now follows a string containing the
+                                 * paperspace value. */
+                                properties.paperspace = dxf_pair_get_int (&pair);
+                                break;
+                        case 100:
+                                if (fp->acad_version_number >= AutoCAD_13)
+                                {
+                                        /* Now follows a string containing the
+                                         * subclass marker value. */
+                                        dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                        if ((strcmp (temp_string, "AcDbEntity") != 0)
+                                        && ((strcmp (temp_string, "AcDbPoint") != 0)))
+                                        {
+                                                fprintf (stderr,
+                                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                                  __FUNCTION__, fp->filename, fp->line_number);
+                                        }
+                                }
+                                break;
+                        case 210:
+                                /* Now follows a string containing the
+                                 * X-value of the extrusion vector. */
+                                point->extr_x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 220:
+                                /* Now follows a string containing the
+                                 * Y-value of the extrusion vector. */
+                                point->extr_y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 230:
+                                /* Now follows a string containing the
+                                 * Z-value of the extrusion vector. */
+                                point->extr_z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, point->dictionary_owner_soft);
+                                point->dictionary_owner_soft = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, point->dictionary_owner_hard);
+                                point->dictionary_owner_hard = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, "DXF comment: %s\n", temp_string);
+                                break;
+                        default:
                                 fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                  (_("Warning: in %s () unknown string tag found while reading from: %s in line: %d.\n")),
                                   __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "210") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &point->extr_x0);
-                }
-                else if (strcmp (temp_string, "220") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &point->extr_y0);
-                }
-                else if (strcmp (temp_string, "230") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &point->extr_z0);
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", point->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", point->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning: in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
         /* Handle omitted members and/or illegal values. */
-        if (strcmp (point->linetype, "") == 0)
+        if ((properties.linetype != NULL)
+          && (strcmp (properties.linetype, "") == 0))
         {
-                point->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_lexer_free_string (fp, properties.linetype);
+                properties.linetype = dxf_strdup (DXF_DEFAULT_LINETYPE);
         }
-        if (strcmp (point->layer, "") == 0)
+        if ((properties.layer != NULL)
+          && (strcmp (properties.layer, "") == 0))
         {
-                point->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_lexer_free_string (fp, properties.layer);
+                properties.layer = dxf_strdup (DXF_DEFAULT_LAYER);
         }
-        /* Clean up. */
-        free (temp_string);
+        /* Entities with equal properties share a record. */
+        dxf_graphic_properties_finish (fp, &point->properties, &properties);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -398,7 +364,7 @@ dxf_point_write
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *dxf_entity_name = strdup ("POINT");
+        char *dxf_entity_name = dxf_strdup ("POINT");
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -407,7 +373,7 @@ dxf_point_write
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (point == NULL)
@@ -416,35 +382,35 @@ dxf_point_write
                   (_("Error in %s () a NULL pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
-        if (strcmp (point->linetype, "") == 0)
+        if (strcmp (point->properties->linetype, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, point->id_code);
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                point->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_point_set_linetype (point, DXF_DEFAULT_LINETYPE);
         }
-        if (strcmp (point->layer, "") == 0)
+        if (strcmp (point->properties->layer, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty layer string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty layer string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name,
                         point->id_code);
                 fprintf (stderr,
                   (_("\t%s entity is relocated to layer 0")),
                   dxf_entity_name);
-                point->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_point_set_layer (point, DXF_DEFAULT_LAYER);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_string (fp, 0, dxf_entity_name);
         if (point->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", point->id_code);
+                dxf_write_hex (fp, 5, point->id_code);
         }
         /*!
          * \todo for version R14.\n
@@ -459,71 +425,71 @@ dxf_point_write
         if ((strcmp (point->dictionary_owner_soft, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", point->dictionary_owner_soft);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, point->dictionary_owner_soft);
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (point->dictionary_owner_hard, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", point->dictionary_owner_hard);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, point->dictionary_owner_hard);
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbEntity\n");
+                dxf_write_string (fp, 100, "AcDbEntity");
         }
-        if (point->paperspace == DXF_PAPERSPACE)
+        if (point->properties->paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp->fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_int (fp, 67, DXF_PAPERSPACE);
         }
-        fprintf (fp->fp, "  8\n%s\n", point->layer);
-        if (strcmp (point->linetype, DXF_DEFAULT_LINETYPE) != 0)
+        dxf_write_string (fp, 8, point->properties->layer);
+        if (strcmp (point->properties->linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp->fp, "  6\n%s\n", point->linetype);
+                dxf_write_string (fp, 6, point->properties->linetype);
         }
         if ((fp->acad_version_number <= AutoCAD_11)
           && DXF_FLATLAND
-          && (point->elevation != 0.0))
+          && (point->properties->elevation != 0.0))
         {
-                fprintf (fp->fp, " 38\n%f\n", point->elevation);
+                dxf_write_double (fp, 38, point->properties->elevation);
         }
-        if (point->color != DXF_COLOR_BYLAYER)
+        if (point->properties->color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp->fp, " 62\n%d\n", point->color);
+                dxf_write_int (fp, 62, point->properties->color);
         }
-        if (point->linetype_scale != 1.0)
+        if (point->properties->linetype_scale != 1.0)
         {
-                fprintf (fp->fp, " 48\n%f\n", point->linetype_scale);
+                dxf_write_double (fp, 48, point->properties->linetype_scale);
         }
-        if (point->visibility != 0)
+        if (point->properties->visibility != 0)
         {
-                fprintf (fp->fp, " 60\n%d\n", point->visibility);
+                dxf_write_int (fp, 60, point->properties->visibility);
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbPoint\n");
+                dxf_write_string (fp, 100, "AcDbPoint");
         }
-        fprintf (fp->fp, " 10\n%f\n", point->x0);
-        fprintf (fp->fp, " 20\n%f\n", point->y0);
-        fprintf (fp->fp, " 30\n%f\n", point->z0);
-        if (point->thickness != 0.0)
+        dxf_write_double (fp, 10, point->x0);
+        dxf_write_double (fp, 20, point->y0);
+        dxf_write_double (fp, 30, point->z0);
+        if (point->properties->thickness != 0.0)
         {
-                fprintf (fp->fp, " 39\n%f\n", point->thickness);
+                dxf_write_double (fp, 39, point->properties->thickness);
         }
         if ((fp->acad_version_number >= AutoCAD_12)
                 && (point->extr_x0 != 0.0)
                 && (point->extr_y0 != 0.0)
                 && (point->extr_z0 != 1.0))
         {
-                fprintf (fp->fp, "210\n%f\n", point->extr_x0);
-                fprintf (fp->fp, "220\n%f\n", point->extr_y0);
-                fprintf (fp->fp, "230\n%f\n", point->extr_z0);
+                dxf_write_double (fp, 210, point->extr_x0);
+                dxf_write_double (fp, 220, point->extr_y0);
+                dxf_write_double (fp, 230, point->extr_z0);
         }
-        fprintf (fp->fp, " 50\n%f\n", point->angle_to_X);
+        dxf_write_double (fp, 50, point->angle_to_X);
         /* Clean up. */
-        free (dxf_entity_name);
+        dxf_free (dxf_entity_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -556,11 +522,10 @@ dxf_point_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (point->linetype);
-        free (point->layer);
-        free (point->dictionary_owner_soft);
-        free (point->dictionary_owner_hard);
-        free (point);
+        dxf_graphic_properties_free (point->properties);
+        dxf_free (point->dictionary_owner_soft);
+        dxf_free (point->dictionary_owner_hard);
+        dxf_free (point);
         point = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -580,7 +545,7 @@ dxf_point_free_chain
                 /*!< a pointer to the chain of DXF \c POINT entities. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (points == NULL)
@@ -606,7 +571,7 @@ dxf_point_free_chain
  *
  * \return \c id_code.
  */
-int
+long
 dxf_point_get_id_code
 (
         DxfPoint *point
@@ -652,7 +617,7 @@ dxf_point_set_id_code
 (
         DxfPoint *point,
                 /*!< a pointer to a DXF \c POINT entity. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -709,14 +674,14 @@ dxf_point_get_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        if (point->linetype ==  NULL)
+        if (point->properties->linetype ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the linetype member.\n")),
                   __FUNCTION__);
                 return (NULL);
         }
-        result = strdup (point->linetype);
+        result = dxf_strdup (point->properties->linetype);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -757,7 +722,12 @@ dxf_point_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        point->linetype = strdup (linetype);
+        if (dxf_graphic_properties_unshare (&point->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (point->properties->linetype);
+        point->properties->linetype = dxf_strdup (linetype);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -790,14 +760,14 @@ dxf_point_get_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        if (point->layer ==  NULL)
+        if (point->properties->layer ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the layer member.\n")),
                   __FUNCTION__);
                 return (NULL);
         }
-        result = strdup (point->layer);
+        result = dxf_strdup (point->properties->layer);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -838,7 +808,12 @@ dxf_point_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        point->layer = strdup (layer);
+        if (dxf_graphic_properties_unshare (&point->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (point->properties->layer);
+        point->properties->layer = dxf_strdup (layer);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -871,7 +846,7 @@ dxf_point_get_elevation
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        result = point->elevation;
+        result = point->properties->elevation;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -905,7 +880,11 @@ dxf_point_set_elevation
                   __FUNCTION__);
                 return (NULL);
         }
-        point->elevation = elevation;
+        if (dxf_graphic_properties_unshare (&point->properties) == NULL)
+        {
+                return (NULL);
+        }
+        point->properties->elevation = elevation;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -938,14 +917,14 @@ dxf_point_get_thickness
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (point->thickness < 0.0)
+        if (point->properties->thickness < 0.0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found in the thickness member.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        result = point->thickness;
+        result = point->properties->thickness;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -986,7 +965,11 @@ dxf_point_set_thickness
                   __FUNCTION__);
                 return (NULL);
         }
-        point->thickness = thickness;
+        if (dxf_graphic_properties_unshare (&point->properties) == NULL)
+        {
+                return (NULL);
+        }
+        point->properties->thickness = thickness;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1019,14 +1002,14 @@ dxf_point_get_linetype_scale
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (point->linetype_scale < 0.0)
+        if (point->properties->linetype_scale < 0.0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found in the linetype scale member.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        result = point->linetype_scale;
+        result = point->properties->linetype_scale;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1067,7 +1050,11 @@ dxf_point_set_linetype_scale
                   __FUNCTION__);
                 return (NULL);
         }
-        point->linetype_scale = linetype_scale;
+        if (dxf_graphic_properties_unshare (&point->properties) == NULL)
+        {
+                return (NULL);
+        }
+        point->properties->linetype_scale = linetype_scale;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1100,21 +1087,21 @@ dxf_point_get_visibility
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (point->visibility < 0)
+        if (point->properties->visibility < 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found in the visibility member.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (point->visibility > 1)
+        if (point->properties->visibility > 1)
         {
                 fprintf (stderr,
                   (_("Error in %s () an out of range value was found in the visibility member.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        result = point->visibility;
+        result = point->properties->visibility;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1162,7 +1149,11 @@ dxf_point_set_visibility
                   __FUNCTION__);
                 return (NULL);
         }
-        point->visibility = visibility;
+        if (dxf_graphic_properties_unshare (&point->properties) == NULL)
+        {
+                return (NULL);
+        }
+        point->properties->visibility = visibility;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1195,13 +1186,13 @@ dxf_point_get_color
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (point->color < 0)
+        if (point->properties->color < 0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found in the color member.\n")),
                   __FUNCTION__);
         }
-        result = point->color;
+        result = point->properties->color;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1243,7 +1234,11 @@ dxf_point_set_color
                 fprintf (stderr,
                   (_("\teffectively turning this entity it's visibility off.\n")));
         }
-        point->color = color;
+        if (dxf_graphic_properties_unshare (&point->properties) == NULL)
+        {
+                return (NULL);
+        }
+        point->properties->color = color;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1276,19 +1271,19 @@ dxf_point_get_paperspace
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (point->paperspace < 0)
+        if (point->properties->paperspace < 0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found in the paperspace member.\n")),
                   __FUNCTION__);
         }
-        if (point->paperspace > 1)
+        if (point->properties->paperspace > 1)
         {
                 fprintf (stderr,
                   (_("Warning in %s () an out of range value was found in the paperspace member.\n")),
                   __FUNCTION__);
         }
-        result = point->paperspace;
+        result = point->properties->paperspace;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1336,7 +1331,11 @@ dxf_point_set_paperspace
                   __FUNCTION__);
                 return (NULL);
         }
-        point->paperspace = paperspace;
+        if (dxf_graphic_properties_unshare (&point->properties) == NULL)
+        {
+                return (NULL);
+        }
+        point->properties->paperspace = paperspace;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1465,21 +1464,21 @@ dxf_point_get_shadow_mode
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (point->shadow_mode < 0)
+        if (point->properties->shadow_mode < 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found in the shadow_mode member.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (point->shadow_mode > 3)
+        if (point->properties->shadow_mode > 3)
         {
                 fprintf (stderr,
                   (_("Error in %s () an out of range value was found in the shadow_mode member.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        result = point->shadow_mode;
+        result = point->properties->shadow_mode;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1527,7 +1526,11 @@ dxf_point_set_shadow_mode
                   __FUNCTION__);
                 return (NULL);
         }
-        point->shadow_mode = shadow_mode;
+        if (dxf_graphic_properties_unshare (&point->properties) == NULL)
+        {
+                return (NULL);
+        }
+        point->properties->shadow_mode = shadow_mode;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1657,7 +1660,7 @@ dxf_point_get_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        result = strdup (point->dictionary_owner_soft);
+        result = dxf_strdup (point->dictionary_owner_soft);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1700,7 +1703,7 @@ dxf_point_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        point->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        point->dictionary_owner_soft = dxf_strdup (dictionary_owner_soft);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1736,14 +1739,14 @@ dxf_point_get_material
                   __FUNCTION__);
                 return (NULL);
         }
-        if (point->material ==  NULL)
+        if (point->properties->material ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the material member.\n")),
                   __FUNCTION__);
                 return (NULL);
         }
-        result = strdup (point->material);
+        result = dxf_strdup (point->properties->material);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1785,7 +1788,12 @@ dxf_point_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        point->material = strdup (material);
+        if (dxf_graphic_properties_unshare (&point->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (point->properties->material);
+        point->properties->material = dxf_strdup (material);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1828,7 +1836,7 @@ dxf_point_get_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        result = strdup (point->dictionary_owner_hard);
+        result = dxf_strdup (point->dictionary_owner_hard);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1871,7 +1879,7 @@ dxf_point_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        point->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        point->dictionary_owner_hard = dxf_strdup (dictionary_owner_hard);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1905,7 +1913,7 @@ dxf_point_get_lineweight
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        result = point->lineweight;
+        result = point->properties->lineweight;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1939,7 +1947,11 @@ dxf_point_set_lineweight
                   __FUNCTION__);
                 return (NULL);
         }
-        point->lineweight = lineweight;
+        if (dxf_graphic_properties_unshare (&point->properties) == NULL)
+        {
+                return (NULL);
+        }
+        point->properties->lineweight = lineweight;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1973,14 +1985,14 @@ dxf_point_get_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        if (point->plot_style_name ==  NULL)
+        if (point->properties->plot_style_name ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the plot_style_name member.\n")),
                   __FUNCTION__);
                 return (NULL);
         }
-        result = strdup (point->plot_style_name);
+        result = dxf_strdup (point->properties->plot_style_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2022,7 +2034,12 @@ dxf_point_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        point->plot_style_name = strdup (plot_style_name);
+        if (dxf_graphic_properties_unshare (&point->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (point->properties->plot_style_name);
+        point->properties->plot_style_name = dxf_strdup (plot_style_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2056,7 +2073,7 @@ dxf_point_get_color_value
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        result = point->color_value;
+        result = point->properties->color_value;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2090,7 +2107,11 @@ dxf_point_set_color_value
                   __FUNCTION__);
                 return (NULL);
         }
-        point->color_value = color_value;
+        if (dxf_graphic_properties_unshare (&point->properties) == NULL)
+        {
+                return (NULL);
+        }
+        point->properties->color_value = color_value;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2124,14 +2145,14 @@ dxf_point_get_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        if (point->color_name ==  NULL)
+        if (point->properties->color_name ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the color_name member.\n")),
                   __FUNCTION__);
                 return (NULL);
         }
-        result = strdup (point->color_name);
+        result = dxf_strdup (point->properties->color_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2173,7 +2194,12 @@ dxf_point_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        point->color_name = strdup (color_name);
+        if (dxf_graphic_properties_unshare (&point->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (point->properties->color_name);
+        point->properties->color_name = dxf_strdup (color_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2207,7 +2233,7 @@ dxf_point_get_transparency
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        result = point->transparency;
+        result = point->properties->transparency;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2241,7 +2267,11 @@ dxf_point_set_transparency
                   __FUNCTION__);
                 return (NULL);
         }
-        point->transparency = transparency;
+        if (dxf_graphic_properties_unshare (&point->properties) == NULL)
+        {
+                return (NULL);
+        }
+        point->properties->transparency = transparency;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2535,7 +2565,7 @@ dxf_point_get_extrusion_vector_as_point
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         DxfPoint *result = NULL;
@@ -2606,6 +2636,50 @@ dxf_point_set_extrusion_vector
 }
 
 
+/*!
+ * \brief Allocate a \c POINT entity at the position \c vec3.
+ *
+ * This is how the get functions of the entities which keep a position
+ * in a DxfVec3 return it as a DxfPoint.
+ *
+ * \return a pointer to the new \c POINT entity, to be freed with
+ * dxf_point_free (), or \c NULL when an error occurred.
+ */
+DxfPoint *
+dxf_point_new_from_vec3
+(
+        DxfVec3 *vec3
+                /*!< the position. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfPoint *point = NULL;
+
+        /* Do some basic checks. */
+        if (vec3 == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        point = dxf_point_init (dxf_point_new ());
+        if (point == NULL)
+        {
+                return (NULL);
+        }
+        point->x0 = vec3->x0;
+        point->y0 = vec3->y0;
+        point->z0 = vec3->z0;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (point);
+}
+
+
 /*!
  * \brief Get the pointer to the next \c POINT entity from a DXF 
  * \c POINT entity.
@@ -36,6 +36,7 @@
 
 
 #include "global.h"
+#include "graphic_properties.h"
 #include "binary_graphics_data.h"
 
 
@@ -44,6 +45,24 @@ extern "C" {
 #endif
 
 
+/*!
+ * \brief A position or direction in 3D space.
+ *
+ * Entities keep their geometric positions by value in a DxfVec3, a
+ * DxfPoint is a complete \c POINT entity.
+ */
+typedef struct
+dxf_vec3_struct
+{
+        double x0;
+                /*!< X-value. */
+        double y0;
+                /*!< Y-value. */
+        double z0;
+                /*!< Z-value. */
+} DxfVec3;
+
+
 /*!
  * \brief DXF definition of an AutoCAD point entity.
  *
@@ -69,60 +88,22 @@ typedef struct
 dxf_point_struct
 {
         /* Members common for all DXF drawable entities. */
-        int id_code;
+        long id_code;
                 /*!< group code = 5\n
                  * Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
-        char *linetype;
-                /*!< group code = 6\n
-                 * The linetype of the entity.\n
-                 * Defaults to \c BYLAYER if ommitted in the DXF file. */
-        char *layer;
-                /*!< group code = 8\n
-                 * Layer on which the entity is drawn.\n
-                 * Defaults to layer "0" if no valid layername is given. */
-        double elevation;
-                /*!< group code = 38\n
-                 * Elevation of the arc in the local Z-direction.\n
-                 * Defaults to 0.0 if omitted in the DXF file, or prior
-                 * to DXF version R12, or DXF_FLATLAND equals 0 (default). */
-        double thickness;
-                /*!< group code = 39\n
-                 * Thickness of the arc in the local Z-direction.\n
-                 * Defaults to 0.0 if ommitted in the DXF file. */
-        double linetype_scale;
-                /*!< group code = 48\n
-                 * Linetype scale (optional). */
-        int16_t visibility;
-                /*!< group code = 60\n
-                 * Object visibility (optional): 0 = Visible; 1 = Invisible. */
-        int color;
-                /*!< group code = 62\n
-                 * Color of the entity.\n
-                 * Defaults to \c BYLAYER if ommitted in the DXF file.\n
-                 * Note that entities encapsulated in a block with the
-                 * color \c BYBLOCK are represented in the "native" color of
-                 * the \c BLOCK entity. */
-        int paperspace;
-                /*!< group code = 67\n
-                 * Entities are to be drawn on either \c PAPERSPACE or
-                 * \c MODELSPACE.\n
-                 * Optional, defaults to \c DXF_MODELSPACE (0). */
+        DxfGraphicProperties *properties;
+                /*!< Linetype, layer, color and the other graphic
+                 * properties, shared with the entities which have
+                 * the same (see graphic_properties.h).\n
+                 * Group codes = 6, 8, 38, 39, 48, 60, 62, 67, 284,
+                 * 347, 370, 390, 420, 430 and 440. */
         int graphics_data_size;
                 /*!< Number of bytes in the proxy entity graphics
                  * represented in the sub-sequent 310 groups, which are
                  * binary chunk records (optional).\n
                  * Group code = 92. */
-        int16_t shadow_mode;
-                /*!< Shadow mode:\n
-                 * <ol>
-                 * <li value = "0"> Casts and receives shadows.</li>
-                 * <li value = "1"> Casts shadows.</li>
-                 * <li value = "2"> Receives shadows.</li>
-                 * <li value = "3"> Ignores shadows.</li>
-                 * </ol>\n
-                 * Group code = 284. */
         DxfBinaryGraphicsData *binary_graphics_data;
                 /*!< Proxy entity graphics data.\n
                  * Multiple lines of 256 characters maximum per line
@@ -131,45 +112,9 @@ dxf_point_struct
         char *dictionary_owner_soft;
                 /*!< group code = 330\n
                  * Soft-pointer ID/handle to owner dictionary (optional). */
-        char *material;
-                /*!< Hard-pointer ID/handle to material object (present if
-                 * not BYLAYER).\n
-                 * Group code = 347. */
         char *dictionary_owner_hard;
                 /*!< group code = 360\n
                  * Hard owner ID/handle to owner dictionary (optional). */
-        int16_t lineweight;
-                /*!< Lineweight enum value.\n
-                 * Stored and moved around as a 16-bit integer.\n
-                 * Group code = 370. */
-        char *plot_style_name;
-                /*!< Hard pointer ID / handle of PlotStyleName object.\n
-                 * Group code = 390. */
-        long color_value;
-                /*!< A 24-bit color value that should be dealt with in
-                 * terms of bytes with values of 0 to 255.\n
-                 * The lowest byte is the blue value, the middle byte is
-                 * the green value, and the third byte is the red value.\n
-                 * The top byte is always 0.\n
-                 * The group code cannot be used by custom entities for
-                 * their own data because the group code is reserved for
-                 * AcDbEntity, class-level color data and AcDbEntity,
-                 * class-level transparency data.\n
-                 * Group code = 420. */
-        char *color_name;
-                /*!< Color name.\n
-                 * The group code cannot be used by custom entities for
-                 * their own data because the group code is reserved for
-                 * AcDbEntity, class-level color data and AcDbEntity,
-                 * class-level transparency data.\n
-                 * Group code = 430. */
-        long transparency;
-                /*!< Transparency value.\n
-                 * The group code cannot be used by custom entities for
-                 * their own data because the group code is reserved for
-                 * AcDbEntity, class-level color data and AcDbEntity,
-                 * class-level transparency data.\n
-                 * Group code = 440. */
         /* Specific members for a DXF point. */
         double x0;
                 /*!< group code = 10. */
@@ -229,7 +174,7 @@ dxf_point_free_chain
 (
         DxfPoint *points
 );
-int
+long
 dxf_point_get_id_code
 (
         DxfPoint *point
@@ -238,7 +183,7 @@ DxfPoint *
 dxf_point_set_id_code
 (
         DxfPoint *point,
-        int id_code
+        long id_code
 );
 char *
 dxf_point_get_linetype
@@ -507,6 +452,11 @@ dxf_point_set_extrusion_vector
         double extr_z0
 );
 DxfPoint *
+dxf_point_new_from_vec3
+(
+        DxfVec3 *vec3
+);
+DxfPoint *
 dxf_point_get_next
 (
         DxfPoint *point
@@ -40,6 +40,9 @@
 
 
 #include "polyline.h"
+#include "arena.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -59,7 +62,7 @@ dxf_polyline_new ()
         size = sizeof (DxfPolyline);
         /* avoid malloc of 0 bytes */
         if (size == 0) size = 1;
-        if ((polyline = malloc (size)) == NULL)
+        if ((polyline = dxf_malloc (size)) == NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () could not allocate memory for a DxfArc struct.\n")),
@@ -109,27 +112,11 @@ dxf_polyline_init
               return (NULL);
         }
         dxf_polyline_set_id_code (polyline, 0);
-        dxf_polyline_set_linetype (polyline, strdup (DXF_DEFAULT_LINETYPE));
-        dxf_polyline_set_layer (polyline, strdup (DXF_DEFAULT_LAYER));
-        dxf_polyline_set_elevation (polyline, 0.0);
-        dxf_polyline_set_thickness (polyline, 0.0);
-        dxf_polyline_set_linetype_scale (polyline, DXF_DEFAULT_LINETYPE_SCALE);
-        dxf_polyline_set_visibility (polyline, DXF_DEFAULT_VISIBILITY);
-        dxf_polyline_set_color (polyline, DXF_COLOR_BYLAYER);
-        dxf_polyline_set_paperspace (polyline, DXF_MODELSPACE);
+        polyline->properties = dxf_graphic_properties_default ();
         dxf_polyline_set_graphics_data_size (polyline, 0);
-        dxf_polyline_set_shadow_mode (polyline, 0);
         dxf_polyline_set_binary_graphics_data (polyline, (DxfBinaryGraphicsData *) dxf_binary_graphics_data_new ());
-        dxf_polyline_set_dictionary_owner_soft (polyline, strdup (""));
-        dxf_polyline_set_material (polyline, strdup (""));
-        dxf_polyline_set_dictionary_owner_hard (polyline, strdup (""));
-        dxf_polyline_set_lineweight (polyline, 0);
-        dxf_polyline_set_plot_style_name (polyline, strdup (""));
-        dxf_polyline_set_color_value (polyline, 0);
-        dxf_polyline_set_color_name (polyline, strdup (""));
-        dxf_polyline_set_transparency (polyline, 0);
-        dxf_polyline_set_p0 (polyline, (DxfPoint *) dxf_point_new ());
-        dxf_point_init ((DxfPoint *) dxf_polyline_get_p0 (polyline));
+        dxf_polyline_set_dictionary_owner_soft (polyline, "");
+        dxf_polyline_set_dictionary_owner_hard (polyline, "");
         dxf_polyline_set_x0 (polyline, 0.0);
         dxf_polyline_set_y0 (polyline, 0.0);
         dxf_polyline_set_z0 (polyline, 0.0);
@@ -145,8 +132,8 @@ dxf_polyline_init
         dxf_polyline_set_extr_x0 (polyline, 0.0);
         dxf_polyline_set_extr_y0 (polyline, 0.0);
         dxf_polyline_set_extr_z0 (polyline, 0.0);
-        dxf_polyline_set_vertices (polyline, (DxfVertex *) dxf_vertex_new ());
-        dxf_vertex_init ((DxfVertex *) dxf_polyline_get_vertices (polyline));
+        dxf_vertex_array_init (&polyline->packed_vertices, 3);
+        polyline->vertices = NULL;
         dxf_polyline_set_next (polyline, NULL);
 #if DEBUG
         DXF_DEBUG_END
@@ -156,6 +143,95 @@ dxf_polyline_init
 
 
 
+/*!
+ * \brief Read the \c VERTEX entities and the \c SEQEND entity following
+ * a 2D or 3D polyline into the packed vertices of \c polyline.
+ *
+ * The handles, layers and other members of a \c VERTEX which are not
+ * kept in a DxfVertexArray are skipped.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_polyline_read_vertices
+(
+        DxfFile *fp,
+                /*!< DXF file pointer to an input file (or device). */
+        DxfPolyline *polyline
+                /*!< a pointer to the DXF polyline entity. */
+)
+{
+        DxfVertexArray *vertices = &polyline->packed_vertices;
+        DxfPair pair;
+        int index = -1;
+        int seqend = FALSE;
+
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
+        {
+                if (pair.group_code == 0)
+                {
+                        if (!seqend && dxf_pair_value_is (&pair, "VERTEX"))
+                        {
+                                index = dxf_vertex_array_append (vertices,
+                                  0.0, 0.0, 0.0, 0.0);
+                                if (index < 0)
+                                {
+                                        return (EXIT_FAILURE);
+                                }
+                                continue;
+                        }
+                        if (!seqend && dxf_pair_value_is (&pair, "SEQEND"))
+                        {
+                                seqend = TRUE;
+                                index = -1;
+                                continue;
+                        }
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
+                }
+                if (index < 0)
+                {
+                        continue;
+                }
+                switch (pair.group_code)
+                {
+                        case 10:
+                                vertices->x0[index] = dxf_pair_get_double (&pair);
+                                break;
+                        case 20:
+                                vertices->y0[index] = dxf_pair_get_double (&pair);
+                                break;
+                        case 30:
+                                vertices->z0[index] = dxf_pair_get_double (&pair);
+                                break;
+                        case 40:
+                                dxf_vertex_array_set_widths (vertices, index,
+                                  dxf_pair_get_double (&pair),
+                                  (vertices->end_width != NULL) ? vertices->end_width[index] : 0.0);
+                                break;
+                        case 41:
+                                dxf_vertex_array_set_widths (vertices, index,
+                                  (vertices->start_width != NULL) ? vertices->start_width[index] : 0.0,
+                                  dxf_pair_get_double (&pair));
+                                break;
+                        case 42:
+                                vertices->bulge[index] = dxf_pair_get_double (&pair);
+                                break;
+                        case 70:
+                                dxf_vertex_array_set_flag (vertices, index,
+                                  dxf_pair_get_int (&pair));
+                                break;
+                        default:
+                                break;
+                }
+        }
+        return (EXIT_SUCCESS);
+}
+
+
 /*!
  * \brief Read data from a DXF file into an \c POLYLINE entity.
  *
@@ -180,7 +256,9 @@ dxf_polyline_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfGraphicProperties properties;
+        DxfPair pair;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -188,8 +266,6 @@ dxf_polyline_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (polyline == NULL)
@@ -200,236 +276,191 @@ dxf_polyline_read
                 polyline = dxf_polyline_new ();
                 polyline = dxf_polyline_init (polyline);
         }
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        dxf_graphic_properties_start (&properties, polyline->properties);
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        fclose (fp->fp);
-                        /* Clean up. */
-                        free (temp_string);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &polyline->id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", polyline->linetype);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", polyline->layer);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the primary point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &polyline->p0->x0);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the primary point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &polyline->p0->y0);
-                }
-                else if (strcmp (temp_string, "30") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the primary point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &polyline->p0->z0);
-                }
-                else if (strcmp (temp_string, "38") == 0)
-                {
-                        /* Now follows a string containing the
-                         * elevation. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &polyline->elevation);
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &polyline->thickness);
-                }
-                else if (strcmp (temp_string, "40") == 0)
-                {
-                        /* Now follows a string containing the
-                         * starting width. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &polyline->start_width);
-                }
-                else if (strcmp (temp_string, "41") == 0)
-                {
-                        /* Now follows a string containing the
-                         * end width. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &polyline->end_width);
-                }
-                else if (strcmp (temp_string, "48") == 0)
-                {
-                        /* Now follows a string containing the linetype
-                         * scale. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &polyline->linetype_scale);
-                }
-                else if (strcmp (temp_string, "60") == 0)
-                {
-                        /* Now follows a string containing the
-                         * visibility value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &polyline->visibility);
-                }
-                else if (strcmp (temp_string, "62") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &polyline->color);
-                }
-                else if (strcmp (temp_string, "66") == 0)
-                {
-                        /* Now follows a string containing the
-                         * vertces follow flag. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &polyline->vertices_follow);
-                }
-                else if (strcmp (temp_string, "67") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &polyline->paperspace);
-                }
-                else if (strcmp (temp_string, "70") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing the
-                         * flag value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &polyline->flag);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else if (strcmp (temp_string, "71") == 0)
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing the polygon
-                         * mesh M vertex count value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &polyline->polygon_mesh_M_vertex_count);
-                }
-                else if (strcmp (temp_string, "72") == 0)
-                {
-                        /* Now follows a string containing the polygon
-                         * mesh N vertex count value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &polyline->polygon_mesh_N_vertex_count);
-                }
-                else if (strcmp (temp_string, "73") == 0)
-                {
-                        /* Now follows a string containing the smooth M
-                         * surface density value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &polyline->smooth_M_surface_density);
-                }
-                else if (strcmp (temp_string, "74") == 0)
-                {
-                        /* Now follows a string containing the smooth N
-                         * surface density value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &polyline->smooth_M_surface_density);
-                }
-                else if (strcmp (temp_string, "75") == 0)
-                {
-                        /* Now follows a string containing the surface
-                         * type value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &polyline->surface_type);
-                }
-                else if (strcmp (temp_string, "100") == 0)
-                {
-                        /* Subclass markers are post AutoCAD R12
-                         * variable so additional testing for the
-                         * version should probably be added here.
-                         * Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                }
-                else if (strcmp (temp_string, "210") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &polyline->extr_x0);
-                }
-                else if (strcmp (temp_string, "220") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &polyline->extr_y0);
-                }
-                else if (strcmp (temp_string, "230") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &polyline->extr_z0);
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", polyline->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", polyline->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                polyline->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 6:
+                                /* Now follows a string containing a linetype
+                                 * name. */
+                                dxf_lexer_free_string (fp, properties.linetype);
+                                properties.linetype = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 8:
+                                /* Now follows a string containing a layer name. */
+                                dxf_lexer_free_string (fp, properties.layer);
+                                properties.layer = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 10:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the primary point. */
+                                polyline->p0.x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 20:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the primary point. */
+                                polyline->p0.y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 30:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the primary point. */
+                                polyline->p0.z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 38:
+                                /* Now follows a string containing the
+                                 * elevation. */
+                                properties.elevation = dxf_pair_get_double (&pair);
+                                break;
+                        case 39:
+                                /* Now follows a string containing the
+                                 * thickness. */
+                                properties.thickness = dxf_pair_get_double (&pair);
+                                break;
+                        case 40:
+                                /* Now follows a string containing the
+                                 * starting width. */
+                                polyline->start_width = dxf_pair_get_double (&pair);
+                                break;
+                        case 41:
+                                /* Now follows a string containing the
+                                 * end width. */
+                                polyline->end_width = dxf_pair_get_double (&pair);
+                                break;
+                        case 48:
+                                /* Now follows a string containing the linetype
+                                 * scale. */
+                                properties.linetype_scale = dxf_pair_get_double (&pair);
+                                break;
+                        case 60:
+                                /* Now follows a string containing the
+                                 * visibility value. */
+                                properties.visibility = dxf_pair_get_int (&pair);
+                                break;
+                        case 62:
+                                /* Now follows a string containing the
+                                 * color value. */
+                                properties.color = dxf_pair_get_int (&pair);
+                                break;
+                        case 66:
+                                /* Now follows a string containing the
+                                 * vertces follow flag. */
+                                polyline->vertices_follow = dxf_pair_get_int (&pair);
+                                break;
+                        case 67:
+                                /* Now follows a string containing the
+                                 * paperspace value. */
+                                properties.paperspace = dxf_pair_get_int (&pair);
+                                break;
+                        case 70:
+                                /* Now follows a string containing the
+                                 * flag value. */
+                                polyline->flag = dxf_pair_get_int (&pair);
+                                break;
+                        case 71:
+                                /* Now follows a string containing the polygon
+                                 * mesh M vertex count value. */
+                                polyline->polygon_mesh_M_vertex_count = dxf_pair_get_int (&pair);
+                                break;
+                        case 72:
+                                /* Now follows a string containing the polygon
+                                 * mesh N vertex count value. */
+                                polyline->polygon_mesh_N_vertex_count = dxf_pair_get_int (&pair);
+                                break;
+                        case 73:
+                                /* Now follows a string containing the smooth M
+                                 * surface density value. */
+                                polyline->smooth_M_surface_density = dxf_pair_get_int (&pair);
+                                break;
+                        case 74:
+                                /* Now follows a string containing the smooth N
+                                 * surface density value. */
+                                polyline->smooth_M_surface_density = dxf_pair_get_int (&pair);
+                                break;
+                        case 75:
+                                /* Now follows a string containing the surface
+                                 * type value. */
+                                polyline->surface_type = dxf_pair_get_int (&pair);
+                                break;
+                        case 100:
+                                /* Subclass markers are post AutoCAD R12
+                                 * variable so additional testing for the
+                                 * version should probably be added here.
+                                 * Now follows a string containing the
+                                 * subclass marker value. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                break;
+                        case 210:
+                                /* Now follows a string containing the
+                                 * X-value of the extrusion vector. */
+                                polyline->extr_x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 220:
+                                /* Now follows a string containing the
+                                 * Y-value of the extrusion vector. */
+                                polyline->extr_y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 230:
+                                /* Now follows a string containing the
+                                 * Z-value of the extrusion vector. */
+                                polyline->extr_z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, polyline->dictionary_owner_soft);
+                                polyline->dictionary_owner_soft = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, polyline->dictionary_owner_hard);
+                                polyline->dictionary_owner_hard = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, "DXF comment: %s\n", temp_string);
+                                break;
+                        default:
+                                fprintf (stderr,
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
+                                  __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
+        /* The vertices of a polygon or polyface mesh are read as
+         * VERTEX entities of their own. */
+        if (((polyline->flag & (16 | 64)) == 0)
+          && (dxf_polyline_read_vertices (fp, polyline) != EXIT_SUCCESS))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+        }
         /* Handle omitted members and/or illegal values. */
-        if (strcmp (dxf_polyline_get_linetype (polyline), "") == 0)
+        if (strcmp (polyline->properties->linetype, "") == 0)
         {
-                dxf_polyline_set_linetype (polyline, strdup (DXF_DEFAULT_LINETYPE));
+                dxf_polyline_set_linetype (polyline, DXF_DEFAULT_LINETYPE);
         }
-        if (strcmp (dxf_polyline_get_layer (polyline), "") == 0)
+        if (strcmp (polyline->properties->layer, "") == 0)
         {
-                dxf_polyline_set_layer (polyline, strdup (DXF_DEFAULT_LAYER));
+                dxf_polyline_set_layer (polyline, DXF_DEFAULT_LAYER);
         }
-        /* Clean up. */
-        free (temp_string);
+        /* Entities with equal properties share a record. */
+        dxf_graphic_properties_finish (fp, &polyline->properties, &properties);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -455,8 +486,10 @@ dxf_polyline_write
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *dxf_entity_name = strdup ("POLYLINE");
+        char *dxf_entity_name = dxf_strdup ("POLYLINE");
         DxfVertex *iter = NULL;
+        DxfVertexArray *vertices = NULL;
+        int i;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -465,7 +498,7 @@ dxf_polyline_write
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (polyline == NULL)
@@ -474,61 +507,61 @@ dxf_polyline_write
                   (_("Error in %s () a NULL pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (dxf_polyline_get_x0 (polyline) != 0.0)
         {
                 fprintf (stderr,
-                  (_("Error in %s () start point has an invalid X-value for the %s entity with id-code: %x\n")),
+                  (_("Error in %s () start point has an invalid X-value for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_polyline_get_id_code (polyline));
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (dxf_polyline_get_y0 (polyline) != 0.0)
         {
                 fprintf (stderr,
-                  (_("Error in %s () start point has an invalid Y-value for the %s entity with id-code: %x\n")),
+                  (_("Error in %s () start point has an invalid Y-value for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_polyline_get_id_code (polyline));
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (dxf_polyline_get_vertices_follow (polyline) != 1)
         {
                 fprintf (stderr,
-                  (_("Error in %s () vertices follow flag has an invalid value for the %s entity with id-code: %x\n")),
+                  (_("Error in %s () vertices follow flag has an invalid value for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_polyline_get_id_code (polyline));
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (strcmp (dxf_polyline_get_linetype (polyline), "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_polyline_get_id_code (polyline));
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                dxf_polyline_set_linetype (polyline, strdup (DXF_DEFAULT_LINETYPE));
+                dxf_polyline_set_linetype (polyline, DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (dxf_polyline_get_layer (polyline), "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty layer string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty layer string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, dxf_polyline_get_id_code (polyline));
                 fprintf (stderr,
                   (_("\t%s entity is relocated to layer 0\n")),
                   dxf_entity_name);
-                dxf_polyline_set_layer (polyline, strdup (DXF_DEFAULT_LAYER));
+                dxf_polyline_set_layer (polyline, DXF_DEFAULT_LAYER);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
-        if (dxf_polyline_get_id_code (polyline) != -1)
+        dxf_write_string (fp, 0, dxf_entity_name);
+        if (polyline->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", dxf_polyline_get_id_code (polyline));
+                dxf_write_hex (fp, 5, dxf_polyline_get_id_code (polyline));
         }
         /*!
          * \todo for version R14.\n
@@ -543,96 +576,146 @@ dxf_polyline_write
         if ((strcmp (polyline->dictionary_owner_soft, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", dxf_polyline_get_dictionary_owner_soft (polyline));
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, dxf_polyline_get_dictionary_owner_soft (polyline));
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (polyline->dictionary_owner_hard, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", dxf_polyline_get_dictionary_owner_hard (polyline));
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, dxf_polyline_get_dictionary_owner_hard (polyline));
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbEntity\n");
+                dxf_write_string (fp, 100, "AcDbEntity");
         }
         if (dxf_polyline_get_paperspace (polyline) == DXF_PAPERSPACE)
         {
-                fprintf (fp->fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_int (fp, 67, DXF_PAPERSPACE);
         }
-        fprintf (fp->fp, "  8\n%s\n", dxf_polyline_get_layer (polyline));
+        dxf_write_string (fp, 8, dxf_polyline_get_layer (polyline));
         if (strcmp (dxf_polyline_get_linetype (polyline), DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp->fp, "  6\n%s\n", dxf_polyline_get_linetype (polyline));
+                dxf_write_string (fp, 6, dxf_polyline_get_linetype (polyline));
         }
         if ((fp->acad_version_number <= AutoCAD_11)
           && DXF_FLATLAND
           && (dxf_polyline_get_elevation (polyline) != 0.0))
         {
-                fprintf (fp->fp, " 38\n%f\n", dxf_polyline_get_elevation (polyline));
+                dxf_write_double (fp, 38, dxf_polyline_get_elevation (polyline));
         }
         if (dxf_polyline_get_color (polyline) != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp->fp, " 62\n%d\n", dxf_polyline_get_color (polyline));
+                dxf_write_int (fp, 62, dxf_polyline_get_color (polyline));
         }
         if (dxf_polyline_get_linetype_scale (polyline) != 1.0)
         {
-                fprintf (fp->fp, " 48\n%f\n", dxf_polyline_get_linetype_scale (polyline));
+                dxf_write_double (fp, 48, dxf_polyline_get_linetype_scale (polyline));
         }
         if (dxf_polyline_get_visibility (polyline) != 0)
         {
-                fprintf (fp->fp, " 60\n%d\n", dxf_polyline_get_visibility (polyline));
+                dxf_write_int (fp, 60, dxf_polyline_get_visibility (polyline));
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDb3dPolyline\n");
+                dxf_write_string (fp, 100, "AcDb3dPolyline");
         }
         if (fp->acad_version_number < AutoCAD_2002)
         {
-                fprintf (fp->fp, " 66\n%d\n", dxf_polyline_get_vertices_follow (polyline));
+                dxf_write_int (fp, 66, dxf_polyline_get_vertices_follow (polyline));
         }
-        fprintf (fp->fp, " 10\n%f\n", dxf_polyline_get_x0 (polyline));
-        fprintf (fp->fp, " 20\n%f\n", dxf_polyline_get_y0 (polyline));
-        fprintf (fp->fp, " 30\n%f\n", dxf_polyline_get_z0 (polyline));
+        dxf_write_double (fp, 10, dxf_polyline_get_x0 (polyline));
+        dxf_write_double (fp, 20, dxf_polyline_get_y0 (polyline));
+        dxf_write_double (fp, 30, dxf_polyline_get_z0 (polyline));
         if (dxf_polyline_get_thickness (polyline) != 0.0)
         {
-                fprintf (fp->fp, " 39\n%f\n", dxf_polyline_get_thickness (polyline));
+                dxf_write_double (fp, 39, dxf_polyline_get_thickness (polyline));
         }
-        fprintf (fp->fp, " 70\n%d\n", dxf_polyline_get_flag (polyline));
+        dxf_write_int (fp, 70, dxf_polyline_get_flag (polyline));
         if (dxf_polyline_get_start_width (polyline) != 0.0)
         {
-                fprintf (fp->fp, " 40\n%f\n", dxf_polyline_get_start_width (polyline));
+                dxf_write_double (fp, 40, dxf_polyline_get_start_width (polyline));
         }
         if (dxf_polyline_get_end_width (polyline) != 0.0)
         {
-                fprintf (fp->fp, " 41\n%f\n", dxf_polyline_get_end_width (polyline));
+                dxf_write_double (fp, 41, dxf_polyline_get_end_width (polyline));
         }
-        fprintf (fp->fp, " 71\n%d\n", dxf_polyline_get_polygon_mesh_M_vertex_count (polyline));
-        fprintf (fp->fp, " 72\n%d\n", dxf_polyline_get_polygon_mesh_N_vertex_count (polyline));
-        fprintf (fp->fp, " 73\n%d\n", dxf_polyline_get_smooth_M_surface_density (polyline));
-        fprintf (fp->fp, " 74\n%d\n", dxf_polyline_get_smooth_N_surface_density (polyline));
-        fprintf (fp->fp, " 75\n%d\n", dxf_polyline_get_surface_type (polyline));
+        dxf_write_int (fp, 71, dxf_polyline_get_polygon_mesh_M_vertex_count (polyline));
+        dxf_write_int (fp, 72, dxf_polyline_get_polygon_mesh_N_vertex_count (polyline));
+        dxf_write_int (fp, 73, dxf_polyline_get_smooth_M_surface_density (polyline));
+        dxf_write_int (fp, 74, dxf_polyline_get_smooth_N_surface_density (polyline));
+        dxf_write_int (fp, 75, dxf_polyline_get_surface_type (polyline));
         if ((fp->acad_version_number >= AutoCAD_12)
                 && (dxf_polyline_get_extr_x0 (polyline) != 0.0)
                 && (dxf_polyline_get_extr_y0 (polyline) != 0.0)
                 && (dxf_polyline_get_extr_z0 (polyline) != 1.0))
         {
-                fprintf (fp->fp, "210\n%f\n", dxf_polyline_get_extr_x0 (polyline));
-                fprintf (fp->fp, "220\n%f\n", dxf_polyline_get_extr_y0 (polyline));
-                fprintf (fp->fp, "230\n%f\n", dxf_polyline_get_extr_z0 (polyline));
+                dxf_write_double (fp, 210, dxf_polyline_get_extr_x0 (polyline));
+                dxf_write_double (fp, 220, dxf_polyline_get_extr_y0 (polyline));
+                dxf_write_double (fp, 230, dxf_polyline_get_extr_z0 (polyline));
         }
         /* Start of writing (multiple) vertices. */
-        iter = (DxfVertex *) dxf_polyline_get_vertices (polyline);
-        while (iter != NULL)
+        vertices = &polyline->packed_vertices;
+        if (polyline->vertices != NULL)
+        {
+                iter = (DxfVertex *) polyline->vertices;
+                while (iter != NULL)
+                {
+                        dxf_vertex_write (fp, iter);
+                        iter = (DxfVertex *) iter->next;
+                }
+        }
+        else if (vertices->count > 0)
+        {
+                /* One DxfVertex is filled and written for each of the
+                 * packed vertices. */
+                iter = dxf_vertex_init (dxf_vertex_new ());
+                if (iter == NULL)
+                {
+                        /* Clean up. */
+                        dxf_free (dxf_entity_name);
+                        return (EXIT_FAILURE);
+                }
+                iter->id_code = -1;
+                if (dxf_graphic_properties_unshare (&iter->properties) == NULL)
+                {
+                        /* Clean up. */
+                        dxf_vertex_free (iter);
+                        dxf_free (dxf_entity_name);
+                        return (EXIT_FAILURE);
+                }
+                dxf_free (iter->properties->layer);
+                iter->properties->layer = dxf_strdup (polyline->properties->layer);
+                for (i = 0; i < vertices->count; i++)
+                {
+                        iter->x0 = vertices->x0[i];
+                        iter->y0 = vertices->y0[i];
+                        iter->z0 = vertices->z0[i];
+                        iter->bulge = vertices->bulge[i];
+                        if (vertices->start_width != NULL)
+                        {
+                                iter->start_width = vertices->start_width[i];
+                                iter->end_width = vertices->end_width[i];
+                        }
+                        iter->flag = (vertices->flag != NULL) ? vertices->flag[i] : 0;
+                        dxf_vertex_write (fp, iter);
+                }
+                dxf_vertex_free (iter);
+        }
+        if ((polyline->vertices != NULL) || (vertices->count > 0))
         {
-                dxf_vertex_write (fp, iter);
-                iter = (DxfVertex *) iter->next;
+                /* End of the sequence of vertices. */
+                dxf_write_string (fp, 0, "SEQEND");
+                if (fp->acad_version_number >= AutoCAD_13)
+                {
+                        dxf_write_string (fp, 100, "AcDbEntity");
+                }
+                dxf_write_string (fp, 8, polyline->properties->layer);
         }
-        dxf_vertex_free (iter);
         /* Clean up. */
-        free (dxf_entity_name);
+        dxf_free (dxf_entity_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -665,17 +748,16 @@ dxf_polyline_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (dxf_polyline_get_linetype (polyline));
-        free (dxf_polyline_get_layer (polyline));
+        dxf_graphic_properties_free (polyline->properties);
         dxf_binary_graphics_data_free_chain (dxf_polyline_get_binary_graphics_data (polyline));
-        free (dxf_polyline_get_dictionary_owner_soft (polyline));
-        free (dxf_polyline_get_material (polyline));
-        free (dxf_polyline_get_dictionary_owner_hard (polyline));
-        free (dxf_polyline_get_plot_style_name (polyline));
-        free (dxf_polyline_get_color_name (polyline));
-        dxf_point_free (dxf_polyline_get_p0 (polyline));
-        dxf_vertex_free_chain (dxf_polyline_get_vertices (polyline));
-        free (polyline);
+        dxf_free (polyline->dictionary_owner_soft);
+        dxf_free (polyline->dictionary_owner_hard);
+        dxf_vertex_array_free (&polyline->packed_vertices);
+        if (polyline->vertices != NULL)
+        {
+                dxf_vertex_free_chain ((DxfVertex *) polyline->vertices);
+        }
+        dxf_free (polyline);
         polyline = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -695,7 +777,7 @@ dxf_polyline_free_chain
                 /*!< a pointer to the chain of DXF \c POLYLINE entities. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (polylines == NULL)
@@ -721,7 +803,7 @@ dxf_polyline_free_chain
  *
  * \return \c id_code.
  */
-int
+long
 dxf_polyline_get_id_code
 (
         DxfPolyline *polyline
@@ -763,7 +845,7 @@ dxf_polyline_set_id_code
 (
         DxfPolyline *polyline,
                 /*!< a pointer to a DXF \c POLYLINE entity. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -818,7 +900,7 @@ dxf_polyline_get_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        if (polyline->linetype ==  NULL)
+        if (polyline->properties->linetype ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the linetype member.\n")),
@@ -828,7 +910,7 @@ dxf_polyline_get_linetype
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (polyline->linetype));
+        return (dxf_strdup (polyline->properties->linetype));
 }
 
 
@@ -868,7 +950,12 @@ dxf_polyline_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        polyline->linetype = strdup (linetype);
+        if (dxf_graphic_properties_unshare (&polyline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (polyline->properties->linetype);
+        polyline->properties->linetype = dxf_strdup (linetype);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -900,7 +987,7 @@ dxf_polyline_get_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        if (polyline->layer ==  NULL)
+        if (polyline->properties->layer ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the layer member.\n")),
@@ -910,7 +997,7 @@ dxf_polyline_get_layer
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (polyline->layer));
+        return (dxf_strdup (polyline->properties->layer));
 }
 
 
@@ -949,7 +1036,12 @@ dxf_polyline_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        polyline->layer = strdup (layer);
+        if (dxf_graphic_properties_unshare (&polyline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (polyline->properties->layer);
+        polyline->properties->layer = dxf_strdup (layer);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -983,7 +1075,7 @@ dxf_polyline_get_elevation
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (polyline->elevation);
+        return (polyline->properties->elevation);
 }
 
 
@@ -1013,7 +1105,11 @@ dxf_polyline_set_elevation
                   __FUNCTION__);
                 return (NULL);
         }
-        polyline->elevation = elevation;
+        if (dxf_graphic_properties_unshare (&polyline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        polyline->properties->elevation = elevation;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1044,7 +1140,7 @@ dxf_polyline_get_thickness
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (polyline->thickness < 0.0)
+        if (polyline->properties->thickness < 0.0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found in the thickness member.\n")),
@@ -1053,7 +1149,7 @@ dxf_polyline_get_thickness
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (polyline->thickness);
+        return (polyline->properties->thickness);
 }
 
 
@@ -1089,7 +1185,11 @@ dxf_polyline_set_thickness
                   (_("Warning in %s () a negative thickness value was passed.\n")),
                   __FUNCTION__);
         }
-        polyline->thickness = thickness;
+        if (dxf_graphic_properties_unshare (&polyline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        polyline->properties->thickness = thickness;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1120,7 +1220,7 @@ dxf_polyline_get_linetype_scale
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (polyline->linetype_scale < 0.0)
+        if (polyline->properties->linetype_scale < 0.0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found in the linetype_scale member.\n")),
@@ -1129,7 +1229,7 @@ dxf_polyline_get_linetype_scale
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (polyline->linetype_scale);
+        return (polyline->properties->linetype_scale);
 }
 
 
@@ -1165,7 +1265,11 @@ dxf_polyline_set_linetype_scale
                   (_("Warning in %s () a negative linetype_scale value was passed.\n")),
                   __FUNCTION__);
         }
-        polyline->linetype_scale = linetype_scale;
+        if (dxf_graphic_properties_unshare (&polyline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        polyline->properties->linetype_scale = linetype_scale;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1196,14 +1300,14 @@ dxf_polyline_get_visibility
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (polyline->visibility < 0)
+        if (polyline->properties->visibility < 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found in the visibility member.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (polyline->visibility > 1)
+        if (polyline->properties->visibility > 1)
         {
                 fprintf (stderr,
                   (_("Error in %s () an out of range value was found in the visibility member.\n")),
@@ -1213,7 +1317,7 @@ dxf_polyline_get_visibility
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (polyline->visibility);
+        return (polyline->properties->visibility);
 }
 
 
@@ -1257,7 +1361,11 @@ dxf_polyline_set_visibility
                   __FUNCTION__);
                 return (NULL);
         }
-        polyline->visibility = visibility;
+        if (dxf_graphic_properties_unshare (&polyline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        polyline->properties->visibility = visibility;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1288,7 +1396,7 @@ dxf_polyline_get_color
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (polyline->color < 0)
+        if (polyline->properties->color < 0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found in the color member.\n")),
@@ -1297,7 +1405,7 @@ dxf_polyline_get_color
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (polyline->color);
+        return (polyline->properties->color);
 }
 
 
@@ -1335,7 +1443,11 @@ dxf_polyline_set_color
                 fprintf (stderr,
                   (_("\teffectively turning this entity it's visibility off.\n")));
         }
-        polyline->color = color;
+        if (dxf_graphic_properties_unshare (&polyline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        polyline->properties->color = color;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1367,13 +1479,13 @@ dxf_polyline_get_paperspace
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (polyline->paperspace < 0)
+        if (polyline->properties->paperspace < 0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found in the paperspace member.\n")),
                   __FUNCTION__);
         }
-        if (polyline->paperspace > 1)
+        if (polyline->properties->paperspace > 1)
         {
                 fprintf (stderr,
                   (_("Warning in %s () an out of range value was found in the paperspace member.\n")),
@@ -1382,7 +1494,7 @@ dxf_polyline_get_paperspace
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (polyline->paperspace);
+        return (polyline->properties->paperspace);
 }
 
 
@@ -1426,7 +1538,11 @@ dxf_polyline_set_paperspace
                   __FUNCTION__);
                 return (NULL);
         }
-        polyline->paperspace = paperspace;
+        if (dxf_graphic_properties_unshare (&polyline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        polyline->properties->paperspace = paperspace;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1551,14 +1667,14 @@ dxf_polyline_get_shadow_mode
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (polyline->shadow_mode < 0)
+        if (polyline->properties->shadow_mode < 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found in the shadow_mode member.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (polyline->shadow_mode > 3)
+        if (polyline->properties->shadow_mode > 3)
         {
                 fprintf (stderr,
                   (_("Error in %s () an out of range value was found in the shadow_mode member.\n")),
@@ -1568,7 +1684,7 @@ dxf_polyline_get_shadow_mode
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (polyline->shadow_mode);
+        return (polyline->properties->shadow_mode);
 }
 
 
@@ -1612,7 +1728,11 @@ dxf_polyline_set_shadow_mode
                   __FUNCTION__);
                 return (NULL);
         }
-        polyline->shadow_mode = shadow_mode;
+        if (dxf_graphic_properties_unshare (&polyline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        polyline->properties->shadow_mode = shadow_mode;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1736,7 +1856,7 @@ dxf_polyline_get_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (polyline->dictionary_owner_soft));
+        return (dxf_strdup (polyline->dictionary_owner_soft));
 }
 
 
@@ -1772,7 +1892,7 @@ dxf_polyline_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        polyline->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        polyline->dictionary_owner_soft = dxf_strdup (dictionary_owner_soft);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1807,7 +1927,7 @@ dxf_polyline_get_material
                   __FUNCTION__);
                 return (NULL);
         }
-        if (polyline->material ==  NULL)
+        if (polyline->properties->material ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the material member.\n")),
@@ -1817,7 +1937,7 @@ dxf_polyline_get_material
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (polyline->material));
+        return (dxf_strdup (polyline->properties->material));
 }
 
 
@@ -1856,7 +1976,12 @@ dxf_polyline_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        polyline->material = strdup (material);
+        if (dxf_graphic_properties_unshare (&polyline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (polyline->properties->material);
+        polyline->properties->material = dxf_strdup (material);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1900,7 +2025,7 @@ dxf_polyline_get_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (polyline->dictionary_owner_hard));
+        return (dxf_strdup (polyline->dictionary_owner_hard));
 }
 
 
@@ -1939,7 +2064,7 @@ dxf_polyline_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        polyline->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        polyline->dictionary_owner_hard = dxf_strdup (dictionary_owner_hard);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1974,7 +2099,7 @@ dxf_polyline_get_lineweight
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (polyline->lineweight);
+        return (polyline->properties->lineweight);
 }
 
 
@@ -2004,7 +2129,11 @@ dxf_polyline_set_lineweight
                   __FUNCTION__);
                 return (NULL);
         }
-        polyline->lineweight = lineweight;
+        if (dxf_graphic_properties_unshare (&polyline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        polyline->properties->lineweight = lineweight;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2036,7 +2165,7 @@ dxf_polyline_get_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        if (polyline->plot_style_name ==  NULL)
+        if (polyline->properties->plot_style_name ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the plot_style_name member.\n")),
@@ -2046,7 +2175,7 @@ dxf_polyline_get_plot_style_name
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (polyline->plot_style_name));
+        return (dxf_strdup (polyline->properties->plot_style_name));
 }
 
 
@@ -2084,7 +2213,12 @@ dxf_polyline_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        polyline->plot_style_name = strdup (plot_style_name);
+        if (dxf_graphic_properties_unshare (&polyline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (polyline->properties->plot_style_name);
+        polyline->properties->plot_style_name = dxf_strdup (plot_style_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2119,7 +2253,7 @@ dxf_polyline_get_color_value
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (polyline->color_value);
+        return (polyline->properties->color_value);
 }
 
 
@@ -2149,7 +2283,11 @@ dxf_polyline_set_color_value
                   __FUNCTION__);
                 return (NULL);
         }
-        polyline->color_value = color_value;
+        if (dxf_graphic_properties_unshare (&polyline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        polyline->properties->color_value = color_value;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2181,7 +2319,7 @@ dxf_polyline_get_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        if (polyline->color_name ==  NULL)
+        if (polyline->properties->color_name ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the color_name member.\n")),
@@ -2191,7 +2329,7 @@ dxf_polyline_get_color_name
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (polyline->color_name));
+        return (dxf_strdup (polyline->properties->color_name));
 }
 
 
@@ -2229,7 +2367,12 @@ dxf_polyline_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        polyline->color_name = strdup (color_name);
+        if (dxf_graphic_properties_unshare (&polyline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (polyline->properties->color_name);
+        polyline->properties->color_name = dxf_strdup (color_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2264,7 +2407,7 @@ dxf_polyline_get_transparency
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (polyline->transparency);
+        return (polyline->properties->transparency);
 }
 
 
@@ -2294,7 +2437,11 @@ dxf_polyline_set_transparency
                   __FUNCTION__);
                 return (NULL);
         }
-        polyline->transparency = transparency;
+        if (dxf_graphic_properties_unshare (&polyline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        polyline->properties->transparency = transparency;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2305,6 +2452,16 @@ dxf_polyline_set_transparency
 /*!
  * \brief Get the insertion point of a DXF \c POLYLINE entity.
  *
+ * The point is a newly allocated copy of the position kept in
+ * \c polyline, to be freed with dxf_point_free ().  Changing it does not
+ * change \c polyline.
+ *
+ * \deprecated Before the position was kept in \c polyline itself this
+ * returned the point held by \c polyline, which was freed together with it
+ * and whose changes were changes of \c polyline.  Callers relying on that
+ * leak the copy and lose their changes, use
+ * dxf_polyline_get_p0_vec3 () instead.
+ *
  * \return the insertion point \c p0.
  */
 DxfPoint *
@@ -2314,7 +2471,7 @@ dxf_polyline_get_p0
                 /*!< a pointer to a DXF \c POLYLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2325,7 +2482,34 @@ dxf_polyline_get_p0
                   __FUNCTION__);
                 return (NULL);
         }
-        if (polyline->p0 == NULL)
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (dxf_point_new_from_vec3 (&polyline->p0));
+}
+
+
+/*!
+ * \brief Get the insertion point of a DXF \c POLYLINE entity, as kept
+ * in \c polyline.
+ *
+ * Changing the position changes \c polyline.
+ *
+ * \return a pointer to the position, or \c NULL when an error
+ * occurred.
+ */
+DxfVec3 *
+dxf_polyline_get_p0_vec3
+(
+        DxfPolyline *polyline
+                /*!< a pointer to a DXF \c POLYLINE entity. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /* Do some basic checks. */
+        if (polyline == NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was passed.\n")),
@@ -2335,13 +2519,15 @@ dxf_polyline_get_p0
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (polyline->p0);
+        return (&polyline->p0);
 }
 
 
 /*!
  * \brief Set the insertion point \c p0 of a DXF \c POLYLINE entity.
  *
+ * Only the position of \c p0 is copied, the caller keeps \c p0.
+ *
  * \return a pointer to \c polyline when successful, or \c NULL when an
  * error occurred.
  */
@@ -2354,7 +2540,7 @@ dxf_polyline_set_p0
                 /*!< a pointer to a DXF \c POINT entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2372,7 +2558,9 @@ dxf_polyline_set_p0
                   __FUNCTION__);
                 return (NULL);
         }
-        polyline->p0 = (DxfPoint *) p0;
+        polyline->p0.x0 = p0->x0;
+        polyline->p0.y0 = p0->y0;
+        polyline->p0.z0 = p0->z0;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2393,7 +2581,7 @@ dxf_polyline_get_x0
                 /*!< a pointer to a DXF \c POLYLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2405,17 +2593,10 @@ dxf_polyline_get_x0
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (polyline->p0 == NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was passed.\n")),
-                  __FUNCTION__);
-                return (EXIT_FAILURE);
-        }
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (polyline->p0->x0);
+        return (polyline->p0.x0);
 }
 
 
@@ -2436,7 +2617,7 @@ dxf_polyline_set_x0
                  * DXF \c POLYLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2447,14 +2628,7 @@ dxf_polyline_set_x0
                   __FUNCTION__);
                 return (NULL);
         }
-        if (polyline->p0 == NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was found.\n")),
-                  __FUNCTION__);
-                return (NULL);
-        }
-        polyline->p0->x0 = x0;
+        polyline->p0.x0 = x0;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2475,7 +2649,7 @@ dxf_polyline_get_y0
                 /*!< a pointer to a DXF \c POLYLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2487,17 +2661,10 @@ dxf_polyline_get_y0
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (polyline->p0 == NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was passed.\n")),
-                  __FUNCTION__);
-                return (EXIT_FAILURE);
-        }
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (polyline->p0->y0);
+        return (polyline->p0.y0);
 }
 
 
@@ -2518,7 +2685,7 @@ dxf_polyline_set_y0
                  * DXF \c polyline entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2529,14 +2696,7 @@ dxf_polyline_set_y0
                   __FUNCTION__);
                 return (NULL);
         }
-        if (polyline->p0 == NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was passed.\n")),
-                  __FUNCTION__);
-                return (NULL);
-        }
-        polyline->p0->y0 = y0;
+        polyline->p0.y0 = y0;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2557,7 +2717,7 @@ dxf_polyline_get_z0
                 /*!< a pointer to a DXF \c POLYLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2569,17 +2729,10 @@ dxf_polyline_get_z0
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (polyline->p0 == NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was passed.\n")),
-                  __FUNCTION__);
-                return (EXIT_FAILURE);
-        }
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (polyline->p0->z0);
+        return (polyline->p0.z0);
 }
 
 
@@ -2600,7 +2753,7 @@ dxf_polyline_set_z0
                  * DXF \c polyline entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2611,14 +2764,7 @@ dxf_polyline_set_z0
                   __FUNCTION__);
                 return (NULL);
         }
-        if (polyline->p0 == NULL)
-        {
-                fprintf (stderr,
-                  (_("Error in %s () a NULL pointer was passed.\n")),
-                  __FUNCTION__);
-                return (NULL);
-        }
-        polyline->p0->z0 = z0;
+        polyline->p0.z0 = z0;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2638,7 +2784,7 @@ dxf_polyline_get_start_width
                 /*!< a pointer to a DXF \c POLYLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2678,7 +2824,7 @@ dxf_polyline_set_start_width
                 /*!< the \c start_width of a DXF \c polyline entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -2715,7 +2861,7 @@ dxf_polyline_get_end_width
                 /*!< a pointer to a DXF \c POLYLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -2755,7 +2901,7 @@ dxf_polyline_set_end_width
                 /*!< the \c end_width of a DXF \c polyline entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3342,7 +3488,7 @@ dxf_polyline_get_extr_x0
                 /*!< a pointer to a DXF \c POLYLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3378,7 +3524,7 @@ dxf_polyline_set_extr_x0
                  * \c POLYLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3410,7 +3556,7 @@ dxf_polyline_get_extr_y0
                 /*!< a pointer to a DXF \c POLYLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3446,7 +3592,7 @@ dxf_polyline_set_extr_y0
                  * \c POLYLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3478,7 +3624,7 @@ dxf_polyline_get_extr_z0
                 /*!< a pointer to a DXF \c POLYLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
 
@@ -3514,7 +3660,7 @@ dxf_polyline_set_extr_z0
                  * \c POLYLINE entity. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -3537,6 +3683,9 @@ dxf_polyline_set_extr_z0
  * \brief Get the pointer to the first vertex of a linked list of
  * \c vertices from a DXF \c POLYLINE entity.
  *
+ * For a polyline read from file the linked list is built from the packed
+ * vertices on the first call and belongs to \c polyline.
+ *
  * \return pointer to the first vertex of a linked list of \c vertices.
  *
  * \warning No checks are performed on the returned pointer.
@@ -3559,6 +3708,11 @@ dxf_polyline_get_vertices
                   __FUNCTION__);
                 return (NULL);
         }
+        if ((polyline->vertices == NULL)
+          && (polyline->packed_vertices.count > 0))
+        {
+                polyline->vertices = dxf_vertex_array_to_chain (&polyline->packed_vertices);
+        }
         if (polyline->vertices == NULL)
         {
                 fprintf (stderr,
@@ -3576,6 +3730,9 @@ dxf_polyline_get_vertices
 /*!
  * \brief Set the pointer to the first vertex of a linked list of
  * \c vertices for a DXF \c POLYLINE entity.
+ *
+ * The linked list replaces any packed vertices and is written as it is,
+ * \c polyline takes ownership of it.
  */
 DxfPolyline *
 dxf_polyline_set_vertices
@@ -3605,6 +3762,12 @@ dxf_polyline_set_vertices
                   __FUNCTION__);
                 return (NULL);
         }
+        if ((polyline->vertices != NULL)
+          && (polyline->vertices != vertices))
+        {
+                dxf_vertex_free_chain (polyline->vertices);
+        }
+        dxf_vertex_array_free (&polyline->packed_vertices);
         polyline->vertices = (DxfVertex *) vertices;
 #if DEBUG
         DXF_DEBUG_END
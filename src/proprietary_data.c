@@ -33,6 +33,7 @@
 
 
 #include "proprietary_data.h"
+#include "arena.h"
 
 
 /*!
@@ -52,7 +53,7 @@ dxf_proprietary_data_new ()
         size = sizeof (DxfProprietaryData);
         /* avoid malloc of 0 bytes */
         if (size == 0) size = 1;
-        if ((data = malloc (size)) == NULL)
+        if ((data = dxf_malloc (size)) == NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () could not allocate memory for a DxfProprietaryData struct.\n")),
@@ -102,7 +103,7 @@ dxf_proprietary_data_init
                 __FUNCTION__);
               return (NULL);
         }
-        data->line = strdup ("");
+        data->line = dxf_strdup ("");
         data->next = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -137,8 +138,8 @@ dxf_proprietary_data_free
                 __FUNCTION__);
               return (EXIT_FAILURE);
         }
-        free (data->line);
-        free (data);
+        dxf_free (data->line);
+        dxf_free (data);
         data = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -159,7 +160,7 @@ dxf_proprietary_data_free_chain
                  * objects. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (datas == NULL)
@@ -290,7 +291,7 @@ dxf_proprietary_data_get_line
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (data->line));
+        return (dxf_strdup (data->line));
 }
 
 
@@ -327,7 +328,7 @@ dxf_proprietary_data_set_line
                   __FUNCTION__);
                 return (NULL);
         }
-        data->line = strdup (line);
+        data->line = dxf_strdup (line);
 #if DEBUG
         DXF_DEBUG_END
 #endif
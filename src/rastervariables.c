@@ -35,6 +35,8 @@
 
 
 #include "rastervariables.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -160,7 +162,8 @@ dxf_rastervariables_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfPair pair;
         int i;
 
         /* Do some basic checks. */
@@ -169,8 +172,6 @@ dxf_rastervariables_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (fp->acad_version_number < AutoCAD_14)
@@ -188,100 +189,81 @@ dxf_rastervariables_read
                 rastervariables = dxf_rastervariables_init (rastervariables);
         }
         i = 0;
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        /* Clean up. */
-                        free (temp_string);
-                        fclose (fp->fp);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &rastervariables->id_code);
-                }
-                if (strcmp (temp_string, "70") == 0)
-                {
-                        /* Now follows a string containing a display
-                         * image frame flag value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &rastervariables->display_image_frame);
-                }
-                if (strcmp (temp_string, "71") == 0)
-                {
-                        /* Now follows a string containing a display
-                         * quality flag value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &rastervariables->display_quality);
-                }
-                if (strcmp (temp_string, "72") == 0)
-                {
-                        /* Now follows a string containing a units
-                         * value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &rastervariables->units);
-                }
-                else if (strcmp (temp_string, "90") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing the
-                         * value of class version. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &rastervariables->class_version);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else if ((fp->acad_version_number >= AutoCAD_13)
-                        && (strcmp (temp_string, "100") == 0))
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "AcDbIdBuffer") != 0)
-                        {
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                rastervariables->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 70:
+                                /* Now follows a string containing a display
+                                 * image frame flag value. */
+                                rastervariables->display_image_frame = dxf_pair_get_int (&pair);
+                                break;
+                        case 71:
+                                /* Now follows a string containing a display
+                                 * quality flag value. */
+                                rastervariables->display_quality = dxf_pair_get_int (&pair);
+                                break;
+                        case 72:
+                                /* Now follows a string containing a units
+                                 * value. */
+                                rastervariables->units = dxf_pair_get_int (&pair);
+                                break;
+                        case 90:
+                                /* Now follows a string containing the
+                                 * value of class version. */
+                                rastervariables->class_version = dxf_pair_get_int (&pair);
+                                break;
+                        case 100:
+                                if (fp->acad_version_number >= AutoCAD_13)
+                                {
+                                        /* Now follows a string containing the
+                                         * subclass marker value. */
+                                        dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                        if (strcmp (temp_string, "AcDbIdBuffer") != 0)
+                                        {
+                                                fprintf (stderr,
+                                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                                  __FUNCTION__, fp->filename, fp->line_number);
+                                        }
+                                }
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner dictionary. */
+                                free (rastervariables->dictionary_owner_soft);
+                                rastervariables->dictionary_owner_soft = dxf_pair_get_string (&pair);
+                                i++;
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                free (rastervariables->dictionary_owner_hard);
+                                rastervariables->dictionary_owner_hard = dxf_pair_get_string (&pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, (_("DXF comment: %s\n")), temp_string);
+                                break;
+                        default:
                                 fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
                                   __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", rastervariables->dictionary_owner_soft);
-                        i++;
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", rastervariables->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, (_("DXF comment: %s\n")), temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
-        /* Clean up. */
-        free (temp_string);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -337,14 +319,14 @@ dxf_rastervariables_write
         if (fp->acad_version_number < AutoCAD_14)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () illegal DXF version for this %s entity with id-code: %x.\n")),
+                  (_("Warning in %s () illegal DXF version for this %s entity with id-code: %lx.\n")),
                   __FUNCTION__, dxf_entity_name, rastervariables->id_code);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_string (fp, 0, dxf_entity_name);
         if (rastervariables->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", rastervariables->id_code);
+                dxf_write_hex (fp, 5, rastervariables->id_code);
         }
         /*!
          * \todo for version R14.\n
@@ -359,25 +341,25 @@ dxf_rastervariables_write
         if ((strcmp (rastervariables->dictionary_owner_soft, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", rastervariables->dictionary_owner_soft);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, rastervariables->dictionary_owner_soft);
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (rastervariables->dictionary_owner_hard, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", rastervariables->dictionary_owner_hard);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, rastervariables->dictionary_owner_hard);
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbRasterVariables\n");
+                dxf_write_string (fp, 100, "AcDbRasterVariables");
         }
-        fprintf (fp->fp, " 90\n%d\n", rastervariables->class_version);
-        fprintf (fp->fp, " 70\n%d\n", rastervariables->display_image_frame);
-        fprintf (fp->fp, " 71\n%d\n", rastervariables->display_quality);
-        fprintf (fp->fp, " 72\n%d\n", rastervariables->units);
+        dxf_write_int (fp, 90, rastervariables->class_version);
+        dxf_write_int (fp, 70, rastervariables->display_image_frame);
+        dxf_write_int (fp, 71, rastervariables->display_quality);
+        dxf_write_int (fp, 72, rastervariables->units);
         /* Clean up. */
         free (dxf_entity_name);
 #if DEBUG
@@ -448,7 +430,7 @@ dxf_rastervariables_free_chain
                  * objects. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (rastervariables == NULL)
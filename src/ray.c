@@ -35,6 +35,9 @@
 
 
 #include "ray.h"
+#include "arena.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -63,7 +66,7 @@ dxf_ray_new ()
         size = sizeof (DxfRay);
         /* avoid malloc of 0 bytes */
         if (size == 0) size = 1;
-        if ((ray = malloc (size)) == NULL)
+        if ((ray = dxf_malloc (size)) == NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () could not allocate memory for a DxfRay struct.\n")),
@@ -119,22 +122,15 @@ dxf_ray_init
               return (NULL);
         }
         ray->id_code = 0;
-        ray->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        ray->layer = strdup (DXF_DEFAULT_LAYER);
+        ray->properties = dxf_graphic_properties_default ();
         ray->x0 = 0.0;
         ray->y0 = 0.0;
         ray->z0 = 0.0;
         ray->x1 = 0.0;
         ray->y1 = 0.0;
         ray->z1 = 0.0;
-        ray->elevation = 0.0;
-        ray->thickness = 0.0;
-        ray->linetype_scale = DXF_DEFAULT_LINETYPE_SCALE;
-        ray->visibility = DXF_DEFAULT_VISIBILITY;
-        ray->color = DXF_COLOR_BYLAYER;
-        ray->paperspace = DXF_MODELSPACE;
-        ray->dictionary_owner_soft = strdup ("");
-        ray->dictionary_owner_hard = strdup ("");
+        ray->dictionary_owner_soft = dxf_strdup ("");
+        ray->dictionary_owner_hard = dxf_strdup ("");
         ray->next = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -173,7 +169,9 @@ dxf_ray_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfGraphicProperties properties;
+        DxfPair pair;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -181,8 +179,6 @@ dxf_ray_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (ray == NULL)
@@ -193,180 +189,152 @@ dxf_ray_read
                 ray = dxf_ray_new ();
                 ray = dxf_ray_init (ray);
         }
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        dxf_graphic_properties_start (&properties, ray->properties);
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        fclose (fp->fp);
-                        /* Clean up. */
-                        free (temp_string);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &ray->id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", ray->linetype);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", ray->layer);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the center point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ray->x0);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the center point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ray->y0);
-                }
-                else if (strcmp (temp_string, "30") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the center point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ray->z0);
-                }
-                else if (strcmp (temp_string, "11") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the center point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ray->x1);
-                }
-                else if (strcmp (temp_string, "21") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the center point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ray->y1);
-                }
-                else if (strcmp (temp_string, "31") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the center point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ray->z1);
-                }
-                else if ((fp->acad_version_number <= AutoCAD_11)
-                        && (strcmp (temp_string, "38") == 0)
-                        && (ray->elevation != 0.0))
-                {
-                        /* Now follows a string containing the
-                         * elevation. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ray->elevation);
-                }
-                else if (strcmp (temp_string, "39") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ray->thickness);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else if (strcmp (temp_string, "48") == 0)
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing the linetype
-                         * scale. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ray->linetype_scale);
-                }
-                else if (strcmp (temp_string, "60") == 0)
-                {
-                        /* Now follows a string containing the
-                         * visibility value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &ray->visibility);
-                }
-                else if (strcmp (temp_string, "62") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &ray->color);
-                }
-                else if (strcmp (temp_string, "67") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &ray->paperspace);
-                }
-                else if ((fp->acad_version_number >= AutoCAD_13)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if ((strcmp (temp_string, "AcDbEntity") != 0)
-                        && ((strcmp (temp_string, "AcDbRay") != 0)))
-                        {
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                ray->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 6:
+                                /* Now follows a string containing a linetype
+                                 * name. */
+                                dxf_lexer_free_string (fp, properties.linetype);
+                                properties.linetype = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 8:
+                                /* Now follows a string containing a layer name. */
+                                dxf_lexer_free_string (fp, properties.layer);
+                                properties.layer = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 10:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the center point. */
+                                ray->x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 20:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the center point. */
+                                ray->y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 30:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the center point. */
+                                ray->z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 11:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the center point. */
+                                ray->x1 = dxf_pair_get_double (&pair);
+                                break;
+                        case 21:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the center point. */
+                                ray->y1 = dxf_pair_get_double (&pair);
+                                break;
+                        case 31:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the center point. */
+                                ray->z1 = dxf_pair_get_double (&pair);
+                                break;
+                        case 38:
+                                if ((fp->acad_version_number <= AutoCAD_11)
+                                  && (properties.elevation != 0.0))
+                                {
+                                        /* Now follows a string containing the
+                                         * elevation. */
+                                        properties.elevation = dxf_pair_get_double (&pair);
+                                }
+                                break;
+                        case 39:
+                                /* Now follows a string containing the
+                                 * thickness. */
+                                properties.thickness = dxf_pair_get_double (&pair);
+                                break;
+                        case 48:
+                                /* Now follows a string containing the linetype
+                                 * scale. */
+                                properties.linetype_scale = dxf_pair_get_double (&pair);
+                                break;
+                        case 60:
+                                /* Now follows a string containing the
+                                 * visibility value. */
+                                properties.visibility = dxf_pair_get_int (&pair);
+                                break;
+                        case 62:
+                                /* Now follows a string containing the
+                                 * color value. */
+                                properties.color = dxf_pair_get_int (&pair);
+                                break;
+                        case 67:
+                                /* Now follows a string containing the
+                                 * paperspace value. */
+                                properties.paperspace = dxf_pair_get_int (&pair);
+                                break;
+                        case 100:
+                                if (fp->acad_version_number >= AutoCAD_13)
+                                {
+                                        /* Now follows a string containing the
+                                         * subclass marker value. */
+                                        dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                        if ((strcmp (temp_string, "AcDbEntity") != 0)
+                                        && ((strcmp (temp_string, "AcDbRay") != 0)))
+                                        {
+                                                fprintf (stderr,
+                                                  (_("Error in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                                  __FUNCTION__, fp->filename, fp->line_number);
+                                        }
+                                }
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, ray->dictionary_owner_soft);
+                                ray->dictionary_owner_soft = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, ray->dictionary_owner_hard);
+                                ray->dictionary_owner_hard = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, "DXF comment: %s\n", temp_string);
+                                break;
+                        default:
                                 fprintf (stderr,
-                                  (_("Error in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
                                   __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", ray->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", ray->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
         /* Handle omitted members and/or illegal values. */
-        if (strcmp (ray->linetype, "") == 0)
+        if ((properties.linetype != NULL)
+          && (strcmp (properties.linetype, "") == 0))
         {
-                ray->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_lexer_free_string (fp, properties.linetype);
+                properties.linetype = dxf_strdup (DXF_DEFAULT_LINETYPE);
         }
-        if (strcmp (ray->layer, "") == 0)
+        if ((properties.layer != NULL)
+          && (strcmp (properties.layer, "") == 0))
         {
-                ray->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_lexer_free_string (fp, properties.layer);
+                properties.layer = dxf_strdup (DXF_DEFAULT_LAYER);
         }
-        /* Clean up. */
-        free (temp_string);
+        /* Entities with equal properties share a record. */
+        dxf_graphic_properties_finish (fp, &ray->properties, &properties);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -398,7 +366,7 @@ dxf_ray_write
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *dxf_entity_name = strdup ("RAY");
+        char *dxf_entity_name = dxf_strdup ("RAY");
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -407,7 +375,7 @@ dxf_ray_write
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (ray == NULL)
@@ -416,7 +384,7 @@ dxf_ray_write
                   (_("Error in %s () a NULL pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if ((ray->x0 == ray->x1)
@@ -424,11 +392,11 @@ dxf_ray_write
                 && (ray->z0 == ray->z1))
         {
                 fprintf (stderr,
-                  (_("Error in %s () start point and end point are identical for the %s entity with id-code: %x\n")),
+                  (_("Error in %s () start point and end point are identical for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, ray->id_code);
                 dxf_entity_skip (dxf_entity_name);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (fp->acad_version_number < AutoCAD_13)
@@ -437,31 +405,39 @@ dxf_ray_write
                   (_("Error in %s () illegal DXF version for this entity.\n")),
                   __FUNCTION__);
         }
-        if (strcmp (ray->linetype, "") == 0)
+        if (strcmp (ray->properties->linetype, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, ray->id_code);
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                ray->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                if (dxf_graphic_properties_unshare (&ray->properties) != NULL)
+                {
+                        dxf_free (ray->properties->linetype);
+                        ray->properties->linetype = dxf_strdup (DXF_DEFAULT_LINETYPE);
+                }
         }
-        if (strcmp (ray->layer, "") == 0)
+        if (strcmp (ray->properties->layer, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty layer string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty layer string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, ray->id_code);
                 fprintf (stderr,
                   (_("\t%s entity is relocated to layer 0\n")),
                   dxf_entity_name);
-                ray->layer = strdup (DXF_DEFAULT_LAYER);
+                if (dxf_graphic_properties_unshare (&ray->properties) != NULL)
+                {
+                        dxf_free (ray->properties->layer);
+                        ray->properties->layer = dxf_strdup (DXF_DEFAULT_LAYER);
+                }
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_string (fp, 0, dxf_entity_name);
         if (ray->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", ray->id_code);
+                dxf_write_hex (fp, 5, ray->id_code);
         }
         /*!
          * \todo for version R14.\n
@@ -476,64 +452,64 @@ dxf_ray_write
         if ((strcmp (ray->dictionary_owner_soft, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", ray->dictionary_owner_soft);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, ray->dictionary_owner_soft);
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (ray->dictionary_owner_hard, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", ray->dictionary_owner_hard);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, ray->dictionary_owner_hard);
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbEntity\n");
+                dxf_write_string (fp, 100, "AcDbEntity");
         }
-        if (ray->paperspace == DXF_PAPERSPACE)
+        if (ray->properties->paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp->fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_int (fp, 67, DXF_PAPERSPACE);
         }
-        fprintf (fp->fp, "  8\n%s\n", ray->layer);
-        if (strcmp (ray->linetype, DXF_DEFAULT_LINETYPE) != 0)
+        dxf_write_string (fp, 8, ray->properties->layer);
+        if (strcmp (ray->properties->linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp->fp, "  6\n%s\n", ray->linetype);
+                dxf_write_string (fp, 6, ray->properties->linetype);
         }
         if ((fp->acad_version_number <= AutoCAD_11)
           && DXF_FLATLAND
-          && (ray->elevation != 0.0))
+          && (ray->properties->elevation != 0.0))
         {
-                fprintf (fp->fp, " 38\n%f\n", ray->elevation);
+                dxf_write_double (fp, 38, ray->properties->elevation);
         }
-        if (ray->color != DXF_COLOR_BYLAYER)
+        if (ray->properties->color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp->fp, " 62\n%d\n", ray->color);
+                dxf_write_int (fp, 62, ray->properties->color);
         }
-        if (ray->linetype_scale != 1.0)
+        if (ray->properties->linetype_scale != 1.0)
         {
-                fprintf (fp->fp, " 48\n%f\n", ray->linetype_scale);
+                dxf_write_double (fp, 48, ray->properties->linetype_scale);
         }
-        if (ray->visibility != 0)
+        if (ray->properties->visibility != 0)
         {
-                fprintf (fp->fp, " 60\n%d\n", ray->visibility);
+                dxf_write_int (fp, 60, ray->properties->visibility);
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbRay\n");
+                dxf_write_string (fp, 100, "AcDbRay");
         }
-        if (ray->thickness != 0.0)
+        if (ray->properties->thickness != 0.0)
         {
-                fprintf (fp->fp, " 39\n%f\n", ray->thickness);
+                dxf_write_double (fp, 39, ray->properties->thickness);
         }
-        fprintf (fp->fp, " 10\n%f\n", ray->x0);
-        fprintf (fp->fp, " 20\n%f\n", ray->y0);
-        fprintf (fp->fp, " 30\n%f\n", ray->z0);
-        fprintf (fp->fp, " 11\n%f\n", ray->x1);
-        fprintf (fp->fp, " 21\n%f\n", ray->y1);
-        fprintf (fp->fp, " 31\n%f\n", ray->z1);
+        dxf_write_double (fp, 10, ray->x0);
+        dxf_write_double (fp, 20, ray->y0);
+        dxf_write_double (fp, 30, ray->z0);
+        dxf_write_double (fp, 11, ray->x1);
+        dxf_write_double (fp, 21, ray->y1);
+        dxf_write_double (fp, 31, ray->z1);
         /* Clean up. */
-        free (dxf_entity_name);
+        dxf_free (dxf_entity_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -572,11 +548,10 @@ dxf_ray_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (ray->linetype);
-        free (ray->layer);
-        free (ray->dictionary_owner_soft);
-        free (ray->dictionary_owner_hard);
-        free (ray);
+        dxf_graphic_properties_free (ray->properties);
+        dxf_free (ray->dictionary_owner_soft);
+        dxf_free (ray->dictionary_owner_hard);
+        dxf_free (ray);
         ray = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -602,7 +577,7 @@ dxf_ray_free_chain
                 /*!< a pointer to the chain of DXF \c RAY entities. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (rays == NULL)
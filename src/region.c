@@ -33,6 +33,9 @@
 
 
 #include "region.h"
+#include "arena.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -58,7 +61,7 @@ dxf_region_new ()
         size = sizeof (DxfRegion);
         /* avoid malloc of 0 bytes */
         if (size == 0) size = 1;
-        if ((region = malloc (size)) == NULL)
+        if ((region = dxf_malloc (size)) == NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () could not allocate memory for a DxfRegion struct.\n")),
@@ -118,22 +121,15 @@ dxf_region_init
         }
         region->modeler_format_version_number = 0;
         region->id_code = 0;
-        region->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        region->layer = strdup (DXF_DEFAULT_LAYER);
-        region->elevation = 0.0;
-        region->thickness = 0.0;
-        region->linetype_scale = DXF_DEFAULT_LINETYPE_SCALE;
-        region->visibility = DXF_DEFAULT_VISIBILITY;
-        region->color = DXF_COLOR_BYLAYER;
-        region->paperspace = DXF_MODELSPACE;
+        region->properties = dxf_graphic_properties_default ();
         region->modeler_format_version_number = 1;
         for (i = 0; i < DXF_MAX_PARAM; i++)
         {
-                region->proprietary_data[i] = strdup ("");
-                region->additional_proprietary_data[i] = strdup ("");
+                region->proprietary_data[i] = dxf_strdup ("");
+                region->additional_proprietary_data[i] = dxf_strdup ("");
         }
-        region->dictionary_owner_soft = strdup ("");
-        region->dictionary_owner_hard = strdup ("");
+        region->dictionary_owner_soft = dxf_strdup ("");
+        region->dictionary_owner_hard = dxf_strdup ("");
         region->next = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -172,7 +168,9 @@ dxf_region_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfGraphicProperties properties;
+        DxfPair pair;
         int i;
         int j;
 
@@ -184,8 +182,6 @@ dxf_region_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (region == NULL)
@@ -196,160 +192,140 @@ dxf_region_read
                 region = dxf_region_new ();
                 region = dxf_region_init (region);
         }
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        dxf_graphic_properties_start (&properties, region->properties);
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        fclose (fp->fp);
-                        /* Clean up. */
-                        free (temp_string);
-                        return (NULL);
-                }
-                else if (strcmp (temp_string, "  1") == 0)
-                {
-                        /* Now follows a string containing proprietary
-                         * data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", region->proprietary_data[i]);
-                        i++;
-                }
-                else if (strcmp (temp_string, "  3") == 0)
-                {
-                        /* Now follows a string containing additional
-                         * proprietary data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", region->additional_proprietary_data[j]);
-                        i++;
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &region->id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", region->linetype);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", region->layer);
-                }
-                else if ((fp->acad_version_number <= AutoCAD_11)
-                        && (strcmp (temp_string, "38") == 0)
-                        && (region->elevation != 0.0))
-                {
-                        /* Now follows a string containing the
-                         * elevation. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &region->elevation);
-                }
-                else if (strcmp (temp_string, "39") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &region->thickness);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else if (strcmp (temp_string, "48") == 0)
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing the linetype
-                         * scale. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &region->linetype_scale);
-                }
-                else if (strcmp (temp_string, "60") == 0)
-                {
-                        /* Now follows a string containing the
-                         * visibility value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &region->visibility);
-                }
-                else if (strcmp (temp_string, "62") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &region->color);
-                }
-                else if (strcmp (temp_string, "67") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &region->paperspace);
-                }
-                else if ((fp->acad_version_number >= AutoCAD_13)
-                        && (strcmp (temp_string, "70") == 0))
-                {
-                        /* Now follows a string containing the modeler
-                         * format version number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &region->modeler_format_version_number);
-                }
-                else if ((fp->acad_version_number >= AutoCAD_13)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "AcDbModelerGeometry") != 0)
-                        {
-                                fprintf (stderr, "Error in dxf_region_read () found a bad subclass marker in: %s in line: %d.\n",
-                                        fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", region->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", region->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                        case 1:
+                                /* Now follows a string containing proprietary
+                                 * data. */
+                                region->proprietary_data[i] = dxf_pair_get_string (&pair);
+                                i++;
+                                break;
+                        case 3:
+                                /* Now follows a string containing additional
+                                 * proprietary data. */
+                                region->additional_proprietary_data[j] = dxf_pair_get_string (&pair);
+                                i++;
+                                break;
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                region->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 6:
+                                /* Now follows a string containing a linetype
+                                 * name. */
+                                dxf_lexer_free_string (fp, properties.linetype);
+                                properties.linetype = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 8:
+                                /* Now follows a string containing a layer name. */
+                                dxf_lexer_free_string (fp, properties.layer);
+                                properties.layer = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 38:
+                                if ((fp->acad_version_number <= AutoCAD_11)
+                                  && (properties.elevation != 0.0))
+                                {
+                                        /* Now follows a string containing the
+                                         * elevation. */
+                                        properties.elevation = dxf_pair_get_double (&pair);
+                                }
+                                break;
+                        case 39:
+                                /* Now follows a string containing the
+                                 * thickness. */
+                                properties.thickness = dxf_pair_get_double (&pair);
+                                break;
+                        case 48:
+                                /* Now follows a string containing the linetype
+                                 * scale. */
+                                properties.linetype_scale = dxf_pair_get_double (&pair);
+                                break;
+                        case 60:
+                                /* Now follows a string containing the
+                                 * visibility value. */
+                                properties.visibility = dxf_pair_get_int (&pair);
+                                break;
+                        case 62:
+                                /* Now follows a string containing the
+                                 * color value. */
+                                properties.color = dxf_pair_get_int (&pair);
+                                break;
+                        case 67:
+                                /* Now follows a string containing the
+                                 * paperspace value. */
+                                properties.paperspace = dxf_pair_get_int (&pair);
+                                break;
+                        case 70:
+                                if (fp->acad_version_number >= AutoCAD_13)
+                                {
+                                        /* Now follows a string containing the modeler
+                                         * format version number. */
+                                        region->modeler_format_version_number = dxf_pair_get_int (&pair);
+                                }
+                                break;
+                        case 100:
+                                if (fp->acad_version_number >= AutoCAD_13)
+                                {
+                                        /* Now follows a string containing the
+                                         * subclass marker value. */
+                                        dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                        if (strcmp (temp_string, "AcDbModelerGeometry") != 0)
+                                        {
+                                                fprintf (stderr, "Error in dxf_region_read () found a bad subclass marker in: %s in line: %d.\n",
+                                                        fp->filename, fp->line_number);
+                                        }
+                                }
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, region->dictionary_owner_soft);
+                                region->dictionary_owner_soft = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, region->dictionary_owner_hard);
+                                region->dictionary_owner_hard = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, "DXF comment: %s\n", temp_string);
+                                break;
+                        default:
+                                fprintf (stderr,
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
+                                  __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
         /* Handle omitted members and/or illegal values. */
-        if (strcmp (region->linetype, "") == 0)
+        if ((properties.linetype != NULL)
+          && (strcmp (properties.linetype, "") == 0))
         {
-                region->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_lexer_free_string (fp, properties.linetype);
+                properties.linetype = dxf_strdup (DXF_DEFAULT_LINETYPE);
         }
-        if (strcmp (region->layer, "") == 0)
+        if ((properties.layer != NULL)
+          && (strcmp (properties.layer, "") == 0))
         {
-                region->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_lexer_free_string (fp, properties.layer);
+                properties.layer = dxf_strdup (DXF_DEFAULT_LAYER);
         }
-        /* Clean up. */
-        free (temp_string);
+        /* Entities with equal properties share a record. */
+        dxf_graphic_properties_finish (fp, &region->properties, &properties);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -381,7 +357,7 @@ dxf_region_write
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *dxf_entity_name = strdup ("REGION");
+        char *dxf_entity_name = dxf_strdup ("REGION");
         int i;
 
         /* Do some basic checks. */
@@ -391,7 +367,7 @@ dxf_region_write
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (region == NULL)
@@ -400,40 +376,48 @@ dxf_region_write
                   (_("Error in %s () a NULL pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (fp->acad_version_number < AutoCAD_13)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () illegal DXF version for this %s entity with id-code: %x.\n")),
+                  (_("Warning in %s () illegal DXF version for this %s entity with id-code: %lx.\n")),
                   __FUNCTION__, dxf_entity_name, region->id_code);
         }
-        if (strcmp (region->linetype, "") == 0)
+        if (strcmp (region->properties->linetype, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, region->id_code);
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                region->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                if (dxf_graphic_properties_unshare (&region->properties) != NULL)
+                {
+                        dxf_free (region->properties->linetype);
+                        region->properties->linetype = dxf_strdup (DXF_DEFAULT_LINETYPE);
+                }
         }
-        if (strcmp (region->layer, "") == 0)
+        if (strcmp (region->properties->layer, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty layer string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty layer string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, region->id_code);
                 fprintf (stderr,
                   (_("\t%s entity is relocated to layer 0")),
                   dxf_entity_name);
-                region->layer = strdup (DXF_DEFAULT_LAYER);
+                if (dxf_graphic_properties_unshare (&region->properties) != NULL)
+                {
+                        dxf_free (region->properties->layer);
+                        region->properties->layer = dxf_strdup (DXF_DEFAULT_LAYER);
+                }
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_string (fp, 0, dxf_entity_name);
         if (region->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", region->id_code);
+                dxf_write_hex (fp, 5, region->id_code);
         }
         /*!
          * \todo for version R14.\n
@@ -448,74 +432,74 @@ dxf_region_write
         if ((strcmp (region->dictionary_owner_soft, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", region->dictionary_owner_soft);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, region->dictionary_owner_soft);
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (region->dictionary_owner_hard, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", region->dictionary_owner_hard);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, region->dictionary_owner_hard);
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbEntity\n");
+                dxf_write_string (fp, 100, "AcDbEntity");
         }
-        if (region->paperspace == DXF_PAPERSPACE)
+        if (region->properties->paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp->fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_int (fp, 67, DXF_PAPERSPACE);
         }
-        fprintf (fp->fp, "  8\n%s\n", region->layer);
-        if (strcmp (region->linetype, DXF_DEFAULT_LINETYPE) != 0)
+        dxf_write_string (fp, 8, region->properties->layer);
+        if (strcmp (region->properties->linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp->fp, "  6\n%s\n", region->linetype);
+                dxf_write_string (fp, 6, region->properties->linetype);
         }
         if ((fp->acad_version_number <= AutoCAD_11)
           && DXF_FLATLAND
-          && (region->elevation != 0.0))
+          && (region->properties->elevation != 0.0))
         {
-                fprintf (fp->fp, " 38\n%f\n", region->elevation);
+                dxf_write_double (fp, 38, region->properties->elevation);
         }
-        if (region->color != DXF_COLOR_BYLAYER)
+        if (region->properties->color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp->fp, " 62\n%d\n", region->color);
+                dxf_write_int (fp, 62, region->properties->color);
         }
-        if (region->linetype_scale != 1.0)
+        if (region->properties->linetype_scale != 1.0)
         {
-                fprintf (fp->fp, " 48\n%f\n", region->linetype_scale);
+                dxf_write_double (fp, 48, region->properties->linetype_scale);
         }
-        if (region->visibility != 0)
+        if (region->properties->visibility != 0)
         {
-                fprintf (fp->fp, " 60\n%d\n", region->visibility);
+                dxf_write_int (fp, 60, region->properties->visibility);
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbModelerGeometry\n");
+                dxf_write_string (fp, 100, "AcDbModelerGeometry");
         }
-        if (region->thickness != 0.0)
+        if (region->properties->thickness != 0.0)
         {
-                fprintf (fp->fp, " 39\n%f\n", region->thickness);
+                dxf_write_double (fp, 39, region->properties->thickness);
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, " 70\n%d\n", region->modeler_format_version_number);
+                dxf_write_int (fp, 70, region->modeler_format_version_number);
         }
         i = 0;
         while (strlen (region->proprietary_data[i]) > 0)
         {
-                fprintf (fp->fp, "  1\n%s\n", region->proprietary_data[i]);
+                dxf_write_string (fp, 1, region->proprietary_data[i]);
                 i++;
         }
         i = 0;
         while (strlen (region->additional_proprietary_data[i]) > 0)
         {
-                fprintf (fp->fp, "  3\n%s\n", region->additional_proprietary_data[i]);
+                dxf_write_string (fp, 3, region->additional_proprietary_data[i]);
                 i++;
         }
         /* Clean up. */
-        free (dxf_entity_name);
+        dxf_free (dxf_entity_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -556,16 +540,15 @@ dxf_region_free
                 __FUNCTION__);
               return (EXIT_FAILURE);
         }
-        free (region->linetype);
-        free (region->layer);
+        dxf_graphic_properties_free (region->properties);
         for (i = 0; i < DXF_MAX_PARAM; i++)
         {
-                free (region->proprietary_data[i]);
-                free (region->additional_proprietary_data[i]);
+                dxf_free (region->proprietary_data[i]);
+                dxf_free (region->additional_proprietary_data[i]);
         }
-        free (region->dictionary_owner_soft);
-        free (region->dictionary_owner_hard);
-        free (region);
+        dxf_free (region->dictionary_owner_soft);
+        dxf_free (region->dictionary_owner_hard);
+        dxf_free (region);
         region = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -591,7 +574,7 @@ dxf_region_free_chain
                 /*!< a pointer to the chain of DXF \c REGION entities. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (regions == NULL)
@@ -33,101 +33,533 @@
 
 
 #include "section.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
- * \brief Function reads a SECTION in a DXF file.
+ * \brief Skip the remaining groups of a section, up to and including
+ * the \c ENDSEC marker.
  */
-int
-dxf_section_read
+void
+dxf_section_skip
 (
         DxfFile *fp
                 /*!< DXF file handle of input file (or device). */
 )
+{
+        DxfPair pair;
+
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
+        {
+                if ((pair.group_code == 0)
+                  && (dxf_pair_value_is (&pair, "ENDSEC")))
+                {
+                        break;
+                }
+        }
+}
+
+
+/*!
+ * \brief Locate the sections of a memory mapped DXF file.
+ *
+ * The file is scanned with the lexer only, no groups are parsed, and
+ * the name and byte range of every section are stored in \c ranges.\n
+ * The ranges can be read independently by means of
+ * dxf_read_init_window ().\n
+ * The read position of \c fp is left at the end of the scan.
+ *
+ * \return the number of sections found, or -1 when an error occurred.
+ */
+int
+dxf_section_index
+(
+        DxfFile *fp,
+                /*!< DXF file handle of a memory mapped input file. */
+        DxfSectionRange *ranges,
+                /*!< array to store the sections in. */
+        int max_ranges
+                /*!< number of elements in \c ranges. */
+)
 {
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
-        DxfHeader dxf_header;
-        DxfBlock dxf_block;
-        char *dxf_entities_list = NULL;
+        DxfPair pair;
+        size_t position;
+        int count = 0;
+        int open = FALSE;
 
         /* Do some basic checks. */
-        if (fp == NULL)
+        if ((fp == NULL) || (fp->buffer == NULL) || (ranges == NULL))
         {
                 fprintf (stderr,
-                  (_("Error in %s () a NULL file pointer was passed.\n")),
+                  (_("Error in %s () a NULL pointer or a file which is not memory mapped was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
-                return (EXIT_FAILURE);
+                return (-1);
         }
-        dxf_read_line (temp_string, fp);
-        if (strcmp (temp_string, "2") == 0)
+        position = fp->position;
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                while (!feof (fp->fp))
+                if (pair.group_code == 0)
                 {
-                        dxf_read_line (temp_string, fp);
-                        if (strcmp (temp_string, "HEADER") == 0)
+                        if (open && dxf_pair_value_is (&pair, "ENDSEC"))
                         {
-                                /* We have found the begin of the HEADER section. */
-                                dxf_header_read (fp, &dxf_header);
+                                ranges[count].end = position;
+                                count++;
+                                open = FALSE;
                         }
-                        else if (strcmp (temp_string, "CLASSES") == 0)
+                        else if (dxf_pair_value_is (&pair, "SECTION"))
                         {
-                                /* We have found the begin of the CLASSES sction. */
-                                /*! \todo Invoke a function for parsing the \c CLASSES section. */ 
+                                if (open)
+                                {
+                                        /* No ENDSEC marker, the section
+                                         * ends here. */
+                                        ranges[count].end = position;
+                                        count++;
+                                        open = FALSE;
+                                }
+                                if (count == max_ranges)
+                                {
+                                        fprintf (stderr,
+                                          (_("Warning in %s () more than %d sections found in: %s.\n")),
+                                          __FUNCTION__, max_ranges, fp->filename);
+                                        break;
+                                }
+                                if ((dxf_lexer_read_pair (fp, &pair) != 1)
+                                  || (pair.group_code != 2))
+                                {
+                                        break;
+                                }
+                                dxf_pair_copy_string (&pair,
+                                  ranges[count].name, DXF_MAX_SECTION_NAME_LENGTH);
+                                ranges[count].start = fp->position;
+                                open = TRUE;
                         }
-                        else if (strcmp (temp_string, "TABLES") == 0)
+                        else if (dxf_pair_value_is (&pair, "EOF"))
                         {
-                                /* We have found the begin of the TABLES sction. */
-                                /*! \todo Invoke a function for parsing the \c TABLES section. */ 
+                                break;
                         }
-                        else if (strcmp (temp_string, "BLOCKS") == 0)
+                }
+                position = fp->position;
+        }
+        if (open)
+        {
+                ranges[count].end = fp->buffer_size;
+                count++;
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (count);
+}
+
+
+/*!
+ * \brief Test if the line from \c start up to \c end holds nothing but
+ * a number, surrounded by optional white space.
+ */
+static int
+dxf_section_line_is_number
+(
+        const char *start,
+                /*!< first byte of the line. */
+        const char *end
+                /*!< the newline ending the line. */
+)
+{
+        int digits = 0;
+
+        while ((start < end) && ((*start == ' ') || (*start == '\t')))
+        {
+                start++;
+        }
+        if ((start < end) && (*start == '-'))
+        {
+                start++;
+        }
+        while ((start < end) && (*start >= '0') && (*start <= '9'))
+        {
+                start++;
+                digits++;
+        }
+        while ((start < end)
+          && ((*start == ' ') || (*start == '\t') || (*start == '\r')))
+        {
+                start++;
+        }
+        return ((digits > 0) && (start == end));
+}
+
+
+/*!
+ * \brief Test if the line from \c start up to \c end holds a zero,
+ * surrounded by optional white space.
+ */
+static int
+dxf_section_line_is_zero
+(
+        const char *start,
+                /*!< first byte of the line. */
+        const char *end
+                /*!< the newline ending the line. */
+)
+{
+        while ((start < end) && ((*start == ' ') || (*start == '\t')))
+        {
+                start++;
+        }
+        if ((start == end) || (*start != '0'))
+        {
+                return (FALSE);
+        }
+        start++;
+        while ((start < end)
+          && ((*start == ' ') || (*start == '\t') || (*start == '\r')))
+        {
+                start++;
+        }
+        return (start == end);
+}
+
+
+/*!
+ * \brief Test if the entity name from \c start up to \c end is one of
+ * the entities belonging to the entity before it.
+ *
+ * \c VERTEX and \c SEQEND entities are read with the \c POLYLINE before
+ * them, \c ATTRIB entities with the \c INSERT before them.
+ */
+static int
+dxf_section_name_is_dependent
+(
+        const char *start,
+                /*!< first byte of the name. */
+        const char *end
+                /*!< the newline ending the name. */
+)
+{
+        while ((end > start)
+          && ((end[-1] == ' ') || (end[-1] == '\t') || (end[-1] == '\r')))
+        {
+                end--;
+        }
+        if ((end - start) != 6)
+        {
+                return (FALSE);
+        }
+        return ((memcmp (start, "VERTEX", 6) == 0)
+          || (memcmp (start, "SEQEND", 6) == 0)
+          || (memcmp (start, "ATTRIB", 6) == 0));
+}
+
+
+/*!
+ * \brief Find the first group code 0 line at or after \c position in
+ * an ASCII DXF file.
+ *
+ * A line holding \c 0 is either the group code 0 starting an entity, or
+ * the value of some other group.\n
+ * A group code is always followed by its value, which for group code 0
+ * is the name of an entity, while a value is always followed by a
+ * (numeric) group code.\n
+ * So a line holding \c 0, followed by a line which is not a number,
+ * starts an entity, whatever came before it.  This makes it possible to
+ * start searching anywhere in the file.\n
+ * An entity which belongs to the one before it, see
+ * dxf_section_name_is_dependent (), is passed over.
+ *
+ * \return the offset of the group code line, or \c end when there is
+ * none.
+ */
+static size_t
+dxf_section_find_entity_ascii
+(
+        const char *buffer,
+                /*!< start of the memory mapped file. */
+        size_t position,
+                /*!< offset to start searching at. */
+        size_t end
+                /*!< offset to stop searching at. */
+)
+{
+        const char *line;
+        const char *eol;
+        const char *next_eol;
+        const char *stop = buffer + end;
+
+        line = buffer + position;
+        /* Start at the beginning of a line. */
+        if ((position > 0) && (line[-1] != '\n'))
+        {
+                eol = memchr (line, '\n', (size_t) (stop - line));
+                if (eol == NULL)
+                {
+                        return (end);
+                }
+                line = eol + 1;
+        }
+        /* memchr () is vectorized by the C library, so this skips over
+         * the lines at memory bandwidth. */
+        eol = memchr (line, '\n', (size_t) (stop - line));
+        while (eol != NULL)
+        {
+                next_eol = memchr (eol + 1, '\n', (size_t) (stop - eol - 1));
+                if (next_eol == NULL)
+                {
+                        break;
+                }
+                if (dxf_section_line_is_zero (line, eol)
+                  && !dxf_section_line_is_number (eol + 1, next_eol)
+                  && !dxf_section_name_is_dependent (eol + 1, next_eol))
+                {
+                        return ((size_t) (line - buffer));
+                }
+                line = eol + 1;
+                eol = next_eol;
+        }
+        return (end);
+}
+
+
+/*!
+ * \brief Split a section in at most \c max_chunks parts of about the
+ * same size, at entity boundaries.
+ *
+ * Every part starts with the group code 0 pair of an entity, so the
+ * parts can be read independently by means of dxf_read_init_window ()
+ * and dxf_entities_read ().\n
+ * No part starts at a \c VERTEX, \c ATTRIB or \c SEQEND entity, these
+ * stay in the part of the entity they belong to.\n
+ * In ASCII files only the lines around the wanted split points are
+ * looked at, see dxf_section_find_entity_ascii ().\n
+ * Binary files have no line structure, there the groups of the section
+ * are scanned with the lexer.
+ *
+ * \return the number of parts stored in \c chunks, or -1 when an error
+ * occurred.
+ */
+int
+dxf_section_split
+(
+        DxfFile *fp,
+                /*!< DXF file handle of a memory mapped input file. */
+        DxfSectionRange *range,
+                /*!< the section to split. */
+        DxfSectionRange *chunks,
+                /*!< array to store the parts in. */
+        int max_chunks
+                /*!< number of elements in \c chunks. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfFile *window;
+        DxfPair pair;
+        size_t size;
+        size_t target;
+        size_t boundary;
+        size_t position;
+        int count = 0;
+
+        /* Do some basic checks. */
+        if ((fp == NULL) || (fp->buffer == NULL) || (range == NULL)
+          || (chunks == NULL) || (max_chunks < 1))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer or a file which is not memory mapped was passed.\n")),
+                  __FUNCTION__);
+                return (-1);
+        }
+        size = range->end - range->start;
+        chunks[0] = *range;
+        count = 1;
+        if (fp->binary)
+        {
+                window = dxf_read_init_window (fp, range->start, range->end);
+                if (window == NULL)
+                {
+                        return (count);
+                }
+                position = window->position;
+                while ((count < max_chunks)
+                  && (dxf_lexer_read_pair (window, &pair) == 1))
+                {
+                        target = (size * (size_t) count) / (size_t) max_chunks;
+                        if ((pair.group_code == 0) && (position >= target)
+                          && (position > 0)
+                          && !dxf_pair_value_is (&pair, "VERTEX")
+                          && !dxf_pair_value_is (&pair, "SEQEND")
+                          && !dxf_pair_value_is (&pair, "ATTRIB"))
                         {
-                                /* We have found the begin of the BLOCKS sction. */
-
-                                /*! \todo Experimental usage of block_read */
-//                                dxf_read_blocks
-//                                (
-//                                        fp->fp,
-//                                        &dxf_blocks_list,
-//                                        dxf_header._AcadVer
-//                                );
+                                boundary = range->start + position;
+                                chunks[count - 1].end = boundary;
+                                chunks[count] = *range;
+                                chunks[count].start = boundary;
+                                count++;
                         }
-                        else if (strcmp (temp_string, "ENTITIES") == 0)
-                        {
-                                /* We have found the begin of the ENTITIES sction. */
-                                dxf_entities_read_table (fp->filename,
-                                                   fp->fp,
-                                                   fp->line_number,
-                                                   dxf_entities_list,
-                                                   dxf_header._AcadVer);                        }
-                        else if (strcmp (temp_string, "OBJECTS") == 0)
+                        position = window->position;
+                }
+                dxf_read_close (window);
+        }
+        else
+        {
+                while (count < max_chunks)
+                {
+                        target = range->start
+                          + (size * (size_t) count) / (size_t) max_chunks;
+                        if (target <= chunks[count - 1].start)
                         {
-                                /* We have found the begin of the OBJECTS sction. */
-                                /*! \todo Invoke a function for parsing the \c OBJECTS section. */ 
+                                target = chunks[count - 1].start + 1;
                         }
-                        else if (strcmp (temp_string, "THUMBNAIL") == 0)
+                        boundary = dxf_section_find_entity_ascii (fp->buffer,
+                          target, range->end);
+                        if (boundary >= range->end)
                         {
-                                /* We have found the begin of the THUMBNAIL sction. */
-                                /*! \todo Invoke a function for parsing the \c THUMBNAIL section. */ 
+                                break;
                         }
+                        chunks[count - 1].end = boundary;
+                        chunks[count] = *range;
+                        chunks[count].start = boundary;
+                        count++;
                 }
         }
-        else
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (count);
+}
+
+
+/*!
+ * \brief Find the AutoCAD version of a drawing from its \c HEADER
+ * section.
+ *
+ * The \c $ACADVER variable comes first in the \c HEADER section, so
+ * only the first two groups of the section are read.
+ *
+ * \return the AutoCAD version number, or \c 0 when it was not found.
+ */
+int
+dxf_section_read_version
+(
+        DxfFile *fp,
+                /*!< the memory mapped file. */
+        DxfSectionRange *range
+                /*!< location of the \c HEADER section. */
+)
+{
+        DxfFile *window;
+        DxfPair pair;
+        char version[DXF_MAX_STRING_LENGTH];
+        int acad_version_number = 0;
+
+        window = dxf_read_init_window (fp, range->start, range->end);
+        if (window == NULL)
+        {
+                return (0);
+        }
+        if ((dxf_lexer_read_pair (window, &pair) == 1)
+          && (pair.group_code == 9)
+          && (dxf_pair_value_is (&pair, "$ACADVER"))
+          && (dxf_lexer_read_pair (window, &pair) == 1)
+          && (pair.group_code == 1))
+        {
+                dxf_pair_copy_string (&pair, version, sizeof (version));
+                acad_version_number = dxf_header_acad_version_from_string (version);
+        }
+        dxf_read_close (window);
+        return (acad_version_number);
+}
+
+
+/*!
+ * \brief Function reads a SECTION in a DXF file.
+ *
+ * The last pair read from file was (0, "SECTION"). \n
+ * Now follows the name of the section, the contents of the section and
+ * the \c ENDSEC marker, which is consumed.
+ */
+int
+dxf_section_read
+(
+        DxfFile *fp
+                /*!< DXF file handle of input file (or device). */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfHeader dxf_header;
+        DxfPair pair;
+        char *dxf_entities_list = NULL;
+
+        /* Do some basic checks. */
+        if (fp == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL file pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if ((dxf_lexer_read_pair (fp, &pair) != 1)
+          || (pair.group_code != 2))
         {
                 fprintf (stderr,
                   (_("Warning in %s () unexpected string encountered while reading line %d from: %s.\n")),
                   __FUNCTION__, fp->line_number, fp->filename);
+                return (EXIT_FAILURE);
+        }
+        if (dxf_pair_value_is (&pair, "HEADER"))
+        {
+                /* We have found the begin of the HEADER section.
+                 * The reader frees the strings it replaces, so start
+                 * from an empty header. */
+                memset (&dxf_header, 0, sizeof (DxfHeader));
+                dxf_header_read (fp, &dxf_header);
+        }
+        else if (dxf_pair_value_is (&pair, "CLASSES"))
+        {
+                /* We have found the begin of the CLASSES sction. */
+                /*! \todo Invoke a function for parsing the \c CLASSES section. */
+        }
+        else if (dxf_pair_value_is (&pair, "TABLES"))
+        {
+                /* We have found the begin of the TABLES sction. */
+                /*! \todo Invoke a function for parsing the \c TABLES section. */
+        }
+        else if (dxf_pair_value_is (&pair, "BLOCKS"))
+        {
+                /* We have found the begin of the BLOCKS sction. */
+                /*! \todo Invoke a function for parsing the \c BLOCKS section. */
+        }
+        else if (dxf_pair_value_is (&pair, "ENTITIES"))
+        {
+                /* We have found the begin of the ENTITIES sction. */
+                dxf_entities_read_table (fp->filename,
+                                   fp->fp,
+                                   fp->line_number,
+                                   dxf_entities_list,
+                                   fp->acad_version_number);
+        }
+        else if (dxf_pair_value_is (&pair, "OBJECTS"))
+        {
+                /* We have found the begin of the OBJECTS sction. */
+                /*! \todo Invoke a function for parsing the \c OBJECTS section. */
         }
-        /* Clean up. */
-        free (temp_string);
+        else if (dxf_pair_value_is (&pair, "THUMBNAIL"))
+        {
+                /* We have found the begin of the THUMBNAIL sction. */
+                /*! \todo Invoke a function for parsing the \c THUMBNAIL section. */
+        }
+        /* Skip whatever was not parsed, up to the end of the section. */
+        dxf_section_skip (fp);
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return EXIT_SUCCESS;
+        return (EXIT_SUCCESS);
 }
 
 
@@ -159,7 +591,8 @@ dxf_section_write
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        fprintf (fp->fp, "  0\nSECTION\n  2\n%s\n", section_name);
+        dxf_write_string (fp, 0, "SECTION");
+        dxf_write_string (fp, 2, section_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -48,7 +48,36 @@ extern "C" {
 #endif
 
 
+#define DXF_MAX_SECTIONS 16
+        /*!< \brief Maximum number of sections found by
+         * dxf_section_index (). */
+#define DXF_MAX_SECTION_NAME_LENGTH 32
+        /*!< \brief Maximum length of a section name, including the
+         * terminating \c NUL byte. */
+
+
+/*!
+ * \brief Location of a section in a memory mapped DXF file.
+ */
+typedef struct
+dxf_section_range_struct
+{
+        char name[DXF_MAX_SECTION_NAME_LENGTH];
+                /*!< Name of the section (\c HEADER, \c ENTITIES, ...). */
+        size_t start;
+                /*!< Offset of the first group after the name of the
+                 * section. */
+        size_t end;
+                /*!< Offset of the \c ENDSEC marker, or the end of the
+                 * file for a section without one. */
+} DxfSectionRange;
+
+
+int dxf_section_index (DxfFile *fp, DxfSectionRange *ranges, int max_ranges);
 int dxf_section_read (DxfFile *fp);
+int dxf_section_read_version (DxfFile *fp, DxfSectionRange *range);
+int dxf_section_split (DxfFile *fp, DxfSectionRange *range, DxfSectionRange *chunks, int max_chunks);
+void dxf_section_skip (DxfFile *fp);
 int dxf_section_write (DxfFile *fp, char *section_name);
 
 
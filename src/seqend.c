@@ -33,6 +33,9 @@
 
 
 #include "seqend.h"
+#include "arena.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -61,7 +64,7 @@ dxf_seqend_new ()
         size = sizeof (DxfSeqend);
         /* avoid malloc of 0 bytes */
         if (size == 0) size = 1;
-        if ((seqend = malloc (size)) == NULL)
+        if ((seqend = dxf_malloc (size)) == NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () could not allocate memory for a DxfSeqend struct.\n")),
@@ -117,18 +120,18 @@ dxf_seqend_init
                 __FUNCTION__);
               return (NULL);
         }
-        seqend->app_name = strdup ("");
+        seqend->app_name = dxf_strdup ("");
         seqend->id_code = 0;
-        seqend->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        seqend->layer = strdup (DXF_DEFAULT_LAYER);
+        seqend->linetype = dxf_strdup (DXF_DEFAULT_LINETYPE);
+        seqend->layer = dxf_strdup (DXF_DEFAULT_LAYER);
         seqend->elevation = 0.0;
         seqend->thickness = 0.0;
         seqend->linetype_scale = DXF_DEFAULT_LINETYPE_SCALE;
         seqend->visibility = DXF_DEFAULT_VISIBILITY;
         seqend->color = DXF_COLOR_BYLAYER;
         seqend->paperspace = DXF_MODELSPACE;
-        seqend->dictionary_owner_soft = strdup ("");
-        seqend->dictionary_owner_hard = strdup ("");
+        seqend->dictionary_owner_soft = dxf_strdup ("");
+        seqend->dictionary_owner_hard = dxf_strdup ("");
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -165,7 +168,8 @@ dxf_seqend_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfPair pair;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -173,8 +177,6 @@ dxf_seqend_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (seqend == NULL)
@@ -185,137 +187,114 @@ dxf_seqend_read
                 seqend = dxf_seqend_new ();
                 seqend = dxf_seqend_init (seqend);
         }
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        fclose (fp->fp);
-                        /* Clean up. */
-                        free (temp_string);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &seqend->id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", seqend->linetype);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", seqend->layer);
-                }
-                else if ((fp->acad_version_number <= AutoCAD_11)
-                        && (strcmp (temp_string, "38") == 0)
-                        && (seqend->elevation != 0.0))
-                {
-                        /* Now follows a string containing the
-                         * elevation. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &seqend->elevation);
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &seqend->thickness);
-                }
-                else if (strcmp (temp_string, "48") == 0)
-                {
-                        /* Now follows a string containing the linetype
-                         * scale. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &seqend->linetype_scale);
-                }
-                else if (strcmp (temp_string, "60") == 0)
-                {
-                        /* Now follows a string containing the
-                         * visibility value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &seqend->visibility);
-                }
-                else if (strcmp (temp_string, "62") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &seqend->color);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else if (strcmp (temp_string, "67") == 0)
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &seqend->paperspace);
-                }
-                else if ((fp->acad_version_number >= AutoCAD_13)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "AcDbEntity") != 0)
-                        {
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                seqend->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 6:
+                                /* Now follows a string containing a linetype
+                                 * name. */
+                                dxf_free (seqend->linetype);
+                                seqend->linetype = dxf_pair_get_string (&pair);
+                                break;
+                        case 8:
+                                /* Now follows a string containing a layer name. */
+                                dxf_free (seqend->layer);
+                                seqend->layer = dxf_pair_get_string (&pair);
+                                break;
+                        case 38:
+                                if ((fp->acad_version_number <= AutoCAD_11)
+                                  && (seqend->elevation != 0.0))
+                                {
+                                        /* Now follows a string containing the
+                                         * elevation. */
+                                        seqend->elevation = dxf_pair_get_double (&pair);
+                                }
+                                break;
+                        case 39:
+                                /* Now follows a string containing the
+                                 * thickness. */
+                                seqend->thickness = dxf_pair_get_double (&pair);
+                                break;
+                        case 48:
+                                /* Now follows a string containing the linetype
+                                 * scale. */
+                                seqend->linetype_scale = dxf_pair_get_double (&pair);
+                                break;
+                        case 60:
+                                /* Now follows a string containing the
+                                 * visibility value. */
+                                seqend->visibility = dxf_pair_get_int (&pair);
+                                break;
+                        case 62:
+                                /* Now follows a string containing the
+                                 * color value. */
+                                seqend->color = dxf_pair_get_int (&pair);
+                                break;
+                        case 67:
+                                /* Now follows a string containing the
+                                 * paperspace value. */
+                                seqend->paperspace = dxf_pair_get_int (&pair);
+                                break;
+                        case 100:
+                                if (fp->acad_version_number >= AutoCAD_13)
+                                {
+                                        /* Now follows a string containing the
+                                         * subclass marker value. */
+                                        dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                        if (strcmp (temp_string, "AcDbEntity") != 0)
+                                        {
+                                                fprintf (stderr,
+                                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                                  __FUNCTION__, fp->filename, fp->line_number);
+                                        }
+                                }
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner dictionary. */
+                                dxf_free (seqend->dictionary_owner_soft);
+                                seqend->dictionary_owner_soft = dxf_pair_get_string (&pair);
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                dxf_free (seqend->dictionary_owner_hard);
+                                seqend->dictionary_owner_hard = dxf_pair_get_string (&pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, "DXF comment: %s\n", temp_string);
+                                break;
+                        default:
                                 fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
                                   __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", seqend->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", seqend->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
         /* Handle omitted members and/or illegal values. */
         if (strcmp (seqend->linetype, "") == 0)
         {
-                seqend->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                seqend->linetype = dxf_strdup (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (seqend->layer, "") == 0)
         {
-                seqend->layer = strdup (DXF_DEFAULT_LAYER);
+                seqend->layer = dxf_strdup (DXF_DEFAULT_LAYER);
         }
-        /* Clean up. */
-        free (temp_string);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -355,7 +334,7 @@ dxf_seqend_write
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *dxf_entity_name = strdup ("SEQEND");
+        char *dxf_entity_name = dxf_strdup ("SEQEND");
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -364,7 +343,7 @@ dxf_seqend_write
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (seqend == NULL)
@@ -373,23 +352,23 @@ dxf_seqend_write
                   (_("Error in %s () a NULL pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (strcmp (seqend->linetype, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, seqend->id_code);
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                seqend->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                seqend->linetype = dxf_strdup (DXF_DEFAULT_LINETYPE);
         }
         if (strcmp (seqend->layer, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty layer string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty layer string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, seqend->id_code);
                 fprintf (stderr,
                   (_("\t%s entity is relocated to layer 0")),
@@ -397,10 +376,10 @@ dxf_seqend_write
                 seqend->layer = DXF_DEFAULT_LAYER;
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_string (fp, 0, dxf_entity_name);
         if (seqend->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", seqend->id_code);
+                dxf_write_hex (fp, 5, seqend->id_code);
         }
         /*!
          * \todo for version R14.\n
@@ -415,51 +394,51 @@ dxf_seqend_write
         if ((strcmp (seqend->dictionary_owner_soft, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", seqend->dictionary_owner_soft);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, seqend->dictionary_owner_soft);
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (seqend->dictionary_owner_hard, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", seqend->dictionary_owner_hard);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, seqend->dictionary_owner_hard);
+                dxf_write_string (fp, 102, "}");
         }
 
         if (seqend->paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp->fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_int (fp, 67, DXF_PAPERSPACE);
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbEntity\n");
+                dxf_write_string (fp, 100, "AcDbEntity");
         }
-        fprintf (fp->fp, "  8\n%s\n", seqend->layer);
+        dxf_write_string (fp, 8, seqend->layer);
         if ((fp->acad_version_number <= AutoCAD_11)
           && DXF_FLATLAND
           && (seqend->elevation != 0.0))
         {
-                fprintf (fp->fp, " 38\n%f\n", seqend->elevation);
+                dxf_write_double (fp, 38, seqend->elevation);
         }
         if (strcmp (seqend->linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp->fp, "  6\n%s\n", seqend->linetype);
+                dxf_write_string (fp, 6, seqend->linetype);
         }
         if (seqend->color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp->fp, " 62\n%d\n", seqend->color);
+                dxf_write_int (fp, 62, seqend->color);
         }
         if (seqend->linetype_scale != 1.0)
         {
-                fprintf (fp->fp, " 48\n%f\n", seqend->linetype_scale);
+                dxf_write_double (fp, 48, seqend->linetype_scale);
         }
         if (seqend->visibility != 0)
         {
-                fprintf (fp->fp, " 60\n%d\n", seqend->visibility);
+                dxf_write_int (fp, 60, seqend->visibility);
         }
         /* Clean up. */
-        free (dxf_entity_name);
+        dxf_free (dxf_entity_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -491,11 +470,12 @@ dxf_seqend_free
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        free (seqend->linetype);
-        free (seqend->layer);
-        free (seqend->dictionary_owner_soft);
-        free (seqend->dictionary_owner_hard);
-        free (seqend);
+        dxf_free (seqend->linetype);
+        dxf_free (seqend->layer);
+        dxf_free (seqend->dictionary_owner_soft);
+        dxf_free (seqend->dictionary_owner_hard);
+        dxf_free (seqend->app_name);
+        dxf_free (seqend);
         seqend = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -66,7 +66,7 @@ dxf_seqend
                  * entity).\n
                  * This code is not saved in a DXF file.\n
                  * Group code = 2. */
-        int id_code;
+        long id_code;
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file.\n
@@ -33,6 +33,9 @@
 
 
 #include "shape.h"
+#include "arena.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -61,7 +64,7 @@ dxf_shape_new ()
         size = sizeof (DxfShape);
         /* avoid malloc of 0 bytes */
         if (size == 0) size = 1;
-        if ((shape = malloc (size)) == NULL)
+        if ((shape = dxf_malloc (size)) == NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () could not allocate memory for a DxfShape struct.\n")),
@@ -118,17 +121,10 @@ dxf_shape_init
               return (NULL);
         }
         shape->id_code = 0;
-        shape->shape_name = strdup ("");
-        shape->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        shape->layer = strdup (DXF_DEFAULT_LAYER);
-        shape->elevation = 0.0;
-        shape->thickness = 0.0;
-        shape->linetype_scale = DXF_DEFAULT_LINETYPE_SCALE;
-        shape->visibility = DXF_DEFAULT_VISIBILITY;
-        shape->color = DXF_COLOR_BYLAYER;
-        shape->paperspace = DXF_MODELSPACE;
-        shape->dictionary_owner_soft = strdup ("");
-        shape->dictionary_owner_hard = strdup ("");
+        shape->shape_name = dxf_strdup ("");
+        shape->properties = dxf_graphic_properties_default ();
+        shape->dictionary_owner_soft = dxf_strdup ("");
+        shape->dictionary_owner_hard = dxf_strdup ("");
         shape->x0 = 0.0;
         shape->y0 = 0.0;
         shape->z0 = 0.0;
@@ -175,8 +171,10 @@ dxf_shape_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
-        char *dxf_entity_name = strdup ("SHAPE");
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfGraphicProperties properties;
+        DxfPair pair;
+        char dxf_entity_name[] = "SHAPE";
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -184,8 +182,6 @@ dxf_shape_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (shape == NULL)
@@ -196,222 +192,185 @@ dxf_shape_read
                 shape = dxf_shape_new ();
                 shape = dxf_shape_init (shape);
         }
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        dxf_graphic_properties_start (&properties, shape->properties);
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        fclose (fp->fp);
-                        /* Clean up. */
-                        free (temp_string);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "2") == 0)
-                {
-                        /* Now follows a string containing a shape
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", shape->shape_name);
-                }
-                else if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &shape->id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", shape->linetype);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", shape->layer);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the insertion point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &shape->x0);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the insertion point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &shape->y0);
-                }
-                else if (strcmp (temp_string, "30") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the insertion point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &shape->z0);
-                }
-                else if ((fp->acad_version_number <= AutoCAD_11)
-                        && (strcmp (temp_string, "38") == 0)
-                        && (shape->elevation != 0.0))
-                {
-                        /* Now follows a string containing the
-                         * elevation. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &shape->elevation);
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &shape->thickness);
-                }
-                else if (strcmp (temp_string, "40") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing the
-                         * size. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &shape->size);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else if (strcmp (temp_string, "41") == 0)
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing the
-                         * relative X scale. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &shape->rel_x_scale);
-                }
-                else if (strcmp (temp_string, "48") == 0)
-                {
-                        /* Now follows a string containing the linetype
-                         * scale. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &shape->linetype_scale);
-                }
-                else if (strcmp (temp_string, "50") == 0)
-                {
-                        /* Now follows a string containing the
-                         * rotation angle. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &shape->rot_angle);
-                }
-                else if (strcmp (temp_string, "51") == 0)
-                {
-                        /* Now follows a string containing the
-                         * oblique angle. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &shape->obl_angle);
-                }
-                else if (strcmp (temp_string, "60") == 0)
-                {
-                        /* Now follows a string containing the
-                         * visibility value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &shape->visibility);
-                }
-                else if (strcmp (temp_string, "62") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &shape->color);
-                }
-                else if (strcmp (temp_string, "67") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &shape->paperspace);
-                }
-                else if ((fp->acad_version_number >= AutoCAD_13)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if ((strcmp (temp_string, "AcDbEntity") != 0)
-                        && ((strcmp (temp_string, "AcDbShape") != 0)))
-                        {
+                        case 2:
+                                /* Now follows a string containing a shape
+                                 * name. */
+                                dxf_free (shape->shape_name);
+                                shape->shape_name = dxf_pair_get_string (&pair);
+                                break;
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                shape->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 6:
+                                /* Now follows a string containing a linetype
+                                 * name. */
+                                dxf_lexer_free_string (fp, properties.linetype);
+                                properties.linetype = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 8:
+                                /* Now follows a string containing a layer name. */
+                                dxf_lexer_free_string (fp, properties.layer);
+                                properties.layer = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 10:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the insertion point. */
+                                shape->x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 20:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the insertion point. */
+                                shape->y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 30:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the insertion point. */
+                                shape->z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 38:
+                                if ((fp->acad_version_number <= AutoCAD_11)
+                                  && (properties.elevation != 0.0))
+                                {
+                                        /* Now follows a string containing the
+                                         * elevation. */
+                                        properties.elevation = dxf_pair_get_double (&pair);
+                                }
+                                break;
+                        case 39:
+                                /* Now follows a string containing the
+                                 * thickness. */
+                                properties.thickness = dxf_pair_get_double (&pair);
+                                break;
+                        case 40:
+                                /* Now follows a string containing the
+                                 * size. */
+                                shape->size = dxf_pair_get_double (&pair);
+                                break;
+                        case 41:
+                                /* Now follows a string containing the
+                                 * relative X scale. */
+                                shape->rel_x_scale = dxf_pair_get_double (&pair);
+                                break;
+                        case 48:
+                                /* Now follows a string containing the linetype
+                                 * scale. */
+                                properties.linetype_scale = dxf_pair_get_double (&pair);
+                                break;
+                        case 50:
+                                /* Now follows a string containing the
+                                 * rotation angle. */
+                                shape->rot_angle = dxf_pair_get_double (&pair);
+                                break;
+                        case 51:
+                                /* Now follows a string containing the
+                                 * oblique angle. */
+                                shape->obl_angle = dxf_pair_get_double (&pair);
+                                break;
+                        case 60:
+                                /* Now follows a string containing the
+                                 * visibility value. */
+                                properties.visibility = dxf_pair_get_int (&pair);
+                                break;
+                        case 62:
+                                /* Now follows a string containing the
+                                 * color value. */
+                                properties.color = dxf_pair_get_int (&pair);
+                                break;
+                        case 67:
+                                /* Now follows a string containing the
+                                 * paperspace value. */
+                                properties.paperspace = dxf_pair_get_int (&pair);
+                                break;
+                        case 100:
+                                if (fp->acad_version_number >= AutoCAD_13)
+                                {
+                                        /* Now follows a string containing the
+                                         * subclass marker value. */
+                                        dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                        if ((strcmp (temp_string, "AcDbEntity") != 0)
+                                        && ((strcmp (temp_string, "AcDbShape") != 0)))
+                                        {
+                                                fprintf (stderr,
+                                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                                  __FUNCTION__, fp->filename, fp->line_number);
+                                        }
+                                }
+                                break;
+                        case 210:
+                                /* Now follows a string containing the
+                                 * X-value of the extrusion vector. */
+                                shape->extr_x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 220:
+                                /* Now follows a string containing the
+                                 * Y-value of the extrusion vector. */
+                                shape->extr_y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 230:
+                                /* Now follows a string containing the
+                                 * Z-value of the extrusion vector. */
+                                shape->extr_z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, shape->dictionary_owner_soft);
+                                shape->dictionary_owner_soft = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, shape->dictionary_owner_hard);
+                                shape->dictionary_owner_hard = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, "DXF comment: %s\n", temp_string);
+                                break;
+                        default:
                                 fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
                                   __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "210") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &shape->extr_x0);
-                }
-                else if (strcmp (temp_string, "220") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &shape->extr_y0);
-                }
-                else if (strcmp (temp_string, "230") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &shape->extr_z0);
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", shape->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", shape->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
         /* Handle omitted members and/or illegal values. */
         if (strcmp (shape->shape_name, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Error in %s () empty name string for the %s entity with id-code: %x\n")),
+                  (_("Error in %s () empty name string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, shape->id_code);
                 return (NULL);
         }
-        if (strcmp (shape->linetype, "") == 0)
+        if ((properties.linetype != NULL)
+          && (strcmp (properties.linetype, "") == 0))
         {
-                shape->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_lexer_free_string (fp, properties.linetype);
+                properties.linetype = dxf_strdup (DXF_DEFAULT_LINETYPE);
         }
-        if (strcmp (shape->layer, "") == 0)
+        if ((properties.layer != NULL)
+          && (strcmp (properties.layer, "") == 0))
         {
-                shape->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_lexer_free_string (fp, properties.layer);
+                properties.layer = dxf_strdup (DXF_DEFAULT_LAYER);
         }
-        /* Clean up. */
-        free (temp_string);
+        /* Entities with equal properties share a record. */
+        dxf_graphic_properties_finish (fp, &shape->properties, &properties);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -444,7 +403,7 @@ dxf_shape_write
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *dxf_entity_name = strdup ("SHAPE");
+        char *dxf_entity_name = dxf_strdup ("SHAPE");
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -453,7 +412,7 @@ dxf_shape_write
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (shape == NULL)
@@ -462,55 +421,63 @@ dxf_shape_write
                   (_("Error in %s () a NULL pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (strcmp (shape->shape_name, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Error in %s () empty name string for the %s entity with id-code: %x\n")),
+                  (_("Error in %s () empty name string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, shape->id_code);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
-        if (strcmp (shape->linetype, "") == 0)
+        if (strcmp (shape->properties->linetype, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, shape->id_code);
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                shape->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                if (dxf_graphic_properties_unshare (&shape->properties) != NULL)
+                {
+                        dxf_free (shape->properties->linetype);
+                        shape->properties->linetype = dxf_strdup (DXF_DEFAULT_LINETYPE);
+                }
         }
-        if (strcmp (shape->layer, "") == 0)
+        if (strcmp (shape->properties->layer, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty layer string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty layer string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, shape->id_code);
                 fprintf (stderr,
                   (_("\t%s entity is relocated to layer 0")),
                   dxf_entity_name);
-                shape->layer = strdup (DXF_DEFAULT_LAYER);
+                if (dxf_graphic_properties_unshare (&shape->properties) != NULL)
+                {
+                        dxf_free (shape->properties->layer);
+                        shape->properties->layer = dxf_strdup (DXF_DEFAULT_LAYER);
+                }
         }
         if (shape->size == 0.0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () size has a value of 0.0 for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () size has a value of 0.0 for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, shape->id_code);
         }
         if (shape->rel_x_scale == 0.0)
         {
                 fprintf (stderr,
-                  (_("Warning: in %s () relative X-scale factor has a value of 0.0 for the %s entity with id-code: %x\n")),
+                  (_("Warning: in %s () relative X-scale factor has a value of 0.0 for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, shape->id_code);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_string (fp, 0, dxf_entity_name);
         if (shape->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", shape->id_code);
+                dxf_write_hex (fp, 5, shape->id_code);
         }
         /*!
          * \todo for version R14.\n
@@ -525,84 +492,84 @@ dxf_shape_write
         if ((strcmp (shape->dictionary_owner_soft, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", shape->dictionary_owner_soft);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, shape->dictionary_owner_soft);
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (shape->dictionary_owner_hard, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", shape->dictionary_owner_hard);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, shape->dictionary_owner_hard);
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbEntity\n");
+                dxf_write_string (fp, 100, "AcDbEntity");
         }
-        if (shape->paperspace == DXF_PAPERSPACE)
+        if (shape->properties->paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp->fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_int (fp, 67, DXF_PAPERSPACE);
         }
-        fprintf (fp->fp, "  8\n%s\n", shape->layer);
-        if (strcmp (shape->linetype, DXF_DEFAULT_LINETYPE) != 0)
+        dxf_write_string (fp, 8, shape->properties->layer);
+        if (strcmp (shape->properties->linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp->fp, "  6\n%s\n", shape->linetype);
+                dxf_write_string (fp, 6, shape->properties->linetype);
         }
         if ((fp->acad_version_number <= AutoCAD_11)
           && DXF_FLATLAND
-          && (shape->elevation != 0.0))
+          && (shape->properties->elevation != 0.0))
         {
-                fprintf (fp->fp, " 38\n%f\n", shape->elevation);
+                dxf_write_double (fp, 38, shape->properties->elevation);
         }
-        if (shape->color != DXF_COLOR_BYLAYER)
+        if (shape->properties->color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp->fp, " 62\n%d\n", shape->color);
+                dxf_write_int (fp, 62, shape->properties->color);
         }
-        if (shape->linetype_scale != 1.0)
+        if (shape->properties->linetype_scale != 1.0)
         {
-                fprintf (fp->fp, " 48\n%f\n", shape->linetype_scale);
+                dxf_write_double (fp, 48, shape->properties->linetype_scale);
         }
-        if (shape->visibility != 0)
+        if (shape->properties->visibility != 0)
         {
-                fprintf (fp->fp, " 60\n%d\n", shape->visibility);
+                dxf_write_int (fp, 60, shape->properties->visibility);
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbShape\n");
+                dxf_write_string (fp, 100, "AcDbShape");
         }
-        if (shape->thickness != 0.0)
+        if (shape->properties->thickness != 0.0)
         {
-                fprintf (fp->fp, " 39\n%f\n", shape->thickness);
+                dxf_write_double (fp, 39, shape->properties->thickness);
         }
-        fprintf (fp->fp, " 10\n%f\n", shape->x0);
-        fprintf (fp->fp, " 20\n%f\n", shape->y0);
-        fprintf (fp->fp, " 30\n%f\n", shape->z0);
-        fprintf (fp->fp, " 40\n%f\n", shape->size);
-        fprintf (fp->fp, "  2\n%s\n", shape->shape_name);
+        dxf_write_double (fp, 10, shape->x0);
+        dxf_write_double (fp, 20, shape->y0);
+        dxf_write_double (fp, 30, shape->z0);
+        dxf_write_double (fp, 40, shape->size);
+        dxf_write_string (fp, 2, shape->shape_name);
         if (shape->rot_angle != 0.0)
         {
-                fprintf (fp->fp, " 50\n%f\n", shape->rot_angle);
+                dxf_write_double (fp, 50, shape->rot_angle);
         }
         if (shape->rel_x_scale != 1.0)
         {
-                fprintf (fp->fp, " 41\n%f\n", shape->rel_x_scale);
+                dxf_write_double (fp, 41, shape->rel_x_scale);
         }
         if (shape->obl_angle != 0.0)
         {
-                fprintf (fp->fp, " 51\n%f\n", shape->obl_angle);
+                dxf_write_double (fp, 51, shape->obl_angle);
         }
         if ((fp->acad_version_number >= AutoCAD_12)
                 && (shape->extr_x0 != 0.0)
                 && (shape->extr_y0 != 0.0)
                 && (shape->extr_z0 != 1.0))
         {
-                fprintf (fp->fp, "210\n%f\n", shape->extr_x0);
-                fprintf (fp->fp, "220\n%f\n", shape->extr_y0);
-                fprintf (fp->fp, "230\n%f\n", shape->extr_z0);
+                dxf_write_double (fp, 210, shape->extr_x0);
+                dxf_write_double (fp, 220, shape->extr_y0);
+                dxf_write_double (fp, 230, shape->extr_z0);
         }
         /* Clean up. */
-        free (dxf_entity_name);
+        dxf_free (dxf_entity_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -641,12 +608,11 @@ dxf_shape_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (shape->shape_name);
-        free (shape->linetype);
-        free (shape->layer);
-        free (shape->dictionary_owner_soft);
-        free (shape->dictionary_owner_hard);
-        free (shape);
+        dxf_free (shape->shape_name);
+        dxf_graphic_properties_free (shape->properties);
+        dxf_free (shape->dictionary_owner_soft);
+        dxf_free (shape->dictionary_owner_hard);
+        dxf_free (shape);
         shape = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -672,7 +638,7 @@ dxf_shape_free_chain
                 /*!< a pointer to the chain of DXF \c SHAPE entities. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (shapes == NULL)
@@ -40,6 +40,9 @@
 
 
 #include "solid.h"
+#include "arena.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -65,7 +68,7 @@ dxf_solid_new ()
         size = sizeof (DxfSolid);
         /* avoid malloc of 0 bytes */
         if (size == 0) size = 1;
-        if ((solid = malloc (size)) == NULL)
+        if ((solid = dxf_malloc (size)) == NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () could not allocate memory for a DxfSolid struct.\n")),
@@ -121,8 +124,7 @@ dxf_solid_init
                 return (NULL);
         }
         solid->id_code = 0;
-        solid->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        solid->layer = strdup (DXF_DEFAULT_LAYER);
+        solid->properties = dxf_graphic_properties_default ();
         solid->x0 = 0.0;
         solid->y0 = 0.0;
         solid->z0 = 0.0;
@@ -138,14 +140,8 @@ dxf_solid_init
         solid->extr_x0 = 0.0;
         solid->extr_y0 = 0.0;
         solid->extr_z0 = 0.0;
-        solid->elevation = 0.0;
-        solid->thickness = 0.0;
-        solid->linetype_scale = DXF_DEFAULT_LINETYPE_SCALE;
-        solid->visibility = DXF_DEFAULT_VISIBILITY;
-        solid->color = DXF_COLOR_BYLAYER;
-        solid->paperspace = DXF_MODELSPACE;
-        solid->dictionary_owner_soft = strdup ("");
-        solid->dictionary_owner_hard = strdup ("");
+        solid->dictionary_owner_soft = dxf_strdup ("");
+        solid->dictionary_owner_hard = dxf_strdup ("");
         solid->next = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -183,7 +179,9 @@ dxf_solid_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfGraphicProperties properties;
+        DxfPair pair;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -191,8 +189,6 @@ dxf_solid_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (solid == NULL)
@@ -203,239 +199,193 @@ dxf_solid_read
                 solid = dxf_solid_new ();
                 solid = dxf_solid_init (solid);
         }
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        dxf_graphic_properties_start (&properties, solid->properties);
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        fclose (fp->fp);
-                        /* Clean up. */
-                        free (temp_string);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &solid->id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", solid->linetype);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", solid->layer);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &solid->x0);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &solid->y0);
-                }
-                else if (strcmp (temp_string, "30") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &solid->z0);
-                }
-                else if (strcmp (temp_string, "11") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &solid->x1);
-                }
-                else if (strcmp (temp_string, "21") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &solid->y1);
-                }
-                else if (strcmp (temp_string, "31") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &solid->z1);
-                }
-                else if (strcmp (temp_string, "12") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &solid->x2);
-                }
-                else if (strcmp (temp_string, "22") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &solid->y2);
-                }
-                else if (strcmp (temp_string, "32") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &solid->z2);
-                }
-                else if (strcmp (temp_string, "13") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &solid->x3);
-                }
-                else if (strcmp (temp_string, "23") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &solid->y3);
-                }
-                else if (strcmp (temp_string, "33") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &solid->z3);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else if ((fp->acad_version_number <= AutoCAD_11)
-                        && (strcmp (temp_string, "38") == 0)
-                        && (solid->elevation != 0.0))
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing the
-                         * elevation. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &solid->elevation);
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &solid->thickness);
-                }
-                else if (strcmp (temp_string, "48") == 0)
-                {
-                        /* Now follows a string containing the linetype
-                         * scale. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &solid->linetype_scale);
-                }
-                else if (strcmp (temp_string, "60") == 0)
-                {
-                        /* Now follows a string containing the
-                         * visibility value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &solid->visibility);
-                }
-                else if (strcmp (temp_string, "62") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &solid->color);
-                }
-                else if (strcmp (temp_string, "67") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &solid->paperspace);
-                }
-                else if ((fp->acad_version_number >= AutoCAD_12)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Subclass markers are post AutoCAD R12
-                         * variable so additional testing for the
-                         * version should probably be added here.
-                         * Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                }
-                else if (strcmp (temp_string, "210") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &solid->extr_x0);
-                }
-                else if (strcmp (temp_string, "220") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &solid->extr_y0);
-                }
-                else if (strcmp (temp_string, "230") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &solid->extr_z0);
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", solid->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", solid->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                solid->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 6:
+                                /* Now follows a string containing a linetype
+                                 * name. */
+                                dxf_lexer_free_string (fp, properties.linetype);
+                                properties.linetype = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 8:
+                                /* Now follows a string containing a layer name. */
+                                dxf_lexer_free_string (fp, properties.layer);
+                                properties.layer = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 10:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the point. */
+                                solid->x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 20:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the point. */
+                                solid->y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 30:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the point. */
+                                solid->z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 11:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the point. */
+                                solid->x1 = dxf_pair_get_double (&pair);
+                                break;
+                        case 21:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the point. */
+                                solid->y1 = dxf_pair_get_double (&pair);
+                                break;
+                        case 31:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the point. */
+                                solid->z1 = dxf_pair_get_double (&pair);
+                                break;
+                        case 12:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the point. */
+                                solid->x2 = dxf_pair_get_double (&pair);
+                                break;
+                        case 22:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the point. */
+                                solid->y2 = dxf_pair_get_double (&pair);
+                                break;
+                        case 32:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the point. */
+                                solid->z2 = dxf_pair_get_double (&pair);
+                                break;
+                        case 13:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the point. */
+                                solid->x3 = dxf_pair_get_double (&pair);
+                                break;
+                        case 23:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the point. */
+                                solid->y3 = dxf_pair_get_double (&pair);
+                                break;
+                        case 33:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the point. */
+                                solid->z3 = dxf_pair_get_double (&pair);
+                                break;
+                        case 38:
+                                if ((fp->acad_version_number <= AutoCAD_11)
+                                  && (properties.elevation != 0.0))
+                                {
+                                        /* Now follows a string containing the
+                                         * elevation. */
+                                        properties.elevation = dxf_pair_get_double (&pair);
+                                }
+                                break;
+                        case 39:
+                                /* Now follows a string containing the
+                                 * thickness. */
+                                properties.thickness = dxf_pair_get_double (&pair);
+                                break;
+                        case 48:
+                                /* Now follows a string containing the linetype
+                                 * scale. */
+                                properties.linetype_scale = dxf_pair_get_double (&pair);
+                                break;
+                        case 60:
+                                /* Now follows a string containing the
+                                 * visibility value. */
+                                properties.visibility = dxf_pair_get_int (&pair);
+                                break;
+                        case 62:
+                                /* Now follows a string containing the
+                                 * color value. */
+                                properties.color = dxf_pair_get_int (&pair);
+                                break;
+                        case 67:
+                                /* Now follows a string containing the
+                                 * paperspace value. */
+                                properties.paperspace = dxf_pair_get_int (&pair);
+                                break;
+                        case 100:
+                                if (fp->acad_version_number >= AutoCAD_12)
+                                {
+                                        /* Subclass markers are post AutoCAD R12
+                                         * variable so additional testing for the
+                                         * version should probably be added here.
+                                         * Now follows a string containing the
+                                         * subclass marker value. */
+                                        dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                }
+                                break;
+                        case 210:
+                                /* Now follows a string containing the
+                                 * X-value of the extrusion vector. */
+                                solid->extr_x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 220:
+                                /* Now follows a string containing the
+                                 * Y-value of the extrusion vector. */
+                                solid->extr_y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 230:
+                                /* Now follows a string containing the
+                                 * Z-value of the extrusion vector. */
+                                solid->extr_z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, solid->dictionary_owner_soft);
+                                solid->dictionary_owner_soft = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, solid->dictionary_owner_hard);
+                                solid->dictionary_owner_hard = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, "DXF comment: %s\n", temp_string);
+                                break;
+                        default:
+                                fprintf (stderr,
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
+                                  __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
         /* Handle omitted members and/or illegal values. */
-        if (strcmp (solid->linetype, "") == 0)
+        if ((properties.linetype != NULL)
+          && (strcmp (properties.linetype, "") == 0))
         {
-                solid->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_lexer_free_string (fp, properties.linetype);
+                properties.linetype = dxf_strdup (DXF_DEFAULT_LINETYPE);
         }
-        if (strcmp (solid->layer, "") == 0)
+        if ((properties.layer != NULL)
+          && (strcmp (properties.layer, "") == 0))
         {
-                solid->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_lexer_free_string (fp, properties.layer);
+                properties.layer = dxf_strdup (DXF_DEFAULT_LAYER);
         }
-        /* Clean up. */
-        free (temp_string);
+        /* Entities with equal properties share a record. */
+        dxf_graphic_properties_finish (fp, &solid->properties, &properties);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -467,7 +417,7 @@ dxf_solid_write
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *dxf_entity_name = strdup ("SOLID");
+        char *dxf_entity_name = dxf_strdup ("SOLID");
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -476,7 +426,7 @@ dxf_solid_write
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (solid == NULL)
@@ -485,34 +435,42 @@ dxf_solid_write
                   (_("Error in %s () a NULL pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
-        if (strcmp (solid->linetype, "") == 0)
+        if (strcmp (solid->properties->linetype, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, solid->id_code);
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                solid->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                if (dxf_graphic_properties_unshare (&solid->properties) != NULL)
+                {
+                        dxf_free (solid->properties->linetype);
+                        solid->properties->linetype = dxf_strdup (DXF_DEFAULT_LINETYPE);
+                }
         }
-        if (strcmp (solid->layer, "") == 0)
+        if (strcmp (solid->properties->layer, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty layer string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty layer string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, solid->id_code);
                 fprintf (stderr,
                   (_("\t%s entity is relocated to layer 0")),
                   dxf_entity_name);
-                solid->layer = strdup (DXF_DEFAULT_LAYER);
+                if (dxf_graphic_properties_unshare (&solid->properties) != NULL)
+                {
+                        dxf_free (solid->properties->layer);
+                        solid->properties->layer = dxf_strdup (DXF_DEFAULT_LAYER);
+                }
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_string (fp, 0, dxf_entity_name);
         if (solid->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", solid->id_code);
+                dxf_write_hex (fp, 5, solid->id_code);
         }
         /*!
          * \todo for version R14.\n
@@ -527,79 +485,79 @@ dxf_solid_write
         if ((strcmp (solid->dictionary_owner_soft, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", solid->dictionary_owner_soft);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, solid->dictionary_owner_soft);
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (solid->dictionary_owner_hard, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", solid->dictionary_owner_hard);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, solid->dictionary_owner_hard);
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbEntity\n");
+                dxf_write_string (fp, 100, "AcDbEntity");
         }
-        if (solid->paperspace == DXF_PAPERSPACE)
+        if (solid->properties->paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp->fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_int (fp, 67, DXF_PAPERSPACE);
         }
-        fprintf (fp->fp, "  8\n%s\n", solid->layer);
-        if (strcmp (solid->linetype, DXF_DEFAULT_LINETYPE) != 0)
+        dxf_write_string (fp, 8, solid->properties->layer);
+        if (strcmp (solid->properties->linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp->fp, "  6\n%s\n", solid->linetype);
+                dxf_write_string (fp, 6, solid->properties->linetype);
         }
         if ((fp->acad_version_number <= AutoCAD_11)
           && DXF_FLATLAND
-          && (solid->elevation != 0.0))
+          && (solid->properties->elevation != 0.0))
         {
-                fprintf (fp->fp, " 38\n%f\n", solid->elevation);
+                dxf_write_double (fp, 38, solid->properties->elevation);
         }
-        if (solid->color != DXF_COLOR_BYLAYER)
+        if (solid->properties->color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp->fp, " 62\n%d\n", solid->color);
+                dxf_write_int (fp, 62, solid->properties->color);
         }
-        if (solid->linetype_scale != 1.0)
+        if (solid->properties->linetype_scale != 1.0)
         {
-                fprintf (fp->fp, " 48\n%f\n", solid->linetype_scale);
+                dxf_write_double (fp, 48, solid->properties->linetype_scale);
         }
-        if (solid->visibility != 0)
+        if (solid->properties->visibility != 0)
         {
-                fprintf (fp->fp, " 60\n%d\n", solid->visibility);
+                dxf_write_int (fp, 60, solid->properties->visibility);
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbTrace\n");
+                dxf_write_string (fp, 100, "AcDbTrace");
         }
-        fprintf (fp->fp, " 10\n%f\n", solid->x0);
-        fprintf (fp->fp, " 20\n%f\n", solid->y0);
-        fprintf (fp->fp, " 30\n%f\n", solid->z0);
-        fprintf (fp->fp, " 11\n%f\n", solid->x1);
-        fprintf (fp->fp, " 21\n%f\n", solid->y1);
-        fprintf (fp->fp, " 31\n%f\n", solid->z1);
-        fprintf (fp->fp, " 12\n%f\n", solid->x2);
-        fprintf (fp->fp, " 22\n%f\n", solid->y2);
-        fprintf (fp->fp, " 32\n%f\n", solid->z2);
-        fprintf (fp->fp, " 13\n%f\n", solid->x3);
-        fprintf (fp->fp, " 23\n%f\n", solid->y3);
-        fprintf (fp->fp, " 33\n%f\n", solid->z3);
-        if (solid->thickness != 0.0)
+        dxf_write_double (fp, 10, solid->x0);
+        dxf_write_double (fp, 20, solid->y0);
+        dxf_write_double (fp, 30, solid->z0);
+        dxf_write_double (fp, 11, solid->x1);
+        dxf_write_double (fp, 21, solid->y1);
+        dxf_write_double (fp, 31, solid->z1);
+        dxf_write_double (fp, 12, solid->x2);
+        dxf_write_double (fp, 22, solid->y2);
+        dxf_write_double (fp, 32, solid->z2);
+        dxf_write_double (fp, 13, solid->x3);
+        dxf_write_double (fp, 23, solid->y3);
+        dxf_write_double (fp, 33, solid->z3);
+        if (solid->properties->thickness != 0.0)
         {
-                fprintf (fp->fp, " 39\n%f\n", solid->thickness);
+                dxf_write_double (fp, 39, solid->properties->thickness);
         }
         if ((fp->acad_version_number >= AutoCAD_12)
                 && (solid->extr_x0 != 0.0)
                 && (solid->extr_y0 != 0.0)
                 && (solid->extr_z0 != 1.0))
         {
-                fprintf (fp->fp, "210\n%f\n", solid->extr_x0);
-                fprintf (fp->fp, "220\n%f\n", solid->extr_y0);
-                fprintf (fp->fp, "230\n%f\n", solid->extr_z0);
+                dxf_write_double (fp, 210, solid->extr_x0);
+                dxf_write_double (fp, 220, solid->extr_y0);
+                dxf_write_double (fp, 230, solid->extr_z0);
         }
         /* Clean up. */
-        free (dxf_entity_name);
+        dxf_free (dxf_entity_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -638,11 +596,10 @@ dxf_solid_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (solid->linetype);
-        free (solid->layer);
-        free (solid->dictionary_owner_soft);
-        free (solid->dictionary_owner_hard);
-        free (solid);
+        dxf_graphic_properties_free (solid->properties);
+        dxf_free (solid->dictionary_owner_soft);
+        dxf_free (solid->dictionary_owner_hard);
+        dxf_free (solid);
         solid = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -668,7 +625,7 @@ dxf_solid_free_chain
                 /*!< pointer to the chain of DXF \c SOLID entities. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (solids == NULL)
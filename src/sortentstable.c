@@ -35,6 +35,9 @@
 
 
 #include "sortentstable.h"
+#include "arena.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -101,8 +104,6 @@ dxf_sortentstable_init
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        int i;
-
         /* Do some basic checks. */
         if (sortentstable == NULL)
         {
@@ -122,11 +123,12 @@ dxf_sortentstable_init
         sortentstable->dictionary_owner_soft = strdup ("");
         sortentstable->dictionary_owner_hard = strdup ("");
         sortentstable->block_owner = strdup ("");
-        for (i = 0; i < DXF_MAX_PARAM; i++)
-        {
-                sortentstable->entity_owner[i] = strdup ("");
-                sortentstable->sort_handle[i] = 0;
-        }
+        sortentstable->entity_owner = NULL;
+        sortentstable->number_of_entity_owners = 0;
+        sortentstable->entity_owner_capacity = 0;
+        sortentstable->sort_handle = NULL;
+        sortentstable->number_of_sort_handles = 0;
+        sortentstable->sort_handle_capacity = 0;
         sortentstable->next = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -164,10 +166,11 @@ dxf_sortentstable_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
-        int i;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfPair pair;
         int j;
-        int k;
+        char **entity_owners;
+        int *sort_handles;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -175,8 +178,6 @@ dxf_sortentstable_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (fp->acad_version_number < AutoCAD_14)
@@ -193,106 +194,108 @@ dxf_sortentstable_read
                 sortentstable = dxf_sortentstable_new ();
                 sortentstable = dxf_sortentstable_init (sortentstable);
         }
-        i = 0;
         j = 0;
-        k = 0;
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
+                if (pair.group_code == 0)
                 {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        /* Clean up. */
-                        free (temp_string);
-                        fclose (fp->fp);
-                        return (NULL);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                if ((strcmp (temp_string, "5") == 0)
-                  && (k == 0))
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &sortentstable->id_code);
-                }
-                if ((strcmp (temp_string, "5") == 0)
-                  && (i > 0))
-                {
-                        /* Now follows a string containing a Sort handle
-                         * (zero or more entries may exist). */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &sortentstable->sort_handle[i]);
-                }
-                else if ((fp->acad_version_number >= AutoCAD_13)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "AcDbSortentsTable") != 0)
-                        {
+                        case 5:
+                                if (sortentstable->number_of_entity_owners == 0)
+                                {
+                                        /* Now follows a string containing a sequential
+                                         * id number. */
+                                        sortentstable->id_code = dxf_pair_get_hex (&pair);
+                                        break;
+                                }
+                                /* Now follows a string containing a Sort handle
+                                 * (zero or more entries may exist). */
+                                sort_handles = dxf_array_reserve (sortentstable->sort_handle,
+                                  sortentstable->number_of_sort_handles,
+                                  &sortentstable->sort_handle_capacity,
+                                  sortentstable->number_of_sort_handles + 1,
+                                  sizeof (int));
+                                if (sort_handles != NULL)
+                                {
+                                        sortentstable->sort_handle = sort_handles;
+                                        sortentstable->sort_handle[sortentstable->number_of_sort_handles] = dxf_pair_get_hex (&pair);
+                                        sortentstable->number_of_sort_handles++;
+                                }
+                                break;
+                        case 100:
+                                if (fp->acad_version_number >= AutoCAD_13)
+                                {
+                                        /* Now follows a string containing the
+                                         * subclass marker value. */
+                                        dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                        if (strcmp (temp_string, "AcDbSortentsTable") != 0)
+                                        {
+                                                fprintf (stderr,
+                                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                                  __FUNCTION__, fp->filename, fp->line_number);
+                                        }
+                                }
+                                break;
+                        case 330:
+                                if (j == 0)
+                                {
+                                        /* Now follows a string containing a soft-pointer
+                                         * ID/handle to owner dictionary. */
+                                        free (sortentstable->dictionary_owner_soft);
+                                        sortentstable->dictionary_owner_soft = dxf_pair_get_string (&pair);
+                                        j++;
+                                }
+                                else if (j > 0)
+                                {
+                                        /* Now follows a string containing a soft pointer
+                                         * ID/handle to owner (currently only the
+                                         * *MODEL_SPACE or *PAPER_SPACE blocks). */
+                                        free (sortentstable->block_owner);
+                                        sortentstable->block_owner = dxf_pair_get_string (&pair);
+                                        j++;
+                                        /*! \todo Check for overrun of array index. */
+                                }
+                                break;
+                        case 331:
+                                /* Now follows a string containing a soft pointer
+                                 * ID/handle to an entity (zero or more entries
+                                 * may exist). */
+                                entity_owners = dxf_array_reserve (sortentstable->entity_owner,
+                                  sortentstable->number_of_entity_owners,
+                                  &sortentstable->entity_owner_capacity,
+                                  sortentstable->number_of_entity_owners + 1,
+                                  sizeof (char *));
+                                if (entity_owners != NULL)
+                                {
+                                        sortentstable->entity_owner = entity_owners;
+                                        sortentstable->entity_owner[sortentstable->number_of_entity_owners] = dxf_pair_get_string (&pair);
+                                        sortentstable->number_of_entity_owners++;
+                                }
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                free (sortentstable->dictionary_owner_hard);
+                                sortentstable->dictionary_owner_hard = dxf_pair_get_string (&pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, (_("DXF comment: %s\n")), temp_string);
+                                break;
+                        default:
                                 fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
                                   __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if ((strcmp (temp_string, "330") == 0)
-                  && (j == 0))
-                {
-                        /* Now follows a string containing a soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", sortentstable->dictionary_owner_soft);
-                        j++;
-                }
-                else if ((strcmp (temp_string, "330") == 0)
-                  && (j > 0))
-                {
-                        /* Now follows a string containing a soft pointer
-                         * ID/handle to owner (currently only the
-                         * *MODEL_SPACE or *PAPER_SPACE blocks). */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", sortentstable->block_owner);
-                        j++;
-                        /*! \todo Check for overrun of array index. */
-                }
-                else if (strcmp (temp_string, "331") == 0)
-                {
-                        /* Now follows a string containing a soft pointer
-                         * ID/handle to an entity (zero or more entries
-                         * may exist). */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", sortentstable->entity_owner[k]);
-                        k++;
-                        /*! \todo Check for overrun of array index. */
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", sortentstable->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, (_("DXF comment: %s\n")), temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
-        /* Clean up. */
-        free (temp_string);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -349,14 +352,14 @@ dxf_sortentstable_write
         if (fp->acad_version_number < AutoCAD_14)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () illegal DXF version for this %s entity with id-code: %x.\n")),
+                  (_("Warning in %s () illegal DXF version for this %s entity with id-code: %lx.\n")),
                   __FUNCTION__, dxf_entity_name, sortentstable->id_code);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_string (fp, 0, dxf_entity_name);
         if (sortentstable->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", sortentstable->id_code);
+                dxf_write_hex (fp, 5, sortentstable->id_code);
         }
         /*!
          * \todo for version R14.\n
@@ -371,37 +374,29 @@ dxf_sortentstable_write
         if ((strcmp (sortentstable->dictionary_owner_soft, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", sortentstable->dictionary_owner_soft);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, sortentstable->dictionary_owner_soft);
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (sortentstable->dictionary_owner_hard, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", sortentstable->dictionary_owner_hard);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, sortentstable->dictionary_owner_hard);
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbSortentsTable\n");
+                dxf_write_string (fp, 100, "AcDbSortentsTable");
         }
-        fprintf (fp->fp, "330\n%s\n", sortentstable->block_owner);
-        i = 0;
-        while (strlen (sortentstable->entity_owner[i]) > 0)
+        dxf_write_string (fp, 330, sortentstable->block_owner);
+        for (i = 0; i < sortentstable->number_of_entity_owners; i++)
         {
-                fprintf (fp->fp, "331\n%s\n", sortentstable->entity_owner[i]);
-                i++;
-                /*! \todo Check for overrun of array index. */
+                dxf_write_string (fp, 331, sortentstable->entity_owner[i]);
         }
-        for (i = 1; i < DXF_MAX_PARAM; i++)
+        for (i = 0; i < sortentstable->number_of_sort_handles; i++)
         {
-                /* For the stort_Handle index i has a range from 1 to
-                 * (DXF_MAX_PARAM - 1). */
-                fprintf (fp->fp, "  5\n%x\n", sortentstable->sort_handle[i]);
-                /*! \bug We have to find a way to get an idea how many
-                 * handles contain a valid value, this for-loop will
-                 * lead to inflated DXF files and structures. */
+                dxf_write_hex (fp, 5, sortentstable->sort_handle[i]);
         }
         /* Clean up. */
         free (dxf_entity_name);
@@ -449,10 +444,12 @@ dxf_sortentstable_free
         free (sortentstable->dictionary_owner_soft);
         free (sortentstable->dictionary_owner_hard);
         free (sortentstable->block_owner);
-        for (i = 0; i < DXF_MAX_PARAM; i++)
+        for (i = 0; i < sortentstable->number_of_entity_owners; i++)
         {
                 free (sortentstable->entity_owner[i]);
         }
+        dxf_free (sortentstable->entity_owner);
+        dxf_free (sortentstable->sort_handle);
         free (sortentstable);
         sortentstable = NULL;
 #if DEBUG
@@ -480,7 +477,7 @@ dxf_sortentstable_free_chain
                  * objects. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (sortentstables == NULL)
@@ -59,7 +59,7 @@ typedef struct
 dxf_sortentstable
 {
         /* Members common for all DXF objects. */
-        int id_code;
+        long id_code;
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file.\n
@@ -76,13 +76,23 @@ dxf_sortentstable
                 /*!< Soft pointer ID/handle to owner (currently only the
                  * *MODEL_SPACE or *PAPER_SPACE blocks).\n
                  * Group code = 330. */
-        char *entity_owner[DXF_MAX_PARAM];
+        char **entity_owner;
                 /*!< Soft pointer ID/handle to an entity (zero or more
-                 * entries may exist).\n
+                 * entries may exist), \c number_of_entity_owners
+                 * entries.\n
                  * Group code = 331. */
-        int sort_handle[DXF_MAX_PARAM];
-                /*!< Sort handle (zero or more entries may exist).\n
+        int number_of_entity_owners;
+                /*!< Number of entries in \c entity_owner. */
+        int entity_owner_capacity;
+                /*!< Number of entries \c entity_owner has room for. */
+        int *sort_handle;
+                /*!< Sort handle (zero or more entries may exist),
+                 * \c number_of_sort_handles entries.\n
                  * Group code = 5. */
+        int number_of_sort_handles;
+                /*!< Number of entries in \c sort_handle. */
+        int sort_handle_capacity;
+                /*!< Number of entries \c sort_handle has room for. */
         struct DxfSortentsTable *next;
                 /*!< Pointer to the next DxfSortentsTable.\n
                  * \c NULL in the last DxfSortentsTable. */
@@ -35,6 +35,9 @@
 
 
 #include "spatial_filter.h"
+#include "arena.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -138,11 +141,12 @@ dxf_spatial_filter_init
                 spatial_filter->inverse_block_transformation[i] = 0.0;
                 spatial_filter->block_transformation[i] = 0.0;
         }
-        for (i = 0; i < DXF_MAX_PARAM; i++)
-        {
-                spatial_filter->x0[i] = 0.0;
-                spatial_filter->y0[i] = 0.0;
-        }
+        spatial_filter->x0 = NULL;
+        spatial_filter->number_of_x0_values = 0;
+        spatial_filter->x0_capacity = 0;
+        spatial_filter->y0 = NULL;
+        spatial_filter->number_of_y0_values = 0;
+        spatial_filter->y0_capacity = 0;
         spatial_filter->next = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -180,10 +184,11 @@ dxf_spatial_filter_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfPair pair;
         int i;
-        int j;
         int k;
+        double *values;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -191,8 +196,6 @@ dxf_spatial_filter_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (fp->acad_version_number < AutoCAD_14)
@@ -210,205 +213,202 @@ dxf_spatial_filter_read
                 spatial_filter = dxf_spatial_filter_init (spatial_filter);
         }
         i = 0;
-        j = 0;
         k = 0;
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        /* Clean up. */
-                        free (temp_string);
-                        fclose (fp->fp);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &spatial_filter->id_code);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the clip boundary definition point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &spatial_filter->x0[i]);
-                        i++;
-                }
-                else if (strcmp (temp_string, "11") == 0)
-                {
-                        /* Now follows a string containing the X-value
-                         * of the origin used to define the local
-                         * coordinate system of the clip boundary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &spatial_filter->x1);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the clip boundary definition point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &spatial_filter->y0[j]);
-                        j++;
-                }
-                else if (strcmp (temp_string, "21") == 0)
-                {
-                        /* Now follows a string containing the Y-value
-                         * of the origin used to define the local
-                         * coordinate system of the clip boundary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &spatial_filter->y1);
-                }
-                else if (strcmp (temp_string, "31") == 0)
-                {
-                        /* Now follows a string containing the Z-value
-                         * of the origin used to define the local
-                         * coordinate system of the clip boundary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &spatial_filter->z1);
-                }
-                else if ((strcmp (temp_string, "40") == 0)
-                  && (k == 0)
-                  && (spatial_filter->front_clipping_plane_flag == 1))
-                {
-                        /* Now follows a string containing the front
-                         * clipping plane distance. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &spatial_filter->front_clipping_plane_distance);
-                        k++;
-                }
-                else if ((strcmp (temp_string, "40") == 0)
-                  && (k > 0)
-                  && (k < 13)) /* k = 1 ... 12. */
-                {
-                        /* Now follows a string containing an element of
-                         * the 4x3 inverse transformation matrix. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &spatial_filter->inverse_block_transformation[(k - 1)]);
-                        k++;
-                }
-                else if ((strcmp (temp_string, "40") == 0)
-                  && (k >= 13)) /* k = 13 ...25. */
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing an element of
-                         * the 4x3 transformation matrix. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &spatial_filter->block_transformation[(k - 13)]);
-                        k++;
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else if ((strcmp (temp_string, "41") == 0)
-                  && (spatial_filter->back_clipping_plane_flag == 1))
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing the back
-                         * clipping plane distance. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &spatial_filter->back_clipping_plane_distance);
-                        i++;
-                }
-                else if (strcmp (temp_string, "70") == 0)
-                {
-                        /* Now follows a string containing the
-                         * number of points. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &spatial_filter->number_of_points);
-                }
-                else if (strcmp (temp_string, "71") == 0)
-                {
-                        /* Now follows a string containing the clip
-                         * boundary display enabled flag. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &spatial_filter->clip_boundary_display_flag);
-                }
-                else if (strcmp (temp_string, "72") == 0)
-                {
-                        /* Now follows a string containing the front
-                         * clipping plane flag. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &spatial_filter->front_clipping_plane_flag);
-                }
-                else if (strcmp (temp_string, "73") == 0)
-                {
-                        /* Now follows a string containing the back
-                         * clipping plane flag. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &spatial_filter->back_clipping_plane_flag);
-                }
-                else if ((fp->acad_version_number >= AutoCAD_13)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if ((strcmp (temp_string, "AcDbFilter") != 0)
-                          && (strcmp (temp_string, "AcDbSpatialFilter") != 0))
-                        {
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                spatial_filter->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 10:
+                                /* Now follows a string containing the
+                                 * X-value of the clip boundary definition point. */
+                                values = dxf_array_reserve (spatial_filter->x0,
+                                  spatial_filter->number_of_x0_values,
+                                  &spatial_filter->x0_capacity,
+                                  spatial_filter->number_of_x0_values + 1,
+                                  sizeof (double));
+                                if (values != NULL)
+                                {
+                                        spatial_filter->x0 = values;
+                                        spatial_filter->x0[spatial_filter->number_of_x0_values] = dxf_pair_get_double (&pair);
+                                        spatial_filter->number_of_x0_values++;
+                                }
+                                break;
+                        case 11:
+                                /* Now follows a string containing the X-value
+                                 * of the origin used to define the local
+                                 * coordinate system of the clip boundary. */
+                                spatial_filter->x1 = dxf_pair_get_double (&pair);
+                                break;
+                        case 20:
+                                /* Now follows a string containing the
+                                 * Y-value of the clip boundary definition point. */
+                                values = dxf_array_reserve (spatial_filter->y0,
+                                  spatial_filter->number_of_y0_values,
+                                  &spatial_filter->y0_capacity,
+                                  spatial_filter->number_of_y0_values + 1,
+                                  sizeof (double));
+                                if (values != NULL)
+                                {
+                                        spatial_filter->y0 = values;
+                                        spatial_filter->y0[spatial_filter->number_of_y0_values] = dxf_pair_get_double (&pair);
+                                        spatial_filter->number_of_y0_values++;
+                                }
+                                break;
+                        case 21:
+                                /* Now follows a string containing the Y-value
+                                 * of the origin used to define the local
+                                 * coordinate system of the clip boundary. */
+                                spatial_filter->y1 = dxf_pair_get_double (&pair);
+                                break;
+                        case 31:
+                                /* Now follows a string containing the Z-value
+                                 * of the origin used to define the local
+                                 * coordinate system of the clip boundary. */
+                                spatial_filter->z1 = dxf_pair_get_double (&pair);
+                                break;
+                        case 40:
+                                if ((k == 0)
+                                  && (spatial_filter->front_clipping_plane_flag == 1))
+                                {
+                                        /* Now follows a string containing the front
+                                         * clipping plane distance. */
+                                        spatial_filter->front_clipping_plane_distance = dxf_pair_get_double (&pair);
+                                        k++;
+                                }
+                                else if ((k > 0)
+                                  && (k < 13))
+                                {
+                                        /* Now follows a string containing an element of
+                                         * the 4x3 inverse transformation matrix. */
+                                        spatial_filter->inverse_block_transformation[(k - 1)] = dxf_pair_get_double (&pair);
+                                        k++;
+                                }
+                                else if (k >= 13)
+                                {
+                                        /* Now follows a string containing an element of
+                                         * the 4x3 transformation matrix. */
+                                        spatial_filter->block_transformation[(k - 13)] = dxf_pair_get_double (&pair);
+                                        k++;
+                                }
+                                break;
+                        case 41:
+                                if (spatial_filter->back_clipping_plane_flag == 1)
+                                {
+                                        /* Now follows a string containing the back
+                                         * clipping plane distance. */
+                                        spatial_filter->back_clipping_plane_distance = dxf_pair_get_double (&pair);
+                                        i++;
+                                }
+                                break;
+                        case 70:
+                                /* Now follows a string containing the
+                                 * number of points. */
+                                spatial_filter->number_of_points = dxf_pair_get_int (&pair);
+                                /* Room for the points which follow. */
+                                values = dxf_array_reserve (spatial_filter->x0,
+                                  spatial_filter->number_of_x0_values,
+                                  &spatial_filter->x0_capacity,
+                                  spatial_filter->number_of_points,
+                                  sizeof (double));
+                                if (values != NULL)
+                                {
+                                        spatial_filter->x0 = values;
+                                }
+                                values = dxf_array_reserve (spatial_filter->y0,
+                                  spatial_filter->number_of_y0_values,
+                                  &spatial_filter->y0_capacity,
+                                  spatial_filter->number_of_points,
+                                  sizeof (double));
+                                if (values != NULL)
+                                {
+                                        spatial_filter->y0 = values;
+                                }
+                                break;
+                        case 71:
+                                /* Now follows a string containing the clip
+                                 * boundary display enabled flag. */
+                                spatial_filter->clip_boundary_display_flag = dxf_pair_get_int (&pair);
+                                break;
+                        case 72:
+                                /* Now follows a string containing the front
+                                 * clipping plane flag. */
+                                spatial_filter->front_clipping_plane_flag = dxf_pair_get_int (&pair);
+                                break;
+                        case 73:
+                                /* Now follows a string containing the back
+                                 * clipping plane flag. */
+                                spatial_filter->back_clipping_plane_flag = dxf_pair_get_int (&pair);
+                                break;
+                        case 100:
+                                if (fp->acad_version_number >= AutoCAD_13)
+                                {
+                                        /* Now follows a string containing the
+                                         * subclass marker value. */
+                                        dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                        if ((strcmp (temp_string, "AcDbFilter") != 0)
+                                          && (strcmp (temp_string, "AcDbSpatialFilter") != 0))
+                                        {
+                                                fprintf (stderr,
+                                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                                  __FUNCTION__, fp->filename, fp->line_number);
+                                        }
+                                }
+                                break;
+                        case 210:
+                                /* Now follows a string containing the X-value
+                                 * of the normal to the plane containing the
+                                 * clip boundary. */
+                                spatial_filter->extr_x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 220:
+                                /* Now follows a string containing the Y-value
+                                 * of the normal to the plane containing the
+                                 * clip boundary. */
+                                spatial_filter->extr_y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 230:
+                                /* Now follows a string containing the
+                                 * Z-value of the extrusion vector. */
+                                spatial_filter->extr_z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 330:
+                                /* Now follows a string containing the Z-value
+                                 * of the normal to the plane containing the
+                                 * clip boundary. */
+                                free (spatial_filter->dictionary_owner_soft);
+                                spatial_filter->dictionary_owner_soft = dxf_pair_get_string (&pair);
+                                i++;
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                free (spatial_filter->dictionary_owner_hard);
+                                spatial_filter->dictionary_owner_hard = dxf_pair_get_string (&pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, (_("DXF comment: %s\n")), temp_string);
+                                break;
+                        default:
                                 fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
                                   __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "210") == 0)
-                {
-                        /* Now follows a string containing the X-value
-                         * of the normal to the plane containing the
-                         * clip boundary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &spatial_filter->extr_x0);
-                }
-                else if (strcmp (temp_string, "220") == 0)
-                {
-                        /* Now follows a string containing the Y-value
-                         * of the normal to the plane containing the
-                         * clip boundary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &spatial_filter->extr_y0);
-                }
-                else if (strcmp (temp_string, "230") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &spatial_filter->extr_z0);
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing the Z-value
-                         * of the normal to the plane containing the
-                         * clip boundary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", spatial_filter->dictionary_owner_soft);
-                        i++;
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", spatial_filter->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, (_("DXF comment: %s\n")), temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
-        /* Clean up. */
-        free (temp_string);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -468,7 +468,7 @@ dxf_spatial_filter_write
                   (_("Error in %s () number of the clip boundary definition points is too small.\n")),
                   __FUNCTION__);
                 fprintf (stderr,
-                  (_("\tThe %s object with id-code %x is dropped from output.\n")),
+                  (_("\tThe %s object with id-code %lx is dropped from output.\n")),
                   dxf_entity_name, spatial_filter->id_code);
                 /* Clean up. */
                 free (dxf_entity_name);
@@ -477,14 +477,14 @@ dxf_spatial_filter_write
         if (fp->acad_version_number < AutoCAD_14)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () illegal DXF version for this %s entity with id-code: %x.\n")),
+                  (_("Warning in %s () illegal DXF version for this %s entity with id-code: %lx.\n")),
                   __FUNCTION__, dxf_entity_name, spatial_filter->id_code);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_string (fp, 0, dxf_entity_name);
         if (spatial_filter->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", spatial_filter->id_code);
+                dxf_write_hex (fp, 5, spatial_filter->id_code);
         }
         /*!
          * \todo for version R14.\n
@@ -499,60 +499,61 @@ dxf_spatial_filter_write
         if ((strcmp (spatial_filter->dictionary_owner_soft, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", spatial_filter->dictionary_owner_soft);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, spatial_filter->dictionary_owner_soft);
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (spatial_filter->dictionary_owner_hard, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", spatial_filter->dictionary_owner_hard);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, spatial_filter->dictionary_owner_hard);
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbFilter\n");
-                fprintf (fp->fp, "100\nAcDbSpatialFilter\n");
+                dxf_write_string (fp, 100, "AcDbFilter");
+                dxf_write_string (fp, 100, "AcDbSpatialFilter");
         }
-        fprintf (fp->fp, " 70\n%d\n", spatial_filter->number_of_points);
+        dxf_write_int (fp, 70, spatial_filter->number_of_points);
         for (i = 0; i < spatial_filter->number_of_points; i++)
         {
-                fprintf (fp->fp, " 10\n%f\n", spatial_filter->x0[i]);
-                fprintf (fp->fp, " 20\n%f\n", spatial_filter->y0[i]);
                 /*! \warning We do rely on a correct number of clip
                  * boundary definition points in the instnce of the
                  * DxfSpatialFilter struct.\n
-                 * It is possible to run into a part of the array where
-                 * initial values (0.0) are present. */
+                 * Points which were not read are written as 0.0. */
+                dxf_write_double (fp, 10,
+                  (i < spatial_filter->number_of_x0_values) ? spatial_filter->x0[i] : 0.0);
+                dxf_write_double (fp, 20,
+                  (i < spatial_filter->number_of_y0_values) ? spatial_filter->y0[i] : 0.0);
         }
         if ((fp->acad_version_number >= AutoCAD_12)
                 && (spatial_filter->extr_x0 != 0.0)
                 && (spatial_filter->extr_y0 != 0.0)
                 && (spatial_filter->extr_z0 != 1.0))
         {
-                fprintf (fp->fp, "210\n%f\n", spatial_filter->extr_x0);
-                fprintf (fp->fp, "220\n%f\n", spatial_filter->extr_y0);
-                fprintf (fp->fp, "230\n%f\n", spatial_filter->extr_z0);
+                dxf_write_double (fp, 210, spatial_filter->extr_x0);
+                dxf_write_double (fp, 220, spatial_filter->extr_y0);
+                dxf_write_double (fp, 230, spatial_filter->extr_z0);
         }
-        fprintf (fp->fp, " 71\n%d\n", spatial_filter->clip_boundary_display_flag);
-        fprintf (fp->fp, " 72\n%d\n", spatial_filter->front_clipping_plane_flag);
+        dxf_write_int (fp, 71, spatial_filter->clip_boundary_display_flag);
+        dxf_write_int (fp, 72, spatial_filter->front_clipping_plane_flag);
         if (spatial_filter->front_clipping_plane_flag)
         {
-                fprintf (fp->fp, " 40\n%f\n", spatial_filter->front_clipping_plane_distance);
+                dxf_write_double (fp, 40, spatial_filter->front_clipping_plane_distance);
         }
-        fprintf (fp->fp, " 73\n%d\n", spatial_filter->back_clipping_plane_flag);
+        dxf_write_int (fp, 73, spatial_filter->back_clipping_plane_flag);
         if (spatial_filter->back_clipping_plane_flag)
         {
-                fprintf (fp->fp, " 41\n%f\n", spatial_filter->back_clipping_plane_distance);
+                dxf_write_double (fp, 41, spatial_filter->back_clipping_plane_distance);
         }
         for (i = 0; i < 12; i++)
         {
-                fprintf (fp->fp, " 40\n%f\n", spatial_filter->inverse_block_transformation[i]);
+                dxf_write_double (fp, 40, spatial_filter->inverse_block_transformation[i]);
         }
         for (i = 0; i < 12; i++)
         {
-                fprintf (fp->fp, " 40\n%f\n", spatial_filter->block_transformation[i]);
+                dxf_write_double (fp, 40, spatial_filter->block_transformation[i]);
         }
         /* Clean up. */
         free (dxf_entity_name);
@@ -597,6 +598,8 @@ dxf_spatial_filter_free
         }
         free (spatial_filter->dictionary_owner_soft);
         free (spatial_filter->dictionary_owner_hard);
+        dxf_free (spatial_filter->x0);
+        dxf_free (spatial_filter->y0);
         free (spatial_filter);
         spatial_filter = NULL;
 #if DEBUG
@@ -623,7 +626,7 @@ dxf_spatial_filter_free_chain
                 /*!< a pointer to the chain of DXF \c SPATIAL_FILTER objects. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (spatial_filters == NULL)
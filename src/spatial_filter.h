@@ -59,7 +59,7 @@ typedef struct
 dxf_spatial_filter
 {
         /* Members common for all DXF objects. */
-        int id_code;
+        long id_code;
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file.\n
@@ -71,14 +71,24 @@ dxf_spatial_filter
                 /*!< Hard owner ID/handle to owner dictionary (optional).\n
                  * Group code = 360. */
         /* Specific members for a DXF spatial_filter. */
-        double x0[DXF_MAX_PARAM];
+        double *x0;
                 /*!< X-value of the clip boundary definition point (in
-                 * OCS) (always 2 or more) based on an xref scale of 1.\n
+                 * OCS) (always 2 or more) based on an xref scale of 1,
+                 * \c number_of_x0_values entries.\n
                  * Group code = 10. */
-        double y0[DXF_MAX_PARAM];
+        int number_of_x0_values;
+                /*!< Number of entries in \c x0. */
+        int x0_capacity;
+                /*!< Number of entries \c x0 has room for. */
+        double *y0;
                 /*!< Y-value of the clip boundary definition point (in
-                 * OCS) (always 2 or more) based on an xref scale of 1.\n
+                 * OCS) (always 2 or more) based on an xref scale of 1,
+                 * \c number_of_y0_values entries.\n
                  * Group code = 20. */
+        int number_of_y0_values;
+                /*!< Number of entries in \c y0. */
+        int y0_capacity;
+                /*!< Number of entries \c y0 has room for. */
         double x1;
                 /*!< X-value of the origin used to define the local
                  * coordinate system of the clip boundary.\n
@@ -230,6 +230,9 @@
 
 
 #include "spline.h"
+#include "arena.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -252,7 +255,7 @@ dxf_spline_new ()
         size = sizeof (DxfSpline);
         /* avoid malloc of 0 bytes */
         if (size == 0) size = 1;
-        if ((spline = malloc (size)) == NULL)
+        if ((spline = dxf_malloc (size)) == NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () could not allocate memory for a DxfSpline struct.\n")),
@@ -287,8 +290,6 @@ dxf_spline_init
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        int i;
-
         /* Do some basic checks. */
         if (spline == NULL)
         {
@@ -305,34 +306,25 @@ dxf_spline_init
                 return (NULL);
         }
         spline->id_code = 0;
-        spline->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        spline->layer = strdup (DXF_DEFAULT_LAYER);
-        spline->elevation = 0.0;
-        spline->thickness = 0.0;
-        spline->linetype_scale = 1.0;
-        spline->visibility = 0;
-        spline->color = DXF_COLOR_BYLAYER;
-        spline->paperspace = DXF_MODELSPACE;
+        spline->properties = dxf_graphic_properties_default ();
         spline->graphics_data_size = 0;
-        spline->shadow_mode = 0;
         dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) spline->binary_graphics_data);
-        spline->dictionary_owner_soft = strdup ("");
-        spline->material = strdup ("");
-        spline->dictionary_owner_hard = strdup ("");
-        spline->lineweight = 0;
-        spline->plot_style_name = strdup ("");
-        spline->color_value = 0;
-        spline->color_name = strdup ("");
-        spline->transparency = 0;
+        spline->dictionary_owner_soft = dxf_strdup ("");
+        spline->dictionary_owner_hard = dxf_strdup ("");
         spline->p0 = dxf_point_init (spline->p0);
         spline->p1 = dxf_point_init (spline->p1);
-        for (i = 0; i < DXF_MAX_PARAM; i++)
-        {
-                spline->knot_value[i] = 0.0;
-                spline->weight_value[i] = 0.0;
-        }
-        spline->p2 = dxf_point_init (spline->p2);
-        spline->p3 = dxf_point_init (spline->p3);
+        spline->knot_value = NULL;
+        spline->number_of_knot_values = 0;
+        spline->knot_value_capacity = 0;
+        spline->weight_value = NULL;
+        spline->number_of_weight_values = 0;
+        spline->weight_value_capacity = 0;
+        spline->p2.x0 = 0.0;
+        spline->p2.y0 = 0.0;
+        spline->p2.z0 = 0.0;
+        spline->p3.x0 = 0.0;
+        spline->p3.y0 = 0.0;
+        spline->p3.z0 = 0.0;
         spline->extr_x0 = 0.0;
         spline->extr_y0 = 0.0;
         spline->extr_z0 = 0.0;
@@ -375,14 +367,15 @@ dxf_spline_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
-        int i_knot_value;
-        int i_weight_value;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfGraphicProperties properties;
+        DxfPair pair;
+        double *knot_values;
         DxfBinaryGraphicsData *binary_graphics_data = NULL;
         DxfPoint *p0 = NULL;
         DxfPoint *p1 = NULL;
-        DxfPoint *p2 = NULL;
-        DxfPoint *p3 = NULL;
+        DxfVec3 *p2 = NULL;
+        DxfVec3 *p3 = NULL;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -390,8 +383,6 @@ dxf_spline_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (spline == NULL)
@@ -402,356 +393,284 @@ dxf_spline_read
                 spline = dxf_spline_new ();
                 spline = dxf_spline_init (spline);
         }
-        i_knot_value = 0;
-        i_weight_value = 0;
         binary_graphics_data = (DxfBinaryGraphicsData *) spline->binary_graphics_data;
         p0 = (DxfPoint *) spline->p0;
         p1 = (DxfPoint *) spline->p1;
-        p2 = (DxfPoint *) spline->p2;
-        p3 = (DxfPoint *) spline->p3;
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        p2 = &spline->p2;
+        p3 = &spline->p3;
+        dxf_graphic_properties_start (&properties, spline->properties);
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        fclose (fp->fp);
-                        /* Clean up. */
-                        free (temp_string);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &spline->id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", spline->linetype);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", spline->layer);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the control point coordinate
-                         * (multiple entries). */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &p0->x0);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of control point coordinate
-                         * (multiple entries). */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &p0->y0);
-                }
-                else if (strcmp (temp_string, "30") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the control point coordinate
-                         * (multiple entries). */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &p0->z0);
-                        dxf_point_init ((DxfPoint *) p0->next);
-                        p0 = (DxfPoint *) p0->next;
-                }
-                else if (strcmp (temp_string, "11") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the fit point coordinate
-                         * (multiple entries). */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &p1->x0);
-                }
-                else if (strcmp (temp_string, "21") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the fit point coordinate
-                         * (multiple entries). */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &p1->y0);
-                }
-                else if (strcmp (temp_string, "31") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the fit point coordinate
-                         * (multiple entries). */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &p1->z0);
-                        dxf_point_init ((DxfPoint *) p1->next);
-                        p1 = (DxfPoint *) p1->next;
-                }
-                else if (strcmp (temp_string, "12") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the start tangent,
-                         * may be omitted (in WCS). */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &p2->x0);
-                }
-                else if (strcmp (temp_string, "22") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the start tangent,
-                         * may be omitted (in WCS). */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &p2->y0);
-                }
-                else if (strcmp (temp_string, "32") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the start tangent,
-                         * may be omitted (in WCS). */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &p2->z0);
-                }
-                else if (strcmp (temp_string, "13") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the end tangent,
-                         * may be omitted (in WCS). */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &p3->x0);
-                }
-                else if (strcmp (temp_string, "23") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the end tangent,
-                         * may be omitted (in WCS). */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &p3->y0);
-                }
-                else if (strcmp (temp_string, "33") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the end tangent,
-                         * may be omitted (in WCS). */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &p3->z0);
-                }
-                else if ((fp->acad_version_number <= AutoCAD_11)
-                        && (strcmp (temp_string, "38") == 0)
-                        && (spline->elevation != 0.0))
-                {
-                        /* Now follows a string containing the
-                         * elevation. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &spline->elevation);
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a thickness value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &spline->thickness);
-                        i_knot_value++;
-                }
-                else if (strcmp (temp_string, "40") == 0)
-                {
-                        /* Now follows a knot value (one entry per knot, multiple entries). */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &spline->knot_value[i_knot_value]);
-                        i_knot_value++;
-                }
-                else if (strcmp (temp_string, "41") == 0)
-                {
-                        /* Now follows a weight value (one entry per knot, multiple entries). */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &spline->weight_value[i_weight_value]);
-                        i_weight_value++;
-                }
-                else if (strcmp (temp_string, "42") == 0)
-                {
-                        /* Now follows a knot tolerance value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &spline->knot_tolerance);
-                }
-                else if (strcmp (temp_string, "43") == 0)
-                {
-                        /* Now follows a control point tolerance value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &spline->control_point_tolerance);
-                }
-                else if (strcmp (temp_string, "44") == 0)
-                {
-                        /* Now follows a fit point tolerance value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &spline->fit_tolerance);
-                }
-                else if (strcmp (temp_string, "48") == 0)
-                {
-                        /* Now follows a linetype scale value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &spline->linetype_scale);
-                        i_knot_value++;
-                }
-                else if (strcmp (temp_string, "60") == 0)
-                {
-                        /* Now follows a string containing the
-                         * visibility value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &spline->visibility);
-                }
-                else if (strcmp (temp_string, "62") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &spline->color);
-                }
-                else if (strcmp (temp_string, "67") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &spline->paperspace);
-                }
-                else if (strcmp (temp_string, "70") == 0)
-                {
-                        /* Now follows a flag value (bit coded). */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &spline->flag);
-                }
-                else if (strcmp (temp_string, "71") == 0)
-                {
-                        /* Now follows a degree of spline curve value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &spline->degree);
-                }
-                else if (strcmp (temp_string, "72") == 0)
-                {
-                        /* Now follows a number of knots value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &spline->number_of_knots);
-                }
-                else if (strcmp (temp_string, "73") == 0)
-                {
-                        /* Now follows a number of control points value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &spline->number_of_control_points);
-                }
-                else if (strcmp (temp_string, "74") == 0)
-                {
-                        /* Now follows a number of fit points value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &spline->number_of_fit_points);
-                }
-                else if (strcmp (temp_string, "92") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &spline->graphics_data_size);
-                }
-                else if (strcmp (temp_string, "284") == 0)
-                {
-                        /* Now follows a string containing the shadow
-                         * mode value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &spline->shadow_mode);
-                }
-                else if (strcmp (temp_string, "310") == 0)
-                {
-                        /* Now follows a string containing binary
-                         * graphics data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", binary_graphics_data->data_line);
-                        dxf_binary_graphics_data_init ((DxfBinaryGraphicsData *) binary_graphics_data->next);
-                        binary_graphics_data = (DxfBinaryGraphicsData *) binary_graphics_data->next;
-                }
-                else if (strcmp (temp_string, "330") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing a
-                         * soft-pointer ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", spline->dictionary_owner_soft);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else if (strcmp (temp_string, "347") == 0)
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing a
-                         * hard-pointer ID/handle to material object. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", spline->material);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing a
-                         * hard-pointer ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", spline->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "370") == 0)
-                {
-                        /* Now follows a string containing the lineweight
-                         * value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &spline->lineweight);
-                }
-                else if (strcmp (temp_string, "390") == 0)
-                {
-                        /* Now follows a string containing a plot style
-                         * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", spline->plot_style_name);
-                }
-                else if (strcmp (temp_string, "420") == 0)
-                {
-                        /* Now follows a string containing a color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%ld\n", &spline->color_value);
-                }
-                else if (strcmp (temp_string, "430") == 0)
-                {
-                        /* Now follows a string containing a color
-                         * name value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", spline->color_name);
-                }
-                else if (strcmp (temp_string, "440") == 0)
-                {
-                        /* Now follows a string containing a transparency
-                         * value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%ld\n", &spline->transparency);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                spline->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 6:
+                                /* Now follows a string containing a linetype
+                                 * name. */
+                                dxf_lexer_free_string (fp, properties.linetype);
+                                properties.linetype = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 8:
+                                /* Now follows a string containing a layer name. */
+                                dxf_lexer_free_string (fp, properties.layer);
+                                properties.layer = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 10:
+                                /* Now follows a string containing the
+                                 * X-value of the control point coordinate
+                                 * (multiple entries). */
+                                p0->x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 20:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of control point coordinate
+                                 * (multiple entries). */
+                                p0->y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 30:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the control point coordinate
+                                 * (multiple entries). */
+                                p0->z0 = dxf_pair_get_double (&pair);
+                                dxf_point_init ((DxfPoint *) p0->next);
+                                p0 = (DxfPoint *) p0->next;
+                                break;
+                        case 11:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the fit point coordinate
+                                 * (multiple entries). */
+                                p1->x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 21:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the fit point coordinate
+                                 * (multiple entries). */
+                                p1->y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 31:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the fit point coordinate
+                                 * (multiple entries). */
+                                p1->z0 = dxf_pair_get_double (&pair);
+                                dxf_point_init ((DxfPoint *) p1->next);
+                                p1 = (DxfPoint *) p1->next;
+                                break;
+                        case 12:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the start tangent,
+                                 * may be omitted (in WCS). */
+                                p2->x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 22:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the start tangent,
+                                 * may be omitted (in WCS). */
+                                p2->y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 32:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the start tangent,
+                                 * may be omitted (in WCS). */
+                                p2->z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 13:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the end tangent,
+                                 * may be omitted (in WCS). */
+                                p3->x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 23:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the end tangent,
+                                 * may be omitted (in WCS). */
+                                p3->y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 33:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the end tangent,
+                                 * may be omitted (in WCS). */
+                                p3->z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 38:
+                                if ((fp->acad_version_number <= AutoCAD_11)
+                                  && (properties.elevation != 0.0))
+                                {
+                                        /* Now follows a string containing the
+                                         * elevation. */
+                                        properties.elevation = dxf_pair_get_double (&pair);
+                                }
+                                break;
+                        case 39:
+                                /* Now follows a thickness value. */
+                                properties.thickness = dxf_pair_get_double (&pair);
+                                break;
+                        case 40:
+                                /* Now follows a knot value (one entry per knot, multiple entries). */
+                                dxf_spline_append_knot_value (spline, dxf_pair_get_double (&pair));
+                                break;
+                        case 41:
+                                /* Now follows a weight value (one entry per knot, multiple entries). */
+                                dxf_spline_append_weight_value (spline, dxf_pair_get_double (&pair));
+                                break;
+                        case 42:
+                                /* Now follows a knot tolerance value. */
+                                spline->knot_tolerance = dxf_pair_get_double (&pair);
+                                break;
+                        case 43:
+                                /* Now follows a control point tolerance value. */
+                                spline->control_point_tolerance = dxf_pair_get_double (&pair);
+                                break;
+                        case 44:
+                                /* Now follows a fit point tolerance value. */
+                                spline->fit_tolerance = dxf_pair_get_double (&pair);
+                                break;
+                        case 48:
+                                /* Now follows a linetype scale value. */
+                                properties.linetype_scale = dxf_pair_get_double (&pair);
+                                break;
+                        case 60:
+                                /* Now follows a string containing the
+                                 * visibility value. */
+                                properties.visibility = dxf_pair_get_int (&pair);
+                                break;
+                        case 62:
+                                /* Now follows a string containing the
+                                 * color value. */
+                                properties.color = dxf_pair_get_int (&pair);
+                                break;
+                        case 67:
+                                /* Now follows a string containing the
+                                 * paperspace value. */
+                                properties.paperspace = dxf_pair_get_int (&pair);
+                                break;
+                        case 70:
+                                /* Now follows a flag value (bit coded). */
+                                spline->flag = dxf_pair_get_int (&pair);
+                                break;
+                        case 71:
+                                /* Now follows a degree of spline curve value. */
+                                spline->degree = dxf_pair_get_int (&pair);
+                                break;
+                        case 72:
+                                /* Now follows a number of knots value. */
+                                spline->number_of_knots = dxf_pair_get_int (&pair);
+                                /* Room for the knot values which follow. */
+                                knot_values = dxf_array_reserve (spline->knot_value,
+                                  spline->number_of_knot_values,
+                                  &spline->knot_value_capacity,
+                                  spline->number_of_knots, sizeof (double));
+                                if (knot_values != NULL)
+                                {
+                                        spline->knot_value = knot_values;
+                                }
+                                break;
+                        case 73:
+                                /* Now follows a number of control points value. */
+                                spline->number_of_control_points = dxf_pair_get_int (&pair);
+                                break;
+                        case 74:
+                                /* Now follows a number of fit points value. */
+                                spline->number_of_fit_points = dxf_pair_get_int (&pair);
+                                break;
+                        case 92:
+                                /* Now follows a string containing the
+                                 * paperspace value. */
+                                spline->graphics_data_size = dxf_pair_get_int (&pair);
+                                break;
+                        case 284:
+                                /* Now follows a string containing the shadow
+                                 * mode value. */
+                                properties.shadow_mode = dxf_pair_get_int (&pair);
+                                break;
+                        case 310:
+                                /* Now follows a string containing binary
+                                 * graphics data. */
+                                binary_graphics_data = dxf_binary_graphics_data_append_line
+                                  (binary_graphics_data,
+                                  dxf_pair_get_string (&pair));
+                                break;
+                        case 330:
+                                /* Now follows a string containing a
+                                 * soft-pointer ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, spline->dictionary_owner_soft);
+                                spline->dictionary_owner_soft = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 347:
+                                /* Now follows a string containing a
+                                 * hard-pointer ID/handle to material object. */
+                                dxf_lexer_free_string (fp, properties.material);
+                                properties.material = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 360:
+                                /* Now follows a string containing a
+                                 * hard-pointer ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, spline->dictionary_owner_hard);
+                                spline->dictionary_owner_hard = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 370:
+                                /* Now follows a string containing the lineweight
+                                 * value. */
+                                properties.lineweight = dxf_pair_get_int (&pair);
+                                break;
+                        case 390:
+                                /* Now follows a string containing a plot style
+                                 * name value. */
+                                dxf_lexer_free_string (fp, properties.plot_style_name);
+                                properties.plot_style_name = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 420:
+                                /* Now follows a string containing a color value. */
+                                properties.color_value = dxf_pair_get_long (&pair);
+                                break;
+                        case 430:
+                                /* Now follows a string containing a color
+                                 * name value. */
+                                dxf_lexer_free_string (fp, properties.color_name);
+                                properties.color_name = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 440:
+                                /* Now follows a string containing a transparency
+                                 * value. */
+                                properties.transparency = dxf_pair_get_long (&pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, "DXF comment: %s\n", temp_string);
+                                break;
+                        default:
+                                fprintf (stderr,
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
+                                  __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
         /* Handle omitted members and/or illegal values. */
-        if (strcmp (spline->linetype, "") == 0)
+        if ((properties.linetype != NULL)
+          && (strcmp (properties.linetype, "") == 0))
         {
-                spline->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_lexer_free_string (fp, properties.linetype);
+                properties.linetype = dxf_strdup (DXF_DEFAULT_LINETYPE);
         }
-        if (strcmp (spline->layer, "") == 0)
+        if ((properties.layer != NULL)
+          && (strcmp (properties.layer, "") == 0))
         {
-                spline->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_lexer_free_string (fp, properties.layer);
+                properties.layer = dxf_strdup (DXF_DEFAULT_LAYER);
         }
-        /* Clean up. */
-        free (temp_string);
+        /* Entities with equal properties share a record. */
+        dxf_graphic_properties_finish (fp, &spline->properties, &properties);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -777,13 +696,13 @@ dxf_spline_write
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *dxf_entity_name = strdup ("SPLINE");
+        char *dxf_entity_name = dxf_strdup ("SPLINE");
         int i;
         DxfBinaryGraphicsData *binary_graphics_data = NULL;
         DxfPoint *p0 = NULL;
         DxfPoint *p1 = NULL;
-        DxfPoint *p2 = NULL;
-        DxfPoint *p3 = NULL;
+        DxfVec3 *p2 = NULL;
+        DxfVec3 *p3 = NULL;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -792,7 +711,7 @@ dxf_spline_write
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (spline == NULL)
@@ -801,7 +720,7 @@ dxf_spline_write
                   (_("Error in %s () a NULL pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (fp->acad_version_number < AutoCAD_13)
@@ -810,36 +729,36 @@ dxf_spline_write
                   (_("Warning in %s () illegal DXF version for this entity.\n")),
                   __FUNCTION__);
         }
-        if (strcmp (spline->linetype, "") == 0)
+        if (strcmp (spline->properties->linetype, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, spline->id_code);
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                spline->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_spline_set_linetype (spline, DXF_DEFAULT_LINETYPE);
         }
-        if (strcmp (spline->layer, "") == 0)
+        if (strcmp (spline->properties->layer, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty layer string for the %s entity with id-code: %x.\n")),
+                  (_("Warning in %s () empty layer string for the %s entity with id-code: %lx.\n")),
                   __FUNCTION__, dxf_entity_name, spline->id_code);
                 fprintf (stderr,
                   (_("\t%s entity is relocated to default layer.\n")),
                   dxf_entity_name);
-                spline->layer = DXF_DEFAULT_LAYER;
+                dxf_spline_set_layer (spline, DXF_DEFAULT_LAYER);
         }
         /* Start writing output. */
         binary_graphics_data = (DxfBinaryGraphicsData *) spline->binary_graphics_data;
         p0 = (DxfPoint *) spline->p0;
         p1 = (DxfPoint *) spline->p1;
-        p2 = (DxfPoint *) spline->p2;
-        p3 = (DxfPoint *) spline->p3;
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
+        p2 = &spline->p2;
+        p3 = &spline->p3;
+        dxf_write_string (fp, 0, dxf_entity_name);
         if (spline->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", spline->id_code);
+                dxf_write_hex (fp, 5, spline->id_code);
         }
         /*!
          * \todo for version R14.\n
@@ -854,119 +773,116 @@ dxf_spline_write
         if ((strcmp (spline->dictionary_owner_soft, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", spline->dictionary_owner_soft);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, spline->dictionary_owner_soft);
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (spline->dictionary_owner_hard, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", spline->dictionary_owner_hard);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, spline->dictionary_owner_hard);
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbEntity\n");
+                dxf_write_string (fp, 100, "AcDbEntity");
         }
-        if (spline->paperspace != DXF_MODELSPACE)
+        if (spline->properties->paperspace != DXF_MODELSPACE)
         {
-                fprintf (fp->fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_int (fp, 67, DXF_PAPERSPACE);
         }
-        fprintf (fp->fp, "  8\n%s\n", spline->layer);
-        if (strcmp (spline->linetype, DXF_DEFAULT_LINETYPE) != 0)
+        dxf_write_string (fp, 8, spline->properties->layer);
+        if (strcmp (spline->properties->linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp->fp, "  6\n%s\n", spline->linetype);
+                dxf_write_string (fp, 6, spline->properties->linetype);
         }
         if ((fp->acad_version_number <= AutoCAD_11)
           && DXF_FLATLAND
-          && (spline->elevation != 0.0))
+          && (spline->properties->elevation != 0.0))
         {
-                fprintf (fp->fp, " 38\n%f\n", spline->elevation);
+                dxf_write_double (fp, 38, spline->properties->elevation);
         }
         if ((fp->acad_version_number >= AutoCAD_2007)
-          && (strcmp (spline->material, "") != 0))
+          && (strcmp (spline->properties->material, "") != 0))
         {
-                fprintf (fp->fp, "347\n%s\n", spline->material);
+                dxf_write_string (fp, 347, spline->properties->material);
         }
-        if (spline->color != DXF_COLOR_BYLAYER)
+        if (spline->properties->color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp->fp, " 62\n%d\n", spline->color);
+                dxf_write_int (fp, 62, spline->properties->color);
         }
-        if (spline->thickness != 0.0)
+        if (spline->properties->thickness != 0.0)
         {
-                fprintf (fp->fp, " 39\n%f\n", spline->thickness);
+                dxf_write_double (fp, 39, spline->properties->thickness);
         }
-        fprintf (fp->fp, "370\n%d\n", spline->lineweight);
-        fprintf (fp->fp, " 48\n%f\n", spline->linetype_scale);
-        if (spline->visibility != 0)
+        dxf_write_int (fp, 370, spline->properties->lineweight);
+        dxf_write_double (fp, 48, spline->properties->linetype_scale);
+        if (spline->properties->visibility != 0)
         {
-                fprintf (fp->fp, " 60\n%d\n", spline->visibility);
+                dxf_write_int (fp, 60, spline->properties->visibility);
         }
-        fprintf (fp->fp, " 92\n%d\n", spline->graphics_data_size);
+        dxf_write_int (fp, 92, spline->graphics_data_size);
         /*!
          * \todo On 64 bit machines use group code 160.
          */
         while (binary_graphics_data != NULL)
         {
-                fprintf (fp->fp, "310\n%s\n", binary_graphics_data->data_line);
+                dxf_write_string (fp, 310, binary_graphics_data->data_line);
                 binary_graphics_data = (DxfBinaryGraphicsData *) dxf_binary_graphics_data_get_next (binary_graphics_data);
         }
-        fprintf (fp->fp, "420\n%ld\n", spline->color_value);
-        fprintf (fp->fp, "430\n%s\n", spline->color_name);
-        fprintf (fp->fp, "440\n%ld\n", spline->transparency);
-        fprintf (fp->fp, "390\n%s\n", spline->plot_style_name);
-        fprintf (fp->fp, "284\n%d\n", spline->shadow_mode);
-        fprintf (fp->fp, "100\nAcDbSpline\n");
+        dxf_write_long (fp, 420, spline->properties->color_value);
+        dxf_write_string (fp, 430, spline->properties->color_name);
+        dxf_write_long (fp, 440, spline->properties->transparency);
+        dxf_write_string (fp, 390, spline->properties->plot_style_name);
+        dxf_write_int (fp, 284, spline->properties->shadow_mode);
+        dxf_write_string (fp, 100, "AcDbSpline");
         if ((fp->acad_version_number >= AutoCAD_12)
                 && (spline->extr_x0 != 0.0)
                 && (spline->extr_y0 != 0.0)
                 && (spline->extr_z0 != 1.0))
         {
-                fprintf (fp->fp, "210\n%f\n", spline->extr_x0);
-                fprintf (fp->fp, "220\n%f\n", spline->extr_y0);
-                fprintf (fp->fp, "230\n%f\n", spline->extr_z0);
-        }
-        fprintf (fp->fp, " 70\n%d\n", spline->flag);
-        fprintf (fp->fp, " 71\n%d\n", spline->degree);
-        fprintf (fp->fp, " 72\n%d\n", spline->number_of_knots);
-        fprintf (fp->fp, " 73\n%d\n", spline->number_of_control_points);
-        fprintf (fp->fp, " 74\n%d\n", spline->number_of_fit_points);
-        fprintf (fp->fp, " 42\n%f\n", spline->knot_tolerance);
-        fprintf (fp->fp, " 43\n%f\n", spline->control_point_tolerance);
-        fprintf (fp->fp, " 12\n%f\n", p2->x0);
-        fprintf (fp->fp, " 22\n%f\n", p2->y0);
-        fprintf (fp->fp, " 32\n%f\n", p2->z0);
-        fprintf (fp->fp, " 13\n%f\n", p3->x0);
-        fprintf (fp->fp, " 23\n%f\n", p3->y0);
-        fprintf (fp->fp, " 33\n%f\n", p3->z0);
-        for (i = 0; i < spline->number_of_knots; i++)
-        {
-                fprintf (fp->fp, " 40\n%f\n", spline->knot_value[i]);
-        }
-        if (spline->number_of_fit_points != 0)
-        {
-        for (i = 0; i < spline->number_of_fit_points; i++)
-                {
-                        fprintf (fp->fp, " 41\n%f\n", spline->weight_value[i]);
-                }
+                dxf_write_double (fp, 210, spline->extr_x0);
+                dxf_write_double (fp, 220, spline->extr_y0);
+                dxf_write_double (fp, 230, spline->extr_z0);
+        }
+        dxf_write_int (fp, 70, spline->flag);
+        dxf_write_int (fp, 71, spline->degree);
+        dxf_write_int (fp, 72, spline->number_of_knots);
+        dxf_write_int (fp, 73, spline->number_of_control_points);
+        dxf_write_int (fp, 74, spline->number_of_fit_points);
+        dxf_write_double (fp, 42, spline->knot_tolerance);
+        dxf_write_double (fp, 43, spline->control_point_tolerance);
+        dxf_write_double (fp, 12, p2->x0);
+        dxf_write_double (fp, 22, p2->y0);
+        dxf_write_double (fp, 32, p2->z0);
+        dxf_write_double (fp, 13, p3->x0);
+        dxf_write_double (fp, 23, p3->y0);
+        dxf_write_double (fp, 33, p3->z0);
+        for (i = 0; i < spline->number_of_knot_values; i++)
+        {
+                dxf_write_double (fp, 40, spline->knot_value[i]);
+        }
+        for (i = 0; i < spline->number_of_weight_values; i++)
+        {
+                dxf_write_double (fp, 41, spline->weight_value[i]);
         }
         while (spline->p0 != NULL)
         {
-                fprintf (fp->fp, " 10\n%f\n", p0->x0);
-                fprintf (fp->fp, " 20\n%f\n", p0->y0);
-                fprintf (fp->fp, " 30\n%f\n", p0->z0);
+                dxf_write_double (fp, 10, p0->x0);
+                dxf_write_double (fp, 20, p0->y0);
+                dxf_write_double (fp, 30, p0->z0);
                 p0 = (DxfPoint *) dxf_point_get_next (p0);
         }
         while (spline->p1 != NULL)
         {
-                fprintf (fp->fp, " 11\n%f\n", p1->x0);
-                fprintf (fp->fp, " 21\n%f\n", p1->y0);
-                fprintf (fp->fp, " 31\n%f\n", p1->z0);
+                dxf_write_double (fp, 11, p1->x0);
+                dxf_write_double (fp, 21, p1->y0);
+                dxf_write_double (fp, 31, p1->z0);
                 p1 = (DxfPoint *) dxf_point_get_next (p1);
         }
         /* Clean up. */
-        free (dxf_entity_name);
+        dxf_free (dxf_entity_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -999,15 +915,13 @@ dxf_spline_free
                 __FUNCTION__);
               return (EXIT_FAILURE);
         }
-        free (spline->linetype);
-        free (spline->layer);
-        free (spline->dictionary_owner_soft);
-        free (spline->material);
-        free (spline->dictionary_owner_hard);
-        free (spline->plot_style_name);
-        free (spline->color_name);
+        dxf_graphic_properties_free (spline->properties);
+        dxf_free (spline->dictionary_owner_soft);
+        dxf_free (spline->dictionary_owner_hard);
+        dxf_free (spline->knot_value);
+        dxf_free (spline->weight_value);
         dxf_binary_graphics_data_free_chain (spline->binary_graphics_data);
-        free (spline);
+        dxf_free (spline);
         spline = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -1027,7 +941,7 @@ dxf_spline_free_chain
                 /*!< a pointer to the chain of DXF \c SPLINE entities. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (splines == NULL)
@@ -1054,7 +968,7 @@ dxf_spline_free_chain
  * \return \c id_code when successful, or \c EXIT_FAILURE when an error
  * occurred.
  */
-int
+long
 dxf_spline_get_id_code
 (
         DxfSpline *spline
@@ -1096,7 +1010,7 @@ dxf_spline_set_id_code
 (
         DxfSpline *spline,
                 /*!< a pointer to a DXF \c SPLINE entity. */
-        int id_code
+        long id_code
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file. */
@@ -1151,7 +1065,7 @@ dxf_spline_get_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        if (spline->linetype ==  NULL)
+        if (spline->properties->linetype ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the linetype member.\n")),
@@ -1161,7 +1075,7 @@ dxf_spline_get_linetype
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (spline->linetype));
+        return (dxf_strdup (spline->properties->linetype));
 }
 
 
@@ -1198,7 +1112,12 @@ dxf_spline_set_linetype
                   __FUNCTION__);
                 return (NULL);
         }
-        spline->linetype = strdup (linetype);
+        if (dxf_graphic_properties_unshare (&spline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (spline->properties->linetype);
+        spline->properties->linetype = dxf_strdup (linetype);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1229,7 +1148,7 @@ dxf_spline_get_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        if (spline->layer ==  NULL)
+        if (spline->properties->layer ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the layer member.\n")),
@@ -1239,7 +1158,7 @@ dxf_spline_get_layer
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (spline->layer));
+        return (dxf_strdup (spline->properties->layer));
 }
 
 
@@ -1276,7 +1195,12 @@ dxf_spline_set_layer
                   __FUNCTION__);
                 return (NULL);
         }
-        spline->layer = strdup (layer);
+        if (dxf_graphic_properties_unshare (&spline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (spline->properties->layer);
+        spline->properties->layer = dxf_strdup (layer);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1311,7 +1235,7 @@ dxf_spline_get_elevation
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (spline->elevation);
+        return (spline->properties->elevation);
 }
 
 
@@ -1341,7 +1265,11 @@ dxf_spline_set_elevation
                   __FUNCTION__);
                 return (NULL);
         }
-        spline->elevation = elevation;
+        if (dxf_graphic_properties_unshare (&spline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        spline->properties->elevation = elevation;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1373,7 +1301,7 @@ dxf_spline_get_thickness
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (spline->thickness < 0.0)
+        if (spline->properties->thickness < 0.0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found in the thickness member.\n")),
@@ -1382,7 +1310,7 @@ dxf_spline_get_thickness
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (spline->thickness);
+        return (spline->properties->thickness);
 }
 
 
@@ -1418,7 +1346,11 @@ dxf_spline_set_thickness
                   (_("Warning in %s () a negative thickness value was passed.\n")),
                   __FUNCTION__);
         }
-        spline->thickness = thickness;
+        if (dxf_graphic_properties_unshare (&spline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        spline->properties->thickness = thickness;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1450,7 +1382,7 @@ dxf_spline_get_linetype_scale
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (spline->linetype_scale < 0.0)
+        if (spline->properties->linetype_scale < 0.0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found in the linetype scale member.\n")),
@@ -1460,7 +1392,7 @@ dxf_spline_get_linetype_scale
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (spline->linetype_scale);
+        return (spline->properties->linetype_scale);
 }
 
 
@@ -1497,7 +1429,11 @@ dxf_spline_set_linetype_scale
                   __FUNCTION__);
                 return (NULL);
         }
-        spline->linetype_scale = linetype_scale;
+        if (dxf_graphic_properties_unshare (&spline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        spline->properties->linetype_scale = linetype_scale;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1529,14 +1465,14 @@ dxf_spline_get_visibility
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (spline->visibility < 0)
+        if (spline->properties->visibility < 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found in the visibility member.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (spline->visibility > 1)
+        if (spline->properties->visibility > 1)
         {
                 fprintf (stderr,
                   (_("Error in %s () an out of range value was found in the visibility member.\n")),
@@ -1546,7 +1482,7 @@ dxf_spline_get_visibility
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (spline->visibility);
+        return (spline->properties->visibility);
 }
 
 
@@ -1590,7 +1526,11 @@ dxf_spline_set_visibility
                   __FUNCTION__);
                 return (NULL);
         }
-        spline->visibility = visibility;
+        if (dxf_graphic_properties_unshare (&spline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        spline->properties->visibility = visibility;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1622,7 +1562,7 @@ dxf_spline_get_color
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (spline->color < 0)
+        if (spline->properties->color < 0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found in the color member.\n")),
@@ -1631,7 +1571,7 @@ dxf_spline_get_color
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (spline->color);
+        return (spline->properties->color);
 }
 
 
@@ -1669,7 +1609,11 @@ dxf_spline_set_color
                 fprintf (stderr,
                   (_("\teffectively turning this entity it's visibility off.\n")));
         }
-        spline->color = color;
+        if (dxf_graphic_properties_unshare (&spline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        spline->properties->color = color;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1701,13 +1645,13 @@ dxf_spline_get_paperspace
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (spline->paperspace < 0)
+        if (spline->properties->paperspace < 0)
         {
                 fprintf (stderr,
                   (_("Warning in %s () a negative value was found in the paperspace member.\n")),
                   __FUNCTION__);
         }
-        if (spline->paperspace > 1)
+        if (spline->properties->paperspace > 1)
         {
                 fprintf (stderr,
                   (_("Warning in %s () an out of range value was found in the paperspace member.\n")),
@@ -1716,7 +1660,7 @@ dxf_spline_get_paperspace
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (spline->paperspace);
+        return (spline->properties->paperspace);
 }
 
 
@@ -1761,7 +1705,11 @@ dxf_spline_set_paperspace
                   __FUNCTION__);
                 return (NULL);
         }
-        spline->paperspace = paperspace;
+        if (dxf_graphic_properties_unshare (&spline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        spline->properties->paperspace = paperspace;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1885,14 +1833,14 @@ dxf_spline_get_shadow_mode
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (spline->shadow_mode < 0)
+        if (spline->properties->shadow_mode < 0)
         {
                 fprintf (stderr,
                   (_("Error in %s () a negative value was found in the shadow_mode member.\n")),
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        if (spline->shadow_mode > 3)
+        if (spline->properties->shadow_mode > 3)
         {
                 fprintf (stderr,
                   (_("Error in %s () an out of range value was found in the shadow_mode member.\n")),
@@ -1902,7 +1850,7 @@ dxf_spline_get_shadow_mode
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (spline->shadow_mode);
+        return (spline->properties->shadow_mode);
 }
 
 
@@ -1946,7 +1894,11 @@ dxf_spline_set_shadow_mode
                   __FUNCTION__);
                 return (NULL);
         }
-        spline->shadow_mode = shadow_mode;
+        if (dxf_graphic_properties_unshare (&spline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        spline->properties->shadow_mode = shadow_mode;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2075,7 +2027,7 @@ dxf_spline_get_dictionary_owner_soft
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (spline->dictionary_owner_soft));
+        return (dxf_strdup (spline->dictionary_owner_soft));
 }
 
 
@@ -2114,7 +2066,7 @@ dxf_spline_set_dictionary_owner_soft
                   __FUNCTION__);
                 return (NULL);
         }
-        spline->dictionary_owner_soft = strdup (dictionary_owner_soft);
+        spline->dictionary_owner_soft = dxf_strdup (dictionary_owner_soft);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2148,7 +2100,7 @@ dxf_spline_get_material
                   __FUNCTION__);
                 return (NULL);
         }
-        if (spline->material ==  NULL)
+        if (spline->properties->material ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the material member.\n")),
@@ -2158,7 +2110,7 @@ dxf_spline_get_material
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (spline->material));
+        return (dxf_strdup (spline->properties->material));
 }
 
 
@@ -2196,7 +2148,12 @@ dxf_spline_set_material
                   __FUNCTION__);
                 return (NULL);
         }
-        spline->material = strdup (material);
+        if (dxf_graphic_properties_unshare (&spline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (spline->properties->material);
+        spline->properties->material = dxf_strdup (material);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2241,7 +2198,7 @@ dxf_spline_get_dictionary_owner_hard
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (spline->dictionary_owner_hard));
+        return (dxf_strdup (spline->dictionary_owner_hard));
 }
 
 
@@ -2280,7 +2237,7 @@ dxf_spline_set_dictionary_owner_hard
                   __FUNCTION__);
                 return (NULL);
         }
-        spline->dictionary_owner_hard = strdup (dictionary_owner_hard);
+        spline->dictionary_owner_hard = dxf_strdup (dictionary_owner_hard);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2315,7 +2272,7 @@ dxf_spline_get_lineweight
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (spline->lineweight);
+        return (spline->properties->lineweight);
 }
 
 
@@ -2345,7 +2302,11 @@ dxf_spline_set_lineweight
                   __FUNCTION__);
                 return (NULL);
         }
-        spline->lineweight = lineweight;
+        if (dxf_graphic_properties_unshare (&spline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        spline->properties->lineweight = lineweight;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2377,7 +2338,7 @@ dxf_spline_get_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        if (spline->plot_style_name ==  NULL)
+        if (spline->properties->plot_style_name ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the plot_style_name member.\n")),
@@ -2387,7 +2348,7 @@ dxf_spline_get_plot_style_name
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (spline->plot_style_name));
+        return (dxf_strdup (spline->properties->plot_style_name));
 }
 
 
@@ -2425,7 +2386,12 @@ dxf_spline_set_plot_style_name
                   __FUNCTION__);
                 return (NULL);
         }
-        spline->plot_style_name = strdup (plot_style_name);
+        if (dxf_graphic_properties_unshare (&spline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (spline->properties->plot_style_name);
+        spline->properties->plot_style_name = dxf_strdup (plot_style_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2460,7 +2426,7 @@ dxf_spline_get_color_value
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (spline->color_value);
+        return (spline->properties->color_value);
 }
 
 
@@ -2490,7 +2456,11 @@ dxf_spline_set_color_value
                   __FUNCTION__);
                 return (NULL);
         }
-        spline->color_value = color_value;
+        if (dxf_graphic_properties_unshare (&spline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        spline->properties->color_value = color_value;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2522,7 +2492,7 @@ dxf_spline_get_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        if (spline->color_name ==  NULL)
+        if (spline->properties->color_name ==  NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () a NULL pointer was found in the color_name member.\n")),
@@ -2532,7 +2502,7 @@ dxf_spline_get_color_name
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (strdup (spline->color_name));
+        return (dxf_strdup (spline->properties->color_name));
 }
 
 
@@ -2570,7 +2540,12 @@ dxf_spline_set_color_name
                   __FUNCTION__);
                 return (NULL);
         }
-        spline->color_name = strdup (color_name);
+        if (dxf_graphic_properties_unshare (&spline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        dxf_free (spline->properties->color_name);
+        spline->properties->color_name = dxf_strdup (color_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2605,7 +2580,7 @@ dxf_spline_get_transparency
 #if DEBUG
         DXF_DEBUG_END
 #endif
-        return (spline->transparency);
+        return (spline->properties->transparency);
 }
 
 
@@ -2635,7 +2610,11 @@ dxf_spline_set_transparency
                   __FUNCTION__);
                 return (NULL);
         }
-        spline->transparency = transparency;
+        if (dxf_graphic_properties_unshare (&spline->properties) == NULL)
+        {
+                return (NULL);
+        }
+        spline->properties->transparency = transparency;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -2811,4 +2790,82 @@ dxf_spline_set_p1
 }
 
 
+/*!
+ * \brief Append a knot value to a DXF \c SPLINE entity.
+ *
+ * \return a pointer to \c spline when successful, or \c NULL when an
+ * error occurred.
+ */
+DxfSpline *
+dxf_spline_append_knot_value
+(
+        DxfSpline *spline,
+                /*!< a pointer to a DXF \c SPLINE entity. */
+        double knot_value
+                /*!< the knot value. */
+)
+{
+        double *knot_values;
+
+        /* Do some basic checks. */
+        if (spline == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        knot_values = dxf_array_reserve (spline->knot_value,
+          spline->number_of_knot_values, &spline->knot_value_capacity,
+          spline->number_of_knot_values + 1, sizeof (double));
+        if (knot_values == NULL)
+        {
+                return (NULL);
+        }
+        spline->knot_value = knot_values;
+        spline->knot_value[spline->number_of_knot_values] = knot_value;
+        spline->number_of_knot_values++;
+        return (spline);
+}
+
+
+/*!
+ * \brief Append a weight value to a DXF \c SPLINE entity.
+ *
+ * \return a pointer to \c spline when successful, or \c NULL when an
+ * error occurred.
+ */
+DxfSpline *
+dxf_spline_append_weight_value
+(
+        DxfSpline *spline,
+                /*!< a pointer to a DXF \c SPLINE entity. */
+        double weight_value
+                /*!< the weight value. */
+)
+{
+        double *weight_values;
+
+        /* Do some basic checks. */
+        if (spline == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        weight_values = dxf_array_reserve (spline->weight_value,
+          spline->number_of_weight_values, &spline->weight_value_capacity,
+          spline->number_of_weight_values + 1, sizeof (double));
+        if (weight_values == NULL)
+        {
+                return (NULL);
+        }
+        spline->weight_value = weight_values;
+        spline->weight_value[spline->number_of_weight_values] = weight_value;
+        spline->number_of_weight_values++;
+        return (spline);
+}
+
+
 /* EOF */
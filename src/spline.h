@@ -37,6 +37,7 @@
 
 
 #include "global.h"
+#include "graphic_properties.h"
 #include "binary_graphics_data.h"
 #include "point.h"
 
@@ -64,64 +65,22 @@ typedef struct
 dxf_spline_struct
 {
         /* Members common for all DXF drawable entities. */
-        int id_code;
+        long id_code;
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file.\n
                  * Group code = 5. */
-        char *linetype;
-                /*!< The linetype of the entity.\n
-                 * Defaults to \c BYLAYER if ommitted in the DXF file.\n
-                 * Group code = 6. */
-        char *layer;
-                /*!< Layer on which the entity is drawn.\n
-                 * Defaults to layer "0" if no valid layername is given.\n
-                 * Group code = 8. */
-        double elevation;
-                /*!< Elevation of the spline in the local Z-direction.\n
-                 * Defaults to 0.0 if omitted in the DXF file, or prior
-                 * to DXF version R12, or DXF_FLATLAND equals 0 (default).\n
-                 * Group code = 38. */
-        double thickness;
-                /*!< Thickness of the arc in the local Z-direction.\n
-                 * Defaults to 0.0 if ommitted in the DXF file.\n
-                 * Group code = 39. */
-        double linetype_scale;
-                /*!< Linetype scale (optional).\n
-                 * Group code = 48. */
-        int16_t visibility;
-                /*!< Object visibility (optional):\n
-                 * <ol>
-                 * <li value = "0"> Visible</li>
-                 * <li value = "1"> Invisible</li>
-                 * </ol>
-                 * Group code = 60. */
-        int color;
-                /*!< Color of the entity.\n
-                 * Defaults to \c BYLAYER if ommitted in the DXF file.\n
-                 * Note that entities encapsulated in a block with the
-                 * color \c BYBLOCK are represented in the "native" color of
-                 * the \c BLOCK entity.\n
-                 * Group code = 62. */
-        int paperspace;
-                /*!< Entities are to be drawn on either \c PAPERSPACE or
-                 * \c MODELSPACE.\n
-                 * Optional, defaults to \c DXF_MODELSPACE (0).\n
-                 * Group code = 67. */
+        DxfGraphicProperties *properties;
+                /*!< Linetype, layer, color and the other graphic
+                 * properties, shared with the entities which have
+                 * the same (see graphic_properties.h).\n
+                 * Group codes = 6, 8, 38, 39, 48, 60, 62, 67, 284, 347,
+                 * 370, 390, 420, 430 and 440. */
         int graphics_data_size;
                 /*!< Number of bytes in the proxy entity graphics
                  * represented in the sub-sequent 310 groups, which are
                  * binary chunk records (optional).\n
                  * Group code = 92. */
-        int16_t shadow_mode;
-                /*!< Shadow mode:\n
-                 * <ol>
-                 * <li value = "0"> Casts and receives shadows.</li>
-                 * <li value = "1"> Casts shadows.</li>
-                 * <li value = "2"> Receives shadows.</li>
-                 * <li value = "3"> Ignores shadows.</li>
-                 * </ol>\n
-                 * Group code = 284. */
         DxfBinaryGraphicsData *binary_graphics_data;
                 /*!< Proxy entity graphics data.\n
                  * Multiple lines of 256 characters maximum per line
@@ -130,45 +89,9 @@ dxf_spline_struct
         char *dictionary_owner_soft;
                 /*!< Soft-pointer ID/handle to owner dictionary (optional).\n
                  * Group code = 330. */
-        char *material;
-                /*!< Hard-pointer ID/handle to material object (present if
-                 * not BYLAYER).\n
-                 * Group code = 347. */
         char *dictionary_owner_hard;
                 /*!< Hard owner ID/handle to owner dictionary (optional).\n
                  * Group code = 360. */
-        int16_t lineweight;
-                /*!< Lineweight enum value.\n
-                 * Stored and moved around as a 16-bit integer.\n
-                 * Group code = 370. */
-        char *plot_style_name;
-                /*!< Hard pointer ID / handle of PlotStyleName object.\n
-                 * Group code = 390. */
-        long color_value;
-                /*!< A 24-bit color value that should be dealt with in
-                 * terms of bytes with values of 0 to 255.\n
-                 * The lowest byte is the blue value, the middle byte is
-                 * the green value, and the third byte is the red value.\n
-                 * The top byte is always 0.\n
-                 * The group code cannot be used by custom entities for
-                 * their own data because the group code is reserved for
-                 * AcDbEntity, class-level color data and AcDbEntity,
-                 * class-level transparency data.\n
-                 * Group code = 420. */
-        char *color_name;
-                /*!< Color name.\n
-                 * The group code cannot be used by custom entities for
-                 * their own data because the group code is reserved for
-                 * AcDbEntity, class-level color data and AcDbEntity,
-                 * class-level transparency data.\n
-                 * Group code = 430. */
-        long transparency;
-                /*!< Transparency value.\n
-                 * The group code cannot be used by custom entities for
-                 * their own data because the group code is reserved for
-                 * AcDbEntity, class-level color data and AcDbEntity,
-                 * class-level transparency data.\n
-                 * Group code = 440. */
         /* Specific members for a DXF spline. */
         DxfPoint *p0;
                 /*! Control point (multiple entries).\n
@@ -176,21 +99,31 @@ dxf_spline_struct
         DxfPoint *p1;
                 /*! Fit point (multiple entries).\n
                  * Group codes = 11, 21 and 31.*/
-        DxfPoint *p2;
+        DxfVec3 p2;
                 /*! Start tangent point.\n
                  * May be omitted (in WCS).\n
                  * Group codes = 12, 22 and 32.*/
-        DxfPoint *p3;
+        DxfVec3 p3;
                 /*!< End tangent point.\n
                  * May be omitted (in WCS).\n
                  * Group codes = 13, 23 and 33. */
-        double knot_value[DXF_MAX_PARAM];
-                /*!< Knot value (one entry per knot, multiple entries).\n
+        double *knot_value;
+                /*!< Knot value (one entry per knot, multiple entries),
+                 * \c number_of_knot_values entries.\n
                  * Group code = 40. */
-        double weight_value[DXF_MAX_PARAM];
+        int number_of_knot_values;
+                /*!< Number of entries in \c knot_value. */
+        int knot_value_capacity;
+                /*!< Number of entries \c knot_value has room for. */
+        double *weight_value;
                 /*!< Weight (if not 1); with multiple group pairs, they
-                 * are present if all are not 1.\n
+                 * are present if all are not 1,
+                 * \c number_of_weight_values entries.\n
                  * Group code = 41. */
+        int number_of_weight_values;
+                /*!< Number of entries in \c weight_value. */
+        int weight_value_capacity;
+                /*!< Number of entries \c weight_value has room for. */
         double knot_tolerance;
                 /*!< Knot tolerance (default = 0.0000001).\n
                  * Group code = 42. */
@@ -269,7 +202,7 @@ dxf_spline_free_chain
 (
         DxfSpline *splines
 );
-int
+long
 dxf_spline_get_id_code
 (
         DxfSpline *spline
@@ -278,7 +211,7 @@ DxfSpline *
 dxf_spline_set_id_code
 (
         DxfSpline *spline,
-        int id_code
+        long id_code
 );
 char *
 dxf_spline_get_linetype
@@ -511,6 +444,18 @@ dxf_spline_set_p1
         DxfSpline *spline,
         DxfPoint *p1
 );
+DxfSpline *
+dxf_spline_append_knot_value
+(
+        DxfSpline *spline,
+        double knot_value
+);
+DxfSpline *
+dxf_spline_append_weight_value
+(
+        DxfSpline *spline,
+        double weight_value
+);
 
 
 #ifdef __cplusplus
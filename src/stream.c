@@ -0,0 +1,298 @@
+/*!
+ * \file stream.c
+ *
+ * \author Copyright (C) 2017 by the libDXF developers.
+ *
+ * \brief Streaming (callback based) reading of DXF files.
+ *
+ * dxf_file_stream () reads a DXF file entity by entity and hands every
+ * entity to a callback as soon as it has been read, after which the
+ * entity is freed.\n
+ * Memory use does not depend on the size of the file, which makes this
+ * suitable for very large drawings which do not fit in memory.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#include "stream.h"
+#include "entities.h"
+#include "lexer.h"
+#include "section.h"
+#include "util.h"
+
+
+#define DXF_STREAM_ERROR -1
+        /*!< \brief Section reader result: an entity could not be read. */
+
+
+/*!
+ * \brief Read the \c HEADER section and hand it to the header callback.
+ *
+ * The AutoCAD version found in the header is used for reading the rest
+ * of the file.
+ *
+ * \return the value returned by the callback, or \c DXF_STREAM_CONTINUE.
+ */
+static int
+dxf_stream_header
+(
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
+        DxfStreamCallbacks *callbacks,
+                /*!< callbacks. */
+        void *user_data
+                /*!< passed to the callbacks. */
+)
+{
+        DxfHeader *header;
+        int result = DXF_STREAM_CONTINUE;
+
+        header = dxf_header_new ();
+        if (header == NULL)
+        {
+                return (DXF_STREAM_CONTINUE);
+        }
+        if (dxf_header_read (fp, header) != NULL)
+        {
+                if (header->_AcadVer > 0)
+                {
+                        fp->acad_version_number = header->_AcadVer;
+                }
+                if (callbacks->header != NULL)
+                {
+                        result = callbacks->header (header, user_data);
+                }
+        }
+        dxf_header_free (header);
+        return (result);
+}
+
+
+/*!
+ * \brief Read the \c ENTITIES section and hand every entity to the
+ * entity callback.
+ *
+ * \return \c DXF_STREAM_STOP when a callback asked to stop,
+ * \c DXF_STREAM_ERROR when an entity could not be read, or
+ * \c DXF_STREAM_CONTINUE at the end of the section.
+ */
+static int
+dxf_stream_entities_section
+(
+        DxfFile *fp,
+                /*!< DXF file handle of input file (or device). */
+        DxfStreamCallbacks *callbacks,
+                /*!< callbacks. */
+        void *user_data
+                /*!< passed to the callbacks. */
+)
+{
+        char name[DXF_MAX_STRING_LENGTH];
+        DxfEntityType type;
+        DxfPair pair;
+        void *entity;
+        int result;
+
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
+        {
+                if (pair.group_code != 0)
+                {
+                        /* Stray group, ignore it. */
+                        continue;
+                }
+                if (dxf_pair_value_is (&pair, "ENDSEC"))
+                {
+                        return (DXF_STREAM_CONTINUE);
+                }
+                type = dxf_entities_get_type (&pair);
+                if ((type == UNKNOWN_ENTITY) || (callbacks->entity == NULL))
+                {
+                        result = DXF_STREAM_CONTINUE;
+                        if ((type == UNKNOWN_ENTITY) && (callbacks->unknown_entity != NULL))
+                        {
+                                dxf_pair_copy_string (&pair, name, sizeof (name));
+                                result = callbacks->unknown_entity (name, user_data);
+                        }
+                        dxf_entities_skip_entity (fp);
+                        if (result == DXF_STREAM_STOP)
+                        {
+                                return (DXF_STREAM_STOP);
+                        }
+                        continue;
+                }
+                if (dxf_filter_skip_entity (fp, type))
+                {
+                        continue;
+                }
+                entity = dxf_entities_read_entity (fp, type);
+                if (entity == NULL)
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () could not read an entity near line %d.\n")),
+                          __FUNCTION__, fp->line_number);
+                        return (DXF_STREAM_ERROR);
+                }
+                result = callbacks->entity (type, entity, user_data);
+                if (result != DXF_STREAM_KEEP)
+                {
+                        dxf_entities_free_entity (type, entity);
+                }
+                if (result == DXF_STREAM_STOP)
+                {
+                        return (DXF_STREAM_STOP);
+                }
+        }
+        return (DXF_STREAM_CONTINUE);
+}
+
+
+/*!
+ * \brief Read a DXF file, handing every entity to a callback as soon as
+ * it has been read.
+ *
+ * The \c HEADER section is handed to \c callbacks->header, every entity
+ * in the \c ENTITIES section to \c callbacks->entity.\n
+ * Unless the callback returns \c DXF_STREAM_KEEP, an entity is freed
+ * when the callback returns, so only one entity is in memory at any
+ * time.\n
+ * A callback returning \c DXF_STREAM_STOP ends reading.\n
+ * All other sections are skipped.\n
+ * Both ASCII and binary DXF files are accepted.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_file_stream
+(
+        const char *filename,
+                /*!< filename of input file (or device). */
+        DxfStreamCallbacks *callbacks,
+                /*!< callbacks to invoke. */
+        void *user_data
+                /*!< passed unchanged to the callbacks. */
+)
+{
+        return (dxf_file_stream_filtered (filename, callbacks, NULL, user_data));
+}
+
+
+/*!
+ * \brief Read a DXF file like dxf_file_stream (), handing only the
+ * entities which pass \c filter to \c callbacks->entity.
+ *
+ * Entities which do not pass are skipped without being allocated.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_file_stream_filtered
+(
+        const char *filename,
+                /*!< filename of input file (or device). */
+        DxfStreamCallbacks *callbacks,
+                /*!< callbacks to invoke. */
+        DxfFilter *filter,
+                /*!< the filter, or \c NULL to hand every entity. */
+        void *user_data
+                /*!< passed unchanged to the callbacks. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfFile *fp;
+        DxfPair pair;
+        int result = DXF_STREAM_CONTINUE;
+
+        /* Do some basic checks. */
+        if (callbacks == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        fp = dxf_read_init_mmap (filename);
+        if (fp == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not open file: %s.\n")),
+                  __FUNCTION__, filename);
+                return (EXIT_FAILURE);
+        }
+        fp->filter = filter;
+        dxf_lexer_detect_binary (fp);
+        while ((result != DXF_STREAM_STOP)
+          && (result != DXF_STREAM_ERROR)
+          && (dxf_lexer_read_pair (fp, &pair) == 1))
+        {
+                if (pair.group_code != 0)
+                {
+                        continue;
+                }
+                if (dxf_pair_value_is (&pair, "EOF"))
+                {
+                        break;
+                }
+                if (!dxf_pair_value_is (&pair, "SECTION"))
+                {
+                        continue;
+                }
+                if ((dxf_lexer_read_pair (fp, &pair) != 1)
+                  || (pair.group_code != 2))
+                {
+                        break;
+                }
+                if (dxf_pair_value_is (&pair, "HEADER"))
+                {
+                        result = dxf_stream_header (fp, callbacks, user_data);
+                        dxf_section_skip (fp);
+                }
+                else if (dxf_pair_value_is (&pair, "ENTITIES"))
+                {
+                        result = dxf_stream_entities_section (fp, callbacks, user_data);
+                }
+                else
+                {
+                        dxf_section_skip (fp);
+                }
+        }
+        dxf_read_close (fp);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        if (result == DXF_STREAM_ERROR)
+        {
+                return (EXIT_FAILURE);
+        }
+        return (EXIT_SUCCESS);
+}
+
+
+/* EOF */
@@ -0,0 +1,109 @@
+/*!
+ * \file stream.h
+ *
+ * \author Copyright (C) 2017 by the libDXF developers.
+ *
+ * \brief Streaming (callback based) reading of DXF files, header file.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+
+
+#ifndef LIBDXF_SRC_STREAM_H
+#define LIBDXF_SRC_STREAM_H
+
+
+#include "global.h"
+#include "entity.h"
+#include "filter.h"
+#include "header.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define DXF_STREAM_CONTINUE 0
+        /*!< \brief Callback return value: free the entity and continue. */
+#define DXF_STREAM_STOP 1
+        /*!< \brief Callback return value: free the entity and stop
+         * reading. */
+#define DXF_STREAM_KEEP 2
+        /*!< \brief Callback return value: the callback took ownership of
+         * the entity, continue without freeing it. */
+
+
+/*!
+ * \brief Callbacks invoked by dxf_file_stream ().
+ *
+ * Unused callbacks are \c NULL.
+ */
+typedef struct
+dxf_stream_callbacks_struct
+{
+        int (*header) (DxfHeader *header, void *user_data);
+                /*!< Called with the contents of the \c HEADER section.\n
+                 * The header is freed when the callback returns. */
+        int (*entity) (DxfEntityType type, void *entity, void *user_data);
+                /*!< Called for every entity in the \c ENTITIES section
+                 * after it has been read, \c entity points to the
+                 * struct for \c type (\c DxfLine for \c LINE, \c DxfArc
+                 * for \c ARC, ...). */
+        int (*unknown_entity) (const char *name, void *user_data);
+                /*!< Called for entities which libDXF can not read, the
+                 * entity is skipped. */
+} DxfStreamCallbacks;
+
+
+int
+dxf_file_stream
+(
+        const char *filename,
+        DxfStreamCallbacks *callbacks,
+        void *user_data
+);
+int
+dxf_file_stream_filtered
+(
+        const char *filename,
+        DxfStreamCallbacks *callbacks,
+        DxfFilter *filter,
+        void *user_data
+);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* LIBDXF_SRC_STREAM_H */
+
+
+/* EOF */
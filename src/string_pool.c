@@ -0,0 +1,473 @@
+/*!
+ * \file string_pool.c
+ *
+ * \author Copyright (C) 2017 by the libDXF developers.
+ *
+ * \brief Pool of shared, immutable strings.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+
+
+#include "string_pool.h"
+
+
+/*!
+ * \brief FNV-1a hash of the \c length bytes of \c string.
+ */
+static uint64_t
+dxf_string_pool_hash
+(
+        const char *string,
+                /*!< the string. */
+        size_t length
+                /*!< number of bytes in \c string. */
+)
+{
+        uint64_t hash = UINT64_C (0xCBF29CE484222325);
+        size_t i;
+
+        for (i = 0; i < length; i++)
+        {
+                hash ^= (unsigned char) string[i];
+                hash *= UINT64_C (0x100000001B3);
+        }
+        return (hash);
+}
+
+
+/*!
+ * \brief Find the slot of a string in \c stripe.
+ *
+ * \return the slot holding the string, or the empty slot where it
+ * belongs.
+ */
+static DxfStringPoolSlot *
+dxf_string_pool_find
+(
+        DxfStringPoolStripe *stripe,
+                /*!< the stripe. */
+        uint64_t hash,
+                /*!< hash of the string. */
+        const char *string,
+                /*!< the string. */
+        size_t length
+                /*!< number of bytes in \c string. */
+)
+{
+        DxfStringPoolSlot *slot;
+        size_t i;
+
+        /* The low bits of the hash select the stripe. */
+        i = (size_t) (hash >> 8) & (stripe->capacity - 1);
+        for (;;)
+        {
+                slot = &stripe->slots[i];
+                if ((slot->string == NULL)
+                  || ((slot->hash == hash)
+                  && (strncmp (slot->string, string, length) == 0)
+                  && (slot->string[length] == '\0')))
+                {
+                        return (slot);
+                }
+                i = (i + 1) & (stripe->capacity - 1);
+        }
+}
+
+
+/*!
+ * \brief Double the number of slots of \c stripe.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when no memory
+ * could be allocated.
+ */
+static int
+dxf_string_pool_grow
+(
+        DxfStringPoolStripe *stripe
+                /*!< the stripe. */
+)
+{
+        DxfStringPoolSlot *slots;
+        size_t capacity;
+        size_t i;
+        size_t j;
+
+        capacity = stripe->capacity * 2;
+        slots = calloc (capacity, sizeof (DxfStringPoolSlot));
+        if (slots == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        for (i = 0; i < stripe->capacity; i++)
+        {
+                if (stripe->slots[i].string == NULL)
+                {
+                        continue;
+                }
+                j = (size_t) (stripe->slots[i].hash >> 8) & (capacity - 1);
+                while (slots[j].string != NULL)
+                {
+                        j = (j + 1) & (capacity - 1);
+                }
+                slots[j] = stripe->slots[i];
+        }
+        free (stripe->slots);
+        stripe->slots = slots;
+        stripe->capacity = capacity;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Copy \c string into the storage of \c stripe.
+ *
+ * \return the copy, or \c NULL when no memory could be allocated.
+ */
+static char *
+dxf_string_pool_store
+(
+        DxfStringPoolStripe *stripe,
+                /*!< the stripe. */
+        const char *string,
+                /*!< the string. */
+        size_t length
+                /*!< number of bytes in \c string. */
+)
+{
+        char *copy;
+
+        if (stripe->storage == NULL)
+        {
+                /* Strings in an arena are left alone by dxf_free (). */
+                stripe->storage = dxf_arena_new ();
+                if (stripe->storage == NULL)
+                {
+                        return (NULL);
+                }
+                stripe->storage->block_size = DXF_STRING_POOL_BLOCK_SIZE;
+        }
+        copy = dxf_arena_alloc (stripe->storage, length + 1);
+        if (copy == NULL)
+        {
+                return (NULL);
+        }
+        memcpy (copy, string, length);
+        copy[length] = '\0';
+        return (copy);
+}
+
+
+/*!
+ * \brief Allocate an empty \c DxfStringPool.
+ *
+ * \return \c NULL when no memory was allocated, a pointer to the
+ * allocated memory when succesful.
+ */
+DxfStringPool *
+dxf_string_pool_new ()
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        DxfStringPool *pool = NULL;
+        int i;
+
+        if ((pool = malloc (sizeof (DxfStringPool))) == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory for a DxfStringPool struct.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        for (i = 0; i < DXF_STRING_POOL_STRIPES; i++)
+        {
+                pool->stripes[i].slots = calloc (DXF_STRING_POOL_MIN_CAPACITY,
+                  sizeof (DxfStringPoolSlot));
+                pool->stripes[i].capacity = DXF_STRING_POOL_MIN_CAPACITY;
+                pool->stripes[i].count = 0;
+                pool->stripes[i].storage = NULL;
+#if !defined (MSDOS) && !defined (_WIN32)
+                pthread_mutex_init (&pool->stripes[i].lock, NULL);
+#endif
+                if (pool->stripes[i].slots == NULL)
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () could not allocate memory.\n")),
+                          __FUNCTION__);
+                        while (i >= 0)
+                        {
+                                free (pool->stripes[i].slots);
+#if !defined (MSDOS) && !defined (_WIN32)
+                                pthread_mutex_destroy (&pool->stripes[i].lock);
+#endif
+                                i--;
+                        }
+                        free (pool);
+                        return (NULL);
+                }
+        }
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (pool);
+}
+
+
+/*!
+ * \brief Get the copy in \c pool of the first \c length bytes of
+ * \c string, adding it when the pool has none yet.
+ *
+ * \c string does not need to be terminated with a \c NUL character.
+ *
+ * \return the copy in the pool, or \c NULL when an error occurred.
+ */
+char *
+dxf_string_pool_intern_n
+(
+        DxfStringPool *pool,
+                /*!< the pool. */
+        const char *string,
+                /*!< the string. */
+        size_t length
+                /*!< number of bytes in \c string. */
+)
+{
+        DxfStringPoolStripe *stripe;
+        DxfStringPoolSlot *slot;
+        uint64_t hash;
+        char *result = NULL;
+
+        /* Do some basic checks. */
+        if ((pool == NULL) || (string == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        hash = dxf_string_pool_hash (string, length);
+        stripe = &pool->stripes[hash & (DXF_STRING_POOL_STRIPES - 1)];
+#if !defined (MSDOS) && !defined (_WIN32)
+        pthread_mutex_lock (&stripe->lock);
+#endif
+        slot = dxf_string_pool_find (stripe, hash, string, length);
+        if (slot->string != NULL)
+        {
+                result = slot->string;
+        }
+        else if ((2 * (stripe->count + 1) <= stripe->capacity)
+          || (dxf_string_pool_grow (stripe) == EXIT_SUCCESS))
+        {
+                result = dxf_string_pool_store (stripe, string, length);
+                if (result != NULL)
+                {
+                        slot = dxf_string_pool_find (stripe, hash, string, length);
+                        slot->hash = hash;
+                        slot->string = result;
+                        stripe->count++;
+                }
+        }
+#if !defined (MSDOS) && !defined (_WIN32)
+        pthread_mutex_unlock (&stripe->lock);
+#endif
+        return (result);
+}
+
+
+/*!
+ * \brief Get the copy of \c string in \c pool, adding it when the pool
+ * has none yet.
+ *
+ * \return the copy in the pool, or \c NULL when an error occurred.
+ */
+char *
+dxf_string_pool_intern
+(
+        DxfStringPool *pool,
+                /*!< the pool. */
+        const char *string
+                /*!< the string. */
+)
+{
+        if (string == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        return (dxf_string_pool_intern_n (pool, string, strlen (string)));
+}
+
+
+/*!
+ * \brief Get the copy of \c string in \c pool without adding it.
+ *
+ * Compare the result with the strings from the pool, e.g. the layers of
+ * the entities of a drawing, to find equal strings by their pointers.
+ *
+ * \return the copy in the pool, or \c NULL when the pool does not hold
+ * the string.
+ */
+char *
+dxf_string_pool_lookup
+(
+        DxfStringPool *pool,
+                /*!< the pool. */
+        const char *string
+                /*!< the string. */
+)
+{
+        DxfStringPoolStripe *stripe;
+        uint64_t hash;
+        size_t length;
+        char *result;
+
+        if ((pool == NULL) || (string == NULL))
+        {
+                return (NULL);
+        }
+        length = strlen (string);
+        hash = dxf_string_pool_hash (string, length);
+        stripe = &pool->stripes[hash & (DXF_STRING_POOL_STRIPES - 1)];
+#if !defined (MSDOS) && !defined (_WIN32)
+        pthread_mutex_lock (&stripe->lock);
+#endif
+        result = dxf_string_pool_find (stripe, hash, string, length)->string;
+#if !defined (MSDOS) && !defined (_WIN32)
+        pthread_mutex_unlock (&stripe->lock);
+#endif
+        return (result);
+}
+
+
+/*!
+ * \brief Test if \c string is stored in \c pool (not just equal to a
+ * string in the pool).
+ *
+ * \return \c TRUE when \c string belongs to the pool, \c FALSE
+ * otherwise.
+ */
+int
+dxf_string_pool_owns
+(
+        DxfStringPool *pool,
+                /*!< the pool. */
+        const char *string
+                /*!< the string. */
+)
+{
+        return ((string != NULL)
+          && (dxf_string_pool_lookup (pool, string) == string));
+}
+
+
+/*!
+ * \brief Get the number of strings in \c pool.
+ *
+ * \return the number of strings.
+ */
+size_t
+dxf_string_pool_count
+(
+        DxfStringPool *pool
+                /*!< the pool. */
+)
+{
+        size_t count = 0;
+        int i;
+
+        if (pool == NULL)
+        {
+                return (0);
+        }
+        for (i = 0; i < DXF_STRING_POOL_STRIPES; i++)
+        {
+#if !defined (MSDOS) && !defined (_WIN32)
+                pthread_mutex_lock (&pool->stripes[i].lock);
+#endif
+                count += pool->stripes[i].count;
+#if !defined (MSDOS) && !defined (_WIN32)
+                pthread_mutex_unlock (&pool->stripes[i].lock);
+#endif
+        }
+        return (count);
+}
+
+
+/*!
+ * \brief Free the allocated memory for a \c DxfStringPool and all the
+ * strings in it.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_string_pool_free
+(
+        DxfStringPool *pool
+                /*!< the pool. */
+)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        int i;
+
+        /* Do some basic checks. */
+        if (pool == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        for (i = 0; i < DXF_STRING_POOL_STRIPES; i++)
+        {
+                if (pool->stripes[i].storage != NULL)
+                {
+                        dxf_arena_free (pool->stripes[i].storage);
+                }
+                free (pool->stripes[i].slots);
+#if !defined (MSDOS) && !defined (_WIN32)
+                pthread_mutex_destroy (&pool->stripes[i].lock);
+#endif
+        }
+        free (pool);
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/* EOF */
@@ -0,0 +1,167 @@
+/*!
+ * \file string_pool.h
+ *
+ * \author Copyright (C) 2017 by the libDXF developers.
+ *
+ * \brief Pool of shared, immutable strings, header file.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+
+
+#ifndef LIBDXF_SRC_STRING_POOL_H
+#define LIBDXF_SRC_STRING_POOL_H
+
+
+#include "global.h"
+#include "arena.h"
+
+#if !defined (MSDOS) && !defined (_WIN32)
+#include <pthread.h>
+#endif
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define DXF_STRING_POOL_STRIPES 16
+        /*!< \brief Number of independently locked parts of a
+         * DxfStringPool, a power of two. */
+#define DXF_STRING_POOL_MIN_CAPACITY 64
+        /*!< \brief Smallest number of slots in a part of a
+         * DxfStringPool. */
+#define DXF_STRING_POOL_BLOCK_SIZE 65536
+        /*!< \brief Number of bytes of string storage allocated at once. */
+
+
+/*!
+ * \brief One slot of a DxfStringPool.
+ */
+typedef struct
+dxf_string_pool_slot_struct
+{
+        uint64_t hash;
+                /*!< Hash of \c string. */
+        char *string;
+                /*!< The string, \c NULL in an empty slot. */
+} DxfStringPoolSlot;
+
+
+/*!
+ * \brief Storage for the strings of a DxfStringPool.
+ */
+/*!
+ * \brief A part of a DxfStringPool, holding the strings with the same
+ * low hash bits.
+ */
+typedef struct
+dxf_string_pool_stripe_struct
+{
+        DxfStringPoolSlot *slots;
+                /*!< Open addressing hash table, a power of two of
+                 * slots. */
+        size_t capacity;
+                /*!< Number of slots. */
+        size_t count;
+                /*!< Number of strings, at most half of \c capacity. */
+        DxfArena *storage;
+                /*!< Storage of the strings, \c NULL until the first
+                 * string is added. */
+#if !defined (MSDOS) && !defined (_WIN32)
+        pthread_mutex_t lock;
+                /*!< Protects the stripe. */
+#endif
+} DxfStringPoolStripe;
+
+
+/*!
+ * \brief A pool of shared strings.
+ *
+ * Every distinct string is stored once, so two strings from the same
+ * pool are equal when their pointers are equal.  Strings in the pool
+ * must not be changed or freed, they live as long as the pool.\n
+ * The pool can be shared by threads.
+ */
+typedef struct
+dxf_string_pool_struct
+{
+        DxfStringPoolStripe stripes[DXF_STRING_POOL_STRIPES];
+                /*!< The parts of the pool. */
+} DxfStringPool;
+
+
+DxfStringPool *
+dxf_string_pool_new ();
+char *
+dxf_string_pool_intern
+(
+        DxfStringPool *pool,
+        const char *string
+);
+char *
+dxf_string_pool_intern_n
+(
+        DxfStringPool *pool,
+        const char *string,
+        size_t length
+);
+char *
+dxf_string_pool_lookup
+(
+        DxfStringPool *pool,
+        const char *string
+);
+int
+dxf_string_pool_owns
+(
+        DxfStringPool *pool,
+        const char *string
+);
+size_t
+dxf_string_pool_count
+(
+        DxfStringPool *pool
+);
+int
+dxf_string_pool_free
+(
+        DxfStringPool *pool
+);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* LIBDXF_SRC_STRING_POOL_H */
+
+
+/* EOF */
@@ -33,6 +33,8 @@
 
 
 #include "style.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -164,7 +166,8 @@ dxf_style_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfPair pair;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -172,8 +175,6 @@ dxf_style_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (style == NULL)
@@ -184,136 +185,114 @@ dxf_style_read
                 style = dxf_style_new ();
                 style = dxf_style_init (style);
         }
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        fclose (fp->fp);
-                        /* Clean up. */
-                        free (temp_string);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &style->id_code);
-                }
-                else if (strcmp (temp_string, "2") == 0)
-                {
-                        /* Now follows a string containing a style name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", style->style_name);
-                }
-                else if (strcmp (temp_string, "3") == 0)
-                {
-                        /* Now follows a string containing a primary
-                         * font filename. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", style->primary_font_filename);
-                }
-                else if (strcmp (temp_string, "4") == 0)
-                {
-                        /* Now follows a string containing a big font
-                         * filename. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", style->big_font_filename);
-                }
-                else if (strcmp (temp_string, "40") == 0)
-                {
-                        /* Now follows a string containing the
-                         * height. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &style->height);
-                }
-                else if (strcmp (temp_string, "41") == 0)
-                {
-                        /* Now follows a string containing the
-                         * width. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &style->width);
-                }
-                else if (strcmp (temp_string, "42") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing the
-                         * last used height. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &style->last_height);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else if (strcmp (temp_string, "50") == 0)
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing the
-                         * oblique angle. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &style->oblique_angle);
-                }
-                else if (strcmp (temp_string, "70") == 0)
-                {
-                        /* Now follows a string containing the
-                         * standard flag value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &style->flag);
-                }
-                else if (strcmp (temp_string, "71") == 0)
-                {
-                        /* Now follows a string containing the
-                         * text generation flag value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &style->text_generation_flag);
-                }
-                else if ((fp->acad_version_number >= AutoCAD_13)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if ((strcmp (temp_string, "AcDbSymbolTableRecord") != 0)
-                        && ((strcmp (temp_string, "AcDbTextStyleTableRecord") != 0)))
-                        {
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                style->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 2:
+                                /* Now follows a string containing a style name. */
+                                free (style->style_name);
+                                style->style_name = dxf_pair_get_string (&pair);
+                                break;
+                        case 3:
+                                /* Now follows a string containing a primary
+                                 * font filename. */
+                                free (style->primary_font_filename);
+                                style->primary_font_filename = dxf_pair_get_string (&pair);
+                                break;
+                        case 4:
+                                /* Now follows a string containing a big font
+                                 * filename. */
+                                free (style->big_font_filename);
+                                style->big_font_filename = dxf_pair_get_string (&pair);
+                                break;
+                        case 40:
+                                /* Now follows a string containing the
+                                 * height. */
+                                style->height = dxf_pair_get_double (&pair);
+                                break;
+                        case 41:
+                                /* Now follows a string containing the
+                                 * width. */
+                                style->width = dxf_pair_get_double (&pair);
+                                break;
+                        case 42:
+                                /* Now follows a string containing the
+                                 * last used height. */
+                                style->last_height = dxf_pair_get_double (&pair);
+                                break;
+                        case 50:
+                                /* Now follows a string containing the
+                                 * oblique angle. */
+                                style->oblique_angle = dxf_pair_get_double (&pair);
+                                break;
+                        case 70:
+                                /* Now follows a string containing the
+                                 * standard flag value. */
+                                style->flag = dxf_pair_get_int (&pair);
+                                break;
+                        case 71:
+                                /* Now follows a string containing the
+                                 * text generation flag value. */
+                                style->text_generation_flag = dxf_pair_get_int (&pair);
+                                break;
+                        case 100:
+                                if (fp->acad_version_number >= AutoCAD_13)
+                                {
+                                        /* Now follows a string containing the
+                                         * subclass marker value. */
+                                        dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                        if ((strcmp (temp_string, "AcDbSymbolTableRecord") != 0)
+                                        && ((strcmp (temp_string, "AcDbTextStyleTableRecord") != 0)))
+                                        {
+                                                fprintf (stderr,
+                                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                                  __FUNCTION__, fp->filename, fp->line_number);
+                                        }
+                                }
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner dictionary. */
+                                free (style->dictionary_owner_soft);
+                                style->dictionary_owner_soft = dxf_pair_get_string (&pair);
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                free (style->dictionary_owner_hard);
+                                style->dictionary_owner_hard = dxf_pair_get_string (&pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, "DXF comment: %s\n", temp_string);
+                                break;
+                        default:
                                 fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
                                   __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", style->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", style->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
         /* Handle omitted members and/or illegal values. */
         if (strcmp (style->style_name, "") == 0)
         {
-                sprintf (style->style_name, "%i", style->id_code);
+                sprintf (temp_string, "%li", style->id_code);
+                free (style->style_name);
+                style->style_name = strdup (temp_string);
                 fprintf (stderr,
                   (_("Warning in %s () illegal style name value found while reading from: %s in line: %d.\n")),
                   __FUNCTION__, fp->filename, fp->line_number);
@@ -321,13 +300,13 @@ dxf_style_read
         if ((strcmp (style->primary_font_filename, "") == 0)
           && (style->flag == 1))
         {
-                sprintf (style->primary_font_filename, "%i", style->id_code);
+                sprintf (temp_string, "%li", style->id_code);
+                free (style->primary_font_filename);
+                style->primary_font_filename = strdup (temp_string);
                 fprintf (stderr,
                   (_("Warning in %s () illegal primary font filename value found while reading from: %s in line: %d.\n")),
                   __FUNCTION__, fp->filename, fp->line_number);
         }
-        /* Clean up. */
-        free (temp_string);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -381,10 +360,10 @@ dxf_style_write
                 return (EXIT_FAILURE);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_string (fp, 0, dxf_entity_name);
         if (style->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", style->id_code);
+                dxf_write_hex (fp, 5, style->id_code);
         }
         /*!
          * \todo for version R14.\n
@@ -399,31 +378,31 @@ dxf_style_write
         if ((strcmp (style->dictionary_owner_soft, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", style->dictionary_owner_soft);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, style->dictionary_owner_soft);
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (style->dictionary_owner_hard, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", style->dictionary_owner_hard);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, style->dictionary_owner_hard);
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbSymbolTableRecord\n");
-                fprintf (fp->fp, "100\nAcDbTextStyleTableRecord\n");
+                dxf_write_string (fp, 100, "AcDbSymbolTableRecord");
+                dxf_write_string (fp, 100, "AcDbTextStyleTableRecord");
         }
-        fprintf (fp->fp, "  2\n%s\n", style->style_name);
-        fprintf (fp->fp, " 70\n%d\n", style->flag);
-        fprintf (fp->fp, " 40\n%f\n", style->height);
-        fprintf (fp->fp, " 41\n%f\n", style->width);
-        fprintf (fp->fp, " 50\n%f\n", style->oblique_angle);
-        fprintf (fp->fp, " 71\n%d\n", style->text_generation_flag);
-        fprintf (fp->fp, " 42\n%f\n", style->last_height);
-        fprintf (fp->fp, "  3\n%s\n", style->primary_font_filename);
-        fprintf (fp->fp, "  4\n%s\n", style->big_font_filename);
+        dxf_write_string (fp, 2, style->style_name);
+        dxf_write_int (fp, 70, style->flag);
+        dxf_write_double (fp, 40, style->height);
+        dxf_write_double (fp, 41, style->width);
+        dxf_write_double (fp, 50, style->oblique_angle);
+        dxf_write_int (fp, 71, style->text_generation_flag);
+        dxf_write_double (fp, 42, style->last_height);
+        dxf_write_string (fp, 3, style->primary_font_filename);
+        dxf_write_string (fp, 4, style->big_font_filename);
         /* Clean up. */
         free (dxf_entity_name);
 #if DEBUG
@@ -467,6 +446,8 @@ dxf_style_free
         free (style->style_name);
         free (style->primary_font_filename);
         free (style->big_font_filename);
+        free (style->dictionary_owner_soft);
+        free (style->dictionary_owner_hard);
         free (style);
         style = NULL;
 #if DEBUG
@@ -494,7 +475,7 @@ dxf_style_free_chain
                  * entries. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (styles == NULL)
@@ -506,6 +487,7 @@ dxf_style_free_chain
         while (styles != NULL)
         {
                 struct DxfStyle *iter = styles->next;
+                styles->next = NULL;
                 dxf_style_free (styles);
                 styles = (DxfStyle *) iter;
         }
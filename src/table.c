@@ -35,6 +35,9 @@
 
 
 #include "table.h"
+#include "arena.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -64,7 +67,7 @@ dxf_table_cell_new ()
         size = sizeof (DxfTableCell);
         /* avoid malloc of 0 bytes */
         if (size == 0) size = 1;
-        if ((cell = malloc (size)) == NULL)
+        if ((cell = dxf_malloc (size)) == NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () could not allocate memory for a DxfTableCell struct.\n")),
@@ -109,7 +112,7 @@ dxf_table_new ()
         size = sizeof (DxfTable);
         /* avoid malloc of 0 bytes */
         if (size == 0) size = 1;
-        if ((table = malloc (size)) == NULL)
+        if ((table = dxf_malloc (size)) == NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () could not allocate memory for a DxfTable struct.\n")),
@@ -151,8 +154,6 @@ dxf_table_cell_init
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        int i;
-
         /* Do some basic checks. */
         if (cell == NULL)
         {
@@ -168,13 +169,14 @@ dxf_table_cell_init
                   __FUNCTION__);
                 return (NULL);
         }
-        cell->text_string = strdup ("");
-        for (i = 0; i < DXF_MAX_PARAM; i++)
-        {
-                cell->optional_text_string[i] = strdup ("");
-                cell->attdef_soft_pointer[i] = strdup ("");
-        }
-        cell->text_style_name = strdup (DXF_DEFAULT_TEXTSTYLE);
+        cell->text_string = dxf_strdup ("");
+        cell->optional_text_string = NULL;
+        cell->number_of_optional_text_strings = 0;
+        cell->optional_text_string_capacity = 0;
+        cell->attdef_soft_pointer = NULL;
+        cell->number_of_attdef_soft_pointers = 0;
+        cell->attdef_soft_pointer_capacity = 0;
+        cell->text_style_name = dxf_strdup (DXF_DEFAULT_TEXTSTYLE);
         cell->color_bg = 0;
         cell->color_fg = DXF_COLOR_BYLAYER;
         cell->border_color_right = DXF_COLOR_BYLAYER;
@@ -203,9 +205,9 @@ dxf_table_cell_init
         cell->border_visibility_override_bottom = 0;
         cell->border_visibility_override_left = 0;
         cell->border_visibility_override_top = 0;
-        cell->attdef_text_string = strdup ("");
-        cell->block_table_record_hard_pointer = strdup ("");
-        cell->field_object_pointer = strdup ("");
+        cell->attdef_text_string = dxf_strdup ("");
+        cell->block_table_record_hard_pointer = dxf_strdup ("");
+        cell->field_object_pointer = dxf_strdup ("");
         cell->next = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -238,8 +240,6 @@ dxf_table_init
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        int i;
-
         /* Do some basic checks. */
         if (table == NULL)
         {
@@ -256,24 +256,21 @@ dxf_table_init
                 return (NULL);
         }
         table->id_code = 0;
-        table->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        table->layer = strdup (DXF_DEFAULT_LAYER);
-        table->elevation = 0.0;
-        table->thickness = 0.0;
-        table->visibility = 0;
-        table->color = DXF_COLOR_BYLAYER;
-        table->paperspace = DXF_MODELSPACE;
+        table->properties = dxf_graphic_properties_default ();
         table->graphics_data_size = 0;
-        for (i = 0; i < DXF_MAX_PARAM; i++)
-        {
-                table->binary_graphics_data[i] = strdup ("");
-                table->row_height[i] = 0.0;
-                table->column_height[i] = 0.0;
-        }
-        table->dictionary_owner_soft = strdup ("");
-        table->dictionary_owner_hard = strdup ("");
-        table->block_name = strdup ("");
-        table->table_text_style_name = strdup ("");
+        table->binary_graphics_data = NULL;
+        table->number_of_binary_graphics_data = 0;
+        table->binary_graphics_data_capacity = 0;
+        table->row_height = NULL;
+        table->number_of_row_heights = 0;
+        table->row_height_capacity = 0;
+        table->column_height = NULL;
+        table->number_of_column_heights = 0;
+        table->column_height_capacity = 0;
+        table->dictionary_owner_soft = dxf_strdup ("");
+        table->dictionary_owner_hard = dxf_strdup ("");
+        table->block_name = dxf_strdup ("");
+        table->table_text_style_name = dxf_strdup ("");
         table->x0 = 0.0;
         table->y0 = 0.0;
         table->z0 = 0.0;
@@ -302,8 +299,8 @@ dxf_table_init
         table->suppress_table_title = 0;
         table->suppress_header_row = 0;
         table->table_cell_color_fill_override = 0;
-        table->tablestyle_object_pointer = strdup ("");
-        table->owning_block_pointer = strdup ("");
+        table->tablestyle_object_pointer = dxf_strdup ("");
+        table->owning_block_pointer = dxf_strdup ("");
         table->cells = NULL;
         table->next = NULL;
 #if DEBUG
@@ -343,11 +340,12 @@ dxf_table_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfGraphicProperties properties;
+        DxfPair pair;
         int i;
-        int j;
-        int k;
-        int l;
+        char **strings;
+        double *values;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -355,8 +353,6 @@ dxf_table_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (table == NULL)
@@ -368,224 +364,206 @@ dxf_table_read
                 table = dxf_table_init (table);
         }
         i = 0;
-        j = 0;
-        k = 0;
-        l = 0;
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
-        {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        fclose (fp->fp);
-                        /* Clean up. */
-                        free (temp_string);
-                        return (NULL);
-                }
-                else if (strcmp (temp_string, "2") == 0)
-                {
-                        /* Now follows a string containing a block name;
-                         * an anonymous block begins with a *T value. */
-                        fscanf (fp->fp, "%s\n", table->block_name);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &table->id_code);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the insertion point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &table->x0);
-                }
-                else if (strcmp (temp_string, "11") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the horizontal direction
-                         * vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &table->x1);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the insertion point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &table->y0);
-                }
-                else if (strcmp (temp_string, "21") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the horizontal direction
-                         * vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &table->y1);
-                }
-                else if (strcmp (temp_string, "30") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the insertion point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &table->z0);
-                }
-                else if (strcmp (temp_string, "31") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the horizontal direction
-                         * vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &table->z1);
-                }
-                else if (strcmp (temp_string, "90") == 0)
-                {
-                        /* Now follows a string containing the flag for
-                         * table value (unsigned integer). */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &table->table_value_flag);
-                }
-                else if (strcmp (temp_string, "91") == 0)
-                {
-                        /* Now follows a string containing the number of
-                         * rows. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &table->number_of_rows);
-                }
-                else if ((strcmp (temp_string, "92") == 0)
-                  && (i == 0))
-                {
-                        /* Now follows a string containing the
-                         * number of bytes in the proxy entity graphics. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &table->graphics_data_size);
-                        i++;
-                }
-                else if ((strcmp (temp_string, "92") == 0)
-                  && (i == 1))
-                {
-                        /* Now follows a string containing the number of
-                         * columns. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &table->number_of_columns);
-                }
-                else if (strcmp (temp_string, "93") == 0)
-                {
-                        /* Now follows a string containing the flag for
-                         * an override. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &table->override_flag);
-                }
-                else if (strcmp (temp_string, "94") == 0)
-                {
-                        /* Now follows a string containing the flag for
-                         * an override of the border color. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &table->border_color_override_flag);
-                }
-                else if (strcmp (temp_string, "95") == 0)
-                {
-                        /* Now follows a string containing the flag for
-                         * an override of the border lineweight. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &table->border_lineweight_override_flag);
-                }
-                else if (strcmp (temp_string, "96") == 0)
+        dxf_graphic_properties_start (&properties, table->properties);
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
+        {
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing the flag for
-                         * an override of the border visibility. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &table->border_visibility_override_flag);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else if ((fp->acad_version_number >= AutoCAD_13)
-                        && (strcmp (temp_string, "100") == 0))
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if ((strcmp (temp_string, "AcDbEntity") != 0)
-                        && ((strcmp (temp_string, "AcDbBlockReference") != 0))
-                        && ((strcmp (temp_string, "AcDbBlockTable") != 0)))
-                        {
+                        case 2:
+                                /* Now follows a string containing a block name;
+                                 * an anonymous block begins with a *T value. */
+                                dxf_free (table->block_name);
+                                table->block_name = dxf_pair_get_string (&pair);
+                                break;
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                table->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 10:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the insertion point. */
+                                table->x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 11:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the horizontal direction
+                                 * vector. */
+                                table->x1 = dxf_pair_get_double (&pair);
+                                break;
+                        case 20:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the insertion point. */
+                                table->y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 21:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the horizontal direction
+                                 * vector. */
+                                table->y1 = dxf_pair_get_double (&pair);
+                                break;
+                        case 30:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the insertion point. */
+                                table->z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 31:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the horizontal direction
+                                 * vector. */
+                                table->z1 = dxf_pair_get_double (&pair);
+                                break;
+                        case 90:
+                                /* Now follows a string containing the flag for
+                                 * table value (unsigned integer). */
+                                table->table_value_flag = dxf_pair_get_int (&pair);
+                                break;
+                        case 91:
+                                /* Now follows a string containing the number of
+                                 * rows. */
+                                table->number_of_rows = dxf_pair_get_int (&pair);
+                                break;
+                        case 92:
+                                if (i == 0)
+                                {
+                                        /* Now follows a string containing the
+                                         * number of bytes in the proxy entity graphics. */
+                                        table->graphics_data_size = dxf_pair_get_int (&pair);
+                                        i++;
+                                }
+                                else if (i == 1)
+                                {
+                                        /* Now follows a string containing the number of
+                                         * columns. */
+                                        table->number_of_columns = dxf_pair_get_int (&pair);
+                                }
+                                break;
+                        case 93:
+                                /* Now follows a string containing the flag for
+                                 * an override. */
+                                table->override_flag = dxf_pair_get_int (&pair);
+                                break;
+                        case 94:
+                                /* Now follows a string containing the flag for
+                                 * an override of the border color. */
+                                table->border_color_override_flag = dxf_pair_get_int (&pair);
+                                break;
+                        case 95:
+                                /* Now follows a string containing the flag for
+                                 * an override of the border lineweight. */
+                                table->border_lineweight_override_flag = dxf_pair_get_int (&pair);
+                                break;
+                        case 96:
+                                /* Now follows a string containing the flag for
+                                 * an override of the border visibility. */
+                                table->border_visibility_override_flag = dxf_pair_get_int (&pair);
+                                break;
+                        case 100:
+                                if (fp->acad_version_number >= AutoCAD_13)
+                                {
+                                        /* Now follows a string containing the
+                                         * subclass marker value. */
+                                        dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                        if ((strcmp (temp_string, "AcDbEntity") != 0)
+                                        && ((strcmp (temp_string, "AcDbBlockReference") != 0))
+                                        && ((strcmp (temp_string, "AcDbBlockTable") != 0)))
+                                        {
+                                                fprintf (stderr,
+                                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                                  __FUNCTION__, fp->filename, fp->line_number);
+                                        }
+                                }
+                                break;
+                        case 141:
+                                /* Now follows a string containing the row
+                                 * height. */
+                                values = dxf_array_reserve (table->row_height,
+                                  table->number_of_row_heights,
+                                  &table->row_height_capacity,
+                                  table->number_of_row_heights + 1,
+                                  sizeof (double));
+                                if (values != NULL)
+                                {
+                                        table->row_height = values;
+                                        table->row_height[table->number_of_row_heights] = dxf_pair_get_double (&pair);
+                                        table->number_of_row_heights++;
+                                }
+                                break;
+                        case 142:
+                                /* Now follows a string containing the column
+                                 * height. */
+                                values = dxf_array_reserve (table->column_height,
+                                  table->number_of_column_heights,
+                                  &table->column_height_capacity,
+                                  table->number_of_column_heights + 1,
+                                  sizeof (double));
+                                if (values != NULL)
+                                {
+                                        table->column_height = values;
+                                        table->column_height[table->number_of_column_heights] = dxf_pair_get_double (&pair);
+                                        table->number_of_column_heights++;
+                                }
+                                break;
+                        case 310:
+                                /* Now follows a string containing binary
+                                 * graphics data. */
+                                strings = dxf_array_reserve (table->binary_graphics_data,
+                                  table->number_of_binary_graphics_data,
+                                  &table->binary_graphics_data_capacity,
+                                  table->number_of_binary_graphics_data + 1,
+                                  sizeof (char *));
+                                if (strings != NULL)
+                                {
+                                        table->binary_graphics_data = strings;
+                                        table->binary_graphics_data[table->number_of_binary_graphics_data] = dxf_pair_get_string (&pair);
+                                        table->number_of_binary_graphics_data++;
+                                }
+                                break;
+                        case 330:
+                                /* Now follows a string containing a soft-pointer
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, table->dictionary_owner_soft);
+                                table->dictionary_owner_soft = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 342:
+                                /* Now follows a string containing a hard pointer
+                                 * ID of the TABLESTYLE object. */
+                                dxf_free (table->tablestyle_object_pointer);
+                                table->tablestyle_object_pointer = dxf_pair_get_string (&pair);
+                                break;
+                        case 343:
+                                /* Now follows a string containing a hard pointer
+                                 * ID of the owning BLOCK record. */
+                                dxf_free (table->owning_block_pointer);
+                                table->owning_block_pointer = dxf_pair_get_string (&pair);
+                                break;
+                        case 360:
+                                /* Now follows a string containing a hard owner
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, table->dictionary_owner_hard);
+                                table->dictionary_owner_hard = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, "DXF comment: %s\n", temp_string);
+                                break;
+                        default:
                                 fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
                                   __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "141") == 0)
-                {
-                        /* Now follows a string containing the row
-                         * height. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &table->row_height[k]);
-                        k++;
-                }
-                else if (strcmp (temp_string, "142") == 0)
-                {
-                        /* Now follows a string containing the column
-                         * height. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &table->column_height[l]);
-                        l++;
-                }
-                else if (strcmp (temp_string, "310") == 0)
-                {
-                        /* Now follows a string containing binary
-                         * graphics data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", table->binary_graphics_data[j]);
-                        j++;
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing a soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", table->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "342") == 0)
-                {
-                        /* Now follows a string containing a hard pointer
-                         * ID of the TABLESTYLE object. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", table->tablestyle_object_pointer);
-                }
-                else if (strcmp (temp_string, "343") == 0)
-                {
-                        /* Now follows a string containing a hard pointer
-                         * ID of the owning BLOCK record. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", table->owning_block_pointer);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing a hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", table->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
-        /* Clean up. */
-        free (temp_string);
+        /* Entities with equal properties share a record. */
+        dxf_graphic_properties_finish (fp, &table->properties, &properties);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -636,33 +614,27 @@ dxf_table_cell_write
                 return (EXIT_FAILURE);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "171\n%d\n", cell->type);
-        fprintf (fp->fp, "172\n%d\n", cell->flag);
-        fprintf (fp->fp, "173\n%d\n", cell->merged);
-        fprintf (fp->fp, "174\n%d\n", cell->autofit);
-        fprintf (fp->fp, "175\n%lf\n", cell->border_width);
-        fprintf (fp->fp, "176\n%lf\n", cell->border_height);
-        fprintf (fp->fp, " 91\n%d\n", cell->override_flag);
-        fprintf (fp->fp, "178\n%d\n", cell->virtual_edge);
-        fprintf (fp->fp, "145\n%lf\n", cell->block_rotation);
-        fprintf (fp->fp, "344\n%s\n", cell->field_object_pointer);
-        i = 0;
-        while ((cell->optional_text_string[i] != NULL)
-          && (strcmp (cell->optional_text_string[i], "") != 0))
-        {
-                fprintf (fp->fp, "  2\n%s\n", cell->optional_text_string[i]);
-                i++;
-        }
-        fprintf (fp->fp, "  1\n%s\n", cell->text_string);
-        fprintf (fp->fp, "340\n%s\n", cell->block_table_record_hard_pointer);
-        fprintf (fp->fp, "144\n%lf\n", cell->block_scale);
-        fprintf (fp->fp, "179\n%d\n", cell->number_of_block_attdefs);
-        i = 0;
-        while ((cell->attdef_soft_pointer[i] != NULL)
-          && (strcmp (cell->attdef_soft_pointer[i], "") != 0))
-        {
-                fprintf (fp->fp, "331\n%s\n", cell->attdef_soft_pointer[i]);
-                i++;
+        dxf_write_int (fp, 171, cell->type);
+        dxf_write_int (fp, 172, cell->flag);
+        dxf_write_int (fp, 173, cell->merged);
+        dxf_write_int (fp, 174, cell->autofit);
+        dxf_write_double (fp, 175, cell->border_width);
+        dxf_write_double (fp, 176, cell->border_height);
+        dxf_write_int (fp, 91, cell->override_flag);
+        dxf_write_int (fp, 178, cell->virtual_edge);
+        dxf_write_double (fp, 145, cell->block_rotation);
+        dxf_write_string (fp, 344, cell->field_object_pointer);
+        for (i = 0; i < cell->number_of_optional_text_strings; i++)
+        {
+                dxf_write_string (fp, 2, cell->optional_text_string[i]);
+        }
+        dxf_write_string (fp, 1, cell->text_string);
+        dxf_write_string (fp, 340, cell->block_table_record_hard_pointer);
+        dxf_write_double (fp, 144, cell->block_scale);
+        dxf_write_int (fp, 179, cell->number_of_block_attdefs);
+        for (i = 0; i < cell->number_of_attdef_soft_pointers; i++)
+        {
+                dxf_write_string (fp, 331, cell->attdef_soft_pointer[i]);
         }
         if (cell->number_of_block_attdefs < (i + 1))
         {
@@ -709,7 +681,7 @@ dxf_table_write
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *dxf_entity_name = strdup ("ACAD_TABLE");
+        char *dxf_entity_name = dxf_strdup ("ACAD_TABLE");
         int i;
 
         /* Do some basic checks. */
@@ -719,7 +691,7 @@ dxf_table_write
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (table == NULL)
@@ -728,63 +700,61 @@ dxf_table_write
                   (_("Error in %s () a NULL pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_string (fp, 0, dxf_entity_name);
         if (table->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", table->id_code);
+                dxf_write_hex (fp, 5, table->id_code);
         }
-        fprintf (fp->fp, "330\n%s\n", table->dictionary_owner_soft);
+        dxf_write_string (fp, 330, table->dictionary_owner_soft);
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbEntity\n");
+                dxf_write_string (fp, 100, "AcDbEntity");
         }
-        fprintf (fp->fp, " 92\n%d\n", table->graphics_data_size);
-        i = 0;
-        while (strlen (table->binary_graphics_data[i]) > 0)
+        dxf_write_int (fp, 92, table->graphics_data_size);
+        for (i = 0; i < table->number_of_binary_graphics_data; i++)
         {
-                fprintf (fp->fp, "310\n%s\n", table->binary_graphics_data[i]);
-                i++;
+                dxf_write_string (fp, 310, table->binary_graphics_data[i]);
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbBlockReference\n");
+                dxf_write_string (fp, 100, "AcDbBlockReference");
         }
-        fprintf (fp->fp, "  2\n%s\n", table->block_name);
-        fprintf (fp->fp, " 10\n%f\n", table->x0);
-        fprintf (fp->fp, " 20\n%f\n", table->y0);
-        fprintf (fp->fp, " 30\n%f\n", table->z0);
+        dxf_write_string (fp, 2, table->block_name);
+        dxf_write_double (fp, 10, table->x0);
+        dxf_write_double (fp, 20, table->y0);
+        dxf_write_double (fp, 30, table->z0);
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbTable\n");
+                dxf_write_string (fp, 100, "AcDbTable");
         }
-        fprintf (fp->fp, "280\n%d\n", table->table_data_version);
-        fprintf (fp->fp, "342\n%s\n", table->tablestyle_object_pointer);
-        fprintf (fp->fp, "343\n%s\n", table->owning_block_pointer);
-        fprintf (fp->fp, " 11\n%f\n", table->x1);
-        fprintf (fp->fp, " 21\n%f\n", table->y1);
-        fprintf (fp->fp, " 31\n%f\n", table->z1);
-        fprintf (fp->fp, " 90\n%d\n", table->table_value_flag);
-        fprintf (fp->fp, " 91\n%d\n", table->number_of_rows);
-        fprintf (fp->fp, " 92\n%d\n", table->number_of_columns);
-        fprintf (fp->fp, " 93\n%d\n", table->override_flag);
-        fprintf (fp->fp, " 94\n%d\n", table->border_color_override_flag);
-        fprintf (fp->fp, " 95\n%d\n", table->border_lineweight_override_flag);
-        fprintf (fp->fp, " 96\n%d\n", table->border_visibility_override_flag);
-        for (i = 0; i < table->number_of_rows; i++)
+        dxf_write_int (fp, 280, table->table_data_version);
+        dxf_write_string (fp, 342, table->tablestyle_object_pointer);
+        dxf_write_string (fp, 343, table->owning_block_pointer);
+        dxf_write_double (fp, 11, table->x1);
+        dxf_write_double (fp, 21, table->y1);
+        dxf_write_double (fp, 31, table->z1);
+        dxf_write_int (fp, 90, table->table_value_flag);
+        dxf_write_int (fp, 91, table->number_of_rows);
+        dxf_write_int (fp, 92, table->number_of_columns);
+        dxf_write_int (fp, 93, table->override_flag);
+        dxf_write_int (fp, 94, table->border_color_override_flag);
+        dxf_write_int (fp, 95, table->border_lineweight_override_flag);
+        dxf_write_int (fp, 96, table->border_visibility_override_flag);
+        for (i = 0; i < table->number_of_row_heights; i++)
         {
-                fprintf (fp->fp, "141\n%f\n", table->row_height[i]);
+                dxf_write_double (fp, 141, table->row_height[i]);
         }
-        for (i = 0; i < table->number_of_columns; i++)
+        for (i = 0; i < table->number_of_column_heights; i++)
         {
-                fprintf (fp->fp, "142\n%f\n", table->column_height[i]);
+                dxf_write_double (fp, 142, table->column_height[i]);
         }
 
         /* Clean up. */
-        free (dxf_entity_name);
+        dxf_free (dxf_entity_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -833,17 +803,22 @@ dxf_table_cell_free
                 __FUNCTION__);
               return (EXIT_FAILURE);
         }
-        free (cell->text_string);
-        for (i = 0; i < DXF_MAX_PARAM; i++)
+        dxf_free (cell->text_string);
+        for (i = 0; i < cell->number_of_optional_text_strings; i++)
         {
-                free (cell->optional_text_string[i]);
-                free (cell->attdef_soft_pointer[i]);
+                dxf_free (cell->optional_text_string[i]);
         }
-        free (cell->text_style_name);
-        free (cell->attdef_text_string);
-        free (cell->block_table_record_hard_pointer);
-        free (cell->field_object_pointer);
-        free (cell);
+        dxf_free (cell->optional_text_string);
+        for (i = 0; i < cell->number_of_attdef_soft_pointers; i++)
+        {
+                dxf_free (cell->attdef_soft_pointer[i]);
+        }
+        dxf_free (cell->attdef_soft_pointer);
+        dxf_free (cell->text_style_name);
+        dxf_free (cell->attdef_text_string);
+        dxf_free (cell->block_table_record_hard_pointer);
+        dxf_free (cell->field_object_pointer);
+        dxf_free (cell);
         cell = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -893,20 +868,22 @@ dxf_table_free
                 __FUNCTION__);
               return (EXIT_FAILURE);
         }
-        free (table->linetype);
-        free (table->layer);
-        for (i = 0; i < DXF_MAX_PARAM; i++)
+        dxf_graphic_properties_free (table->properties);
+        for (i = 0; i < table->number_of_binary_graphics_data; i++)
         {
-                free (table->binary_graphics_data[i]);
+                dxf_free (table->binary_graphics_data[i]);
         }
-        free (table->dictionary_owner_soft);
-        free (table->dictionary_owner_hard);
-        free (table->block_name);
-        free (table->table_text_style_name);
-        free (table->tablestyle_object_pointer);
-        free (table->owning_block_pointer);
+        dxf_free (table->binary_graphics_data);
+        dxf_free (table->row_height);
+        dxf_free (table->column_height);
+        dxf_free (table->dictionary_owner_soft);
+        dxf_free (table->dictionary_owner_hard);
+        dxf_free (table->block_name);
+        dxf_free (table->table_text_style_name);
+        dxf_free (table->tablestyle_object_pointer);
+        dxf_free (table->owning_block_pointer);
 //        dxf_table_cells_free_chain (table->cells);
-        free (table);
+        dxf_free (table);
         table = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -933,7 +910,7 @@ dxf_table_cell_free_chain
                 /*!< pointer to the chain of DXF \c TABLE cells. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -973,7 +950,7 @@ dxf_table_free_chain
                 /*!< pointer to the chain of DXF \c TABLE entities. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         /* Do some basic checks. */
@@ -38,6 +38,7 @@
 
 
 #include "global.h"
+#include "graphic_properties.h"
 
 
 #ifdef __cplusplus
@@ -70,12 +71,17 @@ dxf_table_cell
                  * This value applies only to text-type cells and is
                  * repeated, 1 value per cell.\n
                  * Group code = 1. */
-        char *optional_text_string[DXF_MAX_PARAM];
+        char **optional_text_string;
                 /*!< Text string in a cell, in 250-character chunks;
-                 * optional.\n
+                 * optional, \c number_of_optional_text_strings entries.\n
                  * This value applies only to text-type cells and is
                  * repeated, 1 value per cell.\n
                  * Group code = 3. */
+        int number_of_optional_text_strings;
+                /*!< Number of entries in \c optional_text_string. */
+        int optional_text_string_capacity;
+                /*!< Number of entries \c optional_text_string has room
+                 * for. */
         char *text_style_name;
                 /*!< Text style name (string); override applied at the
                  * cell level.\n
@@ -222,12 +228,18 @@ dxf_table_cell
                  * repeated once per attribute definition and applicable
                  * only for a block-type cell.\n
                  * Group code = 300. */
-        char *attdef_soft_pointer[DXF_MAX_PARAM];
+        char **attdef_soft_pointer;
                 /*!< Soft pointer ID of the attribute definition in the
                  * block table record, referenced by group code 179
-                 * (applicable only for a block-type cell).\n
+                 * (applicable only for a block-type cell),
+                 * \c number_of_attdef_soft_pointers entries.\n
                  * This value is repeated once per attribute definition.\n
                  * Group code = 331. */
+        int number_of_attdef_soft_pointers;
+                /*!< Number of entries in \c attdef_soft_pointer. */
+        int attdef_soft_pointer_capacity;
+                /*!< Number of entries \c attdef_soft_pointer has room
+                 * for. */
         char *block_table_record_hard_pointer;
                 /*!< Hard-pointer ID of the block table record.\n
                  * This value applies only to block-type cells and is
@@ -259,63 +271,33 @@ dxf_table_cell
 typedef struct
 dxf_table
 {
-        int id_code;
+        long id_code;
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file.\n
                  * Group code = 5. */
-        char *linetype;
-                /*!< The linetype of the entity.\n
-                 * Defaults to \c BYLAYER if ommitted in the DXF file.\n
-                 * Group code = 6. */
-        char *layer;
-                /*!< Layer on which the entity is drawn.\n
-                 * Defaults to layer "0" if no valid layername is given.\n
-                 * Group code = 8. */
-        double elevation;
-                /*!< Elevation of the arc in the local Z-direction.\n
-                 * Defaults to 0.0 if omitted in the DXF file, or prior
-                 * to DXF version R12, or DXF_FLATLAND equals 0
-                 * (default).\n
-                 * (default).\n
-                 * Group code = 38. */
-        double thickness;
-                /*!< Thickness of the arc in the local Z-direction.\n
-                 * Defaults to 0.0 if ommitted in the DXF file.\n
-                 * Group code = 39. */
-        double linetype_scale;
-                /*!< Linetype scale (optional).\n
-                 * Group code = 48. */
-        int16_t visibility;
-                /*!< Object visibility (optional):
-                 * <ol>
-                 * <li value = "0"> Visible;</li>
-                 * <li value = "1"> Invisible.</li>
-                 * </ol>
-                 * Group code = 60. */
-        int color;
-                /*!< Color of the entity.\n
-                 * Defaults to \c BYLAYER if ommitted in the DXF file.\n
-                 * Note that entities encapsulated in a block with the
-                 * color \c BYBLOCK are represented in the "native"
-                 * color of the \c BLOCK entity.\n
-                 * Group code = 62. */
-        int paperspace;
-                /*!< Entities are to be drawn on either \c PAPERSPACE or
-                 * \c MODELSPACE.\n
-                 * Optional, defaults to \c DXF_MODELSPACE (0).\n
-                 * Group code = 67. */
+        DxfGraphicProperties *properties;
+                /*!< Linetype, layer, color and the other graphic
+                 * properties, shared with the entities which have
+                 * the same (see graphic_properties.h).\n
+                 * Group codes = 6, 8, 38, 39, 48, 60, 62 and 67. */
         int graphics_data_size;
                 /*!< The number of bytes in the image (and subsequent
                  * binary chunk records) (optional).\n
                  * Group code = 92.
                  *
                  * \warning Multiple entries with Group code 92. */
-        char *binary_graphics_data[DXF_MAX_PARAM];
+        char **binary_graphics_data;
                 /*!< Proxy entity graphics data.\n
                  * Multiple lines of 256 characters maximum per line
-                 * (optional).\n
+                 * (optional), \c number_of_binary_graphics_data
+                 * entries.\n
                  * Group code = 310. */
+        int number_of_binary_graphics_data;
+                /*!< Number of entries in \c binary_graphics_data. */
+        int binary_graphics_data_capacity;
+                /*!< Number of entries \c binary_graphics_data has room
+                 * for. */
         char *dictionary_owner_soft;
                 /*!< Soft-pointer ID/handle to owner dictionary
                  * (optional).\n
@@ -422,14 +404,22 @@ dxf_table
                  * entity level.\n
                  * There may be one entry for each cell type.\n
                  * Group code = 140. */
-        double row_height[DXF_MAX_PARAM];
+        double *row_height;
                 /*!< Row height; this value is repeated, 1 value per
-                 * row.\n
+                 * row, \c number_of_row_heights entries.\n
                  * Group code = 141. */
-        double column_height[DXF_MAX_PARAM];
+        int number_of_row_heights;
+                /*!< Number of entries in \c row_height. */
+        int row_height_capacity;
+                /*!< Number of entries \c row_height has room for. */
+        double *column_height;
                 /*!< Column height; this value is repeated, 1 value per
-                 * column.\n
+                 * column, \c number_of_column_heights entries.\n
                  * Group code = 142. */
+        int number_of_column_heights;
+                /*!< Number of entries in \c column_height. */
+        int column_height_capacity;
+                /*!< Number of entries \c column_height has room for. */
         int table_cell_alignment;
                 /*!< Cell alignment (integer); override applied at the
                  * table entity level.\n
@@ -34,6 +34,15 @@
 
 #include "tables.h"
 #include "section.h"
+#include "appid.h"
+#include "block_record.h"
+#include "dimstyle.h"
+#include "layer.h"
+#include "ltype.h"
+#include "style.h"
+#include "ucs.h"
+#include "view.h"
+#include "vport.h"
 
 
 /*!
@@ -187,15 +196,44 @@ dxf_tables_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (tables->appids);
-        free (tables->block_records);
-        free (tables->dimstyles);
-        free (tables->layers);
-        free (tables->ltypes);
-        free (tables->styles);
-        free (tables->ucss);
-        free (tables->views);
-        free (tables->vports);
+        /* Tables which were not read are NULL. */
+        if (tables->appids != NULL)
+        {
+                dxf_appid_free_chain ((DxfAppid *) tables->appids);
+        }
+        if (tables->block_records != NULL)
+        {
+                dxf_block_record_free_chain ((DxfBlockRecord *) tables->block_records);
+        }
+        if (tables->dimstyles != NULL)
+        {
+                dxf_dimstyle_free_chain ((DxfDimStyle *) tables->dimstyles);
+        }
+        if (tables->layers != NULL)
+        {
+                dxf_layer_free_chain ((DxfLayer *) tables->layers);
+        }
+        if (tables->ltypes != NULL)
+        {
+                dxf_ltype_free_chain ((DxfLType *) tables->ltypes);
+        }
+        if (tables->styles != NULL)
+        {
+                dxf_style_free_chain ((DxfStyle *) tables->styles);
+        }
+        if (tables->ucss != NULL)
+        {
+                dxf_ucs_free_chain ((DxfUcs *) tables->ucss);
+        }
+        if (tables->views != NULL)
+        {
+                dxf_view_free_chain ((DxfView *) tables->views);
+        }
+        if (tables->vports != NULL)
+        {
+                dxf_vport_free_chain ((DxfVPort *) tables->vports);
+        }
+        free (tables);
         tables = NULL;
 #if DEBUG
         DXF_DEBUG_END
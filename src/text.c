@@ -33,6 +33,9 @@
 
 
 #include "text.h"
+#include "arena.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -58,7 +61,7 @@ dxf_text_new ()
         size = sizeof (DxfText);
         /* avoid malloc of 0 bytes */
         if (size == 0) size = 1;
-        if ((text = malloc (size)) == NULL)
+        if ((text = dxf_malloc (size)) == NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () could not allocate memory for a DxfText struct.\n")),
@@ -114,34 +117,27 @@ dxf_text_init
               return (NULL);
         }
         text->id_code = 0;
-        text->text_value = strdup ("");
-        text->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        text->text_style = strdup ("");
-        text->layer = strdup (DXF_DEFAULT_LAYER);
+        text->text_value = dxf_strdup ("");
+        text->properties = dxf_graphic_properties_default ();
+        text->text_style = dxf_strdup ("");
         text->x0 = 0.0;
         text->y0 = 0.0;
         text->z0 = 0.0;
         text->x1 = 0.0;
         text->y1 = 0.0;
         text->z1 = 0.0;
-        text->elevation = 0.0;
-        text->thickness = 0.0;
-        text->linetype_scale = DXF_DEFAULT_LINETYPE_SCALE;
         text->height = 0.0;
         text->rel_x_scale = 0.0;
         text->rot_angle = 0.0;
         text->obl_angle = 0.0;
-        text->visibility = DXF_DEFAULT_VISIBILITY;
-        text->color = DXF_COLOR_BYLAYER;
-        text->paperspace = DXF_MODELSPACE;
         text->text_flags = 0;
         text->hor_align = 0;
         text->vert_align = 0;
         text->extr_x0 = 0.0;
         text->extr_y0 = 0.0;
         text->extr_z0 = 0.0;
-        text->dictionary_owner_soft = strdup ("");
-        text->dictionary_owner_hard = strdup ("");
+        text->dictionary_owner_soft = dxf_strdup ("");
+        text->dictionary_owner_hard = dxf_strdup ("");
         text->next = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -180,8 +176,10 @@ dxf_text_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *dxf_entity_name = strdup ("TEXT");
-        char *temp_string = NULL;
+        char dxf_entity_name[] = "TEXT";
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfGraphicProperties properties;
+        DxfPair pair;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -189,8 +187,6 @@ dxf_text_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (text == NULL)
@@ -201,250 +197,206 @@ dxf_text_read
                 text = dxf_text_new ();
                 text = dxf_text_init (text);
         }
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
-        {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        fclose (fp->fp);
-                        /* Clean up. */
-                        free (temp_string);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "1") == 0)
-                {
-                        /* Now follows a string containing a text value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", text->text_value);
-                }
-                else if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &text->id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", text->linetype);
-                }
-                else if (strcmp (temp_string, "7") == 0)
-                {
-                        /* Now follows a string containing a text style
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", text->text_style);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", text->layer);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the insertion point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &text->x0);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the insertion point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &text->y0);
-                }
-                else if (strcmp (temp_string, "30") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the insertion point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &text->z0);
-                }
-                else if ((fp->acad_version_number <= AutoCAD_11)
-                        && (strcmp (temp_string, "38") == 0)
-                        && (text->elevation != 0.0))
-                {
-                        /* Now follows a string containing the
-                         * elevation. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &text->elevation);
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &text->thickness);
-                }
-                else if (strcmp (temp_string, "40") == 0)
-                {
-                        /* Now follows a string containing the
-                         * height. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &text->height);
-                }
-                else if (strcmp (temp_string, "41") == 0)
-                {
-                        /* Now follows a string containing the
-                         * relative X-scale. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &text->rel_x_scale);
-                }
-                else if (strcmp (temp_string, "48") == 0)
-                {
-                        /* Now follows a string containing the linetype
-                         * scale. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &text->linetype_scale);
-                }
-                else if (strcmp (temp_string, "50") == 0)
-                {
-                        /* Now follows a string containing the
-                         * rotation angle. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &text->rot_angle);
-                }
-                else if (strcmp (temp_string, "51") == 0)
-                {
-                        /* Now follows a string containing the
-                         * oblique angle. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &text->obl_angle);
-                }
-                else if (strcmp (temp_string, "60") == 0)
-                {
-                        /* Now follows a string containing the
-                         * visibility value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &text->visibility);
-                }
-                else if (strcmp (temp_string, "62") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &text->color);
-                }
-                else if (strcmp (temp_string, "67") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &text->paperspace);
-                }
-                else if (strcmp (temp_string, "71") == 0)
-                {
-                        /* Now follows a string containing the
-                         * text flags value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &text->text_flags);
-                }
-                else if (strcmp (temp_string, "72") == 0)
-                {
-                        /* Now follows a string containing the
-                         * horizontal alignment flag value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &text->hor_align);
-                }
-                else if (strcmp (temp_string, "73") == 0)
-                {
-                        /* Now follows a string containing the
-                         * vertical alignment flag value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &text->vert_align);
-                }
-                else if ((fp->acad_version_number >= AutoCAD_13)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if ((strcmp (temp_string, "AcDbEntity") != 0)
-                        && ((strcmp (temp_string, "AcDbText") != 0)))
-                        {
+        dxf_graphic_properties_start (&properties, text->properties);
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
+        {
+                if (pair.group_code == 0)
+                {
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
+                }
+                switch (pair.group_code)
+                {
+                        case 1:
+                                /* Now follows a string containing a text value. */
+                                dxf_free (text->text_value);
+                                text->text_value = dxf_pair_get_string (&pair);
+                                break;
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                text->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 6:
+                                /* Now follows a string containing a linetype
+                                 * name. */
+                                dxf_lexer_free_string (fp, properties.linetype);
+                                properties.linetype = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 7:
+                                /* Now follows a string containing a text style
+                                 * name. */
+                                dxf_free (text->text_style);
+                                text->text_style = dxf_pair_get_string (&pair);
+                                break;
+                        case 8:
+                                /* Now follows a string containing a layer name. */
+                                dxf_lexer_free_string (fp, properties.layer);
+                                properties.layer = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 10:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the insertion point. */
+                                text->x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 20:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the insertion point. */
+                                text->y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 30:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the insertion point. */
+                                text->z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 38:
+                                if ((fp->acad_version_number <= AutoCAD_11)
+                                  && (properties.elevation != 0.0))
+                                {
+                                        /* Now follows a string containing the
+                                         * elevation. */
+                                        properties.elevation = dxf_pair_get_double (&pair);
+                                }
+                                break;
+                        case 39:
+                                /* Now follows a string containing the
+                                 * thickness. */
+                                properties.thickness = dxf_pair_get_double (&pair);
+                                break;
+                        case 40:
+                                /* Now follows a string containing the
+                                 * height. */
+                                text->height = dxf_pair_get_double (&pair);
+                                break;
+                        case 41:
+                                /* Now follows a string containing the
+                                 * relative X-scale. */
+                                text->rel_x_scale = dxf_pair_get_double (&pair);
+                                break;
+                        case 48:
+                                /* Now follows a string containing the linetype
+                                 * scale. */
+                                properties.linetype_scale = dxf_pair_get_double (&pair);
+                                break;
+                        case 50:
+                                /* Now follows a string containing the
+                                 * rotation angle. */
+                                text->rot_angle = dxf_pair_get_double (&pair);
+                                break;
+                        case 51:
+                                /* Now follows a string containing the
+                                 * oblique angle. */
+                                text->obl_angle = dxf_pair_get_double (&pair);
+                                break;
+                        case 60:
+                                /* Now follows a string containing the
+                                 * visibility value. */
+                                properties.visibility = dxf_pair_get_int (&pair);
+                                break;
+                        case 62:
+                                /* Now follows a string containing the
+                                 * color value. */
+                                properties.color = dxf_pair_get_int (&pair);
+                                break;
+                        case 67:
+                                /* Now follows a string containing the
+                                 * paperspace value. */
+                                properties.paperspace = dxf_pair_get_int (&pair);
+                                break;
+                        case 71:
+                                /* Now follows a string containing the
+                                 * text flags value. */
+                                text->text_flags = dxf_pair_get_int (&pair);
+                                break;
+                        case 72:
+                                /* Now follows a string containing the
+                                 * horizontal alignment flag value. */
+                                text->hor_align = dxf_pair_get_int (&pair);
+                                break;
+                        case 73:
+                                /* Now follows a string containing the
+                                 * vertical alignment flag value. */
+                                text->vert_align = dxf_pair_get_int (&pair);
+                                break;
+                        case 100:
+                                if (fp->acad_version_number >= AutoCAD_13)
+                                {
+                                        /* Now follows a string containing the
+                                         * subclass marker value. */
+                                        dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                        if ((strcmp (temp_string, "AcDbEntity") != 0)
+                                        && ((strcmp (temp_string, "AcDbText") != 0)))
+                                        {
+                                                fprintf (stderr,
+                                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                                  __FUNCTION__, fp->filename, fp->line_number);
+                                        }
+                                }
+                                break;
+                        case 210:
+                                /* Now follows a string containing the
+                                 * X-value of the extrusion vector. */
+                                text->extr_x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 220:
+                                /* Now follows a string containing the
+                                 * Y-value of the extrusion vector. */
+                                text->extr_y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 230:
+                                /* Now follows a string containing the
+                                 * Z-value of the extrusion vector. */
+                                text->extr_z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, text->dictionary_owner_soft);
+                                text->dictionary_owner_soft = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, text->dictionary_owner_hard);
+                                text->dictionary_owner_hard = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, "DXF comment: %s\n", temp_string);
+                                break;
+                        default:
                                 fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                  (_("Warning: in %s () unknown string tag found while reading from: %s in line: %d.\n")),
                                   __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "210") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &text->extr_x0);
-                }
-                else if (strcmp (temp_string, "220") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &text->extr_y0);
-                }
-                else if (strcmp (temp_string, "230") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &text->extr_z0);
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", text->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", text->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning: in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
         /* Handle omitted members and/or illegal values. */
         if (strcmp (text->text_value, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Error in %s () text value string is empty for the %s entity with id-code: %x\n")),
+                  (_("Error in %s () text value string is empty for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, text->id_code);
                 dxf_entity_skip (dxf_entity_name);
                 return (NULL);
         }
-        if (strcmp (text->linetype, "") == 0)
+        if ((properties.linetype != NULL)
+          && (strcmp (properties.linetype, "") == 0))
         {
-                text->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_lexer_free_string (fp, properties.linetype);
+                properties.linetype = dxf_strdup (DXF_DEFAULT_LINETYPE);
         }
-        if (strcmp (text->layer, "") == 0)
+        if ((properties.layer != NULL)
+          && (strcmp (properties.layer, "") == 0))
         {
-                text->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_lexer_free_string (fp, properties.layer);
+                properties.layer = dxf_strdup (DXF_DEFAULT_LAYER);
         }
-        /* Clean up. */
-        free (temp_string);
+        /* Entities with equal properties share a record. */
+        dxf_graphic_properties_finish (fp, &text->properties, &properties);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -473,7 +425,7 @@ dxf_text_write
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *dxf_entity_name = strdup ("TEXT");
+        char *dxf_entity_name = dxf_strdup ("TEXT");
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -482,7 +434,7 @@ dxf_text_write
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (text == NULL)
@@ -491,52 +443,56 @@ dxf_text_write
                   (_("Error in %s () a NULL pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (strcmp (text->text_value, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Error in %s () text value string is empty for the %s entity with id-code: %x\n")),
+                  (_("Error in %s () text value string is empty for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, text->id_code);
                 dxf_entity_skip (dxf_entity_name);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (strcmp (text->text_style, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () text style string is empty for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () text style string is empty for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, text->id_code);
-                text->text_style = strdup (DXF_DEFAULT_TEXTSTYLE);        }
-        if (strcmp (text->layer, "") == 0)
+                text->text_style = dxf_strdup (DXF_DEFAULT_TEXTSTYLE);        }
+        if (strcmp (text->properties->layer, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty layer string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty layer string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, text->id_code);
                 fprintf (stderr,
                   (_("\t%s entity is relocated to layer 0")),
                   dxf_entity_name);
-                text->layer = strdup (DXF_DEFAULT_LAYER);
+                if (dxf_graphic_properties_unshare (&text->properties) != NULL)
+                {
+                        dxf_free (text->properties->layer);
+                        text->properties->layer = dxf_strdup (DXF_DEFAULT_LAYER);
+                }
         }
         if (text->height == 0.0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () height has a value of 0.0 for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () height has a value of 0.0 for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, text->id_code);
         }
         if (text->rel_x_scale == 0.0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () relative X-scale factor has a value of 0.0 for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () relative X-scale factor has a value of 0.0 for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, text->id_code);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_string (fp, 0, dxf_entity_name);
         if (text->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", text->id_code);
+                dxf_write_hex (fp, 5, text->id_code);
         }
         /*!
          * \todo for version R14.\n
@@ -551,91 +507,91 @@ dxf_text_write
         if ((strcmp (text->dictionary_owner_soft, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", text->dictionary_owner_soft);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, text->dictionary_owner_soft);
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (text->dictionary_owner_hard, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", text->dictionary_owner_hard);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, text->dictionary_owner_hard);
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbEntity\n");
+                dxf_write_string (fp, 100, "AcDbEntity");
         }
-        if (text->paperspace == 1)
+        if (text->properties->paperspace == 1)
         {
-                fprintf (fp->fp, " 67\n%d\n", text->paperspace);
+                dxf_write_int (fp, 67, text->properties->paperspace);
         }
-        fprintf (fp->fp, "  8\n%s\n", text->layer);
-        if (strcmp (text->linetype, DXF_DEFAULT_LINETYPE) != 0)
+        dxf_write_string (fp, 8, text->properties->layer);
+        if (strcmp (text->properties->linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp->fp, "  6\n%s\n", text->linetype);
+                dxf_write_string (fp, 6, text->properties->linetype);
         }
         if ((fp->acad_version_number <= AutoCAD_11)
           && DXF_FLATLAND
-          && (text->elevation != 0.0))
+          && (text->properties->elevation != 0.0))
         {
-                fprintf (fp->fp, " 38\n%f\n", text->elevation);
+                dxf_write_double (fp, 38, text->properties->elevation);
         }
-        if (text->color != DXF_COLOR_BYLAYER)
+        if (text->properties->color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp->fp, " 62\n%d\n", text->color);
+                dxf_write_int (fp, 62, text->properties->color);
         }
-        if (text->linetype_scale != 1.0)
+        if (text->properties->linetype_scale != 1.0)
         {
-                fprintf (fp->fp, " 48\n%f\n", text->linetype_scale);
+                dxf_write_double (fp, 48, text->properties->linetype_scale);
         }
-        if (text->visibility != 0)
+        if (text->properties->visibility != 0)
         {
-                fprintf (fp->fp, " 60\n%d\n", text->visibility);
+                dxf_write_int (fp, 60, text->properties->visibility);
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbText\n");
+                dxf_write_string (fp, 100, "AcDbText");
         }
-        if (text->thickness != 0.0)
+        if (text->properties->thickness != 0.0)
         {
-                fprintf (fp->fp, " 39\n%f\n", text->thickness);
+                dxf_write_double (fp, 39, text->properties->thickness);
         }
-        fprintf (fp->fp, " 10\n%f\n", text->x0);
-        fprintf (fp->fp, " 20\n%f\n", text->y0);
-        fprintf (fp->fp, " 30\n%f\n", text->z0);
-        fprintf (fp->fp, " 40\n%f\n", text->height);
-        fprintf (fp->fp, "  1\n%s\n", text->text_value);
+        dxf_write_double (fp, 10, text->x0);
+        dxf_write_double (fp, 20, text->y0);
+        dxf_write_double (fp, 30, text->z0);
+        dxf_write_double (fp, 40, text->height);
+        dxf_write_string (fp, 1, text->text_value);
         if (text->rot_angle != 0.0)
         {
-                fprintf (fp->fp, " 50\n%f\n", text->rot_angle);
+                dxf_write_double (fp, 50, text->rot_angle);
         }
         if (text->rel_x_scale != 1.0)
         {
-                fprintf (fp->fp, " 41\n%f\n", text->rel_x_scale);
+                dxf_write_double (fp, 41, text->rel_x_scale);
         }
         if (text->obl_angle != 0.0)
         {
-                fprintf (fp->fp, " 51\n%f\n", text->obl_angle);
+                dxf_write_double (fp, 51, text->obl_angle);
         }
         if (strcmp (text->text_style, DXF_DEFAULT_TEXTSTYLE) != 0)
         {
-                fprintf (fp->fp, "  7\n%s\n", text->text_style);
+                dxf_write_string (fp, 7, text->text_style);
         }
         if (text->text_flags != 0)
         {
-                fprintf (fp->fp, " 71\n%d\n", text->text_flags);
+                dxf_write_int (fp, 71, text->text_flags);
         }
         if (text->hor_align != 0)
         {
-                fprintf (fp->fp, " 72\n%d\n", text->hor_align);
+                dxf_write_int (fp, 72, text->hor_align);
         }
         if ((text->hor_align != 0) || (text->vert_align != 0))
         {
                 if ((text->x0 == text->x1) && (text->y0 == text->y1) && (text->z0 == text->z1))
                 {
                         fprintf (stderr,
-                          (_("Warning in %s () insertion point and alignment point are identical for the %s entity with id-code: %x\n")),
+                          (_("Warning in %s () insertion point and alignment point are identical for the %s entity with id-code: %lx\n")),
                           __FUNCTION__, dxf_entity_name, text->id_code);
                         fprintf (stderr,
                           (_("\tdefault justification applied to %s entity\n")),
@@ -645,9 +601,9 @@ dxf_text_write
                 }
                 else
                 {
-                        fprintf (fp->fp, " 11\n%f\n", text->x1);
-                        fprintf (fp->fp, " 21\n%f\n", text->y1);
-                        fprintf (fp->fp, " 31\n%f\n", text->z1);
+                        dxf_write_double (fp, 11, text->x1);
+                        dxf_write_double (fp, 21, text->y1);
+                        dxf_write_double (fp, 31, text->z1);
                 }
         }
         if ((fp->acad_version_number >= AutoCAD_12)
@@ -655,20 +611,20 @@ dxf_text_write
                 && (text->extr_y0 != 0.0)
                 && (text->extr_z0 != 1.0))
         {
-                fprintf (fp->fp, "210\n%f\n", text->extr_x0);
-                fprintf (fp->fp, "220\n%f\n", text->extr_y0);
-                fprintf (fp->fp, "230\n%f\n", text->extr_z0);
+                dxf_write_double (fp, 210, text->extr_x0);
+                dxf_write_double (fp, 220, text->extr_y0);
+                dxf_write_double (fp, 230, text->extr_z0);
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbText\n");
+                dxf_write_string (fp, 100, "AcDbText");
         }
         if (text->vert_align != 0)
         {
-                fprintf (fp->fp, " 73\n%d\n", text->vert_align);
+                dxf_write_int (fp, 73, text->vert_align);
         }
         /* Clean up. */
-        free (dxf_entity_name);
+        dxf_free (dxf_entity_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -707,13 +663,12 @@ dxf_text_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (text->linetype);
-        free (text->layer);
-        free (text->text_value);
-        free (text->text_style);
-        free (text->dictionary_owner_soft);
-        free (text->dictionary_owner_hard);
-        free (text);
+        dxf_graphic_properties_free (text->properties);
+        dxf_free (text->text_value);
+        dxf_free (text->text_style);
+        dxf_free (text->dictionary_owner_soft);
+        dxf_free (text->dictionary_owner_hard);
+        dxf_free (text);
         text = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -739,7 +694,7 @@ dxf_text_free_chain
                 /*!< a pointer to the chain of DXF \c TEXT entities. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (texts == NULL)
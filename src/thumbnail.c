@@ -33,6 +33,9 @@
 
 
 #include "thumbnail.h"
+#include "arena.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -128,8 +131,6 @@ dxf_thumbnail_init
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        int i;
-
         /* Do some basic checks. */
         if (thumbnail == NULL)
         {
@@ -146,10 +147,9 @@ dxf_thumbnail_init
                 return (NULL);
         }
         thumbnail->number_of_bytes = 0;
-        for (i = 0; i < DXF_MAX_PARAM; i++)
-        {
-                thumbnail->preview_image_data[i] = strdup ("");
-        }
+        thumbnail->preview_image_data = NULL;
+        thumbnail->number_of_preview_image_data = 0;
+        thumbnail->preview_image_data_capacity = 0;
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -199,9 +199,11 @@ dxf_thumbnail_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfPair pair;
         int i;
         int preview_data_length = 0;
+        char **preview_image_data;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -209,8 +211,6 @@ dxf_thumbnail_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (thumbnail == NULL)
@@ -228,48 +228,61 @@ dxf_thumbnail_read
                   __FUNCTION__);
         }
         i = 0;
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        fclose (fp->fp);
-                        /* Clean up. */
-                        free (temp_string);
-                        return (NULL);
-                }
-                else if (strcmp (temp_string, "90") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing the
-                         * number of bytes value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &thumbnail->number_of_bytes);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else if (strcmp (temp_string, "310") == 0)
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing additional
-                         * proprietary data. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", thumbnail->preview_image_data[i]);
-                        preview_data_length = preview_data_length + strlen (thumbnail->preview_image_data[i]);
-                        i++;
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                        case 90:
+                                /* Now follows a string containing the
+                                 * number of bytes value. */
+                                thumbnail->number_of_bytes = dxf_pair_get_int (&pair);
+                                /* Room for the lines which follow, a line
+                                 * holds up to 128 bytes. */
+                                preview_image_data = dxf_array_reserve (thumbnail->preview_image_data,
+                                  thumbnail->number_of_preview_image_data,
+                                  &thumbnail->preview_image_data_capacity,
+                                  (thumbnail->number_of_bytes + 127) / 128,
+                                  sizeof (char *));
+                                if (preview_image_data != NULL)
+                                {
+                                        thumbnail->preview_image_data = preview_image_data;
+                                }
+                                break;
+                        case 310:
+                                /* Now follows a string containing additional
+                                 * proprietary data. */
+                                preview_image_data = dxf_array_reserve (thumbnail->preview_image_data,
+                                  thumbnail->number_of_preview_image_data,
+                                  &thumbnail->preview_image_data_capacity,
+                                  thumbnail->number_of_preview_image_data + 1,
+                                  sizeof (char *));
+                                if (preview_image_data == NULL)
+                                {
+                                        break;
+                                }
+                                thumbnail->preview_image_data = preview_image_data;
+                                i = thumbnail->number_of_preview_image_data;
+                                thumbnail->preview_image_data[i] = dxf_pair_get_string (&pair);
+                                preview_data_length = preview_data_length + strlen (thumbnail->preview_image_data[i]);
+                                thumbnail->number_of_preview_image_data++;
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, "DXF comment: %s\n", temp_string);
+                                break;
+                        default:
+                                fprintf (stderr,
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
+                                  __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
         /* Handle omitted members and/or illegal values. */
@@ -280,8 +293,6 @@ dxf_thumbnail_read
                           __FUNCTION__, preview_data_length,
                           fp->filename, thumbnail->number_of_bytes);
         }
-        /* Clean up. */
-        free (temp_string);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -361,13 +372,11 @@ dxf_thumbnail_write
                   __FUNCTION__);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
-        fprintf (fp->fp, " 90\n%d\n", thumbnail->number_of_bytes);
-        i = 0;
-        while (strlen (thumbnail->preview_image_data[i]) > 0)
+        dxf_write_string (fp, 0, dxf_entity_name);
+        dxf_write_int (fp, 90, thumbnail->number_of_bytes);
+        for (i = 0; i < thumbnail->number_of_preview_image_data; i++)
         {
-                fprintf (fp->fp, "310\n%s\n", thumbnail->preview_image_data[i]);
-                i++;
+                dxf_write_string (fp, 310, thumbnail->preview_image_data[i]);
         }
         /* Clean up. */
         free (dxf_entity_name);
@@ -417,10 +426,11 @@ dxf_thumbnail_free
 #endif
         int i;
 
-        for (i = 0; i < DXF_MAX_PARAM; i++)
+        for (i = 0; i < thumbnail->number_of_preview_image_data; i++)
         {
                 free (thumbnail->preview_image_data[i]);
         }
+        dxf_free (thumbnail->preview_image_data);
         free (thumbnail);
         thumbnail = NULL;
 #if DEBUG
@@ -73,9 +73,15 @@ dxf_thumbnail
                 /*!< group code = 90\n
                  * The number of bytes in the image (and subsequent binary
                  * chunk records). */
-        char *preview_image_data[DXF_MAX_PARAM];
+        char **preview_image_data;
                 /*!< group code = 310\n
-                 * multiple lines (256 characters maximum per line). */
+                 * multiple lines (256 characters maximum per line),
+                 * \c number_of_preview_image_data entries. */
+        int number_of_preview_image_data;
+                /*!< Number of entries in \c preview_image_data. */
+        int preview_image_data_capacity;
+                /*!< Number of entries \c preview_image_data has room
+                 * for. */
 } DxfThumbnail;
 
 
@@ -33,6 +33,9 @@
 
 
 #include "tolerance.h"
+#include "arena.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -61,7 +64,7 @@ dxf_tolerance_new ()
         size = sizeof (DxfTolerance);
         /* avoid malloc of 0 bytes */
         if (size == 0) size = 1;
-        if ((tolerance = malloc (size)) == NULL)
+        if ((tolerance = dxf_malloc (size)) == NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () could not allocate memory for a DxfTolerance struct.\n")),
@@ -117,10 +120,9 @@ dxf_tolerance_init
                   __FUNCTION__);
                 return (NULL);
         }
-        tolerance->dimstyle_name = strdup ("");
+        tolerance->dimstyle_name = dxf_strdup ("");
         tolerance->id_code = 0;
-        tolerance->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        tolerance->layer = strdup (DXF_DEFAULT_LAYER);
+        tolerance->properties = dxf_graphic_properties_default ();
         tolerance->x0 = 0.0;
         tolerance->y0 = 0.0;
         tolerance->z0 = 0.0;
@@ -130,14 +132,8 @@ dxf_tolerance_init
         tolerance->extr_x0 = 0.0;
         tolerance->extr_y0 = 0.0;
         tolerance->extr_z0 = 0.0;
-        tolerance->elevation = 0.0;
-        tolerance->thickness = 0.0;
-        tolerance->linetype_scale = DXF_DEFAULT_LINETYPE_SCALE;
-        tolerance->visibility = DXF_DEFAULT_VISIBILITY;
-        tolerance->color = DXF_COLOR_BYLAYER;
-        tolerance->paperspace = DXF_MODELSPACE;
-        tolerance->dictionary_owner_soft = strdup ("");
-        tolerance->dictionary_owner_hard = strdup ("");
+        tolerance->dictionary_owner_soft = dxf_strdup ("");
+        tolerance->dictionary_owner_hard = dxf_strdup ("");
         tolerance->next = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -175,7 +171,9 @@ dxf_tolerance_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfGraphicProperties properties;
+        DxfPair pair;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -183,8 +181,6 @@ dxf_tolerance_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (tolerance == NULL)
@@ -195,194 +191,155 @@ dxf_tolerance_read
                 tolerance = dxf_tolerance_new ();
                 tolerance = dxf_tolerance_init (tolerance);
         }
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        dxf_graphic_properties_start (&properties, tolerance->properties);
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        fclose (fp->fp);
-                        /* Clean up. */
-                        free (temp_string);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "3") == 0)
-                {
-                        /* Now follows a string containing the dimension
-                         * style name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", tolerance->dimstyle_name);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &tolerance->id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", tolerance->linetype);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", tolerance->layer);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the insertion point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &tolerance->x0);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the insertion point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &tolerance->y0);
-                }
-                else if (strcmp (temp_string, "30") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the insertion point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &tolerance->z0);
-                }
-                else if (strcmp (temp_string, "11") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the direction vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &tolerance->x1);
-                }
-                else if (strcmp (temp_string, "21") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the direction vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &tolerance->y1);
-                }
-                else if (strcmp (temp_string, "31") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the direction vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &tolerance->z1);
-                }
-                else if ((fp->acad_version_number <= AutoCAD_11)
-                        && (strcmp (temp_string, "38") == 0))
-                {
-                        /* Now follows a string containing the
-                         * elevation. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &tolerance->elevation);
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &tolerance->thickness);
-                }
-                else if (strcmp (temp_string, "48") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing the linetype
-                         * scale. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &tolerance->linetype_scale);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else if (strcmp (temp_string, "60") == 0)
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing the
-                         * visibility value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &tolerance->visibility);
-                }
-                else if (strcmp (temp_string, "62") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &tolerance->color);
-                }
-                else if (strcmp (temp_string, "67") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &tolerance->paperspace);
-                }
-                else if ((fp->acad_version_number >= AutoCAD_13)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if ((strcmp (temp_string, "AcDbEntity") != 0)
-                        && ((strcmp (temp_string, "AcDbFcf") != 0)))
-                        {
+                        case 3:
+                                /* Now follows a string containing the dimension
+                                 * style name. */
+                                dxf_free (tolerance->dimstyle_name);
+                                tolerance->dimstyle_name = dxf_pair_get_string (&pair);
+                                break;
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                tolerance->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 6:
+                                /* Now follows a string containing a linetype
+                                 * name. */
+                                dxf_lexer_free_string (fp, properties.linetype);
+                                properties.linetype = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 8:
+                                /* Now follows a string containing a layer name. */
+                                dxf_lexer_free_string (fp, properties.layer);
+                                properties.layer = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 10:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the insertion point. */
+                                tolerance->x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 20:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the insertion point. */
+                                tolerance->y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 30:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the insertion point. */
+                                tolerance->z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 11:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the direction vector. */
+                                tolerance->x1 = dxf_pair_get_double (&pair);
+                                break;
+                        case 21:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the direction vector. */
+                                tolerance->y1 = dxf_pair_get_double (&pair);
+                                break;
+                        case 31:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the direction vector. */
+                                tolerance->z1 = dxf_pair_get_double (&pair);
+                                break;
+                        case 38:
+                                if (fp->acad_version_number <= AutoCAD_11)
+                                {
+                                        /* Now follows a string containing the
+                                         * elevation. */
+                                        properties.elevation = dxf_pair_get_double (&pair);
+                                }
+                                break;
+                        case 39:
+                                /* Now follows a string containing the
+                                 * thickness. */
+                                properties.thickness = dxf_pair_get_double (&pair);
+                                break;
+                        case 48:
+                                /* Now follows a string containing the linetype
+                                 * scale. */
+                                properties.linetype_scale = dxf_pair_get_double (&pair);
+                                break;
+                        case 60:
+                                /* Now follows a string containing the
+                                 * visibility value. */
+                                properties.visibility = dxf_pair_get_int (&pair);
+                                break;
+                        case 62:
+                                /* Now follows a string containing the
+                                 * color value. */
+                                properties.color = dxf_pair_get_int (&pair);
+                                break;
+                        case 67:
+                                /* Now follows a string containing the
+                                 * paperspace value. */
+                                properties.paperspace = dxf_pair_get_int (&pair);
+                                break;
+                        case 100:
+                                if (fp->acad_version_number >= AutoCAD_13)
+                                {
+                                        /* Now follows a string containing the
+                                         * subclass marker value. */
+                                        dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                        if ((strcmp (temp_string, "AcDbEntity") != 0)
+                                        && ((strcmp (temp_string, "AcDbFcf") != 0)))
+                                        {
+                                                fprintf (stderr,
+                                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                                  __FUNCTION__, fp->filename, fp->line_number);
+                                        }
+                                }
+                                break;
+                        case 210:
+                                /* Now follows a string containing the
+                                 * X-value of the extrusion vector. */
+                                tolerance->extr_x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 220:
+                                /* Now follows a string containing the
+                                 * Y-value of the extrusion vector. */
+                                tolerance->extr_y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 230:
+                                /* Now follows a string containing the
+                                 * Z-value of the extrusion vector. */
+                                tolerance->extr_z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, tolerance->dictionary_owner_soft);
+                                tolerance->dictionary_owner_soft = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, tolerance->dictionary_owner_hard);
+                                tolerance->dictionary_owner_hard = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, "DXF comment: %s\n", temp_string);
+                                break;
+                        default:
                                 fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
                                   __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "210") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &tolerance->extr_x0);
-                }
-                else if (strcmp (temp_string, "220") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &tolerance->extr_y0);
-                }
-                else if (strcmp (temp_string, "230") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &tolerance->extr_z0);
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", tolerance->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", tolerance->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
         /* Handle omitted members and/or illegal values. */
@@ -390,16 +347,20 @@ dxf_tolerance_read
         {
                 return (NULL);
         }
-        if (strcmp (tolerance->linetype, "") == 0)
+        if ((properties.linetype != NULL)
+          && (strcmp (properties.linetype, "") == 0))
         {
-                tolerance->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_lexer_free_string (fp, properties.linetype);
+                properties.linetype = dxf_strdup (DXF_DEFAULT_LINETYPE);
         }
-        if (strcmp (tolerance->layer, "") == 0)
+        if ((properties.layer != NULL)
+          && (strcmp (properties.layer, "") == 0))
         {
-                tolerance->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_lexer_free_string (fp, properties.layer);
+                properties.layer = dxf_strdup (DXF_DEFAULT_LAYER);
         }
-        /* Clean up. */
-        free (temp_string);
+        /* Entities with equal properties share a record. */
+        dxf_graphic_properties_finish (fp, &tolerance->properties, &properties);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -431,7 +392,7 @@ dxf_tolerance_write
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *dxf_entity_name = strdup ("TOLERANCE");
+        char *dxf_entity_name = dxf_strdup ("TOLERANCE");
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -440,7 +401,7 @@ dxf_tolerance_write
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (tolerance == NULL)
@@ -449,44 +410,52 @@ dxf_tolerance_write
                   (_("Error in %s () a NULL pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (strcmp (tolerance->dimstyle_name, "") == 0)
         {
-                fprintf (stderr, "Error in dxf_tolerance_write () empty dimstyle name for the %s entity with id-code: %x.\n",
+                fprintf (stderr, "Error in dxf_tolerance_write () empty dimstyle name for the %s entity with id-code: %lx.\n",
                         dxf_entity_name, tolerance->id_code);
                 fprintf (stderr, "\tskipping %s entity.\n",
                         dxf_entity_name);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
-        if (strcmp (tolerance->linetype, "") == 0)
+        if (strcmp (tolerance->properties->linetype, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, tolerance->id_code);
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                tolerance->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                if (dxf_graphic_properties_unshare (&tolerance->properties) != NULL)
+                {
+                        dxf_free (tolerance->properties->linetype);
+                        tolerance->properties->linetype = dxf_strdup (DXF_DEFAULT_LINETYPE);
+                }
         }
-        if (strcmp (tolerance->layer, "") == 0)
+        if (strcmp (tolerance->properties->layer, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty layer string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty layer string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, tolerance->id_code);
                 fprintf (stderr,
                   (_("\t%s entity is relocated to layer 0")),
                   dxf_entity_name);
-                tolerance->layer = DXF_DEFAULT_LAYER;
+                if (dxf_graphic_properties_unshare (&tolerance->properties) != NULL)
+                {
+                        dxf_free (tolerance->properties->layer);
+                        tolerance->properties->layer = dxf_strdup (DXF_DEFAULT_LAYER);
+                }
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_string (fp, 0, dxf_entity_name);
         if (tolerance->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", tolerance->id_code);
+                dxf_write_hex (fp, 5, tolerance->id_code);
         }
         /*!
          * \todo for version R14.\n
@@ -501,74 +470,74 @@ dxf_tolerance_write
         if ((strcmp (tolerance->dictionary_owner_soft, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", tolerance->dictionary_owner_soft);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, tolerance->dictionary_owner_soft);
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (tolerance->dictionary_owner_hard, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", tolerance->dictionary_owner_hard);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, tolerance->dictionary_owner_hard);
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbEntity\n");
+                dxf_write_string (fp, 100, "AcDbEntity");
         }
-        if (tolerance->paperspace == DXF_PAPERSPACE)
+        if (tolerance->properties->paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp->fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_int (fp, 67, DXF_PAPERSPACE);
         }
-        fprintf (fp->fp, "  8\n%s\n", tolerance->layer);
-        if (strcmp (tolerance->linetype, DXF_DEFAULT_LINETYPE) != 0)
+        dxf_write_string (fp, 8, tolerance->properties->layer);
+        if (strcmp (tolerance->properties->linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp->fp, "  6\n%s\n", tolerance->linetype);
+                dxf_write_string (fp, 6, tolerance->properties->linetype);
         }
         if ((fp->acad_version_number <= AutoCAD_11)
           && DXF_FLATLAND
-          && (tolerance->elevation != 0.0))
+          && (tolerance->properties->elevation != 0.0))
         {
-                fprintf (fp->fp, " 38\n%f\n", tolerance->elevation);
+                dxf_write_double (fp, 38, tolerance->properties->elevation);
         }
-        if (tolerance->color != DXF_COLOR_BYLAYER)
+        if (tolerance->properties->color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp->fp, " 62\n%d\n", tolerance->color);
+                dxf_write_int (fp, 62, tolerance->properties->color);
         }
-        if (tolerance->linetype_scale != 1.0)
+        if (tolerance->properties->linetype_scale != 1.0)
         {
-                fprintf (fp->fp, " 48\n%f\n", tolerance->linetype_scale);
+                dxf_write_double (fp, 48, tolerance->properties->linetype_scale);
         }
-        if (tolerance->visibility != 0)
+        if (tolerance->properties->visibility != 0)
         {
-                fprintf (fp->fp, " 60\n%d\n", tolerance->visibility);
+                dxf_write_int (fp, 60, tolerance->properties->visibility);
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbFcf\n");
+                dxf_write_string (fp, 100, "AcDbFcf");
         }
-        if (tolerance->thickness != 0.0)
+        if (tolerance->properties->thickness != 0.0)
         {
-                fprintf (fp->fp, " 39\n%f\n", tolerance->thickness);
+                dxf_write_double (fp, 39, tolerance->properties->thickness);
         }
-        fprintf (fp->fp, "  3\n%s\n", tolerance->dimstyle_name);
-        fprintf (fp->fp, " 10\n%f\n", tolerance->x0);
-        fprintf (fp->fp, " 20\n%f\n", tolerance->y0);
-        fprintf (fp->fp, " 30\n%f\n", tolerance->z0);
+        dxf_write_string (fp, 3, tolerance->dimstyle_name);
+        dxf_write_double (fp, 10, tolerance->x0);
+        dxf_write_double (fp, 20, tolerance->y0);
+        dxf_write_double (fp, 30, tolerance->z0);
         if ((fp->acad_version_number >= AutoCAD_12)
                 && (tolerance->extr_x0 != 0.0)
                 && (tolerance->extr_y0 != 0.0)
                 && (tolerance->extr_z0 != 1.0))
         {
-                fprintf (fp->fp, "210\n%f\n", tolerance->extr_x0);
-                fprintf (fp->fp, "220\n%f\n", tolerance->extr_y0);
-                fprintf (fp->fp, "230\n%f\n", tolerance->extr_z0);
+                dxf_write_double (fp, 210, tolerance->extr_x0);
+                dxf_write_double (fp, 220, tolerance->extr_y0);
+                dxf_write_double (fp, 230, tolerance->extr_z0);
         }
-        fprintf (fp->fp, " 11\n%f\n", tolerance->x1);
-        fprintf (fp->fp, " 21\n%f\n", tolerance->y1);
-        fprintf (fp->fp, " 31\n%f\n", tolerance->z1);
+        dxf_write_double (fp, 11, tolerance->x1);
+        dxf_write_double (fp, 21, tolerance->y1);
+        dxf_write_double (fp, 31, tolerance->z1);
         /* Clean up. */
-        free (dxf_entity_name);
+        dxf_free (dxf_entity_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -607,12 +576,11 @@ dxf_tolerance_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (tolerance->dimstyle_name);
-        free (tolerance->linetype);
-        free (tolerance->layer);
-        free (tolerance->dictionary_owner_soft);
-        free (tolerance->dictionary_owner_hard);
-        free (tolerance);
+        dxf_free (tolerance->dimstyle_name);
+        dxf_graphic_properties_free (tolerance->properties);
+        dxf_free (tolerance->dictionary_owner_soft);
+        dxf_free (tolerance->dictionary_owner_hard);
+        dxf_free (tolerance);
         tolerance = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -639,7 +607,7 @@ dxf_tolerance_free_chain
                  * entities. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (tolerances == NULL)
@@ -33,6 +33,9 @@
 
 
 #include "trace.h"
+#include "arena.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -61,7 +64,7 @@ dxf_trace_new ()
         size = sizeof (DxfTrace);
         /* avoid malloc of 0 bytes */
         if (size == 0) size = 1;
-        if ((trace = malloc (size)) == NULL)
+        if ((trace = dxf_malloc (size)) == NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () could not allocate memory for a DxfTrace struct.\n")),
@@ -118,8 +121,7 @@ dxf_trace_init
                 return (NULL);
         }
         trace->id_code = 0;
-        trace->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        trace->layer = strdup (DXF_DEFAULT_LAYER);
+        trace->properties = dxf_graphic_properties_default ();
         trace->x0 = 0.0;
         trace->y0 = 0.0;
         trace->z0 = 0.0;
@@ -132,17 +134,11 @@ dxf_trace_init
         trace->x3 = 0.0;
         trace->y3 = 0.0;
         trace->z3 = 0.0;
-        trace->elevation = 0.0;
-        trace->thickness = 0.0;
-        trace->linetype_scale = DXF_DEFAULT_LINETYPE_SCALE;
-        trace->visibility = DXF_DEFAULT_VISIBILITY;
-        trace->color = DXF_COLOR_BYLAYER;
-        trace->paperspace = DXF_MODELSPACE;
         trace->extr_x0 = 0.0;
         trace->extr_y0 = 0.0;
         trace->extr_z0 = 0.0;
-        trace->dictionary_owner_soft = strdup ("");
-        trace->dictionary_owner_hard = strdup ("");
+        trace->dictionary_owner_soft = dxf_strdup ("");
+        trace->dictionary_owner_hard = dxf_strdup ("");
         trace->next = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -178,7 +174,9 @@ dxf_trace_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfGraphicProperties properties;
+        DxfPair pair;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -186,8 +184,6 @@ dxf_trace_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (trace == NULL)
@@ -198,243 +194,197 @@ dxf_trace_read
                 trace = dxf_trace_new ();
                 trace = dxf_trace_init (trace);
         }
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        dxf_graphic_properties_start (&properties, trace->properties);
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        fclose (fp->fp);
-                        /* Clean up. */
-                        free (temp_string);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &trace->id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", trace->linetype);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", trace->layer);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the base point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &trace->x0);
-                }
-                else if (strcmp (temp_string, "11") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the alignment point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &trace->x1);
-                }
-                else if (strcmp (temp_string, "12") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the alignment point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &trace->x2);
-                }
-                else if (strcmp (temp_string, "13") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the alignment point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &trace->x3);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the base point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &trace->y0);
-                }
-                else if (strcmp (temp_string, "21") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the alignment point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &trace->y1);
-                }
-                else if (strcmp (temp_string, "22") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the alignment point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &trace->y2);
-                }
-                else if (strcmp (temp_string, "23") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the alignment point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &trace->y3);
-                }
-                else if (strcmp (temp_string, "30") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the base point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &trace->z0);
-                }
-                else if (strcmp (temp_string, "31") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the alignment point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &trace->z1);
-                }
-                else if (strcmp (temp_string, "32") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the alignment point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &trace->z2);
-                }
-                else if (strcmp (temp_string, "33") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the alignment point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &trace->z3);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else if ((fp->acad_version_number <= AutoCAD_11)
-                        && (strcmp (temp_string, "38") == 0)
-                        && (trace->elevation != 0.0))
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing the
-                         * elevation. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &trace->elevation);
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &trace->thickness);
-                }
-                else if (strcmp (temp_string, "48") == 0)
-                {
-                        /* Now follows a string containing the linetype
-                         * scale. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &trace->linetype_scale);
-                }
-                else if (strcmp (temp_string, "60") == 0)
-                {
-                        /* Now follows a string containing the
-                         * visibility value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &trace->visibility);
-                }
-                else if (strcmp (temp_string, "62") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &trace->color);
-                }
-                else if (strcmp (temp_string, "67") == 0)
-                {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &trace->paperspace);
-                }
-                else if ((fp->acad_version_number >= AutoCAD_13)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if ((strcmp (temp_string, "AcDbEntity") != 0)
-                        && ((strcmp (temp_string, "AcDbTrace") != 0)))
-                        {
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                trace->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 6:
+                                /* Now follows a string containing a linetype
+                                 * name. */
+                                dxf_lexer_free_string (fp, properties.linetype);
+                                properties.linetype = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 8:
+                                /* Now follows a string containing a layer name. */
+                                dxf_lexer_free_string (fp, properties.layer);
+                                properties.layer = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 10:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the base point. */
+                                trace->x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 11:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the alignment point. */
+                                trace->x1 = dxf_pair_get_double (&pair);
+                                break;
+                        case 12:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the alignment point. */
+                                trace->x2 = dxf_pair_get_double (&pair);
+                                break;
+                        case 13:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the alignment point. */
+                                trace->x3 = dxf_pair_get_double (&pair);
+                                break;
+                        case 20:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the base point. */
+                                trace->y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 21:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the alignment point. */
+                                trace->y1 = dxf_pair_get_double (&pair);
+                                break;
+                        case 22:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the alignment point. */
+                                trace->y2 = dxf_pair_get_double (&pair);
+                                break;
+                        case 23:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the alignment point. */
+                                trace->y3 = dxf_pair_get_double (&pair);
+                                break;
+                        case 30:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the base point. */
+                                trace->z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 31:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the alignment point. */
+                                trace->z1 = dxf_pair_get_double (&pair);
+                                break;
+                        case 32:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the alignment point. */
+                                trace->z2 = dxf_pair_get_double (&pair);
+                                break;
+                        case 33:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the alignment point. */
+                                trace->z3 = dxf_pair_get_double (&pair);
+                                break;
+                        case 38:
+                                if ((fp->acad_version_number <= AutoCAD_11)
+                                  && (properties.elevation != 0.0))
+                                {
+                                        /* Now follows a string containing the
+                                         * elevation. */
+                                        properties.elevation = dxf_pair_get_double (&pair);
+                                }
+                                break;
+                        case 39:
+                                /* Now follows a string containing the
+                                 * thickness. */
+                                properties.thickness = dxf_pair_get_double (&pair);
+                                break;
+                        case 48:
+                                /* Now follows a string containing the linetype
+                                 * scale. */
+                                properties.linetype_scale = dxf_pair_get_double (&pair);
+                                break;
+                        case 60:
+                                /* Now follows a string containing the
+                                 * visibility value. */
+                                properties.visibility = dxf_pair_get_int (&pair);
+                                break;
+                        case 62:
+                                /* Now follows a string containing the
+                                 * color value. */
+                                properties.color = dxf_pair_get_int (&pair);
+                                break;
+                        case 67:
+                                /* Now follows a string containing the
+                                 * paperspace value. */
+                                properties.paperspace = dxf_pair_get_int (&pair);
+                                break;
+                        case 100:
+                                if (fp->acad_version_number >= AutoCAD_13)
+                                {
+                                        /* Now follows a string containing the
+                                         * subclass marker value. */
+                                        dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                        if ((strcmp (temp_string, "AcDbEntity") != 0)
+                                        && ((strcmp (temp_string, "AcDbTrace") != 0)))
+                                        {
+                                                fprintf (stderr,
+                                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                                  __FUNCTION__, fp->filename, fp->line_number);
+                                        }
+                                }
+                                break;
+                        case 210:
+                                /* Now follows a string containing the
+                                 * X-value of the extrusion vector. */
+                                trace->extr_x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 220:
+                                /* Now follows a string containing the
+                                 * Y-value of the extrusion vector. */
+                                trace->extr_y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 230:
+                                /* Now follows a string containing the
+                                 * Z-value of the extrusion vector. */
+                                trace->extr_z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, trace->dictionary_owner_soft);
+                                trace->dictionary_owner_soft = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, trace->dictionary_owner_hard);
+                                trace->dictionary_owner_hard = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, "DXF comment: %s\n", temp_string);
+                                break;
+                        default:
                                 fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
                                   __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "210") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &trace->extr_x0);
-                }
-                else if (strcmp (temp_string, "220") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &trace->extr_y0);
-                }
-                else if (strcmp (temp_string, "230") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-value of the extrusion vector. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &trace->extr_z0);
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", trace->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", trace->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
         /* Handle omitted members and/or illegal values. */
-        if (strcmp (trace->linetype, "") == 0)
+        if ((properties.linetype != NULL)
+          && (strcmp (properties.linetype, "") == 0))
         {
-                trace->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_lexer_free_string (fp, properties.linetype);
+                properties.linetype = dxf_strdup (DXF_DEFAULT_LINETYPE);
         }
-        if (strcmp (trace->layer, "") == 0)
+        if ((properties.layer != NULL)
+          && (strcmp (properties.layer, "") == 0))
         {
-                trace->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_lexer_free_string (fp, properties.layer);
+                properties.layer = dxf_strdup (DXF_DEFAULT_LAYER);
         }
-        /* Clean up. */
-        free (temp_string);
+        /* Entities with equal properties share a record. */
+        dxf_graphic_properties_finish (fp, &trace->properties, &properties);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -466,7 +416,7 @@ dxf_trace_write
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *dxf_entity_name = strdup ("TRACE");
+        char *dxf_entity_name = dxf_strdup ("TRACE");
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -475,7 +425,7 @@ dxf_trace_write
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (trace == NULL)
@@ -484,34 +434,42 @@ dxf_trace_write
                   (_("Error in %s () a NULL pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
-        if (strcmp (trace->linetype, "") == 0)
+        if (strcmp (trace->properties->linetype, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, trace->id_code);
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                trace->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                if (dxf_graphic_properties_unshare (&trace->properties) != NULL)
+                {
+                        dxf_free (trace->properties->linetype);
+                        trace->properties->linetype = dxf_strdup (DXF_DEFAULT_LINETYPE);
+                }
         }
-        if (strcmp (trace->layer, "") == 0)
+        if (strcmp (trace->properties->layer, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty layer string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty layer string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, trace->id_code);
                 fprintf (stderr,
                   (_("\t%s entity is relocated to layer 0")),
                   dxf_entity_name);
-                trace->layer = strdup (DXF_DEFAULT_LAYER);
+                if (dxf_graphic_properties_unshare (&trace->properties) != NULL)
+                {
+                        dxf_free (trace->properties->layer);
+                        trace->properties->layer = dxf_strdup (DXF_DEFAULT_LAYER);
+                }
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_string (fp, 0, dxf_entity_name);
         if (trace->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", trace->id_code);
+                dxf_write_hex (fp, 5, trace->id_code);
         }
         /*!
          * \todo for version R14.\n
@@ -526,79 +484,79 @@ dxf_trace_write
         if ((strcmp (trace->dictionary_owner_soft, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", trace->dictionary_owner_soft);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, trace->dictionary_owner_soft);
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (trace->dictionary_owner_hard, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", trace->dictionary_owner_hard);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, trace->dictionary_owner_hard);
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbEntity\n");
+                dxf_write_string (fp, 100, "AcDbEntity");
         }
-        if (trace->paperspace == DXF_PAPERSPACE)
+        if (trace->properties->paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp->fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_int (fp, 67, DXF_PAPERSPACE);
         }
-        fprintf (fp->fp, "  8\n%s\n", trace->layer);
-        if (strcmp (trace->linetype, DXF_DEFAULT_LINETYPE) != 0)
+        dxf_write_string (fp, 8, trace->properties->layer);
+        if (strcmp (trace->properties->linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp->fp, "  6\n%s\n", trace->linetype);
+                dxf_write_string (fp, 6, trace->properties->linetype);
         }
         if ((fp->acad_version_number <= AutoCAD_11)
           && DXF_FLATLAND
-          && (trace->elevation != 0.0))
+          && (trace->properties->elevation != 0.0))
         {
-                fprintf (fp->fp, " 38\n%f\n", trace->elevation);
+                dxf_write_double (fp, 38, trace->properties->elevation);
         }
-        if (trace->color != DXF_COLOR_BYLAYER)
+        if (trace->properties->color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp->fp, " 62\n%d\n", trace->color);
+                dxf_write_int (fp, 62, trace->properties->color);
         }
-        if (trace->linetype_scale != 1.0)
+        if (trace->properties->linetype_scale != 1.0)
         {
-                fprintf (fp->fp, " 48\n%f\n", trace->linetype_scale);
+                dxf_write_double (fp, 48, trace->properties->linetype_scale);
         }
-        if (trace->visibility != 0)
+        if (trace->properties->visibility != 0)
         {
-                fprintf (fp->fp, " 60\n%d\n", trace->visibility);
+                dxf_write_int (fp, 60, trace->properties->visibility);
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbTrace\n");
+                dxf_write_string (fp, 100, "AcDbTrace");
         }
-        fprintf (fp->fp, " 10\n%f\n", trace->x0);
-        fprintf (fp->fp, " 20\n%f\n", trace->y0);
-        fprintf (fp->fp, " 30\n%f\n", trace->z0);
-        fprintf (fp->fp, " 11\n%f\n", trace->x1);
-        fprintf (fp->fp, " 21\n%f\n", trace->y1);
-        fprintf (fp->fp, " 31\n%f\n", trace->z1);
-        fprintf (fp->fp, " 12\n%f\n", trace->x2);
-        fprintf (fp->fp, " 22\n%f\n", trace->y2);
-        fprintf (fp->fp, " 32\n%f\n", trace->z2);
-        fprintf (fp->fp, " 13\n%f\n", trace->x3);
-        fprintf (fp->fp, " 23\n%f\n", trace->y3);
-        fprintf (fp->fp, " 33\n%f\n", trace->z3);
-        if (trace->thickness != 0.0)
+        dxf_write_double (fp, 10, trace->x0);
+        dxf_write_double (fp, 20, trace->y0);
+        dxf_write_double (fp, 30, trace->z0);
+        dxf_write_double (fp, 11, trace->x1);
+        dxf_write_double (fp, 21, trace->y1);
+        dxf_write_double (fp, 31, trace->z1);
+        dxf_write_double (fp, 12, trace->x2);
+        dxf_write_double (fp, 22, trace->y2);
+        dxf_write_double (fp, 32, trace->z2);
+        dxf_write_double (fp, 13, trace->x3);
+        dxf_write_double (fp, 23, trace->y3);
+        dxf_write_double (fp, 33, trace->z3);
+        if (trace->properties->thickness != 0.0)
         {
-                fprintf (fp->fp, " 39\n%f\n", trace->thickness);
+                dxf_write_double (fp, 39, trace->properties->thickness);
         }
         if ((fp->acad_version_number >= AutoCAD_12)
                 && (trace->extr_x0 != 0.0)
                 && (trace->extr_y0 != 0.0)
                 && (trace->extr_z0 != 1.0))
         {
-                fprintf (fp->fp, "210\n%f\n", trace->extr_x0);
-                fprintf (fp->fp, "220\n%f\n", trace->extr_y0);
-                fprintf (fp->fp, "230\n%f\n", trace->extr_z0);
+                dxf_write_double (fp, 210, trace->extr_x0);
+                dxf_write_double (fp, 220, trace->extr_y0);
+                dxf_write_double (fp, 230, trace->extr_z0);
         }
         /* Clean up. */
-        free (dxf_entity_name);
+        dxf_free (dxf_entity_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -637,11 +595,10 @@ dxf_trace_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (trace->linetype);
-        free (trace->layer);
-        free (trace->dictionary_owner_soft);
-        free (trace->dictionary_owner_hard);
-        free (trace);
+        dxf_graphic_properties_free (trace->properties);
+        dxf_free (trace->dictionary_owner_soft);
+        dxf_free (trace->dictionary_owner_hard);
+        dxf_free (trace);
         trace = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -667,7 +624,7 @@ dxf_trace_free_chain
                 /*!< a pointer to the chain of DXF \c TRACE entities. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (traces == NULL)
@@ -33,6 +33,8 @@
 
 
 #include "ucs.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -168,7 +170,8 @@ dxf_ucs_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfPair pair;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -176,8 +179,6 @@ dxf_ucs_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (ucs == NULL)
@@ -188,155 +189,123 @@ dxf_ucs_read
                 ucs = dxf_ucs_new ();
                 ucs = dxf_ucs_init (ucs);
         }
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        fclose (fp->fp);
-                        /* Clean up. */
-                        free (temp_string);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &ucs->id_code);
-                }
-                else if (strcmp (temp_string, "2") == 0)
-                {
-                        /* Now follows a string containing an UCS
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", ucs->UCS_name);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the base point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ucs->x_origin);
-                }
-                else if (strcmp (temp_string, "20") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the base point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ucs->y_origin);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else if (strcmp (temp_string, "30") == 0)
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the base point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ucs->z_origin);
-                }
-                else if (strcmp (temp_string, "11") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the reference point for the
-                         * X-axis direction. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ucs->x_X_dir);
-                }
-                else if (strcmp (temp_string, "21") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the reference point for the
-                         * X-axis direction. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ucs->y_X_dir);
-                }
-                else if (strcmp (temp_string, "31") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the reference point for the
-                         * X-axis direction. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ucs->z_X_dir);
-                }
-                else if (strcmp (temp_string, "12") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the reference point for the
-                         * Y-axis direction. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ucs->x_Y_dir);
-                }
-                else if (strcmp (temp_string, "22") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the reference point for the
-                         * Y-axis direction. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ucs->y_Y_dir);
-                }
-                else if (strcmp (temp_string, "32") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the reference point for the
-                         * Y-axis direction. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &ucs->z_Y_dir);
-                }
-                else if (strcmp (temp_string, "70") == 0)
-                {
-                        /* Now follows a string containing the
-                         * standard flag value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &ucs->flag);
-                }
-                else if ((fp->acad_version_number >= AutoCAD_13)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if ((strcmp (temp_string, "AcDbSymbolTableRecord") != 0)
-                        && ((strcmp (temp_string, "AcDbUCSTableRecord") != 0)))
-                        {
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                ucs->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 2:
+                                /* Now follows a string containing an UCS
+                                 * name. */
+                                free (ucs->UCS_name);
+                                ucs->UCS_name = dxf_pair_get_string (&pair);
+                                break;
+                        case 10:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the base point. */
+                                ucs->x_origin = dxf_pair_get_double (&pair);
+                                break;
+                        case 20:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the base point. */
+                                ucs->y_origin = dxf_pair_get_double (&pair);
+                                break;
+                        case 30:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the base point. */
+                                ucs->z_origin = dxf_pair_get_double (&pair);
+                                break;
+                        case 11:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the reference point for the
+                                 * X-axis direction. */
+                                ucs->x_X_dir = dxf_pair_get_double (&pair);
+                                break;
+                        case 21:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the reference point for the
+                                 * X-axis direction. */
+                                ucs->y_X_dir = dxf_pair_get_double (&pair);
+                                break;
+                        case 31:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the reference point for the
+                                 * X-axis direction. */
+                                ucs->z_X_dir = dxf_pair_get_double (&pair);
+                                break;
+                        case 12:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the reference point for the
+                                 * Y-axis direction. */
+                                ucs->x_Y_dir = dxf_pair_get_double (&pair);
+                                break;
+                        case 22:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the reference point for the
+                                 * Y-axis direction. */
+                                ucs->y_Y_dir = dxf_pair_get_double (&pair);
+                                break;
+                        case 32:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the reference point for the
+                                 * Y-axis direction. */
+                                ucs->z_Y_dir = dxf_pair_get_double (&pair);
+                                break;
+                        case 70:
+                                /* Now follows a string containing the
+                                 * standard flag value. */
+                                ucs->flag = dxf_pair_get_int (&pair);
+                                break;
+                        case 100:
+                                if (fp->acad_version_number >= AutoCAD_13)
+                                {
+                                        /* Now follows a string containing the
+                                         * subclass marker value. */
+                                        dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                        if ((strcmp (temp_string, "AcDbSymbolTableRecord") != 0)
+                                        && ((strcmp (temp_string, "AcDbUCSTableRecord") != 0)))
+                                        {
+                                                fprintf (stderr,
+                                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                                  __FUNCTION__, fp->filename, fp->line_number);
+                                        }
+                                }
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner dictionary. */
+                                free (ucs->dictionary_owner_soft);
+                                ucs->dictionary_owner_soft = dxf_pair_get_string (&pair);
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                free (ucs->dictionary_owner_hard);
+                                ucs->dictionary_owner_hard = dxf_pair_get_string (&pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, "DXF comment: %s\n", temp_string);
+                                break;
+                        default:
                                 fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
                                   __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", ucs->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", ucs->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
-        /* Clean up. */
-        free (temp_string);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -393,7 +362,7 @@ dxf_ucs_write
           || (strcmp (ucs->UCS_name, "") == 0))
         {
                 fprintf (stderr,
-                  (_("Error in %s () empty UCS name string for the %s entity with id-code: %x\n")),
+                  (_("Error in %s () empty UCS name string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, ucs->id_code);
                 fprintf (stderr,
                   (_("\t%s entity is discarded from output.\n")),
@@ -403,10 +372,10 @@ dxf_ucs_write
                 return (EXIT_FAILURE);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_string (fp, 0, dxf_entity_name);
         if (ucs->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", ucs->id_code);
+                dxf_write_hex (fp, 5, ucs->id_code);
         }
         /*!
          * \todo for version R14.\n
@@ -421,33 +390,33 @@ dxf_ucs_write
         if ((strcmp (ucs->dictionary_owner_soft, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", ucs->dictionary_owner_soft);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, ucs->dictionary_owner_soft);
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (ucs->dictionary_owner_hard, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", ucs->dictionary_owner_hard);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, ucs->dictionary_owner_hard);
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbSymbolTableRecord\n");
-                fprintf (fp->fp, "100\nAcDbUCSTableRecord\n");
+                dxf_write_string (fp, 100, "AcDbSymbolTableRecord");
+                dxf_write_string (fp, 100, "AcDbUCSTableRecord");
         }
-        fprintf (fp->fp, "  2\n%s\n", ucs->UCS_name);
-        fprintf (fp->fp, " 70\n%d\n", ucs->flag);
-        fprintf (fp->fp, " 10\n%f\n", ucs->x_origin);
-        fprintf (fp->fp, " 20\n%f\n", ucs->y_origin);
-        fprintf (fp->fp, " 30\n%f\n", ucs->z_origin);
-        fprintf (fp->fp, " 11\n%f\n", ucs->x_X_dir);
-        fprintf (fp->fp, " 21\n%f\n", ucs->y_X_dir);
-        fprintf (fp->fp, " 31\n%f\n", ucs->z_X_dir);
-        fprintf (fp->fp, " 12\n%f\n", ucs->x_Y_dir);
-        fprintf (fp->fp, " 22\n%f\n", ucs->y_Y_dir);
-        fprintf (fp->fp, " 32\n%f\n", ucs->z_Y_dir);
+        dxf_write_string (fp, 2, ucs->UCS_name);
+        dxf_write_int (fp, 70, ucs->flag);
+        dxf_write_double (fp, 10, ucs->x_origin);
+        dxf_write_double (fp, 20, ucs->y_origin);
+        dxf_write_double (fp, 30, ucs->z_origin);
+        dxf_write_double (fp, 11, ucs->x_X_dir);
+        dxf_write_double (fp, 21, ucs->y_X_dir);
+        dxf_write_double (fp, 31, ucs->z_X_dir);
+        dxf_write_double (fp, 12, ucs->x_Y_dir);
+        dxf_write_double (fp, 22, ucs->y_Y_dir);
+        dxf_write_double (fp, 32, ucs->z_Y_dir);
         /* Clean up. */
         free (dxf_entity_name);
 #if DEBUG
@@ -518,7 +487,7 @@ dxf_ucs_free_chain
                  * entries. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (ucss == NULL)
@@ -530,6 +499,7 @@ dxf_ucs_free_chain
         while (ucss != NULL)
         {
                 struct DxfUcs *iter = ucss->next;
+                ucss->next = NULL;
                 dxf_ucs_free (ucss);
                 ucss = (DxfUcs *) iter;
         }
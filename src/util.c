@@ -36,91 +36,471 @@
 
 #include <stdarg.h>
 #include "util.h"
+#include "lexer.h"
+#include "compress.h"
+#include "writer.h"
+#if !defined (MSDOS) && !defined (_WIN32)
+#  include <sys/mman.h>
+#endif
 
 
+/*!
+ * \brief Test if the value of a group code is a double.
+ *
+ * Looks up the value type in the group code type table of the lexer.
+ */
 int
 dxf_read_is_double (int type)
+{
+        return (dxf_lexer_group_code_type (type) == DXF_GROUP_CODE_TYPE_DOUBLE);
+}
+
+
+/*!
+ * \brief Test if the value of a group code is an integer.
+ *
+ * Looks up the value type in the group code type table of the lexer.
+ */
+int
+dxf_read_is_int (int type)
+{
+        switch (dxf_lexer_group_code_type (type))
+        {
+                case DXF_GROUP_CODE_TYPE_INT16:
+                case DXF_GROUP_CODE_TYPE_INT32:
+                case DXF_GROUP_CODE_TYPE_INT64:
+                case DXF_GROUP_CODE_TYPE_BOOL:
+                        return (TRUE);
+                default:
+                        return (FALSE);
+        }
+}
+
+
+/*!
+ * \brief Test if the value of a group code is a string.
+ *
+ * Looks up the value type in the group code type table of the lexer,
+ * handles and binary chunks are written as strings too.
+ */
+int
+dxf_read_is_string (int type)
+{
+        switch (dxf_lexer_group_code_type (type))
+        {
+                case DXF_GROUP_CODE_TYPE_STRING:
+                case DXF_GROUP_CODE_TYPE_HANDLE:
+                case DXF_GROUP_CODE_TYPE_BINARY:
+                        return (TRUE);
+                default:
+                        return (FALSE);
+        }
+}
+
+/*!
+ * \brief Opens a DxfFile, does error checking and resets the line number
+ * counter.
+ * 
+ * Reset the line counting to 0.
+ * 
+ * A gzip or Zstandard compressed file is decompressed while it is
+ * read.
+ */
+DxfFile *
+dxf_read_init (const char *filename)
 {
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        if (type >=10 && type < 60)
+        DxfFile * file = NULL;
+        FILE *fp;
+        DxfCompression compression;
+        if (!filename)
+        {
+                fprintf (stderr,
+                  (_("Error: filename is not initialised (NULL pointer).\n")));
+                return (NULL);
+        }
+        if (strcmp (filename, "") == 0)
+        {
+                fprintf (stderr,
+                  (_("Error: filename contains an empty string.\n")));
+                return (NULL);
+        }
+        compression = dxf_compress_detect (filename);
+        fp = dxf_compress_fopen (filename, "r", compression);
+        if (!fp)
         {
+                fprintf (stderr,
+                  (_("Error: could not open file: %s for reading (NULL pointer).\n")),
+                  filename);
+                return (NULL);
+        }
+        file = malloc (sizeof(DxfFile));
+        if (file == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory for a DxfFile struct.\n")),
+                  __FUNCTION__);
+                fclose (fp);
+                return (NULL);
+        }
+        file->fp = fp;
+        file->filename = strdup(filename);
+        file->line_number = 0;
+        file->last_id_code = 0;
+        file->acad_version_number = 0;
+        file->follow_strict_version_rules = FALSE;
+        file->buffer = NULL;
+        file->buffer_size = 0;
+        file->position = 0;
+        file->line_buffer = NULL;
+        file->line_buffer_size = 0;
+        memset (&file->pair, 0, sizeof (file->pair));
+        file->pair_pending = FALSE;
+        file->binary = 0;
+        file->parent = NULL;
+        file->compression = compression;
+        file->write_buffer = NULL;
+        file->write_buffer_size = 0;
+        file->write_length = 0;
+        file->decimals = DXF_WRITE_SHORTEST;
+        file->filter = NULL;
+        file->strings = NULL;
+        file->properties = NULL;
+        file->columns = NULL;
+        /*! \todo FIXME: dxf header and blocks need initialized ?
+        dxf_header_init (file->dxf_header);
+        dxf_block_init (file->dxf_block);
+        */
 #if DEBUG
         DXF_DEBUG_END
 #endif
-                return TRUE;
+        return file;
+}
+
+
+#if !defined (MSDOS) && !defined (_WIN32)
+/*!
+ * \brief Releases the contents of a file opened with
+ * dxf_read_init_mmap (): a memory mapping for a plain file, allocated
+ * memory for a compressed file.
+ */
+static void
+dxf_read_release_buffer (char *buffer, size_t size, int compression)
+{
+        if (compression == DXF_COMPRESSION_NONE)
+        {
+                munmap (buffer, size);
         }
         else
         {
-#if DEBUG
-        DXF_DEBUG_END
-#endif
-                return FALSE;
+                free (buffer);
         }
 }
+#endif
 
 
-int
-dxf_read_is_int (int type)
+/*!
+ * \brief Opens a DxfFile by mapping the whole file into memory, does
+ * error checking and resets the line number counter.
+ *
+ * The contents of the file are accessible without copying by means of
+ * dxf_read_slice ().\n
+ * For the existing readers, which use the \c fp member directly, a
+ * stdio stream on top of the mapping is provided, so no system calls
+ * are needed for reading from the file after it has been opened.
+ *
+ * A gzip or Zstandard compressed file is decompressed into memory
+ * instead and read the same way.\n
+ * On platforms without \c mmap () this falls back to dxf_read_init ().
+ *
+ * \return a pointer to the opened \c DxfFile, or \c NULL when an error
+ * occurred.
+ */
+DxfFile *
+dxf_read_init_mmap (const char *filename)
 {
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        if (type >= 60 && type < 80)
+#if defined (MSDOS) || defined (_WIN32)
+        return (dxf_read_init (filename));
+#else
+        DxfFile *file = NULL;
+        FILE *fp;
+        struct stat st;
+        char *buffer;
+        size_t size = 0;
+        int fd;
+        DxfCompression compression;
+
+        if (!filename)
         {
-#if DEBUG
-        DXF_DEBUG_END
-#endif
-                return TRUE;
+                fprintf (stderr,
+                  (_("Error: filename is not initialised (NULL pointer).\n")));
+                return (NULL);
+        }
+        if (strcmp (filename, "") == 0)
+        {
+                fprintf (stderr,
+                  (_("Error: filename contains an empty string.\n")));
+                return (NULL);
+        }
+        compression = dxf_compress_detect (filename);
+        if (compression != DXF_COMPRESSION_NONE)
+        {
+                /* A compressed file can not be mapped, hold the
+                 * decompressed contents in memory instead. */
+                fp = dxf_compress_fopen (filename, "r", compression);
+                if (!fp)
+                {
+                        fprintf (stderr,
+                          (_("Error: could not open file: %s for reading (NULL pointer).\n")),
+                          filename);
+                        return (NULL);
+                }
+                buffer = dxf_compress_read_all (fp, &size);
+                fclose (fp);
+                if (buffer == NULL)
+                {
+                        fprintf (stderr,
+                          (_("Error: could not decompress an empty or unreadable file: %s.\n")),
+                          filename);
+                        return (NULL);
+                }
         }
         else
         {
+                fd = open (filename, O_RDONLY);
+                if (fd == -1)
+                {
+                        fprintf (stderr,
+                          (_("Error: could not open file: %s for reading (NULL pointer).\n")),
+                          filename);
+                        return (NULL);
+                }
+                if ((fstat (fd, &st) == -1) || (st.st_size == 0))
+                {
+                        fprintf (stderr,
+                          (_("Error: could not map an empty or unreadable file: %s.\n")),
+                          filename);
+                        close (fd);
+                        return (NULL);
+                }
+                size = (size_t) st.st_size;
+                buffer = mmap (NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+                /* The mapping keeps its own reference to the file. */
+                close (fd);
+                if (buffer == MAP_FAILED)
+                {
+                        fprintf (stderr,
+                          (_("Error: could not map file: %s into memory.\n")),
+                          filename);
+                        return (NULL);
+                }
+                madvise (buffer, size, MADV_SEQUENTIAL);
+        }
+        fp = fmemopen (buffer, size, "r");
+        if (!fp)
+        {
+                fprintf (stderr,
+                  (_("Error: could not open a stream on the mapping of file: %s.\n")),
+                  filename);
+                dxf_read_release_buffer (buffer, size, compression);
+                return (NULL);
+        }
+        file = malloc (sizeof(DxfFile));
+        if (file == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory for a DxfFile struct.\n")),
+                  __FUNCTION__);
+                fclose (fp);
+                dxf_read_release_buffer (buffer, size, compression);
+                return (NULL);
+        }
+        file->fp = fp;
+        file->filename = strdup (filename);
+        file->line_number = 0;
+        file->last_id_code = 0;
+        file->acad_version_number = 0;
+        file->follow_strict_version_rules = FALSE;
+        file->buffer = buffer;
+        file->buffer_size = size;
+        file->position = 0;
+        file->line_buffer = NULL;
+        file->line_buffer_size = 0;
+        memset (&file->pair, 0, sizeof (file->pair));
+        file->pair_pending = FALSE;
+        file->binary = 0;
+        file->parent = NULL;
+        file->compression = compression;
+        file->write_buffer = NULL;
+        file->write_buffer_size = 0;
+        file->write_length = 0;
+        file->decimals = DXF_WRITE_SHORTEST;
+        file->filter = NULL;
+        file->strings = NULL;
+        file->properties = NULL;
+        file->columns = NULL;
 #if DEBUG
         DXF_DEBUG_END
 #endif
-                return FALSE;
-        }
+        return (file);
+#endif
 }
 
 
-int
-dxf_read_is_string (int type)
+/*!
+ * \brief Opens a DxfFile on the bytes \c start up to \c end of the
+ * memory mapping of \c file.
+ *
+ * The window shares the mapping of \c file, but has its own read
+ * position and lexer state, so several windows on one file can be read
+ * concurrently, each from its own thread.\n
+ * The window has to be closed with dxf_read_close () before \c file.
+ *
+ * \return a pointer to the opened \c DxfFile, or \c NULL when an error
+ * occurred.
+ */
+DxfFile *
+dxf_read_init_window (DxfFile *file, size_t start, size_t end)
 {
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        if (type >= 0 && type <= 9)
+#if defined (MSDOS) || defined (_WIN32)
+        /* No memory mapping on these platforms. */
+        return (NULL);
+#else
+        DxfFile *window = NULL;
+        FILE *fp;
+
+        if ((file == NULL) || (file->buffer == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer or a file which is not memory mapped was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        if ((start >= end) || (end > file->buffer_size))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () an invalid range was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        fp = fmemopen (file->buffer + start, end - start, "r");
+        if (!fp)
+        {
+                fprintf (stderr,
+                  (_("Error: could not open a stream on the mapping of file: %s.\n")),
+                  file->filename);
+                return (NULL);
+        }
+        window = malloc (sizeof(DxfFile));
+        if (window == NULL)
         {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory for a DxfFile struct.\n")),
+                  __FUNCTION__);
+                fclose (fp);
+                return (NULL);
+        }
+        window->fp = fp;
+        window->filename = strdup (file->filename);
+        window->line_number = 0;
+        window->last_id_code = 0;
+        window->acad_version_number = file->acad_version_number;
+        window->follow_strict_version_rules = file->follow_strict_version_rules;
+        window->buffer = file->buffer + start;
+        window->buffer_size = end - start;
+        window->position = 0;
+        window->line_buffer = NULL;
+        window->line_buffer_size = 0;
+        memset (&window->pair, 0, sizeof (window->pair));
+        window->pair_pending = FALSE;
+        window->binary = file->binary;
+        window->parent = file;
+        window->compression = file->compression;
+        window->write_buffer = NULL;
+        window->write_buffer_size = 0;
+        window->write_length = 0;
+        window->decimals = file->decimals;
+        window->filter = file->filter;
+        window->strings = file->strings;
+        window->properties = file->properties;
+        /* Every window needs a columnar store of its own. */
+        window->columns = NULL;
 #if DEBUG
         DXF_DEBUG_END
 #endif
-                return TRUE;
+        return (window);
+#endif
+}
+
+
+void
+dxf_read_close (DxfFile *file)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        /*! \todo FIXME: how to free other sub structures */
+        if (file == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error: file is not initialised (NULL pointer).\n")));
         }
         else
         {
+                if (file->fp != NULL)
+                {
+                        fclose (file->fp);
+                }
+#if !defined (MSDOS) && !defined (_WIN32)
+                if ((file->buffer != NULL) && (file->parent == NULL))
+                {
+                        dxf_read_release_buffer (file->buffer,
+                          file->buffer_size, file->compression);
+                }
+#endif
+                free (file->line_buffer);
+                free (file->write_buffer);
+                free (file->filename);
+                free (file);
+                file = NULL;
+        }
 #if DEBUG
         DXF_DEBUG_END
 #endif
-                return FALSE;
-        }
 }
 
+
 /*!
- * \brief Opens a DxfFile, does error checking and resets the line number
- * counter.
- * 
- * Reset the line counting to 0.
- * 
+ * \brief Opens a DxfFile for writing, does error checking and resets
+ * the line number counter.
+ *
+ * When \c binary is set, the file is written as a binary DXF file: the
+ * binary DXF sentinel is written and all groups written through the
+ * dxf_write_* () functions (see writer.c) are emitted as binary group
+ * codes and raw little endian values.\n
+ * A \c filename ending in \c .gz or \c .zst is compressed with gzip or
+ * Zstandard while it is written.
+ *
+ * \return a pointer to the opened \c DxfFile, or \c NULL when an error
+ * occurred.
  */
 DxfFile *
-dxf_read_init (const char *filename)
+dxf_write_init (const char *filename, int binary)
 {
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         DxfFile * file = NULL;
         FILE *fp;
+        DxfCompression compression;
         if (!filename)
         {
                 fprintf (stderr,
@@ -133,22 +513,56 @@ dxf_read_init (const char *filename)
                   (_("Error: filename contains an empty string.\n")));
                 return (NULL);
         }
-        fp = fopen (filename, "r");
+        compression = dxf_compress_from_filename (filename);
+        fp = dxf_compress_fopen (filename, binary ? "wb" : "w", compression);
         if (!fp)
         {
                 fprintf (stderr,
-                  (_("Error: could not open file: %s for reading (NULL pointer).\n")),
+                  (_("Error: could not open file: %s for writing (NULL pointer).\n")),
                   filename);
                 return (NULL);
         }
         file = malloc (sizeof(DxfFile));
+        if (file == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                fclose (fp);
+                return (NULL);
+        }
         file->fp = fp;
         file->filename = strdup(filename);
         file->line_number = 0;
-        /*! \todo FIXME: dxf header and blocks need initialized ?
-        dxf_header_init (file->dxf_header);
-        dxf_block_init (file->dxf_block);
-        */
+        file->last_id_code = 0;
+        file->acad_version_number = 0;
+        file->follow_strict_version_rules = FALSE;
+        file->buffer = NULL;
+        file->buffer_size = 0;
+        file->position = 0;
+        file->line_buffer = NULL;
+        file->line_buffer_size = 0;
+        memset (&file->pair, 0, sizeof (file->pair));
+        file->pair_pending = FALSE;
+        file->binary = 0;
+        file->parent = NULL;
+        file->compression = compression;
+        /* Without an output buffer the writer writes every group to
+         * the stream directly. */
+        file->write_buffer = malloc (DXF_WRITE_BUFFER_SIZE);
+        file->write_buffer_size = (file->write_buffer == NULL) ? 0 : DXF_WRITE_BUFFER_SIZE;
+        file->write_length = 0;
+        file->decimals = DXF_WRITE_SHORTEST;
+        file->filter = NULL;
+        file->strings = NULL;
+        file->properties = NULL;
+        file->columns = NULL;
+        if (binary)
+        {
+                /* Always write 2 byte group codes (R14 and later). */
+                file->binary = 2;
+                fwrite (DXF_BINARY_SENTINEL, 1, DXF_BINARY_SENTINEL_LENGTH, fp);
+        }
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -156,25 +570,85 @@ dxf_read_init (const char *filename)
 }
 
 
-void
-dxf_read_close (DxfFile *file)
+/*!
+ * \brief Opens a DxfFile which collects everything written to it in
+ * memory, in the format (ASCII or binary) and for the AutoCAD version
+ * of \c file.
+ *
+ * The contents can be written to \c file, or any other file, with
+ * dxf_write_append ().  Memory files are independent of each other, so
+ * several threads can each write to their own.\n
+ * Close the memory file with dxf_write_close ().
+ *
+ * \return a pointer to the opened \c DxfFile, or \c NULL when an error
+ * occurred.
+ */
+DxfFile *
+dxf_write_init_memory (DxfFile *file)
 {
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        /*! \todo FIXME: how to free other sub structures */
+        DxfFile *memory = NULL;
+
         if (file == NULL)
         {
                 fprintf (stderr,
-                  (_("Error: file is not initialised (NULL pointer).\n")));
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
         }
-        else
+        memory = malloc (sizeof(DxfFile));
+        if (memory == NULL)
         {
-                fclose (file->fp);
-                free (file->filename);
-                free (file);
-                file = NULL;
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (NULL);
         }
+        memory->fp = NULL;
+        memory->filename = strdup (file->filename);
+        memory->line_number = 0;
+        memory->last_id_code = 0;
+        memory->acad_version_number = file->acad_version_number;
+        memory->follow_strict_version_rules = file->follow_strict_version_rules;
+        memory->buffer = NULL;
+        memory->buffer_size = 0;
+        memory->position = 0;
+        memory->line_buffer = NULL;
+        memory->line_buffer_size = 0;
+        memset (&memory->pair, 0, sizeof (memory->pair));
+        memory->pair_pending = FALSE;
+        memory->binary = file->binary;
+        memory->parent = NULL;
+        memory->compression = DXF_COMPRESSION_NONE;
+        /* The buffer is allocated by the writer on first use. */
+        memory->write_buffer = NULL;
+        memory->write_buffer_size = 0;
+        memory->write_length = 0;
+        memory->decimals = file->decimals;
+        memory->filter = NULL;
+        memory->strings = NULL;
+        memory->properties = NULL;
+        memory->columns = NULL;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (memory);
+}
+
+
+void
+dxf_write_close (DxfFile *file)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        if (file != NULL)
+        {
+                dxf_write_flush (file);
+        }
+        dxf_read_close (file);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -195,7 +669,15 @@ dxf_read_line (char * temp_string, DxfFile *fp)
 #endif
         int ret;
 
+        if (fp->buffer != NULL)
+        {
+                fseek (fp->fp, (long) fp->position, SEEK_SET);
+        }
         ret = fscanf (fp->fp, "%[^\n]\n", temp_string);
+        if (fp->buffer != NULL)
+        {
+                fp->position = (size_t) ftell (fp->fp);
+        }
         if (ferror (fp->fp))
         {
                 fprintf (stderr,
@@ -213,6 +695,61 @@ dxf_read_line (char * temp_string, DxfFile *fp)
         return ret;
 }
 
+/*!
+ * \brief Reads a line from a memory mapped file without copying it.
+ *
+ * The next line of the mapping is returned in \c slice, without the
+ * line terminator (both "\n" and "\r\n" are accepted).\n
+ * Calls to this function can be freely mixed with the stdio based
+ * readers.
+ *
+ * \return 1 when a line was read, \c EOF when the end of the mapping
+ * was reached, or when \c fp is not memory mapped.
+ */
+int
+dxf_read_slice (DxfFile *fp, DxfSlice *slice)
+{
+#if DEBUG
+        DXF_DEBUG_BEGIN
+#endif
+        const char *start;
+        const char *end;
+        const char *eol;
+
+        if ((fp == NULL) || (fp->buffer == NULL) || (slice == NULL))
+        {
+                return (EOF);
+        }
+        if (fp->position >= fp->buffer_size)
+        {
+                return (EOF);
+        }
+        start = fp->buffer + fp->position;
+        end = fp->buffer + fp->buffer_size;
+        eol = memchr (start, '\n', (size_t) (end - start));
+        if (eol == NULL)
+        {
+                eol = end;
+        }
+        slice->data = start;
+        slice->length = (size_t) (eol - start);
+        if ((slice->length > 0) && (start[slice->length - 1] == '\r'))
+        {
+                slice->length--;
+        }
+        if (eol < end)
+        {
+                eol++;
+        }
+        fp->position = (size_t) (eol - fp->buffer);
+        fp->line_number++;
+#if DEBUG
+        DXF_DEBUG_END
+#endif
+        return (1);
+}
+
+
 /*!
  * \brief Uses of fscanf with other features.
  * 
@@ -229,7 +766,15 @@ dxf_read_scanf (DxfFile *fp, const char *template, ...)
         char * search_result;
         va_list lst;
         va_start (lst, template);
+        if (fp->buffer != NULL)
+        {
+                fseek (fp->fp, (long) fp->position, SEEK_SET);
+        }
         ret = vfscanf (fp->fp, template, lst);
+        if (fp->buffer != NULL)
+        {
+                fp->position = (size_t) ftell (fp->fp);
+        }
         if (ferror (fp->fp))
         {
                 fprintf (stderr,
@@ -68,8 +68,14 @@ int dxf_read_is_int (int type);
 int dxf_read_is_string (int type);
 int dxf_read_line (char * temp_string, DxfFile *fp);
 int dxf_read_scanf (DxfFile *fp, const char *template, ...);
+int dxf_read_slice (DxfFile *fp, DxfSlice *slice);
 DxfFile *dxf_read_init (const char *filename);
+DxfFile *dxf_read_init_mmap (const char *filename);
+DxfFile *dxf_read_init_window (DxfFile *file, size_t start, size_t end);
 void dxf_read_close (DxfFile *file);
+DxfFile *dxf_write_init (const char *filename, int binary);
+DxfFile *dxf_write_init_memory (DxfFile *file);
+void dxf_write_close (DxfFile *file);
 
 
 #ifdef __cplusplus
@@ -33,6 +33,9 @@
 
 
 #include "vertex.h"
+#include "arena.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -58,7 +61,7 @@ dxf_vertex_new ()
         size = sizeof (DxfVertex);
         /* avoid malloc of 0 bytes */
         if (size == 0) size = 1;
-        if ((vertex = malloc (size)) == NULL)
+        if ((vertex = dxf_malloc (size)) == NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () could not allocate memory for a DxfVertex struct.\n")),
@@ -114,24 +117,17 @@ dxf_vertex_init
               return (NULL);
         }
         vertex->id_code = 0;
-        vertex->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        vertex->layer = strdup (DXF_DEFAULT_LAYER);
+        vertex->properties = dxf_graphic_properties_default ();
         vertex->x0 = 0.0;
         vertex->y0 = 0.0;
         vertex->z0 = 0.0;
-        vertex->elevation = 0.0;
-        vertex->thickness = 0.0;
         vertex->start_width = 0.0;
         vertex->end_width = 0.0;
         vertex->bulge = 0.0;
         vertex->curve_fit_tangent_direction = 0.0;
-        vertex->linetype_scale = DXF_DEFAULT_LINETYPE_SCALE;
-        vertex->visibility = DXF_DEFAULT_VISIBILITY;
-        vertex->color = DXF_COLOR_BYLAYER;
-        vertex->paperspace = DXF_MODELSPACE;
         vertex->flag = 0;
-        vertex->dictionary_owner_soft = strdup ("");
-        vertex->dictionary_owner_hard = strdup ("");
+        vertex->dictionary_owner_soft = dxf_strdup ("");
+        vertex->dictionary_owner_hard = dxf_strdup ("");
         vertex->next = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -169,7 +165,9 @@ dxf_vertex_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfGraphicProperties properties;
+        DxfPair pair;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -177,8 +175,6 @@ dxf_vertex_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (vertex == NULL)
@@ -189,224 +185,184 @@ dxf_vertex_read
                 vertex = dxf_vertex_new ();
                 vertex = dxf_vertex_init (vertex);
         }
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        dxf_graphic_properties_start (&properties, vertex->properties);
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        fclose (fp->fp);
-                        /* Clean up. */
-                        free (temp_string);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &vertex->id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", vertex->linetype);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", vertex->layer);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &vertex->x0);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &vertex->y0);
-                }
-                else if (strcmp (temp_string, "30") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &vertex->z0);
-                }
-                else if ((fp->acad_version_number <= AutoCAD_11)
-                        && (strcmp (temp_string, "38") == 0)
-                        && (vertex->elevation != 0.0))
-                {
-                        /* Now follows a string containing the
-                         * elevation. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &vertex->elevation);
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &vertex->thickness);
-                }
-                else if (strcmp (temp_string, "40") == 0)
-                {
-                        /* Now follows a string containing the
-                         * start width. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &vertex->start_width);
-                }
-                else if (strcmp (temp_string, "41") == 0)
-                {
-                        /* Now follows a string containing the
-                         * end width. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &vertex->end_width);
-                }
-                else if (strcmp (temp_string, "42") == 0)
-                {
-                        /* Now follows a string containing the
-                         * bulge. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &vertex->bulge);
-                }
-                else if (strcmp (temp_string, "48") == 0)
-                {
-                        /* Now follows a string containing the linetype
-                         * scale. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &vertex->linetype_scale);
-                }
-                else if (strcmp (temp_string, "50") == 0)
-                {
-                        /* Now follows a string containing the
-                         * curve fitting tangent. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &vertex->curve_fit_tangent_direction);
-                }
-                else if (strcmp (temp_string, "60") == 0)
-                {
-                        /* Now follows a string containing the
-                         * visibility value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &vertex->visibility);
-                }
-                else if (strcmp (temp_string, "62") == 0)
-                {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &vertex->color);
-                }
-                else if (strcmp (temp_string, "67") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &vertex->paperspace);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else if (strcmp (temp_string, "70") == 0)
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing the flag
-                         * value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &vertex->flag);
-                }
-                else if (strcmp (temp_string, "71") == 0)
-                {
-                        /* Now follows a string containing the Polyface
-                         * mesh vertex index value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &vertex->polyface_mesh_vertex_index_1);
-                }
-                else if (strcmp (temp_string, "72") == 0)
-                {
-                        /* Now follows a string containing the Polyface
-                         * mesh vertex index value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &vertex->polyface_mesh_vertex_index_2);
-                }
-                else if (strcmp (temp_string, "73") == 0)
-                {
-                        /* Now follows a string containing the Polyface
-                         * mesh vertex index value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &vertex->polyface_mesh_vertex_index_3);
-                }
-                else if (strcmp (temp_string, "74") == 0)
-                {
-                        /* Now follows a string containing the Polyface
-                         * mesh vertex index value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &vertex->polyface_mesh_vertex_index_4);
-                }
-                else if ((fp->acad_version_number >= AutoCAD_13)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if ((strcmp (temp_string, "AcDbEntity") != 0)
-                        && (strcmp (temp_string, "AcDbVertex") != 0)
-                        && (strcmp (temp_string, "AcDb2dVertex") != 0)
-                        && (strcmp (temp_string, "AcDb3dPolylineVertex") != 0))
-                        {
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                vertex->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 6:
+                                /* Now follows a string containing a linetype
+                                 * name. */
+                                dxf_lexer_free_string (fp, properties.linetype);
+                                properties.linetype = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 8:
+                                /* Now follows a string containing a layer name. */
+                                dxf_lexer_free_string (fp, properties.layer);
+                                properties.layer = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 10:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the point. */
+                                vertex->x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 20:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the point. */
+                                vertex->y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 30:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the point. */
+                                vertex->z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 38:
+                                if ((fp->acad_version_number <= AutoCAD_11)
+                                  && (properties.elevation != 0.0))
+                                {
+                                        /* Now follows a string containing the
+                                         * elevation. */
+                                        properties.elevation = dxf_pair_get_double (&pair);
+                                }
+                                break;
+                        case 39:
+                                /* Now follows a string containing the
+                                 * thickness. */
+                                properties.thickness = dxf_pair_get_double (&pair);
+                                break;
+                        case 40:
+                                /* Now follows a string containing the
+                                 * start width. */
+                                vertex->start_width = dxf_pair_get_double (&pair);
+                                break;
+                        case 41:
+                                /* Now follows a string containing the
+                                 * end width. */
+                                vertex->end_width = dxf_pair_get_double (&pair);
+                                break;
+                        case 42:
+                                /* Now follows a string containing the
+                                 * bulge. */
+                                vertex->bulge = dxf_pair_get_double (&pair);
+                                break;
+                        case 48:
+                                /* Now follows a string containing the linetype
+                                 * scale. */
+                                properties.linetype_scale = dxf_pair_get_double (&pair);
+                                break;
+                        case 50:
+                                /* Now follows a string containing the
+                                 * curve fitting tangent. */
+                                vertex->curve_fit_tangent_direction = dxf_pair_get_double (&pair);
+                                break;
+                        case 60:
+                                /* Now follows a string containing the
+                                 * visibility value. */
+                                properties.visibility = dxf_pair_get_int (&pair);
+                                break;
+                        case 62:
+                                /* Now follows a string containing the
+                                 * color value. */
+                                properties.color = dxf_pair_get_int (&pair);
+                                break;
+                        case 67:
+                                /* Now follows a string containing the
+                                 * paperspace value. */
+                                properties.paperspace = dxf_pair_get_int (&pair);
+                                break;
+                        case 70:
+                                /* Now follows a string containing the flag
+                                 * value. */
+                                vertex->flag = dxf_pair_get_int (&pair);
+                                break;
+                        case 71:
+                                /* Now follows a string containing the Polyface
+                                 * mesh vertex index value. */
+                                vertex->polyface_mesh_vertex_index_1 = dxf_pair_get_int (&pair);
+                                break;
+                        case 72:
+                                /* Now follows a string containing the Polyface
+                                 * mesh vertex index value. */
+                                vertex->polyface_mesh_vertex_index_2 = dxf_pair_get_int (&pair);
+                                break;
+                        case 73:
+                                /* Now follows a string containing the Polyface
+                                 * mesh vertex index value. */
+                                vertex->polyface_mesh_vertex_index_3 = dxf_pair_get_int (&pair);
+                                break;
+                        case 74:
+                                /* Now follows a string containing the Polyface
+                                 * mesh vertex index value. */
+                                vertex->polyface_mesh_vertex_index_4 = dxf_pair_get_int (&pair);
+                                break;
+                        case 100:
+                                if (fp->acad_version_number >= AutoCAD_13)
+                                {
+                                        /* Now follows a string containing the
+                                         * subclass marker value. */
+                                        dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                        if ((strcmp (temp_string, "AcDbEntity") != 0)
+                                        && (strcmp (temp_string, "AcDbVertex") != 0)
+                                        && (strcmp (temp_string, "AcDb2dVertex") != 0)
+                                        && (strcmp (temp_string, "AcDb3dPolylineVertex") != 0))
+                                        {
+                                                fprintf (stderr,
+                                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                                  __FUNCTION__, fp->filename, fp->line_number);
+                                        }
+                                }
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, vertex->dictionary_owner_soft);
+                                vertex->dictionary_owner_soft = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                dxf_lexer_free_string (fp, vertex->dictionary_owner_hard);
+                                vertex->dictionary_owner_hard = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, "DXF comment: %s\n", temp_string);
+                                break;
+                        default:
                                 fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
                                   __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", vertex->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", vertex->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
         /* Handle omitted members and/or illegal values. */
-        if (strcmp (vertex->linetype, "") == 0)
+        if ((properties.linetype != NULL)
+          && (strcmp (properties.linetype, "") == 0))
         {
-                vertex->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_lexer_free_string (fp, properties.linetype);
+                properties.linetype = dxf_strdup (DXF_DEFAULT_LINETYPE);
         }
-        if (strcmp (vertex->layer, "") == 0)
+        if ((properties.layer != NULL)
+          && (strcmp (properties.layer, "") == 0))
         {
-                vertex->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_lexer_free_string (fp, properties.layer);
+                properties.layer = dxf_strdup (DXF_DEFAULT_LAYER);
         }
-        /* Clean up. */
-        free (temp_string);
+        /* Entities with equal properties share a record. */
+        dxf_graphic_properties_finish (fp, &vertex->properties, &properties);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -438,7 +394,7 @@ dxf_vertex_write
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *dxf_entity_name = strdup ("VERTEX");
+        char *dxf_entity_name = dxf_strdup ("VERTEX");
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -447,7 +403,7 @@ dxf_vertex_write
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (vertex == NULL)
@@ -456,34 +412,42 @@ dxf_vertex_write
                   (_("Error in %s () a NULL pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
-        if (strcmp (vertex->linetype, "") == 0)
+        if (strcmp (vertex->properties->linetype, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, vertex->id_code);
                 fprintf (stderr,
                   (_("    %s entity is reset to default linetype")),
                   dxf_entity_name);
-                vertex->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                if (dxf_graphic_properties_unshare (&vertex->properties) != NULL)
+                {
+                        dxf_free (vertex->properties->linetype);
+                        vertex->properties->linetype = dxf_strdup (DXF_DEFAULT_LINETYPE);
+                }
         }
-        if (strcmp (vertex->layer, "") == 0)
+        if (strcmp (vertex->properties->layer, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty layer string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty layer string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, vertex->id_code);
                 fprintf (stderr,
                   (_("    %s entity is relocated to layer 0")),
                   dxf_entity_name);
-                vertex->layer = strdup (DXF_DEFAULT_LAYER);
+                if (dxf_graphic_properties_unshare (&vertex->properties) != NULL)
+                {
+                        dxf_free (vertex->properties->layer);
+                        vertex->properties->layer = dxf_strdup (DXF_DEFAULT_LAYER);
+                }
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_string (fp, 0, dxf_entity_name);
         if (vertex->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", vertex->id_code);
+                dxf_write_hex (fp, 5, vertex->id_code);
         }
         /*!
          * \todo for version R14.\n
@@ -498,97 +462,97 @@ dxf_vertex_write
         if ((strcmp (vertex->dictionary_owner_soft, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", vertex->dictionary_owner_soft);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, vertex->dictionary_owner_soft);
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (vertex->dictionary_owner_hard, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", vertex->dictionary_owner_hard);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, vertex->dictionary_owner_hard);
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbEntity\n");
+                dxf_write_string (fp, 100, "AcDbEntity");
         }
-        if (vertex->paperspace == DXF_PAPERSPACE)
+        if (vertex->properties->paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp->fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_int (fp, 67, DXF_PAPERSPACE);
         }
-        fprintf (fp->fp, "  8\n%s\n", vertex->layer);
-        if (strcmp (vertex->linetype, DXF_DEFAULT_LINETYPE) != 0)
+        dxf_write_string (fp, 8, vertex->properties->layer);
+        if (strcmp (vertex->properties->linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp->fp, "  6\n%s\n", vertex->linetype);
+                dxf_write_string (fp, 6, vertex->properties->linetype);
         }
         if ((fp->acad_version_number <= AutoCAD_11)
           && DXF_FLATLAND
-          && (vertex->elevation != 0.0))
+          && (vertex->properties->elevation != 0.0))
         {
-                fprintf (fp->fp, " 38\n%f\n", vertex->elevation);
+                dxf_write_double (fp, 38, vertex->properties->elevation);
         }
-        if (vertex->color != DXF_COLOR_BYLAYER)
+        if (vertex->properties->color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp->fp, " 62\n%d\n", vertex->color);
+                dxf_write_int (fp, 62, vertex->properties->color);
         }
-        if (vertex->linetype_scale != 1.0)
+        if (vertex->properties->linetype_scale != 1.0)
         {
-                fprintf (fp->fp, " 48\n%f\n", vertex->linetype_scale);
+                dxf_write_double (fp, 48, vertex->properties->linetype_scale);
         }
-        if (vertex->visibility != 0)
+        if (vertex->properties->visibility != 0)
         {
-                fprintf (fp->fp, " 60\n%d\n", vertex->visibility);
+                dxf_write_int (fp, 60, vertex->properties->visibility);
         }
         /*! \todo Put \c thickness in the correct order. */ 
-        if (vertex->thickness != 0.0)
+        if (vertex->properties->thickness != 0.0)
         {
-                fprintf (fp->fp, " 39\n%f\n", vertex->thickness);
+                dxf_write_double (fp, 39, vertex->properties->thickness);
         }
-        fprintf (fp->fp, "100\nAcDbVertex\n");
+        dxf_write_string (fp, 100, "AcDbVertex");
         /*! \todo We use a \c 3dPolylineVertex for now,
          * it could have been a \c 2dVertex as well, in that case use:\n
-        fprintf (fp->fp, "100\nAcDb2dVertex\n");
+        dxf_write_string (fp, 100, "AcDb2dVertex");
          */
-        fprintf (fp->fp, "100\nAcDb3dPolylineVertex\n");
-        fprintf (fp->fp, " 10\n%f\n", vertex->x0);
-        fprintf (fp->fp, " 20\n%f\n", vertex->y0);
-        fprintf (fp->fp, " 30\n%f\n", vertex->z0);
+        dxf_write_string (fp, 100, "AcDb3dPolylineVertex");
+        dxf_write_double (fp, 10, vertex->x0);
+        dxf_write_double (fp, 20, vertex->y0);
+        dxf_write_double (fp, 30, vertex->z0);
         if (vertex->start_width != 0.0)
         {
-                fprintf (fp->fp, " 40\n%f\n", vertex->start_width);
+                dxf_write_double (fp, 40, vertex->start_width);
         }
         if (vertex->end_width != 0.0)
         {
-                fprintf (fp->fp, " 41\n%f\n", vertex->end_width);
+                dxf_write_double (fp, 41, vertex->end_width);
         }
         if (vertex->bulge != 0.0)
         {
-                fprintf (fp->fp, " 42\n%f\n", vertex->bulge);
+                dxf_write_double (fp, 42, vertex->bulge);
         }
-        fprintf (fp->fp, " 70\n%d\n", vertex->flag);
+        dxf_write_int (fp, 70, vertex->flag);
         if (vertex->curve_fit_tangent_direction != 0.0)
         {
-                fprintf (fp->fp, " 50\n%f\n", vertex->curve_fit_tangent_direction);
+                dxf_write_double (fp, 50, vertex->curve_fit_tangent_direction);
         }
         if (vertex->polyface_mesh_vertex_index_1 != 0)
         {
-                fprintf (fp->fp, " 71\n%d\n", vertex->polyface_mesh_vertex_index_1);
+                dxf_write_int (fp, 71, vertex->polyface_mesh_vertex_index_1);
         }
         if (vertex->polyface_mesh_vertex_index_2 != 0)
         {
-                fprintf (fp->fp, " 72\n%d\n", vertex->polyface_mesh_vertex_index_2);
+                dxf_write_int (fp, 72, vertex->polyface_mesh_vertex_index_2);
         }
         if (vertex->polyface_mesh_vertex_index_3 != 0)
         {
-                fprintf (fp->fp, " 73\n%d\n", vertex->polyface_mesh_vertex_index_3);
+                dxf_write_int (fp, 73, vertex->polyface_mesh_vertex_index_3);
         }
         if (vertex->polyface_mesh_vertex_index_4 != 0)
         {
-                fprintf (fp->fp, " 74\n%d\n", vertex->polyface_mesh_vertex_index_4);
+                dxf_write_int (fp, 74, vertex->polyface_mesh_vertex_index_4);
         }
         /* Clean up. */
-        free (dxf_entity_name);
+        dxf_free (dxf_entity_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -626,11 +590,10 @@ dxf_vertex_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (vertex->linetype);
-        free (vertex->layer);
-        free (vertex->dictionary_owner_soft);
-        free (vertex->dictionary_owner_hard);
-        free (vertex);
+        dxf_graphic_properties_free (vertex->properties);
+        dxf_free (vertex->dictionary_owner_soft);
+        dxf_free (vertex->dictionary_owner_hard);
+        dxf_free (vertex);
         vertex = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -656,7 +619,7 @@ dxf_vertex_free_chain
                 /*!< a pointer to the chain of DXF \c VERTEX entities. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (vertices == NULL)
@@ -668,6 +631,7 @@ dxf_vertex_free_chain
         while (vertices != NULL)
         {
                 struct DxfVertex *iter = vertices->next;
+                vertices->next = NULL;
                 dxf_vertex_free (vertices);
                 vertices = (DxfVertex *) iter;
         }
@@ -677,4 +641,455 @@ dxf_vertex_free_chain
 }
 
 
+/*!
+ * \brief Initialize an empty DxfVertexArray.
+ */
+void
+dxf_vertex_array_init
+(
+        DxfVertexArray *array,
+                /*!< the packed vertices. */
+        int dimensions
+                /*!< 2 for vertices without a Z-value, 3 for vertices
+                 * with one. */
+)
+{
+        array->count = 0;
+        array->capacity = 0;
+        array->dimensions = dimensions;
+        array->x0 = NULL;
+        array->y0 = NULL;
+        array->z0 = NULL;
+        array->bulge = NULL;
+        array->start_width = NULL;
+        array->end_width = NULL;
+        array->flag = NULL;
+        array->arena = dxf_arena_get_current ();
+}
+
+
+/*!
+ * \brief Grow one array of a DxfVertexArray to \c needed entries.
+ *
+ * An array which is \c NULL and not \c always is left alone.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_vertex_array_grow
+(
+        DxfVertexArray *array,
+                /*!< the packed vertices. */
+        void **member,
+                /*!< the array to grow. */
+        int always,
+                /*!< \c TRUE when the array is allocated for every
+                 * vertex. */
+        int needed,
+                /*!< number of entries needed. */
+        size_t size
+                /*!< size of an entry in bytes. */
+)
+{
+        int capacity = array->capacity;
+        void *grown;
+
+        if ((*member == NULL) && !always)
+        {
+                return (EXIT_SUCCESS);
+        }
+        grown = dxf_array_reserve (*member, array->count, &capacity,
+          needed, size);
+        if (grown == NULL)
+        {
+                return (EXIT_FAILURE);
+        }
+        *member = grown;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Make room for \c needed vertices in \c array.
+ *
+ * A \c LWPOLYLINE announces its number of vertices, reserving that many
+ * up front sizes the arrays exactly.  Otherwise the arrays grow to
+ * twice their size at least.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_vertex_array_reserve
+(
+        DxfVertexArray *array,
+                /*!< the packed vertices. */
+        int needed
+                /*!< number of vertices needed. */
+)
+{
+        DxfArena *previous;
+        int capacity;
+        int result = EXIT_SUCCESS;
+
+        /* Do some basic checks. */
+        if (array == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (needed <= array->capacity)
+        {
+                return (EXIT_SUCCESS);
+        }
+        capacity = 2 * array->capacity;
+        if (capacity < needed)
+        {
+                capacity = needed;
+        }
+        previous = dxf_arena_set_current (array->arena);
+        /* An array which grew keeps its entries when a later one fails,
+         * the capacity is only raised when all of them grew. */
+        if ((dxf_vertex_array_grow (array, (void **) &array->x0, TRUE, capacity, sizeof (double)) != EXIT_SUCCESS)
+          || (dxf_vertex_array_grow (array, (void **) &array->y0, TRUE, capacity, sizeof (double)) != EXIT_SUCCESS)
+          || (dxf_vertex_array_grow (array, (void **) &array->z0, (array->dimensions == 3), capacity, sizeof (double)) != EXIT_SUCCESS)
+          || (dxf_vertex_array_grow (array, (void **) &array->bulge, TRUE, capacity, sizeof (double)) != EXIT_SUCCESS)
+          || (dxf_vertex_array_grow (array, (void **) &array->start_width, FALSE, capacity, sizeof (double)) != EXIT_SUCCESS)
+          || (dxf_vertex_array_grow (array, (void **) &array->end_width, FALSE, capacity, sizeof (double)) != EXIT_SUCCESS)
+          || (dxf_vertex_array_grow (array, (void **) &array->flag, FALSE, capacity, sizeof (int)) != EXIT_SUCCESS))
+        {
+                result = EXIT_FAILURE;
+        }
+        else
+        {
+                array->capacity = capacity;
+        }
+        dxf_arena_set_current (previous);
+        return (result);
+}
+
+
+/*!
+ * \brief Append a vertex to \c array.
+ *
+ * The widths and flag of the new vertex are 0.0 and 0.
+ *
+ * \return the index of the vertex, or -1 when an error occurred.
+ */
+int
+dxf_vertex_array_append
+(
+        DxfVertexArray *array,
+                /*!< the packed vertices. */
+        double x0,
+                /*!< X-value of the vertex. */
+        double y0,
+                /*!< Y-value of the vertex. */
+        double z0,
+                /*!< Z-value of the vertex, ignored for 2 dimensions. */
+        double bulge
+                /*!< bulge of the vertex. */
+)
+{
+        int index;
+
+        if (dxf_vertex_array_reserve (array, array->count + 1) != EXIT_SUCCESS)
+        {
+                return (-1);
+        }
+        index = array->count;
+        array->x0[index] = x0;
+        array->y0[index] = y0;
+        if (array->z0 != NULL)
+        {
+                array->z0[index] = z0;
+        }
+        array->bulge[index] = bulge;
+        if (array->start_width != NULL)
+        {
+                array->start_width[index] = 0.0;
+                array->end_width[index] = 0.0;
+        }
+        if (array->flag != NULL)
+        {
+                array->flag[index] = 0;
+        }
+        array->count++;
+        return (index);
+}
+
+
+/*!
+ * \brief Set the widths of vertex \c index of \c array.
+ *
+ * The widths of all vertices are allocated when the first vertex gets
+ * widths.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_vertex_array_set_widths
+(
+        DxfVertexArray *array,
+                /*!< the packed vertices. */
+        int index,
+                /*!< index of the vertex. */
+        double start_width,
+                /*!< starting width. */
+        double end_width
+                /*!< ending width. */
+)
+{
+        DxfArena *previous;
+
+        /* Do some basic checks. */
+        if ((array == NULL) || (index < 0) || (index >= array->count))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer or invalid index was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (array->start_width == NULL)
+        {
+                previous = dxf_arena_set_current (array->arena);
+                array->start_width = dxf_calloc ((size_t) array->capacity, sizeof (double));
+                array->end_width = dxf_calloc ((size_t) array->capacity, sizeof (double));
+                dxf_arena_set_current (previous);
+                if ((array->start_width == NULL) || (array->end_width == NULL))
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () could not allocate memory.\n")),
+                          __FUNCTION__);
+                        dxf_free (array->start_width);
+                        dxf_free (array->end_width);
+                        array->start_width = NULL;
+                        array->end_width = NULL;
+                        return (EXIT_FAILURE);
+                }
+        }
+        array->start_width[index] = start_width;
+        array->end_width[index] = end_width;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Set the flag of vertex \c index of \c array.
+ *
+ * The flags of all vertices are allocated when the first vertex gets a
+ * flag which is not 0.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_vertex_array_set_flag
+(
+        DxfVertexArray *array,
+                /*!< the packed vertices. */
+        int index,
+                /*!< index of the vertex. */
+        int flag
+                /*!< vertex flag. */
+)
+{
+        DxfArena *previous;
+
+        /* Do some basic checks. */
+        if ((array == NULL) || (index < 0) || (index >= array->count))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer or invalid index was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if ((array->flag == NULL) && (flag == 0))
+        {
+                return (EXIT_SUCCESS);
+        }
+        if (array->flag == NULL)
+        {
+                previous = dxf_arena_set_current (array->arena);
+                array->flag = dxf_calloc ((size_t) array->capacity, sizeof (int));
+                dxf_arena_set_current (previous);
+                if (array->flag == NULL)
+                {
+                        fprintf (stderr,
+                          (_("Error in %s () could not allocate memory.\n")),
+                          __FUNCTION__);
+                        return (EXIT_FAILURE);
+                }
+        }
+        array->flag[index] = flag;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Build a chain of DxfVertex entities holding the vertices of
+ * \c array.
+ *
+ * The chain is taken from the arena of \c array.
+ *
+ * \return the first vertex of the chain, to be freed with
+ * dxf_vertex_free_chain (), or \c NULL when \c array is empty or an
+ * error occurred.
+ */
+DxfVertex *
+dxf_vertex_array_to_chain
+(
+        DxfVertexArray *array
+                /*!< the packed vertices. */
+)
+{
+        DxfArena *previous;
+        DxfVertex *first = NULL;
+        DxfVertex *last = NULL;
+        DxfVertex *vertex;
+        int i;
+
+        /* Do some basic checks. */
+        if (array == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        previous = dxf_arena_set_current (array->arena);
+        for (i = 0; i < array->count; i++)
+        {
+                vertex = dxf_vertex_init (dxf_vertex_new ());
+                if (vertex == NULL)
+                {
+                        if (first != NULL)
+                        {
+                                dxf_vertex_free_chain (first);
+                        }
+                        first = NULL;
+                        break;
+                }
+                vertex->x0 = array->x0[i];
+                vertex->y0 = array->y0[i];
+                vertex->z0 = (array->z0 != NULL) ? array->z0[i] : 0.0;
+                vertex->bulge = array->bulge[i];
+                if (array->start_width != NULL)
+                {
+                        vertex->start_width = array->start_width[i];
+                        vertex->end_width = array->end_width[i];
+                }
+                if (array->flag != NULL)
+                {
+                        vertex->flag = array->flag[i];
+                }
+                if (last == NULL)
+                {
+                        first = vertex;
+                }
+                else
+                {
+                        last->next = (struct DxfVertex *) vertex;
+                }
+                last = vertex;
+        }
+        dxf_arena_set_current (previous);
+        return (first);
+}
+
+
+/*!
+ * \brief Replace the vertices of \c array with copies of the chain
+ * \c vertices.
+ *
+ * Only the members a DxfVertexArray holds are copied.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_vertex_array_from_chain
+(
+        DxfVertexArray *array,
+                /*!< the packed vertices. */
+        DxfVertex *vertices
+                /*!< the first vertex of the chain, or \c NULL. */
+)
+{
+        DxfVertex *iter;
+        int count = 0;
+        int index;
+
+        /* Do some basic checks. */
+        if (array == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        for (iter = vertices; iter != NULL; iter = (DxfVertex *) iter->next)
+        {
+                count++;
+        }
+        array->count = 0;
+        if (dxf_vertex_array_reserve (array, count) != EXIT_SUCCESS)
+        {
+                return (EXIT_FAILURE);
+        }
+        for (iter = vertices; iter != NULL; iter = (DxfVertex *) iter->next)
+        {
+                index = dxf_vertex_array_append (array, iter->x0, iter->y0,
+                  iter->z0, iter->bulge);
+                if (((iter->start_width != 0.0) || (iter->end_width != 0.0)
+                  || (array->start_width != NULL))
+                  && (dxf_vertex_array_set_widths (array, index,
+                  iter->start_width, iter->end_width) != EXIT_SUCCESS))
+                {
+                        return (EXIT_FAILURE);
+                }
+                if (dxf_vertex_array_set_flag (array, index, iter->flag) != EXIT_SUCCESS)
+                {
+                        return (EXIT_FAILURE);
+                }
+        }
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Free the arrays of \c array, leaving it empty.
+ *
+ * The array keeps its arena.
+ */
+void
+dxf_vertex_array_free
+(
+        DxfVertexArray *array
+                /*!< the packed vertices. */
+)
+{
+        dxf_free (array->x0);
+        dxf_free (array->y0);
+        dxf_free (array->z0);
+        dxf_free (array->bulge);
+        dxf_free (array->start_width);
+        dxf_free (array->end_width);
+        dxf_free (array->flag);
+        array->count = 0;
+        array->capacity = 0;
+        array->x0 = NULL;
+        array->y0 = NULL;
+        array->z0 = NULL;
+        array->bulge = NULL;
+        array->start_width = NULL;
+        array->end_width = NULL;
+        array->flag = NULL;
+}
+
+
 /* EOF */
@@ -37,6 +37,7 @@
 
 
 #include "global.h"
+#include "graphic_properties.h"
 
 
 #ifdef __cplusplus
@@ -78,50 +79,16 @@ typedef struct
 dxf_vertex_struct
 {
         /* Members common for all DXF drawable entities. */
-        int id_code;
+        long id_code;
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file.\n
                  * Group code = 5. */
-        char *linetype;
-                /*!< The linetype of the entity.\n
-                 * Defaults to \c BYLAYER if ommitted in the DXF file.\n
-                 * Group code = 6. */
-        char *layer;
-                /*!< Layer on which the entity is drawn.\n
-                 * Defaults to layer "0" if no valid layername is given.\n
-                 * Group code = 8. */
-        double elevation;
-                /*!< Elevation of the arc in the local Z-direction.\n
-                 * Defaults to 0.0 if omitted in the DXF file, or prior
-                 * to DXF version R12, or DXF_FLATLAND equals 0 (default).\n
-                 * Group code = 38. */
-        double thickness;
-                /*!< Thickness of the arc in the local Z-direction.\n
-                 * Defaults to 0.0 if ommitted in the DXF file.\n
-                 * Group code = 39. */
-        double linetype_scale;
-                /*!< Linetype scale (optional).\n
-                 * Group code = 48. */
-        int16_t visibility;
-                /*!< Object visibility (optional):\n
-                 * <ol>
-                 * <li value = "0"> Visible</li>
-                 * <li value = "1"> Invisible</li>
-                 * </ol>
-                 * Group code = 60. */
-        int color;
-                /*!< Color of the entity.\n
-                 * Defaults to \c BYLAYER if ommitted in the DXF file.\n
-                 * Note that entities encapsulated in a block with the
-                 * color \c BYBLOCK are represented in the "native" color of
-                 * the \c BLOCK entity.\n
-                 * Group code = 62. */
-        int paperspace;
-                /*!< Entities are to be drawn on either \c PAPERSPACE or
-                 * \c MODELSPACE.\n
-                 * Optional, defaults to \c DXF_MODELSPACE (0).\n
-                 * Group code = 67. */
+        DxfGraphicProperties *properties;
+                /*!< Linetype, layer, color and the other graphic
+                 * properties, shared with the entities which have
+                 * the same (see graphic_properties.h).\n
+                 * Group codes = 6, 8, 38, 39, 48, 60, 62 and 67. */
         char *dictionary_owner_soft;
                 /*!< Soft-pointer ID/handle to owner dictionary (optional).\n
                  * Group code = 330. */
@@ -198,6 +165,55 @@ dxf_vertex_struct
 } DxfVertex;
 
 
+/*!
+ * \brief Packed vertices of a \c LWPOLYLINE or \c POLYLINE entity.
+ *
+ * Every member of a vertex is held in an array of its own, index \c i
+ * of every array belongs to the \c i th vertex.\n
+ * The widths and flags are only allocated once a vertex has them,
+ * until then they are 0.0 and 0 for all vertices.\n
+ * Whatever is allocated for the vertices later on comes from the arena
+ * which was current when the array was initialised, so the vertices of
+ * an entity read into the arenas of a drawing are released with them.
+ */
+typedef struct
+dxf_vertex_array_struct
+{
+        int count;
+                /*!< Number of vertices. */
+        int capacity;
+                /*!< Number of vertices the arrays have room for. */
+        int dimensions;
+                /*!< 2 for vertices without a Z-value (\c LWPOLYLINE),
+                 * 3 for vertices with one (\c POLYLINE). */
+        double *x0;
+                /*!< X-values.\n
+                 * Group code = 10. */
+        double *y0;
+                /*!< Y-values.\n
+                 * Group code = 20. */
+        double *z0;
+                /*!< Z-values, \c NULL for 2 dimensions.\n
+                 * Group code = 30. */
+        double *bulge;
+                /*!< Bulges.\n
+                 * Group code = 42. */
+        double *start_width;
+                /*!< Starting widths, or \c NULL.\n
+                 * Group code = 40. */
+        double *end_width;
+                /*!< Ending widths, or \c NULL.\n
+                 * Group code = 41. */
+        int *flag;
+                /*!< Vertex flags, or \c NULL.\n
+                 * Group code = 70. */
+        struct dxf_arena_struct *arena;
+                /*!< Arena the arrays and the chain of the entity are
+                 * taken from, the current arena of the thread when the
+                 * array was initialised, or \c NULL for \c malloc (). */
+} DxfVertexArray;
+
+
 DxfVertex *
 dxf_vertex_new ();
 DxfVertex *
@@ -227,6 +243,58 @@ dxf_vertex_free_chain
 (
         DxfVertex *vertices
 );
+void
+dxf_vertex_array_init
+(
+        DxfVertexArray *array,
+        int dimensions
+);
+int
+dxf_vertex_array_reserve
+(
+        DxfVertexArray *array,
+        int needed
+);
+int
+dxf_vertex_array_append
+(
+        DxfVertexArray *array,
+        double x0,
+        double y0,
+        double z0,
+        double bulge
+);
+int
+dxf_vertex_array_set_widths
+(
+        DxfVertexArray *array,
+        int index,
+        double start_width,
+        double end_width
+);
+int
+dxf_vertex_array_set_flag
+(
+        DxfVertexArray *array,
+        int index,
+        int flag
+);
+DxfVertex *
+dxf_vertex_array_to_chain
+(
+        DxfVertexArray *array
+);
+int
+dxf_vertex_array_from_chain
+(
+        DxfVertexArray *array,
+        DxfVertex *vertices
+);
+void
+dxf_vertex_array_free
+(
+        DxfVertexArray *array
+);
 
 
 #ifdef __cplusplus
@@ -33,6 +33,8 @@
 
 
 #include "view.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -174,7 +176,8 @@ dxf_view_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfPair pair;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -182,8 +185,6 @@ dxf_view_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (view == NULL)
@@ -194,194 +195,150 @@ dxf_view_read
                 view = dxf_view_new ();
                 view = dxf_view_init (view);
         }
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        fclose (fp->fp);
-                        /* Clean up. */
-                        free (temp_string);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &view->id_code);
-                }
-                else if (strcmp (temp_string, "2") == 0)
-                {
-                        /* Now follows a string containing a view
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", view->view_name);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the View center point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &view->x_view);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the View center point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &view->y_view);
-                }
-                else if (strcmp (temp_string, "11") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the View direction from
-                         * target. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &view->x_direction);
-                }
-                else if (strcmp (temp_string, "21") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the View direction from
-                         * target. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &view->y_direction);
-                }
-                else if (strcmp (temp_string, "31") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the View direction from
-                         * target. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &view->z_direction);
-                }
-                else if (strcmp (temp_string, "12") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the Target point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &view->x_target);
-                }
-                else if (strcmp (temp_string, "22") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the Target point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &view->y_target);
-                }
-                else if (strcmp (temp_string, "32") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the Target point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &view->z_target);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else if (strcmp (temp_string, "40") == 0)
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing the view
-                         * height. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &view->view_height);
-                }
-                else if (strcmp (temp_string, "41") == 0)
-                {
-                        /* Now follows a string containing the view
-                         * width. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &view->view_width);
-                }
-                else if (strcmp (temp_string, "42") == 0)
-                {
-                        /* Now follows a string containing the lens
-                         * length. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &view->lens_length);
-                }
-                else if (strcmp (temp_string, "43") == 0)
-                {
-                        /* Now follows a string containing the Front
-                         * clipping plane - offset from target point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &view->front_plane_offset);
-                }
-                else if (strcmp (temp_string, "44") == 0)
-                {
-                        /* Now follows a string containing the Back
-                         * clipping plane - offset from target point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &view->back_plane_offset);
-                }
-                else if (strcmp (temp_string, "50") == 0)
-                {
-                        /* Now follows a string containing the view
-                         * twist angle. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &view->view_twist_angle);
-                }
-                else if (strcmp (temp_string, "70") == 0)
-                {
-                        /* Now follows a string containing the
-                         * standard flag value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &view->flag);
-                }
-                else if (strcmp (temp_string, "71") == 0)
-                {
-                        /* Now follows a string containing the view mode
-                         * value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &view->view_mode);
-                }
-                else if ((fp->acad_version_number >= AutoCAD_13)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if ((strcmp (temp_string, "AcDbSymbolTableRecord") != 0)
-                        && ((strcmp (temp_string, "AcDbViewTableRecord") != 0)))
-                        {
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                view->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 2:
+                                /* Now follows a string containing a view
+                                 * name. */
+                                free (view->view_name);
+                                view->view_name = dxf_pair_get_string (&pair);
+                                break;
+                        case 10:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the View center point. */
+                                view->x_view = dxf_pair_get_double (&pair);
+                                break;
+                        case 20:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the View center point. */
+                                view->y_view = dxf_pair_get_double (&pair);
+                                break;
+                        case 11:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the View direction from
+                                 * target. */
+                                view->x_direction = dxf_pair_get_double (&pair);
+                                break;
+                        case 21:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the View direction from
+                                 * target. */
+                                view->y_direction = dxf_pair_get_double (&pair);
+                                break;
+                        case 31:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the View direction from
+                                 * target. */
+                                view->z_direction = dxf_pair_get_double (&pair);
+                                break;
+                        case 12:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the Target point. */
+                                view->x_target = dxf_pair_get_double (&pair);
+                                break;
+                        case 22:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the Target point. */
+                                view->y_target = dxf_pair_get_double (&pair);
+                                break;
+                        case 32:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the Target point. */
+                                view->z_target = dxf_pair_get_double (&pair);
+                                break;
+                        case 40:
+                                /* Now follows a string containing the view
+                                 * height. */
+                                view->view_height = dxf_pair_get_double (&pair);
+                                break;
+                        case 41:
+                                /* Now follows a string containing the view
+                                 * width. */
+                                view->view_width = dxf_pair_get_double (&pair);
+                                break;
+                        case 42:
+                                /* Now follows a string containing the lens
+                                 * length. */
+                                view->lens_length = dxf_pair_get_double (&pair);
+                                break;
+                        case 43:
+                                /* Now follows a string containing the Front
+                                 * clipping plane - offset from target point. */
+                                view->front_plane_offset = dxf_pair_get_double (&pair);
+                                break;
+                        case 44:
+                                /* Now follows a string containing the Back
+                                 * clipping plane - offset from target point. */
+                                view->back_plane_offset = dxf_pair_get_double (&pair);
+                                break;
+                        case 50:
+                                /* Now follows a string containing the view
+                                 * twist angle. */
+                                view->view_twist_angle = dxf_pair_get_double (&pair);
+                                break;
+                        case 70:
+                                /* Now follows a string containing the
+                                 * standard flag value. */
+                                view->flag = dxf_pair_get_int (&pair);
+                                break;
+                        case 71:
+                                /* Now follows a string containing the view mode
+                                 * value. */
+                                view->view_mode = dxf_pair_get_int (&pair);
+                                break;
+                        case 100:
+                                if (fp->acad_version_number >= AutoCAD_13)
+                                {
+                                        /* Now follows a string containing the
+                                         * subclass marker value. */
+                                        dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                        if ((strcmp (temp_string, "AcDbSymbolTableRecord") != 0)
+                                        && ((strcmp (temp_string, "AcDbViewTableRecord") != 0)))
+                                        {
+                                                fprintf (stderr,
+                                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                                  __FUNCTION__, fp->filename, fp->line_number);
+                                        }
+                                }
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner dictionary. */
+                                free (view->dictionary_owner_soft);
+                                view->dictionary_owner_soft = dxf_pair_get_string (&pair);
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                free (view->dictionary_owner_hard);
+                                view->dictionary_owner_hard = dxf_pair_get_string (&pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, "DXF comment: %s\n", temp_string);
+                                break;
+                        default:
                                 fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
                                   __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", view->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", view->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
-        /* Clean up. */
-        free (temp_string);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -438,7 +395,7 @@ dxf_view_write
           || (strcmp (view->view_name, "") == 0))
         {
                 fprintf (stderr,
-                  (_("Error in %s () empty UCS name string for the %s entity with id-code: %x\n")),
+                  (_("Error in %s () empty UCS name string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, view->id_code);
                 fprintf (stderr,
                   (_("\t%s entity is discarded from output.\n")),
@@ -448,10 +405,10 @@ dxf_view_write
                 return (EXIT_FAILURE);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_string (fp, 0, dxf_entity_name);
         if (view->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", view->id_code);
+                dxf_write_hex (fp, 5, view->id_code);
         }
         /*!
          * \todo for version R14.\n
@@ -466,39 +423,39 @@ dxf_view_write
         if ((strcmp (view->dictionary_owner_soft, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", view->dictionary_owner_soft);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, view->dictionary_owner_soft);
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (view->dictionary_owner_hard, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", view->dictionary_owner_hard);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, view->dictionary_owner_hard);
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbSymbolTableRecord\n");
-                fprintf (fp->fp, "100\nAcDbViewTableRecord\n");
+                dxf_write_string (fp, 100, "AcDbSymbolTableRecord");
+                dxf_write_string (fp, 100, "AcDbViewTableRecord");
         }
-        fprintf (fp->fp, "  2\n%s\n", view->view_name);
-        fprintf (fp->fp, " 40\n%f\n", view->view_height);
-        fprintf (fp->fp, " 70\n%d\n", view->flag);
-        fprintf (fp->fp, " 10\n%f\n", view->x_view);
-        fprintf (fp->fp, " 20\n%f\n", view->y_view);
-        fprintf (fp->fp, " 41\n%f\n", view->view_width);
-        fprintf (fp->fp, " 11\n%f\n", view->x_direction);
-        fprintf (fp->fp, " 21\n%f\n", view->y_direction);
-        fprintf (fp->fp, " 31\n%f\n", view->z_direction);
-        fprintf (fp->fp, " 12\n%f\n", view->x_target);
-        fprintf (fp->fp, " 22\n%f\n", view->y_target);
-        fprintf (fp->fp, " 32\n%f\n", view->z_target);
-        fprintf (fp->fp, " 42\n%f\n", view->lens_length);
-        fprintf (fp->fp, " 43\n%f\n", view->front_plane_offset);
-        fprintf (fp->fp, " 44\n%f\n", view->back_plane_offset);
-        fprintf (fp->fp, " 50\n%f\n", view->view_twist_angle);
-        fprintf (fp->fp, " 71\n%d\n", view->view_mode);
+        dxf_write_string (fp, 2, view->view_name);
+        dxf_write_double (fp, 40, view->view_height);
+        dxf_write_int (fp, 70, view->flag);
+        dxf_write_double (fp, 10, view->x_view);
+        dxf_write_double (fp, 20, view->y_view);
+        dxf_write_double (fp, 41, view->view_width);
+        dxf_write_double (fp, 11, view->x_direction);
+        dxf_write_double (fp, 21, view->y_direction);
+        dxf_write_double (fp, 31, view->z_direction);
+        dxf_write_double (fp, 12, view->x_target);
+        dxf_write_double (fp, 22, view->y_target);
+        dxf_write_double (fp, 32, view->z_target);
+        dxf_write_double (fp, 42, view->lens_length);
+        dxf_write_double (fp, 43, view->front_plane_offset);
+        dxf_write_double (fp, 44, view->back_plane_offset);
+        dxf_write_double (fp, 50, view->view_twist_angle);
+        dxf_write_int (fp, 71, view->view_mode);
         /* Clean up. */
         free (dxf_entity_name);
 #if DEBUG
@@ -568,7 +525,7 @@ dxf_view_free_chain
                  * entries. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (views == NULL)
@@ -580,6 +537,7 @@ dxf_view_free_chain
         while (views != NULL)
         {
                 struct DxfView *iter = views->next;
+                views->next = NULL;
                 dxf_view_free (views);
                 views = (DxfView *) iter;
         }
@@ -33,6 +33,9 @@
 
 
 #include "viewport.h"
+#include "arena.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -58,7 +61,7 @@ dxf_viewport_new ()
         size = sizeof (DxfViewport);
         /* avoid malloc of 0 bytes */
         if (size == 0) size = 1;
-        if ((viewport = malloc (size)) == NULL)
+        if ((viewport = dxf_malloc (size)) == NULL)
         {
                 fprintf (stderr,
                   (_("Error in %s () could not allocate memory for a DxfViewport struct.\n")),
@@ -117,24 +120,25 @@ dxf_viewport_init
                 return (NULL);
         }
         viewport->id_code = 0;
-        viewport->linetype = strdup (DXF_DEFAULT_LINETYPE);
-        viewport->layer = strdup (DXF_DEFAULT_LAYER);
+        viewport->properties = dxf_graphic_properties_default ();
+        if (dxf_graphic_properties_unshare (&viewport->properties) == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory for the properties of a DxfViewport struct.\n")),
+                  __FUNCTION__);
+                return (NULL);
+        }
+        viewport->properties->paperspace = DXF_PAPERSPACE; /* Always on PAPERSPACE. */
         viewport->x0 = 0.0;
         viewport->y0 = 0.0;
         viewport->z0 = 0.0;
-        viewport->elevation = 0.0;
-        viewport->thickness = 0.0;
-        viewport->linetype_scale = DXF_DEFAULT_LINETYPE_SCALE;
-        viewport->visibility = DXF_DEFAULT_VISIBILITY;
         viewport->width = 0.0;
         viewport->height = 0.0;
         viewport->status = 0;
         viewport->id = 1; /* Always 1. */
-        viewport->color = DXF_COLOR_BYLAYER;
-        viewport->paperspace = DXF_PAPERSPACE; /* Always on PAPERSPACE. */
-        viewport->app_name = strdup ("ACAD"); /* Always "ACAD". */
-        viewport->viewport_data = strdup ("MVIEW"); /* Always "MVIEW". */
-        viewport->window_descriptor_begin = strdup ("{"); /* Always "{". */
+        viewport->app_name = dxf_strdup ("ACAD"); /* Always "ACAD". */
+        viewport->viewport_data = dxf_strdup ("MVIEW"); /* Always "MVIEW". */
+        viewport->window_descriptor_begin = dxf_strdup ("{"); /* Always "{". */
         viewport->extended_entity_data_version = 16;
         viewport->x_target = 0.0;
         viewport->y_target = 0.0;
@@ -165,7 +169,7 @@ dxf_viewport_init
         viewport->x_grid_spacing = 0.0;
         viewport->y_grid_spacing = 0.0;
         viewport->plot_flag = 0;
-        viewport->frozen_layer_list_begin = strdup ("{"); /* Always "{". */
+        viewport->frozen_layer_list_begin = dxf_strdup ("{"); /* Always "{". */
         /*! \todo Implement the number of layers in a more efficient way.
          * A lot of memory is consumed by reserving for DXF_MAX_LAYERS
          * instead of the actual existing number of layers.
@@ -175,12 +179,12 @@ dxf_viewport_init
          * known during run time. */
         for (i = 0; i < DXF_MAX_LAYERS; i++)
         {
-                viewport->frozen_layers[i] = strdup ("");
+                viewport->frozen_layers[i] = dxf_strdup ("");
         }
-        viewport->frozen_layer_list_end = strdup ("}"); /* Always "}". */
-        viewport->window_descriptor_end = strdup ("}"); /* Always "}". */
-        viewport->dictionary_owner_soft = strdup ("");
-        viewport->dictionary_owner_hard = strdup ("");
+        viewport->frozen_layer_list_end = dxf_strdup ("}"); /* Always "}". */
+        viewport->window_descriptor_end = dxf_strdup ("}"); /* Always "}". */
+        viewport->dictionary_owner_soft = dxf_strdup ("");
+        viewport->dictionary_owner_hard = dxf_strdup ("");
         viewport->next = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -219,7 +223,9 @@ dxf_viewport_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfGraphicProperties properties;
+        DxfPair pair;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -227,8 +233,6 @@ dxf_viewport_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (viewport == NULL)
@@ -239,776 +243,684 @@ dxf_viewport_read
                 viewport = dxf_viewport_new ();
                 viewport = dxf_viewport_init (viewport);
         }
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        dxf_graphic_properties_start (&properties, viewport->properties);
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        fclose (fp->fp);
-                        /* Clean up. */
-                        free (temp_string);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &viewport->id_code);
-                }
-                else if (strcmp (temp_string, "6") == 0)
-                {
-                        /* Now follows a string containing a linetype
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", viewport->linetype);
-                }
-                else if (strcmp (temp_string, "8") == 0)
-                {
-                        /* Now follows a string containing a layer name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", viewport->layer);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X-coordinate of the center point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &viewport->x0);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y-coordinate of the center point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &viewport->y0);
-                }
-                else if (strcmp (temp_string, "30") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z-coordinate of the center point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &viewport->z0);
-                }
-                else if ((fp->acad_version_number <= AutoCAD_11)
-                        && (strcmp (temp_string, "38") == 0)
-                        && (viewport->z0 = 0.0))
-                {
-                        /* Elevation is a pre AutoCAD R11 variable
-                         * so additional testing for the version should
-                         * probably be added.
-                         * Now follows a string containing the
-                         * elevation. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &viewport->z0);
-                }
-                else if (strcmp (temp_string, "39") == 0)
-                {
-                        /* Now follows a string containing the
-                         * thickness. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &viewport->thickness);
-                }
-                else if (strcmp (temp_string, "40") == 0)
-                {
-                        /* Now follows a string containing the
-                         * width. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &viewport->width);
-                }
-                else if (strcmp (temp_string, "41") == 0)
-                {
-                        /* Now follows a string containing the
-                         * height. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &viewport->height);
-                }
-                else if (strcmp (temp_string, "48") == 0)
-                {
-                        /* Now follows a string containing the linetype
-                         * scale. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &viewport->linetype_scale);
-                }
-                else if (strcmp (temp_string, "60") == 0)
-                {
-                        /* Now follows a string containing the
-                         * visibility value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%hd\n", &viewport->visibility);
-                }
-                else if (strcmp (temp_string, "62") == 0)
+                if (pair.group_code == 0)
                 {
-                        /* Now follows a string containing the
-                         * color value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &viewport->color);
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else if (strcmp (temp_string, "67") == 0)
+                switch (pair.group_code)
                 {
-                        /* Now follows a string containing the
-                         * paperspace value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &viewport->paperspace);
-                }
-                else if (strcmp (temp_string, "68") == 0)
-                {
-                        /* Now follows a string containing the
-                         * status value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &viewport->status);
-                }
-                else if (strcmp (temp_string, "69") == 0)
-                {
-                        /* Now follows a string containing the
-                         * id. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &viewport->id);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-                else if (strcmp (temp_string, "1001") == 0)
-                {
-                        /* Now follows a sequence of ordered data fields. */
-                        /* Now follows a string containing the appname,
-                         * always "ACAD". */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", viewport->app_name);
-                        if (strcmp (viewport->app_name, "ACAD") == 1)
-                        {
-                                fprintf (stderr,
-                                  (_("Error in %s () while reading from: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                                fprintf (stderr,
-                                  (_("\tunexpected content in string followed after group code 1001.\n")));
-                                return (NULL);
-                        }
-                        /* Now follows a string containing a group code. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1000") == 1)
-                        {
-                                fprintf (stderr,
-                                  (_("Error in %s () while reading from: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                                fprintf (stderr,
-                                  (_("\tunexpected content in string sequence found.\n")));
-                                return (NULL);
-                        }
-                        /* Now follows a string containing the viewport
-                         * data, always "MVIEW". */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", viewport->viewport_data);
-                        if (strcmp (viewport->viewport_data, "MVIEW") == 1)
-                        {
-                                fprintf (stderr,
-                                  (_("Error in %s () while reading from: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                                fprintf (stderr,
-                                  (_("\tunexpected content in string.\n")));
-                                return (NULL);
-                        }
-                        /* Now follows a string containing a group code. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1002") == 1)
-                        {
-                                fprintf (stderr,
-                                  (_("Error in %s () while reading from: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                                fprintf (stderr,
-                                  (_("\tunexpected content in string sequence found.\n")));
-                                return (NULL);
-                        }
-                        /* Now follows a string containing the window
-                         * begin descriptor, always "{". */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", viewport->window_descriptor_begin);
-                        if (strcmp (viewport->window_descriptor_begin, "{") == 1)
-                        {
-                                fprintf (stderr,
-                                  (_("Error in %s () while reading from: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                                fprintf (stderr, "    unexpected content in string.\n");
-                                return (NULL);
-                        }
-                        /* Now follows a string containing a group code. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1070") == 1)
-                        {
-                                fprintf (stderr,
-                                  (_("Error in %s () while reading from: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                                fprintf (stderr,
-                                  (_("\tunexpected content in string sequence found.\n")));
-                                return (NULL);
-                        }
-                        /* Now follows a string containing the extended
-                         * entity data version number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &viewport->extended_entity_data_version);
-                        /* Now follows a string containing a group code. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1010") == 1)
-                        {
-                                fprintf (stderr,
-                                  (_("Error in %s () while reading from: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                                fprintf (stderr,
-                                  (_("\tunexpected content in string sequence found.\n")));
-                                return (NULL);
-                        }
-                        /* Now follows a string containing the X-target. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &viewport->x_target);
-                        /* Now follows a string containing a group code. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1020") == 1)
-                        {
-                                fprintf (stderr,
-                                  (_("Error in %s () while reading from: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                                fprintf (stderr,
-                                  (_("\tunexpected content in string sequence found.\n")));
-                                return (NULL);
-                        }
-                        /* Now follows a string containing the Y-target. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &viewport->y_target);
-                        /* Now follows a string containing a group code. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1030") == 1)
-                        {
-                                fprintf (stderr,
-                                  (_("Error in %s () while reading from: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                                fprintf (stderr,
-                                  (_("\tunexpected content in string sequence found.\n")));
-                                return (NULL);
-                        }
-                        /* Now follows a string containing the Z-target. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &viewport->z_target);
-                        /* Now follows a string containing a group code. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1010") == 1)
-                        {
-                                fprintf (stderr,
-                                  (_("Error in %s () while reading from: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                                fprintf (stderr,
-                                  (_("\tunexpected content in string sequence found.\n")));
-                                return (NULL);
-                        }
-                        /* Now follows a string containing the X-direction. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &viewport->x_direction);
-                        /* Now follows a string containing a group code. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1020") == 1)
-                        {
-                                fprintf (stderr,
-                                  (_("Error in %s () while reading from: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                                fprintf (stderr,
-                                  (_("\tunexpected content in string sequence found.\n")));
-                                return (NULL);
-                        }
-                        /* Now follows a string containing the Y-direction. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &viewport->y_direction);
-                        /* Now follows a string containing a group code. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1030") == 1)
-                        {
-                                fprintf (stderr,
-                                  (_("Error in %s () while reading from: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                                fprintf (stderr,
-                                  (_("\tunexpected content in string sequence found.\n")));
-                                return (NULL);
-                        }
-                        /* Now follows a string containing the Z-direction. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &viewport->z_direction);
-                        /* Now follows a string containing a group code. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1040") == 1)
-                        {
-                                fprintf (stderr,
-                                  (_("Error in %s () while reading from: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                                fprintf (stderr,
-                                  (_("\tunexpected content in string sequence found.\n")));
-                                return (NULL);
-                        }
-                        /* Now follows a string containing the view
-                         * twist angle. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &viewport->view_twist_angle);
-                        /* Now follows a string containing a group code. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1040") == 1)
-                        {
-                                fprintf (stderr,
-                                  (_("Error in %s () while reading from: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                                fprintf (stderr,
-                                  (_("\tunexpected content in string sequence found.\n")));
-                                return (NULL);
-                        }
-                        /* Now follows a string containing the view
-                         * height. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &viewport->view_height);
-                        /* Now follows a string containing a group code. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1040") == 1)
-                        {
-                                fprintf (stderr,
-                                  (_("Error in %s () while reading from: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                                fprintf (stderr,
-                                  (_("\tunexpected content in string sequence found.\n")));
-                                return (NULL);
-                        }
-                        /* Now follows a string containing the
-                         * X-coordinate of the view center point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &viewport->x_center);
-                        /* Now follows a string containing a group code. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1040") == 1)
-                        {
-                                fprintf (stderr,
-                                  (_("Error in %s () while reading from: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                                fprintf (stderr,
-                                  (_("\tunexpected content in string sequence found.\n")));
-                                return (NULL);
-                        }
-                        /* Now follows a string containing the
-                         * Y-coordinate of the view center point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &viewport->y_center);
-                        /* Now follows a string containing a group code. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1040") == 1)
-                        {
-                                fprintf (stderr,
-                                  (_("Error in %s () while reading from: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                                fprintf (stderr,
-                                  (_("\tunexpected content in string sequence found.\n")));
-                                return (NULL);
-                        }
-                        /* Now follows a string containing the
-                         * perspective lens length. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &viewport->perspective_lens_length);
-                        /* Now follows a string containing a group code. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1040") == 1)
-                        {
-                                fprintf (stderr,
-                                  (_("Error in %s () while reading from: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                                fprintf (stderr,
-                                  (_("\tunexpected content in string sequence found.\n")));
-                                return (NULL);
-                        }
-                        /* Now follows a string containing the front
-                         * clipping plane offset. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &viewport->front_plane_offset);
-                        /* Now follows a string containing a group code. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1040") == 1)
-                        {
-                                fprintf (stderr,
-                                  (_("Error in %s () while reading from: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                                fprintf (stderr,
-                                  (_("\tunexpected content in string sequence found.\n")));
-                                return (NULL);
-                        }
-                        /* Now follows a string containing the back
-                         * clipping plane offset. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &viewport->back_plane_offset);
-                        /* Now follows a string containing a group code. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1070") == 1)
-                        {
-                                fprintf (stderr,
-                                  (_("Error in %s () while reading from: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                                fprintf (stderr,
-                                  (_("\tunexpected content in string sequence found.\n")));
-                                return (NULL);
-                        }
-                        /* Now follows a string containing the view mode. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &viewport->view_mode);
-                        /* Now follows a string containing a group code. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1070") == 1)
-                        {
-                                fprintf (stderr,
-                                  (_("Error in %s () while reading from: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                                fprintf (stderr,
-                                  (_("\tunexpected content in string sequence found.\n")));
-                                return (NULL);
-                        }
-                        /* Now follows a string containing the circle
-                         * zoom percent. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &viewport->circle_zoom_percent);
-                        /* Now follows a string containing a group code. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1070") == 1)
-                        {
-                                fprintf (stderr,
-                                  (_("Error in %s () while reading from: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                                fprintf (stderr,
-                                  (_("\tunexpected content in string sequence found.\n")));
-                                return (NULL);
-                        }
-                        /* Now follows a string containing the fast zoom
-                         * setting. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &viewport->fast_zoom_setting);
-                        /* Now follows a string containing a group code. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1070") == 1)
-                        {
-                                fprintf (stderr,
-                                  (_("Error in %s () while reading from: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                                fprintf (stderr,
-                                  (_("\tunexpected content in string sequence found.\n")));
-                                return (NULL);
-                        }
-                        /* Now follows a string containing the ICS ICON
-                         * setting. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &viewport->UCSICON_setting);
-                        /* Now follows a string containing a group code. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1070") == 1)
-                        {
-                                fprintf (stderr,
-                                  (_("Error in %s () while reading from: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                                fprintf (stderr,
-                                  (_("\tunexpected content in string sequence found.\n")));
-                                return (NULL);
-                        }
-                        /* Now follows a string containing the snap on
-                         * setting. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &viewport->snap_on);
-                        /* Now follows a string containing a group code. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1070") == 1)
-                        {
-                                fprintf (stderr,
-                                  (_("Error in %s () while reading from: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                                fprintf (stderr,
-                                  (_("\tunexpected content in string sequence found.\n")));
-                                return (NULL);
-                        }
-                        /* Now follows a string containing the grid on
-                         * setting. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &viewport->grid_on);
-                        /* Now follows a string containing a group code. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1070") == 1)
-                        {
-                                fprintf (stderr,
-                                  (_("Error in %s () while reading from: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                                fprintf (stderr,
-                                  (_("\tunexpected content in string sequence found.\n")));
-                                return (NULL);
-                        }
-                        /* Now follows a string containing the snap
-                         * style setting. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &viewport->snap_style);
-                        /* Now follows a string containing a group code. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1070") == 1)
-                        {
-                                fprintf (stderr,
-                                  (_("Error in %s () while reading from: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                                fprintf (stderr,
-                                  (_("\tunexpected content in string sequence found.\n")));
-                                return (NULL);
-                        }
-                        /* Now follows a string containing the snap
-                         * isopair setting. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &viewport->snap_isopair);
-                        /* Now follows a string containing a group code. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1040") == 1)
-                        {
-                                fprintf (stderr,
-                                  (_("Error in %s () while reading from: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                                fprintf (stderr,
-                                  (_("\tunexpected content in string sequence found.\n")));
-                                return (NULL);
-                        }
-                        /* Now follows a string containing the snap
-                         * rotation angle. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &viewport->snap_rotation_angle);
-                        /* Now follows a string containing a group code. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1040") == 1)
-                        {
-                                fprintf (stderr,
-                                  (_("Error in %s () while reading from: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                                fprintf (stderr,
-                                  (_("\tunexpected content in string sequence found.\n")));
-                                return (NULL);
-                        }
-                        /* Now follows a string containing the X snap
-                         * base. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &viewport->x_snap_base);
-                        /* Now follows a string containing a group code. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1040") == 1)
-                        {
-                                fprintf (stderr,
-                                  (_("Error in %s () while reading from: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                                fprintf (stderr,
-                                  (_("\tunexpected content in string sequence found.\n")));
-                                return (NULL);
-                        }
-                        /* Now follows a string containing the Y snap
-                         * base. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &viewport->y_snap_base);
-                        /* Now follows a string containing a group code. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1040") == 1)
-                        {
-                                fprintf (stderr,
-                                  (_("Error in %s () while reading from: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                                fprintf (stderr,
-                                  (_("\tunexpected content in string sequence found.\n")));
-                                return (NULL);
-                        }
-                        /* Now follows a string containing the X snap
-                         * spacing. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &viewport->x_snap_spacing);
-                        /* Now follows a string containing a group code. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1040") == 1)
-                        {
-                                fprintf (stderr,
-                                  (_("Error in %s () while reading from: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                                fprintf (stderr,
-                                  (_("\tunexpected content in string sequence found.\n")));
-                                return (NULL);
-                        }
-                        /* Now follows a string containing the Y snap
-                         * spacing. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &viewport->y_snap_spacing);
-                        /* Now follows a string containing a group code. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1070") == 1)
-                        {
-                                fprintf (stderr,
-                                  (_("Error in %s () while reading from: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                                fprintf (stderr,
-                                  (_("\tunexpected content in string sequence found.\n")));
-                                return (NULL);
-                        }
-                        /* Now follows a string containing the plot flag. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &viewport->plot_flag);
-                        /* Now follows a string containing a group code. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1002") == 1)
-                        {
-                                fprintf (stderr,
-                                  (_("Error in %s () while reading from: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                                fprintf (stderr,
-                                  (_("\tunexpected content in string sequence found.\n")));
-                                return (NULL);
-                        }
-                        /* Now follows a string containing the frozen
-                         * layer list begin descriptor, always "{". */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", viewport->frozen_layer_list_begin);
-                        if (strcmp (viewport->frozen_layer_list_begin, "{") == 1)
-                        {
-                                fprintf (stderr,
-                                  (_("Error in %s () while reading from: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                                fprintf (stderr,
-                                  (_("\tunexpected content in string.\n")));
-                                return (NULL);
-                        }
-                        /* Now follows a string containing a group code
-                         * value of "1003". */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1003") == 0)
-                        {
-                                /* Start a loop reading all frozen layer
-                                 * names and bail out when a group code
-                                 * with a value of "1002" is encountered
-                                 * or DXF_MAX_LAYERS is reached.*/
-                                int j = 0;
-                                do
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                viewport->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 6:
+                                /* Now follows a string containing a linetype
+                                 * name. */
+                                dxf_lexer_free_string (fp, properties.linetype);
+                                properties.linetype = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 8:
+                                /* Now follows a string containing a layer name. */
+                                dxf_lexer_free_string (fp, properties.layer);
+                                properties.layer = dxf_pair_intern_string (fp, &pair);
+                                break;
+                        case 10:
+                                /* Now follows a string containing the
+                                 * X-coordinate of the center point. */
+                                viewport->x0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 20:
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the center point. */
+                                viewport->y0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 30:
+                                /* Now follows a string containing the
+                                 * Z-coordinate of the center point. */
+                                viewport->z0 = dxf_pair_get_double (&pair);
+                                break;
+                        case 38:
+                                if ((fp->acad_version_number <= AutoCAD_11)
+                                  && (viewport->z0 = 0.0))
                                 {
-                                        (fp->line_number)++;
-                                        fscanf (fp->fp, "%s\n", viewport->frozen_layers[j]);
-                                        j++;
-                                        /* Now follows a string containing a group code. */
-                                        (fp->line_number)++;
-                                        fscanf (fp->fp, "%s\n", temp_string);
+                                        /* Elevation is a pre AutoCAD R11 variable
+                                         * so additional testing for the version should
+                                         * probably be added.
+                                         * Now follows a string containing the
+                                         * elevation. */
+                                        viewport->z0 = dxf_pair_get_double (&pair);
                                 }
-                                while ((strcmp (temp_string, "1003") == 0)
-                                        || (j < DXF_MAX_LAYERS));
-                        }
-                        else
-                        {
-                                /* Either we found an empty list or we
-                                 * have found an exception. */
-                                fprintf (stderr,
-                                  (_("Error in %s () while reading from: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                                fprintf (stderr,
-                                  (_("\tunexpected end of frozen layer list found.\n")));
-                                return (NULL);
-                        }
-                        /* Now we are expecting temp_string to contain a
-                         * group code value of "1002". */
-                        if (strcmp (temp_string, "1002") == 1)
-                        {
-                                fprintf (stderr,
-                                  (_("Error in %s () while reading from: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                                fprintf (stderr,
-                                  (_("\tunexpected content in string sequence found.\n")));
-                                return (NULL);
-                        }
-                        /* Now follows a string containing the frozen
-                         * layer list end descriptor, always "}". */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", viewport->frozen_layer_list_end);
-                        if (strcmp (viewport->frozen_layer_list_end, "}") == 1)
-                        {
-                                fprintf (stderr,
-                                  (_("Error in %s () while reading from: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                                fprintf (stderr,
-                                  (_("\tunexpected content in string.\n")));
-                                return (NULL);
-                        }
-                        /* Now follows a string containing a group code. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "1002") == 1)
-                        {
-                                fprintf (stderr,
-                                  (_("Error in %s () while reading from: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                                fprintf (stderr,
-                                  (_("\tunexpected content in string sequence found.\n")));
-                                return (NULL);
-                        }
-                        /* Now follows a string containing the window
-                         * end descriptor, always "}". */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", viewport->window_descriptor_end);
-                        if (strcmp (viewport->window_descriptor_end, "}") == 1)
-                        {
+                                break;
+                        case 39:
+                                /* Now follows a string containing the
+                                 * thickness. */
+                                properties.thickness = dxf_pair_get_double (&pair);
+                                break;
+                        case 40:
+                                /* Now follows a string containing the
+                                 * width. */
+                                viewport->width = dxf_pair_get_double (&pair);
+                                break;
+                        case 41:
+                                /* Now follows a string containing the
+                                 * height. */
+                                viewport->height = dxf_pair_get_double (&pair);
+                                break;
+                        case 48:
+                                /* Now follows a string containing the linetype
+                                 * scale. */
+                                properties.linetype_scale = dxf_pair_get_double (&pair);
+                                break;
+                        case 60:
+                                /* Now follows a string containing the
+                                 * visibility value. */
+                                properties.visibility = dxf_pair_get_int (&pair);
+                                break;
+                        case 62:
+                                /* Now follows a string containing the
+                                 * color value. */
+                                properties.color = dxf_pair_get_int (&pair);
+                                break;
+                        case 67:
+                                /* Now follows a string containing the
+                                 * paperspace value. */
+                                properties.paperspace = dxf_pair_get_int (&pair);
+                                break;
+                        case 68:
+                                /* Now follows a string containing the
+                                 * status value. */
+                                viewport->status = dxf_pair_get_int (&pair);
+                                break;
+                        case 69:
+                                /* Now follows a string containing the
+                                 * id. */
+                                viewport->id = dxf_pair_get_int (&pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, "DXF comment: %s\n", temp_string);
+                                break;
+                        case 1001:
+                                /* Now follows a sequence of ordered data fields. */
+                                /* Now follows a string containing the appname,
+                                 * always "ACAD". */
+                                dxf_free (viewport->app_name);
+                                viewport->app_name = dxf_pair_get_string (&pair);
+                                if (strcmp (viewport->app_name, "ACAD") == 1)
+                                {
+                                        fprintf (stderr,
+                                          (_("Error in %s () while reading from: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                        fprintf (stderr,
+                                          (_("\tunexpected content in string followed after group code 1001.\n")));
+                                        return (NULL);
+                                }
+                                /* Now follows a string containing a group code. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                if (strcmp (temp_string, "1000") == 1)
+                                {
+                                        fprintf (stderr,
+                                          (_("Error in %s () while reading from: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                        fprintf (stderr,
+                                          (_("\tunexpected content in string sequence found.\n")));
+                                        return (NULL);
+                                }
+                                /* Now follows a string containing the viewport
+                                 * data, always "MVIEW". */
+                                dxf_free (viewport->viewport_data);
+                                viewport->viewport_data = dxf_pair_get_string (&pair);
+                                if (strcmp (viewport->viewport_data, "MVIEW") == 1)
+                                {
+                                        fprintf (stderr,
+                                          (_("Error in %s () while reading from: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                        fprintf (stderr,
+                                          (_("\tunexpected content in string.\n")));
+                                        return (NULL);
+                                }
+                                /* Now follows a string containing a group code. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                if (strcmp (temp_string, "1002") == 1)
+                                {
+                                        fprintf (stderr,
+                                          (_("Error in %s () while reading from: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                        fprintf (stderr,
+                                          (_("\tunexpected content in string sequence found.\n")));
+                                        return (NULL);
+                                }
+                                /* Now follows a string containing the window
+                                 * begin descriptor, always "{". */
+                                dxf_free (viewport->window_descriptor_begin);
+                                viewport->window_descriptor_begin = dxf_pair_get_string (&pair);
+                                if (strcmp (viewport->window_descriptor_begin, "{") == 1)
+                                {
+                                        fprintf (stderr,
+                                          (_("Error in %s () while reading from: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                        fprintf (stderr, "    unexpected content in string.\n");
+                                        return (NULL);
+                                }
+                                /* Now follows a string containing a group code. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                if (strcmp (temp_string, "1070") == 1)
+                                {
+                                        fprintf (stderr,
+                                          (_("Error in %s () while reading from: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                        fprintf (stderr,
+                                          (_("\tunexpected content in string sequence found.\n")));
+                                        return (NULL);
+                                }
+                                /* Now follows a string containing the extended
+                                 * entity data version number. */
+                                viewport->extended_entity_data_version = dxf_pair_get_int (&pair);
+                                /* Now follows a string containing a group code. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                if (strcmp (temp_string, "1010") == 1)
+                                {
+                                        fprintf (stderr,
+                                          (_("Error in %s () while reading from: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                        fprintf (stderr,
+                                          (_("\tunexpected content in string sequence found.\n")));
+                                        return (NULL);
+                                }
+                                /* Now follows a string containing the X-target. */
+                                viewport->x_target = dxf_pair_get_double (&pair);
+                                /* Now follows a string containing a group code. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                if (strcmp (temp_string, "1020") == 1)
+                                {
+                                        fprintf (stderr,
+                                          (_("Error in %s () while reading from: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                        fprintf (stderr,
+                                          (_("\tunexpected content in string sequence found.\n")));
+                                        return (NULL);
+                                }
+                                /* Now follows a string containing the Y-target. */
+                                viewport->y_target = dxf_pair_get_double (&pair);
+                                /* Now follows a string containing a group code. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                if (strcmp (temp_string, "1030") == 1)
+                                {
+                                        fprintf (stderr,
+                                          (_("Error in %s () while reading from: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                        fprintf (stderr,
+                                          (_("\tunexpected content in string sequence found.\n")));
+                                        return (NULL);
+                                }
+                                /* Now follows a string containing the Z-target. */
+                                viewport->z_target = dxf_pair_get_double (&pair);
+                                /* Now follows a string containing a group code. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                if (strcmp (temp_string, "1010") == 1)
+                                {
+                                        fprintf (stderr,
+                                          (_("Error in %s () while reading from: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                        fprintf (stderr,
+                                          (_("\tunexpected content in string sequence found.\n")));
+                                        return (NULL);
+                                }
+                                /* Now follows a string containing the X-direction. */
+                                viewport->x_direction = dxf_pair_get_double (&pair);
+                                /* Now follows a string containing a group code. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                if (strcmp (temp_string, "1020") == 1)
+                                {
+                                        fprintf (stderr,
+                                          (_("Error in %s () while reading from: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                        fprintf (stderr,
+                                          (_("\tunexpected content in string sequence found.\n")));
+                                        return (NULL);
+                                }
+                                /* Now follows a string containing the Y-direction. */
+                                viewport->y_direction = dxf_pair_get_double (&pair);
+                                /* Now follows a string containing a group code. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                if (strcmp (temp_string, "1030") == 1)
+                                {
+                                        fprintf (stderr,
+                                          (_("Error in %s () while reading from: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                        fprintf (stderr,
+                                          (_("\tunexpected content in string sequence found.\n")));
+                                        return (NULL);
+                                }
+                                /* Now follows a string containing the Z-direction. */
+                                viewport->z_direction = dxf_pair_get_double (&pair);
+                                /* Now follows a string containing a group code. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                if (strcmp (temp_string, "1040") == 1)
+                                {
+                                        fprintf (stderr,
+                                          (_("Error in %s () while reading from: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                        fprintf (stderr,
+                                          (_("\tunexpected content in string sequence found.\n")));
+                                        return (NULL);
+                                }
+                                /* Now follows a string containing the view
+                                 * twist angle. */
+                                viewport->view_twist_angle = dxf_pair_get_double (&pair);
+                                /* Now follows a string containing a group code. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                if (strcmp (temp_string, "1040") == 1)
+                                {
+                                        fprintf (stderr,
+                                          (_("Error in %s () while reading from: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                        fprintf (stderr,
+                                          (_("\tunexpected content in string sequence found.\n")));
+                                        return (NULL);
+                                }
+                                /* Now follows a string containing the view
+                                 * height. */
+                                viewport->view_height = dxf_pair_get_double (&pair);
+                                /* Now follows a string containing a group code. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                if (strcmp (temp_string, "1040") == 1)
+                                {
+                                        fprintf (stderr,
+                                          (_("Error in %s () while reading from: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                        fprintf (stderr,
+                                          (_("\tunexpected content in string sequence found.\n")));
+                                        return (NULL);
+                                }
+                                /* Now follows a string containing the
+                                 * X-coordinate of the view center point. */
+                                viewport->x_center = dxf_pair_get_double (&pair);
+                                /* Now follows a string containing a group code. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                if (strcmp (temp_string, "1040") == 1)
+                                {
+                                        fprintf (stderr,
+                                          (_("Error in %s () while reading from: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                        fprintf (stderr,
+                                          (_("\tunexpected content in string sequence found.\n")));
+                                        return (NULL);
+                                }
+                                /* Now follows a string containing the
+                                 * Y-coordinate of the view center point. */
+                                viewport->y_center = dxf_pair_get_double (&pair);
+                                /* Now follows a string containing a group code. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                if (strcmp (temp_string, "1040") == 1)
+                                {
+                                        fprintf (stderr,
+                                          (_("Error in %s () while reading from: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                        fprintf (stderr,
+                                          (_("\tunexpected content in string sequence found.\n")));
+                                        return (NULL);
+                                }
+                                /* Now follows a string containing the
+                                 * perspective lens length. */
+                                viewport->perspective_lens_length = dxf_pair_get_double (&pair);
+                                /* Now follows a string containing a group code. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                if (strcmp (temp_string, "1040") == 1)
+                                {
+                                        fprintf (stderr,
+                                          (_("Error in %s () while reading from: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                        fprintf (stderr,
+                                          (_("\tunexpected content in string sequence found.\n")));
+                                        return (NULL);
+                                }
+                                /* Now follows a string containing the front
+                                 * clipping plane offset. */
+                                viewport->front_plane_offset = dxf_pair_get_double (&pair);
+                                /* Now follows a string containing a group code. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                if (strcmp (temp_string, "1040") == 1)
+                                {
+                                        fprintf (stderr,
+                                          (_("Error in %s () while reading from: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                        fprintf (stderr,
+                                          (_("\tunexpected content in string sequence found.\n")));
+                                        return (NULL);
+                                }
+                                /* Now follows a string containing the back
+                                 * clipping plane offset. */
+                                viewport->back_plane_offset = dxf_pair_get_double (&pair);
+                                /* Now follows a string containing a group code. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                if (strcmp (temp_string, "1070") == 1)
+                                {
+                                        fprintf (stderr,
+                                          (_("Error in %s () while reading from: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                        fprintf (stderr,
+                                          (_("\tunexpected content in string sequence found.\n")));
+                                        return (NULL);
+                                }
+                                /* Now follows a string containing the view mode. */
+                                viewport->view_mode = dxf_pair_get_int (&pair);
+                                /* Now follows a string containing a group code. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                if (strcmp (temp_string, "1070") == 1)
+                                {
+                                        fprintf (stderr,
+                                          (_("Error in %s () while reading from: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                        fprintf (stderr,
+                                          (_("\tunexpected content in string sequence found.\n")));
+                                        return (NULL);
+                                }
+                                /* Now follows a string containing the circle
+                                 * zoom percent. */
+                                viewport->circle_zoom_percent = dxf_pair_get_int (&pair);
+                                /* Now follows a string containing a group code. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                if (strcmp (temp_string, "1070") == 1)
+                                {
+                                        fprintf (stderr,
+                                          (_("Error in %s () while reading from: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                        fprintf (stderr,
+                                          (_("\tunexpected content in string sequence found.\n")));
+                                        return (NULL);
+                                }
+                                /* Now follows a string containing the fast zoom
+                                 * setting. */
+                                viewport->fast_zoom_setting = dxf_pair_get_int (&pair);
+                                /* Now follows a string containing a group code. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                if (strcmp (temp_string, "1070") == 1)
+                                {
+                                        fprintf (stderr,
+                                          (_("Error in %s () while reading from: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                        fprintf (stderr,
+                                          (_("\tunexpected content in string sequence found.\n")));
+                                        return (NULL);
+                                }
+                                /* Now follows a string containing the ICS ICON
+                                 * setting. */
+                                viewport->UCSICON_setting = dxf_pair_get_int (&pair);
+                                /* Now follows a string containing a group code. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                if (strcmp (temp_string, "1070") == 1)
+                                {
+                                        fprintf (stderr,
+                                          (_("Error in %s () while reading from: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                        fprintf (stderr,
+                                          (_("\tunexpected content in string sequence found.\n")));
+                                        return (NULL);
+                                }
+                                /* Now follows a string containing the snap on
+                                 * setting. */
+                                viewport->snap_on = dxf_pair_get_int (&pair);
+                                /* Now follows a string containing a group code. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                if (strcmp (temp_string, "1070") == 1)
+                                {
+                                        fprintf (stderr,
+                                          (_("Error in %s () while reading from: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                        fprintf (stderr,
+                                          (_("\tunexpected content in string sequence found.\n")));
+                                        return (NULL);
+                                }
+                                /* Now follows a string containing the grid on
+                                 * setting. */
+                                viewport->grid_on = dxf_pair_get_int (&pair);
+                                /* Now follows a string containing a group code. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                if (strcmp (temp_string, "1070") == 1)
+                                {
+                                        fprintf (stderr,
+                                          (_("Error in %s () while reading from: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                        fprintf (stderr,
+                                          (_("\tunexpected content in string sequence found.\n")));
+                                        return (NULL);
+                                }
+                                /* Now follows a string containing the snap
+                                 * style setting. */
+                                viewport->snap_style = dxf_pair_get_int (&pair);
+                                /* Now follows a string containing a group code. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                if (strcmp (temp_string, "1070") == 1)
+                                {
+                                        fprintf (stderr,
+                                          (_("Error in %s () while reading from: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                        fprintf (stderr,
+                                          (_("\tunexpected content in string sequence found.\n")));
+                                        return (NULL);
+                                }
+                                /* Now follows a string containing the snap
+                                 * isopair setting. */
+                                viewport->snap_isopair = dxf_pair_get_int (&pair);
+                                /* Now follows a string containing a group code. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                if (strcmp (temp_string, "1040") == 1)
+                                {
+                                        fprintf (stderr,
+                                          (_("Error in %s () while reading from: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                        fprintf (stderr,
+                                          (_("\tunexpected content in string sequence found.\n")));
+                                        return (NULL);
+                                }
+                                /* Now follows a string containing the snap
+                                 * rotation angle. */
+                                viewport->snap_rotation_angle = dxf_pair_get_double (&pair);
+                                /* Now follows a string containing a group code. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                if (strcmp (temp_string, "1040") == 1)
+                                {
+                                        fprintf (stderr,
+                                          (_("Error in %s () while reading from: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                        fprintf (stderr,
+                                          (_("\tunexpected content in string sequence found.\n")));
+                                        return (NULL);
+                                }
+                                /* Now follows a string containing the X snap
+                                 * base. */
+                                viewport->x_snap_base = dxf_pair_get_double (&pair);
+                                /* Now follows a string containing a group code. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                if (strcmp (temp_string, "1040") == 1)
+                                {
+                                        fprintf (stderr,
+                                          (_("Error in %s () while reading from: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                        fprintf (stderr,
+                                          (_("\tunexpected content in string sequence found.\n")));
+                                        return (NULL);
+                                }
+                                /* Now follows a string containing the Y snap
+                                 * base. */
+                                viewport->y_snap_base = dxf_pair_get_double (&pair);
+                                /* Now follows a string containing a group code. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                if (strcmp (temp_string, "1040") == 1)
+                                {
+                                        fprintf (stderr,
+                                          (_("Error in %s () while reading from: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                        fprintf (stderr,
+                                          (_("\tunexpected content in string sequence found.\n")));
+                                        return (NULL);
+                                }
+                                /* Now follows a string containing the X snap
+                                 * spacing. */
+                                viewport->x_snap_spacing = dxf_pair_get_double (&pair);
+                                /* Now follows a string containing a group code. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                if (strcmp (temp_string, "1040") == 1)
+                                {
+                                        fprintf (stderr,
+                                          (_("Error in %s () while reading from: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                        fprintf (stderr,
+                                          (_("\tunexpected content in string sequence found.\n")));
+                                        return (NULL);
+                                }
+                                /* Now follows a string containing the Y snap
+                                 * spacing. */
+                                viewport->y_snap_spacing = dxf_pair_get_double (&pair);
+                                /* Now follows a string containing a group code. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                if (strcmp (temp_string, "1070") == 1)
+                                {
+                                        fprintf (stderr,
+                                          (_("Error in %s () while reading from: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                        fprintf (stderr,
+                                          (_("\tunexpected content in string sequence found.\n")));
+                                        return (NULL);
+                                }
+                                /* Now follows a string containing the plot flag. */
+                                viewport->plot_flag = dxf_pair_get_int (&pair);
+                                /* Now follows a string containing a group code. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                if (strcmp (temp_string, "1002") == 1)
+                                {
+                                        fprintf (stderr,
+                                          (_("Error in %s () while reading from: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                        fprintf (stderr,
+                                          (_("\tunexpected content in string sequence found.\n")));
+                                        return (NULL);
+                                }
+                                /* Now follows a string containing the frozen
+                                 * layer list begin descriptor, always "{". */
+                                dxf_free (viewport->frozen_layer_list_begin);
+                                viewport->frozen_layer_list_begin = dxf_pair_get_string (&pair);
+                                if (strcmp (viewport->frozen_layer_list_begin, "{") == 1)
+                                {
+                                        fprintf (stderr,
+                                          (_("Error in %s () while reading from: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                        fprintf (stderr,
+                                          (_("\tunexpected content in string.\n")));
+                                        return (NULL);
+                                }
+                                /* Now follows a string containing a group code
+                                 * value of "1003". */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                if (strcmp (temp_string, "1003") == 0)
+                                {
+                                        /* Start a loop reading all frozen layer
+                                         * names and bail out when a group code
+                                         * with a value of "1002" is encountered
+                                         * or DXF_MAX_LAYERS is reached.*/
+                                        int j = 0;
+                                        do
+                                        {
+                                                dxf_free (viewport->frozen_layers[j]);
+                                                viewport->frozen_layers[j] = dxf_pair_get_string (&pair);
+                                                j++;
+                                                /* Now follows a string containing a group code. */
+                                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                        }
+                                        while ((strcmp (temp_string, "1003") == 0)
+                                                || (j < DXF_MAX_LAYERS));
+                                }
+                                else
+                                {
+                                        /* Either we found an empty list or we
+                                         * have found an exception. */
+                                        fprintf (stderr,
+                                          (_("Error in %s () while reading from: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                        fprintf (stderr,
+                                          (_("\tunexpected end of frozen layer list found.\n")));
+                                        return (NULL);
+                                }
+                                /* Now we are expecting temp_string to contain a
+                                 * group code value of "1002". */
+                                if (strcmp (temp_string, "1002") == 1)
+                                {
+                                        fprintf (stderr,
+                                          (_("Error in %s () while reading from: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                        fprintf (stderr,
+                                          (_("\tunexpected content in string sequence found.\n")));
+                                        return (NULL);
+                                }
+                                /* Now follows a string containing the frozen
+                                 * layer list end descriptor, always "}". */
+                                dxf_free (viewport->frozen_layer_list_end);
+                                viewport->frozen_layer_list_end = dxf_pair_get_string (&pair);
+                                if (strcmp (viewport->frozen_layer_list_end, "}") == 1)
+                                {
+                                        fprintf (stderr,
+                                          (_("Error in %s () while reading from: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                        fprintf (stderr,
+                                          (_("\tunexpected content in string.\n")));
+                                        return (NULL);
+                                }
+                                /* Now follows a string containing a group code. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                if (strcmp (temp_string, "1002") == 1)
+                                {
+                                        fprintf (stderr,
+                                          (_("Error in %s () while reading from: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                        fprintf (stderr,
+                                          (_("\tunexpected content in string sequence found.\n")));
+                                        return (NULL);
+                                }
+                                /* Now follows a string containing the window
+                                 * end descriptor, always "}". */
+                                dxf_free (viewport->window_descriptor_end);
+                                viewport->window_descriptor_end = dxf_pair_get_string (&pair);
+                                if (strcmp (viewport->window_descriptor_end, "}") == 1)
+                                {
+                                        fprintf (stderr,
+                                          (_("Error in %s () while reading from: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                        fprintf (stderr,
+                                          (_("\tunexpected content in string.\n")));
+                                        return (NULL);
+                                }
+                                break;
+                        default:
                                 fprintf (stderr,
-                                  (_("Error in %s () while reading from: %s in line: %d.\n")),
+                                  (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
                                   __FUNCTION__, fp->filename, fp->line_number);
-                                fprintf (stderr,
-                                  (_("\tunexpected content in string.\n")));
-                                return (NULL);
-                        }
-                }
-                /* End of sequential ordered data fields. */
-                else 
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                                break;
                 }
         }
         /* Handle omitted members and/or illegal values. */
-        if (strcmp (viewport->linetype, "") == 0)
+        if ((properties.linetype != NULL)
+          && (strcmp (properties.linetype, "") == 0))
         {
-                viewport->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                dxf_lexer_free_string (fp, properties.linetype);
+                properties.linetype = dxf_strdup (DXF_DEFAULT_LINETYPE);
         }
-        if (strcmp (viewport->layer, "") == 0)
+        if ((properties.layer != NULL)
+          && (strcmp (properties.layer, "") == 0))
         {
-                viewport->layer = strdup (DXF_DEFAULT_LAYER);
+                dxf_lexer_free_string (fp, properties.layer);
+                properties.layer = dxf_strdup (DXF_DEFAULT_LAYER);
         }
-        /* Clean up. */
-        free (temp_string);
+        /* Entities with equal properties share a record. */
+        dxf_graphic_properties_finish (fp, &viewport->properties, &properties);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1040,7 +952,7 @@ dxf_viewport_write
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *dxf_entity_name = strdup ("VIEWPORT");
+        char *dxf_entity_name = dxf_strdup ("VIEWPORT");
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -1049,7 +961,7 @@ dxf_viewport_write
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
         if (viewport == NULL)
@@ -1058,34 +970,42 @@ dxf_viewport_write
                   (_("Error in %s () a NULL pointer was passed.\n")),
                   __FUNCTION__);
                 /* Clean up. */
-                free (dxf_entity_name);
+                dxf_free (dxf_entity_name);
                 return (EXIT_FAILURE);
         }
-        if (strcmp (viewport->linetype, "") == 0)
+        if (strcmp (viewport->properties->linetype, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %x\n")),
+                  (_("Warning in %s () empty linetype string for the %s entity with id-code: %lx\n")),
                   __FUNCTION__, dxf_entity_name, viewport->id_code);
                 fprintf (stderr,
                   (_("\t%s entity is reset to default linetype")),
                   dxf_entity_name);
-                viewport->linetype = strdup (DXF_DEFAULT_LINETYPE);
+                if (dxf_graphic_properties_unshare (&viewport->properties) != NULL)
+                {
+                        dxf_free (viewport->properties->linetype);
+                        viewport->properties->linetype = dxf_strdup (DXF_DEFAULT_LINETYPE);
+                }
         }
-        if (strcmp (viewport->layer, "") == 0)
+        if (strcmp (viewport->properties->layer, "") == 0)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () empty layer string for the %s entity with id-code: %x.\n")),
+                  (_("Warning in %s () empty layer string for the %s entity with id-code: %lx.\n")),
                   __FUNCTION__, dxf_entity_name, viewport->id_code);
                 fprintf (stderr,
                   (_("\t%s entity is relocated to default layer.\n")),
                   dxf_entity_name);
-                viewport->layer = strdup (DXF_DEFAULT_LAYER);
+                if (dxf_graphic_properties_unshare (&viewport->properties) != NULL)
+                {
+                        dxf_free (viewport->properties->layer);
+                        viewport->properties->layer = dxf_strdup (DXF_DEFAULT_LAYER);
+                }
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_string (fp, 0, dxf_entity_name);
         if (viewport->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", viewport->id_code);
+                dxf_write_hex (fp, 5, viewport->id_code);
         }
         /*!
          * \todo for version R14.\n
@@ -1100,110 +1020,110 @@ dxf_viewport_write
         if ((strcmp (viewport->dictionary_owner_soft, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", viewport->dictionary_owner_soft);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, viewport->dictionary_owner_soft);
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (viewport->dictionary_owner_hard, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", viewport->dictionary_owner_hard);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, viewport->dictionary_owner_hard);
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbEntity\n");
+                dxf_write_string (fp, 100, "AcDbEntity");
         }
-        if (viewport->paperspace == DXF_PAPERSPACE)
+        if (viewport->properties->paperspace == DXF_PAPERSPACE)
         {
-                fprintf (fp->fp, " 67\n%d\n", DXF_PAPERSPACE);
+                dxf_write_int (fp, 67, DXF_PAPERSPACE);
         }
-        fprintf (fp->fp, "  8\n%s\n", viewport->layer);
-        if (strcmp (viewport->linetype, DXF_DEFAULT_LINETYPE) != 0)
+        dxf_write_string (fp, 8, viewport->properties->layer);
+        if (strcmp (viewport->properties->linetype, DXF_DEFAULT_LINETYPE) != 0)
         {
-                fprintf (fp->fp, "  6\n%s\n", viewport->linetype);
+                dxf_write_string (fp, 6, viewport->properties->linetype);
         }
         if ((fp->acad_version_number <= AutoCAD_11)
           && DXF_FLATLAND
-          && (viewport->elevation != 0.0))
+          && (viewport->properties->elevation != 0.0))
         {
-                fprintf (fp->fp, " 38\n%f\n", viewport->elevation);
+                dxf_write_double (fp, 38, viewport->properties->elevation);
         }
-        if (viewport->color != DXF_COLOR_BYLAYER)
+        if (viewport->properties->color != DXF_COLOR_BYLAYER)
         {
-                fprintf (fp->fp, " 62\n%d\n", viewport->color);
+                dxf_write_int (fp, 62, viewport->properties->color);
         }
-        if (viewport->linetype_scale != 1.0)
+        if (viewport->properties->linetype_scale != 1.0)
         {
-                fprintf (fp->fp, " 48\n%f\n", viewport->linetype_scale);
+                dxf_write_double (fp, 48, viewport->properties->linetype_scale);
         }
-        if (viewport->visibility != 0)
+        if (viewport->properties->visibility != 0)
         {
-                fprintf (fp->fp, " 60\n%d\n", viewport->visibility);
+                dxf_write_int (fp, 60, viewport->properties->visibility);
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbViewport\n");
+                dxf_write_string (fp, 100, "AcDbViewport");
         }
-        if (viewport->thickness != 0.0)
+        if (viewport->properties->thickness != 0.0)
         {
-                fprintf (fp->fp, " 39\n%f\n", viewport->thickness);
+                dxf_write_double (fp, 39, viewport->properties->thickness);
         }
-        fprintf (fp->fp, " 10\n%f\n", viewport->x0);
-        fprintf (fp->fp, " 20\n%f\n", viewport->y0);
-        fprintf (fp->fp, " 30\n%f\n", viewport->z0);
-        fprintf (fp->fp, " 40\n%f\n", viewport->width);
-        fprintf (fp->fp, " 41\n%f\n", viewport->height);
-        fprintf (fp->fp, " 68\n%d\n", viewport->status);
-        fprintf (fp->fp, " 69\n%d\n", viewport->id);
-        fprintf (fp->fp, "1001\n%s\n", DXF_VIEWPORT_APP_NAME);
-        fprintf (fp->fp, "1000\n%s\n", DXF_VIEWPORT_DATA);
-        fprintf (fp->fp, "1002\n%s\n", DXF_VIEWPORT_WINDOW_BEGIN);
-        fprintf (fp->fp, "1070\n%d\n", viewport->extended_entity_data_version);
-        fprintf (fp->fp, "1010\n%f\n", viewport->x_target);
-        fprintf (fp->fp, "1020\n%f\n", viewport->y_target);
-        fprintf (fp->fp, "1030\n%f\n", viewport->z_target);
-        fprintf (fp->fp, "1010\n%f\n", viewport->x_direction);
-        fprintf (fp->fp, "1020\n%f\n", viewport->y_direction);
-        fprintf (fp->fp, "1030\n%f\n", viewport->z_direction);
-        fprintf (fp->fp, "1040\n%f\n", viewport->view_twist_angle);
-        fprintf (fp->fp, "1040\n%f\n", viewport->view_height);
-        fprintf (fp->fp, "1040\n%f\n", viewport->x_center);
-        fprintf (fp->fp, "1040\n%f\n", viewport->y_center);
-        fprintf (fp->fp, "1040\n%f\n", viewport->perspective_lens_length);
-        fprintf (fp->fp, "1040\n%f\n", viewport->front_plane_offset);
-        fprintf (fp->fp, "1040\n%f\n", viewport->back_plane_offset);
-        fprintf (fp->fp, "1070\n%d\n", viewport->view_mode);
-        fprintf (fp->fp, "1070\n%d\n", viewport->circle_zoom_percent);
-        fprintf (fp->fp, "1070\n%d\n", viewport->fast_zoom_setting);
-        fprintf (fp->fp, "1070\n%d\n", viewport->UCSICON_setting);
-        fprintf (fp->fp, "1070\n%d\n", viewport->snap_on);
-        fprintf (fp->fp, "1070\n%d\n", viewport->grid_on);
-        fprintf (fp->fp, "1070\n%d\n", viewport->snap_style);
-        fprintf (fp->fp, "1070\n%d\n", viewport->snap_isopair);
-        fprintf (fp->fp, "1040\n%f\n", viewport->snap_rotation_angle);
-        fprintf (fp->fp, "1040\n%f\n", viewport->x_snap_base);
-        fprintf (fp->fp, "1040\n%f\n", viewport->y_snap_base);
-        fprintf (fp->fp, "1040\n%f\n", viewport->x_snap_spacing);
-        fprintf (fp->fp, "1040\n%f\n", viewport->y_snap_spacing);
-        fprintf (fp->fp, "1040\n%f\n", viewport->x_grid_spacing);
-        fprintf (fp->fp, "1040\n%f\n", viewport->y_grid_spacing);
-        fprintf (fp->fp, "1070\n%d\n", viewport->plot_flag);
-        fprintf (fp->fp, "1002\n%s\n", DXF_VIEWPORT_FROZEN_LAYER_LIST_BEGIN);
+        dxf_write_double (fp, 10, viewport->x0);
+        dxf_write_double (fp, 20, viewport->y0);
+        dxf_write_double (fp, 30, viewport->z0);
+        dxf_write_double (fp, 40, viewport->width);
+        dxf_write_double (fp, 41, viewport->height);
+        dxf_write_int (fp, 68, viewport->status);
+        dxf_write_int (fp, 69, viewport->id);
+        dxf_write_string (fp, 1001, DXF_VIEWPORT_APP_NAME);
+        dxf_write_string (fp, 1000, DXF_VIEWPORT_DATA);
+        dxf_write_string (fp, 1002, DXF_VIEWPORT_WINDOW_BEGIN);
+        dxf_write_int (fp, 1070, viewport->extended_entity_data_version);
+        dxf_write_double (fp, 1010, viewport->x_target);
+        dxf_write_double (fp, 1020, viewport->y_target);
+        dxf_write_double (fp, 1030, viewport->z_target);
+        dxf_write_double (fp, 1010, viewport->x_direction);
+        dxf_write_double (fp, 1020, viewport->y_direction);
+        dxf_write_double (fp, 1030, viewport->z_direction);
+        dxf_write_double (fp, 1040, viewport->view_twist_angle);
+        dxf_write_double (fp, 1040, viewport->view_height);
+        dxf_write_double (fp, 1040, viewport->x_center);
+        dxf_write_double (fp, 1040, viewport->y_center);
+        dxf_write_double (fp, 1040, viewport->perspective_lens_length);
+        dxf_write_double (fp, 1040, viewport->front_plane_offset);
+        dxf_write_double (fp, 1040, viewport->back_plane_offset);
+        dxf_write_int (fp, 1070, viewport->view_mode);
+        dxf_write_int (fp, 1070, viewport->circle_zoom_percent);
+        dxf_write_int (fp, 1070, viewport->fast_zoom_setting);
+        dxf_write_int (fp, 1070, viewport->UCSICON_setting);
+        dxf_write_int (fp, 1070, viewport->snap_on);
+        dxf_write_int (fp, 1070, viewport->grid_on);
+        dxf_write_int (fp, 1070, viewport->snap_style);
+        dxf_write_int (fp, 1070, viewport->snap_isopair);
+        dxf_write_double (fp, 1040, viewport->snap_rotation_angle);
+        dxf_write_double (fp, 1040, viewport->x_snap_base);
+        dxf_write_double (fp, 1040, viewport->y_snap_base);
+        dxf_write_double (fp, 1040, viewport->x_snap_spacing);
+        dxf_write_double (fp, 1040, viewport->y_snap_spacing);
+        dxf_write_double (fp, 1040, viewport->x_grid_spacing);
+        dxf_write_double (fp, 1040, viewport->y_grid_spacing);
+        dxf_write_int (fp, 1070, viewport->plot_flag);
+        dxf_write_string (fp, 1002, DXF_VIEWPORT_FROZEN_LAYER_LIST_BEGIN);
         /* Start a loop writing all frozen layer names. */
         int j = 0;
         while ((!viewport->frozen_layers[j]) /* Do not allow NULL pointers. */
                 || (strcmp (viewport->frozen_layers[j], "") == 1) /* Do not allow empty strings. */
                 || (j < DXF_MAX_LAYERS)) /* Do not overrun the array size. */
         {
-                fprintf (fp->fp, "1003\n%s\n", viewport->frozen_layers[j]);
+                dxf_write_string (fp, 1003, viewport->frozen_layers[j]);
                 j++;
         }
-        fprintf (fp->fp, "1002\n%s\n", DXF_VIEWPORT_FROZEN_LAYER_LIST_END);
-        fprintf (fp->fp, "1002\n%s\n", DXF_VIEWPORT_WINDOW_END);
+        dxf_write_string (fp, 1002, DXF_VIEWPORT_FROZEN_LAYER_LIST_END);
+        dxf_write_string (fp, 1002, DXF_VIEWPORT_WINDOW_END);
         /* Clean up. */
-        free (dxf_entity_name);
+        dxf_free (dxf_entity_name);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -1242,22 +1162,20 @@ dxf_viewport_free
                   __FUNCTION__);
                 return (EXIT_FAILURE);
         }
-        free (viewport->linetype);
-        free (viewport->layer);
-        free (viewport->app_name);
-        free (viewport->viewport_data);
-        free (viewport->window_descriptor_begin);
-        free (viewport->frozen_layer_list_begin);
+        dxf_graphic_properties_free (viewport->properties);
+        dxf_free (viewport->app_name);
+        dxf_free (viewport->viewport_data);
+        dxf_free (viewport->window_descriptor_begin);
+        dxf_free (viewport->frozen_layer_list_begin);
         for (i = 0; i < DXF_MAX_LAYERS; i++)
         {
-                if (strcmp (viewport->frozen_layers[i], "") != 0)
-                {
-                        free (viewport->frozen_layers[i]);
-                }
+                dxf_free (viewport->frozen_layers[i]);
         }
-        free (viewport->frozen_layer_list_end);
-        free (viewport->window_descriptor_end);
-        free (viewport);
+        dxf_free (viewport->frozen_layer_list_end);
+        dxf_free (viewport->window_descriptor_end);
+        dxf_free (viewport->dictionary_owner_soft);
+        dxf_free (viewport->dictionary_owner_hard);
+        dxf_free (viewport);
         viewport = NULL;
 #if DEBUG
         DXF_DEBUG_END
@@ -1284,7 +1202,7 @@ dxf_viewport_free_chain
                  * entities. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (viewports == NULL)
@@ -39,6 +39,8 @@
 
 
 #include "vport.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -198,7 +200,8 @@ dxf_vport_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfPair pair;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -206,8 +209,6 @@ dxf_vport_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (vport == NULL)
@@ -218,308 +219,226 @@ dxf_vport_read
                 vport = dxf_vport_new ();
                 vport = dxf_vport_init (vport);
         }
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        fclose (fp->fp);
-                        /* Clean up. */
-                        free (temp_string);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &vport->id_code);
-                }
-                else if (strcmp (temp_string, "2") == 0)
-                {
-                        /* Now follows a string containing a viewport
-                         * name. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", vport->viewport_name);
-                }
-                else if (strcmp (temp_string, "10") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X value of the lower-left corner of viewport. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &vport->x_min);
-                }
-                else if (strcmp (temp_string, "20") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y value of the lower-left corner of viewport. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &vport->y_min);
-                }
-                else if (strcmp (temp_string, "11") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X value of the upper-right corner of viewport. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &vport->x_max);
-                }
-                else if (strcmp (temp_string, "21") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y value of the upper-right corner of viewport. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &vport->y_max);
-                }
-                else if (strcmp (temp_string, "12") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X value of the view center point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &vport->x_center);
-                }
-                else if (strcmp (temp_string, "22") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y value of the view center point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &vport->y_center);
-                }
-                else if (strcmp (temp_string, "13") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X value of the snap base point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &vport->x_snap_base);
-                }
-                else if (strcmp (temp_string, "23") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y value of the snap base point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &vport->y_snap_base);
-                }
-                else if (strcmp (temp_string, "14") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X value of snap spacing X and Y. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &vport->x_snap_spacing);
-                }
-                else if (strcmp (temp_string, "24") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y value of snap spacing X and Y. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &vport->y_snap_spacing);
-                }
-                else if (strcmp (temp_string, "15") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X value of grid spacing X and Y. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &vport->x_grid_spacing);
-                }
-                else if (strcmp (temp_string, "25") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y value of grid spacing X and Y. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &vport->y_grid_spacing);
-                }
-                else if (strcmp (temp_string, "16") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X value of the view direction from target point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &vport->x_direction);
-                }
-                else if (strcmp (temp_string, "26") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y value of the view direction from target point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &vport->y_direction);
-                }
-                else if (strcmp (temp_string, "36") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z value of the view direction from target point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &vport->z_direction);
-                }
-                else if (strcmp (temp_string, "17") == 0)
-                {
-                        /* Now follows a string containing the
-                         * X value of the view target point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &vport->x_target);
-                }
-                else if (strcmp (temp_string, "27") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Y value of the view target point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &vport->y_target);
-                }
-                else if (strcmp (temp_string, "37") == 0)
-                {
-                        /* Now follows a string containing the
-                         * Z value of the view target point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &vport->z_target);
-                }
-                else if (strcmp (temp_string, "40") == 0)
-                {
-                        /* Now follows a string containing the view
-                         * height. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &vport->view_height);
+                if (pair.group_code == 0)
+                {
+                        /* Leave the start of the following entity (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
+                }
+                switch (pair.group_code)
+                {
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                vport->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 2:
+                                /* Now follows a string containing a viewport
+                                 * name. */
+                                free (vport->viewport_name);
+                                vport->viewport_name = dxf_pair_get_string (&pair);
+                                break;
+                        case 10:
+                                /* Now follows a string containing the
+                                 * X value of the lower-left corner of viewport. */
+                                vport->x_min = dxf_pair_get_double (&pair);
+                                break;
+                        case 20:
+                                /* Now follows a string containing the
+                                 * Y value of the lower-left corner of viewport. */
+                                vport->y_min = dxf_pair_get_double (&pair);
+                                break;
+                        case 11:
+                                /* Now follows a string containing the
+                                 * X value of the upper-right corner of viewport. */
+                                vport->x_max = dxf_pair_get_double (&pair);
+                                break;
+                        case 21:
+                                /* Now follows a string containing the
+                                 * Y value of the upper-right corner of viewport. */
+                                vport->y_max = dxf_pair_get_double (&pair);
+                                break;
+                        case 12:
+                                /* Now follows a string containing the
+                                 * X value of the view center point. */
+                                vport->x_center = dxf_pair_get_double (&pair);
+                                break;
+                        case 22:
+                                /* Now follows a string containing the
+                                 * Y value of the view center point. */
+                                vport->y_center = dxf_pair_get_double (&pair);
+                                break;
+                        case 13:
+                                /* Now follows a string containing the
+                                 * X value of the snap base point. */
+                                vport->x_snap_base = dxf_pair_get_double (&pair);
+                                break;
+                        case 23:
+                                /* Now follows a string containing the
+                                 * Y value of the snap base point. */
+                                vport->y_snap_base = dxf_pair_get_double (&pair);
+                                break;
+                        case 14:
+                                /* Now follows a string containing the
+                                 * X value of snap spacing X and Y. */
+                                vport->x_snap_spacing = dxf_pair_get_double (&pair);
+                                break;
+                        case 24:
+                                /* Now follows a string containing the
+                                 * Y value of snap spacing X and Y. */
+                                vport->y_snap_spacing = dxf_pair_get_double (&pair);
+                                break;
+                        case 15:
+                                /* Now follows a string containing the
+                                 * X value of grid spacing X and Y. */
+                                vport->x_grid_spacing = dxf_pair_get_double (&pair);
+                                break;
+                        case 25:
+                                /* Now follows a string containing the
+                                 * Y value of grid spacing X and Y. */
+                                vport->y_grid_spacing = dxf_pair_get_double (&pair);
+                                break;
+                        case 16:
+                                /* Now follows a string containing the
+                                 * X value of the view direction from target point. */
+                                vport->x_direction = dxf_pair_get_double (&pair);
+                                break;
+                        case 26:
+                                /* Now follows a string containing the
+                                 * Y value of the view direction from target point. */
+                                vport->y_direction = dxf_pair_get_double (&pair);
+                                break;
+                        case 36:
+                                /* Now follows a string containing the
+                                 * Z value of the view direction from target point. */
+                                vport->z_direction = dxf_pair_get_double (&pair);
+                                break;
+                        case 17:
+                                /* Now follows a string containing the
+                                 * X value of the view target point. */
+                                vport->x_target = dxf_pair_get_double (&pair);
+                                break;
+                        case 27:
+                                /* Now follows a string containing the
+                                 * Y value of the view target point. */
+                                vport->y_target = dxf_pair_get_double (&pair);
+                                break;
+                        case 37:
+                                /* Now follows a string containing the
+                                 * Z value of the view target point. */
+                                vport->z_target = dxf_pair_get_double (&pair);
+                                break;
+                        case 40:
+                                /* Now follows a string containing the view
+                                 * height. */
+                                vport->view_height = dxf_pair_get_double (&pair);
+                                break;
+                        case 41:
+                                /* Now follows a string containing the viewport
+                                 * aspect ratio. */
+                                vport->viewport_aspect_ratio = dxf_pair_get_double (&pair);
+                                break;
+                        case 42:
+                                /* Now follows a string containing the lens
+                                 * length. */
+                                vport->viewport_aspect_ratio = dxf_pair_get_double (&pair);
+                                break;
+                        case 43:
+                                /* Now follows a string containing the front
+                                 * clipping plane - offset from target point. */
+                                vport->front_plane_offset = dxf_pair_get_double (&pair);
+                                break;
+                        case 44:
+                                /* Now follows a string containing the back
+                                 * clipping plane - offset from target point. */
+                                vport->back_plane_offset = dxf_pair_get_double (&pair);
+                                break;
+                        case 50:
+                                /* Now follows a string containing the snap
+                                 * rotation angle. */
+                                vport->snap_rotation_angle = dxf_pair_get_double (&pair);
+                                break;
+                        case 51:
+                                /* Now follows a string containing the view
+                                 * twist angle. */
+                                vport->view_twist_angle = dxf_pair_get_double (&pair);
+                                break;
+                        case 68:
+                                /* Now follows a string containing the
+                                 * status field value. */
+                                vport->status_field = dxf_pair_get_int (&pair);
+                                break;
+                        case 69:
+                                /* Now follows a string containing the
+                                 * ID value. */
+                                vport->id = dxf_pair_get_int (&pair);
+                                break;
+                        case 70:
+                                /* Now follows a string containing the
+                                 * standard flag value. */
+                                vport->standard_flag = dxf_pair_get_int (&pair);
+                                break;
+                        case 71:
+                                /* Now follows a string containing the
+                                 * view mode value. */
+                                vport->view_mode = dxf_pair_get_int (&pair);
+                                break;
+                        case 72:
+                                /* Now follows a string containing the circle
+                                 * zoom percent value. */
+                                vport->circle_zoom_percent = dxf_pair_get_int (&pair);
+                                break;
+                        case 73:
+                                /* Now follows a string containing the fast
+                                 * zoom setting value. */
+                                vport->fast_zoom_setting = dxf_pair_get_int (&pair);
+                                break;
+                        case 74:
+                                /* Now follows a string containing the UCSICON
+                                 * setting value. */
+                                vport->UCSICON_setting = dxf_pair_get_int (&pair);
+                                break;
+                        case 75:
+                                /* Now follows a string containing the snap
+                                 * on/off value. */
+                                vport->snap_on = dxf_pair_get_int (&pair);
+                                break;
+                        case 76:
+                                /* Now follows a string containing the grid
+                                 * on/off value. */
+                                vport->grid_on = dxf_pair_get_int (&pair);
+                                break;
+                        case 77:
+                                /* Now follows a string containing the snap
+                                 * style value. */
+                                vport->snap_style = dxf_pair_get_int (&pair);
+                                break;
+                        case 78:
+                                /* Now follows a string containing the snap
+                                 * isopair value. */
+                                vport->snap_isopair = dxf_pair_get_int (&pair);
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner dictionary. */
+                                free (vport->dictionary_owner_soft);
+                                vport->dictionary_owner_soft = dxf_pair_get_string (&pair);
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                free (vport->dictionary_owner_hard);
+                                vport->dictionary_owner_hard = dxf_pair_get_string (&pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, "DXF comment: %s\n", temp_string);
+                                break;
                 }
-                else if (strcmp (temp_string, "41") == 0)
-                {
-                        /* Now follows a string containing the viewport
-                         * aspect ratio. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &vport->viewport_aspect_ratio);
-                }
-                else if (strcmp (temp_string, "42") == 0)
-                {
-                        /* Now follows a string containing the lens
-                         * length. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &vport->viewport_aspect_ratio);
-                }
-                else if (strcmp (temp_string, "43") == 0)
-                {
-                        /* Now follows a string containing the front
-                         * clipping plane - offset from target point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &vport->front_plane_offset);
-                }
-                else if (strcmp (temp_string, "44") == 0)
-                {
-                        /* Now follows a string containing the back
-                         * clipping plane - offset from target point. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &vport->back_plane_offset);
-                }
-                else if (strcmp (temp_string, "50") == 0)
-                {
-                        /* Now follows a string containing the snap
-                         * rotation angle. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &vport->snap_rotation_angle);
-                }
-                else if (strcmp (temp_string, "51") == 0)
-                {
-                        /* Now follows a string containing the view
-                         * twist angle. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &vport->view_twist_angle);
-                }
-                else if (strcmp (temp_string, "68") == 0)
-                {
-                        /* Now follows a string containing the
-                         * status field value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &vport->status_field);
-                }
-                else if (strcmp (temp_string, "69") == 0)
-                {
-                        /* Now follows a string containing the
-                         * ID value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &vport->id);
-                }
-                else if (strcmp (temp_string, "70") == 0)
-                {
-                        /* Now follows a string containing the
-                         * standard flag value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &vport->standard_flag);
-                }
-                else if (strcmp (temp_string, "71") == 0)
-                {
-                        /* Now follows a string containing the
-                         * view mode value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &vport->view_mode);
-                }
-                else if (strcmp (temp_string, "72") == 0)
-                {
-                        /* Now follows a string containing the circle
-                         * zoom percent value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &vport->circle_zoom_percent);
-                }
-                else if (strcmp (temp_string, "73") == 0)
-                {
-                        /* Now follows a string containing the fast
-                         * zoom setting value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &vport->fast_zoom_setting);
-                }
-                else if (strcmp (temp_string, "74") == 0)
-                {
-                        /* Now follows a string containing the UCSICON
-                         * setting value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &vport->UCSICON_setting);
-                }
-                else if (strcmp (temp_string, "75") == 0)
-                {
-                        /* Now follows a string containing the snap
-                         * on/off value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &vport->snap_on);
-                }
-                else if (strcmp (temp_string, "76") == 0)
-                {
-                        /* Now follows a string containing the grid
-                         * on/off value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &vport->grid_on);
-                }
-                else if (strcmp (temp_string, "77") == 0)
-                {
-                        /* Now follows a string containing the snap
-                         * style value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &vport->snap_style);
-                }
-                else if (strcmp (temp_string, "78") == 0)
-                {
-                        /* Now follows a string containing the snap
-                         * isopair value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%d\n", &vport->snap_isopair);
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", vport->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", vport->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, "DXF comment: %s\n", temp_string);
-                }
-
         }
         /* Handle omitted members and/or illegal values. */
         if ((strcmp (vport->viewport_name, "") == 0)
@@ -530,8 +449,6 @@ dxf_vport_read
                   __FUNCTION__, fp->filename, fp->line_number);
                 return (NULL);
         }
-        /* Clean up. */
-        free (temp_string);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -586,7 +503,7 @@ dxf_vport_write
           || (strcmp (vport->viewport_name, "") == 0))
         {
                 fprintf (stderr,
-                  (_("Error: empty viewport name string for the %s entity with id-code: %x\n")),
+                  (_("Error: empty viewport name string for the %s entity with id-code: %lx\n")),
                   dxf_entity_name, vport->id_code);
                 fprintf (stderr,
                   (_("\t%s entity is discarded from output.\n")),
@@ -596,10 +513,10 @@ dxf_vport_write
                 return (EXIT_FAILURE);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_string (fp, 0, dxf_entity_name);
         if (vport->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", vport->id_code);
+                dxf_write_hex (fp, 5, vport->id_code);
         }
         /*!
          * \todo for version R14.\n
@@ -614,59 +531,59 @@ dxf_vport_write
         if ((strcmp (vport->dictionary_owner_soft, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", vport->dictionary_owner_soft);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, vport->dictionary_owner_soft);
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (vport->dictionary_owner_hard, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", vport->dictionary_owner_hard);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, vport->dictionary_owner_hard);
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbSymbolTableRecord\n");
-                fprintf (fp->fp, "100\nAcDbViewportTableRecord\n");
+                dxf_write_string (fp, 100, "AcDbSymbolTableRecord");
+                dxf_write_string (fp, 100, "AcDbViewportTableRecord");
         }
-        fprintf (fp->fp, "  2\n%s\n", vport->viewport_name);
-        fprintf (fp->fp, " 70\n%d\n", vport->standard_flag);
-        fprintf (fp->fp, " 10\n%f\n", vport->x_min);
-        fprintf (fp->fp, " 20\n%f\n", vport->y_min);
-        fprintf (fp->fp, " 11\n%f\n", vport->x_max);
-        fprintf (fp->fp, " 21\n%f\n", vport->y_max);
-        fprintf (fp->fp, " 12\n%f\n", vport->x_center);
-        fprintf (fp->fp, " 22\n%f\n", vport->y_center);
-        fprintf (fp->fp, " 13\n%f\n", vport->x_snap_base);
-        fprintf (fp->fp, " 23\n%f\n", vport->y_snap_base);
-        fprintf (fp->fp, " 14\n%f\n", vport->x_snap_spacing);
-        fprintf (fp->fp, " 24\n%f\n", vport->y_snap_spacing);
-        fprintf (fp->fp, " 15\n%f\n", vport->x_grid_spacing);
-        fprintf (fp->fp, " 25\n%f\n", vport->y_grid_spacing);
-        fprintf (fp->fp, " 16\n%f\n", vport->x_direction);
-        fprintf (fp->fp, " 26\n%f\n", vport->y_direction);
-        fprintf (fp->fp, " 36\n%f\n", vport->z_direction);
-        fprintf (fp->fp, " 17\n%f\n", vport->x_target);
-        fprintf (fp->fp, " 27\n%f\n", vport->y_target);
-        fprintf (fp->fp, " 37\n%f\n", vport->z_target);
-        fprintf (fp->fp, " 40\n%f\n", vport->view_height);
-        fprintf (fp->fp, " 41\n%f\n", vport->viewport_aspect_ratio);
-        fprintf (fp->fp, " 42\n%f\n", vport->lens_length);
-        fprintf (fp->fp, " 43\n%f\n", vport->front_plane_offset);
-        fprintf (fp->fp, " 44\n%f\n", vport->back_plane_offset);
-        fprintf (fp->fp, " 50\n%f\n", vport->snap_rotation_angle);
-        fprintf (fp->fp, " 51\n%f\n", vport->view_twist_angle);
+        dxf_write_string (fp, 2, vport->viewport_name);
+        dxf_write_int (fp, 70, vport->standard_flag);
+        dxf_write_double (fp, 10, vport->x_min);
+        dxf_write_double (fp, 20, vport->y_min);
+        dxf_write_double (fp, 11, vport->x_max);
+        dxf_write_double (fp, 21, vport->y_max);
+        dxf_write_double (fp, 12, vport->x_center);
+        dxf_write_double (fp, 22, vport->y_center);
+        dxf_write_double (fp, 13, vport->x_snap_base);
+        dxf_write_double (fp, 23, vport->y_snap_base);
+        dxf_write_double (fp, 14, vport->x_snap_spacing);
+        dxf_write_double (fp, 24, vport->y_snap_spacing);
+        dxf_write_double (fp, 15, vport->x_grid_spacing);
+        dxf_write_double (fp, 25, vport->y_grid_spacing);
+        dxf_write_double (fp, 16, vport->x_direction);
+        dxf_write_double (fp, 26, vport->y_direction);
+        dxf_write_double (fp, 36, vport->z_direction);
+        dxf_write_double (fp, 17, vport->x_target);
+        dxf_write_double (fp, 27, vport->y_target);
+        dxf_write_double (fp, 37, vport->z_target);
+        dxf_write_double (fp, 40, vport->view_height);
+        dxf_write_double (fp, 41, vport->viewport_aspect_ratio);
+        dxf_write_double (fp, 42, vport->lens_length);
+        dxf_write_double (fp, 43, vport->front_plane_offset);
+        dxf_write_double (fp, 44, vport->back_plane_offset);
+        dxf_write_double (fp, 50, vport->snap_rotation_angle);
+        dxf_write_double (fp, 51, vport->view_twist_angle);
 //        fprintf (fp->fp, " 68\n%d\n", vport->status_field);
 //        fprintf (fp->fp, " 69\n%d\n", vport->id);
-        fprintf (fp->fp, " 71\n%d\n", vport->view_mode);
-        fprintf (fp->fp, " 72\n%d\n", vport->circle_zoom_percent);
-        fprintf (fp->fp, " 73\n%d\n", vport->fast_zoom_setting);
-        fprintf (fp->fp, " 74\n%d\n", vport->UCSICON_setting);
-        fprintf (fp->fp, " 75\n%d\n", vport->snap_on);
-        fprintf (fp->fp, " 76\n%d\n", vport->grid_on);
-        fprintf (fp->fp, " 77\n%d\n", vport->snap_style);
-        fprintf (fp->fp, " 78\n%d\n", vport->snap_isopair);
+        dxf_write_int (fp, 71, vport->view_mode);
+        dxf_write_int (fp, 72, vport->circle_zoom_percent);
+        dxf_write_int (fp, 73, vport->fast_zoom_setting);
+        dxf_write_int (fp, 74, vport->UCSICON_setting);
+        dxf_write_int (fp, 75, vport->snap_on);
+        dxf_write_int (fp, 76, vport->grid_on);
+        dxf_write_int (fp, 77, vport->snap_style);
+        dxf_write_int (fp, 78, vport->snap_isopair);
         /* Clean up. */
         free (dxf_entity_name);
 #if DEBUG
@@ -737,7 +654,7 @@ dxf_vport_free_chain
                  * entries. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (vports == NULL)
@@ -749,6 +666,7 @@ dxf_vport_free_chain
         while (vports != NULL)
         {
                 struct DxfVPort *iter = vports->next;
+                vports->next = NULL;
                 dxf_vport_free (vports);
                 vports = (DxfVPort *) iter;
         }
@@ -62,7 +62,7 @@ extern "C" {
 typedef struct
 dxf_vport
 {
-        int id_code;
+        long id_code;
                 /*!< Identification number for the entity.\n
                  * This is to be an unique (sequential) number in the DXF
                  * file.\n
@@ -0,0 +1,739 @@
+/*!
+ * \file writer.c
+ *
+ * \author Copyright (C) 2017 by the libDXF developers.
+ *
+ * \brief Group code writer for DXF files.
+ *
+ * Entity writers emit every group through one of the typed functions in
+ * this file, which write either ASCII DXF or, when the \c DxfFile was
+ * opened with dxf_write_init () in binary mode, binary DXF.\n
+ * Groups are collected in the output buffer of the \c DxfFile and
+ * numbers are formatted by the dxf_number_format_* () functions, so
+ * writing a group costs a few stores instead of a \c fprintf () call.\n
+ * Floating point values are written with the fewest digits which read
+ * back as exactly the same double, unless a fixed number of decimals
+ * was set with dxf_write_set_decimals ().
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+
+
+#include "writer.h"
+#include "lexer.h"
+#include "number.h"
+
+
+/*!
+ * \brief Largest number of bytes in one binary chunk group.
+ */
+#define DXF_WRITE_MAX_CHUNK 127
+
+
+/*!
+ * \brief Make room for at least \c size more bytes in the output
+ * buffer of a memory file.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when no memory
+ * could be allocated.
+ */
+static int
+dxf_write_grow
+(
+        DxfFile *fp,
+                /*!< DXF memory file. */
+        size_t size
+                /*!< number of bytes needed. */
+)
+{
+        char *buffer;
+        size_t allocated;
+
+        allocated = (fp->write_buffer_size == 0) ? DXF_WRITE_MEMORY_SIZE
+          : 2 * fp->write_buffer_size;
+        if (allocated < fp->write_length + size)
+        {
+                allocated = fp->write_length + size;
+        }
+        buffer = realloc (fp->write_buffer, allocated);
+        if (buffer == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not allocate memory.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        fp->write_buffer = buffer;
+        fp->write_buffer_size = allocated;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Append \c size bytes to the output buffer of \c fp, flushing
+ * it first when they do not fit.
+ *
+ * Blocks larger than the buffer, and everything written to a file
+ * without an output buffer, go to the stream directly.  The buffer of
+ * a memory file grows instead.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_write_bytes
+(
+        DxfFile *fp,
+                /*!< DXF file pointer to an output file (or device). */
+        const void *data,
+                /*!< the bytes. */
+        size_t size
+                /*!< number of bytes. */
+)
+{
+        if (size > fp->write_buffer_size - fp->write_length)
+        {
+                if (fp->fp == NULL)
+                {
+                        if (dxf_write_grow (fp, size) == EXIT_FAILURE)
+                        {
+                                return (EXIT_FAILURE);
+                        }
+                }
+                else if (dxf_write_flush (fp) == EXIT_FAILURE)
+                {
+                        return (EXIT_FAILURE);
+                }
+        }
+        if (size > fp->write_buffer_size - fp->write_length)
+        {
+                return ((fwrite (data, 1, size, fp->fp) == size) ? EXIT_SUCCESS : EXIT_FAILURE);
+        }
+        memcpy (fp->write_buffer + fp->write_length, data, size);
+        fp->write_length += size;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Write an ASCII group: the group code right aligned in three
+ * columns on one line, the value on the next.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_write_ascii
+(
+        DxfFile *fp,
+                /*!< DXF file pointer to an output file (or device). */
+        int group_code,
+                /*!< group code. */
+        const char *value,
+                /*!< value. */
+        size_t length
+                /*!< length of \c value. */
+)
+{
+        char code[DXF_NUMBER_MAX_FORMAT_LENGTH];
+        char line[DXF_NUMBER_MAX_FORMAT_LENGTH + 4];
+        char *dest;
+        size_t n;
+        size_t width;
+
+        n = dxf_number_format_long (code, group_code);
+        width = (n < 3) ? 3 : n;
+        if (width + length + 2 <= fp->write_buffer_size - fp->write_length)
+        {
+                /* The usual case: build the group in place. */
+                dest = fp->write_buffer + fp->write_length;
+                memset (dest, ' ', width - n);
+                memcpy (dest + width - n, code, n);
+                dest[width] = '\n';
+                memcpy (dest + width + 1, value, length);
+                dest[width + 1 + length] = '\n';
+                fp->write_length += width + length + 2;
+                return (EXIT_SUCCESS);
+        }
+        memset (line, ' ', width - n);
+        memcpy (line + width - n, code, n);
+        line[width] = '\n';
+        if ((dxf_write_bytes (fp, line, width + 1) == EXIT_FAILURE)
+          || (dxf_write_bytes (fp, value, length) == EXIT_FAILURE))
+        {
+                return (EXIT_FAILURE);
+        }
+        return (dxf_write_bytes (fp, "\n", 1));
+}
+
+
+/*!
+ * \brief Format a floating point value as set for \c fp.
+ *
+ * \return the number of characters written to \c dest.
+ */
+static size_t
+dxf_write_format_double
+(
+        DxfFile *fp,
+                /*!< DXF file pointer to an output file (or device). */
+        char *dest,
+                /*!< destination, room for
+                 * \c DXF_NUMBER_MAX_FORMAT_LENGTH characters. */
+        double value
+                /*!< value. */
+)
+{
+        if (fp->decimals == DXF_WRITE_SHORTEST)
+        {
+                return (dxf_number_format_double (dest, value));
+        }
+        return (dxf_number_format_fixed (dest, value, fp->decimals));
+}
+
+
+/*!
+ * \brief Write a group code to a binary DXF file.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_write_binary_group_code
+(
+        DxfFile *fp,
+                /*!< DXF file pointer to an output file (or device). */
+        int group_code
+                /*!< group code. */
+)
+{
+        unsigned char bytes[3];
+        size_t n;
+
+        if (fp->binary == 1)
+        {
+                /* Group codes of 255 and up are escaped with 255. */
+                if (group_code >= 255)
+                {
+                        bytes[0] = 255;
+                        bytes[1] = (unsigned char) (group_code & 0xff);
+                        bytes[2] = (unsigned char) ((group_code >> 8) & 0xff);
+                        n = 3;
+                }
+                else
+                {
+                        bytes[0] = (unsigned char) group_code;
+                        n = 1;
+                }
+        }
+        else
+        {
+                bytes[0] = (unsigned char) (group_code & 0xff);
+                bytes[1] = (unsigned char) ((group_code >> 8) & 0xff);
+                n = 2;
+        }
+        return (dxf_write_bytes (fp, bytes, n));
+}
+
+
+/*!
+ * \brief Write an integer as \c size little endian bytes to a binary
+ * DXF file.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_write_binary_bytes
+(
+        DxfFile *fp,
+                /*!< DXF file pointer to an output file (or device). */
+        uint64_t value,
+                /*!< value. */
+        size_t size
+                /*!< number of bytes. */
+)
+{
+        unsigned char bytes[8];
+        size_t i;
+
+        for (i = 0; i < size; i++)
+        {
+                bytes[i] = (unsigned char) ((value >> (8 * i)) & 0xff);
+        }
+        return (dxf_write_bytes (fp, bytes, size));
+}
+
+
+/*!
+ * \brief Write a number to a binary DXF file, in the size and
+ * representation belonging to \c group_code.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_write_binary_number
+(
+        DxfFile *fp,
+                /*!< DXF file pointer to an output file (or device). */
+        int group_code,
+                /*!< group code. */
+        double real,
+                /*!< value when \c is_real is set. */
+        int64_t integer,
+                /*!< value when \c is_real is not set. */
+        int is_real
+                /*!< the value is a floating point number. */
+)
+{
+        char text[DXF_NUMBER_MAX_FORMAT_LENGTH];
+        uint64_t bits;
+        size_t n;
+
+        switch (dxf_lexer_group_code_type (group_code))
+        {
+                case DXF_GROUP_CODE_TYPE_DOUBLE:
+                        if (!is_real)
+                        {
+                                real = (double) integer;
+                        }
+                        memcpy (&bits, &real, sizeof (bits));
+                        dxf_write_binary_group_code (fp, group_code);
+                        return (dxf_write_binary_bytes (fp, bits, 8));
+                case DXF_GROUP_CODE_TYPE_INT16:
+                        dxf_write_binary_group_code (fp, group_code);
+                        return (dxf_write_binary_bytes (fp,
+                          (uint64_t) (is_real ? (int64_t) real : integer), 2));
+                case DXF_GROUP_CODE_TYPE_INT32:
+                        dxf_write_binary_group_code (fp, group_code);
+                        return (dxf_write_binary_bytes (fp,
+                          (uint64_t) (is_real ? (int64_t) real : integer), 4));
+                case DXF_GROUP_CODE_TYPE_INT64:
+                        dxf_write_binary_group_code (fp, group_code);
+                        return (dxf_write_binary_bytes (fp,
+                          (uint64_t) (is_real ? (int64_t) real : integer), 8));
+                case DXF_GROUP_CODE_TYPE_BOOL:
+                        dxf_write_binary_group_code (fp, group_code);
+                        return (dxf_write_binary_bytes (fp,
+                          (uint64_t) (is_real ? (int64_t) real : integer), 1));
+                default:
+                        /* A string group, write the number as text. */
+                        if (is_real)
+                        {
+                                n = dxf_write_format_double (fp, text, real);
+                        }
+                        else
+                        {
+                                n = dxf_number_format_long (text, (long) integer);
+                        }
+                        dxf_write_binary_group_code (fp, group_code);
+                        /* Including the terminating NUL. */
+                        return (dxf_write_bytes (fp, text, n + 1));
+        }
+}
+
+
+/*!
+ * \brief Write hexadecimal text as binary chunk groups to a binary DXF
+ * file.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+dxf_write_binary_chunk
+(
+        DxfFile *fp,
+                /*!< DXF file pointer to an output file (or device). */
+        int group_code,
+                /*!< group code. */
+        const char *value
+                /*!< hexadecimal text. */
+)
+{
+        unsigned char bytes[DXF_WRITE_MAX_CHUNK + 1];
+        unsigned long nibble;
+        size_t length = strlen (value) / 2;
+        size_t n;
+        size_t i;
+
+        do
+        {
+                n = (length > DXF_WRITE_MAX_CHUNK) ? DXF_WRITE_MAX_CHUNK : length;
+                bytes[0] = (unsigned char) n;
+                for (i = 0; i < n; i++)
+                {
+                        dxf_number_parse_hex (value, 2, &nibble);
+                        bytes[i + 1] = (unsigned char) nibble;
+                        value += 2;
+                }
+                dxf_write_binary_group_code (fp, group_code);
+                if (dxf_write_bytes (fp, bytes, n + 1) == EXIT_FAILURE)
+                {
+                        return (EXIT_FAILURE);
+                }
+                length -= n;
+        }
+        while (length > 0);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Write a group with a string value.
+ *
+ * In a binary DXF file a string for a numeric group code is converted
+ * to the number, and a string for a binary chunk group code is
+ * converted from hexadecimal text to bytes.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_write_string
+(
+        DxfFile *fp,
+                /*!< DXF file pointer to an output file (or device). */
+        int group_code,
+                /*!< group code. */
+        const char *value
+                /*!< value, \c NULL is written as an empty string. */
+)
+{
+        double real;
+        long integer;
+
+        if (value == NULL)
+        {
+                value = "";
+        }
+        if (!fp->binary)
+        {
+                return (dxf_write_ascii (fp, group_code, value, strlen (value)));
+        }
+        switch (dxf_lexer_group_code_type (group_code))
+        {
+                case DXF_GROUP_CODE_TYPE_DOUBLE:
+                        dxf_number_parse_double (value, strlen (value), &real);
+                        return (dxf_write_binary_number (fp, group_code, real, 0, TRUE));
+                case DXF_GROUP_CODE_TYPE_INT16:
+                case DXF_GROUP_CODE_TYPE_INT32:
+                case DXF_GROUP_CODE_TYPE_INT64:
+                case DXF_GROUP_CODE_TYPE_BOOL:
+                        dxf_number_parse_long (value, strlen (value), &integer);
+                        return (dxf_write_binary_number (fp, group_code, 0.0, integer, FALSE));
+                case DXF_GROUP_CODE_TYPE_BINARY:
+                        return (dxf_write_binary_chunk (fp, group_code, value));
+                default:
+                        dxf_write_binary_group_code (fp, group_code);
+                        return (dxf_write_bytes (fp, value, strlen (value) + 1));
+        }
+}
+
+
+/*!
+ * \brief Write a group with a floating point value.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_write_double
+(
+        DxfFile *fp,
+                /*!< DXF file pointer to an output file (or device). */
+        int group_code,
+                /*!< group code. */
+        double value
+                /*!< value. */
+)
+{
+        char text[DXF_NUMBER_MAX_FORMAT_LENGTH];
+        size_t n;
+
+        if (fp->binary)
+        {
+                return (dxf_write_binary_number (fp, group_code, value, 0, TRUE));
+        }
+        n = dxf_write_format_double (fp, text, value);
+        return (dxf_write_ascii (fp, group_code, text, n));
+}
+
+
+/*!
+ * \brief Write a group with an integer value.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_write_int
+(
+        DxfFile *fp,
+                /*!< DXF file pointer to an output file (or device). */
+        int group_code,
+                /*!< group code. */
+        int value
+                /*!< value. */
+)
+{
+        char text[DXF_NUMBER_MAX_FORMAT_LENGTH];
+        size_t n;
+
+        if (fp->binary)
+        {
+                return (dxf_write_binary_number (fp, group_code, 0.0, value, FALSE));
+        }
+        n = dxf_number_format_long (text, value);
+        return (dxf_write_ascii (fp, group_code, text, n));
+}
+
+
+/*!
+ * \brief Write a group with a long integer value.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_write_long
+(
+        DxfFile *fp,
+                /*!< DXF file pointer to an output file (or device). */
+        int group_code,
+                /*!< group code. */
+        long value
+                /*!< value. */
+)
+{
+        char text[DXF_NUMBER_MAX_FORMAT_LENGTH];
+        size_t n;
+
+        if (fp->binary)
+        {
+                return (dxf_write_binary_number (fp, group_code, 0.0, value, FALSE));
+        }
+        n = dxf_number_format_long (text, value);
+        return (dxf_write_ascii (fp, group_code, text, n));
+}
+
+
+/*!
+ * \brief Write a group with a hexadecimal value, as used for handles.
+ *
+ * Handles are written as hexadecimal text in a binary DXF file as well.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_write_hex
+(
+        DxfFile *fp,
+                /*!< DXF file pointer to an output file (or device). */
+        int group_code,
+                /*!< group code. */
+        unsigned long value
+                /*!< value. */
+)
+{
+        char text[DXF_NUMBER_MAX_FORMAT_LENGTH];
+        size_t n;
+
+        if (fp->binary)
+        {
+                switch (dxf_lexer_group_code_type (group_code))
+                {
+                        case DXF_GROUP_CODE_TYPE_DOUBLE:
+                        case DXF_GROUP_CODE_TYPE_INT16:
+                        case DXF_GROUP_CODE_TYPE_INT32:
+                        case DXF_GROUP_CODE_TYPE_INT64:
+                        case DXF_GROUP_CODE_TYPE_BOOL:
+                                return (dxf_write_binary_number (fp, group_code, 0.0, value, FALSE));
+                        default:
+                                dxf_number_format_hex (text, value);
+                                return (dxf_write_string (fp, group_code, text));
+                }
+        }
+        n = dxf_number_format_hex (text, value);
+        return (dxf_write_ascii (fp, group_code, text, n));
+}
+
+
+/*!
+ * \brief Write \c size bytes of \c data verbatim, e.g. groups copied
+ * from another DXF file of the same format.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_write_raw
+(
+        DxfFile *fp,
+                /*!< DXF file pointer to an output file (or device). */
+        const char *data,
+                /*!< the bytes. */
+        size_t size
+                /*!< number of bytes. */
+)
+{
+        if ((fp == NULL) || ((data == NULL) && (size > 0)))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (size == 0)
+        {
+                return (EXIT_SUCCESS);
+        }
+        return (dxf_write_bytes (fp, data, size));
+}
+
+
+/*!
+ * \brief Set the number of decimals written for floating point values.
+ *
+ * By default (\c DXF_WRITE_SHORTEST) values are written with the fewest
+ * digits which read back as exactly the same double, e.g. "0.1",
+ * "12.0" or "1.5E+20", so a drawing survives reading and writing
+ * unchanged.  A fixed number of decimals, e.g. 6 as with
+ * \c printf ("%f"), gives columns of equal width instead.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_write_set_decimals
+(
+        DxfFile *fp,
+                /*!< DXF file pointer to an output file (or device). */
+        int decimals
+                /*!< number of decimals (0 ... \c DXF_NUMBER_MAX_DECIMALS),
+                 * or \c DXF_WRITE_SHORTEST. */
+)
+{
+        if (fp == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if ((decimals != DXF_WRITE_SHORTEST)
+          && ((decimals < 0) || (decimals > DXF_NUMBER_MAX_DECIMALS)))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () an invalid number of decimals was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        fp->decimals = decimals;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Hand the groups collected in the output buffer of \c fp to
+ * the stream and flush the stream.
+ *
+ * dxf_write_close () does this before closing the file.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_write_flush
+(
+        DxfFile *fp
+                /*!< DXF file pointer to an output file (or device). */
+)
+{
+        size_t length;
+
+        if (fp == NULL)
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (fp->fp == NULL)
+        {
+                /* A memory file keeps its contents. */
+                return (EXIT_SUCCESS);
+        }
+        length = fp->write_length;
+        fp->write_length = 0;
+        if ((length > 0)
+          && (fwrite (fp->write_buffer, 1, length, fp->fp) != length))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () could not write to file: %s.\n")),
+                  __FUNCTION__, fp->filename);
+                return (EXIT_FAILURE);
+        }
+        return ((fflush (fp->fp) == 0) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+
+/*!
+ * \brief Write the contents of the memory file \c memory (see
+ * dxf_write_init_memory ()) to \c fp.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+dxf_write_append
+(
+        DxfFile *fp,
+                /*!< DXF file pointer to an output file (or device). */
+        DxfFile *memory
+                /*!< DXF memory file. */
+)
+{
+        if ((fp == NULL) || (memory == NULL))
+        {
+                fprintf (stderr,
+                  (_("Error in %s () a NULL pointer was passed.\n")),
+                  __FUNCTION__);
+                return (EXIT_FAILURE);
+        }
+        if (memory->write_length == 0)
+        {
+                return (EXIT_SUCCESS);
+        }
+        return (dxf_write_bytes (fp, memory->write_buffer, memory->write_length));
+}
+
+
+/* EOF */
@@ -0,0 +1,129 @@
+/*!
+ * \file writer.h
+ *
+ * \author Copyright (C) 2017 by the libDXF developers.
+ *
+ * \brief Group code writer for DXF files, header file.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+
+
+#ifndef LIBDXF_SRC_WRITER_H
+#define LIBDXF_SRC_WRITER_H
+
+
+#include "global.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define DXF_WRITE_BUFFER_SIZE (256 * 1024)
+        /*!< \brief Size of the output buffer of a file opened for
+         * writing. */
+#define DXF_WRITE_MEMORY_SIZE (64 * 1024)
+        /*!< \brief Initial size of the output buffer of a memory file. */
+#define DXF_WRITE_SHORTEST -1
+        /*!< \brief Write floating point values with the fewest digits
+         * which read back as the same value (see
+         * dxf_write_set_decimals ()). */
+
+
+int
+dxf_write_string
+(
+        DxfFile *fp,
+        int group_code,
+        const char *value
+);
+int
+dxf_write_double
+(
+        DxfFile *fp,
+        int group_code,
+        double value
+);
+int
+dxf_write_int
+(
+        DxfFile *fp,
+        int group_code,
+        int value
+);
+int
+dxf_write_long
+(
+        DxfFile *fp,
+        int group_code,
+        long value
+);
+int
+dxf_write_hex
+(
+        DxfFile *fp,
+        int group_code,
+        unsigned long value
+);
+int
+dxf_write_raw
+(
+        DxfFile *fp,
+        const char *data,
+        size_t size
+);
+int
+dxf_write_set_decimals
+(
+        DxfFile *fp,
+        int decimals
+);
+int
+dxf_write_flush
+(
+        DxfFile *fp
+);
+int
+dxf_write_append
+(
+        DxfFile *fp,
+        DxfFile *memory
+);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* LIBDXF_SRC_WRITER_H */
+
+
+/* EOF */
@@ -35,6 +35,8 @@
 
 
 #include "xrecord.h"
+#include "writer.h"
+#include "lexer.h"
 
 
 /*!
@@ -161,7 +163,8 @@ dxf_xrecord_read
 #if DEBUG
         DXF_DEBUG_BEGIN
 #endif
-        char *temp_string = NULL;
+        char temp_string[DXF_MAX_STRING_LENGTH];
+        DxfPair pair;
 
         /* Do some basic checks. */
         if (fp == NULL)
@@ -169,8 +172,6 @@ dxf_xrecord_read
                 fprintf (stderr,
                   (_("Error in %s () a NULL file pointer was passed.\n")),
                   __FUNCTION__);
-                /* Clean up. */
-                free (temp_string);
                 return (NULL);
         }
         if (fp->acad_version_number < AutoCAD_14)
@@ -187,135 +188,99 @@ dxf_xrecord_read
                 xrecord = dxf_xrecord_new ();
                 xrecord = dxf_xrecord_init (xrecord);
         }
-        (fp->line_number)++;
-        fscanf (fp->fp, "%[^\n]", temp_string);
-        while (strcmp (temp_string, "0") != 0)
+        while (dxf_lexer_read_pair (fp, &pair) == 1)
         {
-                if (ferror (fp->fp))
-                {
-                        fprintf (stderr,
-                          (_("Error in %s () while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
-                        /* Clean up. */
-                        free (temp_string);
-                        fclose (fp->fp);
-                        return (NULL);
-                }
-                if (strcmp (temp_string, "5") == 0)
-                {
-                        /* Now follows a string containing a sequential
-                         * id number. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%x\n", &xrecord->id_code);
-                }
-                else if ((fp->acad_version_number >= AutoCAD_13)
-                        && (strcmp (temp_string, "100") == 0))
-                {
-                        /* Now follows a string containing the
-                         * subclass marker value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        if (strcmp (temp_string, "AcDbXrecord") != 0)
-                        {
-                                fprintf (stderr,
-                                  (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
-                                  __FUNCTION__, fp->filename, fp->line_number);
-                        }
-                }
-                else if (strcmp (temp_string, "330") == 0)
-                {
-                        /* Now follows a string containing Soft-pointer
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", xrecord->dictionary_owner_soft);
-                }
-                else if (strcmp (temp_string, "360") == 0)
-                {
-                        /* Now follows a string containing Hard owner
-                         * ID/handle to owner dictionary. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", xrecord->dictionary_owner_hard);
-                }
-                else if (strcmp (temp_string, "999") == 0)
-                {
-                        /* Now follows a string containing a comment. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", temp_string);
-                        fprintf (stdout, (_("DXF comment: %s\n")), temp_string);
-                }
-                else if
-                  (
-                    ((scanf (temp_string, "%d") >= 1) &&  (scanf (temp_string, "%d") <= 9))
-                    || (strcmp (temp_string, "102") == 0)
-                    || (strcmp (temp_string, "105") == 0)
-                    || ((scanf (temp_string, "%d") >= 300) &&  (scanf (temp_string, "%d") <= 369))
-                  )
+                if (pair.group_code == 0)
                 {
-                        xrecord->group_code = scanf (temp_string, "%d");
-                        /* Now follows a string value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%s\n", xrecord->S);
+                        /* Leave the start of the following object (or the
+                         * end of section marker) for the caller. */
+                        dxf_lexer_unread_pair (fp);
+                        break;
                 }
-                else if
-                  (
-                    ((scanf (temp_string, "%d") >= 10) &&  (scanf (temp_string, "%d") <= 59))
-                  )
+                switch (pair.group_code)
                 {
-                        xrecord->group_code = scanf (temp_string, "%d");
-                        /* Now follows a double value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%lf\n", &xrecord->D);
-                }
-                else if
-                  (
-                    ((scanf (temp_string, "%d") >= 60) &&  (scanf (temp_string, "%d") <= 79))
-                    || ((scanf (temp_string, "%d") >= 170) &&  (scanf (temp_string, "%d") <= 175))
-                  )
-                {
-                        xrecord->group_code = scanf (temp_string, "%d");
-                        /* Now follows a 16-bit integer value.. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%" PRIi16 "\n", &xrecord->I16);
-                }
-                else if
-                  (
-                    ((scanf (temp_string, "%d") >= 90) &&  (scanf (temp_string, "%d") <= 99))
-                  )
-                {
-                        xrecord->group_code = scanf (temp_string, "%d");
-                        /* Now follows a 32-bit integer value.. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%" PRIi32 "\n", &xrecord->I32);
-                }
-                else if
-                  (
-                    ((scanf (temp_string, "%d") >= 140) &&  (scanf (temp_string, "%d") <= 147))
-                  )
-                {
-                        xrecord->group_code = scanf (temp_string, "%d");
-                        /* Now follows a float value. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%f\n", &xrecord->F);
-                }
-                else if
-                  (
-                    ((scanf (temp_string, "%d") >= 280) &&  (scanf (temp_string, "%d") <= 289))
-                  )
-                {
-                        xrecord->group_code = scanf (temp_string, "%d");
-                        /* Now follows a 8-bit integer value.. */
-                        (fp->line_number)++;
-                        fscanf (fp->fp, "%" PRIi8 "\n", &xrecord->I8);
-                }
-                else
-                {
-                        fprintf (stderr,
-                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
-                          __FUNCTION__, fp->filename, fp->line_number);
+                        case 5:
+                                /* Now follows a string containing a sequential
+                                 * id number. */
+                                xrecord->id_code = dxf_pair_get_hex (&pair);
+                                break;
+                        case 100:
+                                if (fp->acad_version_number < AutoCAD_13)
+                                {
+                                        break;
+                                }
+                                /* Now follows a string containing the
+                                 * subclass marker value. */
+                                if (!dxf_pair_value_is (&pair, "AcDbXrecord"))
+                                {
+                                        fprintf (stderr,
+                                          (_("Warning in %s () found a bad subclass marker in: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                }
+                                break;
+                        case 330:
+                                /* Now follows a string containing Soft-pointer
+                                 * ID/handle to owner dictionary. */
+                                free (xrecord->dictionary_owner_soft);
+                                xrecord->dictionary_owner_soft = dxf_pair_get_string (&pair);
+                                break;
+                        case 360:
+                                /* Now follows a string containing Hard owner
+                                 * ID/handle to owner dictionary. */
+                                free (xrecord->dictionary_owner_hard);
+                                xrecord->dictionary_owner_hard = dxf_pair_get_string (&pair);
+                                break;
+                        case 999:
+                                /* Now follows a string containing a comment. */
+                                dxf_pair_copy_string (&pair, temp_string, DXF_MAX_STRING_LENGTH);
+                                fprintf (stdout, (_("DXF comment: %s\n")), temp_string);
+                                break;
+                        default:
+                                xrecord->group_code = pair.group_code;
+                                if (((pair.group_code >= 1) && (pair.group_code <= 9))
+                                  || (pair.group_code == 102)
+                                  || (pair.group_code == 105)
+                                  || ((pair.group_code >= 300) && (pair.group_code <= 369)))
+                                {
+                                        /* Now follows a string value. */
+                                        free (xrecord->S);
+                                        xrecord->S = dxf_pair_get_string (&pair);
+                                }
+                                else if ((pair.group_code >= 10) && (pair.group_code <= 59))
+                                {
+                                        /* Now follows a double value. */
+                                        xrecord->D = dxf_pair_get_double (&pair);
+                                }
+                                else if (((pair.group_code >= 60) && (pair.group_code <= 79))
+                                  || ((pair.group_code >= 170) && (pair.group_code <= 175)))
+                                {
+                                        /* Now follows a 16-bit integer value. */
+                                        xrecord->I16 = (int16_t) dxf_pair_get_int (&pair);
+                                }
+                                else if ((pair.group_code >= 90) && (pair.group_code <= 99))
+                                {
+                                        /* Now follows a 32-bit integer value. */
+                                        xrecord->I32 = (int32_t) dxf_pair_get_long (&pair);
+                                }
+                                else if ((pair.group_code >= 140) && (pair.group_code <= 147))
+                                {
+                                        /* Now follows a float value. */
+                                        xrecord->F = (float) dxf_pair_get_double (&pair);
+                                }
+                                else if ((pair.group_code >= 280) && (pair.group_code <= 289))
+                                {
+                                        /* Now follows a 8-bit integer value. */
+                                        xrecord->I8 = (int8_t) dxf_pair_get_int (&pair);
+                                }
+                                else
+                                {
+                                        fprintf (stderr,
+                                          (_("Warning in %s () unknown string tag found while reading from: %s in line: %d.\n")),
+                                          __FUNCTION__, fp->filename, fp->line_number);
+                                }
+                                break;
                 }
         }
-        /* Clean up. */
-        free (temp_string);
 #if DEBUG
         DXF_DEBUG_END
 #endif
@@ -371,14 +336,14 @@ dxf_xrecord_write
         if (fp->acad_version_number < AutoCAD_14)
         {
                 fprintf (stderr,
-                  (_("Warning in %s () illegal DXF version for this %s entity with id-code: %x.\n")),
+                  (_("Warning in %s () illegal DXF version for this %s entity with id-code: %lx.\n")),
                   __FUNCTION__, dxf_entity_name, xrecord->id_code);
         }
         /* Start writing output. */
-        fprintf (fp->fp, "  0\n%s\n", dxf_entity_name);
+        dxf_write_string (fp, 0, dxf_entity_name);
         if (xrecord->id_code != -1)
         {
-                fprintf (fp->fp, "  5\n%x\n", xrecord->id_code);
+                dxf_write_hex (fp, 5, xrecord->id_code);
         }
         /*!
          * \todo for version R14.\n
@@ -393,22 +358,21 @@ dxf_xrecord_write
         if ((strcmp (xrecord->dictionary_owner_soft, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_REACTORS\n");
-                fprintf (fp->fp, "330\n%s\n", xrecord->dictionary_owner_soft);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_REACTORS");
+                dxf_write_string (fp, 330, xrecord->dictionary_owner_soft);
+                dxf_write_string (fp, 102, "}");
         }
         if ((strcmp (xrecord->dictionary_owner_hard, "") != 0)
           && (fp->acad_version_number >= AutoCAD_14))
         {
-                fprintf (fp->fp, "102\n{ACAD_XDICTIONARY\n");
-                fprintf (fp->fp, "360\n%s\n", xrecord->dictionary_owner_hard);
-                fprintf (fp->fp, "102\n}\n");
+                dxf_write_string (fp, 102, "{ACAD_XDICTIONARY");
+                dxf_write_string (fp, 360, xrecord->dictionary_owner_hard);
+                dxf_write_string (fp, 102, "}");
         }
         if (fp->acad_version_number >= AutoCAD_13)
         {
-                fprintf (fp->fp, "100\nAcDbXrecord\n");
+                dxf_write_string (fp, 100, "AcDbXrecord");
         }
-        fprintf (fp->fp, "%d\n", xrecord->group_code);
         if
         (
           ((xrecord->group_code >= 1) && (xrecord->group_code <= 9))
@@ -417,14 +381,14 @@ dxf_xrecord_write
           || ((xrecord->group_code >= 300) &&  (xrecord->group_code <= 369))
         )
         {
-                fprintf (fp->fp, "%s\n", xrecord->S);
+                dxf_write_string (fp, xrecord->group_code, xrecord->S);
         }
         else if
         (
           ((xrecord->group_code >= 10) && (xrecord->group_code <= 59))
         )
         {
-                fprintf (fp->fp, "%lf\n", xrecord->D);
+                dxf_write_double (fp, xrecord->group_code, xrecord->D);
         }
         else if
         (
@@ -432,33 +396,33 @@ dxf_xrecord_write
           || ((xrecord->group_code >= 170) && (xrecord->group_code <= 175))
         )
         {
-                fprintf (fp->fp, "%" PRIi16 "\n", xrecord->I16);
+                dxf_write_int (fp, xrecord->group_code, xrecord->I16);
         }
         else if
         (
           ((xrecord->group_code >= 90) && (xrecord->group_code <= 99))
         )
         {
-                fprintf (fp->fp, "%" PRIi32 "\n", xrecord->I32);
+                dxf_write_long (fp, xrecord->group_code, xrecord->I32);
         }
         else if
         (
           ((xrecord->group_code >= 140) && (xrecord->group_code <= 147))
         )
         {
-                fprintf (fp->fp, "%f\n", xrecord->F);
+                dxf_write_double (fp, xrecord->group_code, xrecord->F);
         }
         else if
         (
           ((xrecord->group_code >= 280) && (xrecord->group_code <= 289))
         )
         {
-                fprintf (fp->fp, "%" PRIi8 "\n", xrecord->I8);
+                dxf_write_int (fp, xrecord->group_code, xrecord->I8);
         }
         else
         {
                 fprintf (stderr,
-                  (_("Warning in %s () unknown group code %d found in DxfXrecord struct with id-code: %x.\n")),
+                  (_("Warning in %s () unknown group code %d found in DxfXrecord struct with id-code: %lx.\n")),
                   __FUNCTION__, xrecord->group_code, xrecord->id_code);
         }
         /* Clean up. */
@@ -530,7 +494,7 @@ dxf_xrecord_free_chain
                 /*!< a pointer to the chain of DXF \c XRECORD objects. */
 )
 {
-#ifdef DEBUG
+#if DEBUG
         DXF_DEBUG_BEGIN
 #endif
         if (xrecords == NULL)
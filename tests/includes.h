@@ -39,6 +39,35 @@
 #include "src/dxf.h"
 
 
+/*!
+ * \brief Return \c EXIT_FAILURE from a test function when \c condition
+ * does not hold, reporting the failed condition.
+ */
+#define TEST_CHECK(condition) \
+        if (!(condition)) \
+        { \
+                fprintf (stderr, "TESTS: %s () line %d: %s failed\n", \
+                  __FUNCTION__, __LINE__, #condition); \
+                return (EXIT_FAILURE); \
+        }
+
+
+int test_arena (void);
+int test_columns (void);
+int test_compress (void);
+int test_drawing (void);
+int test_entity_index (void);
+int test_filter (void);
+int test_graphic_properties (void);
+int test_handle_table (void);
+int test_lexer (void);
+int test_number (void);
+int test_packed_vertices (void);
+int test_stream (void);
+int test_string_pool (void);
+int test_vec3 (void);
+
+
 #endif /* LIBDXF_TESTS_INCLUDES_H */
 
 
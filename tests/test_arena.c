@@ -0,0 +1,202 @@
+/*!
+ * \file test_arena.c
+ *
+ * \author Copyright (C) 2017 by the libDXF developers.
+ *
+ * \brief Tests for the region allocator.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#include <stdio.h>
+#include <string.h>
+#include "includes.h"
+
+
+/*!
+ * \brief Count the entities of a drawing which are not memory of an
+ * arena.
+ */
+static void
+test_arena_walk
+(
+        DxfEntityType type,
+                /*!< type of the entity. */
+        void *entity,
+                /*!< the entity. */
+        void *user_data
+                /*!< the number of entities not in an arena. */
+)
+{
+        if (!dxf_arena_owns (entity))
+        {
+                (*(int *) user_data)++;
+        }
+}
+
+
+/*!
+ * \brief Hand out aligned pieces which do not overlap, from small and
+ * from large blocks.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+test_arena_alloc (void)
+{
+        DxfArena *arena;
+        unsigned char *pieces[200];
+        unsigned char *large;
+        size_t size;
+        int i;
+
+        arena = dxf_arena_new ();
+        TEST_CHECK (arena != NULL);
+        /* Blocks of one granule, so that several are needed. */
+        arena->block_size = DXF_ARENA_GRANULE;
+        for (i = 0; i < 200; i++)
+        {
+                size = (size_t) (i % 100) * 20 + 1;
+                pieces[i] = dxf_arena_alloc (arena, size);
+                TEST_CHECK (pieces[i] != NULL);
+                TEST_CHECK (((uintptr_t) pieces[i] % DXF_ARENA_ALIGNMENT) == 0);
+                TEST_CHECK (dxf_arena_owns (pieces[i]));
+                TEST_CHECK (dxf_arena_owns (pieces[i] + size - 1));
+                memset (pieces[i], i, size);
+        }
+        TEST_CHECK ((arena->blocks != NULL) && (arena->blocks->next != NULL));
+        for (i = 0; i < 200; i++)
+        {
+                size = (size_t) (i % 100) * 20 + 1;
+                TEST_CHECK ((pieces[i][0] == (unsigned char) i)
+                  && (pieces[i][size - 1] == (unsigned char) i));
+        }
+        /* Larger than a block. */
+        large = dxf_arena_alloc (arena, 3 * DXF_ARENA_BLOCK_SIZE);
+        TEST_CHECK (large != NULL);
+        TEST_CHECK (dxf_arena_owns (large + 3 * DXF_ARENA_BLOCK_SIZE - 1));
+        memset (large, 0xff, 3 * DXF_ARENA_BLOCK_SIZE);
+        TEST_CHECK (dxf_arena_free (arena) == EXIT_SUCCESS);
+        TEST_CHECK (!dxf_arena_owns (pieces[0]));
+        TEST_CHECK (!dxf_arena_owns (large));
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Take memory from the current arena of a thread, and release
+ * chained arenas at once.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+test_arena_current (void)
+{
+        DxfArena *arena;
+        DxfArena *other;
+        char *string;
+        int *cleared;
+        void *memory;
+        void *own;
+
+        arena = dxf_arena_new ();
+        other = dxf_arena_new ();
+        TEST_CHECK ((arena != NULL) && (other != NULL));
+        TEST_CHECK (dxf_arena_get_current () == NULL);
+        TEST_CHECK (dxf_arena_set_current (arena) == NULL);
+        TEST_CHECK (dxf_arena_get_current () == arena);
+        memory = dxf_malloc (24);
+        string = dxf_strdup ("BYLAYER");
+        cleared = dxf_calloc (16, sizeof (int));
+        TEST_CHECK (dxf_arena_owns (memory));
+        TEST_CHECK (dxf_arena_owns (string) && (strcmp (string, "BYLAYER") == 0));
+        TEST_CHECK (dxf_arena_owns (cleared) && (cleared[0] == 0) && (cleared[15] == 0));
+        /* Memory of an arena is left alone. */
+        dxf_free (memory);
+        TEST_CHECK (dxf_arena_set_current (other) == arena);
+        memory = dxf_malloc (24);
+        TEST_CHECK (dxf_arena_set_current (NULL) == other);
+        own = dxf_malloc (24);
+        TEST_CHECK ((own != NULL) && (!dxf_arena_owns (own)));
+        dxf_free (own);
+        arena->next = other;
+        TEST_CHECK (dxf_arena_free (arena) == EXIT_SUCCESS);
+        TEST_CHECK (!dxf_arena_owns (string));
+        TEST_CHECK (!dxf_arena_owns (memory));
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Read a drawing, whose entities all come from its arenas.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+test_arena_drawing
+(
+        const char *filename
+                /*!< the file to read. */
+)
+{
+        DxfDrawing *drawing;
+        int outside = 0;
+
+        drawing = dxf_drawing_read (filename, 2);
+        TEST_CHECK (drawing != NULL);
+        TEST_CHECK (drawing->arena != NULL);
+        dxf_entities_walk (dxf_drawing_get_entities_list (drawing),
+          test_arena_walk, &outside);
+        dxf_drawing_free (drawing);
+        TEST_CHECK (outside == 0);
+        /* Reading leaves the thread without a current arena. */
+        TEST_CHECK (dxf_arena_get_current () == NULL);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Perform test functions for the arena.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+test_arena (void)
+{
+        TEST_CHECK (test_arena_alloc () == EXIT_SUCCESS);
+        TEST_CHECK (test_arena_current () == EXIT_SUCCESS);
+        TEST_CHECK (test_arena_drawing ("../examples/qcad-example_R12.dxf") == EXIT_SUCCESS);
+        TEST_CHECK (test_arena_drawing ("../examples/all_R10_entities.dxf") == EXIT_SUCCESS);
+        return (EXIT_SUCCESS);
+}
+
+
+/* EOF */
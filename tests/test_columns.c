@@ -0,0 +1,284 @@
+/*!
+ * \file test_columns.c
+ *
+ * \author Copyright (C) 2017 by the libDXF developers.
+ *
+ * \brief Tests for the columnar store of simple entities.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#include <stdio.h>
+#include <string.h>
+#include "includes.h"
+
+
+/*!
+ * \brief State of test_columns_compare_line ().
+ */
+typedef struct
+test_columns_state_struct
+{
+        DxfColumns *columns;
+                /*!< The columns compared with. */
+        int row;
+                /*!< Next row of the \c LINE table. */
+        int different;
+                /*!< Number of \c LINE entities which differ from their
+                 * row. */
+} TestColumnsState;
+
+
+/*!
+ * \brief Compare a \c LINE of a drawing with the next row of the
+ * \c LINE table of the columns.
+ */
+static void
+test_columns_compare_line
+(
+        DxfEntityType type,
+                /*!< type of the entity. */
+        void *entity,
+                /*!< the entity. */
+        void *user_data
+                /*!< the TestColumnsState. */
+)
+{
+        TestColumnsState *state = user_data;
+        DxfColumnsTable *table = &state->columns->line;
+        DxfLine *line = entity;
+        int i = state->row;
+
+        if (type != LINE)
+        {
+                return;
+        }
+        state->row++;
+        if ((i >= table->count)
+          || (table->x0[i] != line->p0.x0)
+          || (table->y0[i] != line->p0.y0)
+          || (table->z0[i] != line->p0.z0)
+          || (table->x1[i] != line->p1.x0)
+          || (table->y1[i] != line->p1.y0)
+          || (table->z1[i] != line->p1.z0)
+          || (table->color[i] != dxf_line_get_color (line))
+          || (strcmp (dxf_columns_get_layer_name (state->columns,
+          table->layer[i]), dxf_line_get_layer (line)) != 0))
+        {
+                state->different++;
+        }
+}
+
+
+/*!
+ * \brief Count the entities of a drawing.
+ */
+static void
+test_columns_walk
+(
+        DxfEntityType type,
+                /*!< type of the entity. */
+        void *entity,
+                /*!< the entity. */
+        void *user_data
+                /*!< the number of entities. */
+)
+{
+        (*(int *) user_data)++;
+}
+
+
+/*!
+ * \brief Check that two columns hold the same rows.
+ *
+ * \return \c TRUE when they do, \c FALSE otherwise.
+ */
+static int
+test_columns_same
+(
+        DxfColumns *a,
+                /*!< columns. */
+        DxfColumns *b
+                /*!< other columns. */
+)
+{
+        DxfEntityType types[] = {LINE, POINT, CIRCLE, ARC};
+        DxfColumnsTable *ta;
+        DxfColumnsTable *tb;
+        size_t k;
+        int i;
+
+        for (k = 0; k < sizeof (types) / sizeof (types[0]); k++)
+        {
+                ta = dxf_columns_get_table (a, types[k]);
+                tb = dxf_columns_get_table (b, types[k]);
+                if (ta->count != tb->count)
+                {
+                        return (FALSE);
+                }
+                for (i = 0; i < ta->count; i++)
+                {
+                        if ((ta->x0[i] != tb->x0[i])
+                          || (ta->y0[i] != tb->y0[i])
+                          || (ta->color[i] != tb->color[i])
+                          || ((ta->radius != NULL) && (ta->radius[i] != tb->radius[i]))
+                          || ((ta->end_angle != NULL) && (ta->end_angle[i] != tb->end_angle[i]))
+                          || ((ta->x1 != NULL) && (ta->x1[i] != tb->x1[i]))
+                          || (strcmp (dxf_columns_get_layer_name (a, ta->layer[i]),
+                          dxf_columns_get_layer_name (b, tb->layer[i])) != 0))
+                        {
+                                return (FALSE);
+                        }
+                }
+        }
+        return (TRUE);
+}
+
+
+/*!
+ * \brief Give layer names ids.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+test_columns_layers (void)
+{
+        DxfColumns *columns;
+        char name[32];
+        int i;
+
+        columns = dxf_columns_new ();
+        TEST_CHECK (columns != NULL);
+        TEST_CHECK (dxf_columns_get_layer_id (columns, "WALLS") == 0);
+        TEST_CHECK (dxf_columns_get_layer_id (columns, "DOORS") == 1);
+        TEST_CHECK (dxf_columns_get_layer_id (columns, "WALLS") == 0);
+        /* Grow the layer index. */
+        for (i = 0; i < 100; i++)
+        {
+                snprintf (name, sizeof (name), "LAYER_%d", i);
+                TEST_CHECK (dxf_columns_get_layer_id (columns, name) == i + 2);
+        }
+        TEST_CHECK (dxf_columns_get_layer_id (columns, "DOORS") == 1);
+        TEST_CHECK (strcmp (dxf_columns_get_layer_name (columns, 0), "WALLS") == 0);
+        TEST_CHECK (strcmp (dxf_columns_get_layer_name (columns, 101), "LAYER_99") == 0);
+        TEST_CHECK (columns->number_of_layers == 102);
+        dxf_columns_free (columns);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Read a drawing into columns, which hold the same \c LINE
+ * entities as the structs of a drawing read the usual way.  Writing the
+ * columns and reading them back gives the same rows.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+test_columns_read
+(
+        const char *filename,
+                /*!< the file to read. */
+        int lines,
+                /*!< the number of \c LINE entities in the file. */
+        int circles,
+                /*!< the number of \c CIRCLE entities in the file. */
+        int arcs,
+                /*!< the number of \c ARC entities in the file. */
+        int others
+                /*!< the number of other entities in the file. */
+)
+{
+        TestColumnsState state;
+        DxfDrawing *columnar;
+        DxfDrawing *parallel;
+        DxfDrawing *drawing;
+        DxfDrawing *back;
+        DxfFile *fp;
+        int count = 0;
+        int same;
+
+        columnar = dxf_drawing_read_columnar (filename, 1, NULL);
+        TEST_CHECK ((columnar != NULL) && (columnar->columns != NULL));
+        TEST_CHECK (columnar->columns->line.count == lines);
+        TEST_CHECK (columnar->columns->point.count == 0);
+        TEST_CHECK (columnar->columns->circle.count == circles);
+        TEST_CHECK (columnar->columns->arc.count == arcs);
+        dxf_entities_walk (dxf_drawing_get_entities_list (columnar),
+          test_columns_walk, &count);
+        TEST_CHECK (count == others);
+        /* The parts read by several threads are joined in order. */
+        parallel = dxf_drawing_read_columnar (filename, 4, NULL);
+        TEST_CHECK (parallel != NULL);
+        same = test_columns_same (columnar->columns, parallel->columns);
+        dxf_drawing_free (parallel);
+        TEST_CHECK (same);
+        memset (&state, 0, sizeof (state));
+        state.columns = columnar->columns;
+        drawing = dxf_drawing_read (filename, 1);
+        TEST_CHECK (drawing != NULL);
+        dxf_entities_walk (dxf_drawing_get_entities_list (drawing),
+          test_columns_compare_line, &state);
+        dxf_drawing_free (drawing);
+        TEST_CHECK ((state.row == lines) && (state.different == 0));
+        fp = dxf_write_init ("test_columns.dxf", FALSE);
+        TEST_CHECK (fp != NULL);
+        dxf_write_string (fp, 0, "SECTION");
+        dxf_write_string (fp, 2, "ENTITIES");
+        TEST_CHECK (dxf_columns_write (fp, columnar->columns) == EXIT_SUCCESS);
+        dxf_write_string (fp, 0, "ENDSEC");
+        dxf_write_string (fp, 0, "EOF");
+        dxf_write_close (fp);
+        back = dxf_drawing_read_columnar ("test_columns.dxf", 1, NULL);
+        remove ("test_columns.dxf");
+        TEST_CHECK (back != NULL);
+        same = test_columns_same (columnar->columns, back->columns);
+        dxf_drawing_free (back);
+        dxf_drawing_free (columnar);
+        TEST_CHECK (same);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Perform test functions for the columnar store.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+test_columns (void)
+{
+        TEST_CHECK (test_columns_layers () == EXIT_SUCCESS);
+        TEST_CHECK (test_columns_read ("../examples/qcad-example_R12.dxf", 25, 1, 1, 3) == EXIT_SUCCESS);
+        return (EXIT_SUCCESS);
+}
+
+
+/* EOF */
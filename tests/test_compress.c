@@ -0,0 +1,243 @@
+/*!
+ * \file test_compress.c
+ *
+ * \author Copyright (C) 2017 by the libDXF developers.
+ *
+ * \brief Tests for reading and writing compressed DXF files.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include "includes.h"
+
+
+/*!
+ * \brief Read the pairs of two files, both give the same values.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+test_compress_same_pairs
+(
+        DxfFile *a,
+                /*!< the file written. */
+        DxfFile *b
+                /*!< the file read back. */
+)
+{
+        DxfPair pa;
+        DxfPair pb;
+        char ta[DXF_MAX_STRING_LENGTH];
+        char tb[DXF_MAX_STRING_LENGTH];
+        int ra;
+        int rb;
+        int count = 0;
+
+        do
+        {
+                ra = dxf_lexer_read_pair (a, &pa);
+                rb = dxf_lexer_read_pair (b, &pb);
+                TEST_CHECK (ra == rb);
+                if (ra != 1)
+                {
+                        break;
+                }
+                TEST_CHECK (pa.group_code == pb.group_code);
+                switch (dxf_lexer_group_code_type (pa.group_code))
+                {
+                        case DXF_GROUP_CODE_TYPE_DOUBLE:
+                                TEST_CHECK (dxf_pair_get_double (&pa) == dxf_pair_get_double (&pb));
+                                break;
+                        case DXF_GROUP_CODE_TYPE_INT16:
+                        case DXF_GROUP_CODE_TYPE_INT32:
+                        case DXF_GROUP_CODE_TYPE_INT64:
+                        case DXF_GROUP_CODE_TYPE_BOOL:
+                                TEST_CHECK (dxf_pair_get_long (&pa) == dxf_pair_get_long (&pb));
+                                break;
+                        default:
+                                dxf_pair_copy_string (&pa, ta, sizeof (ta));
+                                dxf_pair_copy_string (&pb, tb, sizeof (tb));
+                                TEST_CHECK (strcasecmp (ta, tb) == 0);
+                                break;
+                }
+                count++;
+        }
+        while (TRUE);
+        TEST_CHECK (count > 0);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Write every pair of \c filename to the compressed file
+ * \c compressed, then read it back through dxf_read_init () and
+ * through dxf_read_init_mmap ().
+ *
+ * dxf_lexer_detect_binary () looks ahead at the start of the file read
+ * through dxf_read_init () and seeks back, for a Zstandard file that
+ * starts decompressing again.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+test_compress_round_trip
+(
+        const char *filename,
+                /*!< the ASCII file to compress. */
+        const char *compressed,
+                /*!< the compressed file to write. */
+        int binary
+                /*!< write a binary DXF file. */
+)
+{
+        DxfFile *in;
+        DxfFile *out;
+        DxfPair pair;
+        char text[DXF_MAX_STRING_LENGTH];
+        int result;
+
+        in = dxf_read_init (filename);
+        TEST_CHECK (in != NULL);
+        out = dxf_write_init (compressed, binary);
+        TEST_CHECK (out != NULL);
+        while (dxf_lexer_read_pair (in, &pair) == 1)
+        {
+                dxf_pair_copy_string (&pair, text, sizeof (text));
+                TEST_CHECK (dxf_write_string (out, pair.group_code, text) == EXIT_SUCCESS);
+        }
+        dxf_write_close (out);
+        dxf_read_close (in);
+        TEST_CHECK (dxf_compress_detect (compressed)
+          == dxf_compress_from_filename (compressed));
+        in = dxf_read_init (filename);
+        TEST_CHECK (in != NULL);
+        out = dxf_read_init (compressed);
+        TEST_CHECK (out != NULL);
+        TEST_CHECK (dxf_lexer_detect_binary (out) == binary);
+        result = test_compress_same_pairs (in, out);
+        dxf_read_close (in);
+        dxf_read_close (out);
+        TEST_CHECK (result == EXIT_SUCCESS);
+        in = dxf_read_init (filename);
+        TEST_CHECK (in != NULL);
+        out = dxf_read_init_mmap (compressed);
+        remove (compressed);
+        TEST_CHECK (out != NULL);
+        TEST_CHECK (dxf_lexer_detect_binary (out) == binary);
+        result = test_compress_same_pairs (in, out);
+        dxf_read_close (in);
+        dxf_read_close (out);
+        TEST_CHECK (result == EXIT_SUCCESS);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Seek backward and forward in a compressed file which is read,
+ * past the data buffered by stdio, and compare with the plain file.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+test_compress_seek
+(
+        const char *filename,
+                /*!< the plain file. */
+        const char *compressed,
+                /*!< the compressed file to write. */
+        DxfCompression compression
+                /*!< compression format of \c compressed. */
+)
+{
+        static char plain[64 * 1024];
+        static char data[64 * 1024];
+        FILE *fp;
+        size_t size;
+        size_t n;
+
+        fp = fopen (filename, "rb");
+        TEST_CHECK (fp != NULL);
+        size = fread (plain, 1, sizeof (plain), fp);
+        fclose (fp);
+        TEST_CHECK (size == sizeof (plain));
+        fp = dxf_compress_fopen (compressed, "w", compression);
+        TEST_CHECK (fp != NULL);
+        n = fwrite (plain, 1, size, fp);
+        TEST_CHECK (fclose (fp) == 0);
+        TEST_CHECK (n == size);
+        fp = dxf_compress_fopen (compressed, "r", compression);
+        remove (compressed);
+        TEST_CHECK (fp != NULL);
+        n = fread (data, 1, size, fp);
+        TEST_CHECK ((n == size) && (memcmp (data, plain, size) == 0));
+        TEST_CHECK ((fseek (fp, 7, SEEK_SET) == 0) && (ftell (fp) == 7));
+        n = fread (data, 1, 100, fp);
+        TEST_CHECK ((n == 100) && (memcmp (data, plain + 7, 100) == 0));
+        TEST_CHECK ((fseek (fp, 40000, SEEK_CUR) == 0) && (ftell (fp) == 40107));
+        n = fread (data, 1, 100, fp);
+        TEST_CHECK ((n == 100) && (memcmp (data, plain + 40107, 100) == 0));
+        TEST_CHECK ((fseek (fp, 3, SEEK_SET) == 0) && (ftell (fp) == 3));
+        n = fread (data, 1, size - 3, fp);
+        TEST_CHECK ((n == size - 3) && (memcmp (data, plain + 3, size - 3) == 0));
+        fclose (fp);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Perform test functions for compressed files, for each
+ * compression format supported by this build.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+test_compress (void)
+{
+        if (dxf_compress_supported (DXF_COMPRESSION_GZIP))
+        {
+                TEST_CHECK (test_compress_round_trip ("../examples/qcad-example_R2000.dxf", "test_compress.dxf.gz", FALSE) == EXIT_SUCCESS);
+                TEST_CHECK (test_compress_round_trip ("../examples/parametric_constraints_R2010.dxf", "test_compress.dxf.gz", TRUE) == EXIT_SUCCESS);
+                TEST_CHECK (test_compress_seek ("../examples/parametric_constraints_R2010.dxf", "test_compress.dxf.gz", DXF_COMPRESSION_GZIP) == EXIT_SUCCESS);
+        }
+        if (dxf_compress_supported (DXF_COMPRESSION_ZSTD))
+        {
+                TEST_CHECK (test_compress_round_trip ("../examples/qcad-example_R2000.dxf", "test_compress.dxf.zst", FALSE) == EXIT_SUCCESS);
+                TEST_CHECK (test_compress_round_trip ("../examples/parametric_constraints_R2010.dxf", "test_compress.dxf.zst", TRUE) == EXIT_SUCCESS);
+                TEST_CHECK (test_compress_seek ("../examples/parametric_constraints_R2010.dxf", "test_compress.dxf.zst", DXF_COMPRESSION_ZSTD) == EXIT_SUCCESS);
+        }
+        return (EXIT_SUCCESS);
+}
+
+
+/* EOF */
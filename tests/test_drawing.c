@@ -0,0 +1,426 @@
+/*!
+ * \file test_drawing.c
+ *
+ * \author Copyright (C) 2017 by the libDXF developers.
+ *
+ * \brief Tests for reading a drawing concurrently.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#include <stdio.h>
+#include <string.h>
+#include "includes.h"
+
+
+/*!
+ * \brief Entities seen while walking a drawing.
+ */
+typedef struct
+test_drawing_count_struct
+{
+        int count[XLINE + 1];
+                /*!< Number of entities of every type. */
+        int total;
+                /*!< Number of entities. */
+        int in_order;
+                /*!< The \c LINE entities came in the order of their X
+                 * coordinates. */
+} TestDrawingCount;
+
+
+/*!
+ * \brief Count an entity of a drawing.
+ */
+static void
+test_drawing_walk
+(
+        DxfEntityType type,
+                /*!< type of the entity. */
+        void *entity,
+                /*!< the entity. */
+        void *user_data
+                /*!< the TestDrawingCount. */
+)
+{
+        TestDrawingCount *count = user_data;
+
+        if ((type == LINE)
+          && (((DxfLine *) entity)->p0.x0 != (double) count->count[LINE]))
+        {
+                count->in_order = FALSE;
+        }
+        count->count[type]++;
+        count->total++;
+}
+
+
+/*!
+ * \brief Read a drawing with \c threads threads and count its entities.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+test_drawing_count
+(
+        const char *filename,
+                /*!< the file to read. */
+        int threads,
+                /*!< the number of threads to read with. */
+        TestDrawingCount *count
+                /*!< the entities of the drawing. */
+)
+{
+        DxfDrawing *drawing;
+
+        memset (count, 0, sizeof (*count));
+        count->in_order = TRUE;
+        drawing = dxf_drawing_read (filename, threads);
+        TEST_CHECK (drawing != NULL);
+        dxf_entities_walk (dxf_drawing_get_entities_list (drawing),
+          test_drawing_walk, count);
+        dxf_drawing_free (drawing);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Read a drawing in one and in several threads, both give the
+ * same entities.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+test_drawing_same_entities
+(
+        const char *filename,
+                /*!< the file to read. */
+        int total
+                /*!< the number of entities in the file. */
+)
+{
+        TestDrawingCount sequential;
+        TestDrawingCount parallel;
+
+        TEST_CHECK (test_drawing_count (filename, 1, &sequential) == EXIT_SUCCESS);
+        TEST_CHECK (test_drawing_count (filename, 4, &parallel) == EXIT_SUCCESS);
+        TEST_CHECK (sequential.total == total);
+        TEST_CHECK (memcmp (sequential.count, parallel.count, sizeof (parallel.count)) == 0);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Write a drawing with an \c ENTITIES section large enough to be
+ * split, holding \c lines \c LINE entities with the X coordinates 0, 1,
+ * ... and a \c POLYLINE after every 1000 of them.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+test_drawing_write_large
+(
+        const char *filename,
+                /*!< the file to write. */
+        int lines
+                /*!< the number of \c LINE entities. */
+)
+{
+        FILE *fp;
+        int i;
+        int j;
+
+        fp = fopen (filename, "w");
+        TEST_CHECK (fp != NULL);
+        fputs ("  0\nSECTION\n  2\nENTITIES\n", fp);
+        for (i = 0; i < lines; i++)
+        {
+                fprintf (fp, "  0\nLINE\n  8\n0\n 10\n%d.0\n 20\n0.0\n 30\n0.0\n"
+                  " 11\n%d.0\n 21\n1.0\n 31\n0.0\n", i, i);
+                if ((i % 1000) == 999)
+                {
+                        fputs ("  0\nPOLYLINE\n  8\n0\n 66\n1\n", fp);
+                        for (j = 0; j < 3; j++)
+                        {
+                                fprintf (fp, "  0\nVERTEX\n  8\n0\n 10\n%d.0\n 20\n0.0\n 30\n0.0\n", j);
+                        }
+                        fputs ("  0\nSEQEND\n  8\n0\n", fp);
+                }
+        }
+        fputs ("  0\nENDSEC\n  0\nEOF\n", fp);
+        fclose (fp);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Read a drawing whose \c ENTITIES section is split in parts, the
+ * parts are joined in file order.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+test_drawing_split (void)
+{
+        TestDrawingCount sequential;
+        TestDrawingCount parallel;
+        int result;
+
+        /* About 3 MB, more than two parts of DXF_DRAWING_MIN_CHUNK_SIZE. */
+        TEST_CHECK (test_drawing_write_large ("test_drawing.dxf", 40000) == EXIT_SUCCESS);
+        result = test_drawing_count ("test_drawing.dxf", 1, &sequential);
+        if (result == EXIT_SUCCESS)
+        {
+                result = test_drawing_count ("test_drawing.dxf", 4, &parallel);
+        }
+        remove ("test_drawing.dxf");
+        TEST_CHECK (result == EXIT_SUCCESS);
+        TEST_CHECK (sequential.count[LINE] == 40000);
+        TEST_CHECK (sequential.count[POLYLINE] == 40);
+        TEST_CHECK (memcmp (sequential.count, parallel.count, sizeof (parallel.count)) == 0);
+        TEST_CHECK (sequential.in_order && parallel.in_order);
+        return (EXIT_SUCCESS);
+}
+
+/*!
+ * \brief Read the whole of \c filename into a newly allocated buffer.
+ *
+ * \return the buffer, to be freed with \c free (), or \c NULL when an
+ * error occurred.
+ */
+static char *
+test_drawing_slurp
+(
+        const char *filename,
+                /*!< the file to read. */
+        size_t *size
+                /*!< returns the size of the file in bytes. */
+)
+{
+        FILE *fp;
+        char *buffer;
+        long length;
+
+        fp = fopen (filename, "rb");
+        if (fp == NULL)
+        {
+                return (NULL);
+        }
+        fseek (fp, 0, SEEK_END);
+        length = ftell (fp);
+        rewind (fp);
+        buffer = (length > 0) ? malloc ((size_t) length) : NULL;
+        if ((buffer != NULL)
+          && (fread (buffer, 1, (size_t) length, fp) != (size_t) length))
+        {
+                free (buffer);
+                buffer = NULL;
+        }
+        fclose (fp);
+        *size = (size_t) length;
+        return (buffer);
+}
+
+
+/*!
+ * \brief Write the entities of a drawing with 1, 2, 4 and 7 threads,
+ * all give the same bytes.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+test_drawing_write_threads
+(
+        int binary
+                /*!< write a binary DXF file. */
+)
+{
+        static const int threads[] = {1, 2, 4, 7};
+        DxfDrawing *drawing;
+        DxfFile *fp;
+        char *first = NULL;
+        char *next;
+        size_t first_size = 0;
+        size_t next_size;
+        size_t i;
+        int same = TRUE;
+
+        /* Enough entities for dxf_entities_write () to hand out jobs
+         * to 7 threads. */
+        TEST_CHECK (test_drawing_write_large ("test_drawing.dxf", 20000) == EXIT_SUCCESS);
+        drawing = dxf_drawing_read ("test_drawing.dxf", 4);
+        remove ("test_drawing.dxf");
+        TEST_CHECK (drawing != NULL);
+        for (i = 0; same && (i < sizeof (threads) / sizeof (threads[0])); i++)
+        {
+                fp = dxf_write_init ("test_drawing_write.dxf", binary);
+                same = (fp != NULL)
+                  && (dxf_entities_write (fp, dxf_drawing_get_entities_list (drawing),
+                  threads[i]) == EXIT_SUCCESS);
+                if (fp != NULL)
+                {
+                        dxf_write_close (fp);
+                }
+                next = test_drawing_slurp ("test_drawing_write.dxf", &next_size);
+                remove ("test_drawing_write.dxf");
+                same = same && (next != NULL);
+                if (first == NULL)
+                {
+                        first = next;
+                        first_size = next_size;
+                }
+                else
+                {
+                        same = same && (next_size == first_size)
+                          && (memcmp (next, first, first_size) == 0);
+                        free (next);
+                }
+        }
+        free (first);
+        dxf_drawing_free (drawing);
+        TEST_CHECK (same);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Read the \c TABLES section of a drawing, every table into its
+ * own list.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+test_drawing_tables
+(
+        const char *filename,
+                /*!< the file to read. */
+        int ltypes,
+                /*!< the number of \c LTYPE records in the file. */
+        int block_records
+                /*!< the number of \c BLOCK_RECORD records in the file. */
+)
+{
+        DxfDrawing *drawing;
+        DxfTables *tables;
+        DxfLType *ltype;
+        DxfBlockRecord *block_record;
+        int count;
+
+        drawing = dxf_drawing_read (filename, 2);
+        TEST_CHECK (drawing != NULL);
+        tables = (DxfTables *) drawing->tables_list;
+        TEST_CHECK (tables != NULL);
+        TEST_CHECK (tables->layers != NULL);
+        TEST_CHECK (strcmp (((DxfLayer *) tables->layers)->layer_name, "0") == 0);
+        TEST_CHECK (((DxfLayer *) tables->layers)->next == NULL);
+        TEST_CHECK (tables->styles != NULL);
+        TEST_CHECK (tables->vports != NULL);
+        TEST_CHECK (tables->appids != NULL);
+        TEST_CHECK (tables->dimstyles != NULL);
+        count = 0;
+        for (ltype = (DxfLType *) tables->ltypes; ltype != NULL; ltype = (DxfLType *) ltype->next)
+        {
+                count++;
+        }
+        TEST_CHECK (count == ltypes);
+        count = 0;
+        for (block_record = (DxfBlockRecord *) tables->block_records; block_record != NULL; block_record = (DxfBlockRecord *) block_record->next)
+        {
+                count++;
+        }
+        TEST_CHECK (count == block_records);
+        dxf_drawing_free (drawing);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Read a drawing of which one section can not be read, which
+ * fails the drawing.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+test_drawing_bad_section
+(
+        const char *section
+                /*!< the groups of the section, from its name on. */
+)
+{
+        FILE *fp;
+        DxfDrawing *drawing;
+
+        fp = fopen ("test_drawing_bad.dxf", "w");
+        TEST_CHECK (fp != NULL);
+        fprintf (fp, "  0\nSECTION\n  2\n%s  0\nENDSEC\n", section);
+        fputs ("  0\nSECTION\n  2\nENTITIES\n"
+          "  0\nLINE\n  8\n0\n 10\n0.0\n 20\n0.0\n 30\n0.0\n"
+          " 11\n1.0\n 21\n1.0\n 31\n0.0\n"
+          "  0\nENDSEC\n  0\nEOF\n", fp);
+        fclose (fp);
+        drawing = dxf_drawing_read ("test_drawing_bad.dxf", 1);
+        remove ("test_drawing_bad.dxf");
+        TEST_CHECK (drawing == NULL);
+        return (EXIT_SUCCESS);
+}
+
+
+
+/*!
+ * \brief Perform test functions for reading a drawing.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+test_drawing (void)
+{
+        TEST_CHECK (test_drawing_same_entities ("../examples/all_R10_entities.dxf", 15) == EXIT_SUCCESS);
+        TEST_CHECK (test_drawing_same_entities ("../examples/qcad-example_R12.dxf", 30) == EXIT_SUCCESS);
+        TEST_CHECK (test_drawing_same_entities ("../examples/qcad-example_R2000.dxf", 14) == EXIT_SUCCESS);
+        TEST_CHECK (test_drawing_same_entities ("../examples/zcad-teapot_R2000.dxf", 1152) == EXIT_SUCCESS);
+        TEST_CHECK (test_drawing_same_entities ("../examples/parametric_constraints_R2010.dxf", 9) == EXIT_SUCCESS);
+        TEST_CHECK (test_drawing_split () == EXIT_SUCCESS);
+        TEST_CHECK (test_drawing_write_threads (FALSE) == EXIT_SUCCESS);
+        TEST_CHECK (test_drawing_write_threads (TRUE) == EXIT_SUCCESS);
+        TEST_CHECK (test_drawing_tables ("../examples/qcad-example_R12.dxf", 19, 0) == EXIT_SUCCESS);
+        TEST_CHECK (test_drawing_tables ("../examples/qcad-example_R2000.dxf", 21, 3) == EXIT_SUCCESS);
+        /* A CLASS without a record name, a LAYER without a name. */
+        TEST_CHECK (test_drawing_bad_section ("CLASSES\n  0\nCLASS\n  2\nAcDbTest\n  3\nTest\n") == EXIT_SUCCESS);
+        TEST_CHECK (test_drawing_bad_section ("TABLES\n  0\nTABLE\n  2\nLAYER\n 70\n1\n  0\nLAYER\n 62\n7\n  0\nENDTAB\n") == EXIT_SUCCESS);
+        return (EXIT_SUCCESS);
+}
+
+
+/* EOF */
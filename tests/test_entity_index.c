@@ -0,0 +1,306 @@
+/*!
+ * \file test_entity_index.c
+ *
+ * \author Copyright (C) 2017 by the libDXF developers.
+ *
+ * \brief Tests for the lazily decoded entity index.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#include <stdio.h>
+#include <string.h>
+#include "includes.h"
+
+
+/*!
+ * \brief Decode every record of an index, all of which can be decoded.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+test_entity_index_get_all
+(
+        const char *filename,
+                /*!< the file to index. */
+        int count
+                /*!< the number of records in the index. */
+)
+{
+        DxfEntityIndex *index;
+        int i;
+
+        index = dxf_entity_index_open (filename);
+        TEST_CHECK (index != NULL);
+        TEST_CHECK (index->count == count);
+        for (i = 0; i < index->count; i++)
+        {
+                TEST_CHECK (index->records[i].type != UNKNOWN_ENTITY);
+                TEST_CHECK (dxf_entity_index_get (index, i) != NULL);
+        }
+        dxf_entity_index_close (index);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Test if the files \c a and \c b have the same contents.
+ *
+ * \return \c TRUE when they have, \c FALSE otherwise.
+ */
+static int
+test_entity_index_same_file
+(
+        const char *a,
+                /*!< a file. */
+        const char *b
+                /*!< another file. */
+)
+{
+        FILE *fa;
+        FILE *fb;
+        int ca;
+        int cb;
+
+        fa = fopen (a, "rb");
+        fb = fopen (b, "rb");
+        if ((fa == NULL) || (fb == NULL))
+        {
+                if (fa != NULL)
+                {
+                        fclose (fa);
+                }
+                if (fb != NULL)
+                {
+                        fclose (fb);
+                }
+                return (FALSE);
+        }
+        do
+        {
+                ca = fgetc (fa);
+                cb = fgetc (fb);
+        }
+        while ((ca == cb) && (ca != EOF));
+        fclose (fa);
+        fclose (fb);
+        return (ca == cb);
+}
+
+
+/*!
+ * \brief Count the group code 5 lines of an ASCII DXF file.
+ *
+ * \return the number of handles, or -1 when the file can not be read.
+ */
+static int
+test_entity_index_count_handles
+(
+        const char *filename
+                /*!< the file. */
+)
+{
+        FILE *fp;
+        char line[DXF_MAX_STRING_LENGTH];
+        int count = 0;
+        int code = TRUE;
+
+        fp = fopen (filename, "r");
+        if (fp == NULL)
+        {
+                return (-1);
+        }
+        /* Group code and value lines alternate. */
+        while (fgets (line, sizeof (line), fp) != NULL)
+        {
+                if (code && (strcmp (line, "  5\n") == 0))
+                {
+                        count++;
+                }
+                code = !code;
+        }
+        fclose (fp);
+        return (count);
+}
+
+
+/*!
+ * \brief Save an index without changes, which copies the file.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+test_entity_index_save_unchanged
+(
+        const char *filename
+                /*!< the file to index. */
+)
+{
+        DxfEntityIndex *index;
+        int result;
+
+        index = dxf_entity_index_open (filename);
+        TEST_CHECK (index != NULL);
+        result = dxf_entity_index_save (index, "test_entity_index.dxf");
+        dxf_entity_index_close (index);
+        TEST_CHECK (result == EXIT_SUCCESS);
+        result = test_entity_index_same_file (filename, "test_entity_index.dxf");
+        remove ("test_entity_index.dxf");
+        TEST_CHECK (result);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Save an R12 index with a changed \c LINE which was read
+ * without a handle, it is written without one.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+test_entity_index_save_without_handle
+(
+        const char *filename
+                /*!< the file to index, an R12 file. */
+)
+{
+        DxfEntityIndex *index;
+        DxfLine *line = NULL;
+        int handles;
+        int result;
+        int i;
+
+        index = dxf_entity_index_open (filename);
+        TEST_CHECK (index != NULL);
+        for (i = 0; (i < index->count) && (line == NULL); i++)
+        {
+                if ((index->records[i].type == LINE)
+                  && (index->records[i].id_code == 0))
+                {
+                        line = dxf_entity_index_get (index, i);
+                        TEST_CHECK (line != NULL);
+                        dxf_line_set_color (line, 1);
+                        TEST_CHECK (dxf_entity_index_set_dirty (index, i) == EXIT_SUCCESS);
+                }
+        }
+        TEST_CHECK (line != NULL);
+        result = dxf_entity_index_save (index, "test_entity_index.dxf");
+        dxf_entity_index_close (index);
+        TEST_CHECK (result == EXIT_SUCCESS);
+        handles = test_entity_index_count_handles ("test_entity_index.dxf");
+        remove ("test_entity_index.dxf");
+        TEST_CHECK (handles == test_entity_index_count_handles (filename));
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Change, delete and add entities, and read the saved file back.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+test_entity_index_save_changed
+(
+        const char *filename
+                /*!< the file to index, holding at least one \c LINE
+                 * followed by another entity. */
+)
+{
+        DxfEntityIndex *index;
+        DxfLine *line = NULL;
+        int count;
+        int changed = -1;
+        int result;
+        int i;
+
+        index = dxf_entity_index_open (filename);
+        TEST_CHECK (index != NULL);
+        count = index->count;
+        for (i = 0; (i < index->count) && (changed == -1); i++)
+        {
+                if (index->records[i].type == LINE)
+                {
+                        changed = i;
+                }
+        }
+        TEST_CHECK ((changed != -1) && (changed < count - 1));
+        line = dxf_entity_index_get (index, changed);
+        TEST_CHECK (line != NULL);
+        dxf_line_set_color (line, 3);
+        TEST_CHECK (dxf_entity_index_set_dirty (index, changed) == EXIT_SUCCESS);
+        TEST_CHECK (dxf_entity_index_delete (index, count - 1) == EXIT_SUCCESS);
+        line = dxf_line_init (dxf_line_new ());
+        TEST_CHECK (line != NULL);
+        dxf_line_set_layer (line, "0");
+        line->p0.x0 = 123.5;
+        TEST_CHECK (dxf_entity_index_add_entity (index, LINE, line) != -1);
+        result = dxf_entity_index_save (index, "test_entity_index.dxf");
+        dxf_entity_index_close (index);
+        TEST_CHECK (result == EXIT_SUCCESS);
+        index = dxf_entity_index_open ("test_entity_index.dxf");
+        remove ("test_entity_index.dxf");
+        TEST_CHECK (index != NULL);
+        TEST_CHECK (index->count == count);
+        line = dxf_entity_index_get (index, changed);
+        TEST_CHECK ((line != NULL) && (index->records[changed].type == LINE));
+        TEST_CHECK (dxf_line_get_color (line) == 3);
+        line = dxf_entity_index_get (index, count - 1);
+        TEST_CHECK ((line != NULL) && (index->records[count - 1].type == LINE));
+        TEST_CHECK (line->p0.x0 == 123.5);
+        dxf_entity_index_close (index);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Perform test functions for the entity index.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+test_entity_index (void)
+{
+        /* Holds a DIMENSION. */
+        TEST_CHECK (test_entity_index_get_all ("../examples/qcad-example_R2000.dxf", 14) == EXIT_SUCCESS);
+        /* VERTEX and SEQEND are records of their own. */
+        TEST_CHECK (test_entity_index_get_all ("../examples/all_R10_entities.dxf", 22) == EXIT_SUCCESS);
+        TEST_CHECK (test_entity_index_save_unchanged ("../examples/qcad-example_R12.dxf") == EXIT_SUCCESS);
+        TEST_CHECK (test_entity_index_save_unchanged ("../examples/qcad-example_R2000.dxf") == EXIT_SUCCESS);
+        TEST_CHECK (test_entity_index_save_without_handle ("../examples/qcad-example_R12.dxf") == EXIT_SUCCESS);
+        TEST_CHECK (test_entity_index_save_changed ("../examples/qcad-example_R12.dxf") == EXIT_SUCCESS);
+        TEST_CHECK (test_entity_index_save_changed ("../examples/qcad-example_R2000.dxf") == EXIT_SUCCESS);
+        return (EXIT_SUCCESS);
+}
+
+
+/* EOF */
@@ -0,0 +1,196 @@
+/*!
+ * \file test_filter.c
+ *
+ * \author Copyright (C) 2017 by the libDXF developers.
+ *
+ * \brief Tests for the read-time entity filter.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#include <stdio.h>
+#include <string.h>
+#include "includes.h"
+
+
+/*!
+ * \brief Entities of the file written by test_filter_write ().
+ */
+static const char *test_filter_entities =
+        "  0\nSECTION\n  2\nENTITIES\n"
+        "  0\nLINE\n  8\nWALL_1\n 10\n0.0\n 20\n0.0\n 11\n1.0\n 21\n1.0\n"
+        "  0\nLINE\n  8\nwall_2\n 10\n10.0\n 20\n10.0\n 11\n11.0\n 21\n11.0\n"
+        "  0\nCIRCLE\n  8\nDOOR\n 10\n0.5\n 20\n0.5\n 40\n1.0\n"
+        "  0\nLINE\n  8\nDOOR\n 67\n1\n 10\n5.0\n 20\n5.0\n 11\n1.5\n 21\n1.5\n"
+        "  0\nPOINT\n  8\nWALL_1\n 10\n20.0\n 20\n20.0\n"
+        "  0\nPOINT\n 10\n0.0\n 20\n0.0\n"
+        "  0\nENDSEC\n  0\nEOF\n";
+
+
+/*!
+ * \brief Count an entity of a drawing.
+ */
+static void
+test_filter_walk
+(
+        DxfEntityType type,
+                /*!< type of the entity. */
+        void *entity,
+                /*!< the entity. */
+        void *user_data
+                /*!< the number of entities. */
+)
+{
+        (*(int *) user_data)++;
+}
+
+
+/*!
+ * \brief Read \c filename with \c filter and count the entities read.
+ *
+ * \return the number of entities, or -1 when the file could not be
+ * read.
+ */
+static int
+test_filter_count
+(
+        const char *filename,
+                /*!< the file to read. */
+        DxfFilter *filter
+                /*!< the filter, freed here. */
+)
+{
+        DxfDrawing *drawing;
+        int count = 0;
+
+        drawing = dxf_drawing_read_filtered (filename, 1, filter);
+        dxf_filter_free (filter);
+        if (drawing == NULL)
+        {
+                return (-1);
+        }
+        dxf_entities_walk (dxf_drawing_get_entities_list (drawing),
+          test_filter_walk, &count);
+        dxf_drawing_free (drawing);
+        return (count);
+}
+
+
+/*!
+ * \brief Match layer names against patterns.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+test_filter_match_layer (void)
+{
+        TEST_CHECK (dxf_filter_match_layer ("*", ""));
+        TEST_CHECK (dxf_filter_match_layer ("*", "WALL"));
+        TEST_CHECK (dxf_filter_match_layer ("wall", "WALL"));
+        TEST_CHECK (dxf_filter_match_layer ("W?LL", "wall"));
+        TEST_CHECK (dxf_filter_match_layer ("W*_*", "WALL_1"));
+        TEST_CHECK (dxf_filter_match_layer ("*1", "WALL_1"));
+        TEST_CHECK (!dxf_filter_match_layer ("W?LL", "WLL"));
+        TEST_CHECK (!dxf_filter_match_layer ("WALL", "WALL_1"));
+        TEST_CHECK (!dxf_filter_match_layer ("*2", "WALL_1"));
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Read a small drawing with filters on every criterion.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+test_filter_read (void)
+{
+        const char *filename = "test_filter.dxf";
+        DxfFilter *filter;
+        FILE *fp;
+        int counts[7];
+
+        fp = fopen (filename, "w");
+        TEST_CHECK (fp != NULL);
+        fputs (test_filter_entities, fp);
+        fclose (fp);
+        counts[0] = test_filter_count (filename, NULL);
+        filter = dxf_filter_init (dxf_filter_new ());
+        dxf_filter_add_type (filter, LINE);
+        counts[1] = test_filter_count (filename, filter);
+        filter = dxf_filter_init (dxf_filter_new ());
+        dxf_filter_add_layer (filter, "WALL_?");
+        counts[2] = test_filter_count (filename, filter);
+        /* An entity without a layer is on layer 0. */
+        filter = dxf_filter_init (dxf_filter_new ());
+        dxf_filter_add_layer (filter, "DOOR");
+        dxf_filter_add_layer (filter, "0");
+        counts[3] = test_filter_count (filename, filter);
+        filter = dxf_filter_init (dxf_filter_new ());
+        dxf_filter_set_paperspace (filter, DXF_PAPERSPACE);
+        counts[4] = test_filter_count (filename, filter);
+        /* Any point of an entity may lie inside, corners in any order. */
+        filter = dxf_filter_init (dxf_filter_new ());
+        dxf_filter_set_window (filter, 2.0, 2.0, -1.0, -1.0);
+        counts[5] = test_filter_count (filename, filter);
+        filter = dxf_filter_init (dxf_filter_new ());
+        dxf_filter_add_type (filter, LINE);
+        dxf_filter_add_type (filter, POINT);
+        dxf_filter_add_layer (filter, "wall*");
+        dxf_filter_set_paperspace (filter, DXF_MODELSPACE);
+        dxf_filter_set_window (filter, -1.0, -1.0, 2.0, 2.0);
+        counts[6] = test_filter_count (filename, filter);
+        remove (filename);
+        TEST_CHECK (counts[0] == 6);
+        TEST_CHECK (counts[1] == 3);
+        TEST_CHECK (counts[2] == 3);
+        TEST_CHECK (counts[3] == 3);
+        TEST_CHECK (counts[4] == 1);
+        TEST_CHECK (counts[5] == 4);
+        TEST_CHECK (counts[6] == 1);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Perform test functions for the entity filter.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+test_filter (void)
+{
+        TEST_CHECK (test_filter_match_layer () == EXIT_SUCCESS);
+        TEST_CHECK (test_filter_read () == EXIT_SUCCESS);
+        return (EXIT_SUCCESS);
+}
+
+
+/* EOF */
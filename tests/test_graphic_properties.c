@@ -0,0 +1,301 @@
+/*!
+ * \file test_graphic_properties.c
+ *
+ * \author Copyright (C) 2017 by the libDXF developers.
+ *
+ * \brief Tests for the shared graphic property records.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#include <stdio.h>
+#include <string.h>
+#include "includes.h"
+
+
+/*!
+ * \brief State of test_graphic_properties_line ().
+ */
+typedef struct
+test_graphic_properties_state_struct
+{
+        DxfGraphicPropertiesPool *pool;
+                /*!< The pool of the drawing. */
+        DxfLine *first;
+                /*!< The first \c LINE of the drawing. */
+        DxfLine *second;
+                /*!< The second \c LINE of the drawing. */
+        int lines;
+                /*!< Number of \c LINE entities. */
+        int different;
+                /*!< Number of \c LINE entities which do not have the
+                 * record of the first \c LINE, or whose record is not
+                 * in the pool. */
+} TestGraphicPropertiesState;
+
+
+/*!
+ * \brief Check the record of a \c LINE read in a drawing whose entities
+ * all have the same properties.
+ */
+static void
+test_graphic_properties_line
+(
+        DxfEntityType type,
+                /*!< type of the entity. */
+        void *entity,
+                /*!< the entity. */
+        void *user_data
+                /*!< the TestGraphicPropertiesState. */
+)
+{
+        TestGraphicPropertiesState *state = user_data;
+        DxfLine *line = entity;
+
+        if (type != LINE)
+        {
+                return;
+        }
+        state->lines++;
+        if (state->first == NULL)
+        {
+                state->first = line;
+        }
+        else if (state->second == NULL)
+        {
+                state->second = line;
+        }
+        if ((line->properties != state->first->properties)
+          || !line->properties->shared
+          || (dxf_graphic_properties_pool_get (state->pool,
+          line->properties->id) != line->properties))
+        {
+                state->different++;
+        }
+}
+
+
+/*!
+ * \brief Share the default record, and copy it on change.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+test_graphic_properties_default (void)
+{
+        DxfGraphicProperties *defaults;
+        DxfGraphicProperties *copy;
+        DxfLine *line;
+        DxfLine *other;
+        int same;
+
+        defaults = dxf_graphic_properties_default ();
+        TEST_CHECK (defaults->shared && (defaults->id == -1));
+        TEST_CHECK (strcmp (defaults->layer, DXF_DEFAULT_LAYER) == 0);
+        TEST_CHECK (strcmp (defaults->linetype, DXF_DEFAULT_LINETYPE) == 0);
+        TEST_CHECK (defaults->color == DXF_COLOR_BYLAYER);
+        /* A shared record is not freed, and copied by sharing it. */
+        TEST_CHECK (dxf_graphic_properties_free (defaults) == EXIT_SUCCESS);
+        TEST_CHECK (dxf_graphic_properties_copy (defaults) == defaults);
+        line = dxf_line_init (dxf_line_new ());
+        other = dxf_line_init (dxf_line_new ());
+        TEST_CHECK ((line != NULL) && (other != NULL));
+        TEST_CHECK ((line->properties == defaults) && (other->properties == defaults));
+        /* A setter gives the entity a record of its own. */
+        dxf_line_set_color (line, 5);
+        dxf_line_set_layer (line, "WALLS");
+        same = (line->properties != defaults)
+          && !line->properties->shared
+          && (dxf_line_get_color (line) == 5)
+          && (strcmp (dxf_line_get_layer (line), "WALLS") == 0)
+          && (other->properties == defaults)
+          && (defaults->color == DXF_COLOR_BYLAYER)
+          && (strcmp (defaults->layer, DXF_DEFAULT_LAYER) == 0);
+        /* A private record is copied with its strings. */
+        copy = dxf_graphic_properties_copy (line->properties);
+        same = same && (copy != NULL) && (copy != line->properties)
+          && !copy->shared && (copy->color == 5)
+          && (copy->layer != line->properties->layer)
+          && (strcmp (copy->layer, "WALLS") == 0);
+        dxf_graphic_properties_free (copy);
+        TEST_CHECK (dxf_graphic_properties_unshare (&line->properties) == line->properties);
+        dxf_line_free (line);
+        dxf_line_free (other);
+        TEST_CHECK (same);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Intern records in a pool, equal properties give the same
+ * record.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+test_graphic_properties_pool (void)
+{
+        DxfGraphicPropertiesPool *pool;
+        DxfGraphicProperties properties;
+        DxfGraphicProperties *red;
+        DxfGraphicProperties *record;
+        DxfStringPool *strings;
+        char layer[32];
+        int failed = 0;
+        int i;
+
+        strings = dxf_string_pool_new ();
+        TEST_CHECK (strings != NULL);
+        pool = dxf_graphic_properties_pool_new (strings);
+        TEST_CHECK (pool != NULL);
+        properties = *dxf_graphic_properties_default ();
+        properties.color = 1;
+        red = dxf_graphic_properties_pool_intern (pool, &properties);
+        if ((red == NULL) || !red->shared || (red->id != 0)
+          || (red->layer == properties.layer))
+        {
+                failed++;
+        }
+        /* Equal strings at other addresses give the same record. */
+        snprintf (layer, sizeof (layer), "%s", DXF_DEFAULT_LAYER);
+        properties.layer = layer;
+        if (dxf_graphic_properties_pool_intern (pool, &properties) != red)
+        {
+                failed++;
+        }
+        /* Grow the pool, the records keep their address and id. */
+        for (i = 0; i < 10 * DXF_GRAPHIC_PROPERTIES_MIN_CAPACITY; i++)
+        {
+                snprintf (layer, sizeof (layer), "LAYER_%d", i);
+                record = dxf_graphic_properties_pool_intern (pool, &properties);
+                if ((record == NULL) || (record->id != i + 1))
+                {
+                        failed++;
+                }
+        }
+        if ((dxf_graphic_properties_pool_count (pool) != (size_t) (10 * DXF_GRAPHIC_PROPERTIES_MIN_CAPACITY + 1))
+          || (dxf_graphic_properties_pool_get (pool, 0) != red)
+          || (red->color != 1)
+          || (dxf_graphic_properties_pool_get (pool, 10 * DXF_GRAPHIC_PROPERTIES_MIN_CAPACITY + 1) != NULL))
+        {
+                failed++;
+        }
+        snprintf (layer, sizeof (layer), "LAYER_%d", 7);
+        record = dxf_graphic_properties_pool_intern (pool, &properties);
+        if ((record == NULL) || (record->id != 8))
+        {
+                failed++;
+        }
+        /* The color is part of the record. */
+        properties.color = 2;
+        record = dxf_graphic_properties_pool_intern (pool, &properties);
+        if ((record == NULL) || (record->id != 10 * DXF_GRAPHIC_PROPERTIES_MIN_CAPACITY + 1))
+        {
+                failed++;
+        }
+        dxf_graphic_properties_pool_free (pool);
+        dxf_string_pool_free (strings);
+        TEST_CHECK (failed == 0);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Read a drawing whose entities all have the same properties,
+ * they share a record of the pool of the drawing.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+test_graphic_properties_read
+(
+        const char *filename,
+                /*!< the file to read, its entities all have the same
+                 * properties. */
+        int threads,
+                /*!< number of threads to read with. */
+        int lines
+                /*!< the number of \c LINE entities in the file. */
+)
+{
+        TestGraphicPropertiesState state;
+        DxfGraphicProperties *shared;
+        DxfDrawing *drawing;
+        DxfArena *previous;
+        int same;
+
+        drawing = dxf_drawing_read (filename, threads);
+        TEST_CHECK ((drawing != NULL) && (drawing->properties != NULL));
+        memset (&state, 0, sizeof (state));
+        state.pool = drawing->properties;
+        dxf_entities_walk (dxf_drawing_get_entities_list (drawing),
+          test_graphic_properties_line, &state);
+        same = (state.lines == lines) && (state.different == 0)
+          && (state.second != NULL);
+        if (same)
+        {
+                /* Changing one entity leaves the others alone, what
+                 * its setter allocates is released with the drawing. */
+                shared = state.second->properties;
+                previous = dxf_arena_set_current (drawing->arena);
+                dxf_line_set_color (state.first, 3);
+                dxf_arena_set_current (previous);
+                same = (state.first->properties != shared)
+                  && !state.first->properties->shared
+                  && (state.second->properties == shared)
+                  && (dxf_line_get_color (state.second) == shared->color)
+                  && (shared->color != 3);
+        }
+        dxf_drawing_free (drawing);
+        TEST_CHECK (same);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Perform test functions for the shared graphic property
+ * records.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+test_graphic_properties (void)
+{
+        TEST_CHECK (test_graphic_properties_default () == EXIT_SUCCESS);
+        TEST_CHECK (test_graphic_properties_pool () == EXIT_SUCCESS);
+        TEST_CHECK (test_graphic_properties_read ("../examples/qcad-example_R12.dxf", 1, 25) == EXIT_SUCCESS);
+        /* The threads reading the sections share the pool. */
+        TEST_CHECK (test_graphic_properties_read ("../examples/qcad-example_R12.dxf", 4, 25) == EXIT_SUCCESS);
+        return (EXIT_SUCCESS);
+}
+
+
+/* EOF */
@@ -0,0 +1,312 @@
+/*!
+ * \file test_handle_table.c
+ *
+ * \author Copyright (C) 2017 by the libDXF developers.
+ *
+ * \brief Tests for the table of handles of a drawing.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#include <stdio.h>
+#include <string.h>
+#include "includes.h"
+
+
+/*!
+ * \brief State of test_handle_table_find ().
+ */
+typedef struct
+test_handle_table_state_struct
+{
+        DxfDrawing *drawing;
+                /*!< the drawing walked. */
+        int found;
+                /*!< Number of entities found by their handle. */
+        int failed;
+                /*!< Number of entities not found by their handle. */
+} TestHandleTableState;
+
+
+/*!
+ * \brief Look up the handle of an entity of a drawing.
+ */
+static void
+test_handle_table_find
+(
+        DxfEntityType type,
+                /*!< type of the entity. */
+        void *entity,
+                /*!< the entity. */
+        void *user_data
+                /*!< the TestHandleTableState. */
+)
+{
+        TestHandleTableState *state = user_data;
+        DxfHandleEntry *entry;
+        long id_code;
+
+        id_code = dxf_entities_get_id_code (type, entity);
+        if (id_code <= 0)
+        {
+                return;
+        }
+        entry = dxf_drawing_lookup_handle (state->drawing, (uint64_t) id_code);
+        if ((entry != NULL)
+          && (entry->kind == DXF_HANDLE_KIND_ENTITY)
+          && (entry->type == type)
+          && (entry->object == entity))
+        {
+                state->found++;
+        }
+        else
+        {
+                state->failed++;
+        }
+}
+
+
+/*!
+ * \brief State of test_handle_table_resolve ().
+ */
+typedef struct
+test_handle_table_pointers_struct
+{
+        DxfDrawing *drawing;
+                /*!< the drawing resolved. */
+        int pointers;
+                /*!< Number of pointers. */
+        int resolved;
+                /*!< Number of pointers to a record of the drawing. */
+        int owners;
+                /*!< Number of soft owners of the blocks and entities
+                 * resolved to a \c BLOCK_RECORD table record. */
+        int wrong;
+                /*!< Number of pointers resolved to an entry which is
+                 * not the one carrying its handle. */
+} TestHandleTablePointers;
+
+
+/*!
+ * \brief Check a pointer resolved by dxf_drawing_resolve_handles ().
+ */
+static void
+test_handle_table_resolve
+(
+        DxfHandleEntry *from,
+                /*!< the record pointing. */
+        int group_code,
+                /*!< group code of the pointer. */
+        DxfHandleEntry *to,
+                /*!< the record pointed to, or \c NULL. */
+        void *user_data
+                /*!< the TestHandleTablePointers. */
+)
+{
+        TestHandleTablePointers *state = user_data;
+
+        if ((from == NULL) || (from->object == NULL))
+        {
+                state->wrong++;
+                return;
+        }
+        state->pointers++;
+        if (to == NULL)
+        {
+                return;
+        }
+        state->resolved++;
+        if ((to->object == NULL)
+          || (dxf_drawing_lookup_handle (state->drawing, to->handle) != to))
+        {
+                state->wrong++;
+        }
+        if ((group_code == 330)
+          && ((from->kind == DXF_HANDLE_KIND_ENTITY)
+          || (from->kind == DXF_HANDLE_KIND_BLOCK))
+          && (to->kind == DXF_HANDLE_KIND_BLOCK_RECORD))
+        {
+                state->owners++;
+        }
+}
+
+
+/*!
+ * \brief Insert and look up handles, growing the table.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+test_handle_table_insert (void)
+{
+        DxfHandleTable *table;
+        DxfHandleEntry *entry;
+        int objects[1000];
+        int i;
+
+        TEST_CHECK (dxf_handle_parse ("1A") == 26);
+        TEST_CHECK (dxf_handle_parse ("ffffffffff") == 0xffffffffffULL);
+        TEST_CHECK (dxf_handle_parse ("1G") == 0);
+        TEST_CHECK (dxf_handle_parse ("") == 0);
+        TEST_CHECK (dxf_handle_parse (NULL) == 0);
+        table = dxf_handle_table_new (0);
+        TEST_CHECK (table != NULL);
+        for (i = 0; i < 1000; i++)
+        {
+                /* Handles far apart, some above 32 bits. */
+                TEST_CHECK (dxf_handle_table_insert (table,
+                  ((uint64_t) i << 28) + 1, DXF_HANDLE_KIND_ENTITY, LINE,
+                  &objects[i]) == EXIT_SUCCESS);
+        }
+        TEST_CHECK (table->count == 1000);
+        TEST_CHECK (table->capacity >= 2 * table->count);
+        /* The first record keeps its handle, 0 is no handle. */
+        TEST_CHECK (dxf_handle_table_insert (table, 1,
+          DXF_HANDLE_KIND_BLOCK, UNKNOWN_ENTITY, &objects[1]) == EXIT_FAILURE);
+        TEST_CHECK (dxf_handle_table_insert (table, 0,
+          DXF_HANDLE_KIND_BLOCK, UNKNOWN_ENTITY, &objects[1]) == EXIT_FAILURE);
+        for (i = 0; i < 1000; i++)
+        {
+                entry = dxf_handle_table_lookup (table, ((uint64_t) i << 28) + 1);
+                TEST_CHECK ((entry != NULL) && (entry->object == &objects[i]));
+        }
+        TEST_CHECK (dxf_handle_table_lookup (table, 2) == NULL);
+        TEST_CHECK (dxf_handle_table_lookup (table, 0) == NULL);
+        dxf_handle_table_free (table);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Find every entity of a drawing by its handle and resolve the
+ * pointers of the drawing.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+test_handle_table_drawing
+(
+        const char *filename,
+                /*!< the file to read, whose entities have handles. */
+        int count,
+                /*!< the number of entities in the file. */
+        int pointers,
+                /*!< the number of pointers the records keep. */
+        int resolved,
+                /*!< the number of pointers to a record which is read. */
+        int owners
+                /*!< the number of soft owners of the blocks and
+                 * entities. */
+)
+{
+        TestHandleTableState state;
+        TestHandleTablePointers resolve;
+
+        memset (&state, 0, sizeof (state));
+        memset (&resolve, 0, sizeof (resolve));
+        state.drawing = dxf_drawing_read (filename, 1);
+        TEST_CHECK (state.drawing != NULL);
+        dxf_entities_walk (dxf_drawing_get_entities_list (state.drawing),
+          test_handle_table_find, &state);
+        resolve.drawing = state.drawing;
+        dxf_drawing_resolve_handles (state.drawing, test_handle_table_resolve, &resolve);
+        /* Indexing again gives the same table. */
+        TEST_CHECK (dxf_drawing_index_handles (state.drawing) == EXIT_SUCCESS);
+        dxf_entities_walk (dxf_drawing_get_entities_list (state.drawing),
+          test_handle_table_find, &state);
+        dxf_drawing_free (state.drawing);
+        TEST_CHECK (state.failed == 0);
+        TEST_CHECK (state.found == 2 * count);
+        TEST_CHECK (resolve.wrong == 0);
+        TEST_CHECK (resolve.pointers == pointers);
+        TEST_CHECK (resolve.resolved == resolved);
+        TEST_CHECK (resolve.owners == owners);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Find an entity carrying a handle above 32 bits, written as it
+ * was read.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+test_handle_table_wide (void)
+{
+        FILE *fp;
+        DxfDrawing *drawing;
+        DxfHandleEntry *entry;
+
+        fp = fopen ("test_handle_table_wide.dxf", "w");
+        TEST_CHECK (fp != NULL);
+        fputs ("  0\nSECTION\n  2\nENTITIES\n"
+          "  0\nLINE\n  5\n123456789AB\n  8\n0\n"
+          " 10\n0.0\n 20\n0.0\n 30\n0.0\n"
+          " 11\n1.0\n 21\n1.0\n 31\n0.0\n"
+          "  0\nENDSEC\n  0\nEOF\n", fp);
+        fclose (fp);
+        drawing = dxf_drawing_read ("test_handle_table_wide.dxf", 1);
+        remove ("test_handle_table_wide.dxf");
+        TEST_CHECK (drawing != NULL);
+        entry = dxf_drawing_lookup_handle (drawing, 0x123456789ABULL);
+        TEST_CHECK ((entry != NULL) && (entry->type == LINE));
+        TEST_CHECK (dxf_entities_get_id_code (LINE, entry->object) == 0x123456789ABL);
+        TEST_CHECK (dxf_drawing_lookup_handle (drawing, 0x456789ABULL) == NULL);
+        dxf_drawing_free (drawing);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Perform test functions for the handle table.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+test_handle_table (void)
+{
+        TEST_CHECK (test_handle_table_insert () == EXIT_SUCCESS);
+        TEST_CHECK (test_handle_table_wide () == EXIT_SUCCESS);
+        /* qcad keeps no owners in its entities, every pointer of the
+         * table records and objects is resolved. */
+        TEST_CHECK (test_handle_table_drawing ("../examples/qcad-example_R2000.dxf", 14, 19, 19, 0) == EXIT_SUCCESS);
+        /* 4 blocks and 7 entities with a soft owner, the VIEWPORT
+         * reader keeps no pointers.  The unresolved pointers are to
+         * the TABLE headers, the ENDBLK markers and the entities of
+         * the blocks, which are not kept. */
+        TEST_CHECK (test_handle_table_drawing ("../examples/parametric_constraints_R2010.dxf", 9, 461, 371, 11) == EXIT_SUCCESS);
+        TEST_CHECK (test_handle_table_drawing ("../examples/zcad-teapot_R2000.dxf", 1152, 1244, 1230, 1154) == EXIT_SUCCESS);
+        return (EXIT_SUCCESS);
+}
+
+
+/* EOF */
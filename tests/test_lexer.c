@@ -0,0 +1,231 @@
+/*!
+ * \file test_lexer.c
+ *
+ * \author Copyright (C) 2017 by the libDXF developers.
+ *
+ * \brief Tests for the group code / value lexer.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include "includes.h"
+
+
+/*!
+ * \brief Read a small file whose values have leading blanks, as written
+ * by some applications.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+test_lexer_read_blanks (void)
+{
+        FILE *f;
+        DxfFile *fp;
+        DxfPair pair;
+        char text[DXF_MAX_STRING_LENGTH];
+
+        f = fopen ("test_lexer.dxf", "w");
+        TEST_CHECK (f != NULL);
+        fputs ("  0\r\n  SECTION\r\n  2\r\nENTITIES\r\n 10\r\n  1.5\r\n"
+          "  5\r\n\tFFFFFF\r\n 62\r\n   -7\r\n  0\r\nENDSEC\r\n", f);
+        fclose (f);
+        fp = dxf_read_init ("test_lexer.dxf");
+        remove ("test_lexer.dxf");
+        TEST_CHECK (fp != NULL);
+        TEST_CHECK (dxf_lexer_read_pair (fp, &pair) == 1);
+        TEST_CHECK ((pair.group_code == 0) && dxf_pair_value_is (&pair, "SECTION"));
+        TEST_CHECK (dxf_lexer_read_pair (fp, &pair) == 1);
+        TEST_CHECK ((pair.group_code == 2) && dxf_pair_value_is (&pair, "ENTITIES"));
+        TEST_CHECK (dxf_lexer_read_pair (fp, &pair) == 1);
+        TEST_CHECK ((pair.group_code == 10) && (dxf_pair_get_double (&pair) == 1.5));
+        TEST_CHECK (dxf_lexer_read_pair (fp, &pair) == 1);
+        TEST_CHECK ((pair.group_code == 5) && (dxf_pair_get_hex (&pair) == 0xffffff));
+        TEST_CHECK (strcmp (dxf_pair_copy_string (&pair, text, sizeof (text)), "FFFFFF") == 0);
+        TEST_CHECK (dxf_lexer_read_pair (fp, &pair) == 1);
+        TEST_CHECK ((pair.group_code == 62) && (dxf_pair_get_int (&pair) == -7));
+        /* A pair pushed back is read once more. */
+        dxf_lexer_unread_pair (fp);
+        TEST_CHECK (dxf_lexer_read_pair (fp, &pair) == 1);
+        TEST_CHECK (pair.group_code == 62);
+        TEST_CHECK (dxf_lexer_read_pair (fp, &pair) == 1);
+        TEST_CHECK ((pair.group_code == 0) && dxf_pair_value_is (&pair, "ENDSEC"));
+        TEST_CHECK (dxf_lexer_read_pair (fp, &pair) == EOF);
+        dxf_read_close (fp);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Read a file through stdio and through a memory mapping, both
+ * give the same pairs.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+test_lexer_same_pairs
+(
+        const char *filename
+                /*!< the file to read. */
+)
+{
+        DxfFile *a;
+        DxfFile *b;
+        DxfPair pa;
+        DxfPair pb;
+        int ra;
+        int rb;
+        int count = 0;
+
+        a = dxf_read_init (filename);
+        TEST_CHECK (a != NULL);
+        b = dxf_read_init_mmap (filename);
+        TEST_CHECK (b != NULL);
+        TEST_CHECK (b->buffer != NULL);
+        do
+        {
+                ra = dxf_lexer_read_pair (a, &pa);
+                rb = dxf_lexer_read_pair (b, &pb);
+                TEST_CHECK (ra == rb);
+                if (ra == 1)
+                {
+                        TEST_CHECK (pa.group_code == pb.group_code);
+                        TEST_CHECK (pa.value.length == pb.value.length);
+                        TEST_CHECK (memcmp (pa.value.data, pb.value.data, pa.value.length) == 0);
+                        count++;
+                }
+        }
+        while (ra == 1);
+        TEST_CHECK (a->line_number == b->line_number);
+        dxf_read_close (a);
+        dxf_read_close (b);
+        TEST_CHECK (count > 0);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Write every pair of an ASCII file to a binary file, reading
+ * that back gives the same values.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+test_lexer_binary_round_trip
+(
+        const char *filename
+                /*!< the ASCII file to convert. */
+)
+{
+        DxfFile *in;
+        DxfFile *out;
+        DxfPair pa;
+        DxfPair pb;
+        char ta[DXF_MAX_STRING_LENGTH];
+        char tb[DXF_MAX_STRING_LENGTH];
+        int ra;
+        int rb;
+
+        in = dxf_read_init (filename);
+        TEST_CHECK (in != NULL);
+        out = dxf_write_init ("test_lexer.dxb", TRUE);
+        TEST_CHECK (out != NULL);
+        while (dxf_lexer_read_pair (in, &pa) == 1)
+        {
+                dxf_pair_copy_string (&pa, ta, sizeof (ta));
+                TEST_CHECK (dxf_write_string (out, pa.group_code, ta) == EXIT_SUCCESS);
+        }
+        dxf_write_close (out);
+        dxf_read_close (in);
+        in = dxf_read_init (filename);
+        TEST_CHECK (in != NULL);
+        out = dxf_read_init_mmap ("test_lexer.dxb");
+        remove ("test_lexer.dxb");
+        TEST_CHECK (out != NULL);
+        TEST_CHECK (dxf_lexer_detect_binary (out));
+        do
+        {
+                ra = dxf_lexer_read_pair (in, &pa);
+                rb = dxf_lexer_read_pair (out, &pb);
+                TEST_CHECK (ra == rb);
+                if (ra != 1)
+                {
+                        break;
+                }
+                TEST_CHECK (pa.group_code == pb.group_code);
+                switch (dxf_lexer_group_code_type (pa.group_code))
+                {
+                        case DXF_GROUP_CODE_TYPE_DOUBLE:
+                                TEST_CHECK (dxf_pair_get_double (&pa) == dxf_pair_get_double (&pb));
+                                break;
+                        case DXF_GROUP_CODE_TYPE_INT16:
+                        case DXF_GROUP_CODE_TYPE_INT32:
+                        case DXF_GROUP_CODE_TYPE_INT64:
+                        case DXF_GROUP_CODE_TYPE_BOOL:
+                                TEST_CHECK (dxf_pair_get_long (&pa) == dxf_pair_get_long (&pb));
+                                break;
+                        default:
+                                /* Binary data comes back as hexadecimal
+                                 * text, maybe in another case. */
+                                dxf_pair_copy_string (&pa, ta, sizeof (ta));
+                                dxf_pair_copy_string (&pb, tb, sizeof (tb));
+                                TEST_CHECK (strcasecmp (ta, tb) == 0);
+                                break;
+                }
+        }
+        while (TRUE);
+        dxf_read_close (in);
+        dxf_read_close (out);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Perform test functions for the lexer.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+test_lexer (void)
+{
+        TEST_CHECK (test_lexer_read_blanks () == EXIT_SUCCESS);
+        TEST_CHECK (test_lexer_same_pairs ("../examples/qcad-example_R12.dxf") == EXIT_SUCCESS);
+        TEST_CHECK (test_lexer_same_pairs ("../examples/qcad-example_R2000.dxf") == EXIT_SUCCESS);
+        TEST_CHECK (test_lexer_binary_round_trip ("../examples/qcad-example_R12.dxf") == EXIT_SUCCESS);
+        TEST_CHECK (test_lexer_binary_round_trip ("../examples/parametric_constraints_R2010.dxf") == EXIT_SUCCESS);
+        return (EXIT_SUCCESS);
+}
+
+
+/* EOF */
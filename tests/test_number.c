@@ -0,0 +1,379 @@
+/*!
+ * \file test_number.c
+ *
+ * \author Copyright (C) 2017 by the libDXF developers.
+ *
+ * \brief Tests for parsing and formatting numbers.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#include <float.h>
+#include <stdio.h>
+#include <string.h>
+#include "includes.h"
+
+
+/*!
+ * \brief Values for which the result of dxf_number_parse_double () is
+ * compared with strtod ().
+ */
+static const char *test_number_doubles[] =
+{
+        "0", "-0.0", "1", "+1.5", "0.1", "3.14159265358979323846",
+        "1e300", "1E-300", "4.9406564584124654e-324",
+        "2.2250738585072011e-308", "1.7976931348623157e308",
+        "9007199254740993", "0.30000000000000004",
+        "123456789012345678901234567890", ".5", "5.", "1e", "  -2.5e+3",
+        NULL
+};
+
+
+/*!
+ * \brief Parse doubles like strtod () does.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+test_number_parse_double (void)
+{
+        const char **s;
+        char text[32];
+        char *end;
+        double value;
+        size_t n;
+        unsigned int seed = 1;
+        uint64_t bits;
+        int i;
+
+        for (s = test_number_doubles; *s != NULL; s++)
+        {
+                n = dxf_number_parse_double (*s, strlen (*s), &value);
+                TEST_CHECK (value == strtod (*s, &end));
+                TEST_CHECK (n == (size_t) (end - *s));
+        }
+        TEST_CHECK (dxf_number_parse_double ("abc", 3, &value) == 0);
+        TEST_CHECK (value == 0.0);
+        /* Only length characters are looked at. */
+        TEST_CHECK (dxf_number_parse_double ("1.25", 3, &value) == 3);
+        TEST_CHECK (value == 1.2);
+        /* Random finite doubles read back exactly. */
+        for (i = 0; i < 10000; i++)
+        {
+                seed = (seed * 1103515245) + 12345;
+                bits = (uint64_t) seed << 32;
+                seed = (seed * 1103515245) + 12345;
+                bits |= seed;
+                memcpy (&value, &bits, sizeof (value));
+                if (isnan (value) || isinf (value))
+                {
+                        continue;
+                }
+                snprintf (text, sizeof (text), "%.17g", value);
+                n = dxf_number_parse_double (text, strlen (text), &value);
+                TEST_CHECK (n == strlen (text));
+                TEST_CHECK (value == strtod (text, NULL));
+        }
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Parse integers and handles, and reject values out of range.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+test_number_parse_integers (void)
+{
+        char text[32];
+        long value;
+        unsigned long hex;
+
+        TEST_CHECK (dxf_number_parse_long ("  -17", 5, &value) == 5);
+        TEST_CHECK (value == -17);
+        TEST_CHECK (dxf_number_parse_long ("+42 ", 4, &value) == 3);
+        TEST_CHECK (value == 42);
+        TEST_CHECK (dxf_number_parse_long ("0000000000000000000000256", 25, &value) == 25);
+        TEST_CHECK (value == 256);
+        TEST_CHECK (dxf_number_parse_long ("-", 1, &value) == 0);
+        TEST_CHECK (value == 0);
+        snprintf (text, sizeof (text), "%ld", LONG_MAX);
+        TEST_CHECK (dxf_number_parse_long (text, strlen (text), &value) == strlen (text));
+        TEST_CHECK (value == LONG_MAX);
+        snprintf (text, sizeof (text), "%ld", LONG_MIN);
+        TEST_CHECK (dxf_number_parse_long (text, strlen (text), &value) == strlen (text));
+        TEST_CHECK (value == LONG_MIN);
+        /* One more than LONG_MAX, which ends in 7. */
+        snprintf (text, sizeof (text), "%ld", LONG_MAX);
+        text[strlen (text) - 1] = '8';
+        errno = 0;
+        TEST_CHECK (dxf_number_parse_long (text, strlen (text), &value) == 0);
+        TEST_CHECK ((value == LONG_MAX) && (errno == ERANGE));
+        TEST_CHECK (dxf_number_parse_long ("-123456789012345678901234", 24, &value) == 0);
+        TEST_CHECK (value == LONG_MIN);
+        TEST_CHECK (dxf_number_parse_hex (" 1aF", 4, &hex) == 4);
+        TEST_CHECK (hex == 0x1af);
+        TEST_CHECK (dxf_number_parse_hex ("G", 1, &hex) == 0);
+        TEST_CHECK (hex == 0);
+        snprintf (text, sizeof (text), "%lX", ULONG_MAX);
+        TEST_CHECK (dxf_number_parse_hex (text, strlen (text), &hex) == strlen (text));
+        TEST_CHECK (hex == ULONG_MAX);
+        strcat (text, "0");
+        errno = 0;
+        TEST_CHECK (dxf_number_parse_hex (text, strlen (text), &hex) == 0);
+        TEST_CHECK ((hex == ULONG_MAX) && (errno == ERANGE));
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Format integers and handles like \c printf () does.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+test_number_format_integers (void)
+{
+        static const long values[] = {0, 1, -1, 9, 10, 99, 100, -12345, 1000000007};
+        char text[DXF_NUMBER_MAX_FORMAT_LENGTH];
+        char expected[DXF_NUMBER_MAX_FORMAT_LENGTH];
+        size_t i;
+
+        for (i = 0; i < sizeof (values) / sizeof (values[0]); i++)
+        {
+                snprintf (expected, sizeof (expected), "%ld", values[i]);
+                TEST_CHECK (dxf_number_format_long (text, values[i]) == strlen (expected));
+                TEST_CHECK (strcmp (text, expected) == 0);
+                snprintf (expected, sizeof (expected), "%lx", (unsigned long) values[i]);
+                TEST_CHECK (dxf_number_format_hex (text, (unsigned long) values[i]) == strlen (expected));
+                TEST_CHECK (strcmp (text, expected) == 0);
+        }
+        snprintf (expected, sizeof (expected), "%ld", LONG_MIN);
+        dxf_number_format_long (text, LONG_MIN);
+        TEST_CHECK (strcmp (text, expected) == 0);
+        snprintf (expected, sizeof (expected), "%ld", LONG_MAX);
+        dxf_number_format_long (text, LONG_MAX);
+        TEST_CHECK (strcmp (text, expected) == 0);
+        snprintf (expected, sizeof (expected), "%lx", ULONG_MAX);
+        dxf_number_format_hex (text, ULONG_MAX);
+        TEST_CHECK (strcmp (text, expected) == 0);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Format doubles with a fixed number of decimals like
+ * \c printf ("%.*f") does.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+test_number_format_fixed (void)
+{
+        static const double values[] =
+        {
+                0.0, -0.0, 0.5, 1.5, 2.5, -2.5, 0.125, 0.375, 1e-7,
+                0.1, 123.456, 999999.9999995, 1e15, 1e300, -3.0
+        };
+        char text[DXF_NUMBER_MAX_FORMAT_LENGTH];
+        char expected[DXF_NUMBER_MAX_FORMAT_LENGTH];
+        unsigned int seed = 7;
+        double value;
+        size_t i;
+        int decimals;
+
+        for (decimals = 0; decimals <= DXF_NUMBER_MAX_DECIMALS; decimals++)
+        {
+                for (i = 0; i < sizeof (values) / sizeof (values[0]); i++)
+                {
+                        snprintf (expected, sizeof (expected), "%.*f", decimals, values[i]);
+                        TEST_CHECK (dxf_number_format_fixed (text, values[i], decimals) == strlen (expected));
+                        TEST_CHECK (strcmp (text, expected) == 0);
+                }
+        }
+        /* Random values below 2.2 * 10^6, many with long binary
+         * fractions. */
+        for (i = 0; i < 20000; i++)
+        {
+                seed = (seed * 1103515245) + 12345;
+                value = (double) (seed >> 1) / 1000.0;
+                value /= (double) (1 << (seed % 24));
+                value = (seed & 1) ? -value : value;
+                decimals = (int) (i % 10);
+                snprintf (expected, sizeof (expected), "%.*f", decimals, value);
+                dxf_number_format_fixed (text, value, decimals);
+                TEST_CHECK (strcmp (text, expected) == 0);
+        }
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Count the significant digits of a formatted number.
+ *
+ * \return the number of digits without leading and trailing zeros.
+ */
+static int
+test_number_significant_digits
+(
+        const char *text
+                /*!< the number. */
+)
+{
+        int count = 0;
+        int zeros = 0;
+
+        for (; (*text != '\0') && (*text != 'E') && (*text != 'e'); text++)
+        {
+                if ((*text < '0') || (*text > '9'))
+                {
+                        continue;
+                }
+                if (*text == '0')
+                {
+                        zeros++;
+                        continue;
+                }
+                count += (count == 0) ? 1 : zeros + 1;
+                zeros = 0;
+        }
+        return (count);
+}
+
+
+/*!
+ * \brief Check that dxf_number_format_double () writes \c value with
+ * the fewest digits which read back as \c value.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+test_number_shortest
+(
+        double value
+                /*!< a finite non-zero value. */
+)
+{
+        char text[DXF_NUMBER_MAX_FORMAT_LENGTH];
+        char shortest[DXF_NUMBER_MAX_FORMAT_LENGTH];
+        int precision;
+
+        TEST_CHECK (dxf_number_format_double (text, value) == strlen (text));
+        TEST_CHECK (strtod (text, NULL) == value);
+        for (precision = 1; precision < 17; precision++)
+        {
+                snprintf (shortest, sizeof (shortest), "%.*e", precision - 1, value);
+                if (strtod (shortest, NULL) == value)
+                {
+                        break;
+                }
+        }
+        TEST_CHECK (test_number_significant_digits (text) == precision);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Format doubles with the fewest digits that read back exactly.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+test_number_format_double (void)
+{
+        static const struct
+        {
+                double value;
+                const char *text;
+        } values[] =
+        {
+                {0.0, "0.0"}, {3.0, "3.0"}, {12.5, "12.5"}, {-0.1, "-0.1"},
+                {1e-5, "0.00001"}, {1.5e20, "1.5E+20"}, {5e-324, "5.0E-324"},
+                {0.30000000000000004, "0.30000000000000004"}
+        };
+        char text[DXF_NUMBER_MAX_FORMAT_LENGTH];
+        unsigned int seed = 3;
+        uint64_t bits;
+        double value;
+        size_t i;
+
+        for (i = 0; i < sizeof (values) / sizeof (values[0]); i++)
+        {
+                dxf_number_format_double (text, values[i].value);
+                TEST_CHECK (strcmp (text, values[i].text) == 0);
+        }
+        TEST_CHECK (test_number_shortest (DBL_MAX) == EXIT_SUCCESS);
+        TEST_CHECK (test_number_shortest (DBL_MIN) == EXIT_SUCCESS);
+        for (i = 0; i < 20000; i++)
+        {
+                seed = (seed * 1103515245) + 12345;
+                bits = (uint64_t) seed << 32;
+                seed = (seed * 1103515245) + 12345;
+                bits |= seed;
+                memcpy (&value, &bits, sizeof (value));
+                if (isnan (value) || isinf (value) || (value == 0.0))
+                {
+                        continue;
+                }
+                TEST_CHECK (test_number_shortest (value) == EXIT_SUCCESS);
+                /* Short decimal values as found in drawings. */
+                value = (double) (int) (seed % 2000000 - 1000000) / 1000.0;
+                if (value != 0.0)
+                {
+                        TEST_CHECK (test_number_shortest (value) == EXIT_SUCCESS);
+                }
+        }
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Perform test functions for parsing and formatting numbers.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+test_number (void)
+{
+        TEST_CHECK (test_number_parse_double () == EXIT_SUCCESS);
+        TEST_CHECK (test_number_parse_integers () == EXIT_SUCCESS);
+        TEST_CHECK (test_number_format_integers () == EXIT_SUCCESS);
+        TEST_CHECK (test_number_format_fixed () == EXIT_SUCCESS);
+        TEST_CHECK (test_number_format_double () == EXIT_SUCCESS);
+        return (EXIT_SUCCESS);
+}
+
+
+/* EOF */
@@ -0,0 +1,309 @@
+/*!
+ * \file test_packed_vertices.c
+ *
+ * \author Copyright (C) 2017 by the libDXF developers.
+ *
+ * \brief Tests for the packed vertices of polylines.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#include <stdio.h>
+#include <string.h>
+#include "includes.h"
+
+
+/*!
+ * \brief Remember the first entity of one type in a drawing.
+ */
+typedef struct
+test_packed_vertices_find_struct
+{
+        DxfEntityType type;
+                /*!< The type looked for. */
+        void *entity;
+                /*!< The first entity of that type, or \c NULL. */
+} TestPackedVerticesFind;
+
+
+/*!
+ * \brief Remember an entity when it is the first one of the type looked
+ * for.
+ */
+static void
+test_packed_vertices_find
+(
+        DxfEntityType type,
+                /*!< type of the entity. */
+        void *entity,
+                /*!< the entity. */
+        void *user_data
+                /*!< the TestPackedVerticesFind. */
+)
+{
+        TestPackedVerticesFind *find = user_data;
+
+        if ((type == find->type) && (find->entity == NULL))
+        {
+                find->entity = entity;
+        }
+}
+
+
+/*!
+ * \brief Check that a chain of DxfVertex entities holds the vertices of
+ * \c array.
+ *
+ * \return \c TRUE when it does, \c FALSE otherwise.
+ */
+static int
+test_packed_vertices_same_chain
+(
+        DxfVertexArray *array,
+                /*!< the packed vertices. */
+        DxfVertex *vertices
+                /*!< the first vertex of the chain. */
+)
+{
+        int i;
+
+        for (i = 0; i < array->count; i++)
+        {
+                if ((vertices == NULL)
+                  || (vertices->x0 != array->x0[i])
+                  || (vertices->y0 != array->y0[i])
+                  || (vertices->z0 != ((array->z0 != NULL) ? array->z0[i] : 0.0))
+                  || (vertices->bulge != array->bulge[i])
+                  || (vertices->start_width != ((array->start_width != NULL) ? array->start_width[i] : 0.0))
+                  || (vertices->end_width != ((array->end_width != NULL) ? array->end_width[i] : 0.0))
+                  || (vertices->flag != ((array->flag != NULL) ? array->flag[i] : 0)))
+                {
+                        return (FALSE);
+                }
+                vertices = (DxfVertex *) vertices->next;
+        }
+        return (vertices == NULL);
+}
+
+
+/*!
+ * \brief Grow an array past the point where widths and flags were
+ * allocated, and copy it through a chain of DxfVertex entities.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+test_packed_vertices_array (void)
+{
+        DxfVertexArray array;
+        DxfVertexArray copy;
+        DxfVertex *chain;
+        int same;
+        int i;
+
+        dxf_vertex_array_init (&array, 3);
+        for (i = 0; i < 10; i++)
+        {
+                TEST_CHECK (dxf_vertex_array_append (&array, i, 2.0 * i, 3.0 * i, 0.5) == i);
+        }
+        TEST_CHECK (array.z0 != NULL);
+        /* Widths and flags are allocated on demand. */
+        TEST_CHECK ((array.start_width == NULL) && (array.flag == NULL));
+        TEST_CHECK (dxf_vertex_array_set_flag (&array, 3, 0) == EXIT_SUCCESS);
+        TEST_CHECK (array.flag == NULL);
+        TEST_CHECK (dxf_vertex_array_set_widths (&array, 5, 1.0, 2.0) == EXIT_SUCCESS);
+        TEST_CHECK (dxf_vertex_array_set_flag (&array, 7, 32) == EXIT_SUCCESS);
+        TEST_CHECK ((array.start_width[4] == 0.0) && (array.end_width[5] == 2.0));
+        TEST_CHECK ((array.flag[6] == 0) && (array.flag[7] == 32));
+        TEST_CHECK (dxf_vertex_array_set_flag (&array, 10, 1) == EXIT_FAILURE);
+        for (i = 10; i < 1000; i++)
+        {
+                TEST_CHECK (dxf_vertex_array_append (&array, i, 2.0 * i, 3.0 * i, 0.0) == i);
+        }
+        TEST_CHECK ((array.count == 1000) && (array.capacity >= 1000));
+        TEST_CHECK ((array.start_width[999] == 0.0) && (array.flag[999] == 0));
+        TEST_CHECK ((array.z0[999] == 2997.0) && (array.end_width[5] == 2.0));
+        chain = dxf_vertex_array_to_chain (&array);
+        TEST_CHECK (test_packed_vertices_same_chain (&array, chain));
+        dxf_vertex_array_init (&copy, 3);
+        TEST_CHECK (dxf_vertex_array_from_chain (&copy, chain) == EXIT_SUCCESS);
+        same = test_packed_vertices_same_chain (&copy, chain);
+        dxf_vertex_free_chain (chain);
+        dxf_vertex_array_free (&copy);
+        dxf_vertex_array_free (&array);
+        TEST_CHECK (same);
+        TEST_CHECK ((array.count == 0) && (array.x0 == NULL));
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Read the \c VERTEX entities following a \c POLYLINE into its
+ * packed vertices.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+test_packed_vertices_read_polyline
+(
+        const char *filename,
+                /*!< the file to read, its first \c POLYLINE is a 2D
+                 * polyline. */
+        int count,
+                /*!< the number of vertices of the first \c POLYLINE. */
+        double x0,
+                /*!< X-value of the first vertex. */
+        double y0
+                /*!< Y-value of the first vertex. */
+)
+{
+        TestPackedVerticesFind find = {POLYLINE, NULL};
+        DxfDrawing *drawing;
+        DxfPolyline *polyline;
+        DxfVertex *vertices;
+        int same;
+
+        drawing = dxf_drawing_read (filename, 1);
+        TEST_CHECK (drawing != NULL);
+        dxf_entities_walk (dxf_drawing_get_entities_list (drawing),
+          test_packed_vertices_find, &find);
+        polyline = find.entity;
+        TEST_CHECK (polyline != NULL);
+        TEST_CHECK (polyline->packed_vertices.count == count);
+        TEST_CHECK (polyline->packed_vertices.x0[0] == x0);
+        TEST_CHECK (polyline->packed_vertices.y0[0] == y0);
+        /* The linked list is built on demand and kept. */
+        TEST_CHECK (polyline->vertices == NULL);
+        vertices = dxf_polyline_get_vertices (polyline);
+        same = test_packed_vertices_same_chain (&polyline->packed_vertices, vertices)
+          && (dxf_polyline_get_vertices (polyline) == vertices);
+        dxf_drawing_free (drawing);
+        TEST_CHECK (same);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Write a \c LWPOLYLINE with widths and bulges, and read it back.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+test_packed_vertices_lwpolyline_round_trip (void)
+{
+        TestPackedVerticesFind find = {LWPOLYLINE, NULL};
+        DxfLWPolyline *lwpolyline;
+        DxfLWPolyline *back;
+        DxfDrawing *drawing;
+        DxfVertexArray *a;
+        DxfVertexArray *b;
+        DxfFile *fp;
+        int same = TRUE;
+        int i;
+
+        lwpolyline = dxf_lwpolyline_init (dxf_lwpolyline_new ());
+        TEST_CHECK (lwpolyline != NULL);
+        dxf_lwpolyline_set_layer (lwpolyline, "0");
+        for (i = 0; i < 100; i++)
+        {
+                TEST_CHECK (dxf_lwpolyline_append_vertex (lwpolyline, 0.5 * i, -0.25 * i, (i % 2) ? 1.0 : 0.0) == EXIT_SUCCESS);
+        }
+        TEST_CHECK (lwpolyline->number_vertices == 100);
+        TEST_CHECK (lwpolyline->packed_vertices.z0 == NULL);
+        TEST_CHECK (dxf_vertex_array_set_widths (&lwpolyline->packed_vertices, 42, 0.1, 0.2) == EXIT_SUCCESS);
+        fp = dxf_write_init ("test_packed_vertices.dxf", FALSE);
+        TEST_CHECK (fp != NULL);
+        fp->acad_version_number = AutoCAD_2000;
+        dxf_write_string (fp, 0, "SECTION");
+        dxf_write_string (fp, 2, "ENTITIES");
+        i = dxf_lwpolyline_write (fp, lwpolyline);
+        dxf_write_string (fp, 0, "ENDSEC");
+        dxf_write_string (fp, 0, "EOF");
+        dxf_write_close (fp);
+        if (i != EXIT_SUCCESS)
+        {
+                remove ("test_packed_vertices.dxf");
+                dxf_lwpolyline_free (lwpolyline);
+                return (EXIT_FAILURE);
+        }
+        drawing = dxf_drawing_read ("test_packed_vertices.dxf", 1);
+        remove ("test_packed_vertices.dxf");
+        if (drawing != NULL)
+        {
+                dxf_entities_walk (dxf_drawing_get_entities_list (drawing),
+                  test_packed_vertices_find, &find);
+        }
+        back = find.entity;
+        a = &lwpolyline->packed_vertices;
+        if ((back == NULL) || (back->packed_vertices.count != a->count)
+          || (back->packed_vertices.start_width == NULL))
+        {
+                same = FALSE;
+        }
+        for (i = 0; same && (i < a->count); i++)
+        {
+                b = &back->packed_vertices;
+                same = (b->x0[i] == a->x0[i]) && (b->y0[i] == a->y0[i])
+                  && (b->bulge[i] == a->bulge[i])
+                  && (b->start_width[i] == a->start_width[i])
+                  && (b->end_width[i] == a->end_width[i]);
+        }
+        if (same)
+        {
+                same = test_packed_vertices_same_chain (&back->packed_vertices,
+                  dxf_lwpolyline_get_vertices (back));
+        }
+        if (drawing != NULL)
+        {
+                dxf_drawing_free (drawing);
+        }
+        dxf_lwpolyline_free (lwpolyline);
+        TEST_CHECK (same);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Perform test functions for the packed vertices.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+test_packed_vertices (void)
+{
+        TEST_CHECK (test_packed_vertices_array () == EXIT_SUCCESS);
+        TEST_CHECK (test_packed_vertices_read_polyline ("../examples/all_R10_entities.dxf", 6, 386.7003607653499, 234.83893125931661) == EXIT_SUCCESS);
+        TEST_CHECK (test_packed_vertices_lwpolyline_round_trip () == EXIT_SUCCESS);
+        return (EXIT_SUCCESS);
+}
+
+
+/* EOF */
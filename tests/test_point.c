@@ -69,7 +69,7 @@ test_point (int argc, char** argv)
                 exit (EXIT_FAILURE);
         }
         dxf_point_test_1->id_code = 1;
-        dxf_point_test_1->layer = strdup ("0");
+        dxf_point_set_layer (dxf_point_test_1, "0");
         dxf_point_test_1->x0 = 10.0;
         dxf_point_test_1->y0 = 20.0;
         dxf_point_test_1->z0 = 30.0;
@@ -0,0 +1,237 @@
+/*!
+ * \file test_stream.c
+ *
+ * \author Copyright (C) 2017 by the libDXF developers.
+ *
+ * \brief Tests for the callback based streaming reader.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#include <stdio.h>
+#include <string.h>
+#if defined (__GLIBC__)
+#include <malloc.h>
+#endif
+#include "includes.h"
+
+
+/*!
+ * \brief Entities seen by the callbacks of a test.
+ */
+typedef struct
+test_stream_count_struct
+{
+        int count[XLINE + 1];
+                /*!< Number of entities of every type. */
+        int total;
+                /*!< Number of entities. */
+        int stop_after;
+                /*!< Stop reading after this many entities, or 0. */
+} TestStreamCount;
+
+
+/*!
+ * \brief Count an entity handed to the stream callback.
+ *
+ * \return \c DXF_STREAM_STOP after \c stop_after entities,
+ * \c DXF_STREAM_CONTINUE otherwise.
+ */
+static int
+test_stream_entity
+(
+        DxfEntityType type,
+                /*!< type of the entity. */
+        void *entity,
+                /*!< the entity. */
+        void *user_data
+                /*!< the TestStreamCount. */
+)
+{
+        TestStreamCount *count = user_data;
+
+        count->count[type]++;
+        count->total++;
+        return (count->total == count->stop_after) ? DXF_STREAM_STOP : DXF_STREAM_CONTINUE;
+}
+
+
+/*!
+ * \brief Count an entity of a drawing.
+ */
+static void
+test_stream_walk
+(
+        DxfEntityType type,
+                /*!< type of the entity. */
+        void *entity,
+                /*!< the entity. */
+        void *user_data
+                /*!< the TestStreamCount. */
+)
+{
+        test_stream_entity (type, entity, user_data);
+}
+
+
+/*!
+ * \brief Stream a file, which gives the same entities as reading the
+ * drawing in one thread.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+test_stream_same_entities
+(
+        const char *filename,
+                /*!< the file to read. */
+        int total
+                /*!< the number of entities in the file. */
+)
+{
+        DxfStreamCallbacks callbacks;
+        TestStreamCount streamed;
+        TestStreamCount read;
+        DxfDrawing *drawing;
+
+        memset (&callbacks, 0, sizeof (callbacks));
+        memset (&streamed, 0, sizeof (streamed));
+        memset (&read, 0, sizeof (read));
+        callbacks.entity = test_stream_entity;
+        TEST_CHECK (dxf_file_stream (filename, &callbacks, &streamed) == EXIT_SUCCESS);
+        /* A drawing keeps no SEQEND entities. */
+        streamed.total -= streamed.count[SEQEND];
+        streamed.count[SEQEND] = 0;
+        drawing = dxf_drawing_read (filename, 1);
+        TEST_CHECK (drawing != NULL);
+        dxf_entities_walk (dxf_drawing_get_entities_list (drawing),
+          test_stream_walk, &read);
+        dxf_drawing_free (drawing);
+        TEST_CHECK (streamed.total == total);
+        TEST_CHECK (memcmp (streamed.count, read.count, sizeof (read.count)) == 0);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Stop streaming from the callback.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+test_stream_stop
+(
+        const char *filename
+                /*!< the file to read. */
+)
+{
+        DxfStreamCallbacks callbacks;
+        TestStreamCount streamed;
+
+        memset (&callbacks, 0, sizeof (callbacks));
+        memset (&streamed, 0, sizeof (streamed));
+        callbacks.entity = test_stream_entity;
+        streamed.stop_after = 3;
+        TEST_CHECK (dxf_file_stream (filename, &callbacks, &streamed) == EXIT_SUCCESS);
+        TEST_CHECK (streamed.total == 3);
+        return (EXIT_SUCCESS);
+}
+
+/*!
+ * \brief Stream a file several times, which leaves no memory behind.
+ *
+ * Every entity is freed when the callback returns, so the heap in use
+ * after a second run must be the heap in use after the first one.  The
+ * first run pays for what is allocated only once.\n
+ * The heap is measured with mallinfo2 () of the GNU C library, on other
+ * systems the file is only streamed.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+test_stream_no_leaks
+(
+        const char *filename
+                /*!< the file to read. */
+)
+{
+        DxfStreamCallbacks callbacks;
+        TestStreamCount streamed;
+        int i;
+#if defined (__GLIBC__) && ((__GLIBC__ > 2) || (__GLIBC_MINOR__ >= 33))
+        struct mallinfo2 info;
+        size_t in_use = 0;
+#endif
+
+        memset (&callbacks, 0, sizeof (callbacks));
+        callbacks.entity = test_stream_entity;
+        for (i = 0; i < 4; i++)
+        {
+                memset (&streamed, 0, sizeof (streamed));
+                TEST_CHECK (dxf_file_stream (filename, &callbacks, &streamed) == EXIT_SUCCESS);
+                TEST_CHECK (streamed.total > 0);
+#if defined (__GLIBC__) && ((__GLIBC__ > 2) || (__GLIBC_MINOR__ >= 33))
+                info = mallinfo2 ();
+                if (i == 0)
+                {
+                        in_use = info.uordblks + info.hblkhd;
+                }
+                else
+                {
+                        TEST_CHECK (info.uordblks + info.hblkhd <= in_use);
+                }
+#endif
+        }
+        return (EXIT_SUCCESS);
+}
+
+
+
+/*!
+ * \brief Perform test functions for the streaming reader.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+test_stream (void)
+{
+        TEST_CHECK (test_stream_same_entities ("../examples/all_R10_entities.dxf", 15) == EXIT_SUCCESS);
+        TEST_CHECK (test_stream_same_entities ("../examples/qcad-example_R12.dxf", 30) == EXIT_SUCCESS);
+        TEST_CHECK (test_stream_same_entities ("../examples/qcad-example_R2000.dxf", 14) == EXIT_SUCCESS);
+        TEST_CHECK (test_stream_same_entities ("../examples/blender-monkey_head_example_R12.dxf", 1008) == EXIT_SUCCESS);
+        TEST_CHECK (test_stream_stop ("../examples/qcad-example_R12.dxf") == EXIT_SUCCESS);
+        TEST_CHECK (test_stream_no_leaks ("../examples/zcad-teapot_R2000.dxf") == EXIT_SUCCESS);
+        TEST_CHECK (test_stream_no_leaks ("../examples/all_R10_entities.dxf") == EXIT_SUCCESS);
+        return (EXIT_SUCCESS);
+}
+
+
+/* EOF */
@@ -0,0 +1,216 @@
+/*!
+ * \file test_string_pool.c
+ *
+ * \author Copyright (C) 2017 by the libDXF developers.
+ *
+ * \brief Tests for the pool of shared strings.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#include <stdio.h>
+#include <string.h>
+#include "includes.h"
+
+
+#define TEST_STRING_POOL_NAMES 5000
+        /*!< \brief Number of distinct strings interned by the tests. */
+#define TEST_STRING_POOL_THREADS 4
+        /*!< \brief Number of threads interning at the same time. */
+
+
+/*!
+ * \brief State of a thread of test_string_pool_threads ().
+ */
+typedef struct
+test_string_pool_thread_struct
+{
+        DxfStringPool *pool;
+                /*!< The shared pool. */
+        int step;
+                /*!< Step through the names. */
+        char *strings[TEST_STRING_POOL_NAMES];
+                /*!< The strings interned by the thread. */
+} TestStringPoolThread;
+
+
+/*!
+ * \brief Intern the names "LAYER_0", "LAYER_1", ... in the order given
+ * by \c step.
+ */
+static void
+test_string_pool_intern_names
+(
+        DxfStringPool *pool,
+                /*!< the pool. */
+        char **strings,
+                /*!< the interned names. */
+        int step
+                /*!< step through the names, prime to their number. */
+)
+{
+        char name[32];
+        int i;
+        int k;
+
+        for (i = 0; i < TEST_STRING_POOL_NAMES; i++)
+        {
+                k = (int) (((long) i * step) % TEST_STRING_POOL_NAMES);
+                snprintf (name, sizeof (name), "LAYER_%d", k);
+                strings[k] = dxf_string_pool_intern (pool, name);
+        }
+}
+
+
+#if !defined (MSDOS) && !defined (_WIN32)
+/*!
+ * \brief Thread interning the names into a shared pool.
+ */
+static void *
+test_string_pool_thread
+(
+        void *data
+                /*!< the TestStringPoolThread. */
+)
+{
+        TestStringPoolThread *thread = data;
+
+        test_string_pool_intern_names (thread->pool, thread->strings,
+          thread->step);
+        return (NULL);
+}
+#endif
+
+
+/*!
+ * \brief Intern, look up and own strings.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+test_string_pool_intern (void)
+{
+        DxfStringPool *pool;
+        char *strings[TEST_STRING_POOL_NAMES];
+        char *copy;
+        char *a;
+        char *b;
+        int i;
+
+        pool = dxf_string_pool_new ();
+        TEST_CHECK (pool != NULL);
+        copy = strdup ("CONTINUOUS");
+        a = dxf_string_pool_intern (pool, "CONTINUOUS");
+        b = dxf_string_pool_intern (pool, copy);
+        TEST_CHECK ((a != NULL) && (a == b) && (a != copy));
+        TEST_CHECK (strcmp (a, "CONTINUOUS") == 0);
+        /* Only length characters of the value are taken. */
+        b = dxf_string_pool_intern_n (pool, "CONTINUOUS\nBYLAYER", 10);
+        TEST_CHECK (a == b);
+        b = dxf_string_pool_intern (pool, "");
+        TEST_CHECK ((b != NULL) && (*b == '\0'));
+        TEST_CHECK (dxf_string_pool_lookup (pool, "CONTINUOUS") == a);
+        TEST_CHECK (dxf_string_pool_lookup (pool, "BYLAYER") == NULL);
+        TEST_CHECK (dxf_string_pool_owns (pool, a));
+        TEST_CHECK (!dxf_string_pool_owns (pool, copy));
+        TEST_CHECK (!dxf_string_pool_owns (pool, NULL));
+        TEST_CHECK (dxf_string_pool_count (pool) == 2);
+        free (copy);
+        /* Grow every part of the pool. */
+        test_string_pool_intern_names (pool, strings, 1);
+        TEST_CHECK (dxf_string_pool_count (pool) == 2 + TEST_STRING_POOL_NAMES);
+        for (i = 0; i < TEST_STRING_POOL_NAMES; i++)
+        {
+                TEST_CHECK (dxf_string_pool_lookup (pool, strings[i]) == strings[i]);
+        }
+        TEST_CHECK (dxf_string_pool_lookup (pool, "CONTINUOUS") == a);
+        dxf_string_pool_free (pool);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Intern the same strings from several threads, which all get
+ * the same pointers.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+test_string_pool_threads (void)
+{
+#if !defined (MSDOS) && !defined (_WIN32)
+        static TestStringPoolThread threads[TEST_STRING_POOL_THREADS];
+        pthread_t ids[TEST_STRING_POOL_THREADS];
+        DxfStringPool *pool;
+        int i;
+        int j;
+
+        pool = dxf_string_pool_new ();
+        TEST_CHECK (pool != NULL);
+        for (i = 0; i < TEST_STRING_POOL_THREADS; i++)
+        {
+                threads[i].pool = pool;
+                threads[i].step = (i % 2) ? 7 : 3;
+                TEST_CHECK (pthread_create (&ids[i], NULL,
+                  test_string_pool_thread, &threads[i]) == 0);
+        }
+        for (i = 0; i < TEST_STRING_POOL_THREADS; i++)
+        {
+                pthread_join (ids[i], NULL);
+        }
+        TEST_CHECK (dxf_string_pool_count (pool) == TEST_STRING_POOL_NAMES);
+        for (i = 1; i < TEST_STRING_POOL_THREADS; i++)
+        {
+                for (j = 0; j < TEST_STRING_POOL_NAMES; j++)
+                {
+                        TEST_CHECK (threads[i].strings[j] == threads[0].strings[j]);
+                }
+        }
+        dxf_string_pool_free (pool);
+#endif
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Perform test functions for the string pool.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+test_string_pool (void)
+{
+        TEST_CHECK (test_string_pool_intern () == EXIT_SUCCESS);
+        TEST_CHECK (test_string_pool_threads () == EXIT_SUCCESS);
+        return (EXIT_SUCCESS);
+}
+
+
+/* EOF */
@@ -0,0 +1,204 @@
+/*!
+ * \file test_vec3.c
+ *
+ * \author Copyright (C) 2017 by the libDXF developers.
+ *
+ * \brief Tests for the positions entities keep in a DxfVec3.
+ *
+ * <hr>
+ * <h1><b>Copyright Notices.</b></h1>\n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.\n\n
+ * This program is distributed in the hope that it will be useful, but
+ * <b>WITHOUT ANY WARRANTY</b>; without even the implied warranty of
+ * <b>MERCHANTABILITY</b> or <b>FITNESS FOR A PARTICULAR PURPOSE</b>.\n
+ * See the GNU General Public License for more details.\n\n
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to:\n
+ * Free Software Foundation, Inc.,\n
+ * 59 Temple Place,\n
+ * Suite 330,\n
+ * Boston,\n
+ * MA 02111 USA.\n
+ * \n
+ * Drawing eXchange Format (DXF) is a defacto industry standard for the
+ * exchange of drawing files between various Computer Aided Drafting
+ * programs.\n
+ * DXF is an industry standard designed by Autodesk(TM).\n
+ * For more details see http://www.autodesk.com.
+ * <hr>
+ */
+
+
+#include <stdio.h>
+#include <string.h>
+#include "includes.h"
+
+
+/*!
+ * \brief Test if a \c POINT is at the position \c vec3.
+ *
+ * \return \c TRUE when it is, \c FALSE otherwise.
+ */
+static int
+test_vec3_at
+(
+        DxfPoint *point,
+                /*!< the point, or \c NULL. */
+        DxfVec3 *vec3
+                /*!< the position. */
+)
+{
+        return ((point != NULL)
+          && (point->x0 == vec3->x0)
+          && (point->y0 == vec3->y0)
+          && (point->z0 == vec3->z0));
+}
+
+
+/*!
+ * \brief Make a \c POINT at the position of a DxfVec3.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+test_vec3_new_point (void)
+{
+        DxfVec3 vec3 = {1.5, -2.5, 3.5};
+        DxfPoint *point;
+
+        point = dxf_point_new_from_vec3 (&vec3);
+        TEST_CHECK (test_vec3_at (point, &vec3));
+        TEST_CHECK (point->next == NULL);
+        dxf_point_free (point);
+        TEST_CHECK (dxf_point_new_from_vec3 (NULL) == NULL);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Get and set the start and end point of a \c LINE, which copy
+ * the positions in and out of the \c LINE.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+test_vec3_line (void)
+{
+        DxfLine *line;
+        DxfLine *created;
+        DxfPoint *p0;
+        DxfPoint *p1;
+        int same;
+
+        line = dxf_line_init (dxf_line_new ());
+        TEST_CHECK (line != NULL);
+        TEST_CHECK ((line->p0.x0 == 0.0) && (line->p1.z0 == 0.0));
+        dxf_line_set_x0 (line, 1.0);
+        dxf_line_set_y0 (line, 2.0);
+        dxf_line_set_z0 (line, 3.0);
+        dxf_line_set_x1 (line, 4.0);
+        dxf_line_set_y1 (line, 6.0);
+        dxf_line_set_z1 (line, 3.0);
+        TEST_CHECK ((dxf_line_get_x0 (line) == 1.0) && (dxf_line_get_y1 (line) == 6.0));
+        TEST_CHECK (dxf_line_calculate_length (line) == 5.0);
+        /* A position got is the one kept in the entity. */
+        TEST_CHECK ((dxf_line_get_p0_vec3 (line) == &line->p0)
+          && (dxf_line_get_p1_vec3 (line) == &line->p1));
+        dxf_line_get_p1_vec3 (line)->y0 = 5.0;
+        TEST_CHECK (dxf_line_get_y1 (line) == 5.0);
+        dxf_line_set_y1 (line, 6.0);
+        p0 = dxf_point_new_from_vec3 (dxf_line_get_p0_vec3 (line));
+        p1 = dxf_point_new_from_vec3 (dxf_line_get_p1_vec3 (line));
+        TEST_CHECK (test_vec3_at (p0, &line->p0) && test_vec3_at (p1, &line->p1));
+        p0->x0 = 10.0;
+        TEST_CHECK (dxf_line_get_x0 (line) == 1.0);
+        /* A point set is copied, the caller keeps it. */
+        dxf_line_set_p0 (line, p0);
+        p0->x0 = 20.0;
+        TEST_CHECK (dxf_line_get_x0 (line) == 10.0);
+        created = dxf_line_create_from_points (p0, p1, 7, 0);
+        same = (created != NULL)
+          && test_vec3_at (p0, &created->p0)
+          && test_vec3_at (p1, &created->p1)
+          && (created->id_code == 7);
+        dxf_point_free (p0);
+        dxf_point_free (p1);
+        if (created != NULL)
+        {
+                dxf_line_free (created);
+        }
+        dxf_line_free (line);
+        TEST_CHECK (same);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Get and set the insertion point of an \c INSERT and a
+ * \c POLYLINE.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+static int
+test_vec3_insertion_point (void)
+{
+        DxfVec3 vec3 = {-1.0, 0.5, 8.0};
+        DxfPolyline *polyline;
+        DxfInsert *insert;
+        DxfPoint *point;
+        DxfVec3 *got;
+        int same;
+
+        point = dxf_point_new_from_vec3 (&vec3);
+        TEST_CHECK (point != NULL);
+        insert = dxf_insert_init (dxf_insert_new ());
+        TEST_CHECK (insert != NULL);
+        dxf_insert_set_p0 (insert, point);
+        got = dxf_insert_get_p0_vec3 (insert);
+        same = (got == &insert->p0) && test_vec3_at (point, got)
+          && (dxf_insert_get_x0 (insert) == -1.0);
+        got->z0 = 9.0;
+        same = same && (dxf_insert_get_z0 (insert) == 9.0);
+        dxf_insert_free (insert);
+        polyline = dxf_polyline_init (dxf_polyline_new ());
+        if (polyline != NULL)
+        {
+                dxf_polyline_set_p0 (polyline, point);
+                got = dxf_polyline_get_p0_vec3 (polyline);
+                same = same && (got == &polyline->p0)
+                  && test_vec3_at (point, got);
+                dxf_polyline_free (polyline);
+        }
+        else
+        {
+                same = FALSE;
+        }
+        dxf_point_free (point);
+        TEST_CHECK (same);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Perform test functions for the positions kept in a DxfVec3.
+ *
+ * \return \c EXIT_SUCCESS when done, or \c EXIT_FAILURE when an error
+ * occurred.
+ */
+int
+test_vec3 (void)
+{
+        TEST_CHECK (test_vec3_new_point () == EXIT_SUCCESS);
+        TEST_CHECK (test_vec3_line () == EXIT_SUCCESS);
+        TEST_CHECK (test_vec3_insertion_point () == EXIT_SUCCESS);
+        return (EXIT_SUCCESS);
+}
+
+
+/* EOF */
@@ -35,16 +35,52 @@
 #include "includes.h"
 
 /*!
- * \brief Reads a dxf file using libdxf form examples dir.
+ * \brief Report the result of a test.
+ *
+ * \return 1 when the test failed, 0 otherwise.
+ */
+static int
+report (const char *name, int result)
+{
+    fprintf (stdout, "TESTS: %s %s\n", name,
+      (result == EXIT_SUCCESS) ? "passed" : "FAILED");
+    return (result != EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Reads a dxf file using libdxf form examples dir, and runs the
+ * tests.
+ *
+ * Run from the tests directory.
+ *
+ * \return \c EXIT_SUCCESS when all tests passed, \c EXIT_FAILURE
+ * otherwise.
  *
  * \version According to DXF R2000.
  */
 int main (void)
 {
+    int failed = 0;
+
     if (dxf_file_read ("../examples/qcad-example_R2000.dxf"))
         fprintf (stdout, "TESTS: R2000 exited with error\n");
     else
         fprintf (stdout, "TESTS: R2000 exited with no error\n");
     
-    return 1;
+    failed += report ("entity index", test_entity_index ());
+    failed += report ("lexer", test_lexer ());
+    failed += report ("number", test_number ());
+    failed += report ("stream", test_stream ());
+    failed += report ("drawing", test_drawing ());
+    failed += report ("filter", test_filter ());
+    failed += report ("handle table", test_handle_table ());
+    failed += report ("string pool", test_string_pool ());
+    failed += report ("arena", test_arena ());
+    failed += report ("columns", test_columns ());
+    failed += report ("packed vertices", test_packed_vertices ());
+    failed += report ("vec3", test_vec3 ());
+    failed += report ("graphic properties", test_graphic_properties ());
+    failed += report ("compress", test_compress ());
+    return (failed ? EXIT_FAILURE : EXIT_SUCCESS);
 }